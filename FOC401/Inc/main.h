@@ -96,6 +96,48 @@ void Error_Handler(void);
 #define M1_PWM_EN_W_Pin GPIO_PIN_12
 #define M1_PWM_EN_W_GPIO_Port GPIOC
 /* USER CODE BEGIN Private defines */
+/* Preemption priorities of the interrupts, with NVIC_PRIORITYGROUP_3: 8 levels, 0 being the
+   highest, the subpriority only ordering the pending requests of a same level.
+   - MC_IRQ_PRIO_TIM_UP    update of TIM1, that rearms the ADC for the next sampling: a few
+                           tens of cycles, ready before the trigger even when the high
+                           frequency task overruns. With PCC_SPLIT_PHASE it then runs the
+                           first stage of the prediction, FOC_CurrPrepareM1, that the end
+                           of the conversions may wait for
+   - MC_IRQ_PRIO_PWM_SYNC  sync event of mc_pwm_sync, that reads the carrier at once
+   - MC_IRQ_PRIO_HF        end of the current conversions, the high frequency task, delayed
+                           by the two short handlers above only
+   - MC_IRQ_PRIO_COMM      MCP UART and DMA, deferred high frequency duties on PendSV,
+                           encoder timer, EXTI lines
+   - TICK_INT_PRIORITY     SysTick and the medium frequency task, the break of TIM1, that
+                           calls MC_Scheduler: one level, so that they never interleave their
+                           commands to the MC interface
+   The break input of TIM1 disables the PWM outputs in hardware. The break interrupt then
+   only records the fault, and is not above the high frequency task.
+   The jitter of the high frequency task, with DBG_MCU_LOAD_MEASURE, is read with
+   MC_REG_PERF_JITTER */
+#define MC_IRQ_PRIO_TIM_UP      0U
+#define MC_IRQ_PRIO_PWM_SYNC    1U
+#define MC_IRQ_PRIO_HF          2U
+#define MC_IRQ_PRIO_COMM        3U
+#if (MC_IRQ_PRIO_TIM_UP >= MC_IRQ_PRIO_HF) || (MC_IRQ_PRIO_PWM_SYNC >= MC_IRQ_PRIO_HF) || \
+    (MC_IRQ_PRIO_HF >= MC_IRQ_PRIO_COMM) || (MC_IRQ_PRIO_COMM >= TICK_INT_PRIORITY)
+#error "The interrupt priorities must follow the order of the list above"
+#endif
+#ifdef M1_ENCODER_SENSOR
+#define M1_ENCODER_A_Pin GPIO_PIN_15
+#define M1_ENCODER_A_GPIO_Port GPIOA
+#define M1_ENCODER_B_Pin GPIO_PIN_3
+#define M1_ENCODER_B_GPIO_Port GPIOB
+#endif
+#ifdef MC_PWM_SYNC_MODE
+#define PWM_SYNC_Pin GPIO_PIN_5
+#define PWM_SYNC_GPIO_Port GPIOB
+#define PWM_SYNC_EXTI_IRQn EXTI9_5_IRQn
+#endif
+#ifdef M1_ICL_ENABLED
+#define M1_ICL_SHUT_OUT_Pin GPIO_PIN_6
+#define M1_ICL_SHUT_OUT_GPIO_Port GPIOC
+#endif
 
 /* USER CODE END Private defines */
 
@@ -62,6 +62,28 @@ void MC_SetCurrentReferenceMotor1( qd_t Iqdref );
 /* Programs a current reference for Motor 1 */
 void MC_SetCurrentReferenceMotor1_F( qd_f_t IqdRef );
 
+#ifdef M1_POSITION_CTRL
+/* Programs a movement of Motor 1 to a mechanical angle, in rad */
+void MC_ProgramPositionCommandMotor1( float FinalPosition, uint16_t hDurationms );
+
+/* Returns the mechanical angle of the rotor of Motor 1, in rad */
+float MC_GetCurrentPositionMotor1( void );
+
+/* Returns the status of the movement of the last position command of Motor 1 */
+PosCtrlStatus_t MC_GetControlPositionStatusMotor1( void );
+#endif
+
+#ifdef MCI_SETPOINT_STREAM
+/* Hands the current references of Motor 1 over to the setpoint stream */
+void MC_StartSetpointStreamMotor1( void );
+
+/* Queues a timestamped current reference of the setpoint stream of Motor 1 */
+bool MC_PushSetpointMotor1( uint16_t hTime, qd_t Iqdref );
+
+/* Returns the clock of the setpoint stream of Motor 1, in FOC periods */
+uint16_t MC_GetStreamClockMotor1( void );
+#endif
+
 /* Returns the state of the last submited command for Motor 1 */
 MCI_CommandState_t  MC_GetCommandStateMotor1( void);
 
@@ -155,6 +177,29 @@ bool MC_GetPolarizationOffsetsMotor1( PolarizationOffsets_t * PolarizationOffset
 
 /* Starts the polarization offsets measurement procedure for Motor 1. */
 bool MC_StartPolarizationOffsetsMeasurementMotor1( void );
+
+#ifdef MC_COMMISSION_MODE
+/* Starts the identification of the model of the predictive current controller of Motor 1 */
+bool MC_StartCommissioningMotor1( void );
+#endif
+#ifdef MC_PROFILE_MODE
+/* Applies a profile of parameters stored in flash to Motor 1 */
+bool MC_SelectProfileMotor1( uint8_t bProfile );
+#endif
+#ifdef MC_DTCALIB_MODE
+/* Starts the calibration of the dead time compensation of Motor 1 */
+bool MC_StartDeadTimeCalibrationMotor1( void );
+#endif
+#ifdef MC_ADCCALIB_MODE
+/* Starts the tuning of the timing of the current sampling of Motor 1 */
+bool MC_StartAdcCalibrationMotor1( void );
+#endif
+#ifdef MC_PWMFREQ_MODE
+/* Changes the PWM frequency of Motor 1 */
+bool MC_SetPwmFrequencyMotor1( uint32_t wFrequency );
+/* Returns the PWM frequency of Motor 1 */
+uint32_t MC_GetPwmFrequencyMotor1( void );
+#endif
 /* Acknowledge a Motor Control fault on Motor 1 */
 bool MC_AcknowledgeFaultMotor1( void );
 
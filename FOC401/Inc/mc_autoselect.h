@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    mc_autoselect.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Boot time selection of the current controller that fits the
+  *          regulation period
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_AUTOSELECT_H
+#define MC_AUTOSELECT_H
+
+#include "mc_type.h"
+
+/* The selection is built when MC_AUTOSELECT_MODE is added to the preprocessor symbols
+   of the build configuration, with the CURR_CTRL_PCC backend. It runs once at the end
+   of MCboot, before any motor start command is processed.
+
+   The output mode, the search, the horizon and the cost norm of the predictive
+   controller are chosen at build, so that the selection is among what the build leaves
+   to the run time: the predictive controller with its node budget, then with the
+   budget halved down to MC_AUTOSEL_MIN_NODES, the budget only bounding the search of a
+   PCC_HORIZON above 1, then the PI controllers alone. Each candidate runs in closed
+   loop on copies of the handles, at the operating points of mc_autoselect.c, and the
+   first one whose longest call fits MC_AUTOSEL_BUDGET_PC percent of the regulation
+   period is kept: its node budget is applied, or the engage speeds of the predictive
+   controller are raised out of reach for the PI controllers. The choice and the cycles
+   of each candidate are read with MC_REG_AUTOSELECT over the MCP link. */
+
+/* Share of the regulation period, REGULATION_EXECUTION_RATE periods of
+   PWM_PERIOD_CYCLES timer cycles, given to the current controller */
+#ifndef MC_AUTOSEL_BUDGET_PC
+#define MC_AUTOSEL_BUDGET_PC      40U
+#endif
+
+/* Node budgets timed: the one of the drive, then halved at each level */
+#define MC_AUTOSEL_NB_LEVELS      4U
+
+/* Operating points of the closed loop runs, and periods of each run from zero
+   currents, the step response included */
+#define MC_AUTOSEL_NB_POINTS      4U
+#define MC_AUTOSEL_PERIODS        64U
+
+typedef enum
+{
+  MC_AUTOSEL_CTRL_PI,             /* Torque and flux PI controllers */
+  MC_AUTOSEL_CTRL_PCC             /* Predictive current controller */
+} MC_AutoSel_Controller_t;
+
+/* Layout of MC_REG_AUTOSELECT */
+typedef struct
+{
+  uint8_t  bController;           /* MC_AutoSel_Controller_t selected */
+  uint8_t  bLevel;                /* Level of the node budget selected,
+                                     MC_AUTOSEL_NB_LEVELS with the PI controllers */
+  uint8_t  bFits;                 /* 0 if no candidate fits, the PI controllers
+                                     being then kept */
+  uint8_t  bBudgetPc;             /* MC_AUTOSEL_BUDGET_PC */
+  uint16_t hNodeBudget;           /* Node budget selected, 0 with the PI controllers */
+  uint16_t hReserved;
+  uint32_t wBudgetCycles;         /* CPU cycles given to the current controller */
+  uint32_t wPICycles;             /* Longest call of the PI controllers */
+  uint32_t wPCCCycles[MC_AUTOSEL_NB_LEVELS]; /* Longest call of the predictive
+                                     controller at each level, 0 if not timed */
+} MC_AutoSel_Report_t;
+
+extern MC_AutoSel_Report_t MC_AutoSelReport;
+
+void MC_AutoSel_Run(void);
+
+#endif /* MC_AUTOSELECT_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,115 @@
+/**
+  ******************************************************************************
+  * @file    mc_bench.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Execution time benchmark of the motor control math kernels
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_BENCH_H
+#define MC_BENCH_H
+
+#include "mc_type.h"
+
+/* The benchmark is built when MC_BENCH_MODE is added to the preprocessor symbols of
+   the build configuration. It runs once at the end of MCboot, before any motor start
+   command is processed, and its results are read with the MC_REG_BENCH_RESULTS,
+   MC_REG_BENCH_RIPPLE and MC_REG_BENCH_SCENARIOS registers over the MCP link.
+   The cost norms of the predictive current controller are compared on builds of each
+   one: #PCC_COST_L2_FLOAT sets PCC_FLOAT_COST_FLAG in the configuration registers. */
+
+typedef enum {
+  BENCH_MCM_Clarke,
+  BENCH_MCM_Park,
+  BENCH_MCM_Rev_Park,
+  BENCH_MCM_ClarkePark,
+  BENCH_MCM_Trig_Functions,
+  BENCH_MCM_Sqrt,
+  BENCH_Circle_Limitation,
+  BENCH_PI_Controller,
+  BENCH_STO_PLL_CalcElAngle,
+  BENCH_PCC_CalcVoltage,      /* Not measured with the CURR_CTRL_PI backend */
+  BENCH_MCM_Trig_Functions_Batch /* MC_BENCH_NB_INPUTS angles in one call */
+//  Others kernels to measure to be added here.
+}MC_BENCH_KERNELS_LIST_t;
+
+/* Define number of kernels according to the list defined in MC_BENCH_KERNELS_LIST_t */
+#define  MC_BENCH_NB_KERNELS  11
+
+/* Number of input vectors, each of them is run MC_BENCH_NB_RUNS times with the caches of
+   the flash filled, after a first run with the caches just reset */
+#define  MC_BENCH_NB_INPUTS  8U
+#define  MC_BENCH_NB_RUNS    16U
+
+typedef struct {
+    uint32_t  min;                  /* Execution time of one call, in CPU cycles */
+    uint32_t  max;
+    uint32_t  cold;                 /* Longest one with the caches reset before the call */
+} MC_Bench_Result_t;
+
+/* Closed loop runs of PCC_CalcVoltage on its own model, one per input vector: the
+   current of each period is the one the controller predicted for it. The error of the
+   first MC_BENCH_RIPPLE_WARMUP periods, the step response, is not accumulated. */
+#define  MC_BENCH_RIPPLE_WARMUP   32U
+#define  MC_BENCH_RIPPLE_PERIODS  256U
+
+typedef struct {
+    uint32_t  mean;                 /* Squared q/d current tracking error, in s16A */
+    uint32_t  max;                  /* digits squared */
+} MC_Bench_Ripple_t;
+
+/* Closed loop runs of the current controllers on a plant model of the motor at an
+   imposed speed, built from the parameters of the drive: MC_BENCH_SCENARIO_WARMUP
+   periods at the initial operating point, then the step of the scenario, with
+   MC_BENCH_SCENARIO_SETTLE periods for the settling time, then MC_BENCH_RIPPLE_PERIODS
+   periods in steady state for the other results. The controllers run on copies of
+   their handles, the PI controllers without the feed forward. */
+typedef enum {
+  BENCH_SCENARIO_SpeedStep,   /* Speed step at constant current reference */
+  BENCH_SCENARIO_LoadStep,    /* q current reference step */
+  BENCH_SCENARIO_BusSag,      /* Bus voltage drop to 70 %, known to the controller */
+  BENCH_SCENARIO_Mismatch     /* q current reference step, plant Rs + 50 % and Ls - 30 % */
+}MC_BENCH_SCENARIOS_LIST_t;
+
+#define  MC_BENCH_NB_SCENARIOS  4U
+
+typedef enum {
+  BENCH_CTRL_PI,
+  BENCH_CTRL_PCC              /* Backend of the build, zero results with CURR_CTRL_PI */
+}MC_BENCH_CONTROLLERS_LIST_t;
+
+#define  MC_BENCH_NB_CONTROLLERS  2U
+
+#define  MC_BENCH_SCENARIO_WARMUP  256U
+#define  MC_BENCH_SCENARIO_SETTLE  256U
+/* The q current is settled within 1/16 of its reference, and at least this band */
+#define  MC_BENCH_SETTLE_BAND_POW2  4U
+#define  MC_BENCH_SETTLE_BAND_MIN   256
+
+typedef struct {
+    uint16_t  hRippleRms;           /* RMS of the q/d currents around their mean, s16A digits */
+    uint16_t  hThd;                 /* Same ripple, per mille of the mean current */
+    uint16_t  hSwitchingFreq;       /* Mean switching frequency of one leg, Hz */
+    uint16_t  hSettlingTime;        /* us after the step, UINT16_MAX if not settled */
+    uint32_t  wCycles;              /* Mean execution time of one call, in CPU cycles */
+} MC_Bench_Scenario_t;
+
+extern MC_Bench_Result_t MC_BenchResults[MC_BENCH_NB_KERNELS];
+extern MC_Bench_Ripple_t MC_BenchRipple[MC_BENCH_NB_INPUTS];
+extern MC_Bench_Scenario_t MC_BenchScenarios[MC_BENCH_NB_CONTROLLERS][MC_BENCH_NB_SCENARIOS];
+
+void MC_Bench_Run(void);
+
+#endif /* MC_BENCH_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,37 @@
+/**
+  ******************************************************************************
+  * @file    mc_board.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Capabilities of the STM32F401 board used by the control core
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_BOARD_H
+#define MC_BOARD_H
+
+/* mc_math.c/h and register_interface.c are the same in every port of the drive and
+   select their variant from the macros below, so that a change of the control core is
+   made once and copied. This file, with mc_stm_types.h for the LL drivers of the
+   series, is what each port provides:
+   - MC_BOARD_CORDIC: the CORDIC coprocessor computes the trigonometric functions,
+     the square root and the phase; without it they come from a sine table and from
+     software iterations;
+   - MC_BOARD_DAC: the DAC outputs of dac_ui are built, with MC_REG_DAC_OUT1/2;
+   - MC_BOARD_OBSERVER_SEL: mc_tasks.c provides TSK_SetObserverM1() and
+     TSK_GetObserverM1(), with MC_REG_OBSERVER_SEL. */
+
+/* STM32F401: no CORDIC, no DAC, a single observer */
+
+#endif /* MC_BOARD_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************
+  * @file    mc_bootlog.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Capture configuration stored in flash and armed at boot
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_BOOTLOG_H
+#define MC_BOOTLOG_H
+
+#include "mc_type.h"
+#include "mc_capture.h"
+
+/* The boot capture is built when MC_BOOTLOG_MODE is added to the preprocessor symbols
+   of the build configuration, with MC_CAPTURE_MODE. The MCPA datalog only streams once
+   the host has configured it, and the start of the drive is then already over: the
+   capture ring records it instead, without the link, and is read afterwards.
+
+   MC_REG_BOOTLOG_CONFIG returns the stored configuration, and stores it for the next
+   boots when it is written in the IDLE state. The configuration is written in the
+   flash sector 3, that STM32F401RETX_FLASH.ld keeps out of the image as the one of
+   mc_faultlog. MCboot arms the capture with it before the
+   boot offset calibration and before any command, so that with a trigger on the start
+   and enough pre-trigger samples the offset calibration, the alignment, the rev up and
+   the switch over are recorded at the FOC rate. The frozen capture is read with the
+   registers of mc_capture. */
+
+/* Layout of MC_REG_BOOTLOG_CONFIG */
+typedef struct
+{
+  uint8_t  bEnabled;              /* 0: the capture is not armed at boot */
+  uint8_t  bReserved;
+  MC_Capture_Config_t Capture;
+} MC_BootLog_Config_t;
+
+void MC_BootLog_Init(void);
+const MC_BootLog_Config_t *MC_BootLog_GetConfig(void);
+bool MC_BootLog_Store(const MC_BootLog_Config_t *pConfig);
+
+#endif /* MC_BOOTLOG_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
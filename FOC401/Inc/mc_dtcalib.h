@@ -0,0 +1,85 @@
+/**
+  ******************************************************************************
+  * @file    mc_dtcalib.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Calibration of the dead time compensation at standstill
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_DTCALIB_H
+#define MC_DTCALIB_H
+
+#include "mc_type.h"
+#include "pwm_curr_fdbk.h"
+
+/* The dead time calibration is built when MC_DTCALIB_MODE is added to the preprocessor
+   symbols of the build configuration. MC_DeadTimeCalibrationMotor1() measures the
+   voltage error of each phase versus its current, at standstill, and replaces the
+   constant DTCompCnt of the space vector modulation by a table of
+   PWMC_DTCOMP_LUT_POINTS points per phase:
+
+   - for each phase in turn the rotor is aligned by a d current along the axis of the
+     phase, regulated by the PI controllers with the dead time compensation disabled;
+   - the d voltage is averaged at MC_DTCALIB_NB_LEVELS currents, from the highest one
+     down to one current step;
+   - the resistance is the slope of the upper half of the levels, where the error does
+     not change with the current anymore. What is left of the d voltage is the error of
+     the phase plus the one of the two others at half the current: the error of the
+     phase is solved level by level from the lower ones, the other phases being
+     assumed to have the same error;
+   - the errors become the compare counts of the table and the compensation is enabled.
+
+   With the predictive controller in PCC_FINITE_SET the mean error at the highest level
+   also gives the dead time drop of the predictor. The table is kept in RAM: the
+   calibration is run again when the power stage has changed temperature. */
+
+/* d current of the highest level, in digits */
+#ifndef MC_DTCALIB_CURRENT
+#define MC_DTCALIB_CURRENT          ((int16_t)(NOMINAL_CURRENT / 2))
+#endif
+
+/* Current levels of a phase, the points of the table but the one at zero current */
+#define MC_DTCALIB_NB_LEVELS        (PWMC_DTCOMP_LUT_POINTS - 1U)
+/* FOC periods of the alignment of a phase, the d current ramps up over the first half */
+#define MC_DTCALIB_ALIGN_LOG        13U
+/* FOC periods for the current to settle at each level */
+#define MC_DTCALIB_SETTLE_LOG       10U
+/* FOC periods averaged at each level */
+#define MC_DTCALIB_AVG_LOG          11U
+
+typedef enum
+{
+  MC_DTCAL_IDLE = 0,  /*!< Not started or stopped */
+  MC_DTCAL_ALIGN,     /*!< Rotor aligned on the axis of the phase */
+  MC_DTCAL_LEVELS,    /*!< d voltage averaged at each current level */
+  MC_DTCAL_MEASURED,  /*!< All phases measured, the current is held at zero until
+                           the medium frequency task computes the table */
+  MC_DTCAL_DONE,      /*!< Table computed and in use */
+  MC_DTCAL_FAILED     /*!< Implausible measurement, the compensation is not changed */
+} MC_DTCalib_Phase_t;
+
+/* The standstill phases, up to MC_DTCAL_MEASURED, are run by the high frequency task */
+void MC_DTCalib_Start(PWMC_Handle_t *pPWMC, int16_t hCurrent);
+void MC_DTCalib_Stop(void);
+MC_DTCalib_Phase_t MC_DTCalib_GetPhase(void);
+int16_t MC_DTCalib_GetElAngle(void);
+qd_t MC_DTCalib_GetCurrentRef(void);
+void MC_DTCalib_Exec(qd_t Iqd, qd_t Vqd);
+
+/* Medium frequency task, in MC_DTCAL_MEASURED with the PWM switched off */
+bool MC_DTCalib_Compute(void);
+int16_t MC_DTCalib_GetPhaseDrop(void);
+
+#endif /* MC_DTCALIB_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,116 @@
+/**
+  ******************************************************************************
+  * @file    mc_gap.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   STGAP isolated gate drivers configured and monitored over SPI DMA
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_GAP_H
+#define MC_GAP_H
+
+#include "mc_type.h"
+#include "mc_interface.h"
+#include "gap_gate_driver_ctrl.h"
+
+/* The STGAP drivers of the power stage are handled when MC_GAP_MODE is added to the
+   preprocessor symbols of the build configuration. STGAP_M1 of mc_config.c describes
+   the daisy chain: MC_GAP_NB_DEVICES devices, one per switch, their registers, the SPI
+   and the NCS and NSD pins. The SPI, 16 bits, and its two DMA streams are set up by
+   the initialisation code of the board.
+
+   Unlike the blocking functions of gap_gate_driver_ctrl.c, each SPI frame of the
+   chain, one word per device, is moved by the DMA: the medium frequency task starts
+   a frame and the next period ends it, so that NCS stays high one period between
+   two frames. Nothing runs in the high frequency task, and MCboot does not wait:
+
+   - MC_Gap_Start begins the configuration, with NSD low: the registers are written
+     in configuration mode, the status is reset and the registers are read back. A
+     mismatch starts over, up to MC_GAP_CONFIG_RETRIES times, after which the chain
+     is reported as not programmable. NSD is released once the registers match, and
+     MCI_StartMotor is rejected until then, the resume of a warm boot as well;
+   - the status registers are then read every MC_GAP_POLL_MS. The safety task raises
+     their faults: desaturation and sense as MC_BREAK_IN, thermal shutdown as
+     MC_OVER_TEMP, the under and over voltages of the supplies as MC_UNDER_VOLT and
+     MC_OVER_VOLT, the others as MC_SW_ERROR. The thermal warning is not a fault;
+   - the status registers latch, and are reset once the PWM is off, in a fault state
+     or in IDLE, so that a fault that is over clears at the next read;
+   - a read with a wrong SPI CRC is dropped, MC_GAP_CRC_ERRORS_MAX in a row are a
+     fault.
+
+   MC_REG_GAP_ERRORS returns the GAP_ERROR_CODE_xxx bits of all the devices. */
+
+#ifndef MC_GAP_NB_DEVICES
+#define MC_GAP_NB_DEVICES           6U
+#endif
+#ifndef MC_GAP_POLL_MS
+#define MC_GAP_POLL_MS              10U
+#endif
+#ifndef MC_GAP_CONFIG_RETRIES
+#define MC_GAP_CONFIG_RETRIES       3U
+#endif
+#define MC_GAP_CRC_ERRORS_MAX       3U
+
+/* SPI of STGAP_M1 and its DMA streams */
+#ifndef MC_GAP_SPI
+#define MC_GAP_SPI                  SPI1
+#endif
+#ifndef MC_GAP_DMA
+#define MC_GAP_DMA                  DMA2
+#endif
+#ifndef MC_GAP_DMA_STREAM_RX
+#define MC_GAP_DMA_STREAM_RX        LL_DMA_STREAM_0
+#endif
+#ifndef MC_GAP_DMA_STREAM_TX
+#define MC_GAP_DMA_STREAM_TX        LL_DMA_STREAM_3
+#endif
+
+/* Registers of each device. The dead time is inserted by the timer, the CRC of the
+   SPI is on */
+#ifndef MC_GAP_DEVICE_PARAMS
+#define MC_GAP_DEVICE_PARAMS                                                               \
+  {                                                                                        \
+    .CFG1 = GAP_CFG1_CRC_SPI | GAP_CFG1_UVLOD | GAP_CFG1_SD_FLAG | GAP_CFG1_DIAG_EN        \
+          | GAP_CFG1_DT_DISABLE | GAP_CFG1_INFILTER_210NS,                                 \
+    .CFG2 = GAP_CFG2_SENSETH_100MV | GAP_CFG2_DESATCURR_500UA | GAP_CFG2_DESATTH_8V,       \
+    .CFG3 = GAP_CFG3_2LTOTH_7_0V | GAP_CFG3_2LTOTIME_DISABLE,                               \
+    .CFG4 = GAP_CFG4_OVLO | GAP_CFG4_UVLOLATCH | GAP_CFG4_UVLOTH_VH_12V                    \
+          | GAP_CFG4_UVLOTH_VL_DISABLE,                                                    \
+    .CFG5 = GAP_CFG5_CLAMP_EN | GAP_CFG5_DESAT_EN,                                         \
+    .DIAG1 = GAP_DIAG_SPI_REGERR | GAP_DIAG_UVLOD_OVLOD | GAP_DIAG_UVLOH_UVLOL             \
+           | GAP_DIAG_OVLOH_OVLOL | GAP_DIAG_DESAT_SENSE | GAP_DIAG_ASC_DT_ERR | GAP_DIAG_TSD, \
+    .DIAG2 = GAP_DIAG_TWN,                                                                 \
+  }
+#endif
+
+typedef enum
+{
+  MC_GAP_CONFIGURING,
+  MC_GAP_READY,
+  MC_GAP_FAILED               /*!< Registers not matching after MC_GAP_CONFIG_RETRIES */
+} MC_Gap_State_t;
+
+void MC_Gap_Start(GAP_Handle_t *pGap);
+MC_Gap_State_t MC_Gap_GetState(void);
+bool MC_Gap_IsReady(void);
+uint32_t MC_Gap_GetErrors(void);
+
+/* Medium frequency task */
+void MC_Gap_Exec(MCI_Handle_t *pMCI);
+
+/* Safety task */
+uint16_t MC_Gap_CheckFaults(void);
+
+#endif /* MC_GAP_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -37,6 +37,30 @@
 #define SQRT_2  1.4142
 #define SQRT_3  1.732
 
+#ifdef MC_BOARD_CORDIC
+/* CORDIC coprocessor configuration register settings */
+
+/* CORDIC FUNCTION: PHASE q1.31 (Electrical Angle computation) */
+#define CORDIC_CONFIG_PHASE     (LL_CORDIC_FUNCTION_PHASE | LL_CORDIC_PRECISION_6CYCLES | LL_CORDIC_SCALE_0 |\
+         LL_CORDIC_NBWRITE_2 | LL_CORDIC_NBREAD_1 |\
+         LL_CORDIC_INSIZE_32BITS | LL_CORDIC_OUTSIZE_32BITS)
+
+/* CORDIC FUNCTION: SQUAREROOT q1.31 */
+#define CORDIC_CONFIG_SQRT      (LL_CORDIC_FUNCTION_SQUAREROOT | LL_CORDIC_PRECISION_6CYCLES | LL_CORDIC_SCALE_1 |\
+         LL_CORDIC_NBWRITE_1 | LL_CORDIC_NBREAD_1 |\
+         LL_CORDIC_INSIZE_32BITS | LL_CORDIC_OUTSIZE_32BITS)
+
+/* CORDIC FUNCTION: COSINE q1.15 */
+#define CORDIC_CONFIG_COSINE    (LL_CORDIC_FUNCTION_COSINE | LL_CORDIC_PRECISION_6CYCLES | LL_CORDIC_SCALE_0 |\
+         LL_CORDIC_NBWRITE_1 | LL_CORDIC_NBREAD_1 |\
+         LL_CORDIC_INSIZE_16BITS | LL_CORDIC_OUTSIZE_16BITS)
+
+/* CORDIC FUNCTION: MODULUS q1.15 */
+#define CORDIC_CONFIG_MODULUS   (LL_CORDIC_FUNCTION_MODULUS | LL_CORDIC_PRECISION_6CYCLES | LL_CORDIC_SCALE_0 |\
+				 LL_CORDIC_NBWRITE_1 | LL_CORDIC_NBREAD_1 |\
+				 LL_CORDIC_INSIZE_16BITS | LL_CORDIC_OUTSIZE_16BITS)
+#endif /* MC_BOARD_CORDIC */
+
 /**
   * @brief  Macro to compute logarithm of two
   */
@@ -103,6 +127,37 @@ qd_t MCM_Park(alphabeta_t Input, int16_t Theta);
   */
 alphabeta_t MCM_Rev_Park(qd_t Input, int16_t Theta);
 
+/**
+  * @brief  This function carries out MCM_Clarke() and MCM_Park() in one pass and
+  *         also returns the sine and cosine of Theta, so that they can be reused
+  *         by the other transformations at the same angle.
+  * @param  Input: stator current Ia and Ib in ab_t format
+  * @param  Theta: rotating frame angular position in q1.15 format
+  * @param  pAlphabeta: stator current Ialpha and Ibeta in alphabeta_t format
+  * @param  pTrig: Cos(Theta) and Sin(Theta) in Trig_Components format
+  * @retval Stator current q and d in qd_t format
+  */
+qd_t MCM_ClarkePark(ab_t Input, int16_t Theta, alphabeta_t *pAlphabeta, Trig_Components *pTrig);
+
+/**
+  * @brief  This function carries out MCM_ClarkePark() with the sine and cosine
+  *         of the angle already computed, e.g. by MCM_Trig_Collect().
+  * @param  Input: stator current Ia and Ib in ab_t format
+  * @param  Trig: Cos(Theta) and Sin(Theta) in Trig_Components format
+  * @param  pAlphabeta: stator current Ialpha and Ibeta in alphabeta_t format
+  * @retval Stator current q and d in qd_t format
+  */
+qd_t MCM_ClarkePark_Trig(ab_t Input, Trig_Components Trig, alphabeta_t *pAlphabeta);
+
+/**
+  * @brief  This function carries out MCM_Rev_Park() with the sine and cosine of
+  *         the angle already computed, e.g. by MCM_ClarkePark().
+  * @param  Input: stator voltage Vq and Vd in qd_t format
+  * @param  Trig: Cos(theta) and Sin(theta) in Trig_Components format
+  * @retval Stator values alpha and beta in alphabeta_t format
+  */
+alphabeta_t MCM_Rev_Park_Trig(qd_t Input, Trig_Components Trig);
+
 /**
   * @brief  This function returns cosine and sine functions of the angle fed in
   *         input
@@ -111,6 +166,16 @@ alphabeta_t MCM_Rev_Park(qd_t Input, int16_t Theta);
   */
 Trig_Components MCM_Trig_Functions(int16_t hAngle);
 
+/**
+  * @brief  This function returns the cosine and sine of several angles in one
+  *         call, so that the angles of a period are collected and computed
+  *         together
+  * @param  pAngles: angles in q1.15 format
+  * @param  pTrig: Cos(angle) and Sin(angle) of each angle, in the same order
+  * @param  bCount: number of angles
+  */
+void MCM_Trig_Functions_Batch(const int16_t *pAngles, Trig_Components *pTrig, uint8_t bCount);
+
 /**
   * @brief  It calculates the square root of a non-negative s32. It returns 0
   *         for negative s32.
@@ -119,9 +184,533 @@ Trig_Components MCM_Trig_Functions(int16_t hAngle);
   */
 int32_t MCM_Sqrt(int32_t wInput);
 
+/**
+  * @brief  1/sqrt(3) in q1.15 format=0.5773315
+  */
+#define divSQRT_3 (int32_t)0x49E6
+
+/**
+  * @brief  Name of the transformation called by the control loops: the static
+  *         inline MCM_xxx_Inline() when MC_MATH_INLINE is defined, so that the
+  *         compiler can fuse it into the caller, the __weak MCM_xxx() otherwise.
+  *         The __weak functions are built on the inline ones and can still be
+  *         overridden, but an override is not seen by the inline callers.
+  */
+#ifdef MC_MATH_INLINE
+#define MCM_CALL(fn)  fn##_Inline
+#else
+#define MCM_CALL(fn)  fn
+#endif
+
+#ifdef MC_BOARD_CORDIC
+/**
+  * @brief  Inline variant of MCM_Trig_Functions()
+  */
+static inline Trig_Components MCM_Trig_Functions_Inline(int16_t hAngle)
+{
+  /* MISRAC2012-violation Rule 19.2. The union keyword should not be used.
+   * If this rule is not followed, the kinds of behavior that need to be determined
+   * are:
+   * Padding  how much padding is inserted at the end of the union;
+   * Alignment  how are members of any structures within the union aligned;
+   * Endianness  is the most significant byte of a word stored at the lowest or
+   *              highest memory address;
+   * Bit-order  how are bits numbered within bytes and how are bits allocated to
+   *             bit fields.
+   * Low. Use of union (u32toi16x2). */
+  //cstat -MISRAC2012-Rule-19.2
+  union u32toi16x2 {
+    uint32_t CordicRdata;
+    Trig_Components Components;
+  } CosSin;
+  //cstat +MISRAC2012-Rule-19.2
+  /* Configure CORDIC */
+  /* Misra  violation Rule11.4 AConversionshouldnotbeperformedbetweena
+   * pointertoobject and an integer type */
+  WRITE_REG(CORDIC->CSR, CORDIC_CONFIG_COSINE);
+  /* Misra  violation Rule11.4 AConversionshouldnotbeperformedbetweena
+   * pointertoobject and an integer type */
+  LL_CORDIC_WriteData(CORDIC, ((uint32_t)0x7FFF0000) + ((uint32_t)hAngle));
+  /* Read angle */
+  /* Misra  violation Rule11.4 AConversionshouldnotbeperformedbetweena
+   * pointertoobject and an integer type */
+  CosSin.CordicRdata = LL_CORDIC_ReadData(CORDIC);
+  return (CosSin.Components); //cstat !UNION-type-punning
+}
+
+/**
+  * @brief  Inline variant of MCM_Sqrt(). The CORDIC computes the root in a fixed
+  *         number of cycles whatever the input. The interrupts are masked around
+  *         its use, so that a task of higher priority does not reconfigure it in
+  *         between, then the mask of the caller is restored.
+  */
+static inline int32_t MCM_Sqrt_Inline(int32_t wInput)
+{
+  int32_t wRoot = 0;
+
+  if (wInput > 0)
+  {
+    uint32_t wPrimask = __get_PRIMASK();
+
+    __disable_irq();
+    WRITE_REG(CORDIC->CSR, CORDIC_CONFIG_SQRT);
+    LL_CORDIC_WriteData(CORDIC, ((uint32_t)wInput));
+#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
+    wRoot = (int32_t)(LL_CORDIC_ReadData(CORDIC) >> 15); //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+#else
+    wRoot = (int32_t)(LL_CORDIC_ReadData(CORDIC) / 32768U);
+#endif
+    __set_PRIMASK(wPrimask);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (wRoot);
+}
+#else
+/* Quarter wave table: the two upper bits of the angle give the quadrant, the next
+   SIN_INDEX_BITS the table index, the remaining SIN_FRAC_BITS interpolate linearly
+   between two entries */
+#define SIN_QUADRANT_SIZE  16384
+#define SIN_INDEX_BITS     8U
+#define SIN_FRAC_BITS      6U
+#define SIN_FRAC_MASK      ((1U << SIN_FRAC_BITS) - 1U)
+#define SIN_TABLE_SIZE     ((1U << SIN_INDEX_BITS) + 1U)
+
+extern const int16_t hSin_Cos_Table[SIN_TABLE_SIZE];
+
+/**
+  * @brief  It returns the sine of a position of the first quadrant, interpolated
+  *         linearly between two entries of hSin_Cos_Table
+  * @param  wPosition: position from 0 to SIN_QUADRANT_SIZE, i.e. 0 to 90 degrees
+  * @retval int16_t Sine in q1.15 format
+  */
+static inline int16_t MCM_QuarterSin(int32_t wPosition)
+{
+  uint32_t wIndex = ((uint32_t)wPosition) >> SIN_FRAC_BITS;
+  int32_t wFrac = (int32_t)(((uint32_t)wPosition) & SIN_FRAC_MASK);
+  int32_t wSin = (int32_t)hSin_Cos_Table[wIndex];
+
+  if (wFrac != 0)
+  {
+    /* wIndex is below the last entry when wFrac is not zero. The table is
+       increasing, so the shifted product is never negative */
+    wSin += ((((int32_t)hSin_Cos_Table[wIndex + 1U]) - wSin) * wFrac) >> SIN_FRAC_BITS;
+  }
+  return ((int16_t)wSin);
+}
+
+/**
+  * @brief  Inline variant of MCM_Trig_Functions()
+  */
+static inline Trig_Components MCM_Trig_Functions_Inline(int16_t hAngle)
+{
+  uint16_t uhAngle = (uint16_t)hAngle;
+  int32_t wPosition;
+  int16_t hSinQ;
+  int16_t hCosQ;
+  Trig_Components Local_Components;
+
+  /* Position in the quadrant, then sine and cosine of the quadrant */
+  wPosition = (int32_t)(uhAngle & ((uint16_t)SIN_QUADRANT_SIZE - 1U));
+  hSinQ = MCM_QuarterSin(wPosition);
+  hCosQ = MCM_QuarterSin(SIN_QUADRANT_SIZE - wPosition);
+
+  switch (uhAngle >> 14)
+  {
+    case 0U: /* 0 to 90 degrees */
+    {
+      Local_Components.hSin = hSinQ;
+      Local_Components.hCos = hCosQ;
+      break;
+    }
+
+    case 1U: /* 90 to 180 degrees */
+    {
+      Local_Components.hSin = hCosQ;
+      Local_Components.hCos = -hSinQ;
+      break;
+    }
+
+    case 2U: /* -180 to -90 degrees */
+    {
+      Local_Components.hSin = -hSinQ;
+      Local_Components.hCos = -hCosQ;
+      break;
+    }
+
+    default: /* -90 to 0 degrees */
+    {
+      Local_Components.hSin = -hCosQ;
+      Local_Components.hCos = hSinQ;
+      break;
+    }
+  }
+  return (Local_Components);
+}
+
+/**
+  * @brief  Inline variant of MCM_Sqrt(). Newton iterations from a first guess
+  *         chosen by the range of the input, bounded to six.
+  */
+static inline int32_t MCM_Sqrt_Inline(int32_t wInput)
+{
+  int32_t wtemprootnew;
+
+  if (wInput > 0)
+  {
+  uint8_t biter = 0u;
+  int32_t wtemproot;
+
+    if (wInput <= ((int32_t)2097152))
+    {
+      wtemproot = ((int32_t)128);
+    }
+    else
+    {
+      wtemproot = ((int32_t)8192);
+    }
+
+    do
+    {
+      wtemprootnew = (wtemproot + (wInput / wtemproot)) / (int32_t)2;
+      if ((wtemprootnew == wtemproot) || ((int32_t)0 == wtemproot))
+      {
+        biter = 6U;
+      }
+      else
+      {
+        biter ++;
+        wtemproot = wtemprootnew;
+      }
+    }
+    while (biter < 6U);
+
+  }
+  else
+  {
+    wtemprootnew = (int32_t)0;
+  }
+
+  return (wtemprootnew);
+}
+#endif /* MC_BOARD_CORDIC */
+
+/**
+  * @brief  Inline variant of MCM_Clarke()
+  */
+static inline alphabeta_t MCM_Clarke_Inline(ab_t Input)
+{
+  alphabeta_t Output;
+
+  int32_t a_divSQRT3_tmp;
+  int32_t b_divSQRT3_tmp;
+  int32_t wbeta_tmp;
+  int16_t hbeta_tmp;
+
+  /* qIalpha = qIas*/
+  Output.alpha = Input.a;
+
+  a_divSQRT3_tmp = divSQRT_3 * ((int32_t)Input.a);
+
+  b_divSQRT3_tmp = divSQRT_3 * ((int32_t)Input.b);
+
+  /*qIbeta = -(2*qIbs+qIas)/sqrt(3)*/
+#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) >> 15;
+#else
+  wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) / 32768;
+#endif
+
+  /* Check saturation of Ibeta */
+  if (wbeta_tmp > INT16_MAX)
+  {
+    hbeta_tmp = INT16_MAX;
+  }
+  else if (wbeta_tmp < (-32768))
+  {
+    hbeta_tmp =  ((int16_t)-32768);
+  }
+  else
+  {
+    hbeta_tmp = ((int16_t)wbeta_tmp);
+  }
+
+  Output.beta = hbeta_tmp;
+
+  if (((int16_t )-32768) == Output.beta)
+  {
+    Output.beta = -32767;
+  }
+
+  return (Output);
+}
+
+/**
+  * @brief  Inline variant of MCM_Park(), with the sine and cosine of the angle
+  *         already computed
+  */
+static inline qd_t MCM_Park_Trig_Inline(alphabeta_t Input, Trig_Components Trig)
+{
+  qd_t Output;
+  int32_t d_tmp_1;
+  int32_t d_tmp_2;
+  int32_t q_tmp_1;
+  int32_t q_tmp_2;
+  int32_t wqd_tmp;
+  int16_t hqd_tmp;
+  Trig_Components Local_Vector_Components = Trig;
+
+  /*No overflow guaranteed*/
+  q_tmp_1 = Input.alpha * ((int32_t )Local_Vector_Components.hCos);
+
+  /*No overflow guaranteed*/
+  q_tmp_2 = Input.beta * ((int32_t)Local_Vector_Components.hSin);
+
+  /*Iq component in Q1.15 Format */
+#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  wqd_tmp = (q_tmp_1 - q_tmp_2) >> 15; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+#else
+  wqd_tmp = (q_tmp_1 - q_tmp_2) / 32768;
+#endif
+
+  /* Check saturation of Iq */
+  if (wqd_tmp > INT16_MAX)
+  {
+    hqd_tmp = INT16_MAX;
+  }
+  else if (wqd_tmp < (-32768))
+  {
+    hqd_tmp = ((int16_t)-32768);
+  }
+  else
+  {
+    hqd_tmp = ((int16_t)wqd_tmp);
+  }
+
+  Output.q = hqd_tmp;
+
+  if (((int16_t )-32768) == Output.q)
+  {
+    Output.q = -32767;
+  }
+
+  /*No overflow guaranteed*/
+  d_tmp_1 = Input.alpha * ((int32_t )Local_Vector_Components.hSin);
+
+  /*No overflow guaranteed*/
+  d_tmp_2 = Input.beta * ((int32_t )Local_Vector_Components.hCos);
+
+  /*Id component in Q1.15 Format */
+#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  wqd_tmp = (d_tmp_1 + d_tmp_2) >> 15; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+#else
+  wqd_tmp = (d_tmp_1 + d_tmp_2) / 32768;
+#endif
+
+  /* Check saturation of Id */
+  if (wqd_tmp > INT16_MAX)
+  {
+    hqd_tmp = INT16_MAX;
+  }
+  else if (wqd_tmp < (-32768))
+  {
+    hqd_tmp = ((int16_t)-32768);
+  }
+  else
+  {
+    hqd_tmp = ((int16_t)wqd_tmp);
+  }
+
+  Output.d = hqd_tmp;
+
+  if (((int16_t)-32768) == Output.d)
+  {
+    Output.d = -32767;
+  }
+
+  return (Output);
+}
+
+/**
+  * @brief  Inline variant of MCM_Park()
+  */
+static inline qd_t MCM_Park_Inline(alphabeta_t Input, int16_t Theta)
+{
+  return (MCM_Park_Trig_Inline(Input, MCM_Trig_Functions_Inline(Theta)));
+}
+
+/**
+  * @brief  Inline variant of MCM_Rev_Park_Trig()
+  */
+static inline alphabeta_t MCM_Rev_Park_Trig_Inline(qd_t Input, Trig_Components Trig)
+{
+  int32_t alpha_tmp1;
+  int32_t alpha_tmp2;
+  int32_t beta_tmp1;
+  int32_t beta_tmp2;
+  alphabeta_t Output;
+
+  /*No overflow guaranteed*/
+  alpha_tmp1 = Input.q * ((int32_t)Trig.hCos);
+  alpha_tmp2 = Input.d * ((int32_t)Trig.hSin);
+
+#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  Output.alpha = (int16_t)(((alpha_tmp1) + (alpha_tmp2)) >> 15);
+#else
+  Output.alpha = (int16_t)(((alpha_tmp1) + (alpha_tmp2)) / 32768);
+#endif
+
+  beta_tmp1 = Input.q * ((int32_t)Trig.hSin);
+  beta_tmp2 = Input.d * ((int32_t)Trig.hCos);
+
+#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+  that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+  the compiler to perform the shift (instead of LSR logical shift right) */
+  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  Output.beta = (int16_t)((beta_tmp2 - beta_tmp1) >> 15);
+#else
+  Output.beta = (int16_t)((beta_tmp2 - beta_tmp1) / 32768);
+#endif
+
+  return (Output);
+}
+
+/**
+  * @brief  Inline variant of MCM_Rev_Park()
+  */
+static inline alphabeta_t MCM_Rev_Park_Inline(qd_t Input, int16_t Theta)
+{
+  return (MCM_Rev_Park_Trig_Inline(Input, MCM_Trig_Functions_Inline(Theta)));
+}
+
+/**
+  * @brief  Inline variant of MCM_ClarkePark_Trig()
+  */
+static inline qd_t MCM_ClarkePark_Trig_Inline(ab_t Input, Trig_Components Trig, alphabeta_t *pAlphabeta)
+{
+  qd_t Output;
+  alphabeta_t Alphabeta;
+  int32_t a_divSQRT3_tmp;
+  int32_t b_divSQRT3_tmp;
+  int32_t wbeta_tmp;
+  int32_t wqd_tmp;
+  int16_t hqd_tmp;
+  Trig_Components Local_Vector_Components = Trig;
+
+  /* qIalpha = qIas*/
+  Alphabeta.alpha = Input.a;
+
+  a_divSQRT3_tmp = divSQRT_3 * ((int32_t)Input.a);
+
+  b_divSQRT3_tmp = divSQRT_3 * ((int32_t)Input.b);
+
+  /*qIbeta = -(2*qIbs+qIas)/sqrt(3)*/
+#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) >> 15;
+#else
+  wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) / 32768;
+#endif
+
+  /* Check saturation of Ibeta, -32768 is also excluded */
+  if (wbeta_tmp > INT16_MAX)
+  {
+    Alphabeta.beta = INT16_MAX;
+  }
+  else if (wbeta_tmp < (-32767))
+  {
+    Alphabeta.beta = -32767;
+  }
+  else
+  {
+    Alphabeta.beta = ((int16_t)wbeta_tmp);
+  }
+
+  /*Iq component in Q1.15 Format */
+#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  wqd_tmp = ((Alphabeta.alpha * ((int32_t)Local_Vector_Components.hCos))
+           - (Alphabeta.beta * ((int32_t)Local_Vector_Components.hSin))) >> 15; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+#else
+  wqd_tmp = ((Alphabeta.alpha * ((int32_t)Local_Vector_Components.hCos))
+           - (Alphabeta.beta * ((int32_t)Local_Vector_Components.hSin))) / 32768;
+#endif
+
+  /* Check saturation of Iq */
+  if (wqd_tmp > INT16_MAX)
+  {
+    hqd_tmp = INT16_MAX;
+  }
+  else if (wqd_tmp < (-32767))
+  {
+    hqd_tmp = -32767;
+  }
+  else
+  {
+    hqd_tmp = ((int16_t)wqd_tmp);
+  }
+
+  Output.q = hqd_tmp;
+
+  /*Id component in Q1.15 Format */
+#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  wqd_tmp = ((Alphabeta.alpha * ((int32_t)Local_Vector_Components.hSin))
+           + (Alphabeta.beta * ((int32_t)Local_Vector_Components.hCos))) >> 15; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+#else
+  wqd_tmp = ((Alphabeta.alpha * ((int32_t)Local_Vector_Components.hSin))
+           + (Alphabeta.beta * ((int32_t)Local_Vector_Components.hCos))) / 32768;
+#endif
+
+  /* Check saturation of Id */
+  if (wqd_tmp > INT16_MAX)
+  {
+    hqd_tmp = INT16_MAX;
+  }
+  else if (wqd_tmp < (-32767))
+  {
+    hqd_tmp = -32767;
+  }
+  else
+  {
+    hqd_tmp = ((int16_t)wqd_tmp);
+  }
+
+  Output.d = hqd_tmp;
+
+  *pAlphabeta = Alphabeta;
+
+  return (Output);
+}
+
+#ifndef MC_BOARD_CORDIC
 /**
   * @brief  Sqrt table used by Circle Limitation function
-  *         used for STM32F0/STM32G0 series only
+  *         used on the boards without CORDIC
   */
 #define SQRT_CIRCLE_LIMITATION {\
      0 , 1023 , 1448 , 1773 , 2047 , 2289 , 2508 , 2709,\
@@ -253,6 +842,7 @@ int32_t MCM_Sqrt(int32_t wInput);
      32509 , 32526 , 32542 , 32558 , 32574 , 32590 , 32606 , 32622,\
      32638 , 32654 , 32670 , 32686 , 32702 , 32718 , 32734 , 32750,\
      32767 }
+#endif /* MC_BOARD_CORDIC */
 
 #define ATAN1DIV1     (int16_t)8192
 #define ATAN1DIV2     (int16_t)4836
@@ -269,6 +859,125 @@ int32_t MCM_Sqrt(int32_t wInput);
 #define ATAN1DIV4096  (int16_t)3
 #define ATAN1DIV8192  (int16_t)1
 
+#ifdef MC_BOARD_CORDIC
+/**
+  * @brief  It executes Modulus algorithm
+  * @param  alpha component
+  *         beta component
+  * @retval int16_t Modulus
+  */
+static inline int16_t MCM_Modulus( int16_t alpha, int16_t beta )
+{
+  int16_t Val;
+   __disable_irq();
+   /* Configure and call to CORDIC- */
+   WRITE_REG(CORDIC->CSR,CORDIC_CONFIG_MODULUS);
+   LL_CORDIC_WriteData(CORDIC, (int32_t) (beta)<<16 | alpha);
+   /* Wait for result */
+   while(!LL_CORDIC_IsActiveFlag_RRDY( CORDIC ))
+   {
+   }
+  /* Read computed modulus */
+  Val = (int16_t)(LL_CORDIC_ReadData(CORDIC)&0xFFFF);
+  __enable_irq();
+  return Val;
+
+}
+
+/**
+  * @brief  It executes CORDIC algorithm for rotor position extraction from B-emf
+  *         alpha and beta
+  * @param  wBemf_alfa_est estimated Bemf alpha on the stator reference frame
+  *         wBemf_beta_est estimated Bemf beta on the stator reference frame
+  * @retval int16_t rotor electrical angle (s16degrees)
+  */
+static inline int16_t MCM_PhaseComputation(int32_t wBemf_alfa_est, int32_t wBemf_beta_est)
+{
+
+  /* Configure and call to CORDIC */
+  WRITE_REG(CORDIC->CSR,CORDIC_CONFIG_PHASE);
+  LL_CORDIC_WriteData(CORDIC, (uint32_t)wBemf_alfa_est);
+  LL_CORDIC_WriteData(CORDIC, (uint32_t)wBemf_beta_est);
+
+  /* Read computed angle */
+  uint32_t result;
+  result = LL_CORDIC_ReadData(CORDIC) >> 16U;
+  return ((int16_t)result);
+
+}
+
+/**
+  * @brief  It starts the computation of the cosine and sine of hAngle on the
+  *         CORDIC and returns at once: the CPU carries on while the CORDIC
+  *         computes, and the result is read by MCM_Trig_Collect(). The CORDIC
+  *         must not be used by any other function, interrupts included, until
+  *         then.
+  * @param  hAngle: angle in q1.15 format
+  */
+static inline void MCM_Trig_Request(int16_t hAngle)
+{
+  /* Configure CORDIC */
+  WRITE_REG(CORDIC->CSR, CORDIC_CONFIG_COSINE);
+  LL_CORDIC_WriteData(CORDIC, ((uint32_t)0x7FFF0000) + ((uint32_t)hAngle));
+}
+
+/**
+  * @brief  It returns the cosine and sine of the angle given to
+  *         MCM_Trig_Request(). If the CORDIC has not completed yet, the read is
+  *         stalled until it has.
+  * @param  hAngle: angle in q1.15 format, the one given to MCM_Trig_Request().
+  *         Unused here, the result comes from the CORDIC
+  * @retval Trig_Components Cos(angle) and Sin(angle) in Trig_Components format
+  */
+static inline Trig_Components MCM_Trig_Collect(int16_t hAngle)
+{
+  //cstat -MISRAC2012-Rule-19.2
+  union u32toi16x2 {
+    uint32_t CordicRdata;
+    Trig_Components Components;
+  } CosSin;
+  //cstat +MISRAC2012-Rule-19.2
+  (void)hAngle;
+  CosSin.CordicRdata = LL_CORDIC_ReadData(CORDIC);
+  return (CosSin.Components); //cstat !UNION-type-punning
+}
+
+/**
+  * @brief  Inline variant of MCM_Trig_Functions_Batch(). The CORDIC is
+  *         configured once and run as a pipeline: the next angle is written
+  *         before the result of the previous one is read, and its computation
+  *         starts as soon as that result is read. The CORDIC must not be used
+  *         by any other function, interrupts included, during the call.
+  */
+static inline void MCM_Trig_Functions_Batch_Inline(const int16_t *pAngles, Trig_Components *pTrig, uint8_t bCount)
+{
+  //cstat -MISRAC2012-Rule-19.2
+  union u32toi16x2 {
+    uint32_t CordicRdata;
+    Trig_Components Components;
+  } CosSin;
+  //cstat +MISRAC2012-Rule-19.2
+  uint8_t i;
+
+  if (bCount > 0U)
+  {
+    WRITE_REG(CORDIC->CSR, CORDIC_CONFIG_COSINE);
+    LL_CORDIC_WriteData(CORDIC, ((uint32_t)0x7FFF0000) + ((uint32_t)(uint16_t)pAngles[0]));
+    for (i = 1U; i < bCount; i++)
+    {
+      LL_CORDIC_WriteData(CORDIC, ((uint32_t)0x7FFF0000) + ((uint32_t)(uint16_t)pAngles[i]));
+      CosSin.CordicRdata = LL_CORDIC_ReadData(CORDIC);
+      pTrig[i - 1U] = CosSin.Components; //cstat !UNION-type-punning
+    }
+    CosSin.CordicRdata = LL_CORDIC_ReadData(CORDIC);
+    pTrig[bCount - 1U] = CosSin.Components; //cstat !UNION-type-punning
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+#else
 /**
   * @brief  It executes Modulus algorithm
   * @param  alpha component
@@ -476,6 +1185,54 @@ static inline int16_t MCM_PhaseComputation(int32_t wBemf_alfa_est, int32_t wBemf
 
 }
 
+/**
+  * @brief  It starts the computation of the cosine and sine of hAngle, to be
+  *         read by MCM_Trig_Collect(). There is no coprocessor on this series:
+  *         the computation is entirely done by MCM_Trig_Collect().
+  * @param  hAngle: angle in q1.15 format
+  */
+static inline void MCM_Trig_Request(int16_t hAngle)
+{
+  (void)hAngle;
+}
+
+/**
+  * @brief  It returns the cosine and sine of the angle given to
+  *         MCM_Trig_Request().
+  * @param  hAngle: angle in q1.15 format, the one given to MCM_Trig_Request()
+  * @retval Trig_Components Cos(angle) and Sin(angle) in Trig_Components format
+  */
+static inline Trig_Components MCM_Trig_Collect(int16_t hAngle)
+{
+  return (MCM_CALL(MCM_Trig_Functions)(hAngle));
+}
+
+/**
+  * @brief  Inline variant of MCM_Trig_Functions_Batch(). The table kernel is
+  *         unrolled by two angles, whose lookups are independent of each other,
+  *         so that the loads of one angle are scheduled with the arithmetic of
+  *         the other.
+  */
+static inline void MCM_Trig_Functions_Batch_Inline(const int16_t *pAngles, Trig_Components *pTrig, uint8_t bCount)
+{
+  uint8_t i;
+
+  for (i = 0U; (i + 1U) < bCount; i += 2U)
+  {
+    pTrig[i] = MCM_Trig_Functions_Inline(pAngles[i]);
+    pTrig[i + 1U] = MCM_Trig_Functions_Inline(pAngles[i + 1U]);
+  }
+  if (i < bCount)
+  {
+    pTrig[i] = MCM_Trig_Functions_Inline(pAngles[i]);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+#endif /* MC_BOARD_CORDIC */
+
 /**
   * @brief  This function codify a floting point number into the relative
   *         32bit integer.
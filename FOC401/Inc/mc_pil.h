@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file    mc_pil.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Processor in the loop run of the current controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_PIL_H
+#define MC_PIL_H
+
+#include "mc_type.h"
+
+/* The processor in the loop mode is built when MC_PIL_MODE is added to the preprocessor
+   symbols of the build configuration. It is switched on in the IDLE state by writing
+   MC_PIL_CMD_ON in the MC_REG_PIL_STATE register. From then on, the plant model runs on
+   the host, without any motor or power stage:
+
+   - the host writes the MC_Pil_Input_t of a step in MC_REG_PIL_FRAME;
+   - once every MC_REG_PIL_STEP_RATE FOC periods, the high frequency task runs
+     FOC_CurrControllerM1 in real time with the phase currents, the angle and the speed
+     of the last frame instead of the measured ones, and skips it in the other periods;
+   - the host reads the MC_Pil_Output_t of the step in MC_REG_PIL_FRAME, then computes
+     the next currents with the applied voltage.
+
+   The bus voltage of the frames replaces the measured one, so that the state machine
+   and the speed loop run as with a motor. A step that finds no new frame waits for it,
+   and the periods it waits are counted. */
+
+/* Default number of FOC periods per step */
+#ifndef MC_PIL_STEP_RATE
+#define MC_PIL_STEP_RATE      40U
+#endif
+
+/* Commands written in MC_REG_PIL_STATE */
+#define MC_PIL_CMD_OFF        0U
+#define MC_PIL_CMD_ON         1U
+
+/* MC_Pil_Output_t::bVector when no finite set vector is applied */
+#define MC_PIL_NO_VECTOR      0xFFU
+
+/* Bits of MC_Pil_Output_t::bFlags */
+#define MC_PIL_FLAG_PCC       0x01U   /* Regulated by the predictive controller */
+
+typedef enum
+{
+  MC_PIL_OFF,
+  MC_PIL_ON
+} MC_Pil_State_t;
+
+/* Inputs of one step, written by the host */
+typedef struct
+{
+  uint16_t hSeq;                    /* Returned with the outputs of the step */
+  int16_t  hIa;                     /* Phase currents of the plant, s16A digits */
+  int16_t  hIb;
+  int16_t  hElAngle;                /* Angle of the Park transformation */
+  int16_t  hElSpeedDpp;             /* Electrical speed given to the regulation */
+  uint16_t hBusVoltage_d;           /* Bus voltage, in u16Volts */
+} MC_Pil_Input_t;
+
+/* Outputs of the last step, read by the host */
+typedef struct
+{
+  uint16_t hSeq;                    /* hSeq of the inputs of the step */
+  int16_t  hVq;                     /* Voltage applied, limited by the circle limitation */
+  int16_t  hVd;
+  int16_t  hValpha;
+  int16_t  hVbeta;
+  uint8_t  bVector;                 /* Switching state of the finite set vector */
+  uint8_t  bFlags;                  /* MC_PIL_FLAG_xxx */
+  uint16_t hCycles;                 /* Execution time of FOC_CurrControllerM1, CPU cycles */
+  uint16_t hLatePeriods;            /* FOC periods waited for the frames since MC_PIL_CMD_ON */
+} MC_Pil_Output_t;
+
+bool MC_Pil_Command(uint8_t bCmd);
+MC_Pil_State_t MC_Pil_GetState(void);
+void MC_Pil_SetStepRate(uint16_t hStepRate);
+uint16_t MC_Pil_GetStepRate(void);
+bool MC_Pil_Push(const MC_Pil_Input_t *pInput);
+void MC_Pil_GetOutput(MC_Pil_Output_t *pOutput);
+uint16_t MC_Pil_GetBusVoltage(void);
+bool MC_Pil_IsHolding(void);
+const MC_Pil_Input_t *MC_Pil_StartStep(void);
+void MC_Pil_EndStep(qd_t Vqd, alphabeta_t Valphabeta, uint8_t bVector, uint8_t bFlags);
+
+#endif /* MC_PIL_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************
+  * @file    mc_plant.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Plant model of the motor for the closed loop runs of the controllers
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_PLANT_H
+#define MC_PLANT_H
+
+#include "mc_type.h"
+
+/* The plant model is built with MC_BENCH_MODE, for the closed loop scenarios of the
+   benchmark, and in the software in the loop build of the controllers (MC_SIL), where
+   it also produces the phase currents given to the Clarke transformation.
+
+   It integrates the q/d currents of a surface PMSM turning at an imposed speed, built
+   from the parameters of the drive: resistive decay, voltage step and back-EMF step per
+   FOC period, and the rotation of the frame during the period. The currents are in s16A
+   digits and the voltages in s16V digits, as the controllers see them. The resistance and
+   the inductance of the plant are given per unit of the ones of the drive, so that the
+   controllers can be run with a model mismatch. */
+
+typedef struct
+{
+  float_t fIq;                      /* Currents, s16A digits */
+  float_t fId;
+  float_t fKDecay;                  /* Current kept per FOC period */
+  float_t fKVolt;                   /* Current step per voltage digit, at the nominal bus */
+  float_t fKBemf;                   /* Current step per dpp of the back-EMF */
+  float_t fBusScale;                /* Bus voltage, per unit of the nominal one */
+  int16_t hElAngle;                 /* Electrical angle at the start of the period */
+  int16_t hElSpeedDpp;              /* Imposed electrical speed */
+} MC_Plant_t;
+
+void MC_Plant_Init(MC_Plant_t *pPlant, float_t fRsScale, float_t fLsScale);
+void MC_Plant_SetBusScale(MC_Plant_t *pPlant, float_t fBusScale);
+void MC_Plant_SetSpeed(MC_Plant_t *pPlant, int16_t hElSpeedDpp);
+qd_t MC_Plant_GetIqd(const MC_Plant_t *pPlant);
+ab_t MC_Plant_GetIab(const MC_Plant_t *pPlant);
+void MC_Plant_Step(MC_Plant_t *pPlant, qd_t Vqd);
+
+#endif /* MC_PLANT_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
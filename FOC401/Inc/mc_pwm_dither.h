@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************
+  * @file    mc_pwm_dither.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Dithering of the PWM carrier frequency
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_PWM_DITHER_H
+#define MC_PWM_DITHER_H
+
+#include "mc_type.h"
+
+/* The carrier dithering is built when MC_PWM_DITHER_MODE is added to the preprocessor
+   symbols of the build configuration. While the space vector modulation writes the duty
+   cycles, the high frequency task draws the auto reload of TIM1 of the next PWM period
+   from a 16-bit LFSR, from the nominal half period up to MC_PWM_DITHER_SPAN counts above
+   it. It is loaded with the duty cycles at the next update event: the energy of the
+   carrier harmonics is spread over a band instead of a line.
+
+   The auto reload is only made longer, so that the sampling points of the current
+   sensing, computed for the nominal period, are still reached by the counter. The duty
+   cycles are not rescaled: the voltage applied is up to MC_PWM_DITHER_SPAN over the half
+   period lower, that the current regulators absorb, and the FOC period is
+   MC_PWM_DITHER_SPAN / 2 counts longer on average. The vectors of PCC_FINITE_SET and the
+   dwell times of PCC_FULL_HEXAGON need the compare at the auto reload for a phase on over
+   the whole period: they are applied with the nominal period, as every write of the duty
+   cycles outside of the FOC period. Exclusive with MC_PWM_SYNC_MODE, that also writes the
+   auto reload of TIM1. */
+
+/* Largest lengthening of the auto reload of TIM1, in timer counts, 1/32 of the half
+   period by default */
+#ifndef MC_PWM_DITHER_SPAN
+#define MC_PWM_DITHER_SPAN      ((uint32_t)PWM_PERIOD_CYCLES / 64U)
+#endif
+
+void MC_PwmDither_Init(void);
+void MC_PwmDither_Next(void);
+void MC_PwmDither_Stop(void);
+
+#endif /* MC_PWM_DITHER_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
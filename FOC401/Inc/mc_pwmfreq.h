@@ -0,0 +1,70 @@
+/**
+  ******************************************************************************
+  * @file    mc_pwmfreq.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Change of the PWM frequency at run time
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_PWMFREQ_H
+#define MC_PWMFREQ_H
+
+#include "mc_type.h"
+
+/* The change of the PWM frequency is built when MC_PWMFREQ_MODE is added to the
+   preprocessor symbols of the build configuration. MC_REG_PWM_FREQUENCY returns the
+   frequency in use, in Hz, and changes it when it is written in the IDLE state with a
+   frequency from MC_PWMFREQ_MIN_HZ to MC_PWMFREQ_MAX_HZ. The change is applied by the
+   medium frequency task with the PWM off, and recomputes what the build derives from
+   PWM_FREQUENCY:
+
+   - the auto reload of TIM1, the period of the PWM driver, the compare value of the
+     switching states and the bootstrap refresh periods, with the macros of
+     parameters_conversion.h that define the ones of the build;
+   - the measurement frequency of the speed and position sensors and the transition
+     steps of the virtual sensor, and the frequency of the extended ramp;
+   - the gains that are a continuous gain times the period: the integral gains of the
+     current PIs, the gains of the state observer and the proportional gain of its PLL.
+     The integral gain of the PLL follows the square of the period;
+   - the model of the predictive current controller, and the nominal model of its
+     estimator.
+
+   The gains in use are scaled, so that a tuning made at run time or by a profile is
+   kept. A frequency that would scale a gain out of its range is refused. The profiles of
+   mc_profile are made for the frequency of the build: they are applied as stored. The
+   counts of periods of the predictive controller, the dead time drop it compensates,
+   the timing of the current sampling and the instrumentation that converts periods to
+   time (mc_perf, mc_fra, mc_spectrum, mc_bench, mc_abtest) keep the values of the
+   build. The speed loop and the medium frequency task are clocked by the SysTick and do
+   not depend on the PWM frequency.
+
+   The carrier lock, the dithering, the time base and the HFI sensor derive the PWM
+   period at build time, and are not built with MC_PWMFREQ_MODE. */
+
+#ifndef MC_PWMFREQ_MIN_HZ
+#define MC_PWMFREQ_MIN_HZ           ((uint32_t)PWM_FREQUENCY / 4U)
+#endif
+/* The time budget of the FOC is the one of the build */
+#ifndef MC_PWMFREQ_MAX_HZ
+#define MC_PWMFREQ_MAX_HZ           ((uint32_t)PWM_FREQUENCY)
+#endif
+
+uint32_t MC_PwmFreq_Get(void);
+bool MC_PwmFreq_Check(uint32_t wFrequency);
+
+/* Medium frequency task, in the IDLE state with the PWM switched off */
+bool MC_PwmFreq_Apply(uint32_t wFrequency);
+
+#endif /* MC_PWMFREQ_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,76 @@
+/**
+  ******************************************************************************
+  * @file    mc_warmboot.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   State of the drive kept across a warm reset
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_WARMBOOT_H
+#define MC_WARMBOOT_H
+
+#include "mc_type.h"
+#include "mc_interface.h"
+#include "pwm_curr_fdbk.h"
+
+/* The warm boot is built when MC_WARMBOOT_MODE is added to the preprocessor symbols of
+   the build configuration. The medium frequency task keeps a record of the state of
+   the drive in the backup registers of the RTC, from MC_WARMBOOT_BKP_FIRST on, that
+   the resets other than the power on do not clear: the current offsets, and while the
+   drive runs without fault the control mode and the last speed or torque ramp. The
+   record is written when it changes, with a CRC.
+
+   After a watchdog, software or brownout reset, MCboot restores the offsets, so that
+   no offset measurement is run, and a drive that was running is started again: the
+   flying start catches the coasting rotor and the loop is closed without rev-up, then
+   the ramp ends at the reference of the record. The angle of the rotor is lost during
+   the reset and the state observer locks onto it again from the back-EMF. The drive is
+   not started again by more than MC_WARMBOOT_MAX_RESUMES warm boots in a row that did
+   not run MC_WARMBOOT_STABLE_MS since, so that a fault of the firmware does not restart
+   the motor forever. A reset of the NRST pin alone is a cold boot.
+
+   The start needs the flying start of a sensorless build: with an encoder or the HFI
+   sensor, only the offsets are restored. MC_WARMBOOT_NO_BOR makes a brownout reset a
+   cold boot, for boards with a battery on VBAT, where a power cycle is seen as a
+   brownout. The kind of the last boot is read with MC_REG_WARMBOOT. */
+
+#ifndef MC_WARMBOOT_BKP_FIRST
+#define MC_WARMBOOT_BKP_FIRST       0U
+#endif
+#ifndef MC_WARMBOOT_MAX_RESUMES
+#define MC_WARMBOOT_MAX_RESUMES     3U
+#endif
+#ifndef MC_WARMBOOT_STABLE_MS
+#define MC_WARMBOOT_STABLE_MS       1000U
+#endif
+
+/* Layout of MC_REG_WARMBOOT */
+typedef enum
+{
+  MC_WARMBOOT_COLD = 0,     /*!< Power on, pin reset, or no valid record */
+  MC_WARMBOOT_OFFSETS,      /*!< Offsets restored, the drive was not running */
+  MC_WARMBOOT_RESUMED,      /*!< Offsets restored and drive started again */
+  MC_WARMBOOT_HELD          /*!< Offsets restored, the drive was running but is left
+                                 in IDLE, after MC_WARMBOOT_MAX_RESUMES resumes or
+                                 without flying start */
+} MC_WarmBoot_Kind_t;
+
+bool MC_WarmBoot_Restore(MCI_Handle_t *pMCI, PWMC_Handle_t *pPWMC);
+MC_WarmBoot_Kind_t MC_WarmBoot_GetKind(void);
+
+/* Medium frequency task */
+void MC_WarmBoot_Save(MCI_Handle_t *pMCI, PWMC_Handle_t *pPWMC);
+
+#endif /* MC_WARMBOOT_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
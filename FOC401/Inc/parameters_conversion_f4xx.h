@@ -39,11 +39,20 @@
 #define ADC1_2  ADC1
 
 /*************************  IRQ Handler Mapping  *********************/
+#define SPD_TIM_M1_IRQHandler TIM2_IRQHandler
 #define TIMx_UP_M1_IRQHandler TIM1_UP_TIM10_IRQHandler
 #define DMAx_R1_M1_IRQHandler DMA2_Stream5_IRQHandler
 #define DMAx_R1_M1_Stream     DMA2_Stream5
 #define TIMx_BRK_M1_IRQHandler TIM1_BRK_TIM9_IRQHandler
 
+/*************************  Regular conversions scan  ****************/
+/* DMA stream of the regular conversion manager, the ADC1 request of DMA2 is on the
+   channel 0 of the streams 0 and 4. The MCP link uses the streams 5 and 6 of DMA1 */
+#define RCM_DMA          DMA2
+#define RCM_DMA_CLOCK    LL_AHB1_GRP1_PERIPH_DMA2
+#define RCM_DMA_STREAM   LL_DMA_STREAM_0
+#define RCM_DMA_CHANNEL  LL_DMA_CHANNEL_0
+
 /**********  AUXILIARY TIMER (SINGLE SHUNT) *************/
 /* Defined here for legacy purposes */
 #define R1_PWM_AUX_TIM                  TIM4
@@ -51,12 +60,50 @@
 /*************************  ADC Physical characteristics  ************/
 #define ADC_TRIG_CONV_LATENCY_CYCLES 3
 #define ADC_SAR_CYCLES 12
+/* Twice the ADC clock cycles of the sampling times 3 to 480 of the SMPR registers */
+#define ADC_SMP_CYCLES_X2 {6U, 30U, 56U, 112U, 168U, 224U, 288U, 960U}
 
 #define M1_VBUS_SW_FILTER_BW_FACTOR      10u
 
-#define MCP_RX_SYNC_PAYLOAD_MAX 256
-#define MCP_TX_SYNC_PAYLOAD_MAX 256
-#define MCP_TX_ASYNC_PAYLOAD_MAX_A 2048
+/* Payloads of the MCP link */
+#include "mc_ram_budget.h"
+
+/* Baud rate of the MCP link over UART_A, up to 6 Mbit/s. The Motor Control Workbench or the
+   Motor Pilot must be set to the same rate. Above the kernel clock of the USART divided by 16,
+   the USART oversamples by 8 */
+#define MCP_UART_BAUDRATE_A     1843200U
+#define MCP_UART_CLOCK_A        (SYSCLK_FREQ / 2U) /* USART2 is clocked by PCLK1, equal to SYSCLK_FREQ / 2 */
+#define MCP_UART_OVERSAMPLING_A ((MCP_UART_BAUDRATE_A > (MCP_UART_CLOCK_A / 16U)) ? UART_OVERSAMPLING_8 \
+                                                                                : UART_OVERSAMPLING_16)
+#if (MCP_UART_BAUDRATE_A > 6000000U) || (MCP_UART_BAUDRATE_A > (MCP_UART_CLOCK_A / 8U))
+#error "MCP_UART_BAUDRATE_A is out of the range of the USART"
+#endif
+
+/* The STM32F401 has no CCM SRAM: the functions of the .ccmram section would be linked in a
+   memory that does not exist. CCMRAM is only for the G4 ports */
+#if defined (CCMRAM)
+#error "CCMRAM must not be defined on the STM32F401, it has no CCM SRAM"
+#endif
+
+/* The second sampling window of PWM_DOUBLE_UPDATE is the combined 3-phase PWM of TIM1 CH5,
+   that the STM32F401 does not have */
+#if defined (PWM_DOUBLE_UPDATE)
+#error "PWM_DOUBLE_UPDATE is only for the G4 ports"
+#endif
+
+/* PID_FMAC computes the PI regulators with the FMAC of the STM32G4 */
+#if defined (PID_FMAC)
+#error "PID_FMAC is only for the G4 ports"
+#endif
+
+/* When RAMFUNC is added to the preprocessor symbols of the build configuration, the same
+   functions are declared __RAM_FUNC instead: GCC puts them in the .RamFunc section, that the
+   STM32CubeIDE linker script places in .data, copied to SRAM by the startup code with the
+   initialized variables. The high frequency task then runs without flash wait states nor
+   ART cache misses, whatever the main loop has evicted from the 1 Kbyte instruction cache.
+   The flash prefetch and the instruction and data caches of the ART accelerator stay enabled
+   by HAL_Init() for the rest of the code and for the constant tables read by the task. With
+   the ARM compiler __RAM_FUNC is empty, the functions are placed in SRAM by the scatter file */
 
 #endif /*__PARAMETERS_CONVERSION_F4XX_H*/
 
@@ -32,6 +32,7 @@
 #define RS                     0.65 /* Stator resistance , ohm*/
 #define LS                     0.000360 /* Stator inductance, H
                                                  For I-PMSM it is equal to Lq */
+#define LD_LQ_RATIO            1.000 /* Ld vs Lq ratio */
 
 /* When using Id = 0, NOMINAL_CURRENT is utilized to saturate the output of the
    PID for speed regulation (i.e. reference torque).
@@ -34,6 +34,15 @@
                                                          by HW if low side signals
                                                          are not used */
 
+/*********** Bootstrap refresh, PWMC_BOOT_REFRESH *********/
+#define BOOT_REFRESH_MAX_HIGH_US      1000 /*!< Longest time a high side
+                                                         stays on without its low
+                                                         side */
+#define BOOT_REFRESH_LOW_NS           500 /*!< Low side on time that
+                                                         recharges a bootstrap
+                                                         capacitor, past the dead
+                                                         time */
+
 /*********** Bus voltage sensing section ****************/
 #define VBUS_PARTITIONING_FACTOR      0.0522 /*!< It expresses how
                                                        much the Vbus is attenuated
@@ -85,6 +85,9 @@ void RCM_ExecUserConv(void);
 /* return the state of the user conversion state machine*/
 RCM_UserConvState_t RCM_GetUserConvState(void);
 
+/* non blocking function to start the DMA scan of the registered conversions, called by MC_TASK */
+void RCM_StartRegularScan(void);
+
 /**
   * @}
   */
@@ -0,0 +1,110 @@
+/**
+  ******************************************************************************
+  * @file    loss_minimization.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          Loss Minimization component of the Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup LossMinimization
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LOSS_MINIMIZATION_H
+#define LOSS_MINIMIZATION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup LossMinimization
+  * @{
+  */
+
+/**
+  * @brief Handle of a Loss Minimization component
+  *
+  * @detail Perturb and observe search of the d current offset that minimizes
+  * the electrical power drawn by the motor at a given speed and load. The speed
+  * loop holds the mechanical power, so the power that the offset saves is loss.
+  */
+typedef struct
+{
+  int16_t  hIdStep;           /*!< Step of the d current offset, in s16A */
+  int16_t  hIdMax;            /*!< Largest magnitude of the d current offset,
+                                   in s16A */
+  int16_t  hLightLoadIq;      /*!< Magnitude of the q current reference up to
+                                   which the search runs, in s16A */
+  int16_t  hLoadBand;         /*!< Change of the q current reference that
+                                   discards a measurement, in s16A */
+  int16_t  hMinSpeedUnit;     /*!< Average mechanical speed magnitude from
+                                   which the search runs, in SPEED_UNIT */
+  uint16_t hSettlePeriods;    /*!< Medium frequency periods waited after a
+                                   step, before the power is averaged */
+  uint16_t hAvgPeriods;       /*!< Medium frequency periods of the average
+                                   of the power */
+
+  int16_t  hIdOffset;         /*!< d current offset, in s16A */
+  int16_t  hDirection;        /*!< Sign of the next step, 1 or -1 */
+  int16_t  hIqWindow;         /*!< q current reference at the start of the
+                                   measurement */
+  uint16_t hCount;            /*!< Medium frequency periods since the last
+                                   step */
+  int32_t  wPowerSum;         /*!< Sum of the power of the measurement, in mW */
+  int32_t  wLastPower_mW;     /*!< Average power measured after the previous
+                                   step, in mW */
+  bool     LastPowerValid;    /*!< True when wLastPower_mW was measured at the
+                                   present operating point */
+  bool     Searching;         /*!< True while the operating point is in the
+                                   search range */
+} LMN_Handle_t;
+
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------- */
+
+/* Initializes the search with no d current offset */
+void LMN_Init(LMN_Handle_t *pHandle);
+
+/* Returns the d current offset to zero at once, before a restart */
+void LMN_Clear(LMN_Handle_t *pHandle);
+
+/* Updates the search, once per medium frequency period in RUN */
+void LMN_Update(LMN_Handle_t *pHandle, int32_t wPower_mW, int16_t hIqref, int16_t hAvrgMecSpeedUnit);
+
+/* Returns the d current offset to add to the reference, in s16A */
+int16_t LMN_GetIdOffset(const LMN_Handle_t *pHandle);
+
+/* Returns true while the operating point is in the search range */
+bool LMN_IsSearching(const LMN_Handle_t *pHandle);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* LOSS_MINIMIZATION_H */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
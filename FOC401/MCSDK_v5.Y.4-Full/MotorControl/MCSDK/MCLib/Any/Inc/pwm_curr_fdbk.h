@@ -48,11 +48,30 @@ extern "C" {
 #define SECTOR_6  5U
 #define SQRT3FACTOR ((uint16_t)0xDDB4) /* = (16384 * 1.732051 * 2)*/
 
+/* Points of a phase in the dead time compensation table of PWMC_SetDeadTimeLut(),
+   at 0 to PWMC_DTCOMP_LUT_POINTS - 1 current steps */
+#define PWMC_DTCOMP_LUT_POINTS 9U
+
 /* Exported types ------------------------------------------------------------*/
 
 /** @brief PWM & Current Sensing component handle type */
 typedef struct PWMC_Handle PWMC_Handle_t;
 
+/**
+  * @brief Timing of the current sampling of the components that support
+  *        PWMC_SetSamplingTiming(), in place of the constants of their parameters.
+  */
+typedef struct
+{
+  uint16_t hTafter;      /**< Delay of the trigger after the edge of the phase with the
+                              largest compare value, in timer clock cycles */
+  uint16_t hTbefore;     /**< Advance of the trigger before this edge, in timer clock
+                              cycles: sampling and conversions of the injected sequence */
+  uint8_t  bSampleTime;  /**< Sampling time of the current channels, value of their SMP
+                              field in the SMPR registers of the ADC */
+  uint8_t  bReserved;
+} PWMC_SampTiming_t;
+
 /**
   * @brief Pointer on callback functions used by PWMC components
   *
@@ -153,6 +172,15 @@ typedef void (*PWMC_SetOffsetCalib_Cb_t)(PWMC_Handle_t *pHandle, PolarizationOff
   */
 typedef void (*PWMC_GetOffsetCalib_Cb_t)(PWMC_Handle_t *pHandle, PolarizationOffsets_t *offsets);
 
+/**
+  * @brief Pointer on the function provided by the PMWC component instance to set the timing
+  *        of the current sampling.
+  *
+  * (See PWMC_Handle::pFctSetSamplingTiming).
+  *
+  */
+typedef bool (*PWMC_SetSampTiming_Cb_t)(PWMC_Handle_t *pHandle, const PWMC_SampTiming_t *pTiming);
+
 /**
   * @brief This structure is used to handle the data of an instance of the PWM & Current Feedback component
   *
@@ -173,6 +201,10 @@ struct PWMC_Handle
   pFctTurnOnLowSides;                        /**< pointer on the function the component instance uses to turn low sides on */
   PWMC_SetSampPointSectX_Cb_t
   pFctSetADCSampPointSectX;                  /**< pointer on the function the component instance uses to set the ADC sampling point */
+  PWMC_SetSampPointSectX_Cb_t
+  pFctSetADCSampPointState;                  /**< pointer on the function the component instance uses to set the ADC sampling point
+                                                  of a switching state applied by PWMC_SetSwitchingState(). MC_NULL for
+                                                  pFctSetADCSampPointSectX */
   PWMC_OverCurr_Cb_t
   pFctIsOverCurrentOccurred;                 /**< pointer on the fct the component instance uses to return the over current status */
   PWMC_SetOcpRefVolt_Cb_t
@@ -188,6 +220,9 @@ struct PWMC_Handle
   pFctSetOffsetCalib;                        /**< pointer on the fct the component instance uses to set the calibrated offsets */
   PWMC_GetOffsetCalib_Cb_t
   pFctGetOffsetCalib;                        /**< pointer on the fct the component instance uses to get the calibrated offsets */
+  PWMC_SetSampTiming_Cb_t
+  pFctSetSamplingTiming;                     /**< pointer on the fct the component instance uses to set the timing of the
+                                                  current sampling, MC_NULL if it only uses the one of its parameters */
   /** @} */
 #ifdef FASTDIV   
   FastDiv_Handle_t fd;
@@ -222,6 +257,22 @@ struct PWMC_Handle
   uint16_t DTCompCnt;                                  /**< Half of Dead time expressed
                                                           *  in timer clock cycles unit:
                                                           *  @f$hDTCompCnt = (DT_s \cdot TimerFreq_{CLK})/2@f$ */
+  const uint16_t *pDTCompLut;                          /**< Dead time compensation of each phase versus its
+                                                          *  absolute current, #PWMC_DTCOMP_LUT_POINTS points
+                                                          *  per phase in timer clock cycles unit, or MC_NULL
+                                                          *  for DTCompCnt at any current */
+  uint8_t DTCompLutShift;                              /**< Current step of pDTCompLut, 2^DTCompLutShift digits */
+  uint16_t StateHighCnt;                               /**< Compare value of the phases with their high side on
+                                                          *  in a switching state applied by PWMC_SetSwitchingState() */
+  uint16_t BootRefreshPeriods;                         /**< Periods of a high side on over the whole period
+                                                          *  after which PWMC_SetDwellTimes() turns its low side
+                                                          *  on, with #PWMC_BOOT_REFRESH */
+  uint16_t BootRefreshCnt;                             /**< Lowering of the compare values that turns a low
+                                                          *  side on for the refresh of its bootstrap capacitor */
+  uint16_t BootHighPeriods[3];                         /**< Consecutive periods of each high side on over the
+                                                          *  whole period */
+  PWMC_SampTiming_t SampTiming;                        /**< Timing of the current sampling, initialized by the
+                                                          *  component from its parameters */
   uint16_t  Ton;                                       /**< Reserved */
   uint16_t  Toff;                                      /**< Reserved */
 
@@ -234,6 +285,9 @@ struct PWMC_Handle
   bool      RLDetectionMode;                           /**< true if enabled, false if disabled. */
   bool offsetCalibStatus;                              /**< true if offset calibration completed, false otherwise. */
   volatile  bool      useEstCurrent;                   /**< estimated current flag */
+  bool EdgeSampling;                                   /**< true to sample after the edge of the phase with the
+                                                          *  largest compare value even when the middle of the
+                                                          *  period is possible, for the calibration of hTafter */
 
 };
 
@@ -253,6 +307,13 @@ void PWMC_GetPhaseCurrents(PWMC_Handle_t *pHandle, ab_t *Iab);
 /*  Converts input voltage components Valfa, beta into duty cycles and feed it to the inverter */
 uint16_t PWMC_SetPhaseVoltage(PWMC_Handle_t *pHandle, alphabeta_t Valfa_beta);
 
+/* Applies one inverter switching state, without space vector modulation */
+uint16_t PWMC_SetSwitchingState(PWMC_Handle_t *pHandle, uint8_t bState);
+
+/* Applies two adjacent switching states during their dwell times, up to the vertices of the hexagon */
+uint16_t PWMC_SetDwellTimes(PWMC_Handle_t *pHandle, uint8_t bStateA, uint8_t bStateB,
+                            uint16_t hDwellA, uint16_t hDwellB);
+
 /* Switches the PWM generation off, setting the outputs to inactive */
 void PWMC_SwitchOffPWM(PWMC_Handle_t *pHandle);
 
@@ -319,6 +380,18 @@ uint16_t PWMC_RLDetectionModeSetDuty(PWMC_Handle_t *pHandle, uint16_t hDuty);
 /* It is used to set the align motor flag.*/
 void PWMC_SetAlignFlag(PWMC_Handle_t *pHandle, uint8_t flag);
 
+/* Sets the table of the dead time compensation versus the phase currents. */
+void PWMC_SetDeadTimeLut(PWMC_Handle_t *pHandle, const uint16_t *pLut, uint8_t bShift);
+
+/* Sets the timing of the current sampling, if the component supports it. */
+bool PWMC_SetSamplingTiming(PWMC_Handle_t *pHandle, const PWMC_SampTiming_t *pTiming);
+
+/* Returns the timing of the current sampling in use. */
+const PWMC_SampTiming_t *PWMC_GetSamplingTiming(const PWMC_Handle_t *pHandle);
+
+/* Forces the sampling after the edge of the phase with the largest compare value. */
+void PWMC_SetEdgeSampling(PWMC_Handle_t *pHandle, bool Enable);
+
 /* Sets the Callback that the PWMC component shall invoke to get phases current. */
 void PWMC_RegisterGetPhaseCurrentsCallBack(PWMC_GetPhaseCurr_Cb_t pCallBack, PWMC_Handle_t *pHandle);
 
@@ -362,6 +435,10 @@ void PWMC_Clear(PWMC_Handle_t *pHandle);
 /* It converts input currents components Iqd into estimated currents Ia, Ib and Ic */
 void PWMC_CalcPhaseCurrentsEst(PWMC_Handle_t *pHandle, qd_t Iqd, int16_t hElAngledpp);
 
+/* It converts the currents predicted for the next sampling Iqd into estimated currents
+   Ia, Ib and Ic, without filter */
+void PWMC_SetPhaseCurrentsEst(PWMC_Handle_t *pHandle, qd_t Iqd, int16_t hElAngledpp);
+
 /* It converts input voltage components Valfa, beta into duty cycles
    and feed it to the inverter with Over modulation function */
 uint16_t PWMC_SetPhaseVoltage_OVM(PWMC_Handle_t *pHandle, alphabeta_t Valfa_beta);
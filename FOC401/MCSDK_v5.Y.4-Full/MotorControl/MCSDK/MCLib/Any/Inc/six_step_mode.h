@@ -0,0 +1,117 @@
+/**
+  ******************************************************************************
+  * @file    six_step_mode.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          Six-Step Mode component of the Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup SixStepMode
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SIX_STEP_MODE_H
+#define SIX_STEP_MODE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup SixStepMode
+  * @{
+  */
+
+/* Number of vertices of the hexagon */
+#define SSM_NB_VERTICES     6U
+
+/**
+  * @brief Handle of a Six-Step Mode component
+  *
+  * @detail At the top of the speed range, once the voltage requested by the
+  * current controller stays on the voltage limit, the inverter holds the vertex
+  * of the hexagon nearest to the request over whole PWM periods: the legs only
+  * commute when the vertex changes, six times per electrical revolution.
+  */
+typedef struct
+{
+  int16_t  hMinSpeedDpp;      /*!< Electrical speed magnitude from which the
+                                   mode is entered, in dpp */
+  int16_t  hExitSpeedDpp;     /*!< Electrical speed magnitude below which the
+                                   mode is left, in dpp */
+  uint16_t hEnterRatio;       /*!< Part of the voltage limit from which the
+                                   request is saturated, Q15 */
+  uint16_t hExitRatio;        /*!< Part of the voltage limit below which the
+                                   request leaves the mode, Q15 */
+  uint16_t hEnterPeriods;     /*!< Periods of saturated request before the
+                                   mode is entered */
+  uint8_t  bFilterShift;      /*!< The request is averaged over 2^bFilterShift
+                                   periods */
+  uint8_t  bHystShift;        /*!< A vertex is left once the next one is nearer
+                                   by 2^-bHystShift of its projection */
+
+  int32_t  wVqSum;            /*!< Running means of the q and d voltages */
+  int32_t  wVdSum;            /*!< requested, times 2^bFilterShift */
+  uint16_t hSatCount;         /*!< Consecutive periods of saturated request */
+  uint16_t hEntries;          /*!< Times the mode was entered, wraps around */
+  uint8_t  bVertex;           /*!< Vertex applied, SSM_NB_VERTICES for none */
+  bool     Active;            /*!< True while the vertices are applied */
+} SSM_Handle_t;
+
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------- */
+
+/* Initializes the component, out of the mode */
+void SSM_Init(SSM_Handle_t *pHandle);
+
+/* Leaves the mode and clears the mean request, before a restart */
+void SSM_Clear(SSM_Handle_t *pHandle);
+
+/* Averages the request and enters or leaves the mode, from the high frequency task */
+bool SSM_Update(SSM_Handle_t *pHandle, qd_t Vqd, uint16_t hMaxModule, int16_t hElSpeedDpp);
+
+/* Returns the mean voltage requested */
+qd_t SSM_GetRequest(const SSM_Handle_t *pHandle);
+
+/* Selects the vertex nearest to the requested voltage and returns its switching state */
+uint8_t SSM_SelectVertex(SSM_Handle_t *pHandle, alphabeta_t Vab);
+
+/* Returns the voltage of the vertex applied */
+alphabeta_t SSM_GetVoltage(const SSM_Handle_t *pHandle);
+
+/* Returns true while the vertices are applied */
+bool SSM_IsActive(const SSM_Handle_t *pHandle);
+
+/* Returns the number of times the mode was entered */
+uint16_t SSM_GetEntries(const SSM_Handle_t *pHandle);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* SIX_STEP_MODE_H */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
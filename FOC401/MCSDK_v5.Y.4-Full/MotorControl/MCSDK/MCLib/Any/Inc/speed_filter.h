@@ -0,0 +1,133 @@
+/**
+  ******************************************************************************
+  * @file    speed_filter.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          Speed Filter Bank component of the Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup SpeedFilterBank
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SPEED_FILTER_H
+#define SPEED_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup SpeedFilterBank
+  * @{
+  */
+
+/* Largest number of biquads of the cascade */
+#define SFB_MAX_STAGES      4U
+
+/* Fractional bits of the coefficients: a notch needs |a1| up to 2 */
+#define SFB_COEF_SHIFT      14U
+
+/**
+  * @brief Coefficients of one biquad, Q14:
+  *        y = b0.x + b1.x[-1] + b2.x[-2] - a1.y[-1] - a2.y[-2]
+  */
+typedef struct
+{
+  int16_t hB0;
+  int16_t hB1;
+  int16_t hB2;
+  int16_t hA1;
+  int16_t hA2;
+} SFB_Coefs_t;
+
+/**
+  * @brief Cascade of biquads, also the layout of MC_REG_SPEED_FILTER
+  */
+typedef struct
+{
+  uint16_t    hNbStages;                /*!< Biquads applied, up to SFB_MAX_STAGES */
+  SFB_Coefs_t Stage[SFB_MAX_STAGES];    /*!< Coefficients, first applied first */
+} SFB_Bank_t;
+
+/**
+  * @brief Handle of a Speed Filter Bank component
+  *
+  * @detail The torque reference of the speed loop goes through a cascade of
+  * biquads, notch and low-pass, that attenuates it at the mechanical
+  * resonances, so that the speed loop gains can rise up to them.
+  */
+typedef struct
+{
+  uint16_t hSampleFreqHz;     /*!< Rate of SFB_Filter() calls, Hz */
+  uint16_t hNotchFreqHz;      /*!< Center of the notch designed by SFB_Init(),
+                                   Hz. 0 for none */
+  uint16_t hNotchWidthHz;     /*!< Width at -3 dB of the notch, Hz */
+  uint16_t hLowPassHz;        /*!< Cut-off of the second order low-pass
+                                   designed by SFB_Init(), Hz. 0 for none */
+
+  SFB_Bank_t Bank;            /*!< Cascade in use */
+  int16_t  hX[SFB_MAX_STAGES][2]; /*!< Last two inputs of each biquad */
+  int16_t  hY[SFB_MAX_STAGES][2]; /*!< Last two outputs of each biquad */
+  volatile SFB_Bank_t PendingBank; /*!< Cascade waiting for the next call of
+                                   SFB_Filter() */
+  volatile bool BankPending;  /*!< True while PendingBank has not been taken */
+} SFB_Handle_t;
+
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------- */
+
+/* Designs the cascade of the drive parameters and clears the filter */
+void SFB_Init(SFB_Handle_t *pHandle);
+
+/* Clears the inputs and outputs of the biquads */
+void SFB_Clear(SFB_Handle_t *pHandle);
+
+/* Filters one sample of the torque reference */
+int16_t SFB_Filter(SFB_Handle_t *pHandle, int16_t hInput);
+
+/* Holds the filter in the steady state of a value, while it is not applied */
+void SFB_Preload(SFB_Handle_t *pHandle, int16_t hValue);
+
+/* Requests a new cascade, taken by the next call of SFB_Filter() */
+bool SFB_SetBank(SFB_Handle_t *pHandle, const SFB_Bank_t *pBank);
+
+/* Returns the cascade in use */
+void SFB_GetBank(const SFB_Handle_t *pHandle, SFB_Bank_t *pBank);
+
+/* Designs a notch biquad */
+void SFB_DesignNotch(SFB_Coefs_t *pCoefs, uint16_t hSampleFreqHz, uint16_t hFreqHz, uint16_t hWidthHz);
+
+/* Designs a second order Butterworth low-pass biquad */
+void SFB_DesignLowPass(SFB_Coefs_t *pCoefs, uint16_t hSampleFreqHz, uint16_t hFreqHz);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* SPEED_FILTER_H */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,139 @@
+/**
+  ******************************************************************************
+  * @file    speed_mpc.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          Speed Predictive Control component of the Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup SpeedMPC
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SPEED_MPC_H
+#define SPEED_MPC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mc_type.h"
+#include "speed_torq_ctrl.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup SpeedMPC
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/**
+  * @brief Number of estimated parameters: torque, viscous friction and load terms
+  */
+#define SMPC_NB_PARAMS      3U
+
+/**
+  * @brief Largest prediction horizon, in medium frequency periods
+  */
+#define SMPC_MAX_HORIZON    32U
+
+/**
+  * @brief Handle of a Speed Predictive Control component
+  *
+  * @detail The mechanical model of the drive, over one medium frequency period,
+  * is:
+  *
+  * @f[
+  * \omega_{k+1} = \omega_{k} + b i_{q,k} - d \omega_{k} + c
+  * @f]
+  *
+  * where @f$ \omega @f$ is the mechanical speed in #SPEED_UNIT, b the torque
+  * constant over the inertia, d the viscous friction over the inertia and c the
+  * load and dry friction torques over the inertia. The three terms are
+  * estimated online by a recursive least squares algorithm, scaled by the
+  * nominal current, the maximum application speed and 1, so that they are of
+  * the same order in single precision floats.
+  */
+typedef struct
+{
+  uint8_t   bHorizon;             /**< Medium frequency periods predicted, up to
+                                       SMPC_MAX_HORIZON */
+  float_t   fMoveWeight;          /**< Weight of the change of the q current
+                                       reference, relative to the speed errors
+                                       over the horizon. 0 gives the step that
+                                       best tracks the speed reference */
+  float_t   fForgetting;          /**< Forgetting factor of the least squares,
+                                       between 0 and 1 */
+  float_t   fInitCovariance;      /**< Diagonal of the covariance matrix at
+                                       initialization, also the bound of its
+                                       mean diagonal */
+  float_t   fTorqueTermNom;       /**< Speed change over one period at the
+                                       nominal current, from the nominal
+                                       inertia, in #SPEED_UNIT */
+  int16_t   hNominalCurrent;      /**< Scale of the q current in the model, in
+                                       digits */
+  int16_t   hSpeedScale;          /**< Scale of the speed in the model, in
+                                       #SPEED_UNIT */
+  int16_t   hMinSpeedUnit;        /**< Absolute mechanical speed, in #SPEED_UNIT,
+                                       below which the model is not estimated */
+  float_t   fTheta[SMPC_NB_PARAMS]; /**< Scaled estimates of b, d and c */
+  float_t   fP[SMPC_NB_PARAMS][SMPC_NB_PARAMS]; /**< Covariance matrix */
+  int16_t   hPrevSpeedUnit;       /**< Speed of the previous call */
+  bool      PrevValid;            /**< False until a first call after a clear */
+  float_t   fInvIqScale;          /**< 1 / hNominalCurrent, set by SMPC_Init() */
+  float_t   fInvSpeedScale;       /**< 1 / hSpeedScale, set by SMPC_Init() */
+  float_t   fInvForgetting;       /**< 1 / fForgetting, set by SMPC_Init() */
+  float_t   fInvMoveDen;          /**< 1 / (1 + fMoveWeight), set by SMPC_Init() */
+} SMPC_Handle_t;
+
+/* Exported functions ------------------------------------------------------- */
+
+/*
+ * Initializes the handle and the estimates from the nominal model
+ */
+void SMPC_Init(SMPC_Handle_t *pHandle);
+
+/*
+ * Forgets the previous sample, before the speed loop is closed
+ */
+void SMPC_Clear(SMPC_Handle_t *pHandle);
+
+/*
+ * Runs one step of the estimation and returns the q current reference
+ */
+int16_t SMPC_CalcTorqueReference(SMPC_Handle_t *pHandle, SpeednTorqCtrl_Handle_t *pSTC, int16_t hIqApplied);
+
+/*
+ * Returns one of the scaled estimates of the model
+ */
+float_t SMPC_GetEstimate(const SMPC_Handle_t *pHandle, uint8_t bParam);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* SPEED_MPC_H */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
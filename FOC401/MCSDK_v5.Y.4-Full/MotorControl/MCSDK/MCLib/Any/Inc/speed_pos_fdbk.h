@@ -41,6 +41,14 @@ extern "C" {
   * @{
   */
 
+/* Exported constants --------------------------------------------------------*/
+/**
+  * @brief  Unit of the fractions of control period taken by SPD_GetElAngleAt():
+  *         SPD_PERIOD_FRACTION is one control period of the speed sensor
+  */
+#define SPD_PERIOD_FRACTION_POW2  8U
+#define SPD_PERIOD_FRACTION       256
+
 /* Exported types ------------------------------------------------------------*/
 /**
   * @brief  SpeednPosFdbk  handle definition
@@ -109,6 +117,8 @@ int16_t SPD_GetElSpeedDpp(const SpeednPosFdbk_Handle_t *pHandle);
 
 int16_t SPD_GetInstElSpeedDpp(const SpeednPosFdbk_Handle_t *pHandle);
 
+int16_t SPD_GetElAngleAt(const SpeednPosFdbk_Handle_t *pHandle, int16_t hFraction);
+
 bool SPD_Check(const SpeednPosFdbk_Handle_t *pHandle);
 
 bool SPD_IsMecSpeedReliable(SpeednPosFdbk_Handle_t *pHandle, const int16_t *pMecSpeedUnit);
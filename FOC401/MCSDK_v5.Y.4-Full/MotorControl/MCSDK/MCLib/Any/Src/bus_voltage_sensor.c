@@ -71,6 +71,8 @@ __weak uint16_t VBS_GetBusVoltage_d(const BusVoltageSensor_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It return latest averaged Vbus measurement expressed in u16Volt
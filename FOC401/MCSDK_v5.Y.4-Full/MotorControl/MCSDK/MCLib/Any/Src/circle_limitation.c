@@ -42,8 +42,12 @@
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 
+/* Series without a hardware divider only, the others compute the root, with the
+   CORDIC on the series that have one */
 #if defined CIRCLE_LIMITATION_SQRT_M0
 const uint16_t SqrtTable[1025] = SQRT_CIRCLE_LIMITATION;
 #endif
@@ -86,7 +90,7 @@ __weak qd_t Circle_Limitation(const CircleLimitation_Handle_t *pHandle, qd_t Vqd
         new_q = SqrtTable[square_temp];
 #else
         square_temp = square_limit - square_d;
-        new_q = MCM_Sqrt(square_temp);
+        new_q = MCM_CALL(MCM_Sqrt)(square_temp);
 #endif
         if (Vqd.q < 0)
         {
@@ -106,7 +110,7 @@ __weak qd_t Circle_Limitation(const CircleLimitation_Handle_t *pHandle, qd_t Vqd
         new_q = SqrtTable[square_temp];
 #else
         square_temp = square_limit - vd_square_limit;
-        new_q = MCM_Sqrt(square_temp);
+        new_q = MCM_CALL(MCM_Sqrt)(square_temp);
 #endif
         if (Vqd.q < 0)
         {
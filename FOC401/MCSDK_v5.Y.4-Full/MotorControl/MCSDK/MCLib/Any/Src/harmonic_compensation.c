@@ -0,0 +1,465 @@
+/**
+  ******************************************************************************
+  * @file    harmonic_compensation.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the Harmonic Compensation component of the Motor Control SDK:
+  *
+  *           * compensation of the back-EMF harmonics and of the cogging torque
+  *             by a table indexed by the electrical angle
+  *           * learning of the table at steady speed
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "harmonic_compensation.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/**
+  * @defgroup HarmonicCompensation Harmonic Compensation
+  * @brief Angle indexed compensation of the back-EMF harmonics and of the cogging torque
+  *
+  * Each period, the high frequency task loads the entry of the electrical angle
+  * of the Park transformation. Its voltage, scaled by the electrical speed, is
+  * the voltage of the back-EMF harmonics: it is added to the output of the PI
+  * controllers and to the back-EMF of the predictor. Its current, the current
+  * of the cogging torque, is added to the q current reference of both.
+  *
+  * The table is learned at steady speed, once HCM_CMD_LEARN is given. The
+  * running means of the applied voltage and of the q current reference are
+  * removed from their values of the period: what is left repeats with the
+  * angle, and moves the entry of the period by 2^-bLearnShift of its error. The
+  * voltage is brought back to hLearnSpeedDpp first. The compensation is applied
+  * while it is learned: the entries converge to the harmonics that the
+  * controllers would otherwise have to produce.
+  *
+  * @{
+  */
+
+/* Private defines -----------------------------------------------------------*/
+/* Largest ratio of the speed to hLearnSpeedDpp applied to the voltages, Q15 */
+#define HCM_MAX_GAIN        ((int32_t)16 << 15)
+
+/* Private functions ---------------------------------------------------------*/
+static inline int16_t HCM_Saturate(int32_t wValue)
+{
+  return ((int16_t)((wValue > (int32_t)INT16_MAX) ? (int32_t)INT16_MAX
+                  : ((wValue < -(int32_t)INT16_MAX) ? -(int32_t)INT16_MAX : wValue)));
+}
+
+/**
+  * @brief  Initializes the component, with no learning. The table is kept: it
+  *         holds either the values it is built with or the ones learned.
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  */
+__weak void HCM_Init(HCM_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->wLearnSpeedInv = (pHandle->hLearnSpeedDpp <= 0) ? 0
+                            : (int32_t)(((uint32_t)1 << 30U) / (uint32_t)pHandle->hLearnSpeedDpp);
+    pHandle->LearnRequested = false;
+    HCM_Clear(pHandle);
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+}
+
+/**
+  * @brief  Stops the learning until the next steady speed and restarts the
+  *         running means. The learning request and the table are kept.
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  */
+__weak void HCM_Clear(HCM_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->Learning = false;
+    pHandle->wLearnScale = 0;
+    pHandle->wVqSum = 0;
+    pHandle->wVdSum = 0;
+    pHandle->wIqSum = 0;
+    pHandle->hWarmup = (uint16_t)1 << pHandle->bMeanShift;
+    pHandle->Voltage.q = 0;
+    pHandle->Voltage.d = 0;
+    pHandle->hIqref = 0;
+    pHandle->bIndex = 0U;
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Loads the entry of the electrical angle of the period and scales its
+  *         voltage by the electrical speed. It must be called by the high
+  *         frequency task before the current controllers.
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  * @param  hElAngle electrical angle of the Park transformation of the period
+  * @param  hElSpeedDpp electrical speed, in dpp
+  */
+__weak void HCM_Update(HCM_Handle_t *pHandle, int16_t hElAngle, int16_t hElSpeedDpp)
+{
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    const HCM_Entry_t *pEntry;
+    int32_t wGain;
+
+    pHandle->bIndex = (uint8_t)((uint16_t)hElAngle >> HCM_ANGLE_SHIFT);
+    pEntry = &pHandle->Table[pHandle->bIndex];
+
+    /* The back-EMF harmonics are proportional to the speed, with its sign */
+    wGain = (int32_t)(((int64_t)hElSpeedDpp * (int64_t)pHandle->wLearnSpeedInv) >> 15);
+    wGain = (wGain > HCM_MAX_GAIN) ? HCM_MAX_GAIN : ((wGain < -HCM_MAX_GAIN) ? -HCM_MAX_GAIN : wGain);
+    pHandle->Voltage.q = HCM_Saturate((int32_t)(((int64_t)pEntry->hVq * wGain) >> 15));
+    pHandle->Voltage.d = HCM_Saturate((int32_t)(((int64_t)pEntry->hVd * wGain) >> 15));
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Adds the cogging current of the entry of the period to the q current
+  *         reference. The reference returned is the one learned by HCM_Learn().
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  * @param  Iqdref current references of the speed and torque controller
+  * @retval qd_t Current references of the current controllers
+  */
+__weak qd_t HCM_AddCurrent(HCM_Handle_t *pHandle, qd_t Iqdref)
+{
+  qd_t Iqdout = Iqdref;
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    Iqdout.q = HCM_Saturate((int32_t)Iqdref.q + (int32_t)pHandle->Table[pHandle->bIndex].hIq);
+    pHandle->hIqref = Iqdout.q;
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+  return (Iqdout);
+}
+
+/**
+  * @brief  Returns the voltage of the back-EMF harmonics of the period.
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  * @retval qd_t Voltage, in digits
+  */
+__weak qd_t HCM_GetVoltage(const HCM_Handle_t *pHandle)
+{
+  qd_t Vqd = {0, 0};
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    Vqd = pHandle->Voltage;
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+  return (Vqd);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Adds the voltage of the back-EMF harmonics of the period to the
+  *         output of the PI controllers, as a feed forward.
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  * @param  Vqd voltage of the PI controllers
+  * @retval qd_t Voltage with the harmonics
+  */
+__weak qd_t HCM_AddVoltage(const HCM_Handle_t *pHandle, qd_t Vqd)
+{
+  qd_t Vout = Vqd;
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    Vout.q = HCM_Saturate((int32_t)Vqd.q + (int32_t)pHandle->Voltage.q);
+    Vout.d = HCM_Saturate((int32_t)Vqd.d + (int32_t)pHandle->Voltage.d);
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+  return (Vout);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Updates the running means with the voltage applied in the period
+  *         and, while learning, moves the entry of the period towards what is
+  *         left of the voltage and of the q current reference once their means
+  *         are removed. It must be called by the high frequency task after the
+  *         current controllers, in RUN.
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  * @param  Vqd voltage applied in the period
+  */
+__weak void HCM_Learn(HCM_Handle_t *pHandle, qd_t Vqd)
+{
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t bMeanShift = pHandle->bMeanShift;
+
+    pHandle->wVqSum += (int32_t)Vqd.q - (pHandle->wVqSum >> bMeanShift);
+    pHandle->wVdSum += (int32_t)Vqd.d - (pHandle->wVdSum >> bMeanShift);
+    pHandle->wIqSum += (int32_t)pHandle->hIqref - (pHandle->wIqSum >> bMeanShift);
+
+    if (pHandle->hWarmup > 0U)
+    {
+      /* The means are not settled yet */
+      pHandle->hWarmup--;
+    }
+    else if (true == pHandle->Learning)
+    {
+      HCM_Entry_t *pEntry = &pHandle->Table[pHandle->bIndex];
+      uint8_t bLearnShift = pHandle->bLearnShift;
+      int32_t wVq = (int32_t)(((int64_t)((int32_t)Vqd.q - (pHandle->wVqSum >> bMeanShift))
+                               * pHandle->wLearnScale) >> 15);
+      int32_t wVd = (int32_t)(((int64_t)((int32_t)Vqd.d - (pHandle->wVdSum >> bMeanShift))
+                               * pHandle->wLearnScale) >> 15);
+      int32_t wIq = (int32_t)pHandle->hIqref - (pHandle->wIqSum >> bMeanShift);
+
+      pEntry->hVq = HCM_Saturate((int32_t)pEntry->hVq + ((wVq - (int32_t)pEntry->hVq) >> bLearnShift));
+      pEntry->hVd = HCM_Saturate((int32_t)pEntry->hVd + ((wVd - (int32_t)pEntry->hVd) >> bLearnShift));
+      pEntry->hIq = HCM_Saturate((int32_t)pEntry->hIq + ((wIq - (int32_t)pEntry->hIq) >> bLearnShift));
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+}
+
+/**
+  * @brief  Selects the learning for the next medium frequency period: it runs
+  *         while requested, at a steady speed of magnitude hMinSpeedDpp or
+  *         more. The means restart when the learning stops.
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  * @param  SteadyState true when the speed holds its reference
+  * @param  hElSpeedDpp average electrical speed, in dpp
+  */
+__weak void HCM_SelectLearning(HCM_Handle_t *pHandle, bool SteadyState, int16_t hElSpeedDpp)
+{
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int32_t wAbsSpeed = (hElSpeedDpp < 0) ? -(int32_t)hElSpeedDpp : (int32_t)hElSpeedDpp;
+
+    if ((true == pHandle->LearnRequested) && (true == SteadyState)
+        && (wAbsSpeed >= (int32_t)pHandle->hMinSpeedDpp) && (wAbsSpeed > 0))
+    {
+      /* The voltage of the period brought back to the speed of the table */
+      pHandle->wLearnScale = ((int32_t)pHandle->hLearnSpeedDpp << 15) / (int32_t)hElSpeedDpp;
+      pHandle->Learning = true;
+    }
+    else if (true == pHandle->Learning)
+    {
+      pHandle->Learning = false;
+      pHandle->hWarmup = (uint16_t)1 << pHandle->bMeanShift;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+}
+
+/**
+  * @brief  Executes a learning command. HCM_CMD_CLEAR is only taken while the
+  *         table is not learned.
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  * @param  bCommand HCM_CMD_STOP, HCM_CMD_LEARN or HCM_CMD_CLEAR
+  * @retval bool True if the command is executed
+  */
+__weak bool HCM_Command(HCM_Handle_t *pHandle, uint8_t bCommand)
+{
+  bool bDone = false;
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    switch (bCommand)
+    {
+      case HCM_CMD_STOP:
+      {
+        pHandle->LearnRequested = false;
+        bDone = true;
+        break;
+      }
+
+      case HCM_CMD_LEARN:
+      {
+        pHandle->LearnRequested = true;
+        bDone = true;
+        break;
+      }
+
+      case HCM_CMD_CLEAR:
+      {
+        if (false == pHandle->Learning)
+        {
+          uint16_t i;
+
+          for (i = 0U; i < HCM_TABLE_SIZE; i++)
+          {
+            pHandle->Table[i].hVq = 0;
+            pHandle->Table[i].hVd = 0;
+            pHandle->Table[i].hIq = 0;
+          }
+          bDone = true;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        break;
+      }
+
+      default:
+        break;
+    }
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+  return (bDone);
+}
+
+/**
+  * @brief  Returns the learning state.
+  * @param  pHandle handler of the current instance of the Harmonic Compensation component
+  * @retval HCM_State_t State
+  */
+__weak HCM_State_t HCM_GetState(const HCM_Handle_t *pHandle)
+{
+  HCM_State_t State = HCM_IDLE;
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if (true == pHandle->Learning)
+    {
+      State = HCM_LEARNING;
+    }
+    else if (true == pHandle->LearnRequested)
+    {
+      State = HCM_WAITING;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_HARMONIC_COMPENSATION
+  }
+#endif
+  return (State);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
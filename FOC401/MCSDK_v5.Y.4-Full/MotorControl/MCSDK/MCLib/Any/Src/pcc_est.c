@@ -0,0 +1,538 @@
+/**
+  ******************************************************************************
+  * @file    pcc_est.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the Predictive Current Control model estimator component of the
+  *          Motor Control SDK:
+  *
+  *           * averaging of the q/d currents and voltages over the medium
+  *             frequency period
+  *           * recursive least squares estimation of the resistance, inductance
+  *             and flux terms of the predictor model
+  *           * temperature prior of the resistance term
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "pcc_est.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/**
+  * @defgroup PCC_EST PCC Model Estimator
+  * @brief Online estimation of the motor model used by the Predictive Current Control
+  *
+  * The high frequency task adds the q/d currents and voltages of each control
+  * period to a pair of sums. The medium frequency task swaps the pair, averages
+  * the sums of the elapsed period and, when the speed and the current are high
+  * enough for the model to be observable, runs one step of a recursive least
+  * squares estimation with forgetting factor. The two steady state equations of
+  * the model are used at each step, plus a pseudo measurement of the resistance
+  * term computed from the nominal resistance and the motor temperature.
+  *
+  * Every hUpdatePeriod steps the wKDecay, wKVolt and wKBemf coefficients of the
+  * predictor are computed from the estimates and staged with PCC_SetTuning(), so
+  * that the high frequency task applies them all together. The estimates are
+  * bounded between half and twice the nominal model.
+  *
+  * @{
+  */
+
+/* Private defines -----------------------------------------------------------*/
+#define PCC_EST_RS            0U                /* Index of the resistance term */
+#define PCC_EST_LS            1U                /* Index of the inductance term */
+#define PCC_EST_FLUX          2U                /* Index of the flux term */
+#define PCC_EST_COPPER_COEF   ((float_t)0.00393) /* Copper resistance temperature coefficient, 1/Celsius */
+#define PCC_EST_RAD_PER_DPP   ((float_t)(3.14159265358979 / 32768.0)) /* rad per control period of 1 dpp */
+
+/**
+  * @brief  It runs one step of the recursive least squares on y = phi' theta.
+  *         The regressor and the measure are first divided by the largest
+  *         component of the regressor: in digits, the regressor would make the
+  *         covariance matrix lose its precision in single precision floats.
+  * @param  pHandle: handler of the current instance of the PCC_EST component
+  * @param  fPhi: regressor, in digits
+  * @param  fY: measure, in digits
+  * @param  fForgetting: forgetting factor of the step
+  * @retval None
+  */
+static void PCC_EST_RlsStep(PCC_EST_Handle_t *pHandle, const float_t fPhi[PCC_EST_NB_PARAMS], float_t fY,
+                            float_t fForgetting)
+{
+  float_t fPhiN[PCC_EST_NB_PARAMS];
+  float_t fPPhi[PCC_EST_NB_PARAMS];
+  float_t fGain[PCC_EST_NB_PARAMS];
+  float_t fNorm = 1.0f;
+  float_t fDen = fForgetting;
+  float_t fErr;
+  uint8_t i;
+  uint8_t j;
+
+  for (i = 0U; i < PCC_EST_NB_PARAMS; i++)
+  {
+    float_t fAbs = (fPhi[i] < 0.0f) ? -fPhi[i] : fPhi[i];
+    fNorm = (fAbs > fNorm) ? fAbs : fNorm;
+  }
+  for (i = 0U; i < PCC_EST_NB_PARAMS; i++)
+  {
+    fPhiN[i] = fPhi[i] / fNorm;
+  }
+  fErr = fY / fNorm;
+
+  for (i = 0U; i < PCC_EST_NB_PARAMS; i++)
+  {
+    fPPhi[i] = 0.0f;
+    for (j = 0U; j < PCC_EST_NB_PARAMS; j++)
+    {
+      fPPhi[i] += pHandle->fP[i][j] * fPhiN[j];
+    }
+    fDen += fPhiN[i] * fPPhi[i];
+    fErr -= fPhiN[i] * pHandle->fTheta[i];
+  }
+
+  for (i = 0U; i < PCC_EST_NB_PARAMS; i++)
+  {
+    fGain[i] = fPPhi[i] / fDen;
+    pHandle->fTheta[i] += fGain[i] * fErr;
+  }
+
+  /* P is symmetric: P.phi is also the transpose of phi'.P. Only the upper
+     triangle is computed, so that rounding does not break the symmetry */
+  for (i = 0U; i < PCC_EST_NB_PARAMS; i++)
+  {
+    for (j = i; j < PCC_EST_NB_PARAMS; j++)
+    {
+      pHandle->fP[i][j] = (pHandle->fP[i][j] - (fGain[i] * fPPhi[j])) / fForgetting;
+      pHandle->fP[j][i] = pHandle->fP[i][j];
+    }
+  }
+}
+
+#ifdef PCC_EXACT_DISCRETISATION
+/**
+  * @brief  It returns exp(-x) from its series up to x^6, within 2^-12 for x
+  *         between 0 and 1
+  * @param  fX: x, the resistance term times the voltage coefficient, Rs Ts / Ls
+  * @retval float_t exp(-x)
+  */
+static float_t PCC_EST_ExpNeg(float_t fX)
+{
+  return (1.0f - (fX * (1.0f - ((fX / 2.0f) * (1.0f - ((fX / 3.0f) * (1.0f - ((fX / 4.0f)
+                 * (1.0f - ((fX / 5.0f) * (1.0f - (fX / 6.0f))))))))))));
+}
+
+/**
+  * @brief  It returns the speed independent gain of the back-EMF coefficient of
+  *         the zero order hold model, exp(-x / 2) (1 + x^2 / 24)
+  * @param  fX: Rs Ts / Ls
+  * @retval float_t Gain of the back-EMF coefficient
+  */
+static float_t PCC_EST_BemfGain(float_t fX)
+{
+  return (PCC_EST_ExpNeg(fX / 2.0f) * (1.0f + ((fX * fX) / 24.0f)));
+}
+#endif
+
+/**
+  * @brief  It computes the wKDecay, wKVolt and wKBemf coefficients from the
+  *         estimates and stages them in the predictor
+  * @param  pHandle: handler of the current instance of the PCC_EST component
+  * @param  pPCC: handler of the PCC component that uses the model
+  * @retval None
+  */
+static void PCC_EST_UpdateModel(const PCC_EST_Handle_t *pHandle, PCC_Handle_t *pPCC)
+{
+  PCC_Tuning_t Tuning;
+  float_t fCoefDiv;
+  float_t fBemfDiv;
+  float_t fKVolt;
+#ifdef PCC_EXACT_DISCRETISATION
+  float_t fX;
+  float_t fKDecay;
+#endif
+
+  PCC_GetTuning(pPCC, &Tuning);
+  fCoefDiv = (float_t)((int32_t)1 << Tuning.hCoefDivisorPOW2);
+  fBemfDiv = (float_t)((int32_t)1 << Tuning.hBemfDivisorPOW2);
+
+  /* b is bounded away from zero by PCC_EST_Update() */
+  fKVolt = 1.0f / pHandle->fTheta[PCC_EST_LS];
+#ifdef PCC_EXACT_DISCRETISATION
+  /* The resistance term is bounded away from zero as well */
+  fX = pHandle->fTheta[PCC_EST_RS] * fKVolt;
+  fKDecay = PCC_EST_ExpNeg(fX);
+  Tuning.wKVolt = (int32_t)(((fKVolt * (1.0f - fKDecay)) / fX) * fCoefDiv);
+  Tuning.wKDecay = (int32_t)(fKDecay * fCoefDiv);
+  Tuning.wKBemf = (int32_t)(pHandle->fTheta[PCC_EST_FLUX] * fKVolt * PCC_EST_BemfGain(fX) * fBemfDiv);
+#else
+  Tuning.wKVolt = (int32_t)(fKVolt * fCoefDiv);
+  Tuning.wKDecay = (int32_t)((1.0f - (pHandle->fTheta[PCC_EST_RS] * fKVolt)) * fCoefDiv);
+  Tuning.wKBemf = (int32_t)(pHandle->fTheta[PCC_EST_FLUX] * fKVolt * fBemfDiv);
+#endif
+
+  /* Refused if a previous set is still pending: the next update retries */
+  (void)PCC_SetTuning(pPCC, &Tuning);
+}
+
+/**
+  * @brief  It initializes the handle. The nominal model is taken from the
+  *         coefficients of the PCC component, which must be initialized.
+  * @param  pHandle: handler of the current instance of the PCC_EST component
+  * @param  pPCC: handler of the PCC component that uses the model
+  * @retval None
+  */
+__weak void PCC_EST_Init(PCC_EST_Handle_t *pHandle, const PCC_Handle_t *pPCC)
+{
+#ifdef NULL_PTR_CHECK_PCC_EST
+  if ((MC_NULL == pHandle) || (MC_NULL == pPCC))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    PCC_Tuning_t Tuning;
+    float_t fCoefDiv;
+    float_t fKVolt;
+    float_t fKDecay;
+    float_t fKBemf;
+#ifdef PCC_EXACT_DISCRETISATION
+    float_t fX;
+    uint8_t i;
+#endif
+
+    PCC_GetTuning(pPCC, &Tuning);
+    fCoefDiv = (float_t)((int32_t)1 << Tuning.hCoefDivisorPOW2);
+    fKVolt = ((float_t)Tuning.wKVolt) / fCoefDiv;
+    fKDecay = ((float_t)Tuning.wKDecay) / fCoefDiv;
+    fKBemf = ((float_t)Tuning.wKBemf) / ((float_t)((int32_t)1 << Tuning.hBemfDivisorPOW2));
+
+#ifdef PCC_EXACT_DISCRETISATION
+    /* x = -ln(wKDecay) by Newton iterations on exp(-x), from the Euler value
+       below it, then the coefficients of the Euler model of the same motor */
+    fX = 1.0f - fKDecay;
+    for (i = 0U; i < 3U; i++)
+    {
+      fX += 1.0f - (fKDecay / PCC_EST_ExpNeg(fX));
+    }
+    fKVolt = (fKVolt * fX) / (1.0f - fKDecay);
+    fKDecay = 1.0f - fX;
+    fKBemf = fKBemf / PCC_EST_BemfGain(fX);
+#endif
+    pHandle->fThetaNom[PCC_EST_RS] = (1.0f - fKDecay) / fKVolt;
+    pHandle->fThetaNom[PCC_EST_LS] = 1.0f / fKVolt;
+    pHandle->fThetaNom[PCC_EST_FLUX] = fKBemf / fKVolt;
+
+    PCC_EST_Clear(pHandle);
+#ifdef NULL_PTR_CHECK_PCC_EST
+  }
+#endif
+}
+
+/**
+  * @brief  It resets the sums, the estimates to the nominal model and the
+  *         covariance matrix to its initial value
+  * @param  pHandle: handler of the current instance of the PCC_EST component
+  * @retval None
+  */
+__weak void PCC_EST_Clear(PCC_EST_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC_EST
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t i;
+    uint8_t j;
+
+    for (i = 0U; i < 2U; i++)
+    {
+      pHandle->Acc[i].wIqSum = 0;
+      pHandle->Acc[i].wIdSum = 0;
+      pHandle->Acc[i].wVqSum = 0;
+      pHandle->Acc[i].wVdSum = 0;
+      pHandle->Acc[i].hNbSamples = 0U;
+    }
+    pHandle->bAccIndex = 0U;
+
+    for (i = 0U; i < PCC_EST_NB_PARAMS; i++)
+    {
+      pHandle->fTheta[i] = pHandle->fThetaNom[i];
+      for (j = 0U; j < PCC_EST_NB_PARAMS; j++)
+      {
+        pHandle->fP[i][j] = (i == j) ? pHandle->fInitCovariance : 0.0f;
+      }
+    }
+    pHandle->hUpdateCounter = 0U;
+#ifdef NULL_PTR_CHECK_PCC_EST
+  }
+#endif
+}
+
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It adds the currents and voltages of one control period to the sums.
+  *         It must be called by the high frequency task. The sums stop once
+  *         UINT16_MAX samples are accumulated, far beyond one medium frequency
+  *         period, so that they can not overflow.
+  * @param  pHandle: handler of the current instance of the PCC_EST component
+  * @param  Iqd: measured currents in the q/d frame
+  * @param  Vqd: voltage applied in the q/d frame
+  * @retval None
+  */
+__weak void PCC_EST_Accumulate(PCC_EST_Handle_t *pHandle, qd_t Iqd, qd_t Vqd)
+{
+#ifdef NULL_PTR_CHECK_PCC_EST
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    PCC_EST_Acc_t *pAcc = &pHandle->Acc[pHandle->bAccIndex];
+
+    if (pAcc->hNbSamples < UINT16_MAX)
+    {
+      pAcc->wIqSum += Iqd.q;
+      pAcc->wIdSum += Iqd.d;
+      pAcc->wVqSum += Vqd.q;
+      pAcc->wVdSum += Vqd.d;
+      pAcc->hNbSamples++;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC_EST
+  }
+#endif
+}
+
+/**
+  * @brief  It swaps the sums, and runs one step of the estimation on the
+  *         averages of the elapsed period if the speed and the q current are
+  *         high enough. Every hUpdatePeriod calls, the predictor model is
+  *         updated from the estimates.
+  *
+  *         The high frequency task preempts the caller, so the sums it writes
+  *         after the swap are never the ones being read.
+  *         It must be called by the medium frequency task.
+  * @param  pHandle: handler of the current instance of the PCC_EST component
+  * @param  pPCC: handler of the PCC component that uses the model
+  * @param  hElSpeedDpp: average electrical speed over the period, in dpp
+  * @param  hTemp_C: motor temperature in Celsius
+  * @retval None
+  */
+__weak void PCC_EST_Update(PCC_EST_Handle_t *pHandle, PCC_Handle_t *pPCC, int16_t hElSpeedDpp, int16_t hTemp_C)
+{
+#ifdef NULL_PTR_CHECK_PCC_EST
+  if ((MC_NULL == pHandle) || (MC_NULL == pPCC))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t bReadIndex = pHandle->bAccIndex;
+    PCC_EST_Acc_t *pAcc = &pHandle->Acc[bReadIndex];
+    int32_t wIqAvg;
+    int16_t hAbsSpeed = (hElSpeedDpp < 0) ? -hElSpeedDpp : hElSpeedDpp;
+
+    pHandle->bAccIndex = bReadIndex ^ 1U;
+
+    wIqAvg = (0U == pAcc->hNbSamples) ? 0 : (pAcc->wIqSum / (int32_t)pAcc->hNbSamples);
+    wIqAvg = (wIqAvg < 0) ? -wIqAvg : wIqAvg;
+
+    if ((pAcc->hNbSamples > 0U) && (hAbsSpeed >= pHandle->hMinSpeedDpp) && (wIqAvg >= pHandle->hMinCurrent))
+    {
+      float_t fNbSamples = (float_t)pAcc->hNbSamples;
+      float_t fIq = ((float_t)pAcc->wIqSum) / fNbSamples;
+      float_t fId = ((float_t)pAcc->wIdSum) / fNbSamples;
+      /* Voltages brought back to the nominal bus voltage of the predictor model */
+      float_t fBusScale = ((float_t)pPCC->hBusScale) / ((float_t)PCC_BUS_SCALE_ONE);
+      float_t fVq = (((float_t)pAcc->wVqSum) / fNbSamples) * fBusScale;
+      float_t fVd = (((float_t)pAcc->wVdSum) / fNbSamples) * fBusScale;
+      float_t fDelta = ((float_t)hElSpeedDpp) * PCC_EST_RAD_PER_DPP;
+#ifdef PCC_INDUCTANCE_TABLE
+      /* The inductance of the sample, brought back to the unsaturated model */
+      float_t fLSat = ((float_t)PCC_LSAT_ONE) / ((float_t)PCC_GetInductanceGain(pPCC, (int16_t)fIq));
+#else
+      float_t fLSat = 1.0f;
+#endif
+      float_t fPhi[PCC_EST_NB_PARAMS];
+      uint8_t i;
+
+      fPhi[PCC_EST_RS] = fId;
+      fPhi[PCC_EST_LS] = -fDelta * fIq * fLSat;
+      fPhi[PCC_EST_FLUX] = 0.0f;
+      PCC_EST_RlsStep(pHandle, fPhi, fVd, pHandle->fForgetting);
+
+      fPhi[PCC_EST_RS] = fIq;
+      fPhi[PCC_EST_LS] = fDelta * fId * fLSat;
+      fPhi[PCC_EST_FLUX] = (float_t)hElSpeedDpp;
+      PCC_EST_RlsStep(pHandle, fPhi, fVq, 1.0f);
+
+      if (pHandle->fPriorWeight > 0.0f)
+      {
+        float_t fRsPrior = pHandle->fThetaNom[PCC_EST_RS]
+                         * (1.0f + (PCC_EST_COPPER_COEF * (float_t)(hTemp_C - pHandle->hRefTemp_C)));
+
+        fPhi[PCC_EST_RS] = pHandle->fPriorWeight;
+        fPhi[PCC_EST_LS] = 0.0f;
+        fPhi[PCC_EST_FLUX] = 0.0f;
+        PCC_EST_RlsStep(pHandle, fPhi, pHandle->fPriorWeight * fRsPrior, 1.0f);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
+      /* Estimates are kept between half and twice the nominal model */
+      for (i = 0U; i < PCC_EST_NB_PARAMS; i++)
+      {
+        float_t fLow = 0.5f * pHandle->fThetaNom[i];
+        float_t fHigh = 2.0f * pHandle->fThetaNom[i];
+
+        if (fLow > fHigh)
+        {
+          float_t fSwap = fLow;
+          fLow = fHigh;
+          fHigh = fSwap;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        pHandle->fTheta[i] = (pHandle->fTheta[i] < fLow) ? fLow
+                           : ((pHandle->fTheta[i] > fHigh) ? fHigh : pHandle->fTheta[i]);
+      }
+    }
+    else
+    {
+      /* Not enough excitation, the estimates are kept */
+    }
+
+    pAcc->wIqSum = 0;
+    pAcc->wIdSum = 0;
+    pAcc->wVqSum = 0;
+    pAcc->wVdSum = 0;
+    pAcc->hNbSamples = 0U;
+
+    pHandle->hUpdateCounter++;
+    if (pHandle->hUpdateCounter >= pHandle->hUpdatePeriod)
+    {
+      pHandle->hUpdateCounter = 0U;
+      PCC_EST_UpdateModel(pHandle, pPCC);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC_EST
+  }
+#endif
+}
+
+/**
+  * @brief  It replaces the nominal model, for instance by a model identified at
+  *         commissioning, resets the estimates to it and stages its coefficients
+  *         in the predictor. The estimates are then bounded around it.
+  * @param  pHandle: handler of the current instance of the PCC_EST component
+  * @param  pPCC: handler of the PCC component that uses the model
+  * @param  fTheta: a, b and c terms of the model, in the units of the predictor,
+  *         all positive
+  * @retval None
+  */
+__weak void PCC_EST_SetModel(PCC_EST_Handle_t *pHandle, PCC_Handle_t *pPCC, const float_t fTheta[PCC_EST_NB_PARAMS])
+{
+#ifdef NULL_PTR_CHECK_PCC_EST
+  if ((MC_NULL == pHandle) || (MC_NULL == pPCC) || (MC_NULL == fTheta))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t i;
+
+    for (i = 0U; i < PCC_EST_NB_PARAMS; i++)
+    {
+      pHandle->fThetaNom[i] = fTheta[i];
+    }
+    PCC_EST_Clear(pHandle);
+    PCC_EST_UpdateModel(pHandle, pPCC);
+#ifdef NULL_PTR_CHECK_PCC_EST
+  }
+#endif
+}
+
+/**
+  * @brief  It returns one of the estimated terms of the model, in the units of
+  *         the predictor
+  * @param  pHandle: handler of the current instance of the PCC_EST component
+  * @param  bParam: 0 for the resistance term, 1 for the inductance term, 2 for
+  *         the flux term
+  * @retval float_t Estimated term, 0 if bParam is out of range
+  */
+__weak float_t PCC_EST_GetEstimate(const PCC_EST_Handle_t *pHandle, uint8_t bParam)
+{
+  float_t fRetVal = 0.0f;
+#ifdef NULL_PTR_CHECK_PCC_EST
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if (bParam < PCC_EST_NB_PARAMS)
+    {
+      fRetVal = pHandle->fTheta[bParam];
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC_EST
+  }
+#endif
+  return (fRetVal);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -43,18 +43,27 @@
   *
   * pqd method to measure power of the motor
   *
-  * @todo Document the PQD Motor Power Measurement "module".
+  * The power is the product of the alpha/beta voltage that was actually
+  * applied during each FOC period, PWMC_SetPhaseVoltage() or the vectors of
+  * the predictive current controller, by the mean of the currents sampled at
+  * the start and at the end of that period. It is accumulated at every FOC
+  * period by PQD_AccumulateElPower() and averaged over the window closed by
+  * every call of PQD_CalcElMotorPower(), together with the copper losses of
+  * the squared currents. The efficiency is the share of the electrical power
+  * that is not lost in the copper, or of the mechanical power when the motor
+  * brakes: neither the iron losses nor the inverter losses are accounted for.
   *
   * @{
   */
 
 /**
-  * @brief  This method should be called with periodicity. It computes and
-  *         returns the measured motor power expressed in watt. It is also used
-  *         to fill, with that measure, the buffer used to compute the average
-  *         motor power.
+  * @brief  This method should be called with periodicity. It closes the window
+  *         accumulated by PQD_AccumulateElPower() since the previous call and
+  *         computes the measured motor power expressed in watt, the copper
+  *         losses and the efficiency of the window. It is also used to fill,
+  *         with that measure, the buffer used to compute the average motor
+  *         power.
   * @param power handle.
-  * @retval int16_t The measured motor power expressed in watt.
   */
 __weak void PQD_CalcElMotorPower(PQD_MotorPowMeas_Handle_t *pHandle)
 {
@@ -66,30 +75,215 @@ __weak void PQD_CalcElMotorPower(PQD_MotorPowMeas_Handle_t *pHandle)
   else
   {
 #endif
-    int32_t wAux;
+    PQD_Window_t *pWindow;
+    int32_t wAux = 0;
     int32_t wAux2;
-    int32_t wAux3;
-    qd_t Iqd = pHandle->pFOCVars->Iqd;
-    qd_t Vqd = pHandle->pFOCVars->Vqd;
+    uint32_t wCurrentSq = 0U;
+    uint8_t bClosed = pHandle->bWindow;
 
-    wAux = ((int32_t)Iqd.q * (int32_t)Vqd.q)
-         + ((int32_t)Iqd.d * (int32_t)Vqd.d);
-    wAux /= 65536;
+    /* The high frequency task preempts this one: it goes on with the other
+       window from now on and never writes the closed one */
+    pHandle->bWindow = bClosed ^ 1U;
+    pWindow = &pHandle->Window[bClosed];
+    if (pWindow->hNbPeriods > 0U)
+    {
+      wAux = pWindow->wPowerSum / (int32_t)pWindow->hNbPeriods;
+      wCurrentSq = pWindow->wCurrentSqSum / pWindow->hNbPeriods;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    pWindow->wPowerSum = 0;
+    pWindow->wCurrentSqSum = 0U;
+    pWindow->hNbPeriods = 0U;
 
     wAux2 = pHandle->wConvFact * (int32_t)VBS_GetAvBusVoltage_V(pHandle->pVBS);
     wAux2 /= 600; /* 600 is max bus voltage expressed in volt.*/
 
-    wAux3 = wAux * wAux2;
-    wAux3 *= 6; /* 6 is max bus voltage expressed in thousend of volt.*/
-    wAux3 /= 10;
-    wAux3 /= 65536;
+    /* 6 / 10 of a watt, 6 being the max bus voltage expressed in thousend of volt */
+    pHandle->wElPower_mW = (int32_t)(((int64_t)wAux * wAux2 * 600) / 65536);
+    pHandle->wCurrentSq = wCurrentSq;
+    pHandle->wCopperLoss_mW = (int32_t)(((int64_t)wCurrentSq * pHandle->wCopperLossFact) / 65536);
+
+    if (pHandle->wElPower_mW > pHandle->wCopperLoss_mW)
+    {
+      pHandle->hEfficiency = (int16_t)(((int64_t)(pHandle->wElPower_mW - pHandle->wCopperLoss_mW) * 1000)
+                                       / pHandle->wElPower_mW);
+    }
+    else if (pHandle->wElPower_mW < 0)
+    {
+      /* Braking: the mechanical power feeds the copper losses first */
+      pHandle->hEfficiency = (int16_t)(((int64_t)pHandle->wElPower_mW * 1000)
+                                       / (pHandle->wElPower_mW - pHandle->wCopperLoss_mW));
+    }
+    else
+    {
+      pHandle->hEfficiency = 0;
+    }
 
-    (void)MPM_CalcElMotorPower(&pHandle->_super, (int16_t)wAux3);
+    (void)MPM_CalcElMotorPower(&pHandle->_super, (int16_t)(pHandle->wElPower_mW / 1000));
 #ifdef NULL_PTR_MOT_POW_MEAS
   }
 #endif
 }
 
+/**
+  * @brief  It should be called before each motor restart. It clears the
+  *         measurement windows and the buffer used to compute the average
+  *         motor power.
+  * @param power handle.
+  */
+__weak void PQD_Clear(PQD_MotorPowMeas_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MOT_POW_MEAS
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t i;
+
+    MPM_Clear(&pHandle->_super);
+    for (i = 0U; i < 2U; i++)
+    {
+      pHandle->Window[i].wPowerSum = 0;
+      pHandle->Window[i].wCurrentSqSum = 0U;
+      pHandle->Window[i].hNbPeriods = 0U;
+    }
+    pHandle->Ialphabeta.alpha = 0;
+    pHandle->Ialphabeta.beta = 0;
+    pHandle->Valphabeta.alpha = 0;
+    pHandle->Valphabeta.beta = 0;
+    pHandle->wCurrentSq = 0U;
+    pHandle->wElPower_mW = 0;
+    pHandle->wCopperLoss_mW = 0;
+    pHandle->hEfficiency = 0;
+#ifdef NULL_PTR_MOT_POW_MEAS
+  }
+#endif
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It accumulates the power of the FOC period that ends with the
+  *         sampling of @p Ialphabeta: the voltage written at the previous call
+  *         times the mean of the currents at its start and at its end. It must
+  *         be called at every FOC period, once the voltage of the next period
+  *         is written.
+  * @param power handle.
+  * @param Ialphabeta currents sampled in the current FOC period.
+  * @param Valphabeta voltage written in the current FOC period, applied from
+  *        the next one on.
+  */
+__weak void PQD_AccumulateElPower(PQD_MotorPowMeas_Handle_t *pHandle, alphabeta_t Ialphabeta, alphabeta_t Valphabeta)
+{
+#ifdef NULL_PTR_MOT_POW_MEAS
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    PQD_Window_t *pWindow = &pHandle->Window[pHandle->bWindow];
+    int32_t wIalpha = ((int32_t)pHandle->Ialphabeta.alpha + Ialphabeta.alpha) / 2;
+    int32_t wIbeta = ((int32_t)pHandle->Ialphabeta.beta + Ialphabeta.beta) / 2;
+    uint32_t wCurrentSq;
+
+    /* Each product is below 2^30, their halves add up without overflow */
+    wCurrentSq = (uint32_t)((int32_t)Ialphabeta.alpha * Ialphabeta.alpha)
+               + (uint32_t)((int32_t)Ialphabeta.beta * Ialphabeta.beta);
+    if (pWindow->hNbPeriods < UINT16_MAX)
+    {
+      pWindow->wPowerSum += (((int32_t)pHandle->Valphabeta.alpha * wIalpha) / 2
+                           + ((int32_t)pHandle->Valphabeta.beta * wIbeta) / 2) / 32768;
+      pWindow->wCurrentSqSum += wCurrentSq / 65536U;
+      pWindow->hNbPeriods++;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    pHandle->Ialphabeta = Ialphabeta;
+    pHandle->Valphabeta = Valphabeta;
+#ifdef NULL_PTR_MOT_POW_MEAS
+  }
+#endif
+}
+
+/**
+  * @brief  It returns the mean squared current magnitude of the last window
+  *         closed by PQD_CalcElMotorPower().
+  * @param power handle.
+  * @retval uint32_t Mean squared current in squared current digits / 65536.
+  */
+__weak uint32_t PQD_GetMeanSqCurrent(const PQD_MotorPowMeas_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MOT_POW_MEAS
+  return ((MC_NULL == pHandle) ? 0U : pHandle->wCurrentSq);
+#else
+  return (pHandle->wCurrentSq);
+#endif
+}
+
+/**
+  * @brief  It returns the electrical power of the last window closed by
+  *         PQD_CalcElMotorPower(), with the resolution of the window rather
+  *         than of MPM_GetAvrgElMotorPowerW().
+  * @param power handle.
+  * @retval int32_t Electrical power expressed in mW.
+  */
+__weak int32_t PQD_GetElPower_mW(const PQD_MotorPowMeas_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MOT_POW_MEAS
+  return ((MC_NULL == pHandle) ? 0 : pHandle->wElPower_mW);
+#else
+  return (pHandle->wElPower_mW);
+#endif
+}
+
+/**
+  * @brief  It returns the copper losses of the last window closed by
+  *         PQD_CalcElMotorPower().
+  * @param power handle.
+  * @retval int16_t Copper losses expressed in watt.
+  */
+__weak int16_t PQD_GetCopperLossW(const PQD_MotorPowMeas_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MOT_POW_MEAS
+  return ((MC_NULL == pHandle) ? 0 : (int16_t)(pHandle->wCopperLoss_mW / 1000));
+#else
+  return ((int16_t)(pHandle->wCopperLoss_mW / 1000));
+#endif
+}
+
+/**
+  * @brief  It returns the share of the electrical power of the last window
+  *         closed by PQD_CalcElMotorPower() that is not lost in the copper, or
+  *         of the mechanical power when the motor brakes.
+  * @param power handle.
+  * @retval int16_t Efficiency expressed in per mille.
+  */
+__weak int16_t PQD_GetEfficiency(const PQD_MotorPowMeas_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MOT_POW_MEAS
+  return ((MC_NULL == pHandle) ? 0 : pHandle->hEfficiency);
+#else
+  return (pHandle->hEfficiency);
+#endif
+}
+
 /**
   * @}
   */
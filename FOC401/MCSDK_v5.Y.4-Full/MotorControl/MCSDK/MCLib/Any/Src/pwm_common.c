@@ -118,7 +118,8 @@ __weak void waitForPolarizationEnd(TIM_TypeDef *TIMx, uint16_t  *SWerror, uint8_
     uint16_t hCalibrationPeriodCounter;
     uint16_t hMaxPeriodsNumber;
 
-    hMaxPeriodsNumber = ((uint16_t)2 * NB_CONVERSIONS) * (((uint16_t)repCnt + 1U) >> 1);
+    /* Periods between two updates, rounded up: a repetition counter of 0 updates twice per period */
+    hMaxPeriodsNumber = ((uint16_t)2 * NB_CONVERSIONS) * (((uint16_t)repCnt + 2U) >> 1);
 
     /* Wait for NB_CONVERSIONS to be executed */
     LL_TIM_ClearFlag_CC1(TIMx);
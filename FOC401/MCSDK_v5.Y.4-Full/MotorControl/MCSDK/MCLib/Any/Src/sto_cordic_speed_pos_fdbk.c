@@ -132,6 +132,8 @@ __weak void STO_CR_Init(STO_CR_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This method executes Luenberger state observer equations and calls
@@ -942,6 +944,8 @@ __weak void STO_CR_SetObserverGains(STO_CR_Handle_t *pHandle, int16_t hhC1, int1
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This method must be called - at least - with the same periodicity
@@ -0,0 +1,212 @@
+/**
+  ******************************************************************************
+  * @file    thermal_derating.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the Thermal Derating component of the Motor Control SDK:
+  *
+  *           * estimation of the power switches and windings temperatures
+  *           * derating of the current limit near their largest values
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "thermal_derating.h"
+#include "mc_math.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/**
+  * @defgroup ThermalDerating Thermal Derating
+  * @brief Current limit derived from a thermal model of the drive
+  *
+  * The medium frequency task feeds the model with the mean squared current of
+  * its period, an I squared t measure of the copper losses, and with the heat
+  * sink temperature of the NTC. Each node filters the squared current with its
+  * own thermal time constant and estimates its temperature above the heat sink.
+  *
+  * While the headroom of a node, the distance of its temperature to its largest
+  * value, is larger than hBand_C, its current limit is the nominal current.
+  * Below, the limit goes down linearly to the continuous current of the node,
+  * the current that holds it at its largest temperature at steady state, which
+  * it reaches at zero headroom, and further down when the headroom is negative.
+  * The node then settles at its largest temperature instead of tripping the
+  * over temperature fault, that remains the last protection.
+  *
+  * The limit of the warmest node is applied as the squared nominal current of
+  * the flux weakening component, which saturates the q current reference and the
+  * speed PI integral term with it.
+  *
+  * @{
+  */
+
+/**
+  * @brief  Initializes the thermal model with unloaded nodes, at the heat sink
+  *         temperature, and the current limit at the nominal current.
+  * @param  pHandle handler of the current instance of the Thermal Derating component
+  */
+__weak void TDR_Init(TDR_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_THERMAL_DERATING
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t i;
+
+    for (i = 0U; i < TDR_NB_NODES; i++)
+    {
+      pHandle->Node[i].fLoad = 0.0f;
+      pHandle->Node[i].hTemp_C = 0;
+    }
+    pHandle->hHeadroom_C = pHandle->hBand_C;
+    pHandle->wSqCurrLimit = pHandle->wNominalSqCurr;
+#ifdef NULL_PTR_CHECK_THERMAL_DERATING
+  }
+#endif
+}
+
+/**
+  * @brief  Updates the temperatures estimated by the thermal model and the
+  *         current limit. It must be called once per medium frequency period,
+  *         whatever the state of the motor, so that the nodes also cool down.
+  * @param  pHandle handler of the current instance of the Thermal Derating component
+  * @param  wCurrentSq mean squared current magnitude of the period, in squared
+  *         s16A / 65536
+  * @param  hSinkTemp_C heat sink temperature, in Celsius
+  */
+__weak void TDR_Update(TDR_Handle_t *pHandle, uint32_t wCurrentSq, int16_t hSinkTemp_C)
+{
+#ifdef NULL_PTR_CHECK_THERMAL_DERATING
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    TDR_Node_t *pNode;
+    float_t fLoad = ((float_t)wCurrentSq * 65536.0f) / (float_t)pHandle->wNominalSqCurr;
+    float_t fBand = (float_t)pHandle->hBand_C;
+    float_t fLimit = 1.0f;
+    float_t fHeadroom;
+    float_t fNodeLimit;
+    float_t fContinuous;
+    float_t fMinHeadroom = fBand;
+    uint8_t i;
+
+    for (i = 0U; i < TDR_NB_NODES; i++)
+    {
+      pNode = &pHandle->Node[i];
+      pNode->fLoad += (fLoad - pNode->fLoad) * pNode->fCoeff;
+      fHeadroom = (float_t)pNode->hMax_C - (float_t)hSinkTemp_C - (pNode->fRise_C * pNode->fLoad);
+      pNode->hTemp_C = (int16_t)((float_t)pNode->hMax_C - fHeadroom);
+
+      if (fHeadroom >= fBand)
+      {
+        fNodeLimit = 1.0f;
+      }
+      else
+      {
+        /* Squared continuous current of the node, relative to the nominal one */
+        fContinuous = ((float_t)pNode->hMax_C - (float_t)hSinkTemp_C) / pNode->fRise_C;
+        fNodeLimit = fContinuous + (((1.0f - fContinuous) * fHeadroom) / fBand);
+      }
+      fLimit = (fNodeLimit < fLimit) ? fNodeLimit : fLimit;
+      fMinHeadroom = (fHeadroom < fMinHeadroom) ? fHeadroom : fMinHeadroom;
+    }
+
+    fLimit = (fLimit > 0.0f) ? fLimit : 0.0f;
+    pHandle->hHeadroom_C = (int16_t)fMinHeadroom;
+    pHandle->wSqCurrLimit = (int32_t)(fLimit * (float_t)pHandle->wNominalSqCurr);
+#ifdef NULL_PTR_CHECK_THERMAL_DERATING
+  }
+#endif
+}
+
+/**
+  * @brief  Returns the squared current limit of the last TDR_Update().
+  * @param  pHandle handler of the current instance of the Thermal Derating component
+  * @retval int32_t Squared current limit, in s16A squared
+  */
+__weak int32_t TDR_GetSqCurrLimit(const TDR_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_THERMAL_DERATING
+  return ((MC_NULL == pHandle) ? 0 : pHandle->wSqCurrLimit);
+#else
+  return (pHandle->wSqCurrLimit);
+#endif
+}
+
+/**
+  * @brief  Returns the current limit of the last TDR_Update().
+  * @param  pHandle handler of the current instance of the Thermal Derating component
+  * @retval int16_t Current limit, in s16A
+  */
+__weak int16_t TDR_GetCurrLimit(const TDR_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_THERMAL_DERATING
+  return ((MC_NULL == pHandle) ? 0 : (int16_t)MCM_Sqrt(pHandle->wSqCurrLimit));
+#else
+  return ((int16_t)MCM_Sqrt(pHandle->wSqCurrLimit));
+#endif
+}
+
+/**
+  * @brief  Returns the thermal headroom of the last TDR_Update(). It saturates at
+  *         hBand_C, above which the current is not derated.
+  * @param  pHandle handler of the current instance of the Thermal Derating component
+  * @retval int16_t Smallest distance of the estimated temperatures to their
+  *         largest value, in Celsius
+  */
+__weak int16_t TDR_GetHeadroom_C(const TDR_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_THERMAL_DERATING
+  return ((MC_NULL == pHandle) ? 0 : pHandle->hHeadroom_C);
+#else
+  return (pHandle->hHeadroom_C);
+#endif
+}
+
+/**
+  * @brief  Returns the temperature of a node estimated by the last TDR_Update().
+  * @param  pHandle handler of the current instance of the Thermal Derating component
+  * @param  bNode TDR_STAGE or TDR_WINDING
+  * @retval int16_t Estimated temperature, in Celsius
+  */
+__weak int16_t TDR_GetTemp_C(const TDR_Handle_t *pHandle, uint8_t bNode)
+{
+#ifdef NULL_PTR_CHECK_THERMAL_DERATING
+  return (((MC_NULL == pHandle) || (bNode >= TDR_NB_NODES)) ? 0 : pHandle->Node[bNode].hTemp_C);
+#else
+  return (pHandle->Node[bNode].hTemp_C);
+#endif
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
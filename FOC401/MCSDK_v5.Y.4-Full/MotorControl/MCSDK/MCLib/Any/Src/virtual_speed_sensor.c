@@ -111,6 +111,8 @@ __weak void VSS_Clear(VirtualSpeedSensor_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  Update the rotor electrical angle integrating the last setled
@@ -184,6 +184,17 @@ uint16_t R3_1_SetADCSampPointSectX( PWMC_Handle_t * pHdl);
   */
 uint16_t R3_1_SetADCSampPointSectX_OVM( PWMC_Handle_t * pHdl);
 
+/**
+  * Configure the ADC for the current sampling of a switching state
+  * applied by PWMC_SetSwitchingState(), in the middle of the PWM period.
+  */
+uint16_t R3_1_SetADCSampPointState( PWMC_Handle_t * pHdl);
+
+/**
+  * It sets the timing of the current sampling, in place of the one of the parameters
+  */
+bool R3_1_SetSamplingTiming( PWMC_Handle_t * pHdl, const PWMC_SampTiming_t * pTiming );
+
 /**
   * It contains the TIMx Update event interrupt
   */
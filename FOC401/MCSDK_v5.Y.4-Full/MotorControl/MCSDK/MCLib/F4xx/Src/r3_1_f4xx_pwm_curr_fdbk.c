@@ -90,6 +90,7 @@
 void R3_1_HFCurrentsCalibrationAB(PWMC_Handle_t *pHdl,ab_t* pStator_Currents);
 void R3_1_HFCurrentsCalibrationC(PWMC_Handle_t *pHdl,ab_t* pStator_Currents);
 uint16_t R3_1_WriteTIMRegisters(PWMC_Handle_t *pHdl, uint16_t hCCR4Reg);
+__STATIC_INLINE uint16_t R3_1_SamplingPointAfter( PWMC_R3_1_Handle_t * pHandle );
 
 /* Private functions ---------------------------------------------------------*/
 
@@ -173,7 +174,53 @@ __weak void R3_1_Init(PWMC_R3_1_Handle_t *pHandle)
     /* Clear the flags */
     pHandle->OverCurrentFlag = false;
     pHandle->_Super.DTTest = 0u;
+
+    /* Timing of the parameters, and sampling time set by the ADC configuration */
+    pHandle->_Super.SampTiming.hTafter = pHandle->pParams_str->hTafter;
+    pHandle->_Super.SampTiming.hTbefore = pHandle->pParams_str->hTbefore;
+    pHandle->_Super.SampTiming.bSampleTime = ( uint8_t )LL_ADC_GetChannelSamplingTime( ADCx,
+        __LL_ADC_DECIMAL_NB_TO_CHANNEL( ( pHandle->pParams_str->ADCConfig[0] & ADC_JSQR_JSQ4 ) >> ADC_JSQR_JSQ4_Pos ) );
+    pHandle->_Super.SampTiming.bReserved = 0u;
+  }
+}
+
+/**
+  * @brief  It sets the timing of the current sampling, see PWMC_SetSamplingTiming().
+  *         The sampling time is that of the channels of the sequences of all the sectors.
+  * @param pHdl: handler of the current instance of the PWM component
+  * @param pTiming: timing of the sampling
+  * @retval bool False if a delay does not fit in half of the period, the timing being
+  *         then not changed
+  */
+__weak bool R3_1_SetSamplingTiming( PWMC_Handle_t * pHdl, const PWMC_SampTiming_t * pTiming )
+{
+  PWMC_R3_1_Handle_t *pHandle = (PWMC_R3_1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+  ADC_TypeDef * ADCx = pHandle->pParams_str->ADCx;
+  bool retVal = false;
+  uint8_t bSector;
+
+  if ( ( pTiming->hTafter < pHandle->Half_PWMPeriod ) && ( pTiming->hTbefore < pHandle->Half_PWMPeriod )
+       && ( ( uint32_t )pTiming->bSampleTime <= ( uint32_t )LL_ADC_SAMPLINGTIME_480CYCLES ) )
+  {
+    /* The SMPR registers of the F4 can be written at any time */
+    for ( bSector = SECTOR_1; bSector <= SECTOR_6; bSector++ )
+    {
+      uint32_t wConfig = pHandle->pParams_str->ADCConfig[bSector];
+
+      LL_ADC_SetChannelSamplingTime( ADCx, __LL_ADC_DECIMAL_NB_TO_CHANNEL( ( wConfig & ADC_JSQR_JSQ3 ) >> ADC_JSQR_JSQ3_Pos ),
+                                     ( uint32_t )pTiming->bSampleTime );
+      LL_ADC_SetChannelSamplingTime( ADCx, __LL_ADC_DECIMAL_NB_TO_CHANNEL( ( wConfig & ADC_JSQR_JSQ4 ) >> ADC_JSQR_JSQ4_Pos ),
+                                     ( uint32_t )pTiming->bSampleTime );
+    }
+    pHdl->SampTiming = *pTiming;
+    pHdl->SampTiming.bReserved = 0u;
+    retVal = true;
   }
+  else
+  {
+    /* Nothing to do */
+  }
+  return ( retVal );
 }
 
 /**
@@ -320,6 +367,8 @@ __weak void R3_1_CurrentReadingCalibration(PWMC_Handle_t *pHdl)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section (".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It computes and return latest converted motor phase currents motor
@@ -973,12 +1022,33 @@ __weak void R3_1_SwitchOffPWM(PWMC_Handle_t *pHdl)
   return;
 }
 
+/**
+  * @brief  Returns the sampling point hTafter after the edge of the phase with the largest
+  *         compare value, on the falling edge of the trigger past the middle of the period.
+  * @param pHandle: handler of the current instance of the PWM component
+  */
+__STATIC_INLINE uint16_t R3_1_SamplingPointAfter( PWMC_R3_1_Handle_t * pHandle )
+{
+  uint16_t hCntSmp = pHandle->_Super.lowDuty + pHandle->_Super.SampTiming.hTafter;
+
+  if ( hCntSmp >= pHandle->Half_PWMPeriod )
+  {
+    /* It must be changed the trigger direction from positive to negative
+         to sample after middle of PWM*/
+    pHandle->ADCTriggerEdge = LL_ADC_INJ_TRIG_EXT_FALLING;
+    hCntSmp = ( 2u * pHandle->Half_PWMPeriod ) - hCntSmp - 1u;
+  }
+  return ( hCntSmp );
+}
+
 #if defined (CCMRAM)
 #if defined (__ICCARM__)
 #pragma location = ".ccmram"
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section (".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 
 /**
@@ -1024,6 +1094,8 @@ __weak uint16_t R3_1_WriteTIMRegisters(PWMC_Handle_t *pHdl, uint16_t hCCR4Reg)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section (".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  Configure the ADC for the current sampling during calibration.
@@ -1048,6 +1120,8 @@ __weak uint16_t R3_1_SetADCSampPointCalibration(PWMC_Handle_t *pHdl)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section (".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  Configure the ADC for the current sampling related to sector x.
@@ -1067,7 +1141,8 @@ __weak uint16_t R3_1_SetADCSampPointSectX( PWMC_Handle_t * pHdl )
   register uint16_t midDuty = pHdl->midDuty;
   
   /* Check if sampling AB in the middle of PWM is possible */
-  if ( ( uint16_t )( pHandle->Half_PWMPeriod - lowDuty ) > pHandle->pParams_str->hTafter )
+  if ( ( false == pHdl->EdgeSampling )
+       && ( ( uint16_t )( pHandle->Half_PWMPeriod - lowDuty ) > pHdl->SampTiming.hTafter ) )
   {
     /* When it is possible to sample in the middle of the PWM period, always sample the same phases
      * (AB are chosen) for all sectors in order to not induce current discontinuities when there are differences
@@ -1096,20 +1171,12 @@ __weak uint16_t R3_1_SetADCSampPointSectX( PWMC_Handle_t * pHdl )
     if ( hDeltaDuty > ( uint16_t )( pHandle->Half_PWMPeriod - lowDuty ) * 2u )
     {
       /* hTbefore = 2*Ts + Tc, where Ts = Sampling time of ADC, Tc = Conversion Time of ADC */
-      hCntSmp = lowDuty - pHandle->pParams_str->hTbefore;
+      hCntSmp = lowDuty - pHdl->SampTiming.hTbefore;
     }
     else
     {
       /* hTafter = DT + max(Trise, Tnoise) */
-      hCntSmp = lowDuty + pHandle->pParams_str->hTafter;
-
-      if ( hCntSmp >= pHandle->Half_PWMPeriod )
-      {
-        /* It must be changed the trigger direction from positive to negative
-             to sample after middle of PWM*/
-        pHandle->ADCTriggerEdge = LL_ADC_INJ_TRIG_EXT_FALLING;
-        hCntSmp = ( 2u * pHandle->Half_PWMPeriod ) - hCntSmp - 1u;
-      }
+      hCntSmp = R3_1_SamplingPointAfter( pHandle );
     }
   }
 
@@ -1140,7 +1207,8 @@ uint16_t R3_1_SetADCSampPointSectX_OVM( PWMC_Handle_t * pHdl )
   DeltaDuty = ( uint16_t )( pHdl->lowDuty - pHdl->midDuty );
 
   /* case 1 (cf user manual) */
-  if (( uint16_t )( pHandle->Half_PWMPeriod - pHdl->lowDuty ) > pHandle->pParams_str->hTafter)
+  if ( ( false == pHdl->EdgeSampling )
+       && ( ( uint16_t )( pHandle->Half_PWMPeriod - pHdl->lowDuty ) > pHdl->SampTiming.hTafter ) )
   {
   /* When it is possible to sample in the middle of the PWM period, always sample the same phases
    * (AB are chosen) for all sectors in order to not induce current discontinuities when there are differences
@@ -1153,11 +1221,16 @@ uint16_t R3_1_SetADCSampPointSectX_OVM( PWMC_Handle_t * pHdl )
     /* set sampling  point trigger in the middle of PWM period */
     SamplingPoint =  pHandle->Half_PWMPeriod - (uint16_t) 1;
   }
+  else if ( true == pHdl->EdgeSampling )
+  {
+    /* Calibration of the timing: as out of the overmodulation */
+    SamplingPoint = R3_1_SamplingPointAfter( pHandle );
+  }
   else /* case 2 (cf user manual) */
   {
     if (DeltaDuty >= pHandle->pParams_str->Tcase2)
     {
-      SamplingPoint = pHdl->lowDuty - pHandle->pParams_str->hTbefore;
+      SamplingPoint = pHdl->lowDuty - pHdl->SampTiming.hTbefore;
     }
     else
     {
@@ -1186,6 +1259,41 @@ uint16_t R3_1_SetADCSampPointSectX_OVM( PWMC_Handle_t * pHdl )
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section (".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Configure the ADC for the current sampling of a switching state applied by
+  *         PWMC_SetSwitchingState().
+  *         The sector, that gives the phases to sample, has already been set from the state.
+  *         All the low sides are on in the middle of the PWM period, that is long enough for
+  *         the sampling, so that no duty cycle comparison is needed.
+  *         And call the WriteTIMRegisters method.
+  * @param pHdl: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak uint16_t R3_1_SetADCSampPointState( PWMC_Handle_t * pHdl )
+{
+#if defined (__ICCARM__)
+#pragma cstat_disable = "MISRAC2012-Rule-11.3"
+#endif /* __ICCARM__ */
+  PWMC_R3_1_Handle_t * pHandle = ( PWMC_R3_1_Handle_t * )pHdl;
+#if defined (__ICCARM__)
+#pragma cstat_restore = "MISRAC2012-Rule-11.3"
+#endif /* __ICCARM__ */
+
+  /* set sampling  point trigger in the middle of PWM period */
+  return R3_1_WriteTIMRegisters( &pHandle->_Super, ( uint16_t )( pHandle->Half_PWMPeriod ) - 1u );
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It contains the TIMx Update event interrupt
@@ -1220,6 +1328,8 @@ __weak void *R3_1_TIMx_UP_IRQHandler(PWMC_R3_1_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section (".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It contains the TIMx Break1 event interrupt
@@ -1461,6 +1571,8 @@ uint16_t R3_1_RLDetectionModeSetDuty(PWMC_Handle_t *pHdl, uint16_t hDuty)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section (".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It computes and return latest converted motor phase currents motor
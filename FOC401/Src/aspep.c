@@ -23,6 +23,8 @@
 #include "aspep.h"
 
 #define MIN(a,b) ( ((a) < (b)) ? (a) : (b) )
+/* Next slot of the rings of received packets and of answers */
+#define ASPEP_NEXT_SYNC(i) ( ((i) < (ASPEP_SYNC_NB_BUFFERS - 1U)) ? ((i) + 1U) : 0U )
 
                                                              static uint8_t ASPEP_TXframeProcess(ASPEP_Handle_t *pHandle, uint8_t packetType, void *txBuffer, uint16_t bufferLength);
 void ASPEP_sendBeacon(ASPEP_Handle_t *pHandle, ASPEP_Capabilities_def *capabilities);
@@ -160,6 +162,112 @@ static bool ASPEP_CheckHeaderCRC(uint32_t header)
   return (crc == 0U);
 }
 
+#ifdef ASPEP_DATA_CRC
+/**
+  * @brief CRC-16 lookup table with 256 entries, generator polynomial x^16+x^12+x^5+1
+  *
+  *  Used to compute the CRC of the data packets in software, when the CRC unit of the MCU
+  * cannot be programmed with this polynomial or is in use by a preempted context.
+  */
+static uint16_t const CRC16_Lookup8[] =
+{
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+  0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+  0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+  0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de,
+  0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
+  0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+  0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4,
+  0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc,
+  0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+  0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
+  0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12,
+  0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+  0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41,
+  0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49,
+  0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+  0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78,
+  0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f,
+  0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+  0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e,
+  0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
+  0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+  0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+  0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c,
+  0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+  0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
+  0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3,
+  0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+  0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92,
+  0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9,
+  0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+  0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
+  0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0
+};
+
+#if defined(CRC_POL_POL)
+/* Set while a context computes with the CRC unit: a higher priority context that preempts
+   it uses the lookup table instead */
+static volatile bool ASPEP_CRCUnitBusy = false;
+#endif
+
+/**
+  * @brief Computes the 16-bit CRC of the @p length bytes at @p data and returns it
+  *
+  *  The CRC is the CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF, bytes
+  * processed most significant bit first, no final XOR. It is sent most significant byte
+  * first after the payload of the data packets.
+  *
+  *  On MCUs whose CRC unit has a programmable polynomial, the unit is fed with 32-bit
+  * words, byte swapped so that the bytes are processed in their memory order.
+  */
+static uint16_t ASPEP_ComputeDataCRC(const uint8_t *data, uint16_t length)
+{
+  uint16_t crc = 0xFFFFU;
+  uint16_t i = 0U;
+#if defined(CRC_POL_POL)
+  bool useUnit = false;
+
+  __disable_irq();
+  if (false == ASPEP_CRCUnitBusy)
+  {
+    ASPEP_CRCUnitBusy = true;
+    useUnit = true;
+  }
+  __enable_irq();
+
+  if (true == useUnit)
+  {
+    CRC->CR = CRC_CR_POLYSIZE_0 | CRC_CR_RESET; /* 16-bit polynomial, no reversal */
+    while ((i < length) && ((((uint32_t)&data[i]) & 3U) != 0U))
+    {
+      *(__IO uint8_t *)(__IO void *)(&CRC->DR) = data[i]; //cstat !MISRAC2012-Rule-11.3
+      i++;
+    }
+    while ((length - i) >= 4U)
+    {
+      CRC->DR = __REV(*(const uint32_t *)&data[i]); //cstat !MISRAC2012-Rule-11.3
+      i += 4U;
+    }
+    while (i < length)
+    {
+      *(__IO uint8_t *)(__IO void *)(&CRC->DR) = data[i]; //cstat !MISRAC2012-Rule-11.3
+      i++;
+    }
+    crc = (uint16_t)CRC->DR;
+    ASPEP_CRCUnitBusy = false;
+  }
+#endif
+
+  while (i < length)
+  {
+    crc = (uint16_t)(crc << 8) ^ CRC16_Lookup8[(uint8_t)(crc >> 8) ^ data[i]];
+    i++;
+  }
+  return (crc);
+}
+#endif /* ASPEP_DATA_CRC */
+
 void ASPEP_start(ASPEP_Handle_t *pHandle)
 {
 #ifdef NULL_PTR_ASP
@@ -174,9 +282,15 @@ void ASPEP_start(ASPEP_Handle_t *pHandle)
     pHandle->ASPEP_State = ASPEP_IDLE;
     pHandle->ASPEP_TL_State = WAITING_PACKET;
     pHandle->syncPacketCount = 0; /* Sync packet counter is reset only at startup*/
+#if defined(ASPEP_DATA_CRC) && defined(CRC_POL_POL)
+    RCC->AHB1ENR |= RCC_AHB1ENR_CRCEN;
+    (void)RCC->AHB1ENR; /* Delay after the clock enable */
+    CRC->POL = 0x1021U;
+    CRC->INIT = 0xFFFFU;
+#endif
 
     /* Configure UART to receive first packet*/
-    pHandle->fASPEP_receive(pHandle->HWIp, pHandle->rxHeader, ASPEP_HEADER_SIZE);
+    pHandle->fASPEP_receive(pHandle->HWIp, pHandle->rxSlot[pHandle->rxWriteIndex].header, ASPEP_HEADER_SIZE);
 #ifdef NULL_PTR_ASP
   }
 #endif
@@ -253,10 +367,13 @@ bool ASPEP_getBuffer(MCTL_Handle_t *pSupHandle, void **buffer,  uint8_t syncAsyn
 
     if (MCTL_SYNC == syncAsync)
     {
-      if (pHandle->syncBuffer.state <= writeLock) /* Possible values are free or writeLock*/
+      /* Only the buffer at the write index can be given: the ring is full while it is not sent */
+      MCTL_Buff_t *syncBuff = &pHandle->syncBuffer[pHandle->syncWriteIndex];
+
+      if (syncBuff->state <= writeLock) /* Possible values are free or writeLock*/
       {
-        *buffer = &pHandle->syncBuffer.buffer[ASPEP_HEADER_SIZE];
-        pHandle->syncBuffer.state = writeLock;
+        *buffer = &syncBuff->buffer[ASPEP_HEADER_SIZE];
+        syncBuff->state = writeLock;
       }
       else
       {
@@ -265,34 +382,20 @@ bool ASPEP_getBuffer(MCTL_Handle_t *pSupHandle, void **buffer,  uint8_t syncAsyn
     }
     else /* Asynchronous buffer request */
     {
-      if ((pHandle->asyncBufferA.state > writeLock) && (pHandle->asyncBufferB.state > writeLock))
+      /* Only the buffer at the write index can be given: the ring is full while it is not sent */
+      MCTL_Buff_t *asyncBuff = &pHandle->asyncBuffer[pHandle->asyncWriteIndex];
+
+      if (asyncBuff->state > writeLock)
       {
         result = false;
       }
       else
       {
-        if (pHandle->asyncBufferA.state <= writeLock)
-        {
-          pHandle->asyncBufferA.state = writeLock;
-          pHandle->lastRequestedAsyncBuff = &pHandle->asyncBufferA;
-          *buffer = &pHandle->asyncBufferA.buffer[ASPEP_HEADER_SIZE];
-#ifdef MCP_DEBUG_METRICS
-          pHandle->asyncBufferA.RequestedNumber++;
-#endif
-        }
-        else if (pHandle->asyncBufferB.state <= writeLock)
-        {
-          pHandle->asyncBufferB.state = writeLock;
-          pHandle->lastRequestedAsyncBuff = &pHandle->asyncBufferB;
-          *buffer = &pHandle->asyncBufferB.buffer[ASPEP_HEADER_SIZE];
+        asyncBuff->state = writeLock;
+        *buffer = &asyncBuff->buffer[ASPEP_HEADER_SIZE];
 #ifdef MCP_DEBUG_METRICS
-          pHandle->asyncBufferB.RequestedNumber++;
+        asyncBuff->RequestedNumber++;
 #endif
-        }
-        else
-        {
-          /* Nothing to do */
-        }
       }
     }
 #ifdef NULL_PTR_ASP
@@ -304,11 +407,12 @@ bool ASPEP_getBuffer(MCTL_Handle_t *pSupHandle, void **buffer,  uint8_t syncAsyn
 bool ASPEP_CheckBeacon (ASPEP_Handle_t * pHandle)
 {
   bool result = true;
-  uint32_t packetHeader = *((uint32_t *)pHandle->rxHeader); //cstat !MISRAC2012-Rule-11.3
+  uint8_t *rxHeader = pHandle->rxSlot[pHandle->rxReadIndex].header;
+  uint32_t packetHeader = *((uint32_t *)rxHeader); //cstat !MISRAC2012-Rule-11.3
   ASPEP_Capabilities_def MasterCapabilities;
   MasterCapabilities.version =  (uint8_t)((packetHeader &0x70U)>> 4U); /*Bits 4 to 6*/
-  MasterCapabilities.DATA_CRC = pHandle->rxHeader[0] >> 7U ;      /*Bit 7 */
-  MasterCapabilities.RX_maxSize =  pHandle->rxHeader[1] &0x3FU; /*Bits 8 to  13*/
+  MasterCapabilities.DATA_CRC = rxHeader[0] >> 7U ;      /*Bit 7 */
+  MasterCapabilities.RX_maxSize =  rxHeader[1] &0x3FU; /*Bits 8 to  13*/
   MasterCapabilities.TXS_maxSize = (uint8_t)((packetHeader&0x01FC000U)  >> 14); /*Bits 14 to 20 */
   MasterCapabilities.TXA_maxSize = (uint8_t)((packetHeader&0xFE00000U) >> 21); /*Bits 21 to 27  */
 
@@ -335,6 +439,29 @@ bool ASPEP_CheckBeacon (ASPEP_Handle_t * pHandle)
   return (result);
 }
 
+/*
+ Frees the oldest received slot once its packet is consumed. If the receiver waits for
+ a free slot, it is armed in the one just freed, the only one that was not.
+  */
+static void ASPEP_releaseRxSlot(ASPEP_Handle_t *pHandle)
+{
+  ASPEP_rxSlot_t *slot = &pHandle->rxSlot[pHandle->rxReadIndex];
+
+  pHandle->rxReadIndex = ASPEP_NEXT_SYNC(pHandle->rxReadIndex);
+  __disable_irq(); /* The receiver may complete a packet meanwhile */
+  slot->ready = false;
+  if (pHandle->rxStalled)
+  {
+    pHandle->rxStalled = false;
+    pHandle->fASPEP_receive(pHandle->HWIp, pHandle->rxSlot[pHandle->rxWriteIndex].header, ASPEP_HEADER_SIZE);
+  }
+  else
+  {
+    /* Nothing to do, the receiver is already armed */
+  }
+  __enable_irq();
+}
+
 /*
 
  void *txBuffer, can be 8, 16 or 32 bits, but must be 32 bits aligned.
@@ -364,24 +491,36 @@ uint8_t ASPEP_sendPacket(MCTL_Handle_t *pSupHandle, void *txBuffer, uint16_t txD
     if (ASPEP_CONNECTED == pHandle-> ASPEP_State)
     {
       /*We must add packet header on  */
-      /* | [0101|0011] | Length 13b | Reserved |CRCH 4b| */
+      /* | [0101|0011] | Length 13b | Reserved 3b | Tag 8b |CRCH 4b| */
       packet = (uint8_t *)txBuffer; //cstat !MISRAC2012-Rule-11.5
       header = (uint32_t *)txBuffer; //cstat !MISRAC2012-Rule-11.5
       header--; /* Header ues 4*8 bits on top of txBuffer*/
       tmpHeader = ((uint32_t)((uint32_t)txDataLengthTemp << (uint32_t)4) | (uint32_t)syncAsync);
+      if (MCTL_SYNC == syncAsync)
+      {
+        /* The answer carries the tag of its request */
+        tmpHeader |= ((uint32_t)pHandle->rxSequence & ASPEP_SEQ_MASK) << ASPEP_SEQ_POS;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
       *header = tmpHeader;
+#ifdef ASPEP_DATA_CRC
       if (1U == pHandle->Capabilities.DATA_CRC)
       {
-        /* TODO : Compute real CRC*/
-        packet[txDataLengthTemp] = (uint8_t)0xCA; /* Dummy CRC */
-        packet[txDataLengthTemp + 1U] = (uint8_t)0xFE; /* Dummy CRC */
+        uint16_t dataCRC = ASPEP_ComputeDataCRC(packet, txDataLengthTemp);
+        packet[txDataLengthTemp] = (uint8_t)(dataCRC >> 8);
+        packet[txDataLengthTemp + 1U] = (uint8_t)dataCRC;
         txDataLengthTemp += (uint16_t)ASPEP_DATACRC_SIZE;
       }
+#endif
       if (MCTL_SYNC == syncAsync)
       {
         if (pSupHandle->MCP_PacketAvailable)
         {
           pSupHandle->MCP_PacketAvailable = false; /* CMD from master is processed*/
+          ASPEP_releaseRxSlot(pHandle); /* Its slot may receive the next request */
         }
         else
         {
@@ -425,72 +564,87 @@ uint8_t ASPEP_TXframeProcess(ASPEP_Handle_t *pHandle, uint8_t dataType, void *tx
 #endif
     /* Insert CRC header in the packet to send */
     ASPEP_ComputeHeaderCRC((uint32_t *)txBuffer); //cstat !MISRAC2012-Rule-11.5
-    __disable_irq(); /*TODO: Disable High frequency task is enough */
-    if (NULL == pHandle->lockBuffer) /* Communication Ip free to send data*/
+    if (MCTL_ASYNC == dataType)
     {
-      if (MCTL_ASYNC == dataType)
-      {
-        /* In ASYNC, two flipflop buffers are used, the txBuffer points always to lastRequestedAsyncBuff->buffer */
-        pHandle->lastRequestedAsyncBuff->state = readLock;
-        pHandle->lockBuffer = (void *)pHandle->lastRequestedAsyncBuff;
-#ifdef MCP_DEBUG_METRICS
-        pHandle->lastRequestedAsyncBuff->SentNumber++;
-#endif
-      }
-      else if (MCTL_SYNC == dataType)
+      /* The txBuffer points always to the buffer at the write index, given by ASPEP_getBuffer */
+      MCTL_Buff_t *asyncBuff = &pHandle->asyncBuffer[pHandle->asyncWriteIndex];
+
+      if (txBuffer != (void *)asyncBuff->buffer)
       {
-        pHandle->syncBuffer.state = readLock;
-        pHandle->lockBuffer = (void *) &pHandle->syncBuffer;
+        result = ASPEP_BUFFER_ERROR;
       }
       else
       {
-        pHandle->ctrlBuffer.state = readLock;
-        pHandle->lockBuffer = (void *)&pHandle->ctrlBuffer;
-      }
-      /* Enable HF task It */
-      __enable_irq(); /*TODO: Enable High frequency task is enough */
-      pHandle->fASPEP_send(pHandle->HWIp, txBuffer, bufferLength);
-    }
-    else /* HW resource busy, saving packet to sent it once resource will be freed*/
-    {
-      __enable_irq(); /*TODO: Enable High frequency task is enough */
-      /* Lock buffer can be freed here */
-      if (MCTL_ASYNC == dataType)
-      {
-        /* Check that the buffer received is the one expected - probably useless */
-        if (txBuffer != (uint8_t *)pHandle->lastRequestedAsyncBuff->buffer)
+        asyncBuff->length = bufferLength;
+        pHandle->asyncWriteIndex = (pHandle->asyncWriteIndex < (ASPEP_ASYNC_NB_BUFFERS - 1U))
+                                 ? (pHandle->asyncWriteIndex + 1U) : 0U;
+        __disable_irq(); /*TODO: Disable High frequency task is enough */
+        if (NULL == pHandle->lockBuffer) /* Communication Ip free to send data*/
         {
-          result = ASPEP_BUFFER_ERROR;
+          /* Nothing is pending while the Ip is free: this buffer is the one at the read index */
+          asyncBuff->state = readLock;
+          pHandle->lockBuffer = (void *)asyncBuff;
+          pHandle->asyncReadIndex = pHandle->asyncWriteIndex;
+#ifdef MCP_DEBUG_METRICS
+          asyncBuff->SentNumber++;
+#endif
+          __enable_irq(); /*TODO: Enable High frequency task is enough */
+          pHandle->fASPEP_send(pHandle->HWIp, txBuffer, bufferLength);
         }
-        if (NULL == pHandle->asyncNextBuffer)
+        else /* HW resource busy, the buffer is sent by ASPEP_HWDataTransmittedIT in the ring order */
         {
-          /* Required to keep the right sending order */
-          pHandle->asyncNextBuffer = pHandle->lastRequestedAsyncBuff;
-        }
-      else
-      {
-        /* nothing to do */
-      }
-        pHandle->lastRequestedAsyncBuff->state = pending;
-        pHandle->lastRequestedAsyncBuff->length = bufferLength;
+          asyncBuff->state = pending;
 #ifdef MCP_DEBUG_METRICS
-        pHandle->lastRequestedAsyncBuff->PendingNumber++;
+          asyncBuff->PendingNumber++;
 #endif
+          __enable_irq(); /*TODO: Enable High frequency task is enough */
+        }
+      }
+    }
+    else if (MCTL_SYNC == dataType)
+    {
+      /* The txBuffer points always to the buffer at the write index, given by ASPEP_getBuffer */
+      MCTL_Buff_t *syncBuff = &pHandle->syncBuffer[pHandle->syncWriteIndex];
+
+      if ((txBuffer != (void *)syncBuff->buffer) || (syncBuff->state != writeLock))
+      {
+        result = ASPEP_BUFFER_ERROR;
       }
-      else if (MCTL_SYNC == dataType)
+      else
       {
-        if (pHandle -> syncBuffer.state != writeLock)
+        syncBuff->length = bufferLength;
+        pHandle->syncWriteIndex = ASPEP_NEXT_SYNC(pHandle->syncWriteIndex);
+        __disable_irq(); /*TODO: Disable High frequency task is enough */
+        if (NULL == pHandle->lockBuffer) /* Communication Ip free to send data*/
         {
-          result = ASPEP_BUFFER_ERROR;
+          /* Nothing is pending while the Ip is free: this buffer is the one at the read index */
+          syncBuff->state = readLock;
+          pHandle->lockBuffer = (void *)syncBuff;
+          pHandle->syncReadIndex = pHandle->syncWriteIndex;
+          __enable_irq(); /*TODO: Enable High frequency task is enough */
+          pHandle->fASPEP_send(pHandle->HWIp, txBuffer, bufferLength);
         }
-        else
+        else /* HW resource busy, the answer is sent by ASPEP_HWDataTransmittedIT in the ring order */
         {
-          pHandle->syncBuffer.state = pending;
-          pHandle->syncBuffer.length = bufferLength;
+          syncBuff->state = pending;
+          __enable_irq(); /*TODO: Enable High frequency task is enough */
         }
       }
-      else if(ASPEP_CTRL == dataType)
+    }
+    else /* ASPEP_CTRL */
+    {
+      __disable_irq(); /*TODO: Disable High frequency task is enough */
+      if (NULL == pHandle->lockBuffer) /* Communication Ip free to send data*/
+      {
+        pHandle->ctrlBuffer.state = readLock;
+        pHandle->lockBuffer = (void *)&pHandle->ctrlBuffer;
+        /* Enable HF task It */
+        __enable_irq(); /*TODO: Enable High frequency task is enough */
+        pHandle->fASPEP_send(pHandle->HWIp, txBuffer, bufferLength);
+      }
+      else /* HW resource busy, saving packet to sent it once resource will be freed*/
       {
+        __enable_irq(); /*TODO: Enable High frequency task is enough */
         if (pHandle->ctrlBuffer.state != available)
         {
           result = ASPEP_BUFFER_ERROR;
@@ -500,10 +654,6 @@ uint8_t ASPEP_TXframeProcess(ASPEP_Handle_t *pHandle, uint8_t dataType, void *tx
           pHandle->ctrlBuffer.state = pending;
         }
       }
-      else
-      {
-        /* Nothing to do */
-      }
     }
 #ifdef NULL_PTR_ASP
   }
@@ -535,11 +685,14 @@ void ASPEP_HWDataTransmittedIT(ASPEP_Handle_t *pHandle)
       MCTL_Buff_t *tempBuff = (MCTL_Buff_t *)pHandle->lockBuffer; //cstat !MISRAC2012-Rule-11.5
       tempBuff->state = available;
     }
-    if (pHandle->syncBuffer.state == pending)
+    /* Answers are pending in the ring order, the oldest one is at the read index */
+    MCTL_Buff_t *syncBuff = &pHandle->syncBuffer[pHandle->syncReadIndex];
+    if (pending == syncBuff->state)
     {
-      pHandle->lockBuffer = (void *)&pHandle->syncBuffer;
-      pHandle->fASPEP_send(pHandle->HWIp, pHandle->syncBuffer.buffer, pHandle->syncBuffer.length);
-      pHandle->syncBuffer.state = readLock;
+      pHandle->lockBuffer = (void *)syncBuff;
+      syncBuff->state = readLock;
+      pHandle->syncReadIndex = ASPEP_NEXT_SYNC(pHandle->syncReadIndex);
+      pHandle->fASPEP_send(pHandle->HWIp, syncBuff->buffer, syncBuff->length);
     }
     /* Second prepare transfer of pending buffer */
     else if (pHandle->ctrlBuffer.state == pending)
@@ -551,26 +704,18 @@ void ASPEP_HWDataTransmittedIT(ASPEP_Handle_t *pHandle)
     else
     {
       __disable_irq();
-      if (pHandle->asyncNextBuffer != NULL)
+      /* Async buffers are pending in the ring order, the oldest one is at the read index */
+      MCTL_Buff_t *asyncBuff = &pHandle->asyncBuffer[pHandle->asyncReadIndex];
+      if (pending == asyncBuff->state)
       {
-        pHandle->lockBuffer = (void *)pHandle->asyncNextBuffer;
-        pHandle->asyncNextBuffer->state = readLock;
+        pHandle->lockBuffer = (void *)asyncBuff;
+        asyncBuff->state = readLock;
+        pHandle->asyncReadIndex = (pHandle->asyncReadIndex < (ASPEP_ASYNC_NB_BUFFERS - 1U))
+                                ? (pHandle->asyncReadIndex + 1U) : 0U;
 #ifdef MCP_DEBUG_METRICS
-        pHandle->asyncNextBuffer->SentNumber++;
+        asyncBuff->SentNumber++;
 #endif
-        pHandle->fASPEP_send(pHandle ->HWIp, pHandle->asyncNextBuffer->buffer, pHandle->asyncNextBuffer->length);
-        /* If one Async buffer is still pending, assign it to the asyncNextBuffer pointer*/
-        if ((pHandle->asyncBufferA.state == pending) || (pHandle->asyncBufferB.state == pending))
-        {
-          //cstat !MISRAC2012-Rule-11.4
-          uint32_t temp = (uint32_t)&pHandle->asyncBufferA + (uint32_t)&pHandle->asyncBufferB
-                          - (uint32_t) pHandle->asyncNextBuffer; //cstat !MISRAC2012-Rule-11.4
-          pHandle->asyncNextBuffer = (MCTL_Buff_t *) temp; //cstat !MISRAC2012-Rule-11.4
-        }
-        else
-        {
-          pHandle->asyncNextBuffer = NULL;
-        }
+        pHandle->fASPEP_send(pHandle ->HWIp, asyncBuff->buffer, asyncBuff->length);
       }
       else /* No TX packet are pending, HW resource is free*/
       {
@@ -595,19 +740,24 @@ uint8_t *ASPEP_RXframeProcess(MCTL_Handle_t *pSupHandle, uint16_t *packetLength)
   {
 #endif
     ASPEP_Handle_t *pHandle = (ASPEP_Handle_t *)pSupHandle; //cstat !MISRAC2012-Rule-11.3
-    uint32_t packetHeader = *((uint32_t *)pHandle->rxHeader); //cstat !MISRAC2012-Rule-11.3
+    ASPEP_rxSlot_t *slot = &pHandle->rxSlot[pHandle->rxReadIndex]; /* Oldest packet received */
+    uint32_t packetHeader = *((uint32_t *)slot->header); //cstat !MISRAC2012-Rule-11.3
     uint16_t packetNumber;
     bool validCRCData = true;
 
     *packetLength = 0;
-    if (pHandle->NewPacketAvailable)
+    if ((true == slot->ready) && (DATA_PACKET == slot->packetType)
+        && (pHandle->syncBuffer[pHandle->syncWriteIndex].state > writeLock))
+    {
+      /* Nothing to do, the request waits until a buffer is free to build its answer */
+    }
+    else if (true == slot->ready)
     {
-      pHandle->NewPacketAvailable = false; /* Consumes new packet*/
       switch (pHandle->ASPEP_State)
       {
         case ASPEP_IDLE:
         {
-          if (BEACON == pHandle->rxPacketType)
+          if (BEACON == slot->packetType)
           {
             if (ASPEP_CheckBeacon(pHandle) == true)
             {
@@ -624,7 +774,7 @@ uint8_t *ASPEP_RXframeProcess(MCTL_Handle_t *pSupHandle, uint16_t *packetLength)
             /* Beacon Packet must be answered*/
             ASPEP_sendBeacon(pHandle, &pHandle->Capabilities);
           }
-          else if (PING == pHandle->rxPacketType)
+          else if (PING == slot->packetType)
           {
             /* In Listening for master slave, */
             packetNumber = (uint16_t)((packetHeader & 0x0FFFF000U) >> (uint16_t)12U);
@@ -639,7 +789,7 @@ uint8_t *ASPEP_RXframeProcess(MCTL_Handle_t *pSupHandle, uint16_t *packetLength)
 
         case ASPEP_CONFIGURED:
         {
-          if (BEACON == pHandle->rxPacketType)
+          if (BEACON == slot->packetType)
           {
             if (ASPEP_CheckBeacon(pHandle) == false)
             {
@@ -652,7 +802,7 @@ uint8_t *ASPEP_RXframeProcess(MCTL_Handle_t *pSupHandle, uint16_t *packetLength)
 
             ASPEP_sendBeacon (pHandle, &pHandle->Capabilities);
           }
-          else if (PING == pHandle->rxPacketType)
+          else if (PING == slot->packetType)
           {
             /* In Listening for master slave, */
             packetNumber = (uint16_t)((packetHeader & 0x0FFFF000U) >> (uint16_t)12U);
@@ -668,7 +818,7 @@ uint8_t *ASPEP_RXframeProcess(MCTL_Handle_t *pSupHandle, uint16_t *packetLength)
 
         case ASPEP_CONNECTED:
         {
-          if (BEACON == pHandle->rxPacketType)
+          if (BEACON == slot->packetType)
           {
             if (ASPEP_CheckBeacon(pHandle) == false)
             {
@@ -680,19 +830,29 @@ uint8_t *ASPEP_RXframeProcess(MCTL_Handle_t *pSupHandle, uint16_t *packetLength)
             }
             ASPEP_sendBeacon(pHandle, &pHandle->Capabilities);
           }
-          else if (PING == pHandle->rxPacketType)
+          else if (PING == slot->packetType)
           {
-            packetNumber = pHandle->rxHeader[1];
+            packetNumber = slot->header[1];
             ASPEP_sendPing(pHandle, ASPEP_PING_CFG, packetNumber);
           }
-          else if (DATA_PACKET == pHandle->rxPacketType)
+          else if (DATA_PACKET == slot->packetType)
           {
+#ifdef ASPEP_DATA_CRC
+            /* A packet without payload is received without data CRC */
+            if ((1U == pHandle->Capabilities.DATA_CRC) && (slot->length > 0U))
+            {
+              uint16_t dataCRC = (uint16_t)((uint16_t)slot->buffer[slot->length] << 8)
+                               | (uint16_t)slot->buffer[slot->length + 1U];
+              validCRCData = (ASPEP_ComputeDataCRC(slot->buffer, slot->length) == dataCRC);
+            }
+#endif
             if (validCRCData)
             {
               pHandle->syncPacketCount++; /* this counter is incremented at each valid data packet received from master */
               pSupHandle->MCP_PacketAvailable = true; /* Will be consumed in ASPEP_sendPacket */
-              *packetLength = pHandle->rxLength;
-              result = pHandle->rxBuffer;
+              pHandle->rxSequence = (uint8_t)((packetHeader >> ASPEP_SEQ_POS) & ASPEP_SEQ_MASK);
+              *packetLength = slot->length;
+              result = slot->buffer;
             }
             else
             {
@@ -701,7 +861,7 @@ uint8_t *ASPEP_RXframeProcess(MCTL_Handle_t *pSupHandle, uint16_t *packetLength)
           }
           else
           {
-            /* This condition is not reachable because already filtred by NewPacketAvailable */
+            /* This condition is not reachable because already filtred by ASPEP_HWDataReceivedIT */
             /* ASPEP_sendNack (pHandle, ASPEP_BAD_PACKET_TYPE) */
           }
           break;
@@ -710,8 +870,15 @@ uint8_t *ASPEP_RXframeProcess(MCTL_Handle_t *pSupHandle, uint16_t *packetLength)
         default:
           break;
       }
-      /* The valid received packet is now safely consumes, we are ready to receive a new packet */
-      pHandle->fASPEP_receive(pHandle->HWIp, pHandle->rxHeader, ASPEP_HEADER_SIZE);
+      if (NULL == result)
+      {
+        /* The packet is consumed, its slot may receive a new packet */
+        ASPEP_releaseRxSlot(pHandle);
+      }
+      else
+      {
+        /* Nothing to do, the request is kept until ASPEP_sendPacket has its answer */
+      }
     }
     else if (pHandle->badPacketFlag > ASPEP_OK)
     {
@@ -736,6 +903,22 @@ uint8_t *ASPEP_RXframeProcess(MCTL_Handle_t *pSupHandle, uint16_t *packetLength)
   return (result);
 }
 
+/* Marks the slot being filled as received, and arms the receiver in the next one if it
+   is free. Otherwise the receiver is armed by ASPEP_releaseRxSlot. */
+static void ASPEP_rxSlotReceived(ASPEP_Handle_t *pHandle)
+{
+  pHandle->rxSlot[pHandle->rxWriteIndex].ready = true;
+  pHandle->rxWriteIndex = ASPEP_NEXT_SYNC(pHandle->rxWriteIndex);
+  if (true == pHandle->rxSlot[pHandle->rxWriteIndex].ready)
+  {
+    pHandle->rxStalled = true;
+  }
+  else
+  {
+    pHandle->fASPEP_receive(pHandle->HWIp, pHandle->rxSlot[pHandle->rxWriteIndex].header, ASPEP_HEADER_SIZE);
+  }
+}
+
 /* This function is called once DMA has transfered the configure number of byte*/
 void ASPEP_HWDataReceivedIT(ASPEP_Handle_t *pHandle)
 {
@@ -747,34 +930,35 @@ void ASPEP_HWDataReceivedIT(ASPEP_Handle_t *pHandle)
   else
   {
 #endif
-    /* Upon reception of a Newpacket the DMA will be re-configured only once the answer has been sent.
-      * This is mandatory to avoid a race condition in case of a new packet is received while executing ASPEP_
-      * RXframeProcess
+    /* Each packet is received in its own slot, kept until ASPEP_RXframeProcess has consumed it, or until the
+      * answer to a data packet is built. The DMA is re-configured at once in the next slot, so that the master may
+      * send a request before the answer to the previous one, up to ASPEP_SYNC_NB_BUFFERS requests. If all the slots
+      * are busy, the DMA is configured once one is freed.
       * If the packet received contains an error in the header, the HW IP will be re-synchronised first, and DMA will be
       * configured after.*/
+    ASPEP_rxSlot_t *slot = &pHandle->rxSlot[pHandle->rxWriteIndex];
+
     switch (pHandle->ASPEP_TL_State)
     {
       case WAITING_PACKET:
       {
-        if (ASPEP_CheckHeaderCRC(*(uint32_t *)pHandle->rxHeader) == true) //cstat !MISRAC2012-Rule-11.3
+        if (ASPEP_CheckHeaderCRC(*(uint32_t *)slot->header) == true) //cstat !MISRAC2012-Rule-11.3
         {
-          pHandle->rxPacketType = (ASPEP_packetType)(((uint32_t)pHandle->rxHeader[0]) & ID_MASK);
-          switch (pHandle->rxPacketType)
+          slot->packetType = (ASPEP_packetType)(((uint32_t)slot->header[0]) & ID_MASK);
+          switch (slot->packetType)
           {
             case DATA_PACKET:
             {
               //cstat !MISRAC2012-Rule-11.3
-              pHandle->rxLength = (uint16_t)((*((uint16_t *)pHandle->rxHeader) & 0x1FFF0U) >> (uint16_t)4);
-              if (0U == pHandle->rxLength) /* data packet with length 0 is a valid packet */
+              slot->length = (uint16_t)((*((uint16_t *)slot->header) & 0x1FFF0U) >> (uint16_t)4);
+              if (0U == slot->length) /* data packet with length 0 is a valid packet */
               {
-                pHandle->NewPacketAvailable = true;
-                /* The receiver is not reconfigure right now on purpose to avoid race condition when the packet will be
-                  *  processed in ASPEP_RXframeProcess */
+                ASPEP_rxSlotReceived(pHandle);
               }
-              else if (pHandle->rxLength <= pHandle->maxRXPayload)
+              else if (slot->length <= pHandle->maxRXPayload)
               {
-                pHandle->fASPEP_receive(pHandle->HWIp, pHandle->rxBuffer,  /* need to read + 2 bytes CRC*/
-                                        (pHandle->rxLength + ((uint16_t)ASPEP_DATACRC_SIZE * (uint16_t)pHandle->Capabilities.DATA_CRC)));
+                pHandle->fASPEP_receive(pHandle->HWIp, slot->buffer,  /* need to read + 2 bytes CRC*/
+                                        (slot->length + ((uint16_t)ASPEP_DATACRC_SIZE * (uint16_t)pHandle->Capabilities.DATA_CRC)));
                 pHandle->ASPEP_TL_State = WAITING_PAYLOAD;
               }
               else
@@ -787,9 +971,7 @@ void ASPEP_HWDataReceivedIT(ASPEP_Handle_t *pHandle)
             case BEACON:
             case PING:
             {
-              pHandle->NewPacketAvailable = true;
-              /* The receiver is not reconfigure right now on purpose to avoid race condition when the packet will be
-                * processed in ASPEP_RXframeProcess */
+              ASPEP_rxSlotReceived(pHandle);
               break;
             }
 
@@ -811,9 +993,7 @@ void ASPEP_HWDataReceivedIT(ASPEP_Handle_t *pHandle)
       {
         pHandle->ASPEP_TL_State = WAITING_PACKET;
         /* Payload received, */
-        pHandle->NewPacketAvailable = true;
-        /* The receiver is not reconfigure right now on purpose to avoid race condition when the packet will be
-          * processed in ASPEP_RXframeProcess */
+        ASPEP_rxSlotReceived(pHandle);
         break;
       }
 
@@ -837,10 +1017,18 @@ void ASPEP_HWDMAReset(ASPEP_Handle_t *pHandle)
   {
 #endif
     /* We must reset the RX state machine to be sure to not be in Waiting packet state */
-    /* Otherwise the arrival of a new packet will trigger a NewPacketAvailable despite */
+    /* Otherwise the arrival of a new packet will be taken as a received packet despite */
     /* the fact that bytes have been lost because of overrun (debugger paused for instance) */
     pHandle->ASPEP_TL_State = WAITING_PACKET;
-    pHandle->fASPEP_receive(pHandle->HWIp, pHandle->rxHeader, ASPEP_HEADER_SIZE);
+    if (true == pHandle->rxSlot[pHandle->rxWriteIndex].ready)
+    {
+      /* The slot still holds a packet, the receiver is armed once it is consumed */
+      pHandle->rxStalled = true;
+    }
+    else
+    {
+      pHandle->fASPEP_receive(pHandle->HWIp, pHandle->rxSlot[pHandle->rxWriteIndex].header, ASPEP_HEADER_SIZE);
+    }
 #ifdef NULL_PTR_ASP
   }
 #endif
@@ -21,6 +21,19 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "mc_tasks.h"
+#ifdef MC_PWM_SYNC_MODE
+#include "mc_pwm_sync.h"
+#endif
+#ifdef MC_PWM_DITHER_MODE
+#include "mc_pwm_dither.h"
+#endif
+#ifdef MC_SPECTRUM_MODE
+#include "mc_spectrum.h"
+#endif
+#ifdef MC_STACK_MODE
+#include "mc_stack.h"
+#endif
 
 /* USER CODE END Includes */
 
@@ -48,6 +61,9 @@ DMA_HandleTypeDef hdma_usart2_rx;
 DMA_HandleTypeDef hdma_usart2_tx;
 
 /* USER CODE BEGIN PV */
+#ifdef M1_ENCODER_SENSOR
+TIM_HandleTypeDef htim2;
+#endif
 
 /* USER CODE END PV */
 
@@ -60,6 +76,15 @@ static void MX_TIM1_Init(void);
 static void MX_USART2_UART_Init(void);
 static void MX_NVIC_Init(void);
 /* USER CODE BEGIN PFP */
+#ifdef M1_ENCODER_SENSOR
+static void MX_TIM2_Init(void);
+#endif
+#if defined(MC_PWM_SYNC_MODE) && (MC_PWM_SYNC_SOURCE == MC_PWM_SYNC_EXTI)
+static void MX_PWM_SYNC_Init(void);
+#endif
+#ifdef M1_ICL_ENABLED
+static void MX_ICL_Init(void);
+#endif
 
 /* USER CODE END PFP */
 
@@ -75,6 +100,10 @@ static void MX_NVIC_Init(void);
 int main(void)
 {
   /* USER CODE BEGIN 1 */
+#ifdef MC_STACK_MODE
+  /* Before the first interrupt */
+  MC_Stack_Paint();
+#endif
 
   /* USER CODE END 1 */
 
@@ -91,6 +120,10 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+#ifdef M1_ENCODER_SENSOR
+  /* Counting before MCboot, that initializes the encoder component */
+  MX_TIM2_Init();
+#endif
 
   /* USER CODE END SysInit */
 
@@ -105,6 +138,19 @@ int main(void)
   /* Initialize interrupts */
   MX_NVIC_Init();
   /* USER CODE BEGIN 2 */
+#ifdef MC_PWM_DITHER_MODE
+  MC_PwmDither_Init();
+#endif
+#ifdef MC_PWM_SYNC_MODE
+  MC_PwmSync_Init();
+#if (MC_PWM_SYNC_SOURCE == MC_PWM_SYNC_EXTI)
+  MX_PWM_SYNC_Init();
+#endif
+#endif
+#ifdef M1_ICL_ENABLED
+  /* The output keeps the state written by ICL_Init in MCboot */
+  MX_ICL_Init();
+#endif
 
   /* USER CODE END 2 */
 
@@ -115,6 +161,24 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+    MC_ProcessHostRequests();
+#ifdef MC_STACK_MODE
+    MC_Stack_Scan();
+#endif
+#ifdef MC_SPECTRUM_MODE
+    MC_Spectrum_Process();
+#endif
+#ifdef MC_LOW_POWER_IDLE
+    if (true == TSK_IsLowPowerIdle())
+    {
+      /* A frame received before the sleep waits for the next SysTick at most */
+      __WFI();
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif
   }
   /* USER CODE END 3 */
 }
@@ -175,22 +239,24 @@ void SystemClock_Config(void)
 static void MX_NVIC_Init(void)
 {
   /* USART2_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(USART2_IRQn, 3, 1);
+  HAL_NVIC_SetPriority(USART2_IRQn, MC_IRQ_PRIO_COMM, 1);
   HAL_NVIC_EnableIRQ(USART2_IRQn);
   /* DMA1_Stream5_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, 3, 0);
+  HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, MC_IRQ_PRIO_COMM, 0);
   HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
   /* ADC_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(ADC_IRQn, 2, 0);
+  HAL_NVIC_SetPriority(ADC_IRQn, MC_IRQ_PRIO_HF, 0);
   HAL_NVIC_EnableIRQ(ADC_IRQn);
+  /* PendSV_IRQn interrupt configuration: deferred duties of the high frequency task */
+  HAL_NVIC_SetPriority(PendSV_IRQn, MC_IRQ_PRIO_COMM, 0);
   /* TIM1_UP_TIM10_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(TIM1_UP_TIM10_IRQn, 0, 0);
+  HAL_NVIC_SetPriority(TIM1_UP_TIM10_IRQn, MC_IRQ_PRIO_TIM_UP, 0);
   HAL_NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
   /* TIM1_BRK_TIM9_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(TIM1_BRK_TIM9_IRQn, 4, 1);
+  HAL_NVIC_SetPriority(TIM1_BRK_TIM9_IRQn, TICK_INT_PRIORITY, 1);
   HAL_NVIC_EnableIRQ(TIM1_BRK_TIM9_IRQn);
   /* EXTI15_10_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(EXTI15_10_IRQn, 3, 0);
+  HAL_NVIC_SetPriority(EXTI15_10_IRQn, MC_IRQ_PRIO_COMM, 0);
   HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
 }
 
@@ -399,13 +465,13 @@ static void MX_USART2_UART_Init(void)
 
   /* USER CODE END USART2_Init 1 */
   huart2.Instance = USART2;
-  huart2.Init.BaudRate = 1843200;
+  huart2.Init.BaudRate = MCP_UART_BAUDRATE_A;
   huart2.Init.WordLength = UART_WORDLENGTH_8B;
   huart2.Init.StopBits = UART_STOPBITS_1;
   huart2.Init.Parity = UART_PARITY_NONE;
   huart2.Init.Mode = UART_MODE_TX_RX;
   huart2.Init.HwFlowCtl = UART_HWCONTROL_NONE;
-  huart2.Init.OverSampling = UART_OVERSAMPLING_16;
+  huart2.Init.OverSampling = MCP_UART_OVERSAMPLING_A;
   if (HAL_UART_Init(&huart2) != HAL_OK)
   {
     Error_Handler();
@@ -470,6 +536,81 @@ static void MX_GPIO_Init(void)
 }
 
 /* USER CODE BEGIN 4 */
+#ifdef M1_ENCODER_SENSOR
+/**
+  * @brief TIM2 Initialization Function, quadrature encoder of Motor 1
+  * @param None
+  * @retval None
+  */
+static void MX_TIM2_Init(void)
+{
+  TIM_Encoder_InitTypeDef sConfig = {0};
+
+  htim2.Instance = TIM2;
+  htim2.Init.Prescaler = 0;
+  htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim2.Init.Period = M1_PULSE_NBR;
+  htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  sConfig.EncoderMode = TIM_ENCODERMODE_TI12;
+  sConfig.IC1Polarity = (ENC_INVERT_SPEED == ENABLE) ? TIM_ICPOLARITY_FALLING : TIM_ICPOLARITY_RISING;
+  sConfig.IC1Selection = TIM_ICSELECTION_DIRECTTI;
+  sConfig.IC1Prescaler = TIM_ICPSC_DIV1;
+  sConfig.IC1Filter = ENC_ICX_FILTER;
+  sConfig.IC2Polarity = TIM_ICPOLARITY_RISING;
+  sConfig.IC2Selection = TIM_ICSELECTION_DIRECTTI;
+  sConfig.IC2Prescaler = TIM_ICPSC_DIV1;
+  sConfig.IC2Filter = ENC_ICX_FILTER;
+  if (HAL_TIM_Encoder_Init(&htim2, &sConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  /* TIM2_IRQn interrupt configuration: overflows of the encoder counter */
+  HAL_NVIC_SetPriority(TIM2_IRQn, MC_IRQ_PRIO_COMM, 0);
+  HAL_NVIC_EnableIRQ(TIM2_IRQn);
+}
+#endif
+#if defined(MC_PWM_SYNC_MODE) && (MC_PWM_SYNC_SOURCE == MC_PWM_SYNC_EXTI)
+/**
+  * @brief PWM_SYNC pin Initialization Function, rising edges of the sync event
+  * @param None
+  * @retval None
+  */
+static void MX_PWM_SYNC_Init(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  GPIO_InitStruct.Pin = PWM_SYNC_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+  GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+  HAL_GPIO_Init(PWM_SYNC_GPIO_Port, &GPIO_InitStruct);
+
+  /* PWM_SYNC_EXTI_IRQn interrupt configuration: above the high frequency task, that
+     would otherwise delay the reading of the carrier phase by its duration */
+  HAL_NVIC_SetPriority(PWM_SYNC_EXTI_IRQn, MC_IRQ_PRIO_PWM_SYNC, 0);
+  HAL_NVIC_EnableIRQ(PWM_SYNC_EXTI_IRQn);
+}
+#endif
+#ifdef M1_ICL_ENABLED
+/**
+  * @brief Bypass relay output of the inrush current limiter Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_ICL_Init(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_GPIOC_CLK_ENABLE();
+  GPIO_InitStruct.Pin = M1_ICL_SHUT_OUT_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+  HAL_GPIO_Init(M1_ICL_SHUT_OUT_GPIO_Port, &GPIO_InitStruct);
+}
+#endif
 
 /* USER CODE END 4 */
 
@@ -0,0 +1,308 @@
+/**
+  ******************************************************************************
+  * @file    mc_abtest.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   A/B experiment: two current controllers interleaved in blocks of FOC
+  *          periods, with the statistics of each one
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "main.h"
+#include "parameters_conversion.h"
+#include "mc_abtest.h"
+
+#ifdef MC_ABTEST_MODE
+
+#include "pcc.h"
+
+#if (CURRENT_CONTROLLER != CURR_CTRL_PCC)
+#error "MC_ABTEST_MODE needs the CURR_CTRL_PCC backend"
+#endif
+
+static MC_ABTest_Config_t ABConfig;
+
+/* Written by the MCP requests, read by the high frequency task */
+static volatile MC_ABTest_State_t ABState = MC_ABTEST_IDLE;
+
+/* Written by the high frequency task, read by the MCP requests with the interrupts
+   masked */
+static MC_ABTest_ArmStats_t ABStats[MC_ABTEST_NB_ARMS];
+static volatile uint8_t bABArm;   /* Arm of the current block */
+
+static bool ABActive;             /* The arm of the period ran the regulation */
+static uint16_t hABPeriod;        /* Periods of the current block */
+static uint8_t bABLegLevels;      /* Side of each leg at the edges of the last period */
+static uint32_t wABStart;         /* Cycle counter at the start of the high frequency task */
+
+/**
+ * @brief  Returns the tracking error of a current, saturated to the range of a digit
+ */
+static int32_t MC_ABTest_Error(int16_t hRef, int16_t hMeas)
+{
+  int32_t wErr = (int32_t)hRef - hMeas;
+
+  return ((wErr > INT16_MAX) ? INT16_MAX : ((wErr < -INT16_MAX) ? -INT16_MAX : wErr));
+}
+
+/**
+ * @brief  Returns the side of a leg at the edges of the PWM period, and whether it
+ *         commutes within the period. With the center aligned PWM, a compare value
+ *         between 0 and the one of a high side on over the whole period turns the
+ *         high side on at the edges and the low side on in the middle.
+ */
+static uint8_t MC_ABTest_Leg(uint16_t hCnt, uint16_t hHighCnt, bool *pModulated)
+{
+  *pModulated = (hCnt > 0U) && (hCnt < hHighCnt);
+  return ((hCnt > 0U) ? 1U : 0U);
+}
+
+/**
+ * @brief  Returns the commutations of the inverter legs for the compare values of the
+ *         period: two for each leg modulated, one for each leg that changes side
+ *         since the previous period.
+ */
+static uint32_t MC_ABTest_CountSwitches(const PWMC_Handle_t *pPWMC)
+{
+  bool Modulated[3];
+  uint8_t bLevels;
+  uint8_t bChanged;
+  uint32_t wSwitches = 0U;
+  uint8_t i;
+
+  bLevels = MC_ABTest_Leg(pPWMC->CntPhA, pPWMC->StateHighCnt, &Modulated[0])
+          | (uint8_t)(MC_ABTest_Leg(pPWMC->CntPhB, pPWMC->StateHighCnt, &Modulated[1]) << 1)
+          | (uint8_t)(MC_ABTest_Leg(pPWMC->CntPhC, pPWMC->StateHighCnt, &Modulated[2]) << 2);
+  bChanged = bLevels ^ bABLegLevels;
+  bABLegLevels = bLevels;
+  for (i = 0U; i < 3U; i++)
+  {
+    wSwitches += (true == Modulated[i]) ? 2U : 0U;
+    wSwitches += (uint32_t)(bChanged >> i) & 1U;
+  }
+  return (wSwitches);
+}
+
+/**
+ * @brief  Configures the arms and the blocks of the experiment. An experiment in
+ *         progress is stopped.
+ * @param  pConfig: experiment configuration
+ * @retval bool False if an arm is unknown or has a weight entry out of the table, or
+ *         if the settling does not leave a period of the block. The configuration is
+ *         then left unchanged.
+ */
+bool MC_ABTest_Configure(const MC_ABTest_Config_t *pConfig)
+{
+  bool bValid = (pConfig->hSettlePeriods < pConfig->hBlockPeriods);
+  uint8_t i;
+
+  for (i = 0U; i < MC_ABTEST_NB_ARMS; i++)
+  {
+    const MC_ABTest_Arm_t *pArm = &pConfig->Arm[i];
+
+    if (pArm->bController > (uint8_t)MC_ABTEST_CTRL_PCC)
+    {
+      bValid = false;
+    }
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    else if ((pArm->bWeightIndex >= PCC_NB_WEIGHTS) && (pArm->bWeightIndex != MC_ABTEST_WEIGHTS_SCHEDULED))
+#else
+    else if (pArm->bWeightIndex != MC_ABTEST_WEIGHTS_SCHEDULED)
+#endif
+    {
+      bValid = false;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+
+  if (true == bValid)
+  {
+    ABState = MC_ABTEST_IDLE;
+    ABConfig = *pConfig;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bValid);
+}
+
+/**
+ * @brief  Executes a MC_ABTEST_CMD_xxx command.
+ * @retval bool False if the command is unknown or the experiment is started before
+ *         any configuration
+ */
+bool MC_ABTest_Command(uint8_t bCmd)
+{
+  bool bDone = true;
+
+  switch (bCmd)
+  {
+    case MC_ABTEST_CMD_STOP:
+    {
+      ABState = MC_ABTEST_IDLE;
+      break;
+    }
+
+    case MC_ABTEST_CMD_START:
+    {
+      if (0U == ABConfig.hBlockPeriods)
+      {
+        bDone = false;
+      }
+      else
+      {
+        /* The high frequency task does not touch the statistics until it is started */
+        ABState = MC_ABTEST_IDLE;
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // Enable the DWT also without debugger
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;          // Enable Cycle Counter
+        (void)memset(ABStats, 0, sizeof(ABStats));
+        bABArm = 0U;
+        ABActive = false;
+        hABPeriod = 0U;
+        ABState = MC_ABTEST_RUNNING;
+      }
+      break;
+    }
+
+    default:
+    {
+      bDone = false;
+      break;
+    }
+  }
+  return (bDone);
+}
+
+const MC_ABTest_Config_t *MC_ABTest_GetConfig(void)
+{
+  return (&ABConfig);
+}
+
+MC_ABTest_State_t MC_ABTest_GetState(void)
+{
+  return (ABState);
+}
+
+/**
+ * @brief  Returns the arm that regulates the currents of the period, or MC_NULL if the
+ *         controller is the one of the engage speeds. To be called by the high
+ *         frequency task, before the regulation.
+ */
+const MC_ABTest_Arm_t *MC_ABTest_GetArm(void)
+{
+  return ((true == ABActive) ? &ABConfig.Arm[bABArm] : MC_NULL);
+}
+
+/**
+ * @brief  Marks the start of the high frequency task, for its CPU cycles
+ */
+void MC_ABTest_StartPeriod(void)
+{
+  wABStart = DWT->CYCCNT;
+}
+
+/**
+ * @brief  Accumulates the period in the statistics of its arm, then moves to the other
+ *         arm at the end of the block. It must be called by the high frequency task at
+ *         each FOC period, after the regulation.
+ * @param  Running: true if the drive is in RUN
+ * @param  PCCEngaged: true if the predictive controller regulated the period
+ * @param  pVars: currents and voltages of the period
+ * @param  pPWMC: compare values written for the period
+ */
+void MC_ABTest_Measure(bool Running, bool PCCEngaged, const FOCVars_t *pVars, const PWMC_Handle_t *pPWMC)
+{
+  if ((MC_ABTEST_RUNNING != ABState) || (false == Running))
+  {
+    ABActive = false;
+  }
+  else if (false == ABActive)
+  {
+    /* The arm regulates from the next period, the block restarts with its settling */
+    ABActive = true;
+    hABPeriod = 0U;
+    (void)MC_ABTest_CountSwitches(pPWMC);
+  }
+  else
+  {
+    uint32_t wSwitches = MC_ABTest_CountSwitches(pPWMC);
+
+    if (hABPeriod >= ABConfig.hSettlePeriods)
+    {
+      MC_ABTest_ArmStats_t *pStats = &ABStats[bABArm];
+      int32_t wErrQ = MC_ABTest_Error(pVars->Iqdref.q, pVars->Iqd.q);
+      int32_t wErrD = MC_ABTest_Error(pVars->Iqdref.d, pVars->Iqd.d);
+      /* Each square is below 2^30, their sum fits */
+      uint32_t wErrorSq = (uint32_t)(wErrQ * wErrQ) + (uint32_t)(wErrD * wErrD);
+      uint32_t wCycles = DWT->CYCCNT - wABStart;
+
+      pStats->dErrorSq += wErrorSq;
+      pStats->wMaxErrorSq = (wErrorSq > pStats->wMaxErrorSq) ? wErrorSq : pStats->wMaxErrorSq;
+      pStats->dPower += ((int64_t)pVars->Valphabeta.alpha * pVars->Ialphabeta.alpha)
+                      + ((int64_t)pVars->Valphabeta.beta * pVars->Ialphabeta.beta);
+      pStats->wSwitches += wSwitches;
+      pStats->dCycles += wCycles;
+      pStats->wMaxCycles = (wCycles > pStats->wMaxCycles) ? wCycles : pStats->wMaxCycles;
+      if ((MC_ABTEST_CTRL_PCC == (MC_ABTest_Controller_t)ABConfig.Arm[bABArm].bController) != PCCEngaged)
+      {
+        pStats->wOffPeriods++;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      pStats->wPeriods++;
+    }
+    else
+    {
+      /* Hand over from the other arm */
+    }
+
+    hABPeriod++;
+    if (hABPeriod >= ABConfig.hBlockPeriods)
+    {
+      ABStats[bABArm].wBlocks++;
+      bABArm ^= 1U;
+      hABPeriod = 0U;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+}
+
+/**
+ * @brief  Copies the statistics of the arms, consistent with each other
+ */
+void MC_ABTest_GetStats(MC_ABTest_Stats_t *pStats)
+{
+  uint32_t Primask = __get_PRIMASK();
+
+  pStats->bState = (uint8_t)ABState;
+  pStats->hReserved = 0U;
+  pStats->wPeriodRate = TF_REGULATION_RATE;
+  __disable_irq();
+  pStats->bArm = bABArm;
+  (void)memcpy(pStats->Arm, ABStats, sizeof(ABStats));
+  __set_PRIMASK(Primask);
+}
+
+#endif /* MC_ABTEST_MODE */
+
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,524 @@
+/**
+  ******************************************************************************
+  * @file    mc_adccalib.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Tuning of the ADC sampling time and trigger delay at standstill
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "main.h"
+#include "parameters_conversion.h"
+#include "mc_adccalib.h"
+
+#ifdef MC_ADCCALIB_MODE
+
+#define MC_ADCCALIB_ALIGN_HALF      ((uint16_t)1 << (MC_ADCCALIB_ALIGN_LOG - 1U))
+#define MC_ADCCALIB_ALIGN_END       ((uint16_t)1 << MC_ADCCALIB_ALIGN_LOG)
+#define MC_ADCCALIB_SETTLE          ((uint16_t)1 << MC_ADCCALIB_SETTLE_LOG)
+#define MC_ADCCALIB_TIMING_END      (MC_ADCCALIB_SETTLE + ((uint16_t)1 << MC_ADCCALIB_AVG_LOG))
+
+#ifdef MC_ADCCALIB_IN_FLASH
+/* Sector 2, 16 KB, in the 512 KB flash of the STM32F401xE, kept out of the image by
+   STM32F401RETX_FLASH.ld */
+#define MC_ADCCALIB_FLASH_SECTOR    FLASH_SECTOR_2
+#define MC_ADCCALIB_FLASH_ADDR      0x08008000U
+#define MC_ADCCALIB_FLASH_SIZE      0x4000U
+
+#define MC_ADCCALIB_MAGIC           0x41444354U   /* "ADCT" */
+#define MC_ADCCALIB_ERASED          0xFFFFFFFFU
+
+/* One record per timing stored, appended to the sector as the offsets of
+   mc_offset_store. The size is a multiple of the 32-bit programming unit. */
+typedef struct
+{
+  uint32_t wMagic;
+  PWMC_SampTiming_t Timing;
+  uint16_t hPWMperiod;              /* The delays are timer counts of this period */
+  uint32_t wCrc;                    /* CRC-32 of the fields above */
+} MC_ADCCalibRecord_t;
+
+_Static_assert((sizeof(MC_ADCCalibRecord_t) % sizeof(uint32_t)) == 0U,
+               "MC_ADCCalibRecord_t must be a multiple of the flash programming unit");
+
+#define MC_ADCCALIB_NB_SLOTS        (MC_ADCCALIB_FLASH_SIZE / sizeof(MC_ADCCalibRecord_t))
+#endif
+
+/* Twice the ADC clock cycles of each sampling time, for TW_BEFORE */
+static const uint16_t SmpCyclesX2[MC_ADCCALIB_NB_SMP] = ADC_SMP_CYCLES_X2;
+
+static volatile MC_ADCCalib_Phase_t Phase = MC_ADCCAL_IDLE;
+static PWMC_Handle_t *pPWM;
+static PWMC_SampTiming_t Nominal;  /* Timing in use at the start */
+static uint8_t bStored;
+static qd_t Iqdref;
+static qd_t Vhold;                  /* Voltage of the sweep, that of the alignment */
+static uint8_t bTiming;             /* Timing measured, sampling times then delays */
+static uint16_t hCounter;           /* FOC periods since the start of the timing */
+static int32_t wSumA;
+static int32_t wSumB;
+static uint64_t SqSumA;
+static uint64_t SqSumB;
+static uint32_t wNoise[MC_ADCCALIB_NB_TIMINGS];
+
+#ifdef MC_ADCCALIB_IN_FLASH
+static uint32_t MC_ADCCalib_Crc(const MC_ADCCalibRecord_t *pRecord)
+{
+  const uint8_t *pData = (const uint8_t *)pRecord;
+  uint32_t wCrc = 0xFFFFFFFFU;
+  uint32_t i;
+  uint8_t bBit;
+
+  for (i = 0U; i < offsetof(MC_ADCCalibRecord_t, wCrc); i++)
+  {
+    wCrc ^= pData[i];
+    for (bBit = 0U; bBit < 8U; bBit++)
+    {
+      wCrc = ((wCrc & 1U) != 0U) ? ((wCrc >> 1) ^ 0xEDB88320U) : (wCrc >> 1);
+    }
+  }
+  return (~wCrc);
+}
+
+/* Returns the last valid record of the sector, or NULL, and the first free slot */
+static const MC_ADCCalibRecord_t *MC_ADCCalib_Scan(uint32_t *pFreeSlot)
+{
+  const MC_ADCCalibRecord_t *pRecords = (const MC_ADCCalibRecord_t *)MC_ADCCALIB_FLASH_ADDR;
+  const MC_ADCCalibRecord_t *pLast = NULL;
+  uint32_t i = 0U;
+
+  while ((i < MC_ADCCALIB_NB_SLOTS) && (pRecords[i].wMagic != MC_ADCCALIB_ERASED))
+  {
+    /* A record interrupted by a reset fails its CRC and is skipped */
+    if ((MC_ADCCALIB_MAGIC == pRecords[i].wMagic) && (MC_ADCCalib_Crc(&pRecords[i]) == pRecords[i].wCrc))
+    {
+      pLast = &pRecords[i];
+    }
+    i++;
+  }
+  *pFreeSlot = i;
+  return (pLast);
+}
+
+/* Appends the timing to the sector, erased once full. The flash is not readable while
+   it is written, and the erase takes around half a second: the drive is idle */
+static void MC_ADCCalib_Store(const PWMC_SampTiming_t *pTiming)
+{
+  MC_ADCCalibRecord_t Record;
+  uint32_t wFreeSlot;
+  uint32_t wAddress;
+  uint32_t Words[sizeof(MC_ADCCalibRecord_t) / sizeof(uint32_t)];
+  uint32_t i;
+
+  (void)memset(&Record, 0, sizeof(Record));
+  Record.wMagic = MC_ADCCALIB_MAGIC;
+  Record.Timing = *pTiming;
+  Record.hPWMperiod = pPWM->PWMperiod;
+  Record.wCrc = MC_ADCCalib_Crc(&Record);
+  (void)memcpy(Words, &Record, sizeof(Record));
+  (void)MC_ADCCalib_Scan(&wFreeSlot);
+
+  HAL_FLASH_Unlock();
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR
+                         | FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+  if (wFreeSlot >= MC_ADCCALIB_NB_SLOTS)
+  {
+    FLASH_EraseInitTypeDef Erase;
+    uint32_t wSectorError;
+
+    Erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    Erase.Sector = MC_ADCCALIB_FLASH_SECTOR;
+    Erase.NbSectors = 1U;
+    Erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    (void)HAL_FLASHEx_Erase(&Erase, &wSectorError);
+    wFreeSlot = 0U;
+  }
+  wAddress = MC_ADCCALIB_FLASH_ADDR + (wFreeSlot * sizeof(MC_ADCCalibRecord_t));
+  for (i = 0U; i < (sizeof(MC_ADCCalibRecord_t) / sizeof(uint32_t)); i++)
+  {
+    (void)HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, wAddress + (i * sizeof(uint32_t)), Words[i]);
+  }
+  HAL_FLASH_Lock();
+}
+#endif
+
+/* Builds the timing of a sweep from the nominal one. Returns false if the sampling
+   and its conversion do not fit between the edge of a centred duty and the middle
+   of the period */
+static bool MC_ADCCalib_Timing(uint8_t bIndex, PWMC_SampTiming_t *pTiming)
+{
+  *pTiming = Nominal;
+  if (bIndex < MC_ADCCALIB_NB_SMP)
+  {
+    pTiming->bSampleTime = bIndex;
+    pTiming->hTbefore = TW_BEFORE_SMP((uint32_t)SmpCyclesX2[bIndex]);
+  }
+  else
+  {
+    pTiming->hTafter = (uint16_t)(((uint32_t)Nominal.hTafter * ((uint32_t)bIndex - MC_ADCCALIB_NB_SMP + 1U)) / 4U);
+  }
+  return (((uint32_t)pTiming->hTafter + pTiming->hTbefore) < ((uint32_t)pPWM->PWMperiod / 4U));
+}
+
+/* Applies the first timing from bTiming on that fits, the ones skipped being marked.
+   Returns false once the sweep is over, the nominal timing being then applied */
+static bool MC_ADCCalib_Apply(void)
+{
+  PWMC_SampTiming_t Timing;
+  bool bApplied = false;
+
+  while ((false == bApplied) && (bTiming < MC_ADCCALIB_NB_TIMINGS))
+  {
+    if ((true == MC_ADCCalib_Timing(bTiming, &Timing)) && (true == PWMC_SetSamplingTiming(pPWM, &Timing)))
+    {
+      bApplied = true;
+    }
+    else
+    {
+      wNoise[bTiming] = UINT32_MAX;
+      bTiming++;
+    }
+  }
+  if (false == bApplied)
+  {
+    (void)PWMC_SetSamplingTiming(pPWM, &Nominal);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  hCounter = 0U;
+  wSumA = 0;
+  wSumB = 0;
+  SqSumA = 0U;
+  SqSumB = 0U;
+  return (bApplied);
+}
+
+/* Variance of a phase current over the averaged periods, in digits^2 */
+static uint32_t MC_ADCCalib_Variance(int32_t wSum, uint64_t SqSum)
+{
+  int64_t lSum = (int64_t)wSum;
+  uint64_t Square = (uint64_t)(lSum * lSum) >> MC_ADCCALIB_AVG_LOG;
+  uint64_t Variance = (SqSum > Square) ? ((SqSum - Square) >> MC_ADCCALIB_AVG_LOG) : 0U;
+
+  return ((Variance < (uint64_t)(UINT32_MAX / 4U)) ? (uint32_t)Variance : (UINT32_MAX / 4U));
+}
+
+/* Index of the shortest timing of a sweep within the margin of its lowest noise, or
+   bCount if none is measured */
+static uint8_t MC_ADCCalib_Select(const uint32_t *pNoise, uint8_t bCount)
+{
+  uint32_t wMin = UINT32_MAX;
+  uint8_t bSelected = bCount;
+  uint8_t i;
+
+  for (i = 0U; i < bCount; i++)
+  {
+    wMin = (pNoise[i] < wMin) ? pNoise[i] : wMin;
+  }
+  for (i = 0U; (i < bCount) && (bSelected == bCount); i++)
+  {
+    if ((wMin != UINT32_MAX) && (pNoise[i] <= (wMin + (wMin >> MC_ADCCALIB_TOL_SHIFT))))
+    {
+      bSelected = i;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  return (bSelected);
+}
+
+/**
+ * @brief  Applies the timing stored in flash, if any and measured at the same PWM
+ *         frequency. It must be called by MCboot once the PWM driver is initialised.
+ * @param  pPWMC: PWM of the motor
+ */
+void MC_ADCCalib_Init(PWMC_Handle_t *pPWMC)
+{
+  pPWM = pPWMC;
+  bStored = 0U;
+#ifdef MC_ADCCALIB_IN_FLASH
+  {
+    const MC_ADCCalibRecord_t *pRecord;
+    uint32_t wFreeSlot;
+
+    pRecord = MC_ADCCalib_Scan(&wFreeSlot);
+    if ((pRecord != NULL) && (pRecord->hPWMperiod == pPWMC->PWMperiod)
+        && (true == PWMC_SetSamplingTiming(pPWMC, &pRecord->Timing)))
+    {
+      bStored = 1U;
+    }
+    else
+    {
+      /* The timing of the configuration is kept */
+    }
+  }
+#endif
+}
+
+/**
+ * @brief  Starts the calibration, run by the high frequency task up to
+ *         MC_ADCCAL_MEASURED. To be called by the medium frequency task before the PWM
+ *         is switched on, with the PI controllers cleared.
+ * @param  pPWMC: PWM of the motor, that is given the timing
+ * @param  hCurrent: d current of the second sweep, in digits
+ */
+void MC_ADCCalib_Start(PWMC_Handle_t *pPWMC, int16_t hCurrent)
+{
+  pPWM = pPWMC;
+  Nominal = *PWMC_GetSamplingTiming(pPWMC);
+  Iqdref.q = 0;
+  Iqdref.d = (hCurrent > 0) ? hCurrent : 0;
+  Vhold.q = 0;
+  Vhold.d = 0;
+  bTiming = 0U;
+  (void)memset(wNoise, 0, sizeof(wNoise));
+
+  /* A driver without the setter refuses the nominal timing */
+  if ((hCurrent > 0) && (true == PWMC_SetSamplingTiming(pPWMC, &Nominal)))
+  {
+    PWMC_SetEdgeSampling(pPWMC, true);
+    Phase = (true == MC_ADCCalib_Apply()) ? MC_ADCCAL_LOWSIDE : MC_ADCCAL_FAILED;
+  }
+  else
+  {
+    Phase = MC_ADCCAL_FAILED;
+  }
+}
+
+/**
+ * @brief  Ends the calibration, whatever its phase. The timing in use before the
+ *         calibration is restored, unless the new one is selected. To be called once
+ *         the PWM is switched off.
+ */
+void MC_ADCCalib_Stop(void)
+{
+  if ((Phase != MC_ADCCAL_IDLE) && (Phase != MC_ADCCAL_DONE))
+  {
+    (void)PWMC_SetSamplingTiming(pPWM, &Nominal);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  if (pPWM != NULL)
+  {
+    PWMC_SetEdgeSampling(pPWM, false);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  Phase = MC_ADCCAL_IDLE;
+}
+
+/**
+ * @brief  Phase of the last calibration
+ */
+MC_ADCCalib_Phase_t MC_ADCCalib_GetPhase(void)
+{
+  return (Phase);
+}
+
+/**
+ * @brief  True while the PI controllers regulate the d current at angle 0, the output
+ *         voltage being MC_ADCCalib_GetVoltage() otherwise
+ */
+bool MC_ADCCalib_IsRegulating(void)
+{
+  return (MC_ADCCAL_ALIGN == Phase);
+}
+
+/**
+ * @brief  Current references of the alignment
+ */
+qd_t MC_ADCCalib_GetCurrentRef(void)
+{
+  qd_t Iqd = {0, 0};
+
+  if (MC_ADCCAL_ALIGN == Phase)
+  {
+    Iqd.d = (hCounter < MC_ADCCALIB_ALIGN_HALF)
+          ? (int16_t)(((int32_t)Iqdref.d * (int32_t)hCounter) >> (MC_ADCCALIB_ALIGN_LOG - 1U)) : Iqdref.d;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (Iqd);
+}
+
+/**
+ * @brief  Voltage applied out of the alignment: zero, or the one of the alignment
+ *         in MC_ADCCAL_VECTOR
+ */
+qd_t MC_ADCCalib_GetVoltage(void)
+{
+  qd_t Vqd = {0, 0};
+
+  return ((MC_ADCCAL_VECTOR == Phase) ? Vhold : Vqd);
+}
+
+/**
+ * @brief  Runs one control period of the standstill phases. To be called by the high
+ *         frequency task once the currents are read and before the regular conversion
+ *         is started, as the timing of the next one may be changed.
+ * @param  Iab: measured phase currents
+ * @param  Vqd: voltage applied in the last period
+ */
+void MC_ADCCalib_Exec(ab_t Iab, qd_t Vqd)
+{
+  hCounter++;
+  switch (Phase)
+  {
+    case MC_ADCCAL_LOWSIDE:
+    case MC_ADCCAL_VECTOR:
+    {
+      if (hCounter > MC_ADCCALIB_SETTLE)
+      {
+        wSumA += Iab.a;
+        wSumB += Iab.b;
+        SqSumA += (uint64_t)((int32_t)Iab.a * Iab.a);
+        SqSumB += (uint64_t)((int32_t)Iab.b * Iab.b);
+      }
+      else
+      {
+        /* The sampling settles with its new timing */
+      }
+
+      if (hCounter >= MC_ADCCALIB_TIMING_END)
+      {
+        /* The variances of both sweeps are added */
+        wNoise[bTiming] += MC_ADCCalib_Variance(wSumA, SqSumA) + MC_ADCCalib_Variance(wSumB, SqSumB);
+        bTiming++;
+        if (false == MC_ADCCalib_Apply())
+        {
+          if (MC_ADCCAL_LOWSIDE == Phase)
+          {
+            Phase = MC_ADCCAL_ALIGN;
+          }
+          else
+          {
+            Phase = MC_ADCCAL_MEASURED;
+          }
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      break;
+    }
+
+    case MC_ADCCAL_ALIGN:
+    {
+      /* Aligned at the nominal timing, the voltage that holds the current is then
+         applied without regulation */
+      if (hCounter >= MC_ADCCALIB_ALIGN_END)
+      {
+        Vhold = Vqd;
+        bTiming = 0U;
+        Phase = (true == MC_ADCCalib_Apply()) ? MC_ADCCAL_VECTOR : MC_ADCCAL_MEASURED;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      break;
+    }
+
+    default:
+      /* The voltage is held at zero */
+      break;
+  }
+}
+
+/**
+ * @brief  Selects the timing from the measurement and applies it. To be called by the
+ *         medium frequency task in MC_ADCCAL_MEASURED, with the PWM switched off.
+ * @retval bool True if a timing is measured in both sweeps and MC_ADCCAL_DONE is
+ *         entered, false if MC_ADCCAL_FAILED is
+ */
+bool MC_ADCCalib_Compute(void)
+{
+  uint8_t bSmp = MC_ADCCalib_Select(&wNoise[0], (uint8_t)MC_ADCCALIB_NB_SMP);
+  uint8_t bDelay = MC_ADCCalib_Select(&wNoise[MC_ADCCALIB_NB_SMP], (uint8_t)MC_ADCCALIB_NB_DELAYS);
+  PWMC_SampTiming_t Timing;
+  PWMC_SampTiming_t DelayTiming;
+  bool bValid = (MC_ADCCAL_MEASURED == Phase) && (bSmp < MC_ADCCALIB_NB_SMP) && (bDelay < MC_ADCCALIB_NB_DELAYS);
+
+  PWMC_SetEdgeSampling(pPWM, false);
+  if (true == bValid)
+  {
+    (void)MC_ADCCalib_Timing(bSmp, &Timing);
+    (void)MC_ADCCalib_Timing(bDelay + (uint8_t)MC_ADCCALIB_NB_SMP, &DelayTiming);
+    Timing.hTafter = DelayTiming.hTafter;
+    bValid = PWMC_SetSamplingTiming(pPWM, &Timing);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  if (true == bValid)
+  {
+#ifdef MC_ADCCALIB_IN_FLASH
+    if (0 != memcmp(&Timing, &Nominal, sizeof(Timing)))
+    {
+      MC_ADCCalib_Store(&Timing);
+      bStored = 1U;
+    }
+    else
+    {
+      /* The timing in use is kept, from the flash or the configuration */
+    }
+#endif
+    Phase = MC_ADCCAL_DONE;
+  }
+  else
+  {
+    (void)PWMC_SetSamplingTiming(pPWM, &Nominal);
+    Phase = MC_ADCCAL_FAILED;
+  }
+  return (bValid);
+}
+
+/**
+ * @brief  Fills the layout of MC_REG_ADCCALIB
+ */
+void MC_ADCCalib_GetReport(MC_ADCCalib_Report_t *pReport)
+{
+  const PWMC_SampTiming_t *pTiming = PWMC_GetSamplingTiming(pPWM);
+
+  pReport->bPhase = (uint8_t)Phase;
+  pReport->bStored = bStored;
+  pReport->bSampleTime = pTiming->bSampleTime;
+  pReport->bReserved = 0U;
+  pReport->hTafter = pTiming->hTafter;
+  pReport->hTbefore = pTiming->hTbefore;
+  (void)memcpy(pReport->wSmpNoise, &wNoise[0], sizeof(pReport->wSmpNoise));
+  (void)memcpy(pReport->wDelayNoise, &wNoise[MC_ADCCALIB_NB_SMP], sizeof(pReport->wDelayNoise));
+}
+
+#endif /* MC_ADCCALIB_MODE */
+
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
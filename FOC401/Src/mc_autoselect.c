@@ -0,0 +1,235 @@
+/**
+  ******************************************************************************
+  * @file    mc_autoselect.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Boot time selection of the current controller that fits the
+  *          regulation period
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "mc_math.h"
+#include "mc_config.h"
+#include "parameters_conversion.h"
+#include "mc_autoselect.h"
+
+#ifdef MC_AUTOSELECT_MODE
+
+#if (CURRENT_CONTROLLER != CURR_CTRL_PCC)
+#error "MC_AUTOSELECT_MODE needs the CURR_CTRL_PCC backend"
+#endif
+
+/* CPU cycles of the regulation period. ADV_TIM_CLK_MHz is not parenthesised on
+   every board */
+#define MC_AUTOSEL_PERIOD_CYCLES  ((((uint32_t)PWM_PERIOD_CYCLES * (SYSCLK_FREQ / 1000000uL)) \
+                                    / (uint32_t)(ADV_TIM_CLK_MHz)) * (uint32_t)REGULATION_EXECUTION_RATE)
+#define MC_AUTOSEL_BUDGET_CYCLES  ((MC_AUTOSEL_PERIOD_CYCLES * MC_AUTOSEL_BUDGET_PC) / 100U)
+
+/* A search of a PCC_HORIZON above 1 completes its first step with a node per vector */
+#define MC_AUTOSEL_MIN_NODES      ((uint16_t)PCC_NB_VECTORS)
+
+#define MC_AUTOSEL_OVERHEAD_RUNS  16U
+
+_Static_assert((MC_AUTOSEL_BUDGET_PC > 0U) && (MC_AUTOSEL_BUDGET_PC <= 100U),
+               "MC_AUTOSEL_BUDGET_PC must be a percentage of the regulation period");
+
+MC_AutoSel_Report_t MC_AutoSelReport;
+
+/* Working copies, so that the timing does not alter the state of the drive */
+static PID_Handle_t AutoSelPIDq;
+static PID_Handle_t AutoSelPIDd;
+static PCC_Handle_t AutoSelPCC;
+
+/* Cost of the measurement itself, removed from every result */
+static uint32_t AutoSelOverhead;
+
+/* Kept so that the empty measure is not optimised out */
+static volatile int32_t AutoSelSink;
+
+typedef struct
+{
+  qd_t     Iqdref;                /* s16A digits */
+  int16_t  hSpeedDpp;
+} MC_AutoSel_Point_t;
+
+/* Light and heavy loads, motoring and braking, up to a high speed */
+static const MC_AutoSel_Point_t AutoSelPoints[MC_AUTOSEL_NB_POINTS] =
+{
+  {{2000, 0}, 20},
+  {{8000, -4000}, 80},
+  {{-6000, -2000}, -90},
+  {{12000, -8000}, 150}
+};
+
+/**
+ * @brief  Returns the longest call of a candidate, in CPU cycles. The predictive
+ *         controller runs in closed loop on its own model, the current of each period
+ *         being the one it predicted; the PI controllers see the step of the reference
+ *         at each period.
+ * @param  PCCCandidate: true for the predictive controller, false for the PI ones
+ * @param  hNodeBudget: node budget of the predictive controller
+ */
+static uint32_t MC_AutoSel_Time(bool PCCCandidate, uint16_t hNodeBudget)
+{
+  uint32_t wMaxCycles = 0U;
+  uint8_t i;
+
+  for (i = 0U; i < MC_AUTOSEL_NB_POINTS; i++)
+  {
+    const MC_AutoSel_Point_t *pPoint = &AutoSelPoints[i];
+    qd_t Iqd = {0, 0};
+    qd_t Vqd = {0, 0};
+    int16_t hAngle = 0;
+    uint16_t hPeriod;
+
+    AutoSelPIDq = PIDIqHandle_M1;
+    AutoSelPIDd = PIDIdHandle_M1;
+    PID_SetIntegralTerm(&AutoSelPIDq, 0);
+    PID_SetIntegralTerm(&AutoSelPIDd, 0);
+    AutoSelPCC = PCC_M1;
+    AutoSelPCC.hNodeBudget = hNodeBudget;
+    PCC_Clear(&AutoSelPCC);
+
+    for (hPeriod = 0U; hPeriod < MC_AUTOSEL_PERIODS; hPeriod++)
+    {
+      Trig_Components Trig = MCM_Trig_Functions(hAngle);
+      uint32_t StartMeasure;
+      uint32_t DeltaTimeInCycle;
+      qd_t VqdNext;
+
+      /* As in FOC_CurrControllerM1 */
+      __disable_irq();
+      StartMeasure = DWT->CYCCNT;
+      if (true == PCCCandidate)
+      {
+        VqdNext = PCC_CalcVoltage(&AutoSelPCC, Iqd, pPoint->Iqdref, Vqd, Trig, pPoint->hSpeedDpp);
+#if (PCC_OUTPUT_MODE != PCC_FINITE_SET) && !defined (PCC_FULL_HEXAGON)
+        VqdNext = Circle_Limitation(&CircleLimitationM1, VqdNext);
+#endif
+      }
+      else
+      {
+        VqdNext.q = PI_Controller(&AutoSelPIDq, (int32_t)pPoint->Iqdref.q - Iqd.q);
+        VqdNext.d = PI_Controller(&AutoSelPIDd, (int32_t)pPoint->Iqdref.d - Iqd.d);
+        VqdNext = Circle_Limitation(&CircleLimitationM1, VqdNext);
+      }
+      DeltaTimeInCycle = DWT->CYCCNT - StartMeasure;
+      __enable_irq();
+
+      DeltaTimeInCycle = (DeltaTimeInCycle > AutoSelOverhead) ? (DeltaTimeInCycle - AutoSelOverhead) : 0U;
+      wMaxCycles = (DeltaTimeInCycle > wMaxCycles) ? DeltaTimeInCycle : wMaxCycles;
+      Vqd = VqdNext;
+      if (true == PCCCandidate)
+      {
+        Iqd = AutoSelPCC.IqdNext;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      hAngle = (int16_t)(hAngle + pPoint->hSpeedDpp);
+    }
+  }
+  return (wMaxCycles);
+}
+
+/**
+ * @brief  Times the candidates, from the richest one, and applies the first one that
+ *         fits MC_AUTOSEL_BUDGET_PC percent of the regulation period to PCC_M1, with
+ *         its tuning set. The drive is idle at boot: the set is applied at once.
+ */
+void MC_AutoSel_Run(void)
+{
+  MC_AutoSel_Report_t *pReport = &MC_AutoSelReport;
+  uint16_t hNodeBudget = PCC_M1.hNodeBudget;
+  PCC_Tuning_t Tuning;
+  uint8_t bLevel;
+  uint8_t bRun;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // Enable the DWT also without debugger
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;          // Enable Cycle Counter
+
+  /* The overhead is the shortest empty measure */
+  AutoSelOverhead = UINT32_MAX;
+  for (bRun = 0U; bRun < MC_AUTOSEL_OVERHEAD_RUNS; bRun++)
+  {
+    uint32_t StartMeasure;
+    uint32_t DeltaTimeInCycle;
+
+    __disable_irq();
+    StartMeasure = DWT->CYCCNT;
+    AutoSelSink = 0;
+    DeltaTimeInCycle = DWT->CYCCNT - StartMeasure;
+    __enable_irq();
+    AutoSelOverhead = (DeltaTimeInCycle < AutoSelOverhead) ? DeltaTimeInCycle : AutoSelOverhead;
+  }
+
+  pReport->bController = (uint8_t)MC_AUTOSEL_CTRL_PI;
+  pReport->bLevel = (uint8_t)MC_AUTOSEL_NB_LEVELS;
+  pReport->bBudgetPc = (uint8_t)MC_AUTOSEL_BUDGET_PC;
+  pReport->hNodeBudget = 0U;
+  pReport->hReserved = 0U;
+  pReport->wBudgetCycles = MC_AUTOSEL_BUDGET_CYCLES;
+  pReport->wPICycles = MC_AutoSel_Time(false, hNodeBudget);
+
+  for (bLevel = 0U; bLevel < MC_AUTOSEL_NB_LEVELS; bLevel++)
+  {
+    uint16_t hLevelBudget = hNodeBudget >> bLevel;
+
+    pReport->wPCCCycles[bLevel] = 0U;
+#if (PCC_HORIZON == 1U)
+    /* The budget does not bound a search of one step */
+    if ((bLevel > 0U) || ((uint8_t)MC_AUTOSEL_CTRL_PCC == pReport->bController))
+#else
+    if ((hLevelBudget < MC_AUTOSEL_MIN_NODES) || ((uint8_t)MC_AUTOSEL_CTRL_PCC == pReport->bController))
+#endif
+    {
+      /* Nothing to do */
+    }
+    else
+    {
+      pReport->wPCCCycles[bLevel] = MC_AutoSel_Time(true, hLevelBudget);
+      if (pReport->wPCCCycles[bLevel] <= pReport->wBudgetCycles)
+      {
+        pReport->bController = (uint8_t)MC_AUTOSEL_CTRL_PCC;
+        pReport->bLevel = bLevel;
+        pReport->hNodeBudget = hLevelBudget;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+  }
+
+  PCC_GetTuning(&PCC_M1, &Tuning);
+  if ((uint8_t)MC_AUTOSEL_CTRL_PCC == pReport->bController)
+  {
+    pReport->bFits = 1U;
+    Tuning.hNodeBudget = pReport->hNodeBudget;
+  }
+  else
+  {
+    pReport->bFits = (pReport->wPICycles <= pReport->wBudgetCycles) ? 1U : 0U;
+    /* The predictive controller is never engaged */
+    Tuning.hEngageSpeed = INT16_MAX;
+    Tuning.hDisengageSpeed = INT16_MAX;
+  }
+  (void)PCC_SetTuning(&PCC_M1, &Tuning);
+  PCC_ApplyTuning(&PCC_M1);
+}
+
+#endif /* MC_AUTOSELECT_MODE */
+
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,189 @@
+/**
+  ******************************************************************************
+  * @file    mc_bootlog.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Capture configuration stored in flash and armed at boot
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "main.h"
+#include "mc_bootlog.h"
+
+#ifdef MC_BOOTLOG_MODE
+
+#ifndef MC_CAPTURE_MODE
+#error "MC_BOOTLOG_MODE needs MC_CAPTURE_MODE"
+#endif
+
+/* Sector 3, 16 KB, in the 512 KB flash of the STM32F401xE, kept out of the image by
+   STM32F401RETX_FLASH.ld */
+#define MC_BOOTLOG_FLASH_SECTOR     FLASH_SECTOR_3
+#define MC_BOOTLOG_FLASH_ADDR       0x0800C000U
+#define MC_BOOTLOG_FLASH_SIZE       0x4000U
+
+#define MC_BOOTLOG_MAGIC            0x424C4F47U   /* "BLOG" */
+#define MC_BOOTLOG_ERASED           0xFFFFFFFFU
+
+/* One record per configuration stored, appended to the sector as the offsets of
+   mc_offset_store. The size is a multiple of the 32-bit programming unit. */
+typedef struct
+{
+  uint32_t wMagic;
+  MC_BootLog_Config_t Config;
+  uint32_t wCrc;                    /* CRC-32 of the fields above */
+} MC_BootLogRecord_t;
+
+_Static_assert((sizeof(MC_BootLogRecord_t) % sizeof(uint32_t)) == 0U,
+               "MC_BootLogRecord_t must be a multiple of the flash programming unit");
+
+#define MC_BOOTLOG_NB_SLOTS         (MC_BOOTLOG_FLASH_SIZE / sizeof(MC_BootLogRecord_t))
+
+/* Stored configuration, disabled if none */
+static MC_BootLog_Config_t BootLogConfig;
+
+static uint32_t MC_BootLog_Crc(const MC_BootLogRecord_t *pRecord)
+{
+  const uint8_t *pData = (const uint8_t *)pRecord;
+  uint32_t wCrc = 0xFFFFFFFFU;
+  uint32_t i;
+  uint8_t bBit;
+
+  for (i = 0U; i < offsetof(MC_BootLogRecord_t, wCrc); i++)
+  {
+    wCrc ^= pData[i];
+    for (bBit = 0U; bBit < 8U; bBit++)
+    {
+      wCrc = ((wCrc & 1U) != 0U) ? ((wCrc >> 1) ^ 0xEDB88320U) : (wCrc >> 1);
+    }
+  }
+  return (~wCrc);
+}
+
+/* Returns the last valid record of the sector, or NULL, and the first free slot */
+static const MC_BootLogRecord_t *MC_BootLog_Scan(uint32_t *pFreeSlot)
+{
+  const MC_BootLogRecord_t *pRecords = (const MC_BootLogRecord_t *)MC_BOOTLOG_FLASH_ADDR;
+  const MC_BootLogRecord_t *pLast = NULL;
+  uint32_t i = 0U;
+
+  while ((i < MC_BOOTLOG_NB_SLOTS) && (pRecords[i].wMagic != MC_BOOTLOG_ERASED))
+  {
+    /* A record interrupted by a reset fails its CRC and is skipped */
+    if ((MC_BOOTLOG_MAGIC == pRecords[i].wMagic) && (MC_BootLog_Crc(&pRecords[i]) == pRecords[i].wCrc))
+    {
+      pLast = &pRecords[i];
+    }
+    i++;
+  }
+  *pFreeSlot = i;
+  return (pLast);
+}
+
+/**
+ * @brief  Reads the stored configuration and arms the capture with it, if enabled.
+ *         It must be called by MCboot, once the handles of the registers of the
+ *         channels are initialised.
+ */
+void MC_BootLog_Init(void)
+{
+  const MC_BootLogRecord_t *pRecord;
+  uint32_t wFreeSlot;
+
+  pRecord = MC_BootLog_Scan(&wFreeSlot);
+  if (pRecord != NULL)
+  {
+    BootLogConfig = pRecord->Config;
+  }
+  else
+  {
+    (void)memset(&BootLogConfig, 0, sizeof(BootLogConfig));
+  }
+
+  if (BootLogConfig.bEnabled != 0U)
+  {
+    /* A configuration made invalid by a new firmware leaves the capture idle */
+    (void)MC_Capture_Configure(&BootLogConfig.Capture);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+const MC_BootLog_Config_t *MC_BootLog_GetConfig(void)
+{
+  return (&BootLogConfig);
+}
+
+/**
+ * @brief  Stores the configuration of the next boots in flash, unless it is equal to
+ *         the stored one. The capture in progress is left unchanged. The flash is not
+ *         readable while it is written, and the erase of the sector, once every
+ *         MC_BOOTLOG_NB_SLOTS configurations, takes around half a second: it must be
+ *         called in the IDLE state.
+ * @retval bool False if the configuration is enabled and refused by the capture
+ */
+bool MC_BootLog_Store(const MC_BootLog_Config_t *pConfig)
+{
+  MC_BootLogRecord_t Record;
+  uint32_t wFreeSlot;
+  uint32_t wAddress;
+  uint32_t Words[sizeof(MC_BootLogRecord_t) / sizeof(uint32_t)];
+  uint32_t i;
+  bool bValid = (0U == pConfig->bEnabled) || (true == MC_Capture_Check(&pConfig->Capture));
+
+  Record.wMagic = MC_BOOTLOG_MAGIC;
+  Record.Config = *pConfig;
+  Record.Config.bReserved = 0U;
+  if ((true == bValid) && (0 != memcmp(&Record.Config, &BootLogConfig, sizeof(MC_BootLog_Config_t))))
+  {
+    (void)MC_BootLog_Scan(&wFreeSlot);
+    Record.wCrc = MC_BootLog_Crc(&Record);
+    (void)memcpy(Words, &Record, sizeof(Record));
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR
+                           | FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+    if (wFreeSlot >= MC_BOOTLOG_NB_SLOTS)
+    {
+      FLASH_EraseInitTypeDef Erase;
+      uint32_t wSectorError;
+
+      Erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+      Erase.Sector = MC_BOOTLOG_FLASH_SECTOR;
+      Erase.NbSectors = 1U;
+      Erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+      (void)HAL_FLASHEx_Erase(&Erase, &wSectorError);
+      wFreeSlot = 0U;
+    }
+    wAddress = MC_BOOTLOG_FLASH_ADDR + (wFreeSlot * sizeof(MC_BootLogRecord_t));
+    for (i = 0U; i < (sizeof(MC_BootLogRecord_t) / sizeof(uint32_t)); i++)
+    {
+      (void)HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, wAddress + (i * sizeof(uint32_t)), Words[i]);
+    }
+    HAL_FLASH_Lock();
+    BootLogConfig = Record.Config;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bValid);
+}
+
+#endif /* MC_BOOTLOG_MODE */
+
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -42,7 +42,7 @@ const GlobalConfig_reg_t globalConfig_reg =
 
 static const ApplicationConfig_reg_t M1_ApplicationConfig_reg =
 {
-  .maxMechanicalSpeed = 2000,
+  .maxMechanicalSpeed = MAX_APPLICATION_SPEED_RPM,
   .maxMotorCurrent = 0xA, /* Information not available yet */
   .maxVoltageSupply = 36,
   .minVoltageSupply = 5,
@@ -51,12 +51,12 @@ static const ApplicationConfig_reg_t M1_ApplicationConfig_reg =
 
 const MotorConfig_reg_t M1_MotorConfig_reg =
 {
-  .polePairs = 4,
-  .ratedFlux = 4.0,
-  .rs = 0.65,
-  .ls = 0.000360*1.000,
-  .ld = 0.000360,
-  .maxCurrent = 10026,
+  .polePairs = POLE_PAIR_NUM,
+  .ratedFlux = MOTOR_VOLTAGE_CONSTANT,
+  .rs = RS,
+  .ls = LS*LD_LQ_RATIO,
+  .ld = LS,
+  .maxCurrent = NOMINAL_CURRENT,
   .name = "No Name M1"
 };
 
@@ -0,0 +1,308 @@
+/**
+  ******************************************************************************
+  * @file    mc_dtcalib.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Calibration of the dead time compensation at standstill
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "mc_dtcalib.h"
+
+#ifdef MC_DTCALIB_MODE
+
+#define MC_DTCALIB_ALIGN_HALF       ((uint16_t)1 << (MC_DTCALIB_ALIGN_LOG - 1U))
+#define MC_DTCALIB_ALIGN_END        ((uint16_t)1 << MC_DTCALIB_ALIGN_LOG)
+#define MC_DTCALIB_SETTLE           ((uint16_t)1 << MC_DTCALIB_SETTLE_LOG)
+#define MC_DTCALIB_LEVEL_END        (MC_DTCALIB_SETTLE + ((uint16_t)1 << MC_DTCALIB_AVG_LOG))
+/* Levels of the fit of the resistance, the upper half */
+#define MC_DTCALIB_FIT_FIRST        (MC_DTCALIB_NB_LEVELS / 2U)
+/* From a phase voltage error, in digits, to compare counts: a count moves the voltage
+   of a phase by 2 / PWMperiod of the bus, a digit by sqrt(3) / (2 * 32767) */
+#define MC_DTCALIB_COUNTS_PER_DIGIT (1.7320508f / (4.0f * 32767.0f))
+/* Largest error, in multiples of DTCompCnt, taken as a measurement */
+#define MC_DTCALIB_MAX_RATIO        4U
+
+/* Axes of phases A, B and C in the alpha/beta frame */
+static const int16_t PhaseAngles[3] = {0, 21845, -21845};
+
+static volatile MC_DTCalib_Phase_t Phase = MC_DTCAL_IDLE;
+static PWMC_Handle_t *pPWM;
+static uint16_t hSavedDTTest;     /* Compensation of the configuration, until a table is in use */
+static qd_t Iqdref;
+static uint8_t bShift;            /* Current step, 2^bShift digits */
+static uint8_t bPhaseIndex;       /* Phase measured */
+static uint8_t bLevel;            /* Level measured, from MC_DTCALIB_NB_LEVELS down to 1 */
+static uint16_t hCounter;         /* FOC periods since the start of the alignment or level */
+static int32_t wIdAcc;
+static int32_t wVdAcc;
+static int32_t wIdSums[3][MC_DTCALIB_NB_LEVELS];
+static int32_t wVdSums[3][MC_DTCALIB_NB_LEVELS];
+static uint16_t Lut[3][PWMC_DTCOMP_LUT_POINTS];
+static int16_t hPhaseDrop;
+
+/**
+ * @brief  Starts the calibration, run by the high frequency task up to
+ *         MC_DTCAL_MEASURED. The dead time compensation is disabled during the
+ *         measurement. To be called by the medium frequency task before the PWM is
+ *         switched on, with the PI controllers cleared.
+ * @param  pPWMC: PWM of the motor, that is given the table
+ * @param  hCurrent: highest d current, in digits, at least MC_DTCALIB_NB_LEVELS
+ */
+void MC_DTCalib_Start(PWMC_Handle_t *pPWMC, int16_t hCurrent)
+{
+  pPWM = pPWMC;
+  hSavedDTTest = pPWMC->DTTest;
+  pPWMC->DTTest = 0U;
+  bShift = 0U;
+  while (((int32_t)MC_DTCALIB_NB_LEVELS << (bShift + 1U)) <= (int32_t)hCurrent)
+  {
+    bShift++;
+  }
+
+  Iqdref.q = 0;
+  Iqdref.d = 0;
+  bPhaseIndex = 0U;
+  hCounter = 0U;
+  Phase = ((int32_t)hCurrent >= (int32_t)MC_DTCALIB_NB_LEVELS) ? MC_DTCAL_ALIGN : MC_DTCAL_FAILED;
+}
+
+/**
+ * @brief  Ends the calibration, whatever its phase. The compensation in use before the
+ *         calibration is restored, unless the table is computed.
+ */
+void MC_DTCalib_Stop(void)
+{
+  if ((Phase != MC_DTCAL_IDLE) && (Phase != MC_DTCAL_DONE))
+  {
+    pPWM->DTTest = hSavedDTTest;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  Phase = MC_DTCAL_IDLE;
+}
+
+/**
+ * @brief  Phase of the last calibration
+ */
+MC_DTCalib_Phase_t MC_DTCalib_GetPhase(void)
+{
+  return (Phase);
+}
+
+/**
+ * @brief  Angle of the PI controllers: the axis of the phase measured
+ */
+int16_t MC_DTCalib_GetElAngle(void)
+{
+  return (PhaseAngles[(bPhaseIndex < 3U) ? bPhaseIndex : 0U]);
+}
+
+/**
+ * @brief  Current references of the standstill phases
+ */
+qd_t MC_DTCalib_GetCurrentRef(void)
+{
+  return (Iqdref);
+}
+
+/**
+ * @brief  Runs one control period of the standstill phases. To be called by the high
+ *         frequency task after the PI controllers, at MC_DTCalib_GetElAngle().
+ * @param  Iqd: measured currents in the q/d frame
+ * @param  Vqd: output of the PI controllers
+ */
+void MC_DTCalib_Exec(qd_t Iqd, qd_t Vqd)
+{
+  int16_t hTop = (int16_t)((int32_t)MC_DTCALIB_NB_LEVELS << bShift);
+
+  hCounter++;
+  switch (Phase)
+  {
+    case MC_DTCAL_ALIGN:
+    {
+      /* From zero current, the rotor turns to the axis of the phase without a jerk */
+      if (hCounter < MC_DTCALIB_ALIGN_HALF)
+      {
+        Iqdref.d = (int16_t)(((int32_t)hTop * (int32_t)hCounter) >> (MC_DTCALIB_ALIGN_LOG - 1U));
+      }
+      else if (hCounter < MC_DTCALIB_ALIGN_END)
+      {
+        Iqdref.d = hTop;
+      }
+      else
+      {
+        bLevel = (uint8_t)MC_DTCALIB_NB_LEVELS;
+        wIdAcc = 0;
+        wVdAcc = 0;
+        hCounter = 0U;
+        Phase = MC_DTCAL_LEVELS;
+      }
+      break;
+    }
+
+    case MC_DTCAL_LEVELS:
+    {
+      if (hCounter > MC_DTCALIB_SETTLE)
+      {
+        wIdAcc += Iqd.d;
+        wVdAcc += Vqd.d;
+      }
+      else
+      {
+        /* The current settles at its new level */
+      }
+
+      if (hCounter >= MC_DTCALIB_LEVEL_END)
+      {
+        wIdSums[bPhaseIndex][bLevel - 1U] = wIdAcc;
+        wVdSums[bPhaseIndex][bLevel - 1U] = wVdAcc;
+        wIdAcc = 0;
+        wVdAcc = 0;
+        hCounter = 0U;
+        bLevel--;
+        if (bLevel > 0U)
+        {
+          Iqdref.d = (int16_t)((int32_t)bLevel << bShift);
+        }
+        else
+        {
+          /* Next phase, or the end of the measurement */
+          Iqdref.d = 0;
+          bPhaseIndex++;
+          Phase = (bPhaseIndex < 3U) ? MC_DTCAL_ALIGN : MC_DTCAL_MEASURED;
+        }
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      break;
+    }
+
+    default:
+      /* The current is held at zero */
+      break;
+  }
+}
+
+/**
+ * @brief  Computes the table from the measurement and gives it to the PWM. To be
+ *         called by the medium frequency task in MC_DTCAL_MEASURED, with the PWM
+ *         switched off.
+ * @retval bool True if the errors are plausible and MC_DTCAL_DONE is entered, false
+ *         if MC_DTCAL_FAILED is
+ */
+bool MC_DTCalib_Compute(void)
+{
+  float_t fScale = 1.0f / (float_t)((int32_t)1 << MC_DTCALIB_AVG_LOG);
+  float_t fCounts = (float_t)pPWM->PWMperiod * MC_DTCALIB_COUNTS_PER_DIGIT;
+  float_t fMaxCounts = (float_t)((uint32_t)MC_DTCALIB_MAX_RATIO * pPWM->DTCompCnt);
+  float_t fDropSum = 0.0f;
+  bool bValid = (MC_DTCAL_MEASURED == Phase);
+  uint8_t p;
+  uint8_t k;
+
+  for (p = 0U; p < 3U; p++)
+  {
+    float_t fI[MC_DTCALIB_NB_LEVELS];
+    float_t fV[MC_DTCALIB_NB_LEVELS];
+    float_t fErr[PWMC_DTCOMP_LUT_POINTS];
+    float_t fMeanI = 0.0f;
+    float_t fMeanV = 0.0f;
+    float_t fSxy = 0.0f;
+    float_t fSxx = 0.0f;
+    float_t fRs;
+    float_t fHalf;
+    float_t fPoint;
+
+    for (k = 0U; k < MC_DTCALIB_NB_LEVELS; k++)
+    {
+      fI[k] = (float_t)wIdSums[p][k] * fScale;
+      fV[k] = (float_t)wVdSums[p][k] * fScale;
+    }
+    /* Resistance: least squares slope of the upper levels */
+    for (k = MC_DTCALIB_FIT_FIRST; k < MC_DTCALIB_NB_LEVELS; k++)
+    {
+      fMeanI += fI[k];
+      fMeanV += fV[k];
+    }
+    fMeanI /= (float_t)(MC_DTCALIB_NB_LEVELS - MC_DTCALIB_FIT_FIRST);
+    fMeanV /= (float_t)(MC_DTCALIB_NB_LEVELS - MC_DTCALIB_FIT_FIRST);
+    for (k = MC_DTCALIB_FIT_FIRST; k < MC_DTCALIB_NB_LEVELS; k++)
+    {
+      fSxy += (fI[k] - fMeanI) * (fV[k] - fMeanV);
+      fSxx += (fI[k] - fMeanI) * (fI[k] - fMeanI);
+    }
+    fRs = (fSxx > 0.0f) ? (fSxy / fSxx) : 0.0f;
+    bValid = bValid && (fRs > 0.0f);
+
+    /* The d error at level n is 2/3 of the error of the phase at n, plus the one of
+       the two others at n / 2: interpolated between the points below for odd n */
+    fErr[0] = 0.0f;
+    for (k = 1U; k < PWMC_DTCOMP_LUT_POINTS; k++)
+    {
+      float_t fDErr = fV[k - 1U] - (fRs * fI[k - 1U]);
+
+      if (1U == k)
+      {
+        /* At half a step the error is taken half of the one of the step */
+        fErr[k] = fDErr;
+      }
+      else
+      {
+        fHalf = ((k & 1U) == 0U) ? fErr[k / 2U] : (0.5f * (fErr[k / 2U] + fErr[(k / 2U) + 1U]));
+        fErr[k] = (1.5f * fDErr) - fHalf;
+      }
+    }
+    bValid = bValid && (fErr[PWMC_DTCOMP_LUT_POINTS - 1U] > 0.0f)
+             && ((fErr[PWMC_DTCOMP_LUT_POINTS - 1U] * fCounts) <= fMaxCounts);
+    fDropSum += fErr[PWMC_DTCOMP_LUT_POINTS - 1U];
+
+    for (k = 0U; k < PWMC_DTCOMP_LUT_POINTS; k++)
+    {
+      fPoint = fErr[k] * fCounts;
+      fPoint = (fPoint > 0.0f) ? ((fPoint < fMaxCounts) ? fPoint : fMaxCounts) : 0.0f;
+      Lut[p][k] = (uint16_t)(fPoint + 0.5f);
+    }
+  }
+
+  if (true == bValid)
+  {
+    hPhaseDrop = (int16_t)(fDropSum / 3.0f);
+    PWMC_SetDeadTimeLut(pPWM, &Lut[0][0], bShift);
+    Phase = MC_DTCAL_DONE;
+  }
+  else
+  {
+    pPWM->DTTest = hSavedDTTest;
+    Phase = MC_DTCAL_FAILED;
+  }
+  return (bValid);
+}
+
+/**
+ * @brief  Mean voltage error of the phases at the highest level of the last completed
+ *         calibration, in digits, conduction drops included
+ */
+int16_t MC_DTCalib_GetPhaseDrop(void)
+{
+  return (hPhaseDrop);
+}
+
+#endif /* MC_DTCALIB_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,280 @@
+/**
+  ******************************************************************************
+  * @file    mc_faultlog.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Log of the faults and of the periods before them, stored in flash
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "main.h"
+#include "mcpa.h"
+#include "mc_faultlog.h"
+#ifdef MC_TIMEBASE_MODE
+#include "mc_timebase.h"
+#endif
+
+#ifdef MC_FAULTLOG_MODE
+
+/* Sector 1, 16 KB, in the 512 KB flash of the STM32F401xE, kept out of the image by
+   STM32F401RETX_FLASH.ld */
+#define MC_FAULTLOG_FLASH_SECTOR    FLASH_SECTOR_1
+#define MC_FAULTLOG_FLASH_ADDR      0x08004000U
+#define MC_FAULTLOG_FLASH_SIZE      0x4000U
+
+#define MC_FAULTLOG_MAGIC           0x464C4F47U   /* "FLOG" */
+#define MC_FAULTLOG_ERASED          0xFFFFFFFFU
+
+/* One record per fault, appended to the sector as the offsets of mc_offset_store.
+   The size is a multiple of the 32-bit programming unit. */
+typedef struct
+{
+  uint32_t wMagic;
+  MC_FaultLog_Entry_t Entry;        /* Its last word was a spare one, erased */
+  uint32_t wCrc;                    /* CRC-32 of the fields above */
+} MC_FaultLogRecord_t;
+
+#define MC_FAULTLOG_NB_SLOTS        (MC_FAULTLOG_FLASH_SIZE / sizeof(MC_FaultLogRecord_t))
+
+static MC_FaultLog_Snapshot_t Ring[MC_FAULTLOG_DEPTH];
+static uint8_t bRingNext;           /* Slot of the next snapshot */
+static uint8_t bRingCount;          /* Snapshots written since the last rearm */
+static volatile bool Frozen;        /* The ring is frozen until the fault is acknowledged */
+static volatile bool Pending;       /* PendingEntry is not written in flash yet */
+static MC_FaultLog_Entry_t PendingEntry;
+static uint32_t wNextSequence;
+static uint32_t wSlots;             /* Records written in the sector */
+static uint16_t hReadIndex;
+
+static uint32_t MC_FaultLog_Crc(const MC_FaultLogRecord_t *pRecord)
+{
+  const uint8_t *pData = (const uint8_t *)pRecord;
+  uint32_t wCrc = 0xFFFFFFFFU;
+  uint32_t i;
+  uint8_t bBit;
+
+  for (i = 0U; i < offsetof(MC_FaultLogRecord_t, wCrc); i++)
+  {
+    wCrc ^= pData[i];
+    for (bBit = 0U; bBit < 8U; bBit++)
+    {
+      wCrc = ((wCrc & 1U) != 0U) ? ((wCrc >> 1) ^ 0xEDB88320U) : (wCrc >> 1);
+    }
+  }
+  return (~wCrc);
+}
+
+static bool MC_FaultLog_IsValid(const MC_FaultLogRecord_t *pRecord)
+{
+  return ((MC_FAULTLOG_MAGIC == pRecord->wMagic) && (MC_FaultLog_Crc(pRecord) == pRecord->wCrc));
+}
+
+/**
+ * @brief  Reads the state of the sector. To be called once at boot.
+ */
+void MC_FaultLog_Init(void)
+{
+  const MC_FaultLogRecord_t *pRecords = (const MC_FaultLogRecord_t *)MC_FAULTLOG_FLASH_ADDR;
+  uint32_t i = 0U;
+
+  while ((i < MC_FAULTLOG_NB_SLOTS) && (pRecords[i].wMagic != MC_FAULTLOG_ERASED))
+  {
+    /* A record interrupted by a reset fails its CRC and is skipped */
+    if (true == MC_FaultLog_IsValid(&pRecords[i]))
+    {
+      wNextSequence = pRecords[i].Entry.wSequence + 1U;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    i++;
+  }
+  wSlots = i;
+}
+
+/**
+ * @brief  Keeps the snapshot of the period. It must be called by FOC_CurrControllerM1.
+ */
+void MC_FaultLog_Write(const MC_FaultLog_Snapshot_t *pSnapshot)
+{
+  if (false == Frozen)
+  {
+    Ring[bRingNext] = *pSnapshot;
+    bRingNext = ((bRingNext + 1U) < MC_FAULTLOG_DEPTH) ? (bRingNext + 1U) : 0U;
+    bRingCount = (bRingCount < MC_FAULTLOG_DEPTH) ? (bRingCount + 1U) : MC_FAULTLOG_DEPTH;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+ * @brief  Freezes the snapshots in the entry written by MC_FaultLog_Store, unless they
+ *         are frozen already. Called by the safety task, that the high frequency task
+ *         preempts, when the drive is in fault.
+ */
+void MC_FaultLog_Freeze(uint16_t hFaults, uint8_t bController)
+{
+  uint8_t bSlot;
+  uint8_t i;
+
+  if (false == Frozen)
+  {
+    /* The high frequency task writes no snapshot from now on */
+    Frozen = true;
+    (void)memset(&PendingEntry, 0, sizeof(MC_FaultLog_Entry_t));
+#ifdef MC_TIMEBASE_MODE
+    {
+      MC_Time_Stamp_t Stamp;
+
+      MC_Time_GetStamp(&Stamp);
+      PendingEntry.wTimestamp = Stamp.wTickLow;
+      PendingEntry.wCycles = Stamp.wCycles;
+    }
+#else
+    PendingEntry.wTimestamp = GLOBAL_TIMESTAMP;
+    PendingEntry.wCycles = MC_FAULTLOG_NO_CYCLES;
+#endif
+    PendingEntry.hFaults = hFaults;
+    PendingEntry.bController = bController;
+    PendingEntry.bNbSnapshots = bRingCount;
+    bSlot = (uint8_t)((bRingNext + MC_FAULTLOG_DEPTH - bRingCount) % MC_FAULTLOG_DEPTH);
+    for (i = 0U; i < bRingCount; i++)
+    {
+      PendingEntry.Snapshots[(MC_FAULTLOG_DEPTH - bRingCount) + i] = Ring[bSlot];
+      bSlot = ((bSlot + 1U) < MC_FAULTLOG_DEPTH) ? (bSlot + 1U) : 0U;
+    }
+    Pending = true;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+ * @brief  Restarts the snapshots for the next fault. Called by the medium frequency
+ *         task when the faults are acknowledged.
+ */
+void MC_FaultLog_Rearm(void)
+{
+  bRingCount = 0U;
+  Frozen = false;
+}
+
+/**
+ * @brief  Writes the frozen entry, if any, in the sector. A full sector is erased
+ *         first, in around half a second. The flash is not readable while it is
+ *         written: it must be called by the medium frequency task with the PWM off.
+ */
+void MC_FaultLog_Store(void)
+{
+  MC_FaultLogRecord_t Record;
+  uint32_t Words[sizeof(MC_FaultLogRecord_t) / sizeof(uint32_t)];
+  uint32_t wAddress;
+  uint32_t i;
+
+  if (true == Pending)
+  {
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR
+                           | FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+    if (wSlots >= MC_FAULTLOG_NB_SLOTS)
+    {
+      FLASH_EraseInitTypeDef Erase;
+      uint32_t wSectorError;
+
+      Erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+      Erase.Sector = MC_FAULTLOG_FLASH_SECTOR;
+      Erase.NbSectors = 1U;
+      Erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+      (void)HAL_FLASHEx_Erase(&Erase, &wSectorError);
+      wSlots = 0U;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    (void)memset(&Record, 0xFF, sizeof(Record));
+    Record.wMagic = MC_FAULTLOG_MAGIC;
+    Record.Entry = PendingEntry;
+    Record.Entry.wSequence = wNextSequence;
+    Record.wCrc = MC_FaultLog_Crc(&Record);
+    (void)memcpy(Words, &Record, sizeof(Record));
+    wAddress = MC_FAULTLOG_FLASH_ADDR + (wSlots * sizeof(MC_FaultLogRecord_t));
+    for (i = 0U; i < (sizeof(MC_FaultLogRecord_t) / sizeof(uint32_t)); i++)
+    {
+      (void)HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, wAddress + (i * sizeof(uint32_t)), Words[i]);
+    }
+    HAL_FLASH_Lock();
+    wSlots++;
+    wNextSequence++;
+    Pending = false;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+ * @brief  Number of entries stored, the ones interrupted by a reset included
+ */
+uint16_t MC_FaultLog_GetCount(void)
+{
+  return ((uint16_t)wSlots);
+}
+
+/**
+ * @brief  Sets the entry returned by MC_FaultLog_Read, 0 for the newest
+ */
+void MC_FaultLog_SetReadIndex(uint16_t hIndex)
+{
+  hReadIndex = hIndex;
+}
+
+uint16_t MC_FaultLog_GetReadIndex(void)
+{
+  return (hReadIndex);
+}
+
+/**
+ * @brief  Copies the entry of the read index.
+ * @retval bool False if there is no such entry, or if it was interrupted by a reset
+ */
+bool MC_FaultLog_Read(MC_FaultLog_Entry_t *pEntry)
+{
+  const MC_FaultLogRecord_t *pRecord = (const MC_FaultLogRecord_t *)MC_FAULTLOG_FLASH_ADDR;
+  bool bDone = false;
+
+  /* Newest first */
+  if ((hReadIndex < wSlots) && (true == MC_FaultLog_IsValid(&pRecord[wSlots - 1U - hReadIndex])))
+  {
+    *pEntry = pRecord[wSlots - 1U - hReadIndex].Entry;
+    bDone = true;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bDone);
+}
+
+#endif /* MC_FAULTLOG_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,506 @@
+/**
+  ******************************************************************************
+  * @file    mc_gap.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   STGAP isolated gate drivers configured and monitored over SPI DMA
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "stm32f4xx_ll_spi.h"
+#include "parameters_conversion.h"
+#include "mc_gap.h"
+
+#ifdef MC_GAP_MODE
+
+#if (MC_GAP_NB_DEVICES < 1U) || (MC_GAP_NB_DEVICES > MAX_DEVICES_NUMBER)
+#error "MC_GAP_NB_DEVICES must be 1 to MAX_DEVICES_NUMBER"
+#endif
+
+/* Commands of the STGAP, see gap_gate_driver_ctrl.c */
+#define MC_GAP_STARTCONFIG          0x2AU
+#define MC_GAP_STOPCONFIG           0x3AU
+#define MC_GAP_WRITEREG             0x80U
+#define MC_GAP_READREG              0xA0U
+#define MC_GAP_RESETSTATUS          0xD0U
+#define MC_GAP_GLOBALRESET          0xEAU
+#define MC_GAP_NOP                  0x00U
+
+#define MC_GAP_POLL_TICKS           ((uint16_t)((MC_GAP_POLL_MS * (uint32_t)MEDIUM_FREQUENCY_TASK_RATE) / 1000U))
+
+/* Bits of GAP_ERROR_CODE_xxx raised by the safety task */
+#define MC_GAP_BREAK_IN_ERRORS      (GAP_ERROR_CODE_DESAT | GAP_ERROR_CODE_SENSE)
+#define MC_GAP_OVER_TEMP_ERRORS     GAP_ERROR_CODE_TSD
+#define MC_GAP_UNDER_VOLT_ERRORS    (GAP_ERROR_CODE_UVLOH | GAP_ERROR_CODE_UVLOL | GAP_ERROR_CODE_UVLOD)
+#define MC_GAP_OVER_VOLT_ERRORS     (GAP_ERROR_CODE_OVLOH | GAP_ERROR_CODE_OVLOL | GAP_ERROR_CODE_OVLOD)
+#define MC_GAP_SW_ERRORS            (GAP_ERROR_CODE_REGERRL | GAP_ERROR_CODE_SPI_ERR | GAP_ERROR_CODE_DT_ERR \
+                                     | GAP_ERROR_CODE_CFG | GAP_ERROR_CODE_ASC | GAP_ERROR_CODE_REGERRR    \
+                                     | GAP_ERROR_CODE_SPI_CRC | GAP_ERROR_CODE_DEVICES_NOT_PROGRAMMABLE)
+
+/* Frames of a sequence */
+typedef enum
+{
+  MC_GAP_FRAME_CMD,           /* Same command to all the devices */
+  MC_GAP_FRAME_WRITE,         /* Data of the register of each device, after MC_GAP_WRITEREG */
+  MC_GAP_FRAME_READ           /* NOP that shifts out the register of each device, after MC_GAP_READREG */
+} MC_Gap_Frame_t;
+
+typedef struct
+{
+  uint8_t bFrame;             /* MC_Gap_Frame_t */
+  uint8_t bCmd;               /* Command, or register of the data frames */
+} MC_Gap_Step_t;
+
+static const MC_Gap_Step_t GapConfigSteps[] =
+{
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_STARTCONFIG},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_GLOBALRESET},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_WRITEREG | (uint8_t)CFG1},
+  {(uint8_t)MC_GAP_FRAME_WRITE, (uint8_t)CFG1},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_WRITEREG | (uint8_t)CFG2},
+  {(uint8_t)MC_GAP_FRAME_WRITE, (uint8_t)CFG2},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_WRITEREG | (uint8_t)CFG3},
+  {(uint8_t)MC_GAP_FRAME_WRITE, (uint8_t)CFG3},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_WRITEREG | (uint8_t)CFG4},
+  {(uint8_t)MC_GAP_FRAME_WRITE, (uint8_t)CFG4},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_WRITEREG | (uint8_t)CFG5},
+  {(uint8_t)MC_GAP_FRAME_WRITE, (uint8_t)CFG5},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_WRITEREG | (uint8_t)DIAG1},
+  {(uint8_t)MC_GAP_FRAME_WRITE, (uint8_t)DIAG1},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_WRITEREG | (uint8_t)DIAG2},
+  {(uint8_t)MC_GAP_FRAME_WRITE, (uint8_t)DIAG2},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_STOPCONFIG},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_RESETSTATUS},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)CFG1},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)CFG1},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)CFG2},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)CFG2},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)CFG3},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)CFG3},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)CFG4},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)CFG4},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)CFG5},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)CFG5},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)DIAG1},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)DIAG1},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)DIAG2},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)DIAG2},
+};
+
+static const MC_Gap_Step_t GapPollSteps[] =
+{
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)STATUS1},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)STATUS1},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)STATUS2},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)STATUS2},
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_READREG | (uint8_t)STATUS3},
+  {(uint8_t)MC_GAP_FRAME_READ, (uint8_t)STATUS3},
+};
+
+static const MC_Gap_Step_t GapResetSteps[] =
+{
+  {(uint8_t)MC_GAP_FRAME_CMD, MC_GAP_RESETSTATUS},
+};
+
+static GAP_Handle_t *pGapHandle;
+static MC_Gap_State_t GapState = MC_GAP_CONFIGURING;
+static const MC_Gap_Step_t *pGapSteps;  /* Sequence in progress, NULL if none */
+static uint8_t bGapNbSteps;
+static uint8_t bGapStep;                /* Frame in progress or next one */
+static bool GapFrameActive;             /* NCS low, the DMA moves the frame */
+static uint8_t bGapCmdCrc;              /* CRC of the last command, seed of the data frames */
+static uint8_t bGapRetries;
+static uint8_t bGapCrcErrors;           /* Polls in a row with a wrong CRC */
+static bool GapReadError;               /* A read of the sequence had a wrong CRC or value */
+static uint16_t hGapPollTicks;
+static uint32_t wGapErrors[MC_GAP_NB_DEVICES]; /* Status of the poll in progress */
+static uint16_t GapTxFrame[MC_GAP_NB_DEVICES];
+static uint16_t GapRxFrame[MC_GAP_NB_DEVICES];
+
+/* Value of a register in the configuration of a device */
+static uint8_t MC_Gap_Param(const GAP_DeviceParams_Handle_t *pParams, uint8_t bReg)
+{
+  uint8_t bValue;
+
+  switch (bReg)
+  {
+    case (uint8_t)CFG1:
+      bValue = pParams->CFG1;
+      break;
+    case (uint8_t)CFG2:
+      bValue = pParams->CFG2;
+      break;
+    case (uint8_t)CFG3:
+      bValue = pParams->CFG3;
+      break;
+    case (uint8_t)CFG4:
+      bValue = pParams->CFG4;
+      break;
+    case (uint8_t)CFG5:
+      bValue = pParams->CFG5;
+      break;
+    case (uint8_t)DIAG1:
+      bValue = pParams->DIAG1;
+      break;
+    default:
+      bValue = pParams->DIAG2;
+      break;
+  }
+  return (bValue);
+}
+
+static void MC_Gap_Sequence(const MC_Gap_Step_t *pSteps, uint8_t bNbSteps)
+{
+  pGapSteps = pSteps;
+  bGapNbSteps = bNbSteps;
+  bGapStep = 0U;
+  GapReadError = false;
+}
+
+/**
+ * @brief  Fills the words of the frame and hands them to the DMA. The first word
+ *         shifted out reaches the last device of the chain, as the first word
+ *         shifted in comes from it.
+ */
+static void MC_Gap_StartFrame(void)
+{
+  const MC_Gap_Step_t *pStep = &pGapSteps[bGapStep];
+  uint8_t i;
+
+  for (i = 0U; i < MC_GAP_NB_DEVICES; i++)
+  {
+    uint8_t bDevice = (MC_GAP_NB_DEVICES - 1U) - i;
+
+    if ((uint8_t)MC_GAP_FRAME_WRITE == pStep->bFrame)
+    {
+      GapTxFrame[i] = GAP_CRCCalculate(MC_Gap_Param(&pGapHandle->DeviceParams[bDevice], pStep->bCmd),
+                                       bGapCmdCrc ^ 0xFFU);
+    }
+    else if ((uint8_t)MC_GAP_FRAME_READ == pStep->bFrame)
+    {
+      GapTxFrame[i] = GAP_CRCCalculate(MC_GAP_NOP, 0xFFU);
+    }
+    else
+    {
+      GapTxFrame[i] = GAP_CRCCalculate(pStep->bCmd, 0xFFU);
+    }
+  }
+  if ((uint8_t)MC_GAP_FRAME_CMD == pStep->bFrame)
+  {
+    bGapCmdCrc = (uint8_t)GapTxFrame[0];
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  LL_GPIO_ResetOutputPin(pGapHandle->NCSPort, pGapHandle->NCSPin);
+  /* The RX stream first, so that no word is missed */
+  LL_DMA_SetMemoryAddress(MC_GAP_DMA, MC_GAP_DMA_STREAM_RX, (uint32_t)GapRxFrame); //cstat !MISRAC2012-Rule-11.4 !MISRAC2012-Rule-11.6
+  LL_DMA_SetDataLength(MC_GAP_DMA, MC_GAP_DMA_STREAM_RX, MC_GAP_NB_DEVICES);
+  LL_DMA_EnableStream(MC_GAP_DMA, MC_GAP_DMA_STREAM_RX);
+  LL_DMA_SetMemoryAddress(MC_GAP_DMA, MC_GAP_DMA_STREAM_TX, (uint32_t)GapTxFrame); //cstat !MISRAC2012-Rule-11.4 !MISRAC2012-Rule-11.6
+  LL_DMA_SetDataLength(MC_GAP_DMA, MC_GAP_DMA_STREAM_TX, MC_GAP_NB_DEVICES);
+  LL_DMA_EnableStream(MC_GAP_DMA, MC_GAP_DMA_STREAM_TX);
+  GapFrameActive = true;
+}
+
+/**
+ * @brief  Decodes the words received by a read frame, in the order of the devices
+ */
+static void MC_Gap_EndRead(uint8_t bReg)
+{
+  uint8_t bMask = GAP_RegMask((GAP_Registers_Handle_t)bReg);
+  uint8_t i;
+
+  for (i = 0U; i < MC_GAP_NB_DEVICES; i++)
+  {
+    uint8_t bDevice = (MC_GAP_NB_DEVICES - 1U) - i;
+    uint8_t bValue = (uint8_t)(GapRxFrame[i] >> 8);
+
+    if (((pGapHandle->DeviceParams[bDevice].CFG1 & GAP_CFG1_CRC_SPI) != 0U)
+        && (false == GAP_CRCCheck(&bValue, GapRxFrame[i])))
+    {
+      GapReadError = true;
+    }
+    else
+    {
+      bValue &= bMask;
+      switch (bReg)
+      {
+        case (uint8_t)STATUS1:
+          wGapErrors[bDevice] = (uint32_t)bValue << 16;
+          break;
+        case (uint8_t)STATUS2:
+          /* The GATE bit is the state of the input, not an error */
+          wGapErrors[bDevice] |= (uint32_t)(bValue & (uint8_t)~GAP_STATUS2_GATE) << 8;
+          break;
+        case (uint8_t)STATUS3:
+          wGapErrors[bDevice] |= (uint32_t)bValue;
+          break;
+        default:
+          if ((MC_Gap_Param(&pGapHandle->DeviceParams[bDevice], bReg) & bMask) != bValue)
+          {
+            GapReadError = true;
+          }
+          else
+          {
+            /* Nothing to do */
+          }
+          break;
+      }
+    }
+  }
+}
+
+/**
+ * @brief  Ends the sequence of frames, and updates the state and the errors
+ */
+static void MC_Gap_EndSequence(const MC_Gap_Step_t *pSteps)
+{
+  uint8_t i;
+
+  if (GapPollSteps == pSteps)
+  {
+    if (true == GapReadError)
+    {
+      /* The status of the poll is dropped */
+      if (bGapCrcErrors < MC_GAP_CRC_ERRORS_MAX)
+      {
+        bGapCrcErrors++;
+      }
+      else
+      {
+        pGapHandle->GAP_ErrorsNow[0] |= GAP_ERROR_CODE_SPI_CRC;
+        pGapHandle->GAP_ErrorsOccurred[0] |= GAP_ERROR_CODE_SPI_CRC;
+      }
+    }
+    else
+    {
+      bGapCrcErrors = 0U;
+      for (i = 0U; i < MC_GAP_NB_DEVICES; i++)
+      {
+        pGapHandle->GAP_ErrorsNow[i] = wGapErrors[i];
+        pGapHandle->GAP_ErrorsOccurred[i] |= wGapErrors[i];
+      }
+    }
+  }
+  else if (GapConfigSteps == pSteps)
+  {
+    if (false == GapReadError)
+    {
+      GapState = MC_GAP_READY;
+      LL_GPIO_SetOutputPin(pGapHandle->NSDPort, pGapHandle->NSDPin);
+      hGapPollTicks = 0U;
+    }
+    else if (bGapRetries < MC_GAP_CONFIG_RETRIES)
+    {
+      bGapRetries++;
+      MC_Gap_Sequence(GapConfigSteps, (uint8_t)(sizeof(GapConfigSteps) / sizeof(MC_Gap_Step_t)));
+    }
+    else
+    {
+      GapState = MC_GAP_FAILED;
+      pGapHandle->GAP_ErrorsNow[0] |= GAP_ERROR_CODE_DEVICES_NOT_PROGRAMMABLE;
+      pGapHandle->GAP_ErrorsOccurred[0] |= GAP_ERROR_CODE_DEVICES_NOT_PROGRAMMABLE;
+    }
+  }
+  else
+  {
+    /* Status reset */
+    LL_GPIO_SetOutputPin(pGapHandle->NSDPort, pGapHandle->NSDPin);
+  }
+}
+
+/**
+ * @brief  Starts the configuration of the chain. It must be called by MCboot, before
+ *         any start of the drive.
+ */
+void MC_Gap_Start(GAP_Handle_t *pGap)
+{
+  pGapHandle = pGap;
+  GapState = MC_GAP_CONFIGURING;
+  bGapRetries = 0U;
+  bGapCrcErrors = 0U;
+  GapFrameActive = false;
+
+  LL_GPIO_SetOutputPin(pGapHandle->NCSPort, pGapHandle->NCSPin);
+  /* The outputs of the devices are off until their registers are checked */
+  LL_GPIO_ResetOutputPin(pGapHandle->NSDPort, pGapHandle->NSDPin);
+
+  LL_DMA_DisableStream(MC_GAP_DMA, MC_GAP_DMA_STREAM_RX);
+  LL_DMA_DisableStream(MC_GAP_DMA, MC_GAP_DMA_STREAM_TX);
+  LL_DMA_SetPeriphAddress(MC_GAP_DMA, MC_GAP_DMA_STREAM_RX, LL_SPI_DMA_GetRegAddr(pGapHandle->SPIx));
+  LL_DMA_SetPeriphAddress(MC_GAP_DMA, MC_GAP_DMA_STREAM_TX, LL_SPI_DMA_GetRegAddr(pGapHandle->SPIx));
+  LL_SPI_EnableDMAReq_RX(pGapHandle->SPIx);
+  LL_SPI_EnableDMAReq_TX(pGapHandle->SPIx);
+  LL_SPI_Enable(pGapHandle->SPIx);
+
+  MC_Gap_Sequence(GapConfigSteps, (uint8_t)(sizeof(GapConfigSteps) / sizeof(MC_Gap_Step_t)));
+}
+
+MC_Gap_State_t MC_Gap_GetState(void)
+{
+  return (GapState);
+}
+
+bool MC_Gap_IsReady(void)
+{
+  return (MC_GAP_READY == GapState);
+}
+
+/**
+ * @brief  Returns the GAP_ERROR_CODE_xxx bits of all the devices
+ */
+uint32_t MC_Gap_GetErrors(void)
+{
+  uint32_t wErrors = 0U;
+  uint8_t i;
+
+  for (i = 0U; i < MC_GAP_NB_DEVICES; i++)
+  {
+    wErrors |= pGapHandle->GAP_ErrorsNow[i];
+  }
+  return (wErrors);
+}
+
+/**
+ * @brief  Ends the frame moved by the DMA since the previous period, or starts the
+ *         next one. The polling and the status reset begin when no sequence runs.
+ */
+void MC_Gap_Exec(MCI_Handle_t *pMCI)
+{
+  if (true == GapFrameActive)
+  {
+    if (0U == LL_DMA_IsActiveFlag_TC(MC_GAP_DMA, MC_GAP_DMA_STREAM_RX))
+    {
+      /* Nothing to do, the frame is still moving */
+    }
+    else
+    {
+      LL_DMA_ClearFlag_TC(MC_GAP_DMA, MC_GAP_DMA_STREAM_RX);
+      LL_DMA_DisableStream(MC_GAP_DMA, MC_GAP_DMA_STREAM_RX);
+      LL_DMA_DisableStream(MC_GAP_DMA, MC_GAP_DMA_STREAM_TX);
+      /* The devices execute the command on the rising edge */
+      LL_GPIO_SetOutputPin(pGapHandle->NCSPort, pGapHandle->NCSPin);
+      GapFrameActive = false;
+      if ((uint8_t)MC_GAP_FRAME_READ == pGapSteps[bGapStep].bFrame)
+      {
+        MC_Gap_EndRead(pGapSteps[bGapStep].bCmd);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      bGapStep++;
+      if (bGapStep >= bGapNbSteps)
+      {
+        const MC_Gap_Step_t *pSteps = pGapSteps;
+
+        pGapSteps = NULL;
+        MC_Gap_EndSequence(pSteps);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+  }
+  else if (pGapSteps != NULL)
+  {
+    MC_Gap_StartFrame();
+  }
+  else if (MC_GAP_READY == GapState)
+  {
+    MCI_State_t State = MCI_GetSTMState(pMCI);
+
+    if (hGapPollTicks > 0U)
+    {
+      hGapPollTicks--;
+    }
+    else if ((MC_Gap_GetErrors() != GAP_ERROR_CLEAR)
+             && ((FAULT_NOW == State) || (FAULT_OVER == State) || (IDLE == State)))
+    {
+      /* The PWM is off: the latched status is reset, the next poll shows whether
+         the fault is over. NSD low is required by the reset */
+      LL_GPIO_ResetOutputPin(pGapHandle->NSDPort, pGapHandle->NSDPin);
+      MC_Gap_Sequence(GapResetSteps, (uint8_t)(sizeof(GapResetSteps) / sizeof(MC_Gap_Step_t)));
+      hGapPollTicks = 0U;
+    }
+    else
+    {
+      MC_Gap_Sequence(GapPollSteps, (uint8_t)(sizeof(GapPollSteps) / sizeof(MC_Gap_Step_t)));
+      hGapPollTicks = MC_GAP_POLL_TICKS;
+    }
+  }
+  else
+  {
+    /* Nothing to do, not programmable */
+  }
+}
+
+/**
+ * @brief  Returns the faults of the drive raised by the errors of the devices
+ */
+uint16_t MC_Gap_CheckFaults(void)
+{
+  uint32_t wErrors = MC_Gap_GetErrors();
+  uint16_t hFaults = MC_NO_FAULTS;
+
+  if ((wErrors & MC_GAP_BREAK_IN_ERRORS) != 0U)
+  {
+    hFaults |= MC_BREAK_IN;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  if ((wErrors & MC_GAP_OVER_TEMP_ERRORS) != 0U)
+  {
+    hFaults |= MC_OVER_TEMP;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  if ((wErrors & MC_GAP_UNDER_VOLT_ERRORS) != 0U)
+  {
+    hFaults |= MC_UNDER_VOLT;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  if ((wErrors & MC_GAP_OVER_VOLT_ERRORS) != 0U)
+  {
+    hFaults |= MC_OVER_VOLT;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  if ((wErrors & MC_GAP_SW_ERRORS) != 0U)
+  {
+    hFaults |= MC_SW_ERROR;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (hFaults);
+}
+
+#endif /* MC_GAP_MODE */
+
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -25,6 +25,9 @@
 #include "speed_torq_ctrl.h"
 #include "mc_interface.h"
 #include "motorcontrol.h"
+#ifdef MC_GAP_MODE
+#include "mc_gap.h"
+#endif
 
 #define ROUNDING_OFF
 
@@ -43,6 +46,22 @@
 
 #define round(x) ((x)>=0?(int32_t)((x)+0.5):(int32_t)((x)-0.5))
 
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Publishes the buffered command whose parameters have just been
+  *         written. The buffered commands are posted from the main loop, while
+  *         MCI_ExecBufferedCommands runs in the medium frequency task of the
+  *         SysTick: the caller writes the parameters with the interrupts
+  *         disabled, and the state of the command is written after all of them.
+  * @param  pHandle Pointer on the component instance to work on.
+  */
+static inline void MCI_PostCommand(MCI_Handle_t *pHandle)
+{
+  __DMB();
+  pHandle->CommandState = MCI_COMMAND_NOT_ALREADY_EXECUTED;
+}
+
 /* Functions -----------------------------------------------*/
 
 /**
@@ -80,6 +99,14 @@ __weak void MCI_Init(MCI_Handle_t *pHandle, SpeednTorqCtrl_Handle_t *pSTC, pFOCV
     pHandle->State = IDLE;
     pHandle->CurrentFaults = MC_NO_FAULTS;
     pHandle->PastFaults = MC_NO_FAULTS;
+#ifdef MCI_SETPOINT_STREAM
+    pHandle->Stream.bHead = 0U;
+    pHandle->Stream.bTail = 0U;
+    pHandle->Stream.hClock = 0U;
+    pHandle->Stream.Active = false;
+    pHandle->Stream.wOverruns = 0U;
+    pHandle->Stream.wStarved = 0U;
+#endif
 #ifdef NULL_PTR_MC_INT
   }
 #endif
@@ -108,11 +135,15 @@ __weak void MCI_ExecSpeedRamp(MCI_Handle_t *pHandle,  int16_t hFinalSpeed, uint1
   else
   {
 #endif
+    uint32_t wPrimask = __get_PRIMASK();
+
+    __disable_irq();
     pHandle->lastCommand = MCI_CMD_EXECSPEEDRAMP;
     pHandle->hFinalSpeed = hFinalSpeed;
     pHandle->hDurationms = hDurationms;
-    pHandle->CommandState = MCI_COMMAND_NOT_ALREADY_EXECUTED;
     pHandle->LastModalitySetByUser = STC_SPEED_MODE;
+    MCI_PostCommand(pHandle);
+    __set_PRIMASK(wPrimask);
 #ifdef NULL_PTR_MC_INT
   }
 #endif
@@ -175,11 +206,15 @@ __weak void MCI_ExecTorqueRamp(MCI_Handle_t *pHandle,  int16_t hFinalTorque, uin
   else
   {
 #endif
+    uint32_t wPrimask = __get_PRIMASK();
+
+    __disable_irq();
     pHandle->lastCommand = MCI_CMD_EXECTORQUERAMP;
     pHandle->hFinalTorque = hFinalTorque;
     pHandle->hDurationms = hDurationms;
-    pHandle->CommandState = MCI_COMMAND_NOT_ALREADY_EXECUTED;
     pHandle->LastModalitySetByUser = STC_TORQUE_MODE;
+    MCI_PostCommand(pHandle);
+    __set_PRIMASK(wPrimask);
 #ifdef NULL_PTR_MC_INT
   }
 #endif
@@ -211,7 +246,7 @@ __weak void MCI_ExecTorqueRamp_F( MCI_Handle_t * pHandle,  float FinalTorque, ui
   else
   {
 #endif
-    int16_t hFinalTorque = (int16_t) (FinalTorque * CURRENT_CONV_FACTOR);
+    int16_t hFinalTorque = (int16_t) (FinalTorque * (float)CURRENT_CONV_FACTOR);
     MCI_ExecTorqueRamp(pHandle, hFinalTorque, hDurationms);
 #ifdef NULL_PTR_MC_INT
   }
@@ -239,11 +274,15 @@ __weak void MCI_SetCurrentReferences(MCI_Handle_t *pHandle, qd_t Iqdref)
   else
   {
 #endif
+    uint32_t wPrimask = __get_PRIMASK();
+
+    __disable_irq();
     pHandle->lastCommand = MCI_CMD_SETCURRENTREFERENCES;
     pHandle->Iqdref.q = Iqdref.q;
     pHandle->Iqdref.d = Iqdref.d;
-    pHandle->CommandState = MCI_COMMAND_NOT_ALREADY_EXECUTED;
     pHandle->LastModalitySetByUser = STC_TORQUE_MODE;
+    MCI_PostCommand(pHandle);
+    __set_PRIMASK(wPrimask);
 #ifdef NULL_PTR_MC_INT
   }
 #endif
@@ -271,14 +310,279 @@ __weak void MCI_SetCurrentReferences_F( MCI_Handle_t * pHandle, qd_f_t IqdRef )
   {
 #endif
     qd_t Iqdref;
-    Iqdref.d = (int16_t) (IqdRef.d * CURRENT_CONV_FACTOR);
-    Iqdref.q = (int16_t) (IqdRef.q * CURRENT_CONV_FACTOR);
+    Iqdref.d = (int16_t) (IqdRef.d * (float)CURRENT_CONV_FACTOR);
+    Iqdref.q = (int16_t) (IqdRef.q * (float)CURRENT_CONV_FACTOR);
     MCI_SetCurrentReferences(pHandle, Iqdref);
 #ifdef NULL_PTR_MC_INT
   }
 #endif
 }
 
+#ifdef MCI_SETPOINT_STREAM
+/**
+  * @brief  This is a buffered command that hands the current references over
+  *         to the setpoint stream. This commands don't become active as soon as
+  *         it is called but it will be executed when the pSTM state is
+  *         START_RUN or RUN. From then on, the high frequency task goes from the
+  *         current references to the setpoints queued by MCI_PushSetpoint. The
+  *         setpoints queued before the call are discarded, those queued after it
+  *         are kept. User can check the status of the command calling the
+  *         MCI_IsCommandAcknowledged method.
+  * @param  pHandle Pointer on the component instance to work on.
+  * @retval none.
+  */
+__weak void MCI_StartStream(MCI_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MC_INT
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint32_t wPrimask = __get_PRIMASK();
+
+    /* The tail is only written by MCI_ExecStream while the stream is active, and the
+       high frequency task is not preempted by the caller */
+    __disable_irq();
+    pHandle->Stream.Active = false;
+    pHandle->Stream.bTail = pHandle->Stream.bHead;
+    pHandle->lastCommand = MCI_CMD_STARTSTREAM;
+    pHandle->LastModalitySetByUser = STC_TORQUE_MODE;
+    MCI_PostCommand(pHandle);
+    __set_PRIMASK(wPrimask);
+#ifdef NULL_PTR_MC_INT
+  }
+#endif
+}
+
+/**
+  * @brief  Queues a setpoint of the stream. It is the only producer of the FIFO:
+  *         all the calls must be made from the same context, of a lower priority
+  *         than the high frequency task. The times of the successive setpoints
+  *         must increase, by less than 32768 FOC periods.
+  * @param  pHandle Pointer on the component instance to work on.
+  * @param  hTime Time at which the setpoint is reached, in FOC periods of
+  *         MCI_GetStreamClock(). A setpoint already due is reached at once.
+  * @param  Iqdref current references of the setpoint, in qd_t format.
+  * @retval bool It returns false, and counts an overrun, if the FIFO is full.
+  */
+__weak bool MCI_PushSetpoint(MCI_Handle_t *pHandle, uint16_t hTime, qd_t Iqdref)
+{
+  bool RetVal;
+#ifdef NULL_PTR_MC_INT
+  if (MC_NULL == pHandle)
+  {
+    RetVal = false;
+  }
+  else
+  {
+#endif
+    MCI_Stream_t *pStream = &pHandle->Stream;
+    uint8_t bHead = pStream->bHead;
+
+    if ((uint8_t)(bHead - pStream->bTail) >= MCI_STREAM_DEPTH)
+    {
+      pStream->wOverruns++;
+      RetVal = false;
+    }
+    else
+    {
+      volatile MCI_Setpoint_t *pEntry = &pStream->Fifo[bHead & (MCI_STREAM_DEPTH - 1U)];
+
+      pEntry->hTime = hTime;
+      pEntry->Iqdref.q = Iqdref.q;
+      pEntry->Iqdref.d = Iqdref.d;
+      /* The entry is handed to the consumer once written */
+      pStream->bHead = (uint8_t)(bHead + 1U);
+      RetVal = true;
+    }
+#ifdef NULL_PTR_MC_INT
+  }
+#endif
+  return (RetVal);
+}
+
+/**
+  * @brief  It returns the clock of the setpoint stream, the number of FOC
+  *         periods modulo 65536, to timestamp the setpoints.
+  * @param  pHandle Pointer on the component instance to work on.
+  * @retval uint16_t Clock of the stream.
+  */
+__weak uint16_t MCI_GetStreamClock(MCI_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MC_INT
+  return ((MC_NULL == pHandle) ? 0U : pHandle->Stream.hClock);
+#else
+  return (pHandle->Stream.hClock);
+#endif
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Consumer of the setpoint stream, to be called by the high frequency
+  *         task before the current regulation. It counts the clock of the
+  *         stream and, when the stream is active in RUN state, sets the current
+  *         references by linear interpolation from the last reached setpoint
+  *         to the next one. It holds the last reached setpoint when the FIFO
+  *         is empty.
+  * @param  pHandle Pointer on the component instance to work on.
+  * @retval none.
+  */
+__weak void MCI_ExecStream(MCI_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MC_INT
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    MCI_Stream_t *pStream = &pHandle->Stream;
+    uint16_t hClock = pStream->hClock + 1U;
+
+    pStream->hClock = hClock;
+    if ((true == pStream->Active) && (RUN == pHandle->State))
+    {
+      volatile MCI_Setpoint_t *pNext;
+      uint8_t bHead = pStream->bHead;
+      uint8_t bTail = pStream->bTail;
+      qd_t Iqdref;
+      int32_t wElapsed;
+      int32_t wSpan;
+      bool bDue = true;
+
+      /* The setpoints due are reached, the last of them starts the interpolation */
+      while ((bTail != bHead) && (true == bDue))
+      {
+        pNext = &pStream->Fifo[bTail & (MCI_STREAM_DEPTH - 1U)];
+        bDue = ((int16_t)(pNext->hTime - hClock) <= 0);
+        if (true == bDue)
+        {
+          pStream->Prev.hTime = pNext->hTime;
+          pStream->Prev.Iqdref.q = pNext->Iqdref.q;
+          pStream->Prev.Iqdref.d = pNext->Iqdref.d;
+          bTail++;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+      }
+      pStream->bTail = bTail;
+
+      Iqdref.q = pStream->Prev.Iqdref.q;
+      Iqdref.d = pStream->Prev.Iqdref.d;
+      if (bTail != bHead)
+      {
+        /* The next setpoint is in the future: 0 <= wElapsed < wSpan < 32768 */
+        pNext = &pStream->Fifo[bTail & (MCI_STREAM_DEPTH - 1U)];
+        wElapsed = (int32_t)((uint16_t)(hClock - pStream->Prev.hTime));
+        wSpan = (int32_t)((uint16_t)(pNext->hTime - pStream->Prev.hTime));
+        /* Fraction of the segment in Q15, one division for both axes */
+        wElapsed = (wElapsed * 32768) / wSpan;
+
+        Iqdref.q += (int16_t)((((int32_t)pNext->Iqdref.q - Iqdref.q) * wElapsed) / 32768);
+        Iqdref.d += (int16_t)((((int32_t)pNext->Iqdref.d - Iqdref.d) * wElapsed) / 32768);
+      }
+      else
+      {
+        /* The next setpoint, once queued, is reached from now on */
+        pStream->Prev.hTime = hClock;
+        pStream->wStarved++;
+      }
+      pHandle->pFOCVars->Iqdref = Iqdref;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_MC_INT
+  }
+#endif
+}
+#endif
+
+#ifdef M1_POSITION_CTRL
+/**
+  * @brief  This is a buffered command to move the rotor to a mechanical angle
+  *         along a jerk limited trajectory. This commands don't become active as
+  *         soon as it is called but it will be executed when the pSTM state is
+  *         RUN. User can check the status of the command calling the
+  *         MCI_IsCommandAcknowledged method: it is executed unsuccessfully while
+  *         the previous movement is on going.
+  * @param  pHandle Pointer on the component instance to work on.
+  * @param  FinalPosition is the mechanical angle at the end of the movement,
+  *         in rad, counted from the encoder position at the boot.
+  * @param  hDurationms the duration of the movement expressed in milliseconds.
+  *         It is rounded down to a multiple of 9 periods of the position loop.
+  * @retval none.
+  */
+__weak void MCI_ExecPositionCommand(MCI_Handle_t *pHandle, float FinalPosition, uint16_t hDurationms)
+{
+#ifdef NULL_PTR_MC_INT
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint32_t wPrimask = __get_PRIMASK();
+
+    __disable_irq();
+    pHandle->lastCommand = MCI_CMD_EXECPOSITIONCMD;
+    pHandle->FinalPosition = FinalPosition;
+    pHandle->hDurationms = hDurationms;
+    pHandle->LastModalitySetByUser = STC_TORQUE_MODE;
+    MCI_PostCommand(pHandle);
+    __set_PRIMASK(wPrimask);
+#ifdef NULL_PTR_MC_INT
+  }
+#endif
+}
+
+/**
+  * @brief  It returns the mechanical angle of the rotor measured by the encoder.
+  * @param  pHandle Pointer on the component instance to work on.
+  * @retval float Mechanical angle, in rad, counted from the encoder position at
+  *         the boot.
+  */
+__weak float MCI_GetCurrentPosition(MCI_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MC_INT
+  return ((MC_NULL == pHandle) ? 0.0f : TC_GetCurrentPosition(pHandle->pPosCtrl));
+#else
+  return (TC_GetCurrentPosition(pHandle->pPosCtrl));
+#endif
+}
+
+/**
+  * @brief  It returns the status of the trajectory of the last position command.
+  * @param  pHandle Pointer on the component instance to work on.
+  * @retval PosCtrlStatus_t TC_MOVEMENT_ON_GOING until the trajectory reached its
+  *         final angle, TC_READY_FOR_COMMAND afterwards.
+  */
+__weak PosCtrlStatus_t MCI_GetPositionCtrlStatus(MCI_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_MC_INT
+  return ((MC_NULL == pHandle) ? TC_READY_FOR_COMMAND : TC_GetControlPositionStatus(pHandle->pPosCtrl));
+#else
+  return (TC_GetControlPositionStatus(pHandle->pPosCtrl));
+#endif
+}
+#endif
+
 /**
   * @brief  This is a user command used to begin the start-up procedure.
   *         If the state machine is in IDLE state the command is executed
@@ -304,12 +608,23 @@ __weak bool MCI_StartMotor(MCI_Handle_t *pHandle)
 {
   bool RetVal;
 
-  if ((IDLE == MCI_GetSTMState(pHandle)) &&
+  /* A start requested during an offset measurement goes on with the charge of the
+     bootstrap capacitors once the offsets are measured */
+  if (((IDLE == MCI_GetSTMState(pHandle)) ||
+       ((OFFSET_CALIB == MCI_GetSTMState(pHandle)) && (MCI_MEASURE_OFFSETS == pHandle->DirectCommand))) &&
       (MC_NO_FAULTS == MCI_GetOccurredFaults(pHandle)) &&
+#ifdef MC_GAP_MODE
+      /* The gate drivers are off until their registers are checked */
+      (true == MC_Gap_IsReady()) &&
+#endif
       (MC_NO_FAULTS == MCI_GetCurrentFaults(pHandle)))
   {
     pHandle->DirectCommand = MCI_START;
     pHandle->CommandState = MCI_COMMAND_NOT_ALREADY_EXECUTED;
+#ifdef MCI_SETPOINT_STREAM
+    /* The stream is restarted by MCI_StartStream once in RUN */
+    pHandle->Stream.Active = false;
+#endif
     RetVal = true;
   }
   else
@@ -349,10 +664,18 @@ __weak bool MCI_StartWithMeasurementOffset(MCI_Handle_t* pHandle)
 
   if ((IDLE == MCI_GetSTMState(pHandle)) &&
       (MC_NO_FAULTS == MCI_GetOccurredFaults(pHandle)) &&
+#ifdef MC_GAP_MODE
+      /* The gate drivers are off until their registers are checked */
+      (true == MC_Gap_IsReady()) &&
+#endif
       (MC_NO_FAULTS == MCI_GetCurrentFaults(pHandle)))
   {
     pHandle->DirectCommand = MCI_START;
     pHandle->CommandState = MCI_COMMAND_NOT_ALREADY_EXECUTED;
+#ifdef MCI_SETPOINT_STREAM
+    /* The stream is restarted by MCI_StartStream once in RUN */
+    pHandle->Stream.Active = false;
+#endif
     pHandle->pPWM->offsetCalibStatus = false;
     RetVal = true;
   }
@@ -401,6 +724,175 @@ __weak bool MCI_StartOffsetMeasurments(MCI_Handle_t *pHandle)
   return (RetVal);
 }
 
+#ifdef MC_COMMISSION_MODE
+/**
+  * @brief  This is a user command used to begin the commissioning, the
+  *         identification of the model of the predictive current controller. If
+  *         the state machine is in IDLE state the command is executed
+  *         instantaneously otherwise the command is discarded. User must take
+  *         care of this possibility by checking the return value.\n
+  *         <B>Note:</B> The current offsets are measured first if they are not
+  *         known yet, then the state machine moves to COMMISSIONING, and to STOP
+  *         once the model is identified. The motor turns during the
+  *         identification. Its result is returned by MC_Commission_GetPhase().
+  * @param  pHandle Pointer on the component instance to work on.
+  * @retval bool It returns true if the command is successfully executed
+  *         otherwise it return false.
+  */
+__weak bool MCI_StartCommissioning(MCI_Handle_t *pHandle)
+{
+  bool RetVal;
+
+  if ((IDLE == MCI_GetSTMState(pHandle)) &&
+      (MC_NO_FAULTS == MCI_GetOccurredFaults(pHandle)) &&
+      (MC_NO_FAULTS == MCI_GetCurrentFaults(pHandle)))
+  {
+    pHandle->DirectCommand = MCI_COMMISSION;
+    RetVal = true;
+  }
+  else
+  {
+    /* reject the command as the condition are not met */
+    RetVal = false;
+  }
+
+  return (RetVal);
+}
+#endif
+
+#ifdef MC_DTCALIB_MODE
+/**
+  * @brief  This is a user command used to begin the calibration of the dead time
+  *         compensation. If the state machine is in IDLE state the command is
+  *         executed instantaneously otherwise the command is discarded. User must
+  *         take care of this possibility by checking the return value.\n
+  *         <B>Note:</B> The current offsets are measured first if they are not
+  *         known yet, then the state machine moves to DT_CALIBRATING, and to STOP
+  *         once the compensation is calibrated. The rotor aligns on the axis of
+  *         each phase in turn. Its result is returned by MC_DTCalib_GetPhase().
+  * @param  pHandle Pointer on the component instance to work on.
+  * @retval bool It returns true if the command is successfully executed
+  *         otherwise it return false.
+  */
+__weak bool MCI_StartDeadTimeCalibration(MCI_Handle_t *pHandle)
+{
+  bool RetVal;
+
+  if ((IDLE == MCI_GetSTMState(pHandle)) &&
+      (MC_NO_FAULTS == MCI_GetOccurredFaults(pHandle)) &&
+      (MC_NO_FAULTS == MCI_GetCurrentFaults(pHandle)))
+  {
+    pHandle->DirectCommand = MCI_DT_CALIBRATE;
+    RetVal = true;
+  }
+  else
+  {
+    /* reject the command as the condition are not met */
+    RetVal = false;
+  }
+
+  return (RetVal);
+}
+#endif
+
+#ifdef MC_ADCCALIB_MODE
+/**
+  * @brief  This is a user command used to begin the tuning of the timing of the
+  *         current sampling. If the state machine is in IDLE state the command is
+  *         executed instantaneously otherwise the command is discarded. User must
+  *         take care of this possibility by checking the return value.\n
+  *         <B>Note:</B> The current offsets are measured first if they are not
+  *         known yet, then the state machine moves to ADC_CALIBRATING, and to STOP
+  *         once the timing is selected. The rotor aligns on the axis of phase A.
+  *         Its result is returned by MC_ADCCalib_GetPhase().
+  * @param  pHandle Pointer on the component instance to work on.
+  * @retval bool It returns true if the command is successfully executed
+  *         otherwise it return false.
+  */
+__weak bool MCI_StartAdcCalibration(MCI_Handle_t *pHandle)
+{
+  bool RetVal;
+
+  if ((IDLE == MCI_GetSTMState(pHandle)) &&
+      (MC_NO_FAULTS == MCI_GetOccurredFaults(pHandle)) &&
+      (MC_NO_FAULTS == MCI_GetCurrentFaults(pHandle)))
+  {
+    pHandle->DirectCommand = MCI_ADC_CALIBRATE;
+    RetVal = true;
+  }
+  else
+  {
+    /* reject the command as the condition are not met */
+    RetVal = false;
+  }
+
+  return (RetVal);
+}
+#endif
+
+#ifdef MC_PROFILE_MODE
+/**
+  * @brief  This is a user command used to apply a profile of parameters stored in
+  *         flash, see mc_profile.h. It is executed by the medium frequency task in the
+  *         #IDLE state, so it is only accepted in this state, and the selection is
+  *         kept for the next boots. The profile must be stored: the command is
+  *         ignored otherwise.
+  * @param  pHandle Pointer on the component instance to work on.
+  * @param  bProfile Index of the profile.
+  * @retval bool It returns true if the command is successfully executed
+  *         otherwise it return false.
+  */
+__weak bool MCI_SelectProfile(MCI_Handle_t *pHandle, uint8_t bProfile)
+{
+  bool RetVal;
+
+  if ((IDLE == MCI_GetSTMState(pHandle)) && (MCI_NO_COMMAND == pHandle->DirectCommand))
+  {
+    pHandle->bProfile = bProfile;
+    pHandle->DirectCommand = MCI_SELECT_PROFILE;
+    RetVal = true;
+  }
+  else
+  {
+    /* reject the command as the condition are not met */
+    RetVal = false;
+  }
+
+  return (RetVal);
+}
+#endif
+
+#ifdef MC_PWMFREQ_MODE
+/**
+  * @brief  This is a user command used to change the PWM frequency, see
+  *         mc_pwmfreq.h. It is executed by the medium frequency task in the #IDLE
+  *         state, so it is only accepted in this state. The frequency is checked
+  *         when it is applied: the command is ignored if it is refused.
+  * @param  pHandle Pointer on the component instance to work on.
+  * @param  wFrequency PWM frequency, in Hz.
+  * @retval bool It returns true if the command is successfully executed
+  *         otherwise it return false.
+  */
+__weak bool MCI_SetPwmFrequency(MCI_Handle_t *pHandle, uint32_t wFrequency)
+{
+  bool RetVal;
+
+  if ((IDLE == MCI_GetSTMState(pHandle)) && (MCI_NO_COMMAND == pHandle->DirectCommand))
+  {
+    pHandle->wPwmFrequency = wFrequency;
+    pHandle->DirectCommand = MCI_SET_PWM_FREQ;
+    RetVal = true;
+  }
+  else
+  {
+    /* reject the command as the condition are not met */
+    RetVal = false;
+  }
+
+  return (RetVal);
+}
+#endif
+
 /**
   * @brief  This is a user command used to get the phase offset values.
   *         User must take  care of this possibility by checking the return value.\n
@@ -495,6 +987,9 @@ __weak bool MCI_StopMotor(MCI_Handle_t * pHandle)
        status == true )
   {
     pHandle->DirectCommand = MCI_STOP;
+#ifdef MCI_SETPOINT_STREAM
+    pHandle->Stream.Active = false;
+#endif
     RetVal = true;
   }
   else
@@ -572,10 +1067,17 @@ __weak void MCI_ExecBufferedCommands(MCI_Handle_t *pHandle)
     if ( pHandle->CommandState == MCI_COMMAND_NOT_ALREADY_EXECUTED )
     {
       bool commandHasBeenExecuted = false;
+#ifdef MCI_SETPOINT_STREAM
+      /* Any other command takes the current references back from the stream */
+      pHandle->Stream.Active = false;
+#endif
       switch (pHandle->lastCommand)
       {
         case MCI_CMD_EXECSPEEDRAMP:
         {
+#ifdef M1_POSITION_CTRL
+          TC_Clear(pHandle->pPosCtrl);
+#endif
           pHandle->pFOCVars->bDriveInput = INTERNAL;
           STC_SetControlMode(pHandle->pSTC, STC_SPEED_MODE);
           commandHasBeenExecuted = STC_ExecRamp(pHandle->pSTC, pHandle->hFinalSpeed, pHandle->hDurationms);
@@ -584,6 +1086,9 @@ __weak void MCI_ExecBufferedCommands(MCI_Handle_t *pHandle)
 
         case MCI_CMD_EXECTORQUERAMP:
         {
+#ifdef M1_POSITION_CTRL
+          TC_Clear(pHandle->pPosCtrl);
+#endif
           pHandle->pFOCVars->bDriveInput = INTERNAL;
           STC_SetControlMode(pHandle->pSTC, STC_TORQUE_MODE);
           commandHasBeenExecuted = STC_ExecRamp(pHandle->pSTC, pHandle->hFinalTorque, pHandle->hDurationms);
@@ -592,12 +1097,49 @@ __weak void MCI_ExecBufferedCommands(MCI_Handle_t *pHandle)
 
         case MCI_CMD_SETCURRENTREFERENCES:
         {
+#ifdef M1_POSITION_CTRL
+          TC_Clear(pHandle->pPosCtrl);
+#endif
           pHandle->pFOCVars->bDriveInput = EXTERNAL;
           pHandle->pFOCVars->Iqdref = pHandle->Iqdref;
           commandHasBeenExecuted = true;
           break;
         }
 
+#ifdef M1_POSITION_CTRL
+        case MCI_CMD_EXECPOSITIONCMD:
+        {
+          /* A movement that follows a regulated one starts from its reference,
+             so that the position reference does not jump */
+          float StartPosition = (ENABLE == pHandle->pPosCtrl->PositionControlRegulation)
+                              ? pHandle->pPosCtrl->Theta : TC_GetCurrentPosition(pHandle->pPosCtrl);
+
+          pHandle->pFOCVars->bDriveInput = INTERNAL;
+          STC_SetControlMode(pHandle->pSTC, STC_TORQUE_MODE);
+          commandHasBeenExecuted = TC_MoveCommand(pHandle->pPosCtrl, StartPosition,
+                                                  pHandle->FinalPosition - StartPosition,
+                                                  (float)pHandle->hDurationms / 1000.0f);
+          break;
+        }
+#endif
+
+#ifdef MCI_SETPOINT_STREAM
+        case MCI_CMD_STARTSTREAM:
+        {
+#ifdef M1_POSITION_CTRL
+          TC_Clear(pHandle->pPosCtrl);
+#endif
+          /* The stream starts from the current references, reached now */
+          pHandle->pFOCVars->bDriveInput = EXTERNAL;
+          pHandle->Stream.Prev.hTime = pHandle->Stream.hClock;
+          pHandle->Stream.Prev.Iqdref.q = pHandle->pFOCVars->Iqdref.q;
+          pHandle->Stream.Prev.Iqdref.d = pHandle->pFOCVars->Iqdref.d;
+          pHandle->Stream.Active = true;
+          commandHasBeenExecuted = true;
+          break;
+        }
+#endif
+
         default:
           break;
       }
@@ -1051,20 +1593,21 @@ __weak ab_t MCI_GetIab(MCI_Handle_t *pHandle)
   }
   else
   {
-    tempVal = pHandle->pFOCVars->Iab;
+    tempVal = FOC_GetSnapshot(pHandle->pFOCVars).Iab;
   }
   return (tempVal);
 #else
-  return (pHandle->pFOCVars->Iab);
+  return (FOC_GetSnapshot(pHandle->pFOCVars).Iab);
 #endif
 }
 
 __weak ab_f_t MCI_GetIab_F(MCI_Handle_t *pHandle)
 {
   ab_f_t Iab;
+  ab_t Iab_s16 = FOC_GetSnapshot(pHandle->pFOCVars).Iab;
 
-  Iab.a = (float)((float)pHandle->pFOCVars->Iab.a * CURRENT_CONV_FACTOR_INV);
-  Iab.b = (float)((float)pHandle->pFOCVars->Iab.b * CURRENT_CONV_FACTOR_INV);
+  Iab.a = (float)((float)Iab_s16.a * (float)CURRENT_CONV_FACTOR_INV);
+  Iab.b = (float)((float)Iab_s16.b * (float)CURRENT_CONV_FACTOR_INV);
 
   return (Iab);
 
@@ -1087,11 +1630,11 @@ __weak alphabeta_t MCI_GetIalphabeta(MCI_Handle_t *pHandle)
   }
   else
   {
-    tempVal = pHandle->pFOCVars->Ialphabeta;
+    tempVal = FOC_GetSnapshot(pHandle->pFOCVars).Ialphabeta;
   }
   return (tempVal);
 #else
-  return (pHandle->pFOCVars->Ialphabeta);
+  return (FOC_GetSnapshot(pHandle->pFOCVars).Ialphabeta);
 #endif
 }
 
@@ -1112,11 +1655,11 @@ __weak qd_t MCI_GetIqd(MCI_Handle_t *pHandle)
   }
   else
   {
-    tempVal = pHandle->pFOCVars->Iqd;
+    tempVal = FOC_GetSnapshot(pHandle->pFOCVars).Iqd;
   }
   return (tempVal);
 #else
-  return (pHandle->pFOCVars->Iqd);
+  return (FOC_GetSnapshot(pHandle->pFOCVars).Iqd);
 #endif
 }
 
@@ -1128,9 +1671,10 @@ __weak qd_t MCI_GetIqd(MCI_Handle_t *pHandle)
 __weak qd_f_t MCI_GetIqd_F(MCI_Handle_t *pHandle)
 {
   qd_f_t Iqd;
+  qd_t Iqd_s16 = FOC_GetSnapshot(pHandle->pFOCVars).Iqd;
 
-  Iqd.d = (float)((float)pHandle->pFOCVars->Iqd.d * CURRENT_CONV_FACTOR_INV);
-  Iqd.q = (float)((float)pHandle->pFOCVars->Iqd.q * CURRENT_CONV_FACTOR_INV);
+  Iqd.d = (float)((float)Iqd_s16.d * (float)CURRENT_CONV_FACTOR_INV);
+  Iqd.q = (float)((float)Iqd_s16.q * (float)CURRENT_CONV_FACTOR_INV);
 
   return (Iqd);
 }
@@ -1195,8 +1739,8 @@ __weak qd_f_t MCI_GetIqdref_F(MCI_Handle_t *pHandle)
 {
   qd_f_t Iqdref;
 
-  Iqdref.d = (float)((float)pHandle->pFOCVars->Iqdref.d * CURRENT_CONV_FACTOR_INV);
-  Iqdref.q = (float)((float)pHandle->pFOCVars->Iqdref.q * CURRENT_CONV_FACTOR_INV);
+  Iqdref.d = (float)((float)pHandle->pFOCVars->Iqdref.d * (float)CURRENT_CONV_FACTOR_INV);
+  Iqdref.q = (float)((float)pHandle->pFOCVars->Iqdref.q * (float)CURRENT_CONV_FACTOR_INV);
 
   return ( Iqdref );
 }
@@ -1218,11 +1762,11 @@ __weak qd_t MCI_GetVqd(MCI_Handle_t *pHandle)
   }
   else
   {
-    tempVal = pHandle->pFOCVars->Vqd;
+    tempVal = FOC_GetSnapshot(pHandle->pFOCVars).Vqd;
   }
   return (tempVal);
 #else
-  return (pHandle->pFOCVars->Vqd);
+  return (FOC_GetSnapshot(pHandle->pFOCVars).Vqd);
 #endif
 }
 
@@ -1243,11 +1787,11 @@ __weak alphabeta_t MCI_GetValphabeta(MCI_Handle_t *pHandle)
   }
   else
   {
-    tempVal = pHandle->pFOCVars->Valphabeta;
+    tempVal = FOC_GetSnapshot(pHandle->pFOCVars).Valphabeta;
   }
   return (tempVal);
 #else
-  return (pHandle->pFOCVars->Valphabeta);
+  return (FOC_GetSnapshot(pHandle->pFOCVars).Valphabeta);
 #endif
 }
 
@@ -1260,9 +1804,9 @@ __weak alphabeta_t MCI_GetValphabeta(MCI_Handle_t *pHandle)
 __weak int16_t MCI_GetElAngledpp(MCI_Handle_t *pHandle)
 {
 #ifdef NULL_PTR_MC_INT
-  return ((MC_NULL == pHandle) ? 0 : pHandle->pFOCVars->hElAngle);
+  return ((MC_NULL == pHandle) ? 0 : FOC_GetSnapshot(pHandle->pFOCVars).hElAngle);
 #else
-  return (pHandle->pFOCVars->hElAngle);
+  return (FOC_GetSnapshot(pHandle->pFOCVars).hElAngle);
 #endif
 }
 
@@ -1289,7 +1833,7 @@ __weak int16_t MCI_GetTeref(MCI_Handle_t *pHandle)
 __weak float MCI_GetTeref_F(MCI_Handle_t *pHandle)
 {
 
-  return ((float)(pHandle->pFOCVars->hTeref * CURRENT_CONV_FACTOR_INV));
+  return ((float)(pHandle->pFOCVars->hTeref * (float)CURRENT_CONV_FACTOR_INV));
 }
 
 /**
@@ -1312,7 +1856,7 @@ __weak int16_t MCI_GetPhaseCurrentAmplitude(MCI_Handle_t *pHandle)
   else
   {
 #endif
-  Local_Curr = pHandle->pFOCVars->Ialphabeta;
+  Local_Curr = FOC_GetSnapshot(pHandle->pFOCVars).Ialphabeta;
   wAux = MCM_Modulus( Local_Curr.alpha, Local_Curr.beta );
 #ifdef NULL_PTR_MC_INT
   }
@@ -1343,7 +1887,7 @@ __weak int16_t MCI_GetPhaseVoltageAmplitude(MCI_Handle_t *pHandle)
     int32_t wAux1;
     int32_t wAux2;
 
-    Local_Voltage = pHandle->pFOCVars->Valphabeta;
+    Local_Voltage = FOC_GetSnapshot(pHandle->pFOCVars).Valphabeta;
     wAux1 = (int32_t)(Local_Voltage.alpha) * Local_Voltage.alpha;
     wAux2 = (int32_t)(Local_Voltage.beta) * Local_Voltage.beta;
 
@@ -36,6 +36,8 @@
 
 /* Private macro -------------------------------------------------------------*/
 
+#ifndef MC_BOARD_CORDIC
+/* Quarter wave sine table of the boards without CORDIC */
 #define SIN_COS_TABLE {\
     0x0000,0x00C9,0x0192,0x025B,0x0324,0x03ED,0x04B6,0x057F,\
     0x0648,0x0711,0x07D9,0x08A2,0x096A,0x0A33,0x0AFB,0x0BC4,\
@@ -68,18 +70,12 @@
     0x7D89,0x7DB0,0x7DD5,0x7DFA,0x7E1D,0x7E3E,0x7E5F,0x7E7E,\
     0x7E9C,0x7EB9,0x7ED5,0x7EEF,0x7F09,0x7F21,0x7F37,0x7F4D,\
     0x7F61,0x7F74,0x7F86,0x7F97,0x7FA6,0x7FB4,0x7FC1,0x7FCD,\
-    0x7FD8,0x7FE1,0x7FE9,0x7FF0,0x7FF5,0x7FF9,0x7FFD,0x7FFE}
-
-#define SIN_MASK        0x0300u
-#define U0_90           0x0200u
-#define U90_180         0x0300u
-#define U180_270        0x0000u
-#define U270_360        0x0100u
+    0x7FD8,0x7FE1,0x7FE9,0x7FF0,0x7FF5,0x7FF9,0x7FFD,0x7FFE,\
+    0x7FFF}
 
 /* Private variables ---------------------------------------------------------*/
-const int16_t hSin_Cos_Table[256] = SIN_COS_TABLE;
-
-#define divSQRT_3 (int32_t)0x49E6    /* 1/sqrt(3) in q1.15 format=0.5773315*/
+const int16_t hSin_Cos_Table[SIN_TABLE_SIZE] = SIN_COS_TABLE;
+#endif /* MC_BOARD_CORDIC */
 
 #if defined (CCMRAM)
 #if defined (__ICCARM__)
@@ -87,6 +83,8 @@ const int16_t hSin_Cos_Table[256] = SIN_COS_TABLE;
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function transforms stator values a and b (which are
@@ -99,53 +97,7 @@ __attribute__( ( section ( ".ccmram" ) ) )
   */
 __weak alphabeta_t MCM_Clarke(ab_t Input)
 {
-  alphabeta_t Output;
-
-  int32_t a_divSQRT3_tmp;
-  int32_t b_divSQRT3_tmp;
-  int32_t wbeta_tmp;
-  int16_t hbeta_tmp;
-
-  /* qIalpha = qIas*/
-  Output.alpha = Input.a;
-
-  a_divSQRT3_tmp = divSQRT_3 * ((int32_t)Input.a);
-
-  b_divSQRT3_tmp = divSQRT_3 * ((int32_t)Input.b);
-
-  /*qIbeta = -(2*qIbs+qIas)/sqrt(3)*/
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-    the compiler to perform the shift (instead of LSR logical shift right) */
-  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-  wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) >> 15;
-#else
-  wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) / 32768;
-#endif
-
-  /* Check saturation of Ibeta */
-  if (wbeta_tmp > INT16_MAX)
-  {
-    hbeta_tmp = INT16_MAX;
-  }
-  else if (wbeta_tmp < (-32768))
-  {
-    hbeta_tmp =  ((int16_t)-32768);
-  }
-  else
-  {
-    hbeta_tmp = ((int16_t)wbeta_tmp);
-  }
-
-  Output.beta = hbeta_tmp;
-
-  if (((int16_t )-32768) == Output.beta)
-  {
-    Output.beta = -32767;
-  }
-
-  return (Output);
+  return (MCM_Clarke_Inline(Input));
 }
 
 #if defined (CCMRAM)
@@ -154,6 +106,8 @@ __weak alphabeta_t MCM_Clarke(ab_t Input)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function transforms stator values alpha and beta, which
@@ -167,92 +121,7 @@ __attribute__( ( section ( ".ccmram" ) ) )
   */
 __weak qd_t MCM_Park(alphabeta_t Input, int16_t Theta)
 {
-  qd_t Output;
-  int32_t d_tmp_1;
-  int32_t d_tmp_2;
-  int32_t q_tmp_1;
-  int32_t q_tmp_2;
-  int32_t wqd_tmp;
-  int16_t hqd_tmp;
-  Trig_Components Local_Vector_Components;
-
-  Local_Vector_Components = MCM_Trig_Functions(Theta);
-
-  /*No overflow guaranteed*/
-  q_tmp_1 = Input.alpha * ((int32_t )Local_Vector_Components.hCos);
-
-  /*No overflow guaranteed*/
-  q_tmp_2 = Input.beta * ((int32_t)Local_Vector_Components.hSin);
-
-  /*Iq component in Q1.15 Format */
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-    the compiler to perform the shift (instead of LSR logical shift right) */
-  wqd_tmp = (q_tmp_1 - q_tmp_2) >> 15; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-#else
-  wqd_tmp = (q_tmp_1 - q_tmp_2) / 32768;
-#endif
-
-  /* Check saturation of Iq */
-  if (wqd_tmp > INT16_MAX)
-  {
-    hqd_tmp = INT16_MAX;
-  }
-  else if (wqd_tmp < (-32768))
-  {
-    hqd_tmp = ((int16_t)-32768);
-  }
-  else
-  {
-    hqd_tmp = ((int16_t)wqd_tmp);
-  }
-
-  Output.q = hqd_tmp;
-
-  if (((int16_t )-32768) == Output.q)
-  {
-    Output.q = -32767;
-  }
-
-  /*No overflow guaranteed*/
-  d_tmp_1 = Input.alpha * ((int32_t )Local_Vector_Components.hSin);
-
-  /*No overflow guaranteed*/
-  d_tmp_2 = Input.beta * ((int32_t )Local_Vector_Components.hCos);
-
-  /*Id component in Q1.15 Format */
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-    the compiler to perform the shift (instead of LSR logical shift right) */
-  wqd_tmp = (d_tmp_1 + d_tmp_2) >> 15; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-#else
-  wqd_tmp = (d_tmp_1 + d_tmp_2) / 32768;
-#endif
-
-  /* Check saturation of Id */
-  if (wqd_tmp > INT16_MAX)
-  {
-    hqd_tmp = INT16_MAX;
-  }
-  else if (wqd_tmp < (-32768))
-  {
-    hqd_tmp = ((int16_t)-32768);
-  }
-  else
-  {
-    hqd_tmp = ((int16_t)wqd_tmp);
-  }
-
-  Output.d = hqd_tmp;
-
-  if (((int16_t)-32768) == Output.d)
-  {
-    Output.d = -32767;
-  }
-
-  return (Output);
+  return (MCM_Park_Trig_Inline(Input, MCM_Trig_Functions(Theta)));
 }
 
 #if defined (CCMRAM)
@@ -261,6 +130,8 @@ __weak qd_t MCM_Park(alphabeta_t Input, int16_t Theta)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function transforms stator voltage qVq and qVd, that belong to
@@ -274,43 +145,84 @@ __attribute__( ( section ( ".ccmram" ) ) )
   */
 __weak alphabeta_t MCM_Rev_Park(qd_t Input, int16_t Theta)
 {
-  int32_t alpha_tmp1;
-  int32_t alpha_tmp2;
-  int32_t beta_tmp1;
-  int32_t beta_tmp2;
-  Trig_Components Local_Vector_Components;
-  alphabeta_t Output;
-
-  Local_Vector_Components = MCM_Trig_Functions(Theta);
-
-  /*No overflow guaranteed*/
-  alpha_tmp1 = Input.q * ((int32_t)Local_Vector_Components.hCos);
-  alpha_tmp2 = Input.d * ((int32_t)Local_Vector_Components.hSin);
+  return (MCM_Rev_Park_Trig_Inline(Input, MCM_Trig_Functions(Theta)));
+}
 
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-    the compiler to perform the shift (instead of LSR logical shift right) */
-  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-  Output.alpha = (int16_t)(((alpha_tmp1) + (alpha_tmp2)) >> 15);
-#else
-  Output.alpha = (int16_t)(((alpha_tmp1) + (alpha_tmp2)) / 32768);
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  This function carries out MCM_Clarke() and MCM_Park() in one pass and
+  *         also returns the sine and cosine of Theta, so that they can be reused
+  *         by the other transformations at the same angle.
+  *                               alpha = a
+  *                       beta = -(2*b+a)/sqrt(3)
+  *                   q= alpha *cos(Theta)- beta *sin(Theta)
+  *                   d= alpha *sin(theta)+ beta *cos(Theta)
+  *         The outputs are saturated as by MCM_Clarke() and MCM_Park().
+  * @param  Input: stator values a and b in ab_t format
+  * @param  Theta: rotating frame angular position in q1.15 format
+  * @param  pAlphabeta: stator values alpha and beta in alphabeta_t format
+  * @param  pTrig: Cos(Theta) and Sin(Theta) in Trig_Components format
+  * @retval Stator values q and d in qd_t format
+  */
+__weak qd_t MCM_ClarkePark(ab_t Input, int16_t Theta, alphabeta_t *pAlphabeta, Trig_Components *pTrig)
+{
+  *pTrig = MCM_Trig_Functions(Theta);
+  return (MCM_ClarkePark_Trig(Input, *pTrig, pAlphabeta));
+}
 
-  beta_tmp1 = Input.q * ((int32_t)Local_Vector_Components.hSin);
-  beta_tmp2 = Input.d * ((int32_t)Local_Vector_Components.hCos);
-
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-  that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-  the compiler to perform the shift (instead of LSR logical shift right) */
-  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-  Output.beta = (int16_t)((beta_tmp2 - beta_tmp1) >> 15);
-#else
-  Output.beta = (int16_t)((beta_tmp2 - beta_tmp1) / 32768);
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
+/**
+  * @brief  This function carries out MCM_ClarkePark() with the sine and cosine
+  *         of the angle already computed, e.g. requested with MCM_Trig_Request()
+  *         before the phase currents are read and obtained with
+  *         MCM_Trig_Collect().
+  * @param  Input: stator values a and b in ab_t format
+  * @param  Trig: Cos(Theta) and Sin(Theta) in Trig_Components format
+  * @param  pAlphabeta: stator values alpha and beta in alphabeta_t format
+  * @retval Stator values q and d in qd_t format
+  */
+__weak qd_t MCM_ClarkePark_Trig(ab_t Input, Trig_Components Trig, alphabeta_t *pAlphabeta)
+{
+  return (MCM_ClarkePark_Trig_Inline(Input, Trig, pAlphabeta));
+}
 
-  return (Output);
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  This function carries out MCM_Rev_Park() with the sine and cosine of
+  *         the angle already computed, e.g. by MCM_ClarkePark():
+  *                  Valfa= Vq*Cos(theta)+ Vd*Sin(theta)
+  *                  Vbeta=-Vq*Sin(theta)+ Vd*Cos(theta)
+  * @param  Input: stator voltage Vq and Vd in qd_t format
+  * @param  Trig: Cos(theta) and Sin(theta) in Trig_Components format
+  * @retval Stator voltage Valpha and Vbeta in qd_t format
+  */
+__weak alphabeta_t MCM_Rev_Park_Trig(qd_t Input, Trig_Components Trig)
+{
+  return (MCM_Rev_Park_Trig_Inline(Input, Trig));
 }
 
 #if defined (CCMRAM)
@@ -319,61 +231,42 @@ __weak alphabeta_t MCM_Rev_Park(qd_t Input, int16_t Theta)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function returns cosine and sine functions of the angle fed in
-  *         input
+  *         input. On the boards without CORDIC, both come from a quarter wave
+  *         table indexed by the bits of hAngle, with a linear interpolation: no
+  *         division is needed.
   * @param  hAngle: angle in q1.15 format
   * @retval Sin(angle) and Cos(angle) in Trig_Components format
   */
 
 __weak Trig_Components MCM_Trig_Functions(int16_t hAngle)
 {
+  return (MCM_Trig_Functions_Inline(hAngle));
+}
 
-  int32_t shindex;
-  uint16_t uhindex;
-
-  Trig_Components Local_Components;
-
-  /* 10 bit index computation  */
-  shindex = (((int32_t)32768) + ((int32_t)hAngle));
-  uhindex = (uint16_t)shindex;
-  uhindex /= ((uint16_t)64);
-
-  switch (((uint16_t)uhindex) & SIN_MASK)
-  {
-    case U0_90:
-    {
-      Local_Components.hSin = hSin_Cos_Table[( uint8_t )( uhindex )];
-      Local_Components.hCos = hSin_Cos_Table[( uint8_t )( 0xFFu - ( uint8_t )( uhindex ) )];
-      break;
-    }
-
-    case U90_180:
-    {
-      Local_Components.hSin = hSin_Cos_Table[( uint8_t )( 0xFFu - ( uint8_t )( uhindex ) )];
-      Local_Components.hCos = -hSin_Cos_Table[( uint8_t )( uhindex )];
-      break;
-    }
-
-    case U180_270:
-    {
-      Local_Components.hSin = -hSin_Cos_Table[( uint8_t )( uhindex )];
-      Local_Components.hCos = -hSin_Cos_Table[( uint8_t )( 0xFFu - ( uint8_t )( uhindex ) )];
-      break;
-    }
-
-    case U270_360:
-    {
-      Local_Components.hSin =  -hSin_Cos_Table[( uint8_t )( 0xFFu - ( uint8_t )( uhindex ) )];
-      Local_Components.hCos =  hSin_Cos_Table[( uint8_t )( uhindex )];
-      break;
-    }
-
-    default:
-      break;
-  }
-  return (Local_Components);
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  This function returns the cosine and sine of several angles in one
+  *         call
+  * @param  pAngles: angles in q1.15 format
+  * @param  pTrig: Cos(angle) and Sin(angle) of each angle, in the same order
+  * @param  bCount: number of angles
+  */
+__weak void MCM_Trig_Functions_Batch(const int16_t *pAngles, Trig_Components *pTrig, uint8_t bCount)
+{
+  MCM_Trig_Functions_Batch_Inline(pAngles, pTrig, bCount);
 }
 
 #if defined (CCMRAM)
@@ -382,6 +275,8 @@ __weak Trig_Components MCM_Trig_Functions(int16_t hAngle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It calculates the square root of a non-negative int32_t. It returns 0
@@ -391,44 +286,8 @@ __attribute__( ( section ( ".ccmram" ) ) )
   */
 __weak int32_t MCM_Sqrt(int32_t wInput)
 {
-  int32_t wtemprootnew;
-
-  if (wInput > 0)
-  {
-  uint8_t biter = 0u;
-  int32_t wtemproot;
-
-    if (wInput <= ((int32_t)2097152))
-    {
-      wtemproot = ((int32_t)128);
-    }
-    else
-    {
-      wtemproot = ((int32_t)8192);
-    }
-
-    do
-    {
-      wtemprootnew = (wtemproot + (wInput / wtemproot)) / (int32_t)2;
-      if ((wtemprootnew == wtemproot) || ((int32_t)0 == wtemproot))
-      {
-        biter = 6U;
-      }
-      else
-      {
-        biter ++;
-        wtemproot = wtemprootnew;
-      }
-    }
-    while (biter < 6U);
-
-  }
-  else
-  {
-    wtemprootnew = (int32_t)0;
-  }
-
-  return (wtemprootnew);
+  /* With the CORDIC, the interrupts are masked around it, sqrt is used in MF and HF task */
+  return (MCM_Sqrt_Inline(wInput));
 }
 
 /**
@@ -20,11 +20,94 @@
 #include "parameters_conversion.h"
 #include "mc_perf.h"
 
+/* Duration of the FOC period in CPU cycles */
+#define MC_PERF_FOC_PERIOD_CYCLES  ((uint32_t)SYSCLK_FREQ / ((uint32_t)PWM_FREQUENCY / (uint32_t)REGULATION_EXECUTION_RATE))
+
+/* Histogram bin of a measure, as a multiply and shift: (Delta * MC_PERF_HISTO_SCALE) >> 16 */
+#define MC_PERF_HISTO_SCALE  (((uint32_t)MC_PERF_HISTO_NB_BINS << 16) / MC_PERF_FOC_PERIOD_CYCLES)
+
+/* Window of the CPU loads */
+#define MC_PERF_LOAD_WINDOW_MS      100U
+#define MC_PERF_LOAD_WINDOW_CYCLES  (((uint32_t)SYSCLK_FREQ / 1000U) * MC_PERF_LOAD_WINDOW_MS)
+
+/* Period of the tasks of MC_PERF_TASKS_LIST_t in CPU cycles */
+static const uint32_t MC_Perf_TaskPeriod[MC_PERF_NB_JITTERS] =
+{
+  (uint32_t)SYSCLK_FREQ / (uint32_t)SPEED_LOOP_FREQUENCY_HZ,
+  (uint32_t)SYSCLK_FREQ / (uint32_t)SYS_TICK_FREQUENCY,
+  MC_PERF_FOC_PERIOD_CYCLES
+};
+
+static void MC_Perf_ResetTrace(Perf_Handle_t *pHdl)
+{
+  uint8_t  j;
+
+  pHdl->DeltaTimeInCycle = 0;
+  pHdl->min = UINT32_MAX;
+  pHdl->max = 0;
+  pHdl->mean = 0;
+  pHdl->AccCycles = 0;
+  pHdl->NbMeasures = 0;
+  for (j = 0; j<MC_PERF_HISTO_NB_BINS; j++) {
+    pHdl->Histogram[j] = 0;
+  }
+}
+
+static void MC_Perf_ResetJitter(Perf_Jitter_t *pJit)
+{
+  pJit->min = INT32_MAX;
+  pJit->max = INT32_MIN;
+  pJit->NbOverruns = 0;
+  pJit->Started = false;
+}
+
+static void MC_Perf_ResetNoise(Perf_Noise_t *pNoise)
+{
+  uint8_t  j;
+
+  for (j = 0; j<2U; j++) {
+    pNoise->AccSample[j] = 0;
+    pNoise->AccSquare[j] = 0;
+    pNoise->mean[j] = 0;
+    pNoise->variance[j] = 0;
+  }
+  pNoise->NbSamples = 0;
+}
+
+static void MC_Perf_ResetLoads(MC_Perf_Handle_t *pHandle)
+{
+  uint8_t  j;
+
+  for (j = 0; j<MC_PERF_NB_LOADS; j++) {
+    pHandle->MC_Perf_LoadLog[j].load = 0;
+    pHandle->MC_Perf_LoadLog[j].max = 0;
+  }
+  pHandle->IdleLoad = MC_PERF_LOAD_FULL;
+  pHandle->MinIdleLoad = MC_PERF_LOAD_FULL;
+}
+
+/* Updates min, max and mean with the last measure */
+static void MC_Perf_UpdateStats(Perf_Handle_t *pHdl)
+{
+  if (pHdl->max < pHdl->DeltaTimeInCycle) { pHdl->max = pHdl->DeltaTimeInCycle; }
+  if (pHdl->min > pHdl->DeltaTimeInCycle) { pHdl->min = pHdl->DeltaTimeInCycle; }
+
+  pHdl->AccCycles += pHdl->DeltaTimeInCycle;
+  pHdl->NbMeasures++;
+  if (pHdl->NbMeasures >= ((uint16_t)1 << MC_PERF_MEAN_WINDOW_LOG))
+  {
+    pHdl->mean = pHdl->AccCycles >> MC_PERF_MEAN_WINDOW_LOG;
+    pHdl->AccCycles = 0;
+    pHdl->NbMeasures = 0;
+  }
+}
+
 void  MC_Perf_Measure_Init (MC_Perf_Handle_t *pHandle)
 {
   uint8_t  i;
   Perf_Handle_t  *pHdl;
 
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // Enable the DWT also without debugger
   if (DWT->CTRL != 0) {                         // Check if DWT is present
     DWT->CYCCNT  = 0;
     DWT->CTRL   |= DWT_CTRL_CYCCNTENA_Msk;      // Enable Cycle Counter
@@ -33,12 +116,24 @@ void  MC_Perf_Measure_Init (MC_Perf_Handle_t *pHandle)
   for (i = 0; i<MC_PERF_NB_TRACES; i++) {
     pHdl = &pHandle->MC_Perf_TraceLog[i];
     pHdl->StartMeasure = 0;
-    pHdl->DeltaTimeInCycle = 0;
-    pHdl->min = UINT32_MAX;
-    pHdl->max = 0;
+    MC_Perf_ResetTrace(pHdl);
+  }
+  for (i = 0; i<MC_PERF_NB_JITTERS; i++) {
+    pHandle->MC_Perf_JitterLog[i].LastStart = 0;
+    MC_Perf_ResetJitter(&pHandle->MC_Perf_JitterLog[i]);
   }
   pHandle->BG_Task_OnGoing = false;
   pHandle->AccHighFreqTasksCnt = 0;
+  pHandle->NbFpuTasks = 0U;
+  MC_Perf_ResetNoise(&pHandle->CurrentNoise);
+  for (i = 0; i<MC_PERF_NB_LOADS; i++) {
+    pHandle->MC_Perf_LoadLog[i].StartMeasure = 0;
+    pHandle->MC_Perf_LoadLog[i].NestedMark = 0;
+    pHandle->MC_Perf_LoadLog[i].AccCycles = 0;
+  }
+  pHandle->LoadNestedCycles = 0;
+  pHandle->LoadWindowStart = DWT->CYCCNT;
+  MC_Perf_ResetLoads(pHandle);
 
 }
 
@@ -49,10 +144,14 @@ void  MC_Perf_Clear(MC_Perf_Handle_t *pHandle)
 
   for (i = 0; i<MC_PERF_NB_TRACES; i++) {
     pHdl = &pHandle->MC_Perf_TraceLog[i];
-    pHdl->DeltaTimeInCycle = 0;
-    pHdl->min = UINT32_MAX;
-    pHdl->max = 0;
+    MC_Perf_ResetTrace(pHdl);
+  }
+  for (i = 0; i<MC_PERF_NB_JITTERS; i++) {
+    MC_Perf_ResetJitter(&pHandle->MC_Perf_JitterLog[i]);
   }
+  pHandle->NbFpuTasks = 0U;
+  MC_Perf_ResetNoise(&pHandle->CurrentNoise);
+  MC_Perf_ResetLoads(pHandle);
 }
 
 /**
@@ -66,6 +165,96 @@ void  MC_Perf_Measure_Start (MC_Perf_Handle_t *pHandle, uint8_t  CodeSection)
   pHandle->MC_Perf_TraceLog[CodeSection].StartMeasure = StartMeasure;
 }
 
+/**
+ * @brief  Counts the high frequency tasks that executed an FPU instruction.
+ *         CONTROL.FPCA is cleared at the exception entry and set by the first
+ *         FPU instruction of the handler: at the end of the task it tells
+ *         whether the ADC interrupt, callees and compiler generated code
+ *         included, caused the lazy stacking of the FPU context.
+ * @param  pHandle: handler of the performance measurement component
+ */
+void  MC_Perf_CheckFpu (MC_Perf_Handle_t *pHandle)
+{
+  if (((__get_CONTROL() & CONTROL_FPCA_Msk) != 0U) && (pHandle->NbFpuTasks < UINT16_MAX))
+  {
+    pHandle->NbFpuTasks++;
+  }
+}
+
+/**
+ * @brief  Measures the entry latency of an interrupt in the cases of
+ *         MC_PERF_IRQ_ENTRIES_LIST_t: the FPU interrupt, unused otherwise, is
+ *         pended at the highest priority and its handler reads the cycle counter.
+ *         The differences between the cases are the cost of the FPU context,
+ *         the pending and the read of the counter being the same in all.
+ *         Called once by MCboot(), the interrupts enabled, before the PWM starts.
+ * @param  pHandle: handler of the performance measurement component
+ */
+void  MC_Perf_MeasureIrqEntry (MC_Perf_Handle_t *pHandle)
+{
+  volatile float FpuOperand = 1.0f;
+  uint32_t Fpccr = FPU->FPCCR;
+  uint32_t StartMeasure;
+  uint8_t  i;
+
+  NVIC_SetPriority(FPU_IRQn, 0U);
+  NVIC_EnableIRQ(FPU_IRQn);
+  for (i = 0; i<MC_PERF_NB_IRQ_ENTRIES; i++) {
+    if ((uint8_t)IRQ_ENTRY_NO_FPU == i) {
+      /* No FPU context active */
+      __set_CONTROL(__get_CONTROL() & ~CONTROL_FPCA_Msk);
+      __ISB();
+    } else {
+      /* Without LSPEN the exception entry stacks the FPU registers */
+      FPU->FPCCR = ((uint8_t)IRQ_ENTRY_FPU_STACKED == i) ? (Fpccr & ~FPU_FPCCR_LSPEN_Msk) : Fpccr;
+      /* An FPU instruction activates the FPU context, CONTROL.FPCA */
+      FpuOperand = FpuOperand * 1.0f;
+    }
+    StartMeasure = DWT->CYCCNT;
+    NVIC_SetPendingIRQ(FPU_IRQn);
+    __DSB();
+    __ISB();
+    pHandle->IrqEntryCycles[i] = (uint16_t)(pHandle->IrqEntryStamp - StartMeasure);
+  }
+  FPU->FPCCR = Fpccr;
+  NVIC_DisableIRQ(FPU_IRQn);
+}
+
+/**
+ * @brief  Accumulates the phase currents read in the FOC period. The mean and the
+ *         variance of Ia and Ib are updated at the end of each window of
+ *         2^MC_PERF_MEAN_WINDOW_LOG samples.
+ * @param  pHandle: handler of the performance measurement component
+ * @param  Iab: phase currents read by the current sensing component
+ */
+void  MC_Perf_CurrentNoise (MC_Perf_Handle_t *pHandle, ab_t Iab)
+{
+  Perf_Noise_t *pNoise = &pHandle->CurrentNoise;
+  int32_t Sample[2];
+  int32_t Mean;
+  uint8_t  j;
+
+  Sample[0] = Iab.a;
+  Sample[1] = Iab.b;
+  for (j = 0; j<2U; j++) {
+    pNoise->AccSample[j] += Sample[j];
+    pNoise->AccSquare[j] += (uint64_t)((uint32_t)(Sample[j] * Sample[j]));
+  }
+  pNoise->NbSamples++;
+  if (pNoise->NbSamples >= ((uint16_t)1 << MC_PERF_MEAN_WINDOW_LOG))
+  {
+    for (j = 0; j<2U; j++) {
+      /* Variance = mean of the squares - square of the mean */
+      Mean = pNoise->AccSample[j] / (int32_t)((uint32_t)1 << MC_PERF_MEAN_WINDOW_LOG);
+      pNoise->mean[j] = (int16_t)Mean;
+      pNoise->variance[j] = (uint32_t)(pNoise->AccSquare[j] >> MC_PERF_MEAN_WINDOW_LOG) - (uint32_t)(Mean * Mean);
+      pNoise->AccSample[j] = 0;
+      pNoise->AccSquare[j] = 0;
+    }
+    pNoise->NbSamples = 0;
+  }
+}
+
 /**
  * @brief  Start the measure of a code section called in background
  * @param  pHandle: handler of the performance measurement component
@@ -80,13 +269,15 @@ void  MC_BG_Perf_Measure_Start (MC_Perf_Handle_t *pHandle, uint8_t  CodeSection)
 }
 
 /**
- * @brief  Stop the measurement of a code section and compute elapse time
+ * @brief  Stop the measurement of a code section and compute elapse time.
+ *         Min, max, mean and the histogram of the code section are updated.
  * @param  pHandle: handler of the performance measurement component
  * @param  CodeSection: code section to measure
  */
 void  MC_Perf_Measure_Stop (MC_Perf_Handle_t *pHandle, uint8_t  CodeSection)
 {
   uint32_t StopMeasure;
+  uint32_t bin;
   Perf_Handle_t *pHdl;
 
   StopMeasure = DWT->CYCCNT;
@@ -102,13 +293,24 @@ void  MC_Perf_Measure_Stop (MC_Perf_Handle_t *pHandle, uint8_t  CodeSection)
     pHdl->DeltaTimeInCycle = StopMeasure - pHdl->StartMeasure;
   }
 
-  if( pHandle->BG_Task_OnGoing )
+  /* Only the high frequency task is removed from the background measures, the
+     FOC code sections are nested in it */
+  if( pHandle->BG_Task_OnGoing && ((uint8_t)MEASURE_TSK_HighFrequencyTask == CodeSection) )
   {
     pHandle->AccHighFreqTasksCnt += pHdl->DeltaTimeInCycle;
   }
 
-  if (pHdl->max < pHdl->DeltaTimeInCycle) { pHdl->max = pHdl->DeltaTimeInCycle; }
-  if (pHdl->min > pHdl->DeltaTimeInCycle) { pHdl->min = pHdl->DeltaTimeInCycle; }
+  MC_Perf_UpdateStats(pHdl);
+
+  if (pHdl->DeltaTimeInCycle < MC_PERF_FOC_PERIOD_CYCLES)
+  {
+    bin = (pHdl->DeltaTimeInCycle * MC_PERF_HISTO_SCALE) >> 16;
+  }
+  else
+  {
+    bin = MC_PERF_HISTO_NB_BINS - 1U;
+  }
+  if (pHdl->Histogram[bin] < UINT16_MAX) { pHdl->Histogram[bin]++; }
 
 }
 
@@ -140,9 +342,119 @@ void  MC_BG_Perf_Measure_Stop (MC_Perf_Handle_t *pHandle, uint8_t  CodeSection)
   {
     pHdl->DeltaTimeInCycle -= pHandle->AccHighFreqTasksCnt;
   }
-  if (pHdl->max < pHdl->DeltaTimeInCycle) { pHdl->max = pHdl->DeltaTimeInCycle; }
-  if (pHdl->min > pHdl->DeltaTimeInCycle) { pHdl->min = pHdl->DeltaTimeInCycle; }
+  MC_Perf_UpdateStats(pHdl);
+
+}
+
+/**
+ * @brief  Record the start of a task run by the scheduler. The time elapsed since
+ *         its previous start, minus the period of the task, updates the min and
+ *         max jitter of the task. A start later than two periods is an overrun.
+ * @param  pHandle: handler of the performance measurement component
+ * @param  Task: scheduled task that starts, from MC_PERF_TASKS_LIST_t
+ */
+void  MC_Perf_Task_Start (MC_Perf_Handle_t *pHandle, uint8_t  Task)
+{
+  uint32_t StartMeasure = DWT->CYCCNT;
+  Perf_Jitter_t *pJit = &pHandle->MC_Perf_JitterLog[Task];
+
+  if (pJit->Started)
+  {
+    /* The unsigned difference also holds across an overflow of the cycle counter */
+    uint32_t Elapsed = StartMeasure - pJit->LastStart;
+    int32_t Jitter = (int32_t)(Elapsed - MC_Perf_TaskPeriod[Task]);
 
+    if (pJit->max < Jitter) { pJit->max = Jitter; }
+    if (pJit->min > Jitter) { pJit->min = Jitter; }
+    if ((Elapsed >= (2U * MC_Perf_TaskPeriod[Task])) && (pJit->NbOverruns < UINT16_MAX))
+    {
+      pJit->NbOverruns++;
+    }
+  }
+  pJit->LastStart = StartMeasure;
+  pJit->Started = true;
+}
+
+/**
+ * @brief  Start of a task whose CPU load is measured. The tasks measured that preempt
+ *         it are removed from its load, whatever their nesting.
+ * @param  pHandle: handler of the performance measurement component
+ * @param  Task: task that starts, from MC_PERF_LOADS_LIST_t
+ */
+void  MC_Perf_Load_Start (MC_Perf_Handle_t *pHandle, uint8_t  Task)
+{
+  Perf_Load_t *pLoad = &pHandle->MC_Perf_LoadLog[Task];
+  uint32_t Primask = __get_PRIMASK();
+
+  __disable_irq();
+  pLoad->NestedMark = pHandle->LoadNestedCycles;
+  pLoad->StartMeasure = DWT->CYCCNT;
+  __set_PRIMASK(Primask);
+}
+
+/**
+ * @brief  End of a task whose CPU load is measured: its own execution time is the
+ *         time elapsed since its start minus the own execution times of the tasks
+ *         that ended meanwhile, and is added to the current window.
+ * @param  pHandle: handler of the performance measurement component
+ * @param  Task: task that ends, from MC_PERF_LOADS_LIST_t
+ */
+void  MC_Perf_Load_Stop (MC_Perf_Handle_t *pHandle, uint8_t  Task)
+{
+  Perf_Load_t *pLoad = &pHandle->MC_Perf_LoadLog[Task];
+  uint32_t Primask = __get_PRIMASK();
+  uint32_t OwnCycles;
+
+  __disable_irq();
+  /* The unsigned differences also hold across an overflow of the counters */
+  OwnCycles = (DWT->CYCCNT - pLoad->StartMeasure) - (pHandle->LoadNestedCycles - pLoad->NestedMark);
+  pHandle->LoadNestedCycles += OwnCycles;
+  pLoad->AccCycles += OwnCycles;
+  __set_PRIMASK(Primask);
+}
+
+/**
+ * @brief  Computes the loads of the tasks and the idle time once a window of
+ *         MC_PERF_LOAD_WINDOW_MS has elapsed. To be called periodically, below the
+ *         priority of the high frequency task. A task running at the end of the
+ *         window is counted in the next one.
+ * @param  pHandle: handler of the performance measurement component
+ */
+void  MC_Perf_Load_Update (MC_Perf_Handle_t *pHandle)
+{
+  uint32_t AccCycles[MC_PERF_NB_LOADS];
+  uint32_t Now;
+  uint32_t Elapsed;
+  uint32_t Primask;
+  uint32_t Total = 0;
+  uint32_t Load;
+  uint8_t  i;
+
+  if ((DWT->CYCCNT - pHandle->LoadWindowStart) >= MC_PERF_LOAD_WINDOW_CYCLES)
+  {
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    Now = DWT->CYCCNT;
+    for (i = 0; i<MC_PERF_NB_LOADS; i++) {
+      AccCycles[i] = pHandle->MC_Perf_LoadLog[i].AccCycles;
+      pHandle->MC_Perf_LoadLog[i].AccCycles = 0;
+    }
+    __set_PRIMASK(Primask);
+
+    Elapsed = Now - pHandle->LoadWindowStart;
+    pHandle->LoadWindowStart = Now;
+    for (i = 0; i<MC_PERF_NB_LOADS; i++) {
+      Perf_Load_t *pLoad = &pHandle->MC_Perf_LoadLog[i];
+
+      Load = (uint32_t)(((uint64_t)AccCycles[i] * MC_PERF_LOAD_FULL) / Elapsed);
+      if (Load > MC_PERF_LOAD_FULL) { Load = MC_PERF_LOAD_FULL; }
+      pLoad->load = (uint16_t)Load;
+      if (pLoad->max < pLoad->load) { pLoad->max = pLoad->load; }
+      Total += Load;
+    }
+    pHandle->IdleLoad = (uint16_t)((Total < MC_PERF_LOAD_FULL) ? (MC_PERF_LOAD_FULL - Total) : 0U);
+    if (pHandle->MinIdleLoad > pHandle->IdleLoad) { pHandle->MinIdleLoad = pHandle->IdleLoad; }
+  }
 }
 
 /**
@@ -0,0 +1,378 @@
+/**
+  ******************************************************************************
+  * @file    mc_profile.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Motor and controller parameter sets stored in flash
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "main.h"
+#include "mc_config.h"
+#include "mc_profile.h"
+
+#ifdef MC_PROFILE_MODE
+
+/* Sector 4, 64 KB, in the 512 KB flash of the STM32F401xE, kept out of the image by
+   STM32F401RETX_FLASH.ld */
+#define MC_PROFILE_FLASH_SECTOR     FLASH_SECTOR_4
+#define MC_PROFILE_FLASH_ADDR       0x08010000U
+
+#define MC_PROFILE_MAGIC            0x50524F46U   /* "PROF" */
+#define MC_PROFILE_ERASED           0xFFFFFFFFU
+
+/* Largest divisor of the PI controllers */
+#define MC_PROFILE_MAX_DIV_POW2     15U
+
+/* One record per write, appended to the sector as the offsets of mc_offset_store. The
+   last valid record of each index holds its profile, and the last one flagged as
+   selected the selection. The size is a multiple of the 32-bit programming unit. */
+typedef struct
+{
+  uint32_t wMagic;
+  uint8_t  bIndex;
+  uint8_t  bSelected;               /* 1 if the profile was the selected one */
+  uint16_t hSpare;
+  MC_Profile_t Profile;
+  uint32_t wSpare;
+  uint32_t wCrc;                    /* CRC-32 of the fields above */
+} MC_ProfileRecord_t;
+
+/* Only the beginning of the sector is used, so that the scan stays short. Must be
+   greater than MC_PROFILE_NB_PROFILES: a full sector is erased and written again with
+   the stored profiles */
+#define MC_PROFILE_NB_SLOTS         256U
+
+static MC_Profile_t Profiles[MC_PROFILE_NB_PROFILES];
+static bool Stored[MC_PROFILE_NB_PROFILES];
+static uint8_t bSelected = MC_PROFILE_NONE;
+
+static uint32_t MC_Profile_Crc(const MC_ProfileRecord_t *pRecord)
+{
+  const uint8_t *pData = (const uint8_t *)pRecord;
+  uint32_t wCrc = 0xFFFFFFFFU;
+  uint32_t i;
+  uint8_t bBit;
+
+  for (i = 0U; i < offsetof(MC_ProfileRecord_t, wCrc); i++)
+  {
+    wCrc ^= pData[i];
+    for (bBit = 0U; bBit < 8U; bBit++)
+    {
+      wCrc = ((wCrc & 1U) != 0U) ? ((wCrc >> 1) ^ 0xEDB88320U) : (wCrc >> 1);
+    }
+  }
+  return (~wCrc);
+}
+
+static bool MC_Profile_IsValid(const MC_Profile_t *pProfile)
+{
+  bool bValid = (pProfile->hSpeedKpDivPOW2 <= MC_PROFILE_MAX_DIV_POW2)
+             && (pProfile->hSpeedKiDivPOW2 <= MC_PROFILE_MAX_DIV_POW2)
+             && (pProfile->hIqKpDivPOW2 <= MC_PROFILE_MAX_DIV_POW2)
+             && (pProfile->hIqKiDivPOW2 <= MC_PROFILE_MAX_DIV_POW2)
+             && (pProfile->hIdKpDivPOW2 <= MC_PROFILE_MAX_DIV_POW2)
+             && (pProfile->hIdKiDivPOW2 <= MC_PROFILE_MAX_DIV_POW2)
+             && (pProfile->hMaxSpeedUnit > 0U) && (pProfile->hMinSpeedUnit < 0)
+             && (pProfile->hMaxTorque > 0U) && (pProfile->hMaxTorque <= (uint16_t)INT16_MAX)
+             && (pProfile->hMinTorque < 0);
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  /* The checks of PCC_SetTuning() */
+  bValid = bValid && (pProfile->PCC.hCoefDivisorPOW2 <= PCC_MAX_DIVISOR_POW2)
+                  && (pProfile->PCC.hBemfDivisorPOW2 <= PCC_MAX_DIVISOR_POW2)
+                  && (pProfile->PCC.hNodeBudget > 0U)
+                  && (pProfile->PCC.hDisengageSpeed <= pProfile->PCC.hEngageSpeed);
+#endif
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+  /* Also false for a NaN */
+  bValid = bValid && (pProfile->bMpcHorizon > 0U) && (pProfile->bMpcHorizon <= (uint8_t)SMPC_MAX_HORIZON)
+                  && (pProfile->fMpcMoveWeight >= 0.0f) && (pProfile->fMpcTorqueTerm > 0.0f);
+#endif
+  return (bValid);
+}
+
+/* Writes the parameters of a profile in the components. The predictor and the
+   controllers are not running */
+static void MC_Profile_Apply(const MC_Profile_t *pProfile)
+{
+  PID_SetKP(&PIDSpeedHandle_M1, pProfile->hSpeedKp);
+  PID_SetKI(&PIDSpeedHandle_M1, pProfile->hSpeedKi);
+  PID_SetKPDivisorPOW2(&PIDSpeedHandle_M1, pProfile->hSpeedKpDivPOW2);
+  PID_SetKIDivisorPOW2(&PIDSpeedHandle_M1, pProfile->hSpeedKiDivPOW2);
+  PID_SetKP(&PIDIqHandle_M1, pProfile->hIqKp);
+  PID_SetKI(&PIDIqHandle_M1, pProfile->hIqKi);
+  PID_SetKPDivisorPOW2(&PIDIqHandle_M1, pProfile->hIqKpDivPOW2);
+  PID_SetKIDivisorPOW2(&PIDIqHandle_M1, pProfile->hIqKiDivPOW2);
+  PID_SetKP(&PIDIdHandle_M1, pProfile->hIdKp);
+  PID_SetKI(&PIDIdHandle_M1, pProfile->hIdKi);
+  PID_SetKPDivisorPOW2(&PIDIdHandle_M1, pProfile->hIdKpDivPOW2);
+  PID_SetKIDivisorPOW2(&PIDIdHandle_M1, pProfile->hIdKiDivPOW2);
+
+  /* The output of the speed PI is bounded by the q current limits, as in mc_config.c */
+  PID_SetUpperOutputLimit(&PIDSpeedHandle_M1, (int16_t)pProfile->hMaxTorque);
+  PID_SetLowerOutputLimit(&PIDSpeedHandle_M1, pProfile->hMinTorque);
+  PID_SetUpperIntegralTermLimit(&PIDSpeedHandle_M1,
+                                (int32_t)pProfile->hMaxTorque * (int32_t)PID_GetKIDivisor(&PIDSpeedHandle_M1));
+  PID_SetLowerIntegralTermLimit(&PIDSpeedHandle_M1,
+                                (int32_t)pProfile->hMinTorque * (int32_t)PID_GetKIDivisor(&PIDSpeedHandle_M1));
+  SpeednTorqCtrlM1.MaxAppPositiveMecSpeedUnit = pProfile->hMaxSpeedUnit;
+  SpeednTorqCtrlM1.MinAppNegativeMecSpeedUnit = pProfile->hMinSpeedUnit;
+  SpeednTorqCtrlM1.MaxPositiveTorque = pProfile->hMaxTorque;
+  SpeednTorqCtrlM1.MinNegativeTorque = pProfile->hMinTorque;
+
+  STO_PLL_SetObserverGains(&STO_PLL_M1, pProfile->hPllC1, pProfile->hPllC2);
+  STO_SetPLLGains(&STO_PLL_M1, pProfile->hPllKp, pProfile->hPllKi);
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  if (true == PCC_SetTuning(pPCC[M1], &pProfile->PCC))
+  {
+    PCC_ApplyTuning(pPCC[M1]);
+#ifdef PCC_MODEL_ESTIMATION
+    /* The model of the profile becomes the nominal model of the estimator */
+    PCC_EST_Init(pPCCEst[M1], pPCC[M1]);
+#endif
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+  pSMPC[M1]->bHorizon = pProfile->bMpcHorizon;
+  pSMPC[M1]->fMoveWeight = pProfile->fMpcMoveWeight;
+  pSMPC[M1]->fTorqueTermNom = pProfile->fMpcTorqueTerm;
+  SMPC_Init(pSMPC[M1]);
+#endif
+}
+
+/* Returns the first free slot of the sector, MC_PROFILE_NB_SLOTS if it is full. With
+   bRead, the last valid record of each index and the selected index are read as well */
+static uint32_t MC_Profile_Scan(bool bRead)
+{
+  const MC_ProfileRecord_t *pRecords = (const MC_ProfileRecord_t *)MC_PROFILE_FLASH_ADDR;
+  uint32_t i = 0U;
+
+  while ((i < MC_PROFILE_NB_SLOTS) && (pRecords[i].wMagic != MC_PROFILE_ERASED))
+  {
+    /* A record interrupted by a reset fails its CRC and is skipped */
+    if ((true == bRead) && (MC_PROFILE_MAGIC == pRecords[i].wMagic)
+        && (pRecords[i].bIndex < MC_PROFILE_NB_PROFILES) && (MC_Profile_Crc(&pRecords[i]) == pRecords[i].wCrc))
+    {
+      Profiles[pRecords[i].bIndex] = pRecords[i].Profile;
+      Stored[pRecords[i].bIndex] = true;
+      if (pRecords[i].bSelected != 0U)
+      {
+        bSelected = pRecords[i].bIndex;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    i++;
+  }
+  return (i);
+}
+
+static void MC_Profile_Program(uint32_t wSlot, uint8_t bIndex)
+{
+  MC_ProfileRecord_t Record;
+  uint32_t Words[sizeof(MC_ProfileRecord_t) / sizeof(uint32_t)];
+  uint32_t wAddress = MC_PROFILE_FLASH_ADDR + (wSlot * sizeof(MC_ProfileRecord_t));
+  uint32_t i;
+
+  (void)memset(&Record, 0xFF, sizeof(Record));
+  Record.wMagic = MC_PROFILE_MAGIC;
+  Record.bIndex = bIndex;
+  Record.bSelected = (bIndex == bSelected) ? 1U : 0U;
+  Record.Profile = Profiles[bIndex];
+  Record.wCrc = MC_Profile_Crc(&Record);
+  (void)memcpy(Words, &Record, sizeof(Record));
+
+  for (i = 0U; i < (sizeof(MC_ProfileRecord_t) / sizeof(uint32_t)); i++)
+  {
+    (void)HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, wAddress + (i * sizeof(uint32_t)), Words[i]);
+  }
+}
+
+/* Appends the record of a profile. A full sector is erased, in around one second,
+   and the other stored profiles are written again first */
+static void MC_Profile_Write(uint8_t bIndex)
+{
+  uint32_t wFreeSlot = MC_Profile_Scan(false);
+  uint8_t i;
+
+  HAL_FLASH_Unlock();
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR
+                         | FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+  if (wFreeSlot >= MC_PROFILE_NB_SLOTS)
+  {
+    FLASH_EraseInitTypeDef Erase;
+    uint32_t wSectorError;
+
+    Erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    Erase.Sector = MC_PROFILE_FLASH_SECTOR;
+    Erase.NbSectors = 1U;
+    Erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    (void)HAL_FLASHEx_Erase(&Erase, &wSectorError);
+    wFreeSlot = 0U;
+    for (i = 0U; i < MC_PROFILE_NB_PROFILES; i++)
+    {
+      if ((i != bIndex) && (true == Stored[i]))
+      {
+        MC_Profile_Program(wFreeSlot, i);
+        wFreeSlot++;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  MC_Profile_Program(wFreeSlot, bIndex);
+  HAL_FLASH_Lock();
+}
+
+/**
+ * @brief  Reads the profiles stored in flash and applies the selected one, if any. To
+ *         be called once the components are initialized.
+ */
+void MC_Profile_Init(void)
+{
+  (void)MC_Profile_Scan(true);
+  if (bSelected != MC_PROFILE_NONE)
+  {
+    MC_Profile_Apply(&Profiles[bSelected]);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+ * @brief  Reads the parameters in use, that a profile can be made of
+ */
+void MC_Profile_Capture(MC_Profile_t *pProfile)
+{
+  (void)memset(pProfile, 0, sizeof(MC_Profile_t));
+  pProfile->hSpeedKp = PID_GetKP(&PIDSpeedHandle_M1);
+  pProfile->hSpeedKi = PID_GetKI(&PIDSpeedHandle_M1);
+  pProfile->hIqKp = PID_GetKP(&PIDIqHandle_M1);
+  pProfile->hIqKi = PID_GetKI(&PIDIqHandle_M1);
+  pProfile->hIdKp = PID_GetKP(&PIDIdHandle_M1);
+  pProfile->hIdKi = PID_GetKI(&PIDIdHandle_M1);
+  pProfile->hSpeedKpDivPOW2 = PID_GetKPDivisorPOW2(&PIDSpeedHandle_M1);
+  pProfile->hSpeedKiDivPOW2 = PID_GetKIDivisorPOW2(&PIDSpeedHandle_M1);
+  pProfile->hIqKpDivPOW2 = PID_GetKPDivisorPOW2(&PIDIqHandle_M1);
+  pProfile->hIqKiDivPOW2 = PID_GetKIDivisorPOW2(&PIDIqHandle_M1);
+  pProfile->hIdKpDivPOW2 = PID_GetKPDivisorPOW2(&PIDIdHandle_M1);
+  pProfile->hIdKiDivPOW2 = PID_GetKIDivisorPOW2(&PIDIdHandle_M1);
+  STO_PLL_GetObserverGains(&STO_PLL_M1, &pProfile->hPllC1, &pProfile->hPllC2);
+  STO_GetPLLGains(&STO_PLL_M1, &pProfile->hPllKp, &pProfile->hPllKi);
+  pProfile->hMaxSpeedUnit = STC_GetMaxAppPositiveMecSpeedUnit(&SpeednTorqCtrlM1);
+  pProfile->hMinSpeedUnit = STC_GetMinAppNegativeMecSpeedUnit(&SpeednTorqCtrlM1);
+  pProfile->hMaxTorque = SpeednTorqCtrlM1.MaxPositiveTorque;
+  pProfile->hMinTorque = SpeednTorqCtrlM1.MinNegativeTorque;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  PCC_GetTuning(pPCC[M1], &pProfile->PCC);
+#endif
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+  pProfile->fMpcMoveWeight = pSMPC[M1]->fMoveWeight;
+  pProfile->fMpcTorqueTerm = pSMPC[M1]->fTorqueTermNom;
+  pProfile->bMpcHorizon = pSMPC[M1]->bHorizon;
+#endif
+}
+
+/**
+ * @brief  True if a profile is stored at this index
+ */
+bool MC_Profile_IsStored(uint8_t bIndex)
+{
+  return ((bIndex < MC_PROFILE_NB_PROFILES) && (true == Stored[bIndex]));
+}
+
+/**
+ * @brief  Stores a profile in flash, unless it is equal to the stored one. The stored
+ *         profile of the same index, if any, is replaced. The profile is not applied,
+ *         even if it is the selected one. The flash is not readable while it is
+ *         written: it must be called in the IDLE state.
+ * @retval bool False if the index is out of range or a parameter is out of the range
+ *         of its component
+ */
+bool MC_Profile_Store(uint8_t bIndex, const MC_Profile_t *pProfile)
+{
+  bool bValid = (bIndex < MC_PROFILE_NB_PROFILES) && (true == MC_Profile_IsValid(pProfile));
+
+  if ((true == bValid)
+      && ((false == Stored[bIndex]) || (0 != memcmp(&Profiles[bIndex], pProfile, sizeof(MC_Profile_t)))))
+  {
+    Profiles[bIndex] = *pProfile;
+    Stored[bIndex] = true;
+    MC_Profile_Write(bIndex);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bValid);
+}
+
+/**
+ * @brief  Applies a stored profile and records the selection in flash, if it changes.
+ *         Called by the medium frequency task in the IDLE state, the PWM being off.
+ */
+void MC_Profile_Select(uint8_t bIndex)
+{
+  if (true == MC_Profile_IsStored(bIndex))
+  {
+    MC_Profile_Apply(&Profiles[bIndex]);
+    if (bIndex != bSelected)
+    {
+      bSelected = bIndex;
+      MC_Profile_Write(bIndex);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+ * @brief  Selected profile, MC_PROFILE_NONE if the drive runs with the parameters of
+ *         the build
+ */
+uint8_t MC_Profile_GetSelected(void)
+{
+  return (bSelected);
+}
+
+#endif /* MC_PROFILE_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    mc_pwm_dither.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Dithering of the PWM carrier frequency
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "mc_config.h"
+#include "mc_pwm_dither.h"
+
+#ifdef MC_PWM_DITHER_MODE
+
+#ifdef MC_PWM_SYNC_MODE
+#error "MC_PWM_DITHER_MODE and MC_PWM_SYNC_MODE both write the auto reload of TIM1"
+#endif
+
+#define MC_PWM_DITHER_HALF_PERIOD ((uint32_t)PWM_PERIOD_CYCLES / 2U)
+
+/* Taps of the maximal length 16-bit Galois LFSR, x^16 + x^14 + x^13 + x^11 + 1 */
+#define MC_PWM_DITHER_TAPS      0xB400U
+#define MC_PWM_DITHER_SEED      0xACE1U
+
+static uint16_t hLfsr;
+
+/**
+  * @brief  Seeds the sequence and enables the preload of the auto reload of TIM1, that
+  *         is then written at any time. To be called once the timers are started.
+  */
+void MC_PwmDither_Init(void)
+{
+  hLfsr = MC_PWM_DITHER_SEED;
+  LL_TIM_EnableARRPreload(TIM1);
+}
+
+/**
+  * @brief  Draws the auto reload of the next PWM period. To be called by the high
+  *         frequency task with the duty cycles of the space vector modulation.
+  */
+void MC_PwmDither_Next(void)
+{
+  hLfsr = ((hLfsr & 1U) != 0U) ? (uint16_t)((hLfsr >> 1) ^ MC_PWM_DITHER_TAPS) : (uint16_t)(hLfsr >> 1);
+  /* Uniform in [0, MC_PWM_DITHER_SPAN] */
+  LL_TIM_SetAutoReload(TIM1, MC_PWM_DITHER_HALF_PERIOD
+                             + (((uint32_t)hLfsr * (MC_PWM_DITHER_SPAN + 1U)) >> 16U));
+}
+
+/**
+  * @brief  Restores the nominal auto reload from the next PWM period
+  */
+void MC_PwmDither_Stop(void)
+{
+  LL_TIM_SetAutoReload(TIM1, MC_PWM_DITHER_HALF_PERIOD);
+}
+
+#endif /* MC_PWM_DITHER_MODE */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file    mc_ram_budget.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Footprint of the buffers of the MCP link and of the captures, checked
+  *          against their RAM budget
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "parameters_conversion.h"
+#include "mc_math.h"
+#include "aspep.h" /* Sizes of the ASPEP buffers */
+#include "mc_ram_budget.h"
+#ifdef MC_CAPTURE_MODE
+#include "mc_capture.h"
+#endif
+#ifdef MC_RECORD_MODE
+#include "mc_record.h"
+#endif
+#ifdef MC_SPECTRUM_MODE
+#include "mc_spectrum.h"
+#endif
+#ifdef MC_FAULTLOG_MODE
+#include "mc_faultlog.h"
+#endif
+
+/* The sizes below are the ones of the buffers declared by each feature */
+
+/* MCPSyncTxBuff, MCPSyncRXBuff and MCPAsyncBuffUARTA of mcp_config.c */
+#define MC_RAM_ASPEP_BYTES    ((ASPEP_SYNC_NB_BUFFERS * (MCP_TX_SYNCBUFFER_SIZE + MCP_RX_SYNCBUFFER_SIZE)) \
+                               + (ASPEP_ASYNC_NB_BUFFERS * MCP_TX_ASYNCBUFFER_SIZE_A))
+
+/* dataPtrTableA, dataPtrTableBuffA, dataSizeTableA, dataSizeTableBuffA and HFLastTableA */
+#define MC_RAM_MCPA_BYTES     ((uint32_t)MCPA_OVER_UARTA_STREAM * ((2U * sizeof(void *)) \
+                               + (2U * sizeof(uint8_t)) + sizeof(int16_t)))
+
+/* CaptureRing */
+#ifdef MC_CAPTURE_MODE
+#define MC_RAM_CAPTURE_BYTES  (MC_CAPTURE_DEPTH * MC_CAPTURE_NB_CHANNELS * sizeof(int16_t))
+#else
+#define MC_RAM_CAPTURE_BYTES  0U
+#endif
+
+/* RecordFrames */
+#ifdef MC_RECORD_MODE
+#define MC_RAM_RECORD_BYTES   (MC_RECORD_DEPTH * sizeof(MC_Record_Frame_t))
+#else
+#define MC_RAM_RECORD_BYTES   0U
+#endif
+
+/* SpectrumSamples, SpectrumRe, SpectrumIm and SpectrumTwiddle */
+#ifdef MC_SPECTRUM_MODE
+#define MC_RAM_SPECTRUM_BYTES (MC_SPECTRUM_SIZE * (sizeof(int16_t) + (2U * sizeof(int32_t))) \
+                               + ((MC_SPECTRUM_SIZE / 2U) * sizeof(Trig_Components)))
+#else
+#define MC_RAM_SPECTRUM_BYTES 0U
+#endif
+
+/* Ring of snapshots and PendingEntry */
+#ifdef MC_FAULTLOG_MODE
+#define MC_RAM_FAULTLOG_BYTES ((MC_FAULTLOG_DEPTH * sizeof(MC_FaultLog_Snapshot_t)) + sizeof(MC_FaultLog_Entry_t))
+#else
+#define MC_RAM_FAULTLOG_BYTES 0U
+#endif
+
+#define MC_RAM_TOTAL_BYTES    (MC_RAM_ASPEP_BYTES + MC_RAM_MCPA_BYTES + MC_RAM_CAPTURE_BYTES \
+                               + MC_RAM_RECORD_BYTES + MC_RAM_SPECTRUM_BYTES + MC_RAM_FAULTLOG_BYTES)
+
+_Static_assert(MC_RAM_TOTAL_BYTES <= MC_RAM_BUDGET,
+               "The buffers of the link and of the captures exceed MC_RAM_BUDGET, see mc_ram_budget.h");
+
+const MC_RAM_Report_t MC_RamReport =
+{
+  .wBudget = MC_RAM_BUDGET,
+  .wTotal = MC_RAM_TOTAL_BYTES,
+  .wFeature =
+  {
+    [MC_RAM_ASPEP] = MC_RAM_ASPEP_BYTES,
+    [MC_RAM_MCPA] = MC_RAM_MCPA_BYTES,
+    [MC_RAM_CAPTURE] = MC_RAM_CAPTURE_BYTES,
+    [MC_RAM_RECORD] = MC_RAM_RECORD_BYTES,
+    [MC_RAM_SPECTRUM] = MC_RAM_SPECTRUM_BYTES,
+    [MC_RAM_FAULTLOG] = MC_RAM_FAULTLOG_BYTES,
+  },
+};
+
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
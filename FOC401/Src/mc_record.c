@@ -0,0 +1,160 @@
+/**
+  ******************************************************************************
+  * @file    mc_record.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Record of the inputs and outputs of the current controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "mc_record.h"
+
+#ifdef MC_RECORD_MODE
+
+static MC_Record_Frame_t RecordFrames[MC_RECORD_DEPTH];
+static volatile MC_Record_State_t RecordState = MC_RECORD_IDLE;
+static uint16_t hRecordLength;    /* Frames written since the start of the record */
+static uint16_t hRecordRead;      /* Next frame read by MC_Record_Read */
+
+/**
+ * @brief  Executes a MC_RECORD_CMD_xxx command.
+ * @retval bool False if the command is unknown
+ */
+bool MC_Record_Command(uint8_t bCmd)
+{
+  bool bDone = true;
+
+  switch (bCmd)
+  {
+    case MC_RECORD_CMD_STOP:
+    {
+      RecordState = MC_RECORD_IDLE;
+      break;
+    }
+
+    case MC_RECORD_CMD_ARM:
+    {
+      RecordState = MC_RECORD_IDLE;
+      hRecordLength = 0U;
+      hRecordRead = 0U;
+      RecordState = MC_RECORD_ARMED;
+      break;
+    }
+
+    default:
+    {
+      bDone = false;
+      break;
+    }
+  }
+  return (bDone);
+}
+
+/**
+ * @brief  Starts an armed record, or ends a running one. Called by FOC_Clear(), while
+ *         the current controller is not running.
+ */
+void MC_Record_Clear(void)
+{
+  if (MC_RECORD_ARMED == RecordState)
+  {
+    RecordState = MC_RECORD_RECORDING;
+  }
+  else if ((MC_RECORD_RECORDING == RecordState) && (hRecordLength > 0U))
+  {
+    /* The next periods start from another cleared state */
+    RecordState = MC_RECORD_DONE;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+MC_Record_State_t MC_Record_GetState(void)
+{
+  return (RecordState);
+}
+
+/**
+ * @brief  Writes the frame of the period. It must be called by FOC_CurrControllerM1
+ *         in the MC_RECORD_RECORDING state only.
+ */
+void MC_Record_Write(const MC_Record_Frame_t *pFrame)
+{
+  RecordFrames[hRecordLength] = *pFrame;
+  hRecordLength++;
+  if (hRecordLength >= MC_RECORD_DEPTH)
+  {
+    RecordState = MC_RECORD_DONE;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+ * @brief  Number of frames of the record
+ */
+uint16_t MC_Record_GetLength(void)
+{
+  return (hRecordLength);
+}
+
+/**
+ * @brief  Sets the first frame read by the next MC_Record_Read. The first frame of
+ *         the record is the first period after the clear of the controllers.
+ */
+void MC_Record_SetReadIndex(uint16_t hIndex)
+{
+  hRecordRead = (hIndex < MC_RECORD_DEPTH) ? hIndex : MC_RECORD_DEPTH;
+}
+
+uint16_t MC_Record_GetReadIndex(void)
+{
+  return (hRecordRead);
+}
+
+/**
+ * @brief  Copies the frames of the frozen record from the read index on, and moves
+ *         the read index after them.
+ * @param  pFrames: receives the frames
+ * @param  hMaxFrames: largest number of frames copied
+ * @retval uint16_t Number of frames copied, 0 if the record is not done
+ */
+uint16_t MC_Record_Read(MC_Record_Frame_t *pFrames, uint16_t hMaxFrames)
+{
+  uint16_t hNbFrames = 0U;
+  uint16_t i;
+
+  if ((MC_RECORD_DONE == RecordState) && (hRecordRead < hRecordLength))
+  {
+    hNbFrames = hRecordLength - hRecordRead;
+    hNbFrames = (hNbFrames < hMaxFrames) ? hNbFrames : hMaxFrames;
+    for (i = 0U; i < hNbFrames; i++)
+    {
+      pFrames[i] = RecordFrames[hRecordRead + i];
+    }
+    hRecordRead += hNbFrames;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (hNbFrames);
+}
+
+#endif /* MC_RECORD_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,334 @@
+/**
+  ******************************************************************************
+  * @file    mc_spectrum.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Spectrum of the phase current, distortion and ripple monitoring
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "mc_math.h"
+#include "parameters_conversion.h"
+#include "mc_spectrum.h"
+
+#ifdef MC_SPECTRUM_MODE
+
+#define MC_SPECTRUM_HALF        (MC_SPECTRUM_SIZE / 2U)
+/* Angle of the Trig functions for one bin, 2^16 per turn */
+#define MC_SPECTRUM_ANGLE_SHIFT (16U - MC_SPECTRUM_SIZE_LOG)
+/* FOC periods per spectrum, the bin width is TF_REGULATION_RATE divided by it */
+#define MC_SPECTRUM_PERIODS     (MC_SPECTRUM_DECIMATION * MC_SPECTRUM_SIZE)
+
+/* Samples of the high frequency task */
+static int16_t SpectrumSamples[MC_SPECTRUM_SIZE];
+/* True once the buffer is full, until the main loop has copied it */
+static volatile bool SpectrumReady = false;
+static uint16_t hSpectrumFill;     /* Samples in the buffer */
+static uint16_t hSpectrumDecim;    /* FOC periods since the last sample */
+
+/* Work buffers of the main loop */
+static int32_t SpectrumRe[MC_SPECTRUM_SIZE];
+static int32_t SpectrumIm[MC_SPECTRUM_SIZE];
+static Trig_Components SpectrumTwiddle[MC_SPECTRUM_HALF];
+static bool SpectrumTwiddleValid = false;
+static MC_Spectrum_Result_t SpectrumResult;
+
+static uint32_t MC_Spectrum_Sqrt(uint64_t dValue)
+{
+  uint64_t dRoot = 0U;
+  uint64_t dBit = (uint64_t)1 << 62;
+  uint64_t dRest = dValue;
+
+  while (dBit > dRest)
+  {
+    dBit >>= 2;
+  }
+  while (dBit != 0U)
+  {
+    if (dRest >= (dRoot + dBit))
+    {
+      dRest -= dRoot + dBit;
+      dRoot = (dRoot >> 1) + dBit;
+    }
+    else
+    {
+      dRoot >>= 1;
+    }
+    dBit >>= 2;
+  }
+  return ((uint32_t)dRoot);
+}
+
+static uint16_t MC_Spectrum_Amplitude(uint64_t dPower)
+{
+  /* A sine of amplitude A gives a bin of N.A/4 with the Hann window */
+  uint32_t wAmplitude = (MC_Spectrum_Sqrt(dPower) * 4U) >> MC_SPECTRUM_SIZE_LOG;
+
+  return ((wAmplitude < UINT16_MAX) ? (uint16_t)wAmplitude : UINT16_MAX);
+}
+
+static uint16_t MC_Spectrum_Freq(uint16_t hBin)
+{
+  return ((uint16_t)((((uint32_t)hBin * TF_REGULATION_RATE) + (MC_SPECTRUM_PERIODS / 2U)) / MC_SPECTRUM_PERIODS));
+}
+
+/* Radix 2 decimation in time, in place. A stage doubles the magnitude at most, the
+   16 bits samples fit in 16 + MC_SPECTRUM_SIZE_LOG bits at the end. */
+static void MC_Spectrum_Fft(void)
+{
+  uint16_t i;
+  uint16_t j = 0U;
+  uint16_t hLength;
+
+  for (i = 0U; i < (MC_SPECTRUM_SIZE - 1U); i++)
+  {
+    uint16_t hBit = MC_SPECTRUM_HALF;
+
+    if (i < j)
+    {
+      int32_t wSwap = SpectrumRe[i];
+      SpectrumRe[i] = SpectrumRe[j];
+      SpectrumRe[j] = wSwap;
+      wSwap = SpectrumIm[i];
+      SpectrumIm[i] = SpectrumIm[j];
+      SpectrumIm[j] = wSwap;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    while ((j & hBit) != 0U)
+    {
+      j &= ~hBit;
+      hBit >>= 1;
+    }
+    j |= hBit;
+  }
+
+  for (hLength = 2U; hLength <= MC_SPECTRUM_SIZE; hLength <<= 1)
+  {
+    uint16_t hHalf = hLength / 2U;
+    uint16_t hStride = MC_SPECTRUM_SIZE / hLength;
+    uint16_t hStart;
+
+    for (hStart = 0U; hStart < MC_SPECTRUM_SIZE; hStart += hLength)
+    {
+      for (i = 0U; i < hHalf; i++)
+      {
+        /* Multiplied by exp(-j.2.pi.k/N) */
+        Trig_Components W = SpectrumTwiddle[i * hStride];
+        uint16_t a = hStart + i;
+        uint16_t b = a + hHalf;
+        int32_t wTr = (int32_t)((((int64_t)SpectrumRe[b] * W.hCos) + ((int64_t)SpectrumIm[b] * W.hSin)) >> 15);
+        int32_t wTi = (int32_t)((((int64_t)SpectrumIm[b] * W.hCos) - ((int64_t)SpectrumRe[b] * W.hSin)) >> 15);
+
+        SpectrumRe[b] = SpectrumRe[a] - wTr;
+        SpectrumIm[b] = SpectrumIm[a] - wTi;
+        SpectrumRe[a] += wTr;
+        SpectrumIm[a] += wTi;
+      }
+    }
+  }
+}
+
+/**
+ * @brief  Keeps one phase current sample out of MC_SPECTRUM_DECIMATION while the
+ *         buffer is not full. It must be called once per FOC period by the high
+ *         frequency task.
+ * @param  hIa: phase a current, in s16A
+ * @param  Running: true while the drive is in RUN, the buffer restarts otherwise
+ */
+void MC_Spectrum_Sample(int16_t hIa, bool Running)
+{
+  if (true == SpectrumReady)
+  {
+    /* Nothing to do */
+  }
+  else if (false == Running)
+  {
+    hSpectrumFill = 0U;
+    hSpectrumDecim = 0U;
+  }
+  else
+  {
+    hSpectrumDecim++;
+    if (hSpectrumDecim >= MC_SPECTRUM_DECIMATION)
+    {
+      hSpectrumDecim = 0U;
+      SpectrumSamples[hSpectrumFill] = hIa;
+      hSpectrumFill++;
+      if (hSpectrumFill >= MC_SPECTRUM_SIZE)
+      {
+        hSpectrumFill = 0U;
+        SpectrumReady = true;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+}
+
+/**
+ * @brief  Computes the spectrum of a full buffer and updates the result. It must be
+ *         called from the main loop, it returns at once when no buffer is full.
+ */
+void MC_Spectrum_Process(void)
+{
+  if (true == SpectrumReady)
+  {
+    uint64_t dPower[MC_SPECTRUM_HALF];
+    uint64_t dFund = 0U;
+    uint64_t dOther = 0U;
+    int32_t wMean = 0;
+    uint16_t hFund = 2U;
+    uint16_t i;
+    uint8_t j;
+
+    if (false == SpectrumTwiddleValid)
+    {
+      for (i = 0U; i < MC_SPECTRUM_HALF; i++)
+      {
+        SpectrumTwiddle[i] = MCM_Trig_Functions((int16_t)(i << MC_SPECTRUM_ANGLE_SHIFT));
+      }
+      SpectrumTwiddleValid = true;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    for (i = 0U; i < MC_SPECTRUM_SIZE; i++)
+    {
+      wMean += SpectrumSamples[i];
+    }
+    wMean /= (int32_t)MC_SPECTRUM_SIZE;
+    for (i = 0U; i < MC_SPECTRUM_SIZE; i++)
+    {
+      /* Hann window, 0.5 - 0.5.cos(2.pi.n/N) */
+      Trig_Components Trig = MCM_Trig_Functions((int16_t)(i << MC_SPECTRUM_ANGLE_SHIFT));
+      int32_t wWindow = (INT16_MAX - (int32_t)Trig.hCos) / 2;
+
+      SpectrumRe[i] = (int32_t)(((int64_t)(SpectrumSamples[i] - wMean) * wWindow) >> 15);
+      SpectrumIm[i] = 0;
+    }
+    /* The high frequency task fills the next buffer meanwhile */
+    SpectrumReady = false;
+
+    MC_Spectrum_Fft();
+
+    for (i = 0U; i < MC_SPECTRUM_HALF; i++)
+    {
+      dPower[i] = (uint64_t)((int64_t)SpectrumRe[i] * SpectrumRe[i])
+                + (uint64_t)((int64_t)SpectrumIm[i] * SpectrumIm[i]);
+      /* The mean and the leak of its window are not part of the signal */
+      if ((i >= 2U) && (dPower[i] > dPower[hFund]))
+      {
+        hFund = i;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+
+    for (j = 0U; j < MC_SPECTRUM_NB_PEAKS; j++)
+    {
+      SpectrumResult.Peaks[j].hFreq_Hz = 0U;
+      SpectrumResult.Peaks[j].hAmplitude = 0U;
+    }
+    for (i = 2U; i < MC_SPECTRUM_HALF; i++)
+    {
+      if (((i + MC_SPECTRUM_FUND_BINS) >= hFund) && (i <= (hFund + MC_SPECTRUM_FUND_BINS)))
+      {
+        dFund += dPower[i];
+      }
+      else
+      {
+        uint16_t hAmplitude = MC_Spectrum_Amplitude(dPower[i]);
+
+        dOther += dPower[i];
+        /* A ripple line spreads over three bins: only its center is a peak */
+        if ((dPower[i] >= dPower[i - 1U])
+            && ((i == (MC_SPECTRUM_HALF - 1U)) || (dPower[i] > dPower[i + 1U])))
+        {
+          for (j = MC_SPECTRUM_NB_PEAKS; (j > 0U) && (hAmplitude > SpectrumResult.Peaks[j - 1U].hAmplitude); j--)
+          {
+            if (j < MC_SPECTRUM_NB_PEAKS)
+            {
+              SpectrumResult.Peaks[j] = SpectrumResult.Peaks[j - 1U];
+            }
+            else
+            {
+              /* The smallest peak leaves the list */
+            }
+          }
+          if (j < MC_SPECTRUM_NB_PEAKS)
+          {
+            SpectrumResult.Peaks[j].hFreq_Hz = MC_Spectrum_Freq(i);
+            SpectrumResult.Peaks[j].hAmplitude = hAmplitude;
+          }
+          else
+          {
+            /* Nothing to do */
+          }
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+      }
+    }
+
+    SpectrumResult.Fundamental.hFreq_Hz = MC_Spectrum_Freq(hFund);
+    SpectrumResult.Fundamental.hAmplitude = MC_Spectrum_Amplitude(dPower[hFund]);
+    while (dOther > (UINT64_MAX / 1000000U))
+    {
+      dOther >>= 2;
+      dFund >>= 2;
+    }
+    if (0U == dFund)
+    {
+      SpectrumResult.hThd = UINT16_MAX;
+    }
+    else
+    {
+      uint32_t wThd = MC_Spectrum_Sqrt((dOther * 1000000U) / dFund);
+      SpectrumResult.hThd = (wThd < UINT16_MAX) ? (uint16_t)wThd : UINT16_MAX;
+    }
+    SpectrumResult.hCount++;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+uint16_t MC_Spectrum_GetThd(void)
+{
+  return (SpectrumResult.hThd);
+}
+
+void MC_Spectrum_GetResult(MC_Spectrum_Result_t *pResult)
+{
+  *pResult = SpectrumResult;
+}
+
+#endif /* MC_SPECTRUM_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,120 @@
+/**
+  ******************************************************************************
+  * @file    mc_state_stats.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Residence time and transitions of the states of the drive
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "parameters_conversion.h"
+#include "mc_state_stats.h"
+
+#ifdef MC_STATE_STATS_MODE
+
+_Static_assert((sizeof(MC_StateStats_t) + 2U) <= MCP_TX_SYNC_PAYLOAD_MAX, "MC_REG_STATE_STATS exceeds the MCP payload");
+
+static MC_StateStats_t Stats;
+static uint32_t wTicks;             /* Periods since the reset */
+static uint32_t wEntryTick;         /* Period of the entry in the current state */
+static uint32_t wStartTick;         /* Period of the last exit of IDLE */
+static volatile bool ResetPending;  /* Reset requested by the register interface */
+
+static uint16_t MC_StateStats_Sat(uint32_t wValue)
+{
+  return ((wValue > (uint32_t)UINT16_MAX) ? UINT16_MAX : (uint16_t)wValue);
+}
+
+/**
+ * @brief  Clears the statistics, the current state counting as entered once
+ */
+void MC_StateStats_Init(MCI_State_t State)
+{
+  (void)memset(&Stats, 0, sizeof(MC_StateStats_t));
+  Stats.hTickRate = MEDIUM_FREQUENCY_TASK_RATE;
+  Stats.bState = (uint8_t)State;
+  Stats.bPrevState = (uint8_t)State;
+  Stats.States[State].hEntries = 1U;
+  wTicks = 0U;
+  wEntryTick = 0U;
+  wStartTick = 0U;
+  ResetPending = false;
+}
+
+/**
+ * @brief  Counts the period in the state. It must be called by the medium frequency
+ *         task, once per period, with the state before the state machine runs.
+ */
+void MC_StateStats_Exec(MCI_State_t State)
+{
+  uint8_t bState = (uint8_t)State;
+  MC_StateStats_Entry_t *pEntry;
+
+  if (true == ResetPending)
+  {
+    MC_StateStats_Init(State);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  wTicks++;
+  if ((bState != Stats.bState) && (bState < MC_STATE_STATS_NB_STATES))
+  {
+    Stats.States[Stats.bState].hLastTicks = MC_StateStats_Sat(wTicks - wEntryTick);
+    if ((uint8_t)IDLE == Stats.bState)
+    {
+      wStartTick = wTicks;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    Stats.wTransitions++;
+    Stats.bPrevState = Stats.bState;
+    Stats.bState = bState;
+    wEntryTick = wTicks;
+
+    pEntry = &Stats.States[bState];
+    pEntry->hEntries = (pEntry->hEntries < UINT16_MAX) ? (pEntry->hEntries + 1U) : UINT16_MAX;
+    Stats.hSinceStart[bState] = MC_StateStats_Sat(wTicks - wStartTick);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  Stats.States[Stats.bState].wTotalTicks++;
+}
+
+/**
+ * @brief  Requests the reset of the statistics, done by the next MC_StateStats_Exec
+ */
+void MC_StateStats_Reset(void)
+{
+  ResetPending = true;
+}
+
+/**
+ * @brief  Copies the statistics. The medium frequency task may preempt the copy: the
+ *         counters of the current state can then be one period apart.
+ */
+void MC_StateStats_Get(MC_StateStats_t *pStats)
+{
+  *pStats = Stats;
+}
+
+#endif /* MC_STATE_STATS_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
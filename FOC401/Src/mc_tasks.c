@@ -32,8 +32,78 @@
 #include "pwm_common.h"
 
 #include "mc_tasks.h"
+#include "mc_trace.h"
 #include "parameters_conversion.h"
 #include "mcp_config.h"
+#ifdef MC_BENCH_MODE
+#include "mc_bench.h"
+#endif
+#ifdef MC_CAPTURE_MODE
+#include "mc_capture.h"
+#endif
+#ifdef MC_FRA_MODE
+#include "mc_fra.h"
+#endif
+#ifdef MC_SPECTRUM_MODE
+#include "mc_spectrum.h"
+#endif
+#ifdef MC_OFFSETS_IN_FLASH
+#include "mc_offset_store.h"
+#endif
+#ifdef MC_COMMISSION_MODE
+#include "mc_commission.h"
+#endif
+#ifdef MC_DTCALIB_MODE
+#include "mc_dtcalib.h"
+#endif
+#ifdef MC_PROFILE_MODE
+#include "mc_profile.h"
+#endif
+#ifdef MC_RECORD_MODE
+#include "mc_record.h"
+#endif
+#ifdef MC_PIL_MODE
+#include "mc_pil.h"
+#endif
+#ifdef MC_FAULTLOG_MODE
+#include "mc_faultlog.h"
+#endif
+#ifdef MC_TIMEBASE_MODE
+#include "mc_timebase.h"
+#endif
+#ifdef MC_STACK_MODE
+#include "mc_stack.h"
+#endif
+#ifdef MC_ABTEST_MODE
+#include "mc_abtest.h"
+#endif
+#ifdef MC_AUTOSELECT_MODE
+#include "mc_autoselect.h"
+#endif
+#ifdef MC_BOOTLOG_MODE
+#include "mc_bootlog.h"
+#endif
+#ifdef MC_ADCCALIB_MODE
+#include "mc_adccalib.h"
+#endif
+#ifdef MC_PWMFREQ_MODE
+#include "mc_pwmfreq.h"
+#endif
+#ifdef MC_WARMBOOT_MODE
+#include "mc_warmboot.h"
+#endif
+#ifdef MC_REPORT_MODE
+#include "mc_report.h"
+#endif
+#ifdef MC_STATE_STATS_MODE
+#include "mc_state_stats.h"
+#endif
+#ifdef MC_PWM_DITHER_MODE
+#include "mc_pwm_dither.h"
+#endif
+#ifdef MC_GAP_MODE
+#include "mc_gap.h"
+#endif
 
 /* USER CODE BEGIN Includes */
 
@@ -58,97 +128,151 @@
   #define OFFCALIBRWAITTICKS2    (uint16_t)((SYS_TICK_FREQUENCY * OFFCALIBRWAIT_MS2)  / ((uint16_t)1000))
   #define STOPPERMANENCY_TICKS   (uint16_t)((SYS_TICK_FREQUENCY * STOPPERMANENCY_MS)  / ((uint16_t)1000))
   #define STOPPERMANENCY_TICKS2  (uint16_t)((SYS_TICK_FREQUENCY * STOPPERMANENCY_MS2) / ((uint16_t)1000))
+  #define MF_TASK_PERIOD_TICKS   (uint16_t)(SYS_TICK_FREQUENCY / SPEED_LOOP_FREQUENCY_HZ)
+#ifdef M1_POSITION_CTRL
+  #define POSITION_TASK_PERIOD_TICKS (uint16_t)(SYS_TICK_FREQUENCY / POSITION_LOOP_FREQUENCY_HZ)
+#endif
+/* Speed sensor of the start and of the low speeds, replaced by the observer above
+   SENSORLESS_SWITCH_SPEED_RPM */
+#if defined(M1_ENCODER_SENSOR)
+  #define STANDSTILL_SENSOR_M1   (&ENCODER_M1._Super)
+#elif defined(M1_HFI_SENSOR)
+  #define STANDSTILL_SENSOR_M1   (&HFI_M1._Super)
+#endif
 
 /* USER CODE END Private define */
 #define VBUS_TEMP_ERR_MASK (MC_OVER_VOLT| MC_UNDER_VOLT| MC_OVER_TEMP)
 /* Private variables----------------------------------------------------------*/
 static FOCVars_t FOCVars[NBR_OF_MOTORS];
 
+#ifdef MC_STATIC_BINDING_MODE
+/* Bound at compile time, as the handle tables of mc_config.h */
+static PWMC_Handle_t * const pwmcHandle[NBR_OF_MOTORS] = {&PWM_Handle_M1._Super};
+static CircleLimitation_Handle_t * const pCLM[NBR_OF_MOTORS] = {&CircleLimitationM1};
+static RampExtMngr_Handle_t * const pREMNG[NBR_OF_MOTORS] = {&RampExtMngrHFParamsM1};
+#else
 static PWMC_Handle_t *pwmcHandle[NBR_OF_MOTORS];
 static CircleLimitation_Handle_t *pCLM[NBR_OF_MOTORS];
 //cstat !MISRAC2012-Rule-8.9_a
 static RampExtMngr_Handle_t *pREMNG[NBR_OF_MOTORS];   /*!< Ramp manager used to modify the Iq ref
                                                     during the start-up switch over.*/
+#endif
 
-static uint16_t hMFTaskCounterM1 = 0; //cstat !MISRAC2012-Rule-8.9_a
-static volatile uint16_t hBootCapDelayCounterM1 = ((uint16_t)0);
-static volatile uint16_t hStopPermanencyCounterM1 = ((uint16_t)0);
+/**
+  * @brief Periodic task run by MC_Scheduler
+  */
+typedef struct
+{
+  void (*pTask)(void);  /*!< Task function, run from the SysTick interrupt */
+  uint32_t wDeadline;   /*!< Scheduler tick of the next run */
+  uint16_t hPeriod;     /*!< Run period, in scheduler ticks */
+} MC_SchedTask_t;
+
+static volatile uint32_t wSchedulerTicks = 0U; /*!< Calls of MC_Scheduler since the boot */
+static volatile uint32_t wBootCapDelayStartM1 = 0U;      /*!< Scheduler tick of the boot cap charge start */
+static volatile uint16_t hBootCapDelayM1 = ((uint16_t)0); /*!< Boot cap charge duration, in ticks */
+static volatile uint32_t wStopPermanencyStartM1 = 0U;    /*!< Scheduler tick of the stop start */
+static volatile uint16_t hStopPermanencyM1 = ((uint16_t)0); /*!< Stop permanency duration, in ticks */
+static bool ReadyM1 = false;                   /*!< Motor 1 has been ready to start once */
+static uint16_t hReadyTimeM1 = 0U;             /*!< HAL tick at which Motor 1 got ready to start, in ms */
+static uint32_t wStartTickM1 = 0U;             /*!< HAL tick of the last start command of Motor 1, in ms */
+static bool StartPendingM1 = false;            /*!< The last start of Motor 1 has not reached RUN yet */
+static uint16_t hStartUpTimeM1 = 0U;           /*!< Time from the last start command of Motor 1 to RUN, in ms */
+#ifdef MC_LOW_POWER_IDLE
+static volatile bool LowPowerM1 = false;        /*!< Motor 1 idle, the main loop sleeps between the interrupts */
+#endif
 
 static volatile uint8_t bMCBootCompleted = ((uint8_t)0);
+static SpeednPosFdbk_Handle_t * volatile pSpeedSensorM1 = &STO_PLL_M1._Super; /*!< Speed sensor of pSTC[M1], read
+                                                                                    by the high frequency task */
+
+#if (FLYING_START_ENABLING == ENABLE)
+static bool FlyingCatchM1 = false;              /*!< START regulates zero currents */
+static uint16_t hFlyingCatchTicksM1 = ((uint16_t)0); /*!< Medium frequency periods of the catch left */
+static volatile bool ObserverFreeRunM1 = false; /*!< The PLL is not reset before the first
+                                                     acceleration stage of the rev-up */
+#endif
 
-/* USER CODE BEGIN Private Variables */
+#if (COAST_ENABLING == ENABLE) && !defined (M1_ENCODER_SENSOR) && !defined (M1_HFI_SENSOR)
+/* The loop of a coasting rotor is closed again by the flying start of the sensorless builds */
+#define COAST_M1
+static bool CoastingM1 = false;                 /*!< RUN with the PWM switched off */
+static uint16_t hCoastTicksM1 = COAST_ENTRY_TICKS; /*!< Medium frequency periods of null
+                                                     reference left before the coasting */
+static int16_t hCoastSpeedDppM1 = ((int16_t)0); /*!< Electrical speed held, per observer period */
+static uint32_t wCoastAngleM1 = 0U;             /*!< Electrical angle propagated, 8 fractional bits */
+#endif
 
+/* USER CODE BEGIN Private Variables */
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#ifdef PCC_SPLIT_PHASE
+static volatile bool HFTaskBusyM1 = false; /*!< TSK_HighFrequencyTask runs, FOC_CurrPrepareM1 waits */
+#endif
+#endif
 /* USER CODE END Private Variables */
 
 /* Private functions ---------------------------------------------------------*/
 void TSK_MediumFrequencyTaskM1(void);
+static void MC_MediumFrequencyTasksM1(void);
+#ifdef M1_POSITION_CTRL
+static void MC_PositionControlTaskM1(void);
+#endif
 void FOC_Clear(uint8_t bMotor);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+static void FOC_SelectCurrController(uint8_t bMotor);
+#endif
+static void TSK_SetSpeedSensorM1(SpeednPosFdbk_Handle_t *pSensor);
+#ifdef STANDSTILL_SENSOR_M1
+static void TSK_CloseStandstillLoopM1(void);
+static void TSK_SelectSpeedSensorM1(void);
+#endif
+#ifdef MC_LOW_POWER_IDLE
+static void TSK_SetLowPowerM1(bool LowPower);
+#endif
+#ifdef COAST_M1
+static void TSK_EnterCoastM1(bool IsSpeedReliable);
+static void TSK_CoastM1(void);
+#endif
 void FOC_InitAdditionalMethods(uint8_t bMotor);
 void FOC_CalcCurrRef(uint8_t bMotor);
 void TSK_MF_StopProcessing(  MCI_Handle_t * pHandle, uint8_t motor);
 MCI_Handle_t * GetMCI(uint8_t bMotor);
 static uint16_t FOC_CurrControllerM1(void);
+#ifdef MC_COMMISSION_MODE
+static uint16_t FOC_CommissionControllerM1(void);
+static void TSK_CommissionM1(void);
+#endif
+#ifdef MC_DTCALIB_MODE
+static uint16_t FOC_DTCalibControllerM1(void);
+static void TSK_DTCalibM1(void);
+#endif
+#ifdef MC_ADCCALIB_MODE
+static uint16_t FOC_ADCCalibControllerM1(void);
+static void TSK_ADCCalibM1(void);
+#endif
 void TSK_SetChargeBootCapDelayM1(uint16_t hTickCount);
 bool TSK_ChargeBootCapDelayHasElapsedM1(void);
 void TSK_SetStopPermanencyTimeM1(uint16_t hTickCount);
 bool TSK_StopPermanencyTimeHasElapsedM1(void);
 void TSK_SafetyTask_PWMOFF(uint8_t motor);
 
-/* USER CODE BEGIN Private Functions */
-
-int i,j,c1,c2;
-float IalphaPred,IbetaPred,IqTx,wr,IqRef,Varray[7][3];
-volatile int16_t IdPred,IqPred,IdTemp,IqTemp;
-
-uint8_t optimalVector,optimalDuty,Sa,Sb,Sc;
-int16_t polePairs;
-
-
-
-
-int states[7] = {1,3,2,6,4,5,0};
-int runMPC = 0;
-int hasMPCinit = 0;
-alphabeta_t Valbt;
-
-int16_t Vphase = 8;
-
-
-void clarkeTransform(int16_t a, int16_t b, int16_t c, alphabeta_t *Xalbt);
-void parkTransform(short a, short b, short c, volatile qd_t *Xdq);
-void computeSinCos(int16_t thetaElec);
-
-
-
-void initModelPredictiveControl(){
-	ab_t Vab;
-	alphabeta_t Valphabeta;
-
-	c1 = (int)(10027*(1 - (0.65/(10000*0.0007))));
-	c2 = (int)(10027*(1/(10000*0.0007)));
-
-	for(i=0;i<7;i++){
-		Sa = states[i] & 0x01;
-		Sb = (states[i]>>1) & 0x01;
-		Sc = (states[i]>>2) & 0x01;
-
-		Vab.a = 4*((2*Sa-Sb-Sc))*32767/Vphase;
-		Vab.b = 4*((2*Sb-Sa-Sc))*32767/Vphase;
-
-		Valphabeta = MCM_Clarke(Vab);
+/* Tasks of MC_Scheduler, run in the order of the table when their deadline is reached.
+   A task added here is given the phase of its first run in wDeadline, so that tasks of
+   the same period can be spread over different SysTick interrupts */
+static MC_SchedTask_t SchedTasks[] =
+{
+#ifdef M1_POSITION_CTRL
+  /* First, so that a position step is not delayed by the medium frequency task */
+  {&MC_PositionControlTaskM1, 0U, POSITION_TASK_PERIOD_TICKS},
+#endif
+  {&MC_MediumFrequencyTasksM1, 0U, MF_TASK_PERIOD_TICKS},
+  /* USER CODE BEGIN Scheduled tasks */
 
-		Varray[i][0] = Valphabeta.alpha;
-		Varray[i][1] = Valphabeta.beta;
-	}
-}
+  /* USER CODE END Scheduled tasks */
+};
+#define MC_SCHED_NB_TASKS  (sizeof(SchedTasks) / sizeof(SchedTasks[0]))
 
-int absVal(int x){
-	if(x<0){
-		return  -x;
-	} else {
-		return x;
-	}
-}
+/* USER CODE BEGIN Private Functions */
 
 /* USER CODE END Private Functions */
 /**
@@ -171,14 +295,24 @@ __weak void MCboot( MCI_Handle_t* pMCIList[NBR_OF_MOTORS] )
   }
   else
   {
+    /* Lazy stacking of the FPU context, the reset configuration, set on purpose: an interrupt
+       that preempts floating point code only reserves the space of the FPU registers on the
+       stack, and they are saved by the first FPU instruction of the handler. The high
+       frequency task has none, see MC_Perf_CheckFpu(), so its entry takes 12 cycles instead
+       of 29 whatever it preempts, as measured by MC_Perf_MeasureIrqEntry() */
+    FPU->FPCCR |= (FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk);
 
     bMCBootCompleted = (uint8_t )0;
+#ifndef MC_STATIC_BINDING_MODE
     pCLM[M1] = &CircleLimitationM1;
+#endif
 
     /**********************************************************/
     /*    PWM and current sensing component initialization    */
     /**********************************************************/
+#ifndef MC_STATIC_BINDING_MODE
     pwmcHandle[M1] = &PWM_Handle_M1._Super;
+#endif
     R3_1_Init(&PWM_Handle_M1);
     ASPEP_start(&aspepOverUartA);
 
@@ -211,6 +345,20 @@ __weak void MCboot( MCI_Handle_t* pMCIList[NBR_OF_MOTORS] )
     /****************************************************/
     VSS_Init(&VirtualSpeedSensorM1);
 
+#ifdef M1_ENCODER_SENSOR
+    /******************************************************/
+    /*   Encoder and alignment component initialization   */
+    /******************************************************/
+    ENC_Init(&ENCODER_M1);
+    EAC_Init(&EncAlignCtrlM1, pSTC[M1], &VirtualSpeedSensorM1, &ENCODER_M1);
+#endif
+#ifdef M1_HFI_SENSOR
+    /********************************************************/
+    /*   High frequency injection component initialization */
+    /********************************************************/
+    HFI_Init(&HFI_M1);
+#endif
+
     /**************************************/
     /*   Rev-up component initialization  */
     /**************************************/
@@ -222,6 +370,42 @@ __weak void MCboot( MCI_Handle_t* pMCIList[NBR_OF_MOTORS] )
     PID_HandleInit(&PIDIqHandle_M1);
     PID_HandleInit(&PIDIdHandle_M1);
 
+    /*************************************************/
+    /*   Flux weakening component initialization     */
+    /*************************************************/
+    PID_HandleInit(&PIDFluxWeakeningHandle_M1);
+    FW_Init(pFW[M1], &PIDSpeedHandle_M1, &PIDFluxWeakeningHandle_M1);
+
+    /******************************************************/
+    /*   Feed forward component initialization            */
+    /******************************************************/
+    FF_Init(pFF[M1], &(BusVoltageSensor_M1._Super), pPIDId[M1], pPIDIq[M1]);
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+    /*********************************************************/
+    /*   Predictive current control component initialization */
+    /*********************************************************/
+    PCC_Init(pPCC[M1]);
+#ifdef PCC_MODEL_ESTIMATION
+    PCC_EST_Init(pPCCEst[M1], pPCC[M1]);
+#endif
+#ifdef MC_COMMISSION_MODE
+    /* The model of the last commissioning replaces the one of the motor parameters */
+    if (true == MC_Commission_Load())
+    {
+      MC_Commission_Apply(pPCCEst[M1], pPCC[M1]);
+    }
+#endif
+#endif
+
+#ifdef DBG_MCU_LOAD_MEASURE
+    /********************************************************/
+    /*   Execution time measurement initialization          */
+    /********************************************************/
+    MC_Perf_Measure_Init(&PerfTraces);
+    MC_Perf_MeasureIrqEntry(&PerfTraces);
+#endif
+
     /********************************************************/
     /*   Bus voltage sensor component initialization        */
     /********************************************************/
@@ -237,8 +421,42 @@ __weak void MCboot( MCI_Handle_t* pMCIList[NBR_OF_MOTORS] )
     /*   Temperature measurement component initialization  */
     /*******************************************************/
     NTC_Init(&TempSensor_M1);
+#ifdef THERMAL_DERATING
+    TDR_Init(pTDR[M1]);
+#endif
+#ifdef LOSS_MINIMIZATION
+    LMN_Init(pLMN[M1]);
+#endif
+#ifdef HARMONIC_COMPENSATION
+    HCM_Init(pHCM[M1]);
+#endif
+#ifdef SIX_STEP_MODE
+    SSM_Init(pSSM[M1]);
+#endif
+#ifdef LOAD_TORQUE_OBSERVER
+    LTO_Init(pLTO[M1]);
+#endif
+#ifdef SPEED_FILTER_BANK
+    SFB_Init(pSFB[M1]);
+#endif
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+    SMPC_Init(pSMPC[M1]);
+#endif
+#ifdef MC_PROFILE_MODE
+    /* The selected profile replaces the parameters of the build, once all its
+       components are initialized */
+    MC_Profile_Init();
+#endif
+#ifdef MC_TIMEBASE_MODE
+    MC_Time_Init();
+#endif
+#ifdef MC_FAULTLOG_MODE
+    MC_FaultLog_Init();
+#endif
 
+#ifndef MC_STATIC_BINDING_MODE
     pREMNG[M1] = &RampExtMngrHFParamsM1;
+#endif
     REMNG_Init(pREMNG[M1]);
 
     FOC_Clear(M1);
@@ -246,11 +464,76 @@ __weak void MCboot( MCI_Handle_t* pMCIList[NBR_OF_MOTORS] )
     FOCVars[M1].Iqdref = STC_GetDefaultIqdref(pSTC[M1]);
     FOCVars[M1].UserIdref = STC_GetDefaultIqdref(pSTC[M1]).d;
     MCI_Init(&Mci[M1], pSTC[M1], &FOCVars[M1],pwmcHandle[M1] );
+#ifdef M1_POSITION_CTRL
+    /******************************************************/
+    /*   Position control component initialization       */
+    /******************************************************/
+    PID_HandleInit(&PID_PosParamsM1);
+    TC_Init(&PosCtrlM1, &PID_PosParamsM1, pSTC[M1], &ENCODER_M1);
+    Mci[M1].pPosCtrl = &PosCtrlM1;
+#endif
     MCI_ExecSpeedRamp(&Mci[M1],
     STC_GetMecSpeedRefUnitDefault(pSTC[M1]),0); /*First command to STC*/
 
     pMCIList[M1] = &Mci[M1];
 
+#ifdef MC_BENCH_MODE
+    /********************************************************/
+    /*   Math kernels benchmark                             */
+    /********************************************************/
+    MC_Bench_Run();
+#endif
+
+#ifdef MC_AUTOSELECT_MODE
+    /********************************************************/
+    /*   Current controller fitting the regulation period   */
+    /********************************************************/
+    MC_AutoSel_Run();
+#endif
+
+#ifdef MC_BOOTLOG_MODE
+    /* The stored capture records the start from the boot offset calibration on */
+    MC_BootLog_Init();
+#endif
+
+#ifdef MC_ADCCALIB_MODE
+    /* The timing of the current sampling tuned at a previous boot */
+    MC_ADCCalib_Init(pwmcHandle[M1]);
+#endif
+
+#ifdef MC_GAP_MODE
+    /* NSD is held low until the gate drivers are configured by the medium frequency task */
+    MC_Gap_Start(&STGAP_M1);
+#endif
+
+#ifdef MC_WARMBOOT_MODE
+    /* After a warm reset, the offsets of the previous boot and the start of the drive
+       that was running */
+    (void)MC_WarmBoot_Restore(&Mci[M1], pwmcHandle[M1]);
+#endif
+
+#if defined(MC_BOOT_OFFSET_CALIB) && !defined(MC_OFFSETS_IN_FLASH)
+    /* The current offsets are measured while the application gets ready, and not
+       at the first start */
+    if (false == pwmcHandle[M1]->offsetCalibStatus)
+    {
+      (void)MCI_StartOffsetMeasurments(&Mci[M1]);
+    }
+    else
+    {
+      /* Restored by the warm boot */
+    }
+#endif
+#ifdef M1_ICL_ENABLED
+    /* The commands, the offset measurement above included, wait for the charge of
+       the bus capacitors */
+    ICL_Init(&ICL_M1, &(BusVoltageSensor_M1._Super), &ICLDOUTParamsM1);
+    Mci[M1].State = ICLWAIT;
+#endif
+#ifdef MC_STATE_STATS_MODE
+    MC_StateStats_Init(Mci[M1].State);
+#endif
+
     /* USER CODE BEGIN MCboot 2 */
 
     /* USER CODE END MCboot 2 */
@@ -262,9 +545,9 @@ __weak void MCboot( MCI_Handle_t* pMCIList[NBR_OF_MOTORS] )
 /**
  * @brief Runs all the Tasks of the Motor Control cockpit
  *
- * This function is to be called periodically at least at the Medium Frequency task
- * rate (It is typically called on the Systick interrupt). Exact invokation rate is
- * the Speed regulator execution rate set in the Motor Contorl Workbench.
+ * This function is to be called on every Systick interrupt, at SYS_TICK_FREQUENCY.
+ * The Medium Frequency tasks are run by MC_Scheduler at their own deadlines, the
+ * Speed regulator execution rate set in the Motor Contorl Workbench.
  *
  * The following tasks are executed in this order:
  *
@@ -286,7 +569,15 @@ __weak void MC_RunMotorControlTasks(void)
 
     /* Safety task is run after Medium Frequency task so that
      * it can overcome actions they initiated if needed. */
+#ifdef DBG_MCU_LOAD_MEASURE
+    MC_Perf_Task_Start(&PerfTraces, (uint8_t)JITTER_TSK_SafetyTask);
+    MC_Perf_Load_Start(&PerfTraces, (uint8_t)LOAD_TSK_SafetyTask);
+#endif
     TSK_SafetyTask();
+#ifdef DBG_MCU_LOAD_MEASURE
+    MC_Perf_Load_Stop(&PerfTraces, (uint8_t)LOAD_TSK_SafetyTask);
+    MC_Perf_Load_Update(&PerfTraces);
+#endif
 
   }
 }
@@ -300,7 +591,7 @@ void TSK_MF_StopProcessing(  MCI_Handle_t * pHandle, uint8_t motor)
   R3_1_SwitchOffPWM(pwmcHandle[motor]);
 
   FOC_Clear(motor);
-  MPM_Clear((MotorPowMeas_Handle_t*) pMPM[motor]);
+  PQD_Clear(pMPM[motor]);
   TSK_SetStopPermanencyTimeM1(STOPPERMANENCY_TICKS);
   Mci[motor].State = STOP;
   return;
@@ -309,7 +600,10 @@ void TSK_MF_StopProcessing(  MCI_Handle_t * pHandle, uint8_t motor)
 /**
  * @brief  Executes the Medium Frequency Task functions for each drive instance.
  *
- * It is to be clocked at the Systick frequency.
+ * It is to be clocked at the Systick frequency. Each call is one scheduler tick: only
+ * the tasks of SchedTasks whose deadline is reached are run, and the boot capacitor
+ * and stop permanency delays are measured on the tick count instead of being counted
+ * down on every call.
  */
 __weak void MC_Scheduler(void)
 {
@@ -319,59 +613,147 @@ __weak void MC_Scheduler(void)
 
   if (((uint8_t)1) == bMCBootCompleted)
   {
-    if(hMFTaskCounterM1 > 0u)
-    {
-      hMFTaskCounterM1--;
-    }
-    else
+    uint32_t wTicks = wSchedulerTicks;
+    uint8_t i;
+
+    for (i = 0U; i < (uint8_t)MC_SCHED_NB_TASKS; i++)
     {
-      TSK_MediumFrequencyTaskM1();
+      MC_SchedTask_t *pSched = &SchedTasks[i];
 
-      MCP_Over_UartA.rxBuffer = MCP_Over_UartA.pTransportLayer->fRXPacketProcess(MCP_Over_UartA.pTransportLayer,
-                                                                                &MCP_Over_UartA.rxLength);
-      if ( 0U == MCP_Over_UartA.rxBuffer)
+      if ((int32_t)(wTicks - pSched->wDeadline) >= 0)
       {
-        /* Nothing to do */
+        /* The next deadline follows the previous one, so that the rate does not drift
+           with the latency of the interrupt. A task late by a whole period restarts
+           from now instead of being run several times in a row */
+        pSched->wDeadline += pSched->hPeriod;
+        if ((int32_t)(wTicks - pSched->wDeadline) >= 0)
+        {
+          pSched->wDeadline = wTicks + pSched->hPeriod;
+        }
+        pSched->pTask();
       }
       else
       {
-        /* Synchronous answer */
-        if (0U == MCP_Over_UartA.pTransportLayer->fGetBuffer(MCP_Over_UartA.pTransportLayer,
-                                                     (void **) &MCP_Over_UartA.txBuffer, //cstat !MISRAC2012-Rule-11.3
-                                                     MCTL_SYNC))
-        {
-          /* no buffer available to build the answer ... should not occur */
-        }
-        else
-        {
-          MCP_ReceivedPacket(&MCP_Over_UartA);
-          MCP_Over_UartA.pTransportLayer->fSendPacket(MCP_Over_UartA.pTransportLayer, MCP_Over_UartA.txBuffer,
-                                                      MCP_Over_UartA.txLength, MCTL_SYNC);
-          /* no buffer available to build the answer ... should not occur */
-        }
+        /* Nothing to do */
       }
+    }
+    wSchedulerTicks = wTicks + 1U;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  /* USER CODE BEGIN MC_Scheduler 2 */
+
+  /* USER CODE END MC_Scheduler 2 */
+}
+
+/**
+ * @brief  Medium Frequency task of motor 1, run by MC_Scheduler every
+ *         MF_TASK_PERIOD_TICKS.
+ */
+static void MC_MediumFrequencyTasksM1(void)
+{
+#ifdef DBG_MCU_LOAD_MEASURE
+  MC_Perf_Task_Start(&PerfTraces, (uint8_t)JITTER_TSK_MediumFrequencyTaskM1);
+  MC_Perf_Load_Start(&PerfTraces, (uint8_t)LOAD_TSK_MediumFrequencyTaskM1);
+  MC_BG_Perf_Measure_Start(&PerfTraces, (uint8_t)MEASURE_TSK_MediumFrequencyTaskM1);
+#endif
+  TSK_MediumFrequencyTaskM1();
+#ifdef DBG_MCU_LOAD_MEASURE
+  MC_BG_Perf_Measure_Stop(&PerfTraces, (uint8_t)MEASURE_TSK_MediumFrequencyTaskM1);
+  MC_Perf_Load_Stop(&PerfTraces, (uint8_t)LOAD_TSK_MediumFrequencyTaskM1);
+#endif
 
-      /* USER CODE BEGIN MC_Scheduler 1 */
+  /* USER CODE BEGIN MC_Scheduler 1 */
 
-      /* USER CODE END MC_Scheduler 1 */
-      hMFTaskCounterM1 = (uint16_t)MF_TASK_OCCURENCE_TICKS;
-    }
-    if(hBootCapDelayCounterM1 > 0U)
+  /* USER CODE END MC_Scheduler 1 */
+}
+
+#ifdef M1_POSITION_CTRL
+/**
+ * @brief  Position loop of motor 1, run by MC_Scheduler every
+ *         POSITION_TASK_PERIOD_TICKS, at POSITION_LOOP_FREQUENCY_HZ.
+ *
+ * The torque reference of the trajectory and of the position PID is applied to the q
+ * current reference at once, instead of at the next speed loop period: with the one
+ * period response of the predictive current controller, the bandwidth of the position
+ * loop is then set by its own rate. The Medium Frequency task still builds the whole
+ * current reference from the same torque reference at the speed loop rate, with the
+ * MTPA, the flux weakening and the thermal derating.
+ */
+static void MC_PositionControlTaskM1(void)
+{
+  TC_IncTick(&PosCtrlM1);
+  if (RUN == Mci[M1].State)
+  {
+    TC_PositionRegulation(&PosCtrlM1);
+    if ((ENABLE == PosCtrlM1.PositionControlRegulation) && (INTERNAL == FOCVars[M1].bDriveInput))
     {
-      hBootCapDelayCounterM1--;
+      FOCVars[M1].hTeref = STC_CalcTorqueReference(pSTC[M1]);
+      FOCVars[M1].Iqdref.q = FOCVars[M1].hTeref;
     }
-    if(hStopPermanencyCounterM1 > 0U)
+    else
     {
-      hStopPermanencyCounterM1--;
+      /* Nothing to do */
     }
   }
   else
   {
     /* Nothing to do */
   }
-  /* USER CODE BEGIN MC_Scheduler 2 */
+}
+#endif
 
-  /* USER CODE END MC_Scheduler 2 */
+/**
+ * @brief  Processes the MCP request received by the transport layer, if any, and sends
+ *         its answer. It is to be called from the main loop: it is then preempted by
+ *         every motor control interrupt, and a long command such as a datalog
+ *         configuration never delays the Medium Frequency task.
+ */
+__weak void MC_ProcessHostRequests(void)
+{
+  if (((uint8_t)1) == bMCBootCompleted)
+  {
+    MCP_Over_UartA.rxBuffer = MCP_Over_UartA.pTransportLayer->fRXPacketProcess(MCP_Over_UartA.pTransportLayer,
+                                                                              &MCP_Over_UartA.rxLength);
+    if ( 0U == MCP_Over_UartA.rxBuffer)
+    {
+      /* Nothing to do */
+    }
+    else
+    {
+      /* Synchronous answer */
+      if (0U == MCP_Over_UartA.pTransportLayer->fGetBuffer(MCP_Over_UartA.pTransportLayer,
+                                                   (void **) &MCP_Over_UartA.txBuffer, //cstat !MISRAC2012-Rule-11.3
+                                                   MCTL_SYNC))
+      {
+        /* no buffer available to build the answer ... should not occur */
+      }
+      else
+      {
+#ifdef DBG_MCU_LOAD_MEASURE
+        /* Only the requests are measured, the polling of the main loop is idle time */
+        MC_Perf_Load_Start(&PerfTraces, (uint8_t)LOAD_MCP);
+#endif
+        MCP_ReceivedPacket(&MCP_Over_UartA);
+        MCP_Over_UartA.pTransportLayer->fSendPacket(MCP_Over_UartA.pTransportLayer, MCP_Over_UartA.txBuffer,
+                                                    MCP_Over_UartA.txLength, MCTL_SYNC);
+#ifdef DBG_MCU_LOAD_MEASURE
+        MC_Perf_Load_Stop(&PerfTraces, (uint8_t)LOAD_MCP);
+#endif
+        /* no buffer available to build the answer ... should not occur */
+      }
+    }
+#ifdef MC_REPORT_MODE
+    /* After the request, that may have changed the registers reported */
+    MC_Report_Exec();
+#endif
+  }
+  else
+  {
+    /* Nothing to do */
+  }
 }
 
 /**
@@ -391,7 +773,57 @@ __weak void TSK_MediumFrequencyTaskM1(void)
   int16_t wAux = 0;
 
   bool IsSpeedReliable = STO_PLL_CalcAvrgMecSpeedUnit(&STO_PLL_M1, &wAux);
+#ifdef M1_ENCODER_SENSOR
+  /* The observer runs alongside the encoder: the speed feedback checked is the one in use */
+  bool IsEncoderReliable = ENC_CalcAvrgMecSpeedUnit(&ENCODER_M1, &wAux);
+
+  if (&ENCODER_M1._Super == STC_GetSpeedSensor(pSTC[M1]))
+  {
+    IsSpeedReliable = IsEncoderReliable;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#elif defined(M1_HFI_SENSOR)
+  /* The injection follows the observer at high speed: it is only checked while in use */
+  bool IsHFIReliable = HFI_CalcAvrgMecSpeedUnit(&HFI_M1, &wAux);
+
+  if (&HFI_M1._Super == STC_GetSpeedSensor(pSTC[M1]))
+  {
+    IsSpeedReliable = IsHFIReliable;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+#ifdef M1_ICL_ENABLED
+  ICL_State_t ICLstate = ICL_Exec(&ICL_M1);
+#endif
   PQD_CalcElMotorPower(pMPM[M1]);
+#ifdef THERMAL_DERATING
+  /* Also in the stop states, for the model to cool down */
+  TDR_Update(pTDR[M1], PQD_GetMeanSqCurrent(pMPM[M1]), NTC_GetAvTemp_C(pTemperatureSensor[M1]));
+#endif
+
+#ifdef MC_STATE_STATS_MODE
+  /* State in which the period was spent, before the state machine moves */
+  MC_StateStats_Exec(Mci[M1].State);
+#endif
+
+  if ((false == ReadyM1) && (MCI_MEASURE_OFFSETS != Mci[M1].DirectCommand) && (OFFSET_CALIB != Mci[M1].State)
+      && (ICLWAIT != Mci[M1].State))
+  {
+    /* Boot completed and no offset measurement pending */
+    uint32_t wTick = HAL_GetTick();
+    hReadyTimeM1 = (wTick < 0xFFFFU) ? (uint16_t)wTick : 0xFFFFU;
+    ReadyM1 = true;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
 
   if (MCI_GetCurrentFaults(&Mci[M1]) == MC_NO_FAULTS)
   {
@@ -399,12 +831,59 @@ __weak void TSK_MediumFrequencyTaskM1(void)
     {
       switch (Mci[M1].State)
       {
+#ifdef M1_ICL_ENABLED
+        case ICLWAIT:
+        {
+          if (ICL_INACTIVE == ICLstate)
+          {
+            /* The bus capacitors are charged and the limiting resistor bypassed */
+            Mci[M1].State = IDLE;
+          }
+          else
+          {
+            /* Nothing to do */
+          }
+          break;
+        }
+
+#endif
         case IDLE:
         {
-          if ((MCI_START == Mci[M1].DirectCommand) || (MCI_MEASURE_OFFSETS == Mci[M1].DirectCommand))
+#ifdef M1_ICL_ENABLED
+          if (ICL_INACTIVE != ICLstate)
+          {
+            /* The bus is charging again, through the limiting resistor */
+            Mci[M1].State = ICLWAIT;
+          }
+          else
+#endif
+          if ((MCI_START == Mci[M1].DirectCommand) || (MCI_MEASURE_OFFSETS == Mci[M1].DirectCommand)
+              || (MCI_COMMISSION == Mci[M1].DirectCommand) || (MCI_DT_CALIBRATE == Mci[M1].DirectCommand)
+              || (MCI_ADC_CALIBRATE == Mci[M1].DirectCommand))
           {
             RUC_Clear(&RevUpControlM1, MCI_GetImposedMotorDirection(&Mci[M1]));
+            if (MCI_START == Mci[M1].DirectCommand)
+            {
+              wStartTickM1 = HAL_GetTick();
+              StartPendingM1 = true;
+            }
+            else
+            {
+              /* Nothing to do */
+            }
+
+#ifdef MC_OFFSETS_IN_FLASH
+           if ((MCI_MEASURE_OFFSETS != Mci[M1].DirectCommand) && (pwmcHandle[M1]->offsetCalibStatus == false))
+           {
+             PolarizationOffsets_t StoredOffsets;
 
+             /* Offsets of a previous power cycle, measured at a close temperature */
+             if (MC_OffsetStore_Load(&StoredOffsets, NTC_GetAvTemp_C(pTemperatureSensor[M1])))
+             {
+               PWMC_SetOffsetCalib(pwmcHandle[M1], &StoredOffsets);
+             }
+           }
+#endif
            if (pwmcHandle[M1]->offsetCalibStatus == false)
            {
              PWMC_CurrentReadingCalibr(pwmcHandle[M1], CRC_START);
@@ -422,6 +901,22 @@ __weak void TSK_MediumFrequencyTaskM1(void)
            }
 
           }
+#ifdef MC_PROFILE_MODE
+          else if (MCI_SELECT_PROFILE == Mci[M1].DirectCommand)
+          {
+            /* Applied while the PWM is off */
+            MC_Profile_Select(Mci[M1].bProfile);
+            Mci[M1].DirectCommand = MCI_NO_COMMAND;
+          }
+#endif
+#ifdef MC_PWMFREQ_MODE
+          else if (MCI_SET_PWM_FREQ == Mci[M1].DirectCommand)
+          {
+            /* Applied while the PWM is off, the next start runs at the new frequency */
+            (void)MC_PwmFreq_Apply(Mci[M1].wPwmFrequency);
+            Mci[M1].DirectCommand = MCI_NO_COMMAND;
+          }
+#endif
           else
           {
             /* nothing to be done, FW stays in IDLE state */
@@ -439,10 +934,17 @@ __weak void TSK_MediumFrequencyTaskM1(void)
             {
               if (PWMC_CurrentReadingCalibr(pwmcHandle[M1], CRC_EXEC))
               {
-                if (MCI_MEASURE_OFFSETS == Mci[M1].DirectCommand)
+#ifdef MC_OFFSETS_IN_FLASH
+                PolarizationOffsets_t MeasuredOffsets;
+
+                /* Written while the PWM is still off */
+                PWMC_GetOffsetCalib(pwmcHandle[M1], &MeasuredOffsets);
+                MC_OffsetStore_Save(&MeasuredOffsets, NTC_GetAvTemp_C(pTemperatureSensor[M1]));
+#endif
+                if (MCI_MEASURE_OFFSETS == Mci[M1].DirectCommand)
                 {
                   FOC_Clear(M1);
-                  MPM_Clear((MotorPowMeas_Handle_t*) pMPM[M1]);
+                  PQD_Clear(pMPM[M1]);
                   Mci[M1].DirectCommand = MCI_NO_COMMAND;
                   Mci[M1].State = IDLE;
                 }
@@ -468,17 +970,103 @@ __weak void TSK_MediumFrequencyTaskM1(void)
           {
             TSK_MF_StopProcessing(&Mci[M1], M1);
           }
+#ifdef MC_COMMISSION_MODE
+          else if (MCI_COMMISSION == Mci[M1].DirectCommand)
+          {
+            if (TSK_ChargeBootCapDelayHasElapsedM1())
+            {
+              /* The standstill phases regulate the currents at the angle of the Virtual
+                 Speed Sensor, that then drags the rotor for the flux phase */
+              FOCVars[M1].bDriveInput = EXTERNAL;
+              TSK_SetSpeedSensorM1(&VirtualSpeedSensorM1._Super);
+              VSS_Clear(&VirtualSpeedSensorM1);
+              FOC_Clear(M1);
+              MC_Commission_Start(pPCC[M1], MC_COMMISSION_CURRENT);
+              Mci[M1].State = COMMISSIONING;
+              PWMC_SwitchOnPWM(pwmcHandle[M1]);
+            }
+            else
+            {
+              /* nothing to be done, FW waits for bootstrap capacitor to charge */
+            }
+          }
+#endif
+#ifdef MC_DTCALIB_MODE
+          else if (MCI_DT_CALIBRATE == Mci[M1].DirectCommand)
+          {
+            if (TSK_ChargeBootCapDelayHasElapsedM1())
+            {
+              FOCVars[M1].bDriveInput = EXTERNAL;
+              FOC_Clear(M1);
+              MC_DTCalib_Start(pwmcHandle[M1], MC_DTCALIB_CURRENT);
+              Mci[M1].State = DT_CALIBRATING;
+              PWMC_SwitchOnPWM(pwmcHandle[M1]);
+            }
+            else
+            {
+              /* nothing to be done, FW waits for bootstrap capacitor to charge */
+            }
+          }
+#endif
+#ifdef MC_ADCCALIB_MODE
+          else if (MCI_ADC_CALIBRATE == Mci[M1].DirectCommand)
+          {
+            if (TSK_ChargeBootCapDelayHasElapsedM1())
+            {
+              FOCVars[M1].bDriveInput = EXTERNAL;
+              FOC_Clear(M1);
+              MC_ADCCalib_Start(pwmcHandle[M1], MC_ADCCALIB_CURRENT);
+              Mci[M1].State = ADC_CALIBRATING;
+              PWMC_SwitchOnPWM(pwmcHandle[M1]);
+            }
+            else
+            {
+              /* nothing to be done, FW waits for bootstrap capacitor to charge */
+            }
+          }
+#endif
           else
           {
             if (TSK_ChargeBootCapDelayHasElapsedM1())
             {
               R3_1_SwitchOffPWM(pwmcHandle[M1]);
              FOCVars[M1].bDriveInput = EXTERNAL;
-             STC_SetSpeedSensor( pSTC[M1], &VirtualSpeedSensorM1._Super );
+             TSK_SetSpeedSensorM1(&VirtualSpeedSensorM1._Super);
               STO_PLL_Clear(&STO_PLL_M1);
               FOC_Clear( M1 );
+#ifdef M1_ENCODER_SENSOR
+              ENC_Clear(&ENCODER_M1);
+              if (false == EAC_IsAligned(&EncAlignCtrlM1))
+              {
+                /* The encoder counts from an unknown angle until the rotor is aligned once */
+                EAC_StartAlignment(&EncAlignCtrlM1);
+                Mci[M1].State = ALIGNMENT;
+              }
+              else
+              {
+                /* The encoder angle is valid at standstill: no rev-up */
+                TSK_CloseStandstillLoopM1();
+              }
+#elif defined(M1_HFI_SENSOR)
+              /* The carrier is injected from now on: the angle of the saliency and
+                 the polarity of the magnet are found at standstill, no rev-up */
+              HFI_Clear(&HFI_M1);
+              TSK_SetSpeedSensorM1(&HFI_M1._Super);
+              HFI_StartPolarity(&HFI_M1);
+              Mci[M1].State = ALIGNMENT;
+#else
+#if (FLYING_START_ENABLING == ENABLE)
+              /* The rotor may still be spinning: the observer is given the zero current
+                 regulation before any rev-up */
+              VSS_SetCopyObserver(&VirtualSpeedSensorM1);
+              STO_SetDirection(&STO_PLL_M1, (int8_t)MCI_GetImposedMotorDirection(&Mci[M1]));
+              hFlyingCatchTicksM1 = FLYING_START_CATCH_TICKS;
+              FlyingCatchM1 = true;
+              ObserverFreeRunM1 = true;
+#endif
 
               Mci[M1].State = START;
+#endif
 
               PWMC_SwitchOnPWM(pwmcHandle[M1]);
             }
@@ -490,12 +1078,112 @@ __weak void TSK_MediumFrequencyTaskM1(void)
           break;
         }
 
+#ifdef M1_ENCODER_SENSOR
+        case ALIGNMENT:
+        {
+          if (MCI_STOP == Mci[M1].DirectCommand)
+          {
+            TSK_MF_StopProcessing(&Mci[M1], M1);
+          }
+          else
+          {
+            bool IsAligned = EAC_IsAligned(&EncAlignCtrlM1);
+            bool EACDone = EAC_Exec(&EncAlignCtrlM1);
+
+            if ((false == IsAligned) && (false == EACDone))
+            {
+              qd_t IqdRef;
+
+              /* The torque ramp of the alignment drives the d current, at the angle
+                 imposed by the Virtual Speed Sensor */
+              IqdRef.q = 0;
+              IqdRef.d = STC_CalcTorqueReference(pSTC[M1]);
+              FOCVars[M1].Iqdref = IqdRef;
+            }
+            else
+            {
+              /* The rotor settles with the low sides on, then CHARGE_BOOT_CAP
+                 closes the loop on the aligned encoder */
+              R3_1_SwitchOffPWM(pwmcHandle[M1]);
+              FOC_Clear(M1);
+              R3_1_TurnOnLowSides(pwmcHandle[M1]);
+              TSK_SetChargeBootCapDelayM1(CHARGE_BOOT_CAP_TICKS);
+              Mci[M1].State = CHARGE_BOOT_CAP;
+            }
+          }
+          break;
+        }
+#elif defined(M1_HFI_SENSOR)
+        case ALIGNMENT:
+        {
+          if (MCI_STOP == Mci[M1].DirectCommand)
+          {
+            TSK_MF_StopProcessing(&Mci[M1], M1);
+          }
+          else
+          {
+            qd_t IqdRef;
+
+            /* The d current pulses of the polarity detection, on the angle of the
+               injection */
+            IqdRef.q = 0;
+            if (true == HFI_ExecPolarity(&HFI_M1, &IqdRef.d))
+            {
+              TSK_CloseStandstillLoopM1();
+            }
+            else
+            {
+              FOCVars[M1].Iqdref = IqdRef;
+            }
+          }
+          break;
+        }
+#endif
+
         case START:
         {
           if (MCI_STOP == Mci[M1].DirectCommand)
           {
             TSK_MF_StopProcessing(&Mci[M1], M1);
           }
+#if (FLYING_START_ENABLING == ENABLE)
+          else if (true == FlyingCatchM1)
+          {
+            /* With zero currents the applied voltage is the back-EMF, that the observer
+               locks onto in a few electrical periods */
+            FOCVars[M1].Iqdref.q = 0;
+            FOCVars[M1].Iqdref.d = 0;
+            if (hFlyingCatchTicksM1 > 0U)
+            {
+              hFlyingCatchTicksM1--;
+            }
+            else
+            {
+              int16_t hDirection = MCI_GetImposedMotorDirection(&Mci[M1]);
+              int32_t wObsSpeedUnit = (int32_t)SPD_GetAvrgMecSpeedUnit(&STO_PLL_M1._Super) * hDirection;
+
+              FlyingCatchM1 = false;
+              if ((true == IsSpeedReliable) && (wObsSpeedUnit >= (int32_t)FLYING_START_MIN_SPEED_UNIT))
+              {
+                /* The rotor is caught: the loop is closed as at the end of SWITCH_OVER,
+                   the predictive controller engages from RUN above its speed */
+                PID_SetIntegralTerm(&PIDSpeedHandle_M1, 0);
+                TSK_SetSpeedSensorM1(&STO_PLL_M1._Super);
+                FOC_InitAdditionalMethods(M1);
+                FOC_CalcCurrRef( M1 );
+                STC_ForceSpeedReferenceToCurrentSpeed(pSTC[M1]);
+                MCI_ExecBufferedCommands(&Mci[M1]);
+                Mci[M1].State = RUN;
+              }
+              else
+              {
+                /* The rotor is at rest, too slow or spinning backwards: standard rev-up */
+                RUC_Clear(&RevUpControlM1, hDirection);
+                ObserverFreeRunM1 = false;
+              }
+            }
+          }
+#endif
           else
           {
             /* Mechanical speed as imposed by the Virtual Speed Sensor during the Rev Up phase. */
@@ -522,6 +1210,16 @@ __weak void TSK_MediumFrequencyTaskM1(void)
            }
 
            (void) VSS_CalcAvrgMecSpeedUnit(&VirtualSpeedSensorM1, &hForcedMecSpeedUnit);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_OPEN_LOOP_START)
+           /* The predictor regulates the rev-up currents on the angle of the virtual
+              speed sensor, within its current constraint */
+           pCRG[M1]->PCCSelected = true;
+           PCC_SetBusVoltage(pPCC[M1], VBS_GetAvBusVoltage_d(&(BusVoltageSensor_M1._Super)));
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+           PCC_SelectWeights(pPCC[M1], (hForcedMecSpeedUnit < 0) ? -hForcedMecSpeedUnit : hForcedMecSpeedUnit,
+                             FOCVars[M1].Iqdref.q);
+#endif
+#endif
 
            /* check that startup stage where the observer has to be used has been reached */
            if (true == RUC_FirstAccelerationStageReached(&RevUpControlM1))
@@ -572,6 +1270,16 @@ __weak void TSK_MediumFrequencyTaskM1(void)
               /* Compute the virtual speed and positions of the rotor.
                  The function returns true if the virtual speed is in the reliability range */
               LoopClosed = VSS_CalcAvrgMecSpeedUnit(&VirtualSpeedSensorM1, &hForcedMecSpeedUnit);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_BLENDED_HANDOVER)
+              /* Above the engage speed the predictor is blended in along with the
+                 observer angle */
+              FOC_SelectCurrController(M1);
+              PCC_SetBusVoltage(pPCC[M1], VBS_GetAvBusVoltage_d(&(BusVoltageSensor_M1._Super)));
+#elif (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_OPEN_LOOP_START)
+              /* The predictor of the start-up keeps the regulation until RUN selects
+                 the controller from the speed */
+              PCC_SetBusVoltage(pPCC[M1], VBS_GetAvBusVoltage_d(&(BusVoltageSensor_M1._Super)));
+#endif
               /* Check if the transition ramp has completed. */
               bool tempBool;
               tempBool = VSS_TransitionEnded(&VirtualSpeedSensorM1);
@@ -592,7 +1300,7 @@ __weak void TSK_MediumFrequencyTaskM1(void)
                 /* USER CODE BEGIN MediumFrequencyTask M1 1 */
 
                 /* USER CODE END MediumFrequencyTask M1 1 */
-                STC_SetSpeedSensor(pSTC[M1], &STO_PLL_M1._Super); /*Observer has converged*/
+                TSK_SetSpeedSensorM1(&STO_PLL_M1._Super); /*Observer has converged*/
                 FOC_InitAdditionalMethods(M1);
                 FOC_CalcCurrRef( M1 );
                 STC_ForceSpeedReferenceToCurrentSpeed(pSTC[M1]); /* Init the reference speed to current speed */
@@ -610,6 +1318,12 @@ __weak void TSK_MediumFrequencyTaskM1(void)
           {
             TSK_MF_StopProcessing(&Mci[M1], M1);
           }
+#ifdef COAST_M1
+          else if (true == CoastingM1)
+          {
+            TSK_CoastM1();
+          }
+#endif
           else
           {
             /* USER CODE BEGIN MediumFrequencyTask M1 2 */
@@ -617,23 +1331,108 @@ __weak void TSK_MediumFrequencyTaskM1(void)
             /* USER CODE END MediumFrequencyTask M1 2 */
 
             MCI_ExecBufferedCommands(&Mci[M1]);
+#ifdef STANDSTILL_SENSOR_M1
+            TSK_SelectSpeedSensorM1();
+#endif
+#ifdef LOSS_MINIMIZATION
+            /* Before the references, for them to take the step at once */
+            LMN_Update(pLMN[M1], PQD_GetElPower_mW(pMPM[M1]), FOCVars[M1].Iqdref.q,
+                       SPD_GetAvrgMecSpeedUnit(STC_GetSpeedSensor(pSTC[M1])));
+#endif
             FOC_CalcCurrRef(M1);
+#ifdef HARMONIC_COMPENSATION
+            {
+              SpeednPosFdbk_Handle_t *pSPD = STC_GetSpeedSensor(pSTC[M1]);
+              int32_t wSpeedError = (int32_t)SPD_GetAvrgMecSpeedUnit(pSPD)
+                                  - (int32_t)STC_GetMecSpeedRefUnit(pSTC[M1]);
+
+              /* Learned at a steady speed only: the speed loop then holds the
+                 mean torque, and what is left repeats with the angle */
+              HCM_SelectLearning(pHCM[M1], (wSpeedError < (int32_t)HCM_STEADY_BAND_UNIT)
+                                           && (wSpeedError > -(int32_t)HCM_STEADY_BAND_UNIT),
+                                 SPD_GetElSpeedDpp(pSPD));
+            }
+#endif
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+            FOC_SelectCurrController(M1);
+            PCC_SetBusVoltage(pPCC[M1], VBS_GetAvBusVoltage_d(&(BusVoltageSensor_M1._Super)));
+            PCC_UpdateStats(pPCC[M1]);
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE) && defined (PCC_SHARED_MODEL)
+            PCC_UpdateFlux(pPCC[M1], SPD_GetElSpeedDpp(STC_GetSpeedSensor(pSTC[M1])));
+#endif
+#ifdef PCC_MODEL_ESTIMATION
+            PCC_EST_Update(pPCCEst[M1], pPCC[M1], SPD_GetElSpeedDpp(STC_GetSpeedSensor(pSTC[M1])),
+                           NTC_GetAvTemp_C(pTemperatureSensor[M1]));
+#endif
+#endif
 
             if(!IsSpeedReliable)
             {
               MCI_FaultProcessing(&Mci[M1], MC_SPEED_FDBK, 0);
             }
+#ifdef COAST_M1
+            /* Last, on the references of this period */
+            TSK_EnterCoastM1(IsSpeedReliable);
+#endif
+
+          }
+          break;
+        }
+
+#ifdef MC_COMMISSION_MODE
+        case COMMISSIONING:
+        {
+          if (MCI_STOP == Mci[M1].DirectCommand)
+          {
+            MC_Commission_Stop();
+            TSK_MF_StopProcessing(&Mci[M1], M1);
+          }
+          else
+          {
+            TSK_CommissionM1();
+          }
+          break;
+        }
+#endif
+
+#ifdef MC_DTCALIB_MODE
+        case DT_CALIBRATING:
+        {
+          if (MCI_STOP == Mci[M1].DirectCommand)
+          {
+            MC_DTCalib_Stop();
+            TSK_MF_StopProcessing(&Mci[M1], M1);
+          }
+          else
+          {
+            TSK_DTCalibM1();
+          }
+          break;
+        }
+#endif
 
+#ifdef MC_ADCCALIB_MODE
+        case ADC_CALIBRATING:
+        {
+          if (MCI_STOP == Mci[M1].DirectCommand)
+          {
+            TSK_MF_StopProcessing(&Mci[M1], M1);
+            MC_ADCCalib_Stop();
+          }
+          else
+          {
+            TSK_ADCCalibM1();
           }
           break;
         }
+#endif
 
         case STOP:
         {
           if (TSK_StopPermanencyTimeHasElapsedM1())
           {
 
-            STC_SetSpeedSensor(pSTC[M1], &VirtualSpeedSensorM1._Super);  	/*  sensor-less */
+            TSK_SetSpeedSensorM1(&VirtualSpeedSensorM1._Super);  	/*  sensor-less */
             VSS_Clear(&VirtualSpeedSensorM1); /* Reset measured speed in IDLE */
 
             /* USER CODE BEGIN MediumFrequencyTask M1 5 */
@@ -652,10 +1451,17 @@ __weak void TSK_MediumFrequencyTaskM1(void)
 
         case FAULT_OVER:
         {
+#ifdef MC_FAULTLOG_MODE
+          /* The PWM is off since the fault */
+          MC_FaultLog_Store();
+#endif
           if (MCI_ACK_FAULTS == Mci[M1].DirectCommand)
           {
             Mci[M1].DirectCommand = MCI_NO_COMMAND;
             Mci[M1].State = IDLE;
+#ifdef MC_FAULTLOG_MODE
+            MC_FaultLog_Rearm();
+#endif
 
           }
           else
@@ -682,8 +1488,37 @@ __weak void TSK_MediumFrequencyTaskM1(void)
   else
   {
     Mci[M1].State = FAULT_NOW;
+#ifdef MC_FAULTLOG_MODE
+    MC_FaultLog_Store();
+#endif
   }
 
+  if ((true == StartPendingM1) && (RUN == Mci[M1].State))
+  {
+    /* Whatever the way the loop was closed: switch over, flying start or standstill sensor */
+    uint32_t wStartUpTime = HAL_GetTick() - wStartTickM1;
+    hStartUpTimeM1 = (wStartUpTime < 0xFFFFU) ? (uint16_t)wStartUpTime : 0xFFFFU;
+    StartPendingM1 = false;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+#ifdef MC_WARMBOOT_MODE
+  MC_WarmBoot_Save(&Mci[M1], pwmcHandle[M1]);
+#endif
+
+#ifdef MC_GAP_MODE
+  MC_Gap_Exec(&Mci[M1]);
+#endif
+
+#ifdef MC_LOW_POWER_IDLE
+  /* Any command wakes the drive up before its state changes: it is processed by the
+     next run of this task, that the SysTick interrupt wakes up anyway */
+  TSK_SetLowPowerM1((IDLE == Mci[M1].State) && (MCI_NO_COMMAND == Mci[M1].DirectCommand) && (true == ReadyM1));
+#endif
+
   /* USER CODE BEGIN MediumFrequencyTask M1 6 */
 
   /* USER CODE END MediumFrequencyTask M1 6 */
@@ -706,6 +1541,10 @@ __weak void FOC_Clear(uint8_t bMotor)
   qd_t NULL_qd = {((int16_t)0), ((int16_t)0)};
   alphabeta_t NULL_alphabeta = {((int16_t)0), ((int16_t)0)};
 
+#ifdef MC_RECORD_MODE
+  /* An armed record starts from the cleared state of the controllers */
+  MC_Record_Clear();
+#endif
   FOCVars[bMotor].Iab = NULL_ab;
   FOCVars[bMotor].Ialphabeta = NULL_alphabeta;
   FOCVars[bMotor].Iqd = NULL_qd;
@@ -714,12 +1553,46 @@ __weak void FOC_Clear(uint8_t bMotor)
   FOCVars[bMotor].Vqd = NULL_qd;
   FOCVars[bMotor].Valphabeta = NULL_alphabeta;
   FOCVars[bMotor].hElAngle = (int16_t)0;
+#ifdef COAST_M1
+  if (M1 == bMotor)
+  {
+    CoastingM1 = false;
+    hCoastTicksM1 = COAST_ENTRY_TICKS;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
 
   PID_SetIntegralTerm(pPIDIq[bMotor], ((int32_t)0));
   PID_SetIntegralTerm(pPIDId[bMotor], ((int32_t)0));
+  FW_Clear(pFW[bMotor]);
+  FF_Clear(pFF[bMotor]);
+#ifdef LOSS_MINIMIZATION
+  LMN_Clear(pLMN[bMotor]);
+#endif
+#ifdef HARMONIC_COMPENSATION
+  HCM_Clear(pHCM[bMotor]);
+#endif
+#ifdef SIX_STEP_MODE
+  SSM_Clear(pSSM[bMotor]);
+#endif
+#ifdef LOAD_TORQUE_OBSERVER
+  LTO_Clear(pLTO[bMotor]);
+#endif
+#ifdef SPEED_FILTER_BANK
+  SFB_Clear(pSFB[bMotor]);
+#endif
+
+  CRG_Clear(pCRG[bMotor]);
 
   STC_Clear(pSTC[bMotor]);
 
+#ifdef MC_PWM_DITHER_MODE
+  /* The controllers of the other states write their duty cycles for the nominal period */
+  MC_PwmDither_Stop();
+#endif
   PWMC_SwitchOffPWM(pwmcHandle[bMotor]);
 
   /* USER CODE BEGIN FOC_Clear 1 */
@@ -744,6 +1617,10 @@ __weak void FOC_InitAdditionalMethods(uint8_t bMotor) //cstat !RED-func-no-effec
   /* USER CODE BEGIN FOC_InitAdditionalMethods 0 */
 
   /* USER CODE END FOC_InitAdditionalMethods 0 */
+      FF_InitFOCAdditionalMethods(pFF[bMotor]);
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+      SMPC_Clear(pSMPC[bMotor]);
+#endif
     }
 }
 
@@ -759,6 +1636,7 @@ __weak void FOC_InitAdditionalMethods(uint8_t bMotor) //cstat !RED-func-no-effec
   */
 __weak void FOC_CalcCurrRef(uint8_t bMotor)
 {
+  qd_t IqdTmp;
 
   /* USER CODE BEGIN FOC_CalcCurrRef 0 */
 
@@ -766,8 +1644,74 @@ __weak void FOC_CalcCurrRef(uint8_t bMotor)
   if (INTERNAL == FOCVars[bMotor].bDriveInput)
   {
     FOCVars[bMotor].hTeref = STC_CalcTorqueReference(pSTC[bMotor]);
-    FOCVars[bMotor].Iqdref.q = FOCVars[bMotor].hTeref;
-
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+    if (STC_SPEED_MODE == STC_GetControlMode(pSTC[bMotor]))
+    {
+      /* The ramp has moved: the predictive controller replaces the output of the
+         speed PI, and is saturated downstream as the PI is */
+      FOCVars[bMotor].hTeref = SMPC_CalcTorqueReference(pSMPC[bMotor], pSTC[bMotor], FOCVars[bMotor].Iqdref.q);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif
+#ifdef LOAD_TORQUE_OBSERVER
+    /* The load is estimated from the q current executed over the last period, then
+       fed forward: the speed PI only corrects the error of the observer */
+    (void)LTO_Update(pLTO[bMotor], FOCVars[bMotor].Iqdref.q,
+                     SPD_GetAvrgMecSpeedUnit(STC_GetSpeedSensor(pSTC[bMotor])));
+    if (STC_SPEED_MODE == STC_GetControlMode(pSTC[bMotor]))
+    {
+      FOCVars[bMotor].hTeref = LTO_AddFeedForward(pLTO[bMotor], FOCVars[bMotor].hTeref);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif
+#ifdef SPEED_FILTER_BANK
+    /* The resonances of the mechanics are removed from the torque reference of the
+       speed loop. Out of the speed mode the filter follows the reference, so that
+       it is bumpless once the speed loop is closed */
+    if (STC_SPEED_MODE == STC_GetControlMode(pSTC[bMotor]))
+    {
+      FOCVars[bMotor].hTeref = SFB_Filter(pSFB[bMotor], FOCVars[bMotor].hTeref);
+    }
+    else
+    {
+      SFB_Preload(pSFB[bMotor], FOCVars[bMotor].hTeref);
+    }
+#endif
+    IqdTmp.q = FOCVars[bMotor].hTeref;
+    IqdTmp.d = FOCVars[bMotor].UserIdref;
+    /* The MTPA Id is the base from which the flux weakening loop goes down */
+    MTPA_CalcCurrRefFromIq(pMaxTorquePerAmpere[bMotor], &IqdTmp);
+#ifdef LOSS_MINIMIZATION
+    /* At light load the d current moves from the MTPA one to the point of least loss */
+    IqdTmp.d += LMN_GetIdOffset(pLMN[bMotor]);
+#endif
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    /* On average the finite set holds a voltage inside the hexagon of its vectors
+       only: while the predictor is engaged the voltage is weakened down to the
+       circle inscribed in the hexagon rather than to the circle limitation */
+    pFW[bMotor]->hMaxModule = (true == pCRG[bMotor]->PCCEngaged) ? PCC_HEXAGON_MODULE : (uint16_t)MAX_MODULE;
+#elif (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_FULL_HEXAGON)
+    /* The dwell times reach the vertices of the hexagon: while the predictor is
+       engaged the voltage is weakened down to the circle inscribed in the full
+       hexagon, the full scale of PWMC_SetPhaseVoltage(), rather than to the
+       circle limitation */
+    pFW[bMotor]->hMaxModule = (true == pCRG[bMotor]->PCCEngaged) ? (uint16_t)INT16_MAX : (uint16_t)MAX_MODULE;
+#endif
+#ifdef THERMAL_DERATING
+    /* The flux weakening saturates the q current and the speed PI integral term
+       on the circle of the thermal current limit */
+    pFW[bMotor]->wNominalSqCurr = TDR_GetSqCurrLimit(pTDR[bMotor]);
+#endif
+    FOCVars[bMotor].Iqdref = FW_CalcCurrRef(pFW[bMotor], IqdTmp);
+    /* Decoupling and back-EMF voltages, computed once per speed loop period for
+       the PI controllers */
+    FF_VqdffComputation(pFF[bMotor], FOCVars[bMotor].Iqdref, pSTC[bMotor]);
   }
   else
   {
@@ -778,66 +1722,358 @@ __weak void FOC_CalcCurrRef(uint8_t bMotor)
   /* USER CODE END FOC_CalcCurrRef 1 */
 }
 
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
 /**
-  * @brief  It set a counter intended to be used for counting the delay required
-  *         for drivers boot capacitors charging of motor 1
-  * @param  hTickCount number of ticks to be counted
-  * @retval void
+  * @brief  It selects the current controller from the absolute average speed:
+  *         the predictive controller from the engage speed on, the PI controllers
+  *         below the disengage speed. In between, the selection is kept, so that
+  *         the controller does not toggle around a single threshold. The
+  *         handover itself is made by the high frequency task. The cost
+  *         weights of the operating point are selected as well.
+  *         It must be called by the medium frequency task in RUN state, and
+  *         in SWITCH_OVER with PCC_BLENDED_HANDOVER.
+  * @param  bMotor related motor it can be M1 or M2
+  * @retval none
   */
-__weak void TSK_SetChargeBootCapDelayM1(uint16_t hTickCount)
+static void FOC_SelectCurrController(uint8_t bMotor)
 {
-   hBootCapDelayCounterM1 = hTickCount;
-}
+  int16_t hSpeed = SPD_GetAvrgMecSpeedUnit(STC_GetSpeedSensor(pSTC[bMotor]));
 
-/**
-  * @brief  Use this function to know whether the time required to charge boot
-  *         capacitors of motor 1 has elapsed
-  * @param  none
-  * @retval bool true if time has elapsed, false otherwise
-  */
-__weak bool TSK_ChargeBootCapDelayHasElapsedM1(void)
-{
-  bool retVal = false;
-  if (((uint16_t)0) == hBootCapDelayCounterM1)
+  hSpeed = (hSpeed < 0) ? -hSpeed : hSpeed;
+#ifdef M1_HFI_SENSOR
+  if (&HFI_M1._Super == STC_GetSpeedSensor(pSTC[bMotor]))
   {
-    retVal = true;
+    /* The carrier only rides on the voltage of the PI controllers */
+    pCRG[bMotor]->PCCSelected = false;
   }
-  return (retVal);
+  else
+#endif
+  if (hSpeed >= PCC_GetEngageSpeed(pPCC[bMotor]))
+  {
+    pCRG[bMotor]->PCCSelected = true;
+  }
+  else if (hSpeed < PCC_GetDisengageSpeed(pPCC[bMotor]))
+  {
+    pCRG[bMotor]->PCCSelected = false;
+  }
+  else
+  {
+    /* Nothing to do, hysteresis band */
+  }
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  PCC_SelectWeights(pPCC[bMotor], hSpeed, FOCVars[bMotor].Iqdref.q);
+#endif
+#ifdef PCC_ADAPTIVE_PERIOD
+  PCC_SelectPeriod(pPCC[bMotor], hSpeed);
+#endif
 }
+#endif
 
 /**
-  * @brief  It set a counter intended to be used for counting the permanency
-  *         time in STOP state of motor 1
-  * @param  hTickCount number of ticks to be counted
-  * @retval void
+  * @brief  It sets the speed sensor of the speed controller of Motor 1 and
+  *         publishes it to the high frequency task, that reads it with one load
+  *         instead of calling STC_GetSpeedSensor() at every FOC period.
+  * @param  pSensor speed sensor of the speed controller
+  * @retval none
   */
-__weak void TSK_SetStopPermanencyTimeM1(uint16_t hTickCount)
+static void TSK_SetSpeedSensorM1(SpeednPosFdbk_Handle_t *pSensor)
 {
-  hStopPermanencyCounterM1 = hTickCount;
+  STC_SetSpeedSensor(pSTC[M1], pSensor);
+  pSpeedSensorM1 = pSensor;
 }
 
+#ifdef COAST_M1
 /**
-  * @brief  Use this function to know whether the permanency time in STOP state
-  *         of motor 1 has elapsed
-  * @param  none
-  * @retval bool true if time is elapsed, false otherwise
+  * @brief  It switches the PWM of Motor 1 off once the torque reference of the torque
+  *         mode has been null for COAST_ENTRY_MS, at a speed the observer holds and at
+  *         which the back-EMF stays below the bus: the rotor then coasts without any
+  *         switching, and the high frequency task stops with the PWM. Called by the
+  *         medium frequency task in RUN, after the references.
+  * @param  IsSpeedReliable reliability of the observer in this period
+  * @retval none
   */
-__weak bool TSK_StopPermanencyTimeHasElapsedM1(void)
+static void TSK_EnterCoastM1(bool IsSpeedReliable)
 {
-  bool retVal = false;
-  if (((uint16_t)0) == hStopPermanencyCounterM1)
+  int32_t wSpeedUnit = (int32_t)SPD_GetAvrgMecSpeedUnit(&STO_PLL_M1._Super);
+  int32_t wAbsSpeedUnit = (wSpeedUnit < 0) ? -wSpeedUnit : wSpeedUnit;
+
+  if ((STC_TORQUE_MODE != STC_GetControlMode(pSTC[M1])) || (INTERNAL != FOCVars[M1].bDriveInput)
+      || (FOCVars[M1].hTeref != 0) || (FOCVars[M1].UserIdref != 0) || (false == IsSpeedReliable)
+      || (pSpeedSensorM1 != &STO_PLL_M1._Super) || (wAbsSpeedUnit < (int32_t)FLYING_START_MIN_SPEED_UNIT)
+      || (wAbsSpeedUnit > (int32_t)COAST_MAX_SPEED_UNIT))
   {
-    retVal = true;
+    hCoastTicksM1 = COAST_ENTRY_TICKS;
   }
-  return (retVal);
-}
-
-#if defined (CCMRAM)
-#if defined (__ICCARM__)
+  else if (hCoastTicksM1 > 0U)
+  {
+    hCoastTicksM1--;
+  }
+  else
+  {
+    qd_t NULL_qd = {((int16_t)0), ((int16_t)0)};
+
+    PWMC_SwitchOffPWM(pwmcHandle[M1]);
+    /* The last FOC period is over: the estimate of the observer is held from now on */
+    hCoastSpeedDppM1 = SPD_GetElSpeedDpp(&STO_PLL_M1._Super);
+    wCoastAngleM1 = (uint32_t)(uint16_t)SPD_GetElAngle(&STO_PLL_M1._Super) << 8U;
+    FOCVars[M1].Iqd = NULL_qd;
+    FOCVars[M1].Iqdref = NULL_qd;
+    FOCVars[M1].Vqd = NULL_qd;
+    CoastingM1 = true;
+  }
+}
+
+/**
+  * @brief  It propagates the angle of the coasting Motor 1 at the speed held, and
+  *         re-engages through the flying start as soon as the torque reference leaves
+  *         zero: the zero currents of START then last COAST_CATCH_MS, with the PLL of
+  *         the observer seeded with the propagated angle. A rotor that slowed down below
+  *         FLYING_START_MIN_SPEED_RPM in the meantime is started by the rev-up. Called
+  *         by the medium frequency task in RUN, instead of the references.
+  * @param  none
+  * @retval none
+  */
+static void TSK_CoastM1(void)
+{
+  MCI_ExecBufferedCommands(&Mci[M1]);
+  /* The torque ramp goes on while coasting */
+  FOCVars[M1].hTeref = STC_CalcTorqueReference(pSTC[M1]);
+  wCoastAngleM1 += (uint32_t)((int32_t)hCoastSpeedDppM1 * COAST_OBS_PERIODS_PER_TICK);
+
+  if ((STC_TORQUE_MODE == STC_GetControlMode(pSTC[M1])) && (INTERNAL == FOCVars[M1].bDriveInput)
+      && (0 == FOCVars[M1].hTeref) && (0 == FOCVars[M1].UserIdref))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    FOC_Clear(M1);
+    TSK_SetSpeedSensorM1(&VirtualSpeedSensorM1._Super);
+    STO_SetPLL(&STO_PLL_M1, hCoastSpeedDppM1, (int16_t)(wCoastAngleM1 >> 8U));
+    VSS_SetCopyObserver(&VirtualSpeedSensorM1);
+    STO_SetDirection(&STO_PLL_M1, (int8_t)MCI_GetImposedMotorDirection(&Mci[M1]));
+    hFlyingCatchTicksM1 = COAST_CATCH_TICKS;
+    FlyingCatchM1 = true;
+    ObserverFreeRunM1 = true;
+    Mci[M1].State = START;
+    PWMC_SwitchOnPWM(pwmcHandle[M1]);
+  }
+}
+#endif
+
+#ifdef STANDSTILL_SENSOR_M1
+/**
+  * @brief  It closes the speed loop of Motor 1 on the low speed sensor, the
+  *         aligned encoder or the injection once the polarity is known, and
+  *         moves the state machine to RUN, without rev-up.
+  * @param  none
+  * @retval none
+  */
+static void TSK_CloseStandstillLoopM1(void)
+{
+  PID_SetIntegralTerm(&PIDSpeedHandle_M1, 0);
+  /* The alignment left the torque mode */
+  STC_SetControlMode(pSTC[M1], MCI_GetControlMode(&Mci[M1]));
+  TSK_SetSpeedSensorM1(STANDSTILL_SENSOR_M1);
+  STO_SetDirection(&STO_PLL_M1, (int8_t)MCI_GetImposedMotorDirection(&Mci[M1]));
+  FOC_InitAdditionalMethods(M1);
+  FOC_CalcCurrRef(M1);
+  STC_ForceSpeedReferenceToCurrentSpeed(pSTC[M1]);
+#ifdef M1_POSITION_CTRL
+  /* The regulation of the previous run is not resumed: a position command
+     already executed is executed again, from the angle the rotor stopped at */
+  TC_Clear(&PosCtrlM1);
+  if (MCI_CMD_EXECPOSITIONCMD == Mci[M1].lastCommand)
+  {
+    Mci[M1].CommandState = MCI_COMMAND_NOT_ALREADY_EXECUTED;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+  MCI_ExecBufferedCommands(&Mci[M1]);
+  Mci[M1].State = RUN;
+}
+
+/**
+  * @brief  It hands the speed and position feedback of Motor 1 over from the
+  *         low speed sensor to the observer above SENSORLESS_SWITCH_SPEED_RPM,
+  *         once the observer tracks its speed, and back to the low speed sensor
+  *         below SENSORLESS_SWITCH_BACK_RPM. The encoder angle is computed, and
+  *         the injection angle follows the observer, at every observer run, so
+  *         that they are still valid at the switch back.
+  *         It must be called by the medium frequency task in RUN state, after
+  *         the speeds of both sensors are computed.
+  * @param  none
+  * @retval none
+  */
+static void TSK_SelectSpeedSensorM1(void)
+{
+#if (SENSORLESS_SWITCH_SPEED_RPM > 0)
+  int16_t hSpeed = SPD_GetAvrgMecSpeedUnit(STANDSTILL_SENSOR_M1);
+  int16_t hAbsSpeed = (hSpeed < 0) ? -hSpeed : hSpeed;
+
+  if (STANDSTILL_SENSOR_M1 == STC_GetSpeedSensor(pSTC[M1]))
+  {
+    if (hAbsSpeed > (int16_t)SENSORLESS_SWITCH_SPEED_UNIT)
+    {
+      if (true == STO_PLL_IsObserverConverged(&STO_PLL_M1, &hSpeed))
+      {
+        TSK_SetSpeedSensorM1(&STO_PLL_M1._Super);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else if (hAbsSpeed < (int16_t)SENSORLESS_SWITCH_BACK_UNIT)
+  {
+    TSK_SetSpeedSensorM1(STANDSTILL_SENSOR_M1);
+  }
+  else
+  {
+    /* Nothing to do, hysteresis band */
+  }
+#endif
+}
+#endif
+
+/**
+  * @brief  It set a counter intended to be used for counting the delay required
+  *         for drivers boot capacitors charging of motor 1
+  * @param  hTickCount number of ticks to be counted
+  * @retval void
+  */
+__weak void TSK_SetChargeBootCapDelayM1(uint16_t hTickCount)
+{
+   wBootCapDelayStartM1 = wSchedulerTicks;
+   hBootCapDelayM1 = hTickCount;
+}
+
+/**
+  * @brief  Use this function to know whether the time required to charge boot
+  *         capacitors of motor 1 has elapsed
+  * @param  none
+  * @retval bool true if time has elapsed, false otherwise
+  */
+__weak bool TSK_ChargeBootCapDelayHasElapsedM1(void)
+{
+  bool retVal = false;
+  /* The unsigned difference also holds across an overflow of the tick count */
+  if ((wSchedulerTicks - wBootCapDelayStartM1) >= (uint32_t)hBootCapDelayM1)
+  {
+    retVal = true;
+  }
+  return (retVal);
+}
+
+/**
+  * @brief  It set a counter intended to be used for counting the permanency
+  *         time in STOP state of motor 1
+  * @param  hTickCount number of ticks to be counted
+  * @retval void
+  */
+__weak void TSK_SetStopPermanencyTimeM1(uint16_t hTickCount)
+{
+  wStopPermanencyStartM1 = wSchedulerTicks;
+  hStopPermanencyM1 = hTickCount;
+}
+
+/**
+  * @brief  Use this function to know whether the permanency time in STOP state
+  *         of motor 1 has elapsed
+  * @param  none
+  * @retval bool true if time is elapsed, false otherwise
+  */
+__weak bool TSK_StopPermanencyTimeHasElapsedM1(void)
+{
+  bool retVal = false;
+  /* The unsigned difference also holds across an overflow of the tick count */
+  if ((wSchedulerTicks - wStopPermanencyStartM1) >= (uint32_t)hStopPermanencyM1)
+  {
+    retVal = true;
+  }
+  return (retVal);
+}
+
+/**
+  * @brief  Returns the time from the power on, or more exactly from HAL_Init, at which
+  *         motor 1 was first ready to start: boot completed and the current offsets
+  *         measured by MC_BOOT_OFFSET_CALIB. The first start then reaches the torque
+  *         after the charge of the bootstrap capacitors only.
+  * @retval uint16_t Time in ms, 0 while not ready yet
+  */
+__weak uint16_t TSK_GetReadyTimeM1(void)
+{
+  return ((true == ReadyM1) ? hReadyTimeM1 : 0U);
+}
+
+/**
+  * @brief  Returns the time motor 1 took to close the speed loop at its last start,
+  *         from the start command to the RUN state: offset measurement if any,
+  *         charge of the bootstrap capacitors, rev-up and observer convergence,
+  *         switch over. It is the figure of merit of the start-up tuning.
+  * @retval uint16_t Time in ms, 0 until a start reaches RUN
+  */
+__weak uint16_t TSK_GetStartUpTimeM1(void)
+{
+  return (hStartUpTimeM1);
+}
+
+#ifdef MC_LOW_POWER_IDLE
+/**
+  * @brief  Enters or leaves the low power idle of motor 1. The ADC and PWM interrupts
+  *         are already stopped with the PWM: the peripherals only used while it runs,
+  *         TIM1, are then no longer clocked while the CPU sleeps.
+  *         The clocks of the peripherals are only gated in Sleep mode, so that the
+  *         tasks run as usual whenever the CPU is awake.
+  * @param  LowPower true to enter the low power idle
+  */
+static void TSK_SetLowPowerM1(bool LowPower)
+{
+  if (LowPower == LowPowerM1)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    if (true == LowPower)
+    {
+      __HAL_RCC_TIM1_CLK_SLEEP_DISABLE();
+    }
+    else
+    {
+      __HAL_RCC_TIM1_CLK_SLEEP_ENABLE();
+    }
+    LowPowerM1 = LowPower;
+  }
+}
+
+/**
+  * @brief  Returns true while motor 1 is in the low power idle: IDLE state, boot
+  *         completed and no command pending. The main loop may then sleep until
+  *         the next interrupt.
+  */
+__weak bool TSK_IsLowPowerIdle(void)
+{
+  return (LowPowerM1);
+}
+#endif
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
 #pragma location = ".ccmram"
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section (".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 
 /**
@@ -859,6 +2095,21 @@ __weak uint8_t TSK_HighFrequencyTask(void)
 
   Observer_Inputs_t STO_Inputs; /*  only if sensorless main*/
 
+#ifdef MC_STACK_MODE
+  MC_Stack_MarkHF();
+#endif
+#ifdef DBG_MCU_LOAD_MEASURE
+  MC_Perf_Task_Start(&PerfTraces, (uint8_t)JITTER_TSK_HighFrequencyTask);
+  MC_Perf_Load_Start(&PerfTraces, (uint8_t)LOAD_TSK_HighFrequencyTask);
+#endif
+  MC_TRACE_SPAN_START(MEASURE_TSK_HighFrequencyTask);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_SPLIT_PHASE)
+  HFTaskBusyM1 = true;
+#endif
+#ifdef MC_ABTEST_MODE
+  MC_ABTest_StartPeriod();
+#endif
+
   STO_Inputs.Valfa_beta = FOCVars[M1].Valphabeta;  /* only if sensorless*/
   if (SWITCH_OVER == Mci[M1].State)
   {
@@ -867,10 +2118,45 @@ __weak uint8_t TSK_HighFrequencyTask(void)
       FOCVars[M1].Iqdref.q = (int16_t)REMNG_Calc(pREMNG[M1]);
     }
   }
+#ifdef MCI_SETPOINT_STREAM
+  MCI_ExecStream(&Mci[M1]);
+#endif
   /* USER CODE BEGIN HighFrequencyTask SINGLEDRIVE_1 */
 
   /* USER CODE END HighFrequencyTask SINGLEDRIVE_1 */
-  hFOCreturn = FOC_CurrControllerM1();
+#ifdef MC_PIL_MODE
+  if (true == MC_Pil_IsHolding())
+  {
+    /* Between the steps of the processor in the loop, the PWM keeps its last voltage */
+    hFOCreturn = MC_NO_FAULTS;
+  }
+  else
+#endif
+  {
+#ifdef MC_DTCALIB_MODE
+    if (DT_CALIBRATING == Mci[M1].State)
+    {
+      /* The dead time calibration regulates the currents on the axis of a phase */
+      hFOCreturn = FOC_DTCalibControllerM1();
+    }
+    else
+#endif
+#ifdef MC_ADCCALIB_MODE
+    if (ADC_CALIBRATING == Mci[M1].State)
+    {
+      /* The ADC timing calibration applies a constant voltage between its alignments */
+      hFOCreturn = FOC_ADCCalibControllerM1();
+    }
+    else
+#endif
+#ifdef MC_COMMISSION_MODE
+    /* The standstill phases of the commissioning regulate the currents at a fixed angle */
+    hFOCreturn = ((COMMISSIONING == Mci[M1].State) && (true == MC_Commission_IsStandstill()))
+               ? FOC_CommissionControllerM1() : FOC_CurrControllerM1();
+#else
+    hFOCreturn = FOC_CurrControllerM1();
+#endif
+  }
   /* USER CODE BEGIN HighFrequencyTask SINGLEDRIVE_2 */
 
   /* USER CODE END HighFrequencyTask SINGLEDRIVE_2 */
@@ -880,17 +2166,45 @@ __weak uint8_t TSK_HighFrequencyTask(void)
   }
   else
   {
+#if defined(M1_ENCODER_SENSOR)
+    (void)ENC_CalcAngle(&ENCODER_M1);
+#elif !defined(M1_HFI_SENSOR)
     bool IsAccelerationStageReached = RUC_FirstAccelerationStageReached(&RevUpControlM1);
+#endif
     STO_Inputs.Ialfa_beta = FOCVars[M1].Ialphabeta; /*  only if sensorless*/
     STO_Inputs.Vbus = VBS_GetAvBusVoltage_d(&(BusVoltageSensor_M1._Super)); /*  only for sensorless*/
     (void)( void )STO_PLL_CalcElAngle(&STO_PLL_M1, &STO_Inputs);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_SHARED_MODEL)
+    /* The back-EMF of the observer model is the one of the next prediction */
+    PCC_SetBemfStep(pPCC[M1], MCM_Park(STO_PLL_GetBemfCurrentStep(&STO_PLL_M1), FOCVars[M1].hElAngle));
+#endif
     STO_PLL_CalcAvrgElSpeedDpp(&STO_PLL_M1); /*  Only in case of Sensor-less */
+    /* Alongside the low speed sensor, the PLL is never reset: it locks on its own
+       for the sensorless switch-over */
+#ifndef STANDSTILL_SENSOR_M1
+#if (FLYING_START_ENABLING == ENABLE)
+    if ((false == IsAccelerationStageReached) && (false == ObserverFreeRunM1))
+#else
 	 if (false == IsAccelerationStageReached)
+#endif
     {
       STO_ResetPLL(&STO_PLL_M1);
     }
+#endif
+#ifdef M1_HFI_SENSOR
+    if (&HFI_M1._Super == pSpeedSensorM1)
+    {
+      (void)HFI_CalcElAngle(&HFI_M1);
+    }
+    else
+    {
+      /* The PLL of the injection resumes from the observer at the switch back */
+      HFI_SetElAngle(&HFI_M1, SPD_GetElAngle(&STO_PLL_M1._Super), SPD_GetInstElSpeedDpp(&STO_PLL_M1._Super));
+    }
+#endif
     /*  only for sensor-less*/
-    if(((uint16_t)START == Mci[M1].State) || ((uint16_t)SWITCH_OVER == Mci[M1].State))
+    if(((uint16_t)START == Mci[M1].State) || ((uint16_t)SWITCH_OVER == Mci[M1].State)
+       || ((uint16_t)COMMISSIONING == Mci[M1].State))
     {
       int16_t hObsAngle = SPD_GetElAngle(&STO_PLL_M1._Super);
       (void)VSS_CalcElAngle(&VirtualSpeedSensorM1, &hObsAngle);
@@ -903,7 +2217,47 @@ __weak uint8_t TSK_HighFrequencyTask(void)
 
   /* USER CODE END HighFrequencyTask 1 */
 
+#ifdef MC_CAPTURE_MODE
+  MC_Capture_Record(MCI_GetCurrentFaults(&Mci[M1]));
+#endif
+#ifdef MC_FRA_MODE
+  MC_Fra_Measure(RUN == Mci[M1].State);
+#endif
+#ifdef MC_ABTEST_MODE
+  MC_ABTest_Measure(RUN == Mci[M1].State, pCRG[M1]->PCCEngaged, &FOCVars[M1], pwmcHandle[M1]);
+#endif
+
   GLOBAL_TIMESTAMP++;
+#ifdef MC_TIMEBASE_MODE
+  MC_Time_Tick();
+#endif
+  /* TSK_HighFrequencyDeferredTask runs as soon as this interrupt returns */
+  SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+
+#ifdef DBG_MCU_LOAD_MEASURE
+  MC_Perf_CheckFpu(&PerfTraces);
+  MC_Perf_Load_Stop(&PerfTraces, (uint8_t)LOAD_TSK_HighFrequencyTask);
+#endif
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_SPLIT_PHASE)
+  HFTaskBusyM1 = false;
+#endif
+  MC_TRACE_SPAN_STOP(MEASURE_TSK_HighFrequencyTask);
+  return (bMotorNbr);
+}
+
+/**
+  * @brief  Executes the high frequency duties that do not require a precise timing:
+  *         the MCPA datalog
+  *
+  *  It is run by the PendSV exception, requested at the end of TSK_HighFrequencyTask.
+  * The PendSV priority is below the ADC one: these duties run right after the FOC
+  * loop but never delay the next one.
+  */
+__weak void TSK_HighFrequencyDeferredTask(void)
+{
+#ifdef DBG_MCU_LOAD_MEASURE
+  MC_Perf_Load_Start(&PerfTraces, (uint8_t)LOAD_TSK_HighFrequencyDeferredTask);
+#endif
   if (0U == MCPA_UART_A.Mark)
   {
     /* Nothing to do */
@@ -912,8 +2266,13 @@ __weak uint8_t TSK_HighFrequencyTask(void)
   {
     MCPA_dataLog (&MCPA_UART_A);
   }
-
-  return (bMotorNbr);
+#ifdef MC_REPORT_MODE
+  /* Between two buffers of the datalog */
+  MC_Report_Send(&MCPA_UART_A);
+#endif
+#ifdef DBG_MCU_LOAD_MEASURE
+  MC_Perf_Load_Stop(&PerfTraces, (uint8_t)LOAD_TSK_HighFrequencyDeferredTask);
+#endif
 }
 
 #if defined (CCMRAM)
@@ -922,6 +2281,8 @@ __weak uint8_t TSK_HighFrequencyTask(void)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section (".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief It executes the core of FOC drive that is the controllers for Iqd
@@ -934,101 +2295,639 @@ __attribute__((section (".ccmram")))
   */
 inline uint16_t FOC_CurrControllerM1(void)
 {
-	volatile qd_t Iqd, Vqd, VqdTemp;
-	volatile int costTemp1,costTemp2,cost;
-	ab_t Iab;
-	alphabeta_t Ialphabeta, Valphabeta;
-
+  qd_t Iqd, Vqd;
+  ab_t Iab;
+  alphabeta_t Ialphabeta, Valphabeta;
+  Trig_Components Trig;
+#if (REV_PARK_ANGLE_COMPENSATION_FACTOR != 0)
+  Trig_Components TrigBatch[2];
+  int16_t hTrigAngles[2];
+#endif
 
-	int16_t hElAngle;
-	uint16_t hCodeError;
-	SpeednPosFdbk_Handle_t *speedHandle;
+  int16_t hElAngle;
+  int16_t hElSpeedDpp;
+  uint16_t hCodeError;
+  SpeednPosFdbk_Handle_t *speedHandle;
+#ifdef M1_HFI_SENSOR
+  bool IsInjecting;
+#endif
+#ifdef MC_RECORD_MODE
+  MC_Record_Frame_t RecordFrame;
+  bool IsRecording = (MC_RECORD_RECORDING == MC_Record_GetState());
+#endif
+#ifdef MC_PIL_MODE
+  const MC_Pil_Input_t *pPilInput = MC_Pil_StartStep();
+#endif
+#ifdef MC_FAULTLOG_MODE
+  MC_FaultLog_Snapshot_t Snapshot;
+#endif
 
-	speedHandle = STC_GetSpeedSensor(pSTC[M1]);
-	hElAngle = SPD_GetElAngle(speedHandle);
-	hElAngle += SPD_GetInstElSpeedDpp(speedHandle)*PARK_ANGLE_COMPENSATION_FACTOR;
-	PWMC_GetPhaseCurrents(pwmcHandle[M1], &Iab);
-	Ialphabeta = MCM_Clarke(Iab);
-	Iqd = MCM_Park(Ialphabeta, hElAngle);
+  speedHandle = pSpeedSensorM1;
+  /* Angle at the sampling of the currents */
+  hElAngle = SPD_GetElAngleAt(speedHandle, PARK_ANGLE_COMPENSATION_FACTOR * SPD_PERIOD_FRACTION);
+  hElSpeedDpp = SPD_GetInstElSpeedDpp(speedHandle);
+#ifdef MC_PIL_MODE
+  if (MC_NULL != pPilInput)
+  {
+    /* Angle and speed of the plant model of the host */
+    hElAngle = pPilInput->hElAngle;
+    hElSpeedDpp = pPilInput->hElSpeedDpp;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+  MC_TRACE_SPAN_START(MEASURE_FOC_ReadCurrents);
+#if (REV_PARK_ANGLE_COMPENSATION_FACTOR == 0)
+  /* The sine and cosine of the angle are computed while the currents are read */
+  MCM_Trig_Request(hElAngle);
+#else
+  /* The voltage is applied REV_PARK_ANGLE_COMPENSATION_FACTOR periods after the sampling:
+     the sine and cosine of both angles are computed in one call after the currents */
+  hTrigAngles[0] = hElAngle;
+  hTrigAngles[1] = SPD_GetElAngleAt(speedHandle, (PARK_ANGLE_COMPENSATION_FACTOR + REV_PARK_ANGLE_COMPENSATION_FACTOR)
+                                                     * SPD_PERIOD_FRACTION);
+#endif
+  PWMC_GetPhaseCurrents(pwmcHandle[M1], &Iab);
+#ifdef MC_PIL_MODE
+  if (MC_NULL != pPilInput)
+  {
+    /* The currents are still read, for the sequence of the ADC, then replaced */
+    Iab.a = pPilInput->hIa;
+    Iab.b = pPilInput->hIb;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+  MC_TRACE_SPAN_STOP(MEASURE_FOC_ReadCurrents);
+#ifdef DBG_MCU_LOAD_MEASURE
+  MC_Perf_CurrentNoise(&PerfTraces, Iab);
+#endif
+#ifdef MC_SPECTRUM_MODE
+  MC_Spectrum_Sample(Iab.a, RUN == Mci[M1].State);
+#endif
+  MC_TRACE_SPAN_START(MEASURE_FOC_Park);
+#if (REV_PARK_ANGLE_COMPENSATION_FACTOR == 0)
+  Trig = MCM_Trig_Collect(hElAngle);
+#else
+  MCM_CALL(MCM_Trig_Functions_Batch)(hTrigAngles, TrigBatch, 2U);
+  Trig = TrigBatch[0];
+#endif
+  Iqd = MCM_CALL(MCM_ClarkePark_Trig)(Iab, Trig, &Ialphabeta);
+#ifdef M1_HFI_SENSOR
+  /* Below the sensorless switch speed, the regulators see the currents without the
+     ripple of the carrier, added to their voltage */
+  IsInjecting = (&HFI_M1._Super == speedHandle);
+  if (true == IsInjecting)
+  {
+    Iqd = HFI_SplitCurrents(&HFI_M1, Iqd);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+  MC_TRACE_SPAN_STOP(MEASURE_FOC_Park);
+  MC_TRACE_SPAN_START(MEASURE_FOC_Predict);
 
+#ifdef MC_RECORD_MODE
+  if (true == IsRecording)
+  {
+    /* Inputs of the regulation, before it consumes the references */
+    RecordFrame.hIa = Iab.a;
+    RecordFrame.hIb = Iab.b;
+    RecordFrame.hElAngle = hElAngle;
+    RecordFrame.hElSpeedDpp = hElSpeedDpp;
+    RecordFrame.hIqref = FOCVars[M1].Iqdref.q;
+    RecordFrame.hIdref = FOCVars[M1].Iqdref.d;
+    RecordFrame.hBusVoltage_d = VBS_GetAvBusVoltage_d(&(BusVoltageSensor_M1._Super));
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+#ifdef HARMONIC_COMPENSATION
+  HCM_Update(pHCM[M1], hElAngle, hElSpeedDpp);
+#endif
+  Vqd = CRG_Regulate(pCRG[M1], Iqd, FOCVars[M1].Iqdref, FOCVars[M1].Vqd, Trig, hElSpeedDpp);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  MC_TRACE_LEVEL(MC_TRACE_PCC_ENGAGED, pCRG[M1]->PCCEngaged);
+#endif
+#ifdef M1_HFI_SENSOR
+  if (true == IsInjecting)
+  {
+    Vqd = HFI_Inject(&HFI_M1, Vqd);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+#ifdef SIX_STEP_MODE
+  if (true == SSM_Update(pSSM[M1], Vqd, pFW[M1]->hMaxModule, hElSpeedDpp))
+  {
+    uint8_t bVertexState;
+
+    /* The flux weakening keeps regulating the request, as below the mode */
+    Vqd = Circle_Limitation(pCLM[M1], Vqd);
+    MC_TRACE_SPAN_STOP(MEASURE_FOC_Predict);
+    MC_TRACE_SPAN_START(MEASURE_FOC_Write);
+    /* The vertex nearest to the mean request is held over the whole period: the
+       legs only commute when it changes, six times per electrical revolution */
+    Valphabeta = MCM_CALL(MCM_Rev_Park_Trig)(SSM_GetRequest(pSSM[M1]), Trig);
+    bVertexState = SSM_SelectVertex(pSSM[M1], Valphabeta);
+    MC_TRACE_MODE(MC_TRACE_MODE_SIX_STEP);
+    MC_TRACE_VECTOR(bVertexState, bVertexState);
+    Valphabeta = SSM_GetVoltage(pSSM[M1]);
+#ifdef MC_PWM_DITHER_MODE
+    MC_PwmDither_Stop();
+#endif
+    hCodeError = PWMC_SetDwellTimes(pwmcHandle[M1], bVertexState, bVertexState, 32768U, 0U);
+  }
+  else
+#endif
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  if (true == pCRG[M1]->PCCEngaged)
+  {
+    MC_TRACE_SPAN_STOP(MEASURE_FOC_Predict);
+    MC_TRACE_SPAN_START(MEASURE_FOC_Write);
+    /* The switching state of the optimal vector is written as is: the vector needs
+       neither the circle limitation nor the space vector modulation */
+    Valphabeta = PCC_GetVectorVoltage(pPCC[M1]);
+#ifdef MC_PWM_DITHER_MODE
+    MC_PwmDither_Stop();
+#endif
+    MC_TRACE_MODE(MC_TRACE_MODE_PCC_VECTOR);
+    MC_TRACE_VECTOR(PCC_GetSwitchingState(pPCC[M1]), PCC_GetSwitchingState(pPCC[M1]));
+    hCodeError = PWMC_SetSwitchingState(pwmcHandle[M1], PCC_GetSwitchingState(pPCC[M1]));
+  }
+  else
+#elif (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_FULL_HEXAGON)
+  if (true == pCRG[M1]->PCCEngaged)
+  {
+    MC_TRACE_SPAN_STOP(MEASURE_FOC_Predict);
+    MC_TRACE_SPAN_START(MEASURE_FOC_Write);
+    /* The dwell times are written as they are, up to the vertices of the hexagon:
+       they need neither the circle limitation nor the space vector modulation */
+    Valphabeta = MCM_CALL(MCM_Rev_Park_Trig)(Vqd, Trig);
+#ifdef MC_PWM_DITHER_MODE
+    MC_PwmDither_Stop();
+#endif
+    MC_TRACE_MODE(MC_TRACE_MODE_PCC_DWELL);
+    MC_TRACE_VECTOR(PCC_GetDwellState(pPCC[M1], 0U), PCC_GetDwellState(pPCC[M1], 1U));
+    hCodeError = PWMC_SetDwellTimes(pwmcHandle[M1], PCC_GetDwellState(pPCC[M1], 0U), PCC_GetDwellState(pPCC[M1], 1U),
+                                    PCC_GetDwellTime(pPCC[M1], 0U), PCC_GetDwellTime(pPCC[M1], 1U));
+  }
+  else
+#endif
+  {
+    Vqd = Circle_Limitation(pCLM[M1], Vqd);
+    MC_TRACE_SPAN_STOP(MEASURE_FOC_Predict);
+    MC_TRACE_SPAN_START(MEASURE_FOC_Write);
+#if (REV_PARK_ANGLE_COMPENSATION_FACTOR == 0)
+    /* Same angle as the Park transformation: its sine and cosine are reused */
+    Valphabeta = MCM_CALL(MCM_Rev_Park_Trig)(Vqd, Trig);
+#else
+    /* Angle and sine and cosine computed with the ones of the Park transformation */
+    hElAngle = hTrigAngles[1];
+    Valphabeta = MCM_CALL(MCM_Rev_Park_Trig)(Vqd, TrigBatch[1]);
+#endif
+#ifdef MC_PWM_DITHER_MODE
+    /* Loaded with the duty cycles at the next update event */
+    MC_PwmDither_Next();
+#endif
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+    MC_TRACE_MODE((true == pCRG[M1]->PCCEngaged) ? MC_TRACE_MODE_PCC : MC_TRACE_MODE_PI);
+#else
+    MC_TRACE_MODE(MC_TRACE_MODE_PI);
+#endif
+    hCodeError = PWMC_SetPhaseVoltage(pwmcHandle[M1], Valphabeta);
+  }
+  MC_TRACE_SPAN_STOP(MEASURE_FOC_Write);
+#if ((CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_FULL_HEXAGON)) || defined (SIX_STEP_MODE)
+  /* Currents used by the _OVM sampling of the next period for the phases whose
+     low side is not on long enough */
+  PWMC_CalcPhaseCurrentsEst(pwmcHandle[M1], Iqd, hElAngle);
+#endif
 
-	int speedRPM = SPEED_UNIT_2_RPM(SPD_GetAvrgMecSpeedUnit(speedHandle));
-	int16_t wr = SPEED_UNIT_2_RPM(MC_GetMecSpeedAverageMotor1())/9.55;
+  hCodeError |= CRG_RegulationDone(pCRG[M1], Iqd, Vqd);
+#ifdef HARMONIC_COMPENSATION
+  HCM_Learn(pHCM[M1], Vqd);
+#endif
+  FW_DataProcess(pFW[M1], Vqd);
+
+  FOCVars[M1].Vqd = Vqd;
+  FOCVars[M1].Iab = Iab;
+  FOCVars[M1].Ialphabeta = Ialphabeta;
+  FOCVars[M1].Iqd = Iqd;
+  FOCVars[M1].Valphabeta = Valphabeta;
+  FOCVars[M1].hElAngle = hElAngle;
+  PQD_AccumulateElPower(pMPM[M1], Ialphabeta, Valphabeta);
+  FOC_PublishSnapshot(&FOCVars[M1]);
+#ifdef MC_PIL_MODE
+  if (MC_NULL != pPilInput)
+  {
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    MC_Pil_EndStep(Vqd, Valphabeta,
+                   (true == pCRG[M1]->PCCEngaged) ? PCC_GetSwitchingState(pPCC[M1]) : MC_PIL_NO_VECTOR,
+                   (true == pCRG[M1]->PCCEngaged) ? MC_PIL_FLAG_PCC : 0U);
+#elif (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+    MC_Pil_EndStep(Vqd, Valphabeta, MC_PIL_NO_VECTOR, (true == pCRG[M1]->PCCEngaged) ? MC_PIL_FLAG_PCC : 0U);
+#else
+    MC_Pil_EndStep(Vqd, Valphabeta, MC_PIL_NO_VECTOR, 0U);
+#endif
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+#ifdef MC_RECORD_MODE
+  if (true == IsRecording)
+  {
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+    RecordFrame.hFlags = (true == pCRG[M1]->PCCEngaged) ? MC_RECORD_FLAG_PCC : 0U;
+#else
+    RecordFrame.hFlags = 0U;
+#endif
+    RecordFrame.hVq = Vqd.q;
+    RecordFrame.hVd = Vqd.d;
+    MC_Record_Write(&RecordFrame);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+#ifdef MC_FAULTLOG_MODE
+  Snapshot.hIa = Iab.a;
+  Snapshot.hIb = Iab.b;
+  Snapshot.hIq = Iqd.q;
+  Snapshot.hId = Iqd.d;
+  Snapshot.hIqref = FOCVars[M1].Iqdref.q;
+  Snapshot.hIdref = FOCVars[M1].Iqdref.d;
+  Snapshot.hVq = Vqd.q;
+  Snapshot.hVd = Vqd.d;
+  Snapshot.hElAngle = hElAngle;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  Snapshot.hDecision = (true == pCRG[M1]->PCCEngaged) ? pPCC[M1]->hLogDecision : 0U;
+#else
+  Snapshot.hDecision = 0U;
+#endif
+  MC_FaultLog_Write(&Snapshot);
+#endif
 
-	/* Omkar code start */
+  return(hCodeError);
+}
 
-	if(!hasMPCinit){
-		hasMPCinit = 1;
-		initModelPredictiveControl();
-	}
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_SPLIT_PHASE)
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
+/**
+  * @brief  It computes the terms of the next prediction of the predictive current
+  *         controller that do not depend on the measured currents, see
+  *         PCC_SPLIT_PHASE: with the angle and the speed of the next
+  *         FOC_CurrControllerM1 and the voltage applied since the last one. It is
+  *         called by the update interrupt of the PWM timer, while the currents are
+  *         sampled and converted, so that the high frequency task only applies the
+  *         measurement. Nothing is done while the high frequency task runs, whose
+  *         PCC_CalcVoltage() reads the terms, nor while the predictive controller is
+  *         not engaged. The terms are computed again by PCC_CalcVoltage() when the
+  *         angle, the speed or the voltage differ, e.g. after an observer run of the
+  *         medium frequency task.
+  *         The CORDIC, when used by MCM_Trig_Functions, is taken as the high
+  *         frequency task takes it, above the medium frequency task.
+  */
+void FOC_CurrPrepareM1(void)
+{
+  SpeednPosFdbk_Handle_t *speedHandle = pSpeedSensorM1;
+  Trig_Components Trig;
+  int16_t hElAngle;
+  int16_t hElSpeedDpp;
 
+  if ((true == pCRG[M1]->PCCEngaged) && (false == HFTaskBusyM1))
+  {
+    /* The angle and the speed of the next FOC_CurrControllerM1 */
+    hElAngle = SPD_GetElAngleAt(speedHandle, PARK_ANGLE_COMPENSATION_FACTOR * SPD_PERIOD_FRACTION);
+    hElSpeedDpp = SPD_GetInstElSpeedDpp(speedHandle);
+    Trig = MCM_CALL(MCM_Trig_Functions)(hElAngle);
+    PCC_PrepareVoltage(pPCC[M1], FOCVars[M1].Vqd, Trig, hElSpeedDpp);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+#endif
 
-	if(speedRPM > 1900 || runMPC){
-		runMPC = 1;
-		HAL_GPIO_WritePin(GPIOA, GPIO_PIN_5, 1);
+#ifdef MC_COMMISSION_MODE
+/**
+  * @brief  It regulates the currents of the standstill phases of the commissioning
+  *         instead of FOC_CurrControllerM1, at the angle of the Virtual Speed Sensor at
+  *         rest. The voltage is given by MC_Commission_Exec(). Only run at
+  *         commissioning, it is left in flash.
+  * @retval uint16_t It returns MC_NO_FAULTS if the FOC has been ended before
+  *         next PWM Update event, MC_FOC_DURATION otherwise
+  */
+static uint16_t FOC_CommissionControllerM1(void)
+{
+  qd_t Iqd, Vqd;
+  ab_t Iab;
+  alphabeta_t Ialphabeta, Valphabeta;
+  Trig_Components Trig;
+  int16_t hElAngle;
+  uint16_t hCodeError;
+
+  hElAngle = SPD_GetElAngle(&VirtualSpeedSensorM1._Super);
+  MCM_Trig_Request(hElAngle);
+  PWMC_GetPhaseCurrents(pwmcHandle[M1], &Iab);
+  Trig = MCM_Trig_Collect(hElAngle);
+  Iqd = MCM_CALL(MCM_ClarkePark_Trig)(Iab, Trig, &Ialphabeta);
+
+  if (true == MC_Commission_IsRegulating())
+  {
+    FOCVars[M1].Iqdref = MC_Commission_GetCurrentRef();
+    Vqd.q = PI_Controller(pPIDIq[M1], (int32_t)(FOCVars[M1].Iqdref.q) - Iqd.q);
+    Vqd.d = PI_Controller(pPIDId[M1], (int32_t)(FOCVars[M1].Iqdref.d) - Iqd.d);
+  }
+  else
+  {
+    /* The PI controllers are frozen, their integral terms hold the voltage of the
+       last current level for the flux phase */
+    Vqd = FOCVars[M1].Vqd;
+  }
+  Vqd = Circle_Limitation(pCLM[M1], MC_Commission_Exec(Iqd, Vqd));
+  Valphabeta = MCM_CALL(MCM_Rev_Park_Trig)(Vqd, Trig);
+  hCodeError = PWMC_SetPhaseVoltage(pwmcHandle[M1], Valphabeta);
+
+  FOCVars[M1].Vqd = Vqd;
+  FOCVars[M1].Iab = Iab;
+  FOCVars[M1].Ialphabeta = Ialphabeta;
+  FOCVars[M1].Iqd = Iqd;
+  FOCVars[M1].Valphabeta = Valphabeta;
+  FOCVars[M1].hElAngle = hElAngle;
+  PQD_AccumulateElPower(pMPM[M1], Ialphabeta, Valphabeta);
+  FOC_PublishSnapshot(&FOCVars[M1]);
+
+  return (hCodeError);
+}
 
-		IqTemp = Iqd.q;
-		IdTemp = Iqd.d;
+/**
+  * @brief  It runs the commissioning of Motor 1 once the high frequency task is done
+  *         with the standstill phases: the open loop acceleration, the averaging at
+  *         MC_COMMISSION_SPEED_UNIT and the hand-over of the identified model to the
+  *         predictor. It must be called by the medium frequency task in COMMISSIONING
+  *         state.
+  * @param  none
+  * @retval none
+  */
+static void TSK_CommissionM1(void)
+{
+  int16_t hMecSpeedUnit;
 
-		cost = 2147483628;
+  switch (MC_Commission_GetPhase())
+  {
+    case MC_COMM_SPIN:
+    {
+      if (true == MC_Commission_Spin())
+      {
+        /* The PI controllers resume the d current of the standstill phases, at the
+           angle of the Virtual Speed Sensor that drags the rotor */
+        VSS_SetMecAcceleration(&VirtualSpeedSensorM1,
+                               (int16_t)(MC_COMMISSION_SPEED_UNIT * MCI_GetImposedMotorDirection(&Mci[M1])),
+                               MC_COMMISSION_RAMP_MS);
+      }
+      else
+      {
+        /* Nothing to do, MC_COMM_FAILED stops the motor at the next period */
+      }
+      break;
+    }
 
-		for(i=0;i<6;i++){
+    case MC_COMM_RAMP:
+    {
+      (void)VSS_CalcAvrgMecSpeedUnit(&VirtualSpeedSensorM1, &hMecSpeedUnit);
+      if (true == VSS_RampCompleted(&VirtualSpeedSensorM1))
+      {
+        MC_Commission_StartFlux();
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      break;
+    }
 
-			if(i<6){
-				Valphabeta.alpha = Varray[i][0];
-				Valphabeta.beta  = Varray[i][1];
+    case MC_COMM_FLUX:
+    {
+      (void)VSS_CalcAvrgMecSpeedUnit(&VirtualSpeedSensorM1, &hMecSpeedUnit);
+      MC_Commission_AccumulateFlux(FOCVars[M1].Iqd, FOCVars[M1].Vqd,
+                                   SPD_GetElSpeedDpp(&VirtualSpeedSensorM1._Super));
+      break;
+    }
 
-				VqdTemp = MCM_Park(Valphabeta, hElAngle);
-			} else {
-				VqdTemp.d = 0;
-				VqdTemp.q = 0;
-			}
+    case MC_COMM_DONE:
+    {
+      /* The rotor coasts down: the flash is written with the PWM switched off */
+      TSK_MF_StopProcessing(&Mci[M1], M1);
+      MC_Commission_Apply(pPCCEst[M1], pPCC[M1]);
+      MC_Commission_Save();
+      break;
+    }
 
-			IdPred = ((C1*IdTemp/10027) + (wr*IqTemp/2) + (c2*(VqdTemp.d)*Vphase/32767));
-			IqPred = ((C1*IqTemp/10027) - (wr*IdTemp/2) + (c2*(VqdTemp.q)*Vphase/32767));
+    case MC_COMM_FAILED:
+    {
+      TSK_MF_StopProcessing(&Mci[M1], M1);
+      break;
+    }
 
-			costTemp1 = (FOCVars[M1].Iqdref.q - IqPred);
-			costTemp2 = (FOCVars[M1].Iqdref.d - IdPred);
+    default:
+      /* The standstill phases are run by the high frequency task */
+      break;
+  }
+}
+#endif
 
-			if(costTemp1<0){
-				costTemp1 = -costTemp1;
-			}
+#ifdef MC_DTCALIB_MODE
+/**
+  * @brief  It regulates the d current of the dead time calibration instead of
+  *         FOC_CurrControllerM1, on the axis of the phase measured. The PI outputs
+  *         are averaged by MC_DTCalib_Exec(). Only run at calibration, it is left in
+  *         flash.
+  * @retval uint16_t It returns MC_NO_FAULTS if the FOC has been ended before
+  *         next PWM Update event, MC_FOC_DURATION otherwise
+  */
+static uint16_t FOC_DTCalibControllerM1(void)
+{
+  qd_t Iqd, Vqd;
+  ab_t Iab;
+  alphabeta_t Ialphabeta, Valphabeta;
+  Trig_Components Trig;
+  int16_t hElAngle;
+  uint16_t hCodeError;
+
+  hElAngle = MC_DTCalib_GetElAngle();
+  MCM_Trig_Request(hElAngle);
+  PWMC_GetPhaseCurrents(pwmcHandle[M1], &Iab);
+  Trig = MCM_Trig_Collect(hElAngle);
+  Iqd = MCM_CALL(MCM_ClarkePark_Trig)(Iab, Trig, &Ialphabeta);
+
+  FOCVars[M1].Iqdref = MC_DTCalib_GetCurrentRef();
+  Vqd.q = PI_Controller(pPIDIq[M1], (int32_t)(FOCVars[M1].Iqdref.q) - Iqd.q);
+  Vqd.d = PI_Controller(pPIDId[M1], (int32_t)(FOCVars[M1].Iqdref.d) - Iqd.d);
+  Vqd = Circle_Limitation(pCLM[M1], Vqd);
+  MC_DTCalib_Exec(Iqd, Vqd);
+  Valphabeta = MCM_CALL(MCM_Rev_Park_Trig)(Vqd, Trig);
+  hCodeError = PWMC_SetPhaseVoltage(pwmcHandle[M1], Valphabeta);
+
+  FOCVars[M1].Vqd = Vqd;
+  FOCVars[M1].Iab = Iab;
+  FOCVars[M1].Ialphabeta = Ialphabeta;
+  FOCVars[M1].Iqd = Iqd;
+  FOCVars[M1].Valphabeta = Valphabeta;
+  FOCVars[M1].hElAngle = hElAngle;
+  PQD_AccumulateElPower(pMPM[M1], Ialphabeta, Valphabeta);
+  FOC_PublishSnapshot(&FOCVars[M1]);
+
+  return (hCodeError);
+}
 
-			if(costTemp2<0){
-				costTemp2 = -costTemp2;
-			}
+/**
+  * @brief  It ends the dead time calibration of Motor 1 once the high frequency task
+  *         is done with the measurement: the table is computed with the PWM switched
+  *         off and, with the predictive controller, its dead time drop replaced. It
+  *         must be called by the medium frequency task in DT_CALIBRATING state.
+  * @param  none
+  * @retval none
+  */
+static void TSK_DTCalibM1(void)
+{
+  switch (MC_DTCalib_GetPhase())
+  {
+    case MC_DTCAL_MEASURED:
+    {
+      TSK_MF_StopProcessing(&Mci[M1], M1);
+      if (true == MC_DTCalib_Compute())
+      {
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+        /* The predictor applies whole vectors, that the table does not compensate */
+        PCC_SetDeadTimeDrop(pPCC[M1], MC_DTCalib_GetPhaseDrop());
+#endif
+      }
+      else
+      {
+        /* Nothing to do, the compensation is not changed */
+      }
+      break;
+    }
 
-			costTemp1 = costTemp1*costTemp1;
-			costTemp2 = costTemp2*costTemp2;
+    case MC_DTCAL_FAILED:
+    {
+      MC_DTCalib_Stop();
+      TSK_MF_StopProcessing(&Mci[M1], M1);
+      break;
+    }
 
-			if(costTemp1+costTemp2 < cost){
-				optimalVector = i;
-				cost = costTemp1+costTemp2;
-				Vqd.d = VqdTemp.d;
-				Vqd.q = VqdTemp.q;
-			}
-		}
-	} else {
-		  Vqd.q = PI_Controller(pPIDIq[M1], (int32_t)(FOCVars[M1].Iqdref.q) - Iqd.q);
-		  Vqd.d = PI_Controller(pPIDId[M1], (int32_t)(FOCVars[M1].Iqdref.d) - Iqd.d);
-	}
-	/* Omkar code end */
+    default:
+      /* The standstill phases are run by the high frequency task */
+      break;
+  }
+}
+#endif
 
-	Vqd = Circle_Limitation(pCLM[M1], Vqd);
-	hElAngle += SPD_GetInstElSpeedDpp(speedHandle)*REV_PARK_ANGLE_COMPENSATION_FACTOR;
+#ifdef MC_ADCCALIB_MODE
+/**
+  * @brief  It runs the ADC timing calibration instead of FOC_CurrControllerM1, at
+  *         angle 0: the d current is regulated by the PI controllers during the
+  *         alignment, the voltage of MC_ADCCalib_GetVoltage() is applied otherwise.
+  *         The timing of the next sampling is set by MC_ADCCalib_Exec(), before the
+  *         regular conversion is started. Only run at calibration, it is left in flash.
+  * @retval uint16_t It returns MC_NO_FAULTS if the FOC has been ended before
+  *         next PWM Update event, MC_FOC_DURATION otherwise
+  */
+static uint16_t FOC_ADCCalibControllerM1(void)
+{
+  qd_t Iqd, Vqd;
+  ab_t Iab;
+  alphabeta_t Ialphabeta, Valphabeta;
+  Trig_Components Trig;
+  uint16_t hCodeError;
+
+  MCM_Trig_Request(0);
+  PWMC_GetPhaseCurrents(pwmcHandle[M1], &Iab);
+  MC_ADCCalib_Exec(Iab, FOCVars[M1].Vqd);
+  /* The ADC is free until the next current sampling */
+  RCM_ExecNextConv();
+  Trig = MCM_Trig_Collect(0);
+  Iqd = MCM_CALL(MCM_ClarkePark_Trig)(Iab, Trig, &Ialphabeta);
+
+  FOCVars[M1].Iqdref = MC_ADCCalib_GetCurrentRef();
+  if (true == MC_ADCCalib_IsRegulating())
+  {
+    Vqd.q = PI_Controller(pPIDIq[M1], (int32_t)(FOCVars[M1].Iqdref.q) - Iqd.q);
+    Vqd.d = PI_Controller(pPIDId[M1], (int32_t)(FOCVars[M1].Iqdref.d) - Iqd.d);
+    Vqd = Circle_Limitation(pCLM[M1], Vqd);
+  }
+  else
+  {
+    Vqd = MC_ADCCalib_GetVoltage();
+  }
+  Valphabeta = MCM_CALL(MCM_Rev_Park_Trig)(Vqd, Trig);
+  hCodeError = PWMC_SetPhaseVoltage(pwmcHandle[M1], Valphabeta);
+
+  FOCVars[M1].Vqd = Vqd;
+  FOCVars[M1].Iab = Iab;
+  FOCVars[M1].Ialphabeta = Ialphabeta;
+  FOCVars[M1].Iqd = Iqd;
+  FOCVars[M1].Valphabeta = Valphabeta;
+  FOCVars[M1].hElAngle = 0;
+  PQD_AccumulateElPower(pMPM[M1], Ialphabeta, Valphabeta);
+  FOC_PublishSnapshot(&FOCVars[M1]);
+
+  return (hCodeError);
+}
 
-	Valphabeta = MCM_Rev_Park(Vqd, hElAngle);
-	hCodeError = PWMC_SetPhaseVoltage(pwmcHandle[M1], Valphabeta);
+/**
+  * @brief  It ends the ADC timing calibration of Motor 1 once the high frequency task
+  *         is done with the measurement: the timing is selected with the PWM switched
+  *         off. It must be called by the medium frequency task in ADC_CALIBRATING
+  *         state.
+  * @param  none
+  * @retval none
+  */
+static void TSK_ADCCalibM1(void)
+{
+  switch (MC_ADCCalib_GetPhase())
+  {
+    case MC_ADCCAL_MEASURED:
+    {
+      TSK_MF_StopProcessing(&Mci[M1], M1);
+      (void)MC_ADCCalib_Compute();
+      break;
+    }
 
-	FOCVars[M1].Vqd = Vqd;
-	FOCVars[M1].Iab = Iab;
-	FOCVars[M1].Ialphabeta = Ialphabeta;
-	FOCVars[M1].Iqd = Iqd;
-	FOCVars[M1].Valphabeta = Valphabeta;
-	FOCVars[M1].hElAngle = hElAngle;
+    case MC_ADCCAL_FAILED:
+    {
+      TSK_MF_StopProcessing(&Mci[M1], M1);
+      MC_ADCCalib_Stop();
+      break;
+    }
 
-	return(hCodeError);
+    default:
+      /* The standstill phases are run by the high frequency task */
+      break;
+  }
 }
+#endif
 
 /**
   * @brief  Executes safety checks (e.g. bus voltage and temperature) for all drive instances.
@@ -1045,6 +2944,8 @@ __weak void TSK_SafetyTask(void)
     TSK_SafetyTask_PWMOFF(M1);
     /* User conversion execution */
     RCM_ExecUserConv();
+    /* The regular conversions read by the next safety task are scanned meanwhile */
+    RCM_StartRegularScan();
   /* USER CODE BEGIN TSK_SafetyTask 1 */
 
   /* USER CODE END TSK_SafetyTask 1 */
@@ -1065,23 +2966,69 @@ __weak void TSK_SafetyTask_PWMOFF(uint8_t bMotor)
   uint16_t CodeReturn = MC_NO_ERROR;
   uint16_t errMask[NBR_OF_MOTORS] = {VBUS_TEMP_ERR_MASK};
 
+#ifdef M1_ICL_ENABLED
+  if ((M1 == bMotor) && (ICLWAIT == Mci[M1].State))
+  {
+    /* The bus is charging through the limiting resistor */
+    errMask[M1] &= (uint16_t)~MC_UNDER_VOLT;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+
   CodeReturn |= errMask[bMotor] & NTC_CalcAvTemp(pTemperatureSensor[bMotor]); /* check for fault if FW protection is activated. It returns MC_OVER_TEMP or MC_NO_ERROR */
   CodeReturn |= PWMC_CheckOverCurrent(pwmcHandle[bMotor]);                    /* check for fault. It return MC_BREAK_IN or MC_NO_FAULTS
                                                                                  (for STM32F30x can return MC_OVER_VOLT in case of HW Overvoltage) */
   if(M1 == bMotor)
   {
-    CodeReturn |= errMask[bMotor] & RVBS_CalcAvVbus(&BusVoltageSensor_M1);
+#ifdef MC_PIL_MODE
+    uint16_t hPilBusVoltage_d = MC_Pil_GetBusVoltage();
+
+    if (hPilBusVoltage_d > 0U)
+    {
+      /* Bus voltage of the plant model of the host, there is no power stage */
+      BusVoltageSensor_M1._Super.LatestConv = hPilBusVoltage_d;
+      BusVoltageSensor_M1._Super.AvBusVoltage_d = hPilBusVoltage_d;
+    }
+    else
+#endif
+    {
+      CodeReturn |= errMask[bMotor] & RVBS_CalcAvVbus(&BusVoltageSensor_M1);
+    }
+#ifdef MC_GAP_MODE
+    /* Errors of the gate drivers read by the medium frequency task */
+    CodeReturn |= MC_Gap_CheckFaults();
+#endif
   }
   MCI_FaultProcessing(&Mci[bMotor], CodeReturn, ~CodeReturn); /* process faults */
   if (MCI_GetFaultState(&Mci[bMotor]) != (uint32_t)MC_NO_FAULTS)
   {
     PWMC_SwitchOffPWM(pwmcHandle[bMotor]);
+    MC_TRACE_FAULT(MCI_GetOccurredFaults(&Mci[bMotor]));
+#ifdef MC_FAULTLOG_MODE
+    if (M1 == bMotor)
+    {
+      /* Before FOC_Clear, that disengages the predictive controller */
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+      MC_FaultLog_Freeze(MCI_GetOccurredFaults(&Mci[M1]),
+                         (true == pCRG[M1]->PCCEngaged) ? MC_FAULTLOG_CTRL_PCC : MC_FAULTLOG_CTRL_PI);
+#else
+      MC_FaultLog_Freeze(MCI_GetOccurredFaults(&Mci[M1]), MC_FAULTLOG_CTRL_PI);
+#endif
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif
     if (MCPA_UART_A.Mark != 0)
     {
       MCPA_flushDataLog (&MCPA_UART_A);
     }
     FOC_Clear(bMotor);
-    MPM_Clear((MotorPowMeas_Handle_t*)pMPM[bMotor]); //cstat !MISRAC2012-Rule-11.3
+    PQD_Clear(pMPM[bMotor]);
     /* USER CODE BEGIN TSK_SafetyTask_PWMOFF 1 */
 
     /* USER CODE END TSK_SafetyTask_PWMOFF 1 */
@@ -26,15 +26,94 @@
 #include "mcp.h"
 #include "mcp_config.h"
 #include "mcpa.h"
+#ifdef MC_BOARD_DAC
+#include "dac_ui.h"
+#endif
 #include "mc_configuration_registers.h"
+#include "mc_tasks.h"
+#ifdef MC_BENCH_MODE
+#include "mc_bench.h"
+#endif
+#ifdef MC_CAPTURE_MODE
+#include "mc_capture.h"
+#endif
+#ifdef MC_PROFILE_MODE
+#include "mc_profile.h"
+#endif
+#ifdef MC_RECORD_MODE
+#include "mc_record.h"
+#endif
+#ifdef MC_PIL_MODE
+#include "mc_pil.h"
+#endif
+#ifdef MC_FAULTLOG_MODE
+#include "mc_faultlog.h"
+#endif
+#ifdef MC_STATE_STATS_MODE
+#include "mc_state_stats.h"
+#endif
+#ifdef MC_FRA_MODE
+#include "mc_fra.h"
+#endif
+#ifdef MC_SPECTRUM_MODE
+#include "mc_spectrum.h"
+#endif
+#ifdef MC_TIMEBASE_MODE
+#include "mc_timebase.h"
+#endif
+#ifdef MC_STACK_MODE
+#include "mc_stack.h"
+#endif
+#ifdef MC_ABTEST_MODE
+#include "mc_abtest.h"
+#endif
+#ifdef MC_AUTOSELECT_MODE
+#include "mc_autoselect.h"
+#endif
+#ifdef MC_BOOTLOG_MODE
+#include "mc_bootlog.h"
+#endif
+#ifdef MC_ADCCALIB_MODE
+#include "mc_adccalib.h"
+#endif
+#ifdef MC_PWMFREQ_MODE
+#include "mc_pwmfreq.h"
+#endif
+#ifdef MC_WARMBOOT_MODE
+#include "mc_warmboot.h"
+#endif
+#ifdef MC_REPORT_MODE
+#include "mc_report.h"
+#endif
+#ifdef MC_GAP_MODE
+#include "mc_gap.h"
+#endif
 
 static RevUpCtrl_Handle_t *RevUpControl[NBR_OF_MOTORS] = { &RevUpControlM1 };
 static STO_PLL_Handle_t * stoPLLSensor [NBR_OF_MOTORS] = { &STO_PLL_M1 };
 static PID_Handle_t *pPIDSpeed[NBR_OF_MOTORS] = { &PIDSpeedHandle_M1 };
+static PID_Handle_t *pPIDFW[NBR_OF_MOTORS] = { &PIDFluxWeakeningHandle_M1 };
+static BusVoltageSensor_Handle_t *BusVoltageSensor[NBR_OF_MOTORS] = { &BusVoltageSensor_M1._Super };
+#ifdef M1_POSITION_CTRL
+static PID_Handle_t *pPIDPos[NBR_OF_MOTORS] = { &PID_PosParamsM1 };
+#endif
+#ifdef DBG_MCU_LOAD_MEASURE
+static uint8_t perfTrace = (uint8_t)MEASURE_TSK_HighFrequencyTask; /* Code section read by MC_REG_PERF_STATS */
+#endif
 
 static uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t dataAvailable);
 static uint8_t RI_GetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t maxSize);
 static uint8_t RI_MovString(const char_t * srcString, char_t * destString, uint16_t *size, int16_t maxSize);
+static uint8_t RI_GetRawBlock(uint8_t *data, int16_t freeSpace, const void *pBlock, uint16_t blockSize);
+
+typedef struct
+{
+  uint16_t dataID[RI_REG_GROUP_MAX_ELT];
+  uint8_t nbElt;          /* 0 when the group is not defined */
+  uint8_t size;           /* Bytes of the values of the group */
+} RI_RegGroup_t;
+
+static RI_RegGroup_t RI_RegGroup[RI_REG_GROUP_NBR];
 
 __weak uint8_t RI_SetRegCommandParser (MCP_Handle_t * pHandle, uint16_t txSyncFreeSpace)
 {
@@ -153,6 +232,120 @@ __weak uint8_t RI_GetRegCommandParser (MCP_Handle_t * pHandle, uint16_t txSyncFr
   return (retVal);
 }
 
+/**
+  * @brief  Defines a register group. The payload is the index of the group on one byte
+  *         followed by the data IDs of its registers, an empty list deletes the group.
+  *         Every register is read once here, so that an unknown one is rejected now
+  *         rather than at each read of the group.
+  */
+__weak uint8_t RI_DefineRegGroupCommandParser (MCP_Handle_t * pHandle)
+{
+  uint8_t retVal = MCP_CMD_OK;
+#ifdef NULL_PTR_REG_INT
+  if (MC_NULL == pHandle)
+  {
+    retVal = MCP_CMD_NOK;
+  }
+  else
+  {
+#endif
+    uint8_t * rxData = pHandle->rxBuffer;
+    uint16_t nbElt = (pHandle->rxLength > 0U) ? ((pHandle->rxLength - 1U) / MCP_ID_SIZE) : 0U;
+
+    pHandle->txLength = 0;
+    if ((0U == pHandle->rxLength) || (rxData[0] >= RI_REG_GROUP_NBR)
+        || (((pHandle->rxLength - 1U) % MCP_ID_SIZE) != 0U) || (nbElt > RI_REG_GROUP_MAX_ELT))
+    {
+      retVal = MCP_CMD_NOK;
+    }
+    else
+    {
+      RI_RegGroup_t * pGroup = &RI_RegGroup[rxData[0]];
+      uint32_t scratch;
+      uint16_t size;
+      uint16_t groupSize = 0U;
+      uint16_t i;
+
+      pGroup->nbElt = 0U;
+      for (i = 0U; (i < nbElt) && (MCP_CMD_OK == retVal); i++)
+      {
+        uint16_t dataID = (uint16_t)rxData[1U + (i * MCP_ID_SIZE)]
+                        | ((uint16_t)rxData[2U + (i * MCP_ID_SIZE)] << 8);
+
+        if (0U == RI_GetIDSize(dataID))
+        {
+          retVal = MCP_ERROR_BAD_DATA_TYPE;
+        }
+        else
+        {
+          retVal = RI_GetReg(dataID, (uint8_t *)&scratch, &size, (int16_t)sizeof(scratch));
+          pGroup->dataID[i] = dataID;
+          groupSize += size;
+        }
+      }
+      if (MCP_CMD_OK == retVal)
+      {
+        pGroup->nbElt = (uint8_t)nbElt;
+        pGroup->size = (uint8_t)groupSize;
+      }
+      else
+      {
+        /* Nothing to do, the group stays deleted */
+      }
+    }
+#ifdef NULL_PTR_REG_INT
+  }
+#endif
+  return (retVal);
+}
+
+/**
+  * @brief  Reads a register group. The payload is the index of the group on one byte and
+  *         the answer is the values of its registers, without their data IDs. The space
+  *         of the answer is checked once for the whole group.
+  */
+__weak uint8_t RI_GetRegGroupCommandParser (MCP_Handle_t * pHandle, uint16_t txSyncFreeSpace)
+{
+  uint8_t retVal = MCP_CMD_OK;
+#ifdef NULL_PTR_REG_INT
+  if (MC_NULL == pHandle)
+  {
+    retVal = MCP_CMD_NOK;
+  }
+  else
+  {
+#endif
+    pHandle->txLength = 0;
+    if ((pHandle->rxLength != 1U) || (pHandle->rxBuffer[0] >= RI_REG_GROUP_NBR)
+        || (0U == RI_RegGroup[pHandle->rxBuffer[0]].nbElt))
+    {
+      retVal = MCP_CMD_NOK;
+    }
+    else if (RI_RegGroup[pHandle->rxBuffer[0]].size > txSyncFreeSpace)
+    {
+      retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+    }
+    else
+    {
+      const RI_RegGroup_t * pGroup = &RI_RegGroup[pHandle->rxBuffer[0]];
+      uint8_t * txData = pHandle->txBuffer;
+      uint16_t size;
+      uint8_t i;
+
+      for (i = 0U; i < pGroup->nbElt; i++)
+      {
+        /* The size of every register was checked by the definition of the group */
+        (void)RI_GetReg(pGroup->dataID[i], txData, &size, (int16_t)sizeof(uint32_t));
+        txData = txData + size;
+      }
+      pHandle->txLength = pGroup->size;
+    }
+#ifdef NULL_PTR_REG_INT
+  }
+#endif
+  return (retVal);
+}
+
 uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t dataAvailable)
 {
   uint8_t retVal = MCP_CMD_OK;
@@ -211,6 +404,122 @@ uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t data
             retVal = MCP_ERROR_RO_REG;
             break;
           }
+
+#ifdef MC_BOARD_OBSERVER_SEL
+          case MC_REG_OBSERVER_SEL:
+          {
+            retVal = (true == TSK_SetObserverM1(*data)) ? MCP_CMD_OK : MCP_CMD_NOK;
+            break;
+          }
+#endif
+
+#ifdef MC_CAPTURE_MODE
+          case MC_REG_CAPTURE_STATE:
+          {
+            retVal = (true == MC_Capture_Command(*data)) ? MCP_CMD_OK : MCP_CMD_NOK;
+            break;
+          }
+#endif
+
+#ifdef MC_PROFILE_MODE
+          case MC_REG_PROFILE_SEL:
+          {
+            retVal = ((true == MC_Profile_IsStored(*data)) && (true == MCI_SelectProfile(pMCIN, *data)))
+                   ? MCP_CMD_OK : MCP_CMD_NOK;
+            break;
+          }
+#endif
+
+#ifdef MC_RECORD_MODE
+          case MC_REG_RECORD_STATE:
+          {
+            retVal = (true == MC_Record_Command(*data)) ? MCP_CMD_OK : MCP_CMD_NOK;
+            break;
+          }
+#endif
+
+#ifdef MC_PIL_MODE
+          case MC_REG_PIL_STATE:
+          {
+            /* The inputs of the controller are switched with the PWM off */
+            retVal = ((MCI_GetSTMState(pMCIN) == IDLE) && (true == MC_Pil_Command(*data)))
+                   ? MCP_CMD_OK : MCP_CMD_NOK;
+            break;
+          }
+#endif
+
+#ifdef MC_FAULTLOG_MODE
+          case MC_REG_FAULTLOG_COUNT:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+#endif
+
+#ifdef HARMONIC_COMPENSATION
+          case MC_REG_HCM_STATE:
+          {
+            retVal = (true == HCM_Command(pHCM[motorID], *data)) ? MCP_CMD_OK : MCP_CMD_NOK;
+            break;
+          }
+#endif
+
+#ifdef MC_FRA_MODE
+          case MC_REG_FRA_STATE:
+          {
+            retVal = (true == MC_Fra_Command(*data)) ? MCP_CMD_OK : MCP_CMD_NOK;
+            break;
+          }
+#endif
+
+#ifdef MC_ABTEST_MODE
+          case MC_REG_ABTEST_STATE:
+          {
+            retVal = (true == MC_ABTest_Command(*data)) ? MCP_CMD_OK : MCP_CMD_NOK;
+            break;
+          }
+#endif
+
+#ifdef MC_WARMBOOT_MODE
+          case MC_REG_WARMBOOT:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+#endif
+
+          case MC_REG_ASPEP_SYNC_DEPTH:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+
+#ifdef DBG_MCU_LOAD_MEASURE
+          case MC_REG_PERF_TRACE:
+          {
+            uint8_t regdata8 = *data;
+            if (regdata8 < (uint8_t)MC_PERF_NB_TRACES)
+            {
+              /* Statistics restart so that they only cover the selected operating point */
+              perfTrace = regdata8;
+              MC_Perf_Clear(&PerfTraces);
+            }
+            else
+            {
+              retVal = MCP_CMD_NOK;
+            }
+            break;
+          }
+#endif
+
+#ifdef M1_POSITION_CTRL
+          case MC_REG_POSITION_CTRL_STATE:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+#endif
+
           default:
           {
             retVal = MCP_ERROR_UNKNOWN_REG;
@@ -245,6 +554,24 @@ uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t data
             break;
           }
 
+          case MC_REG_FLUXWK_KP:
+          {
+            PID_SetKP(pPIDFW[motorID], (int16_t)regdata16);
+            break;
+          }
+
+          case MC_REG_FLUXWK_KI:
+          {
+            PID_SetKI(pPIDFW[motorID], (int16_t)regdata16);
+            break;
+          }
+
+          case MC_REG_FLUXWK_BUS:
+          {
+            FW_SetVref(pFW[motorID], (uint16_t)regdata16);
+            break;
+          }
+
           case MC_REG_I_Q_KP:
           {
             PID_SetKP(pPIDIq[motorID], (int16_t)regdata16);
@@ -284,11 +611,29 @@ uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t data
           case MC_REG_BUS_VOLTAGE:
           case MC_REG_HEATS_TEMP:
           case MC_REG_MOTOR_POWER:
+          case MC_REG_MOTOR_COPPER_LOSS:
+          case MC_REG_MOTOR_EFFICIENCY:
+          case MC_REG_READY_TIME:
+          case MC_REG_STARTUP_TIME:
           {
             retVal = MCP_ERROR_RO_REG;
             break;
           }
 
+#ifdef MC_BOARD_DAC
+          case MC_REG_DAC_OUT1:
+          {
+            DAC_SetChannelConfig(&DAC_Handle , DAC_CH1, regdata16);
+            break;
+          }
+
+          case MC_REG_DAC_OUT2:
+          {
+            DAC_SetChannelConfig(&DAC_Handle , DAC_CH2, regdata16);
+            break;
+          }
+#endif
+
           case MC_REG_I_A:
           case MC_REG_I_B:
           case MC_REG_I_ALPHA_MEAS:
@@ -351,13 +696,20 @@ uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t data
 
           case MC_REG_STOPLL_KI:
           {
-            PID_SetKI (&stoPLLSensor[motorID]->PIRegulator, (int16_t)regdata16);
+            /* The nominal gains, scheduled with the speed by the observer */
+            int16_t hKp;
+            int16_t hKi;
+            STO_GetPLLGains(stoPLLSensor[motorID], &hKp, &hKi);
+            STO_SetPLLGains(stoPLLSensor[motorID], hKp, (int16_t)regdata16);
             break;
           }
 
           case MC_REG_STOPLL_KP:
           {
-            PID_SetKP (&stoPLLSensor[motorID]->PIRegulator, (int16_t)regdata16);
+            int16_t hKp;
+            int16_t hKi;
+            STO_GetPLLGains(stoPLLSensor[motorID], &hKp, &hKi);
+            STO_SetPLLGains(stoPLLSensor[motorID], (int16_t)regdata16, hKi);
             break;
           }
 
@@ -387,6 +739,18 @@ uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t data
             break;
           }
 
+          case MC_REG_FLUXWK_KP_DIV:
+          {
+            PID_SetKPDivisorPOW2(pPIDFW[motorID], regdata16);
+            break;
+          }
+
+          case MC_REG_FLUXWK_KI_DIV:
+          {
+            PID_SetKIDivisorPOW2(pPIDFW[motorID], regdata16);
+            break;
+          }
+
           case MC_REG_SPEED_KD_DIV:
           {
             PID_SetKDDivisorPOW2(pPIDSpeed[motorID], regdata16);
@@ -441,73 +805,232 @@ uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t data
             break;
           }
 
-          default:
+#ifdef MC_CAPTURE_MODE
+          case MC_REG_CAPTURE_INDEX:
           {
-            retVal = MCP_ERROR_UNKNOWN_REG;
+            MC_Capture_SetReadIndex(regdata16);
             break;
           }
-        }
-        *size = 2;
-        break;
-      }
+#endif
 
-      case TYPE_DATA_32BIT:
-      {
-        uint32_t regdata32 = *(uint32_t *)data; //cstat !MISRAC2012-Rule-11.3
+#ifdef MC_RECORD_MODE
+          case MC_REG_RECORD_INDEX:
+          {
+            MC_Record_SetReadIndex(regdata16);
+            break;
+          }
+#endif
 
-        switch (regID)
-        {
-          case MC_REG_FAULTS_FLAGS:
-          case MC_REG_SPEED_MEAS:
+#ifdef MC_PIL_MODE
+          case MC_REG_PIL_STEP_RATE:
           {
-            retVal = MCP_ERROR_RO_REG;
+            MC_Pil_SetStepRate(regdata16);
             break;
           }
+#endif
 
-          case MC_REG_SPEED_REF:
+#ifdef MC_FAULTLOG_MODE
+          case MC_REG_FAULTLOG_INDEX:
           {
-            MCI_ExecSpeedRamp(pMCIN,((((int16_t)regdata32) * ((int16_t)SPEED_UNIT)) / (int16_t)U_RPM), 0);
+            MC_FaultLog_SetReadIndex(regdata16);
             break;
           }
+#endif
 
-          case MC_REG_STOPLL_EST_BEMF:
-          case MC_REG_STOPLL_OBS_BEMF:
-          case MC_REG_STOCORDIC_EST_BEMF:
-          case MC_REG_STOCORDIC_OBS_BEMF:
+#ifdef THERMAL_DERATING
+          case MC_REG_THERMAL_HEADROOM:
+          case MC_REG_THERMAL_CURR_LIMIT:
+          case MC_REG_WINDING_TEMP:
           {
             retVal = MCP_ERROR_RO_REG;
             break;
           }
+#endif
 
-          default:
+#ifdef LOSS_MINIMIZATION
+          case MC_REG_LMN_ID_OFFSET:
           {
-            retVal = MCP_ERROR_UNKNOWN_REG;
+            retVal = MCP_ERROR_RO_REG;
             break;
           }
-        }
-        *size = 4;
-        break;
-      }
+#endif
 
-      case TYPE_DATA_STRING:
-      {
-        const char_t *charData = (const char_t *)data;
-        char_t *dummy = (char_t *)data ;
-        retVal = MCP_ERROR_RO_REG;
-        /* Used to compute String length stored in RXBUFF even if Reg does not exist*/
-        /* It allows to jump to the next command in the buffer */
-        (void)RI_MovString (charData, dummy, size, dataAvailable);
-        break;
-      }
+#ifdef MC_FRA_MODE
+          case MC_REG_FRA_INDEX:
+          {
+            MC_Fra_SetReadIndex(regdata16);
+            break;
+          }
+#endif
 
-      case TYPE_DATA_RAW:
-      {
-        uint16_t rawSize = *(uint16_t *) data; //cstat !MISRAC2012-Rule-11.3
-        /* The size consumed by the structure is the structure size + 2 bytes used to store the size*/
-        *size = rawSize + 2U;
-        uint8_t *rawData = data; /* rawData points to the first data (after size extraction) */
-        rawData++;
-        rawData++;
+#ifdef MC_SPECTRUM_MODE
+          case MC_REG_SPECTRUM_THD:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+#endif
+
+#ifdef SIX_STEP_MODE
+          case MC_REG_SIX_STEP_ENTRIES:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+#endif
+
+#ifdef LOAD_TORQUE_OBSERVER
+          case MC_REG_LOAD_TORQUE:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+#endif
+
+#ifdef M1_POSITION_CTRL
+          case MC_REG_POSITION_KP:
+          {
+            PID_SetKP(pPIDPos[motorID], (int16_t)regdata16);
+            break;
+          }
+
+          case MC_REG_POSITION_KI:
+          {
+            PID_SetKI(pPIDPos[motorID], (int16_t)regdata16);
+            break;
+          }
+
+          case MC_REG_POSITION_KD:
+          {
+            PID_SetKD(pPIDPos[motorID], (int16_t)regdata16);
+            break;
+          }
+
+          case MC_REG_POSITION_KP_DIV:
+          {
+            PID_SetKPDivisorPOW2(pPIDPos[motorID], regdata16);
+            break;
+          }
+
+          case MC_REG_POSITION_KI_DIV:
+          {
+            PID_SetKIDivisorPOW2(pPIDPos[motorID], regdata16);
+            break;
+          }
+
+          case MC_REG_POSITION_KD_DIV:
+          {
+            PID_SetKDDivisorPOW2(pPIDPos[motorID], regdata16);
+            break;
+          }
+#endif
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+          case MC_REG_PCC_SW_WEIGHT:
+          {
+            PCC_SetSwitchingWeight(pPCC[motorID], regdata16);
+            break;
+          }
+
+          case MC_REG_PCC_DECISION:
+          case MC_REG_PCC_COST:
+          case MC_REG_PCC_I_Q_PRED:
+          case MC_REG_PCC_I_D_PRED:
+          case MC_REG_PCC_FALLBACKS:
+          case MC_REG_PCC_RESIDUAL_EVENTS:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+#endif
+
+          default:
+          {
+            retVal = MCP_ERROR_UNKNOWN_REG;
+            break;
+          }
+        }
+        *size = 2;
+        break;
+      }
+
+      case TYPE_DATA_32BIT:
+      {
+        uint32_t regdata32 = *(uint32_t *)data; //cstat !MISRAC2012-Rule-11.3
+
+        switch (regID)
+        {
+          case MC_REG_FAULTS_FLAGS:
+          case MC_REG_SPEED_MEAS:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+
+          case MC_REG_SPEED_REF:
+          {
+            MCI_ExecSpeedRamp(pMCIN,((((int16_t)regdata32) * ((int16_t)SPEED_UNIT)) / (int16_t)U_RPM), 0);
+            break;
+          }
+
+          case MC_REG_STOPLL_EST_BEMF:
+          case MC_REG_STOPLL_OBS_BEMF:
+          case MC_REG_STOCORDIC_EST_BEMF:
+          case MC_REG_STOCORDIC_OBS_BEMF:
+#ifdef M1_POSITION_CTRL
+          case MC_REG_CURRENT_POSITION:
+#endif
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+
+#ifdef MC_PWMFREQ_MODE
+          case MC_REG_PWM_FREQUENCY:
+          {
+            retVal = ((true == MC_PwmFreq_Check(regdata32)) && (true == MCI_SetPwmFrequency(pMCIN, regdata32)))
+                   ? MCP_CMD_OK : MCP_CMD_NOK;
+            break;
+          }
+#endif
+
+#ifdef MC_GAP_MODE
+          case MC_REG_GAP_ERRORS:
+          {
+            retVal = MCP_ERROR_RO_REG;
+            break;
+          }
+#endif
+
+          default:
+          {
+            retVal = MCP_ERROR_UNKNOWN_REG;
+            break;
+          }
+        }
+        *size = 4;
+        break;
+      }
+
+      case TYPE_DATA_STRING:
+      {
+        const char_t *charData = (const char_t *)data;
+        char_t *dummy = (char_t *)data ;
+        retVal = MCP_ERROR_RO_REG;
+        /* Used to compute String length stored in RXBUFF even if Reg does not exist*/
+        /* It allows to jump to the next command in the buffer */
+        (void)RI_MovString (charData, dummy, size, dataAvailable);
+        break;
+      }
+
+      case TYPE_DATA_RAW:
+      {
+        uint16_t rawSize = *(uint16_t *) data; //cstat !MISRAC2012-Rule-11.3
+        /* The size consumed by the structure is the structure size + 2 bytes used to store the size*/
+        *size = rawSize + 2U;
+        uint8_t *rawData = data; /* rawData points to the first data (after size extraction) */
+        rawData++;
+        rawData++;
 
         if (*size > dataAvailable )
         { /* The decoded size of the raw structure can not match with transmitted buffer, error in buffer construction*/
@@ -522,6 +1045,13 @@ uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t data
             case MC_REG_MOTOR_CONFIG:
             case MC_REG_APPLICATION_CONFIG:
             case MC_REG_FOCFW_CONFIG:
+            case MC_REG_PERF_STATS:
+            case MC_REG_PERF_JITTER:
+            case MC_REG_PERF_NOISE:
+            case MC_REG_PERF_LOAD:
+            case MC_REG_BENCH_RESULTS:
+            case MC_REG_BENCH_RIPPLE:
+            case MC_REG_BENCH_SCENARIOS:
             {
               retVal = MCP_ERROR_RO_REG;
               break;
@@ -548,6 +1078,20 @@ uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t data
               break;
             }
 
+#ifdef M1_POSITION_CTRL
+            case MC_REG_POSITION_RAMP:
+            {
+              float position;
+              uint16_t duration;
+
+              /* Final mechanical angle in rad, then the duration in ms as the other ramps */
+              (void)memcpy(&position, rawData, sizeof(float));
+              duration = *(uint16_t *)&rawData[4]; //cstat !MISRAC2012-Rule-11.3
+              MCI_ExecPositionCommand(pMCIN, position, duration);
+              break;
+            }
+#endif
+
             case MC_REG_REVUP_DATA:
             {
               int32_t rpm;
@@ -579,618 +1123,1843 @@ uint8_t RI_SetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t data
               break;
             }
 
-            case MC_REG_CURRENT_REF:
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+            case MC_REG_PCC_TUNING:
             {
-              qd_t currComp;
-              currComp.q = *((int16_t *) rawData); //cstat !MISRAC2012-Rule-11.3
-              currComp.d = *((int16_t *) &rawData[2]); //cstat !MISRAC2012-Rule-11.3
-              MCI_SetCurrentReferences(pMCIN, currComp);
+              PCC_Tuning_t pccTuning;
+              int32_t rpm;
+
+              if (rawSize != 24U)
+              {
+                retVal = MCP_ERROR_BAD_RAW_FORMAT;
+              }
+              else
+              {
+                pccTuning.wKDecay = *(int32_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+                pccTuning.wKVolt = *(int32_t *)&rawData[4]; //cstat !MISRAC2012-Rule-11.3
+                pccTuning.wKBemf = *(int32_t *)&rawData[8]; //cstat !MISRAC2012-Rule-11.3
+                pccTuning.hCoefDivisorPOW2 = *(uint16_t *)&rawData[12]; //cstat !MISRAC2012-Rule-11.3
+                pccTuning.hBemfDivisorPOW2 = *(uint16_t *)&rawData[14]; //cstat !MISRAC2012-Rule-11.3
+                pccTuning.hSwitchingWeight = *(uint16_t *)&rawData[16]; //cstat !MISRAC2012-Rule-11.3
+                pccTuning.hNodeBudget = *(uint16_t *)&rawData[18]; //cstat !MISRAC2012-Rule-11.3
+                rpm = (int32_t)*(int16_t *)&rawData[20]; //cstat !MISRAC2012-Rule-11.3
+                pccTuning.hEngageSpeed = (int16_t)((rpm * SPEED_UNIT) / U_RPM);
+                rpm = (int32_t)*(int16_t *)&rawData[22]; //cstat !MISRAC2012-Rule-11.3
+                pccTuning.hDisengageSpeed = (int16_t)((rpm * SPEED_UNIT) / U_RPM);
+                /* Refused while the previous set is waiting for the high frequency task */
+                if (false == PCC_SetTuning(pPCC[motorID], &pccTuning))
+                {
+                  retVal = MCP_CMD_NOK;
+                }
+                else
+                {
+                  /* Nothing to do */
+                }
+              }
               break;
             }
 
-            default:
+            case MC_REG_PCC_STATS:
             {
-              retVal = MCP_ERROR_UNKNOWN_REG;
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
-          }
-        }
-        break;
-      }
+#endif
 
-      default:
-      {
-        retVal = MCP_ERROR_BAD_DATA_TYPE;
-        *size =0; /* From this point we are not able anymore to decode the RX buffer*/
-        break;
-      }
-    }
-#ifdef NULL_PTR_REG_INT
-  }
+#ifdef MC_CAPTURE_MODE
+            case MC_REG_CAPTURE_CONFIG:
+            {
+              MC_Capture_Config_t captureConfig;
+              uint8_t i;
+
+              if (rawSize != 14U)
+              {
+                retVal = MCP_ERROR_BAD_RAW_FORMAT;
+              }
+              else
+              {
+                for (i = 0U; i < MC_CAPTURE_NB_CHANNELS; i++)
+                {
+                  captureConfig.hRegID[i] = *(uint16_t *)&rawData[2U * i]; //cstat !MISRAC2012-Rule-11.3
+                }
+                captureConfig.bTrigger = rawData[8];
+                captureConfig.bTrigChannel = rawData[9];
+                captureConfig.hTrigLevel = *(int16_t *)&rawData[10]; //cstat !MISRAC2012-Rule-11.3
+                captureConfig.hPreTrigger = *(uint16_t *)&rawData[12]; //cstat !MISRAC2012-Rule-11.3
+                if (false == MC_Capture_Configure(&captureConfig))
+                {
+                  retVal = MCP_CMD_NOK;
+                }
+              }
+              break;
+            }
+
+            case MC_REG_CAPTURE_DATA:
+            {
+              retVal = MCP_ERROR_RO_REG;
+              break;
+            }
 #endif
-  return (retVal);
-}
 
-uint8_t RI_GetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t freeSpace)
-{
-  uint8_t retVal = MCP_CMD_OK;
-#ifdef NULL_PTR_REG_INT
-  if ((MC_NULL == data) || (MC_NULL == size))
-  {
-    retVal = MCP_CMD_NOK;
-  }
-  else
-  {
+#ifdef MC_PROFILE_MODE
+            case MC_REG_PROFILE_DATA:
+            {
+              MC_Profile_t profile;
+
+              /* Index of the profile and 3 spare bytes, then the profile */
+              if (rawSize != (4U + sizeof(MC_Profile_t)))
+              {
+                retVal = MCP_ERROR_BAD_RAW_FORMAT;
+              }
+              /* The flash is written with the PWM off */
+              else if (MCI_GetSTMState(pMCIN) != IDLE)
+              {
+                retVal = MCP_CMD_NOK;
+              }
+              else
+              {
+                (void)memcpy(&profile, &rawData[4], sizeof(MC_Profile_t));
+                if (false == MC_Profile_Store(rawData[0], &profile))
+                {
+                  retVal = MCP_CMD_NOK;
+                }
+                else if (rawData[0] == MC_Profile_GetSelected())
+                {
+                  /* The new parameters of the selected profile are applied as well */
+                  (void)MCI_SelectProfile(pMCIN, rawData[0]);
+                }
+                else
+                {
+                  /* Nothing to do */
+                }
+              }
+              break;
+            }
 #endif
-    uint16_t regID = dataID & REG_MASK;
-    uint8_t typeID = ((uint8_t)dataID) & TYPE_MASK;
-    BusVoltageSensor_Handle_t* BusVoltageSensor[NBR_OF_MOTORS]={ &BusVoltageSensor_M1._Super};
-    uint8_t motorID = 0U;
 
-    MCI_Handle_t *pMCIN = &Mci[motorID];
-    switch (typeID)
-    {
-      case TYPE_DATA_8BIT:
-      {
-        if (freeSpace > 0U)
-        {
-          switch (regID)
-          {
-            case MC_REG_STATUS:
+#ifdef MC_RECORD_MODE
+            case MC_REG_RECORD_DATA:
             {
-              *data = (uint8_t)MCI_GetSTMState(pMCIN);
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
+#endif
 
-            case MC_REG_CONTROL_MODE:
+#ifdef MC_PIL_MODE
+            case MC_REG_PIL_FRAME:
             {
-              *data = (uint8_t)MCI_GetControlMode(pMCIN);
+              MC_Pil_Input_t pilInput;
+
+              if (rawSize != sizeof(MC_Pil_Input_t))
+              {
+                retVal = MCP_ERROR_BAD_RAW_FORMAT;
+              }
+              else
+              {
+                (void)memcpy(&pilInput, rawData, sizeof(MC_Pil_Input_t));
+                retVal = (true == MC_Pil_Push(&pilInput)) ? MCP_CMD_OK : MCP_CMD_NOK;
+              }
               break;
             }
+#endif
 
-            case MC_REG_RUC_STAGE_NBR:
+#ifdef MC_FAULTLOG_MODE
+            case MC_REG_FAULTLOG_DATA:
             {
-              *data = (RevUpControl[motorID] != MC_NULL) ? (uint8_t)RUC_GetNumberOfPhases(RevUpControl[motorID]) : 0U;
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
+#endif
 
-            default:
+#ifdef MC_STATE_STATS_MODE
+            case MC_REG_STATE_STATS:
             {
-              retVal = MCP_ERROR_UNKNOWN_REG;
+              /* Whatever the data */
+              MC_StateStats_Reset();
               break;
             }
-          }
-          *size = 1;
-        }
-        else
-        {
-          retVal = MCP_ERROR_NO_TXSYNC_SPACE;
-        }
-        break;
-      }
-
-      case TYPE_DATA_16BIT:
-      {
-        uint16_t *regdataU16 = (uint16_t *)data; //cstat !MISRAC2012-Rule-11.3
-        int16_t *regdata16 = (int16_t *) data; //cstat !MISRAC2012-Rule-11.3
+#endif
 
-        if (freeSpace >= 2U)
-        {
-          switch (regID)
-          {
-            case MC_REG_SPEED_KP:
+#ifdef MC_FRA_MODE
+            case MC_REG_FRA_CONFIG:
             {
-              *regdata16 = PID_GetKP(pPIDSpeed[motorID]);
-              break;
-            }
+              MC_Fra_Config_t fraConfig;
+              uint8_t i;
 
-            case MC_REG_SPEED_KI:
-            {
-              *regdata16 = PID_GetKI(pPIDSpeed[motorID]);
+              if ((rawSize < MC_FRA_CONFIG_HEADER) || (rawData[5] > MC_FRA_MAX_POINTS)
+                  || (rawSize != (MC_FRA_CONFIG_HEADER + (4U * rawData[5]))))
+              {
+                retVal = MCP_ERROR_BAD_RAW_FORMAT;
+              }
+              else
+              {
+                for (i = 0U; i < MC_FRA_NB_CHANNELS; i++)
+                {
+                  fraConfig.hRegID[i] = *(uint16_t *)&rawData[2U * i]; //cstat !MISRAC2012-Rule-11.3
+                }
+                fraConfig.bInjection = rawData[4];
+                fraConfig.bNbPoints = rawData[5];
+                fraConfig.hAmplitude = *(int16_t *)&rawData[6]; //cstat !MISRAC2012-Rule-11.3
+                fraConfig.hSettleCycles = *(uint16_t *)&rawData[8]; //cstat !MISRAC2012-Rule-11.3
+                fraConfig.hCycles = *(uint16_t *)&rawData[10]; //cstat !MISRAC2012-Rule-11.3
+                (void)memcpy(fraConfig.wFreq_mHz, &rawData[MC_FRA_CONFIG_HEADER], 4U * rawData[5]);
+                if (false == MC_Fra_Configure(&fraConfig))
+                {
+                  retVal = MCP_CMD_NOK;
+                }
+              }
               break;
             }
 
-            case MC_REG_SPEED_KD:
+            case MC_REG_FRA_DATA:
             {
-              *regdata16 = PID_GetKD(pPIDSpeed[motorID]);
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
+#endif
 
-        case MC_REG_I_Q_KP:
+#ifdef MC_SPECTRUM_MODE
+            case MC_REG_SPECTRUM_DATA:
             {
-              *regdata16 = PID_GetKP(pPIDIq[motorID]);
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
+#endif
 
-        case MC_REG_I_Q_KI:
+#ifdef MC_TIMEBASE_MODE
+            case MC_REG_TIME:
             {
-              *regdata16 = PID_GetKI(pPIDIq[motorID]);
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
+#endif
 
-        case MC_REG_I_Q_KD:
+#ifdef MC_STACK_MODE
+            case MC_REG_STACK:
             {
-              *regdata16 = PID_GetKD(pPIDIq[motorID]);
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
+#endif
 
-        case MC_REG_I_D_KP:
+            case MC_REG_RAM_FOOTPRINT:
             {
-              *regdata16 = PID_GetKP(pPIDId[motorID]);
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
 
-        case MC_REG_I_D_KI:
+#ifdef MC_ABTEST_MODE
+            case MC_REG_ABTEST_CONFIG:
             {
-              *regdata16 = PID_GetKI(pPIDId[motorID]);
-              break;
-            }
+              MC_ABTest_Config_t abConfig;
 
-        case MC_REG_I_D_KD:
-            {
-              *regdata16 = PID_GetKD(pPIDId[motorID]);
+              if (rawSize != sizeof(MC_ABTest_Config_t))
+              {
+                retVal = MCP_ERROR_BAD_RAW_FORMAT;
+              }
+              else
+              {
+                (void)memcpy(&abConfig, rawData, sizeof(MC_ABTest_Config_t));
+                retVal = (true == MC_ABTest_Configure(&abConfig)) ? MCP_CMD_OK : MCP_CMD_NOK;
+              }
               break;
             }
 
-            case MC_REG_BUS_VOLTAGE:
+            case MC_REG_ABTEST_STATS:
             {
-              *regdataU16 = VBS_GetAvBusVoltage_V(BusVoltageSensor[motorID]);
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
+#endif
 
-            case MC_REG_HEATS_TEMP:
+#ifdef MC_AUTOSELECT_MODE
+            case MC_REG_AUTOSELECT:
             {
-              *regdata16 = NTC_GetAvTemp_C(pTemperatureSensor[motorID]);
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
+#endif
 
-            case MC_REG_MOTOR_POWER:
+#ifdef MC_BOOTLOG_MODE
+            case MC_REG_BOOTLOG_CONFIG:
             {
-              *regdata16 = MPM_GetAvrgElMotorPowerW((MotorPowMeas_Handle_t *)pMPM[motorID]); //cstat !MISRAC2012-Rule-11.3
-              break;
-            }
+              MC_BootLog_Config_t bootLogConfig;
 
-            case MC_REG_I_A:
-            {
-              *regdata16 = MCI_GetIab(pMCIN).a;
+              if (rawSize != sizeof(MC_BootLog_Config_t))
+              {
+                retVal = MCP_ERROR_BAD_RAW_FORMAT;
+              }
+              /* The flash is written with the PWM off */
+              else if (MCI_GetSTMState(pMCIN) != IDLE)
+              {
+                retVal = MCP_CMD_NOK;
+              }
+              else
+              {
+                (void)memcpy(&bootLogConfig, rawData, sizeof(MC_BootLog_Config_t));
+                retVal = (true == MC_BootLog_Store(&bootLogConfig)) ? MCP_CMD_OK : MCP_CMD_NOK;
+              }
               break;
             }
+#endif
 
-            case MC_REG_I_B:
+#ifdef MC_ADCCALIB_MODE
+            case MC_REG_ADCCALIB:
             {
-              *regdata16 = MCI_GetIab(pMCIN).b;
+              retVal = MCP_ERROR_RO_REG;
               break;
             }
+#endif
 
-            case MC_REG_I_ALPHA_MEAS:
+#ifdef MC_REPORT_MODE
+            case MC_REG_REPORT_CONFIG:
             {
-              *regdata16 = MCI_GetIalphabeta(pMCIN).alpha;
-              break;
-            }
+              MC_Report_Config_t reportConfig;
 
-            case MC_REG_I_BETA_MEAS:
-            {
-              *regdata16 = MCI_GetIalphabeta(pMCIN).beta;
+              if (rawSize != sizeof(MC_Report_Config_t))
+              {
+                retVal = MCP_ERROR_BAD_RAW_FORMAT;
+              }
+              else
+              {
+                (void)memcpy(&reportConfig, rawData, sizeof(MC_Report_Config_t));
+                retVal = MC_Report_Configure(&reportConfig, MCPA_UART_A.pTransportLayer->txAsyncMaxPayload);
+              }
               break;
             }
+#endif
 
-            case MC_REG_I_Q_MEAS:
+#ifdef SPEED_FILTER_BANK
+            case MC_REG_SPEED_FILTER:
             {
-              *regdata16 = MCI_GetIqd(pMCIN).q;
-              break;
-            }
+              SFB_Bank_t bank;
 
-            case MC_REG_I_D_MEAS:
-            {
-              *regdata16 = MCI_GetIqd(pMCIN).d;
+              if (rawSize != sizeof(SFB_Bank_t))
+              {
+                retVal = MCP_ERROR_BAD_RAW_FORMAT;
+              }
+              else
+              {
+                (void)memcpy(&bank, rawData, sizeof(SFB_Bank_t));
+                /* Refused while the previous cascade is waiting for the speed loop,
+                   or if a biquad is unstable */
+                if (false == SFB_SetBank(pSFB[motorID], &bank))
+                {
+                  retVal = MCP_CMD_NOK;
+                }
+                else
+                {
+                  /* Nothing to do */
+                }
+              }
               break;
             }
+#endif
 
-            case MC_REG_I_Q_REF:
+            case MC_REG_CURRENT_REF:
             {
-              *regdata16 = MCI_GetIqdref(pMCIN).q;
+              qd_t currComp;
+              currComp.q = *((int16_t *) rawData); //cstat !MISRAC2012-Rule-11.3
+              currComp.d = *((int16_t *) &rawData[2]); //cstat !MISRAC2012-Rule-11.3
+              MCI_SetCurrentReferences(pMCIN, currComp);
               break;
             }
 
-            case MC_REG_I_D_REF:
+            default:
             {
-              *regdata16 = MCI_GetIqdref(pMCIN).d;
+              retVal = MCP_ERROR_UNKNOWN_REG;
               break;
             }
+          }
+        }
+        break;
+      }
 
-            case MC_REG_V_Q:
-            {
-              *regdata16 = MCI_GetVqd(pMCIN).q;
-              break;
-            }
+      default:
+      {
+        retVal = MCP_ERROR_BAD_DATA_TYPE;
+        *size =0; /* From this point we are not able anymore to decode the RX buffer*/
+        break;
+      }
+    }
+#ifdef NULL_PTR_REG_INT
+  }
+#endif
+  return (retVal);
+}
 
-            case MC_REG_V_D:
-            {
-              *regdata16 = MCI_GetVqd(pMCIN).d;
-              break;
-            }
+/* Readers of the 16 bits registers, indexed by their element identifier, so that the
+   registers polled by the monitoring are read without walking a switch. The unsigned
+   registers are returned with their bit pattern. */
+typedef int16_t (*RI_Reg16Reader_t)(uint8_t motorID);
 
-            case MC_REG_V_ALPHA:
-            {
-              *regdata16 = MCI_GetValphabeta(pMCIN).alpha;
-              break;
-            }
+static int16_t RI_GetSpeedKp(uint8_t motorID)
+{
+  return (PID_GetKP(pPIDSpeed[motorID]));
+}
 
-            case MC_REG_V_BETA:
-            {
-              *regdata16 = MCI_GetValphabeta(pMCIN).beta;
-              break;
-            }
-            case MC_REG_STOPLL_EL_ANGLE:
-            {
-              //cstat !MISRAC2012-Rule-11.3
-              *regdata16 = SPD_GetElAngle((SpeednPosFdbk_Handle_t *)stoPLLSensor[motorID]);
-              break;
-            }
+static int16_t RI_GetSpeedKi(uint8_t motorID)
+{
+  return (PID_GetKI(pPIDSpeed[motorID]));
+}
 
-            case MC_REG_STOPLL_ROT_SPEED:
-            {
-              //cstat !MISRAC2012-Rule-11.3
-              *regdata16 = SPD_GetS16Speed((SpeednPosFdbk_Handle_t *)stoPLLSensor[motorID]);
-              break;
-            }
+static int16_t RI_GetSpeedKd(uint8_t motorID)
+{
+  return (PID_GetKD(pPIDSpeed[motorID]));
+}
 
-            case MC_REG_STOPLL_I_ALPHA:
-            {
-              *regdata16 = STO_PLL_GetEstimatedCurrent(stoPLLSensor[motorID]).alpha;
-              break;
-            }
+static int16_t RI_GetFluxwkKp(uint8_t motorID)
+{
+  return (PID_GetKP(pPIDFW[motorID]));
+}
 
-            case MC_REG_STOPLL_I_BETA:
-            {
-              *regdata16 = STO_PLL_GetEstimatedCurrent(stoPLLSensor[motorID]).beta;
-              break;
-            }
+static int16_t RI_GetFluxwkKi(uint8_t motorID)
+{
+  return (PID_GetKI(pPIDFW[motorID]));
+}
 
-            case MC_REG_STOPLL_BEMF_ALPHA:
-            {
-              *regdata16 = STO_PLL_GetEstimatedBemf(stoPLLSensor[motorID]).alpha;
-              break;
-            }
+static int16_t RI_GetFluxwkBus(uint8_t motorID)
+{
+  return ((int16_t)FW_GetVref(pFW[motorID]));
+}
 
-            case MC_REG_STOPLL_BEMF_BETA:
-            {
-              *regdata16 = STO_PLL_GetEstimatedBemf(stoPLLSensor[motorID]).beta;
-              break;
-            }
+static int16_t RI_GetFluxwkBusMeas(uint8_t motorID)
+{
+  return ((int16_t)FW_GetAvVPercentage(pFW[motorID]));
+}
 
-            case MC_REG_STOPLL_C1:
-            {
-              int16_t hC1;
-              int16_t hC2;
-              STO_PLL_GetObserverGains(stoPLLSensor[motorID], &hC1, &hC2);
-              *regdata16 = hC1;
-              break;
-            }
+static int16_t RI_GetIQKp(uint8_t motorID)
+{
+  return (PID_GetKP(pPIDIq[motorID]));
+}
 
-            case MC_REG_STOPLL_C2:
-            {
-              int16_t hC1;
-              int16_t hC2;
-              STO_PLL_GetObserverGains(stoPLLSensor[motorID], &hC1, &hC2);
-              *regdata16 = hC2;
-              break;
-            }
+static int16_t RI_GetIQKi(uint8_t motorID)
+{
+  return (PID_GetKI(pPIDIq[motorID]));
+}
 
-            case MC_REG_STOPLL_KI:
-            {
-              *regdata16 = PID_GetKI (&stoPLLSensor[motorID]->PIRegulator);
-              break;
-            }
+static int16_t RI_GetIQKd(uint8_t motorID)
+{
+  return (PID_GetKD(pPIDIq[motorID]));
+}
 
-            case MC_REG_STOPLL_KP:
-            {
-              *regdata16 = PID_GetKP (&stoPLLSensor[motorID]->PIRegulator);
-              break;
-            }
+static int16_t RI_GetIDKp(uint8_t motorID)
+{
+  return (PID_GetKP(pPIDId[motorID]));
+}
 
-            case MC_REG_DAC_USER1:
-            case MC_REG_DAC_USER2:
-              break;
+static int16_t RI_GetIDKi(uint8_t motorID)
+{
+  return (PID_GetKI(pPIDId[motorID]));
+}
 
-            case MC_REG_SPEED_KP_DIV:
-            {
-              *regdataU16 = (uint16_t)PID_GetKPDivisorPOW2(pPIDSpeed[motorID]);
-              break;
-            }
+static int16_t RI_GetIDKd(uint8_t motorID)
+{
+  return (PID_GetKD(pPIDId[motorID]));
+}
 
-            case MC_REG_SPEED_KI_DIV:
-            {
-              *regdataU16 = (uint16_t)PID_GetKIDivisorPOW2(pPIDSpeed[motorID]);
-              break;
-            }
+static int16_t RI_GetBusVoltage(uint8_t motorID)
+{
+  return ((int16_t)VBS_GetAvBusVoltage_V(BusVoltageSensor[motorID]));
+}
 
-            case MC_REG_SPEED_KD_DIV:
-            {
-              *regdataU16 = PID_GetKDDivisorPOW2(pPIDSpeed[motorID]);
-              break;
-            }
-            case MC_REG_I_D_KP_DIV:
-            {
-              *regdataU16 = PID_GetKPDivisorPOW2(pPIDId[motorID]);
-              break;
-            }
+static int16_t RI_GetHeatsTemp(uint8_t motorID)
+{
+  return (NTC_GetAvTemp_C(pTemperatureSensor[motorID]));
+}
 
-            case MC_REG_I_D_KI_DIV:
-            {
-              *regdataU16 = PID_GetKIDivisorPOW2(pPIDId[motorID]);
-              break;
-            }
+static int16_t RI_GetMotorPower(uint8_t motorID)
+{
+  return (MPM_GetAvrgElMotorPowerW((MotorPowMeas_Handle_t *)pMPM[motorID])); //cstat !MISRAC2012-Rule-11.3
+}
 
-            case MC_REG_I_D_KD_DIV:
-            {
-              *regdataU16 = PID_GetKDDivisorPOW2(pPIDId[motorID]);
-              break;
-            }
+static int16_t RI_GetMotorCopperLoss(uint8_t motorID)
+{
+  return (PQD_GetCopperLossW(pMPM[motorID]));
+}
 
-            case MC_REG_I_Q_KP_DIV:
-            {
-              *regdataU16 = PID_GetKPDivisorPOW2(pPIDIq[motorID]);
-              break;
-            }
+static int16_t RI_GetMotorEfficiency(uint8_t motorID)
+{
+  return (PQD_GetEfficiency(pMPM[motorID]));
+}
 
-            case MC_REG_I_Q_KI_DIV:
-            {
-              *regdataU16 = PID_GetKIDivisorPOW2(pPIDIq[motorID]);
-              break;
-            }
+static int16_t RI_GetReadyTime(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)TSK_GetReadyTimeM1());
+}
 
-            case MC_REG_I_Q_KD_DIV:
-            {
-              *regdataU16 = PID_GetKDDivisorPOW2(pPIDIq[motorID]);
-              break;
-            }
+static int16_t RI_GetStartUpTime(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)TSK_GetStartUpTimeM1());
+}
 
-            case MC_REG_STOPLL_KI_DIV:
-            {
-              *regdataU16 = PID_GetKIDivisorPOW2(&stoPLLSensor[motorID]->PIRegulator);
-              break;
-            }
+#ifdef MC_BOARD_DAC
+static int16_t RI_GetDacOut1(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)DAC_GetChannelConfig(&DAC_Handle , DAC_CH1));
+}
 
-            case MC_REG_STOPLL_KP_DIV:
-            {
-              *regdataU16 = PID_GetKPDivisorPOW2(&stoPLLSensor[motorID]->PIRegulator);
-              break;
-            }
+static int16_t RI_GetDacOut2(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)DAC_GetChannelConfig(&DAC_Handle , DAC_CH2));
+}
+#endif
 
-            default:
-            {
-              retVal = MCP_ERROR_UNKNOWN_REG;
-              break;
-            }
-          }
-          *size = 2;
-        }
-        else
-        {
-          retVal = MCP_ERROR_NO_TXSYNC_SPACE;
-        }
-        break;
-      }
+static int16_t RI_GetIA(uint8_t motorID)
+{
+  return (MCI_GetIab(&Mci[motorID]).a);
+}
 
-      case TYPE_DATA_32BIT:
-      {
-        uint32_t *regdataU32 = (uint32_t *)data; //cstat !MISRAC2012-Rule-11.3
-        int32_t *regdata32 = (int32_t *)data; //cstat !MISRAC2012-Rule-11.3
+static int16_t RI_GetIB(uint8_t motorID)
+{
+  return (MCI_GetIab(&Mci[motorID]).b);
+}
 
-        if (freeSpace >= 4U)
+static int16_t RI_GetIAlphaMeas(uint8_t motorID)
+{
+  return (MCI_GetIalphabeta(&Mci[motorID]).alpha);
+}
+
+static int16_t RI_GetIBetaMeas(uint8_t motorID)
+{
+  return (MCI_GetIalphabeta(&Mci[motorID]).beta);
+}
+
+static int16_t RI_GetIQMeas(uint8_t motorID)
+{
+  return (MCI_GetIqd(&Mci[motorID]).q);
+}
+
+static int16_t RI_GetIDMeas(uint8_t motorID)
+{
+  return (MCI_GetIqd(&Mci[motorID]).d);
+}
+
+static int16_t RI_GetIQRef(uint8_t motorID)
+{
+  return (MCI_GetIqdref(&Mci[motorID]).q);
+}
+
+static int16_t RI_GetIDRef(uint8_t motorID)
+{
+  return (MCI_GetIqdref(&Mci[motorID]).d);
+}
+
+static int16_t RI_GetVQ(uint8_t motorID)
+{
+  return (MCI_GetVqd(&Mci[motorID]).q);
+}
+
+static int16_t RI_GetVD(uint8_t motorID)
+{
+  return (MCI_GetVqd(&Mci[motorID]).d);
+}
+
+static int16_t RI_GetVAlpha(uint8_t motorID)
+{
+  return (MCI_GetValphabeta(&Mci[motorID]).alpha);
+}
+
+static int16_t RI_GetVBeta(uint8_t motorID)
+{
+  return (MCI_GetValphabeta(&Mci[motorID]).beta);
+}
+
+static int16_t RI_GetStopllElAngle(uint8_t motorID)
+{
+  return (SPD_GetElAngle((SpeednPosFdbk_Handle_t *)stoPLLSensor[motorID]));
+}
+
+static int16_t RI_GetStopllRotSpeed(uint8_t motorID)
+{
+  return (SPD_GetS16Speed((SpeednPosFdbk_Handle_t *)stoPLLSensor[motorID]));
+}
+
+static int16_t RI_GetStopllIAlpha(uint8_t motorID)
+{
+  return (STO_PLL_GetEstimatedCurrent(stoPLLSensor[motorID]).alpha);
+}
+
+static int16_t RI_GetStopllIBeta(uint8_t motorID)
+{
+  return (STO_PLL_GetEstimatedCurrent(stoPLLSensor[motorID]).beta);
+}
+
+static int16_t RI_GetStopllBemfAlpha(uint8_t motorID)
+{
+  return (STO_PLL_GetEstimatedBemf(stoPLLSensor[motorID]).alpha);
+}
+
+static int16_t RI_GetStopllBemfBeta(uint8_t motorID)
+{
+  return (STO_PLL_GetEstimatedBemf(stoPLLSensor[motorID]).beta);
+}
+
+static int16_t RI_GetStopllC1(uint8_t motorID)
+{
+  int16_t hC1;
+  int16_t hC2;
+  STO_PLL_GetObserverGains(stoPLLSensor[motorID], &hC1, &hC2);
+  return (hC1);
+}
+
+static int16_t RI_GetStopllC2(uint8_t motorID)
+{
+  int16_t hC1;
+  int16_t hC2;
+  STO_PLL_GetObserverGains(stoPLLSensor[motorID], &hC1, &hC2);
+  return (hC2);
+}
+
+static int16_t RI_GetStopllKi(uint8_t motorID)
+{
+  int16_t hKp;
+  int16_t hKi;
+  STO_GetPLLGains(stoPLLSensor[motorID], &hKp, &hKi);
+  return (hKi);
+}
+
+static int16_t RI_GetStopllKp(uint8_t motorID)
+{
+  int16_t hKp;
+  int16_t hKi;
+  STO_GetPLLGains(stoPLLSensor[motorID], &hKp, &hKi);
+  return (hKp);
+}
+
+static int16_t RI_GetDacUser(uint8_t motorID)
+{
+  (void)motorID;
+  return (0);
+}
+
+static int16_t RI_GetSpeedKpDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKPDivisorPOW2(pPIDSpeed[motorID]));
+}
+
+static int16_t RI_GetSpeedKiDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKIDivisorPOW2(pPIDSpeed[motorID]));
+}
+
+static int16_t RI_GetFluxwkKpDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKPDivisorPOW2(pPIDFW[motorID]));
+}
+
+static int16_t RI_GetFluxwkKiDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKIDivisorPOW2(pPIDFW[motorID]));
+}
+
+static int16_t RI_GetSpeedKdDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKDDivisorPOW2(pPIDSpeed[motorID]));
+}
+
+static int16_t RI_GetIDKpDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKPDivisorPOW2(pPIDId[motorID]));
+}
+
+static int16_t RI_GetIDKiDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKIDivisorPOW2(pPIDId[motorID]));
+}
+
+static int16_t RI_GetIDKdDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKDDivisorPOW2(pPIDId[motorID]));
+}
+
+static int16_t RI_GetIQKpDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKPDivisorPOW2(pPIDIq[motorID]));
+}
+
+static int16_t RI_GetIQKiDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKIDivisorPOW2(pPIDIq[motorID]));
+}
+
+static int16_t RI_GetIQKdDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKDDivisorPOW2(pPIDIq[motorID]));
+}
+
+static int16_t RI_GetStopllKiDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKIDivisorPOW2(&stoPLLSensor[motorID]->PIRegulator));
+}
+
+static int16_t RI_GetStopllKpDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKPDivisorPOW2(&stoPLLSensor[motorID]->PIRegulator));
+}
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+static int16_t RI_GetPccSwWeight(uint8_t motorID)
+{
+  return ((int16_t)PCC_GetSwitchingWeight(pPCC[motorID]));
+}
+
+static int16_t RI_GetPccDecision(uint8_t motorID)
+{
+  return ((int16_t)pPCC[motorID]->hLogDecision);
+}
+
+static int16_t RI_GetPccCost(uint8_t motorID)
+{
+  return ((int16_t)pPCC[motorID]->hLogCost);
+}
+
+static int16_t RI_GetPccIQPred(uint8_t motorID)
+{
+  return (PCC_GetPredictedIqd(pPCC[motorID]).q);
+}
+
+static int16_t RI_GetPccIDPred(uint8_t motorID)
+{
+  return (PCC_GetPredictedIqd(pPCC[motorID]).d);
+}
+
+static int16_t RI_GetPccFallbacks(uint8_t motorID)
+{
+  return ((int16_t)PCC_GetFallbackEvents(pPCC[motorID]));
+}
+
+static int16_t RI_GetPccResidualEvents(uint8_t motorID)
+{
+  return ((int16_t)PCC_GetResidualEvents(pPCC[motorID]));
+}
+
+#endif
+#ifdef MC_CAPTURE_MODE
+static int16_t RI_GetCaptureIndex(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)MC_Capture_GetReadIndex());
+}
+
+#endif
+#ifdef MC_RECORD_MODE
+static int16_t RI_GetRecordIndex(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)MC_Record_GetReadIndex());
+}
+
+#endif
+#ifdef MC_PIL_MODE
+static int16_t RI_GetPilStepRate(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)MC_Pil_GetStepRate());
+}
+
+#endif
+#ifdef MC_FAULTLOG_MODE
+static int16_t RI_GetFaultLogIndex(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)MC_FaultLog_GetReadIndex());
+}
+
+#endif
+#ifdef THERMAL_DERATING
+static int16_t RI_GetThermalHeadroom(uint8_t motorID)
+{
+  return (TDR_GetHeadroom_C(pTDR[motorID]));
+}
+
+static int16_t RI_GetThermalCurrLimit(uint8_t motorID)
+{
+  return (TDR_GetCurrLimit(pTDR[motorID]));
+}
+
+static int16_t RI_GetWindingTemp(uint8_t motorID)
+{
+  return (TDR_GetTemp_C(pTDR[motorID], TDR_WINDING));
+}
+
+#endif
+#ifdef LOSS_MINIMIZATION
+static int16_t RI_GetLmnIdOffset(uint8_t motorID)
+{
+  return (LMN_GetIdOffset(pLMN[motorID]));
+}
+
+#endif
+#ifdef MC_FRA_MODE
+static int16_t RI_GetFraIndex(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)MC_Fra_GetReadIndex());
+}
+
+#endif
+#ifdef MC_SPECTRUM_MODE
+static int16_t RI_GetSpectrumThd(uint8_t motorID)
+{
+  (void)motorID;
+  return ((int16_t)MC_Spectrum_GetThd());
+}
+
+#endif
+#ifdef SIX_STEP_MODE
+static int16_t RI_GetSixStepEntries(uint8_t motorID)
+{
+  return ((int16_t)SSM_GetEntries(pSSM[motorID]));
+}
+
+#endif
+#ifdef LOAD_TORQUE_OBSERVER
+static int16_t RI_GetLoadTorque(uint8_t motorID)
+{
+  return (LTO_GetLoad(pLTO[motorID]));
+}
+
+#endif
+#ifdef M1_POSITION_CTRL
+static int16_t RI_GetPositionKp(uint8_t motorID)
+{
+  return (PID_GetKP(pPIDPos[motorID]));
+}
+
+static int16_t RI_GetPositionKi(uint8_t motorID)
+{
+  return (PID_GetKI(pPIDPos[motorID]));
+}
+
+static int16_t RI_GetPositionKd(uint8_t motorID)
+{
+  return (PID_GetKD(pPIDPos[motorID]));
+}
+
+static int16_t RI_GetPositionKpDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKPDivisorPOW2(pPIDPos[motorID]));
+}
+
+static int16_t RI_GetPositionKiDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKIDivisorPOW2(pPIDPos[motorID]));
+}
+
+static int16_t RI_GetPositionKdDiv(uint8_t motorID)
+{
+  return ((int16_t)PID_GetKDDivisorPOW2(pPIDPos[motorID]));
+}
+
+#endif
+static const RI_Reg16Reader_t RI_Reg16Readers[] =
+{
+  [MC_REG_SPEED_KP >> ELT_IDENTIFIER_POS] = &RI_GetSpeedKp,
+  [MC_REG_SPEED_KI >> ELT_IDENTIFIER_POS] = &RI_GetSpeedKi,
+  [MC_REG_SPEED_KD >> ELT_IDENTIFIER_POS] = &RI_GetSpeedKd,
+  [MC_REG_FLUXWK_KP >> ELT_IDENTIFIER_POS] = &RI_GetFluxwkKp,
+  [MC_REG_FLUXWK_KI >> ELT_IDENTIFIER_POS] = &RI_GetFluxwkKi,
+  [MC_REG_FLUXWK_BUS >> ELT_IDENTIFIER_POS] = &RI_GetFluxwkBus,
+  [MC_REG_FLUXWK_BUS_MEAS >> ELT_IDENTIFIER_POS] = &RI_GetFluxwkBusMeas,
+  [MC_REG_I_Q_KP >> ELT_IDENTIFIER_POS] = &RI_GetIQKp,
+  [MC_REG_I_Q_KI >> ELT_IDENTIFIER_POS] = &RI_GetIQKi,
+  [MC_REG_I_Q_KD >> ELT_IDENTIFIER_POS] = &RI_GetIQKd,
+  [MC_REG_I_D_KP >> ELT_IDENTIFIER_POS] = &RI_GetIDKp,
+  [MC_REG_I_D_KI >> ELT_IDENTIFIER_POS] = &RI_GetIDKi,
+  [MC_REG_I_D_KD >> ELT_IDENTIFIER_POS] = &RI_GetIDKd,
+  [MC_REG_BUS_VOLTAGE >> ELT_IDENTIFIER_POS] = &RI_GetBusVoltage,
+  [MC_REG_HEATS_TEMP >> ELT_IDENTIFIER_POS] = &RI_GetHeatsTemp,
+  [MC_REG_MOTOR_POWER >> ELT_IDENTIFIER_POS] = &RI_GetMotorPower,
+  [MC_REG_MOTOR_COPPER_LOSS >> ELT_IDENTIFIER_POS] = &RI_GetMotorCopperLoss,
+  [MC_REG_MOTOR_EFFICIENCY >> ELT_IDENTIFIER_POS] = &RI_GetMotorEfficiency,
+  [MC_REG_READY_TIME >> ELT_IDENTIFIER_POS] = &RI_GetReadyTime,
+  [MC_REG_STARTUP_TIME >> ELT_IDENTIFIER_POS] = &RI_GetStartUpTime,
+#ifdef MC_BOARD_DAC
+  [MC_REG_DAC_OUT1 >> ELT_IDENTIFIER_POS] = &RI_GetDacOut1,
+  [MC_REG_DAC_OUT2 >> ELT_IDENTIFIER_POS] = &RI_GetDacOut2,
+#endif
+  [MC_REG_I_A >> ELT_IDENTIFIER_POS] = &RI_GetIA,
+  [MC_REG_I_B >> ELT_IDENTIFIER_POS] = &RI_GetIB,
+  [MC_REG_I_ALPHA_MEAS >> ELT_IDENTIFIER_POS] = &RI_GetIAlphaMeas,
+  [MC_REG_I_BETA_MEAS >> ELT_IDENTIFIER_POS] = &RI_GetIBetaMeas,
+  [MC_REG_I_Q_MEAS >> ELT_IDENTIFIER_POS] = &RI_GetIQMeas,
+  [MC_REG_I_D_MEAS >> ELT_IDENTIFIER_POS] = &RI_GetIDMeas,
+  [MC_REG_I_Q_REF >> ELT_IDENTIFIER_POS] = &RI_GetIQRef,
+  [MC_REG_I_D_REF >> ELT_IDENTIFIER_POS] = &RI_GetIDRef,
+  [MC_REG_V_Q >> ELT_IDENTIFIER_POS] = &RI_GetVQ,
+  [MC_REG_V_D >> ELT_IDENTIFIER_POS] = &RI_GetVD,
+  [MC_REG_V_ALPHA >> ELT_IDENTIFIER_POS] = &RI_GetVAlpha,
+  [MC_REG_V_BETA >> ELT_IDENTIFIER_POS] = &RI_GetVBeta,
+  [MC_REG_STOPLL_EL_ANGLE >> ELT_IDENTIFIER_POS] = &RI_GetStopllElAngle,
+  [MC_REG_STOPLL_ROT_SPEED >> ELT_IDENTIFIER_POS] = &RI_GetStopllRotSpeed,
+  [MC_REG_STOPLL_I_ALPHA >> ELT_IDENTIFIER_POS] = &RI_GetStopllIAlpha,
+  [MC_REG_STOPLL_I_BETA >> ELT_IDENTIFIER_POS] = &RI_GetStopllIBeta,
+  [MC_REG_STOPLL_BEMF_ALPHA >> ELT_IDENTIFIER_POS] = &RI_GetStopllBemfAlpha,
+  [MC_REG_STOPLL_BEMF_BETA >> ELT_IDENTIFIER_POS] = &RI_GetStopllBemfBeta,
+  [MC_REG_STOPLL_C1 >> ELT_IDENTIFIER_POS] = &RI_GetStopllC1,
+  [MC_REG_STOPLL_C2 >> ELT_IDENTIFIER_POS] = &RI_GetStopllC2,
+  [MC_REG_STOPLL_KI >> ELT_IDENTIFIER_POS] = &RI_GetStopllKi,
+  [MC_REG_STOPLL_KP >> ELT_IDENTIFIER_POS] = &RI_GetStopllKp,
+  [MC_REG_DAC_USER1 >> ELT_IDENTIFIER_POS] = &RI_GetDacUser,
+  [MC_REG_DAC_USER2 >> ELT_IDENTIFIER_POS] = &RI_GetDacUser,
+  [MC_REG_SPEED_KP_DIV >> ELT_IDENTIFIER_POS] = &RI_GetSpeedKpDiv,
+  [MC_REG_SPEED_KI_DIV >> ELT_IDENTIFIER_POS] = &RI_GetSpeedKiDiv,
+  [MC_REG_FLUXWK_KP_DIV >> ELT_IDENTIFIER_POS] = &RI_GetFluxwkKpDiv,
+  [MC_REG_FLUXWK_KI_DIV >> ELT_IDENTIFIER_POS] = &RI_GetFluxwkKiDiv,
+  [MC_REG_SPEED_KD_DIV >> ELT_IDENTIFIER_POS] = &RI_GetSpeedKdDiv,
+  [MC_REG_I_D_KP_DIV >> ELT_IDENTIFIER_POS] = &RI_GetIDKpDiv,
+  [MC_REG_I_D_KI_DIV >> ELT_IDENTIFIER_POS] = &RI_GetIDKiDiv,
+  [MC_REG_I_D_KD_DIV >> ELT_IDENTIFIER_POS] = &RI_GetIDKdDiv,
+  [MC_REG_I_Q_KP_DIV >> ELT_IDENTIFIER_POS] = &RI_GetIQKpDiv,
+  [MC_REG_I_Q_KI_DIV >> ELT_IDENTIFIER_POS] = &RI_GetIQKiDiv,
+  [MC_REG_I_Q_KD_DIV >> ELT_IDENTIFIER_POS] = &RI_GetIQKdDiv,
+  [MC_REG_STOPLL_KI_DIV >> ELT_IDENTIFIER_POS] = &RI_GetStopllKiDiv,
+  [MC_REG_STOPLL_KP_DIV >> ELT_IDENTIFIER_POS] = &RI_GetStopllKpDiv,
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  [MC_REG_PCC_SW_WEIGHT >> ELT_IDENTIFIER_POS] = &RI_GetPccSwWeight,
+  [MC_REG_PCC_DECISION >> ELT_IDENTIFIER_POS] = &RI_GetPccDecision,
+  [MC_REG_PCC_COST >> ELT_IDENTIFIER_POS] = &RI_GetPccCost,
+  [MC_REG_PCC_I_Q_PRED >> ELT_IDENTIFIER_POS] = &RI_GetPccIQPred,
+  [MC_REG_PCC_I_D_PRED >> ELT_IDENTIFIER_POS] = &RI_GetPccIDPred,
+  [MC_REG_PCC_FALLBACKS >> ELT_IDENTIFIER_POS] = &RI_GetPccFallbacks,
+  [MC_REG_PCC_RESIDUAL_EVENTS >> ELT_IDENTIFIER_POS] = &RI_GetPccResidualEvents,
+#endif
+#ifdef MC_CAPTURE_MODE
+  [MC_REG_CAPTURE_INDEX >> ELT_IDENTIFIER_POS] = &RI_GetCaptureIndex,
+#endif
+#ifdef MC_RECORD_MODE
+  [MC_REG_RECORD_INDEX >> ELT_IDENTIFIER_POS] = &RI_GetRecordIndex,
+#endif
+#ifdef MC_PIL_MODE
+  [MC_REG_PIL_STEP_RATE >> ELT_IDENTIFIER_POS] = &RI_GetPilStepRate,
+#endif
+#ifdef MC_FAULTLOG_MODE
+  [MC_REG_FAULTLOG_INDEX >> ELT_IDENTIFIER_POS] = &RI_GetFaultLogIndex,
+#endif
+#ifdef THERMAL_DERATING
+  [MC_REG_THERMAL_HEADROOM >> ELT_IDENTIFIER_POS] = &RI_GetThermalHeadroom,
+  [MC_REG_THERMAL_CURR_LIMIT >> ELT_IDENTIFIER_POS] = &RI_GetThermalCurrLimit,
+  [MC_REG_WINDING_TEMP >> ELT_IDENTIFIER_POS] = &RI_GetWindingTemp,
+#endif
+#ifdef LOSS_MINIMIZATION
+  [MC_REG_LMN_ID_OFFSET >> ELT_IDENTIFIER_POS] = &RI_GetLmnIdOffset,
+#endif
+#ifdef MC_FRA_MODE
+  [MC_REG_FRA_INDEX >> ELT_IDENTIFIER_POS] = &RI_GetFraIndex,
+#endif
+#ifdef MC_SPECTRUM_MODE
+  [MC_REG_SPECTRUM_THD >> ELT_IDENTIFIER_POS] = &RI_GetSpectrumThd,
+#endif
+#ifdef SIX_STEP_MODE
+  [MC_REG_SIX_STEP_ENTRIES >> ELT_IDENTIFIER_POS] = &RI_GetSixStepEntries,
+#endif
+#ifdef LOAD_TORQUE_OBSERVER
+  [MC_REG_LOAD_TORQUE >> ELT_IDENTIFIER_POS] = &RI_GetLoadTorque,
+#endif
+#ifdef M1_POSITION_CTRL
+  [MC_REG_POSITION_KP >> ELT_IDENTIFIER_POS] = &RI_GetPositionKp,
+  [MC_REG_POSITION_KI >> ELT_IDENTIFIER_POS] = &RI_GetPositionKi,
+  [MC_REG_POSITION_KD >> ELT_IDENTIFIER_POS] = &RI_GetPositionKd,
+  [MC_REG_POSITION_KP_DIV >> ELT_IDENTIFIER_POS] = &RI_GetPositionKpDiv,
+  [MC_REG_POSITION_KI_DIV >> ELT_IDENTIFIER_POS] = &RI_GetPositionKiDiv,
+  [MC_REG_POSITION_KD_DIV >> ELT_IDENTIFIER_POS] = &RI_GetPositionKdDiv,
+#endif
+};
+#define RI_NB_REG16  (sizeof(RI_Reg16Readers) / sizeof(RI_Reg16Readers[0]))
+
+uint8_t RI_GetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t freeSpace)
+{
+  uint8_t retVal = MCP_CMD_OK;
+#ifdef NULL_PTR_REG_INT
+  if ((MC_NULL == data) || (MC_NULL == size))
+  {
+    retVal = MCP_CMD_NOK;
+  }
+  else
+  {
+#endif
+    uint16_t regID = dataID & REG_MASK;
+    uint8_t typeID = ((uint8_t)dataID) & TYPE_MASK;
+    uint8_t motorID = 0U;
+
+    MCI_Handle_t *pMCIN = &Mci[motorID];
+    switch (typeID)
+    {
+      case TYPE_DATA_8BIT:
+      {
+        if (freeSpace > 0U)
         {
           switch (regID)
           {
-            case MC_REG_FAULTS_FLAGS:
+            case MC_REG_STATUS:
             {
-              *regdataU32 = MCI_GetFaultState(pMCIN);
+              *data = (uint8_t)MCI_GetSTMState(pMCIN);
               break;
             }
 
-            case MC_REG_SPEED_MEAS:
+            case MC_REG_CONTROL_MODE:
             {
-              *regdata32 = (((int32_t)MCI_GetAvrgMecSpeedUnit(pMCIN) * U_RPM) / SPEED_UNIT);
+              *data = (uint8_t)MCI_GetControlMode(pMCIN);
               break;
             }
 
-            case MC_REG_SPEED_REF:
+            case MC_REG_RUC_STAGE_NBR:
             {
-              *regdata32 = (((int32_t)MCI_GetMecSpeedRefUnit(pMCIN) * U_RPM) / SPEED_UNIT);
+              *data = (RevUpControl[motorID] != MC_NULL) ? (uint8_t)RUC_GetNumberOfPhases(RevUpControl[motorID]) : 0U;
               break;
             }
 
-            case MC_REG_STOPLL_EST_BEMF:
+#ifdef MC_BOARD_OBSERVER_SEL
+            case MC_REG_OBSERVER_SEL:
             {
-              *regdata32 = STO_PLL_GetEstimatedBemfLevel(stoPLLSensor[motorID]);
+              *data = TSK_GetObserverM1();
               break;
             }
+#endif
 
-            case MC_REG_STOPLL_OBS_BEMF:
+#ifdef MC_CAPTURE_MODE
+            case MC_REG_CAPTURE_STATE:
             {
-              *regdata32 = STO_PLL_GetObservedBemfLevel(stoPLLSensor[motorID]);
+              *data = (uint8_t)MC_Capture_GetState();
+              break;
+            }
+#endif
+
+#ifdef MC_PROFILE_MODE
+            case MC_REG_PROFILE_SEL:
+            {
+              *data = MC_Profile_GetSelected();
+              break;
+            }
+#endif
+
+#ifdef MC_RECORD_MODE
+            case MC_REG_RECORD_STATE:
+            {
+              *data = (uint8_t)MC_Record_GetState();
               break;
             }
-
-            default:
+#endif
+
+#ifdef MC_PIL_MODE
+            case MC_REG_PIL_STATE:
+            {
+              *data = (uint8_t)MC_Pil_GetState();
+              break;
+            }
+#endif
+
+#ifdef MC_FAULTLOG_MODE
+            case MC_REG_FAULTLOG_COUNT:
+            {
+              uint16_t hCount = MC_FaultLog_GetCount();
+              *data = (hCount < UINT8_MAX) ? (uint8_t)hCount : UINT8_MAX;
+              break;
+            }
+#endif
+
+#ifdef HARMONIC_COMPENSATION
+            case MC_REG_HCM_STATE:
+            {
+              *data = (uint8_t)HCM_GetState(pHCM[motorID]);
+              break;
+            }
+#endif
+
+#ifdef MC_FRA_MODE
+            case MC_REG_FRA_STATE:
+            {
+              *data = (uint8_t)MC_Fra_GetState();
+              break;
+            }
+#endif
+
+#ifdef MC_ABTEST_MODE
+            case MC_REG_ABTEST_STATE:
+            {
+              *data = (uint8_t)MC_ABTest_GetState();
+              break;
+            }
+#endif
+
+#ifdef MC_WARMBOOT_MODE
+            case MC_REG_WARMBOOT:
+            {
+              *data = (uint8_t)MC_WarmBoot_GetKind();
+              break;
+            }
+#endif
+
+            case MC_REG_ASPEP_SYNC_DEPTH:
+            {
+              *data = (uint8_t)ASPEP_SYNC_NB_BUFFERS;
+              break;
+            }
+
+#ifdef DBG_MCU_LOAD_MEASURE
+            case MC_REG_PERF_TRACE:
+            {
+              *data = perfTrace;
+              break;
+            }
+#endif
+
+#ifdef M1_POSITION_CTRL
+            case MC_REG_POSITION_CTRL_STATE:
+            {
+              *data = (uint8_t)MCI_GetPositionCtrlStatus(pMCIN);
+              break;
+            }
+#endif
+
+            default:
+            {
+              retVal = MCP_ERROR_UNKNOWN_REG;
+              break;
+            }
+          }
+          *size = 1;
+        }
+        else
+        {
+          retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+        }
+        break;
+      }
+
+      case TYPE_DATA_16BIT:
+      {
+        int16_t *regdata16 = (int16_t *) data; //cstat !MISRAC2012-Rule-11.3
+        uint16_t eltID = regID >> ELT_IDENTIFIER_POS;
+
+        if (freeSpace >= 2U)
+        {
+          if ((eltID < RI_NB_REG16) && (RI_Reg16Readers[eltID] != MC_NULL))
+          {
+            *regdata16 = RI_Reg16Readers[eltID](motorID);
+          }
+          else
+          {
+            retVal = MCP_ERROR_UNKNOWN_REG;
+          }
+          *size = 2;
+        }
+        else
+        {
+          retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+        }
+        break;
+      }
+
+      case TYPE_DATA_32BIT:
+      {
+        uint32_t *regdataU32 = (uint32_t *)data; //cstat !MISRAC2012-Rule-11.3
+        int32_t *regdata32 = (int32_t *)data; //cstat !MISRAC2012-Rule-11.3
+
+        if (freeSpace >= 4U)
+        {
+          switch (regID)
+          {
+            case MC_REG_FAULTS_FLAGS:
+            {
+              *regdataU32 = MCI_GetFaultState(pMCIN);
+              break;
+            }
+
+            case MC_REG_SPEED_MEAS:
+            {
+              *regdata32 = (((int32_t)MCI_GetAvrgMecSpeedUnit(pMCIN) * U_RPM) / SPEED_UNIT);
+              break;
+            }
+
+            case MC_REG_SPEED_REF:
+            {
+              *regdata32 = (((int32_t)MCI_GetMecSpeedRefUnit(pMCIN) * U_RPM) / SPEED_UNIT);
+              break;
+            }
+
+            case MC_REG_STOPLL_EST_BEMF:
+            {
+              *regdata32 = STO_PLL_GetEstimatedBemfLevel(stoPLLSensor[motorID]);
+              break;
+            }
+
+            case MC_REG_STOPLL_OBS_BEMF:
+            {
+              *regdata32 = STO_PLL_GetObservedBemfLevel(stoPLLSensor[motorID]);
+              break;
+            }
+
+#ifdef M1_POSITION_CTRL
+            case MC_REG_CURRENT_POSITION:
+            {
+              /* Multi-turn mechanical angle, 65536 per revolution */
+              *regdata32 = SPD_GetMecAngle(&ENCODER_M1._Super);
+              break;
+            }
+#endif
+
+#ifdef MC_PWMFREQ_MODE
+            case MC_REG_PWM_FREQUENCY:
+            {
+              *regdataU32 = MC_PwmFreq_Get();
+              break;
+            }
+#endif
+
+#ifdef MC_GAP_MODE
+            case MC_REG_GAP_ERRORS:
+            {
+              /* GAP_ERROR_CODE_xxx of all the gate drivers */
+              *regdataU32 = MC_Gap_GetErrors();
+              break;
+            }
+#endif
+
+            default:
+            {
+              retVal = MCP_ERROR_UNKNOWN_REG;
+              break;
+            }
+          }
+          *size = 4;
+        }
+        else
+        {
+          retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+        }
+        break;
+      }
+
+      case TYPE_DATA_STRING:
+      {
+        char_t *charData = (char_t *)data;
+        switch (regID)
+        {
+      case MC_REG_FW_NAME:
+        retVal = RI_MovString (FIRMWARE_NAME ,charData, size, freeSpace);
+            break;
+
+          case MC_REG_CTRL_STAGE_NAME:
+          {
+            retVal = RI_MovString (CTL_BOARD ,charData, size, freeSpace);
+            break;
+          }
+
+          case MC_REG_PWR_STAGE_NAME:
+          {
+            retVal = RI_MovString (PWR_BOARD_NAME[motorID] ,charData, size, freeSpace);
+            break;
+          }
+
+          case MC_REG_MOTOR_NAME:
+          {
+        retVal = RI_MovString (MotorConfig_reg[motorID]->name ,charData, size, freeSpace);
+            break;
+          }
+
+          default:
+          {
+            retVal = MCP_ERROR_UNKNOWN_REG;
+            *size= 0 ; /* */
+            break;
+          }
+        }
+        break;
+      }
+
+      case TYPE_DATA_RAW:
+      {
+        /* First 2 bytes of the answer is reserved to the size */
+        uint16_t *rawSize = (uint16_t *)data; //cstat !MISRAC2012-Rule-11.3
+        uint8_t * rawData = data;
+        rawData++;
+        rawData++;
+
+        switch (regID)
+        {
+          case MC_REG_GLOBAL_CONFIG:
+          {
+            *rawSize = (uint16_t)sizeof(GlobalConfig_reg_t);
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              (void)memcpy(rawData, &globalConfig_reg, sizeof(GlobalConfig_reg_t));
+            }
+            break;
+          }
+
+          case MC_REG_MOTOR_CONFIG:
+          {
+            *rawSize = (uint16_t)sizeof(MotorConfig_reg_t);
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              MotorConfig_reg_t const *pMotorConfig_reg = MotorConfig_reg[motorID];
+              (void)memcpy(rawData, (uint8_t *)pMotorConfig_reg, sizeof(MotorConfig_reg_t));
+            }
+          }
+      break;
+      case MC_REG_APPLICATION_CONFIG:
+        {
+        *rawSize = sizeof(ApplicationConfig_reg_t);
+        if ((*rawSize) +2  > freeSpace)
+        {
+          retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+        }
+        else
+        {
+          memcpy(rawData, ApplicationConfig_reg[motorID], sizeof(ApplicationConfig_reg_t));
+            }
+      break;
+          }
+
+          case MC_REG_FOCFW_CONFIG:
+          {
+            *rawSize = (uint16_t)sizeof(FOCFwConfig_reg_t);
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              FOCFwConfig_reg_t const *pFOCConfig_reg = FOCConfig_reg[motorID];
+              (void)memcpy(rawData, (uint8_t *)pFOCConfig_reg, sizeof(FOCFwConfig_reg_t));
+            }
+            break;
+          }
+
+          case MC_REG_SPEED_RAMP:
+          {
+            int32_t *rpm = (int32_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+            uint16_t *duration = (uint16_t *)&rawData[4]; //cstat !MISRAC2012-Rule-11.3
+            *rpm = (((int32_t)MCI_GetLastRampFinalSpeed(pMCIN) * U_RPM) / (int32_t)SPEED_UNIT);
+            *duration = MCI_GetLastRampFinalDuration(pMCIN);
+            *rawSize = 6;
+            break;
+          }
+
+          case MC_REG_TORQUE_RAMP:
+          {
+            int16_t *torque = (int16_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+            uint16_t *duration = (uint16_t *)&rawData[2]; //cstat !MISRAC2012-Rule-11.3
+
+            *rawSize = 4;
+            *torque = MCI_GetLastRampFinalTorque(pMCIN);
+            *duration = MCI_GetLastRampFinalDuration(pMCIN) ;
+            break;
+          }
+
+#ifdef M1_POSITION_CTRL
+          case MC_REG_POSITION_RAMP:
+          {
+            uint16_t *duration = (uint16_t *)&rawData[4]; //cstat !MISRAC2012-Rule-11.3
+
+            (void)memcpy(rawData, &pMCIN->FinalPosition, sizeof(float));
+            *duration = MCI_GetLastRampFinalDuration(pMCIN);
+            *rawSize = 6;
+            break;
+          }
+#endif
+
+          case MC_REG_REVUP_DATA:
+          {
+            int32_t *rpm;
+            uint16_t *finalTorque;
+            uint16_t *durationms;
+            RevUpCtrl_PhaseParams_t revUpPhase;
+            uint8_t i;
+
+            *rawSize = (uint16_t)RUC_MAX_PHASE_NUMBER*8U;
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              for (i = 0; i <RUC_MAX_PHASE_NUMBER; i++)
+              {
+                (void)RUC_GetPhase( RevUpControl[motorID] ,i, &revUpPhase);
+                rpm = (int32_t *) &data[2U + (i*8U)];  //cstat !MISRAC2012-Rule-11.3
+                *rpm = (((int32_t)revUpPhase.hFinalMecSpeedUnit) * U_RPM) / SPEED_UNIT; //cstat !MISRAC2012-Rule-11.3
+                finalTorque = (uint16_t *)&data[6U + (i * 8U)]; //cstat !MISRAC2012-Rule-11.3
+                *finalTorque = (uint16_t)revUpPhase.hFinalTorque; //cstat !MISRAC2012-Rule-11.3
+                durationms  = (uint16_t *)&data[8U + (i * 8U)]; //cstat !MISRAC2012-Rule-11.3
+                *durationms  = revUpPhase.hDurationms;
+              }
+            }
+            break;
+          }
+
+          case MC_REG_CURRENT_REF:
+          {
+            uint16_t *iqref = (uint16_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+            uint16_t *idref = (uint16_t *)&rawData[2]; //cstat !MISRAC2012-Rule-11.3
+
+            *rawSize = 4;
+            *iqref = (uint16_t)MCI_GetIqdref(pMCIN).q;
+            *idref = (uint16_t)MCI_GetIqdref(pMCIN).d;
+            break;
+    }
+
+#ifdef DBG_MCU_LOAD_MEASURE
+          case MC_REG_PERF_STATS:
+          {
+            const Perf_Handle_t *pTrace = &PerfTraces.MC_Perf_TraceLog[perfTrace];
+            uint32_t *cycles = (uint32_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+
+            *rawSize = (uint16_t)(12U + sizeof(pTrace->Histogram));
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              cycles[0] = pTrace->min;
+              cycles[1] = pTrace->max;
+              cycles[2] = pTrace->mean;
+              (void)memcpy(&rawData[12], pTrace->Histogram, sizeof(pTrace->Histogram));
+            }
+            break;
+          }
+
+          case MC_REG_PERF_JITTER:
+          {
+            uint32_t *cycles = (uint32_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+            uint8_t i;
+
+            *rawSize = (uint16_t)(12U * (uint16_t)MC_PERF_NB_JITTERS);
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              for (i = 0U; i < (uint8_t)MC_PERF_NB_JITTERS; i++)
+              {
+                const Perf_Jitter_t *pJit = &PerfTraces.MC_Perf_JitterLog[i];
+
+                cycles[(3U * i)] = (uint32_t)pJit->min;
+                cycles[(3U * i) + 1U] = (uint32_t)pJit->max;
+                cycles[(3U * i) + 2U] = pJit->NbOverruns;
+              }
+            }
+            break;
+          }
+
+          case MC_REG_PERF_NOISE:
+          {
+            const Perf_Noise_t *pNoise = &PerfTraces.CurrentNoise;
+
+            *rawSize = 12;
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              (void)memcpy(rawData, pNoise->mean, sizeof(pNoise->mean));
+              (void)memcpy(&rawData[4], pNoise->variance, sizeof(pNoise->variance));
+            }
+            break;
+          }
+
+          case MC_REG_PERF_LOAD:
+          {
+            uint16_t *load = (uint16_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+            uint8_t i;
+
+            *rawSize = (uint16_t)(4U * ((uint16_t)MC_PERF_NB_LOADS + 1U));
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              for (i = 0U; i < (uint8_t)MC_PERF_NB_LOADS; i++)
+              {
+                load[(2U * i)] = PerfTraces.MC_Perf_LoadLog[i].load;
+                load[(2U * i) + 1U] = PerfTraces.MC_Perf_LoadLog[i].max;
+              }
+              load[2U * (uint8_t)MC_PERF_NB_LOADS] = PerfTraces.IdleLoad;
+              load[(2U * (uint8_t)MC_PERF_NB_LOADS) + 1U] = PerfTraces.MinIdleLoad;
+            }
+            break;
+          }
+#endif
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+          case MC_REG_PCC_TUNING:
+          {
+            PCC_Tuning_t pccTuning;
+
+            *rawSize = 24;
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
             {
-              retVal = MCP_ERROR_UNKNOWN_REG;
-              break;
+              PCC_GetTuning(pPCC[motorID], &pccTuning);
+              *(int32_t *)rawData = pccTuning.wKDecay; //cstat !MISRAC2012-Rule-11.3
+              *(int32_t *)&rawData[4] = pccTuning.wKVolt; //cstat !MISRAC2012-Rule-11.3
+              *(int32_t *)&rawData[8] = pccTuning.wKBemf; //cstat !MISRAC2012-Rule-11.3
+              *(uint16_t *)&rawData[12] = pccTuning.hCoefDivisorPOW2; //cstat !MISRAC2012-Rule-11.3
+              *(uint16_t *)&rawData[14] = pccTuning.hBemfDivisorPOW2; //cstat !MISRAC2012-Rule-11.3
+              *(uint16_t *)&rawData[16] = pccTuning.hSwitchingWeight; //cstat !MISRAC2012-Rule-11.3
+              *(uint16_t *)&rawData[18] = pccTuning.hNodeBudget; //cstat !MISRAC2012-Rule-11.3
+              *(int16_t *)&rawData[20] = (int16_t)((((int32_t)pccTuning.hEngageSpeed) * U_RPM) / SPEED_UNIT); //cstat !MISRAC2012-Rule-11.3
+              *(int16_t *)&rawData[22] = (int16_t)((((int32_t)pccTuning.hDisengageSpeed) * U_RPM) / SPEED_UNIT); //cstat !MISRAC2012-Rule-11.3
             }
-          }
-          *size = 4;
-        }
-        else
-        {
-          retVal = MCP_ERROR_NO_TXSYNC_SPACE;
-        }
-        break;
-      }
-
-      case TYPE_DATA_STRING:
-      {
-        char_t *charData = (char_t *)data;
-        switch (regID)
-        {
-      case MC_REG_FW_NAME:
-        retVal = RI_MovString (FIRMWARE_NAME ,charData, size, freeSpace);
             break;
+          }
 
-          case MC_REG_CTRL_STAGE_NAME:
+          case MC_REG_PCC_STATS:
           {
-            retVal = RI_MovString (CTL_BOARD ,charData, size, freeSpace);
+            const PCC_Stats_t *pccStats = PCC_GetStats(pPCC[motorID]);
+            uint16_t *stats = (uint16_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+
+            *rawSize = (uint16_t)(20U + sizeof(pccStats->hVectorCount));
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              stats[0] = pccStats->hNbPeriods;
+              stats[1] = (0U == pccStats->hNbPeriods) ? 0U
+                       : (uint16_t)(pccStats->wCostSum / pccStats->hNbPeriods);
+              stats[2] = pccStats->hCostMax;
+              stats[3] = pccStats->hVectorChanges;
+              stats[4] = pccStats->hBudgetExceeded;
+              (void)memcpy(&rawData[10], pccStats->hVectorCount, sizeof(pccStats->hVectorCount));
+              /* Appended after the vector counts, that the existing hosts read */
+              stats[5U + PCC_NB_VECTORS] = pccStats->hTripRejected;
+              stats[6U + PCC_NB_VECTORS] = pccStats->hTripPredicted;
+              stats[7U + PCC_NB_VECTORS] = pccStats->hLimitEvents;
+              stats[8U + PCC_NB_VECTORS] = (0U == pccStats->hResidualPeriods) ? 0U
+                                         : (uint16_t)(pccStats->wResidualSum / pccStats->hResidualPeriods);
+              stats[9U + PCC_NB_VECTORS] = pccStats->hResidualMax;
+            }
             break;
           }
+#endif
 
-          case MC_REG_PWR_STAGE_NAME:
+#ifdef MC_BENCH_MODE
+          case MC_REG_BENCH_RESULTS:
           {
-            retVal = RI_MovString (PWR_BOARD_NAME[motorID] ,charData, size, freeSpace);
+            retVal = RI_GetRawBlock(data, freeSpace, MC_BenchResults, (uint16_t)sizeof(MC_BenchResults));
             break;
           }
 
-          case MC_REG_MOTOR_NAME:
+          case MC_REG_BENCH_RIPPLE:
           {
-        retVal = RI_MovString (MotorConfig_reg[motorID]->name ,charData, size, freeSpace);
+            retVal = RI_GetRawBlock(data, freeSpace, MC_BenchRipple, (uint16_t)sizeof(MC_BenchRipple));
             break;
           }
 
-          default:
+          case MC_REG_BENCH_SCENARIOS:
           {
-            retVal = MCP_ERROR_UNKNOWN_REG;
-            *size= 0 ; /* */
+            retVal = RI_GetRawBlock(data, freeSpace, MC_BenchScenarios, (uint16_t)sizeof(MC_BenchScenarios));
             break;
           }
-        }
-        break;
-      }
-
-      case TYPE_DATA_RAW:
-      {
-        /* First 2 bytes of the answer is reserved to the size */
-        uint16_t *rawSize = (uint16_t *)data; //cstat !MISRAC2012-Rule-11.3
-        uint8_t * rawData = data;
-        rawData++;
-        rawData++;
+#endif
 
-        switch (regID)
-        {
-          case MC_REG_GLOBAL_CONFIG:
+#ifdef MC_CAPTURE_MODE
+          case MC_REG_CAPTURE_CONFIG:
           {
-            *rawSize = (uint16_t)sizeof(GlobalConfig_reg_t);
+            const MC_Capture_Config_t *pCaptureConfig = MC_Capture_GetConfig();
+            uint8_t i;
+
+            *rawSize = 14;
             if (((*rawSize) + 2U) > freeSpace)
             {
               retVal = MCP_ERROR_NO_TXSYNC_SPACE;
             }
             else
             {
-              (void)memcpy(rawData, &globalConfig_reg, sizeof(GlobalConfig_reg_t));
+              for (i = 0U; i < MC_CAPTURE_NB_CHANNELS; i++)
+              {
+                *(uint16_t *)&rawData[2U * i] = pCaptureConfig->hRegID[i]; //cstat !MISRAC2012-Rule-11.3
+              }
+              rawData[8] = pCaptureConfig->bTrigger;
+              rawData[9] = pCaptureConfig->bTrigChannel;
+              *(int16_t *)&rawData[10] = pCaptureConfig->hTrigLevel; //cstat !MISRAC2012-Rule-11.3
+              *(uint16_t *)&rawData[12] = pCaptureConfig->hPreTrigger; //cstat !MISRAC2012-Rule-11.3
             }
             break;
           }
 
-          case MC_REG_MOTOR_CONFIG:
+          case MC_REG_CAPTURE_DATA:
           {
-            *rawSize = (uint16_t)sizeof(MotorConfig_reg_t);
-            if (((*rawSize) + 2U) > freeSpace)
+            /* Index of the first sample, then as many samples as fit in the answer */
+            int16_t hRoom = freeSpace - 4;
+            uint16_t hMaxSamples = (hRoom > 0) ? ((uint16_t)hRoom / (2U * MC_CAPTURE_NB_CHANNELS)) : 0U;
+            uint16_t *firstIndex = (uint16_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+
+            *rawSize = 0;
+            if (MC_Capture_GetState() != MC_CAPTURE_DONE)
+            {
+              retVal = MCP_CMD_NOK;
+            }
+            else if (0U == hMaxSamples)
             {
               retVal = MCP_ERROR_NO_TXSYNC_SPACE;
             }
             else
             {
-              MotorConfig_reg_t const *pMotorConfig_reg = MotorConfig_reg[motorID];
-              (void)memcpy(rawData, (uint8_t *)pMotorConfig_reg, sizeof(MotorConfig_reg_t));
+              *firstIndex = MC_Capture_GetReadIndex();
+              *rawSize = 2U + (2U * MC_CAPTURE_NB_CHANNELS
+                               * MC_Capture_Read((int16_t *)&rawData[2], hMaxSamples)); //cstat !MISRAC2012-Rule-11.3
             }
+            break;
           }
-      break;
-      case MC_REG_APPLICATION_CONFIG:
-        {
-        *rawSize = sizeof(ApplicationConfig_reg_t);
-        if ((*rawSize) +2  > freeSpace)
-        {
-          retVal = MCP_ERROR_NO_TXSYNC_SPACE;
-        }
-        else
-        {
-          memcpy(rawData, ApplicationConfig_reg[motorID], sizeof(ApplicationConfig_reg_t));
-            }
-      break;
+#endif
+
+#ifdef MC_PROFILE_MODE
+          case MC_REG_PROFILE_DATA:
+          {
+            MC_Profile_t profile;
+
+            MC_Profile_Capture(&profile);
+            retVal = RI_GetRawBlock(data, freeSpace, &profile, (uint16_t)sizeof(MC_Profile_t));
+            break;
           }
+#endif
 
-          case MC_REG_FOCFW_CONFIG:
+#ifdef MC_RECORD_MODE
+          case MC_REG_RECORD_DATA:
           {
-            *rawSize = (uint16_t)sizeof(FOCFwConfig_reg_t);
-            if (((*rawSize) + 2U) > freeSpace)
+            /* Index of the first frame, then as many frames as fit in the answer */
+            int16_t hRoom = freeSpace - 4;
+            uint16_t hMaxFrames = (hRoom > 0) ? ((uint16_t)hRoom / (uint16_t)sizeof(MC_Record_Frame_t)) : 0U;
+            uint16_t *firstIndex = (uint16_t *)rawData; //cstat !MISRAC2012-Rule-11.3
+
+            *rawSize = 0;
+            if (MC_Record_GetState() != MC_RECORD_DONE)
+            {
+              retVal = MCP_CMD_NOK;
+            }
+            else if (0U == hMaxFrames)
             {
               retVal = MCP_ERROR_NO_TXSYNC_SPACE;
             }
             else
             {
-              FOCFwConfig_reg_t const *pFOCConfig_reg = FOCConfig_reg[motorID];
-              (void)memcpy(rawData, (uint8_t *)pFOCConfig_reg, sizeof(FOCFwConfig_reg_t));
+              *firstIndex = MC_Record_GetReadIndex();
+              *rawSize = 2U + ((uint16_t)sizeof(MC_Record_Frame_t)
+                               * MC_Record_Read((MC_Record_Frame_t *)&rawData[2], hMaxFrames)); //cstat !MISRAC2012-Rule-11.3
             }
             break;
           }
+#endif
 
-          case MC_REG_SPEED_RAMP:
+#ifdef MC_PIL_MODE
+          case MC_REG_PIL_FRAME:
           {
-            int32_t *rpm = (int32_t *)rawData; //cstat !MISRAC2012-Rule-11.3
-            uint16_t *duration = (uint16_t *)&rawData[4]; //cstat !MISRAC2012-Rule-11.3
-            *rpm = (((int32_t)MCI_GetLastRampFinalSpeed(pMCIN) * U_RPM) / (int32_t)SPEED_UNIT);
-            *duration = MCI_GetLastRampFinalDuration(pMCIN);
-            *rawSize = 6;
+            MC_Pil_Output_t pilOutput;
+
+            MC_Pil_GetOutput(&pilOutput);
+            retVal = RI_GetRawBlock(data, freeSpace, &pilOutput, (uint16_t)sizeof(MC_Pil_Output_t));
             break;
           }
+#endif
 
-          case MC_REG_TORQUE_RAMP:
+#ifdef MC_FAULTLOG_MODE
+          case MC_REG_FAULTLOG_DATA:
           {
-            int16_t *torque = (int16_t *)rawData; //cstat !MISRAC2012-Rule-11.3
-            uint16_t *duration = (uint16_t *)&rawData[2]; //cstat !MISRAC2012-Rule-11.3
+            MC_FaultLog_Entry_t entry;
 
-            *rawSize = 4;
-            *torque = MCI_GetLastRampFinalTorque(pMCIN);
-            *duration = MCI_GetLastRampFinalDuration(pMCIN) ;
+            *rawSize = (uint16_t)sizeof(MC_FaultLog_Entry_t);
+            if (((*rawSize) + 2U) > freeSpace)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else if (false == MC_FaultLog_Read(&entry))
+            {
+              *rawSize = 0;
+              retVal = MCP_CMD_NOK;
+            }
+            else
+            {
+              (void)memcpy(rawData, &entry, sizeof(MC_FaultLog_Entry_t));
+            }
             break;
           }
+#endif
 
-          case MC_REG_REVUP_DATA:
+#ifdef MC_STATE_STATS_MODE
+          case MC_REG_STATE_STATS:
           {
-            int32_t *rpm;
-            uint16_t *finalTorque;
-            uint16_t *durationms;
-            RevUpCtrl_PhaseParams_t revUpPhase;
+            MC_StateStats_t stats;
+
+            MC_StateStats_Get(&stats);
+            retVal = RI_GetRawBlock(data, freeSpace, &stats, (uint16_t)sizeof(MC_StateStats_t));
+            break;
+          }
+#endif
+
+#ifdef MC_FRA_MODE
+          case MC_REG_FRA_CONFIG:
+          {
+            const MC_Fra_Config_t *pFraConfig = MC_Fra_GetConfig();
             uint8_t i;
 
-            *rawSize = (uint16_t)RUC_MAX_PHASE_NUMBER*8U;
+            *rawSize = MC_FRA_CONFIG_HEADER + (4U * pFraConfig->bNbPoints);
             if (((*rawSize) + 2U) > freeSpace)
             {
               retVal = MCP_ERROR_NO_TXSYNC_SPACE;
             }
             else
             {
-              for (i = 0; i <RUC_MAX_PHASE_NUMBER; i++)
+              for (i = 0U; i < MC_FRA_NB_CHANNELS; i++)
               {
-                (void)RUC_GetPhase( RevUpControl[motorID] ,i, &revUpPhase);
-                rpm = (int32_t *) &data[2U + (i*8U)];  //cstat !MISRAC2012-Rule-11.3
-                *rpm = (((int32_t)revUpPhase.hFinalMecSpeedUnit) * U_RPM) / SPEED_UNIT; //cstat !MISRAC2012-Rule-11.3
-                finalTorque = (uint16_t *)&data[6U + (i * 8U)]; //cstat !MISRAC2012-Rule-11.3
-                *finalTorque = (uint16_t)revUpPhase.hFinalTorque; //cstat !MISRAC2012-Rule-11.3
-                durationms  = (uint16_t *)&data[8U + (i * 8U)]; //cstat !MISRAC2012-Rule-11.3
-                *durationms  = revUpPhase.hDurationms;
+                *(uint16_t *)&rawData[2U * i] = pFraConfig->hRegID[i]; //cstat !MISRAC2012-Rule-11.3
               }
+              rawData[4] = pFraConfig->bInjection;
+              rawData[5] = pFraConfig->bNbPoints;
+              *(int16_t *)&rawData[6] = pFraConfig->hAmplitude; //cstat !MISRAC2012-Rule-11.3
+              *(uint16_t *)&rawData[8] = pFraConfig->hSettleCycles; //cstat !MISRAC2012-Rule-11.3
+              *(uint16_t *)&rawData[10] = pFraConfig->hCycles; //cstat !MISRAC2012-Rule-11.3
+              (void)memcpy(&rawData[MC_FRA_CONFIG_HEADER], pFraConfig->wFreq_mHz, 4U * pFraConfig->bNbPoints);
             }
             break;
           }
 
-          case MC_REG_CURRENT_REF:
+          case MC_REG_FRA_DATA:
           {
-            uint16_t *iqref = (uint16_t *)rawData; //cstat !MISRAC2012-Rule-11.3
-            uint16_t *idref = (uint16_t *)&rawData[2]; //cstat !MISRAC2012-Rule-11.3
+            /* Index of the first point, then as many points measured as fit in the answer */
+            int16_t hRoom = freeSpace - 4;
+            uint16_t hMaxPoints = (hRoom > 0) ? ((uint16_t)hRoom / (uint16_t)sizeof(MC_Fra_Point_t)) : 0U;
+            uint16_t *firstIndex = (uint16_t *)rawData; //cstat !MISRAC2012-Rule-11.3
 
-            *rawSize = 4;
-            *iqref = (uint16_t)MCI_GetIqdref(pMCIN).q;
-            *idref = (uint16_t)MCI_GetIqdref(pMCIN).d;
+            *rawSize = 0;
+            if (0U == hMaxPoints)
+            {
+              retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+            }
+            else
+            {
+              *firstIndex = MC_Fra_GetReadIndex();
+              *rawSize = 2U + ((uint16_t)sizeof(MC_Fra_Point_t)
+                               * MC_Fra_Read((MC_Fra_Point_t *)&rawData[2], hMaxPoints)); //cstat !MISRAC2012-Rule-11.3
+            }
             break;
-    }
+          }
+#endif
+
+#ifdef MC_SPECTRUM_MODE
+          case MC_REG_SPECTRUM_DATA:
+          {
+            MC_Spectrum_Result_t spectrum;
+
+            MC_Spectrum_GetResult(&spectrum);
+            retVal = RI_GetRawBlock(data, freeSpace, &spectrum, (uint16_t)sizeof(MC_Spectrum_Result_t));
+            break;
+          }
+#endif
+
+#ifdef SPEED_FILTER_BANK
+          case MC_REG_SPEED_FILTER:
+          {
+            SFB_Bank_t bank;
+
+            SFB_GetBank(pSFB[motorID], &bank);
+            retVal = RI_GetRawBlock(data, freeSpace, &bank, (uint16_t)sizeof(SFB_Bank_t));
+            break;
+          }
+#endif
+
+#ifdef MC_TIMEBASE_MODE
+          case MC_REG_TIME:
+          {
+            MC_Time_Info_t info;
+
+            MC_Time_GetInfo(&info);
+            retVal = RI_GetRawBlock(data, freeSpace, &info, (uint16_t)sizeof(MC_Time_Info_t));
+            break;
+          }
+#endif
+
+#ifdef MC_STACK_MODE
+          case MC_REG_STACK:
+          {
+            MC_Stack_Info_t info;
+
+            MC_Stack_GetInfo(&info);
+            retVal = RI_GetRawBlock(data, freeSpace, &info, (uint16_t)sizeof(MC_Stack_Info_t));
+            break;
+          }
+#endif
+
+          case MC_REG_RAM_FOOTPRINT:
+          {
+            retVal = RI_GetRawBlock(data, freeSpace, &MC_RamReport, (uint16_t)sizeof(MC_RAM_Report_t));
+            break;
+          }
+
+#ifdef MC_ABTEST_MODE
+          case MC_REG_ABTEST_CONFIG:
+          {
+            retVal = RI_GetRawBlock(data, freeSpace, MC_ABTest_GetConfig(), (uint16_t)sizeof(MC_ABTest_Config_t));
+            break;
+          }
+
+          case MC_REG_ABTEST_STATS:
+          {
+            MC_ABTest_Stats_t stats;
+
+            MC_ABTest_GetStats(&stats);
+            retVal = RI_GetRawBlock(data, freeSpace, &stats, (uint16_t)sizeof(MC_ABTest_Stats_t));
+            break;
+          }
+#endif
+
+#ifdef MC_AUTOSELECT_MODE
+          case MC_REG_AUTOSELECT:
+          {
+            retVal = RI_GetRawBlock(data, freeSpace, &MC_AutoSelReport, (uint16_t)sizeof(MC_AutoSel_Report_t));
+            break;
+          }
+#endif
+
+#ifdef MC_BOOTLOG_MODE
+          case MC_REG_BOOTLOG_CONFIG:
+          {
+            retVal = RI_GetRawBlock(data, freeSpace, MC_BootLog_GetConfig(), (uint16_t)sizeof(MC_BootLog_Config_t));
+            break;
+          }
+#endif
+
+#ifdef MC_ADCCALIB_MODE
+          case MC_REG_ADCCALIB:
+          {
+            MC_ADCCalib_Report_t adcCalibReport;
+
+            MC_ADCCalib_GetReport(&adcCalibReport);
+            retVal = RI_GetRawBlock(data, freeSpace, &adcCalibReport, (uint16_t)sizeof(MC_ADCCalib_Report_t));
+            break;
+          }
+#endif
+
+#ifdef MC_REPORT_MODE
+          case MC_REG_REPORT_CONFIG:
+          {
+            retVal = RI_GetRawBlock(data, freeSpace, MC_Report_GetConfig(), (uint16_t)sizeof(MC_Report_Config_t));
+            break;
+          }
+#endif
 
           case MC_REG_ASYNC_UARTA:
           case MC_REG_ASYNC_UARTB:
@@ -1219,6 +2988,22 @@ uint8_t RI_GetReg (uint16_t dataID, uint8_t * data, uint16_t *size, int16_t free
   return (retVal);
 }
 
+/**
+  * @brief  Reads an 8, 16 or 32 bits register, as GET_DATA_ELEMENT, into the low bytes of
+  *         @p value. It is used by the reports of mc_report, from the main loop.
+  * @retval uint8_t MCP_CMD_OK, or the error of the register
+  */
+uint8_t RI_ReadReg(uint16_t dataID, uint32_t *value)
+{
+  uint32_t data = 0U;
+  uint16_t size;
+  uint8_t retVal;
+
+  retVal = RI_GetReg(dataID, (uint8_t *)&data, &size, (int16_t)sizeof(data));
+  *value = data;
+  return (retVal);
+}
+
 uint8_t RI_MovString(const char_t *srcString, char_t *destString, uint16_t *size, int16_t maxSize)
 {
   uint8_t retVal = MCP_CMD_OK;
@@ -1247,6 +3032,29 @@ uint8_t RI_MovString(const char_t *srcString, char_t *destString, uint16_t *size
   return (retVal);
 }
 
+/**
+  * @brief  Answers a TYPE_DATA_RAW register with a copy of @p pBlock, after the 2 bytes
+  *         of its size. The getters of the diagnostic blocks fill a local copy first, so
+  *         that the answer is a snapshot of the block.
+  * @retval uint8_t MCP_CMD_OK, or MCP_ERROR_NO_TXSYNC_SPACE if the block does not fit
+  */
+static uint8_t RI_GetRawBlock(uint8_t *data, int16_t freeSpace, const void *pBlock, uint16_t blockSize)
+{
+  uint8_t retVal = MCP_CMD_OK;
+  uint16_t *rawSize = (uint16_t *)data; //cstat !MISRAC2012-Rule-11.3
+
+  *rawSize = blockSize;
+  if (((int32_t)blockSize + 2) > (int32_t)freeSpace)
+  {
+    retVal = MCP_ERROR_NO_TXSYNC_SPACE;
+  }
+  else
+  {
+    (void)memcpy(&data[2], pBlock, blockSize);
+  }
+  return (retVal);
+}
+
 uint8_t RI_GetIDSize(uint16_t dataID)
 {
   uint8_t typeID = ((uint8_t)dataID) & TYPE_MASK;
@@ -1406,6 +3214,33 @@ __weak uint8_t RI_GetPtrReg(uint16_t dataID, void **dataPtr)
             *dataPtr = &(stoPLLSensor[vmotorID]->hBemf_beta_est);
             break;
           }
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+          /* Decision data of the predictive controller, updated by every PCC_CalcVoltage() */
+          case MC_REG_PCC_DECISION:
+          {
+            *dataPtr = &(pPCC[vmotorID]->hLogDecision);
+            break;
+          }
+
+          case MC_REG_PCC_COST:
+          {
+            *dataPtr = &(pPCC[vmotorID]->hLogCost);
+            break;
+          }
+
+          case MC_REG_PCC_I_Q_PRED:
+          {
+            *dataPtr = &(pPCC[vmotorID]->IqdPred.q);
+            break;
+          }
+
+          case MC_REG_PCC_I_D_PRED:
+          {
+            *dataPtr = &(pPCC[vmotorID]->IqdPred.d);
+            break;
+          }
+#endif
           default:
           {
             *dataPtr = &nullData16;
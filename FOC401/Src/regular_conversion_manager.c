@@ -6,7 +6,8 @@
   * @brief   This file provides firmware functions that implement the following features
   *          of the regular_conversion_manager component of the Motor Control SDK:
   *           Register conversion with or without callback
-  *           Execute regular conv directly from Temperature and VBus sensors
+  *           Scan the registered conversions with the DMA
+  *           Read the scanned conversions from Temperature and VBus sensors
   *           Execute user regular conversion scheduled by medium frequency task
   *           Manage user conversion state machine
   *           +
@@ -52,6 +53,12 @@
   * RCM_RegisterRegConv_WithCB() or RCM_RegisterRegConv() APIs. Multiple conversions can be registered,
   * but only one can be scheduled at a time .
   *
+  * The registered conversions are converted in a single scan of the regular sequence of their
+  * ADC, moved by a circular DMA stream into a buffer. The scan is started once per SysTick by
+  * the safety task, after the conversions of the previous scan have been read, and runs
+  * alongside the injected current conversions. A conversion is therefore never waited for:
+  * RCM_ExecRegularConv() returns the value of the last scan, at most one SysTick period old.
+  *
   * A requested user regular conversion will be executed by the medium frequency task after the
   * MC-SDK regular safety conversions: Bus voltage and Temperature.
   *
@@ -104,11 +111,29 @@ typedef struct
 static RegConv_t *RCM_handle_array[RCM_MAX_CONV];
 static RCM_callback_t RCM_CB_array[RCM_MAX_CONV];
 
+/* The STM32F401 has a single ADC: all the conversions are in the same scan */
+static ADC_TypeDef *RCM_ScanADC = MC_NULL;
+static uint8_t RCM_ScanLength = 0U;
+static uint8_t RCM_ScanRank[RCM_MAX_CONV];       /* Rank of each conversion, index of its value in RCM_ScanBuffer */
+static uint16_t RCM_ScanBuffer[RCM_MAX_CONV];    /* Written by the DMA, in the order of the ranks */
+
 static uint16_t RCM_UserConvValue;
 static RCM_UserConvState_t RCM_UserConvState;
 static uint8_t RCM_UserConvHandle;
 
+static const uint32_t RCM_RegRanks[RCM_MAX_CONV] =
+{
+  LL_ADC_REG_RANK_1, LL_ADC_REG_RANK_2, LL_ADC_REG_RANK_3, LL_ADC_REG_RANK_4
+};
+
+static const uint32_t RCM_SeqLengths[RCM_MAX_CONV] =
+{
+  LL_ADC_REG_SEQ_SCAN_DISABLE, LL_ADC_REG_SEQ_SCAN_ENABLE_2RANKS,
+  LL_ADC_REG_SEQ_SCAN_ENABLE_3RANKS, LL_ADC_REG_SEQ_SCAN_ENABLE_4RANKS
+};
+
 /* Private function prototypes -----------------------------------------------*/
+static void RCM_ConfigScan(void);
 
 /* Private functions ---------------------------------------------------------*/
 
@@ -226,6 +251,24 @@ uint8_t RCM_RegisterRegConv(RegConv_t *regConv)
       }
       i++;
     }
+    if ((handle < RCM_MAX_CONV) && (0 == RCM_handle_array [handle]))
+    {
+      /* New conversion, it is added at the end of the scan */
+      if ((MC_NULL == RCM_ScanADC) || (RCM_ScanADC == regConv->regADC))
+      {
+        RCM_ScanADC = regConv->regADC;
+        RCM_ScanRank[handle] = RCM_ScanLength;
+        RCM_ScanLength++;
+      }
+      else
+      {
+        handle = 255U;
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
     if (handle < RCM_MAX_CONV)
     {
       RCM_handle_array [handle] = regConv;
@@ -243,11 +286,11 @@ uint8_t RCM_RegisterRegConv(RegConv_t *regConv)
       {
         /* Nothing to do */
       }
-      /* reset regular conversion sequencer length set by cubeMX */
-      LL_ADC_REG_SetSequencerLength(regConv->regADC, LL_ADC_REG_SEQ_SCAN_DISABLE);
       /* configure the sampling time (should already be configured by for non user conversions)*/
       LL_ADC_SetChannelSamplingTime (regConv->regADC, __LL_ADC_DECIMAL_NB_TO_CHANNEL(regConv->channel),
                                      regConv->samplingTime);
+      /* The regular sequence set by cubeMX is replaced by the registered conversions */
+      RCM_ConfigScan();
     }
     else
     {
@@ -261,28 +304,14 @@ uint8_t RCM_RegisterRegConv(RegConv_t *regConv)
 
 /*
  * This function is used to read the result of a regular conversion.
- * This function polls on the ADC end of conversion.
- * As ADC have injected channels for currents sensing,
- * There is no issue to execute regular conversion asynchronously.
+ * It does not wait for an ADC conversion: the value returned is the one of the last
+ * DMA scan, started by RCM_StartRegularScan.
  *
  * NOTE: This function is not part of the public API and users should not call it.
  */
 uint16_t RCM_ExecRegularConv (uint8_t handle)
 {
-  uint16_t retVal;
-
-  LL_ADC_REG_SetSequencerRanks(RCM_handle_array[handle]->regADC,
-                               LL_ADC_REG_RANK_1,
-                               __LL_ADC_DECIMAL_NB_TO_CHANNEL(RCM_handle_array[handle]->channel));
-
-  (void)LL_ADC_REG_ReadConversionData12(RCM_handle_array[handle]->regADC);
-
-  /* Bit banding access equivalent to LL_ADC_REG_StartConversionSWStart */
-  BB_REG_BIT_SET(&RCM_handle_array[handle]->regADC->CR2, ADC_CR2_SWSTART_Pos);
-  /* Wait until end of regular conversion */
-  while (LL_ADC_IsActiveFlag_EOCS(RCM_handle_array[handle]->regADC) == 0u) {}
-  retVal = LL_ADC_REG_ReadConversionData12(RCM_handle_array[handle]->regADC);
-  return retVal;
+  return (RCM_ScanBuffer[RCM_ScanRank[handle]]);
 }
 
 /**
@@ -349,6 +378,7 @@ void RCM_ExecUserConv()
 {
   if (RCM_USERCONV_REQUESTED == RCM_UserConvState)
   {
+    /* The conversion was scanned at registration, the scan buffer always holds a value */
     RCM_UserConvValue = RCM_ExecRegularConv(RCM_UserConvHandle);
     RCM_UserConvState = RCM_USERCONV_EOC;
     if (RCM_CB_array[RCM_UserConvHandle].cb != NULL)
@@ -380,6 +410,81 @@ RCM_UserConvState_t RCM_GetUserConvState(void)
   return (RCM_UserConvState);
 }
 
+/*
+ * Starts the scan of the registered regular conversions
+ *
+ * This function does not poll on ADC read: the DMA stores the conversions, read back
+ * by the next calls to RCM_ExecRegularConv. It must be called by MC_TASK once per
+ * SysTick, after the conversions of the previous scan have been read.
+ *
+ * NOTE: This function is not part of the public API and users should not call it.
+ */
+void RCM_StartRegularScan(void)
+{
+  if (RCM_ScanADC != MC_NULL)
+  {
+    /* Bit banding access equivalent to LL_ADC_REG_StartConversionSWStart */
+    BB_REG_BIT_SET(&RCM_ScanADC->CR2, ADC_CR2_SWSTART_Pos);
+  }
+  else
+  {
+    /* Nothing to do, no conversion registered */
+  }
+}
+
+/*
+ * Programs the regular sequence of the ADC with the registered conversions and the DMA
+ * stream in circular mode, then runs a first scan so that the buffer holds valid values.
+ */
+static void RCM_ConfigScan(void)
+{
+  uint8_t i;
+
+  for (i = 0U; i < RCM_MAX_CONV; i++)
+  {
+    if (RCM_handle_array[i] != 0)
+    {
+      LL_ADC_REG_SetSequencerRanks(RCM_ScanADC, RCM_RegRanks[RCM_ScanRank[i]],
+                                   __LL_ADC_DECIMAL_NB_TO_CHANNEL(RCM_handle_array[i]->channel));
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  LL_ADC_SetSequencersScanMode(RCM_ScanADC, LL_ADC_SEQ_SCAN_ENABLE);
+  LL_ADC_REG_SetSequencerLength(RCM_ScanADC, RCM_SeqLengths[RCM_ScanLength - 1U]);
+
+  LL_AHB1_GRP1_EnableClock(RCM_DMA_CLOCK);
+  LL_DMA_DisableStream(RCM_DMA, RCM_DMA_STREAM);
+  while (1U == LL_DMA_IsEnabledStream(RCM_DMA, RCM_DMA_STREAM))
+  {
+    /* Nothing to do */
+  }
+  LL_DMA_SetChannelSelection(RCM_DMA, RCM_DMA_STREAM, RCM_DMA_CHANNEL);
+  LL_DMA_ConfigTransfer(RCM_DMA, RCM_DMA_STREAM,
+                        LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_CIRCULAR | LL_DMA_PERIPH_NOINCREMENT
+                        | LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_HALFWORD | LL_DMA_MDATAALIGN_HALFWORD
+                        | LL_DMA_PRIORITY_LOW);
+  LL_DMA_ConfigAddresses(RCM_DMA, RCM_DMA_STREAM,
+                         LL_ADC_DMA_GetRegAddr(RCM_ScanADC, LL_ADC_DMA_REG_REGULAR_DATA),
+                         (uint32_t)RCM_ScanBuffer, LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+  LL_DMA_SetDataLength(RCM_DMA, RCM_DMA_STREAM, RCM_ScanLength);
+  LL_DMA_ClearFlag_TC(RCM_DMA, RCM_DMA_STREAM);
+  LL_DMA_EnableStream(RCM_DMA, RCM_DMA_STREAM);
+  /* The DMA requests of the ADC restart with the new sequence */
+  LL_ADC_REG_SetDMATransfer(RCM_ScanADC, LL_ADC_REG_DMA_TRANSFER_NONE);
+  LL_ADC_REG_SetDMATransfer(RCM_ScanADC, LL_ADC_REG_DMA_TRANSFER_UNLIMITED);
+
+  /* Bit banding access equivalent to LL_ADC_REG_StartConversionSWStart */
+  BB_REG_BIT_SET(&RCM_ScanADC->CR2, ADC_CR2_SWSTART_Pos);
+  while (0U == LL_DMA_IsActiveFlag_TC(RCM_DMA, RCM_DMA_STREAM))
+  {
+    /* Nothing to do */
+  }
+  LL_DMA_ClearFlag_TC(RCM_DMA, RCM_DMA_STREAM);
+}
+
 /**
   * @}
   */
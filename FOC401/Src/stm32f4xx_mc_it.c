@@ -30,6 +30,7 @@
 #include "stm32f4xx_hal.h"
 #include "stm32f4xx.h"
 #include "mcp_config.h"
+#include "mc_trace.h"
 /* USER CODE BEGIN Includes */
 
 /* USER CODE END Includes */
@@ -58,9 +59,16 @@
 void ADC_IRQHandler(void);
 void TIMx_UP_M1_IRQHandler(void);
 void TIMx_BRK_M1_IRQHandler(void);
+#ifdef M1_ENCODER_SENSOR
+void SPD_TIM_M1_IRQHandler(void);
+#endif
 
 void HardFault_Handler(void);
 void SysTick_Handler(void);
+void PendSV_Handler(void);
+#ifdef DBG_MCU_LOAD_MEASURE
+void FPU_IRQHandler(void);
+#endif
 void EXTI15_10_IRQHandler (void);
 
 /**
@@ -73,6 +81,7 @@ void ADC_IRQHandler(void)
   /* USER CODE BEGIN ADC_IRQn 0 */
 
   /* USER CODE END ADC_IRQn 0 */
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_HF);
   if(LL_ADC_IsActiveFlag_JEOS(ADC1))
   {
     // Clear Flags
@@ -89,6 +98,8 @@ void ADC_IRQHandler(void)
     TSK_HighFrequencyTask();          /*GUI, this section is present only if DAC is disabled*/
   }
 #endif
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_HF);
+
   /* USER CODE BEGIN ADC_IRQn 1 */
 
   /* USER CODE END ADC_IRQn 1 */
@@ -104,9 +115,16 @@ void TIMx_UP_M1_IRQHandler(void)
   /* USER CODE BEGIN TIMx_UP_M1_IRQn 0 */
 
   /* USER CODE END TIMx_UP_M1_IRQn 0 */
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_TIM_UP);
 
   LL_TIM_ClearFlag_UPDATE(PWM_Handle_M1.pParams_str->TIMx);
   R3_1_TIMx_UP_IRQHandler(&PWM_Handle_M1);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_SPLIT_PHASE)
+  /* The ADC is rearmed first: the first stage of the prediction runs during the conversions */
+  FOC_CurrPrepareM1();
+#endif
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_TIM_UP);
+
   /* USER CODE BEGIN TIMx_UP_M1_IRQn 1 */
 
   /* USER CODE END TIMx_UP_M1_IRQn 1 */
@@ -122,6 +140,7 @@ void TIMx_BRK_M1_IRQHandler(void)
   /* USER CODE BEGIN TIMx_BRK_M1_IRQn 0 */
 
   /* USER CODE END TIMx_BRK_M1_IRQn 0 */
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_BRK);
   if (LL_TIM_IsActiveFlag_BRK(PWM_Handle_M1.pParams_str->TIMx))
   {
     LL_TIM_ClearFlag_BRK(PWM_Handle_M1.pParams_str->TIMx);
@@ -130,11 +149,41 @@ void TIMx_BRK_M1_IRQHandler(void)
   /* Systick is not executed due low priority so is necessary to call MC_Scheduler here.*/
   MC_Scheduler();
 
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_BRK);
+
   /* USER CODE BEGIN TIMx_BRK_M1_IRQn 1 */
 
   /* USER CODE END TIMx_BRK_M1_IRQn 1 */
 }
 
+#ifdef M1_ENCODER_SENSOR
+/**
+  * @brief  This function handles the overflows of the encoder timer of Motor 1.
+  * @param  None
+  * @retval None
+  */
+void SPD_TIM_M1_IRQHandler(void)
+{
+  /* USER CODE BEGIN SPD_TIM_M1_IRQn 0 */
+
+  /* USER CODE END SPD_TIM_M1_IRQn 0 */
+
+  if ((LL_TIM_IsActiveFlag_UPDATE(ENCODER_M1.TIMx) != 0U) && (LL_TIM_IsEnabledIT_UPDATE(ENCODER_M1.TIMx) != 0U))
+  {
+    LL_TIM_ClearFlag_UPDATE(ENCODER_M1.TIMx);
+    (void)ENC_IRQHandler(&ENCODER_M1);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  /* USER CODE BEGIN SPD_TIM_M1_IRQn 1 */
+
+  /* USER CODE END SPD_TIM_M1_IRQn 1 */
+}
+#endif
+
 /**
   * @brief This function handles DMA_RX_A channel DMACH_RX_A global interrupt.
   */
@@ -230,6 +279,7 @@ void HardFault_Handler(void)
 
 void SysTick_Handler(void)
 {
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_SYSTICK);
 
 #ifdef MC_HAL_IS_USED
 static uint8_t SystickDividerCounter = SYSTICK_DIVIDER;
@@ -251,7 +301,41 @@ static uint8_t SystickDividerCounter = SYSTICK_DIVIDER;
 
   /* USER CODE BEGIN SysTick_IRQn 2 */
   /* USER CODE END SysTick_IRQn 2 */
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_SYSTICK);
+}
+
+/**
+  * @brief  This function handles the PendSV exception, requested by the high
+  *         frequency task to run its deferred duties.
+  * @param  None
+  * @retval None
+  */
+void PendSV_Handler(void)
+{
+  /* USER CODE BEGIN PendSV_IRQn 0 */
+
+  /* USER CODE END PendSV_IRQn 0 */
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_PENDSV);
+
+  TSK_HighFrequencyDeferredTask();
+
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_PENDSV);
+
+  /* USER CODE BEGIN PendSV_IRQn 1 */
+
+  /* USER CODE END PendSV_IRQn 1 */
+}
+
+#ifdef DBG_MCU_LOAD_MEASURE
+/**
+  * @brief  This function handles the FPU interrupt, only pended by
+  *         MC_Perf_MeasureIrqEntry(): the cycle counter at the entry.
+  */
+void FPU_IRQHandler(void)
+{
+  PerfTraces.IrqEntryStamp = DWT->CYCCNT;
 }
+#endif
 
 /**
   * @brief  This function handles Button IRQ on PIN PC13.
@@ -44,6 +44,13 @@
 #define ASPEP_CTRL_SIZE 4
 #define ASPEP_DATACRC_SIZE 2U
 
+/* Tag of a data packet, in the reserved bits 20 to 27 of its header. The answer to a
+   request carries the tag of the request, so that a host with several requests
+   outstanding matches the answers by their tag rather than by their order. A host
+   that leaves the reserved bits null gets null tags. */
+#define ASPEP_SEQ_POS  20U
+#define ASPEP_SEQ_MASK ((uint32_t)0xFF)
+
 #define ID_MASK     ((uint32_t)0xF)
 #define DATA_PACKET ((uint32_t)0x9)
 #define PING        ((uint32_t)0x6)
@@ -78,6 +85,16 @@ typedef struct
   buff_access_t state;
 } ASPEP_ctrlBuff_t;
 
+/* Packet received from the master, kept until it is answered */
+typedef struct
+{
+  uint8_t header[ASPEP_HEADER_SIZE]; /* Contains the ASPEP 32 bits header, 32 bits aligned */
+  uint8_t *buffer;                   /* Contains the ASPEP Data payload */
+  uint16_t length;
+  ASPEP_packetType packetType;
+  volatile bool ready;               /* Received, not consumed yet */
+} ASPEP_rxSlot_t;
+
 typedef struct
 {
   uint8_t DATA_CRC;
@@ -91,28 +108,29 @@ typedef struct
 {
   MCTL_Handle_t _Super;
   void *HWIp;
-  uint8_t *rxBuffer;   /* Contains the ASPEP Data payload */
-  uint8_t rxHeader[4]; /* Contains the ASPEP 32 bits header*/
+  ASPEP_rxSlot_t rxSlot[ASPEP_SYNC_NB_BUFFERS]; /* Ring of received packets, processed in order */
+  volatile uint8_t rxWriteIndex; /* Slot filled by the receiver, only moved by ASPEP_HWDataReceivedIT */
+  uint8_t rxReadIndex;           /* Oldest slot not consumed yet */
+  volatile bool rxStalled;       /* All the slots are busy, the receiver is armed once one is freed */
+  uint8_t rxSequence;            /* Tag of the request being answered */
   ASPEP_ctrlBuff_t ctrlBuffer;
-  MCTL_Buff_t syncBuffer;
-  MCTL_Buff_t asyncBufferA;
-  MCTL_Buff_t asyncBufferB;
-  MCTL_Buff_t *lastRequestedAsyncBuff;
-  MCTL_Buff_t *asyncNextBuffer;
+  MCTL_Buff_t syncBuffer[ASPEP_SYNC_NB_BUFFERS]; /* Ring of answers, sent in order */
+  uint8_t syncWriteIndex;          /* Buffer given to the MCP, only moved by ASPEP_TXframeProcess */
+  volatile uint8_t syncReadIndex;  /* Next answer to be sent by the DMA */
+  MCTL_Buff_t asyncBuffer[ASPEP_ASYNC_NB_BUFFERS]; /* Ring of asynchronous buffers, sent in order */
+  volatile uint8_t asyncWriteIndex; /* Buffer given to the MCPA, only moved by ASPEP_TXframeProcess */
+  volatile uint8_t asyncReadIndex;  /* Next buffer to be sent by the DMA */
   void *lockBuffer;
   ASPEP_hwinit_cb_t fASPEP_HWInit;
   ASPEP_hwsync_cb_t fASPEP_HWSync;
   ASPEP_receive_cb_t fASPEP_receive;
   ASPEP_send_cb_t fASPEP_send;
-  uint16_t rxLength;
   uint16_t maxRXPayload;
   uint8_t syncPacketCount;
-  bool NewPacketAvailable;
   uint8_t badPacketFlag; /* Contains the error code in case of ASPEP decoding issue */
   uint8_t liid;
   ASPEP_sm_type ASPEP_State;
   ASPEP_TL_sm_type ASPEP_TL_State;
-  ASPEP_packetType rxPacketType;
   ASPEP_Capabilities_def Capabilities;
 } ASPEP_Handle_t;
 
@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file    mc_abtest.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   A/B experiment: two current controllers interleaved in blocks of FOC
+  *          periods, with the statistics of each one
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_ABTEST_H
+#define MC_ABTEST_H
+
+#include "mc_type.h"
+#include "pwm_curr_fdbk.h"
+
+/* The experiment is built when MC_ABTEST_MODE is added to the preprocessor symbols of
+   the build configuration, with the CURR_CTRL_PCC backend. The MC_REG_ABTEST_CONFIG
+   register gives the two arms and the length of the blocks; writing
+   MC_ABTEST_CMD_START in MC_REG_ABTEST_STATE then alternates them in RUN.
+
+   Each arm is a current controller: the PI controllers, or the predictive controller
+   with the weights of the operating point or with a fixed entry of its weight table.
+   The arm of the block replaces the choice of the engage speeds, the fallback to the
+   PI of the predictive controller being kept. The arms take turns every hBlockPeriods
+   FOC periods, so that both run under the same load, speed and temperature: the
+   drifts of the operating point are shared out between them, down to the length of
+   a block. The first hSettlePeriods periods of each block, the hand over from the
+   other arm, are left out of the statistics.
+
+   The statistics of each arm are sums over its periods, read with MC_REG_ABTEST_STATS:
+   - the squared tracking error of the q and d currents, in s16A digits squared;
+   - the commutations of the inverter legs, from the compare values written;
+   - the electrical power, the sum of Valpha.Ialpha + Vbeta.Ibeta in s16V times s16A
+     digits, the scale of the power of PQD_AccumulateElPower();
+   - the CPU cycles of the high frequency task, and their max.
+   The drive leaving RUN suspends the experiment, the block restarting in RUN. */
+
+/* Number of arms of the experiment */
+#define MC_ABTEST_NB_ARMS       2U
+
+/* Commands written in MC_REG_ABTEST_STATE */
+#define MC_ABTEST_CMD_STOP      0U
+#define MC_ABTEST_CMD_START     1U     /* Also clears the statistics */
+
+/* bWeightIndex of an arm that keeps the weights of the operating point */
+#define MC_ABTEST_WEIGHTS_SCHEDULED 0xFFU
+
+typedef enum
+{
+  MC_ABTEST_IDLE,
+  MC_ABTEST_RUNNING
+} MC_ABTest_State_t;
+
+typedef enum
+{
+  MC_ABTEST_CTRL_PI,              /* Torque and flux PI controllers */
+  MC_ABTEST_CTRL_PCC              /* Predictive current controller */
+} MC_ABTest_Controller_t;
+
+typedef struct
+{
+  uint8_t  bController;           /* MC_ABTest_Controller_t */
+  uint8_t  bWeightIndex;          /* Entry of the weight table of the predictive
+                                     controller, or MC_ABTEST_WEIGHTS_SCHEDULED */
+} MC_ABTest_Arm_t;
+
+/* Layout of MC_REG_ABTEST_CONFIG */
+typedef struct
+{
+  uint16_t hBlockPeriods;         /* FOC periods of each block */
+  uint16_t hSettlePeriods;        /* Periods at the start of a block left out,
+                                     below hBlockPeriods */
+  MC_ABTest_Arm_t Arm[MC_ABTEST_NB_ARMS];
+} MC_ABTest_Config_t;
+
+/* Statistics of an arm, sums over its periods */
+typedef struct
+{
+  uint64_t dErrorSq;              /* Squared q and d tracking errors */
+  uint64_t dCycles;               /* CPU cycles of the high frequency task */
+  int64_t  dPower;                /* Valpha.Ialpha + Vbeta.Ibeta */
+  uint32_t wPeriods;              /* Periods accumulated */
+  uint32_t wSwitches;             /* Commutations of the inverter legs */
+  uint32_t wOffPeriods;           /* Periods run by the other controller, on a
+                                     fallback of the predictive controller */
+  uint32_t wBlocks;               /* Blocks completed */
+  uint32_t wMaxCycles;
+  uint32_t wMaxErrorSq;           /* Largest squared error of a period */
+} MC_ABTest_ArmStats_t;
+
+/* Layout of MC_REG_ABTEST_STATS */
+typedef struct
+{
+  uint8_t  bState;                /* MC_ABTest_State_t */
+  uint8_t  bArm;                  /* Arm of the current block */
+  uint16_t hReserved;
+  uint32_t wPeriodRate;           /* FOC periods per second, TF_REGULATION_RATE */
+  MC_ABTest_ArmStats_t Arm[MC_ABTEST_NB_ARMS];
+} MC_ABTest_Stats_t;
+
+bool MC_ABTest_Configure(const MC_ABTest_Config_t *pConfig);
+bool MC_ABTest_Command(uint8_t bCmd);
+const MC_ABTest_Config_t *MC_ABTest_GetConfig(void);
+MC_ABTest_State_t MC_ABTest_GetState(void);
+const MC_ABTest_Arm_t *MC_ABTest_GetArm(void);
+void MC_ABTest_StartPeriod(void);
+void MC_ABTest_Measure(bool Running, bool PCCEngaged, const FOCVars_t *pVars, const PWMC_Handle_t *pPWMC);
+void MC_ABTest_GetStats(MC_ABTest_Stats_t *pStats);
+
+#endif /* MC_ABTEST_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
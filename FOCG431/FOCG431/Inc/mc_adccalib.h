@@ -0,0 +1,113 @@
+/**
+  ******************************************************************************
+  * @file    mc_adccalib.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Tuning of the ADC sampling time and trigger delay at standstill
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_ADCCALIB_H
+#define MC_ADCCALIB_H
+
+#include "mc_type.h"
+#include "pwm_curr_fdbk.h"
+
+/* The ADC timing calibration is built when MC_ADCCALIB_MODE is added to the preprocessor
+   symbols of the build configuration. MC_StartAdcCalibrationMotor1() replaces the
+   sampling time of the current channels and the trigger delay TW_AFTER of the
+   configuration by the shortest ones that do not add noise to the currents, on PWM
+   drivers that set a sampling timing (R3_2 on the STM32G4, R3_1 on the STM32F4):
+
+   - the sampling is forced hTafter after the last switching edge of the period, the
+     worst case of the ringing of the shunts, whatever the duties;
+   - MC_ADCCALIB_NB_SMP sampling times, at the delay of the configuration, then
+     MC_ADCCALIB_NB_DELAYS delays, at the sampling time of the configuration, are each
+     applied for MC_ADCCALIB_SETTLE_LOG periods, then the variance of Ia and Ib is
+     measured over MC_ADCCALIB_AVG_LOG periods. The sweep is run with zero voltage, all
+     phases switching at once, then with the voltage that holds a d current of
+     MC_ADCCALIB_CURRENT, with distinct edges, and the variances of both are added. A
+     timing that does not fit in the period is skipped;
+   - the shortest sampling time and the shortest delay within 1 / 2^MC_ADCCALIB_TOL_SHIFT
+     of the lowest noise of their sweep are applied, TW_BEFORE following the sampling
+     time.
+
+   With MC_ADCCALIB_IN_FLASH the timing is written in the flash page before the one of
+   mc_bootlog, that must be removed from the FLASH region of the linker script as well,
+   and applied again by MCboot at the next boots as long as the PWM frequency is the
+   same. The noise of each timing is read with MC_REG_ADCCALIB. */
+
+/* d current held by the second sweep, in digits */
+#ifndef MC_ADCCALIB_CURRENT
+#define MC_ADCCALIB_CURRENT         ((int16_t)(NOMINAL_CURRENT / 4))
+#endif
+
+/* Sampling times of the SMPR registers, and delays from a quarter of the configured one
+   up to twice it */
+#define MC_ADCCALIB_NB_SMP          8U
+#define MC_ADCCALIB_NB_DELAYS       8U
+#define MC_ADCCALIB_NB_TIMINGS      (MC_ADCCALIB_NB_SMP + MC_ADCCALIB_NB_DELAYS)
+/* FOC periods for the sampling to settle with a new timing */
+#define MC_ADCCALIB_SETTLE_LOG      6U
+/* FOC periods of the variance of each timing */
+#define MC_ADCCALIB_AVG_LOG         10U
+/* FOC periods of the alignment, the d current ramps up over the first half */
+#define MC_ADCCALIB_ALIGN_LOG       13U
+/* Margin over the lowest noise of a sweep of the timings kept, 1/8 */
+#define MC_ADCCALIB_TOL_SHIFT       3U
+
+typedef enum
+{
+  MC_ADCCAL_IDLE = 0,  /*!< Not started or stopped */
+  MC_ADCCAL_LOWSIDE,   /*!< Sweep at zero voltage */
+  MC_ADCCAL_ALIGN,     /*!< Rotor aligned by the d current at angle 0 */
+  MC_ADCCAL_VECTOR,    /*!< Sweep at the voltage of the alignment */
+  MC_ADCCAL_MEASURED,  /*!< Both sweeps measured, the voltage is held at zero until
+                            the medium frequency task selects the timing */
+  MC_ADCCAL_DONE,      /*!< Timing selected and in use */
+  MC_ADCCAL_FAILED     /*!< No timing measured, or no driver support, the timing is
+                            not changed */
+} MC_ADCCalib_Phase_t;
+
+/* Layout of MC_REG_ADCCALIB */
+typedef struct
+{
+  uint8_t  bPhase;                /* MC_ADCCalib_Phase_t */
+  uint8_t  bStored;               /* 1 if the timing in use was read from or written
+                                     in flash */
+  uint8_t  bSampleTime;           /* Timing in use */
+  uint8_t  bReserved;
+  uint16_t hTafter;
+  uint16_t hTbefore;
+  uint32_t wSmpNoise[MC_ADCCALIB_NB_SMP];     /* Variance of each sampling time, in
+                                                 digits^2, UINT32_MAX if skipped */
+  uint32_t wDelayNoise[MC_ADCCALIB_NB_DELAYS]; /* Variance of each delay */
+} MC_ADCCalib_Report_t;
+
+void MC_ADCCalib_Init(PWMC_Handle_t *pPWMC);
+
+/* The standstill phases, up to MC_ADCCAL_MEASURED, are run by the high frequency task */
+void MC_ADCCalib_Start(PWMC_Handle_t *pPWMC, int16_t hCurrent);
+void MC_ADCCalib_Stop(void);
+MC_ADCCalib_Phase_t MC_ADCCalib_GetPhase(void);
+bool MC_ADCCalib_IsRegulating(void);
+qd_t MC_ADCCalib_GetCurrentRef(void);
+qd_t MC_ADCCalib_GetVoltage(void);
+void MC_ADCCalib_Exec(ab_t Iab, qd_t Vqd);
+
+/* Medium frequency task, in MC_ADCCAL_MEASURED with the PWM switched off */
+bool MC_ADCCalib_Compute(void);
+void MC_ADCCalib_GetReport(MC_ADCCalib_Report_t *pReport);
+
+#endif /* MC_ADCCALIB_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file    mc_capture.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Triggered capture of 16 bits registers at the FOC rate
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_CAPTURE_H
+#define MC_CAPTURE_H
+
+#include "mc_type.h"
+#include "mc_ram_budget.h"
+
+/* The capture is built when MC_CAPTURE_MODE is added to the preprocessor symbols of
+   the build configuration. Writing the MC_REG_CAPTURE_CONFIG register over the MCP
+   link arms it, writing MC_REG_CAPTURE_STATE stops it, arms it again or forces the
+   trigger. Once armed, the channels are recorded in a RAM ring at every FOC period,
+   without any link traffic, until the trigger occurred and the post-trigger part of
+   the ring is filled. The frozen capture is then read at the link pace with the
+   MC_REG_CAPTURE_INDEX and MC_REG_CAPTURE_DATA registers. With MC_TIMEBASE_MODE, the
+   time of the trigger sample is returned by MC_REG_TIME. With MC_BOOTLOG_MODE, a
+   configuration stored in flash arms it at boot. */
+
+/* Number of 16 bits registers recorded at every FOC period */
+#define MC_CAPTURE_NB_CHANNELS  4U
+/* Number of samples of the ring: MC_CAPTURE_DEPTH, see mc_ram_budget.h */
+/* Number of samples over which the changes of the trigger channel are counted */
+#define MC_CAPTURE_BURST_WINDOW 32U
+
+/* Commands written in MC_REG_CAPTURE_STATE */
+#define MC_CAPTURE_CMD_STOP     0U
+#define MC_CAPTURE_CMD_ARM      1U
+#define MC_CAPTURE_CMD_TRIGGER  2U
+
+typedef enum
+{
+  MC_CAPTURE_TRIG_MANUAL,   /* Only triggered by MC_CAPTURE_CMD_TRIGGER */
+  MC_CAPTURE_TRIG_FAULT,    /* Triggered by any current fault of the drive */
+  MC_CAPTURE_TRIG_RISING,   /* Trigger channel rising above hTrigLevel */
+  MC_CAPTURE_TRIG_FALLING,  /* Trigger channel falling below hTrigLevel */
+  MC_CAPTURE_TRIG_BURST     /* At least hTrigLevel changes of the trigger channel in
+                               the last MC_CAPTURE_BURST_WINDOW samples */
+} MC_Capture_Trigger_t;
+
+typedef enum
+{
+  MC_CAPTURE_IDLE,
+  MC_CAPTURE_ARMED,         /* Recording, waiting for the trigger */
+  MC_CAPTURE_TRIGGERED,     /* Recording the post-trigger samples */
+  MC_CAPTURE_DONE           /* Frozen, ready to be read */
+} MC_Capture_State_t;
+
+typedef struct
+{
+  uint16_t hRegID[MC_CAPTURE_NB_CHANNELS]; /* TYPE_DATA_16BIT register of each channel */
+  uint8_t  bTrigger;                       /* MC_Capture_Trigger_t */
+  uint8_t  bTrigChannel;                   /* Channel tested by the trigger */
+  int16_t  hTrigLevel;
+  uint16_t hPreTrigger;                    /* Samples kept before the trigger one */
+} MC_Capture_Config_t;
+
+bool MC_Capture_Check(const MC_Capture_Config_t *pConfig);
+bool MC_Capture_Configure(const MC_Capture_Config_t *pConfig);
+bool MC_Capture_Command(uint8_t bCmd);
+void MC_Capture_Record(uint16_t hFaults);
+const MC_Capture_Config_t *MC_Capture_GetConfig(void);
+MC_Capture_State_t MC_Capture_GetState(void);
+void MC_Capture_SetReadIndex(uint16_t hIndex);
+uint16_t MC_Capture_GetReadIndex(void);
+uint16_t MC_Capture_Read(int16_t *pSamples, uint16_t hMaxSamples);
+#ifdef MC_TIMEBASE_MODE
+uint64_t MC_Capture_GetTriggerTime(void);
+#endif
+
+#endif /* MC_CAPTURE_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,74 @@
+/**
+  ******************************************************************************
+  * @file    mc_cbc_limit.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Cycle-by-cycle current limit by a comparator on the current sensing
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_CBC_LIMIT_H
+#define MC_CBC_LIMIT_H
+
+#include "mc_type.h"
+#include "pwm_curr_fdbk.h"
+
+/* The cycle-by-cycle current limit is built when MC_CBC_LIMIT_MODE is added to the
+   preprocessor symbols of the build configuration. MC_CBC_LIMIT_COMP compares the output
+   of the current amplifier of phase U with a threshold of the internal DAC3:
+
+   - its output is the OCREF_CLR input of TIM1, with the clear of the three PWM channels
+     enabled: from the crossing the high sides are off and the low sides on, a zero vector
+     until the next update event, and the current freewheels instead of rising further;
+   - the threshold is MC_CBC_LIMIT_CURRENT below the offset of the phase, the amplifier
+     output falling as the current read rises. It is written by MC_CbcLimit_Arm() from
+     the offsets measured, before each switch on of the PWM: before the first calibration
+     the offset is 0 and the limit never trips;
+   - the crossings set the pending flag of the EXTI line of the comparator, whose
+     interrupt is not enabled in the NVIC. The high frequency task reads and clears it
+     with MC_CbcLimit_Exec(), once per period, and gives the periods cut to the predictive
+     controller with PCC_LIMIT_EVENTS.
+
+   The limit applies to one polarity of one phase, OCREF_CLR taking a single comparator,
+   and only while the low side of the phase conducts, when the shunt carries the current.
+   The TIM1 break on M1_OCP stays the protection, with its fault. The defaults follow the
+   wiring of this board: they must be checked against the schematic of another one. */
+
+/* Comparator on the output of the amplifier of phase U, PA0 */
+#ifndef MC_CBC_LIMIT_COMP
+#define MC_CBC_LIMIT_COMP           COMP3
+#define MC_CBC_LIMIT_INPUT_PLUS     LL_COMP_INPUT_PLUS_IO1
+#define MC_CBC_LIMIT_INPUT_MINUS    LL_COMP_INPUT_MINUS_DAC3_CH1
+#define MC_CBC_LIMIT_DAC_CHANNEL    LL_DAC_CHANNEL_1
+#define MC_CBC_LIMIT_OCREF_CLR      LL_TIM_OCREF_CLR_INT_COMP3
+#define MC_CBC_LIMIT_EXTI_LINE      LL_EXTI_LINE_29
+#endif
+
+/* Phase current of the limit, in digits, above the trip current of the predictive
+   controller and below the end of the measurement range */
+#ifndef MC_CBC_LIMIT_CURRENT
+#define MC_CBC_LIMIT_CURRENT        ((int16_t)((95 * (int32_t)INT16_MAX) / 100))
+#endif
+
+/* Hysteresis of the comparator, against the ringing of the low side turn on */
+#ifndef MC_CBC_LIMIT_HYSTERESIS
+#define MC_CBC_LIMIT_HYSTERESIS     LL_COMP_HYSTERESIS_10MV
+#endif
+
+void MC_CbcLimit_Init(void);
+void MC_CbcLimit_Arm(PWMC_Handle_t *pPWMC);
+bool MC_CbcLimit_Exec(void);
+uint16_t MC_CbcLimit_GetEvents(void);
+
+#endif /* MC_CBC_LIMIT_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
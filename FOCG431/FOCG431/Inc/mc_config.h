@@ -33,13 +33,51 @@
 #include "r_divider_bus_voltage_sensor.h"
 #include "virtual_bus_voltage_sensor.h"
 #include "pqd_motor_power_measurement.h"
+#include "inrush_current_limiter.h"
+#include "power_stage_parameters.h"
+#if defined (SINGLE_SHUNT)
+#include "r1_g4xx_pwm_curr_fdbk.h"
+#elif defined (ICS_SENSORS)
+#include "ics_g4xx_pwm_curr_fdbk.h"
+#else
 #include "r3_2_g4xx_pwm_curr_fdbk.h"
+#endif
 
 #include "ramp_ext_mngr.h"
 #include "circle_limitation.h"
+#include "flux_weakening_ctrl.h"
+#include "feed_forward_ctrl.h"
+#include "max_torque_per_ampere.h"
+#include "pcc.h"
+#include "pcc_est.h"
+#include "thermal_derating.h"
+#include "loss_minimization.h"
+#include "harmonic_compensation.h"
+#include "six_step_mode.h"
+#include "load_torque_obs.h"
+#include "speed_filter.h"
+#include "speed_mpc.h"
+#include "mc_curr_regulation.h"
+#ifdef MC_GAP_MODE
+#include "mc_gap.h"
+#endif
+#ifdef DBG_MCU_LOAD_MEASURE
+#include "mc_perf.h"
+#endif
 
 #include "sto_speed_pos_fdbk.h"
 #include "sto_pll_speed_pos_fdbk.h"
+#include "sto_cordic_speed_pos_fdbk.h"
+#ifdef M1_ENCODER_SENSOR
+#include "encoder_speed_pos_fdbk.h"
+#include "enc_align_ctrl.h"
+#endif
+#ifdef M1_HFI_SENSOR
+#include "hfi_speed_pos_fdbk.h"
+#endif
+#ifdef M1_POSITION_CTRL
+#include "trajectory_ctrl.h"
+#endif
 /* USER CODE BEGIN Additional include */
 
 /* USER CODE END Additional include */
@@ -49,24 +87,176 @@ extern PID_Handle_t PIDSpeedHandle_M1;
 extern PID_Handle_t PIDIqHandle_M1;
 extern PID_Handle_t PIDIdHandle_M1;
 extern NTC_Handle_t TempSensor_M1;
+#if defined (SINGLE_SHUNT)
+extern PWMC_R1_Handle_t PWM_Handle_M1;
+#elif defined (ICS_SENSORS)
+extern PWMC_ICS_Handle_t PWM_Handle_M1;
+#else
 extern PWMC_R3_2_Handle_t PWM_Handle_M1;
+#endif
+
+#ifdef MC_STATIC_BINDING_MODE
+/* The handle of the PWM is bound at compile time as well */
+#ifndef MC_PWMC_DIRECT_MODE
+#define MC_PWMC_DIRECT_MODE
+#endif
+#endif
+#if defined (MC_PWMC_DIRECT_MODE) && (NBR_OF_MOTORS != 1)
+#error "MC_PWMC_DIRECT_MODE requires a single motor"
+#endif
+
+/* Functions of the driver of PWM_Handle_M1, called directly by pwm_curr_fdbk.c with
+   MC_PWMC_DIRECT_MODE instead of through the function pointers of the handle */
+#if defined (SINGLE_SHUNT) && defined (SIX_STEP_MODE)
+#error "SIX_STEP_MODE requires three shunts or ICS sensors: a vertex held over the period gives the bus current of a single phase"
+#endif
+#if defined (SINGLE_SHUNT)
+#define PWMC_GET_PHASE_CURRENTS_M1    R1_GetPhaseCurrents
+#define PWMC_SET_SAMP_POINT_SECTX_M1  R1_SetADCSampPointSectX
+#define PWMC_SET_SAMP_POINT_STATE_M1  R1_SetADCSampPointState
+#define PWMC_SWITCH_OFF_PWM_M1        R1_SwitchOffPWM
+#define PWMC_SWITCH_ON_PWM_M1         R1_SwitchOnPWM
+#define PWMC_TURN_ON_LOW_SIDES_M1     R1_TurnOnLowSides
+#define PWMC_IS_OVER_CURRENT_M1       R1_IsOverCurrentOccurred
+#elif defined (ICS_SENSORS)
+#define PWMC_GET_PHASE_CURRENTS_M1    ICS_GetPhaseCurrents
+#define PWMC_SET_SAMP_POINT_SECTX_M1  ICS_WriteTIMRegisters
+#define PWMC_SET_SAMP_POINT_STATE_M1  ICS_SetADCSampPointState
+#define PWMC_SWITCH_OFF_PWM_M1        ICS_SwitchOffPWM
+#define PWMC_SWITCH_ON_PWM_M1         ICS_SwitchOnPWM
+#define PWMC_TURN_ON_LOW_SIDES_M1     ICS_TurnOnLowSides
+#define PWMC_IS_OVER_CURRENT_M1       ICS_IsOverCurrentOccurred
+#elif defined (PCC_FULL_HEXAGON) || defined (SIX_STEP_MODE)
+#define PWMC_GET_PHASE_CURRENTS_M1    R3_2_GetPhaseCurrents_OVM
+#define PWMC_SET_SAMP_POINT_SECTX_M1  R3_2_SetADCSampPointSectX_OVM
+#define PWMC_SET_SAMP_POINT_STATE_M1  R3_2_SetADCSampPointState
+#define PWMC_SWITCH_OFF_PWM_M1        R3_2_SwitchOffPWM
+#define PWMC_SWITCH_ON_PWM_M1         R3_2_SwitchOnPWM
+#define PWMC_TURN_ON_LOW_SIDES_M1     R3_2_TurnOnLowSides
+#define PWMC_IS_OVER_CURRENT_M1       R3_2_IsOverCurrentOccurred
+#else
+#define PWMC_GET_PHASE_CURRENTS_M1    R3_2_GetPhaseCurrents
+#define PWMC_SET_SAMP_POINT_SECTX_M1  R3_2_SetADCSampPointSectX
+#define PWMC_SET_SAMP_POINT_STATE_M1  R3_2_SetADCSampPointState
+#define PWMC_SWITCH_OFF_PWM_M1        R3_2_SwitchOffPWM
+#define PWMC_SWITCH_ON_PWM_M1         R3_2_SwitchOnPWM
+#define PWMC_TURN_ON_LOW_SIDES_M1     R3_2_TurnOnLowSides
+#define PWMC_IS_OVER_CURRENT_M1       R3_2_IsOverCurrentOccurred
+#endif
 extern SpeednTorqCtrl_Handle_t SpeednTorqCtrlM1;
 extern PQD_MotorPowMeas_Handle_t PQD_MotorPowMeasM1;
 extern PQD_MotorPowMeas_Handle_t *pPQD_MotorPowMeasM1;
 extern VirtualSpeedSensor_Handle_t VirtualSpeedSensorM1;
+#ifdef M1_ENCODER_SENSOR
+extern ENCODER_Handle_t ENCODER_M1;
+extern EncAlign_Handle_t EncAlignCtrlM1;
+#endif
+#ifdef M1_HFI_SENSOR
+extern HFI_Handle_t HFI_M1;
+#endif
+#ifdef M1_POSITION_CTRL
+extern PID_Handle_t PID_PosParamsM1;
+extern PosCtrl_Handle_t PosCtrlM1;
+#endif
 extern STO_Handle_t STO_M1;
 extern STO_PLL_Handle_t STO_PLL_M1;
+extern STO_CR_Handle_t STO_CR_M1;
 extern RDivider_Handle_t BusVoltageSensor_M1;
+#ifdef M1_ICL_ENABLED
+extern ICL_Handle_t ICL_M1;
+extern DOUT_handle_t ICLDOUTParamsM1;
+#endif
 extern CircleLimitation_Handle_t CircleLimitationM1;
+extern PID_Handle_t PIDFluxWeakeningHandle_M1;
+extern FW_Handle_t FW_M1;
+extern FF_Handle_t FF_M1;
+extern MTPA_Handle_t MTPARegM1;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+extern PCC_Handle_t PCC_M1;
+#ifdef PCC_MODEL_ESTIMATION
+extern PCC_EST_Handle_t PCC_EST_M1;
+#endif
+#endif
+#ifdef THERMAL_DERATING
+extern TDR_Handle_t TDR_M1;
+#endif
+#ifdef LOSS_MINIMIZATION
+extern LMN_Handle_t LMN_M1;
+#endif
+#ifdef HARMONIC_COMPENSATION
+extern HCM_Handle_t HCM_M1;
+#endif
+#ifdef SIX_STEP_MODE
+extern SSM_Handle_t SSM_M1;
+#endif
+extern CRG_Handle_t CurrRegM1;
+#ifdef LOAD_TORQUE_OBSERVER
+extern LTO_Handle_t LTO_M1;
+#endif
+#ifdef SPEED_FILTER_BANK
+extern SFB_Handle_t SFB_M1;
+#endif
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+extern SMPC_Handle_t SMPC_M1;
+#endif
+#ifdef MC_GAP_MODE
+extern GAP_Handle_t STGAP_M1;
+#endif
 extern RampExtMngr_Handle_t RampExtMngrHFParamsM1;
 
 extern MCI_Handle_t Mci[NBR_OF_MOTORS];
-extern SpeednTorqCtrl_Handle_t *pSTC[NBR_OF_MOTORS];
-extern PID_Handle_t *pPIDIq[NBR_OF_MOTORS];
-extern PID_Handle_t *pPIDId[NBR_OF_MOTORS];
-extern NTC_Handle_t *pTemperatureSensor[NBR_OF_MOTORS];
-extern PQD_MotorPowMeas_Handle_t *pMPM[NBR_OF_MOTORS];
+#ifdef MC_STATIC_BINDING_MODE
+#if (NBR_OF_MOTORS != 1)
+#error "MC_STATIC_BINDING_MODE requires a single motor"
+#endif
+/* The handle tables are constant in each file that includes this one, instead of
+   being defined in mc_config.c: pPIDIq[M1] and the like are then folded to the
+   address of the component, without any load from RAM */
+#define MC_HANDLE_TABLE(Type, Table, HandleM1)  static Type * const Table[NBR_OF_MOTORS] = {&(HandleM1)}
+#else
+#define MC_HANDLE_TABLE(Type, Table, HandleM1)  extern Type *Table[NBR_OF_MOTORS]
+#endif
+
+MC_HANDLE_TABLE(SpeednTorqCtrl_Handle_t, pSTC, SpeednTorqCtrlM1);
+MC_HANDLE_TABLE(PID_Handle_t, pPIDIq, PIDIqHandle_M1);
+MC_HANDLE_TABLE(PID_Handle_t, pPIDId, PIDIdHandle_M1);
+MC_HANDLE_TABLE(FW_Handle_t, pFW, FW_M1);
+MC_HANDLE_TABLE(FF_Handle_t, pFF, FF_M1);
+MC_HANDLE_TABLE(MTPA_Handle_t, pMaxTorquePerAmpere, MTPARegM1);
+MC_HANDLE_TABLE(CRG_Handle_t, pCRG, CurrRegM1);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+MC_HANDLE_TABLE(PCC_Handle_t, pPCC, PCC_M1);
+#ifdef PCC_MODEL_ESTIMATION
+MC_HANDLE_TABLE(PCC_EST_Handle_t, pPCCEst, PCC_EST_M1);
+#endif
+#endif
+MC_HANDLE_TABLE(NTC_Handle_t, pTemperatureSensor, TempSensor_M1);
+#ifdef THERMAL_DERATING
+MC_HANDLE_TABLE(TDR_Handle_t, pTDR, TDR_M1);
+#endif
+#ifdef LOSS_MINIMIZATION
+MC_HANDLE_TABLE(LMN_Handle_t, pLMN, LMN_M1);
+#endif
+#ifdef HARMONIC_COMPENSATION
+MC_HANDLE_TABLE(HCM_Handle_t, pHCM, HCM_M1);
+#endif
+#ifdef SIX_STEP_MODE
+MC_HANDLE_TABLE(SSM_Handle_t, pSSM, SSM_M1);
+#endif
+#ifdef LOAD_TORQUE_OBSERVER
+MC_HANDLE_TABLE(LTO_Handle_t, pLTO, LTO_M1);
+#endif
+#ifdef SPEED_FILTER_BANK
+MC_HANDLE_TABLE(SFB_Handle_t, pSFB, SFB_M1);
+#endif
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+MC_HANDLE_TABLE(SMPC_Handle_t, pSMPC, SMPC_M1);
+#endif
+MC_HANDLE_TABLE(PQD_MotorPowMeas_Handle_t, pMPM, PQD_MotorPowMeasM1);
 extern MCI_Handle_t* pMCI[NBR_OF_MOTORS];
+#ifdef DBG_MCU_LOAD_MEASURE
+extern MC_Perf_Handle_t PerfTraces;
+#endif
 
 /* USER CODE BEGIN Additional extern */
 
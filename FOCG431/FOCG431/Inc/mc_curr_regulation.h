@@ -0,0 +1,355 @@
+/**
+  ******************************************************************************
+  * @file    mc_curr_regulation.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Current regulation backends of the FOC_CurrController of each motor
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_CURR_REGULATION_H
+#define MC_CURR_REGULATION_H
+
+#include "mc_type.h"
+#include "pid_regulator.h"
+#include "feed_forward_ctrl.h"
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#include "pcc.h"
+#ifdef PCC_MODEL_ESTIMATION
+#include "pcc_est.h"
+#endif
+#endif
+#ifdef HARMONIC_COMPENSATION
+#include "harmonic_compensation.h"
+#endif
+#ifdef SIX_STEP_MODE
+#include "six_step_mode.h"
+#endif
+#ifdef MC_ABTEST_MODE
+#include "mc_abtest.h"
+#endif
+#ifdef MC_FRA_MODE
+#include "mc_fra.h"
+#endif
+
+/* Each backend implements CRG_Regulate() and CRG_RegulationDone() for the
+   FOC_CurrController of each motor. Only the backend selected by CURRENT_CONTROLLER
+   is built, and its functions are inlined in the controller, without any dispatch.
+   The software in the loop build of the SIL directory runs the same functions on
+   its plant model, with the handles of the port. */
+
+/**
+  * @brief Current regulation of a motor: the controllers it runs and, with the
+  *        predictive controller, the state of the handover between the PI
+  *        controllers and the predictive one
+  */
+typedef struct
+{
+  PID_Handle_t *pPIDIq;           /*!< Torque PI controller */
+  PID_Handle_t *pPIDId;           /*!< Flux PI controller */
+  FF_Handle_t *pFF;               /*!< Feed forward added to the output of the PI controllers */
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  PCC_Handle_t *pPCC;             /*!< Predictive current controller */
+#ifdef PCC_MODEL_ESTIMATION
+  PCC_EST_Handle_t *pPCCEst;      /*!< Estimator of the model of the predictive controller */
+#endif
+#ifdef PCC_BLENDED_HANDOVER
+  uint32_t wBlendPeriods;         /*!< FOC periods of the blend of a handover */
+#endif
+#endif
+#ifdef HARMONIC_COMPENSATION
+  HCM_Handle_t *pHCM;             /*!< Compensation of the harmonics of the back-EMF */
+#endif
+#ifdef SIX_STEP_MODE
+  SSM_Handle_t *pSSM;             /*!< Six step mode of the high speeds */
+#endif
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  volatile bool PCCSelected;      /*!< Current controller chosen by the medium frequency task */
+  bool PCCEngaged;                /*!< Current controller run by the high frequency task */
+#ifdef PCC_BLENDED_HANDOVER
+  uint32_t wBlendCount;           /*!< FOC periods left in the blend with the controller left */
+#endif
+#endif
+} CRG_Handle_t;
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+/**
+  * @brief  It clears the predictive controller and engages the PI controllers.
+  *         It must be called before each motor restart.
+  * @param  pHandle current regulation of the motor
+  * @retval none
+  */
+static inline void CRG_Clear(CRG_Handle_t *pHandle)
+{
+  PCC_Clear(pHandle->pPCC);
+  pHandle->PCCSelected = false;
+  pHandle->PCCEngaged = false;
+#ifdef PCC_BLENDED_HANDOVER
+  pHandle->wBlendCount = 0U;
+#endif
+}
+
+/**
+  * @brief  It hands the current regulation over to the requested controller.
+  *         The PI controllers start with their integral terms preloaded from the
+  *         last voltage applied by the predictive controller, so that the
+  *         voltage does not step at the handover.
+  * @param  pHandle current regulation of the motor
+  * @param  PCCRequested true to engage the predictive controller, false to
+  *         engage the PI controllers
+  * @param  Vqd voltage applied during the period
+  * @retval none
+  */
+static inline void CRG_HandOver(CRG_Handle_t *pHandle, bool PCCRequested, qd_t Vqd)
+{
+  if (true == PCCRequested)
+  {
+    /* The predictor starts from the voltage applied by the PI controllers */
+    PCC_Clear(pHandle->pPCC);
+    pHandle->PCCEngaged = true;
+  }
+  else
+  {
+    /* The PI controllers take over the applied voltage, less the feed forward
+       voltage added to their output */
+    qd_t Vqdff = FF_GetVqdff(pHandle->pFF);
+
+    PID_SetIntegralTerm(pHandle->pPIDIq, ((int32_t)Vqd.q - Vqdff.q) * (int32_t)PID_GetKIDivisor(pHandle->pPIDIq));
+    PID_SetIntegralTerm(pHandle->pPIDId, ((int32_t)Vqd.d - Vqdff.d) * (int32_t)PID_GetKIDivisor(pHandle->pPIDId));
+    pHandle->PCCEngaged = false;
+  }
+#ifdef PCC_BLENDED_HANDOVER
+  /* A handover during the blend starts from the voltage already blended */
+  pHandle->wBlendCount = pHandle->wBlendPeriods;
+#endif
+}
+
+/**
+  * @brief  It computes the voltage that regulates the Iqd currents, with the
+  *         predictive current controller above the engage speed and the PI
+  *         controllers below the disengage speed. It must be called by
+  *         the FOC_CurrController of the motor only.
+  * @param  pHandle current regulation of the motor
+  * @param  Iqd measured currents in the q/d frame
+  * @param  Iqdref current references
+  * @param  Vqd voltage applied during the period
+  * @param  Trig sine and cosine of the electrical angle of the Park transformation
+  * @param  hElSpeedDpp instantaneous electrical speed in dpp
+  * @retval qd_t Voltage, before the circle limitation
+  */
+static inline qd_t CRG_Regulate(CRG_Handle_t *pHandle, qd_t Iqd, qd_t Iqdref, qd_t Vqd, Trig_Components Trig,
+                                int16_t hElSpeedDpp)
+{
+  qd_t VqdNext;
+  bool PCCRequested;
+#ifdef MC_ABTEST_MODE
+  const MC_ABTest_Arm_t *pArm;
+#endif
+
+  /* A tuning set written over MCP takes effect here, for a whole control period */
+  PCC_ApplyTuning(pHandle->pPCC);
+#ifdef PCC_INDUCTANCE_TABLE
+  /* The inductance of the predictor follows the saturation at the measured load */
+  PCC_SelectInductance(pHandle->pPCC, Iqd.q);
+#endif
+#ifdef HARMONIC_COMPENSATION
+  /* The entry of the angle of the period, for both controllers */
+  Iqdref = HCM_AddCurrent(pHandle->pHCM, Iqdref);
+  PCC_SetBemfHarmonic(pHandle->pPCC, HCM_GetVoltage(pHandle->pHCM));
+#endif
+#ifdef MC_FRA_MODE
+  Iqdref = MC_Fra_InjectCurrent(Iqdref);
+#endif
+
+  /* The controller selected by the medium frequency task takes over from here,
+     unless repeated budget overruns have handed the regulation to the PI */
+  PCCRequested = pHandle->PCCSelected;
+#ifdef MC_ABTEST_MODE
+  pArm = MC_ABTest_GetArm();
+  if (MC_NULL != pArm)
+  {
+    /* The arm of the block replaces the choice of the engage speeds */
+    PCCRequested = (MC_ABTEST_CTRL_PCC == (MC_ABTest_Controller_t)pArm->bController);
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    PCC_SetWeightIndex(pHandle->pPCC, pArm->bWeightIndex);
+#endif
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+  PCCRequested = (true == PCC_FallbackTick(pHandle->pPCC)) ? false : PCCRequested;
+#ifdef SIX_STEP_MODE
+  /* The vertices only take the angle of the request: the PI controllers give it
+     without the cost of the search */
+  PCCRequested = (true == SSM_IsActive(pHandle->pSSM)) ? false : PCCRequested;
+#endif
+  if (pHandle->PCCEngaged != PCCRequested)
+  {
+    CRG_HandOver(pHandle, PCCRequested, Vqd);
+  }
+
+  if (true == pHandle->PCCEngaged)
+  {
+#ifdef PCC_ADAPTIVE_PERIOD
+    if (true == PCC_HoldTick(pHandle->pPCC))
+    {
+      /* The vector of the last decision stays on the inverter */
+      VqdNext = PCC_GetHeldVoltage(pHandle->pPCC, Trig);
+    }
+    else
+#endif
+    {
+      VqdNext = PCC_CalcVoltage(pHandle->pPCC, Iqd, Iqdref, Vqd, Trig, hElSpeedDpp);
+    }
+  }
+  else
+  {
+    VqdNext.q = PI_Controller(pHandle->pPIDIq, (int32_t)(Iqdref.q) - Iqd.q);
+    VqdNext.d = PI_Controller(pHandle->pPIDId, (int32_t)(Iqdref.d) - Iqd.d);
+    VqdNext = FF_VqdConditioning(pHandle->pFF, VqdNext);
+    FF_DataProcess(pHandle->pFF);
+#ifdef HARMONIC_COMPENSATION
+    VqdNext = HCM_AddVoltage(pHandle->pHCM, VqdNext);
+#endif
+  }
+#ifdef PCC_BLENDED_HANDOVER
+  if (pHandle->wBlendCount > 0U)
+  {
+    /* The controller left runs until the end of the ramp, with its weight in Q15
+       going down to zero */
+    qd_t VqdLeft;
+    int32_t wWeight = (int32_t)((pHandle->wBlendCount << 15) / pHandle->wBlendPeriods);
+
+    if (true == pHandle->PCCEngaged)
+    {
+      VqdLeft.q = PI_Controller(pHandle->pPIDIq, (int32_t)(Iqdref.q) - Iqd.q);
+      VqdLeft.d = PI_Controller(pHandle->pPIDId, (int32_t)(Iqdref.d) - Iqd.d);
+      VqdLeft = FF_VqdConditioning(pHandle->pFF, VqdLeft);
+      FF_DataProcess(pHandle->pFF);
+#ifdef HARMONIC_COMPENSATION
+      VqdLeft = HCM_AddVoltage(pHandle->pHCM, VqdLeft);
+#endif
+    }
+    else
+    {
+      VqdLeft = PCC_CalcVoltage(pHandle->pPCC, Iqd, Iqdref, Vqd, Trig, hElSpeedDpp);
+    }
+    VqdNext.q = (int16_t)((int32_t)VqdNext.q + ((((int32_t)VqdLeft.q - VqdNext.q) * wWeight) >> 15));
+    VqdNext.d = (int16_t)((int32_t)VqdNext.d + ((((int32_t)VqdLeft.d - VqdNext.d) * wWeight) >> 15));
+    pHandle->wBlendCount--;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+#ifdef MC_FRA_MODE
+  VqdNext = MC_Fra_InjectVoltage(VqdNext);
+#endif
+  return (VqdNext);
+}
+
+/**
+  * @brief  It completes the control period once the voltage is applied. It must
+  *         be called by the FOC_CurrController of the motor only.
+  * @param  pHandle current regulation of the motor
+  * @param  Iqd measured currents in the q/d frame
+  * @param  Vqd applied voltage in the q/d frame
+  * @retval uint16_t MC_NO_FAULTS. A horizon search stopped by its node budget
+  *         is not a fault: the best sequence found is applied and repeated
+  *         overruns fall back to the PI controllers, see PCC_FallbackTick()
+  */
+static inline uint16_t CRG_RegulationDone(CRG_Handle_t *pHandle, qd_t Iqd, qd_t Vqd)
+{
+#ifdef PCC_MODEL_ESTIMATION
+  PCC_EST_Accumulate(pHandle->pPCCEst, Iqd, Vqd);
+#else
+  (void)pHandle;
+  (void)Iqd;
+  (void)Vqd;
+#endif
+  return (MC_NO_FAULTS);
+}
+
+#else /* CURRENT_CONTROLLER == CURR_CTRL_PI */
+/**
+  * @brief  It clears the current regulation. Nothing to do with the PI
+  *         controllers, cleared by FOC_Clear().
+  * @param  pHandle unused
+  * @retval none
+  */
+static inline void CRG_Clear(CRG_Handle_t *pHandle)
+{
+  (void)pHandle;
+}
+
+/**
+  * @brief  It computes the voltage that regulates the Iqd currents with the
+  *         torque and flux PI controllers. It must be called by
+  *         the FOC_CurrController of the motor only.
+  * @param  pHandle current regulation of the motor
+  * @param  Iqd measured currents in the q/d frame
+  * @param  Iqdref current references
+  * @param  Vqd unused
+  * @param  Trig unused
+  * @param  hElSpeedDpp unused
+  * @retval qd_t Voltage, before the circle limitation
+  */
+static inline qd_t CRG_Regulate(CRG_Handle_t *pHandle, qd_t Iqd, qd_t Iqdref, qd_t Vqd, Trig_Components Trig,
+                                int16_t hElSpeedDpp)
+{
+  qd_t VqdNext;
+
+  (void)Vqd;
+  (void)Trig;
+  (void)hElSpeedDpp;
+#ifdef HARMONIC_COMPENSATION
+  Iqdref = HCM_AddCurrent(pHandle->pHCM, Iqdref);
+#endif
+#ifdef MC_FRA_MODE
+  Iqdref = MC_Fra_InjectCurrent(Iqdref);
+#endif
+  VqdNext.q = PI_Controller(pHandle->pPIDIq, (int32_t)(Iqdref.q) - Iqd.q);
+  VqdNext.d = PI_Controller(pHandle->pPIDId, (int32_t)(Iqdref.d) - Iqd.d);
+  VqdNext = FF_VqdConditioning(pHandle->pFF, VqdNext);
+  FF_DataProcess(pHandle->pFF);
+#ifdef HARMONIC_COMPENSATION
+  VqdNext = HCM_AddVoltage(pHandle->pHCM, VqdNext);
+#endif
+#ifdef MC_FRA_MODE
+  VqdNext = MC_Fra_InjectVoltage(VqdNext);
+#endif
+  return (VqdNext);
+}
+
+/**
+  * @brief  It completes the control period once the voltage is applied. Nothing
+  *         to do with the PI controllers.
+  * @param  pHandle unused
+  * @param  Iqd unused
+  * @param  Vqd unused
+  * @retval uint16_t MC_NO_FAULTS
+  */
+static inline uint16_t CRG_RegulationDone(CRG_Handle_t *pHandle, qd_t Iqd, qd_t Vqd)
+{
+  (void)pHandle;
+  (void)Iqd;
+  (void)Vqd;
+  return (MC_NO_FAULTS);
+}
+#endif
+
+#endif /* MC_CURR_REGULATION_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,167 @@
+/**
+  ******************************************************************************
+  * @file    mc_fdcan.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Cyclic process data of the drive over FDCAN
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_FDCAN_H
+#define MC_FDCAN_H
+
+#include "mc_type.h"
+#ifdef MC_FDCAN_GATEWAY
+#include "mcp.h"
+#include "mcpa.h"
+#endif
+
+/* The FDCAN interface is built when MC_FDCAN_MODE is added to the preprocessor symbols
+   of the build configuration. The master of the bus sends one command frame per cycle,
+   with one MC_FDCAN_SLOT_SIZE bytes slot per drive, its DLC covering the slots of the
+   drives in use. The frame is also the synchronization of the cycle: each drive decodes
+   its slot in the FDCAN interrupt as soon as the frame is received, without any main
+   loop polling, and answers at once with its feedback frame. The bus arbitration then
+   orders the answers by node index.
+
+   Slot of the command frame, little endian:
+     byte 0     MC_FDCAN_CMD_KEEP, MC_FDCAN_CMD_TORQUE or MC_FDCAN_CMD_SPEED
+     byte 1     MC_FDCAN_CTRL_xxx bits, acted upon on their rising edge
+     bytes 2-3  q current reference in digits, or speed reference in SPEED_UNIT
+     bytes 4-5  d current reference in digits, torque command only
+     bytes 6-7  sequence number of the cycle, echoed by the feedback frame
+
+   Feedback frame, MC_FDCAN_FEEDBACK_SIZE bytes, little endian:
+     bytes 0-3  measured q and d currents, in digits
+     bytes 4-5  average mechanical speed, in SPEED_UNIT
+     byte 6     MCI_State_t of the state machine
+     byte 7     0
+     bytes 8-9  current faults
+     bytes 10-11 sequence number of the last command frame
+
+   The references are buffered commands of the MC interface, applied by the next medium
+   frequency task: a cycle faster than the medium frequency task only refreshes them.
+
+   The drives of the bus share the link to the host of one of them, node 0, when it is
+   built with MC_FDCAN_GATEWAY and the others with MC_FDCAN_PEER:
+
+   - each peer samples its currents and voltages every MC_FDCAN_TELEMETRY_DECIMATION
+     FOC periods, in the deferred high frequency task, and sends them by
+     MC_FDCAN_TELEMETRY_SAMPLES in a telemetry frame. The frame is dated by the sequence
+     number of the last command frame and the FOC periods elapsed since it;
+   - the gateway keeps GLOBAL_TIMESTAMP at the reception of the last
+     MC_FDCAN_SEQ_HISTORY command frames and dates the samples of the peers on its own
+     timebase: all the drives receive the command frame together, and count the same
+     FOC periods once their carriers follow it with MC_PWM_SYNC_FDCAN. A frame older
+     than the history is dropped;
+   - the gateway hands the samples to the host as asynchronous packets, between two
+     buffers of its datalog as the reports of mc_report.h: GLOBAL_TIMESTAMP of the first
+     sample on 32 bits, the node, the number of samples, the decimation and the state of
+     the peer on 8 bits each, the samples, then a null mark and the async ID
+     MC_FDCAN_ASYNC_ID;
+   - the host addresses the drive of node k as the motor k + 1 of the MCP header. The
+     gateway forwards the requests to the other nodes, as motor 1, and the peer executes
+     them in its main loop. The gateway answers the host once the peer answered, or with
+     MCP_CMD_NOK after MC_FDCAN_MCP_TIMEOUT_MS, and the next requests wait until then.
+     A request and its answer fit in one frame. The datalog of MCPA is the one of the
+     gateway only, the peers having their telemetry.
+
+   Telemetry frame, MC_FDCAN_TELEMETRY_SIZE bytes, little endian:
+     bytes 0-1  sequence number of the last command frame at the first sample
+     bytes 2-3  FOC periods elapsed since this command frame at the first sample
+     byte 4     number of samples
+     byte 5     FOC periods between two samples
+     byte 6     MCI_State_t of the state machine
+     byte 7     0
+     then, for each sample, the measured q and d currents and the q and d voltages, in
+     digits
+
+   Request and answer frames, 64 bytes:
+     byte 0     number of the request, echoed by its answer
+     byte 1     bytes of the MCP packet, up to MC_FDCAN_MCP_MAX_BYTES
+     then the MCP packet: header and payload of the request, or payload and status of
+     the answer */
+
+/* Node index of the drive, from 0 to MC_FDCAN_MAX_NODES - 1 */
+#ifndef MC_FDCAN_NODE
+#define MC_FDCAN_NODE           0U
+#endif
+#define MC_FDCAN_MAX_NODES      8U
+
+#if defined(MC_FDCAN_GATEWAY) || defined(MC_FDCAN_PEER)
+#define MC_FDCAN_SHARED_LINK
+#endif
+
+/* Standard identifiers: the command has the highest priority of the cycle */
+#define MC_FDCAN_COMMAND_ID     0x100U
+#define MC_FDCAN_FEEDBACK_ID    0x180U  /* + node index */
+
+#define MC_FDCAN_TELEMETRY_ID   0x200U  /* + node index */
+#define MC_FDCAN_REQUEST_ID     0x280U  /* + node index of the peer */
+#define MC_FDCAN_ANSWER_ID      0x300U  /* + node index of the peer */
+
+#define MC_FDCAN_SLOT_SIZE      8U
+#define MC_FDCAN_FEEDBACK_SIZE  12U
+
+/* Command frame, then the frames of the gateway and its peers */
+#define MC_FDCAN_STD_FILTERS    3U
+
+#ifndef MC_FDCAN_TELEMETRY_DECIMATION
+#define MC_FDCAN_TELEMETRY_DECIMATION  8U
+#endif
+#define MC_FDCAN_TELEMETRY_SAMPLES  7U
+#define MC_FDCAN_TELEMETRY_SIZE     (8U + (MC_FDCAN_TELEMETRY_SAMPLES * 8U))
+#define MC_FDCAN_SEQ_HISTORY        16U
+#define MC_FDCAN_ASYNC_ID           2U
+#define MC_FDCAN_MCP_MAX_BYTES      62U
+#ifndef MC_FDCAN_MCP_TIMEOUT_MS
+#define MC_FDCAN_MCP_TIMEOUT_MS     20U
+#endif
+
+/* Commands of byte 0 of the slot */
+#define MC_FDCAN_CMD_KEEP       0U      /* References unchanged */
+#define MC_FDCAN_CMD_TORQUE     1U      /* Cyclic q and d current references */
+#define MC_FDCAN_CMD_SPEED      2U      /* Cyclic speed reference, without ramp */
+
+/* Control bits of byte 1 of the slot */
+#define MC_FDCAN_CTRL_START     0x01U
+#define MC_FDCAN_CTRL_STOP      0x02U
+#define MC_FDCAN_CTRL_ACK       0x04U
+
+void MC_FDCAN_Start(void);
+uint16_t MC_FDCAN_GetSequence(void);
+uint32_t MC_FDCAN_GetLostFeedbacks(void);
+
+#ifdef MC_FDCAN_SHARED_LINK
+/* Medium frequency task, frames queued by the other tasks */
+void MC_FDCAN_Exec(void);
+#endif
+
+#ifdef MC_FDCAN_PEER
+/* Deferred high frequency task */
+void MC_FDCAN_Sample(void);
+/* Main loop */
+void MC_FDCAN_ExecRequest(void);
+#endif
+
+#ifdef MC_FDCAN_GATEWAY
+/* Main loop */
+bool MC_FDCAN_Forward(const MCP_Handle_t *pMCP);
+bool MC_FDCAN_IsForwarding(void);
+bool MC_FDCAN_GetForwardAnswer(MCP_Handle_t *pMCP);
+/* Deferred high frequency task, after the datalog */
+void MC_FDCAN_SendTelemetry(MCPA_Handle_t *pMCPA);
+#endif
+
+#endif /* MC_FDCAN_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file    mc_offset_store.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Storage of the current sensing offsets in flash
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_OFFSET_STORE_H
+#define MC_OFFSET_STORE_H
+
+#include "mc_type.h"
+
+/* The storage is built when MC_OFFSETS_IN_FLASH is added to the preprocessor symbols
+   of the build configuration. The offsets measured by the first calibration are
+   written in the last page of the flash, out of the FLASH region of the linker
+   script (NVM region), and the next starts reuse them instead of measuring them
+   again. A MCI_MEASURE_OFFSETS command always measures and stores them again. */
+
+/* Offsets of the R3_2 component: left aligned conversions, mid scale at rest */
+#define MC_OFFSET_NOMINAL           32768
+/* Largest distance of a stored offset to MC_OFFSET_NOMINAL */
+#define MC_OFFSET_TOLERANCE         4096
+/* Largest distance, in Celsius, of the heat sink temperature to the one of the
+   stored offsets */
+#define MC_OFFSET_MAX_TEMP_DELTA_C  10
+
+bool MC_OffsetStore_Load(PolarizationOffsets_t *pOffsets, int16_t hTemp_C);
+void MC_OffsetStore_Save(const PolarizationOffsets_t *pOffsets, int16_t hTemp_C);
+
+#endif /* MC_OFFSET_STORE_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
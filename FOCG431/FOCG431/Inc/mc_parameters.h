@@ -22,13 +22,29 @@
 #ifndef MC_PARAMETERS_H
 #define MC_PARAMETERS_H
 
+#include "power_stage_parameters.h"
+#if defined (SINGLE_SHUNT)
+#include "r1_g4xx_pwm_curr_fdbk.h"
+#elif defined (ICS_SENSORS)
+#include "ics_g4xx_pwm_curr_fdbk.h"
+#else
 #include "r3_2_g4xx_pwm_curr_fdbk.h"
+#endif
 
 /* USER CODE BEGIN Additional include */
 
 /* USER CODE END Additional include */
 
+#if defined (SINGLE_SHUNT)
+extern R1_Params_t R1_ParamsM1;
+#elif defined (ICS_SENSORS)
+extern ICS_Params_t ICS_ParamsM1;
+#else
 extern R3_2_Params_t R3_2_ParamsM1;
+#if defined (THREE_SHUNT_INTERNAL_OPAMPS)
+extern R3_3_OPAMPParams_t R3_3_OPAMPParamsM1;
+#endif
+#endif
 
 /* USER CODE BEGIN Additional extern */
 
@@ -0,0 +1,147 @@
+/**
+  ******************************************************************************
+  * @file    mc_ram_budget.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Sizes of the buffers of the MCP link and of the captures, and their
+  *          RAM budget
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_RAM_BUDGET_H
+#define MC_RAM_BUDGET_H
+
+#include <stdint.h>
+
+/* The buffers of the MCP link and of the captures take most of the RAM that the
+   control leaves, on the G431 the most of 32 KB. Their sizes are all set here, each
+   one can be overridden by a preprocessor symbol of the build configuration:
+
+   - the async payload sets the bytes of datalog that MCPA sends per packet: with
+     ASPEP_ASYNC_NB_BUFFERS buffers in the ring, it is the largest RAM user. A packet
+     adds 6 bytes of header and CRC to its payload, so that halving it costs below one
+     percent of the throughput of the datalog, but also halves the burst of samples
+     that the ring absorbs while the link is busy. It is halved by default when
+     MC_CAPTURE_MODE is built, to leave room for the capture ring;
+   - the sync payloads bound the answer and the request of a register access, the
+     largest raw registers included. ASPEP_SYNC_NB_BUFFERS pairs of them let the host
+     send that many requests before the answer to the first one;
+   - the depths of the capture, the record, the spectrum and the fault log set the
+     periods they keep, at the FOC rate.
+
+   The buffers of the features built must fit in MC_RAM_BUDGET, checked at build by
+   mc_ram_budget.c. MC_RamReport keeps the bytes of each feature, computed at build
+   from the sizes of their buffers, and MC_REG_RAM_FOOTPRINT returns it. */
+
+/* Bytes of RAM given to the buffers of the link and of the captures */
+#ifndef MC_RAM_BUDGET
+#define MC_RAM_BUDGET               16384U
+#endif
+
+/* Payloads of the ASPEP packets, a multiple of 32 bytes for the sync ones and of
+   64 bytes for the async one */
+#ifndef MCP_RX_SYNC_PAYLOAD_MAX
+#define MCP_RX_SYNC_PAYLOAD_MAX     256U
+#endif
+#ifndef MCP_TX_SYNC_PAYLOAD_MAX
+#define MCP_TX_SYNC_PAYLOAD_MAX     256U
+#endif
+#ifndef MCP_TX_ASYNC_PAYLOAD_MAX_A
+#ifdef MC_CAPTURE_MODE
+#define MCP_TX_ASYNC_PAYLOAD_MAX_A  1024U
+#else
+#define MCP_TX_ASYNC_PAYLOAD_MAX_A  2048U
+#endif
+#endif
+
+/* Number of asynchronous buffers of the ring: one sent by the DMA, one waiting for the DMA and
+   one filled by the MCPA, so that the datalog never waits for the end of a transfer */
+#ifndef ASPEP_ASYNC_NB_BUFFERS
+#define ASPEP_ASYNC_NB_BUFFERS      3U
+#endif
+
+/* Number of requests of the host outstanding at once, each with its receive and answer
+   buffers. With one, the host waits for each answer before the next request; with more,
+   the next requests are received while one is processed and its answer sent, the host
+   matching the answers by the tag of their header. MC_REG_ASPEP_SYNC_DEPTH returns it */
+#ifndef ASPEP_SYNC_NB_BUFFERS
+#define ASPEP_SYNC_NB_BUFFERS       2U
+#endif
+
+/* Registers that the datalog of MCPA can stream */
+#ifndef MCPA_OVER_UARTA_STREAM
+#define MCPA_OVER_UARTA_STREAM      10
+#endif
+
+/* Number of samples of the capture ring, a power of two */
+#ifndef MC_CAPTURE_DEPTH
+#define MC_CAPTURE_DEPTH            256U
+#endif
+
+/* Number of frames of a record */
+#ifndef MC_RECORD_DEPTH
+#define MC_RECORD_DEPTH             256U
+#endif
+
+/* Samples of a spectrum, log2 */
+#ifndef MC_SPECTRUM_SIZE_LOG
+#define MC_SPECTRUM_SIZE_LOG        8U
+#endif
+
+/* Snapshots of an entry of the fault log, must be even so that the entries fill
+   whole 64-bit words */
+#ifndef MC_FAULTLOG_DEPTH
+#define MC_FAULTLOG_DEPTH           8U
+#endif
+
+/* Bounds of the fields of the ASPEP beacon */
+#if ((MCP_RX_SYNC_PAYLOAD_MAX % 32U) != 0U) || (MCP_RX_SYNC_PAYLOAD_MAX < 32U) || (MCP_RX_SYNC_PAYLOAD_MAX > 2048U)
+#error "MCP_RX_SYNC_PAYLOAD_MAX must be a multiple of 32 up to 2048"
+#endif
+#if ((MCP_TX_SYNC_PAYLOAD_MAX % 32U) != 0U) || (MCP_TX_SYNC_PAYLOAD_MAX < 32U) || (MCP_TX_SYNC_PAYLOAD_MAX > 4096U)
+#error "MCP_TX_SYNC_PAYLOAD_MAX must be a multiple of 32 up to 4096"
+#endif
+#if ((MCP_TX_ASYNC_PAYLOAD_MAX_A % 64U) != 0U) || (MCP_TX_ASYNC_PAYLOAD_MAX_A < 64U) || (MCP_TX_ASYNC_PAYLOAD_MAX_A > 8128U)
+#error "MCP_TX_ASYNC_PAYLOAD_MAX_A must be a multiple of 64 up to 8128"
+#endif
+#if (ASPEP_ASYNC_NB_BUFFERS < 2U) || (ASPEP_ASYNC_NB_BUFFERS > 4U)
+#error "ASPEP_ASYNC_NB_BUFFERS must be 2, 3 or 4"
+#endif
+#if (ASPEP_SYNC_NB_BUFFERS < 1U) || (ASPEP_SYNC_NB_BUFFERS > 4U)
+#error "ASPEP_SYNC_NB_BUFFERS must be 1 to 4"
+#endif
+
+/* Features of MC_RamReport */
+typedef enum
+{
+  MC_RAM_ASPEP,                     /* Sync, receive and async buffers of the link */
+  MC_RAM_MCPA,                      /* Tables of the streamed registers */
+  MC_RAM_CAPTURE,
+  MC_RAM_RECORD,
+  MC_RAM_SPECTRUM,
+  MC_RAM_FAULTLOG,
+  MC_RAM_NB_FEATURES
+} MC_RAM_Feature_t;
+
+/* Layout of MC_REG_RAM_FOOTPRINT, in bytes. The features not built take 0 */
+typedef struct
+{
+  uint32_t wBudget;                 /* MC_RAM_BUDGET */
+  uint32_t wTotal;                  /* Sum of the features */
+  uint32_t wFeature[MC_RAM_NB_FEATURES];
+} MC_RAM_Report_t;
+
+extern const MC_RAM_Report_t MC_RamReport;
+
+#endif /* MC_RAM_BUDGET_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file    mc_record.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Record of the inputs and outputs of the current controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_RECORD_H
+#define MC_RECORD_H
+
+#include "mc_type.h"
+#include "mc_ram_budget.h"
+
+/* The record is built when MC_RECORD_MODE is added to the preprocessor symbols of the
+   build configuration. Writing MC_RECORD_CMD_ARM in the MC_REG_RECORD_STATE register
+   arms it: from the first FOC period after the next FOC_Clear(), that is from the
+   cleared state of the controllers at the next start, FOC_CurrControllerM1 writes one
+   frame per period in RAM, without any link traffic. The record stops when it is full
+   or at the following FOC_Clear(), when the motor is stopped. The frames are then
+   read at the link pace with the MC_REG_RECORD_INDEX and MC_REG_RECORD_DATA registers.
+
+   A frame holds the exact values that the current controller read and wrote in its
+   period, so that the controller code built for a host can be fed with the inputs
+   from the same cleared state and its outputs compared with the recorded ones. The
+   references and the bus voltage are the ones written by the medium frequency task. */
+
+/* Number of frames of a record: MC_RECORD_DEPTH, see mc_ram_budget.h */
+
+/* Commands written in MC_REG_RECORD_STATE */
+#define MC_RECORD_CMD_STOP      0U
+#define MC_RECORD_CMD_ARM       1U
+
+/* Bits of MC_Record_Frame_t::hFlags */
+#define MC_RECORD_FLAG_PCC      0x0001U   /* Regulated by the predictive controller */
+
+typedef enum
+{
+  MC_RECORD_IDLE,
+  MC_RECORD_ARMED,          /* Waiting for the clear of the controllers */
+  MC_RECORD_RECORDING,
+  MC_RECORD_DONE            /* Frozen, ready to be read */
+} MC_Record_State_t;
+
+/* One FOC period, also the layout of the frames of MC_REG_RECORD_DATA */
+typedef struct
+{
+  int16_t  hIa;                     /* Phase currents read, before the Clarke transformation */
+  int16_t  hIb;
+  int16_t  hElAngle;                /* Angle of the Park transformation */
+  int16_t  hElSpeedDpp;             /* Electrical speed given to the regulation */
+  int16_t  hIqref;                  /* Current references of the period */
+  int16_t  hIdref;
+  uint16_t hBusVoltage_d;           /* Averaged bus voltage, in u16Volts */
+  uint16_t hFlags;                  /* MC_RECORD_FLAG_xxx */
+  int16_t  hVq;                     /* Voltage written, limited by the circle limitation */
+  int16_t  hVd;
+} MC_Record_Frame_t;
+
+bool MC_Record_Command(uint8_t bCmd);
+void MC_Record_Clear(void);
+MC_Record_State_t MC_Record_GetState(void);
+void MC_Record_Write(const MC_Record_Frame_t *pFrame);
+uint16_t MC_Record_GetLength(void);
+void MC_Record_SetReadIndex(uint16_t hIndex);
+uint16_t MC_Record_GetReadIndex(void);
+uint16_t MC_Record_Read(MC_Record_Frame_t *pFrames, uint16_t hMaxFrames);
+
+#endif /* MC_RECORD_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
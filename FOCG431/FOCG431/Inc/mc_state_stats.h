@@ -0,0 +1,70 @@
+/**
+  ******************************************************************************
+  * @file    mc_state_stats.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Residence time and transitions of the states of the drive
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_STATE_STATS_H
+#define MC_STATE_STATS_H
+
+#include "mc_type.h"
+#include "mc_interface.h"
+
+/* The state statistics are built when MC_STATE_STATS_MODE is added to the preprocessor
+   symbols of the build configuration. The medium frequency task samples the state of
+   the drive at each of its periods, before it moves the state machine:
+
+   - for each state, the number of entries, the periods of the last residence and the
+     periods spent in the state since the reset;
+   - for each state, the periods from the last exit of IDLE to its last entry: after a
+     start they give the time line of CHARGE_BOOT_CAP, OFFSET_CALIB, START, SWITCH_OVER
+     and RUN;
+   - MC_REG_STATE_STATS returns MC_StateStats_t, a write to it resets the statistics.
+
+   The resolution is one period of the medium frequency task: a state left in the same
+   period it was entered, as FAULT_OVER acknowledged at once, is not seen. The
+   counters are saturated, the totals wrap after 2^32 periods. */
+
+/* States counted, the highest value of MCI_State_t plus one */
+#define MC_STATE_STATS_NB_STATES    ((uint8_t)ADC_CALIBRATING + 1U)
+
+/* Statistics of a state */
+typedef struct
+{
+  uint32_t wTotalTicks;             /* Periods spent in the state since the reset */
+  uint16_t hEntries;                /* Entries in the state, saturated */
+  uint16_t hLastTicks;              /* Periods of the last residence, saturated */
+} MC_StateStats_Entry_t;
+
+/* Layout of MC_REG_STATE_STATS */
+typedef struct
+{
+  uint32_t wTransitions;            /* Changes of state since the reset */
+  uint16_t hTickRate;               /* Periods per second, MEDIUM_FREQUENCY_TASK_RATE */
+  uint8_t  bState;                  /* State of the last period */
+  uint8_t  bPrevState;              /* State before it */
+  MC_StateStats_Entry_t States[MC_STATE_STATS_NB_STATES];
+  uint16_t hSinceStart[MC_STATE_STATS_NB_STATES]; /* Periods from the last exit of IDLE
+                                                     to the last entry, saturated */
+} MC_StateStats_t;
+
+void MC_StateStats_Init(MCI_State_t State);
+void MC_StateStats_Exec(MCI_State_t State);
+void MC_StateStats_Reset(void);
+void MC_StateStats_Get(MC_StateStats_t *pStats);
+
+#endif /* MC_STATE_STATS_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
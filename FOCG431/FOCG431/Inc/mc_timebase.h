@@ -0,0 +1,76 @@
+/**
+  ******************************************************************************
+  * @file    mc_timebase.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   64-bit time base of the telemetry, in CPU cycles since the boot
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_TIMEBASE_H
+#define MC_TIMEBASE_H
+
+#include "mc_type.h"
+
+/* The time base is built when MC_TIMEBASE_MODE is added to the preprocessor symbols of
+   the build configuration. It has two rates:
+
+   - the tick, counted on 64 bits by the high frequency task at each FOC period, as
+     GLOBAL_TIMESTAMP, that only has 32 bits and wraps after a few days;
+   - the cycle counter of the DWT, read at each tick, that places a time between two
+     ticks with the resolution of the CPU clock.
+
+   MC_Time_Get() returns the ticks times MC_TIME_CYCLES_PER_TICK plus the cycles since
+   the last tick, so that the time is monotonic and does not wrap in the life of the
+   drive, while the 32-bit cycle counter wraps after 25 s at 170 MHz. The cycles since
+   the last tick are bounded by one tick: a tick late by the jitter of the high
+   frequency task or the reset of the cycle counter by a benchmark never makes the time
+   go backward. The origin of a tick is the end of its high frequency task.
+
+   The fault log and the capture stamp their events with it, MC_REG_TIME returns
+   MC_Time_Info_t. The datalog of MCPA keeps GLOBAL_TIMESTAMP, the low word of the
+   ticks, so that the format of its buffers is unchanged. */
+
+/* CPU cycles per second and per tick of the time base */
+#define MC_TIME_CYCLES_PER_SECOND  ((uint32_t)SYSCLK_FREQ)
+#define MC_TIME_CYCLES_PER_TICK    ((uint32_t)SYSCLK_FREQ / (uint32_t)TF_REGULATION_RATE)
+
+/* Time of the events that did not occur */
+#define MC_TIME_NONE               0U
+
+/* Time base at one instant */
+typedef struct
+{
+  uint32_t wTickLow;                /* Ticks since the boot */
+  uint32_t wTickHigh;
+  uint32_t wCycles;                 /* CPU cycles since the last tick, below MC_TIME_CYCLES_PER_TICK */
+} MC_Time_Stamp_t;
+
+/* Layout of MC_REG_TIME */
+typedef struct
+{
+  uint64_t dNow;                    /* Time of the answer, in CPU cycles since the boot */
+  uint64_t dCaptureTrigger;         /* Time of the trigger of the capture, MC_TIME_NONE if none */
+  uint32_t wCyclesPerSecond;        /* MC_TIME_CYCLES_PER_SECOND */
+  uint32_t wCyclesPerTick;          /* MC_TIME_CYCLES_PER_TICK */
+} MC_Time_Info_t;
+
+void MC_Time_Init(void);
+void MC_Time_Tick(void);
+void MC_Time_GetStamp(MC_Time_Stamp_t *pStamp);
+uint64_t MC_Time_Get(void);
+uint64_t MC_Time_FromStamp(const MC_Time_Stamp_t *pStamp);
+void MC_Time_GetInfo(MC_Time_Info_t *pInfo);
+
+#endif /* MC_TIMEBASE_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
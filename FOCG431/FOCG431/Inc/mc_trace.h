@@ -0,0 +1,155 @@
+/**
+  ******************************************************************************
+  * @file    mc_trace.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Debug trace points of the high frequency task
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_TRACE_H
+#define MC_TRACE_H
+
+#include "mc_type.h"
+#include "mc_perf.h"
+
+/* Every debug output of the high frequency task goes through these macros, so that
+   a build without DBG_MCU_LOAD_MEASURE, without DBG_DAC_OUTPUT and with
+   MC_TRACE_OUTPUT set to MC_TRACE_OFF in mc_stm_types.h carries none of them. */
+
+/* Outputs of the trace points, selected by MC_TRACE_OUTPUT */
+#define MC_TRACE_OFF   0   /* Compiled out */
+#define MC_TRACE_GPIO  1   /* One store in the BSRR register of the pin */
+#define MC_TRACE_ITM   2   /* One write in the ITM stimulus port, read over SWO */
+
+#ifndef MC_TRACE_OUTPUT
+#define MC_TRACE_OUTPUT MC_TRACE_OFF
+#endif
+
+/* Trace points: GPIO port, GPIO pin, ITM stimulus port */
+#define MC_TRACE_PCC_ENGAGED  GPIOA, GPIO_PIN_5, 1U   /* LD2, high while the PCC regulates */
+
+/* ITM stimulus port of the code sections timed by MC_Perf: the section number when it
+   starts, the section number with bit 7 set when it stops */
+#define MC_TRACE_SPAN_PORT    0U
+
+/* ITM stimulus ports of the events, only written by MC_TRACE_ITM: a pin cannot carry
+   their value */
+#define MC_TRACE_ISR_PORT     2U   /* MC_TRACE_ISR_xxx at the entry, with bit 7 set at the exit */
+#define MC_TRACE_MODE_PORT    3U   /* MC_TRACE_MODE_xxx of the output written in the period */
+#define MC_TRACE_VECTOR_PORT  4U   /* Switching state of a vector output, see MC_TRACE_VECTOR */
+#define MC_TRACE_FAULT_PORT   5U   /* Occurred faults, 16 bits, while the PWM is held off */
+
+/* Interrupts of the motor control */
+#define MC_TRACE_ISR_HF       1U   /* ADC, high frequency task */
+#define MC_TRACE_ISR_TIM_UP   2U   /* Update of the PWM timer */
+#define MC_TRACE_ISR_BRK      3U   /* Break of the PWM timer */
+#define MC_TRACE_ISR_SYSTICK  4U   /* Medium frequency and safety tasks */
+#define MC_TRACE_ISR_PENDSV   5U   /* Deferred duties of the high frequency task */
+
+/* Outputs of the current controller */
+#define MC_TRACE_MODE_PI          0U   /* PI voltage, space vector modulation */
+#define MC_TRACE_MODE_PCC         1U   /* PCC voltage, space vector modulation */
+#define MC_TRACE_MODE_PCC_VECTOR  2U   /* Finite set vector of the PCC */
+#define MC_TRACE_MODE_PCC_DWELL   3U   /* Two vertices of the hexagon and their dwell times */
+#define MC_TRACE_MODE_SIX_STEP    4U   /* Vertex held over the period */
+
+/* Nothing is written while the debugger has not enabled the stimulus port, and the
+   event is dropped rather than waiting for room in the ITM FIFO */
+static inline void MC_Trace_ITM(uint32_t wPort, uint8_t bData)
+{
+  if (((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0U) && ((ITM->TER & (1UL << wPort)) != 0U)
+      && (ITM->PORT[wPort].u32 != 0U))
+  {
+    ITM->PORT[wPort].u8 = bData;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+static inline void MC_Trace_ITM16(uint32_t wPort, uint16_t hData)
+{
+  if (((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0U) && ((ITM->TER & (1UL << wPort)) != 0U)
+      && (ITM->PORT[wPort].u32 != 0U))
+  {
+    ITM->PORT[wPort].u16 = hData;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+#if (MC_TRACE_OUTPUT == MC_TRACE_GPIO)
+#define MC_TRACE_LEVEL_(port, pin, stim, level) \
+  WRITE_REG((port)->BSRR, (true == (level)) ? (uint32_t)(pin) : ((uint32_t)(pin) << 16U))
+#elif (MC_TRACE_OUTPUT == MC_TRACE_ITM)
+#define MC_TRACE_LEVEL_(port, pin, stim, level)  MC_Trace_ITM((stim), (uint8_t)(level))
+#else
+#define MC_TRACE_LEVEL_(port, pin, stim, level)  ((void)0)
+#endif
+/* Drives trace point @p point to @p level, a bool */
+#define MC_TRACE_LEVEL(point, level)  MC_TRACE_LEVEL_(point, (level))
+
+#if (MC_TRACE_OUTPUT == MC_TRACE_ITM)
+#define MC_TRACE_SPAN_EVENT(code)  MC_Trace_ITM(MC_TRACE_SPAN_PORT, (uint8_t)(code))
+#else
+#define MC_TRACE_SPAN_EVENT(code)  ((void)0)
+#endif
+
+/* Start and stop of a MC_PERF_FUNCTIONS_LIST_t code section */
+#ifdef DBG_MCU_LOAD_MEASURE
+#define MC_TRACE_SPAN_START(section)                                  \
+  do {                                                                \
+    MC_TRACE_SPAN_EVENT(section);                                     \
+    MC_Perf_Measure_Start(&PerfTraces, (uint8_t)(section));           \
+  } while (0)
+#define MC_TRACE_SPAN_STOP(section)                                   \
+  do {                                                                \
+    MC_Perf_Measure_Stop(&PerfTraces, (uint8_t)(section));            \
+    MC_TRACE_SPAN_EVENT((uint32_t)(section) | 0x80U);                 \
+  } while (0)
+#else
+#define MC_TRACE_SPAN_START(section)  MC_TRACE_SPAN_EVENT(section)
+#define MC_TRACE_SPAN_STOP(section)   MC_TRACE_SPAN_EVENT((uint32_t)(section) | 0x80U)
+#endif
+
+/* Events of the interrupts and of the decisions of the current controller. The
+   vector carries the switching state in the low nibble and the second state of a
+   pair of dwell states in the high nibble, a single state being written in both. */
+#if (MC_TRACE_OUTPUT == MC_TRACE_ITM)
+#define MC_TRACE_ISR_ENTRY(isr)       MC_Trace_ITM(MC_TRACE_ISR_PORT, (uint8_t)(isr))
+#define MC_TRACE_ISR_EXIT(isr)        MC_Trace_ITM(MC_TRACE_ISR_PORT, (uint8_t)((uint32_t)(isr) | 0x80U))
+#define MC_TRACE_MODE(mode)           MC_Trace_ITM(MC_TRACE_MODE_PORT, (uint8_t)(mode))
+#define MC_TRACE_VECTOR(state0, state1)                               \
+  MC_Trace_ITM(MC_TRACE_VECTOR_PORT, (uint8_t)(((uint32_t)(state0) & 0xFU) | (((uint32_t)(state1) & 0xFU) << 4U)))
+#define MC_TRACE_FAULT(faults)        MC_Trace_ITM16(MC_TRACE_FAULT_PORT, (uint16_t)(faults))
+#else
+#define MC_TRACE_ISR_ENTRY(isr)       ((void)0)
+#define MC_TRACE_ISR_EXIT(isr)        ((void)0)
+#define MC_TRACE_MODE(mode)           ((void)0)
+#define MC_TRACE_VECTOR(state0, state1) ((void)0)
+#define MC_TRACE_FAULT(faults)        ((void)0)
+#endif
+
+/* Update of the debug DAC outputs */
+#ifdef DBG_DAC_OUTPUT
+#define MC_TRACE_DAC_EXEC()  DAC_Exec(&DAC_Handle)
+#else
+#define MC_TRACE_DAC_EXEC()  ((void)0)
+#endif
+
+#endif /* MC_TRACE_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -26,6 +26,9 @@
 #include "mcp.h"
 #include "aspep.h"
 #include "mcpa.h"
+#ifdef MC_USB_CDC_MODE
+#include "usb_cdc_aspep_driver.h"
+#endif
 
 #define USARTA USART2
 #define DMA_RX_A DMA2
@@ -36,12 +39,13 @@
 #define MCP_RX_IRQHandler_A DMA2_Channel2_IRQHandler
 #define MCP_USER_CALLBACK_MAX 2
 
-#define MCPA_OVER_UARTA_STREAM 10
-
 extern ASPEP_Handle_t aspepOverUartA;
 extern MCP_Handle_t MCP_Over_UartA;
 extern MCPA_Handle_t MCPA_UART_A;
 extern MCP_user_cb_t MCP_UserCallBack[MCP_USER_CALLBACK_MAX];
+#ifdef MC_USB_CDC_MODE
+extern CDCASPEP_Handle_t CDCASPEP_A;
+#endif
 #endif /* MCP_CONFIG_H */
 
 /************************ (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -32,10 +32,28 @@
 #define ADC_REFERENCE_VOLTAGE  3.30
 
 /************************* CONTROL FREQUENCIES & DELAIES **********************/
-#define TF_REGULATION_RATE 	(uint32_t) ((uint32_t)(PWM_FREQUENCY)/(REGULATION_EXECUTION_RATE))
+/* Loads of the compare values, and current samples, per PWM period */
+#ifdef PWM_DOUBLE_UPDATE
+#define PWM_UPDATES_PER_PERIOD  2U
+#else
+#define PWM_UPDATES_PER_PERIOD  1U
+#endif
+
+#define TF_REGULATION_RATE 	(uint32_t) (((uint32_t)(PWM_FREQUENCY)*PWM_UPDATES_PER_PERIOD)/(REGULATION_EXECUTION_RATE))
 
 /* TF_REGULATION_RATE_SCALED is TF_REGULATION_RATE divided by PWM_FREQ_SCALING to allow more dynamic */
-#define TF_REGULATION_RATE_SCALED (uint16_t) ((uint32_t)(PWM_FREQUENCY)/(REGULATION_EXECUTION_RATE*PWM_FREQ_SCALING))
+#define TF_REGULATION_RATE_SCALED (uint16_t) (((uint32_t)(PWM_FREQUENCY)*PWM_UPDATES_PER_PERIOD)/(REGULATION_EXECUTION_RATE*PWM_FREQ_SCALING))
+
+/* OBS_REGULATION_RATE is the execution rate of the speed and position sensors */
+#define OBS_REGULATION_RATE  (uint32_t) (TF_REGULATION_RATE/(OBSERVER_EXECUTION_RATE))
+#define OBS_REGULATION_RATE_SCALED (uint16_t) (TF_REGULATION_RATE_SCALED/(OBSERVER_EXECUTION_RATE))
+/* Execution rate of the speed and position sensors at a PWM frequency of Freq Hz, see mc_pwmfreq.h */
+#define SPD_MEAS_RATE_AT(Freq)  (((uint32_t)(Freq)*PWM_UPDATES_PER_PERIOD)/(REGULATION_EXECUTION_RATE*OBSERVER_EXECUTION_RATE))
+#define SPD_MEAS_RATE_SCALED_AT(Freq) (uint16_t) (((uint32_t)(Freq)*PWM_UPDATES_PER_PERIOD)/(REGULATION_EXECUTION_RATE*PWM_FREQ_SCALING*OBSERVER_EXECUTION_RATE))
+
+#if (OBSERVER_EXECUTION_RATE < 1) || (OBSERVER_EXECUTION_RATE > 255)
+#error "OBSERVER_EXECUTION_RATE must be between 1 and 255"
+#endif
 
 /* DPP_CONV_FACTOR is introduce to compute the right DPP with TF_REGULATOR_SCALED  */
 #define DPP_CONV_FACTOR (65536/PWM_FREQ_SCALING)
@@ -44,9 +62,18 @@
 #define CURRENT_CONV_FACTOR		((65536.0 * RSHUNT * AMPLIFICATION_GAIN)/ADC_REFERENCE_VOLTAGE)
 #define CURRENT_CONV_FACTOR_INV		(1.0 / ((65536.0 * RSHUNT * AMPLIFICATION_GAIN)/ADC_REFERENCE_VOLTAGE))
 
-#define REP_COUNTER 			(uint16_t) ((REGULATION_EXECUTION_RATE *2u)-1u)
+#define REP_COUNTER 			(uint16_t) ((REGULATION_EXECUTION_RATE *(2u/PWM_UPDATES_PER_PERIOD))-1u)
 
-#define SYS_TICK_FREQUENCY          ( uint16_t )2000U
+/* The medium frequency task is clocked by the SysTick, which follows a speed loop
+   faster than 2 kHz, and the position loop in the M1_POSITION_CTRL builds */
+#ifdef M1_POSITION_CTRL
+#define SCHED_TASK_FREQUENCY_HZ     ((POSITION_LOOP_FREQUENCY_HZ > SPEED_LOOP_FREQUENCY_HZ) ?\
+                                     (uint16_t)POSITION_LOOP_FREQUENCY_HZ : (uint16_t)SPEED_LOOP_FREQUENCY_HZ)
+#else
+#define SCHED_TASK_FREQUENCY_HZ     (uint16_t)SPEED_LOOP_FREQUENCY_HZ
+#endif
+#define SYS_TICK_FREQUENCY          ((SCHED_TASK_FREQUENCY_HZ > 2000U) ? (uint16_t)SCHED_TASK_FREQUENCY_HZ\
+                                                                   : (uint16_t)2000U)
 #define UI_TASK_FREQUENCY_HZ        10U
 #define SERIAL_COM_TIMEOUT_INVERSE  25U
 #define SERIAL_COM_ATR_TIME_MS      20U
@@ -70,20 +97,315 @@
 
 #define MAX_CURRENT (ADC_REFERENCE_VOLTAGE/(2*RSHUNT*AMPLIFICATION_GAIN))
 #define OBS_MINIMUM_SPEED_UNIT    (uint16_t) ((OBS_MINIMUM_SPEED_RPM*SPEED_UNIT)/U_RPM)
+#define PLL_GAIN_SCHEDULE_SPEED_UNIT (uint16_t) ((PLL_GAIN_SCHEDULE_SPEED_RPM*SPEED_UNIT)/U_RPM)
+#define FLYING_START_MIN_SPEED_UNIT (int16_t) ((FLYING_START_MIN_SPEED_RPM*SPEED_UNIT)/U_RPM)
+#define FLYING_START_CATCH_TICKS  (uint16_t) ((FLYING_START_CATCH_MS*MEDIUM_FREQUENCY_TASK_RATE)/1000)
+#define COAST_ENTRY_TICKS  (uint16_t) ((COAST_ENTRY_MS*MEDIUM_FREQUENCY_TASK_RATE)/1000)
+#define COAST_CATCH_TICKS  (uint16_t) ((COAST_CATCH_MS*MEDIUM_FREQUENCY_TASK_RATE)/1000)
+#define COAST_MAX_SPEED_UNIT (int16_t) ((COAST_MAX_SPEED_RPM*SPEED_UNIT)/U_RPM)
+/* Observer periods per medium frequency period, 8 fractional bits: the step of the
+   angle propagated while coasting */
+#define COAST_OBS_PERIODS_PER_TICK  (int32_t) ((OBS_REGULATION_RATE*256U)/MEDIUM_FREQUENCY_TASK_RATE)
+#if (COAST_ENABLING == ENABLE) && (FLYING_START_ENABLING != ENABLE)
+#error "COAST_ENABLING re-engages through the flying start, FLYING_START_ENABLING is required"
+#endif
 
 #define MAX_APPLICATION_SPEED_UNIT ((MAX_APPLICATION_SPEED_RPM*SPEED_UNIT)/U_RPM)
 #define MIN_APPLICATION_SPEED_UNIT ((MIN_APPLICATION_SPEED_RPM*SPEED_UNIT)/U_RPM)
 
 /************************* PLL PARAMETERS **************************/
-#define C1 (int32_t)((((int16_t)F1)*RS)/(LS*TF_REGULATION_RATE))
+#define C1 (int32_t)((((int16_t)F1)*RS)/(LS*OBS_REGULATION_RATE))
 #define C2 (int32_t) GAIN1
-#define C3 (int32_t)((((int16_t)F1)*MAX_BEMF_VOLTAGE)/(LS*MAX_CURRENT*TF_REGULATION_RATE))
+#define C3 (int32_t)((((int16_t)F1)*MAX_BEMF_VOLTAGE)/(LS*MAX_CURRENT*OBS_REGULATION_RATE))
 #define C4 (int32_t) GAIN2
-#define C5 (int32_t)((((int16_t)F1)*MAX_VOLTAGE)/(LS*MAX_CURRENT*TF_REGULATION_RATE))
+#define C5 (int32_t)((((int16_t)F1)*MAX_VOLTAGE)/(LS*MAX_CURRENT*OBS_REGULATION_RATE))
 
 #define PERCENTAGE_FACTOR    (uint16_t)(VARIANCE_THRESHOLD*128u)
+/* The index of the speed FIFO of the PLL observer wraps with a mask */
+_Static_assert((STO_FIFO_DEPTH_UNIT > 0) && (STO_FIFO_DEPTH_UNIT <= 64)
+               && ((STO_FIFO_DEPTH_UNIT & (STO_FIFO_DEPTH_UNIT - 1)) == 0),
+               "STO PLL: STO_FIFO_DEPTH_UNIT must be a power of two up to 64");
 #define HFI_MINIMUM_SPEED    (uint16_t) (HFI_MINIMUM_SPEED_RPM/6u)
 
+/******************** PREDICTIVE CURRENT CONTROL PARAMETERS *******************/
+/* Voltage applied by PWMC_SetPhaseVoltage for a vector of magnitude 32767, Volts */
+#define PCC_VECTOR_VOLTAGE_V  (NOMINAL_BUS_VOLTAGE_V / SQRT_3)
+
+/* Model coefficients for a divisor of 1: current step of one period for a vector of
+   magnitude 32768, and back-EMF current step of one period per dpp of speed */
+#define PCC_KVOLT_UNIT  ((CURRENT_CONV_FACTOR * PCC_VECTOR_VOLTAGE_V) / (LS * TF_REGULATION_RATE * 32768.0))
+#define PCC_KBEMF_UNIT  ((MOTOR_VOLTAGE_CONSTANT * SQRT_2 * 60.0 * CURRENT_CONV_FACTOR) /\
+                         (SQRT_3 * 1000.0 * POLE_PAIR_NUM * LS * 65536.0))
+
+/* Largest divisor exponent, up to 15, for which the coefficient k times the divisor
+   stays within PCC_COEF_MAX, -1 if k alone exceeds it. The products of such a
+   coefficient with any int16_t operand, or with a vertex of the hexagon, fit in 31 bits. */
+#define PCC_COEF_MAX  32768.0
+#define PCC_FIT_SHIFT(k) \
+  (((k) <= (PCC_COEF_MAX / 32768.0)) ? 15 : \
+   (((k) <= (PCC_COEF_MAX / 16384.0)) ? 14 : \
+    (((k) <= (PCC_COEF_MAX / 8192.0)) ? 13 : \
+     (((k) <= (PCC_COEF_MAX / 4096.0)) ? 12 : \
+      (((k) <= (PCC_COEF_MAX / 2048.0)) ? 11 : \
+       (((k) <= (PCC_COEF_MAX / 1024.0)) ? 10 : \
+        (((k) <= (PCC_COEF_MAX / 512.0)) ? 9 : \
+         (((k) <= (PCC_COEF_MAX / 256.0)) ? 8 : \
+          (((k) <= (PCC_COEF_MAX / 128.0)) ? 7 : \
+           (((k) <= (PCC_COEF_MAX / 64.0)) ? 6 : \
+            (((k) <= (PCC_COEF_MAX / 32.0)) ? 5 : \
+             (((k) <= (PCC_COEF_MAX / 16.0)) ? 4 : \
+              (((k) <= (PCC_COEF_MAX / 8.0)) ? 3 : \
+               (((k) <= (PCC_COEF_MAX / 4.0)) ? 2 : \
+                (((k) <= (PCC_COEF_MAX / 2.0)) ? 1 : \
+                 (((k) <= PCC_COEF_MAX) ? 0 : -1))))))))))))))))
+
+/* The decay coefficient, below 1, shares the divisor of PCC_KVOLT */
+#define PCC_COEF_DIV_LOG  PCC_FIT_SHIFT(PCC_KVOLT_UNIT)
+#define PCC_BEMF_DIV_LOG  PCC_FIT_SHIFT(PCC_KBEMF_UNIT)
+#define PCC_COEF_DIV      (double)(1L << PCC_COEF_DIV_LOG)
+#define PCC_BEMF_DIV      (double)(1L << PCC_BEMF_DIV_LOG)
+
+#ifdef PCC_EXACT_DISCRETISATION
+/* Zero order hold model, x = Rs Ts / Ls below 1: decay exp(-x), voltage gain
+   (1 - exp(-x)) / x and back-EMF gain exp(-x / 2) (1 + x^2 / 24), its speed
+   dependent part being applied by the PCC component. exp(-x) is its series up
+   to x^6, within 2^-12. */
+#define PCC_X              (RS / (LS * TF_REGULATION_RATE))
+#define PCC_EXP_NEG(x)     (1.0 - ((x) * (1.0 - (((x) / 2.0) * (1.0 - (((x) / 3.0) * (1.0 - (((x) / 4.0)\
+                            * (1.0 - (((x) / 5.0) * (1.0 - ((x) / 6.0))))))))))))
+#define PCC_ZOH_VOLT_GAIN  ((1.0 - PCC_EXP_NEG(PCC_X)) / PCC_X)
+#define PCC_ZOH_BEMF_GAIN  (PCC_EXP_NEG(PCC_X / 2.0) * (1.0 + ((PCC_X * PCC_X) / 24.0)))
+#define PCC_KDECAY (int32_t)(PCC_COEF_DIV * PCC_EXP_NEG(PCC_X))
+#define PCC_KVOLT  (int32_t)(PCC_COEF_DIV * PCC_KVOLT_UNIT * PCC_ZOH_VOLT_GAIN * PCC_STATE_VOLT_GAIN)
+#else
+#define PCC_KDECAY (int32_t)(PCC_COEF_DIV * (1.0 - (RS / (LS * TF_REGULATION_RATE))))
+#define PCC_KVOLT  (int32_t)(PCC_COEF_DIV * PCC_KVOLT_UNIT * PCC_STATE_VOLT_GAIN)
+#endif
+/* Bus voltage of PCC_KVOLT, u16Volts */
+#define PCC_NOMINAL_BUS_D  (uint16_t)(NOMINAL_BUS_VOLTAGE_V * FF_BUS_DIGITS_PER_V)
+#ifdef PCC_EXACT_DISCRETISATION
+#define PCC_KBEMF  (int32_t)(PCC_BEMF_DIV * PCC_KBEMF_UNIT * PCC_ZOH_BEMF_GAIN)
+#else
+#define PCC_KBEMF  (int32_t)(PCC_BEMF_DIV * PCC_KBEMF_UNIT)
+#endif
+
+/* Evaluated by the compiler from the floating point motor parameters. The decay
+   coefficient is only positive when the electrical time constant exceeds one period. */
+_Static_assert(PCC_COEF_DIV_LOG >= 0, "PCC: current step of one period too large for the coefficients");
+_Static_assert(PCC_BEMF_DIV_LOG >= 0, "PCC: back-EMF coefficient too large");
+_Static_assert(RS < (LS * TF_REGULATION_RATE), "PCC: electrical time constant shorter than the control period");
+
+#ifdef PCC_ADAPTIVE_PERIOD
+/* Models of the decision periods of n control periods, the ones above for n Ts. The
+   back-EMF coefficient is per dpp of the angle covered in the decision period. */
+#define PCC_COEF_DIV_LOG_N(n)  PCC_FIT_SHIFT(PCC_KVOLT_UNIT * (n))
+#define PCC_COEF_DIV_N(n)      (double)(1L << PCC_COEF_DIV_LOG_N(n))
+#define PCC_X_N(n)             ((RS * (n)) / (LS * TF_REGULATION_RATE))
+#ifdef PCC_EXACT_DISCRETISATION
+#define PCC_KDECAY_N(n) (int32_t)(PCC_COEF_DIV_N(n) * PCC_EXP_NEG(PCC_X_N(n)))
+#define PCC_KVOLT_N(n)  (int32_t)(PCC_COEF_DIV_N(n) * PCC_KVOLT_UNIT * PCC_STATE_VOLT_GAIN * (n) *\
+                                  ((1.0 - PCC_EXP_NEG(PCC_X_N(n))) / PCC_X_N(n)))
+#define PCC_KBEMF_N(n)  (int32_t)(PCC_BEMF_DIV * PCC_KBEMF_UNIT * PCC_EXP_NEG(PCC_X_N(n) / 2.0) *\
+                                  (1.0 + ((PCC_X_N(n) * PCC_X_N(n)) / 24.0)))
+#else
+#define PCC_KDECAY_N(n) (int32_t)(PCC_COEF_DIV_N(n) * (1.0 - PCC_X_N(n)))
+#define PCC_KVOLT_N(n)  (int32_t)(PCC_COEF_DIV_N(n) * PCC_KVOLT_UNIT * PCC_STATE_VOLT_GAIN * (n))
+#define PCC_KBEMF_N(n)  PCC_KBEMF
+#endif
+#define PCC_PERIOD_MODEL(n) {PCC_KDECAY_N(n), PCC_KVOLT_N(n), PCC_KBEMF_N(n),\
+                             (uint16_t)PCC_COEF_DIV_LOG_N(n), (uint16_t)PCC_BEMF_DIV_LOG}
+/* Decision periods of 1, 2 and 4 control periods */
+#define PCC_PERIOD_TABLE    {PCC_PERIOD_MODEL(1), PCC_PERIOD_MODEL(2), PCC_PERIOD_MODEL(4)}
+_Static_assert(PCC_COEF_DIV_LOG_N(4) >= 0, "PCC: current step of the decision period too large for the coefficients");
+_Static_assert((RS * 4) < (LS * TF_REGULATION_RATE), "PCC: electrical time constant shorter than the decision period");
+
+#define PCC_PERIOD_SPEED_BAND1_UNIT ((PCC_PERIOD_SPEED_BAND1_RPM*SPEED_UNIT)/U_RPM)
+#define PCC_PERIOD_SPEED_BAND2_UNIT ((PCC_PERIOD_SPEED_BAND2_RPM*SPEED_UNIT)/U_RPM)
+#define PCC_PERIOD_HYST_UNIT        ((PCC_PERIOD_HYST_RPM*SPEED_UNIT)/U_RPM)
+_Static_assert(PCC_PERIOD_SPEED_BAND2_RPM < PCC_PERIOD_SPEED_BAND1_RPM, "PCC: decision period bands not decreasing");
+#endif
+
+/* Phase voltage errors in digits of the vector table: 2/3 of a phase error is seen on its axis */
+#define PCC_PHASE_DIGITS_PER_V (2.0 * 32767.0 / (3.0 * PCC_VECTOR_VOLTAGE_V))
+#define PCC_SWITCH_DROP    (int16_t)(PCC_SWITCH_DROP_V * PCC_PHASE_DIGITS_PER_V)
+#define PCC_DIODE_DROP     (int16_t)(PCC_DIODE_DROP_V * PCC_PHASE_DIGITS_PER_V)
+#define PCC_DEADTIME_DROP  (int16_t)(((2.0 * 32767.0 / SQRT_3) * DEADTIME_NS * PWM_FREQUENCY * PWM_UPDATES_PER_PERIOD) / 1.0e9)
+
+#ifdef M1_ENCODER_SENSOR
+/* The encoder angle is valid from standstill */
+#define PCC_ENGAGE_SPEED_UNIT ((ENC_PCC_ENGAGE_SPEED_RPM*SPEED_UNIT)/U_RPM)
+#define PCC_DISENGAGE_SPEED_UNIT ((ENC_PCC_DISENGAGE_SPEED_RPM*SPEED_UNIT)/U_RPM)
+#else
+#define PCC_ENGAGE_SPEED_UNIT ((PCC_ENGAGE_SPEED_RPM*SPEED_UNIT)/U_RPM)
+#define PCC_DISENGAGE_SPEED_UNIT ((PCC_DISENGAGE_SPEED_RPM*SPEED_UNIT)/U_RPM)
+#endif
+
+#define PCC_FALLBACK_PERIODS  (uint16_t)((PCC_FALLBACK_MS * TF_REGULATION_RATE) / 1000U)
+#define PCC_RESIDUAL_LIMIT    (uint16_t)((PCC_RESIDUAL_LIMIT_PC * (int32_t)NOMINAL_CURRENT) / 100)
+_Static_assert((PCC_RESIDUAL_SHIFT >= 0) && (PCC_RESIDUAL_SHIFT <= 15), "PCC: residual mean out of 32 bits");
+#ifdef PCC_BLENDED_HANDOVER
+/* FOC periods of the blend of the current controllers, the switch over ramp */
+#define PCC_BLEND_PERIODS     (uint32_t)((TRANSITION_DURATION * TF_REGULATION_RATE) / 1000U)
+_Static_assert((PCC_BLEND_PERIODS > 0U) && (PCC_BLEND_PERIODS < (1UL << 17)), "PCC: blend of the controllers out of range");
+#endif
+#define PCC_DIST_GAIN         (uint16_t)(PCC_DIST_OBSERVER_GAIN * 32768.0)
+#ifdef PCC_STATE_FILTER
+#define PCC_STATE_GAIN        (uint16_t)(PCC_STATE_FILTER_GAIN * 32768.0)
+_Static_assert((PCC_STATE_GAIN > 0U) && (PCC_STATE_GAIN < 32768U), "PCC: gain of the current estimate out of ]0, 1[");
+#endif
+
+#define PCC_EST_MIN_SPEED_DPP (int16_t)((PCC_EST_MIN_SPEED_RPM * POLE_PAIR_NUM * 65536.0)/\
+                                        (60.0 * TF_REGULATION_RATE))
+#define PCC_EST_MIN_CURRENT   (int16_t)(PCC_EST_MIN_CURRENT_A * CURRENT_CONV_FACTOR)
+#define PCC_EST_UPDATE_PERIOD (uint16_t)((PCC_EST_UPDATE_PERIOD_MS * MEDIUM_FREQUENCY_TASK_RATE) / 1000U)
+#define TDR_STAGE_COEFF       (1.0 / (TDR_STAGE_TAU_S * MEDIUM_FREQUENCY_TASK_RATE))
+#define TDR_WINDING_COEFF     (1.0 / (TDR_WINDING_TAU_S * MEDIUM_FREQUENCY_TASK_RATE))
+#define LMN_LIGHT_LOAD_IQ     (int16_t)((LMN_LIGHT_LOAD_PC * (int32_t)NOMINAL_CURRENT) / 100)
+#define LMN_LOAD_BAND         (int16_t)((LMN_LOAD_BAND_PC * (int32_t)NOMINAL_CURRENT) / 100)
+#define LMN_MIN_SPEED_UNIT    ((LMN_MIN_SPEED_RPM*SPEED_UNIT)/U_RPM)
+#define LMN_ID_STEP           (int16_t)((LMN_ID_STEP_PC * (int32_t)NOMINAL_CURRENT) / 100)
+#define LMN_ID_MAX            (int16_t)((LMN_ID_MAX_PC * (int32_t)NOMINAL_CURRENT) / 100)
+#define LMN_SETTLE_PERIODS    (uint16_t)((LMN_SETTLE_MS * MEDIUM_FREQUENCY_TASK_RATE) / 1000U)
+#define LMN_AVG_PERIODS       (uint16_t)((LMN_AVG_MS * MEDIUM_FREQUENCY_TASK_RATE) / 1000U)
+_Static_assert((LMN_ID_STEP_PC > 0) && (LMN_ID_MAX_PC >= LMN_ID_STEP_PC), "LMN: step of the d current above its bound");
+_Static_assert(((LMN_AVG_MS * MEDIUM_FREQUENCY_TASK_RATE) / 1000U) > 0U, "LMN: averaging time below one medium frequency period");
+#define HCM_LEARN_SPEED_DPP   (int16_t)((HCM_LEARN_SPEED_RPM * POLE_PAIR_NUM * 65536.0)/\
+                                        (60.0 * TF_REGULATION_RATE))
+#define HCM_MIN_SPEED_DPP     (int16_t)((HCM_MIN_SPEED_RPM * POLE_PAIR_NUM * 65536.0)/\
+                                        (60.0 * TF_REGULATION_RATE))
+#define HCM_STEADY_BAND_UNIT  ((HCM_STEADY_BAND_RPM*SPEED_UNIT)/U_RPM)
+_Static_assert(HCM_LEARN_SPEED_DPP > 0, "HCM: speed of the table below one dpp");
+_Static_assert((HCM_MEAN_SHIFT > 0) && (HCM_MEAN_SHIFT <= 15) && (HCM_LEARN_SHIFT <= 15), "HCM: shifts out of range");
+#define SSM_MIN_SPEED_DPP     (int16_t)((SIX_STEP_MIN_SPEED_RPM * POLE_PAIR_NUM * 65536.0)/\
+                                        (60.0 * TF_REGULATION_RATE))
+#define SSM_EXIT_SPEED_DPP    (int16_t)((SIX_STEP_EXIT_SPEED_RPM * POLE_PAIR_NUM * 65536.0)/\
+                                        (60.0 * TF_REGULATION_RATE))
+#define SSM_ENTER_RATIO       (uint16_t)((SIX_STEP_ENTER_PC * 32768U) / 100U)
+#define SSM_EXIT_RATIO        (uint16_t)((SIX_STEP_EXIT_PC * 32768U) / 100U)
+#define SSM_ENTER_PERIODS     (uint16_t)((SIX_STEP_ENTER_MS * TF_REGULATION_RATE) / 1000U)
+_Static_assert((SIX_STEP_EXIT_PC < SIX_STEP_ENTER_PC) && (SIX_STEP_ENTER_PC <= 100), "SSM: exit voltage above the entry one");
+_Static_assert(SIX_STEP_EXIT_SPEED_RPM < SIX_STEP_MIN_SPEED_RPM, "SSM: exit speed above the entry one");
+_Static_assert((SIX_STEP_FILTER_SHIFT <= 15) && (SIX_STEP_HYST_SHIFT <= 15), "SSM: shifts out of range");
+#define PCC_STATS_PERIOD      (uint16_t)((PCC_STATS_WINDOW_MS * MEDIUM_FREQUENCY_TASK_RATE) / 1000U)
+#define PCC_VBUS_START_D      (uint16_t)(PCC_VBUS_START_V*65535/(ADC_REFERENCE_VOLTAGE/VBUS_PARTITIONING_FACTOR))
+_Static_assert(PCC_VBUS_START_V < OV_VOLTAGE_THRESHOLD_V, "PCC: braking limit above the overvoltage threshold");
+#define PCC_BRAKE_ID          (int16_t)((PCC_BRAKE_ID_PC * (int32_t)NOMINAL_CURRENT) / 100)
+#define PCC_LSAT_STEP         (int16_t)((PCC_LSAT_RANGE_PC * (int32_t)INT16_MAX) / (100 * ((int32_t)PCC_LSAT_POINTS - 1)))
+#define PCC_LSAT_KNEE         (int16_t)((PCC_LSAT_KNEE_PC * PCC_LSAT_RANGE_PC * (int32_t)INT16_MAX) / 10000)
+#define PCC_LSAT_DROP         (uint16_t)((PCC_LSAT_DROP_PC * (int32_t)PCC_LSAT_ONE) / 100)
+_Static_assert((PCC_LSAT_RANGE_PC > 0) && (PCC_LSAT_RANGE_PC <= 100), "PCC: inductance table outside the measurement range");
+_Static_assert((PCC_LSAT_DROP_PC >= 0) && (PCC_LSAT_DROP_PC <= 50), "PCC: inductance drop of the default table above one half");
+#define PCC_WEIGHT_SPEED_BAND1_UNIT ((PCC_WEIGHT_SPEED_BAND1_RPM*SPEED_UNIT)/U_RPM)
+#define PCC_WEIGHT_SPEED_BAND2_UNIT ((PCC_WEIGHT_SPEED_BAND2_RPM*SPEED_UNIT)/U_RPM)
+#define PCC_WEIGHT_IQ_BAND1   (int16_t)((PCC_WEIGHT_IQ_BAND1_PC * (int32_t)NOMINAL_CURRENT) / 100)
+#define PCC_WEIGHT_IQ_BAND2   (int16_t)((PCC_WEIGHT_IQ_BAND2_PC * (int32_t)NOMINAL_CURRENT) / 100)
+#define PCC_BARRIER_CURRENT   ((PCC_BARRIER_CURRENT_PC * (int32_t)NOMINAL_CURRENT) / 100)
+_Static_assert(PCC_BARRIER_CURRENT <= INT16_MAX, "PCC: barrier current above the current scale");
+#define PCC_MAX_CURR          ((PCC_MAX_CURRENT_PC * (int32_t)INT16_MAX) / 100)
+_Static_assert((PCC_MAX_CURRENT_PC >= 0) && (PCC_MAX_CURRENT_PC <= 100), "PCC: current constraint outside the measurement range");
+_Static_assert((0 == PCC_MAX_CURR) || (PCC_MAX_CURR >= PCC_BARRIER_CURRENT), "PCC: current constraint below the barrier");
+#if defined (PCC_OPEN_LOOP_START) && (PCC_MAX_CURRENT_PC == 0)
+#error "PCC_OPEN_LOOP_START requires the current constraint of PCC_MAX_CURRENT_PC"
+#endif
+#define PCC_TRIP_CURR         ((PCC_TRIP_CURRENT_PC * (int32_t)INT16_MAX) / 100)
+/* Saturation of the current error of the 32 bit costs: the error of a reversal of the q reference */
+#define PCC_COST_SAT_ERROR    (((2 * (int32_t)NOMINAL_CURRENT) > INT16_MAX) ? INT16_MAX : (2 * (int32_t)NOMINAL_CURRENT))
+_Static_assert((PCC_TRIP_CURRENT_PC >= 0) && (PCC_TRIP_CURRENT_PC <= 100), "PCC: phase current constraint outside the measurement range");
+/* Torque cost: magnet flux over Ld, from the back-EMF step of one period over the
+   angle of the period, LS being Lq, and Lq/Ld */
+#define PCC_FLUX_CURR         (int32_t)((PCC_KBEMF_UNIT * 32768.0) / (3.1416 * LD_LQ_RATIO))
+#define PCC_INDUCTANCE_RATIO  (uint16_t)(16384.0 / LD_LQ_RATIO)
+_Static_assert(LD_LQ_RATIO > 0.25, "PCC: Lq above four times Ld, out of the inductance ratio range");
+
+/****************************** ENCODER PARAMETERS ****************************/
+/* Auto-reload of the encoder timer, that counts the four edges of each line */
+#define M1_PULSE_NBR          ((4 * (M1_ENCODER_PPR)) - 1)
+#define ALIGNMENT_ANGLE_S16   ((int16_t)((ALIGNMENT_ANGLE_DEG * 65536U) / 360U))
+#define SENSORLESS_SWITCH_SPEED_UNIT ((SENSORLESS_SWITCH_SPEED_RPM*SPEED_UNIT)/U_RPM)
+#define SENSORLESS_SWITCH_BACK_UNIT  ((SENSORLESS_SWITCH_BACK_RPM*SPEED_UNIT)/U_RPM)
+
+/*************************** POSITION CONTROL PARAMETERS **********************/
+#if defined (M1_POSITION_CTRL) && !defined (M1_ENCODER_SENSOR)
+#error "M1_POSITION_CTRL requires M1_ENCODER_SENSOR"
+#endif
+#define POSITION_SAMPLING_TIME      (1.0f / (float)POSITION_LOOP_FREQUENCY_HZ)
+
+/****************************** HFI PARAMETERS ********************************/
+#ifdef M1_HFI_SENSOR
+#ifdef M1_ENCODER_SENSOR
+#error "M1_HFI_SENSOR and M1_ENCODER_SENSOR are two low speed sensors: only one can be defined"
+#endif
+#if (SENSORLESS_SWITCH_SPEED_RPM == 0)
+#error "M1_HFI_SENSOR requires the observer above SENSORLESS_SWITCH_SPEED_RPM"
+#endif
+#if (HFI_HALF_PERIOD < 2) || ((2 * HFI_HALF_PERIOD) > 8)
+#error "HFI_HALF_PERIOD must be 2 to 4 FOC periods"
+#endif
+_Static_assert(LD_LQ_RATIO < 1.0, "HFI: the motor is not salient, Ld must be smaller than Lq");
+#endif
+#define HFI_INJ_VOLTAGE       (int16_t)((HFI_INJECTION_VOLTAGE_V * 32767.0 * SQRT_3) / NOMINAL_BUS_VOLTAGE_V)
+/* d and q current changes of one FOC period of the carrier, d at zero angle error
+   and q per radian of twice the angle error */
+#define HFI_D_STEP            ((HFI_INJECTION_VOLTAGE_V * CURRENT_CONV_FACTOR) / (LS * LD_LQ_RATIO * TF_REGULATION_RATE))
+#define HFI_Q_STEP            ((HFI_INJECTION_VOLTAGE_V * CURRENT_CONV_FACTOR * ((1.0 / LD_LQ_RATIO) - 1.0)) /\
+                               (2.0 * LS * TF_REGULATION_RATE))
+/* Share of the FOC periods demodulated, the ones where the carrier toggles are not */
+#define HFI_ACTIVE_SHARE      ((HFI_HALF_PERIOD - 1.0) / HFI_HALF_PERIOD)
+/* s16 degrees per digit of demodulated q current of one observer period, Q4 */
+#define HFI_ERROR_GAIN        (int16_t)((65536.0 * 16.0) / (4.0 * 3.1416 * HFI_Q_STEP * HFI_ACTIVE_SHARE * OBSERVER_EXECUTION_RATE) + 0.5)
+#define HFI_MIN_D_RESPONSE    (int16_t)(0.25 * HFI_ACTIVE_SHARE * HFI_D_STEP)
+/* Critically damped PLL, from the angle error in s16 degrees to the speed in dpp */
+#define HFI_PLL_KPDIV         16384
+#define HFI_PLL_KPDIV_LOG     LOG2((16384))
+#define HFI_PLL_KIDIV         32768
+#define HFI_PLL_KIDIV_LOG     LOG2((32768))
+#define HFI_PLL_KP_GAIN       (int16_t)((2.0 * 3.1416 * HFI_PLL_BANDWIDTH_HZ * HFI_PLL_KPDIV) / OBS_REGULATION_RATE)
+#define HFI_PLL_KI_GAIN       (int16_t)((3.1416 * 3.1416 * HFI_PLL_BANDWIDTH_HZ * HFI_PLL_BANDWIDTH_HZ * HFI_PLL_KIDIV) /\
+                                        ((float)OBS_REGULATION_RATE * (float)OBS_REGULATION_RATE))
+#define HFI_LOCK_TICKS        (uint16_t)((HFI_LOCK_MS * MEDIUM_FREQUENCY_TASK_RATE) / 1000U)
+#define HFI_PULSE_TICKS       (uint16_t)((HFI_POLARITY_MS * MEDIUM_FREQUENCY_TASK_RATE) / 1000U)
+
+/************************** FEED FORWARD PARAMETERS ***************************/
+/* Torque constant of the motor, Nm per A peak */
+#define MOTOR_TORQUE_CONSTANT (MOTOR_VOLTAGE_CONSTANT * 1.2247 * 60.0 / (2000.0 * 3.1416))
+/* Iq digits of an acceleration of one SPEED_UNIT per speed loop period */
+#define SPEED_ACC_FF_GAIN     (int32_t)((SPEED_ACC_FF_INERTIA_KGM2 * 2.0 * 3.1416 * MEDIUM_FREQUENCY_TASK_RATE *\
+                                         CURRENT_CONV_FACTOR) / (SPEED_UNIT * MOTOR_TORQUE_CONSTANT))
+/* SPEED_UNIT gained in one speed loop period at NOMINAL_CURRENT, with the nominal inertia */
+#define SPEED_MPC_TORQUE_TERM ((MOTOR_TORQUE_CONSTANT * NOMINAL_CURRENT * SPEED_UNIT) /\
+                               (CURRENT_CONV_FACTOR * 2.0 * 3.1416 * SPEED_MPC_INERTIA_KGM2 *\
+                                MEDIUM_FREQUENCY_TASK_RATE))
+#define SPEED_MPC_EST_MIN_SPEED_UNIT ((SPEED_MPC_EST_MIN_SPEED_RPM*SPEED_UNIT)/U_RPM)
+/* Iq digits of an acceleration of one SPEED_UNIT per speed loop period, with the
+   inertia of the load torque observer */
+#define LTO_IQ_PER_ACC        ((LOAD_OBS_INERTIA_KGM2 * 2.0 * 3.1416 * MEDIUM_FREQUENCY_TASK_RATE *\
+                                CURRENT_CONV_FACTOR) / (SPEED_UNIT * MOTOR_TORQUE_CONSTANT))
+/* 1 - pole of the observer, per speed loop period */
+#define LTO_POLE_STEP         ((2.0 * 3.1416 * LOAD_OBS_BANDWIDTH_HZ) / MEDIUM_FREQUENCY_TASK_RATE)
+#define LTO_SPEED_PER_IQ      (int32_t)(65536.0 / LTO_IQ_PER_ACC)
+#define LTO_SPEED_GAIN        (uint16_t)(LTO_POLE_STEP * (2.0 - LTO_POLE_STEP) * 32768.0)
+#define LTO_LOAD_GAIN         (int32_t)(LTO_POLE_STEP * LTO_POLE_STEP * LTO_IQ_PER_ACC * 65536.0)
+#define LTO_FF_GAIN           (uint16_t)((LOAD_OBS_FF_PC * 32768U) / 100U)
+#define LTO_MAX_LOAD          (int16_t)((LOAD_OBS_MAX_PC * (int32_t)NOMINAL_CURRENT) / 100)
+_Static_assert((LOAD_OBS_BANDWIDTH_HZ * 13) < MEDIUM_FREQUENCY_TASK_RATE, "LTO: bandwidth above the speed loop frequency / 13");
+_Static_assert((LOAD_OBS_FF_PC <= 100) && (LOAD_OBS_MAX_PC <= 100), "LTO: shares above 100 %");
+_Static_assert(((2 * SPEED_FILTER_NOTCH_HZ) < MEDIUM_FREQUENCY_TASK_RATE)
+               && ((2 * SPEED_FILTER_LOW_PASS_HZ) < MEDIUM_FREQUENCY_TASK_RATE), "SFB: filter above half the speed loop frequency");
+#if defined (LOAD_TORQUE_OBSERVER) && (SPEED_CONTROLLER == SPD_CTRL_MPC)
+#error "LOAD_TORQUE_OBSERVER requires SPD_CTRL_PI: the model of SPD_CTRL_MPC already estimates the load"
+#endif
+/* Digits of VBS_GetAvBusVoltage_d() per Volt of bus */
+#define FF_BUS_DIGITS_PER_V   (65536.0 * VBUS_PARTITIONING_FACTOR / ADC_REFERENCE_VOLTAGE)
+/* Rate of the speed sensor: SPD_GetElSpeedDpp() returns dpp per period of this rate */
+#define FF_SPEED_RATE         OBS_REGULATION_RATE
+/* Constants of FF_VqdffComputation(), for the w*Lq*Iq, w*Ld*Id and w*Psi terms */
+#define CONSTANT1_Q  (int32_t)(((3.1416 / 4.0) * FF_SPEED_RATE * LS * SQRT_3 * 32767.0 * FF_BUS_DIGITS_PER_V)/\
+                               CURRENT_CONV_FACTOR)
+#define CONSTANT1_D  (int32_t)(((3.1416 / 4.0) * FF_SPEED_RATE * LS * LD_LQ_RATIO * SQRT_3 * 32767.0 *\
+                               FF_BUS_DIGITS_PER_V) / CURRENT_CONV_FACTOR)
+#define CONSTANT2_QD (int32_t)((FF_SPEED_RATE * MOTOR_VOLTAGE_CONSTANT * SQRT_2 * 60.0 * 32767.0 *\
+                                FF_BUS_DIGITS_PER_V) / (1000.0 * POLE_PAIR_NUM * 65536.0 * 32.0))
+
 #define MAX_APPLICATION_SPEED_UNIT2 ((MAX_APPLICATION_SPEED_RPM2*SPEED_UNIT)/_RPM)
 #define MIN_APPLICATION_SPEED_UNIT2 ((MIN_APPLICATION_SPEED_RPM2*SPEED_UNIT)/_RPM)
 
@@ -93,6 +415,9 @@
 #define UNDERVOLTAGE_THRESHOLD_d  (uint16_t)((UD_VOLTAGE_THRESHOLD_V*65535)/\
                                   ((uint16_t)(ADC_REFERENCE_VOLTAGE/\
                                                            VBUS_PARTITIONING_FACTOR)))
+#define INRUSH_CURRLIMIT_SETTLE_d (uint16_t)((INRUSH_CURRLIMIT_SETTLE_V*65535)/\
+                                  ((uint16_t)(ADC_REFERENCE_VOLTAGE/\
+                                                           VBUS_PARTITIONING_FACTOR)))
 #define INT_SUPPLY_VOLTAGE          (uint16_t)(65536/ADC_REFERENCE_VOLTAGE)
 
 #define DELTA_TEMP_THRESHOLD        (OV_TEMPERATURE_THRESHOLD_C- T0_C)
@@ -104,7 +429,8 @@
 #define OV_TEMPERATURE_HYSTERESIS_d  (DELTA_V_HYSTERESIS*INT_SUPPLY_VOLTAGE)
 
 /*************** Timer for PWM generation & currenst sensing parameters  ******/
-#define PWM_PERIOD_CYCLES (uint16_t)((ADV_TIM_CLK_MHz*(uint32_t)1000000u/((uint32_t)(PWM_FREQUENCY)))& ( uint16_t )0xFFFE)
+#define PWM_PERIOD_CYCLES_AT(Freq) (uint16_t)((ADV_TIM_CLK_MHz*(uint32_t)1000000u/((uint32_t)(Freq)))& ( uint16_t )0xFFFE)
+#define PWM_PERIOD_CYCLES PWM_PERIOD_CYCLES_AT(PWM_FREQUENCY)
 
 #define DEADTIME_NS  HW_DEAD_TIME_NS
 
@@ -131,15 +457,73 @@
 /**********************/
 /* MOTOR 1 ADC Timing */
 /**********************/
-#define SAMPLING_TIME ((ADC_SAMPLING_CYCLES * ADV_TIM_CLK_MHz) / ADC_CLK_MHz) /* In ADV_TIMER CLK cycles*/
+/* Conversions added after the first one by the oversampling of the injected conversions */
+#define ADC_INJ_OVS_CYCLES ((ADC_INJ_OVERSAMPLING - 1) * (ADC_SAMPLING_CYCLES + ADC_SAR_CYCLES))
+#define SAMPLING_TIME (((ADC_SAMPLING_CYCLES + ADC_INJ_OVS_CYCLES) * ADV_TIM_CLK_MHz) / ADC_CLK_MHz) /* In ADV_TIMER CLK cycles*/
 #define TRISE ((TRISE_NS * ADV_TIM_CLK_MHz)/1000uL)
 #define TDEAD ((uint16_t)((DEADTIME_NS * ADV_TIM_CLK_MHz)/1000))
 #define TNOISE ((uint16_t)((TNOISE_NS*ADV_TIM_CLK_MHz)/1000))
 #define HTMIN 1 /* Required for main.c compilation only, CCR4 is overwritten at runtime */
-#define TW_BEFORE ((uint16_t)((ADC_TRIG_CONV_LATENCY_CYCLES + ADC_SAMPLING_CYCLES) * ADV_TIM_CLK_MHz) / ADC_CLK_MHz  + 1u)
+#define TW_BEFORE ((uint16_t)((ADC_TRIG_CONV_LATENCY_CYCLES + ADC_SAMPLING_CYCLES + ADC_INJ_OVS_CYCLES) * ADV_TIM_CLK_MHz) / ADC_CLK_MHz  + 1u)
 #define TW_BEFORE_R3_1 ((uint16_t)((ADC_TRIG_CONV_LATENCY_CYCLES + ADC_SAMPLING_CYCLES*2 + ADC_SAR_CYCLES) * ADV_TIM_CLK_MHz) / ADC_CLK_MHz  + 1u)
 #define TW_AFTER ((uint16_t)(((DEADTIME_NS+MAX_TNTR_NS)*ADV_TIM_CLK_MHz)/1000UL))
+/* TW_BEFORE of a sampling time of the current channels given in halves of ADC clock cycles */
+#define TW_BEFORE_SMP(SmpX2) ((uint16_t)(((((uint32_t)(2 * ADC_TRIG_CONV_LATENCY_CYCLES) + (SmpX2) \
+                               + ((ADC_INJ_OVERSAMPLING - 1U) * ((SmpX2) + (uint32_t)(2 * ADC_SAR_CYCLES)))) \
+                               * (uint32_t)(ADV_TIM_CLK_MHz)) / (2U * (uint32_t)(ADC_CLK_MHz))) + 1U))
+/* Single shunt: shortest window of the bus current, also the shortest distance between
+   the two triggers of the PWM period */
+#define TW_MIN ((uint16_t)(TW_AFTER + TW_BEFORE))
+/* Compare value of the high side phases of a switching state: sqrt(3)/2 of the half PWM period,
+   shortened if needed to leave TW_AFTER before the sampling point in the middle of the period
+   and TW_BEFORE after it */
+#define STATE_HIGH_CNT_SQRT3_AT(Period) ((uint16_t)(((uint32_t)(Period) * 28378UL) >> 16))
+#define STATE_HIGH_CNT_SQRT3 STATE_HIGH_CNT_SQRT3_AT(PWM_PERIOD_CYCLES)
+/* PWM_DOUBLE_UPDATE: half width of the window of the low sides around the underflow, the
+   compare values of the high side phases being shifted by it */
+#if defined (PWM_DOUBLE_UPDATE) && (defined (SINGLE_SHUNT) || defined (ICS_SENSORS))
+#error "PWM_DOUBLE_UPDATE samples the three shunts in the windows of the low sides"
+#endif
+#ifdef PWM_DOUBLE_UPDATE
+#define PWM_VALLEY_CNT ((uint16_t)(((TW_AFTER > TW_BEFORE) ? TW_AFTER : TW_BEFORE) + 1U))
+#else
+#define PWM_VALLEY_CNT 0U
+#endif
+#define STATE_HIGH_CNT_WINDOW_AT(Period) ((uint16_t)(((Period) / 2U) - ((TW_AFTER > TW_BEFORE) ? TW_AFTER : TW_BEFORE) - 1U \
+                                          - PWM_VALLEY_CNT))
+#define STATE_HIGH_CNT_WINDOW STATE_HIGH_CNT_WINDOW_AT(PWM_PERIOD_CYCLES)
+#if defined (ICS_SENSORS)
+/* Isolated sensors: sampling instants in timer counts from the update event, in the middle of
+   the high side phases. The modulated periods are sampled in the middle of the zero vector. An
+   active switching state is sampled at the beginning of its period, once the commutations of the
+   update have settled and the update interrupt has armed the trigger (ICS_TRIG_ARM, 1 us), so that
+   the predictive controller gets the currents of its period boundary and the whole period to
+   compute. The sensors need no low side window, a switching state keeps sqrt(3)/2 */
+#define ICS_TRIG_ARM ((uint16_t)ADV_TIM_CLK_MHz)
+#define ICS_SAMPLING_POINT_AT(Period) ((uint16_t)(((Period) / 2U) - 1U))
+#define ICS_SAMPLING_POINT ICS_SAMPLING_POINT_AT(PWM_PERIOD_CYCLES)
+#define ICS_SAMPLING_POINT_STATE ((uint16_t)(TW_AFTER + ICS_TRIG_ARM))
+#define STATE_HIGH_CNT_AT(Period) STATE_HIGH_CNT_SQRT3_AT(Period)
+#else
+#define STATE_HIGH_CNT_AT(Period) ((STATE_HIGH_CNT_SQRT3_AT(Period) < STATE_HIGH_CNT_WINDOW_AT(Period)) \
+                                   ? STATE_HIGH_CNT_SQRT3_AT(Period) : STATE_HIGH_CNT_WINDOW_AT(Period))
+#endif
+#define STATE_HIGH_CNT STATE_HIGH_CNT_AT(PWM_PERIOD_CYCLES)
+/* Voltage of the active switching states of PCC_FINITE_SET per unit of their vector, the high
+   sides being on for STATE_HIGH_CNT instead of sqrt(3)/2 of the half period. Evaluated where
+   PCC_KVOLT is used, with pcc.h */
+#define PCC_STATE_VOLT_GAIN_AT(Period) ((PCC_OUTPUT_MODE == PCC_FINITE_SET) \
+                                        ? ((double)STATE_HIGH_CNT_AT(Period) / (double)STATE_HIGH_CNT_SQRT3_AT(Period)) \
+                                        : 1.0)
+#define PCC_STATE_VOLT_GAIN PCC_STATE_VOLT_GAIN_AT(PWM_PERIOD_CYCLES)
 #define MAX_TWAIT ((uint16_t)((TW_AFTER - SAMPLING_TIME)/2))
+/* Bootstrap refresh: FOC periods of a high side on over the whole period before its low side is
+   turned on, and lowering of the compare values that turns it on for BOOT_REFRESH_LOW_NS past
+   the dead time */
+#define BOOT_REFRESH_PERIODS_AT(RegRate) ((uint16_t)((BOOT_REFRESH_MAX_HIGH_US * (uint32_t)(RegRate)) / 1000000UL))
+#define BOOT_REFRESH_PERIODS BOOT_REFRESH_PERIODS_AT(TF_REGULATION_RATE)
+#define BOOT_REFRESH_CNT ((uint16_t)(((BOOT_REFRESH_LOW_NS + DEADTIME_NS) * ADV_TIM_CLK_MHz) / 2000UL))
+_Static_assert(((BOOT_REFRESH_MAX_HIGH_US * (uint32_t)TF_REGULATION_RATE) / 1000000UL) > 0U, "Bootstrap refresh: high side time below one FOC period");
 
 /* USER CODE BEGIN temperature */
 
@@ -150,6 +534,10 @@
 
 #define PQD_CONVERSION_FACTOR (int32_t)(( 1000 * 3 * ADC_REFERENCE_VOLTAGE ) /\
              ( 1.732 * RSHUNT * AMPLIFICATION_GAIN ))
+/* Copper losses, in mW, of a squared alpha/beta current magnitude of 65536 squared digits */
+#define PQD_COPPER_LOSS_FACTOR (int32_t)(1500 * RS *\
+             ( ADC_REFERENCE_VOLTAGE / ( RSHUNT * AMPLIFICATION_GAIN )) *\
+             ( ADC_REFERENCE_VOLTAGE / ( RSHUNT * AMPLIFICATION_GAIN )))
 
 /****** Prepares the UI configurations according the MCconfxx settings ********/
 
@@ -188,6 +576,10 @@
 #define DOUT_ACTIVE_LOW    DOutputActiveLow
 
 #define LPF_FILT_CONST ((int16_t)(32767 * 0.5))
+/* Flux weakening average voltage filter, in FOC periods */
+#define M1_VQD_SW_FILTER_BW_FACTOR      128u
+#define M1_VQD_SW_FILTER_BW_FACTOR_LOG  LOG2((M1_VQD_SW_FILTER_BW_FACTOR))
+
 /* MMI Table Motor 1 MAX_MODULATION_95_PER_CENT */
 #define MAX_MODULE 31128
 
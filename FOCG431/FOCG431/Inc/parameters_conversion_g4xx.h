@@ -36,12 +36,27 @@
 #define HALL_TIM_CLK    170000000uL
 
 /*************************  IRQ Handler Mapping  *********************/
+#define SPD_TIM_M1_IRQHandler TIM2_IRQHandler
 #define TIMx_UP_M1_IRQHandler TIM1_UP_TIM16_IRQHandler
 
 #define TIMx_BRK_M1_IRQHandler TIM1_BRK_TIM15_IRQHandler
 
+/*************************  Regular conversions scan  ****************/
+/* DMA channels of the regular conversion manager, one per scanned ADC in the order of
+   the first registration on each ADC. The MCP link uses the channels 2 and 3 of DMA2 */
+#define RCM_DMA                DMA1
+#define RCM_DMA_CLOCK          (LL_AHB1_GRP1_PERIPH_DMA1 | LL_AHB1_GRP1_PERIPH_DMAMUX1)
+#define RCM_DMA_CHANNEL_SCAN1  LL_DMA_CHANNEL_1
+#define RCM_DMA_CHANNEL_SCAN2  LL_DMA_CHANNEL_4
+
 #define ADC_TRIG_CONV_LATENCY_CYCLES 3.5
 #define ADC_SAR_CYCLES 12.5
+/* Twice the ADC clock cycles of the sampling times 2.5 to 640.5 of the SMPR registers */
+#define ADC_SMP_CYCLES_X2 {5U, 13U, 25U, 49U, 95U, 185U, 495U, 1281U}
+
+#if (ADC_INJ_OVERSAMPLING != 1) && (ADC_INJ_OVERSAMPLING != 2) && (ADC_INJ_OVERSAMPLING != 4)
+#error "ADC_INJ_OVERSAMPLING must be 1, 2 or 4"
+#endif
 
 #define M1_VBUS_SW_FILTER_BW_FACTOR     6u
 
@@ -124,9 +139,19 @@
 #define COMP7_NonInvertingInput_PC1    LL_COMP_INPUT_PLUS_IO2
 #define COMP7_NonInvertingInput_PA0    LL_COMP_INPUT_PLUS_IO1
 
-#define MCP_RX_SYNC_PAYLOAD_MAX 256U
-#define MCP_TX_SYNC_PAYLOAD_MAX 256U
-#define MCP_TX_ASYNC_PAYLOAD_MAX_A 2048U
+/* Payloads of the MCP link */
+#include "mc_ram_budget.h"
+
+/* Baud rate of the MCP link over UART_A, up to 6 Mbit/s. The Motor Control Workbench or the
+   Motor Pilot must be set to the same rate. Above the kernel clock of the USART divided by 16,
+   the USART oversamples by 8 */
+#define MCP_UART_BAUDRATE_A     1843200U
+#define MCP_UART_CLOCK_A        SYSCLK_FREQ /* USART2 is clocked by PCLK1, equal to SYSCLK_FREQ */
+#define MCP_UART_OVERSAMPLING_A ((MCP_UART_BAUDRATE_A > (MCP_UART_CLOCK_A / 16U)) ? UART_OVERSAMPLING_8 \
+                                                                                : UART_OVERSAMPLING_16)
+#if (MCP_UART_BAUDRATE_A > 6000000U) || (MCP_UART_BAUDRATE_A > (MCP_UART_CLOCK_A / 8U))
+#error "MCP_UART_BAUDRATE_A is out of the range of the USART"
+#endif
 
 /* USER CODE BEGIN Additional parameters */
 
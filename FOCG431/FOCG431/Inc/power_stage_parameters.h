@@ -34,6 +34,15 @@
                                                          by HW if low side signals
                                                          are not used */
 
+/*********** Bootstrap refresh, PWMC_BOOT_REFRESH *********/
+#define BOOT_REFRESH_MAX_HIGH_US      1000 /*!< Longest time a high side
+                                                         stays on without its low
+                                                         side */
+#define BOOT_REFRESH_LOW_NS           500 /*!< Low side on time that
+                                                         recharges a bootstrap
+                                                         capacitor, past the dead
+                                                         time */
+
 /*********** Bus voltage sensing section ****************/
 #define VBUS_PARTITIONING_FACTOR      0.0522 /*!< It expresses how
                                                        much the Vbus is attenuated
@@ -42,6 +51,15 @@
 #define NOMINAL_BUS_VOLTAGE_V         11
 /******** Current reading parameters section ******/
 /*** Topology ***/
+/* SINGLE_SHUNT instead, for a board with the only shunt in the DC link: the
+   R1_G4XX_pwm_curr_fdbk component reads the currents.
+   ICS_SENSORS instead, for isolated current sensors on phases A and B: the
+   ICS_G4XX_pwm_curr_fdbk component samples them simultaneously with ADC1 and
+   ADC2, RSHUNT is then 1 and AMPLIFICATION_GAIN the gain of the sensors in V/A.
+   THREE_SHUNT_INTERNAL_OPAMPS in addition, for a board with the shunts amplified by
+   the internal OPAMP1 and OPAMP2 in standalone mode, with the external gain network
+   of the ESC G4 board: ADC1 and ADC2 convert their outputs on channel 3 and
+   R3_2_G4XX_pwm_curr_fdbk switches their non inverting inputs at each sector */
 #define THREE_SHUNT_INDEPENDENT_RESOURCES
 
 #define RSHUNT                        0.33000
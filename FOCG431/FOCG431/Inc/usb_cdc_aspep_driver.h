@@ -0,0 +1,117 @@
+/**
+  ******************************************************************************
+  * @file    usb_cdc_aspep_driver.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   ASPEP physical layer over the USB device, as a CDC virtual COM port
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef USB_CDC_ASPEP_DRIVER_H
+#define USB_CDC_ASPEP_DRIVER_H
+
+#include "main.h"
+#include "aspep.h"
+
+/* The USB link is built when MC_USB_CDC_MODE is added to the preprocessor symbols of
+   the build configuration. It replaces the USART of aspepOverUartA: the ASPEP packets,
+   the MCP commands and the MCPA datalog are unchanged, and the host opens the virtual
+   COM port of the drive as it opens the one of the ST-LINK, while the full speed bulk
+   endpoints carry about five times the datalog of the USART at MCP_UART_BAUDRATE_A.
+
+   - the device has a single CDC ACM function, the class driver of the host is used
+     without any vendor driver. The line coding is kept for the host but not applied;
+   - the USB interrupt, at MC_IRQ_PRIO_COMM as the USART one, runs the HAL PCD driver
+     and the transfers requested by ASPEP: the sends and receives requested by the
+     medium frequency task or the high frequency task only pend it, so that the
+     registers of the USB peripheral are never written at two priorities;
+   - the buffers of ASPEP are given to the PCD driver as they are: the async ring is
+     copied to the double buffered IN endpoint packet by packet, while the host reads
+     the other half. A transfer of a multiple of 64 bytes ends with a zero length packet;
+   - the OUT endpoint is only armed again once the bytes of the last packet are taken
+     by the receives of ASPEP, the host being held by NAKs meanwhile. The resync of
+     ASPEP after a bad header drops the rest of the last packet;
+   - until the host configures the device, and after a bus reset, the packets sent
+     are dropped, so that the async ring of ASPEP never waits for an absent host.
+
+   The USB clock is the HSI48, trimmed on the start of frame of the host by the CRS. */
+
+/* Identification of the device */
+#ifndef CDCASPEP_VID
+#define CDCASPEP_VID            0x0483U   /* STMicroelectronics */
+#endif
+#ifndef CDCASPEP_PID
+#define CDCASPEP_PID            0x5740U   /* Virtual COM port */
+#endif
+
+/* Max packet size of the full speed bulk endpoints */
+#define CDCASPEP_PACKET_SIZE    64U
+
+/* Line coding of the virtual COM port, returned to the host as set */
+#define CDCASPEP_LINE_CODING_SIZE 7U
+
+/* Stages of the transfers of the control endpoint */
+typedef enum
+{
+  CDCASPEP_EP0_IDLE,
+  CDCASPEP_EP0_DATA_IN,             /* Answer sent to the host */
+  CDCASPEP_EP0_DATA_OUT,            /* Data of a class request received */
+  CDCASPEP_EP0_STATUS_IN,
+  CDCASPEP_EP0_STATUS_OUT
+} CDCASPEP_Ep0Stage_t;
+
+typedef struct
+{
+  ASPEP_Handle_t *pASPEP;           /* Transport layer notified of the transfers */
+  PCD_HandleTypeDef PCD;
+
+  /* Send requested by ASPEP, started by the USB interrupt */
+  uint8_t *pTxData;
+  uint16_t hTxLength;
+  volatile bool TxRequest;          /* Raised last by CDCASPEP_SEND_PACKET */
+  bool TxBusy;                      /* Transfer on the IN endpoint */
+  bool TxZlp;                       /* Zero length packet due at the end of the transfer */
+
+  /* Receive requested by ASPEP, filled by the USB interrupt */
+  uint8_t * volatile pRxTarget;     /* Written last by CDCASPEP_RECEIVE_BUFFER, NULL once filled */
+  volatile uint16_t hRxWanted;
+  volatile uint16_t hRxGot;
+  volatile bool ResyncRequest;      /* Raised by CDCASPEP_IDLE_ENABLE */
+  uint8_t RxPacket[CDCASPEP_PACKET_SIZE]; /* Last packet of the OUT endpoint */
+  uint16_t hRxPacketLength;
+  uint16_t hRxPacketRead;           /* Bytes of RxPacket taken by the receives */
+  bool RxArmed;                     /* OUT endpoint waiting for a packet */
+
+  /* Control endpoint */
+  CDCASPEP_Ep0Stage_t Ep0Stage;
+  const uint8_t *pEp0Data;          /* Rest of the answer */
+  uint16_t hEp0Remaining;
+  bool Ep0Zlp;                      /* Answer shorter than asked, ending on a full packet */
+  uint8_t bEp0Request;              /* Class request of the data OUT stage */
+  uint8_t Ep0Buffer[CDCASPEP_PACKET_SIZE];
+  uint8_t LineCoding[CDCASPEP_LINE_CODING_SIZE];
+  uint8_t bConfiguration;           /* 0 until the host configures the device */
+} CDCASPEP_Handle_t;
+
+/* Physical layer of ASPEP */
+void CDCASPEP_INIT(void *pHWHandle);
+bool CDCASPEP_SEND_PACKET(void *pHWHandle, void *data, uint16_t length);
+void CDCASPEP_RECEIVE_BUFFER(void *pHWHandle, void *buffer, uint16_t length);
+void CDCASPEP_IDLE_ENABLE(void *pHWHandle);
+
+/* To be called by the USB_LP interrupt */
+void CDCASPEP_IRQHandler(CDCASPEP_Handle_t *pHandle);
+
+#endif /* USB_CDC_ASPEP_DRIVER_H */
+
+/************************ (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,174 @@
+/**
+  ******************************************************************************
+  * @file    hfi_speed_pos_fdbk.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          High Frequency Injection Speed & Position Feedback component of the
+  *          Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup HFI
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HFI_SPEEDNPOSFDBK_H
+#define HFI_SPEEDNPOSFDBK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "speed_pos_fdbk.h"
+#include "pid_regulator.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup SpeednPosFdbk
+  * @{
+  */
+
+/** @addtogroup HFI
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/**
+  * @brief Largest number of FOC periods of one period of the carrier
+  */
+#define HFI_MAX_CARRIER_PERIOD  8U
+
+/**
+  * @brief Number of PLL speeds averaged by HFI_CalcAvrgMecSpeedUnit(), a power of two
+  */
+#define HFI_SPEED_BUFFER_SIZE   16U
+#define HFI_SPEED_BUFFER_LOG    4U
+
+/**
+  * @brief Fractional bits of hErrorGain
+  */
+#define HFI_ERROR_GAIN_LOG      4U
+
+/**
+  * @brief Steps of the detection of the magnet polarity
+  */
+typedef enum
+{
+  HFI_POL_IDLE,       /*!< No detection started */
+  HFI_POL_LOCK,       /*!< The PLL locks on the saliency at zero current */
+  HFI_POL_POSITIVE,   /*!< Positive d current pulse */
+  HFI_POL_NEGATIVE,   /*!< Negative d current pulse */
+  HFI_POL_DONE        /*!< The angle points to the north pole */
+} HFI_Polarity_t;
+
+/**
+  * @brief  HFI class parameters definition
+  */
+typedef struct
+{
+  SpeednPosFdbk_Handle_t _Super;
+
+  PID_Handle_t PIRegulator;     /*!< PI regulator of the PLL, from the angle
+                                     error in s16 degrees to the speed in dpp */
+  int16_t hInjVoltage;          /*!< Amplitude of the carrier on the d voltage */
+  uint8_t bHalfPeriod;          /*!< FOC periods of each sign of the carrier,
+                                     at least 2 */
+  int16_t hErrorGain;           /*!< s16 degrees of angle error per digit of
+                                     demodulated q current summed over one
+                                     observer period, with HFI_ERROR_GAIN_LOG
+                                     fractional bits */
+  int16_t hMinDResponse;        /*!< Mean demodulated d current below which the
+                                     carrier is not seen and the angle not
+                                     reliable */
+  int16_t hPolarityCurrent;     /*!< d current of the polarity pulses, s16A */
+  uint16_t hLockTicks;          /*!< Medium frequency periods of the lock at
+                                     zero current */
+  uint16_t hPulseTicks;         /*!< Medium frequency periods of each pulse */
+
+  /* Written by the high frequency task */
+  qd_t PrevIqd;                 /*!< Currents of the previous FOC period */
+  qd_t IqdRing[HFI_MAX_CARRIER_PERIOD]; /*!< Currents of the last carrier period */
+  int32_t wIqSum;               /*!< Sums of IqdRing */
+  int32_t wIdSum;
+  uint8_t bRingIndex;
+  bool RingFilled;              /*!< False until the first split after a clear */
+  uint8_t bPhase;               /*!< FOC period of the carrier */
+  int8_t bSign1;                /*!< Sign of the carrier applied one and two */
+  int8_t bSign2;                /*!< FOC periods ago, 0 if none */
+  int32_t wErrorSum;            /*!< Demodulated q current since the last PLL run */
+  volatile uint32_t wDResponse; /*!< Running sum of the demodulated d current */
+  volatile uint32_t wNbSamples; /*!< Running count of the demodulated periods */
+  volatile bool FlipRequest;    /*!< The angle is turned by half a turn at the
+                                     next PLL run */
+  int16_t SpeedBuffer[HFI_SPEED_BUFFER_SIZE]; /*!< Last PLL speeds, dpp */
+  uint8_t bSpeedIndex;
+
+  /* Written by the medium frequency task */
+  uint32_t wDResponseLast;      /*!< wDResponse and wNbSamples at the last */
+  uint32_t wNbSamplesLast;      /*!< reliability check */
+  uint32_t wDResponseRef;       /*!< wDResponse and wNbSamples at the start of */
+  uint32_t wNbSamplesRef;       /*!< the polarity measurement window */
+  HFI_Polarity_t Polarity;
+  uint16_t hPolarityTicks;      /*!< Medium frequency periods of the step */
+  int32_t wPositiveResponse;    /*!< Mean d response of the positive pulse */
+} HFI_Handle_t;
+
+/* Exported functions ------------------------------------------------------- */
+
+/* Initializes the HFI component */
+void HFI_Init(HFI_Handle_t *pHandle);
+
+/* Clears the angle, the PLL and the carrier before a start */
+void HFI_Clear(HFI_Handle_t *pHandle);
+
+/* Splits the measured currents into the fundamental and the response to the carrier */
+qd_t HFI_SplitCurrents(HFI_Handle_t *pHandle, qd_t Iqd);
+
+/* Adds the carrier to the d voltage */
+qd_t HFI_Inject(HFI_Handle_t *pHandle, qd_t Vqd);
+
+/* Runs the PLL on the response to the carrier, once per observer period */
+int16_t HFI_CalcElAngle(HFI_Handle_t *pHandle);
+
+/* Sets the angle and the speed, while another sensor is in use */
+void HFI_SetElAngle(HFI_Handle_t *pHandle, int16_t hElAngle, int16_t hElSpeedDpp);
+
+/* Computes the average mechanical speed and the reliability of the angle */
+bool HFI_CalcAvrgMecSpeedUnit(HFI_Handle_t *pHandle, int16_t *pMecSpeedUnit);
+
+/* Starts the detection of the magnet polarity */
+void HFI_StartPolarity(HFI_Handle_t *pHandle);
+
+/* Runs one medium frequency period of the detection of the magnet polarity */
+bool HFI_ExecPolarity(HFI_Handle_t *pHandle, int16_t *phIdRef);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* HFI_SPEEDNPOSFDBK_H */
+
+/******************* (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
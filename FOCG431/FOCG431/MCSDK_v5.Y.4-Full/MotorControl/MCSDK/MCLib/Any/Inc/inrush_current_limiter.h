@@ -66,7 +66,18 @@ typedef struct
   uint16_t hICLTicksCounter;    /*!< Number of clock events remaining to complete the ICL activation/deactivation */
   uint16_t hICLTotalTicks;      /*!< Total number of clock events to complete the ICL activation/deactivation */
   uint16_t hICLFrequencyHz;     /*!< Clock frequency used (Hz) to trigger the ICL_Exec() method */
-  uint16_t hICLDurationms;      /*!< ICL activation/deactivation duration (ms)*/
+  uint16_t hICLDurationms;      /*!< ICL activation/deactivation duration (ms), the switching
+                                     time of the bypass relay */
+  uint16_t hICLWindowms;        /*!< Interval between two samples of the bus voltage rise (ms) */
+  uint16_t hSettleVoltage_d;    /*!< Rise of the bus voltage still expected, in u16Volts, below
+                                     which the bus capacitors are charged and the ICL is
+                                     bypassed. With 0, it is bypassed as soon as the bus
+                                     voltage is above the under voltage threshold */
+  uint16_t hWindowTicks;        /*!< Number of clock events of an interval, set by ICL_Init() */
+  uint16_t hWindowCounter;      /*!< Number of clock events remaining in the interval */
+  uint16_t hWindowVbus_d;       /*!< Bus voltage at the start of the interval, in u16Volts */
+  int32_t  wLastRise_d;         /*!< Rise of the bus voltage over the last interval, in
+                                     u16Volts, negative before the first one */
 } ICL_Handle_t;
 
 
@@ -0,0 +1,1293 @@
+/**
+  ******************************************************************************
+  * @file    pcc.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          Predictive Current Control component of the Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup PCC
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PCC_H
+#define PCC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mc_type.h"
+#include "mc_math.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup PCC
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/**
+  * @brief Number of inverter voltage vectors evaluated by the predictive
+  *        controller: the six active vectors followed by the zero vector.
+  */
+#define PCC_NB_VECTORS      ((uint8_t)7)
+
+/**
+  * @brief Index of the zero vector in the PCC vector table.
+  */
+#define PCC_ZERO_VECTOR     ((uint8_t)6)
+
+/**
+  * @brief Number of polarities of the three phase currents. Bit 0, 1 and 2 of a
+  *        polarity are set when the current of phase A, B and C is positive.
+  */
+#define PCC_NB_POLARITIES   ((uint8_t)8)
+
+/**
+  * @brief Radius of the circle inscribed in the hexagon of the active vectors,
+  *        sqrt(3)/2 of their magnitude: the largest voltage that the finite set
+  *        holds on average whatever its angle.
+  */
+#define PCC_HEXAGON_MODULE  ((uint16_t)28377)
+
+/**
+  * @name Candidate search modes
+  *
+  * Values of PCC_SEARCH_MODE, to be defined in mc_stm_types.h.
+  * - PCC_FULL_SEARCH evaluates every vector of the vector table. It is kept as
+  *   the reference implementation.
+  * - PCC_SECTOR_SEARCH computes the deadbeat voltage once and evaluates only the
+  *   two active vectors that bound its sector and the zero vector.
+  * @{
+  */
+#define PCC_FULL_SEARCH     0
+#define PCC_SECTOR_SEARCH   1
+/** @} */
+
+#ifndef PCC_SEARCH_MODE
+#define PCC_SEARCH_MODE     PCC_FULL_SEARCH
+#endif
+
+/**
+  * @name Output modes
+  *
+  * Values of PCC_OUTPUT_MODE, to be defined in mc_stm_types.h.
+  * - PCC_FINITE_SET applies one inverter vector during the whole control period.
+  * - PCC_MODULATED applies the two active vectors of a sector and the zero
+  *   vector with the dwell times whose average voltage is the nearest to the
+  *   deadbeat one within the hexagon. The average voltage is applied by the
+  *   space vector modulation, at a fixed switching frequency.
+  *   The prediction horizon is then 1 and the switching penalty is not used.
+  * - PCC_DEADBEAT solves the model for the voltage that brings the currents to
+  *   their reference at the end of the next period, in closed form, limits it to
+  *   the module of the circle limitation, hMaxModule, and applies it through
+  *   the space vector modulation. There
+  *   is no search: the cost is the one of the prediction of the free response.
+  *   The prediction horizon is then 1 and the switching penalty is not used.
+  * @{
+  */
+#define PCC_FINITE_SET      0
+#define PCC_MODULATED       1
+#define PCC_DEADBEAT        2
+/** @} */
+
+#ifndef PCC_OUTPUT_MODE
+#define PCC_OUTPUT_MODE     PCC_FINITE_SET
+#endif
+
+/**
+  * @name Cost norms
+  *
+  * Values of PCC_COST_NORM, to be defined in mc_stm_types.h. They set the
+  * arithmetic of the cost of the candidates of #PCC_FINITE_SET.
+  * - PCC_COST_L2_WIDE weights the squared q and d errors with 64 bit products
+  *   and sums, SMULL and SMLAL on the Cortex-M4: the cost is exact up to the
+  *   saturation of the total to INT32_MAX.
+  * - PCC_COST_L2_SAT computes the same cost with 32 bit products only: each
+  *   component of the error is saturated to PCC_Handle_t::wCostSatError, the
+  *   weights are applied with 4 fractional bits and the squared current above
+  *   the barrier saturates to PCC_Handle_t::wExcessSatSq. The saturation is
+  *   PCC_Handle_t::hCostSatError, twice the nominal current on the ports,
+  *   lowered by PCC_Init() to the largest error whose square, weighted by the
+  *   largest weight of the table, fits in 32 bits. Beyond the saturation the
+  *   costs of the candidates are equal and the first one of the search is
+  *   kept.
+  * - PCC_COST_L1 weights the absolute q and d errors, in current digits, with
+  *   no square. The barrier applies to the current magnitude, approximated by
+  *   the largest of its alpha/beta components plus 3/8 of the smallest.
+  * - PCC_COST_L2_PACKED is the cost of PCC_COST_L2_SAT with the alpha/beta and
+  *   the q/d components of the residual in the halves of one register. The
+  *   square roots of the weights are part of the rotation coefficients, so
+  *   that the rotation is two dual multiplies, SMUSD and SMUADX, and the
+  *   weighted sum of the squares a third one, SMUAD. The components are
+  *   saturated after the rotation to the #PCC_COST_PACKED_BITS lanes, and
+  *   their sum to the square of PCC_Handle_t::wCostSatError.
+  *   With FULL_MISRA_C_COMPLIANCY_PCC the same arithmetic is done without the
+  *   intrinsics, bit for bit: it is the reference of the SIMD build.
+  * - PCC_COST_L2_FLOAT computes the cost of PCC_COST_L2_WIDE in single
+  *   precision, for the cores with an FPU: the rotation of the residual and
+  *   the weighted squares are multiply-accumulates of the FPU, VFMA on the
+  *   Cortex-M4F, with no 64 bit product, no saturation of the errors and no
+  *   double promotion. The weights of the search are converted once per step
+  *   of the horizon, with the rotation, and the cost is converted back to the
+  *   int32_t cost of the search, saturated to INT32_MAX, so that the
+  *   switching penalty, the tie band and the statistics keep their units. It
+  *   differs from PCC_COST_L2_WIDE by its roundings only.
+  * @{
+  */
+#define PCC_COST_L2_WIDE    0
+#define PCC_COST_L2_SAT     1
+#define PCC_COST_L1         2
+#define PCC_COST_L2_PACKED  3
+#define PCC_COST_L2_FLOAT   4
+/** @} */
+
+#ifndef PCC_COST_NORM
+#define PCC_COST_NORM       PCC_COST_L2_WIDE
+#endif
+
+/**
+  * @name Cost objectives
+  *
+  * Values of PCC_COST_OBJECTIVE, to be defined in mc_stm_types.h. They set
+  * what the cost of the candidates of #PCC_FINITE_SET measures.
+  * - PCC_OBJECTIVE_CURRENT weights the q and d current errors: the
+  *   predictive current control.
+  * - PCC_OBJECTIVE_TORQUE weights the torque and stator flux magnitude errors
+  *   of the predicted currents, the predictive torque control. The reference
+  *   torque and flux are the ones of the current references, so that MTPA and
+  *   the flux weakening still give the operating point, but every current
+  *   that produces them costs the same: in the flux weakening the search
+  *   trades the d current for the q current along the voltage limit instead
+  *   of tracking both. The torque is the one of the salient PMSM, divided by
+  *   1.5 p Ld and by the flux current wFluxCurr, the d current that cancels
+  *   the magnet flux: it is in q current digits and equals the q current on a
+  *   motor without saliency. The flux is divided by Ld: it is in d current
+  *   digits. hQWeight then weights the torque error and hDWeight the flux
+  *   error, so that a weight table of the current control keeps its scale.
+  *   The flux error is the error of the squared flux magnitudes divided by
+  *   twice wFluxCurr, exact at the magnet flux and smaller in the flux
+  *   weakening. The flux current is the one of the motor parameters, or the
+  *   one of the observer back-EMF with #PCC_SHARED_MODEL, PCC_UpdateFlux().
+  *   The cost is no longer the distance to the deadbeat voltage: it requires
+  *   #PCC_FULL_SEARCH, and the candidates pointing away from the error are
+  *   not skipped. It requires #PCC_COST_L2_WIDE.
+  * @{
+  */
+#define PCC_OBJECTIVE_CURRENT  0
+#define PCC_OBJECTIVE_TORQUE   1
+/** @} */
+
+#ifndef PCC_COST_OBJECTIVE
+#define PCC_COST_OBJECTIVE  PCC_OBJECTIVE_CURRENT
+#endif
+
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE) && ((PCC_OUTPUT_MODE != PCC_FINITE_SET) \
+    || (PCC_SEARCH_MODE != PCC_FULL_SEARCH) || (PCC_COST_NORM != PCC_COST_L2_WIDE))
+#error "PCC_OBJECTIVE_TORQUE requires PCC_FINITE_SET, PCC_FULL_SEARCH and PCC_COST_L2_WIDE"
+#endif
+
+/**
+  * @name Flux current of #PCC_OBJECTIVE_TORQUE
+  *
+  * PCC_Handle_t::hInductanceRatio, Lq / Ld, is a Q14 number. The flux current
+  * is kept above #PCC_FLUX_CURR_MIN, so that the gains divided by it stay in
+  * range. PCC_UpdateFlux() takes the flux current of the observer back-EMF
+  * above #PCC_FLUX_MIN_DPP only, where its current step is large enough, and
+  * filters it with a time constant of 2^#PCC_FLUX_FILTER_POW2 calls.
+  * @{
+  */
+#define PCC_RATIO_POW2        14U
+#define PCC_RATIO_ONE         ((int32_t)1 << PCC_RATIO_POW2)
+#define PCC_FLUX_CURR_MIN     ((int32_t)64)
+#define PCC_FLUX_CURR_MAX     ((int32_t)1 << 17)
+#define PCC_FLUX_MIN_DPP      ((int16_t)128)
+#define PCC_FLUX_FILTER_POW2  4U
+/** @} */
+
+/**
+  * @brief Bits of the saturation of the weighted q/d components with
+  *        #PCC_COST_L2_PACKED, the int16_t range of the current digits: the
+  *        sum of their squares is below 2^31 + 1, the unsigned result of SMUAD
+  */
+#define PCC_COST_PACKED_BITS  16U
+
+/**
+  * @brief Prediction horizon of the controller, in control periods, to be
+  *        defined in mc_stm_types.h.
+  *
+  * With a horizon of 1 the vector is selected on the predicted currents at the
+  * next control period only. With a horizon of 2 or 3 the controller evaluates
+  * the sequences of vectors over the horizon with a branch and bound search,
+  * applies the first vector of the best sequence and repeats the search at the
+  * next control period.
+  */
+#ifndef PCC_HORIZON
+#define PCC_HORIZON         1U
+#endif
+
+#if (PCC_HORIZON < 1U) || (PCC_HORIZON > 3U)
+#error "PCC_HORIZON must be 1, 2 or 3"
+#endif
+
+#if (PCC_OUTPUT_MODE == PCC_MODULATED) && (PCC_HORIZON != 1U)
+#error "PCC_MODULATED requires PCC_HORIZON 1"
+#endif
+
+#if (PCC_OUTPUT_MODE == PCC_DEADBEAT) && (PCC_HORIZON != 1U)
+#error "PCC_DEADBEAT requires PCC_HORIZON 1"
+#endif
+
+/**
+  * @brief Full hexagon of the modulated controller, enabled by defining
+  *        PCC_FULL_HEXAGON in mc_stm_types.h.
+  *
+  * The dwell times of #PCC_MODULATED are applied as they are by
+  * PWMC_SetDwellTimes() instead of their average voltage through the circle
+  * limitation and PWMC_SetPhaseVoltage(). The active vectors are then the
+  * vertices of the hexagon, 2/sqrt(3) of the full scale of
+  * PWMC_SetPhaseVoltage(), and the voltage reaches the whole hexagon as with
+  * PWMC_SetPhaseVoltage_OVM(). The PWMC component samples the currents with
+  * its _OVM functions and estimated currents where the sampling window of a
+  * phase is too short.
+  */
+#if defined (PCC_FULL_HEXAGON) && (PCC_OUTPUT_MODE != PCC_MODULATED)
+#error "PCC_FULL_HEXAGON requires PCC_MODULATED"
+#endif
+
+/**
+  * @brief Magnitude of the vertices of the hexagon in the units of
+  *        PWMC_SetPhaseVoltage(), 2/sqrt(3) in Q15
+  */
+#define PCC_HEXAGON_GAIN    ((int32_t)37837)
+
+/**
+  * @brief Exact discretisation of the model, enabled by defining
+  *        PCC_EXACT_DISCRETISATION in mc_stm_types.h.
+  *
+  * The model is then the zero order hold discretisation of the motor instead
+  * of its forward Euler one. wKDecay is exp(-Rs Ts / Ls), wKVolt and wKBemf
+  * carry the gains of the integral of the decay over the period, and the
+  * coupling of the axes and the back-EMF are rotated by the exact angle
+  * covered in one period. The speed dependent terms are computed again when
+  * the speed changes, from the sine table of MCM_Trig_Functions(), so that the
+  * predictor keeps the same integer operations per period. The prediction
+  * then holds at larger control periods, where the angle covered in one
+  * period is no longer small.
+  */
+
+/**
+  * @brief Adaptive decision period of #PCC_FINITE_SET, enabled by defining
+  *        PCC_ADAPTIVE_PERIOD in mc_stm_types.h.
+  *
+  * At low speed the vector is decided once every 2 or 4 control periods and
+  * held in between, so that the inverter switches less and the search runs
+  * less often where the bandwidth is not needed. The FOC period itself, and
+  * with it the PWM, the current sampling, the observers and the medium
+  * frequency tick, is unchanged. The predictor then runs the model of the
+  * decision period, one entry of PCC_Handle_t::pPeriodTable, and the frame
+  * rotates by the angle covered in the decision period. The decision period
+  * is chosen by PCC_SelectPeriod() from the medium frequency task and takes
+  * effect with its model through PCC_ApplyTuning().
+  */
+#if defined (PCC_ADAPTIVE_PERIOD) && (PCC_OUTPUT_MODE != PCC_FINITE_SET)
+#error "PCC_ADAPTIVE_PERIOD requires PCC_FINITE_SET"
+#endif
+
+#if defined (PCC_ADAPTIVE_PERIOD) && defined (PCC_MODEL_ESTIMATION)
+#error "PCC_ADAPTIVE_PERIOD requires the model of pPeriodTable, without PCC_MODEL_ESTIMATION"
+#endif
+
+/**
+  * @brief Number of decision periods of #PCC_ADAPTIVE_PERIOD: 1, 2 and 4
+  *        control periods
+  */
+#define PCC_PERIOD_STEPS    3U
+
+/**
+  * @brief Blended handover with the PI controllers, enabled by defining
+  *        PCC_BLENDED_HANDOVER in mc_stm_types.h.
+  *
+  * The controller left keeps running for the switch over ramp after a
+  * handover and its voltage is interpolated with the one of the controller
+  * engaged. The interpolation is made on the voltage of the space vector
+  * modulation: the vectors of #PCC_FINITE_SET and the dwell times of
+  * #PCC_FULL_HEXAGON are written to the PWM directly and cannot be blended.
+  */
+#if defined (PCC_BLENDED_HANDOVER) && ((PCC_OUTPUT_MODE == PCC_FINITE_SET) || defined (PCC_FULL_HEXAGON))
+#error "PCC_BLENDED_HANDOVER requires PCC_MODULATED without PCC_FULL_HEXAGON, or PCC_DEADBEAT"
+#endif
+
+/**
+  * @brief Table of the vectors in the q/d frame, enabled by defining
+  *        PCC_DQ_VECTOR_TABLE in mc_stm_types.h.
+  *
+  * The q/d voltage of the optimal vector of #PCC_FINITE_SET, and of the vector
+  * held by #PCC_ADAPTIVE_PERIOD, is read from a flash table indexed by the
+  * electrical angle quantised to #PCC_DQ_TABLE_SIZE steps, instead of being
+  * rotated by the sine and cosine of the period. The active vectors are 60
+  * degrees apart: they are the same entries of the table shifted by a sixth of
+  * it, so that one entry of 4 bytes per angle is enough. The entry is the one
+  * nearest to the sine and cosine of the Park transformation given to
+  * PCC_CalcVoltage() and PCC_GetHeldVoltage(), found by a bisection of the
+  * first octant of the table. It is meant for the boards without CORDIC, where
+  * the table takes 6 KB of flash.
+  */
+#if defined (PCC_DQ_VECTOR_TABLE) && (PCC_OUTPUT_MODE != PCC_FINITE_SET)
+#error "PCC_DQ_VECTOR_TABLE requires PCC_FINITE_SET"
+#endif
+
+/**
+  * @brief Back-EMF of the state observer, enabled by defining PCC_SHARED_MODEL
+  *        in mc_stm_types.h.
+  *
+  * The current step of the back-EMF is the one of the model of the STO_PLL
+  * observer, STO_PLL_GetBemfCurrentStep(), given in the q/d frame to
+  * PCC_SetBemfStep() by the high frequency task, instead of wKBemf times the
+  * speed. The observer runs after the current controller: the step is the one
+  * of the previous period, turned into the q/d frame at its own angle. A step
+  * is used by one PCC_CalcVoltage() only; without one, as with the CORDIC
+  * observer, the controller uses wKBemf. The predictor keeps the measured
+  * currents, or their estimate with PCC_STATE_FILTER, as its state, the
+  * observer currents lagging them.
+  */
+
+/**
+  * @brief Filtered current state, enabled by defining PCC_STATE_FILTER in
+  *        mc_stm_types.h.
+  *
+  * The prediction starts from an estimate of the currents instead of the
+  * measured ones: the currents predicted for the period, IqdNext, corrected by
+  * a share hStateGain of their error, as a Kalman filter with its steady state
+  * gain does. With the disturbance observer, whose gain hDistGain applies to
+  * the same error, the currents and the disturbance are then estimated
+  * together. The noise of one sample of the currents moves the decision of a
+  * finite set controller hStateGain times less, which removes most of the
+  * vector changes it alone would cause, at the cost of a slower response of
+  * the estimate to a current step the model misses. The residual and the
+  * disturbance are computed on the measured currents, and the estimate is not
+  * used after PCC_Clear() or a cut of the current limit, that the model does
+  * not know.
+  */
+
+/**
+  * @brief Split-phase prediction, enabled by defining PCC_SPLIT_PHASE in
+  *        mc_stm_types.h.
+  *
+  * The terms of the prediction that do not depend on the measured currents,
+  * PCC_Terms_t, are computed by PCC_PrepareVoltage() from the update interrupt
+  * of the PWM timer, while the currents are being sampled and converted: the
+  * rotation of the period, the back-EMF step and the current step of the
+  * voltage applied. With #PCC_FINITE_SET the currents at the end of the period
+  * are also predicted from IqdNext, the prediction of the last period, and the
+  * current steps of the vectors are set for their polarity. PCC_CalcVoltage()
+  * then only applies the measurement: the disturbance observer, the free
+  * response, the search and its minimum, which shortens the time from the end
+  * of the conversions to the update of the PWM.
+  *
+  * The terms are used by the next PCC_CalcVoltage() only, if it is given the
+  * same angle, speed and voltage, and if the model has not changed in between.
+  * Otherwise they are computed again as without PCC_SPLIT_PHASE, and the
+  * polarity is taken from the measured currents.
+  */
+
+/**
+  * @brief Cycle-by-cycle limit events, enabled by defining PCC_LIMIT_EVENTS in
+  *        mc_stm_types.h.
+  *
+  * PCC_SetLimitEvent() is called by the high frequency task when the hardware
+  * current limit of MC_CBC_LIMIT_MODE has cut the PWM since the last decision.
+  * The currents measured then follow the zero vector applied from the cut, not
+  * the vector decided: the disturbance observer is not updated with them, and
+  * the next search weights the barrier by hLimitWeight times
+  * 2^#PCC_LIMIT_EVENT_SHIFT, so that the vectors driving the current back to
+  * the limit are avoided. The barrier, with #PCC_FINITE_SET, must be enabled by
+  * a non zero hLimitWeight in the weight table. The decisions following an
+  * event are counted in PCC_Stats_t::hLimitEvents.
+  */
+#ifndef PCC_LIMIT_EVENT_SHIFT
+#define PCC_LIMIT_EVENT_SHIFT 2U
+#endif
+
+/**
+  * @brief Overvoltage aware braking, enabled by defining PCC_VBUS_LIMIT in
+  *        mc_stm_types.h.
+  *
+  * PCC_SetBusVoltage() computes how close the averaged bus voltage is to its
+  * limit, PCC_Handle_t::hVbusLevel: 0 up to hVbusStart_d, rising to 1 (Q15) at
+  * hVbusLimit_d, the overvoltage threshold. While the reference brakes, its q
+  * current opposed to the speed, the next decisions:
+  * - lower the d reference by hBrakeIdMax times the level: the d current
+  *   dissipates part of the braking power in the stator, with no torque;
+  * - with #PCC_FINITE_SET and a horizon of one, add to the cost of each
+  *   candidate hRegenWeight times the level times the power its vector returns
+  *   to the bus, the product of its voltage and of the current predicted at
+  *   the end of the period. The zero vector and the vectors drawing power win
+  *   as the bus voltage rises, and the search itself limits the regenerative
+  *   q current;
+  * - otherwise, with no candidate vectors, scale the q reference by one minus
+  *   the level.
+  * The overvoltage protection is kept: the braking torque is traded for the
+  * bus voltage only close to the threshold.
+  */
+
+/**
+  * @brief Inductance saturation table, enabled by defining PCC_INDUCTANCE_TABLE
+  *        in mc_stm_types.h.
+  *
+  * PCC_Handle_t::hLSatGain holds #PCC_LSAT_POINTS ratios of the inductance of
+  * the model to the inductance at a q current magnitude of i times hLSatStep,
+  * the last one holding above. PCC_SelectInductance() interpolates them at the
+  * measured q current of each period and, when the ratio moves by more than
+  * #PCC_LSAT_HYST, multiplies the current steps of the voltage, wKVoltBus and
+  * the current step table, by it. The back-EMF step is multiplied by the
+  * ratio in use as well. The decay term, Rs * Ts / Ls, a few percent of one,
+  * is kept unsaturated.
+  *
+  * PCC_Init() fills a default table, in which the inductance goes down
+  * linearly by hLSatDrop from hLSatKnee to the last point. The table is
+  * measured by MC_COMMISSION_MODE and stored with its model. With
+  * PCC_MODEL_ESTIMATION, the estimator divides the inductance term of each
+  * sample by the ratio of its current, so that it estimates the inductance of
+  * the unsaturated model the table refers to.
+  */
+#ifndef PCC_LSAT_POINTS
+#define PCC_LSAT_POINTS     16U
+#endif
+#if (PCC_LSAT_POINTS < 2U) || (PCC_LSAT_POINTS > 32U)
+#error "PCC_LSAT_POINTS must be between 2 and 32"
+#endif
+#define PCC_LSAT_POW2       14U
+#define PCC_LSAT_ONE        ((uint16_t)1 << PCC_LSAT_POW2)
+#define PCC_LSAT_HYST       ((uint16_t)64)    /* 0.4 % */
+
+/**
+  * @brief Number of angles of the table of #PCC_DQ_VECTOR_TABLE, a multiple of
+  *        6: one step is 0.23 degrees, whose voltage error is below 0.4 %
+  */
+#define PCC_DQ_TABLE_SIZE   1536U
+
+/**
+  * @name Decision log word
+  *
+  * Bit fields of PCC_Handle_t::hLogDecision, logged by the MCPA with the
+  * MC_REG_PCC_DECISION register:
+  * - bits 0 to 2: index of the optimal vector in the vector table;
+  * - bits 3 to 5: switching state of the inverter, phase A on bit 3;
+  * - bit 6: set if the search was stopped by its node budget;
+  * - bits 8 to 15: number of nodes evaluated, saturated to 255.
+  * @{
+  */
+#define PCC_LOG_VECTOR_POS  0U
+#define PCC_LOG_STATE_POS   3U
+#define PCC_LOG_BUDGET_POS  6U
+#define PCC_LOG_NODES_POS   8U
+#define PCC_LOG_NODES_MAX   255U
+/** @} */
+
+/**
+  * @brief Divisor of the cost logged in PCC_Handle_t::hLogCost, expressed as
+  *        power of 2. The logged cost is in the units of hSwitchingWeight.
+  */
+#define PCC_LOG_COST_POW2   8U
+
+/**
+  * @brief Seed of the pseudo random sequence of the tie break of #PCC_FINITE_SET,
+  *        any value but 0
+  */
+#define PCC_RANDOM_SEED     ((uint16_t)0xACE1)
+
+/**
+  * @brief Largest divisor of the model coefficients accepted by PCC_SetTuning(),
+  *        expressed as power of 2
+  */
+#define PCC_MAX_DIVISOR_POW2  ((uint16_t)15)
+
+/**
+  * @name Bus voltage compensation
+  *
+  * The ratio of the measured to the nominal bus voltage, PCC_Handle_t::hBusScale,
+  * is a Q14 number. It is limited to the range below, so that a missing or
+  * wrong bus measurement does not cancel the voltage term of the model, and
+  * it is applied only when it moves by more than #PCC_BUS_SCALE_HYST, so that
+  * the current step tables are not computed again at every ripple of the bus.
+  * @{
+  */
+#define PCC_BUS_SCALE_POW2    14U
+#define PCC_BUS_SCALE_ONE     ((uint16_t)1 << PCC_BUS_SCALE_POW2)
+#define PCC_BUS_SCALE_MIN     ((uint16_t)8192)  /* 0.5 */
+#define PCC_BUS_SCALE_MAX     ((uint16_t)24576) /* 1.5 */
+#define PCC_BUS_SCALE_HYST    ((uint16_t)64)    /* 0.4 % */
+/** @} */
+
+/**
+  * @name Cost weights by operating point
+  *
+  * With #PCC_FINITE_SET the cost of a candidate is the sum of its q and d
+  * current errors squared, each with its own weight, of the switching penalty
+  * scaled by a weight and of the squared current above the limit of the
+  * barrier, PCC_Handle_t::wLimitSqCurr, times the barrier weight. The weights
+  * are read from a table of #PCC_WEIGHT_SPEED_BANDS rows of speed bands and
+  * #PCC_WEIGHT_IQ_BANDS columns of q current bands, whose entry is selected by
+  * PCC_SelectWeights(). The weights are fixed point numbers, #PCC_WEIGHT_ONE
+  * for 1: the entry {PCC_WEIGHT_ONE, PCC_WEIGHT_ONE, PCC_WEIGHT_ONE, 0} gives
+  * the squared distance and the switching penalty of hSwitchingWeight. With
+  * #PCC_COST_L1 the errors and the current above the limit are not squared.
+  *
+  * Beyond the barrier, whose weight lets the error and the current limit be
+  * traded, PCC_Handle_t::hMaxCurr is a hard constraint: a candidate whose
+  * predicted current magnitude is above it, at any step of the horizon, is
+  * kept only if no candidate stays below it. PCC_Handle_t::hTripCurr is the
+  * same constraint on the largest predicted phase current, the one seen by the
+  * overcurrent protection: set below its trip threshold, it keeps the vectors
+  * that would trip the inverter for the periods where no other one is left.
+  * The voltage limit needs no constraint, the candidates being the vertices of
+  * the hexagon.
+  * @{
+  */
+#define PCC_WEIGHT_SPEED_BANDS  3U
+#define PCC_WEIGHT_IQ_BANDS     3U
+#define PCC_NB_WEIGHTS          (PCC_WEIGHT_SPEED_BANDS * PCC_WEIGHT_IQ_BANDS)
+#define PCC_WEIGHT_POW2         8U
+#define PCC_WEIGHT_ONE          ((uint16_t)1 << PCC_WEIGHT_POW2)
+/** @} */
+
+/**
+  * @brief Cost weights of one operating point of a Predictive Current Control
+  *        component, in units of #PCC_WEIGHT_ONE
+  */
+typedef struct
+{
+  uint16_t  hQWeight;             /**< Weight of the squared q current error */
+  uint16_t  hDWeight;             /**< Weight of the squared d current error */
+  uint16_t  hSwitchingScale;      /**< Scale of hSwitchingWeight */
+  uint16_t  hLimitWeight;         /**< Weight of the squared current above the
+                                       limit of the barrier. 0 disables the
+                                       barrier */
+} PCC_Weights_t;
+
+#if (PCC_COST_NORM == PCC_COST_L2_PACKED)
+/**
+  * @brief Weights of one entry of the weight table as used by
+  *        #PCC_COST_L2_PACKED. Computed by PCC_Init()
+  */
+typedef struct
+{
+  uint16_t  hQScale;              /**< Square root of hQWeight divided by
+                                       hMaxWeight, Q15: 32768 for the largest
+                                       weight, so that the rotation of equal
+                                       weights is exact */
+  uint16_t  hDScale;              /**< Square root of hDWeight divided by
+                                       hMaxWeight, Q15 */
+  uint16_t  hMinScale;            /**< Smallest of hQScale and hDScale, for the
+                                       lower bound of the cost */
+  uint16_t  hMaxWeight;           /**< Largest of hQWeight and hDWeight */
+} PCC_PackedScale_t;
+#endif
+
+/**
+  * @brief Tuning set of a Predictive Current Control component
+  *
+  * @detail Values written at run time by PCC_SetTuning(). They are applied all
+  * together by PCC_ApplyTuning() at the beginning of a control period, so that the
+  * predictor never runs with a partly updated model.
+  */
+typedef struct
+{
+  int32_t   wKDecay;              /**< See #PCC_Handle_t */
+  int32_t   wKVolt;               /**< See #PCC_Handle_t */
+  int32_t   wKBemf;               /**< See #PCC_Handle_t */
+  uint16_t  hCoefDivisorPOW2;     /**< See #PCC_Handle_t */
+  uint16_t  hBemfDivisorPOW2;     /**< See #PCC_Handle_t */
+  uint16_t  hSwitchingWeight;     /**< See #PCC_Handle_t */
+  uint16_t  hNodeBudget;          /**< See #PCC_Handle_t */
+  int16_t   hEngageSpeed;         /**< See #PCC_Handle_t */
+  int16_t   hDisengageSpeed;      /**< See #PCC_Handle_t */
+} PCC_Tuning_t;
+
+#ifdef PCC_ADAPTIVE_PERIOD
+/**
+  * @brief Model of the motor over a decision period of #PCC_ADAPTIVE_PERIOD
+  */
+typedef struct
+{
+  int32_t   wKDecay;              /**< See #PCC_Handle_t */
+  int32_t   wKVolt;               /**< See #PCC_Handle_t */
+  int32_t   wKBemf;               /**< See #PCC_Handle_t */
+  uint16_t  hCoefDivisorPOW2;     /**< See #PCC_Handle_t */
+  uint16_t  hBemfDivisorPOW2;     /**< See #PCC_Handle_t */
+} PCC_PeriodModel_t;
+#endif
+
+/**
+  * @brief Decision statistics of a Predictive Current Control component over
+  *        one window of PCC_Handle_t::hStatsPeriod medium frequency periods
+  *
+  * @detail Every counter is accumulated by PCC_CalcVoltage() and stops at
+  * UINT16_MAX control periods. The mean cost is wCostSum / hNbPeriods.
+  */
+typedef struct
+{
+  uint32_t  wCostSum;             /**< Sum of the logged costs, see
+                                       PCC_Handle_t::hLogCost */
+  uint16_t  hCostMax;             /**< Largest logged cost */
+  uint16_t  hNbPeriods;           /**< Control periods run by the predictive
+                                       controller */
+  uint16_t  hVectorChanges;       /**< Periods whose optimal vector differs
+                                       from the one of the previous period */
+  uint16_t  hBudgetExceeded;      /**< Periods whose search was stopped by
+                                       the node budget */
+  uint16_t  hTripRejected;        /**< Periods whose search evaluated a
+                                       candidate above hTripCurr, with
+                                       #PCC_FINITE_SET */
+  uint16_t  hTripPredicted;       /**< Periods whose applied vector is
+                                       predicted above hTripCurr, no candidate
+                                       staying below it */
+  uint16_t  hLimitEvents;         /**< Periods following a cut of the
+                                       hardware current limit, with
+                                       #PCC_LIMIT_EVENTS */
+  uint32_t  wResidualSum;         /**< Sum of the residuals, see
+                                       PCC_Handle_t::hResidual */
+  uint16_t  hResidualMax;         /**< Largest residual */
+  uint16_t  hResidualPeriods;     /**< Periods whose residual was evaluated.
+                                       The mean residual is wResidualSum /
+                                       hResidualPeriods */
+  uint16_t  hVectorCount[PCC_NB_VECTORS]; /**< Periods each vector of the
+                                       vector table was optimal */
+} PCC_Stats_t;
+
+/**
+  * @brief Terms of the prediction of one control period that do not depend on
+  *        the measured currents, see PCC_SPLIT_PHASE
+  */
+typedef struct
+{
+  Trig_Components Trig;           /**< Park angle of the period */
+  qd_t      Vqd;                  /**< Voltage applied during the period, as
+                                       given to PCC_CalcVoltage() */
+  int16_t   hElSpeedDpp;          /**< Electrical speed of the period, in dpp */
+  uint8_t   bPolarity;            /**< Polarity of the currents predicted at
+                                       the end of the period, set in the
+                                       current steps of the vectors, or
+                                       PCC_NB_POLARITIES if not predicted */
+  int32_t   wCosNext;             /**< Cosine of the angle at the end of the
+                                       period, Q15 */
+  int32_t   wSinNext;             /**< Sine of the angle at the end of the
+                                       period, Q15 */
+#ifndef PCC_EXACT_DISCRETISATION
+  int32_t   wDelta;               /**< Angle covered in the decision period,
+                                       Q13 of pi */
+#endif
+#if (PCC_HORIZON > 1U) || defined (PCC_EXACT_DISCRETISATION)
+  int32_t   wCosStep;             /**< Rotation of the frame over the period */
+  int32_t   wSinStep;
+#endif
+  int32_t   wBemfQ;               /**< Current step of the back-EMF in the
+                                       period, without the disturbance */
+  int32_t   wBemfD;
+  int32_t   wVoltQ;               /**< Current step of the voltage applied in
+                                       the period */
+  int32_t   wVoltD;
+} PCC_Terms_t;
+
+/**
+  * @brief Handle of a Predictive Current Control component
+  *
+  * @detail This structure stores the discrete model of the motor used to predict
+  * the stator currents one control period ahead and the outcome of the last
+  * optimisation. Model coefficients are expressed as rational numbers, with a
+  * gain and a power of two divisor, so that the predictor only needs multiplies
+  * and shifts.
+  */
+typedef struct
+{
+  int32_t   wKDecay;              /**< Current decay coefficient
+                                       (1 - Rs * Ts / Ls), exp(-Rs * Ts / Ls)
+                                       with PCC_EXACT_DISCRETISATION, scaled by
+                                       2^hCoefDivisorPOW2 */
+  int32_t   wKVolt;               /**< Voltage to current coefficient
+                                       (Ts / Ls), from a vector table digit
+                                       to a current digit at the nominal bus
+                                       voltage, scaled by 2^hCoefDivisorPOW2 */
+  int32_t   wKBemf;               /**< Back-EMF coefficient (psi * Ts / Ls),
+                                       from an electrical speed in dpp to a
+                                       current digit, scaled by
+                                       2^hBemfDivisorPOW2 */
+  uint16_t  hCoefDivisorPOW2;     /**< Divisor of wKDecay and wKVolt,
+                                       expressed as power of 2 */
+  uint16_t  hBemfDivisorPOW2;     /**< Divisor of wKBemf, expressed as
+                                       power of 2 */
+  uint16_t  hSwitchingWeight;     /**< Cost of one inverter leg commutation,
+                                       in units of 256 squared current digits
+                                       at a hSwitchingScale of #PCC_WEIGHT_ONE,
+                                       in current digits with #PCC_COST_L1.
+                                       0 disables the switching penalty */
+  uint16_t  hNodeBudget;          /**< Maximum number of nodes the horizon
+                                       search may evaluate in one control
+                                       period. Unused if PCC_HORIZON is 1 */
+  uint16_t  hFallbackOverruns;    /**< Number of consecutive searches stopped
+                                       by hNodeBudget that start a fallback to
+                                       the current PI controllers. 0 disables
+                                       the fallback */
+  uint16_t  hFallbackPeriods;     /**< Number of control periods of a
+                                       fallback to the current PI controllers */
+  uint16_t  hResidualLimit;       /**< Mean residual above which the
+                                       measured currents or the model are
+                                       deemed faulty and a fallback to the
+                                       current PI controllers starts, s16A.
+                                       0 disables the fallback */
+  uint8_t   bResidualShift;       /**< The residual is averaged over
+                                       2^bResidualShift control periods */
+  uint16_t  hDistGain;            /**< Gain of the disturbance observer, share
+                                       of the prediction error of one period
+                                       added to Disturbance, Q15. 0 disables
+                                       the observer */
+#ifdef PCC_STATE_FILTER
+  uint16_t  hStateGain;           /**< Gain of the current estimate, share of
+                                       the prediction error of one period
+                                       added to IqdNext, Q15, below 1. See
+                                       PCC_STATE_FILTER */
+#endif
+  int16_t   hEngageSpeed;         /**< Absolute average mechanical speed, in
+                                       SPEED_UNIT, above which the predictive
+                                       controller replaces the current PI
+                                       controllers */
+  int16_t   hDisengageSpeed;      /**< Absolute average mechanical speed, in
+                                       SPEED_UNIT, below which the current PI
+                                       controllers take over again. Not greater
+                                       than hEngageSpeed */
+  volatile PCC_Tuning_t PendingTuning; /**< Tuning set waiting for the next
+                                       call of PCC_ApplyTuning() */
+  volatile bool TuningPending;    /**< True while PendingTuning has not been
+                                       applied */
+  uint16_t  hNominalBusVoltage;   /**< Bus voltage of wKVolt, in u16Volts.
+                                       0 disables the bus voltage compensation */
+  uint32_t  wNominalBusInv;       /**< 2^(PCC_BUS_SCALE_POW2 + 16) divided by
+                                       hNominalBusVoltage. Computed by PCC_Init() */
+  volatile uint16_t hBusScale;    /**< Ratio of the bus voltage to
+                                       hNominalBusVoltage in use, Q14 */
+  volatile uint16_t hPendingBusScale; /**< Ratio staged by PCC_SetBusVoltage() */
+  volatile bool BusScalePending;  /**< True while hPendingBusScale has not been
+                                       applied */
+  int32_t   wKVoltBus;            /**< wKVolt times hBusScale, the voltage
+                                       coefficient used by the predictor */
+  alphabeta_t DeltaIalphabeta[PCC_NB_VECTORS]; /**< Current step produced in
+                                       one control period by each vector of the
+                                       vector table, in the alpha/beta frame.
+                                       Computed by PCC_Init() from wKVoltBus */
+#if (PCC_OUTPUT_MODE != PCC_FINITE_SET)
+  int32_t   wKVoltInv;            /**< 2^(hCoefDivisorPOW2 + 15) divided by
+                                       wKVoltBus, from a current step to the
+                                       voltage of the vector table digits that
+                                       produces it, Q15 */
+#endif
+#if (PCC_OUTPUT_MODE != PCC_FINITE_SET) && !defined (PCC_FULL_HEXAGON)
+  uint16_t  hMaxModule;           /**< Module of the circle limitation applied to
+                                       the returned voltage by the motor control
+                                       task, MAX_MODULE. The voltage is limited
+                                       to it, along its direction, before the
+                                       currents are predicted */
+#endif
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  int16_t   hSwitchDrop;          /**< Voltage across a conducting power switch.
+                                       As the inverter voltage errors below, in
+                                       digits of the vector table: an error of
+                                       one phase alone moves the vector by as
+                                       many digits along the axis of the phase */
+  int16_t   hDiodeDrop;           /**< Voltage across a conducting freewheeling
+                                       diode */
+  int16_t   hDeadTimeDrop;        /**< Voltage lost by a phase in the dead time
+                                       of one switching pulse */
+  alphabeta_t DeltaIoffset[PCC_NB_VECTORS][PCC_NB_POLARITIES]; /**< Current
+                                       step of the inverter voltage errors of
+                                       each vector, for each polarity of the
+                                       phase currents. Computed by PCC_Init()
+                                       from wKVolt and the drops above */
+  alphabeta_t DeltaIalphabetaPol[PCC_NB_VECTORS]; /**< DeltaIalphabeta plus
+                                       DeltaIoffset of bPolarity, the current
+                                       steps used by the search */
+  uint8_t   bPolarity;            /**< Polarity of the phase currents of
+                                       DeltaIalphabetaPol, PCC_NB_POLARITIES
+                                       when it has to be computed again */
+  const PCC_Weights_t *pWeightTable; /**< #PCC_NB_WEIGHTS cost weights, one row
+                                       of #PCC_WEIGHT_IQ_BANDS entries per speed
+                                       band */
+#if (PCC_COST_NORM == PCC_COST_L2_PACKED)
+  PCC_PackedScale_t PackedScale[PCC_NB_WEIGHTS]; /**< pWeightTable as used by
+                                       #PCC_COST_L2_PACKED */
+#endif
+  int16_t   hWeightSpeedBand[PCC_WEIGHT_SPEED_BANDS - 1U]; /**< Absolute average
+                                       mechanical speeds, in SPEED_UNIT, at which
+                                       the speed bands of the table end, but the
+                                       last one */
+  int16_t   hWeightIqBand[PCC_WEIGHT_IQ_BANDS - 1U]; /**< Absolute q currents, in
+                                       digits, at which the q current bands of
+                                       the table end, but the last one */
+  int16_t   hLimitCurr;           /**< Current magnitude above which the
+                                       barrier weight applies, in digits */
+  uint32_t  wLimitSqCurr;         /**< Square of hLimitCurr. Computed by
+                                       PCC_Init() */
+  int16_t   hMaxCurr;             /**< Current magnitude above which a candidate
+                                       is infeasible, in digits. 0 disables the
+                                       constraint */
+  uint32_t  wMaxSqCurr;           /**< Square of hMaxCurr, UINT32_MAX if
+                                       disabled. Computed by PCC_Init() */
+#if (PCC_COST_NORM == PCC_COST_L2_SAT) || (PCC_COST_NORM == PCC_COST_L2_PACKED)
+  int16_t   hCostSatError;        /**< Saturation of each component of the
+                                       current error, in digits */
+  int32_t   wCostSatError;        /**< hCostSatError, lowered to the headroom
+                                       of the weights of pWeightTable. Computed
+                                       by PCC_Init() */
+  uint32_t  wCostSatSq;           /**< Square of wCostSatError. Computed by
+                                       PCC_Init() */
+  uint32_t  wExcessSatSq;         /**< Saturation of the squared current above
+                                       hLimitCurr, the headroom of the barrier
+                                       weights. Computed by PCC_Init() */
+#endif
+  int16_t   hTripCurr;            /**< Phase current above which a candidate
+                                       is infeasible, in absolute digits, below
+                                       the trip of the overcurrent protection.
+                                       0 disables the constraint */
+  bool      TripRejected;         /**< True if the last search evaluated a
+                                       candidate above hTripCurr */
+  bool      TripPredicted;        /**< True if the last optimal vector is
+                                       predicted above hTripCurr */
+  volatile uint8_t bWeightIndex;  /**< Entry of pWeightTable in use, written
+                                       by PCC_SelectWeights() or
+                                       PCC_SetWeightIndex() */
+  uint16_t  hTieBand;             /**< Cost difference, in the units of
+                                       hSwitchingWeight, within which candidates
+                                       are equal: one of them is drawn at random,
+                                       so that the switching spectrum is spread.
+                                       0 keeps the first best candidate */
+  uint16_t  hRandom;              /**< State of the pseudo random sequence of
+                                       the tie break, never 0 */
+#endif
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+  int32_t   wFluxCurr;            /**< Magnet flux divided by Ld, the d current
+                                       that cancels it, in digits. Set by
+                                       PCC_Init() and PCC_UpdateFlux() */
+  uint16_t  hInductanceRatio;     /**< Lq / Ld, in Q14 */
+  int32_t   wTorqueSaliency;      /**< (1 - Lq / Ld) / wFluxCurr, in Q30: the
+                                       reluctance torque per q current and d
+                                       current digit. Computed with wFluxCurr */
+  int32_t   wFluxGain;            /**< 2^24 / (2 wFluxCurr), from the error of
+                                       the squared flux to the flux error.
+                                       Computed with wFluxCurr */
+#endif
+#ifdef PCC_ADAPTIVE_PERIOD
+  const PCC_PeriodModel_t *pPeriodTable; /**< #PCC_PERIOD_STEPS models, the
+                                       one of a decision period of 2^i control
+                                       periods at index i */
+  int16_t   hPeriodSpeedBand[PCC_PERIOD_STEPS - 1U]; /**< Absolute average
+                                       mechanical speeds, in SPEED_UNIT,
+                                       decreasing, below which the decision
+                                       period is 2^(i + 1) control periods */
+  int16_t   hPeriodHyst;          /**< Speed, in SPEED_UNIT, below a band that
+                                       the speed must reach before the decision
+                                       period is made longer */
+  uint8_t   bPeriodLog;           /**< Decision period in use, expressed as
+                                       power of 2 */
+  volatile uint8_t bPendingPeriodLog; /**< Decision period of PendingTuning */
+  uint8_t   bPeriodCounter;       /**< Control periods left before the next
+                                       decision */
+#endif
+#if (PCC_HORIZON > 1U) || defined (PCC_EXACT_DISCRETISATION)
+  int16_t   hStepSpeedDpp;        /**< Electrical speed of StepTrig, INT16_MIN
+                                       when it has to be computed again */
+  Trig_Components StepTrig;       /**< Rotation of the frame over one control
+                                       period, kept while the speed is steady */
+#endif
+#ifdef PCC_EXACT_DISCRETISATION
+  int32_t   wKDecayCos;           /**< wKDecay times the cosine of StepTrig,
+                                       decay of each axis onto itself */
+  int32_t   wKDecaySin;           /**< wKDecay times the sine of StepTrig,
+                                       coupling of the axes */
+  int16_t   hBemfCos;             /**< Share of the back-EMF current step on
+                                       the q axis at the end of the period, Q15 */
+  int16_t   hBemfSin;             /**< Share of the back-EMF current step on
+                                       the d axis at the end of the period, Q15 */
+#endif
+  qd_t      IqdPred;              /**< Currents predicted at the end of the
+                                       period the optimal vector is applied */
+  qd_t      IqdNext;              /**< Currents predicted at the end of the
+                                       current period, compared with the next
+                                       measurement by the disturbance observer */
+  qd_t      Disturbance;          /**< Current step per period that the model
+                                       misses, estimated by the disturbance
+                                       observer and added to the predictions */
+  bool      NextValid;            /**< True once IqdNext has been predicted */
+#ifdef PCC_SPLIT_PHASE
+  PCC_Terms_t Terms;              /**< Terms computed by PCC_PrepareVoltage()
+                                       for the next PCC_CalcVoltage() */
+  volatile bool TermsReady;       /**< True while Terms hold for the model in
+                                       use and have not been used */
+#endif
+  qd_t      Vqd;                  /**< Optimal voltage in the q/d frame */
+  int32_t   wCost;                /**< Cost of the optimal vector */
+  uint16_t  hNodeCount;           /**< Number of nodes evaluated by the last
+                                       search */
+  uint8_t   bOptimalVector;       /**< Index of the optimal vector in the
+                                       PCC vector table */
+  uint8_t   bSwitchingState;      /**< Switching state that realises the
+                                       optimal vector */
+  uint16_t  hDwellTime[2];        /**< Dwell times of the two active vectors
+                                       of the sector, in Q15 fractions of the
+                                       period, with #PCC_MODULATED */
+  uint8_t   bSector;              /**< Sector of the two active vectors, from
+                                       0 to 5, with #PCC_MODULATED */
+#ifdef PCC_SHARED_MODEL
+  qd_t      BemfStep;             /**< Current step per period of the
+                                       back-EMF of the observer model, set by
+                                       PCC_SetBemfStep() */
+  bool      BemfShared;           /**< True when BemfStep is set for the next
+                                       PCC_CalcVoltage() */
+#endif
+#ifdef HARMONIC_COMPENSATION
+  qd_t      BemfHarmonic;         /**< Voltage of the back-EMF harmonics of
+                                       the period, set by
+                                       PCC_SetBemfHarmonic() */
+#endif
+#ifdef PCC_LIMIT_EVENTS
+  PCC_Weights_t LimitWeights;     /**< Entry of the weight table with the
+                                       barrier weight raised, used by the
+                                       search following a limit event */
+  bool      LimitEvent;           /**< True when the hardware current limit
+                                       cut the PWM since the last decision, set
+                                       by PCC_SetLimitEvent() */
+#endif
+#ifdef PCC_VBUS_LIMIT
+  uint16_t  hVbusStart_d;         /**< Bus voltage from which the braking is
+                                       limited, in u16Volts */
+  uint16_t  hVbusLimit_d;         /**< Bus voltage of the full limitation, in
+                                       u16Volts */
+  uint16_t  hRegenWeight;         /**< Cost of a current digit returned to the
+                                       bus at the full vector voltage and at
+                                       hVbusLimit_d, in squared current error
+                                       digits */
+  int16_t   hBrakeIdMax;          /**< Magnitude of the d current injected at
+                                       hVbusLimit_d */
+  uint32_t  wVbusRangeInv;        /**< 2^31 divided by hVbusLimit_d minus
+                                       hVbusStart_d, 0 if not above. Computed
+                                       by PCC_Init() */
+  volatile uint16_t hVbusLevel;   /**< Position of the bus voltage between
+                                       hVbusStart_d and hVbusLimit_d, Q15. Set
+                                       by PCC_SetBusVoltage() */
+#endif
+#ifdef PCC_INDUCTANCE_TABLE
+  int16_t   hLSatKnee;            /**< q current from which the default table
+                                       lowers the inductance, in digits */
+  uint16_t  hLSatDrop;            /**< Part of the inductance of the model lost
+                                       at the last point of the default table,
+                                       Q14 */
+  uint16_t  hLSatGain[PCC_LSAT_POINTS]; /**< Inductance of the model divided by
+                                       the inductance at a q current magnitude
+                                       of i times hLSatStep, Q14 */
+  int16_t   hLSatStep;            /**< q current between two points of
+                                       hLSatGain, in digits */
+  uint32_t  wLSatStepInv;         /**< 2^16 divided by hLSatStep. Computed by
+                                       PCC_Init() */
+  uint16_t  hLSatGainInUse;       /**< Ratio of hLSatGain the current steps
+                                       are computed with, Q14 */
+#endif
+#ifdef PCC_FULL_HEXAGON
+  bool      VqdHeld;              /**< True when Vqd is the voltage applied
+                                       during the current period: the predictor
+                                       then uses it instead of the voltage
+                                       saturated to the int16_t range */
+#endif
+  bool      BudgetExceeded;       /**< True if the last search was stopped
+                                       by hNodeBudget before completion */
+  uint16_t  hOverrunCount;        /**< Consecutive searches stopped by
+                                       hNodeBudget */
+  uint16_t  hFallbackCounter;     /**< Control periods left in the fallback
+                                       to the current PI controllers */
+  uint16_t  hFallbackEvents;      /**< Fallbacks since PCC_Init(), saturated
+                                       to UINT16_MAX */
+  uint16_t  hResidual;            /**< Residual of the last period, sum of
+                                       the magnitudes of the q and d errors of
+                                       the currents predicted for it, s16A */
+  uint32_t  wResidualSum;         /**< Running mean of hResidual, times
+                                       2^bResidualShift */
+  uint16_t  hResidualEvents;      /**< Fallbacks started by the residual since
+                                       PCC_Init(), saturated to UINT16_MAX */
+  uint16_t  hLogDecision;         /**< Last decision packed for the MCPA
+                                       datalog, see #PCC_LOG_VECTOR_POS */
+  uint16_t  hLogCost;             /**< Cost of the optimal vector divided by
+                                       2^PCC_LOG_COST_POW2 and saturated to 16
+                                       bits, for the MCPA datalog */
+  uint16_t  hStatsPeriod;         /**< Number of calls of PCC_UpdateStats()
+                                       in one statistics window */
+  uint16_t  hStatsCounter;        /**< Calls of PCC_UpdateStats() since the
+                                       beginning of the window */
+  PCC_Stats_t Stats[2];           /**< Statistics written by the high
+                                       frequency task and read by the medium
+                                       frequency task */
+  volatile uint8_t bStatsIndex;   /**< Index of the statistics written by the
+                                       high frequency task */
+} PCC_Handle_t;
+
+/* Exported functions ------------------------------------------------------- */
+
+/*
+ * Initializes the handle
+ */
+void PCC_Init(PCC_Handle_t *pHandle);
+
+/*
+ * Resets the result of the last optimisation
+ */
+void PCC_Clear(PCC_Handle_t *pHandle);
+
+/*
+ * Selects the voltage vector that minimises the predicted current error
+ */
+qd_t PCC_CalcVoltage(PCC_Handle_t *pHandle, qd_t Iqd, qd_t Iqdref, qd_t Vqd, Trig_Components Trig,
+                     int16_t hElSpeedDpp);
+
+#ifdef PCC_SPLIT_PHASE
+/*
+ * Computes the terms of the next prediction that do not depend on the measured currents
+ */
+void PCC_PrepareVoltage(PCC_Handle_t *pHandle, qd_t Vqd, Trig_Components Trig, int16_t hElSpeedDpp);
+#endif
+
+/*
+ * Stages a new tuning set, applied at the beginning of the next control period
+ */
+bool PCC_SetTuning(PCC_Handle_t *pHandle, const PCC_Tuning_t *pTuning);
+
+/*
+ * Returns the tuning set in use
+ */
+void PCC_GetTuning(const PCC_Handle_t *pHandle, PCC_Tuning_t *pTuning);
+
+/*
+ * Applies the staged tuning set, if any
+ */
+void PCC_ApplyTuning(PCC_Handle_t *pHandle);
+
+/*
+ * Stages the ratio of the measured to the nominal bus voltage, and sets the
+ * level of PCC_VBUS_LIMIT
+ */
+void PCC_SetBusVoltage(PCC_Handle_t *pHandle, uint16_t hBusVoltage_d);
+
+#ifdef PCC_SHARED_MODEL
+/*
+ * Sets the back-EMF current step of the observer model for the next period
+ */
+void PCC_SetBemfStep(PCC_Handle_t *pHandle, qd_t BemfStep);
+#endif
+
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE) && defined (PCC_SHARED_MODEL)
+/*
+ * Updates the flux current of the torque cost from the back-EMF of the observer model
+ */
+void PCC_UpdateFlux(PCC_Handle_t *pHandle, int16_t hElSpeedDpp);
+#endif
+
+#ifdef HARMONIC_COMPENSATION
+/*
+ * Sets the voltage of the back-EMF harmonics of the next decision
+ */
+void PCC_SetBemfHarmonic(PCC_Handle_t *pHandle, qd_t Vqd);
+#endif
+
+#ifdef PCC_LIMIT_EVENTS
+/*
+ * Signals a cut of the hardware current limit for the next decision
+ */
+void PCC_SetLimitEvent(PCC_Handle_t *pHandle);
+#endif
+
+#ifdef PCC_INDUCTANCE_TABLE
+/*
+ * Returns the inductance ratio of the table at a q current
+ */
+uint16_t PCC_GetInductanceGain(const PCC_Handle_t *pHandle, int16_t hIq);
+
+/*
+ * Selects the inductance ratio of the measured q current for the period
+ */
+void PCC_SelectInductance(PCC_Handle_t *pHandle, int16_t hIq);
+
+/*
+ * Replaces the inductance saturation table
+ */
+void PCC_SetInductanceTable(PCC_Handle_t *pHandle, const uint16_t *pGain);
+#endif
+
+/*
+ * Returns the speed above which the predictive controller is engaged
+ */
+int16_t PCC_GetEngageSpeed(const PCC_Handle_t *pHandle);
+
+/*
+ * Returns the speed below which the predictive controller is disengaged
+ */
+int16_t PCC_GetDisengageSpeed(const PCC_Handle_t *pHandle);
+
+/*
+ * Returns the index of the last optimal vector
+ */
+uint8_t PCC_GetOptimalVector(const PCC_Handle_t *pHandle);
+
+/*
+ * Returns the inverter switching state of the last optimal vector
+ */
+uint8_t PCC_GetSwitchingState(const PCC_Handle_t *pHandle);
+
+/*
+ * Returns the voltage of the last optimal vector in the alpha/beta frame
+ */
+alphabeta_t PCC_GetVectorVoltage(const PCC_Handle_t *pHandle);
+
+#if (PCC_OUTPUT_MODE == PCC_MODULATED)
+/*
+ * Returns the inverter switching state of an active vector of the last sector
+ */
+uint8_t PCC_GetDwellState(const PCC_Handle_t *pHandle, uint8_t bIndex);
+
+/*
+ * Returns the dwell time of an active vector of the last sector
+ */
+uint16_t PCC_GetDwellTime(const PCC_Handle_t *pHandle, uint8_t bIndex);
+#endif
+
+/*
+ * Sets the cost weight of one inverter leg commutation
+ */
+void PCC_SetSwitchingWeight(PCC_Handle_t *pHandle, uint16_t hWeight);
+
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+/*
+ * Replaces the dead time drop by a measured voltage error of a phase
+ */
+void PCC_SetDeadTimeDrop(PCC_Handle_t *pHandle, int16_t hPhaseDrop);
+#endif
+
+/*
+ * Returns the cost weight of one inverter leg commutation
+ */
+uint16_t PCC_GetSwitchingWeight(const PCC_Handle_t *pHandle);
+
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+/*
+ * Selects the cost weights of the operating point
+ */
+void PCC_SelectWeights(PCC_Handle_t *pHandle, int16_t hSpeedUnit, int16_t hIq);
+
+/*
+ * Forces an entry of the weight table
+ */
+void PCC_SetWeightIndex(PCC_Handle_t *pHandle, uint8_t bIndex);
+
+/*
+ * Returns the entry of the weight table in use
+ */
+uint8_t PCC_GetWeightIndex(const PCC_Handle_t *pHandle);
+#endif
+
+#ifdef PCC_ADAPTIVE_PERIOD
+/*
+ * Selects the decision period of the speed
+ */
+void PCC_SelectPeriod(PCC_Handle_t *pHandle, int16_t hSpeedUnit);
+
+/*
+ * Counts one control period of the decision period
+ */
+bool PCC_HoldTick(PCC_Handle_t *pHandle);
+
+/*
+ * Returns the voltage of the vector held in the q/d frame of the period
+ */
+qd_t PCC_GetHeldVoltage(const PCC_Handle_t *pHandle, Trig_Components Trig);
+
+/*
+ * Returns the number of control periods of the decision period in use
+ */
+uint8_t PCC_GetDecisionPeriods(const PCC_Handle_t *pHandle);
+#endif
+
+/*
+ * Returns the cost of the last optimal vector
+ */
+int32_t PCC_GetCost(const PCC_Handle_t *pHandle);
+
+/*
+ * Returns the currents predicted for the last optimal vector
+ */
+qd_t PCC_GetPredictedIqd(const PCC_Handle_t *pHandle);
+
+/*
+ * Returns the current step per period estimated by the disturbance observer
+ */
+qd_t PCC_GetDisturbance(const PCC_Handle_t *pHandle);
+
+/*
+ * Returns the number of nodes evaluated by the last search
+ */
+uint16_t PCC_GetNodeCount(const PCC_Handle_t *pHandle);
+
+/*
+ * Returns true if the last search exceeded its node budget
+ */
+bool PCC_IsBudgetExceeded(const PCC_Handle_t *pHandle);
+
+/*
+ * Counts one control period of the fallback to the PI controllers
+ */
+bool PCC_FallbackTick(PCC_Handle_t *pHandle);
+
+/*
+ * Returns the number of fallbacks to the PI controllers
+ */
+uint16_t PCC_GetFallbackEvents(const PCC_Handle_t *pHandle);
+
+/*
+ * Returns the number of fallbacks started by the residual of the predictions
+ */
+uint16_t PCC_GetResidualEvents(const PCC_Handle_t *pHandle);
+
+/*
+ * Closes the statistics window when its period has elapsed
+ */
+void PCC_UpdateStats(PCC_Handle_t *pHandle);
+
+/*
+ * Returns the statistics of the last complete window
+ */
+const PCC_Stats_t *PCC_GetStats(const PCC_Handle_t *pHandle);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* PCC_H */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -58,6 +58,7 @@ typedef struct
                                          CalcTorqueReference.*/
   uint32_t ScalingFactor;           /*!< Scaling factor between output value and
                                          its internal representation.*/
+  uint8_t  ScalingShift;            /*!< Log2 of ScalingFactor, a power of two.*/
 #ifdef FASTDIV
   /* (Fast division optimization for cortex-M0 micros)*/
   FastDiv_Handle_t fd;                       /*!< Fast division obj.*/
@@ -103,6 +103,12 @@ typedef struct
                                              digit.*/
   int16_t IdrefDefault;                /*!< Default Id current reference expressed
                                              in digit.*/
+  int32_t AccFFGain;                   /*!< Iq current, expressed in digit, of an
+                                             acceleration of one #SPEED_UNIT per
+                                             STC_CalcTorqueReference call. The
+                                             torque of the speed ramps is added to
+                                             the output of the speed PI. 0 disables
+                                             the acceleration feed-forward.*/
 } SpeednTorqCtrl_Handle_t;
 
 
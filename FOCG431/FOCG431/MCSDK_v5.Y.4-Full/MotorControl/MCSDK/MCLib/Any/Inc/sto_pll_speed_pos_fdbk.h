@@ -94,8 +94,12 @@ typedef struct
   int16_t hBemf_beta_est;       /*!< Estimated B-emf beta in int16_t format */
   int16_t Speed_Buffer[64];    /*!< Estimated DPP speed FIFO, it contains latest
                                      SpeedBufferSizeDpp speed measurements*/
-  uint8_t Speed_Buffer_Index;  /*!< Position of latest speed estimation in
+  volatile uint8_t Speed_Buffer_Index; /*!< Position of latest speed estimation in
                                      estimated speed FIFO */
+  volatile int32_t UnitBufferSum; /*!< Sum of the SpeedBufferSizeUnit elements of
+                                     the speed FIFO [dpp] */
+  volatile int64_t UnitBufferSqSum; /*!< Sum of the squares of the SpeedBufferSizeUnit
+                                     elements of the speed FIFO [dpp^2] */
   bool IsSpeedReliable;        /*!< Latest private speed reliability information,
                                      updated by SPD_CalcAvrgMecSpeedUnit, it is
                                      true if the speed measurement variance is
@@ -120,7 +124,7 @@ typedef struct
   uint8_t SpeedBufferSizeUnit;       /*!< Depth of FIFO used to average
                                            estimated speed exported by
                                            SPD_GetAvrgMecSpeedUnit. It
-                                           must be an integer number between 1
+                                           must be a power of two between 1
                                            and 64 */
   uint8_t SpeedBufferSizeDpp;       /*!< Depth of FIFO used for both averaging
                                            estimated speed exported by
@@ -175,6 +179,21 @@ typedef struct
   uint16_t SpeedBufferSizeDppLOG;    /*!< bSpeedBufferSizedpp expressed as power of 2.
                                             E.g. if gain divisor is 512 the value
                                             must be 9 because 2^9 = 512 */
+  uint16_t GainScheduleSpeedUnit;    /*!< Absolute value of the mechanical speed
+                                            below which the PLL gains are raised in
+                                            inverse proportion to the speed: the
+                                            input of the PLL is the back-emf, the
+                                            bandwidth of the PLL is then kept.
+                                            Expressed in the unit defined by
+                                            #SPEED_UNIT, 0 to keep the nominal gains */
+  uint8_t GainScheduleMax;           /*!< Largest factor applied to the nominal
+                                            PLL gains at low speed */
+  bool FastConvergence;              /*!< When true, a start-up consistency test
+                                            passed in the inner half of the speed
+                                            band counts twice, and a failed test
+                                            halves the count instead of clearing it */
+  int16_t hNominalKpGain;            /*!< PLL gains set by STO_SetPLLGains, applied */
+  int16_t hNominalKiGain;            /*!< at and above GainScheduleSpeedUnit */
   bool ForceConvergency;       /*!< Variable to force observer convergence.*/
   bool ForceConvergency2;      /*!< Variable to force observer convergence.*/
 
@@ -220,6 +239,9 @@ alphabeta_t STO_PLL_GetEstimatedBemf(STO_PLL_Handle_t *pHandle);
 /* It exports the stator current alpha-beta as estimated by state  observer */
 alphabeta_t STO_PLL_GetEstimatedCurrent(STO_PLL_Handle_t *pHandle);
 
+/* It exports the current step produced by the back-EMF in the observer model */
+alphabeta_t STO_PLL_GetBemfCurrentStep(STO_PLL_Handle_t *pHandle);
+
 /* It set new values for observer gains*/
 void STO_PLL_SetObserverGains(STO_PLL_Handle_t *pHandle, int16_t hhC1, int16_t hhC2);
 
@@ -41,7 +41,7 @@ extern "C" {
 #endif
 
 #define Z_ALIGNMENT_DURATION  2                     /* 2 seconds */
-#define Z_ALIGNMENT_NB_ROTATION (2.0f * M_PI)         /* 1 turn in 2 seconds allowed to find the "Z" signal  */
+#define Z_ALIGNMENT_NB_ROTATION (2.0f * (float)M_PI)        /* 1 turn in 2 seconds allowed to find the "Z" signal  */
 
 /** @addtogroup MCSDK
   * @{
@@ -108,6 +108,7 @@ typedef struct
 
 void TC_Init(PosCtrl_Handle_t *pHandle, PID_Handle_t *pPIDPosReg, SpeednTorqCtrl_Handle_t *pSTC,
              ENCODER_Handle_t *pENC);
+void TC_Clear(PosCtrl_Handle_t *pHandle);
 bool TC_MoveCommand(PosCtrl_Handle_t *pHandle, float startingAngle, float angleStep, float movementDuration);
 void TC_FollowCommand(PosCtrl_Handle_t *pHandle, float Angle);
 void TC_PositionRegulation(PosCtrl_Handle_t *pHandle);
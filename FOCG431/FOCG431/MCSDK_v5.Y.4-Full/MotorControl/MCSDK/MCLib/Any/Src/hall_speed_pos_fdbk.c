@@ -254,6 +254,8 @@ __weak void HALL_Clear(HALL_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  Update the rotor electrical angle integrating the last measured
@@ -393,6 +395,8 @@ __weak bool HALL_CalcAvrgMecSpeedUnit(HALL_Handle_t *pHandle, int16_t *hMecSpeed
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  Example of private method of the class HALL to implement an MC IRQ function
@@ -722,6 +726,8 @@ __weak void *HALL_TIMx_CC_IRQHandler(void *pHandleVoid)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  Example of private method of the class HALL to implement an MC IRQ function
@@ -0,0 +1,565 @@
+/**
+  ******************************************************************************
+  * @file    hfi_speed_pos_fdbk.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the High Frequency Injection Speed & Position Feedback component of
+  *          the Motor Control SDK:
+  *
+  *           * injection of a square wave carrier on the d voltage
+  *           * estimation of the rotor angle and speed from the saliency of the motor
+  *           * detection of the magnet polarity at standstill
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "hfi_speed_pos_fdbk.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup SpeednPosFdbk
+  * @{
+  */
+
+/**
+  * @defgroup HFI High Frequency Injection Speed & Position Feedback
+  * @brief Angle of a salient motor at low speed, from its response to a carrier
+  *
+  * The back-EMF the observers rely on vanishes at low speed. The inductance of a
+  * salient motor does not: with Ld smaller than Lq, a voltage carrier on the
+  * estimated d axis makes a current ripple on the estimated q axis that is
+  * proportional to the sine of twice the angle error.
+  *
+  * The carrier is a square wave of hInjVoltage on the d voltage, bHalfPeriod FOC
+  * periods positive then bHalfPeriod FOC periods negative, added after the current
+  * regulators. At each FOC period, the change of the q current since the previous
+  * period is demodulated with the sign of the carrier that caused it, and the sum
+  * over one observer period drives a PLL that makes the angle and the speed. The
+  * average of the currents over one carrier period, where the ripple cancels out,
+  * is what the current regulators see.
+  *
+  * The saliency repeats every half turn: the PLL locks either on the north or on
+  * the south pole. HFI_ExecPolarity() tells them apart at standstill with two d
+  * current pulses of opposite signs. The one that adds to the magnet flux
+  * saturates the iron, lowers Ld and makes the larger d ripple.
+  *
+  * The demodulated d ripple is also the health check of the estimate: below
+  * hMinDResponse the carrier is not seen, and the speed is reported unreliable.
+  *
+  * @{
+  */
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Mean demodulated d current since the given snapshot of wDResponse and wNbSamples */
+static int32_t HFI_MeanDResponse(const HFI_Handle_t *pHandle, uint32_t wDResponseRef, uint32_t wNbSamplesRef)
+{
+  uint32_t wNbSamples = pHandle->wNbSamples - wNbSamplesRef;
+  int32_t wMean;
+
+  if (0U == wNbSamples)
+  {
+    wMean = 0;
+  }
+  else
+  {
+    /* The running sum wraps around: the difference is the sum since the snapshot */
+    wMean = (int32_t)(pHandle->wDResponse - wDResponseRef) / (int32_t)wNbSamples;
+  }
+  return (wMean);
+}
+
+/**
+  * @brief  Initializes the High Frequency Injection component.
+  * @param  pHandle handler of the current instance of the HFI component
+  */
+__weak void HFI_Init(HFI_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    PID_HandleInit(&pHandle->PIRegulator);
+    HFI_Clear(pHandle);
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  }
+#endif
+}
+
+/**
+  * @brief  Clears the angle, the speed, the PLL and the carrier, and stops the
+  *         detection of the magnet polarity. It must be called before a start.
+  * @param  pHandle handler of the current instance of the HFI component
+  */
+__weak void HFI_Clear(HFI_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t i;
+
+    pHandle->_Super.hElAngle = 0;
+    pHandle->_Super.hMecAngle = 0;
+    pHandle->_Super.hElSpeedDpp = 0;
+    pHandle->_Super.InstantaneousElSpeedDpp = 0;
+    pHandle->_Super.hAvrMecSpeedUnit = 0;
+    pHandle->_Super.bSpeedErrorNumber = 0U;
+    PID_SetIntegralTerm(&pHandle->PIRegulator, 0);
+    for (i = 0U; i < HFI_SPEED_BUFFER_SIZE; i++)
+    {
+      pHandle->SpeedBuffer[i] = 0;
+    }
+    pHandle->bSpeedIndex = 0U;
+    pHandle->RingFilled = false;
+    pHandle->bPhase = 0U;
+    pHandle->bSign1 = 0;
+    pHandle->bSign2 = 0;
+    pHandle->wErrorSum = 0;
+    pHandle->FlipRequest = false;
+    pHandle->wDResponseLast = pHandle->wDResponse;
+    pHandle->wNbSamplesLast = pHandle->wNbSamples;
+    pHandle->Polarity = HFI_POL_IDLE;
+    pHandle->hPolarityTicks = 0U;
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  }
+#endif
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Demodulates the change of the measured currents since the previous FOC
+  *         period and returns their average over the last carrier period, free of
+  *         the carrier ripple. It must be called once per FOC period while the
+  *         carrier is injected, before the current regulators.
+  * @param  pHandle handler of the current instance of the HFI component
+  * @param  Iqd measured currents
+  * @retval qd_t Currents to regulate
+  */
+__weak qd_t HFI_SplitCurrents(HFI_Handle_t *pHandle, qd_t Iqd)
+{
+  qd_t Fundamental;
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  if (MC_NULL == pHandle)
+  {
+    Fundamental = Iqd;
+  }
+  else
+  {
+#endif
+    uint8_t bPeriod = 2U * pHandle->bHalfPeriod;
+    uint8_t i;
+
+    if (false == pHandle->RingFilled)
+    {
+      /* First period of the carrier: no change to demodulate yet */
+      for (i = 0U; i < bPeriod; i++)
+      {
+        pHandle->IqdRing[i] = Iqd;
+      }
+      pHandle->wIqSum = (int32_t)Iqd.q * (int32_t)bPeriod;
+      pHandle->wIdSum = (int32_t)Iqd.d * (int32_t)bPeriod;
+      pHandle->bRingIndex = 0U;
+      pHandle->RingFilled = true;
+    }
+    else
+    {
+      /* The voltage between the two samplings is the mean of the last two
+         voltages computed: the change is only demodulated when both have the
+         same sign, the FOC periods where the carrier toggles are left out */
+      int32_t wSign = ((int32_t)pHandle->bSign1 + (int32_t)pHandle->bSign2) / 2;
+      qd_t Oldest = pHandle->IqdRing[pHandle->bRingIndex];
+
+      pHandle->wErrorSum += wSign * ((int32_t)Iqd.q - (int32_t)pHandle->PrevIqd.q);
+      pHandle->wDResponse += (uint32_t)(wSign * ((int32_t)Iqd.d - (int32_t)pHandle->PrevIqd.d));
+      pHandle->wNbSamples++;
+
+      pHandle->wIqSum += (int32_t)Iqd.q - (int32_t)Oldest.q;
+      pHandle->wIdSum += (int32_t)Iqd.d - (int32_t)Oldest.d;
+      pHandle->IqdRing[pHandle->bRingIndex] = Iqd;
+      pHandle->bRingIndex = ((pHandle->bRingIndex + 1U) >= bPeriod) ? 0U : (pHandle->bRingIndex + 1U);
+    }
+    pHandle->PrevIqd = Iqd;
+
+    Fundamental.q = (int16_t)(pHandle->wIqSum / (int32_t)bPeriod);
+    Fundamental.d = (int16_t)(pHandle->wIdSum / (int32_t)bPeriod);
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  }
+#endif
+  return (Fundamental);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Adds the carrier to the d voltage computed by the current regulators.
+  *         It must be called once per FOC period while the carrier is injected,
+  *         after HFI_SplitCurrents() and before the circle limitation.
+  * @param  pHandle handler of the current instance of the HFI component
+  * @param  Vqd voltage computed by the current regulators
+  * @retval qd_t Voltage to apply
+  */
+__weak qd_t HFI_Inject(HFI_Handle_t *pHandle, qd_t Vqd)
+{
+  qd_t Vqd_out = Vqd;
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int8_t bSign = (pHandle->bPhase < pHandle->bHalfPeriod) ? 1 : -1;
+    int32_t wVd = (int32_t)Vqd.d + ((int32_t)bSign * (int32_t)pHandle->hInjVoltage);
+
+    wVd = (wVd > (int32_t)INT16_MAX) ? (int32_t)INT16_MAX : wVd;
+    wVd = (wVd < -(int32_t)INT16_MAX) ? -(int32_t)INT16_MAX : wVd;
+    Vqd_out.d = (int16_t)wVd;
+
+    pHandle->bSign2 = pHandle->bSign1;
+    pHandle->bSign1 = bSign;
+    pHandle->bPhase = ((pHandle->bPhase + 1U) >= (2U * pHandle->bHalfPeriod)) ? 0U : (pHandle->bPhase + 1U);
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  }
+#endif
+  return (Vqd_out);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Runs the PLL on the q current demodulated since its last run and
+  *         updates the angle and the speed. It must be called once per observer
+  *         period while the carrier is injected.
+  * @param  pHandle handler of the current instance of the HFI component
+  * @retval int16_t rotor electrical angle (s16Degrees)
+  */
+__weak int16_t HFI_CalcElAngle(HFI_Handle_t *pHandle)
+{
+  int16_t hElAngle;
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  if (MC_NULL == pHandle)
+  {
+    hElAngle = 0;
+  }
+  else
+  {
+#endif
+    int32_t wError = pHandle->wErrorSum;
+    int16_t hSpeed;
+
+    if (true == pHandle->FlipRequest)
+    {
+      /* The PLL locked on the south pole */
+      pHandle->_Super.hElAngle = (int16_t)((uint16_t)pHandle->_Super.hElAngle + 32768U);
+      pHandle->FlipRequest = false;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    pHandle->wErrorSum = 0;
+
+    wError = (wError > 65535) ? 65535 : wError;
+    wError = (wError < -65535) ? -65535 : wError;
+    wError = (wError * (int32_t)pHandle->hErrorGain) / (int32_t)(1U << HFI_ERROR_GAIN_LOG);
+    wError = (wError > (int32_t)INT16_MAX) ? (int32_t)INT16_MAX : wError;
+    wError = (wError < -(int32_t)INT16_MAX) ? -(int32_t)INT16_MAX : wError;
+
+    hSpeed = PI_Controller(&pHandle->PIRegulator, wError);
+    pHandle->_Super.InstantaneousElSpeedDpp = hSpeed;
+    pHandle->_Super.hElAngle += hSpeed;
+    pHandle->_Super.hMecAngle += hSpeed / (int16_t)pHandle->_Super.bElToMecRatio;
+
+    pHandle->SpeedBuffer[pHandle->bSpeedIndex] = hSpeed;
+    pHandle->bSpeedIndex = (pHandle->bSpeedIndex + 1U) & (HFI_SPEED_BUFFER_SIZE - 1U);
+    hElAngle = pHandle->_Super.hElAngle;
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  }
+#endif
+  return (hElAngle);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Makes the angle and the speed follow another speed sensor while the
+  *         carrier is not injected, so that the PLL resumes from them. It must be
+  *         called once per observer period instead of HFI_CalcElAngle().
+  * @param  pHandle handler of the current instance of the HFI component
+  * @param  hElAngle electrical angle of the sensor in use, s16Degrees
+  * @param  hElSpeedDpp instantaneous electrical speed of the sensor in use, dpp
+  */
+__weak void HFI_SetElAngle(HFI_Handle_t *pHandle, int16_t hElAngle, int16_t hElSpeedDpp)
+{
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->_Super.hElAngle = hElAngle;
+    pHandle->_Super.InstantaneousElSpeedDpp = hElSpeedDpp;
+    PID_SetIntegralTerm(&pHandle->PIRegulator,
+                        (int32_t)hElSpeedDpp * (int32_t)PID_GetKIDivisor(&pHandle->PIRegulator));
+    pHandle->SpeedBuffer[pHandle->bSpeedIndex] = hElSpeedDpp;
+    pHandle->bSpeedIndex = (pHandle->bSpeedIndex + 1U) & (HFI_SPEED_BUFFER_SIZE - 1U);
+
+    /* The carrier starts again from a new period */
+    pHandle->RingFilled = false;
+    pHandle->bPhase = 0U;
+    pHandle->bSign1 = 0;
+    pHandle->bSign2 = 0;
+    pHandle->wErrorSum = 0;
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  }
+#endif
+}
+
+/**
+  * @brief  Computes the average mechanical speed of the last PLL runs and checks
+  *         the reliability of the estimate: the speed must be in the reliable
+  *         range and, if the carrier was injected since the last call, its d
+  *         response must be at least hMinDResponse. It must be called by the
+  *         medium frequency task.
+  * @param  pHandle handler of the current instance of the HFI component
+  * @param  pMecSpeedUnit pointer to int16_t, used to return the rotor average
+  *         mechanical speed (expressed in the unit defined by #SPEED_UNIT)
+  * @retval bool true = sensor information is reliable
+  *              false = sensor information is not reliable
+  */
+__weak bool HFI_CalcAvrgMecSpeedUnit(HFI_Handle_t *pHandle, int16_t *pMecSpeedUnit)
+{
+  bool bAux;
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  if ((MC_NULL == pHandle) || (MC_NULL == pMecSpeedUnit))
+  {
+    bAux = false;
+  }
+  else
+  {
+#endif
+    int32_t wAvrSpeed_dpp = 0;
+    int32_t wAux;
+    uint32_t wDResponse = pHandle->wDResponse;
+    uint32_t wNbSamples = pHandle->wNbSamples;
+    uint8_t i;
+
+    for (i = 0U; i < HFI_SPEED_BUFFER_SIZE; i++)
+    {
+      wAvrSpeed_dpp += (int32_t)pHandle->SpeedBuffer[i];
+    }
+    wAvrSpeed_dpp = wAvrSpeed_dpp / (int32_t)HFI_SPEED_BUFFER_SIZE;
+    pHandle->_Super.hElSpeedDpp = (int16_t)wAvrSpeed_dpp;
+
+    /* Computation of Mechanical speed Unit */
+    wAux = wAvrSpeed_dpp * ((int32_t)pHandle->_Super.hMeasurementFrequency);
+    wAux = wAux * ((int32_t)pHandle->_Super.SpeedUnit);
+    wAux = wAux / ((int32_t)pHandle->_Super.DPPConvFactor);
+    wAux = wAux / ((int16_t)pHandle->_Super.bElToMecRatio);
+    *pMecSpeedUnit = (int16_t)wAux;
+    pHandle->_Super.hAvrMecSpeedUnit = (int16_t)wAux;
+
+    if ((wNbSamples != pHandle->wNbSamplesLast)
+        && (HFI_MeanDResponse(pHandle, pHandle->wDResponseLast, pHandle->wNbSamplesLast)
+            < (int32_t)pHandle->hMinDResponse))
+    {
+      /* The carrier is lost: the angle can no longer be trusted */
+      pHandle->_Super.bSpeedErrorNumber = pHandle->_Super.bMaximumSpeedErrorsNumber;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    pHandle->wDResponseLast = wDResponse;
+    pHandle->wNbSamplesLast = wNbSamples;
+
+    bAux = SPD_IsMecSpeedReliable(&pHandle->_Super, pMecSpeedUnit);
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  }
+#endif
+  return (bAux);
+}
+
+/**
+  * @brief  Starts the detection of the magnet polarity. The carrier must be
+  *         injected, at standstill, for the whole detection.
+  * @param  pHandle handler of the current instance of the HFI component
+  */
+__weak void HFI_StartPolarity(HFI_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->Polarity = HFI_POL_LOCK;
+    pHandle->hPolarityTicks = 0U;
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  }
+#endif
+}
+
+/**
+  * @brief  Runs one medium frequency period of the detection of the magnet
+  *         polarity: the PLL first locks at zero current for hLockTicks, then a
+  *         positive and a negative d current pulse of hPulseTicks each are
+  *         applied. The d response of each pulse is measured over its second
+  *         half, once the current has settled. If the negative pulse makes the
+  *         larger response, the angle is turned by half a turn.
+  * @param  pHandle handler of the current instance of the HFI component
+  * @param  phIdRef pointer to int16_t, used to return the d current reference
+  * @retval bool true once the angle points to the north pole
+  */
+__weak bool HFI_ExecPolarity(HFI_Handle_t *pHandle, int16_t *phIdRef)
+{
+  bool bDone = false;
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  if ((MC_NULL == pHandle) || (MC_NULL == phIdRef))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int32_t wResponse;
+
+    pHandle->hPolarityTicks++;
+    switch (pHandle->Polarity)
+    {
+      case HFI_POL_LOCK:
+      {
+        *phIdRef = 0;
+        if (pHandle->hPolarityTicks >= pHandle->hLockTicks)
+        {
+          pHandle->hPolarityTicks = 0U;
+          pHandle->Polarity = HFI_POL_POSITIVE;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        break;
+      }
+
+      case HFI_POL_POSITIVE:
+      case HFI_POL_NEGATIVE:
+      {
+        *phIdRef = (HFI_POL_POSITIVE == pHandle->Polarity) ? pHandle->hPolarityCurrent : -pHandle->hPolarityCurrent;
+        if (pHandle->hPolarityTicks == (pHandle->hPulseTicks / 2U))
+        {
+          pHandle->wDResponseRef = pHandle->wDResponse;
+          pHandle->wNbSamplesRef = pHandle->wNbSamples;
+        }
+        else if (pHandle->hPolarityTicks >= pHandle->hPulseTicks)
+        {
+          wResponse = HFI_MeanDResponse(pHandle, pHandle->wDResponseRef, pHandle->wNbSamplesRef);
+          pHandle->hPolarityTicks = 0U;
+          if (HFI_POL_POSITIVE == pHandle->Polarity)
+          {
+            pHandle->wPositiveResponse = wResponse;
+            pHandle->Polarity = HFI_POL_NEGATIVE;
+          }
+          else
+          {
+            pHandle->FlipRequest = (wResponse > pHandle->wPositiveResponse);
+            *phIdRef = 0;
+            pHandle->Polarity = HFI_POL_DONE;
+            bDone = true;
+          }
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        break;
+      }
+
+      case HFI_POL_DONE:
+      {
+        *phIdRef = 0;
+        bDone = true;
+        break;
+      }
+
+      default:
+      {
+        *phIdRef = 0;
+        break;
+      }
+    }
+#ifdef NULL_PTR_CHECK_HFI_SPD_POS_FDB
+  }
+#endif
+  return (bDone);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @} */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,4315 @@
+/**
+  ******************************************************************************
+  * @file    pcc.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the Predictive Current Control component of the Motor Control SDK:
+  *
+  *           * one step ahead prediction of the stator currents
+  *           * compensation of the computation delay
+  *           * compensation of the dead time and of the device drops
+  *           * finite control set selection of the inverter voltage vector
+  *           * multi-step prediction with branch and bound pruning
+  *           * switching effort penalty
+  *           * modulated predictive control with dwell times
+  *           * run time tuning applied between two control periods
+  *           * fallback to the PI controllers on repeated budget overruns
+  *           * windowed statistics of the decisions
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "pcc.h"
+#include "mc_math.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/**
+  * @defgroup PCC Predictive Current Control
+  * @brief Finite control set predictive current controller of the Motor Control SDK
+  *
+  * The PCC component predicts the stator currents at the next control period for
+  * each voltage vector the inverter can apply, using the discrete model of the
+  * motor in the rotating frame:
+  *
+  * @f[
+  * i_{d}(k+1) = (1 - \frac{R_{s} T_{s}}{L_{s}}) i_{d}(k) + \omega_{e} T_{s} i_{q}(k) + \frac{T_{s}}{L_{s}} v_{d}(k)
+  * @f]
+  * @f[
+  * i_{q}(k+1) = (1 - \frac{R_{s} T_{s}}{L_{s}}) i_{q}(k) - \omega_{e} T_{s} i_{d}(k)
+  *              - \frac{\psi T_{s}}{L_{s}} \omega_{e} + \frac{T_{s}}{L_{s}} v_{q}(k)
+  * @f]
+  *
+  * and selects the vector whose predicted currents are the closest to the reference.
+  * As the selected vector is applied from the next PWM period on, the currents are
+  * first propagated over the current period with the voltage being applied, and
+  * the candidate vectors are evaluated from this predicted state.
+  * When PCC_HORIZON is greater than 1, sequences of vectors are evaluated over the
+  * horizon with the same model written in the stationary frame, and the first
+  * vector of the sequence that minimises the sum of the squared errors is applied.
+  * A penalty proportional to the number of inverter legs that commute can be added
+  * to the cost, in order to trade current ripple against switching losses.
+  * The q and d errors, the switching penalty and a barrier on the predicted
+  * current magnitude are weighted by the entry of a table that the medium
+  * frequency task selects from the speed and the q current, so that the trade
+  * off follows the operating point. The high frequency task reads the entry in
+  * use through one index, without any lookup of its own.
+  * With #PCC_DEADBEAT the model is solved for the voltage that reaches the
+  * reference at the end of the next period, applied by the space vector
+  * modulation: one evaluation of the model per period.
+  * With #PCC_MODULATED the controller applies, within one period, the two active
+  * vectors of a sector and the zero vector, with dwell times inversely
+  * proportional to their costs: the resulting voltage is applied by the space
+  * vector modulation at a fixed switching frequency. With PCC_FULL_HEXAGON the
+  * dwell times are applied as they are, up to the vertices of the hexagon, and
+  * the model is written with the voltage of the vertices.
+  * A disturbance observer adds to the predictions the current step per period
+  * that the model misses, corrected at every period by a share hDistGain of
+  * the error of the currents predicted for it, so that a model error leaves
+  * no steady state offset of the currents. With PCC_STATE_FILTER the
+  * prediction starts from an estimate of the currents, corrected by the same
+  * error with the gain hStateGain, rather than from the measured currents.
+  * With PCC_EXACT_DISCRETISATION the model is the zero order hold one, whose
+  * rotation and back-EMF terms follow the angle covered in one period at the
+  * larger control periods.
+  * The model coefficients are computed at compile time from the motor parameters
+  * (pmsm_motor_parameters.h) and the control rate, so the same component serves
+  * every board.
+  *
+  * @{
+  */
+
+/* Private defines -----------------------------------------------------------*/
+#define PCC_SQRT3_Q13       ((int32_t)14189)  /* sqrt(3) * 8192 */
+#define PCC_ALL_HIGH        ((uint8_t)7)      /* Zero vector with all high side switches on */
+#define PCC_NO_VECTOR       PCC_NB_VECTORS    /* No previous vector to be kept as candidate */
+#define PCC_MAX_SW_COST     (INT32_MAX / 3)   /* Largest cost of one commutation, 3 legs commute at most */
+#define PCC_INFEASIBLE_COST (INT32_MAX / 2)   /* Cost added to a candidate whose predicted current
+                                                 is above hMaxCurr */
+#define PCC_BOUND_MAX_ERROR ((int32_t)16383)  /* Largest error and current step components of the lower
+                                                 bound of PCC_AwayCost(), so that the residual is never
+                                                 saturated */
+#define PCC_BOUND_SLACK     ((int32_t)32)     /* Margin of the lower bound for the rounding of the q/d
+                                                 rotation of the residual, in current digits */
+#define PCC_PACKED_MIN_SCALE ((uint16_t)8192) /* Smallest scale of a weight, Q15, for which the rounding
+                                                 of #PCC_COST_L2_PACKED stays within PCC_BOUND_SLACK */
+#define PCC_PI_Q13          ((int32_t)25736)  /* pi * 8192: rad per control period of 1 dpp, in Q15 */
+#define PCC_DPP_PER_RAD     ((int32_t)10430)  /* 32768 / pi: dpp of an angle of 1 rad per control period */
+#define PCC_HIGH_SHARE_Q15  ((int32_t)28378)  /* sqrt(3)/2: share of the period a high side is on,
+                                                 see PWMC_SetSwitchingState() */
+#define PCC_FLOAT_Q15       ((float_t)3.0517578125e-05f) /* 2^-15, from a Q15 number */
+#define PCC_FLOAT_WEIGHT    ((float_t)0.00390625f) /* 2^-PCC_WEIGHT_POW2, from a weight */
+#define PCC_FLOAT_COST_MAX  ((float_t)2147483520.0f) /* Largest float below 2^31, the cost saturation */
+
+#if (PCC_COST_NORM == PCC_COST_L2_FLOAT) && defined (__GNUC__) && defined (__arm__) && !defined (__ARM_FP)
+#error "PCC_COST_L2_FLOAT requires a build with the FPU, -mfloat-abi=hard or softfp"
+#endif
+
+#ifndef FULL_MISRA_C_COMPLIANCY_PCC
+/* WARNING: the below macro is not MISRA compliant, user should verify that
+            Cortex-M4 assembly instruction ASR (arithmetic shift right) is used
+            by the compiler to perform the shifts (instead of LSR logical shift
+            right) */
+//cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+#define PCC_DIV_POW2(wValue, bShift)  ((wValue) >> (bShift))
+#else
+#define PCC_DIV_POW2(wValue, bShift)  ((wValue) / ((int32_t)1 << (bShift)))
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+  * @brief Current vector of the horizon search, in the alpha/beta frame. The
+  *        components are 32 bits wide as the current targets include the back-EMF
+  *        term and may exceed the int16_t range.
+  */
+typedef struct
+{
+  int32_t wAlpha;
+  int32_t wBeta;
+} PCC_Vector_t;
+
+#if (PCC_COST_NORM == PCC_COST_L2_PACKED)
+/**
+  * @brief Rotation of the residual into the q/d frame of a step with
+  *        #PCC_COST_L2_PACKED: the cosine and sine of the frame times the scale
+  *        of the q weight and of the d weight, the cosine in the low half and
+  *        the sine in the high half, and the weight of both.
+  */
+typedef struct
+{
+  uint32_t wRotQ;
+  uint32_t wRotD;
+  int32_t  wWeight;               /* PCC_PackedScale_t::hMaxWeight, 4 fractional bits */
+} PCC_CostFrame_t;
+#elif (PCC_COST_NORM == PCC_COST_L2_FLOAT)
+/**
+  * @brief Rotation of the residual into the q/d frame of a step with
+  *        #PCC_COST_L2_FLOAT, and the weights of the step, in single precision:
+  *        the operands of the cost of one candidate, read in sequence by the
+  *        multiply-accumulates of the FPU
+  */
+typedef struct
+{
+  float_t fCos;
+  float_t fSin;
+  float_t fQWeight;               /* hQWeight / PCC_WEIGHT_ONE */
+  float_t fDWeight;
+  float_t fLimitWeight;
+} PCC_CostFrame_t;
+#elif (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+/**
+  * @brief Rotation of the residual into the q/d frame of a step with
+  *        #PCC_OBJECTIVE_TORQUE, and the reference of the step: its currents,
+  *        its torque and its squared flux magnitude
+  */
+typedef struct
+{
+  Trig_Components Trig;
+  int32_t wIrefQ;
+  int32_t wIrefD;
+  int64_t lTorqueRef;
+  int64_t lFluxSqRef;
+} PCC_CostFrame_t;
+#else
+/**
+  * @brief Rotation of the residual into the q/d frame of a step: the cosine and
+  *        sine of the frame
+  */
+typedef Trig_Components PCC_CostFrame_t;
+#endif
+
+/**
+  * @brief Vector selected by PCC_CalcVoltage() for the next period: the voltage
+  *        to apply and the current error it leaves at the end of the period, in
+  *        the alpha/beta frame, the cosine and sine of the q/d frame of that
+  *        error, and its cost
+  */
+typedef struct
+{
+  PCC_Vector_t Voltage;
+  PCC_Vector_t Residual;
+  int32_t wCosPred;
+  int32_t wSinPred;
+  int32_t wCost;
+  uint8_t bVector;
+} PCC_Decision_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+/* With CCMRAM, the tables read at each period are in the .ccmram_rodata input section,
+   copied with the code to the CCM SRAM, out of the way of the DMA transfers to the SRAM and
+   of the flash wait states. They are not in .ccmram, that holds the functions of this file:
+   GCC does not mix code and data in the same input section. PCC_VectorDqTable, 6 Kbytes,
+   stays in the flash. */
+
+/**
+  * @brief Inverter switching states of the PCC vector table. Bit 0, 1 and 2 are
+  *        the state of the high side switch of phase A, B and C respectively.
+  *        As MCM_Clarke() defines the beta axis as -(a + 2b) / sqrt(3), the
+  *        vectors are ordered clockwise with respect to the phase sequence.
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram_rodata"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram_rodata")))
+#endif
+#endif
+static const uint8_t PCC_SwitchingStates[PCC_NB_VECTORS] = {1U, 5U, 4U, 6U, 2U, 3U, 0U};
+
+/**
+  * @brief Number of inverter legs that commute, indexed by the exclusive or of
+  *        two switching states.
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram_rodata"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram_rodata")))
+#endif
+#endif
+static const uint8_t PCC_Commutations[8] = {0U, 1U, 1U, 2U, 1U, 2U, 2U, 3U};
+
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+/**
+  * @brief Index in the vector table of the vector with the high side of phase
+  *        A, B and C alone on, that gives the axis of the phase.
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram_rodata"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram_rodata")))
+#endif
+#endif
+static const uint8_t PCC_PhaseAxis[3] = {0U, 4U, 2U};
+#endif
+
+/**
+  * @brief Inverter voltage vectors in the alpha/beta frame, in the order of
+  *        PCC_SwitchingStates. The active vectors are normalised to INT16_MAX,
+  *        the full scale of PWMC_SetPhaseVoltage(), i.e. the bus voltage divided
+  *        by sqrt(3): the scaling to Volts is part of the wKVolt coefficient, so
+  *        the table is the same for every board.
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram_rodata"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram_rodata")))
+#endif
+#endif
+static const alphabeta_t PCC_VectorTable[PCC_NB_VECTORS] =
+{
+  {  32767,      0 },   /* 100:   0 deg */
+  {  16384,  28377 },   /* 101:  60 deg */
+  { -16384,  28377 },   /* 001: 120 deg */
+  { -32767,      0 },   /* 011: 180 deg */
+  { -16384, -28377 },   /* 010: 240 deg */
+  {  16384, -28377 },   /* 110: 300 deg */
+  {      0,      0 },   /* 000: zero vector */
+};
+
+#ifdef PCC_DQ_VECTOR_TABLE
+/**
+  * @brief q/d voltage of the active vector 0 of PCC_VectorTable at the angles
+  *        k * 360 / PCC_DQ_TABLE_SIZE degrees, cosine and sine in units of
+  *        PCC_VectorTable. The active vector i is the entry of the angle plus
+  *        i * 60 degrees.
+  */
+static const qd_t PCC_VectorDqTable[PCC_DQ_TABLE_SIZE] =
+{
+  { 32767,      0 }, { 32767,    134 }, { 32766,    268 }, { 32765,    402 }, { 32763,    536 }, { 32760,    670 },
+  { 32757,    804 }, { 32754,    938 }, { 32749,   1072 }, { 32745,   1206 }, { 32740,   1340 }, { 32734,   1474 },
+  { 32728,   1608 }, { 32721,   1742 }, { 32713,   1875 }, { 32705,   2009 }, { 32697,   2143 }, { 32688,   2277 },
+  { 32678,   2410 }, { 32668,   2544 }, { 32657,   2678 }, { 32646,   2811 }, { 32634,   2945 }, { 32622,   3078 },
+  { 32609,   3212 }, { 32596,   3345 }, { 32582,   3478 }, { 32567,   3612 }, { 32552,   3745 }, { 32537,   3878 },
+  { 32521,   4011 }, { 32504,   4144 }, { 32487,   4277 }, { 32469,   4410 }, { 32451,   4543 }, { 32432,   4675 },
+  { 32412,   4808 }, { 32392,   4940 }, { 32372,   5073 }, { 32351,   5205 }, { 32329,   5338 }, { 32307,   5470 },
+  { 32285,   5602 }, { 32261,   5734 }, { 32238,   5866 }, { 32213,   5998 }, { 32189,   6129 }, { 32163,   6261 },
+  { 32137,   6393 }, { 32111,   6524 }, { 32084,   6655 }, { 32057,   6786 }, { 32028,   6917 }, { 32000,   7048 },
+  { 31971,   7179 }, { 31941,   7310 }, { 31911,   7441 }, { 31880,   7571 }, { 31849,   7701 }, { 31817,   7832 },
+  { 31785,   7962 }, { 31752,   8092 }, { 31719,   8222 }, { 31685,   8351 }, { 31650,   8481 }, { 31616,   8610 },
+  { 31580,   8739 }, { 31544,   8868 }, { 31507,   8997 }, { 31470,   9126 }, { 31433,   9255 }, { 31395,   9383 },
+  { 31356,   9512 }, { 31317,   9640 }, { 31277,   9768 }, { 31237,   9896 }, { 31196,  10024 }, { 31155,  10151 },
+  { 31113,  10278 }, { 31071,  10406 }, { 31028,  10533 }, { 30985,  10659 }, { 30941,  10786 }, { 30896,  10913 },
+  { 30852,  11039 }, { 30806,  11165 }, { 30760,  11291 }, { 30714,  11417 }, { 30667,  11542 }, { 30619,  11668 },
+  { 30571,  11793 }, { 30523,  11918 }, { 30474,  12042 }, { 30424,  12167 }, { 30374,  12291 }, { 30324,  12415 },
+  { 30273,  12539 }, { 30221,  12663 }, { 30169,  12787 }, { 30117,  12910 }, { 30064,  13033 }, { 30010,  13156 },
+  { 29956,  13279 }, { 29901,  13401 }, { 29846,  13523 }, { 29791,  13645 }, { 29735,  13767 }, { 29678,  13888 },
+  { 29621,  14010 }, { 29563,  14131 }, { 29505,  14252 }, { 29447,  14372 }, { 29388,  14492 }, { 29328,  14613 },
+  { 29268,  14732 }, { 29208,  14852 }, { 29147,  14971 }, { 29085,  15090 }, { 29023,  15209 }, { 28961,  15328 },
+  { 28898,  15446 }, { 28834,  15564 }, { 28771,  15682 }, { 28706,  15800 }, { 28641,  15917 }, { 28576,  16034 },
+  { 28510,  16151 }, { 28444,  16267 }, { 28377,  16383 }, { 28310,  16499 }, { 28242,  16615 }, { 28174,  16730 },
+  { 28105,  16846 }, { 28036,  16960 }, { 27966,  17075 }, { 27896,  17189 }, { 27826,  17303 }, { 27755,  17417 },
+  { 27683,  17530 }, { 27611,  17643 }, { 27539,  17756 }, { 27466,  17869 }, { 27393,  17981 }, { 27319,  18093 },
+  { 27245,  18204 }, { 27170,  18316 }, { 27095,  18427 }, { 27019,  18537 }, { 26943,  18648 }, { 26867,  18758 },
+  { 26790,  18868 }, { 26712,  18977 }, { 26635,  19086 }, { 26556,  19195 }, { 26478,  19303 }, { 26398,  19411 },
+  { 26319,  19519 }, { 26239,  19627 }, { 26158,  19734 }, { 26077,  19841 }, { 25996,  19947 }, { 25914,  20053 },
+  { 25832,  20159 }, { 25749,  20265 }, { 25666,  20370 }, { 25582,  20475 }, { 25498,  20579 }, { 25414,  20683 },
+  { 25329,  20787 }, { 25244,  20891 }, { 25158,  20994 }, { 25072,  21096 }, { 24986,  21199 }, { 24899,  21301 },
+  { 24811,  21403 }, { 24724,  21504 }, { 24636,  21605 }, { 24547,  21705 }, { 24458,  21806 }, { 24369,  21905 },
+  { 24279,  22005 }, { 24189,  22104 }, { 24098,  22203 }, { 24007,  22301 }, { 23915,  22399 }, { 23824,  22497 },
+  { 23731,  22594 }, { 23639,  22691 }, { 23546,  22788 }, { 23452,  22884 }, { 23359,  22979 }, { 23264,  23075 },
+  { 23170,  23170 }, { 23075,  23264 }, { 22979,  23359 }, { 22884,  23452 }, { 22788,  23546 }, { 22691,  23639 },
+  { 22594,  23731 }, { 22497,  23824 }, { 22399,  23915 }, { 22301,  24007 }, { 22203,  24098 }, { 22104,  24189 },
+  { 22005,  24279 }, { 21905,  24369 }, { 21806,  24458 }, { 21705,  24547 }, { 21605,  24636 }, { 21504,  24724 },
+  { 21403,  24811 }, { 21301,  24899 }, { 21199,  24986 }, { 21096,  25072 }, { 20994,  25158 }, { 20891,  25244 },
+  { 20787,  25329 }, { 20683,  25414 }, { 20579,  25498 }, { 20475,  25582 }, { 20370,  25666 }, { 20265,  25749 },
+  { 20159,  25832 }, { 20053,  25914 }, { 19947,  25996 }, { 19841,  26077 }, { 19734,  26158 }, { 19627,  26239 },
+  { 19519,  26319 }, { 19411,  26398 }, { 19303,  26478 }, { 19195,  26556 }, { 19086,  26635 }, { 18977,  26712 },
+  { 18868,  26790 }, { 18758,  26867 }, { 18648,  26943 }, { 18537,  27019 }, { 18427,  27095 }, { 18316,  27170 },
+  { 18204,  27245 }, { 18093,  27319 }, { 17981,  27393 }, { 17869,  27466 }, { 17756,  27539 }, { 17643,  27611 },
+  { 17530,  27683 }, { 17417,  27755 }, { 17303,  27826 }, { 17189,  27896 }, { 17075,  27966 }, { 16960,  28036 },
+  { 16846,  28105 }, { 16730,  28174 }, { 16615,  28242 }, { 16499,  28310 }, { 16384,  28377 }, { 16267,  28444 },
+  { 16151,  28510 }, { 16034,  28576 }, { 15917,  28641 }, { 15800,  28706 }, { 15682,  28771 }, { 15564,  28834 },
+  { 15446,  28898 }, { 15328,  28961 }, { 15209,  29023 }, { 15090,  29085 }, { 14971,  29147 }, { 14852,  29208 },
+  { 14732,  29268 }, { 14613,  29328 }, { 14492,  29388 }, { 14372,  29447 }, { 14252,  29505 }, { 14131,  29563 },
+  { 14010,  29621 }, { 13888,  29678 }, { 13767,  29735 }, { 13645,  29791 }, { 13523,  29846 }, { 13401,  29901 },
+  { 13279,  29956 }, { 13156,  30010 }, { 13033,  30064 }, { 12910,  30117 }, { 12787,  30169 }, { 12663,  30221 },
+  { 12539,  30273 }, { 12415,  30324 }, { 12291,  30374 }, { 12167,  30424 }, { 12042,  30474 }, { 11918,  30523 },
+  { 11793,  30571 }, { 11668,  30619 }, { 11542,  30667 }, { 11417,  30714 }, { 11291,  30760 }, { 11165,  30806 },
+  { 11039,  30852 }, { 10913,  30896 }, { 10786,  30941 }, { 10659,  30985 }, { 10533,  31028 }, { 10406,  31071 },
+  { 10278,  31113 }, { 10151,  31155 }, { 10024,  31196 }, {  9896,  31237 }, {  9768,  31277 }, {  9640,  31317 },
+  {  9512,  31356 }, {  9383,  31395 }, {  9255,  31433 }, {  9126,  31470 }, {  8997,  31507 }, {  8868,  31544 },
+  {  8739,  31580 }, {  8610,  31616 }, {  8481,  31650 }, {  8351,  31685 }, {  8222,  31719 }, {  8092,  31752 },
+  {  7962,  31785 }, {  7832,  31817 }, {  7701,  31849 }, {  7571,  31880 }, {  7441,  31911 }, {  7310,  31941 },
+  {  7179,  31971 }, {  7048,  32000 }, {  6917,  32028 }, {  6786,  32057 }, {  6655,  32084 }, {  6524,  32111 },
+  {  6393,  32137 }, {  6261,  32163 }, {  6129,  32189 }, {  5998,  32213 }, {  5866,  32238 }, {  5734,  32261 },
+  {  5602,  32285 }, {  5470,  32307 }, {  5338,  32329 }, {  5205,  32351 }, {  5073,  32372 }, {  4940,  32392 },
+  {  4808,  32412 }, {  4675,  32432 }, {  4543,  32451 }, {  4410,  32469 }, {  4277,  32487 }, {  4144,  32504 },
+  {  4011,  32521 }, {  3878,  32537 }, {  3745,  32552 }, {  3612,  32567 }, {  3478,  32582 }, {  3345,  32596 },
+  {  3212,  32609 }, {  3078,  32622 }, {  2945,  32634 }, {  2811,  32646 }, {  2678,  32657 }, {  2544,  32668 },
+  {  2410,  32678 }, {  2277,  32688 }, {  2143,  32697 }, {  2009,  32705 }, {  1875,  32713 }, {  1742,  32721 },
+  {  1608,  32728 }, {  1474,  32734 }, {  1340,  32740 }, {  1206,  32745 }, {  1072,  32749 }, {   938,  32754 },
+  {   804,  32757 }, {   670,  32760 }, {   536,  32763 }, {   402,  32765 }, {   268,  32766 }, {   134,  32767 },
+  {     0,  32767 }, {  -134,  32767 }, {  -268,  32766 }, {  -402,  32765 }, {  -536,  32763 }, {  -670,  32760 },
+  {  -804,  32757 }, {  -938,  32754 }, { -1072,  32749 }, { -1206,  32745 }, { -1340,  32740 }, { -1474,  32734 },
+  { -1608,  32728 }, { -1742,  32721 }, { -1875,  32713 }, { -2009,  32705 }, { -2143,  32697 }, { -2277,  32688 },
+  { -2410,  32678 }, { -2544,  32668 }, { -2678,  32657 }, { -2811,  32646 }, { -2945,  32634 }, { -3078,  32622 },
+  { -3212,  32609 }, { -3345,  32596 }, { -3478,  32582 }, { -3612,  32567 }, { -3745,  32552 }, { -3878,  32537 },
+  { -4011,  32521 }, { -4144,  32504 }, { -4277,  32487 }, { -4410,  32469 }, { -4543,  32451 }, { -4675,  32432 },
+  { -4808,  32412 }, { -4940,  32392 }, { -5073,  32372 }, { -5205,  32351 }, { -5338,  32329 }, { -5470,  32307 },
+  { -5602,  32285 }, { -5734,  32261 }, { -5866,  32238 }, { -5998,  32213 }, { -6129,  32189 }, { -6261,  32163 },
+  { -6393,  32137 }, { -6524,  32111 }, { -6655,  32084 }, { -6786,  32057 }, { -6917,  32028 }, { -7048,  32000 },
+  { -7179,  31971 }, { -7310,  31941 }, { -7441,  31911 }, { -7571,  31880 }, { -7701,  31849 }, { -7832,  31817 },
+  { -7962,  31785 }, { -8092,  31752 }, { -8222,  31719 }, { -8351,  31685 }, { -8481,  31650 }, { -8610,  31616 },
+  { -8739,  31580 }, { -8868,  31544 }, { -8997,  31507 }, { -9126,  31470 }, { -9255,  31433 }, { -9383,  31395 },
+  { -9512,  31356 }, { -9640,  31317 }, { -9768,  31277 }, { -9896,  31237 }, {-10024,  31196 }, {-10151,  31155 },
+  {-10278,  31113 }, {-10406,  31071 }, {-10533,  31028 }, {-10659,  30985 }, {-10786,  30941 }, {-10913,  30896 },
+  {-11039,  30852 }, {-11165,  30806 }, {-11291,  30760 }, {-11417,  30714 }, {-11542,  30667 }, {-11668,  30619 },
+  {-11793,  30571 }, {-11918,  30523 }, {-12042,  30474 }, {-12167,  30424 }, {-12291,  30374 }, {-12415,  30324 },
+  {-12539,  30273 }, {-12663,  30221 }, {-12787,  30169 }, {-12910,  30117 }, {-13033,  30064 }, {-13156,  30010 },
+  {-13279,  29956 }, {-13401,  29901 }, {-13523,  29846 }, {-13645,  29791 }, {-13767,  29735 }, {-13888,  29678 },
+  {-14010,  29621 }, {-14131,  29563 }, {-14252,  29505 }, {-14372,  29447 }, {-14492,  29388 }, {-14613,  29328 },
+  {-14732,  29268 }, {-14852,  29208 }, {-14971,  29147 }, {-15090,  29085 }, {-15209,  29023 }, {-15328,  28961 },
+  {-15446,  28898 }, {-15564,  28834 }, {-15682,  28771 }, {-15800,  28706 }, {-15917,  28641 }, {-16034,  28576 },
+  {-16151,  28510 }, {-16267,  28444 }, {-16383,  28377 }, {-16499,  28310 }, {-16615,  28242 }, {-16730,  28174 },
+  {-16846,  28105 }, {-16960,  28036 }, {-17075,  27966 }, {-17189,  27896 }, {-17303,  27826 }, {-17417,  27755 },
+  {-17530,  27683 }, {-17643,  27611 }, {-17756,  27539 }, {-17869,  27466 }, {-17981,  27393 }, {-18093,  27319 },
+  {-18204,  27245 }, {-18316,  27170 }, {-18427,  27095 }, {-18537,  27019 }, {-18648,  26943 }, {-18758,  26867 },
+  {-18868,  26790 }, {-18977,  26712 }, {-19086,  26635 }, {-19195,  26556 }, {-19303,  26478 }, {-19411,  26398 },
+  {-19519,  26319 }, {-19627,  26239 }, {-19734,  26158 }, {-19841,  26077 }, {-19947,  25996 }, {-20053,  25914 },
+  {-20159,  25832 }, {-20265,  25749 }, {-20370,  25666 }, {-20475,  25582 }, {-20579,  25498 }, {-20683,  25414 },
+  {-20787,  25329 }, {-20891,  25244 }, {-20994,  25158 }, {-21096,  25072 }, {-21199,  24986 }, {-21301,  24899 },
+  {-21403,  24811 }, {-21504,  24724 }, {-21605,  24636 }, {-21705,  24547 }, {-21806,  24458 }, {-21905,  24369 },
+  {-22005,  24279 }, {-22104,  24189 }, {-22203,  24098 }, {-22301,  24007 }, {-22399,  23915 }, {-22497,  23824 },
+  {-22594,  23731 }, {-22691,  23639 }, {-22788,  23546 }, {-22884,  23452 }, {-22979,  23359 }, {-23075,  23264 },
+  {-23170,  23170 }, {-23264,  23075 }, {-23359,  22979 }, {-23452,  22884 }, {-23546,  22788 }, {-23639,  22691 },
+  {-23731,  22594 }, {-23824,  22497 }, {-23915,  22399 }, {-24007,  22301 }, {-24098,  22203 }, {-24189,  22104 },
+  {-24279,  22005 }, {-24369,  21905 }, {-24458,  21806 }, {-24547,  21705 }, {-24636,  21605 }, {-24724,  21504 },
+  {-24811,  21403 }, {-24899,  21301 }, {-24986,  21199 }, {-25072,  21096 }, {-25158,  20994 }, {-25244,  20891 },
+  {-25329,  20787 }, {-25414,  20683 }, {-25498,  20579 }, {-25582,  20475 }, {-25666,  20370 }, {-25749,  20265 },
+  {-25832,  20159 }, {-25914,  20053 }, {-25996,  19947 }, {-26077,  19841 }, {-26158,  19734 }, {-26239,  19627 },
+  {-26319,  19519 }, {-26398,  19411 }, {-26478,  19303 }, {-26556,  19195 }, {-26635,  19086 }, {-26712,  18977 },
+  {-26790,  18868 }, {-26867,  18758 }, {-26943,  18648 }, {-27019,  18537 }, {-27095,  18427 }, {-27170,  18316 },
+  {-27245,  18204 }, {-27319,  18093 }, {-27393,  17981 }, {-27466,  17869 }, {-27539,  17756 }, {-27611,  17643 },
+  {-27683,  17530 }, {-27755,  17417 }, {-27826,  17303 }, {-27896,  17189 }, {-27966,  17075 }, {-28036,  16960 },
+  {-28105,  16846 }, {-28174,  16730 }, {-28242,  16615 }, {-28310,  16499 }, {-28377,  16383 }, {-28444,  16267 },
+  {-28510,  16151 }, {-28576,  16034 }, {-28641,  15917 }, {-28706,  15800 }, {-28771,  15682 }, {-28834,  15564 },
+  {-28898,  15446 }, {-28961,  15328 }, {-29023,  15209 }, {-29085,  15090 }, {-29147,  14971 }, {-29208,  14852 },
+  {-29268,  14732 }, {-29328,  14613 }, {-29388,  14492 }, {-29447,  14372 }, {-29505,  14252 }, {-29563,  14131 },
+  {-29621,  14010 }, {-29678,  13888 }, {-29735,  13767 }, {-29791,  13645 }, {-29846,  13523 }, {-29901,  13401 },
+  {-29956,  13279 }, {-30010,  13156 }, {-30064,  13033 }, {-30117,  12910 }, {-30169,  12787 }, {-30221,  12663 },
+  {-30273,  12539 }, {-30324,  12415 }, {-30374,  12291 }, {-30424,  12167 }, {-30474,  12042 }, {-30523,  11918 },
+  {-30571,  11793 }, {-30619,  11668 }, {-30667,  11542 }, {-30714,  11417 }, {-30760,  11291 }, {-30806,  11165 },
+  {-30852,  11039 }, {-30896,  10913 }, {-30941,  10786 }, {-30985,  10659 }, {-31028,  10533 }, {-31071,  10406 },
+  {-31113,  10278 }, {-31155,  10151 }, {-31196,  10024 }, {-31237,   9896 }, {-31277,   9768 }, {-31317,   9640 },
+  {-31356,   9512 }, {-31395,   9383 }, {-31433,   9255 }, {-31470,   9126 }, {-31507,   8997 }, {-31544,   8868 },
+  {-31580,   8739 }, {-31616,   8610 }, {-31650,   8481 }, {-31685,   8351 }, {-31719,   8222 }, {-31752,   8092 },
+  {-31785,   7962 }, {-31817,   7832 }, {-31849,   7701 }, {-31880,   7571 }, {-31911,   7441 }, {-31941,   7310 },
+  {-31971,   7179 }, {-32000,   7048 }, {-32028,   6917 }, {-32057,   6786 }, {-32084,   6655 }, {-32111,   6524 },
+  {-32137,   6393 }, {-32163,   6261 }, {-32189,   6129 }, {-32213,   5998 }, {-32238,   5866 }, {-32261,   5734 },
+  {-32285,   5602 }, {-32307,   5470 }, {-32329,   5338 }, {-32351,   5205 }, {-32372,   5073 }, {-32392,   4940 },
+  {-32412,   4808 }, {-32432,   4675 }, {-32451,   4543 }, {-32469,   4410 }, {-32487,   4277 }, {-32504,   4144 },
+  {-32521,   4011 }, {-32537,   3878 }, {-32552,   3745 }, {-32567,   3612 }, {-32582,   3478 }, {-32596,   3345 },
+  {-32609,   3212 }, {-32622,   3078 }, {-32634,   2945 }, {-32646,   2811 }, {-32657,   2678 }, {-32668,   2544 },
+  {-32678,   2410 }, {-32688,   2277 }, {-32697,   2143 }, {-32705,   2009 }, {-32713,   1875 }, {-32721,   1742 },
+  {-32728,   1608 }, {-32734,   1474 }, {-32740,   1340 }, {-32745,   1206 }, {-32749,   1072 }, {-32754,    938 },
+  {-32757,    804 }, {-32760,    670 }, {-32763,    536 }, {-32765,    402 }, {-32766,    268 }, {-32767,    134 },
+  {-32767,      0 }, {-32767,   -134 }, {-32766,   -268 }, {-32765,   -402 }, {-32763,   -536 }, {-32760,   -670 },
+  {-32757,   -804 }, {-32754,   -938 }, {-32749,  -1072 }, {-32745,  -1206 }, {-32740,  -1340 }, {-32734,  -1474 },
+  {-32728,  -1608 }, {-32721,  -1742 }, {-32713,  -1875 }, {-32705,  -2009 }, {-32697,  -2143 }, {-32688,  -2277 },
+  {-32678,  -2410 }, {-32668,  -2544 }, {-32657,  -2678 }, {-32646,  -2811 }, {-32634,  -2945 }, {-32622,  -3078 },
+  {-32609,  -3212 }, {-32596,  -3345 }, {-32582,  -3478 }, {-32567,  -3612 }, {-32552,  -3745 }, {-32537,  -3878 },
+  {-32521,  -4011 }, {-32504,  -4144 }, {-32487,  -4277 }, {-32469,  -4410 }, {-32451,  -4543 }, {-32432,  -4675 },
+  {-32412,  -4808 }, {-32392,  -4940 }, {-32372,  -5073 }, {-32351,  -5205 }, {-32329,  -5338 }, {-32307,  -5470 },
+  {-32285,  -5602 }, {-32261,  -5734 }, {-32238,  -5866 }, {-32213,  -5998 }, {-32189,  -6129 }, {-32163,  -6261 },
+  {-32137,  -6393 }, {-32111,  -6524 }, {-32084,  -6655 }, {-32057,  -6786 }, {-32028,  -6917 }, {-32000,  -7048 },
+  {-31971,  -7179 }, {-31941,  -7310 }, {-31911,  -7441 }, {-31880,  -7571 }, {-31849,  -7701 }, {-31817,  -7832 },
+  {-31785,  -7962 }, {-31752,  -8092 }, {-31719,  -8222 }, {-31685,  -8351 }, {-31650,  -8481 }, {-31616,  -8610 },
+  {-31580,  -8739 }, {-31544,  -8868 }, {-31507,  -8997 }, {-31470,  -9126 }, {-31433,  -9255 }, {-31395,  -9383 },
+  {-31356,  -9512 }, {-31317,  -9640 }, {-31277,  -9768 }, {-31237,  -9896 }, {-31196, -10024 }, {-31155, -10151 },
+  {-31113, -10278 }, {-31071, -10406 }, {-31028, -10533 }, {-30985, -10659 }, {-30941, -10786 }, {-30896, -10913 },
+  {-30852, -11039 }, {-30806, -11165 }, {-30760, -11291 }, {-30714, -11417 }, {-30667, -11542 }, {-30619, -11668 },
+  {-30571, -11793 }, {-30523, -11918 }, {-30474, -12042 }, {-30424, -12167 }, {-30374, -12291 }, {-30324, -12415 },
+  {-30273, -12539 }, {-30221, -12663 }, {-30169, -12787 }, {-30117, -12910 }, {-30064, -13033 }, {-30010, -13156 },
+  {-29956, -13279 }, {-29901, -13401 }, {-29846, -13523 }, {-29791, -13645 }, {-29735, -13767 }, {-29678, -13888 },
+  {-29621, -14010 }, {-29563, -14131 }, {-29505, -14252 }, {-29447, -14372 }, {-29388, -14492 }, {-29328, -14613 },
+  {-29268, -14732 }, {-29208, -14852 }, {-29147, -14971 }, {-29085, -15090 }, {-29023, -15209 }, {-28961, -15328 },
+  {-28898, -15446 }, {-28834, -15564 }, {-28771, -15682 }, {-28706, -15800 }, {-28641, -15917 }, {-28576, -16034 },
+  {-28510, -16151 }, {-28444, -16267 }, {-28377, -16383 }, {-28310, -16499 }, {-28242, -16615 }, {-28174, -16730 },
+  {-28105, -16846 }, {-28036, -16960 }, {-27966, -17075 }, {-27896, -17189 }, {-27826, -17303 }, {-27755, -17417 },
+  {-27683, -17530 }, {-27611, -17643 }, {-27539, -17756 }, {-27466, -17869 }, {-27393, -17981 }, {-27319, -18093 },
+  {-27245, -18204 }, {-27170, -18316 }, {-27095, -18427 }, {-27019, -18537 }, {-26943, -18648 }, {-26867, -18758 },
+  {-26790, -18868 }, {-26712, -18977 }, {-26635, -19086 }, {-26556, -19195 }, {-26478, -19303 }, {-26398, -19411 },
+  {-26319, -19519 }, {-26239, -19627 }, {-26158, -19734 }, {-26077, -19841 }, {-25996, -19947 }, {-25914, -20053 },
+  {-25832, -20159 }, {-25749, -20265 }, {-25666, -20370 }, {-25582, -20475 }, {-25498, -20579 }, {-25414, -20683 },
+  {-25329, -20787 }, {-25244, -20891 }, {-25158, -20994 }, {-25072, -21096 }, {-24986, -21199 }, {-24899, -21301 },
+  {-24811, -21403 }, {-24724, -21504 }, {-24636, -21605 }, {-24547, -21705 }, {-24458, -21806 }, {-24369, -21905 },
+  {-24279, -22005 }, {-24189, -22104 }, {-24098, -22203 }, {-24007, -22301 }, {-23915, -22399 }, {-23824, -22497 },
+  {-23731, -22594 }, {-23639, -22691 }, {-23546, -22788 }, {-23452, -22884 }, {-23359, -22979 }, {-23264, -23075 },
+  {-23170, -23170 }, {-23075, -23264 }, {-22979, -23359 }, {-22884, -23452 }, {-22788, -23546 }, {-22691, -23639 },
+  {-22594, -23731 }, {-22497, -23824 }, {-22399, -23915 }, {-22301, -24007 }, {-22203, -24098 }, {-22104, -24189 },
+  {-22005, -24279 }, {-21905, -24369 }, {-21806, -24458 }, {-21705, -24547 }, {-21605, -24636 }, {-21504, -24724 },
+  {-21403, -24811 }, {-21301, -24899 }, {-21199, -24986 }, {-21096, -25072 }, {-20994, -25158 }, {-20891, -25244 },
+  {-20787, -25329 }, {-20683, -25414 }, {-20579, -25498 }, {-20475, -25582 }, {-20370, -25666 }, {-20265, -25749 },
+  {-20159, -25832 }, {-20053, -25914 }, {-19947, -25996 }, {-19841, -26077 }, {-19734, -26158 }, {-19627, -26239 },
+  {-19519, -26319 }, {-19411, -26398 }, {-19303, -26478 }, {-19195, -26556 }, {-19086, -26635 }, {-18977, -26712 },
+  {-18868, -26790 }, {-18758, -26867 }, {-18648, -26943 }, {-18537, -27019 }, {-18427, -27095 }, {-18316, -27170 },
+  {-18204, -27245 }, {-18093, -27319 }, {-17981, -27393 }, {-17869, -27466 }, {-17756, -27539 }, {-17643, -27611 },
+  {-17530, -27683 }, {-17417, -27755 }, {-17303, -27826 }, {-17189, -27896 }, {-17075, -27966 }, {-16960, -28036 },
+  {-16846, -28105 }, {-16730, -28174 }, {-16615, -28242 }, {-16499, -28310 }, {-16384, -28377 }, {-16267, -28444 },
+  {-16151, -28510 }, {-16034, -28576 }, {-15917, -28641 }, {-15800, -28706 }, {-15682, -28771 }, {-15564, -28834 },
+  {-15446, -28898 }, {-15328, -28961 }, {-15209, -29023 }, {-15090, -29085 }, {-14971, -29147 }, {-14852, -29208 },
+  {-14732, -29268 }, {-14613, -29328 }, {-14492, -29388 }, {-14372, -29447 }, {-14252, -29505 }, {-14131, -29563 },
+  {-14010, -29621 }, {-13888, -29678 }, {-13767, -29735 }, {-13645, -29791 }, {-13523, -29846 }, {-13401, -29901 },
+  {-13279, -29956 }, {-13156, -30010 }, {-13033, -30064 }, {-12910, -30117 }, {-12787, -30169 }, {-12663, -30221 },
+  {-12539, -30273 }, {-12415, -30324 }, {-12291, -30374 }, {-12167, -30424 }, {-12042, -30474 }, {-11918, -30523 },
+  {-11793, -30571 }, {-11668, -30619 }, {-11542, -30667 }, {-11417, -30714 }, {-11291, -30760 }, {-11165, -30806 },
+  {-11039, -30852 }, {-10913, -30896 }, {-10786, -30941 }, {-10659, -30985 }, {-10533, -31028 }, {-10406, -31071 },
+  {-10278, -31113 }, {-10151, -31155 }, {-10024, -31196 }, { -9896, -31237 }, { -9768, -31277 }, { -9640, -31317 },
+  { -9512, -31356 }, { -9383, -31395 }, { -9255, -31433 }, { -9126, -31470 }, { -8997, -31507 }, { -8868, -31544 },
+  { -8739, -31580 }, { -8610, -31616 }, { -8481, -31650 }, { -8351, -31685 }, { -8222, -31719 }, { -8092, -31752 },
+  { -7962, -31785 }, { -7832, -31817 }, { -7701, -31849 }, { -7571, -31880 }, { -7441, -31911 }, { -7310, -31941 },
+  { -7179, -31971 }, { -7048, -32000 }, { -6917, -32028 }, { -6786, -32057 }, { -6655, -32084 }, { -6524, -32111 },
+  { -6393, -32137 }, { -6261, -32163 }, { -6129, -32189 }, { -5998, -32213 }, { -5866, -32238 }, { -5734, -32261 },
+  { -5602, -32285 }, { -5470, -32307 }, { -5338, -32329 }, { -5205, -32351 }, { -5073, -32372 }, { -4940, -32392 },
+  { -4808, -32412 }, { -4675, -32432 }, { -4543, -32451 }, { -4410, -32469 }, { -4277, -32487 }, { -4144, -32504 },
+  { -4011, -32521 }, { -3878, -32537 }, { -3745, -32552 }, { -3612, -32567 }, { -3478, -32582 }, { -3345, -32596 },
+  { -3212, -32609 }, { -3078, -32622 }, { -2945, -32634 }, { -2811, -32646 }, { -2678, -32657 }, { -2544, -32668 },
+  { -2410, -32678 }, { -2277, -32688 }, { -2143, -32697 }, { -2009, -32705 }, { -1875, -32713 }, { -1742, -32721 },
+  { -1608, -32728 }, { -1474, -32734 }, { -1340, -32740 }, { -1206, -32745 }, { -1072, -32749 }, {  -938, -32754 },
+  {  -804, -32757 }, {  -670, -32760 }, {  -536, -32763 }, {  -402, -32765 }, {  -268, -32766 }, {  -134, -32767 },
+  {     0, -32767 }, {   134, -32767 }, {   268, -32766 }, {   402, -32765 }, {   536, -32763 }, {   670, -32760 },
+  {   804, -32757 }, {   938, -32754 }, {  1072, -32749 }, {  1206, -32745 }, {  1340, -32740 }, {  1474, -32734 },
+  {  1608, -32728 }, {  1742, -32721 }, {  1875, -32713 }, {  2009, -32705 }, {  2143, -32697 }, {  2277, -32688 },
+  {  2410, -32678 }, {  2544, -32668 }, {  2678, -32657 }, {  2811, -32646 }, {  2945, -32634 }, {  3078, -32622 },
+  {  3212, -32609 }, {  3345, -32596 }, {  3478, -32582 }, {  3612, -32567 }, {  3745, -32552 }, {  3878, -32537 },
+  {  4011, -32521 }, {  4144, -32504 }, {  4277, -32487 }, {  4410, -32469 }, {  4543, -32451 }, {  4675, -32432 },
+  {  4808, -32412 }, {  4940, -32392 }, {  5073, -32372 }, {  5205, -32351 }, {  5338, -32329 }, {  5470, -32307 },
+  {  5602, -32285 }, {  5734, -32261 }, {  5866, -32238 }, {  5998, -32213 }, {  6129, -32189 }, {  6261, -32163 },
+  {  6393, -32137 }, {  6524, -32111 }, {  6655, -32084 }, {  6786, -32057 }, {  6917, -32028 }, {  7048, -32000 },
+  {  7179, -31971 }, {  7310, -31941 }, {  7441, -31911 }, {  7571, -31880 }, {  7701, -31849 }, {  7832, -31817 },
+  {  7962, -31785 }, {  8092, -31752 }, {  8222, -31719 }, {  8351, -31685 }, {  8481, -31650 }, {  8610, -31616 },
+  {  8739, -31580 }, {  8868, -31544 }, {  8997, -31507 }, {  9126, -31470 }, {  9255, -31433 }, {  9383, -31395 },
+  {  9512, -31356 }, {  9640, -31317 }, {  9768, -31277 }, {  9896, -31237 }, { 10024, -31196 }, { 10151, -31155 },
+  { 10278, -31113 }, { 10406, -31071 }, { 10533, -31028 }, { 10659, -30985 }, { 10786, -30941 }, { 10913, -30896 },
+  { 11039, -30852 }, { 11165, -30806 }, { 11291, -30760 }, { 11417, -30714 }, { 11542, -30667 }, { 11668, -30619 },
+  { 11793, -30571 }, { 11918, -30523 }, { 12042, -30474 }, { 12167, -30424 }, { 12291, -30374 }, { 12415, -30324 },
+  { 12539, -30273 }, { 12663, -30221 }, { 12787, -30169 }, { 12910, -30117 }, { 13033, -30064 }, { 13156, -30010 },
+  { 13279, -29956 }, { 13401, -29901 }, { 13523, -29846 }, { 13645, -29791 }, { 13767, -29735 }, { 13888, -29678 },
+  { 14010, -29621 }, { 14131, -29563 }, { 14252, -29505 }, { 14372, -29447 }, { 14492, -29388 }, { 14613, -29328 },
+  { 14732, -29268 }, { 14852, -29208 }, { 14971, -29147 }, { 15090, -29085 }, { 15209, -29023 }, { 15328, -28961 },
+  { 15446, -28898 }, { 15564, -28834 }, { 15682, -28771 }, { 15800, -28706 }, { 15917, -28641 }, { 16034, -28576 },
+  { 16151, -28510 }, { 16267, -28444 }, { 16384, -28377 }, { 16499, -28310 }, { 16615, -28242 }, { 16730, -28174 },
+  { 16846, -28105 }, { 16960, -28036 }, { 17075, -27966 }, { 17189, -27896 }, { 17303, -27826 }, { 17417, -27755 },
+  { 17530, -27683 }, { 17643, -27611 }, { 17756, -27539 }, { 17869, -27466 }, { 17981, -27393 }, { 18093, -27319 },
+  { 18204, -27245 }, { 18316, -27170 }, { 18427, -27095 }, { 18537, -27019 }, { 18648, -26943 }, { 18758, -26867 },
+  { 18868, -26790 }, { 18977, -26712 }, { 19086, -26635 }, { 19195, -26556 }, { 19303, -26478 }, { 19411, -26398 },
+  { 19519, -26319 }, { 19627, -26239 }, { 19734, -26158 }, { 19841, -26077 }, { 19947, -25996 }, { 20053, -25914 },
+  { 20159, -25832 }, { 20265, -25749 }, { 20370, -25666 }, { 20475, -25582 }, { 20579, -25498 }, { 20683, -25414 },
+  { 20787, -25329 }, { 20891, -25244 }, { 20994, -25158 }, { 21096, -25072 }, { 21199, -24986 }, { 21301, -24899 },
+  { 21403, -24811 }, { 21504, -24724 }, { 21605, -24636 }, { 21705, -24547 }, { 21806, -24458 }, { 21905, -24369 },
+  { 22005, -24279 }, { 22104, -24189 }, { 22203, -24098 }, { 22301, -24007 }, { 22399, -23915 }, { 22497, -23824 },
+  { 22594, -23731 }, { 22691, -23639 }, { 22788, -23546 }, { 22884, -23452 }, { 22979, -23359 }, { 23075, -23264 },
+  { 23170, -23170 }, { 23264, -23075 }, { 23359, -22979 }, { 23452, -22884 }, { 23546, -22788 }, { 23639, -22691 },
+  { 23731, -22594 }, { 23824, -22497 }, { 23915, -22399 }, { 24007, -22301 }, { 24098, -22203 }, { 24189, -22104 },
+  { 24279, -22005 }, { 24369, -21905 }, { 24458, -21806 }, { 24547, -21705 }, { 24636, -21605 }, { 24724, -21504 },
+  { 24811, -21403 }, { 24899, -21301 }, { 24986, -21199 }, { 25072, -21096 }, { 25158, -20994 }, { 25244, -20891 },
+  { 25329, -20787 }, { 25414, -20683 }, { 25498, -20579 }, { 25582, -20475 }, { 25666, -20370 }, { 25749, -20265 },
+  { 25832, -20159 }, { 25914, -20053 }, { 25996, -19947 }, { 26077, -19841 }, { 26158, -19734 }, { 26239, -19627 },
+  { 26319, -19519 }, { 26398, -19411 }, { 26478, -19303 }, { 26556, -19195 }, { 26635, -19086 }, { 26712, -18977 },
+  { 26790, -18868 }, { 26867, -18758 }, { 26943, -18648 }, { 27019, -18537 }, { 27095, -18427 }, { 27170, -18316 },
+  { 27245, -18204 }, { 27319, -18093 }, { 27393, -17981 }, { 27466, -17869 }, { 27539, -17756 }, { 27611, -17643 },
+  { 27683, -17530 }, { 27755, -17417 }, { 27826, -17303 }, { 27896, -17189 }, { 27966, -17075 }, { 28036, -16960 },
+  { 28105, -16846 }, { 28174, -16730 }, { 28242, -16615 }, { 28310, -16499 }, { 28377, -16384 }, { 28444, -16267 },
+  { 28510, -16151 }, { 28576, -16034 }, { 28641, -15917 }, { 28706, -15800 }, { 28771, -15682 }, { 28834, -15564 },
+  { 28898, -15446 }, { 28961, -15328 }, { 29023, -15209 }, { 29085, -15090 }, { 29147, -14971 }, { 29208, -14852 },
+  { 29268, -14732 }, { 29328, -14613 }, { 29388, -14492 }, { 29447, -14372 }, { 29505, -14252 }, { 29563, -14131 },
+  { 29621, -14010 }, { 29678, -13888 }, { 29735, -13767 }, { 29791, -13645 }, { 29846, -13523 }, { 29901, -13401 },
+  { 29956, -13279 }, { 30010, -13156 }, { 30064, -13033 }, { 30117, -12910 }, { 30169, -12787 }, { 30221, -12663 },
+  { 30273, -12539 }, { 30324, -12415 }, { 30374, -12291 }, { 30424, -12167 }, { 30474, -12042 }, { 30523, -11918 },
+  { 30571, -11793 }, { 30619, -11668 }, { 30667, -11542 }, { 30714, -11417 }, { 30760, -11291 }, { 30806, -11165 },
+  { 30852, -11039 }, { 30896, -10913 }, { 30941, -10786 }, { 30985, -10659 }, { 31028, -10533 }, { 31071, -10406 },
+  { 31113, -10278 }, { 31155, -10151 }, { 31196, -10024 }, { 31237,  -9896 }, { 31277,  -9768 }, { 31317,  -9640 },
+  { 31356,  -9512 }, { 31395,  -9383 }, { 31433,  -9255 }, { 31470,  -9126 }, { 31507,  -8997 }, { 31544,  -8868 },
+  { 31580,  -8739 }, { 31616,  -8610 }, { 31650,  -8481 }, { 31685,  -8351 }, { 31719,  -8222 }, { 31752,  -8092 },
+  { 31785,  -7962 }, { 31817,  -7832 }, { 31849,  -7701 }, { 31880,  -7571 }, { 31911,  -7441 }, { 31941,  -7310 },
+  { 31971,  -7179 }, { 32000,  -7048 }, { 32028,  -6917 }, { 32057,  -6786 }, { 32084,  -6655 }, { 32111,  -6524 },
+  { 32137,  -6393 }, { 32163,  -6261 }, { 32189,  -6129 }, { 32213,  -5998 }, { 32238,  -5866 }, { 32261,  -5734 },
+  { 32285,  -5602 }, { 32307,  -5470 }, { 32329,  -5338 }, { 32351,  -5205 }, { 32372,  -5073 }, { 32392,  -4940 },
+  { 32412,  -4808 }, { 32432,  -4675 }, { 32451,  -4543 }, { 32469,  -4410 }, { 32487,  -4277 }, { 32504,  -4144 },
+  { 32521,  -4011 }, { 32537,  -3878 }, { 32552,  -3745 }, { 32567,  -3612 }, { 32582,  -3478 }, { 32596,  -3345 },
+  { 32609,  -3212 }, { 32622,  -3078 }, { 32634,  -2945 }, { 32646,  -2811 }, { 32657,  -2678 }, { 32668,  -2544 },
+  { 32678,  -2410 }, { 32688,  -2277 }, { 32697,  -2143 }, { 32705,  -2009 }, { 32713,  -1875 }, { 32721,  -1742 },
+  { 32728,  -1608 }, { 32734,  -1474 }, { 32740,  -1340 }, { 32745,  -1206 }, { 32749,  -1072 }, { 32754,   -938 },
+  { 32757,   -804 }, { 32760,   -670 }, { 32763,   -536 }, { 32765,   -402 }, { 32766,   -268 }, { 32767,   -134 }
+};
+
+/**
+  * @brief  It returns the angle of PCC_VectorDqTable below 45 degrees whose
+  *         sine is the nearest to a sine, searched by bisection
+  * @param  wSine: sine of the angle, from 0 to the sine of 45 degrees
+  * @retval uint32_t Index of the angle in PCC_VectorDqTable
+  */
+static uint32_t PCC_SearchDqOctant(int32_t wSine)
+{
+  uint32_t wLow = 0U;
+  uint32_t wHigh = PCC_DQ_TABLE_SIZE / 8U;
+
+  while ((wHigh - wLow) > 1U)
+  {
+    uint32_t wMiddle = (wLow + wHigh) >> 1;
+
+    if ((int32_t)PCC_VectorDqTable[wMiddle].d <= wSine)
+    {
+      wLow = wMiddle;
+    }
+    else
+    {
+      wHigh = wMiddle;
+    }
+  }
+  return (((wSine - (int32_t)PCC_VectorDqTable[wLow].d) > ((int32_t)PCC_VectorDqTable[wHigh].d - wSine))
+          ? wHigh : wLow);
+}
+
+/**
+  * @brief  It returns the angle of PCC_VectorDqTable nearest to the electrical
+  *         angle of a sine and cosine, without multiplication: the angle is
+  *         turned into the first quadrant by steps of 90 degrees, and the
+  *         smaller of its sine and cosine is searched in the first octant of
+  *         the table
+  * @param  Trig: cosine and sine of the electrical angle
+  * @retval uint32_t Index of the angle in PCC_VectorDqTable
+  */
+static inline uint32_t PCC_GetDqTableIndex(Trig_Components Trig)
+{
+  int32_t wCos;
+  int32_t wSin;
+  uint32_t wIndex;
+
+  if ((Trig.hCos > 0) && (Trig.hSin >= 0))
+  {
+    wCos = (int32_t)Trig.hCos;
+    wSin = (int32_t)Trig.hSin;
+    wIndex = 0U;
+  }
+  else if ((Trig.hCos <= 0) && (Trig.hSin > 0))
+  {
+    wCos = (int32_t)Trig.hSin;
+    wSin = -(int32_t)Trig.hCos;
+    wIndex = PCC_DQ_TABLE_SIZE / 4U;
+  }
+  else if ((Trig.hCos < 0) && (Trig.hSin <= 0))
+  {
+    wCos = -(int32_t)Trig.hCos;
+    wSin = -(int32_t)Trig.hSin;
+    wIndex = PCC_DQ_TABLE_SIZE / 2U;
+  }
+  else
+  {
+    wCos = -(int32_t)Trig.hSin;
+    wSin = (int32_t)Trig.hCos;
+    wIndex = (3U * PCC_DQ_TABLE_SIZE) / 4U;
+  }
+
+  if (wSin <= wCos)
+  {
+    wIndex += PCC_SearchDqOctant(wSin);
+  }
+  else
+  {
+    wIndex += (PCC_DQ_TABLE_SIZE / 4U) - PCC_SearchDqOctant(wCos);
+  }
+  return ((wIndex >= PCC_DQ_TABLE_SIZE) ? (wIndex - PCC_DQ_TABLE_SIZE) : wIndex);
+}
+
+/**
+  * @brief  It returns the voltage of a vector of the vector table in the q/d
+  *         frame of an electrical angle, read from PCC_VectorDqTable
+  * @param  bVector: index of the vector in the vector table
+  * @param  Trig: cosine and sine of the electrical angle of the q/d frame
+  * @retval qd_t Voltage of the vector, in units of the vector table
+  */
+static inline qd_t PCC_GetVectorDq(uint8_t bVector, Trig_Components Trig)
+{
+  qd_t Vqd = {0, 0};
+
+  if (bVector != PCC_ZERO_VECTOR)
+  {
+    uint32_t wIndex = PCC_GetDqTableIndex(Trig);
+
+    wIndex += (uint32_t)bVector * (PCC_DQ_TABLE_SIZE / 6U);
+    wIndex = (wIndex >= PCC_DQ_TABLE_SIZE) ? (wIndex - PCC_DQ_TABLE_SIZE) : wIndex;
+    Vqd = PCC_VectorDqTable[wIndex];
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (Vqd);
+}
+#endif
+
+/**
+  * @brief  It returns the sector of a voltage vector, sector i lying between the
+  *         active vectors i and i + 1 of PCC_VectorTable.
+  * @param  wAlpha: alpha component of the voltage vector, |wAlpha| < 131072
+  * @param  wBeta: beta component of the voltage vector
+  * @retval uint8_t Sector, from 0 to 5
+  */
+static uint8_t PCC_GetSector(int32_t wAlpha, int32_t wBeta)
+{
+  uint8_t bSector;
+  int32_t wSqrt3Alpha = PCC_DIV_POW2(wAlpha * PCC_SQRT3_Q13, 13);
+
+  if (wBeta >= 0)
+  {
+    if (wBeta < wSqrt3Alpha)
+    {
+      bSector = 0U;
+    }
+    else if (wBeta < -wSqrt3Alpha)
+    {
+      bSector = 2U;
+    }
+    else
+    {
+      bSector = 1U;
+    }
+  }
+  else
+  {
+    if (wBeta > wSqrt3Alpha)
+    {
+      bSector = 3U;
+    }
+    else if (wBeta > -wSqrt3Alpha)
+    {
+      bSector = 5U;
+    }
+    else
+    {
+      bSector = 4U;
+    }
+  }
+  return (bSector);
+}
+
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+/**
+  * @brief  It fills the list of the candidate vectors for a given deadbeat
+  *         voltage, starting with the two active vectors that bound its sector
+  *         and the zero vector. With #PCC_FULL_SEARCH the list is completed with
+  *         the other active vectors, so that the closest ones come first. With
+  *         #PCC_SECTOR_SEARCH the previous vector, that costs no commutation, is
+  *         added to the list if it is not already part of it.
+  * @param  wAlpha: alpha component of the deadbeat voltage, |wAlpha| <= UINT16_MAX
+  * @param  wBeta: beta component of the deadbeat voltage
+  * @param  bPrevVector: previous vector, or PCC_NO_VECTOR
+  * @param  Candidates: list to be filled, PCC_NB_VECTORS long
+  * @retval uint8_t Number of candidates
+  */
+static uint8_t PCC_GetCandidates(int32_t wAlpha, int32_t wBeta, uint8_t bPrevVector, uint8_t Candidates[PCC_NB_VECTORS])
+{
+  uint8_t bSector = PCC_GetSector(wAlpha, wBeta);
+
+  Candidates[0] = bSector;
+  Candidates[1] = (bSector < (PCC_ZERO_VECTOR - 1U)) ? (bSector + 1U) : 0U;
+  Candidates[2] = PCC_ZERO_VECTOR;
+#if (PCC_SEARCH_MODE == PCC_SECTOR_SEARCH)
+  if ((bPrevVector < PCC_ZERO_VECTOR) && (bPrevVector != Candidates[0]) && (bPrevVector != Candidates[1]))
+  {
+    Candidates[3] = bPrevVector;
+    return (4U);
+  }
+  return (3U);
+#else
+  (void)bPrevVector;
+  {
+    uint8_t i;
+
+    for (i = 2U; i < PCC_ZERO_VECTOR; i++)
+    {
+      Candidates[i + 1U] = (bSector + i) % PCC_ZERO_VECTOR;
+    }
+  }
+  return (PCC_NB_VECTORS);
+#endif
+}
+
+#endif
+
+/**
+  * @brief  It returns the switching state that realises a vector after a given
+  *         switching state. The zero vector is realised with all the high side
+  *         or all the low side switches on, whichever needs fewer commutations.
+  * @param  bVector: index of the vector in the PCC vector table
+  * @param  bPrevState: previous switching state
+  * @retval uint8_t Switching state
+  */
+static uint8_t PCC_GetSwitchingStateAfter(uint8_t bVector, uint8_t bPrevState)
+{
+  uint8_t bState = PCC_SwitchingStates[bVector];
+
+  if ((PCC_ZERO_VECTOR == bVector) && (PCC_Commutations[bPrevState] >= 2U))
+  {
+    bState = PCC_ALL_HIGH;
+  }
+  return (bState);
+}
+
+/**
+  * @brief  It adds two positive costs, saturating the sum to INT32_MAX
+  * @param  wCost: first cost
+  * @param  wTerm: second cost
+  * @retval int32_t Saturated sum
+  */
+static int32_t PCC_AddCost(int32_t wCost, int32_t wTerm)
+{
+  return ((wCost > (INT32_MAX - wTerm)) ? INT32_MAX : (wCost + wTerm));
+}
+
+/**
+  * @brief  It saturates a current to a symmetrical range
+  * @param  wValue: current to be saturated
+  * @param  wLimit: positive limit of the range
+  * @retval int32_t Saturated current
+  */
+static int32_t PCC_Saturate(int32_t wValue, int32_t wLimit)
+{
+  return ((wValue > wLimit) ? wLimit : ((wValue < -wLimit) ? -wLimit : wValue));
+}
+
+/**
+  * @brief  It divides by 2^bShift rounding to the nearest, half away from zero.
+  *         Unlike the arithmetic shift, the quotient of -wValue is the opposite
+  *         of the one of wValue: the terms of the model that are odd in the
+  *         speed are then exactly reversed when the rotation is
+  * @param  wValue: value to be divided
+  * @param  bShift: power of two of the divisor
+  * @retval int32_t Quotient
+  */
+static inline int32_t PCC_DivPow2Odd(int32_t wValue, uint8_t bShift)
+{
+  int32_t wHalf = (int32_t)(((uint32_t)1U << bShift) >> 1);
+
+  return ((wValue >= 0) ? PCC_DIV_POW2(wValue + wHalf, bShift) : -PCC_DIV_POW2(wHalf - wValue, bShift));
+}
+
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+/**
+  * @brief  It returns the cost of one inverter leg commutation
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pWeights: weights of the operating point
+  * @retval int32_t Cost of one commutation, in squared current digits, in
+  *         current digits with #PCC_COST_L1
+  */
+static int32_t PCC_SwitchingCost(const PCC_Handle_t *pHandle, const PCC_Weights_t *pWeights)
+{
+  uint32_t wCost = (uint32_t)pHandle->hSwitchingWeight * (uint32_t)pWeights->hSwitchingScale;
+
+#if (PCC_COST_NORM == PCC_COST_L1)
+  wCost = wCost >> PCC_WEIGHT_POW2;
+#endif
+  return ((wCost > (uint32_t)PCC_MAX_SW_COST) ? PCC_MAX_SW_COST : (int32_t)wCost);
+}
+
+/**
+  * @brief  It returns the cost difference within which candidates are equal
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval int32_t Cost difference, in squared current digits, in current
+  *         digits with #PCC_COST_L1
+  */
+static int32_t PCC_TieBand(const PCC_Handle_t *pHandle)
+{
+#if (PCC_COST_NORM == PCC_COST_L1)
+  return ((int32_t)pHandle->hTieBand);
+#else
+  return ((int32_t)pHandle->hTieBand * (int32_t)PCC_WEIGHT_ONE);
+#endif
+}
+
+/**
+  * @brief  It decides if a candidate replaces the best one found so far. A
+  *         candidate whose cost is wBand below the lowest one replaces it; the
+  *         candidates within wBand of the lowest cost are ties, one of which is
+  *         kept with the same probability, drawn from a 16-bit Galois LFSR.
+  *         With a wBand of 0 only a strictly lower cost replaces the best one.
+  * @param  wCost: cost of the candidate
+  * @param  wBand: cost difference within which candidates are equal
+  * @param  pMinCost: lowest cost found so far, updated
+  * @param  pTies: number of ties of the candidate kept, updated
+  * @param  pRandom: state of the LFSR, updated on a tie
+  * @retval bool True if the candidate replaces the best one
+  */
+static bool PCC_TakeCandidate(int32_t wCost, int32_t wBand, int32_t *pMinCost, uint8_t *pTies, uint16_t *pRandom)
+{
+  bool Take;
+  uint16_t hRandom;
+
+  if (PCC_AddCost(wCost, wBand) < *pMinCost)
+  {
+    *pTies = 1U;
+    Take = true;
+  }
+  else if (wCost < PCC_AddCost(*pMinCost, wBand))
+  {
+    hRandom = *pRandom;
+    hRandom = ((hRandom & 1U) != 0U) ? (uint16_t)((hRandom >> 1) ^ 0xB400U) : (uint16_t)(hRandom >> 1);
+    *pRandom = hRandom;
+    (*pTies)++;
+    Take = (0U == ((uint32_t)hRandom % (uint32_t)*pTies));
+  }
+  else
+  {
+    Take = false;
+  }
+  *pMinCost = (wCost < *pMinCost) ? wCost : *pMinCost;
+  return (Take);
+}
+
+/**
+  * @brief  It returns the largest absolute phase current of a current vector.
+  *         The current of phase A is its alpha component, the ones of phases B
+  *         and C are (-alpha +/- sqrt(3) beta) / 2, whose largest absolute value
+  *         is (|alpha| + sqrt(3) |beta|) / 2.
+  * @param  wIAlpha: alpha component of the current, in the int16_t range
+  * @param  wIBeta: beta component of the current, in the int16_t range
+  * @retval uint32_t Largest absolute phase current
+  */
+static uint32_t PCC_PhasePeak(int32_t wIAlpha, int32_t wIBeta)
+{
+  uint32_t wAbsAlpha = (uint32_t)((wIAlpha < 0) ? -wIAlpha : wIAlpha);
+  uint32_t wAbsBeta = (uint32_t)((wIBeta < 0) ? -wIBeta : wIBeta);
+  uint32_t wSide = (wAbsAlpha + ((wAbsBeta * (uint32_t)PCC_SQRT3_Q13) >> 13)) >> 1;
+
+  return ((wSide > wAbsAlpha) ? wSide : wAbsAlpha);
+}
+
+#if (PCC_COST_NORM == PCC_COST_L2_SAT) || (PCC_COST_NORM == PCC_COST_L2_PACKED)
+/**
+  * @brief  It returns the square root of a number rounded down, bit by bit
+  * @param  wSquare: number
+  * @retval uint32_t Root, below 2^16
+  */
+static uint32_t PCC_FloorSqrt(uint32_t wSquare)
+{
+  uint32_t wRoot = 0U;
+  uint32_t wBit = (uint32_t)1 << 15;
+  uint32_t wTry;
+
+  while (wBit > 0U)
+  {
+    wTry = wRoot | wBit;
+    wRoot = ((wTry * wTry) <= wSquare) ? wTry : wRoot;
+    wBit >>= 1;
+  }
+  return (wRoot);
+}
+
+/**
+  * @brief  It returns the largest square whose product by a weight fits the
+  *         32 bit cost: (wSq >> 4) (wWeight >> 4) is not above INT32_MAX
+  * @param  wWeight: weight
+  * @retval uint32_t Largest square, UINT32_MAX if any square fits
+  */
+static uint32_t PCC_CostHeadroom(uint32_t wWeight)
+{
+  uint32_t wScale = wWeight >> 4;
+  uint32_t wQuotient = (0U == wScale) ? UINT32_MAX : ((uint32_t)INT32_MAX / wScale);
+
+  return ((wQuotient > (UINT32_MAX >> 4)) ? UINT32_MAX : ((wQuotient << 4) | 15U));
+}
+
+/**
+  * @brief  It computes the saturations of the cost of #PCC_COST_L2_SAT and
+  *         #PCC_COST_L2_PACKED from the largest weights of the weight table:
+  *         the error saturation hCostSatError is lowered so that its weighted
+  *         square fits in 32 bits, and the squared current above the barrier
+  *         saturates where its weighted value does, the barrier weight raised
+  *         by #PCC_LIMIT_EVENTS included.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval None
+  */
+static void PCC_UpdateCostSaturation(PCC_Handle_t *pHandle)
+{
+  const PCC_Weights_t *pWeights;
+  uint32_t wMaxWeight = 0U;
+  uint32_t wMaxLimitWeight = 0U;
+  uint32_t wSq = (uint32_t)((int32_t)pHandle->hCostSatError * (int32_t)pHandle->hCostSatError);
+  uint32_t wHeadroom;
+  uint8_t i;
+
+  for (i = 0U; i < PCC_NB_WEIGHTS; i++)
+  {
+    pWeights = &pHandle->pWeightTable[i];
+    wMaxWeight = (pWeights->hQWeight > wMaxWeight) ? pWeights->hQWeight : wMaxWeight;
+    wMaxWeight = (pWeights->hDWeight > wMaxWeight) ? pWeights->hDWeight : wMaxWeight;
+    wMaxLimitWeight = (pWeights->hLimitWeight > wMaxLimitWeight) ? pWeights->hLimitWeight : wMaxLimitWeight;
+  }
+#ifdef PCC_LIMIT_EVENTS
+  wMaxLimitWeight <<= PCC_LIMIT_EVENT_SHIFT;
+  wMaxLimitWeight = (wMaxLimitWeight > UINT16_MAX) ? UINT16_MAX : wMaxLimitWeight;
+#endif
+  wHeadroom = PCC_CostHeadroom(wMaxWeight);
+  pHandle->wCostSatSq = (wSq < wHeadroom) ? wSq : wHeadroom;
+  pHandle->wCostSatError = (int32_t)PCC_FloorSqrt(pHandle->wCostSatSq);
+  pHandle->wCostSatSq = (uint32_t)(pHandle->wCostSatError * pHandle->wCostSatError);
+  pHandle->wExcessSatSq = PCC_CostHeadroom(wMaxLimitWeight);
+}
+#endif
+
+#if (PCC_COST_NORM == PCC_COST_L2_PACKED)
+/**
+  * @brief  It divides by 2^15 rounding towards minus infinity, the arithmetic
+  *         shift of the SIMD build
+  * @param  wValue: value to be divided
+  * @retval int32_t Quotient
+  */
+static inline int32_t PCC_FloorQ15(int32_t wValue)
+{
+#ifndef FULL_MISRA_C_COMPLIANCY_PCC
+  return (wValue >> 15); //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+#else
+  return ((wValue >= 0) ? (wValue / 32768) : -((32767 - wValue) / 32768));
+#endif
+}
+
+/**
+  * @brief  It returns the square root of the ratio of two weights, bit by bit on
+  *         its Q30 square
+  * @param  hWeight: weight
+  * @param  hMaxWeight: largest weight, not smaller than hWeight
+  * @retval uint16_t Square root of hWeight / hMaxWeight, Q15, not above 32768
+  */
+static uint16_t PCC_SqrtRatio(uint16_t hWeight, uint16_t hMaxWeight)
+{
+  uint32_t wSquare = (0U == hMaxWeight) ? 0U : (uint32_t)(((uint64_t)hWeight << 30) / hMaxWeight);
+
+  return ((uint16_t)PCC_FloorSqrt(wSquare));
+}
+
+/**
+  * @brief  It computes the scales of the weights of the weight table used by
+  *         #PCC_COST_L2_PACKED
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval None
+  */
+static void PCC_UpdatePackedScales(PCC_Handle_t *pHandle)
+{
+  const PCC_Weights_t *pWeights;
+  PCC_PackedScale_t *pScale;
+  uint8_t i;
+
+  for (i = 0U; i < PCC_NB_WEIGHTS; i++)
+  {
+    pWeights = &pHandle->pWeightTable[i];
+    pScale = &pHandle->PackedScale[i];
+    pScale->hMaxWeight = (pWeights->hQWeight > pWeights->hDWeight) ? pWeights->hQWeight : pWeights->hDWeight;
+    pScale->hQScale = PCC_SqrtRatio(pWeights->hQWeight, pScale->hMaxWeight);
+    pScale->hDScale = PCC_SqrtRatio(pWeights->hDWeight, pScale->hMaxWeight);
+    pScale->hMinScale = (pScale->hQScale < pScale->hDScale) ? pScale->hQScale : pScale->hDScale;
+  }
+}
+
+/**
+  * @brief  It returns the sum of the squares of the weighted q/d components of
+  *         a residual, each one saturated to #PCC_COST_PACKED_BITS. The two
+  *         builds give the same result bit for bit.
+  * @param  hResAlpha: alpha component of the predicted current error
+  * @param  hResBeta: beta component of the predicted current error
+  * @param  pFrame: rotation of the q/d frame of the step
+  * @retval uint32_t Sum of the squares, not above 2^31
+  */
+static inline uint32_t PCC_PackedSquares(int16_t hResAlpha, int16_t hResBeta, const PCC_CostFrame_t *pFrame)
+{
+#ifndef FULL_MISRA_C_COMPLIANCY_PCC
+  /* alpha in the low half and beta in the high half: q = alpha cos - beta sin
+     is SMUSD, d = alpha sin + beta cos is SMUADX, and q^2 + d^2 is SMUAD */
+  uint32_t wRes = __PKHBT((uint32_t)(uint16_t)hResAlpha, (uint32_t)(uint16_t)hResBeta, 16);
+  int32_t wQ = __SSAT(PCC_FloorQ15((int32_t)__SMUSD(wRes, pFrame->wRotQ)), PCC_COST_PACKED_BITS);
+  int32_t wD = __SSAT(PCC_FloorQ15((int32_t)__SMUADX(wRes, pFrame->wRotD)), PCC_COST_PACKED_BITS);
+  uint32_t wQD = __PKHBT((uint32_t)wQ, (uint32_t)wD, 16);
+
+  /* Only two lanes of -2^15 overflow the signed sum: it is read unsigned */
+  return (__SMUAD(wQD, wQD));
+#else
+  /* Same arithmetic, the halves being sign extended from the packed words */
+  int32_t wQCos = (int32_t)(pFrame->wRotQ & 0xFFFFU) - (((pFrame->wRotQ & 0x8000U) != 0U) ? 65536 : 0);
+  int32_t wQSin = (int32_t)(pFrame->wRotQ >> 16) - (((pFrame->wRotQ & 0x80000000U) != 0U) ? 65536 : 0);
+  int32_t wDCos = (int32_t)(pFrame->wRotD & 0xFFFFU) - (((pFrame->wRotD & 0x8000U) != 0U) ? 65536 : 0);
+  int32_t wDSin = (int32_t)(pFrame->wRotD >> 16) - (((pFrame->wRotD & 0x80000000U) != 0U) ? 65536 : 0);
+  int32_t wMax = ((int32_t)1 << (PCC_COST_PACKED_BITS - 1U)) - 1;
+  int32_t wQ = PCC_FloorQ15(((int32_t)hResAlpha * wQCos) - ((int32_t)hResBeta * wQSin));
+  int32_t wD = PCC_FloorQ15(((int32_t)hResAlpha * wDSin) + ((int32_t)hResBeta * wDCos));
+
+  wQ = (wQ > wMax) ? wMax : ((wQ < (-wMax - 1)) ? (-wMax - 1) : wQ);
+  wD = (wD > wMax) ? wMax : ((wD < (-wMax - 1)) ? (-wMax - 1) : wD);
+  return ((uint32_t)(wQ * wQ) + (uint32_t)(wD * wD));
+#endif
+}
+#endif
+
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+/**
+  * @brief  It returns the torque of the q and d currents, divided by 1.5 p Ld
+  *         and by the flux current: iq (1 + (1 - Lq / Ld) id / wFluxCurr)
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  wIq: q current, in the int16_t range
+  * @param  wId: d current, in the int16_t range
+  * @retval int64_t Torque, in q current digits
+  */
+static inline int64_t PCC_Torque(const PCC_Handle_t *pHandle, int32_t wIq, int32_t wId)
+{
+  /* Product of the currents below 2^30 and gain below 2^26 */
+  return ((int64_t)wIq + PCC_DIV_POW2((int64_t)(wIq * wId) * (int64_t)pHandle->wTorqueSaliency, 30));
+}
+
+/**
+  * @brief  It returns the squared magnitude of the stator flux of the q and d
+  *         currents, divided by Ld: (id + wFluxCurr)^2 + (Lq / Ld iq)^2
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  wIq: q current, in the int16_t range
+  * @param  wId: d current, in the int16_t range
+  * @retval int64_t Squared flux, in squared d current digits
+  */
+static inline int64_t PCC_FluxSq(const PCC_Handle_t *pHandle, int32_t wIq, int32_t wId)
+{
+  int32_t wFluxD = wId + pHandle->wFluxCurr;
+  /* Below 2^31 with a ratio below 4 */
+  int32_t wFluxQ = PCC_DIV_POW2(wIq * (int32_t)pHandle->hInductanceRatio, PCC_RATIO_POW2);
+
+  return (((int64_t)wFluxD * wFluxD) + ((int64_t)wFluxQ * wFluxQ));
+}
+
+/**
+  * @brief  It sets the flux current of #PCC_OBJECTIVE_TORQUE, within
+  *         #PCC_FLUX_CURR_MIN and #PCC_FLUX_CURR_MAX, and the gains divided by
+  *         it. Each field is written at once: a decision running in between
+  *         mixes the old and the new flux for one period.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  wFluxCurr: magnet flux divided by Ld, in current digits
+  * @retval None
+  */
+static void PCC_SetFluxCurrent(PCC_Handle_t *pHandle, int32_t wFluxCurr)
+{
+  int32_t wFlux = (wFluxCurr < PCC_FLUX_CURR_MIN) ? PCC_FLUX_CURR_MIN
+                : ((wFluxCurr > PCC_FLUX_CURR_MAX) ? PCC_FLUX_CURR_MAX : wFluxCurr);
+
+  pHandle->wTorqueSaliency = (int32_t)((((int64_t)PCC_RATIO_ONE - (int64_t)pHandle->hInductanceRatio) * 65536)
+                                       / (int64_t)wFlux);
+  pHandle->wFluxGain = (int32_t)(((uint32_t)1U << 23U) / (uint32_t)wFlux);
+  pHandle->wFluxCurr = wFlux;
+}
+#endif
+
+/**
+  * @brief  It returns the weights of the search: the entry of the weight table
+  *         in use, with the barrier weight raised after a limit event of
+  *         #PCC_LIMIT_EVENTS.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval const PCC_Weights_t* Weights of the search
+  */
+static inline const PCC_Weights_t *PCC_GetWeights(const PCC_Handle_t *pHandle)
+{
+#ifdef PCC_LIMIT_EVENTS
+  return ((true == pHandle->LimitEvent) ? &pHandle->LimitWeights : &pHandle->pWeightTable[pHandle->bWeightIndex]);
+#else
+  return (&pHandle->pWeightTable[pHandle->bWeightIndex]);
+#endif
+}
+
+/**
+  * @brief  It returns the rotation of the residual into the q/d frame of a step,
+  *         as used by PCC_ErrorCost(). With #PCC_COST_L2_PACKED the scales of
+  *         the weights of the operating point are applied to it, with
+  *         #PCC_COST_L2_FLOAT the weights of the search are joined to it, with
+  *         #PCC_OBJECTIVE_TORQUE the torque and flux of the reference.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Frame: cosine and sine of the angle of the q/d frame of the step
+  * @param  Iref: reference currents of the step, in the alpha/beta frame
+  * @retval PCC_CostFrame_t Rotation of the step
+  */
+static inline PCC_CostFrame_t PCC_GetCostFrame(const PCC_Handle_t *pHandle, Trig_Components Frame, PCC_Vector_t Iref)
+{
+#if (PCC_COST_NORM == PCC_COST_L2_PACKED)
+  const PCC_PackedScale_t *pScale = &pHandle->PackedScale[pHandle->bWeightIndex];
+  PCC_CostFrame_t CostFrame;
+
+  (void)Iref;
+
+  CostFrame.wRotQ = ((uint32_t)(uint16_t)PCC_FloorQ15((int32_t)pScale->hQScale * Frame.hSin) << 16)
+                  | (uint32_t)(uint16_t)PCC_FloorQ15((int32_t)pScale->hQScale * Frame.hCos);
+  CostFrame.wRotD = ((uint32_t)(uint16_t)PCC_FloorQ15((int32_t)pScale->hDScale * Frame.hSin) << 16)
+                  | (uint32_t)(uint16_t)PCC_FloorQ15((int32_t)pScale->hDScale * Frame.hCos);
+  CostFrame.wWeight = (int32_t)(pScale->hMaxWeight >> 4);
+  return (CostFrame);
+#elif (PCC_COST_NORM == PCC_COST_L2_FLOAT)
+  const PCC_Weights_t *pWeights = PCC_GetWeights(pHandle);
+  PCC_CostFrame_t CostFrame;
+
+  (void)Iref;
+  CostFrame.fCos = (float_t)Frame.hCos * PCC_FLOAT_Q15;
+  CostFrame.fSin = (float_t)Frame.hSin * PCC_FLOAT_Q15;
+  CostFrame.fQWeight = (float_t)pWeights->hQWeight * PCC_FLOAT_WEIGHT;
+  CostFrame.fDWeight = (float_t)pWeights->hDWeight * PCC_FLOAT_WEIGHT;
+  CostFrame.fLimitWeight = (float_t)pWeights->hLimitWeight * PCC_FLOAT_WEIGHT;
+  return (CostFrame);
+#elif (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+  PCC_CostFrame_t CostFrame;
+
+  CostFrame.Trig = Frame;
+  CostFrame.wIrefQ = PCC_Saturate(PCC_DIV_POW2(Iref.wAlpha * Frame.hCos, 15) - PCC_DIV_POW2(Iref.wBeta * Frame.hSin, 15),
+                                  INT16_MAX);
+  CostFrame.wIrefD = PCC_Saturate(PCC_DIV_POW2(Iref.wAlpha * Frame.hSin, 15) + PCC_DIV_POW2(Iref.wBeta * Frame.hCos, 15),
+                                  INT16_MAX);
+  CostFrame.lTorqueRef = PCC_Torque(pHandle, CostFrame.wIrefQ, CostFrame.wIrefD);
+  CostFrame.lFluxSqRef = PCC_FluxSq(pHandle, CostFrame.wIrefQ, CostFrame.wIrefD);
+  return (CostFrame);
+#else
+  (void)pHandle;
+  (void)Iref;
+  return (Frame);
+#endif
+}
+
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+/**
+  * @brief  It returns the torque and the flux errors of a predicted current
+  *         error, in the units of #PCC_OBJECTIVE_TORQUE, saturated to the
+  *         UINT16_MAX range as the current errors of the free response
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hResAlpha: alpha component of the predicted current error
+  * @param  hResBeta: beta component of the predicted current error
+  * @param  pFrame: rotation and reference of the step, PCC_GetCostFrame()
+  * @param  pErrTorque: torque error, in q current digits
+  * @param  pErrFlux: flux magnitude error, in d current digits
+  * @retval None
+  */
+static inline void PCC_TorqueFluxError(const PCC_Handle_t *pHandle, int16_t hResAlpha, int16_t hResBeta,
+                                       const PCC_CostFrame_t *pFrame, int32_t *pErrTorque, int32_t *pErrFlux)
+{
+  int32_t wResQ = PCC_DIV_POW2((int32_t)hResAlpha * pFrame->Trig.hCos, 15)
+                - PCC_DIV_POW2((int32_t)hResBeta * pFrame->Trig.hSin, 15);
+  int32_t wResD = PCC_DIV_POW2((int32_t)hResAlpha * pFrame->Trig.hSin, 15)
+                + PCC_DIV_POW2((int32_t)hResBeta * pFrame->Trig.hCos, 15);
+  int32_t wIq = PCC_Saturate(pFrame->wIrefQ - wResQ, INT16_MAX);
+  int32_t wId = PCC_Saturate(pFrame->wIrefD - wResD, INT16_MAX);
+  int64_t lErrTorque = pFrame->lTorqueRef - PCC_Torque(pHandle, wIq, wId);
+  /* Squared flux below 2^36 and gain below 2^17: the product fits */
+  int64_t lErrFlux = PCC_DIV_POW2((pFrame->lFluxSqRef - PCC_FluxSq(pHandle, wIq, wId)) * (int64_t)pHandle->wFluxGain, 24);
+
+  *pErrTorque = (int32_t)((lErrTorque > (int64_t)UINT16_MAX) ? (int64_t)UINT16_MAX
+                        : ((lErrTorque < -(int64_t)UINT16_MAX) ? -(int64_t)UINT16_MAX : lErrTorque));
+  *pErrFlux = (int32_t)((lErrFlux > (int64_t)UINT16_MAX) ? (int64_t)UINT16_MAX
+                      : ((lErrFlux < -(int64_t)UINT16_MAX) ? -(int64_t)UINT16_MAX : lErrFlux));
+}
+#endif
+
+/**
+  * @brief  It returns the weighted cost of a predicted current error: its q and
+  *         d components, squared but with #PCC_COST_L1, plus the current above
+  *         the limit of the barrier, squared as well. A predicted current whose
+  *         magnitude is above hMaxCurr is infeasible: PCC_INFEASIBLE_COST and
+  *         its overshoot are added to the cost, so that a feasible candidate is
+  *         preferred to it unless the current error itself saturates the cost,
+  *         and the one of least overshoot is kept when none is feasible. A
+  *         predicted phase current above hTripCurr is infeasible as well.
+  *         With #PCC_OBJECTIVE_TORQUE the q and d errors are the torque and
+  *         the flux errors, PCC_TorqueFluxError().
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pWeights: weights of the operating point
+  * @param  hResAlpha: alpha component of the predicted current error
+  * @param  hResBeta: beta component of the predicted current error
+  * @param  Iref: reference currents of the step, in the alpha/beta frame
+  * @param  Frame: rotation of the q/d frame of the step, PCC_GetCostFrame()
+  * @param  pTripped: set to true if the phase current is above hTripCurr
+  * @retval int32_t Cost, saturated to INT32_MAX
+  */
+static int32_t PCC_ErrorCost(const PCC_Handle_t *pHandle, const PCC_Weights_t *pWeights, int16_t hResAlpha,
+                             int16_t hResBeta, PCC_Vector_t Iref, PCC_CostFrame_t Frame, bool *pTripped)
+{
+#if (PCC_COST_NORM == PCC_COST_L2_FLOAT)
+  float_t fResAlpha = (float_t)hResAlpha;
+  float_t fResBeta = (float_t)hResBeta;
+  float_t fResQ = (fResAlpha * Frame.fCos) - (fResBeta * Frame.fSin);
+  float_t fResD = (fResAlpha * Frame.fSin) + (fResBeta * Frame.fCos);
+#elif (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+  int32_t wResQ;
+  int32_t wResD;
+
+  PCC_TorqueFluxError(pHandle, hResAlpha, hResBeta, &Frame, &wResQ, &wResD);
+#elif (PCC_COST_NORM != PCC_COST_L2_PACKED)
+  /* One rounding of each component, as the dual multiplies of PCC_COST_L2_PACKED: the sums
+     of the products are below 2^31, the magnitude of the residual times the one of the frame */
+  int32_t wResQ = PCC_DIV_POW2(((int32_t)hResAlpha * Frame.hCos) - ((int32_t)hResBeta * Frame.hSin), 15);
+  int32_t wResD = PCC_DIV_POW2(((int32_t)hResAlpha * Frame.hSin) + ((int32_t)hResBeta * Frame.hCos), 15);
+#endif
+  int32_t wIAlpha = PCC_Saturate(Iref.wAlpha - hResAlpha, INT16_MAX);
+  int32_t wIBeta = PCC_Saturate(Iref.wBeta - hResBeta, INT16_MAX);
+  uint32_t wPeak = PCC_PhasePeak(wIAlpha, wIBeta);
+  uint32_t wTripLimit = (0 == pHandle->hTripCurr) ? UINT32_MAX : (uint32_t)pHandle->hTripCurr;
+#if (PCC_COST_NORM == PCC_COST_L1)
+  uint32_t wAbsQ = (uint32_t)((wResQ < 0) ? -wResQ : wResQ);
+  uint32_t wAbsD = (uint32_t)((wResD < 0) ? -wResD : wResD);
+  uint32_t wAbsAlpha = (uint32_t)((wIAlpha < 0) ? -wIAlpha : wIAlpha);
+  uint32_t wAbsBeta = (uint32_t)((wIBeta < 0) ? -wIBeta : wIBeta);
+  uint32_t wMax = (wAbsAlpha > wAbsBeta) ? wAbsAlpha : wAbsBeta;
+  uint32_t wMin = (wAbsAlpha > wAbsBeta) ? wAbsBeta : wAbsAlpha;
+  uint32_t wMag = wMax + (((wMin << 1) + wMin) >> 3);
+  uint32_t wExcess = (wMag > (uint32_t)pHandle->hLimitCurr) ? (wMag - (uint32_t)pHandle->hLimitCurr) : 0U;
+  uint32_t wMaxMag = (0 == pHandle->hMaxCurr) ? UINT32_MAX : (uint32_t)pHandle->hMaxCurr;
+  bool Infeasible = (wMag > wMaxMag);
+  uint32_t wOver = (true == Infeasible) ? (wMag - wMaxMag) : 0U;
+  int32_t wCost;
+
+  /* Every product is below 2^32, and each term below 2^24 once shifted */
+  wCost = (int32_t)(((wAbsQ * (uint32_t)pWeights->hQWeight) >> PCC_WEIGHT_POW2)
+                  + ((wAbsD * (uint32_t)pWeights->hDWeight) >> PCC_WEIGHT_POW2)
+                  + ((wExcess * (uint32_t)pWeights->hLimitWeight) >> PCC_WEIGHT_POW2));
+#elif (PCC_COST_NORM == PCC_COST_L2_SAT)
+  int32_t wSatQ = PCC_Saturate(wResQ, pHandle->wCostSatError);
+  int32_t wSatD = PCC_Saturate(wResD, pHandle->wCostSatError);
+  uint32_t wSq = (uint32_t)(wIAlpha * wIAlpha) + (uint32_t)(wIBeta * wIBeta);
+  uint32_t wExcess = (wSq > pHandle->wLimitSqCurr) ? (wSq - pHandle->wLimitSqCurr) : 0U;
+  bool Infeasible = (wSq > pHandle->wMaxSqCurr);
+  uint32_t wOver = (true == Infeasible) ? (wSq - pHandle->wMaxSqCurr) : 0U;
+  int32_t wCost;
+
+  wExcess = (wExcess > pHandle->wExcessSatSq) ? pHandle->wExcessSatSq : wExcess;
+  /* The saturations are the headroom of the weights: each term is below 2^31 */
+  wCost = ((wSatQ * wSatQ) >> 4) * (int32_t)(pWeights->hQWeight >> 4);
+  wCost = PCC_AddCost(wCost, ((wSatD * wSatD) >> 4) * (int32_t)(pWeights->hDWeight >> 4));
+  wCost = PCC_AddCost(wCost, (int32_t)(wExcess >> 4) * (int32_t)(pWeights->hLimitWeight >> 4));
+#elif (PCC_COST_NORM == PCC_COST_L2_PACKED)
+#ifndef FULL_MISRA_C_COMPLIANCY_PCC
+  uint32_t wI = __PKHBT((uint32_t)(uint16_t)wIAlpha, (uint32_t)(uint16_t)wIBeta, 16);
+  uint32_t wSq = __SMUAD(wI, wI);
+#else
+  uint32_t wSq = (uint32_t)(wIAlpha * wIAlpha) + (uint32_t)(wIBeta * wIBeta);
+#endif
+  uint32_t wExcess = (wSq > pHandle->wLimitSqCurr) ? (wSq - pHandle->wLimitSqCurr) : 0U;
+  bool Infeasible = (wSq > pHandle->wMaxSqCurr);
+  uint32_t wOver = (true == Infeasible) ? (wSq - pHandle->wMaxSqCurr) : 0U;
+  uint32_t wResSq = PCC_PackedSquares(hResAlpha, hResBeta, &Frame);
+  int32_t wCost;
+
+  wExcess = (wExcess > pHandle->wExcessSatSq) ? pHandle->wExcessSatSq : wExcess;
+  wResSq = (wResSq > pHandle->wCostSatSq) ? pHandle->wCostSatSq : wResSq;
+  /* The saturations are the headroom of the weights: each term is below 2^31 */
+  wCost = (int32_t)(wResSq >> 4) * Frame.wWeight;
+  wCost = PCC_AddCost(wCost, (int32_t)(wExcess >> 4) * (int32_t)(pWeights->hLimitWeight >> 4));
+#elif (PCC_COST_NORM == PCC_COST_L2_FLOAT)
+  uint32_t wSq = (uint32_t)(wIAlpha * wIAlpha) + (uint32_t)(wIBeta * wIBeta);
+  uint32_t wExcess = (wSq > pHandle->wLimitSqCurr) ? (wSq - pHandle->wLimitSqCurr) : 0U;
+  bool Infeasible = (wSq > pHandle->wMaxSqCurr);
+  uint32_t wOver = (true == Infeasible) ? (wSq - pHandle->wMaxSqCurr) : 0U;
+  float_t fCost = (fResQ * fResQ) * Frame.fQWeight;
+  int32_t wCost;
+
+  (void)pWeights;
+  fCost += (fResD * fResD) * Frame.fDWeight;
+  fCost += (float_t)wExcess * Frame.fLimitWeight;
+  wCost = (fCost < PCC_FLOAT_COST_MAX) ? (int32_t)fCost : INT32_MAX;
+#else
+  uint32_t wSq = (uint32_t)(wIAlpha * wIAlpha) + (uint32_t)(wIBeta * wIBeta);
+  uint32_t wExcess = (wSq > pHandle->wLimitSqCurr) ? (wSq - pHandle->wLimitSqCurr) : 0U;
+  bool Infeasible = (wSq > pHandle->wMaxSqCurr);
+  uint32_t wOver = (true == Infeasible) ? (wSq - pHandle->wMaxSqCurr) : 0U;
+  int64_t lCost = (((int64_t)wResQ * wResQ) * (int64_t)pWeights->hQWeight)
+                + (((int64_t)wResD * wResD) * (int64_t)pWeights->hDWeight)
+                + ((int64_t)wExcess * (int64_t)pWeights->hLimitWeight);
+  int32_t wCost;
+
+  lCost = lCost >> PCC_WEIGHT_POW2;
+  wCost = (lCost > (int64_t)INT32_MAX) ? INT32_MAX : (int32_t)lCost;
+#endif
+
+  if (wPeak > wTripLimit)
+  {
+    /* Its overshoot, in current digits, is added to the one of the magnitude */
+    *pTripped = true;
+    Infeasible = true;
+    wOver = ((wPeak - wTripLimit) > (UINT32_MAX - wOver)) ? UINT32_MAX : (wOver + (wPeak - wTripLimit));
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  if (true == Infeasible)
+  {
+    /* The overshoot, below 2^31, only ranks the infeasible candidates */
+    wCost = PCC_AddCost(PCC_AddCost(wCost, PCC_INFEASIBLE_COST), (int32_t)(wOver >> 2));
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (wCost);
+}
+
+#if defined (PCC_VBUS_LIMIT) && (PCC_OUTPUT_MODE == PCC_FINITE_SET) && (PCC_HORIZON == 1U)
+/**
+  * @brief  It computes the cost of the power that a vector returns to the bus,
+  *         #PCC_VBUS_LIMIT. The power is the product of the voltage of the
+  *         vector and of the current predicted at the end of the period.
+  * @param  bVector: index of the vector in PCC_VectorTable
+  * @param  Iref: reference stator currents in the alpha/beta frame
+  * @param  hResAlpha: alpha component of the predicted current error
+  * @param  hResBeta: beta component of the predicted current error
+  * @param  wRegenGain: hRegenWeight times PCC_Handle_t::hVbusLevel, Q15
+  * @retval int32_t Cost of the candidate, 0 for a vector that draws power
+  */
+static int32_t PCC_RegenCost(uint8_t bVector, PCC_Vector_t Iref, int16_t hResAlpha, int16_t hResBeta,
+                             uint32_t wRegenGain)
+{
+  int32_t wIAlpha = PCC_Saturate(Iref.wAlpha - hResAlpha, INT16_MAX);
+  int32_t wIBeta = PCC_Saturate(Iref.wBeta - hResBeta, INT16_MAX);
+  int32_t wPower = PCC_DIV_POW2((int32_t)PCC_VectorTable[bVector].alpha * wIAlpha, 15)
+                 + PCC_DIV_POW2((int32_t)PCC_VectorTable[bVector].beta * wIBeta, 15);
+  uint32_t wCost = (wPower < 0) ? ((uint32_t)(-wPower) * wRegenGain) : 0U;
+
+  return ((wCost > (uint32_t)INT32_MAX) ? INT32_MAX : (int32_t)wCost);
+}
+#endif
+
+/**
+  * @brief  It returns a lower bound of the cost of the candidates whose current
+  *         step points away from the error, PCC_PointsAway().
+  *
+  * The residual of such a candidate is at least as long as the error itself:
+  * with E the error and S the step, |E - S|^2 = |E|^2 + |S|^2 - 2 E.S >= |E|^2.
+  * Its q/d components, once rotated, are then at least as long as |E| minus
+  * PCC_BOUND_SLACK, and its cost is at least the one of a residual of that
+  * length on the axis of the smallest weight. The switching and the barrier
+  * terms, that are positive, are left out of the bound. A candidate whose bound
+  * reaches the best cost found so far is skipped without being evaluated: it
+  * would have been pruned, so that the result of the search is unchanged.
+  * With #PCC_COST_L2_PACKED the length is scaled by the smallest scale of the
+  * weights, the bound being left out when that scale is below
+  * PCC_PACKED_MIN_SCALE. With #PCC_OBJECTIVE_TORQUE a longer residual may
+  * have a lower torque and flux cost: there is no bound.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pWeights: weights of the operating point
+  * @param  Err: current error left by the free response of the model
+  * @retval int32_t Lower bound, 0 if the error is too large for the bound to hold
+  */
+static int32_t PCC_AwayCost(const PCC_Handle_t *pHandle, const PCC_Weights_t *pWeights, PCC_Vector_t Err)
+{
+  int32_t wAbsAlpha = (Err.wAlpha < 0) ? -Err.wAlpha : Err.wAlpha;
+  int32_t wAbsBeta = (Err.wBeta < 0) ? -Err.wBeta : Err.wBeta;
+  uint32_t wMinWeight = (pWeights->hQWeight < pWeights->hDWeight) ? pWeights->hQWeight : pWeights->hDWeight;
+  int32_t wBound = 0;
+
+#if (PCC_COST_NORM != PCC_COST_L2_PACKED)
+  (void)pHandle;
+#else
+  (void)wMinWeight;
+#endif
+  if ((PCC_COST_OBJECTIVE != PCC_OBJECTIVE_TORQUE)
+      && (wAbsAlpha <= PCC_BOUND_MAX_ERROR) && (wAbsBeta <= PCC_BOUND_MAX_ERROR))
+  {
+#if (PCC_COST_NORM == PCC_COST_L1)
+    /* |rq| + |rd| >= |E| - slack >= max(|Ealpha|, |Ebeta|) - slack */
+    int32_t wLength = ((wAbsAlpha > wAbsBeta) ? wAbsAlpha : wAbsBeta) - PCC_BOUND_SLACK;
+
+    if (wLength > 0)
+    {
+      wBound = (int32_t)(((uint32_t)wLength * wMinWeight) >> PCC_WEIGHT_POW2) - 1;
+    }
+#else
+    /* (|E| - slack)^2 >= |E|^2 - 2 slack (|Ealpha| + |Ebeta|) */
+    int32_t wSq = (Err.wAlpha * Err.wAlpha) + (Err.wBeta * Err.wBeta)
+                - ((2 * PCC_BOUND_SLACK) * (wAbsAlpha + wAbsBeta));
+
+    if (wSq > 0)
+    {
+#if (PCC_COST_NORM == PCC_COST_L2_SAT)
+      wSq = ((uint32_t)wSq > pHandle->wCostSatSq) ? (int32_t)pHandle->wCostSatSq : wSq;
+      wBound = ((wSq >> 4) - 1) * (int32_t)(wMinWeight >> 4);
+#elif (PCC_COST_NORM == PCC_COST_L2_FLOAT)
+      float_t fBound = (float_t)wSq * ((float_t)wMinWeight * PCC_FLOAT_WEIGHT);
+
+      wBound = (fBound < PCC_FLOAT_COST_MAX) ? (int32_t)fBound : INT32_MAX;
+#elif (PCC_COST_NORM == PCC_COST_L2_PACKED)
+      const PCC_PackedScale_t *pScale = &pHandle->PackedScale[pHandle->bWeightIndex];
+      int64_t lScaledSq = ((int64_t)wSq * ((int64_t)pScale->hMinScale * pScale->hMinScale)) >> 30;
+
+      /* The sum of the squares saturates to wCostSatSq */
+      wSq = (lScaledSq > (int64_t)pHandle->wCostSatSq) ? (int32_t)pHandle->wCostSatSq : (int32_t)lScaledSq;
+      wBound = (pScale->hMinScale < PCC_PACKED_MIN_SCALE) ? 0
+             : (((wSq >> 4) - 1) * (int32_t)(pScale->hMaxWeight >> 4));
+#else
+      int64_t lBound = ((int64_t)wSq * (int64_t)wMinWeight) >> PCC_WEIGHT_POW2;
+
+      wBound = (lBound > (int64_t)INT32_MAX) ? INT32_MAX : (int32_t)lBound;
+#endif
+    }
+#endif
+  }
+  return ((wBound > 0) ? wBound : 0);
+}
+
+/**
+  * @brief  It tells whether the current step of a candidate points away from
+  *         the error, so that the lower bound of PCC_AwayCost() applies to it.
+  * @param  Err: current error left by the free response of the model, whose
+  *         components are at most PCC_BOUND_MAX_ERROR
+  * @param  Step: current step of the candidate
+  * @retval bool True if the bound applies
+  */
+static bool PCC_PointsAway(PCC_Vector_t Err, alphabeta_t Step)
+{
+  int32_t wAlpha = (int32_t)Step.alpha;
+  int32_t wBeta = (int32_t)Step.beta;
+
+  return ((wAlpha <= PCC_BOUND_MAX_ERROR) && (wAlpha >= -PCC_BOUND_MAX_ERROR)
+          && (wBeta <= PCC_BOUND_MAX_ERROR) && (wBeta >= -PCC_BOUND_MAX_ERROR)
+          && (((Err.wAlpha * wAlpha) + (Err.wBeta * wBeta)) <= 0));
+}
+#endif
+
+
+#if (PCC_OUTPUT_MODE != PCC_FINITE_SET)
+/**
+  * @brief  It returns the voltage of the vector table digits whose current step
+  *         is @p Step, the deadbeat voltage. Beyond the int16_t range only its
+  *         direction is kept: it is scaled down along it, so that its products
+  *         with the vector table fit in 32 bits.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Step: current step, |Step| < 131072
+  * @retval PCC_Vector_t Voltage, components within +/-INT16_MAX
+  */
+static PCC_Vector_t PCC_GetStepVoltage(const PCC_Handle_t *pHandle, PCC_Vector_t Step)
+{
+  PCC_Vector_t Voltage;
+  int64_t lAlpha = PCC_DIV_POW2((int64_t)Step.wAlpha * (int64_t)pHandle->wKVoltInv, 15);
+  int64_t lBeta = PCC_DIV_POW2((int64_t)Step.wBeta * (int64_t)pHandle->wKVoltInv, 15);
+  int64_t lMax = (lAlpha < 0) ? -lAlpha : lAlpha;
+
+  lMax = (lBeta > lMax) ? lBeta : ((-lBeta > lMax) ? -lBeta : lMax);
+  while (lMax > (int64_t)INT16_MAX)
+  {
+    lAlpha /= 2;
+    lBeta /= 2;
+    lMax /= 2;
+  }
+  Voltage.wAlpha = (int32_t)lAlpha;
+  Voltage.wBeta = (int32_t)lBeta;
+  return (Voltage);
+}
+
+#ifndef PCC_FULL_HEXAGON
+/**
+  * @brief  It returns the factor that brings a voltage back to hMaxModule, the
+  *         module of the circle limitation of the motor control task, along its
+  *         direction, so that the circle limitation leaves it as it is.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Voltage: voltage of the vector table digits, components within
+  *         +/-INT16_MAX
+  * @retval int32_t Factor in Q15 format, 32768 inside the circle
+  */
+static int32_t PCC_GetModuleScale(const PCC_Handle_t *pHandle, PCC_Vector_t Voltage)
+{
+  int32_t wModule = MCM_Sqrt((Voltage.wAlpha * Voltage.wAlpha) + (Voltage.wBeta * Voltage.wBeta));
+
+  /* The root is rounded down: one digit less keeps the result inside the circle */
+  return ((wModule >= (int32_t)pHandle->hMaxModule)
+          ? ((((int32_t)pHandle->hMaxModule - 1) << 15) / (wModule + 1)) : 32768);
+}
+#endif
+#endif
+
+#if (PCC_OUTPUT_MODE == PCC_MODULATED)
+/**
+  * @brief  It selects the sector and the dwell times of the modulated predictive
+  *         controller: the average voltage of the two active vectors of a sector
+  *         and of the zero vector whose current step is nearest to the free
+  *         response error.
+  *
+  * The current step of each vector is the one of its voltage scaled by
+  * wKVoltBus, so that the nearest average voltage is the one of the hexagon
+  * nearest to the deadbeat voltage, the error scaled by wKVoltInv, and lies in
+  * the sector of that voltage. Inside the hexagon, the dwell times d_a and d_b
+  * of the active vectors V_a and V_b give the deadbeat voltage V exactly:
+  * @f[
+  * d_{a} = \frac{V \times V_{b}}{V_{a} \times V_{b}}, \quad
+  * d_{b} = \frac{V_{a} \times V}{V_{a} \times V_{b}}
+  * @f]
+  * Beyond it, V is projected on the edge between V_a and V_b, without the zero
+  * vector. Without #PCC_FULL_HEXAGON, the dwell times of the active vectors are
+  * then scaled down so that the average voltage stays within hMaxModule, the
+  * circle limitation applied to it by the motor control task. The search mode
+  * does not apply: the sector is the one of V.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  wErrAlpha: alpha component of the free response error, |wErrAlpha| < 131072
+  * @param  wErrBeta: beta component of the free response error
+  * @param  pVoltage: average voltage of the selected vectors over the period
+  * @param  pResidual: predicted current error with the average voltage
+  * @retval uint8_t Active vector of the selected sector with the longest dwell time
+  */
+static uint8_t PCC_ModulatedSearch(PCC_Handle_t *pHandle, int32_t wErrAlpha, int32_t wErrBeta,
+                                   PCC_Vector_t *pVoltage, PCC_Vector_t *pResidual)
+{
+  PCC_Vector_t Err = {wErrAlpha, wErrBeta};
+  PCC_Vector_t Voltage = PCC_GetStepVoltage(pHandle, Err);
+  int32_t wVoltAlpha = Voltage.wAlpha;
+  int32_t wVoltBeta = Voltage.wBeta;
+  int32_t wDet;
+  int32_t wDwellA;
+  int32_t wDwellB;
+  uint8_t bA;
+  uint8_t bB;
+
+  bA = PCC_GetSector(wVoltAlpha, wVoltBeta);
+  bB = (bA < (PCC_ZERO_VECTOR - 1U)) ? (bA + 1U) : 0U;
+  /* Cross products of the vectors of the sector, 32767^2 sin(60 deg) at most, in
+     Q15 of the dwell times */
+  wDet = ((PCC_VectorTable[bA].alpha * PCC_VectorTable[bB].beta)
+          - (PCC_VectorTable[bA].beta * PCC_VectorTable[bB].alpha)) >> 15;
+  wDwellA = ((wVoltAlpha * PCC_VectorTable[bB].beta) - (wVoltBeta * PCC_VectorTable[bB].alpha)) / wDet;
+  wDwellB = ((PCC_VectorTable[bA].alpha * wVoltBeta) - (PCC_VectorTable[bA].beta * wVoltAlpha)) / wDet;
+  /* Both are positive in the sector, up to the rounding of its bounds */
+  wDwellA = (wDwellA < 0) ? 0 : wDwellA;
+  wDwellB = (wDwellB < 0) ? 0 : wDwellB;
+  if ((wDwellA + wDwellB) > 32768)
+  {
+    /* Projection on the edge, of length 32767: Q15 position from V_a to V_b */
+    int32_t wEdgeAlpha = (int32_t)PCC_VectorTable[bB].alpha - PCC_VectorTable[bA].alpha;
+    int32_t wEdgeBeta = (int32_t)PCC_VectorTable[bB].beta - PCC_VectorTable[bA].beta;
+    int64_t lDot = ((int64_t)(wVoltAlpha - PCC_VectorTable[bA].alpha) * wEdgeAlpha)
+                 + ((int64_t)(wVoltBeta - PCC_VectorTable[bA].beta) * wEdgeBeta);
+
+    wDwellB = (int32_t)(lDot >> 15);
+    wDwellB = (wDwellB < 0) ? 0 : ((wDwellB > 32768) ? 32768 : wDwellB);
+    wDwellA = 32768 - wDwellB;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#ifndef PCC_FULL_HEXAGON
+  Voltage.wAlpha = PCC_DIV_POW2((wDwellA * PCC_VectorTable[bA].alpha) + (wDwellB * PCC_VectorTable[bB].alpha), 15);
+  Voltage.wBeta = PCC_DIV_POW2((wDwellA * PCC_VectorTable[bA].beta) + (wDwellB * PCC_VectorTable[bB].beta), 15);
+  {
+    int32_t wScale = PCC_GetModuleScale(pHandle, Voltage);
+
+    wDwellA = PCC_DIV_POW2(wDwellA * wScale, 15);
+    wDwellB = PCC_DIV_POW2(wDwellB * wScale, 15);
+  }
+#endif
+
+  pVoltage->wAlpha = PCC_DIV_POW2((wDwellA * PCC_VectorTable[bA].alpha) + (wDwellB * PCC_VectorTable[bB].alpha), 15);
+  pVoltage->wBeta = PCC_DIV_POW2((wDwellA * PCC_VectorTable[bA].beta) + (wDwellB * PCC_VectorTable[bB].beta), 15);
+  pResidual->wAlpha = wErrAlpha - PCC_DIV_POW2((wDwellA * pHandle->DeltaIalphabeta[bA].alpha)
+                                              + (wDwellB * pHandle->DeltaIalphabeta[bB].alpha), 15);
+  pResidual->wBeta = wErrBeta - PCC_DIV_POW2((wDwellA * pHandle->DeltaIalphabeta[bA].beta)
+                                            + (wDwellB * pHandle->DeltaIalphabeta[bB].beta), 15);
+  pHandle->hDwellTime[0] = (uint16_t)wDwellA;
+  pHandle->hDwellTime[1] = (uint16_t)wDwellB;
+  pHandle->bSector = bA;
+  pHandle->hNodeCount = 1U;
+
+  return ((wDwellA >= wDwellB) ? bA : bB);
+}
+#endif
+
+#if (PCC_HORIZON > 1U)
+/**
+  * @brief  It searches the sequence of vectors that minimises the sum of the
+  *         weighted squared current errors over the prediction horizon.
+  *
+  * The tree of the vector sequences is explored depth first. The children of a
+  * node are ordered by PCC_GetCandidates(), so that a good sequence is reached
+  * first, and a branch is pruned as soon as its partial cost reaches the cost of
+  * the best complete sequence found so far. A child whose lower bound,
+  * PCC_AwayCost(), already reaches it is skipped before its cost is computed,
+  * and is not counted in the budget. The commutations of each step are
+  * counted from the switching state of the previous one. At most hNodeBudget nodes are
+  * evaluated: when the budget runs out the best sequence found so far is kept and
+  * BudgetExceeded is set.
+  *
+  * The model, the budget, the weights and the best residual are kept in locals
+  * during the search and the handle is only written at its end, so that the
+  * stores of the search do not force the model to be read again from memory at
+  * every node.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  State: measured stator currents in the alpha/beta frame
+  * @param  Iref: reference currents at the end of each step of the horizon, in
+  *         the alpha/beta frame
+  * @param  Frame: cosine and sine of the angle of the q/d frame at the end of
+  *         each step of the horizon
+  * @param  BemfStep: current step produced by the back-EMF and the estimated
+  *         disturbance during each step of the horizon, in the alpha/beta frame
+  * @param  pResidual: predicted current error at the end of the first step of
+  *         the best sequence
+  * @param  pCost: cost of the best sequence
+  * @retval uint8_t First vector of the best sequence
+  */
+static uint8_t PCC_HorizonSearch(PCC_Handle_t *pHandle, PCC_Vector_t State, const PCC_Vector_t Iref[PCC_HORIZON],
+                                 const Trig_Components Frame[PCC_HORIZON], const PCC_Vector_t BemfStep[PCC_HORIZON],
+                                 PCC_Vector_t *pResidual, int32_t *pCost)
+{
+  const alphabeta_t *pDeltaI = pHandle->DeltaIalphabetaPol;
+  const PCC_Weights_t *pWeights = PCC_GetWeights(pHandle);
+  PCC_Vector_t Err[PCC_HORIZON];
+  PCC_CostFrame_t CostFrame[PCC_HORIZON];
+  PCC_Vector_t FirstResidual = {0, 0};
+  PCC_Vector_t BestResidual;
+  int32_t wPathCost[PCC_HORIZON];
+  int32_t wAwayCost[PCC_HORIZON];
+  uint8_t bCoefShift = (uint8_t)pHandle->hCoefDivisorPOW2;
+  int32_t wKDecay = pHandle->wKDecay;
+  int32_t wMinCost = INT32_MAX;
+  int32_t wBestCost = INT32_MAX;
+  int32_t wSwitchingCost = PCC_SwitchingCost(pHandle, pWeights);
+  int32_t wTieBand = PCC_TieBand(pHandle);
+  int32_t wCost;
+  int16_t hResAlpha;
+  int16_t hResBeta;
+  uint16_t hNodeCount = 0U;
+  uint16_t hNodeBudget = pHandle->hNodeBudget;
+  uint16_t hRandom = pHandle->hRandom;
+  uint8_t bTies = 0U;
+  uint8_t Candidates[PCC_HORIZON][PCC_NB_VECTORS];
+  uint8_t bNbCandidates[PCC_HORIZON];
+  uint8_t bNext[PCC_HORIZON];
+  uint8_t bPathState[PCC_HORIZON + 1U];
+  uint8_t bPathVector[PCC_HORIZON + 1U];
+  uint8_t bDepth = 0U;
+  uint8_t bFirst = PCC_ZERO_VECTOR;
+  uint8_t bOptimal;
+  uint8_t bVector;
+  bool Searching = true;
+  bool BudgetExceeded = false;
+  bool Tripped = false;
+
+  for (bDepth = 0U; bDepth < PCC_HORIZON; bDepth++)
+  {
+    CostFrame[bDepth] = PCC_GetCostFrame(pHandle, Frame[bDepth], Iref[bDepth]);
+  }
+  bDepth = 0U;
+
+  /* Entry 0 of the path is the vector applied during the last period */
+  bPathState[0] = pHandle->bSwitchingState;
+  bPathVector[0] = (0 == wSwitchingCost) ? PCC_NO_VECTOR : pHandle->bOptimalVector;
+
+  /* Error left by the free response at the end of the first step */
+  Err[0].wAlpha = PCC_Saturate(Iref[0].wAlpha - BemfStep[0].wAlpha
+                              - PCC_DIV_POW2(wKDecay * State.wAlpha, bCoefShift), UINT16_MAX);
+  Err[0].wBeta = PCC_Saturate(Iref[0].wBeta - BemfStep[0].wBeta
+                             - PCC_DIV_POW2(wKDecay * State.wBeta, bCoefShift), UINT16_MAX);
+  bNbCandidates[0] = PCC_GetCandidates(Err[0].wAlpha, Err[0].wBeta, bPathVector[0], Candidates[0]);
+  wPathCost[0] = 0;
+  wAwayCost[0] = PCC_AwayCost(pHandle, pWeights, Err[0]);
+  bNext[0] = 0U;
+
+  /* Fallback if no sequence is completed: the vector closest to the deadbeat voltage */
+  bOptimal = Candidates[0][0];
+  BestResidual.wAlpha = PCC_Saturate(Err[0].wAlpha - (int32_t)pDeltaI[bOptimal].alpha, INT16_MAX);
+  BestResidual.wBeta = PCC_Saturate(Err[0].wBeta - (int32_t)pDeltaI[bOptimal].beta, INT16_MAX);
+
+  while (true == Searching)
+  {
+    if (bNext[bDepth] >= bNbCandidates[bDepth])
+    {
+      /* All the children of this node are done: back to its parent */
+      if (0U == bDepth)
+      {
+        Searching = false;
+      }
+      else
+      {
+        bDepth--;
+      }
+    }
+    else if ((wAwayCost[bDepth] > 0)
+             && (PCC_AddCost(wPathCost[bDepth], wAwayCost[bDepth]) >= PCC_AddCost(wMinCost, wTieBand))
+             && (true == PCC_PointsAway(Err[bDepth], pDeltaI[Candidates[bDepth][bNext[bDepth]]])))
+    {
+      /* Skipped: its residual is longer than the error, whose cost cannot beat the best sequence */
+      bNext[bDepth]++;
+    }
+    else if (hNodeCount >= hNodeBudget)
+    {
+      BudgetExceeded = true;
+      Searching = false;
+    }
+    else
+    {
+      bVector = Candidates[bDepth][bNext[bDepth]];
+      bNext[bDepth]++;
+      hNodeCount++;
+
+      hResAlpha = (int16_t)PCC_Saturate(Err[bDepth].wAlpha - (int32_t)pDeltaI[bVector].alpha, INT16_MAX);
+      hResBeta = (int16_t)PCC_Saturate(Err[bDepth].wBeta - (int32_t)pDeltaI[bVector].beta, INT16_MAX);
+      bPathState[bDepth + 1U] = PCC_GetSwitchingStateAfter(bVector, bPathState[bDepth]);
+      bPathVector[bDepth + 1U] = (0 == wSwitchingCost) ? PCC_NO_VECTOR : bVector;
+      wCost = PCC_AddCost(wPathCost[bDepth],
+                          PCC_ErrorCost(pHandle, pWeights, hResAlpha, hResBeta, Iref[bDepth], CostFrame[bDepth],
+                                        &Tripped));
+      wCost = PCC_AddCost(wCost, wSwitchingCost
+                          * (int32_t)PCC_Commutations[bPathState[bDepth] ^ bPathState[bDepth + 1U]]);
+
+      if (0U == bDepth)
+      {
+        bFirst = bVector;
+        FirstResidual.wAlpha = hResAlpha;
+        FirstResidual.wBeta = hResBeta;
+      }
+
+      if (wCost >= PCC_AddCost(wMinCost, wTieBand))
+      {
+        /* Pruned: this branch cannot beat nor tie the best sequence */
+      }
+      else if ((PCC_HORIZON - 1U) == bDepth)
+      {
+        if (true == PCC_TakeCandidate(wCost, wTieBand, &wMinCost, &bTies, &hRandom))
+        {
+          wBestCost = wCost;
+          bOptimal = bFirst;
+          BestResidual = FirstResidual;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+      }
+      else
+      {
+        /* Predicted currents at the end of this step, then the error left by
+           their free response at the end of the next one */
+        State.wAlpha = PCC_Saturate(Iref[bDepth].wAlpha - hResAlpha, INT16_MAX);
+        State.wBeta = PCC_Saturate(Iref[bDepth].wBeta - hResBeta, INT16_MAX);
+        bDepth++;
+        Err[bDepth].wAlpha = PCC_Saturate(Iref[bDepth].wAlpha - BemfStep[bDepth].wAlpha
+                                        - PCC_DIV_POW2(wKDecay * State.wAlpha, bCoefShift), UINT16_MAX);
+        Err[bDepth].wBeta = PCC_Saturate(Iref[bDepth].wBeta - BemfStep[bDepth].wBeta
+                                       - PCC_DIV_POW2(wKDecay * State.wBeta, bCoefShift), UINT16_MAX);
+        bNbCandidates[bDepth] = PCC_GetCandidates(Err[bDepth].wAlpha, Err[bDepth].wBeta, bPathVector[bDepth],
+                                                  Candidates[bDepth]);
+        wPathCost[bDepth] = wCost;
+        wAwayCost[bDepth] = PCC_AwayCost(pHandle, pWeights, Err[bDepth]);
+        bNext[bDepth] = 0U;
+      }
+    }
+  }
+
+  pHandle->hNodeCount = hNodeCount;
+  pHandle->BudgetExceeded = BudgetExceeded;
+  pHandle->TripRejected = Tripped;
+  pHandle->hRandom = hRandom;
+  *pResidual = BestResidual;
+  *pCost = wBestCost;
+  return (bOptimal);
+}
+#endif
+
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+/**
+  * @brief  It computes the current steps of the inverter voltage errors, for
+  *         each vector of the vector table and each polarity of the currents.
+  *
+  * PWMC_SetSwitchingState() switches the phases of the high sides of a state
+  * on during sqrt(3)/2 of the period and keeps the other phases, and the zero
+  * vector, on their low side. The error of one phase is then:
+  * - on its high side, the drop of the high switch or diode for sqrt(3)/2 of
+  *   the period and of the low diode or switch for the rest of it, plus the
+  *   dead time of its pulse, lost with a positive current and gained with a
+  *   negative one;
+  * - on its low side, the drop of the low diode or switch.
+  * The phase errors are summed along the phase axes, so that their common mode
+  * cancels, and converted into current steps with wKVolt.
+  *
+  * The switch and diode drops are fixed voltages, their current steps do not
+  * depend on the bus voltage. The dead time drop is a fraction of the bus
+  * voltage and is scaled by hBusScale.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval None
+  */
+static void PCC_UpdateCurrentOffsets(PCC_Handle_t *pHandle)
+{
+  uint8_t bCoefShift = (uint8_t)pHandle->hCoefDivisorPOW2;
+  int32_t wSwitch = (int32_t)pHandle->hSwitchDrop;
+  int32_t wDiode = (int32_t)pHandle->hDiodeDrop;
+  int32_t wDeadTime = PCC_DIV_POW2((int32_t)pHandle->hDeadTimeDrop * (int32_t)pHandle->hBusScale,
+                                   PCC_BUS_SCALE_POW2);
+  int32_t wErr;
+  int32_t wAlpha;
+  int32_t wBeta;
+  uint8_t bState;
+  uint8_t bPolarity;
+  uint8_t bPhase;
+  uint8_t i;
+
+  for (i = 0U; i < PCC_NB_VECTORS; i++)
+  {
+    bState = PCC_SwitchingStates[i];
+    for (bPolarity = 0U; bPolarity < PCC_NB_POLARITIES; bPolarity++)
+    {
+      wAlpha = 0;
+      wBeta = 0;
+      for (bPhase = 0U; bPhase < 3U; bPhase++)
+      {
+        bool Positive = (((uint32_t)bPolarity >> bPhase) & 1U) != 0U;
+
+        if ((((uint32_t)bState >> bPhase) & 1U) != 0U)
+        {
+          wErr = (true == Positive)
+               ? (-PCC_DIV_POW2((PCC_HIGH_SHARE_Q15 * wSwitch) + ((32768 - PCC_HIGH_SHARE_Q15) * wDiode), 15)
+                  - wDeadTime)
+               : (PCC_DIV_POW2((PCC_HIGH_SHARE_Q15 * wDiode) + ((32768 - PCC_HIGH_SHARE_Q15) * wSwitch), 15)
+                  + wDeadTime);
+        }
+        else
+        {
+          wErr = (true == Positive) ? -wDiode : wSwitch;
+        }
+        wAlpha += PCC_DIV_POW2(wErr * PCC_VectorTable[PCC_PhaseAxis[bPhase]].alpha, 15);
+        wBeta += PCC_DIV_POW2(wErr * PCC_VectorTable[PCC_PhaseAxis[bPhase]].beta, 15);
+      }
+      pHandle->DeltaIoffset[i][bPolarity].alpha = (int16_t)PCC_DIV_POW2(pHandle->wKVolt * wAlpha, bCoefShift);
+      pHandle->DeltaIoffset[i][bPolarity].beta = (int16_t)PCC_DIV_POW2(pHandle->wKVolt * wBeta, bCoefShift);
+    }
+  }
+  pHandle->bPolarity = PCC_NB_POLARITIES;
+}
+
+/**
+  * @brief  It returns the polarity of the phase currents of a current vector
+  * @param  wAlpha: alpha component of the current vector, |wAlpha| <= INT16_MAX
+  * @param  wBeta: beta component of the current vector, |wBeta| <= INT16_MAX
+  * @retval uint8_t Bit 0, 1 and 2 set when the current of phase A, B and C is positive
+  */
+static uint8_t PCC_GetPolarity(int32_t wAlpha, int32_t wBeta)
+{
+  /* Inverse of MCM_Clarke(): 2 ib = -sqrt(3) beta - alpha, 2 ic = sqrt(3) beta - alpha */
+  int32_t wSqrt3Beta = PCC_DIV_POW2(wBeta * PCC_SQRT3_Q13, 13);
+  uint8_t bPolarity = (wAlpha > 0) ? 1U : 0U;
+
+  bPolarity |= ((-wSqrt3Beta - wAlpha) > 0) ? 2U : 0U;
+  bPolarity |= ((wSqrt3Beta - wAlpha) > 0) ? 4U : 0U;
+  return (bPolarity);
+}
+
+/**
+  * @brief  It sets the current steps of the search for a polarity of the phase
+  *         currents. They are only computed again when the polarity changes,
+  *         i.e. six times per electrical period at the most.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  bPolarity: polarity of the phase currents, see PCC_GetPolarity()
+  * @retval None
+  */
+static void PCC_SetPolarity(PCC_Handle_t *pHandle, uint8_t bPolarity)
+{
+  uint8_t i;
+
+  if (bPolarity != pHandle->bPolarity)
+  {
+    for (i = 0U; i < PCC_NB_VECTORS; i++)
+    {
+      pHandle->DeltaIalphabetaPol[i].alpha = pHandle->DeltaIalphabeta[i].alpha + pHandle->DeltaIoffset[i][bPolarity].alpha;
+      pHandle->DeltaIalphabetaPol[i].beta = pHandle->DeltaIalphabeta[i].beta + pHandle->DeltaIoffset[i][bPolarity].beta;
+    }
+    pHandle->bPolarity = bPolarity;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+#endif
+/**
+  * @brief  It scales the voltage coefficient by the bus voltage ratio and
+  *         computes the current step produced by each vector of the vector
+  *         table from it
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval None
+  */
+static void PCC_UpdateCurrentSteps(PCC_Handle_t *pHandle)
+{
+  uint8_t bCoefShift = (uint8_t)pHandle->hCoefDivisorPOW2;
+  uint8_t i;
+
+#ifdef PCC_FULL_HEXAGON
+  /* The digits of the vector table are the ones of the vertices of the hexagon */
+  pHandle->wKVoltBus = (int32_t)PCC_DIV_POW2((int64_t)pHandle->wKVolt * (int64_t)pHandle->hBusScale
+                                             * (int64_t)PCC_HEXAGON_GAIN, PCC_BUS_SCALE_POW2 + 15U);
+#else
+  pHandle->wKVoltBus = (int32_t)PCC_DIV_POW2((int64_t)pHandle->wKVolt * (int64_t)pHandle->hBusScale,
+                                             PCC_BUS_SCALE_POW2);
+#endif
+#ifdef PCC_INDUCTANCE_TABLE
+  /* A saturated inductance steps the current further for the same voltage */
+  pHandle->wKVoltBus = (int32_t)PCC_DIV_POW2((int64_t)pHandle->wKVoltBus * (int64_t)pHandle->hLSatGainInUse,
+                                             PCC_LSAT_POW2);
+#endif
+  for (i = 0U; i < PCC_NB_VECTORS; i++)
+  {
+    pHandle->DeltaIalphabeta[i].alpha = (int16_t)PCC_DIV_POW2(pHandle->wKVoltBus * PCC_VectorTable[i].alpha,
+                                                              bCoefShift);
+    pHandle->DeltaIalphabeta[i].beta = (int16_t)PCC_DIV_POW2(pHandle->wKVoltBus * PCC_VectorTable[i].beta,
+                                                             bCoefShift);
+  }
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  PCC_UpdateCurrentOffsets(pHandle);
+#else
+  pHandle->wKVoltInv = (pHandle->wKVoltBus <= 0) ? 0
+                     : (int32_t)(((uint32_t)1 << (bCoefShift + 15U)) / (uint32_t)pHandle->wKVoltBus);
+#endif
+#ifdef PCC_SPLIT_PHASE
+  /* The terms prepared hold for the previous model */
+  pHandle->TermsReady = false;
+#endif
+}
+
+#if (PCC_HORIZON > 1U) || defined (PCC_EXACT_DISCRETISATION)
+/**
+  * @brief  It computes the terms of the model that only depend on the speed,
+  *         when the speed differs from the one they were computed for.
+  *
+  * With PCC_EXACT_DISCRETISATION the back-EMF step of one period is the one of
+  * the Euler model times (exp(mu) - 1) / mu, mu = -Rs Ts / Ls + j w Ts, in the
+  * frame of the end of the period. This is exp(mu / 2) sinh(mu / 2) / (mu / 2):
+  * a rotation by half the angle of the period and a magnitude of
+  * 1 - (w Ts)^2 / 24, the terms in Rs Ts / Ls alone being part of wKBemf.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hElSpeedDpp: electrical speed in dpp
+  * @retval None
+  */
+static void PCC_UpdateStep(PCC_Handle_t *pHandle, int16_t hElSpeedDpp)
+{
+  if (hElSpeedDpp != pHandle->hStepSpeedDpp)
+  {
+#ifdef PCC_EXACT_DISCRETISATION
+    {
+      /* The angle of the period and its half are computed in one call */
+      const int16_t hAngles[2] = {hElSpeedDpp, (int16_t)(hElSpeedDpp / 2)};
+      Trig_Components Trigs[2];
+      Trig_Components HalfTrig;
+      int64_t lDelta = PCC_DIV_POW2((int64_t)hElSpeedDpp * PCC_PI_Q13, 13);
+      int32_t wGain = (int32_t)32768 - (int32_t)(PCC_DIV_POW2(lDelta * lDelta, 15) / 24);
+
+      MCM_CALL(MCM_Trig_Functions_Batch)(hAngles, Trigs, 2U);
+      pHandle->StepTrig = Trigs[0];
+      HalfTrig = Trigs[1];
+      pHandle->wKDecayCos = PCC_DIV_POW2(pHandle->wKDecay * (int32_t)pHandle->StepTrig.hCos, 15);
+      pHandle->wKDecaySin = PCC_DIV_POW2(pHandle->wKDecay * (int32_t)pHandle->StepTrig.hSin, 15);
+      pHandle->hBemfCos = (int16_t)PCC_DIV_POW2(wGain * (int32_t)HalfTrig.hCos, 15);
+      pHandle->hBemfSin = (int16_t)PCC_DIV_POW2(wGain * (int32_t)HalfTrig.hSin, 15);
+    }
+#else
+    pHandle->StepTrig = MCM_CALL(MCM_Trig_Functions)(hElSpeedDpp);
+#endif
+    pHandle->hStepSpeedDpp = hElSpeedDpp;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+#endif
+
+/**
+  * @brief  It computes the terms of the prediction of one control period that
+  *         do not depend on the measured currents: the rotation of the period,
+  *         the current step of the back-EMF and the one of the voltage applied.
+  *         The back-EMF step of the observer, with PCC_SHARED_MODEL, is used
+  *         but not consumed.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Vqd: voltage applied during the period, see PCC_CalcVoltage()
+  * @param  Trig: cosine and sine of the electrical angle of the period
+  * @param  hElSpeedDpp: electrical speed in dpp
+  * @param  pTerms: terms of the period
+  * @retval None
+  */
+static void PCC_ComputeTerms(PCC_Handle_t *pHandle, qd_t Vqd, Trig_Components Trig, int16_t hElSpeedDpp,
+                             PCC_Terms_t *pTerms)
+{
+#ifdef PCC_ADAPTIVE_PERIOD
+  /* Angle covered by the decision period */
+  int16_t hStepSpeedDpp = (int16_t)PCC_Saturate((int32_t)hElSpeedDpp * (int32_t)((uint32_t)1U << pHandle->bPeriodLog),
+                                                INT16_MAX);
+#else
+  int16_t hStepSpeedDpp = hElSpeedDpp;
+#endif
+  uint8_t bCoefShift = (uint8_t)pHandle->hCoefDivisorPOW2;
+  int32_t wCos = (int32_t)Trig.hCos;
+  int32_t wSin = (int32_t)Trig.hSin;
+  int32_t wVq;
+  int32_t wVd;
+  int32_t wBemf;
+
+  pTerms->Trig = Trig;
+  pTerms->Vqd = Vqd;
+  pTerms->hElSpeedDpp = hElSpeedDpp;
+  pTerms->bPolarity = PCC_NB_POLARITIES;
+#ifndef PCC_EXACT_DISCRETISATION
+  pTerms->wDelta = PCC_DivPow2Odd(((int32_t)hStepSpeedDpp) * PCC_PI_Q13, 13U);
+#endif
+#if (PCC_HORIZON > 1U) || defined (PCC_EXACT_DISCRETISATION)
+  /* The rotation over one period only depends on the speed: it is computed
+     again when the speed changes, not at every period */
+  PCC_UpdateStep(pHandle, hStepSpeedDpp);
+  pTerms->wCosStep = (int32_t)pHandle->StepTrig.hCos;
+  pTerms->wSinStep = (int32_t)pHandle->StepTrig.hSin;
+#endif
+#ifdef PCC_EXACT_DISCRETISATION
+  pTerms->wCosNext = PCC_DIV_POW2(wCos * pTerms->wCosStep, 15) - PCC_DIV_POW2(wSin * pTerms->wSinStep, 15);
+  pTerms->wSinNext = PCC_DIV_POW2(wSin * pTerms->wCosStep, 15) + PCC_DIV_POW2(wCos * pTerms->wSinStep, 15);
+#else
+  pTerms->wCosNext = wCos - PCC_DIV_POW2(pTerms->wDelta * wSin, 15);
+  pTerms->wSinNext = wSin + PCC_DIV_POW2(pTerms->wDelta * wCos, 15);
+#endif
+
+#ifdef PCC_FULL_HEXAGON
+  if (true == pHandle->VqdHeld)
+  {
+    Vqd = pHandle->Vqd;
+  }
+  else
+  {
+    /* Voltage of the PI controllers, from the units of PWMC_SetPhaseVoltage() */
+    Vqd.q = (int16_t)PCC_DIV_POW2((int32_t)Vqd.q * (int32_t)PCC_HEXAGON_MODULE, 15);
+    Vqd.d = (int16_t)PCC_DIV_POW2((int32_t)Vqd.d * (int32_t)PCC_HEXAGON_MODULE, 15);
+  }
+#endif
+
+  /* Current step per period of the back-EMF */
+#ifdef PCC_SHARED_MODEL
+  if (true == pHandle->BemfShared)
+  {
+    /* Step of the observer model, that already holds the back-EMF terms */
+#ifdef PCC_ADAPTIVE_PERIOD
+    pTerms->wBemfQ = (int32_t)pHandle->BemfStep.q * (int32_t)((uint32_t)1U << pHandle->bPeriodLog);
+    pTerms->wBemfD = (int32_t)pHandle->BemfStep.d * (int32_t)((uint32_t)1U << pHandle->bPeriodLog);
+#else
+    pTerms->wBemfQ = (int32_t)pHandle->BemfStep.q;
+    pTerms->wBemfD = (int32_t)pHandle->BemfStep.d;
+#endif
+  }
+  else
+#endif
+  {
+#ifdef PCC_INDUCTANCE_TABLE
+    wBemf = PCC_DivPow2Odd(PCC_DivPow2Odd(pHandle->wKBemf * hStepSpeedDpp, (uint8_t)pHandle->hBemfDivisorPOW2)
+                           * (int32_t)pHandle->hLSatGainInUse, PCC_LSAT_POW2);
+#else
+    /* Odd in the speed: the same back-EMF step, reversed, in both directions */
+    wBemf = PCC_DivPow2Odd(pHandle->wKBemf * hStepSpeedDpp, (uint8_t)pHandle->hBemfDivisorPOW2);
+#endif
+#ifdef PCC_EXACT_DISCRETISATION
+    pTerms->wBemfQ = -PCC_DivPow2Odd(wBemf * (int32_t)pHandle->hBemfCos, 15U);
+    pTerms->wBemfD = -PCC_DIV_POW2(wBemf * (int32_t)pHandle->hBemfSin, 15);
+#else
+    pTerms->wBemfQ = -wBemf;
+    pTerms->wBemfD = 0;
+#endif
+  }
+
+  /* Applied voltage in the current frame */
+#ifdef PCC_EXACT_DISCRETISATION
+  wVq = PCC_DIV_POW2((int32_t)Vqd.q * pTerms->wCosStep, 15) - PCC_DIV_POW2((int32_t)Vqd.d * pTerms->wSinStep, 15);
+  wVd = PCC_DIV_POW2((int32_t)Vqd.d * pTerms->wCosStep, 15) + PCC_DIV_POW2((int32_t)Vqd.q * pTerms->wSinStep, 15);
+#else
+  wVq = (int32_t)Vqd.q - PCC_DIV_POW2(pTerms->wDelta * Vqd.d, 15);
+  wVd = (int32_t)Vqd.d + PCC_DIV_POW2(pTerms->wDelta * Vqd.q, 15);
+#endif
+  pTerms->wVoltQ = PCC_DIV_POW2(pHandle->wKVoltBus * wVq, bCoefShift);
+  pTerms->wVoltD = PCC_DIV_POW2(pHandle->wKVoltBus * wVd, bCoefShift);
+}
+
+/**
+  * @brief  It propagates currents to the end of the period of @p pTerms
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pTerms: terms of the period, see PCC_ComputeTerms()
+  * @param  Iqd: currents at the beginning of the period
+  * @param  wDriftQ: current step of the back-EMF and of the disturbance, q axis
+  * @param  wDriftD: current step of the back-EMF and of the disturbance, d axis
+  * @retval qd_t Currents at the end of the period, saturated to +/-INT16_MAX
+  */
+static inline qd_t PCC_Propagate(const PCC_Handle_t *pHandle, const PCC_Terms_t *pTerms, qd_t Iqd, int32_t wDriftQ,
+                                 int32_t wDriftD)
+{
+  uint8_t bCoefShift = (uint8_t)pHandle->hCoefDivisorPOW2;
+  qd_t IqdNext;
+  int32_t wIq;
+  int32_t wId;
+
+#ifdef PCC_EXACT_DISCRETISATION
+  wId = PCC_DIV_POW2(pHandle->wKDecayCos * Iqd.d, bCoefShift)
+      + PCC_DIV_POW2(pHandle->wKDecaySin * Iqd.q, bCoefShift)
+      + wDriftD
+      + pTerms->wVoltD;
+  wIq = PCC_DIV_POW2(pHandle->wKDecayCos * Iqd.q, bCoefShift)
+      - PCC_DIV_POW2(pHandle->wKDecaySin * Iqd.d, bCoefShift)
+      + wDriftQ
+      + pTerms->wVoltQ;
+#else
+  wId = PCC_DIV_POW2(pHandle->wKDecay * Iqd.d, bCoefShift)
+      + PCC_DIV_POW2(pTerms->wDelta * Iqd.q, 15)
+      + wDriftD
+      + pTerms->wVoltD;
+  wIq = PCC_DIV_POW2(pHandle->wKDecay * Iqd.q, bCoefShift)
+      - PCC_DIV_POW2(pTerms->wDelta * Iqd.d, 15)
+      + wDriftQ
+      + pTerms->wVoltQ;
+#endif
+  IqdNext.d = (int16_t)((wId > (int32_t)INT16_MAX) ? (int32_t)INT16_MAX
+                                                    : ((wId < -(int32_t)INT16_MAX) ? -(int32_t)INT16_MAX : wId));
+  IqdNext.q = (int16_t)((wIq > (int32_t)INT16_MAX) ? (int32_t)INT16_MAX
+                                                    : ((wIq < -(int32_t)INT16_MAX) ? -(int32_t)INT16_MAX : wIq));
+  return (IqdNext);
+}
+
+#ifdef PCC_VBUS_LIMIT
+/**
+  * @brief  It adapts the reference currents when braking close to the bus
+  *         voltage limit, #PCC_VBUS_LIMIT: a d current dissipates the power
+  *         and, with no candidate vectors to weigh, the q current is lowered
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Iqdref: reference stator currents in the q/d frame
+  * @param  hElSpeedDpp: electrical speed in dpp
+  * @param  pVbusLevel: PCC_Handle_t::hVbusLevel while braking, 0 otherwise
+  * @retval qd_t Reference stator currents of the period
+  */
+static inline qd_t PCC_LimitBrakeReference(const PCC_Handle_t *pHandle, qd_t Iqdref, int16_t hElSpeedDpp,
+                                           uint16_t *pVbusLevel)
+{
+  qd_t IqdrefBrake = Iqdref;
+  uint16_t hVbusLevel = pHandle->hVbusLevel;
+
+  if ((0U == hVbusLevel) || (((int32_t)Iqdref.q * (int32_t)hElSpeedDpp) >= 0))
+  {
+    hVbusLevel = 0U;
+  }
+  else
+  {
+    IqdrefBrake.d = (int16_t)PCC_Saturate((int32_t)Iqdref.d
+                                          - PCC_DIV_POW2((int32_t)pHandle->hBrakeIdMax * (int32_t)hVbusLevel, 15),
+                                          INT16_MAX);
+#if (PCC_OUTPUT_MODE != PCC_FINITE_SET) || (PCC_HORIZON > 1U)
+    IqdrefBrake.q = (int16_t)PCC_DIV_POW2((int32_t)Iqdref.q * (32768 - (int32_t)hVbusLevel), 15);
+#endif
+  }
+  *pVbusLevel = hVbusLevel;
+  return (IqdrefBrake);
+}
+#endif
+
+/**
+  * @brief  It updates the estimates of the model from the error of the currents
+  *         predicted for this period by the previous call of PCC_CalcVoltage().
+  *
+  * The disturbance observer corrects the current step per period that the model
+  * misses. It follows a slow drift of the model: a residual, the error, that
+  * stays large is rather a fault of the measured currents, an open phase or a
+  * step of the parameters, and starts a fallback. With PCC_LIMIT_EVENTS no
+  * estimate is updated after a cut of the current limit, that the model does
+  * not know.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Iqd: measured stator currents in the q/d frame
+  * @retval bool true if the currents of the period were predicted, and
+  *         PCC_Handle_t::hResidual computed
+  */
+static inline bool PCC_EstimateModel(PCC_Handle_t *pHandle, qd_t Iqd)
+{
+  bool ResidualValid = false;
+
+#ifdef PCC_LIMIT_EVENTS
+  if ((true == pHandle->NextValid) && (false == pHandle->LimitEvent))
+#else
+  if (true == pHandle->NextValid)
+#endif
+  {
+    int32_t wErrQ = (int32_t)Iqd.q - (int32_t)pHandle->IqdNext.q;
+    int32_t wErrD = (int32_t)Iqd.d - (int32_t)pHandle->IqdNext.d;
+    uint32_t wResidual = (uint32_t)((wErrQ < 0) ? -wErrQ : wErrQ) + (uint32_t)((wErrD < 0) ? -wErrD : wErrD);
+
+    pHandle->Disturbance.q = (int16_t)PCC_Saturate((int32_t)pHandle->Disturbance.q
+                           + PCC_DIV_POW2((int32_t)pHandle->hDistGain * wErrQ, 15), INT16_MAX);
+    pHandle->Disturbance.d = (int16_t)PCC_Saturate((int32_t)pHandle->Disturbance.d
+                           + PCC_DIV_POW2((int32_t)pHandle->hDistGain * wErrD, 15), INT16_MAX);
+
+    pHandle->hResidual = (wResidual < UINT16_MAX) ? (uint16_t)wResidual : UINT16_MAX;
+    ResidualValid = true;
+    pHandle->wResidualSum += (uint32_t)pHandle->hResidual - (pHandle->wResidualSum >> pHandle->bResidualShift);
+    if ((pHandle->hResidualLimit > 0U)
+        && ((pHandle->wResidualSum >> pHandle->bResidualShift) > pHandle->hResidualLimit))
+    {
+      pHandle->wResidualSum = 0U;
+      pHandle->hFallbackCounter = pHandle->hFallbackPeriods;
+      pHandle->hFallbackEvents += (pHandle->hFallbackEvents < UINT16_MAX) ? 1U : 0U;
+      pHandle->hResidualEvents += (pHandle->hResidualEvents < UINT16_MAX) ? 1U : 0U;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* No prediction for this period */
+    pHandle->hResidual = 0U;
+  }
+  return (ResidualValid);
+}
+
+#ifdef PCC_STATE_FILTER
+/**
+  * @brief  It returns the fixed gain Kalman estimate of the currents, between
+  *         the currents predicted for this period and the measured ones, so
+  *         that it stays in the int16_t range. Only valid when
+  *         PCC_EstimateModel() reports a prediction for the period.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Iqd: measured stator currents in the q/d frame
+  * @retval qd_t Estimated stator currents in the q/d frame
+  */
+static inline qd_t PCC_FilterState(const PCC_Handle_t *pHandle, qd_t Iqd)
+{
+  int32_t wErrQ = (int32_t)Iqd.q - (int32_t)pHandle->IqdNext.q;
+  int32_t wErrD = (int32_t)Iqd.d - (int32_t)pHandle->IqdNext.d;
+  qd_t IqdEst;
+
+  IqdEst.q = (int16_t)((int32_t)pHandle->IqdNext.q + PCC_DIV_POW2((int32_t)pHandle->hStateGain * wErrQ, 15));
+  IqdEst.d = (int16_t)((int32_t)pHandle->IqdNext.d + PCC_DIV_POW2((int32_t)pHandle->hStateGain * wErrD, 15));
+  return (IqdEst);
+}
+#endif
+
+/**
+  * @brief  It computes the current step per period of the back-EMF and of the
+  *         disturbance. With HARMONIC_COMPENSATION it subtracts the harmonics of
+  *         the back-EMF, by angle, that the model at the speed misses.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pTerms: terms of the period, see PCC_ComputeTerms()
+  * @param  pDriftQ: current step, q axis
+  * @param  pDriftD: current step, d axis
+  * @retval None
+  */
+static inline void PCC_GetDrift(const PCC_Handle_t *pHandle, const PCC_Terms_t *pTerms, int32_t *pDriftQ,
+                                int32_t *pDriftD)
+{
+  int32_t wDriftQ = (int32_t)pHandle->Disturbance.q + pTerms->wBemfQ;
+  int32_t wDriftD = (int32_t)pHandle->Disturbance.d + pTerms->wBemfD;
+
+#ifdef HARMONIC_COMPENSATION
+  wDriftQ -= PCC_DIV_POW2(pHandle->wKVoltBus * (int32_t)pHandle->BemfHarmonic.q, (uint8_t)pHandle->hCoefDivisorPOW2);
+  wDriftD -= PCC_DIV_POW2(pHandle->wKVoltBus * (int32_t)pHandle->BemfHarmonic.d, (uint8_t)pHandle->hCoefDivisorPOW2);
+#endif
+  *pDriftQ = wDriftQ;
+  *pDriftD = wDriftD;
+}
+
+#if (PCC_HORIZON > 1U)
+/**
+  * @brief  It builds the steps of the horizon from the end of the period of
+  *         @p pTerms and selects the first vector of the best sequence with
+  *         PCC_HorizonSearch().
+  *
+  * The prediction is carried out in the alpha/beta frame, where the vectors do
+  * not rotate: the reference and the back-EMF are rotated by the angle of the
+  * period at each step. The reference is reached at the angle of the end of a
+  * step. The back-EMF and the disturbance act at the angle of the start of the
+  * step, or with PCC_EXACT_DISCRETISATION at the one of its end, the frame in
+  * which the exact step of the model is computed.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pTerms: terms of the period, see PCC_ComputeTerms()
+  * @param  IqdNext: currents at the end of the period, in the q/d frame
+  * @param  Iqdref: reference stator currents in the q/d frame
+  * @param  wDriftQ: current step of the back-EMF and of the disturbance, q axis
+  * @param  wDriftD: current step of the back-EMF and of the disturbance, d axis
+  * @param  pDecision: selected vector, its residual at the end of the first step
+  *         and the frame of that step
+  * @retval None
+  */
+static inline void PCC_HorizonDecision(PCC_Handle_t *pHandle, const PCC_Terms_t *pTerms, qd_t IqdNext, qd_t Iqdref,
+                                       int32_t wDriftQ, int32_t wDriftD, PCC_Decision_t *pDecision)
+{
+  PCC_Vector_t State;
+  PCC_Vector_t Iref[PCC_HORIZON];
+  Trig_Components Frame[PCC_HORIZON];
+  PCC_Vector_t BemfStep[PCC_HORIZON];
+  int32_t wIq = (int32_t)IqdNext.q;
+  int32_t wId = (int32_t)IqdNext.d;
+  int32_t wCosStep = pTerms->wCosStep;
+  int32_t wSinStep = pTerms->wSinStep;
+  int32_t wCosK = pTerms->wCosNext;
+  int32_t wSinK = pTerms->wSinNext;
+  int32_t wTmp;
+  uint8_t j;
+
+  State.wAlpha = PCC_Saturate(PCC_DIV_POW2(wIq * wCosK, 15) + PCC_DIV_POW2(wId * wSinK, 15), INT16_MAX);
+  State.wBeta = PCC_Saturate(PCC_DIV_POW2(wId * wCosK, 15) - PCC_DIV_POW2(wIq * wSinK, 15), INT16_MAX);
+
+  for (j = 0U; j < PCC_HORIZON; j++)
+  {
+#ifndef PCC_EXACT_DISCRETISATION
+    BemfStep[j].wAlpha = PCC_DIV_POW2(wDriftQ * wCosK, 15) + PCC_DIV_POW2(wDriftD * wSinK, 15);
+    BemfStep[j].wBeta = PCC_DIV_POW2(wDriftD * wCosK, 15) - PCC_DIV_POW2(wDriftQ * wSinK, 15);
+#endif
+
+    wTmp = PCC_DIV_POW2(wCosK * wCosStep, 15) - PCC_DIV_POW2(wSinK * wSinStep, 15);
+    wSinK = PCC_DIV_POW2(wSinK * wCosStep, 15) + PCC_DIV_POW2(wCosK * wSinStep, 15);
+    wCosK = wTmp;
+    Iref[j].wAlpha = PCC_DIV_POW2((int32_t)Iqdref.q * wCosK, 15) + PCC_DIV_POW2((int32_t)Iqdref.d * wSinK, 15);
+    Iref[j].wBeta = PCC_DIV_POW2((int32_t)Iqdref.d * wCosK, 15) - PCC_DIV_POW2((int32_t)Iqdref.q * wSinK, 15);
+    Frame[j].hCos = (int16_t)wCosK;
+    Frame[j].hSin = (int16_t)wSinK;
+#ifdef PCC_EXACT_DISCRETISATION
+    BemfStep[j].wAlpha = PCC_DIV_POW2(wDriftQ * wCosK, 15) + PCC_DIV_POW2(wDriftD * wSinK, 15);
+    BemfStep[j].wBeta = PCC_DIV_POW2(wDriftD * wCosK, 15) - PCC_DIV_POW2(wDriftQ * wSinK, 15);
+#endif
+
+    if (0U == j)
+    {
+      pDecision->wCosPred = wCosK;
+      pDecision->wSinPred = wSinK;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+
+  pDecision->bVector = PCC_HorizonSearch(pHandle, State, Iref, Frame, BemfStep, &pDecision->Residual,
+                                         &pDecision->wCost);
+  pDecision->Voltage.wAlpha = (int32_t)PCC_VectorTable[pDecision->bVector].alpha;
+  pDecision->Voltage.wBeta = (int32_t)PCC_VectorTable[pDecision->bVector].beta;
+  pHandle->TripPredicted = (0 != pHandle->hTripCurr)
+                         && (PCC_PhasePeak(PCC_Saturate(Iref[0].wAlpha - pDecision->Residual.wAlpha, INT16_MAX),
+                                           PCC_Saturate(Iref[0].wBeta - pDecision->Residual.wBeta, INT16_MAX))
+                             > (uint32_t)pHandle->hTripCurr);
+}
+#else
+/**
+  * @brief  It returns the free response error of the next period: the reference
+  *         minus the currents that the model predicts with no voltage applied,
+  *         common to all the candidate vectors, rotated into the alpha/beta frame
+  *         of the end of the period. With PCC_EXACT_DISCRETISATION the decay and
+  *         rotation of the currents are the exact ones of the model, otherwise
+  *         their first order approximation.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pTerms: terms of the period, see PCC_ComputeTerms()
+  * @param  IqdNext: currents at the end of the period, in the q/d frame
+  * @param  Iqdref: reference stator currents in the q/d frame
+  * @param  wDriftQ: current step of the back-EMF and of the disturbance, q axis
+  * @param  wDriftD: current step of the back-EMF and of the disturbance, d axis
+  * @retval PCC_Vector_t Free response error, from q/d components saturated to
+  *         +/-UINT16_MAX
+  */
+static inline PCC_Vector_t PCC_FreeResponseError(const PCC_Handle_t *pHandle, const PCC_Terms_t *pTerms, qd_t IqdNext,
+                                                 qd_t Iqdref, int32_t wDriftQ, int32_t wDriftD)
+{
+  PCC_Vector_t Err;
+  uint8_t bCoefShift = (uint8_t)pHandle->hCoefDivisorPOW2;
+  int32_t wIq = (int32_t)IqdNext.q;
+  int32_t wId = (int32_t)IqdNext.d;
+  int32_t wIdFree;
+  int32_t wIqFree;
+  int32_t wErrD;
+  int32_t wErrQ;
+
+#ifdef PCC_EXACT_DISCRETISATION
+  wIdFree = PCC_DIV_POW2(pHandle->wKDecayCos * wId, bCoefShift)
+          + PCC_DIV_POW2(pHandle->wKDecaySin * wIq, bCoefShift)
+          + wDriftD;
+  wIqFree = PCC_DIV_POW2(pHandle->wKDecayCos * wIq, bCoefShift)
+          - PCC_DIV_POW2(pHandle->wKDecaySin * wId, bCoefShift)
+          + wDriftQ;
+#else
+  wIdFree = PCC_DIV_POW2(pHandle->wKDecay * wId, bCoefShift)
+          + PCC_DIV_POW2(pTerms->wDelta * wIq, 15)
+          + wDriftD;
+  wIqFree = PCC_DIV_POW2(pHandle->wKDecay * wIq, bCoefShift)
+          - PCC_DIV_POW2(pTerms->wDelta * wId, 15)
+          + wDriftQ;
+#endif
+
+  wErrQ = (int32_t)Iqdref.q - wIqFree;
+  wErrD = (int32_t)Iqdref.d - wIdFree;
+  wErrQ = (wErrQ > (int32_t)UINT16_MAX) ? (int32_t)UINT16_MAX : ((wErrQ < -(int32_t)UINT16_MAX) ? -(int32_t)UINT16_MAX : wErrQ);
+  wErrD = (wErrD > (int32_t)UINT16_MAX) ? (int32_t)UINT16_MAX : ((wErrD < -(int32_t)UINT16_MAX) ? -(int32_t)UINT16_MAX : wErrD);
+  Err.wAlpha = PCC_DIV_POW2(wErrQ * pTerms->wCosNext, 15) + PCC_DIV_POW2(wErrD * pTerms->wSinNext, 15);
+  Err.wBeta = PCC_DIV_POW2(wErrD * pTerms->wCosNext, 15) - PCC_DIV_POW2(wErrQ * pTerms->wSinNext, 15);
+  return (Err);
+}
+
+#if (PCC_OUTPUT_MODE == PCC_MODULATED)
+/**
+  * @brief  It selects the average voltage of the next period with
+  *         PCC_ModulatedSearch(), #PCC_MODULATED
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Err: free response error, see PCC_FreeResponseError()
+  * @param  pDecision: selected voltage, its residual and cost
+  * @retval None
+  */
+static inline void PCC_ModulatedDecision(PCC_Handle_t *pHandle, PCC_Vector_t Err, PCC_Decision_t *pDecision)
+{
+  int32_t wResAlpha;
+  int32_t wResBeta;
+
+  pDecision->bVector = PCC_ModulatedSearch(pHandle, Err.wAlpha, Err.wBeta, &pDecision->Voltage,
+                                           &pDecision->Residual);
+  wResAlpha = PCC_Saturate(pDecision->Residual.wAlpha, INT16_MAX);
+  wResBeta = PCC_Saturate(pDecision->Residual.wBeta, INT16_MAX);
+  pDecision->wCost = PCC_AddCost(wResAlpha * wResAlpha, wResBeta * wResBeta);
+}
+#elif (PCC_OUTPUT_MODE == PCC_DEADBEAT)
+/**
+  * @brief  It computes the voltage whose current step cancels the free response
+  *         error, #PCC_DEADBEAT, limited along its direction to hMaxModule, the
+  *         circle limitation applied on the voltage returned by
+  *         PCC_CalcVoltage(). The residual is the one of the limited voltage:
+  *         the currents predicted for the next period are the ones that the
+  *         applied voltage gives, and the disturbance observer does not take
+  *         the limitation for a model error.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Err: free response error, see PCC_FreeResponseError()
+  * @param  pDecision: voltage, its residual and cost, and the active vector that
+  *         starts its sector, logged as the selected vector
+  * @retval None
+  */
+static inline void PCC_DeadbeatDecision(PCC_Handle_t *pHandle, PCC_Vector_t Err, PCC_Decision_t *pDecision)
+{
+  uint8_t bCoefShift = (uint8_t)pHandle->hCoefDivisorPOW2;
+  int32_t wKVoltBus = pHandle->wKVoltBus;
+  PCC_Vector_t Voltage = PCC_GetStepVoltage(pHandle, Err);
+  int32_t wScale = PCC_GetModuleScale(pHandle, Voltage);
+  int32_t wVoltAlpha = PCC_DIV_POW2(Voltage.wAlpha * wScale, 15);
+  int32_t wVoltBeta = PCC_DIV_POW2(Voltage.wBeta * wScale, 15);
+  int32_t wResAlpha;
+  int32_t wResBeta;
+
+  pDecision->Voltage.wAlpha = wVoltAlpha;
+  pDecision->Voltage.wBeta = wVoltBeta;
+  pDecision->Residual.wAlpha = Err.wAlpha - PCC_DIV_POW2(wKVoltBus * wVoltAlpha, bCoefShift);
+  pDecision->Residual.wBeta = Err.wBeta - PCC_DIV_POW2(wKVoltBus * wVoltBeta, bCoefShift);
+  wResAlpha = PCC_Saturate(pDecision->Residual.wAlpha, INT16_MAX);
+  wResBeta = PCC_Saturate(pDecision->Residual.wBeta, INT16_MAX);
+  pDecision->wCost = PCC_AddCost(wResAlpha * wResAlpha, wResBeta * wResBeta);
+  pDecision->bVector = PCC_GetSector(wVoltAlpha, wVoltBeta);
+  pHandle->hNodeCount = 1U;
+}
+#else
+/**
+  * @brief  It selects the vector of the next period among the candidates of
+  *         PCC_GetCandidates(), #PCC_FINITE_SET: the one of least cost, the
+  *         error, switching and, with #PCC_VBUS_LIMIT, regeneration terms. The
+  *         candidates whose current step points away from the error are skipped
+  *         once their bound, PCC_AwayCost(), cannot beat the best vector.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pTerms: terms of the period, see PCC_ComputeTerms()
+  * @param  Err: free response error, see PCC_FreeResponseError()
+  * @param  Iqdref: reference stator currents in the q/d frame
+  * @param  hVbusLevel: PCC_Handle_t::hVbusLevel while braking, 0 otherwise or
+  *         without #PCC_VBUS_LIMIT
+  * @param  pDecision: selected vector, its residual and cost, left unchanged if
+  *         no candidate is evaluated
+  * @retval None
+  */
+static inline void PCC_FiniteSetDecision(PCC_Handle_t *pHandle, const PCC_Terms_t *pTerms, PCC_Vector_t Err,
+                                         qd_t Iqdref, uint16_t hVbusLevel, PCC_Decision_t *pDecision)
+{
+  const PCC_Weights_t *pWeights = PCC_GetWeights(pHandle);
+  PCC_Vector_t Iref;
+  Trig_Components Frame;
+  PCC_CostFrame_t CostFrame;
+  int32_t wCosNext = pTerms->wCosNext;
+  int32_t wSinNext = pTerms->wSinNext;
+  int32_t wCost;
+  int32_t wSwitchingCost = PCC_SwitchingCost(pHandle, pWeights);
+  int32_t wTieBand = PCC_TieBand(pHandle);
+  int32_t wLowestCost = INT32_MAX;
+  int32_t wAwayCost;
+  uint8_t Candidates[PCC_NB_VECTORS];
+  uint8_t bNbCandidates;
+  uint8_t bNbEvaluated = 0U;
+  uint8_t bTies = 0U;
+  uint8_t bPrevState = pHandle->bSwitchingState;
+  uint8_t bState;
+  uint8_t i;
+  int16_t hResAlpha;
+  int16_t hResBeta;
+  bool Tripped = false;
+#ifdef PCC_VBUS_LIMIT
+  uint32_t wRegenGain = ((uint32_t)pHandle->hRegenWeight * hVbusLevel) >> 15U;
+#else
+  (void)hVbusLevel;
+#endif
+
+  /* Reference and q/d frame at the end of the next period, for the weights */
+  Iref.wAlpha = PCC_DIV_POW2((int32_t)Iqdref.q * wCosNext, 15) + PCC_DIV_POW2((int32_t)Iqdref.d * wSinNext, 15);
+  Iref.wBeta = PCC_DIV_POW2((int32_t)Iqdref.d * wCosNext, 15) - PCC_DIV_POW2((int32_t)Iqdref.q * wSinNext, 15);
+  Frame.hCos = (int16_t)wCosNext;
+  Frame.hSin = (int16_t)wSinNext;
+  CostFrame = PCC_GetCostFrame(pHandle, Frame, Iref);
+  wAwayCost = PCC_AwayCost(pHandle, pWeights, Err);
+  bNbCandidates = PCC_GetCandidates(Err.wAlpha, Err.wBeta,
+                                    (0 == wSwitchingCost) ? PCC_NO_VECTOR : pHandle->bOptimalVector, Candidates);
+  for (i = 0U; i < bNbCandidates; i++)
+  {
+    if ((wAwayCost > 0) && (wAwayCost >= PCC_AddCost(wLowestCost, wTieBand))
+        && (true == PCC_PointsAway(Err, pHandle->DeltaIalphabetaPol[Candidates[i]])))
+    {
+      /* Skipped: its residual is longer than the error, whose cost cannot beat the best vector */
+    }
+    else
+    {
+      bNbEvaluated++;
+      hResAlpha = (int16_t)PCC_Saturate(Err.wAlpha - (int32_t)pHandle->DeltaIalphabetaPol[Candidates[i]].alpha, INT16_MAX);
+      hResBeta = (int16_t)PCC_Saturate(Err.wBeta - (int32_t)pHandle->DeltaIalphabetaPol[Candidates[i]].beta, INT16_MAX);
+      bState = PCC_GetSwitchingStateAfter(Candidates[i], bPrevState);
+      wCost = PCC_AddCost(PCC_ErrorCost(pHandle, pWeights, hResAlpha, hResBeta, Iref, CostFrame, &Tripped),
+                          wSwitchingCost * (int32_t)PCC_Commutations[bPrevState ^ bState]);
+#ifdef PCC_VBUS_LIMIT
+      wCost = PCC_AddCost(wCost, PCC_RegenCost(Candidates[i], Iref, hResAlpha, hResBeta, wRegenGain));
+#endif
+
+      if (true == PCC_TakeCandidate(wCost, wTieBand, &wLowestCost, &bTies, &pHandle->hRandom))
+      {
+        pDecision->wCost = wCost;
+        pDecision->bVector = Candidates[i];
+        pDecision->Residual.wAlpha = hResAlpha;
+        pDecision->Residual.wBeta = hResBeta;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+  }
+
+  pDecision->Voltage.wAlpha = (int32_t)PCC_VectorTable[pDecision->bVector].alpha;
+  pDecision->Voltage.wBeta = (int32_t)PCC_VectorTable[pDecision->bVector].beta;
+  pHandle->hNodeCount = (uint16_t)bNbEvaluated;
+  pHandle->TripRejected = Tripped;
+  pHandle->TripPredicted = (0 != pHandle->hTripCurr)
+                         && (PCC_PhasePeak(PCC_Saturate(Iref.wAlpha - pDecision->Residual.wAlpha, INT16_MAX),
+                                           PCC_Saturate(Iref.wBeta - pDecision->Residual.wBeta, INT16_MAX))
+                             > (uint32_t)pHandle->hTripCurr);
+}
+#endif
+#endif
+
+/**
+  * @brief  It logs the decision of the period for the MCPA datalog, in
+  *         PCC_Handle_t::hLogDecision and hLogCost, read in place without any
+  *         copy, and adds it to the statistics of the window, closed by
+  *         PCC_UpdateStats(). Repeated overruns of the search start a fallback,
+  *         counted by PCC_FallbackTick().
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  bPrevVector: vector selected by the previous period
+  * @param  ResidualValid: true if PCC_Handle_t::hResidual was computed in the
+  *         period, see PCC_EstimateModel()
+  * @retval None
+  */
+static inline void PCC_LogDecision(PCC_Handle_t *pHandle, uint8_t bPrevVector, bool ResidualValid)
+{
+  PCC_Stats_t *pStats = &pHandle->Stats[pHandle->bStatsIndex];
+  uint8_t bOptimal = pHandle->bOptimalVector;
+  uint16_t hLogNodes = (pHandle->hNodeCount > PCC_LOG_NODES_MAX) ? (uint16_t)PCC_LOG_NODES_MAX : pHandle->hNodeCount;
+
+  pHandle->hLogDecision = (uint16_t)(((uint32_t)bOptimal << PCC_LOG_VECTOR_POS)
+                                   | ((uint32_t)pHandle->bSwitchingState << PCC_LOG_STATE_POS)
+                                   | ((true == pHandle->BudgetExceeded) ? (1UL << PCC_LOG_BUDGET_POS) : 0UL)
+                                   | ((uint32_t)hLogNodes << PCC_LOG_NODES_POS));
+  pHandle->hLogCost = ((uint32_t)pHandle->wCost >= (0x10000UL << PCC_LOG_COST_POW2)) ? UINT16_MAX
+                    : (uint16_t)((uint32_t)pHandle->wCost >> PCC_LOG_COST_POW2);
+
+  if (pStats->hNbPeriods < UINT16_MAX)
+  {
+    pStats->hNbPeriods++;
+    pStats->wCostSum += pHandle->hLogCost;
+    pStats->hCostMax = (pHandle->hLogCost > pStats->hCostMax) ? pHandle->hLogCost : pStats->hCostMax;
+    pStats->hVectorCount[bOptimal]++;
+    pStats->hVectorChanges += (bOptimal != bPrevVector) ? 1U : 0U;
+    pStats->hBudgetExceeded += (true == pHandle->BudgetExceeded) ? 1U : 0U;
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    pStats->hTripRejected += (true == pHandle->TripRejected) ? 1U : 0U;
+    pStats->hTripPredicted += (true == pHandle->TripPredicted) ? 1U : 0U;
+#endif
+#ifdef PCC_LIMIT_EVENTS
+    pStats->hLimitEvents += (true == pHandle->LimitEvent) ? 1U : 0U;
+#endif
+    if (true == ResidualValid)
+    {
+      pStats->hResidualPeriods++;
+      pStats->wResidualSum += pHandle->hResidual;
+      pStats->hResidualMax = (pHandle->hResidual > pStats->hResidualMax) ? pHandle->hResidual : pStats->hResidualMax;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  if (true == pHandle->BudgetExceeded)
+  {
+    pHandle->hOverrunCount++;
+    if ((pHandle->hFallbackOverruns > 0U) && (pHandle->hOverrunCount >= pHandle->hFallbackOverruns))
+    {
+      pHandle->hOverrunCount = 0U;
+      pHandle->hFallbackCounter = pHandle->hFallbackPeriods;
+      pHandle->hFallbackEvents += (pHandle->hFallbackEvents < UINT16_MAX) ? 1U : 0U;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    pHandle->hOverrunCount = 0U;
+  }
+}
+
+/**
+  * @brief  It resets the statistics of one window
+  * @param  pStats: statistics to reset
+  * @retval None
+  */
+static void PCC_ClearStats(PCC_Stats_t *pStats)
+{
+  uint8_t i;
+
+  pStats->wCostSum = 0U;
+  pStats->hCostMax = 0U;
+  pStats->hNbPeriods = 0U;
+  pStats->hVectorChanges = 0U;
+  pStats->hBudgetExceeded = 0U;
+  pStats->hTripRejected = 0U;
+  pStats->hTripPredicted = 0U;
+  pStats->hLimitEvents = 0U;
+  pStats->wResidualSum = 0U;
+  pStats->hResidualMax = 0U;
+  pStats->hResidualPeriods = 0U;
+  for (i = 0U; i < PCC_NB_VECTORS; i++)
+  {
+    pStats->hVectorCount[i] = 0U;
+  }
+}
+
+/**
+  * @brief  It initializes the handle and computes the current step table
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval None
+  */
+__weak void PCC_Init(PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->wNominalBusInv = (0U == pHandle->hNominalBusVoltage) ? 0U
+                            : (((uint32_t)1 << (PCC_BUS_SCALE_POW2 + 16U)) / (uint32_t)pHandle->hNominalBusVoltage);
+    pHandle->hBusScale = PCC_BUS_SCALE_ONE;
+    pHandle->BusScalePending = false;
+#ifdef PCC_VBUS_LIMIT
+    pHandle->wVbusRangeInv = (pHandle->hVbusLimit_d <= pHandle->hVbusStart_d) ? 0U
+                           : (((uint32_t)1 << 31U) / (uint32_t)(pHandle->hVbusLimit_d - pHandle->hVbusStart_d));
+    pHandle->hVbusLevel = 0U;
+#endif
+#ifdef PCC_INDUCTANCE_TABLE
+    {
+      int32_t wRange = ((int32_t)pHandle->hLSatStep * (int32_t)(PCC_LSAT_POINTS - 1U)) - (int32_t)pHandle->hLSatKnee;
+      uint8_t i;
+
+      for (i = 0U; i < PCC_LSAT_POINTS; i++)
+      {
+        int32_t wAbove = ((int32_t)pHandle->hLSatStep * (int32_t)i) - (int32_t)pHandle->hLSatKnee;
+        uint32_t wL = PCC_LSAT_ONE;
+
+        if ((wAbove > 0) && (wRange > 0))
+        {
+          wL -= (uint32_t)(((int32_t)pHandle->hLSatDrop * wAbove) / wRange);
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        pHandle->hLSatGain[i] = (uint16_t)(((uint32_t)PCC_LSAT_ONE * (uint32_t)PCC_LSAT_ONE) / wL);
+      }
+    }
+    pHandle->wLSatStepInv = (pHandle->hLSatStep <= 0) ? 0U
+                          : (((uint32_t)1 << 16U) / (uint32_t)pHandle->hLSatStep);
+    pHandle->hLSatGainInUse = PCC_GetInductanceGain(pHandle, 0);
+#endif
+    PCC_UpdateCurrentSteps(pHandle);
+    pHandle->TuningPending = false;
+#if (PCC_HORIZON > 1U) || defined (PCC_EXACT_DISCRETISATION)
+    pHandle->hStepSpeedDpp = INT16_MIN;
+#endif
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    pHandle->wLimitSqCurr = (uint32_t)((int32_t)pHandle->hLimitCurr * (int32_t)pHandle->hLimitCurr);
+    pHandle->wMaxSqCurr = (0 == pHandle->hMaxCurr) ? UINT32_MAX
+                        : (uint32_t)((int32_t)pHandle->hMaxCurr * (int32_t)pHandle->hMaxCurr);
+    pHandle->bWeightIndex = 0U;
+#if (PCC_COST_NORM == PCC_COST_L2_SAT) || (PCC_COST_NORM == PCC_COST_L2_PACKED)
+    PCC_UpdateCostSaturation(pHandle);
+#endif
+#if (PCC_COST_NORM == PCC_COST_L2_PACKED)
+    PCC_UpdatePackedScales(pHandle);
+#endif
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+    PCC_SetFluxCurrent(pHandle, pHandle->wFluxCurr);
+#endif
+    pHandle->hRandom = PCC_RANDOM_SEED;
+#endif
+#ifdef PCC_ADAPTIVE_PERIOD
+    /* The model of the handle is the one of a single control period */
+    pHandle->bPeriodLog = 0U;
+    pHandle->bPendingPeriodLog = 0U;
+#endif
+    PCC_Clear(pHandle);
+    PCC_ClearStats(&pHandle->Stats[0]);
+    PCC_ClearStats(&pHandle->Stats[1]);
+    pHandle->hStatsCounter = 0U;
+    pHandle->bStatsIndex = 0U;
+    pHandle->hFallbackEvents = 0U;
+    pHandle->hResidualEvents = 0U;
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+/**
+  * @brief  It resets the result of the last optimisation
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval None
+  */
+__weak void PCC_Clear(PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->IqdPred.q = 0;
+    pHandle->IqdPred.d = 0;
+    pHandle->Disturbance.q = 0;
+    pHandle->Disturbance.d = 0;
+    pHandle->NextValid = false;
+#ifdef PCC_SPLIT_PHASE
+    pHandle->TermsReady = false;
+#endif
+#ifdef PCC_SHARED_MODEL
+    pHandle->BemfShared = false;
+#endif
+#ifdef HARMONIC_COMPENSATION
+    pHandle->BemfHarmonic.q = 0;
+    pHandle->BemfHarmonic.d = 0;
+#endif
+#ifdef PCC_LIMIT_EVENTS
+    pHandle->LimitEvent = false;
+#endif
+    pHandle->Vqd.q = 0;
+    pHandle->Vqd.d = 0;
+    pHandle->wCost = 0;
+    pHandle->hNodeCount = 0U;
+    pHandle->bOptimalVector = PCC_ZERO_VECTOR;
+    pHandle->bSwitchingState = PCC_SwitchingStates[PCC_ZERO_VECTOR];
+    pHandle->hDwellTime[0] = 0U;
+    pHandle->hDwellTime[1] = 0U;
+    pHandle->bSector = 0U;
+#ifdef PCC_FULL_HEXAGON
+    pHandle->VqdHeld = false;
+#endif
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    pHandle->TripRejected = false;
+    pHandle->TripPredicted = false;
+#endif
+    pHandle->BudgetExceeded = false;
+    pHandle->hOverrunCount = 0U;
+    pHandle->hFallbackCounter = 0U;
+    pHandle->hResidual = 0U;
+    pHandle->wResidualSum = 0U;
+#ifdef PCC_ADAPTIVE_PERIOD
+    pHandle->bPeriodCounter = 0U;
+#endif
+    pHandle->hLogDecision = ((uint16_t)PCC_ZERO_VECTOR << PCC_LOG_VECTOR_POS)
+                          | ((uint16_t)PCC_SwitchingStates[PCC_ZERO_VECTOR] << PCC_LOG_STATE_POS);
+    pHandle->hLogCost = 0U;
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  This function predicts the stator currents for each candidate vector
+  *         and selects the one that minimises the squared current error with
+  *         respect to the reference.
+  *
+  * The voltage computed at period k is applied during period k + 1. The measured
+  * currents are first propagated to the end of period k with @p Vqd, the voltage
+  * computed at the previous call, and the candidates are then evaluated on
+  * period k + 1. @p Vqd being expressed in the frame of the previous call, it is
+  * rotated by @p hElSpeedDpp into the current one. Sine and cosine of the angle
+  * of period k + 1 are obtained from @p Trig with a first order
+  * rotation, so the delay compensation needs no further trigonometric function.
+  *
+  * The voltage term of the model does not depend on the rotor angle, so the
+  * free response error is rotated once into the alpha/beta frame and compared
+  * with the current step of each vector, DeltaIalphabeta, computed by
+  * PCC_Init(). The sine and cosine of the Park angle, @p Trig, are the ones
+  * already computed by MCM_ClarkePark(). With #PCC_FINITE_SET the current steps
+  * include the dead time and device drops of each vector, taken from the
+  * polarity of the phase currents propagated to the end of period k.
+  * With PCC_SPLIT_PHASE the terms prepared by PCC_PrepareVoltage() for the same
+  * @p Trig, @p hElSpeedDpp and @p Vqd are used, and the polarity is then the
+  * one of the predicted currents.
+  *
+  * With #PCC_SECTOR_SEARCH the candidates are the two active vectors adjacent to
+  * the deadbeat voltage, i.e. the voltage that would zero the predicted error,
+  * and the zero vector. As the cost is proportional to the squared distance
+  * between a candidate and the deadbeat voltage, the closest vector of the
+  * hexagon is always one of them and both modes select the same vector. This no
+  * longer holds with a switching penalty, hSwitchingWeight, that may favour a
+  * farther vector: the previous vector is then added to the candidates. Nor
+  * strictly with different q and d weights, whose cost is no longer the
+  * distance to the deadbeat voltage: the sector search then gives a close
+  * approximation of the full search.
+  *
+  * When PCC_HORIZON is greater than 1 the prediction is carried out in the
+  * alpha/beta frame, where the vectors do not rotate: the reference and the
+  * back-EMF are rotated by @p hElSpeedDpp at each step of the horizon, and
+  * PCC_HorizonSearch() selects the first vector of the best sequence.
+  *
+  * With #PCC_MODULATED, PCC_ModulatedSearch() returns the average voltage of two
+  * active vectors and the zero vector applied with their dwell times: the
+  * returned voltage is then anywhere inside the hexagon.
+  * With #PCC_DEADBEAT the returned voltage is the one that cancels the free
+  * response error, the closed form solution of the model, without any search.
+  * With PCC_FULL_HEXAGON the voltages of the predictor are in digits of the
+  * vertices of the hexagon. @p Vqd is only used on the first call after
+  * PCC_Clear(), the predictor then uses its own voltage. In the corners of the
+  * hexagon the returned voltage exceeds the int16_t range of the units of
+  * PWMC_SetPhaseVoltage() and is saturated.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Iqd: measured stator currents in the q/d frame
+  * @param  Iqdref: reference stator currents in the q/d frame
+  * @param  Vqd: voltage applied during the current period, as computed by the
+  *         previous FOC period
+  * @param  Trig: cosine and sine of the electrical angle used for the Park
+  *         transformation
+  * @param  hElSpeedDpp: instantaneous electrical speed expressed in dpp, as
+  *         returned by SPD_GetInstElSpeedDpp(). Being an electrical speed per
+  *         control period, it needs no pole pair factor nor time conversion:
+  *         the rotation, coupling and back-EMF terms only take integer
+  *         multiplies and shifts. With PCC_ADAPTIVE_PERIOD the terms cover
+  *         the decision period, of PCC_GetDecisionPeriods() control periods
+  * @retval qd_t Optimal voltage vector in the q/d frame of @p Trig
+  */
+__weak qd_t PCC_CalcVoltage(PCC_Handle_t *pHandle, qd_t Iqd, qd_t Iqdref, qd_t Vqd, Trig_Components Trig,
+                            int16_t hElSpeedDpp)
+{
+  qd_t VqdOpt = {0, 0};
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    PCC_Terms_t Terms;
+    const PCC_Terms_t *pTerms = &Terms;
+    PCC_Decision_t Decision;
+    int32_t wDriftQ;
+    int32_t wDriftD;
+#ifndef PCC_DQ_VECTOR_TABLE
+    int32_t wCos = (int32_t)Trig.hCos;
+    int32_t wSin = (int32_t)Trig.hSin;
+#endif
+    bool ResidualValid;
+    uint8_t bPrevVector;
+#ifdef PCC_VBUS_LIMIT
+    uint16_t hVbusLevel;
+#endif
+
+#ifdef PCC_SPLIT_PHASE
+    if ((true == pHandle->TermsReady) && (Trig.hCos == pHandle->Terms.Trig.hCos)
+        && (Trig.hSin == pHandle->Terms.Trig.hSin) && (hElSpeedDpp == pHandle->Terms.hElSpeedDpp)
+        && (Vqd.q == pHandle->Terms.Vqd.q) && (Vqd.d == pHandle->Terms.Vqd.d))
+    {
+      /* Computed by PCC_PrepareVoltage() while the currents were converted */
+      pTerms = &pHandle->Terms;
+    }
+    else
+#endif
+    {
+      PCC_ComputeTerms(pHandle, Vqd, Trig, hElSpeedDpp, &Terms);
+    }
+#ifdef PCC_SPLIT_PHASE
+    pHandle->TermsReady = false;
+#endif
+#ifdef PCC_SHARED_MODEL
+    pHandle->BemfShared = false;
+#endif
+    Decision.Voltage.wAlpha = 0;
+    Decision.Voltage.wBeta = 0;
+    Decision.Residual.wAlpha = 0;
+    Decision.Residual.wBeta = 0;
+    Decision.wCosPred = pTerms->wCosNext;
+    Decision.wSinPred = pTerms->wSinNext;
+    Decision.wCost = INT32_MAX;
+    Decision.bVector = PCC_ZERO_VECTOR;
+
+#ifdef PCC_VBUS_LIMIT
+    Iqdref = PCC_LimitBrakeReference(pHandle, Iqdref, hElSpeedDpp, &hVbusLevel);
+#endif
+
+    /* Disturbance observer and residual monitor, from the error of the currents
+       predicted for this period */
+    ResidualValid = PCC_EstimateModel(pHandle, Iqd);
+#ifdef PCC_STATE_FILTER
+    if (true == ResidualValid)
+    {
+      Iqd = PCC_FilterState(pHandle, Iqd);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif
+
+    /* Currents at the end of the period, with the voltage applied */
+    PCC_GetDrift(pHandle, pTerms, &wDriftQ, &wDriftD);
+    pHandle->IqdNext = PCC_Propagate(pHandle, pTerms, Iqd, wDriftQ, wDriftD);
+    pHandle->NextValid = true;
+
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    if (PCC_NB_POLARITIES == pTerms->bPolarity)
+    {
+      int32_t wIq = (int32_t)pHandle->IqdNext.q;
+      int32_t wId = (int32_t)pHandle->IqdNext.d;
+      int32_t wCosNext = pTerms->wCosNext;
+      int32_t wSinNext = pTerms->wSinNext;
+
+      /* The polarity of the currents at the end of the period sets the inverter
+         voltage errors of the vector applied next */
+      PCC_SetPolarity(pHandle, PCC_GetPolarity(PCC_DIV_POW2(wIq * wCosNext, 15) + PCC_DIV_POW2(wId * wSinNext, 15),
+                                               PCC_DIV_POW2(wId * wCosNext, 15) - PCC_DIV_POW2(wIq * wSinNext, 15)));
+    }
+    else
+    {
+      /* Nothing to do, set by PCC_PrepareVoltage() from the predicted currents */
+    }
+#endif
+
+#if (PCC_HORIZON > 1U)
+    PCC_HorizonDecision(pHandle, pTerms, pHandle->IqdNext, Iqdref, wDriftQ, wDriftD, &Decision);
+#else
+    {
+      PCC_Vector_t Err = PCC_FreeResponseError(pHandle, pTerms, pHandle->IqdNext, Iqdref, wDriftQ, wDriftD);
+
+#if (PCC_OUTPUT_MODE == PCC_MODULATED)
+      PCC_ModulatedDecision(pHandle, Err, &Decision);
+#elif (PCC_OUTPUT_MODE == PCC_DEADBEAT)
+      PCC_DeadbeatDecision(pHandle, Err, &Decision);
+#elif defined (PCC_VBUS_LIMIT)
+      PCC_FiniteSetDecision(pHandle, pTerms, Err, Iqdref, hVbusLevel, &Decision);
+#else
+      PCC_FiniteSetDecision(pHandle, pTerms, Err, Iqdref, 0U, &Decision);
+#endif
+      pHandle->BudgetExceeded = false;
+    }
+#endif
+
+    /* Optimal voltage and predicted currents back in the q/d frame */
+#ifdef PCC_DQ_VECTOR_TABLE
+    VqdOpt = PCC_GetVectorDq(Decision.bVector, Trig);
+#else
+    VqdOpt.q = (int16_t)(PCC_DIV_POW2(Decision.Voltage.wAlpha * wCos, 15)
+                       - PCC_DIV_POW2(Decision.Voltage.wBeta * wSin, 15));
+    VqdOpt.d = (int16_t)(PCC_DIV_POW2(Decision.Voltage.wAlpha * wSin, 15)
+                       + PCC_DIV_POW2(Decision.Voltage.wBeta * wCos, 15));
+#endif
+    pHandle->IqdPred.q = (int16_t)PCC_Saturate((int32_t)Iqdref.q
+                                             - (PCC_DIV_POW2(Decision.Residual.wAlpha * Decision.wCosPred, 15)
+                                                - PCC_DIV_POW2(Decision.Residual.wBeta * Decision.wSinPred, 15)),
+                                               INT16_MAX);
+    pHandle->IqdPred.d = (int16_t)PCC_Saturate((int32_t)Iqdref.d
+                                             - (PCC_DIV_POW2(Decision.Residual.wAlpha * Decision.wSinPred, 15)
+                                                + PCC_DIV_POW2(Decision.Residual.wBeta * Decision.wCosPred, 15)),
+                                               INT16_MAX);
+
+    pHandle->bSwitchingState = PCC_GetSwitchingStateAfter(Decision.bVector, pHandle->bSwitchingState);
+    bPrevVector = pHandle->bOptimalVector;
+    pHandle->bOptimalVector = Decision.bVector;
+    pHandle->wCost = Decision.wCost;
+    pHandle->Vqd = VqdOpt;
+#ifdef PCC_FULL_HEXAGON
+    pHandle->VqdHeld = true;
+    VqdOpt.q = (int16_t)PCC_Saturate(PCC_DIV_POW2((int32_t)VqdOpt.q * PCC_HEXAGON_GAIN, 15), INT16_MAX);
+    VqdOpt.d = (int16_t)PCC_Saturate(PCC_DIV_POW2((int32_t)VqdOpt.d * PCC_HEXAGON_GAIN, 15), INT16_MAX);
+#endif
+
+    PCC_LogDecision(pHandle, bPrevVector, ResidualValid);
+#ifdef PCC_LIMIT_EVENTS
+    pHandle->LimitEvent = false;
+#endif
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+  return (VqdOpt);
+}
+
+#ifdef PCC_SPLIT_PHASE
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It computes the terms of the next PCC_CalcVoltage() that do not
+  *         depend on the measured currents, see PCC_SPLIT_PHASE. It must be
+  *         called once the PWM period has started and before the currents are
+  *         converted, with the angle, the speed and the voltage that the next
+  *         PCC_CalcVoltage() will be given, and never while PCC_CalcVoltage()
+  *         runs.
+  *
+  * With #PCC_FINITE_SET the currents at the end of the period are predicted
+  * from IqdNext, the currents predicted for the sampling instant, and the
+  * current steps of the vectors are set for their polarity. The disturbance is
+  * the one of the previous period: the polarity only changes near the zero
+  * crossings of the phase currents, where the measurement moves it little.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Vqd: voltage applied during the period, see PCC_CalcVoltage()
+  * @param  Trig: cosine and sine of the electrical angle of the sampling instant
+  * @param  hElSpeedDpp: instantaneous electrical speed expressed in dpp
+  * @retval None
+  */
+__weak void PCC_PrepareVoltage(PCC_Handle_t *pHandle, qd_t Vqd, Trig_Components Trig, int16_t hElSpeedDpp)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    PCC_Terms_t *pTerms = &pHandle->Terms;
+
+    PCC_ComputeTerms(pHandle, Vqd, Trig, hElSpeedDpp, pTerms);
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+#ifdef PCC_LIMIT_EVENTS
+    if ((true == pHandle->NextValid) && (false == pHandle->LimitEvent))
+#else
+    if (true == pHandle->NextValid)
+#endif
+    {
+      int32_t wDriftQ = (int32_t)pHandle->Disturbance.q + pTerms->wBemfQ;
+      int32_t wDriftD = (int32_t)pHandle->Disturbance.d + pTerms->wBemfD;
+      qd_t IqdPred;
+
+#ifdef HARMONIC_COMPENSATION
+      wDriftQ -= PCC_DIV_POW2(pHandle->wKVoltBus * (int32_t)pHandle->BemfHarmonic.q,
+                              (uint8_t)pHandle->hCoefDivisorPOW2);
+      wDriftD -= PCC_DIV_POW2(pHandle->wKVoltBus * (int32_t)pHandle->BemfHarmonic.d,
+                              (uint8_t)pHandle->hCoefDivisorPOW2);
+#endif
+      IqdPred = PCC_Propagate(pHandle, pTerms, pHandle->IqdNext, wDriftQ, wDriftD);
+      pTerms->bPolarity = PCC_GetPolarity(PCC_DIV_POW2((int32_t)IqdPred.q * pTerms->wCosNext, 15)
+                                          + PCC_DIV_POW2((int32_t)IqdPred.d * pTerms->wSinNext, 15),
+                                          PCC_DIV_POW2((int32_t)IqdPred.d * pTerms->wCosNext, 15)
+                                          - PCC_DIV_POW2((int32_t)IqdPred.q * pTerms->wSinNext, 15));
+      PCC_SetPolarity(pHandle, pTerms->bPolarity);
+    }
+    else
+    {
+      /* Nothing to do, the polarity is taken from the measured currents */
+    }
+#endif
+    pHandle->TermsReady = true;
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+#endif
+
+/**
+  * @brief  It returns the index of the last optimal vector
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval uint8_t Index of the optimal vector in the vector table
+  */
+__weak uint8_t PCC_GetOptimalVector(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? PCC_ZERO_VECTOR : pHandle->bOptimalVector);
+#else
+  return (pHandle->bOptimalVector);
+#endif
+}
+
+/**
+  * @brief  It returns the inverter switching state of the last optimal vector.
+  *         The zero vector is realised with all the high side switches on when
+  *         it needs fewer commutations than with all the low side ones.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval uint8_t Bit 0, 1 and 2 are the state of phase A, B and C high side
+  */
+__weak uint8_t PCC_GetSwitchingState(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0U : pHandle->bSwitchingState);
+#else
+  return (pHandle->bSwitchingState);
+#endif
+}
+
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It returns the voltage of the last optimal vector in the alpha/beta
+  *         frame, in the units of PWMC_SetPhaseVoltage(). It is the average
+  *         voltage applied by PWMC_SetSwitchingState() with the switching state
+  *         returned by PCC_GetSwitchingState().
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval alphabeta_t Voltage of the optimal vector
+  */
+__weak alphabeta_t PCC_GetVectorVoltage(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? PCC_VectorTable[PCC_ZERO_VECTOR] : PCC_VectorTable[pHandle->bOptimalVector]);
+#else
+  return (PCC_VectorTable[pHandle->bOptimalVector]);
+#endif
+}
+
+#if (PCC_OUTPUT_MODE == PCC_MODULATED)
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It returns the inverter switching state of an active vector of the
+  *         sector selected by the last search, to be applied with
+  *         PWMC_SetDwellTimes()
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  bIndex: 0 for the first active vector of the sector, 1 for the second
+  * @retval uint8_t Switching state of the vector
+  */
+__weak uint8_t PCC_GetDwellState(const PCC_Handle_t *pHandle, uint8_t bIndex)
+{
+  uint8_t bVector;
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    bVector = PCC_ZERO_VECTOR;
+  }
+  else
+  {
+#endif
+    bVector = pHandle->bSector + ((0U == bIndex) ? 0U : 1U);
+    bVector = (bVector < PCC_ZERO_VECTOR) ? bVector : 0U;
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+  return (PCC_SwitchingStates[bVector]);
+}
+
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It returns the dwell time of an active vector of the sector selected
+  *         by the last search
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  bIndex: 0 for the first active vector of the sector, 1 for the second
+  * @retval uint16_t Dwell time in Q15 fraction of the period. The two dwell
+  *         times sum up to 32768 at most
+  */
+__weak uint16_t PCC_GetDwellTime(const PCC_Handle_t *pHandle, uint8_t bIndex)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0U : pHandle->hDwellTime[(0U == bIndex) ? 0U : 1U]);
+#else
+  return (pHandle->hDwellTime[(0U == bIndex) ? 0U : 1U]);
+#endif
+}
+#endif
+
+/**
+  * @brief  It sets the cost weight of one inverter leg commutation. The cost of
+  *         one commutation is @p hWeight * 256, in squared current digits.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hWeight: new switching weight, 0 disables the switching penalty
+  * @retval None
+  */
+__weak void PCC_SetSwitchingWeight(PCC_Handle_t *pHandle, uint16_t hWeight)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->hSwitchingWeight = hWeight;
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+/**
+  * @brief  It returns the cost weight of one inverter leg commutation
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval uint16_t Switching weight
+  */
+__weak uint16_t PCC_GetSwitchingWeight(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0U : pHandle->hSwitchingWeight);
+#else
+  return (pHandle->hSwitchingWeight);
+#endif
+}
+
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+/**
+  * @brief  It replaces the dead time drop of the inverter voltage errors by a
+  *         measured one. The measured voltage error of a phase at a high current
+  *         also includes the conduction drops: their mean, hSwitchDrop and
+  *         hDiodeDrop being modelled apart, is removed. The current steps are
+  *         computed again with the tuning set in use, by the next call of
+  *         PCC_ApplyTuning().
+  *         It must be called by the medium frequency task.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hPhaseDrop: voltage error of a phase, in digits of the vector table
+  *         at the bus voltage of the measurement, conduction drops included
+  * @retval None
+  */
+__weak void PCC_SetDeadTimeDrop(PCC_Handle_t *pHandle, int16_t hPhaseDrop)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    PCC_Tuning_t Tuning;
+    /* The conduction drops are fixed voltages, the dead time drop a fraction of the bus */
+    int32_t wConduction = (((int32_t)pHandle->hSwitchDrop + (int32_t)pHandle->hDiodeDrop) * (int32_t)PCC_BUS_SCALE_ONE)
+                        / (2 * (int32_t)pHandle->hBusScale);
+    int32_t wDrop = (int32_t)hPhaseDrop - wConduction;
+
+    pHandle->hDeadTimeDrop = (wDrop > 0) ? (int16_t)wDrop : 0;
+    PCC_GetTuning(pHandle, &Tuning);
+    /* Refused if a set is pending already: its application computes the steps as well */
+    (void)PCC_SetTuning(pHandle, &Tuning);
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+/**
+  * @brief  It selects the entry of the weight table of the operating point. The
+  *         index is written in a single store, so that the high frequency task
+  *         always reads a complete set of weights.
+  *         It must be called by the medium frequency task.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hSpeedUnit: average mechanical speed, in SPEED_UNIT
+  * @param  hIq: q current reference, in digits
+  * @retval None
+  */
+__weak void PCC_SelectWeights(PCC_Handle_t *pHandle, int16_t hSpeedUnit, int16_t hIq)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int16_t hAbsSpeed = (hSpeedUnit < 0) ? -hSpeedUnit : hSpeedUnit;
+    int16_t hAbsIq = (hIq < 0) ? -hIq : hIq;
+    uint8_t bSpeedBand = 0U;
+    uint8_t bIqBand = 0U;
+
+    while ((bSpeedBand < (PCC_WEIGHT_SPEED_BANDS - 1U)) && (hAbsSpeed >= pHandle->hWeightSpeedBand[bSpeedBand]))
+    {
+      bSpeedBand++;
+    }
+    while ((bIqBand < (PCC_WEIGHT_IQ_BANDS - 1U)) && (hAbsIq >= pHandle->hWeightIqBand[bIqBand]))
+    {
+      bIqBand++;
+    }
+    pHandle->bWeightIndex = (uint8_t)((bSpeedBand * PCC_WEIGHT_IQ_BANDS) + bIqBand);
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+/**
+  * @brief  It forces the entry of the weight table, in place of the one of the
+  *         operating point until the next PCC_SelectWeights(). Called by the high
+  *         frequency task before PCC_CalcVoltage(), the entry holds for the period.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  bIndex: entry of the weight table, ignored from #PCC_NB_WEIGHTS on
+  * @retval None
+  */
+__weak void PCC_SetWeightIndex(PCC_Handle_t *pHandle, uint8_t bIndex)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if (bIndex < PCC_NB_WEIGHTS)
+    {
+      pHandle->bWeightIndex = bIndex;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+/**
+  * @brief  It returns the entry of the weight table in use
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval uint8_t Speed band times PCC_WEIGHT_IQ_BANDS plus q current band
+  */
+__weak uint8_t PCC_GetWeightIndex(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0U : pHandle->bWeightIndex);
+#else
+  return (pHandle->bWeightIndex);
+#endif
+}
+#endif
+
+#ifdef PCC_ADAPTIVE_PERIOD
+/**
+  * @brief  It selects the decision period of the average mechanical speed and
+  *         stages its model with PCC_SetTuning(), the other terms of the tuning
+  *         set being kept. The period is made longer when the speed is
+  *         hPeriodHyst below a band, shorter as soon as the speed is above it.
+  *         The model is staged again when a tuning set written otherwise has
+  *         replaced the one of the decision period in use.
+  *         It must be called by the medium frequency task.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hSpeedUnit: average mechanical speed, in SPEED_UNIT
+  * @retval None
+  */
+__weak void PCC_SelectPeriod(PCC_Handle_t *pHandle, int16_t hSpeedUnit)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int16_t hAbsSpeed = (hSpeedUnit < 0) ? -hSpeedUnit : hSpeedUnit;
+    uint8_t bInUse = pHandle->bPeriodLog;
+    const PCC_PeriodModel_t *pInUse = &pHandle->pPeriodTable[bInUse];
+    uint8_t bLog = 0U;
+
+    while ((bLog < (PCC_PERIOD_STEPS - 1U))
+           && ((int32_t)hAbsSpeed < ((int32_t)pHandle->hPeriodSpeedBand[bLog]
+                                     - ((bLog < bInUse) ? 0 : (int32_t)pHandle->hPeriodHyst))))
+    {
+      bLog++;
+    }
+
+    if (true == pHandle->TuningPending)
+    {
+      /* Nothing to do, the set staged is applied first */
+    }
+    else if ((bLog != bInUse) || (pHandle->wKDecay != pInUse->wKDecay) || (pHandle->wKVolt != pInUse->wKVolt)
+             || (pHandle->wKBemf != pInUse->wKBemf))
+    {
+      PCC_Tuning_t Tuning;
+      const PCC_PeriodModel_t *pModel = &pHandle->pPeriodTable[bLog];
+
+      PCC_GetTuning(pHandle, &Tuning);
+      Tuning.wKDecay = pModel->wKDecay;
+      Tuning.wKVolt = pModel->wKVolt;
+      Tuning.wKBemf = pModel->wKBemf;
+      Tuning.hCoefDivisorPOW2 = pModel->hCoefDivisorPOW2;
+      Tuning.hBemfDivisorPOW2 = pModel->hBemfDivisorPOW2;
+      /* Written before the set: PCC_ApplyTuning() reads both together */
+      pHandle->bPendingPeriodLog = bLog;
+      (void)PCC_SetTuning(pHandle, &Tuning);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It counts one control period of the decision period. The first
+  *         period of a decision period runs PCC_CalcVoltage(), the vector it
+  *         selects is held over the others. It must be called once per control
+  *         period by the high frequency task, while the predictive controller
+  *         is engaged.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval bool True if the vector of the last decision is held this period
+  */
+__weak bool PCC_HoldTick(PCC_Handle_t *pHandle)
+{
+  bool retVal = false;
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if (pHandle->bPeriodCounter > 0U)
+    {
+      pHandle->bPeriodCounter--;
+      retVal = true;
+    }
+    else
+    {
+      pHandle->bPeriodCounter = (uint8_t)(((uint32_t)1U << pHandle->bPeriodLog) - 1U);
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+  return (retVal);
+}
+
+/**
+  * @brief  It returns the voltage of the vector held, in the q/d frame of the
+  *         control period
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Trig: cosine and sine of the electrical angle used for the Park
+  *         transformation
+  * @retval qd_t Voltage of the last optimal vector
+  */
+__weak qd_t PCC_GetHeldVoltage(const PCC_Handle_t *pHandle, Trig_Components Trig)
+{
+  qd_t Vqd;
+#ifdef PCC_DQ_VECTOR_TABLE
+#ifdef NULL_PTR_CHECK_PCC
+  Vqd = (MC_NULL == pHandle) ? PCC_GetVectorDq(PCC_ZERO_VECTOR, Trig)
+                             : PCC_GetVectorDq(pHandle->bOptimalVector, Trig);
+#else
+  Vqd = PCC_GetVectorDq(pHandle->bOptimalVector, Trig);
+#endif
+#else
+  alphabeta_t Valphabeta = PCC_GetVectorVoltage(pHandle);
+
+  Vqd.q = (int16_t)(PCC_DIV_POW2((int32_t)Valphabeta.alpha * Trig.hCos, 15)
+                  - PCC_DIV_POW2((int32_t)Valphabeta.beta * Trig.hSin, 15));
+  Vqd.d = (int16_t)(PCC_DIV_POW2((int32_t)Valphabeta.alpha * Trig.hSin, 15)
+                  + PCC_DIV_POW2((int32_t)Valphabeta.beta * Trig.hCos, 15));
+#endif
+  return (Vqd);
+}
+
+/**
+  * @brief  It returns the decision period in use
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval uint8_t Number of control periods of the decision period
+  */
+__weak uint8_t PCC_GetDecisionPeriods(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 1U : (uint8_t)((uint32_t)1U << pHandle->bPeriodLog));
+#else
+  return ((uint8_t)((uint32_t)1U << pHandle->bPeriodLog));
+#endif
+}
+#endif
+
+/**
+  * @brief  It stages a new tuning set. The set is applied as a whole by the next
+  *         call of PCC_ApplyTuning(), made by the high frequency task at the
+  *         beginning of a control period.
+  *
+  *         The request is refused if the previous set has not yet been applied,
+  *         if a divisor is greater than #PCC_MAX_DIVISOR_POW2, if the node budget
+  *         is zero or if the disengage speed is negative or greater than the
+  *         engage speed: both are absolute speeds, so that the controller is
+  *         engaged in either direction of rotation.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pTuning: new tuning set
+  * @retval bool True if the set is staged
+  */
+__weak bool PCC_SetTuning(PCC_Handle_t *pHandle, const PCC_Tuning_t *pTuning)
+{
+  bool retVal = false;
+#ifdef NULL_PTR_CHECK_PCC
+  if ((MC_NULL == pHandle) || (MC_NULL == pTuning))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if ((false == pHandle->TuningPending)
+        && (pTuning->hCoefDivisorPOW2 <= PCC_MAX_DIVISOR_POW2)
+        && (pTuning->hBemfDivisorPOW2 <= PCC_MAX_DIVISOR_POW2)
+        && (pTuning->hNodeBudget > 0U)
+        && (pTuning->hDisengageSpeed >= 0)
+        && (pTuning->hDisengageSpeed <= pTuning->hEngageSpeed))
+    {
+      pHandle->PendingTuning = *pTuning;
+      /* Raised last: the high frequency task only reads a complete set */
+      pHandle->TuningPending = true;
+      retVal = true;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+  return (retVal);
+}
+
+/**
+  * @brief  It returns the tuning set in use
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pTuning: filled with the tuning set in use
+  * @retval None
+  */
+__weak void PCC_GetTuning(const PCC_Handle_t *pHandle, PCC_Tuning_t *pTuning)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if ((MC_NULL == pHandle) || (MC_NULL == pTuning))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pTuning->wKDecay = pHandle->wKDecay;
+    pTuning->wKVolt = pHandle->wKVolt;
+    pTuning->wKBemf = pHandle->wKBemf;
+    pTuning->hCoefDivisorPOW2 = pHandle->hCoefDivisorPOW2;
+    pTuning->hBemfDivisorPOW2 = pHandle->hBemfDivisorPOW2;
+    pTuning->hSwitchingWeight = pHandle->hSwitchingWeight;
+    pTuning->hNodeBudget = pHandle->hNodeBudget;
+    pTuning->hEngageSpeed = pHandle->hEngageSpeed;
+    pTuning->hDisengageSpeed = pHandle->hDisengageSpeed;
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+#ifdef PCC_SHARED_MODEL
+/**
+  * @brief  It sets the current step per period produced by the back-EMF in the
+  *         model of the state observer, used by the next PCC_CalcVoltage()
+  *         instead of wKBemf times the speed. It must be called by the high
+  *         frequency task after the observer.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  BemfStep: STO_PLL_GetBemfCurrentStep() turned into the q/d frame
+  *         of the period of the observer
+  * @retval None
+  */
+__weak void PCC_SetBemfStep(PCC_Handle_t *pHandle, qd_t BemfStep)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->BemfStep = BemfStep;
+    pHandle->BemfShared = true;
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+#endif
+
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE) && defined (PCC_SHARED_MODEL)
+/**
+  * @brief  It updates the flux current of #PCC_OBJECTIVE_TORQUE from the last
+  *         back-EMF step of the observer model, PCC_SetBemfStep(): the step is
+  *         the magnet flux divided by the inductance of the model, Lq, times
+  *         the angle covered in a period. It is kept
+  *         below #PCC_FLUX_MIN_DPP, where the step is too small, and filtered
+  *         over 2^#PCC_FLUX_FILTER_POW2 calls. It must be called by the medium
+  *         frequency task.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hElSpeedDpp: average electrical speed expressed in dpp
+  * @retval None
+  */
+__weak void PCC_UpdateFlux(PCC_Handle_t *pHandle, int16_t hElSpeedDpp)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int32_t wSpeed = (hElSpeedDpp < 0) ? -(int32_t)hElSpeedDpp : (int32_t)hElSpeedDpp;
+
+    if (wSpeed >= (int32_t)PCC_FLUX_MIN_DPP)
+    {
+      qd_t Step = pHandle->BemfStep;
+      uint32_t wSq = (uint32_t)((int32_t)Step.q * (int32_t)Step.q) + (uint32_t)((int32_t)Step.d * (int32_t)Step.d);
+      int64_t lFluxLq = (int64_t)MCM_Sqrt((wSq > (uint32_t)INT32_MAX) ? INT32_MAX : (int32_t)wSq) * PCC_DPP_PER_RAD;
+      /* From the flux divided by Lq to the flux divided by Ld */
+      int32_t wFlux = (int32_t)(PCC_DIV_POW2(lFluxLq * (int64_t)pHandle->hInductanceRatio, PCC_RATIO_POW2)
+                                / (int64_t)wSpeed);
+
+      PCC_SetFluxCurrent(pHandle, pHandle->wFluxCurr
+                                  + PCC_DIV_POW2(wFlux - pHandle->wFluxCurr, PCC_FLUX_FILTER_POW2));
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+#endif
+
+#ifdef HARMONIC_COMPENSATION
+/**
+  * @brief  It sets the voltage of the back-EMF harmonics, HCM_GetVoltage() of
+  *         the period, taken off the voltage of the next PCC_CalcVoltage() in
+  *         its prediction. It must be called by the high frequency task
+  *         before PCC_CalcVoltage().
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  Vqd: voltage of the back-EMF harmonics, in digits
+  * @retval None
+  */
+__weak void PCC_SetBemfHarmonic(PCC_Handle_t *pHandle, qd_t Vqd)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->BemfHarmonic = Vqd;
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+#endif
+
+#ifdef PCC_LIMIT_EVENTS
+/**
+  * @brief  It signals that the hardware current limit cut the PWM during the
+  *         last period. The next PCC_CalcVoltage() does not update the
+  *         disturbance observer and raises the barrier weight of the entry of
+  *         the weight table in use. It must be called by the high frequency
+  *         task before PCC_CalcVoltage(), once per period with an event.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval None
+  */
+__weak void PCC_SetLimitEvent(PCC_Handle_t *pHandle)
+{
+  uint32_t wWeight;
+
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->LimitWeights = pHandle->pWeightTable[pHandle->bWeightIndex];
+    wWeight = (uint32_t)pHandle->LimitWeights.hLimitWeight << PCC_LIMIT_EVENT_SHIFT;
+    pHandle->LimitWeights.hLimitWeight = (wWeight > UINT16_MAX) ? UINT16_MAX : (uint16_t)wWeight;
+    pHandle->LimitEvent = true;
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+#endif
+
+/**
+  * @brief  It computes the ratio of the measured to the nominal bus voltage and
+  *         stages it for the next call of PCC_ApplyTuning(), when it differs
+  *         from the ratio in use by more than #PCC_BUS_SCALE_HYST.
+  *
+  *         The division by the nominal bus voltage is done once by PCC_Init():
+  *         the ratio only takes a multiply and a shift. It is meant to be called
+  *         from the medium frequency task with the averaged bus voltage.
+  *
+  *         With #PCC_VBUS_LIMIT it also sets PCC_Handle_t::hVbusLevel, at every
+  *         call.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hBusVoltage_d: bus voltage in u16Volts
+  * @retval None
+  */
+__weak void PCC_SetBusVoltage(PCC_Handle_t *pHandle, uint16_t hBusVoltage_d)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+#ifdef PCC_VBUS_LIMIT
+    if (hBusVoltage_d <= pHandle->hVbusStart_d)
+    {
+      pHandle->hVbusLevel = 0U;
+    }
+    else
+    {
+      uint32_t wLevel = (uint32_t)(((uint64_t)(hBusVoltage_d - pHandle->hVbusStart_d) * pHandle->wVbusRangeInv) >> 16U);
+      pHandle->hVbusLevel = (wLevel > (uint32_t)INT16_MAX) ? (uint16_t)INT16_MAX : (uint16_t)wLevel;
+    }
+#endif
+    if ((0U == pHandle->wNominalBusInv) || (true == pHandle->BusScalePending))
+    {
+      /* Nothing to do */
+    }
+    else
+    {
+      uint32_t wScale = (uint32_t)(((uint64_t)hBusVoltage_d * pHandle->wNominalBusInv) >> 16U);
+      uint16_t hScale = (wScale > (uint32_t)PCC_BUS_SCALE_MAX) ? PCC_BUS_SCALE_MAX
+                      : ((wScale < (uint32_t)PCC_BUS_SCALE_MIN) ? PCC_BUS_SCALE_MIN : (uint16_t)wScale);
+      uint16_t hInUse = pHandle->hBusScale;
+      uint16_t hDiff = (hScale > hInUse) ? (hScale - hInUse) : (hInUse - hScale);
+
+      if (hDiff > PCC_BUS_SCALE_HYST)
+      {
+        pHandle->hPendingBusScale = hScale;
+        /* Raised last: the high frequency task only reads a complete ratio */
+        pHandle->BusScalePending = true;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It applies the tuning set staged by PCC_SetTuning() and the bus
+  *         voltage ratio staged by PCC_SetBusVoltage(), if any, and computes
+  *         the current step table again. It must be called from the high
+  *         frequency task, before the predictor runs.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval None
+  */
+__weak void PCC_ApplyTuning(PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if (true == pHandle->TuningPending)
+    {
+      PCC_Tuning_t Tuning = pHandle->PendingTuning;
+
+      pHandle->wKDecay = Tuning.wKDecay;
+      pHandle->wKVolt = Tuning.wKVolt;
+      pHandle->wKBemf = Tuning.wKBemf;
+      pHandle->hCoefDivisorPOW2 = Tuning.hCoefDivisorPOW2;
+      pHandle->hBemfDivisorPOW2 = Tuning.hBemfDivisorPOW2;
+      pHandle->hSwitchingWeight = Tuning.hSwitchingWeight;
+      pHandle->hNodeBudget = Tuning.hNodeBudget;
+      pHandle->hEngageSpeed = Tuning.hEngageSpeed;
+      pHandle->hDisengageSpeed = Tuning.hDisengageSpeed;
+#ifdef PCC_ADAPTIVE_PERIOD
+      /* The next period decides with the new model */
+      pHandle->bPeriodLog = pHandle->bPendingPeriodLog;
+      pHandle->bPeriodCounter = 0U;
+#endif
+      if (true == pHandle->BusScalePending)
+      {
+        pHandle->hBusScale = pHandle->hPendingBusScale;
+        pHandle->BusScalePending = false;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      PCC_UpdateCurrentSteps(pHandle);
+#ifdef PCC_EXACT_DISCRETISATION
+      /* The speed dependent terms include wKDecay */
+      pHandle->hStepSpeedDpp = INT16_MIN;
+#endif
+      pHandle->TuningPending = false;
+    }
+    else if (true == pHandle->BusScalePending)
+    {
+      pHandle->hBusScale = pHandle->hPendingBusScale;
+      PCC_UpdateCurrentSteps(pHandle);
+      pHandle->BusScalePending = false;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+#ifdef PCC_INDUCTANCE_TABLE
+/**
+  * @brief  It returns the ratio of the inductance of the model to the
+  *         inductance at a q current, interpolated linearly between the points
+  *         of the saturation table. Above the last point, the last ratio holds.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hIq: q current, in digits, of either sign
+  * @retval uint16_t Inductance ratio, Q14
+  */
+__weak uint16_t PCC_GetInductanceGain(const PCC_Handle_t *pHandle, int16_t hIq)
+{
+  uint16_t hGain = PCC_LSAT_ONE;
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint32_t wAbsIq = (hIq < 0) ? (uint32_t)(-(int32_t)hIq) : (uint32_t)hIq;
+    uint32_t wPos = wAbsIq * pHandle->wLSatStepInv;
+    uint32_t wIndex = wPos >> 16U;
+
+    if (wIndex >= (PCC_LSAT_POINTS - 1U))
+    {
+      hGain = pHandle->hLSatGain[PCC_LSAT_POINTS - 1U];
+    }
+    else
+    {
+      int32_t wLow = (int32_t)pHandle->hLSatGain[wIndex];
+      int32_t wHigh = (int32_t)pHandle->hLSatGain[wIndex + 1U];
+
+      hGain = (uint16_t)(wLow + PCC_DIV_POW2((wHigh - wLow) * (int32_t)((wPos & 0xFFFFU) >> 1U), 15));
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+  return (hGain);
+}
+
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It selects the inductance ratio of the measured q current. When it
+  *         differs from the ratio in use by more than #PCC_LSAT_HYST, the
+  *         current step table is computed again with it: the table is only
+  *         recomputed while the current moves along the saturation curve.
+  *         It must be called from the high frequency task, before the
+  *         predictor runs.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  hIq: measured q current, in digits
+  * @retval None
+  */
+__weak void PCC_SelectInductance(PCC_Handle_t *pHandle, int16_t hIq)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint16_t hGain = PCC_GetInductanceGain(pHandle, hIq);
+    uint16_t hInUse = pHandle->hLSatGainInUse;
+    uint16_t hDiff = (hGain > hInUse) ? (hGain - hInUse) : (hInUse - hGain);
+
+    if (hDiff > PCC_LSAT_HYST)
+    {
+      pHandle->hLSatGainInUse = hGain;
+      PCC_UpdateCurrentSteps(pHandle);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+/**
+  * @brief  It replaces the inductance saturation table. The high frequency
+  *         task may read a table with part of the points replaced, a
+  *         transient of one period at most. The ratio in use is kept until
+  *         the next PCC_SelectInductance().
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @param  pGain: #PCC_LSAT_POINTS inductance ratios, Q14
+  * @retval None
+  */
+__weak void PCC_SetInductanceTable(PCC_Handle_t *pHandle, const uint16_t *pGain)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if ((MC_NULL == pHandle) || (MC_NULL == pGain))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t i;
+
+    for (i = 0U; i < PCC_LSAT_POINTS; i++)
+    {
+      pHandle->hLSatGain[i] = pGain[i];
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+#endif
+
+/**
+  * @brief  It returns the absolute average mechanical speed above which the
+  *         predictive controller replaces the current PI controllers
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval int16_t Engage speed in SPEED_UNIT
+  */
+__weak int16_t PCC_GetEngageSpeed(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0 : pHandle->hEngageSpeed);
+#else
+  return (pHandle->hEngageSpeed);
+#endif
+}
+
+/**
+  * @brief  It returns the absolute average mechanical speed below which the
+  *         current PI controllers take over again from the predictive controller
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval int16_t Disengage speed in SPEED_UNIT
+  */
+__weak int16_t PCC_GetDisengageSpeed(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0 : pHandle->hDisengageSpeed);
+#else
+  return (pHandle->hDisengageSpeed);
+#endif
+}
+
+/**
+  * @brief  It returns the cost of the last optimal vector
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval int32_t Cost of the optimal vector
+  */
+__weak int32_t PCC_GetCost(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0 : pHandle->wCost);
+#else
+  return (pHandle->wCost);
+#endif
+}
+
+/**
+  * @brief  It returns the currents predicted for the last optimal vector
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval qd_t Predicted stator currents in the q/d frame
+  */
+__weak qd_t PCC_GetPredictedIqd(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  qd_t NULL_qd = {0, 0};
+  return ((MC_NULL == pHandle) ? NULL_qd : pHandle->IqdPred);
+#else
+  return (pHandle->IqdPred);
+#endif
+}
+
+/**
+  * @brief  It returns the current step per period estimated by the disturbance
+  *         observer, that the model misses
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval qd_t Estimated disturbance in the q/d frame, in current digits
+  */
+__weak qd_t PCC_GetDisturbance(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  qd_t NULL_qd = {0, 0};
+  return ((MC_NULL == pHandle) ? NULL_qd : pHandle->Disturbance);
+#else
+  return (pHandle->Disturbance);
+#endif
+}
+
+/**
+  * @brief  It returns the number of nodes evaluated by the last search, i.e. the
+  *         number of candidates with a horizon of 1
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval uint16_t Number of evaluated nodes
+  */
+__weak uint16_t PCC_GetNodeCount(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0U : pHandle->hNodeCount);
+#else
+  return (pHandle->hNodeCount);
+#endif
+}
+
+/**
+  * @brief  It returns true if the last search was stopped by the node budget
+  *         before completion. The applied vector is then the first vector of
+  *         the best sequence found within the budget.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval bool True if the node budget was exceeded
+  */
+__weak bool PCC_IsBudgetExceeded(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? false : pHandle->BudgetExceeded);
+#else
+  return (pHandle->BudgetExceeded);
+#endif
+}
+
+#if defined (CCMRAM) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC) && (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It counts one control period of the fallback to the current PI
+  *         controllers. A fallback starts when hFallbackOverruns consecutive
+  *         searches have been stopped by the node budget, and lasts
+  *         hFallbackPeriods control periods. It must be called once per control
+  *         period by the high frequency task, before the current controller is
+  *         chosen.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval bool True if the current PI controllers must run this period
+  */
+__weak bool PCC_FallbackTick(PCC_Handle_t *pHandle)
+{
+  bool retVal = false;
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if (pHandle->hFallbackCounter > 0U)
+    {
+      pHandle->hFallbackCounter--;
+      retVal = true;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+  return (retVal);
+}
+
+/**
+  * @brief  It returns the number of fallbacks to the current PI controllers
+  *         since PCC_Init()
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval uint16_t Number of fallbacks, saturated to UINT16_MAX
+  */
+__weak uint16_t PCC_GetFallbackEvents(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0U : pHandle->hFallbackEvents);
+#else
+  return (pHandle->hFallbackEvents);
+#endif
+}
+
+/**
+  * @brief  It returns the number of fallbacks to the current PI controllers
+  *         started by the residual of the predictions since PCC_Init(). They
+  *         are counted in PCC_GetFallbackEvents() as well
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval uint16_t Number of fallbacks, saturated to UINT16_MAX
+  */
+__weak uint16_t PCC_GetResidualEvents(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? 0U : pHandle->hResidualEvents);
+#else
+  return (pHandle->hResidualEvents);
+#endif
+}
+
+/**
+  * @brief  It counts the medium frequency periods of the statistics window and,
+  *         when PCC_Handle_t::hStatsPeriod of them have elapsed, hands the
+  *         statistics accumulated by the high frequency task over to
+  *         PCC_GetStats() and starts a new window. It must be called once per
+  *         medium frequency period.
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval None
+  */
+__weak void PCC_UpdateStats(PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->hStatsCounter++;
+    if (pHandle->hStatsCounter >= pHandle->hStatsPeriod)
+    {
+      uint8_t bNextIndex = pHandle->bStatsIndex ^ 1U;
+
+      /* The next window is cleared before the high frequency task writes it */
+      PCC_ClearStats(&pHandle->Stats[bNextIndex]);
+      pHandle->bStatsIndex = bNextIndex;
+      pHandle->hStatsCounter = 0U;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_PCC
+  }
+#endif
+}
+
+/**
+  * @brief  It returns the statistics of the last complete window. They stay
+  *         unchanged until the next window is closed by PCC_UpdateStats().
+  * @param  pHandle: handler of the current instance of the PCC component
+  * @retval const PCC_Stats_t * Statistics of the last complete window
+  */
+__weak const PCC_Stats_t *PCC_GetStats(const PCC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_PCC
+  return ((MC_NULL == pHandle) ? MC_NULL : &pHandle->Stats[pHandle->bStatsIndex ^ 1U]);
+#else
+  return (&pHandle->Stats[pHandle->bStatsIndex ^ 1U]);
+#endif
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -35,6 +35,7 @@
   */
 /* Private function prototypes -----------------------------------------------*/
 uint32_t getScalingFactor(int32_t Target);
+static uint8_t REMNG_GetShift(uint32_t ScalingFactor);
 
 /**
   * @brief  It reset the state variable to zero.
@@ -56,6 +57,7 @@ void REMNG_Init(RampExtMngr_Handle_t *pHandle)
     pHandle->RampRemainingStep = 0U;
     pHandle->IncDecAmount = 0;
     pHandle->ScalingFactor = 1U;
+    pHandle->ScalingShift = 0U;
 
 #ifdef FASTDIV
     FD_Init(& (pHandle->fd));
@@ -71,6 +73,8 @@ void REMNG_Init(RampExtMngr_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  Exec the ramp calculations and returns the current value of the
@@ -119,7 +123,9 @@ __weak int32_t REMNG_Calc(RampExtMngr_Handle_t *pHandle)
 #ifdef FASTDIV
     ret_val = FD_FastDiv(&(pHandle->fd), pHandle->Ext, ((int32_t)pHandle->ScalingFactor));
 #else
-    ret_val = pHandle->Ext / ((int32_t)pHandle->ScalingFactor);
+    /* Same result as the division by ScalingFactor, truncated toward zero */
+    ret_val = (current_ref < 0) ? -(int32_t)((uint32_t)(-current_ref) >> pHandle->ScalingShift)
+                                : (int32_t)((uint32_t)current_ref >> pHandle->ScalingShift);
 #endif
 #ifdef NULL_RMP_EXT_MNG
   }
@@ -163,6 +169,7 @@ __weak bool REMNG_ExecRamp(RampExtMngr_Handle_t *pHandle, int32_t TargetFinal, u
     if (0U == Durationms)
     {
       pHandle->ScalingFactor = getScalingFactor(TargetFinal);
+      pHandle->ScalingShift = REMNG_GetShift(pHandle->ScalingFactor);
       pHandle->Ext = TargetFinal * ((int32_t)pHandle->ScalingFactor);
       pHandle->RampRemainingStep = 0U;
       pHandle->IncDecAmount = 0;
@@ -198,6 +205,7 @@ __weak bool REMNG_ExecRamp(RampExtMngr_Handle_t *pHandle, int32_t TargetFinal, u
       }
 
       pHandle->ScalingFactor = wScalingFactorMin;
+      pHandle->ScalingShift = REMNG_GetShift(pHandle->ScalingFactor);
       pHandle->Ext = current_ref * ((int32_t)pHandle->ScalingFactor);
 
       /* Store the TargetFinal to be applied in the last step */
@@ -242,6 +250,8 @@ __weak int32_t REMNG_GetValue(const RampExtMngr_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  Check if the settled ramp has been completed.
@@ -333,6 +343,23 @@ __weak uint32_t getScalingFactor(int32_t Target)
   return (((uint32_t)1) << (i - 1U));
 }
 
+/**
+  * @brief  Log2 of the scaling factor, so that REMNG_Calc() shifts instead of
+  *         dividing in the high frequency task.
+  * @param  ScalingFactor Scaling factor returned by getScalingFactor().
+  * @retval uint8_t It returns the position of the bit set in ScalingFactor.
+  */
+static uint8_t REMNG_GetShift(uint32_t ScalingFactor)
+{
+  uint8_t bShift = 0U;
+
+  while ((ScalingFactor >> bShift) > 1U)
+  {
+    bShift++;
+  }
+  return (bShift);
+}
+
 /**
   * @}
   */
@@ -605,6 +605,8 @@ __weak void RUC_Stop(RevUpCtrl_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 
 /**
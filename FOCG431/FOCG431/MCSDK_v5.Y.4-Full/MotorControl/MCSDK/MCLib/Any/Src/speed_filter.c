@@ -0,0 +1,375 @@
+/**
+  ******************************************************************************
+  * @file    speed_filter.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the Speed Filter Bank component of the Motor Control SDK:
+  *
+  *           * cascade of biquads on the torque reference of the speed loop
+  *           * design of notch and low-pass biquads
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "speed_filter.h"
+#include "mc_math.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/**
+  * @defgroup SpeedFilterBank Speed Filter Bank
+  * @brief Notch and low-pass filters of the speed loop
+  *
+  * With a fast current loop, the gains of the speed loop are limited by the
+  * resonances of the mechanics coupled to the rotor. The torque reference
+  * computed by the speed controller goes through a cascade of up to
+  * SFB_MAX_STAGES biquads in direct form I, with Q14 coefficients and 16 bits
+  * samples, once per speed loop period.
+  *
+  * SFB_Init() designs a notch and a second order low-pass from the drive
+  * parameters. The coefficients of any cascade can then be written through
+  * SFB_SetBank(), from the register interface: the new cascade is taken by
+  * the next SFB_Filter() call and starts from the steady state of the sample,
+  * so that the reference does not step. The DC gain of each biquad is set to
+  * exactly one in its quantized coefficients.
+  *
+  * @{
+  */
+
+/* One in Q14 */
+#define SFB_ONE             ((int32_t)1 << SFB_COEF_SHIFT)
+
+/**
+  * @brief  Rounds a coefficient to Q14 and saturates it to 16 bits.
+  */
+static int16_t SFB_Quantize(float_t fCoef)
+{
+  float_t fScaled = fCoef * (float_t)SFB_ONE;
+  int32_t wCoef = (int32_t)((fScaled < 0.0f) ? (fScaled - 0.5f) : (fScaled + 0.5f));
+
+  if (wCoef > INT16_MAX)
+  {
+    wCoef = INT16_MAX;
+  }
+  else if (wCoef < INT16_MIN)
+  {
+    wCoef = INT16_MIN;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return ((int16_t)wCoef);
+}
+
+/**
+  * @brief  Sets b1 so that the DC gain of the quantized biquad is one.
+  */
+static void SFB_SetUnityGain(SFB_Coefs_t *pCoefs)
+{
+  int32_t wB1 = SFB_ONE + (int32_t)pCoefs->hA1 + (int32_t)pCoefs->hA2
+              - (int32_t)pCoefs->hB0 - (int32_t)pCoefs->hB2;
+
+  pCoefs->hB1 = (wB1 > INT16_MAX) ? INT16_MAX : ((wB1 < INT16_MIN) ? INT16_MIN : (int16_t)wB1);
+}
+
+/**
+  * @brief  Returns true if the poles of the biquad are inside the unit circle,
+  *         from the stability triangle of a2 and a1.
+  */
+static bool SFB_IsStable(const SFB_Coefs_t *pCoefs)
+{
+  int32_t wA1 = (pCoefs->hA1 < 0) ? -(int32_t)pCoefs->hA1 : (int32_t)pCoefs->hA1;
+  int32_t wA2 = (int32_t)pCoefs->hA2;
+
+  return ((wA2 < SFB_ONE) && (wA2 > -SFB_ONE) && (wA1 < (SFB_ONE + wA2)));
+}
+
+/**
+  * @brief  Designs the notch and the low-pass of the handle and clears the
+  *         filter. A frequency of 0, or not below half the sample frequency,
+  *         leaves the biquad out of the cascade.
+  * @param  pHandle handler of the current instance of the Speed Filter Bank component
+  */
+__weak void SFB_Init(SFB_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint16_t hNyquist = pHandle->hSampleFreqHz / 2U;
+    uint16_t hNbStages = 0U;
+
+    if ((pHandle->hNotchFreqHz > 0U) && (pHandle->hNotchFreqHz < hNyquist) && (pHandle->hNotchWidthHz > 0U))
+    {
+      SFB_DesignNotch(&pHandle->Bank.Stage[hNbStages], pHandle->hSampleFreqHz,
+                      pHandle->hNotchFreqHz, pHandle->hNotchWidthHz);
+      hNbStages++;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    if ((pHandle->hLowPassHz > 0U) && (pHandle->hLowPassHz < hNyquist))
+    {
+      SFB_DesignLowPass(&pHandle->Bank.Stage[hNbStages], pHandle->hSampleFreqHz, pHandle->hLowPassHz);
+      hNbStages++;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    pHandle->Bank.hNbStages = hNbStages;
+    pHandle->BankPending = false;
+    SFB_Clear(pHandle);
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  }
+#endif
+}
+
+/**
+  * @brief  Clears the inputs and outputs of the biquads.
+  * @param  pHandle handler of the current instance of the Speed Filter Bank component
+  */
+__weak void SFB_Clear(SFB_Handle_t *pHandle)
+{
+  SFB_Preload(pHandle, 0);
+}
+
+/**
+  * @brief  Sets the inputs and outputs of the biquads to a value, the steady
+  *         state of a constant input. Called while the filter is not applied,
+  *         it makes the next SFB_Filter() call bumpless.
+  * @param  pHandle handler of the current instance of the Speed Filter Bank component
+  * @param  hValue constant input
+  */
+__weak void SFB_Preload(SFB_Handle_t *pHandle, int16_t hValue)
+{
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t i;
+
+    for (i = 0U; i < SFB_MAX_STAGES; i++)
+    {
+      pHandle->hX[i][0] = hValue;
+      pHandle->hX[i][1] = hValue;
+      pHandle->hY[i][0] = hValue;
+      pHandle->hY[i][1] = hValue;
+    }
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  }
+#endif
+}
+
+/**
+  * @brief  Takes the cascade requested by SFB_SetBank(), if any, then filters
+  *         one sample. It must be called once per speed loop period.
+  * @param  pHandle handler of the current instance of the Speed Filter Bank component
+  * @param  hInput torque reference, in digits
+  * @retval int16_t Filtered torque reference, in digits
+  */
+__weak int16_t SFB_Filter(SFB_Handle_t *pHandle, int16_t hInput)
+{
+  int16_t hOutput = hInput;
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint16_t i;
+
+    if (true == pHandle->BankPending)
+    {
+      pHandle->Bank = pHandle->PendingBank;
+      pHandle->BankPending = false;
+      SFB_Preload(pHandle, hInput);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    for (i = 0U; i < pHandle->Bank.hNbStages; i++)
+    {
+      const SFB_Coefs_t *pCoefs = &pHandle->Bank.Stage[i];
+      int64_t dAcc = ((int64_t)pCoefs->hB0 * hOutput)
+                   + ((int64_t)pCoefs->hB1 * pHandle->hX[i][0])
+                   + ((int64_t)pCoefs->hB2 * pHandle->hX[i][1])
+                   - ((int64_t)pCoefs->hA1 * pHandle->hY[i][0])
+                   - ((int64_t)pCoefs->hA2 * pHandle->hY[i][1]);
+
+      dAcc /= SFB_ONE;
+      if (dAcc > INT16_MAX)
+      {
+        dAcc = INT16_MAX;
+      }
+      else if (dAcc < -INT16_MAX)
+      {
+        dAcc = -INT16_MAX;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      pHandle->hX[i][1] = pHandle->hX[i][0];
+      pHandle->hX[i][0] = hOutput;
+      pHandle->hY[i][1] = pHandle->hY[i][0];
+      pHandle->hY[i][0] = (int16_t)dAcc;
+      hOutput = (int16_t)dAcc;
+    }
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  }
+#endif
+  return (hOutput);
+}
+
+/**
+  * @brief  Requests a new cascade. It is refused if the previous request has
+  *         not been taken yet, if it has more than SFB_MAX_STAGES biquads or if
+  *         one of them is unstable.
+  * @param  pHandle handler of the current instance of the Speed Filter Bank component
+  * @param  pBank cascade requested
+  * @retval bool True if the cascade is accepted
+  */
+__weak bool SFB_SetBank(SFB_Handle_t *pHandle, const SFB_Bank_t *pBank)
+{
+  bool retVal = false;
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  if ((MC_NULL == pHandle) || (MC_NULL == pBank))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if ((false == pHandle->BankPending) && (pBank->hNbStages <= SFB_MAX_STAGES))
+    {
+      uint16_t i;
+
+      retVal = true;
+      for (i = 0U; i < pBank->hNbStages; i++)
+      {
+        retVal = (true == SFB_IsStable(&pBank->Stage[i])) ? retVal : false;
+      }
+      if (true == retVal)
+      {
+        pHandle->PendingBank = *pBank;
+        /* Raised last: the speed loop only reads a complete cascade */
+        pHandle->BankPending = true;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  }
+#endif
+  return (retVal);
+}
+
+/**
+  * @brief  Returns the cascade in use.
+  * @param  pHandle handler of the current instance of the Speed Filter Bank component
+  * @param  pBank filled with the cascade in use
+  */
+__weak void SFB_GetBank(const SFB_Handle_t *pHandle, SFB_Bank_t *pBank)
+{
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  if ((MC_NULL == pHandle) || (MC_NULL == pBank))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    *pBank = pHandle->Bank;
+#ifdef NULL_PTR_CHECK_SPEED_FILTER
+  }
+#endif
+}
+
+/**
+  * @brief  Designs a notch biquad, of unity gain away from its center.
+  * @param  pCoefs filled with the coefficients
+  * @param  hSampleFreqHz rate of the filter, Hz
+  * @param  hFreqHz center of the notch, below half hSampleFreqHz, Hz
+  * @param  hWidthHz width of the notch at -3 dB, Hz
+  */
+__weak void SFB_DesignNotch(SFB_Coefs_t *pCoefs, uint16_t hSampleFreqHz, uint16_t hFreqHz, uint16_t hWidthHz)
+{
+  /* Angle of the center per sample, 65536 per turn */
+  Trig_Components Trig = MCM_Trig_Functions((int16_t)(((uint32_t)hFreqHz * 65536U) / hSampleFreqHz));
+  float_t fCos = (float_t)Trig.hCos / 32768.0f;
+  float_t fAlpha = ((float_t)Trig.hSin / 32768.0f) * (float_t)hWidthHz / (2.0f * (float_t)hFreqHz);
+  float_t fInvA0 = 1.0f / (1.0f + fAlpha);
+
+  pCoefs->hB0 = SFB_Quantize(fInvA0);
+  pCoefs->hB2 = pCoefs->hB0;
+  pCoefs->hA1 = SFB_Quantize(-2.0f * fCos * fInvA0);
+  pCoefs->hA2 = SFB_Quantize((1.0f - fAlpha) * fInvA0);
+  SFB_SetUnityGain(pCoefs);
+}
+
+/**
+  * @brief  Designs a second order Butterworth low-pass biquad.
+  * @param  pCoefs filled with the coefficients
+  * @param  hSampleFreqHz rate of the filter, Hz
+  * @param  hFreqHz cut-off frequency, below half hSampleFreqHz, Hz
+  */
+__weak void SFB_DesignLowPass(SFB_Coefs_t *pCoefs, uint16_t hSampleFreqHz, uint16_t hFreqHz)
+{
+  Trig_Components Trig = MCM_Trig_Functions((int16_t)(((uint32_t)hFreqHz * 65536U) / hSampleFreqHz));
+  float_t fCos = (float_t)Trig.hCos / 32768.0f;
+  /* Quality factor of 1 / sqrt(2) */
+  float_t fAlpha = ((float_t)Trig.hSin / 32768.0f) * 0.70711f;
+  float_t fInvA0 = 1.0f / (1.0f + fAlpha);
+
+  pCoefs->hB0 = SFB_Quantize(((1.0f - fCos) / 2.0f) * fInvA0);
+  pCoefs->hB2 = pCoefs->hB0;
+  pCoefs->hA1 = SFB_Quantize(-2.0f * fCos * fInvA0);
+  pCoefs->hA2 = SFB_Quantize((1.0f - fAlpha) * fInvA0);
+  SFB_SetUnityGain(pCoefs);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
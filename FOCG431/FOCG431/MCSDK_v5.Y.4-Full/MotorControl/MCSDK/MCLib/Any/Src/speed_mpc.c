@@ -0,0 +1,371 @@
+/**
+  ******************************************************************************
+  * @file    speed_mpc.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the Speed Predictive Control component of the Motor Control SDK:
+  *
+  *           * recursive least squares estimation of the torque, friction and
+  *             load terms of the mechanical model
+  *           * computation of the q current reference that best tracks the
+  *             speed ramp over the prediction horizon, within the torque limits
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "speed_mpc.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/**
+  * @defgroup SpeedMPC Speed Predictive Control
+  * @brief Model predictive speed regulation, an alternative to the speed PI
+  *
+  * At each medium frequency period, the speed change of the elapsed period and
+  * the q current reference applied during it run one step of a recursive least
+  * squares estimation of the mechanical model, with forgetting factor. The
+  * estimation is suspended at low speed, where the speed sensors are the least
+  * accurate.
+  *
+  * The model then predicts the speed over the next bHorizon periods, for a q
+  * current reference held constant over the horizon. The reference minimizes
+  * the squared distance of the predicted speeds to the speed ramp, whose next
+  * steps are known, plus the squared change of the reference weighted by
+  * fMoveWeight. With a single decision variable the minimum is found in closed
+  * form, and saturating it to the torque limits of the speed and torque
+  * controller gives the exact constrained optimum.
+  *
+  * The integral term of the speed PI follows the reference, so that the PI,
+  * still run by STC_CalcTorqueReference(), does not wind up.
+  *
+  * @{
+  */
+
+/* Private defines -----------------------------------------------------------*/
+#define SMPC_TORQUE           0U                /* Index of the torque term */
+#define SMPC_FRICTION         1U                /* Index of the viscous friction term */
+#define SMPC_LOAD             2U                /* Index of the load term */
+#define SMPC_MIN_DECAY        ((float_t)0.5)    /* Smallest speed decay per period, 1 - d */
+
+/**
+  * @brief  It runs one step of the recursive least squares on y = phi' theta.
+  *         The regressor and the measure are first divided by the largest
+  *         component of the regressor, above 1.
+  * @param  pHandle: handler of the current instance of the SpeedMPC component
+  * @param  fPhi: scaled regressor
+  * @param  fY: measure, in #SPEED_UNIT
+  * @param  fForgetting: forgetting factor of the step
+  * @param  fInvForgetting: inverse of @p fForgetting
+  * @retval None
+  */
+static void SMPC_RlsStep(SMPC_Handle_t *pHandle, const float_t fPhi[SMPC_NB_PARAMS], float_t fY,
+                         float_t fForgetting, float_t fInvForgetting)
+{
+  float_t fPhiN[SMPC_NB_PARAMS];
+  float_t fPPhi[SMPC_NB_PARAMS];
+  float_t fGain[SMPC_NB_PARAMS];
+  float_t fNorm = 1.0f;
+  float_t fDen = fForgetting;
+  float_t fInv;
+  float_t fErr;
+  uint8_t i;
+  uint8_t j;
+
+  for (i = 0U; i < SMPC_NB_PARAMS; i++)
+  {
+    float_t fAbs = (fPhi[i] < 0.0f) ? -fPhi[i] : fPhi[i];
+    fNorm = (fAbs > fNorm) ? fAbs : fNorm;
+  }
+  /* One division, and products, in each loop: a float division is 14 cycles on the M4 */
+  fInv = 1.0f / fNorm;
+  for (i = 0U; i < SMPC_NB_PARAMS; i++)
+  {
+    fPhiN[i] = fPhi[i] * fInv;
+  }
+  fErr = fY * fInv;
+
+  for (i = 0U; i < SMPC_NB_PARAMS; i++)
+  {
+    fPPhi[i] = 0.0f;
+    for (j = 0U; j < SMPC_NB_PARAMS; j++)
+    {
+      fPPhi[i] += pHandle->fP[i][j] * fPhiN[j];
+    }
+    fDen += fPhiN[i] * fPPhi[i];
+    fErr -= fPhiN[i] * pHandle->fTheta[i];
+  }
+
+  fInv = 1.0f / fDen;
+  for (i = 0U; i < SMPC_NB_PARAMS; i++)
+  {
+    fGain[i] = fPPhi[i] * fInv;
+    pHandle->fTheta[i] += fGain[i] * fErr;
+  }
+
+  /* Upper triangle only, so that rounding does not break the symmetry of P */
+  for (i = 0U; i < SMPC_NB_PARAMS; i++)
+  {
+    for (j = i; j < SMPC_NB_PARAMS; j++)
+    {
+      pHandle->fP[i][j] = (pHandle->fP[i][j] - (fGain[i] * fPPhi[j])) * fInvForgetting;
+      pHandle->fP[j][i] = pHandle->fP[i][j];
+    }
+  }
+}
+
+/**
+  * @brief  It bounds the estimates to a physical model: the torque term between
+  *         a quarter and four times its nominal value, the speed decay of one
+  *         period between SMPC_MIN_DECAY and 1, and the load term within the
+  *         torque of the nominal current.
+  * @param  pHandle: handler of the current instance of the SpeedMPC component
+  * @retval None
+  */
+static void SMPC_BoundEstimates(SMPC_Handle_t *pHandle)
+{
+  float_t fLow = 0.25f * pHandle->fTorqueTermNom;
+  float_t fHigh = 4.0f * pHandle->fTorqueTermNom;
+  float_t fDecayMax = (1.0f - SMPC_MIN_DECAY) * (float_t)pHandle->hSpeedScale;
+  float_t fTheta;
+
+  fTheta = pHandle->fTheta[SMPC_TORQUE];
+  pHandle->fTheta[SMPC_TORQUE] = (fTheta < fLow) ? fLow : ((fTheta > fHigh) ? fHigh : fTheta);
+
+  fTheta = pHandle->fTheta[SMPC_FRICTION];
+  pHandle->fTheta[SMPC_FRICTION] = (fTheta < 0.0f) ? 0.0f : ((fTheta > fDecayMax) ? fDecayMax : fTheta);
+
+  fTheta = pHandle->fTheta[SMPC_LOAD];
+  fHigh = pHandle->fTorqueTermNom;
+  pHandle->fTheta[SMPC_LOAD] = (fTheta < -fHigh) ? -fHigh : ((fTheta > fHigh) ? fHigh : fTheta);
+}
+
+/**
+  * @brief  It initializes the estimates to the nominal model, with a null
+  *         friction and load, and the covariance matrix to its initial value.
+  *         The inverses of the parameters are computed here, so it must be
+  *         called again after any change of the parameters.
+  * @param  pHandle: handler of the current instance of the SpeedMPC component
+  * @retval None
+  */
+__weak void SMPC_Init(SMPC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_SPD_MPC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    uint8_t i;
+    uint8_t j;
+
+    pHandle->bHorizon = (pHandle->bHorizon > (uint8_t)SMPC_MAX_HORIZON) ? (uint8_t)SMPC_MAX_HORIZON
+                      : ((0U == pHandle->bHorizon) ? 1U : pHandle->bHorizon);
+    pHandle->fInvIqScale = 1.0f / (float_t)pHandle->hNominalCurrent;
+    pHandle->fInvSpeedScale = 1.0f / (float_t)pHandle->hSpeedScale;
+    pHandle->fInvForgetting = 1.0f / pHandle->fForgetting;
+    pHandle->fInvMoveDen = 1.0f / (1.0f + pHandle->fMoveWeight);
+    pHandle->fTheta[SMPC_TORQUE] = pHandle->fTorqueTermNom;
+    pHandle->fTheta[SMPC_FRICTION] = 0.0f;
+    pHandle->fTheta[SMPC_LOAD] = 0.0f;
+    for (i = 0U; i < SMPC_NB_PARAMS; i++)
+    {
+      for (j = 0U; j < SMPC_NB_PARAMS; j++)
+      {
+        pHandle->fP[i][j] = (i == j) ? pHandle->fInitCovariance : 0.0f;
+      }
+    }
+
+    SMPC_Clear(pHandle);
+#ifdef NULL_PTR_CHECK_SPD_MPC
+  }
+#endif
+}
+
+/**
+  * @brief  It forgets the speed of the previous call, so that the first step
+  *         after a start is not used by the estimation. The estimates are kept
+  *         from one run to the next.
+  * @param  pHandle: handler of the current instance of the SpeedMPC component
+  * @retval None
+  */
+__weak void SMPC_Clear(SMPC_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_SPD_MPC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->hPrevSpeedUnit = 0;
+    pHandle->PrevValid = false;
+#ifdef NULL_PTR_CHECK_SPD_MPC
+  }
+#endif
+}
+
+/**
+  * @brief  It runs one step of the estimation of the model and computes the q
+  *         current reference over the prediction horizon. It must be called by
+  *         the medium frequency task, after STC_CalcTorqueReference() has moved
+  *         the speed ramp, while the controller is in speed mode.
+  *
+  *         The torque reference and the integral term of the speed PI of the
+  *         speed and torque controller are overwritten with the result.
+  * @param  pHandle: handler of the current instance of the SpeedMPC component
+  * @param  pSTC: speed and torque controller whose ramp, speed sensor and
+  *         torque limits are used
+  * @param  hIqApplied: q current reference applied since the previous call, in
+  *         digits, after the downstream saturations
+  * @retval int16_t q current reference, in digits
+  */
+__weak int16_t SMPC_CalcTorqueReference(SMPC_Handle_t *pHandle, SpeednTorqCtrl_Handle_t *pSTC, int16_t hIqApplied)
+{
+  int16_t hIqRef;
+#ifdef NULL_PTR_CHECK_SPD_MPC
+  if ((MC_NULL == pHandle) || (MC_NULL == pSTC))
+  {
+    hIqRef = 0;
+  }
+  else
+  {
+#endif
+    int16_t hSpeedUnit = SPD_GetAvrgMecSpeedUnit(pSTC->SPD);
+    int16_t hAbsSpeed = (hSpeedUnit < 0) ? -hSpeedUnit : hSpeedUnit;
+    float_t fB;
+    float_t fA;
+    float_t fC;
+    float_t fF;
+    float_t fG = 0.0f;
+    float_t fRef;
+    float_t fRefStep;
+    float_t fSumGE = 0.0f;
+    float_t fSumGG = 0.0f;
+    float_t fIq = (float_t)hIqApplied;
+    float_t fMax = (float_t)pSTC->MaxPositiveTorque;
+    float_t fMin = (float_t)pSTC->MinNegativeTorque;
+    uint32_t wRemaining = pSTC->RampRemainingStep;
+    uint8_t j;
+
+    if (pHandle->PrevValid && (hAbsSpeed >= pHandle->hMinSpeedUnit))
+    {
+      float_t fPhi[SMPC_NB_PARAMS];
+      float_t fTrace = pHandle->fP[0][0] + pHandle->fP[1][1] + pHandle->fP[2][2];
+      /* Without excitation the forgetting factor makes P grow without bound:
+         it is suspended while the mean diagonal is above its initial value */
+      bool bSuspended = (fTrace > ((float_t)SMPC_NB_PARAMS * pHandle->fInitCovariance));
+
+      fPhi[SMPC_TORQUE] = fIq * pHandle->fInvIqScale;
+      fPhi[SMPC_FRICTION] = -((float_t)pHandle->hPrevSpeedUnit) * pHandle->fInvSpeedScale;
+      fPhi[SMPC_LOAD] = 1.0f;
+      SMPC_RlsStep(pHandle, fPhi, (float_t)(hSpeedUnit - pHandle->hPrevSpeedUnit),
+                   bSuspended ? 1.0f : pHandle->fForgetting, bSuspended ? 1.0f : pHandle->fInvForgetting);
+      SMPC_BoundEstimates(pHandle);
+    }
+    else
+    {
+      /* Not enough speed accuracy, the estimates are kept */
+    }
+    pHandle->hPrevSpeedUnit = hSpeedUnit;
+    pHandle->PrevValid = true;
+
+    /* Prediction over the horizon: w(j) = F(j) + G(j) iq */
+    fB = pHandle->fTheta[SMPC_TORQUE] * pHandle->fInvIqScale;
+    fA = 1.0f - (pHandle->fTheta[SMPC_FRICTION] * pHandle->fInvSpeedScale);
+    fC = pHandle->fTheta[SMPC_LOAD];
+    fF = (float_t)hSpeedUnit;
+    fRef = ((float_t)pSTC->SpeedRefUnitExt) / 65536.0f;
+    fRefStep = ((float_t)pSTC->IncDecAmount) / 65536.0f;
+    for (j = 0U; j < pHandle->bHorizon; j++)
+    {
+      float_t fErr;
+
+      fF = (fA * fF) + fC;
+      fG = (fA * fG) + fB;
+      if (wRemaining > 0U)
+      {
+        fRef += fRefStep;
+        wRemaining--;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      fErr = fRef - fF;
+      fSumGE += fG * fErr;
+      fSumGG += fG * fG;
+    }
+
+    /* fB is bounded away from zero, so is fSumGG */
+    fIq = ((fSumGE / fSumGG) + (pHandle->fMoveWeight * fIq)) * pHandle->fInvMoveDen;
+    fIq = (fIq > fMax) ? fMax : ((fIq < fMin) ? fMin : fIq);
+    hIqRef = (int16_t)fIq;
+
+    pSTC->TorqueRef = (int32_t)hIqRef * 65536;
+    PID_SetIntegralTerm(pSTC->PISpeed, (int32_t)hIqRef * (int32_t)PID_GetKIDivisor(pSTC->PISpeed));
+#ifdef NULL_PTR_CHECK_SPD_MPC
+  }
+#endif
+  return (hIqRef);
+}
+
+/**
+  * @brief  It returns one of the scaled estimates of the model
+  * @param  pHandle: handler of the current instance of the SpeedMPC component
+  * @param  bParam: 0 for the torque term, 1 for the viscous friction term, 2 for
+  *         the load term
+  * @retval float_t Estimated term, in #SPEED_UNIT per medium frequency period,
+  *         0 if bParam is out of range
+  */
+__weak float_t SMPC_GetEstimate(const SMPC_Handle_t *pHandle, uint8_t bParam)
+{
+  float_t fRetVal = 0.0f;
+#ifdef NULL_PTR_CHECK_SPD_MPC
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if (bParam < SMPC_NB_PARAMS)
+    {
+      fRetVal = pHandle->fTheta[bParam];
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_SPD_MPC
+  }
+#endif
+  return (fRetVal);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -395,7 +395,8 @@ __weak void STC_StopRamp(SpeednTorqCtrl_Handle_t *pHandle)
   * @brief  It is used to compute the new value of motor torque reference. It
   *         must be called at fixed time equal to hSTCFrequencyHz. It is called
   *         passing as parameter the speed sensor used to perform the speed
-  *         regulation.
+  *         regulation. During a speed ramp the torque of its acceleration,
+  *         scaled by AccFFGain, is added to the output of the speed PI.
   * @param  pHandle: handler of the current instance of the SpeednTorqCtrl component
   * @retval int16_t motor torque reference. This value represents actually the
   *         Iq current expressed in digit.
@@ -415,6 +416,7 @@ __weak int16_t STC_CalcTorqueReference(SpeednTorqCtrl_Handle_t *pHandle)
   {
 #endif
     int32_t wCurrentReference;
+    int32_t wTorqueFF = 0;
     int16_t hMeasuredSpeed;
     int16_t hTargetSpeed;
     int16_t hError;
@@ -435,6 +437,21 @@ __weak int16_t STC_CalcTorqueReference(SpeednTorqCtrl_Handle_t *pHandle)
       /* Increment/decrement the reference value. */
       wCurrentReference += pHandle->IncDecAmount;
 
+      /* Torque of the acceleration of the speed reference */
+      if (STC_SPEED_MODE == pHandle->Mode)
+      {
+#ifndef FULL_MISRA_C_COMPLIANCY_SPD_TORQ_CTRL
+        //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+        wTorqueFF = (int32_t)(((int64_t)pHandle->IncDecAmount * pHandle->AccFFGain) >> 16);
+#else
+        wTorqueFF = (int32_t)(((int64_t)pHandle->IncDecAmount * pHandle->AccFFGain) / 65536);
+#endif
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
       /* Decrement the number of remaining steps */
       pHandle->RampRemainingStep--;
     }
@@ -464,6 +481,28 @@ __weak int16_t STC_CalcTorqueReference(SpeednTorqCtrl_Handle_t *pHandle)
       hError = hTargetSpeed - hMeasuredSpeed;
       hTorqueReference = PI_Controller(pHandle->PISpeed, (int32_t)hError);
 
+      if (wTorqueFF != 0)
+      {
+        wTorqueFF += (int32_t)hTorqueReference;
+        if (wTorqueFF > (int32_t)pHandle->MaxPositiveTorque)
+        {
+          wTorqueFF = (int32_t)pHandle->MaxPositiveTorque;
+        }
+        else if (wTorqueFF < (int32_t)pHandle->MinNegativeTorque)
+        {
+          wTorqueFF = (int32_t)pHandle->MinNegativeTorque;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        hTorqueReference = (int16_t)wTorqueFF;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
       pHandle->SpeedRefUnitExt = wCurrentReference;
       pHandle->TorqueRef = ((int32_t)hTorqueReference) * 65536;
     }
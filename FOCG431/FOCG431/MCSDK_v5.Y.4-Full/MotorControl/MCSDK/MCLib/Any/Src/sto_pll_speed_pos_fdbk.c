@@ -74,10 +74,20 @@
 #define C6_COMP_CONST1  ((int32_t)1043038)
 #define C6_COMP_CONST2  ((int32_t)10430)
 
+/* STO_PLL_CalcElAngle() sums the products of the current estimator by pairs with dual
+   MACs, unless FULL_MISRA_C_COMPLIANCY_STO_PLL is defined. STO_PLL_NO_DUAL_MAC selects the
+   separate products alone, with the shifts kept: the SIL compares this build with the
+   default one bit for bit. */
+#if !defined (FULL_MISRA_C_COMPLIANCY_STO_PLL) && !defined (STO_PLL_NO_DUAL_MAC)
+#define STO_PLL_DUAL_MAC
+#endif
+
 /* Private function prototypes -----------------------------------------------*/
 static void STO_Store_Rotor_Speed(STO_PLL_Handle_t *pHandle, int16_t hRotor_Speed);
 static int16_t STO_ExecutePLL(STO_PLL_Handle_t *pHandle, int16_t hBemf_alfa_est, int16_t hBemf_beta_est);
 static void STO_InitSpeedBuffer(STO_PLL_Handle_t *pHandle);
+static void STO_ScheduleGains(STO_PLL_Handle_t *pHandle, int32_t wMecSpeedUnit);
+static void STO_ConsistencyFailed(STO_PLL_Handle_t *pHandle);
 
 
 /**
@@ -120,6 +130,8 @@ __weak void STO_PLL_Init(STO_PLL_Handle_t *pHandle)
     STO_PLL_Clear(pHandle);
 
     PID_HandleInit(&pHandle->PIRegulator);
+    pHandle->hNominalKpGain = PID_GetKP(&pHandle->PIRegulator);
+    pHandle->hNominalKiGain = PID_GetKI(&pHandle->PIRegulator);
 
     /* Acceleration measurement set to zero */
     pHandle->_Super.hMecAccelUnitP = 0;
@@ -157,6 +169,8 @@ __weak void STO_PLL_Return(STO_PLL_Handle_t *pHandle, uint8_t flag)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This method executes Luenberger state observer equations and calls
@@ -190,6 +204,10 @@ __weak int16_t STO_PLL_CalcElAngle(STO_PLL_Handle_t *pHandle, Observer_Inputs_t
     int16_t hRotor_Speed;
     int16_t hValfa;
     int16_t hVbeta;
+#ifdef STO_PLL_DUAL_MAC
+    uint32_t wC1C3 = __PKHBT((uint16_t)pHandle->hC1, (uint16_t)pHandle->hC3, 16);
+    uint32_t wC2C5 = __PKHBT((uint16_t)pHandle->hC2, (uint16_t)pHandle->hC5, 16);
+#endif
 
     if (pHandle->wBemf_alfa_est > (((int32_t)pHandle->hF2) * INT16_MAX))
     {
@@ -296,6 +314,12 @@ __weak int16_t STO_PLL_CalcElAngle(STO_PLL_Handle_t *pHandle, Observer_Inputs_t
     hAux = (int16_t)(pHandle->Ialfa_est / pHandle->hF1);
 #endif
 
+#ifdef STO_PLL_DUAL_MAC
+    /* C2 * error + C5 * voltage and C1 * current + C3 * BEMF, each pair by one dual MAC */
+    wIalfa_est_Next = (int32_t)__SMLAD(wC2C5, __PKHBT((uint16_t)hIalfa_err, (uint16_t)hValfa, 16),
+                                       (uint32_t)pHandle->Ialfa_est);
+    wIalfa_est_Next -= (int32_t)__SMUAD(wC1C3, __PKHBT((uint16_t)hAux, (uint16_t)hAux_Alfa, 16));
+#else
     wAux = ((int32_t)pHandle->hC1) * hAux;
     wIalfa_est_Next = pHandle->Ialfa_est - wAux;
 
@@ -307,6 +331,7 @@ __weak int16_t STO_PLL_CalcElAngle(STO_PLL_Handle_t *pHandle, Observer_Inputs_t
 
     wAux = ((int32_t)pHandle->hC3) * hAux_Alfa;
     wIalfa_est_Next -= wAux;
+#endif
 
     wAux = ((int32_t)pHandle->hC4) * hIalfa_err;
     wBemf_alfa_est_Next = pHandle->wBemf_alfa_est + wAux;
@@ -329,6 +354,12 @@ __weak int16_t STO_PLL_CalcElAngle(STO_PLL_Handle_t *pHandle, Observer_Inputs_t
     hAux = (int16_t)(pHandle->Ibeta_est / pHandle->hF1);
 #endif
 
+#ifdef STO_PLL_DUAL_MAC
+    /* C2 * error + C5 * voltage and C1 * current + C3 * BEMF, each pair by one dual MAC */
+    wIbeta_est_Next = (int32_t)__SMLAD(wC2C5, __PKHBT((uint16_t)hIbeta_err, (uint16_t)hVbeta, 16),
+                                       (uint32_t)pHandle->Ibeta_est);
+    wIbeta_est_Next -= (int32_t)__SMUAD(wC1C3, __PKHBT((uint16_t)hAux, (uint16_t)hAux_Beta, 16));
+#else
     wAux = ((int32_t)pHandle->hC1) * hAux;
     wIbeta_est_Next = pHandle->Ibeta_est - wAux;
 
@@ -340,6 +371,7 @@ __weak int16_t STO_PLL_CalcElAngle(STO_PLL_Handle_t *pHandle, Observer_Inputs_t
 
     wAux = ((int32_t)pHandle->hC3) * hAux_Beta;
     wIbeta_est_Next -= wAux;
+#endif
 
     wAux = ((int32_t)pHandle->hC4) * hIbeta_err;
     wBemf_beta_est_Next = pHandle->wBemf_beta_est + wAux;
@@ -403,7 +435,8 @@ __weak int16_t STO_PLL_CalcElAngle(STO_PLL_Handle_t *pHandle, Observer_Inputs_t
   *         parameter hMecSpeedUnit - the rotor average mechanical speed,
   *         expressed in Unit. Average is computed considering a FIFO depth
   *         equal to bSpeedBufferSizeUnit. Moreover it also computes and returns
-  *         the reliability state of the sensor.
+  *         the reliability state of the sensor. The average and the variance
+  *         come from the sums kept up to date by each write of the FIFO.
   * @param  pHandle: handler of the current instance of the STO component
   * @param  pMecSpeedUnit pointer to int16_t, used to return the rotor average
   *         mechanical speed (expressed in the unit defined by #SPEED_UNIT)
@@ -424,42 +457,37 @@ __weak bool STO_PLL_CalcAvrgMecSpeedUnit(STO_PLL_Handle_t *pHandle, int16_t *pMe
   else
   {
 #endif
-    int32_t wAvrSpeed_dpp = (int32_t)0;
-    int32_t wError;
+    int32_t wAvrSpeed_dpp;
+    int32_t wSum;
+    int64_t lSqSum;
     int32_t wAux;
     int32_t wAvrSquareSpeed;
-    int32_t wAvrQuadraticError = 0;
+    int32_t wAvrQuadraticError;
     int32_t wObsBemf, wEstBemf;
     int32_t wObsBemfSq = 0;
     int32_t wEstBemfSq = 0;
     int32_t wEstBemfSqLo;
     bool bIs_Speed_Reliable = false;
     bool bIs_Bemf_Consistent = false;
-    uint8_t i, bSpeedBufferSizeUnit = pHandle->SpeedBufferSizeUnit;
-
-    for (i = 0U; i < bSpeedBufferSizeUnit; i++)
-    {
-      wAvrSpeed_dpp += (int32_t)(pHandle->Speed_Buffer[i]);
-    }
+    uint8_t bIndex;
+    int32_t wSpeedBufferSizeUnit = (int32_t)pHandle->SpeedBufferSizeUnit;
 
-    if (0U == bSpeedBufferSizeUnit)
+    /* The sums are written by the observer at each FOC period: they are read again
+       if a new speed was stored meanwhile */
+    do
     {
-      /* Nothing to do */
-    }
-    else
-    {
-      wAvrSpeed_dpp = wAvrSpeed_dpp / ((int16_t)bSpeedBufferSizeUnit);
-    }
+      bIndex = pHandle->Speed_Buffer_Index;
+      wSum = pHandle->UnitBufferSum;
+      lSqSum = pHandle->UnitBufferSqSum;
+    } while (bIndex != pHandle->Speed_Buffer_Index);
 
-    for (i = 0U; i < bSpeedBufferSizeUnit; i++)
-    {
-      wError = ((int32_t)pHandle->Speed_Buffer[i]) - wAvrSpeed_dpp;
-      wError = (wError * wError);
-      wAvrQuadraticError += wError;
-    }
+    wAvrSpeed_dpp = wSum / wSpeedBufferSizeUnit;
 
-    /* It computes the measurement variance */
-    wAvrQuadraticError = wAvrQuadraticError / ((int16_t)bSpeedBufferSizeUnit);
+    /* It computes the measurement variance, the average of the squared errors to
+       the truncated average speed, as the sum of the squares less its square */
+    lSqSum = lSqSum - (2 * (int64_t)wAvrSpeed_dpp * wSum)
+           + ((int64_t)wSpeedBufferSizeUnit * wAvrSpeed_dpp * wAvrSpeed_dpp);
+    wAvrQuadraticError = (int32_t)(lSqSum / wSpeedBufferSizeUnit);
 
     /* The maximum variance acceptable is here calculated as a function of average speed */
     wAvrSquareSpeed = wAvrSpeed_dpp * wAvrSpeed_dpp;
@@ -481,6 +509,7 @@ __weak bool STO_PLL_CalcAvrgMecSpeedUnit(STO_PLL_Handle_t *pHandle, int16_t *pMe
     pHandle->_Super.hAvrMecSpeedUnit = (int16_t)wAux;
 
     pHandle->IsSpeedReliable = bIs_Speed_Reliable;
+    STO_ScheduleGains(pHandle, wAux);
 
     /*Bemf Consistency Check algorithm*/
     if (true == pHandle->EnableDualCheck) /*do algorithm if it's enabled*/
@@ -559,6 +588,8 @@ __weak bool STO_PLL_CalcAvrgMecSpeedUnit(STO_PLL_Handle_t *pHandle, int16_t *pMe
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This method must be called - at least - with the same periodicity
@@ -678,15 +709,15 @@ __weak void STO_PLL_Clear(STO_PLL_Handle_t *pHandle)
   */
 inline static void STO_Store_Rotor_Speed(STO_PLL_Handle_t *pHandle, int16_t hRotor_Speed)
 {
-  uint8_t bBuffer_index = pHandle->Speed_Buffer_Index;
+  uint8_t bBuffer_index = (pHandle->Speed_Buffer_Index + 1U) & (pHandle->SpeedBufferSizeUnit - 1U);
+  int32_t wOldest = (int32_t)pHandle->Speed_Buffer[bBuffer_index];
+  int32_t wNewest = (int32_t)hRotor_Speed;
 
-  bBuffer_index++;
-  if (bBuffer_index == pHandle->SpeedBufferSizeUnit)
-  {
-    bBuffer_index = 0U;
-  }
+  /* The element overwritten leaves the sums of the SpeedBufferSizeUnit elements */
+  pHandle->UnitBufferSum += wNewest - wOldest;
+  pHandle->UnitBufferSqSum += (int64_t)((wNewest * wNewest) - (wOldest * wOldest));
 
-  pHandle->SpeedBufferOldestEl = pHandle->Speed_Buffer[bBuffer_index];
+  pHandle->SpeedBufferOldestEl = (int16_t)wOldest;
   pHandle->Speed_Buffer[bBuffer_index] = hRotor_Speed;
   pHandle->Speed_Buffer_Index = bBuffer_index;
 }
@@ -731,6 +762,61 @@ inline static int16_t STO_ExecutePLL(STO_PLL_Handle_t *pHandle, int16_t hBemf_al
   return (hOutput);
 }
 
+/**
+  * @brief  It raises the PLL gains below GainScheduleSpeedUnit, in inverse
+  *         proportion to the mechanical speed and up to GainScheduleMax times
+  *         the nominal gains. The error of the PLL is proportional to the
+  *         back-emf, so to the speed: the bandwidth of the PLL is kept during
+  *         the rev-up instead of falling with the speed, and the observer locks
+  *         earlier. The integral term is kept, the change is bumpless.
+  * @param  pHandle: handler of the current instance of the STO component
+  * @param  wMecSpeedUnit average mechanical speed estimated by the observer
+  * @retval none
+  */
+static void STO_ScheduleGains(STO_PLL_Handle_t *pHandle, int32_t wMecSpeedUnit)
+{
+  if (0U == pHandle->GainScheduleSpeedUnit)
+  {
+    /* Nothing to do, the nominal gains are kept */
+  }
+  else
+  {
+    int32_t wAbsSpeed = (wMecSpeedUnit < 0) ? -wMecSpeedUnit : wMecSpeedUnit;
+    int32_t wMaxFactor = ((int32_t)pHandle->GainScheduleMax) * 256;
+    int32_t wFactor; /* Q8 */
+    int32_t wKp;
+    int32_t wKi;
+
+    wFactor = (wAbsSpeed > 0) ? ((((int32_t)pHandle->GainScheduleSpeedUnit) * 256) / wAbsSpeed) : wMaxFactor;
+    wFactor = (wFactor > wMaxFactor) ? wMaxFactor : wFactor;
+    wFactor = (wFactor < 256) ? 256 : wFactor;
+
+    wKp = (((int32_t)pHandle->hNominalKpGain) * wFactor) / 256;
+    wKi = (((int32_t)pHandle->hNominalKiGain) * wFactor) / 256;
+    PID_SetKP(&pHandle->PIRegulator, (int16_t)((wKp > (int32_t)INT16_MAX) ? INT16_MAX : wKp));
+    PID_SetKI(&pHandle->PIRegulator, (int16_t)((wKi > (int32_t)INT16_MAX) ? INT16_MAX : wKi));
+  }
+}
+
+/**
+  * @brief  It records a failed start-up consistency test: the count of passed
+  *         tests is cleared, or only halved with FastConvergence so that a single
+  *         outlier of the rev-up does not restart the whole test.
+  * @param  pHandle: handler of the current instance of the STO component
+  * @retval none
+  */
+static void STO_ConsistencyFailed(STO_PLL_Handle_t *pHandle)
+{
+  if (true == pHandle->FastConvergence)
+  {
+    pHandle->ConsistencyCounter /= 2U;
+  }
+  else
+  {
+    pHandle->ConsistencyCounter = 0U;
+  }
+}
+
 /**
   * @brief  It clears the estimated speed buffer
   * @param  pHandle: handler of the current instance of the STO component
@@ -748,6 +834,8 @@ static void STO_InitSpeedBuffer(STO_PLL_Handle_t * pHandle)
   }
   pHandle->Speed_Buffer_Index = 0U;
   pHandle->SpeedBufferOldestEl = (int16_t)0;
+  pHandle->UnitBufferSum = (int32_t)0;
+  pHandle->UnitBufferSqSum = (int64_t)0;
 
   return;
 }
@@ -757,7 +845,9 @@ static void STO_InitSpeedBuffer(STO_PLL_Handle_t * pHandle)
   *         the state observer algorithm converged. To be periodically called
   *         during motor open-loop ramp-up (e.g. at the same frequency of
   *         SPD_CalcElAngle), it returns true if the estimated angle and speed
-  *         can be considered reliable, false otherwise
+  *         can be considered reliable, false otherwise. The estimated speed must
+  *         pass StartUpConsistThreshold tests, consecutive unless FastConvergence
+  *         is set
   * @param  pHandle: handler of the current instance of the STO component
   * @param  hForcedMecSpeedUnit Mechanical speed in 0.1Hz unit as forced by VSS
   * @retval bool sensor reliability state
@@ -823,7 +913,18 @@ __weak bool STO_PLL_IsObserverConverged(STO_PLL_Handle_t *pHandle, int16_t *phFo
             {
               if (hEstimatedSpeedUnit <= hUpperThreshold)
               {
-                pHandle->ConsistencyCounter++;
+                wAux = (int32_t)*phForcedMecSpeedUnit;
+                if ((true == pHandle->FastConvergence)
+                    && ((2 * (int32_t)hEstimatedSpeedUnit) >= (wAux + hLowerThreshold))
+                    && ((2 * (int32_t)hEstimatedSpeedUnit) <= (wAux + hUpperThreshold)))
+                {
+                  /* Inside the inner half of the band: worth two tests */
+                  pHandle->ConsistencyCounter += 2U;
+                }
+                else
+                {
+                  pHandle->ConsistencyCounter++;
+                }
 
                 /*... for hConsistencyThreshold consecutive times... */
                 if (pHandle->ConsistencyCounter >= pHandle->StartUpConsistThreshold)
@@ -837,22 +938,22 @@ __weak bool STO_PLL_IsObserverConverged(STO_PLL_Handle_t *pHandle, int16_t *phFo
               }
               else
               {
-                pHandle->ConsistencyCounter = 0U;
+                STO_ConsistencyFailed(pHandle);
               }
             }
             else
             {
-              pHandle->ConsistencyCounter = 0U;
+              STO_ConsistencyFailed(pHandle);
             }
           }
           else
           {
-            pHandle->ConsistencyCounter = 0U;
+            STO_ConsistencyFailed(pHandle);
           }
         }
         else
         {
-          pHandle->ConsistencyCounter = 0U;
+          STO_ConsistencyFailed(pHandle);
         }
       }
     }
@@ -925,6 +1026,47 @@ __weak alphabeta_t STO_PLL_GetEstimatedCurrent(STO_PLL_Handle_t *pHandle)
   return (iaux);
 }
 
+/**
+  * @brief  It exports the current step of the last period produced by the
+  *         back-EMF in the model of the state observer, -hC3 * Bemf / hF1. A
+  *         predictive current controller can take it as its own back-EMF term,
+  *         so that the model is evaluated once for both and follows the
+  *         observer when its parameters change.
+  * @param  pHandle: handler of the current instance of the STO component
+  * @retval alphabeta_t Current step alpha-beta, in current digits per period
+  */
+__weak alphabeta_t STO_PLL_GetBemfCurrentStep(STO_PLL_Handle_t *pHandle)
+{
+  alphabeta_t Step;
+#ifdef NULL_PTR_STO_PLL_SPD_POS_FDB
+  if (MC_NULL == pHandle)
+  {
+    Step.alpha = 0;
+    Step.beta = 0;
+  }
+  else
+  {
+#endif
+    int32_t wAlpha = -((int32_t)pHandle->hC3 * pHandle->hBemf_alfa_est);
+    int32_t wBeta = -((int32_t)pHandle->hC3 * pHandle->hBemf_beta_est);
+
+#ifndef FULL_MISRA_C_COMPLIANCY_STO_PLL
+    //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+    wAlpha = wAlpha >> pHandle->F1LOG;
+    //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+    wBeta = wBeta >> pHandle->F1LOG;
+#else
+    wAlpha = wAlpha / pHandle->hF1;
+    wBeta = wBeta / pHandle->hF1;
+#endif
+    Step.alpha = (int16_t)((wAlpha > INT16_MAX) ? INT16_MAX : ((wAlpha < -INT16_MAX) ? -INT16_MAX : wAlpha));
+    Step.beta = (int16_t)((wBeta > INT16_MAX) ? INT16_MAX : ((wBeta < -INT16_MAX) ? -INT16_MAX : wBeta));
+#ifdef NULL_PTR_STO_PLL_SPD_POS_FDB
+  }
+#endif
+  return (Step);
+}
+
 /**
   * @brief  It exports current observer gains through parameters hhC2 and hhC4
   * @param  pHandle: handler of the current instance of the STO component
@@ -975,7 +1117,8 @@ __weak void STO_PLL_SetObserverGains(STO_PLL_Handle_t *pHandle, int16_t hhC1, in
 }
 
 /**
-  * @brief  It exports current PLL gains through parameters pPgain and pIgain
+  * @brief  It exports the nominal PLL gains through parameters pPgain and pIgain.
+  *         Below GainScheduleSpeedUnit the gains applied are larger.
   * @param  pHandle: handler of the current instance of the STO component
   * @param  pPgain pointer to int16_t used to return PLL proportional gain
   * @param  pIgain pointer to int16_t used to return PLL integral gain
@@ -991,8 +1134,8 @@ __weak void STO_GetPLLGains(STO_PLL_Handle_t *pHandle, int16_t *pPgain, int16_t
   else
   {
 #endif
-    *pPgain = PID_GetKP(& pHandle->PIRegulator);
-    *pIgain = PID_GetKI(& pHandle->PIRegulator);
+    *pPgain = pHandle->hNominalKpGain;
+    *pIgain = pHandle->hNominalKiGain;
 #ifdef NULL_PTR_STO_PLL_SPD_POS_FDB
   }
 #endif
@@ -1000,7 +1143,9 @@ __weak void STO_GetPLLGains(STO_PLL_Handle_t *pHandle, int16_t *pPgain, int16_t
 
 
 /**
-  * @brief  It allows setting new values for PLL gains
+  * @brief  It allows setting new values for the nominal PLL gains, the gains
+  *         applied at and above GainScheduleSpeedUnit. They are applied at once,
+  *         and scaled at the next speed computation below that speed.
   * @param  pHandle: handler of the current instance of the STO component
   * @param  hPgain new value for PLL proportional gain
   * @param  hIgain new value for PLL integral gain
@@ -1016,6 +1161,8 @@ __weak void STO_SetPLLGains(STO_PLL_Handle_t *pHandle, int16_t hPgain, int16_t h
   else
   {
 #endif
+    pHandle->hNominalKpGain = hPgain;
+    pHandle->hNominalKiGain = hIgain;
     PID_SetKP(&pHandle->PIRegulator, hPgain);
     PID_SetKI(&pHandle->PIRegulator, hIgain);
 #ifdef NULL_PTR_STO_PLL_SPD_POS_FDB
@@ -1076,6 +1223,8 @@ __weak void STO_OTF_ResetPLL(STO_Handle_t * pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It resets integral term of PLL
@@ -67,6 +67,26 @@ void TC_Init(PosCtrl_Handle_t *pHandle, PID_Handle_t *pPIDPosReg, SpeednTorqCtrl
   pHandle->MecAngleOffset = 0;
 }
 
+/**
+  * @brief  It stops the trajectory and the position regulation, and clears the
+  *         position PID, so that a later command starts from a steady state.
+  *         It must be called when the motor stops and when a speed or torque
+  *         command takes over.
+  * @param  pHandle: handler of the current instance of the Position Control component.
+  * @retval none
+  */
+void TC_Clear(PosCtrl_Handle_t *pHandle)
+{
+  pHandle->PositionControlRegulation = DISABLE;
+  pHandle->PositionCtrlStatus = TC_READY_FOR_COMMAND;
+  pHandle->ElapseTime = 0.0f;
+  pHandle->Omega = 0.0f;
+  pHandle->Acceleration = 0.0f;
+  pHandle->ReceivedTh = 0U;
+  PID_SetIntegralTerm(pHandle->PIDPosRegulator, 0);
+  PID_SetPrevError(pHandle->PIDPosRegulator, 0);
+}
+
 /**
   * @brief  It configures the trapezoidal speed trajectory.
   * @param  pHandle: handler of the current instance of the Position Control component.
@@ -80,7 +100,7 @@ bool TC_MoveCommand(PosCtrl_Handle_t *pHandle, float startingAngle, float angleS
 {
 
   bool RetConfigStatus = false;
-  float fMinimumStepDuration;
+  float fMinimumStepDuration = (9.0f * pHandle->SamplingTime);
 
   if ((pHandle->PositionCtrlStatus == TC_FOLLOWING_ON_GOING) && (movementDuration > 0))
   {
@@ -88,12 +108,11 @@ bool TC_MoveCommand(PosCtrl_Handle_t *pHandle, float startingAngle, float angleS
     pHandle->PositionCtrlStatus = TC_READY_FOR_COMMAND;
   }
 
-  if ((pHandle->PositionCtrlStatus == TC_READY_FOR_COMMAND) && (movementDuration > 0))
+  /* A movement shorter than the minimum step duration would be rounded to 0 */
+  if ((pHandle->PositionCtrlStatus == TC_READY_FOR_COMMAND) && (movementDuration >= fMinimumStepDuration))
   {
     pHandle->PositionControlRegulation = ENABLE;
 
-    fMinimumStepDuration = (9.0f * pHandle->SamplingTime);
-
     // WARNING: Movement duration value is rounded to the nearest valid value
     //          [(DeltaT/9) / SamplingTime]:  shall be an integer value
     pHandle->MovementDuration = (float)((int)(movementDuration / fMinimumStepDuration)) * fMinimumStepDuration;
@@ -211,7 +230,9 @@ void TC_PositionRegulation(PosCtrl_Handle_t *pHandle)
   {
     wMecAngleRef = (int32_t)(pHandle->Theta * RADTOS16);
 
-    wMecAngle = SPD_GetMecAngle(STC_GetSpeedSensor(pHandle->pSTC));
+    /* The position is the one of the encoder, even when the speed loop runs on
+       another sensor */
+    wMecAngle = SPD_GetMecAngle(&pHandle->pENC->_Super);
     wError = wMecAngleRef - wMecAngle;
     hTorqueRef_Pos = PID_Controller(pHandle->PIDPosRegulator, wError);
 
@@ -318,7 +339,7 @@ void TC_EncAlignmentCommand(PosCtrl_Handle_t *pHandle)
     {
       // If index is supported start the search of the zero
       pHandle->EncoderAbsoluteAligned = false;
-      wMecAngleRef = SPD_GetMecAngle(STC_GetSpeedSensor(pHandle->pSTC));
+      wMecAngleRef = SPD_GetMecAngle(&pHandle->pENC->_Super);
       TC_MoveCommand(pHandle, (float)(wMecAngleRef) / RADTOS16, Z_ALIGNMENT_NB_ROTATION, Z_ALIGNMENT_DURATION);
       pHandle->AlignmentStatus = TC_ZERO_ALIGNMENT_START;
     }
@@ -378,7 +399,7 @@ void TC_EncoderReset(PosCtrl_Handle_t *pHandle)
 float TC_GetCurrentPosition(PosCtrl_Handle_t *pHandle)
 {
 
-  return ((float)((SPD_GetMecAngle(STC_GetSpeedSensor(pHandle->pSTC))) / RADTOS16));
+  return ((float)((SPD_GetMecAngle(&pHandle->pENC->_Super)) / RADTOS16));
 }
 
 /**
@@ -0,0 +1,94 @@
+/**
+  ******************************************************************************
+  * @file    pid_fmac_g4xx.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          PI regulator computed by the FMAC of the STM32G4.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup PID_FMAC_G4XX
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PID_FMAC_G4XX_H
+#define PID_FMAC_G4XX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "pid_regulator.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup PIDRegulator
+  * @{
+  */
+
+/** @addtogroup PID_FMAC_G4XX
+  * @{
+  */
+
+/* Exported defines --------------------------------------------------------*/
+
+/* Buffers of the regulators in the local memory of the FMAC, words 0 to 10. The other
+   users of the FMAC place theirs above PID_FMAC_MEM_END. */
+#define PID_FMAC_X2_BASE     0U   /* b0, b1, b2 then a1 */
+#define PID_FMAC_X2_SIZE     4U
+#define PID_FMAC_X1_BASE     4U   /* Fraction r(k-1), e(k-1), e(k) */
+#define PID_FMAC_X1_SIZE     4U
+#define PID_FMAC_Y_BASE      8U   /* y(k-1), y(k) */
+#define PID_FMAC_Y_SIZE      2U
+#define PID_FMAC_MEM_END     10U
+
+/* Feed forward taps: e(k), e(k-1) and the fraction, and feedback taps: y(k-1) */
+#define PID_FMAC_TAPS_B      3U
+#define PID_FMAC_TAPS_A      1U
+
+/* Largest gain R of the FMAC: the coefficients are in [-2^R, 2^R[ */
+#define PID_FMAC_MAX_SHIFT   7U
+
+/* Exported functions ------------------------------------------------------- */
+
+/**
+  * Enables the FMAC with the clipping of its outputs.
+  */
+void PID_FMAC_Init(void);
+
+/**
+  * Computes the output of a PI regulator with the FMAC.
+  */
+int16_t PI_FMAC_Controller(PID_Handle_t *pHandle, int32_t wProcessVarError);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* PID_FMAC_G4XX_H */
+
+/************************ (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -100,6 +100,9 @@ typedef const struct
                                          and all the 6 sectors */
   uint32_t ADCConfig1 [6] ; /*!< values of JSQR for first ADC for 6 sectors */
   uint32_t ADCConfig2 [6] ; /*!< values of JSQR for Second ADC for 6 sectors */
+  uint8_t ADCOversampling;  /*!< Number of injected conversions averaged by the
+                                 oversampler of the ADCs for each current sample:
+                                 1 (oversampling disabled), 2 or 4 */
 
   uint16_t pwm_en_u_pin;                    /*!< Channel 1N (low side) GPIO output pin */
   uint16_t pwm_en_v_pin;                    /*!< Channel 2N (low side) GPIO output pin */
@@ -119,6 +122,11 @@ typedef const struct
                                             number of TIM clocks.*/
   uint16_t Tcase3;                   /*!< It is the sampling time express in
                                             number of TIM clocks.*/
+#ifdef PWM_DOUBLE_UPDATE
+  uint16_t Tvalley;                  /*!< Half width of the window of the low sides
+                                            around the underflow, forced by TIMx CH5,
+                                            in number of TIM clocks.*/
+#endif
 
   /* DAC settings --------------------------------------------------------------*/
   uint16_t DAC_OCP_Threshold;        /*!< Value of analog reference expressed
@@ -187,6 +195,12 @@ typedef struct
   uint16_t ADC_ExternalPolarityInjected;
   volatile uint8_t PolarizationCounter;
   uint8_t PolarizationSector; /*!< Sector selected during calibration phase */
+  uint8_t ADCDataShift;     /*!< Left shift giving the injected data the scale
+                                 of a single left aligned conversion */
+#ifdef PWM_DOUBLE_UPDATE
+  volatile uint8_t UpdateCount; /*!< Update events of TIMx, counted by the interrupt */
+  uint8_t ArmedUpdateCount; /*!< UpdateCount when the sampling was last armed */
+#endif
   /*!< Trigger selection for ADC peripheral.*/
   bool OverCurrentFlag;     /*!< This flag is set when an overcurrent occurs.*/
   bool OverVoltageFlag;     /*!< This flag is set when an overvoltage occurs.*/
@@ -205,6 +219,18 @@ typedef struct
   */
 void R3_2_Init(PWMC_R3_2_Handle_t *pHandle);
 
+/**
+  * It starts the initialization: OPAMPs, comparators and the calibration of the ADCs,
+  * that runs while the caller goes on
+  */
+void R3_2_StartInit(PWMC_R3_2_Handle_t *pHandle);
+
+/**
+  * It completes the initialization started by R3_2_StartInit: enables the ADCs
+  * once calibrated and initializes TIMx
+  */
+void R3_2_CompleteInit(PWMC_R3_2_Handle_t *pHandle);
+
 /**
   * It stores into the handle the voltage present on Ia and
   * Ib current feedback analog channels when no current is flowin into the
@@ -259,6 +285,18 @@ uint16_t R3_2_SetADCSampPointSectX(PWMC_Handle_t *pHdl);
   */
 uint16_t R3_2_SetADCSampPointSectX_OVM(PWMC_Handle_t *pHdl);
 
+/**
+  * Configure the ADC for the current sampling of a switching state
+  * applied by PWMC_SetSwitchingState(), in the middle of the PWM period.
+  * And call the WriteTIMRegisters method.
+  */
+uint16_t R3_2_SetADCSampPointState(PWMC_Handle_t *pHdl);
+
+/**
+  * It sets the timing of the current sampling, in place of the one of the parameters
+  */
+bool R3_2_SetSamplingTiming(PWMC_Handle_t *pHdl, const PWMC_SampTiming_t *pTiming);
+
 /**
   *  It contains the TIMx Update event interrupt
   */
@@ -64,6 +64,7 @@
 static void ICS_TIMxInit(TIM_TypeDef *TIMx, PWMC_Handle_t *pHdl);
 static void ICS_ADCxInit(ADC_TypeDef *ADCx);
 static void ICS_HFCurrentsPolarization(PWMC_Handle_t *pHdl, ab_t *Iab);
+static uint16_t ICS_WriteSampling(PWMC_ICS_Handle_t *pHandle, uint16_t hInstant);
 
 /**
   * @brief  It initializes TIMx, ADC, GPIO, DMA1 and NVIC for current reading
@@ -124,6 +125,9 @@ __weak void ICS_Init(PWMC_ICS_Handle_t *pHandle)
     {
       /* Nothing to do ADCx_2 already configured */
     }
+    pHandle->SamplingPoint = pHandle->pParams_str->SamplingPoint;
+    pHandle->SamplingPointState = pHandle->pParams_str->SamplingPointState;
+    pHandle->ADC_ExternalPolarityInjected = (uint16_t)LL_ADC_INJ_TRIG_EXT_RISING;
     ICS_TIMxInit(TIMx, &pHandle->_Super);
   }
 }
@@ -445,13 +449,91 @@ __attribute__((section(".ccmram")))
 __weak uint16_t ICS_WriteTIMRegisters(PWMC_Handle_t *pHdl)
 {
   PWMC_ICS_Handle_t *pHandle = (PWMC_ICS_Handle_t *)pHdl;    //cstat !MISRAC2012-Rule-11.3
+
+  return (ICS_WriteSampling(pHandle, pHandle->SamplingPoint));
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Configure the ADC for the current sampling of a switching state applied by
+  *         PWMC_SetSwitchingState(). The sensors do not need the low sides on: an active
+  *         state is sampled at SamplingPointState, for instance while it is applied,
+  *         and the zero states at SamplingPoint.
+  *         And call the WriteTIMRegisters method.
+  * @param  pHdl: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak uint16_t ICS_SetADCSampPointState(PWMC_Handle_t *pHdl)
+{
+  PWMC_ICS_Handle_t *pHandle = (PWMC_ICS_Handle_t *)pHdl;    //cstat !MISRAC2012-Rule-11.3
+
+  /* lowDuty is the compare value of the phases with their high side on, 0 in a zero state */
+  return (ICS_WriteSampling(pHandle, (0U == pHdl->lowDuty) ? pHandle->SamplingPoint
+                                                             : pHandle->SamplingPointState));
+}
+
+/**
+  * @brief  It sets the sampling instants, in number of TIM clocks from the update event.
+  *         They are taken into account by the next call of the WriteTIMRegisters method.
+  *         An instant right after the update event must leave the time of the TIMx update
+  *         interrupt, that arms the trigger of the ADCs.
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @param  hSamplingPoint: instant of the sampling of the modulated periods and of
+  *         the zero switching states
+  * @param  hSamplingPointState: instant of the sampling of the active switching states
+  * @retval none
+  */
+__weak void ICS_SetSamplingPoints(PWMC_ICS_Handle_t *pHandle, uint16_t hSamplingPoint, uint16_t hSamplingPointState)
+{
+  uint16_t hLast = (uint16_t)(pHandle->_Super.PWMperiod - 1U);
+
+  pHandle->SamplingPoint = (hSamplingPoint < hLast) ? hSamplingPoint : hLast;
+  pHandle->SamplingPointState = (hSamplingPointState < hLast) ? hSamplingPointState : hLast;
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Writes the duty cycles and the sampling instant of the next PWM period.
+  *         TIMx_Ch4, in PWM mode 2, rises at its compare value in the up counting and
+  *         falls at it in the down counting: the first half of the period is reached by
+  *         the rising edge and the second half by the falling edge of the trigger.
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @param  hInstant: instant of the sampling, in number of TIM clocks from the update event
+  * @retval uint16_t MC_FOC_DURATION if the update event has already occurred, MC_NO_ERROR otherwise
+  */
+static uint16_t ICS_WriteSampling(PWMC_ICS_Handle_t *pHandle, uint16_t hInstant)
+{
   TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+  uint16_t hCompare;
   uint16_t Aux;
 
+  if (hInstant < pHandle->Half_PWMPeriod)
+  {
+    pHandle->ADC_ExternalPolarityInjected = (uint16_t)LL_ADC_INJ_TRIG_EXT_RISING;
+    hCompare = hInstant;
+  }
+  else
+  {
+    pHandle->ADC_ExternalPolarityInjected = (uint16_t)LL_ADC_INJ_TRIG_EXT_FALLING;
+    hCompare = (uint16_t)((2U * pHandle->Half_PWMPeriod) - hInstant - 1U);
+  }
 
   LL_TIM_OC_SetCompareCH1(TIMx, (uint32_t) pHandle->_Super.CntPhA);
   LL_TIM_OC_SetCompareCH2(TIMx, (uint32_t) pHandle->_Super.CntPhB);
   LL_TIM_OC_SetCompareCH3(TIMx, (uint32_t) pHandle->_Super.CntPhC);
+  LL_TIM_OC_SetCompareCH4(TIMx, (uint32_t) hCompare);
 
   /* Limit for update event */
   if (((TIMx->CR2) & TIM_CR2_MMS_Msk) != LL_TIM_TRGO_RESET)
@@ -552,7 +634,8 @@ __weak void ICS_SwitchOnPWM(PWMC_Handle_t *pHdl)
 
   pHandle->_Super.TurnOnLowSidesAction = false;
 
-  /* Set all duty to 50% */
+  /* Set all duty to 50%, the first sampling is in the middle of the period */
+  pHandle->ADC_ExternalPolarityInjected = (uint16_t)LL_ADC_INJ_TRIG_EXT_RISING;
   LL_TIM_OC_SetCompareCH1(TIMx, ((uint32_t) pHandle->Half_PWMPeriod / (uint32_t) 2));
   LL_TIM_OC_SetCompareCH2(TIMx, ((uint32_t) pHandle->Half_PWMPeriod / (uint32_t) 2));
   LL_TIM_OC_SetCompareCH3(TIMx, ((uint32_t) pHandle->Half_PWMPeriod / (uint32_t) 2));
@@ -660,8 +743,10 @@ __weak void *ICS_TIMx_UP_IRQHandler(PWMC_ICS_Handle_t *pHandle)
   ADC_TypeDef *ADCx_2 = pHandle->pParams_str->ADCx_2;
 
 
-  ADCx_1->JSQR = (uint32_t) pHandle->pParams_str->ADCConfig1;
-  ADCx_2->JSQR = (uint32_t) pHandle->pParams_str->ADCConfig2;
+  /* Both ADCs are triggered by the same edge of the same event: the two sensors are
+     sampled simultaneously */
+  ADCx_1->JSQR = (uint32_t) pHandle->pParams_str->ADCConfig1 | (uint32_t) pHandle->ADC_ExternalPolarityInjected;
+  ADCx_2->JSQR = (uint32_t) pHandle->pParams_str->ADCConfig2 | (uint32_t) pHandle->ADC_ExternalPolarityInjected;
 
   /* enable ADC trigger source */
   LL_TIM_SetTriggerOutput(TIMx, LL_TIM_TRGO_OC4REF);
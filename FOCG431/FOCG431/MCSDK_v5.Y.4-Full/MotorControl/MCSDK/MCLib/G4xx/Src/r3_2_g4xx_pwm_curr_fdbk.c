@@ -59,12 +59,25 @@
                                                LL_TIM_CHANNEL_CH2|LL_TIM_CHANNEL_CH2N|\
                                                LL_TIM_CHANNEL_CH3|LL_TIM_CHANNEL_CH3N))
 
+/* Trigger output of TIMx that starts the injected conversions once armed: the update event,
+   at the underflow and the overflow, with PWM_DOUBLE_UPDATE, OC4REF otherwise */
+#ifdef PWM_DOUBLE_UPDATE
+#define R3_2_TRGO_SAMPLING         LL_TIM_TRGO_UPDATE
+#else
+#define R3_2_TRGO_SAMPLING         LL_TIM_TRGO_OC4REF
+#endif
+
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
 static void R3_2_TIMxInit(TIM_TypeDef *TIMx, PWMC_Handle_t *pHdl);
+static bool R3_2_ADCxEnableRegulator(ADC_TypeDef *ADCx);
 static void R3_2_ADCxInit(ADC_TypeDef *ADCx);
+static void R3_2_ADCxOversamplingInit(ADC_TypeDef *ADCx, uint8_t Oversampling);
 __STATIC_INLINE uint16_t R3_2_WriteTIMRegisters(PWMC_Handle_t *pHdl, uint16_t hCCR4Reg);
+__STATIC_INLINE uint16_t R3_2_SamplingPointAfter(PWMC_R3_2_Handle_t *pHandle);
+__STATIC_INLINE void R3_2_ArmSampling(PWMC_R3_2_Handle_t *pHandle);
+static uint32_t R3_2_ADCxChannel(uint32_t ADCConfig);
 static void R3_2_HFCurrentsPolarizationAB(PWMC_Handle_t *pHdl, ab_t *Iab);
 static void R3_2_HFCurrentsPolarizationC(PWMC_Handle_t *pHdl, ab_t *Iab);
 static void R3_2_SetAOReferenceVoltage(uint32_t DAC_Channel, DAC_TypeDef *DACx, uint16_t hDACVref);
@@ -79,6 +92,20 @@ static void R3_2_RLSwitchOnPWM(PWMC_Handle_t *pHdl);
   * @retval none
   */
 __weak void R3_2_Init(PWMC_R3_2_Handle_t *pHandle)
+{
+  R3_2_StartInit(pHandle);
+  R3_2_CompleteInit(pHandle);
+}
+
+/**
+  * @brief  It starts the initialization of the component: OPAMPs, comparators, and the
+  *         voltage regulators and calibration of both ADCs, started together. The
+  *         calibration runs in the background until R3_2_CompleteInit is called, so that
+  *         the caller can initialize the other components meanwhile.
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void R3_2_StartInit(PWMC_R3_2_Handle_t *pHandle)
 {
   if (MC_NULL == pHandle)
   {
@@ -224,6 +251,90 @@ __weak void R3_2_Init(PWMC_R3_2_Handle_t *pHandle)
         /* Nothing to do */
       }
 
+      bool RegulWait = false;
+
+      if (0U == LL_ADC_IsEnabled(ADCx_1))
+      {
+        R3_2_ADCxOversamplingInit(ADCx_1, pHandle->pParams_str->ADCOversampling);
+        RegulWait = R3_2_ADCxEnableRegulator(ADCx_1);
+      }
+      else
+      {
+        /* Nothing to do ADCx_1 already configured */
+      }
+      if (0U == LL_ADC_IsEnabled(ADCx_2))
+      {
+        R3_2_ADCxOversamplingInit(ADCx_2, pHandle->pParams_str->ADCOversampling);
+        RegulWait = R3_2_ADCxEnableRegulator(ADCx_2) || RegulWait;
+      }
+      else
+      {
+        /* Nothing to do ADCx_2 already configured */
+      }
+
+      if (true == RegulWait)
+      {
+        /* Wait for Regulator Startup time, once for both */
+        /* Note: Variable divided by 2 to compensate partially              */
+        /*       CPU processing cycles, scaling in us split to not          */
+        /*       exceed 32 bits register capacity and handle low frequency. */
+        volatile uint32_t wait_loop_index = ((LL_ADC_DELAY_INTERNAL_REGUL_STAB_US / 10UL)
+                                             * (SystemCoreClock / (100000UL * 2UL)));
+        while (wait_loop_index != 0UL)
+        {
+          wait_loop_index--;
+        }
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
+      /* Both calibrations run at the same time, each ADC has its own analog part */
+      if (0U == LL_ADC_IsEnabled(ADCx_1))
+      {
+        LL_ADC_StartCalibration(ADCx_1, LL_ADC_SINGLE_ENDED);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      if (0U == LL_ADC_IsEnabled(ADCx_2))
+      {
+        LL_ADC_StartCalibration(ADCx_2, LL_ADC_SINGLE_ENDED);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+}
+
+/**
+  * @brief  It completes the initialization started by R3_2_StartInit: it waits for the
+  *         end of the calibration of the ADCs, enables them and initializes TIMx.
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void R3_2_CompleteInit(PWMC_R3_2_Handle_t *pHandle)
+{
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+    ADC_TypeDef *ADCx_1 = pHandle->pParams_str->ADCx_1;
+    ADC_TypeDef *ADCx_2 = pHandle->pParams_str->ADCx_2;
+
+    if ((uint32_t)pHandle == (uint32_t)&pHandle->_Super) //cstat !MISRAC2012-Rule-11.4
+    {
       if (0U == LL_ADC_IsEnabled(ADCx_1))
       {
         R3_2_ADCxInit(ADCx_1);
@@ -245,6 +356,25 @@ __weak void R3_2_Init(PWMC_R3_2_Handle_t *pHandle)
       {
         /* Nothing to do ADCx_2 already configured */
       }
+      /* The oversampled data are right aligned sums: 13 bits for 2 conversions, 14 bits for 4 */
+      if (pHandle->pParams_str->ADCOversampling > 2U)
+      {
+        pHandle->ADCDataShift = 2U;
+      }
+      else if (2U == pHandle->pParams_str->ADCOversampling)
+      {
+        pHandle->ADCDataShift = 3U;
+      }
+      else
+      {
+        pHandle->ADCDataShift = 0U;
+      }
+      /* Timing of the parameters, and sampling time set by the ADC configuration */
+      pHandle->_Super.SampTiming.hTafter = pHandle->pParams_str->Tafter;
+      pHandle->_Super.SampTiming.hTbefore = pHandle->pParams_str->Tbefore;
+      pHandle->_Super.SampTiming.bSampleTime = (uint8_t)LL_ADC_GetChannelSamplingTime(ADCx_1,
+                                               R3_2_ADCxChannel(pHandle->pParams_str->ADCConfig1[0]));
+      pHandle->_Super.SampTiming.bReserved = 0U;
       R3_2_TIMxInit(TIMx, &pHandle->_Super);
     }
     else
@@ -254,8 +384,16 @@ __weak void R3_2_Init(PWMC_R3_2_Handle_t *pHandle)
   }
 }
 
-static void R3_2_ADCxInit(ADC_TypeDef *ADCx)
+/**
+  * @brief  Exits an ADC from deep-power-down mode and enables its voltage regulator.
+  * @param  ADCx ADC to be powered up
+  * @retval bool True if the regulator was off: its startup time must be waited
+  *         for before the calibration is started
+  */
+static bool R3_2_ADCxEnableRegulator(ADC_TypeDef *ADCx)
 {
+  bool RegulWait = false;
+
   /* - Exit from deep-power-down mode */
   LL_ADC_DisableDeepPowerDown(ADCx);
 
@@ -263,24 +401,21 @@ static void R3_2_ADCxInit(ADC_TypeDef *ADCx)
   {
     /* Enable ADC internal voltage regulator */
     LL_ADC_EnableInternalRegulator(ADCx);
-
-    /* Wait for Regulator Startup time, once for both */
-    /* Note: Variable divided by 2 to compensate partially              */
-    /*       CPU processing cycles, scaling in us split to not          */
-    /*       exceed 32 bits register capacity and handle low frequency. */
-    volatile uint32_t wait_loop_index = ((LL_ADC_DELAY_INTERNAL_REGUL_STAB_US / 10UL)
-                                         * (SystemCoreClock / (100000UL * 2UL)));
-    while (wait_loop_index != 0UL)
-    {
-      wait_loop_index--;
-    }
+    RegulWait = true;
   }
   else
   {
     /* Nothing to do */
   }
+  return (RegulWait);
+}
 
-  LL_ADC_StartCalibration(ADCx, LL_ADC_SINGLE_ENDED);
+/**
+  * @brief  Enables an ADC at the end of the calibration started by R3_2_StartInit.
+  * @param  ADCx ADC to be enabled
+  */
+static void R3_2_ADCxInit(ADC_TypeDef *ADCx)
+{
   while (1U == LL_ADC_IsCalibrationOnGoing(ADCx))
   {
     /* Nothing to do */
@@ -304,6 +439,28 @@ static void R3_2_ADCxInit(ADC_TypeDef *ADCx)
   LL_ADC_REG_StartConversion(ADCx);
 }
 
+/**
+  * @brief  Configures the oversampler of the injected conversions of an ADC, that must be
+  *         disabled. Each trigger then converts Oversampling times the same channel and the
+  *         data register holds the sum, right aligned whatever the data alignment of the ADC.
+  *         The regular conversions are not oversampled.
+  * @param  ADCx ADC to be configured
+  * @param  Oversampling Number of conversions per current sample: 1 (disabled), 2 or 4
+  */
+static void R3_2_ADCxOversamplingInit(ADC_TypeDef *ADCx, uint8_t Oversampling)
+{
+  if (Oversampling > 1U)
+  {
+    LL_ADC_SetOverSamplingScope(ADCx, LL_ADC_OVS_GRP_INJECTED);
+    LL_ADC_ConfigOverSamplingRatioShift(ADCx, (Oversampling > 2U) ? LL_ADC_OVS_RATIO_4 : LL_ADC_OVS_RATIO_2,
+                                        LL_ADC_OVS_SHIFT_NONE);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
 /**
   * @brief  It initializes TIMx peripheral for PWM generation
   * @param TIMx: Timer to be initialized
@@ -329,6 +486,15 @@ static void R3_2_TIMxInit(TIM_TypeDef *TIMx, PWMC_Handle_t *pHdl)
   LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH3);
   /* Enables the TIMx Preload on CC4 Register */
   LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH4);
+#ifdef PWM_DOUBLE_UPDATE
+  /* OC5REF, inactive while the counter is below Tvalley, gates the three phases: their low
+     sides are on around the underflow, the sampling window of the second update */
+  LL_TIM_OC_SetMode(TIMx, LL_TIM_CHANNEL_CH5, LL_TIM_OCMODE_PWM2);
+  LL_TIM_OC_SetCompareCH5(TIMx, (uint32_t)pHandle->pParams_str->Tvalley);
+  LL_TIM_SetCH5CombinedChannels(TIMx, LL_TIM_GROUPCH5_OC1REFC | LL_TIM_GROUPCH5_OC2REFC
+                                      | LL_TIM_GROUPCH5_OC3REFC);
+  LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH5);
+#endif
   /* Prepare timer for synchronization */
   LL_TIM_GenerateEvent_UPDATE(TIMx);
   if (2U == pHandle->pParams_str->FreqRatio)
@@ -485,7 +651,7 @@ __weak void R3_2_CurrentReadingPolarization(PWMC_Handle_t *pHdl)
 
     /* IF CH4 is enabled, it means that JSQR is now configured to sample polarization current*/
     /*while ( LL_TIM_CC_IsEnabledChannel(TIMx, LL_TIM_CHANNEL_CH4) == 0u ) */
-    while (((TIMx->CR2) & TIM_CR2_MMS_Msk) != LL_TIM_TRGO_OC4REF)
+    while (((TIMx->CR2) & TIM_CR2_MMS_Msk) != R3_2_TRGO_SAMPLING)
     {
       /* Nothing to do */
     }
@@ -581,8 +747,8 @@ __weak void R3_2_GetPhaseCurrents(PWMC_Handle_t *pHdl, ab_t *Iab)
     uint8_t Sector;
 
     Sector = (uint8_t)pHandle->_Super.Sector;
-    ADCDataReg1 = *pHandle->pParams_str->ADCDataReg1[Sector];
-    ADCDataReg2 = *pHandle->pParams_str->ADCDataReg2[Sector];
+    ADCDataReg1 = *pHandle->pParams_str->ADCDataReg1[Sector] << pHandle->ADCDataShift;
+    ADCDataReg2 = *pHandle->pParams_str->ADCDataReg2[Sector] << pHandle->ADCDataShift;
 
     /* disable ADC trigger source */
     /* LL_TIM_CC_DisableChannel(TIMx, LL_TIM_CHANNEL_CH4) */
@@ -754,8 +920,8 @@ __weak void R3_2_GetPhaseCurrents_OVM(PWMC_Handle_t *pHdl, ab_t *Iab)
     LL_TIM_SetTriggerOutput(TIMx, LL_TIM_TRGO_RESET);
 
     Sector = (uint8_t)pHandle->_Super.Sector;
-    ADCDataReg1 = *pHandle->pParams_str->ADCDataReg1[Sector];
-    ADCDataReg2 = *pHandle->pParams_str->ADCDataReg2[Sector];
+    ADCDataReg1 = *pHandle->pParams_str->ADCDataReg1[Sector] << pHandle->ADCDataShift;
+    ADCDataReg2 = *pHandle->pParams_str->ADCDataReg2[Sector] << pHandle->ADCDataShift;
 
     switch (Sector)
     {
@@ -1103,7 +1269,8 @@ uint16_t R3_2_SetADCSampPointSectX(PWMC_Handle_t *pHdl)
     uint16_t DeltaDuty;
 
     /* Verify that sampling is possible in the middle of PWM by checking the smallest duty cycle */
-    if ((uint16_t)(pHandle->Half_PWMPeriod - pHdl->lowDuty) > pHandle->pParams_str->Tafter)
+    if ((false == pHdl->EdgeSampling)
+        && ((uint16_t)(pHandle->Half_PWMPeriod - pHdl->lowDuty) > pHdl->SampTiming.hTafter))
     {
       /* When it is possible to sample in the middle of the PWM period, always sample the same phases
        * (AB are chosen) for all sectors in order to not induce current discontinuities when there are differences
@@ -1130,18 +1297,11 @@ uint16_t R3_2_SetADCSampPointSectX(PWMC_Handle_t *pHdl)
       /* Definition of crossing point */
       if (DeltaDuty > ((uint16_t)(pHandle->Half_PWMPeriod - pHdl->lowDuty) * 2U))
       {
-        SamplingPoint = pHdl->lowDuty - pHandle->pParams_str->Tbefore;
+        SamplingPoint = pHdl->lowDuty - pHdl->SampTiming.hTbefore;
       }
       else
       {
-        SamplingPoint = pHdl->lowDuty + pHandle->pParams_str->Tafter;
-
-        if (SamplingPoint >= pHandle->Half_PWMPeriod)
-        {
-          /* ADC trigger edge must be changed from positive to negative */
-          pHandle->ADC_ExternalPolarityInjected = (uint16_t)LL_ADC_INJ_TRIG_EXT_FALLING;
-          SamplingPoint = (2U * pHandle->Half_PWMPeriod) - SamplingPoint - (uint16_t)1;
-        }
+        SamplingPoint = R3_2_SamplingPointAfter(pHandle);
       }
     }
     returnValue = R3_2_WriteTIMRegisters(&pHandle->_Super, SamplingPoint);
@@ -1183,7 +1343,8 @@ uint16_t R3_2_SetADCSampPointSectX_OVM(PWMC_Handle_t *pHdl)
     DeltaDuty = (uint16_t)(pHdl->lowDuty - pHdl->midDuty);
 
     /* case 1 (cf user manual) */
-    if ((uint16_t)(pHandle->Half_PWMPeriod - pHdl->lowDuty) > pHandle->pParams_str->Tafter)
+    if ((false == pHdl->EdgeSampling)
+        && ((uint16_t)(pHandle->Half_PWMPeriod - pHdl->lowDuty) > pHdl->SampTiming.hTafter))
     {
       /* When it is possible to sample in the middle of the PWM period, always sample the same phases
        * (AB are chosen) for all sectors in order to not induce current discontinuities when there are differences
@@ -1196,11 +1357,16 @@ uint16_t R3_2_SetADCSampPointSectX_OVM(PWMC_Handle_t *pHdl)
       /* set sampling  point trigger in the middle of PWM period */
       SamplingPoint =  pHandle->Half_PWMPeriod - (uint16_t) 1;
     }
+    else if (true == pHdl->EdgeSampling)
+    {
+      /* Calibration of the timing: as out of the overmodulation */
+      SamplingPoint = R3_2_SamplingPointAfter(pHandle);
+    }
     else /* case 2 (cf user manual) */
     {
       if (DeltaDuty >= pHandle->pParams_str->Tcase2)
       {
-        SamplingPoint = pHdl->lowDuty - pHandle->pParams_str->Tbefore;
+        SamplingPoint = pHdl->lowDuty - pHdl->SampTiming.hTbefore;
       }
       else
       {
@@ -1223,6 +1389,150 @@ uint16_t R3_2_SetADCSampPointSectX_OVM(PWMC_Handle_t *pHdl)
   return (retVal);
 }
 
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Configure the ADC for the current sampling of a switching state applied by
+  *         PWMC_SetSwitchingState().
+  *         The sector, that gives the phases to sample, has already been set from the state.
+  *         All the low sides are on in the middle of the PWM period, that is long enough for
+  *         the sampling, so that no duty cycle comparison is needed.
+  *         And call the WriteTIMRegisters method.
+  * @param  pHandle Pointer on the target component instance
+  * @retval none
+  */
+uint16_t R3_2_SetADCSampPointState(PWMC_Handle_t *pHdl)
+{
+  uint16_t retVal;
+
+  if (MC_NULL == pHdl)
+  {
+    retVal = 0U;
+  }
+  else
+  {
+    PWMC_R3_2_Handle_t *pHandle = (PWMC_R3_2_Handle_t *)pHdl;    //cstat !MISRAC2012-Rule-11.3
+
+    /* set sampling  point trigger in the middle of PWM period */
+    retVal = R3_2_WriteTIMRegisters(&pHandle->_Super, (pHandle->Half_PWMPeriod - (uint16_t)1));
+  }
+  return (retVal);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Returns the sampling point hTafter after the edge of the phase with the largest
+  *         compare value, on the falling edge of the trigger past the middle of the period.
+  * @param  pHandle Pointer on the target component instance
+  */
+__STATIC_INLINE uint16_t R3_2_SamplingPointAfter(PWMC_R3_2_Handle_t *pHandle)
+{
+  uint16_t SamplingPoint = pHandle->_Super.lowDuty + pHandle->_Super.SampTiming.hTafter;
+
+  if (SamplingPoint >= pHandle->Half_PWMPeriod)
+  {
+    /* ADC trigger edge must be changed from positive to negative */
+    pHandle->ADC_ExternalPolarityInjected = (uint16_t)LL_ADC_INJ_TRIG_EXT_FALLING;
+    SamplingPoint = (2U * pHandle->Half_PWMPeriod) - SamplingPoint - (uint16_t)1;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (SamplingPoint);
+}
+
+/**
+  * @brief  Returns the channel of the first conversion of an injected sequence
+  * @param  ADCConfig JSQR value of the sequence
+  */
+static uint32_t R3_2_ADCxChannel(uint32_t ADCConfig)
+{
+  return (__LL_ADC_DECIMAL_NB_TO_CHANNEL((ADCConfig & ADC_JSQR_JSQ1) >> ADC_JSQR_JSQ1_Pos));
+}
+
+/**
+  * @brief  Sets the timing of the current sampling, see PWMC_SetSamplingTiming(). The
+  *         sampling time is that of the channels of the sequences of both ADCs. The
+  *         injected conversions are stopped while it is changed, and started again if
+  *         they were started: to be called with the PWM switched off, or by the high
+  *         frequency task once the currents are read, before the next trigger.
+  * @param  pHdl Pointer on the target component instance
+  * @param  pTiming Timing of the sampling
+  * @retval bool False if a delay does not fit in half of the period, the timing being
+  *         then not changed
+  */
+bool R3_2_SetSamplingTiming(PWMC_Handle_t *pHdl, const PWMC_SampTiming_t *pTiming)
+{
+  PWMC_R3_2_Handle_t *pHandle = (PWMC_R3_2_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+  bool retVal = false;
+
+  if ((pTiming->hTafter < pHandle->Half_PWMPeriod) && (pTiming->hTbefore < pHandle->Half_PWMPeriod)
+      && ((uint32_t)pTiming->bSampleTime <= (uint32_t)LL_ADC_SAMPLINGTIME_640CYCLES_5))
+  {
+    ADC_TypeDef *ADCs[2] = {pHandle->pParams_str->ADCx_1, pHandle->pParams_str->ADCx_2};
+    const uint32_t *pConfigs[2] = {pHandle->pParams_str->ADCConfig1, pHandle->pParams_str->ADCConfig2};
+    uint8_t bADC;
+    uint8_t bSector;
+
+    for (bADC = 0U; bADC < 2U; bADC++)
+    {
+      ADC_TypeDef *ADCx = ADCs[bADC];
+      uint32_t wStarted = LL_ADC_INJ_IsConversionOngoing(ADCx);
+
+      /* The SMPR registers are written without any conversion ongoing */
+      if (wStarted != 0U)
+      {
+        LL_ADC_INJ_StopConversion(ADCx);
+        while (LL_ADC_INJ_IsStopConversionOngoing(ADCx) != 0U)
+        {
+          /* Nothing to do */
+        }
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      while (LL_ADC_REG_IsConversionOngoing(ADCx) != 0U)
+      {
+        /* Nothing to do, the regular conversion of the task ends */
+      }
+      for (bSector = SECTOR_1; bSector <= SECTOR_6; bSector++)
+      {
+        LL_ADC_SetChannelSamplingTime(ADCx, R3_2_ADCxChannel(pConfigs[bADC][bSector]),
+                                      (uint32_t)pTiming->bSampleTime);
+      }
+      if (wStarted != 0U)
+      {
+        LL_ADC_INJ_StartConversion(ADCx);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    pHdl->SampTiming = *pTiming;
+    pHdl->SampTiming.bReserved = 0U;
+    retVal = true;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (retVal);
+}
+
 #if defined (CCMRAM)
 #if defined (__ICCARM__)
 #pragma location = ".ccmram"
@@ -1244,6 +1554,36 @@ __STATIC_INLINE uint16_t R3_2_WriteTIMRegisters(PWMC_Handle_t *pHdl, uint16_t Sa
   uint16_t Aux;
 
 
+#ifdef PWM_DOUBLE_UPDATE
+  uint16_t hValley = pHandle->pParams_str->Tvalley;
+  uint16_t hMaxCnt = pHandle->Half_PWMPeriod - hValley;
+  uint8_t bUpdates;
+
+  /* The high sides are gated off below Tvalley: the compare values are shifted by it, and
+     clamped to keep the window of the overflow */
+  LL_TIM_OC_SetCompareCH1(TIMx, (uint32_t)((pHandle->_Super.CntPhA < (hMaxCnt - hValley))
+                                           ? (pHandle->_Super.CntPhA + hValley) : hMaxCnt));
+  LL_TIM_OC_SetCompareCH2(TIMx, (uint32_t)((pHandle->_Super.CntPhB < (hMaxCnt - hValley))
+                                           ? (pHandle->_Super.CntPhB + hValley) : hMaxCnt));
+  LL_TIM_OC_SetCompareCH3(TIMx, (uint32_t)((pHandle->_Super.CntPhC < (hMaxCnt - hValley))
+                                           ? (pHandle->_Super.CntPhC + hValley) : hMaxCnt));
+  LL_TIM_OC_SetCompareCH4(TIMx, (uint32_t) SamplingPoint);
+
+  /* The sampling is armed for the next update. The update of the current sample must be the
+     only one since the last arming: none if the interrupt armed it during the task, more if
+     updates were missed */
+  R3_2_ArmSampling(pHandle);
+  bUpdates = pHandle->UpdateCount;
+  if ((uint8_t)(bUpdates - pHandle->ArmedUpdateCount) != 1U)
+  {
+    Aux = MC_FOC_DURATION;
+  }
+  else
+  {
+    Aux = MC_NO_ERROR;
+  }
+  pHandle->ArmedUpdateCount = bUpdates;
+#else
   LL_TIM_OC_SetCompareCH1(TIMx, (uint32_t) pHandle->_Super.CntPhA);
   LL_TIM_OC_SetCompareCH2(TIMx, (uint32_t) pHandle->_Super.CntPhB);
   LL_TIM_OC_SetCompareCH3(TIMx, (uint32_t) pHandle->_Super.CntPhC);
@@ -1260,6 +1600,7 @@ __STATIC_INLINE uint16_t R3_2_WriteTIMRegisters(PWMC_Handle_t *pHdl, uint16_t Sa
   {
     Aux = MC_NO_ERROR;
   }
+#endif
   return Aux;
 }
 /**
@@ -1281,8 +1622,8 @@ static void R3_2_HFCurrentsPolarizationAB(PWMC_Handle_t *pHdl, ab_t *Iab)
   {
     PWMC_R3_2_Handle_t *pHandle = (PWMC_R3_2_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
     TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
-    uint32_t ADCDataReg1 = *pHandle->pParams_str->ADCDataReg1[pHandle->PolarizationSector];
-    uint32_t ADCDataReg2 = *pHandle->pParams_str->ADCDataReg2[pHandle->PolarizationSector];
+    uint32_t ADCDataReg1 = *pHandle->pParams_str->ADCDataReg1[pHandle->PolarizationSector] << pHandle->ADCDataShift;
+    uint32_t ADCDataReg2 = *pHandle->pParams_str->ADCDataReg2[pHandle->PolarizationSector] << pHandle->ADCDataShift;
 
     /* disable ADC trigger source */
     /* LL_TIM_CC_DisableChannel(TIMx, LL_TIM_CHANNEL_CH4) */
@@ -1324,7 +1665,7 @@ static void R3_2_HFCurrentsPolarizationC(PWMC_Handle_t *pHdl, ab_t *Iab)
   {
     PWMC_R3_2_Handle_t *pHandle = (PWMC_R3_2_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
     TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
-    uint32_t ADCDataReg2 = *pHandle->pParams_str->ADCDataReg2[pHandle->PolarizationSector];
+    uint32_t ADCDataReg2 = *pHandle->pParams_str->ADCDataReg2[pHandle->PolarizationSector] << pHandle->ADCDataShift;
 
     /* disable ADC trigger source */
     /* LL_TIM_CC_DisableChannel(TIMx, LL_TIM_CHANNEL_CH4) */
@@ -1520,55 +1861,93 @@ __weak void *R3_2_TIMx_UP_IRQHandler(PWMC_R3_2_Handle_t *pHandle)
   }
   else
   {
+#ifdef PWM_DOUBLE_UPDATE
     TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
-    ADC_TypeDef *ADCx_1 = pHandle->pParams_str->ADCx_1;
-    ADC_TypeDef *ADCx_2 = pHandle->pParams_str->ADCx_2;
-    R3_3_OPAMPParams_t *OPAMPParams = pHandle->pParams_str->OPAMPParams;
-    OPAMP_TypeDef *operationAmp;
-    uint32_t OpampConfig;
 
-    if (OPAMPParams != NULL)
+    /* The high frequency task arms the sampling of the next update: it is armed here only
+       when no task did, at the start of the PWM or after a task that set no compare values */
+    pHandle->UpdateCount++;
+    if (((TIMx->CR2) & TIM_CR2_MMS_Msk) == LL_TIM_TRGO_RESET)
     {
-      /* We can not change OPAMP source if ADC acquisition is ongoing (Dual motor with internal opamp use case)*/
-      while (ADCx_1->JSQR != 0x0u)
-      {
-        /* Nothing to do */
-      }
-      /* We need to manage the Operational amplifier internal output enable - Dedicated to G4 and the VPSEL selection */
-      operationAmp = OPAMPParams->OPAMPSelect_1[pHandle->_Super.Sector];
-      if (operationAmp != NULL)
-      {
-        OpampConfig = OPAMPParams->OPAMPConfig1[pHandle->_Super.Sector];
-        MODIFY_REG(operationAmp->CSR, (OPAMP_CSR_OPAMPINTEN | OPAMP_CSR_VPSEL), OpampConfig);
-      }
-      else
-      {
-        /* Nothing to do */
-      }
-      operationAmp = OPAMPParams->OPAMPSelect_2[pHandle->_Super.Sector];
-      if (operationAmp != NULL)
-      {
-        OpampConfig = OPAMPParams->OPAMPConfig2[pHandle->_Super.Sector];
-        MODIFY_REG(operationAmp->CSR, (OPAMP_CSR_OPAMPINTEN | OPAMP_CSR_VPSEL), OpampConfig);
-      }
-      else
-      {
-        /* Nothing to do */
-      }
+      R3_2_ArmSampling(pHandle);
+      pHandle->ArmedUpdateCount = pHandle->UpdateCount;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#else
+    R3_2_ArmSampling(pHandle);
+#endif
+    tempPointer = &(pHandle->_Super.Motor);
+  }
+  return (tempPointer);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Arms the injected conversions of both ADCs on the sector of the handle, and the
+  *         trigger output of TIMx that starts them.
+  * @param  pHandle: handler of the current instance of the PWM component
+  */
+__STATIC_INLINE void R3_2_ArmSampling(PWMC_R3_2_Handle_t *pHandle)
+{
+  TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+  ADC_TypeDef *ADCx_1 = pHandle->pParams_str->ADCx_1;
+  ADC_TypeDef *ADCx_2 = pHandle->pParams_str->ADCx_2;
+  R3_3_OPAMPParams_t *OPAMPParams = pHandle->pParams_str->OPAMPParams;
+  OPAMP_TypeDef *operationAmp;
+  uint32_t OpampConfig;
+
+  if (OPAMPParams != NULL)
+  {
+    /* We can not change OPAMP source if ADC acquisition is ongoing (Dual motor with internal opamp use case)*/
+    while (ADCx_1->JSQR != 0x0u)
+    {
+      /* Nothing to do */
+    }
+    /* We need to manage the Operational amplifier internal output enable - Dedicated to G4 and the VPSEL selection */
+    operationAmp = OPAMPParams->OPAMPSelect_1[pHandle->_Super.Sector];
+    if (operationAmp != NULL)
+    {
+      OpampConfig = OPAMPParams->OPAMPConfig1[pHandle->_Super.Sector];
+      MODIFY_REG(operationAmp->CSR, (OPAMP_CSR_OPAMPINTEN | OPAMP_CSR_VPSEL), OpampConfig);
     }
+    else
+    {
+      /* Nothing to do */
+    }
+    operationAmp = OPAMPParams->OPAMPSelect_2[pHandle->_Super.Sector];
+    if (operationAmp != NULL)
+    {
+      OpampConfig = OPAMPParams->OPAMPConfig2[pHandle->_Super.Sector];
+      MODIFY_REG(operationAmp->CSR, (OPAMP_CSR_OPAMPINTEN | OPAMP_CSR_VPSEL), OpampConfig);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
 
-    ADCx_1->JSQR = pHandle->pParams_str->ADCConfig1[pHandle->_Super.Sector] | (uint32_t) pHandle->ADC_ExternalPolarityInjected;
-    ADCx_2->JSQR = pHandle->pParams_str->ADCConfig2[pHandle->_Super.Sector] | (uint32_t) pHandle->ADC_ExternalPolarityInjected;
+#ifdef PWM_DOUBLE_UPDATE
+  /* The update event is a pulse: its rising edge is the centre of the window */
+  pHandle->ADC_ExternalPolarityInjected = (uint16_t)LL_ADC_INJ_TRIG_EXT_RISING;
+#endif
+  ADCx_1->JSQR = pHandle->pParams_str->ADCConfig1[pHandle->_Super.Sector] | (uint32_t) pHandle->ADC_ExternalPolarityInjected;
+  ADCx_2->JSQR = pHandle->pParams_str->ADCConfig2[pHandle->_Super.Sector] | (uint32_t) pHandle->ADC_ExternalPolarityInjected;
 
-    /* enable ADC trigger source */
+  /* enable ADC trigger source */
 
-    /* LL_TIM_CC_EnableChannel(TIMx, LL_TIM_CHANNEL_CH4) */
-    LL_TIM_SetTriggerOutput(TIMx, LL_TIM_TRGO_OC4REF);
+  /* LL_TIM_CC_EnableChannel(TIMx, LL_TIM_CHANNEL_CH4) */
+  LL_TIM_SetTriggerOutput(TIMx, R3_2_TRGO_SAMPLING);
 
-    pHandle->ADC_ExternalPolarityInjected = (uint16_t)LL_ADC_INJ_TRIG_EXT_RISING;
-    tempPointer = &(pHandle->_Super.Motor);
-  }
-  return (tempPointer);
+  pHandle->ADC_ExternalPolarityInjected = (uint16_t)LL_ADC_INJ_TRIG_EXT_RISING;
 }
 
 #if defined (CCMRAM)
@@ -1944,7 +2323,7 @@ static void R3_2_RLGetPhaseCurrents(PWMC_Handle_t *pHdl, ab_t *pStator_Currents)
     /* disable ADC trigger source */
     LL_TIM_SetTriggerOutput(TIMx, LL_TIM_TRGO_RESET);
 
-    wAux = ((int32_t)pHandle->PhaseBOffset) - ((int32_t)*pHandle->pParams_str->ADCDataReg2[pHandle->_Super.Sector]);
+    wAux = ((int32_t)pHandle->PhaseBOffset) - ((int32_t)(*pHandle->pParams_str->ADCDataReg2[pHandle->_Super.Sector] << pHandle->ADCDataShift));
 
     /* Check saturation */
     if (wAux > -INT16_MAX)
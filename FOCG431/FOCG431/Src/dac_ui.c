@@ -89,9 +89,11 @@ __weak void DAC_Exec(DAC_Handle_t *pHandle)
   {
 #endif
     uint32_t temp1;
-    temp1 = DACOFF + (uint32_t)*((uint16_t*) pHandle->ptrDataCh[DAC_CH1]); //cstat !MISRAC2012-Rule-11.3
-    LL_DAC_ConvertData12LeftAligned(DAC1, LL_DAC_CHANNEL_1, temp1);
-    LL_DAC_TrigSWConversion(DAC1, LL_DAC_CHANNEL_1);
+    temp1 = DACOFF + (uint32_t)*pHandle->ptrDataCh[DAC_CH1];
+    /* The plain writes avoid the read back of the registers, slow on the peripheral
+       bus, done by the LL functions */
+    WRITE_REG(DAC1->DHR12L1, temp1 & DAC_DHR12L1_DACC1DHR);
+    WRITE_REG(DAC1->SWTRIGR, DAC_SWTRIGR_SWTRIG1);
 #ifdef NULL_PTR_DAC_UI
   }
 #endif
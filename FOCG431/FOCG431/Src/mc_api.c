@@ -21,6 +21,12 @@
 #include "mc_interface.h"
 #include "mc_api.h"
 #include "mc_config.h"
+#ifdef MC_PROFILE_MODE
+#include "mc_profile.h"
+#endif
+#ifdef MC_PWMFREQ_MODE
+#include "mc_pwmfreq.h"
+#endif
 
 /** @addtogroup MCSDK
   * @{
@@ -284,6 +290,97 @@ __weak void MC_SetCurrentReferenceMotor1_F( qd_f_t IqdRef )
 	MCI_SetCurrentReferences_F( pMCI[M1], IqdRef );
 }
 
+#ifdef M1_POSITION_CTRL
+/**
+  * @brief Programs a position command for Motor 1 for later or immediate execution.
+  *
+  *  A position command moves the rotor from its current angle to the @p FinalPosition
+  * mechanical angle along a jerk limited trajectory that lasts @p hDurationms. The
+  * trajectory and the position regulation are run at #POSITION_LOOP_FREQUENCY_HZ.
+  *
+  *  Invoking the MC_ProgramPositionCommandMotor1() function programs a new movement
+  * with the provided parameters. The programmed movement is executed immediately if
+  * Motor 1's state machine is in the #RUN state and the previous movement has
+  * completed. Otherwise, the command is buffered and will be executed when the state
+  * machine reaches the #RUN state, or executed unsuccessfully if a movement is still on
+  * going, which MC_GetControlPositionStatusMotor1() tells.
+  *
+  *  The Application can check the status of the command with the MC_GetCommandStateMotor1()
+  * to know whether the last command was executed immediately or not.
+  *
+  * @param  FinalPosition Mechanical angle at the end of the movement, in rad, counted
+  *         from the encoder position at the boot.
+  * @param  hDurationms Duration of the movement expressed in milliseconds, rounded down
+  *         to a multiple of 9 periods of the position loop.
+  */
+__weak void MC_ProgramPositionCommandMotor1( float FinalPosition, uint16_t hDurationms )
+{
+	MCI_ExecPositionCommand( pMCI[M1], FinalPosition, hDurationms );
+}
+
+/**
+  * @brief Returns the mechanical angle of the rotor of Motor 1, in rad, counted from the
+  *        encoder position at the boot
+  */
+__weak float MC_GetCurrentPositionMotor1( void )
+{
+	return MCI_GetCurrentPosition( pMCI[M1] );
+}
+
+/**
+  * @brief Returns the status of the movement of the last position command of Motor 1
+  */
+__weak PosCtrlStatus_t MC_GetControlPositionStatusMotor1( void )
+{
+	return MCI_GetPositionCtrlStatus( pMCI[M1] );
+}
+#endif
+
+#ifdef MCI_SETPOINT_STREAM
+/**
+  * @brief Hands the current references of Motor 1 over to the setpoint stream, for later
+  *        or immediate execution.
+  *
+  *  Once the command is executed, in the #START_RUN or #RUN states, the high frequency task
+  * interpolates the current references between the setpoints queued by
+  * MC_PushSetpointMotor1(), every FOC period of the #RUN state. The setpoints queued
+  * before the call are discarded. Any other command programmed afterwards ends the stream.
+  *
+  *  The Application can check the status of the command with the MC_GetCommandStateMotor1()
+  * to know whether the last command was executed immediately or not.
+  */
+__weak void MC_StartSetpointStreamMotor1( void )
+{
+	MCI_StartStream( pMCI[M1] );
+}
+
+/**
+  * @brief Queues a setpoint of the stream of Motor 1.
+  *
+  *  The current references go linearly from the last reached setpoint to this one, reached
+  * at @p hTime. The times of the successive setpoints must increase, by less than 32768
+  * FOC periods. All the calls must be made from the same context, of a lower priority than
+  * the high frequency task.
+  *
+  * @param  hTime Time of the setpoint, on the clock of MC_GetStreamClockMotor1().
+  * @param  Iqdref current references of the setpoint, in the qd_t format.
+  * @retval false if the FIFO of #MCI_STREAM_DEPTH setpoints is full, the setpoint being lost.
+  */
+__weak bool MC_PushSetpointMotor1( uint16_t hTime, qd_t Iqdref )
+{
+	return MCI_PushSetpoint( pMCI[M1], hTime, Iqdref );
+}
+
+/**
+  * @brief Returns the clock of the setpoint stream of Motor 1, counted in FOC periods by the
+  *        high frequency task, modulo 65536
+  */
+__weak uint16_t MC_GetStreamClockMotor1( void )
+{
+	return MCI_GetStreamClock( pMCI[M1] );
+}
+#endif
+
 /**
   * @brief  Returns the status of the last buffered command for Motor 1.
   * The status can be one of the following values:
@@ -679,6 +776,98 @@ bool MC_StartPolarizationOffsetsMeasurementMotor1( void )
 	return( MCI_StartOffsetMeasurments( pMCI[M1] ) );
 }
 
+#ifdef MC_COMMISSION_MODE
+/**
+ * @brief Starts the identification of the model of the predictive current controller of Motor 1
+ *
+ * If the Motor Control Firmware is in the #IDLE state, the current offsets are measured if they
+ * are not known yet, then the model is identified at standstill and in open loop rotation, in the
+ * #COMMISSIONING state, and true is returned. Otherwise, nothing is done and false is returned.
+ *
+ * The model becomes the model of the predictor and is stored in flash, see mc_commission.h. The
+ * identification has not completed when this function returns: the application can use the
+ * MC_Commission_GetPhase() function to query its state.
+ */
+bool MC_StartCommissioningMotor1( void )
+{
+	return( MCI_StartCommissioning( pMCI[M1] ) );
+}
+#endif
+
+#ifdef MC_DTCALIB_MODE
+/**
+ * @brief Starts the calibration of the dead time compensation of Motor 1
+ *
+ * If the Motor Control Firmware is in the #IDLE state, the current offsets are measured if they
+ * are not known yet, then the voltage error of each phase is measured at standstill, in the
+ * #DT_CALIBRATING state, and true is returned. Otherwise, nothing is done and false is returned.
+ *
+ * The errors become the dead time compensation of the space vector modulation, see
+ * mc_dtcalib.h. The calibration has not completed when this function returns: the application
+ * can use the MC_DTCalib_GetPhase() function to query its state.
+ */
+bool MC_StartDeadTimeCalibrationMotor1( void )
+{
+	return( MCI_StartDeadTimeCalibration( pMCI[M1] ) );
+}
+#endif
+
+#ifdef MC_ADCCALIB_MODE
+/**
+ * @brief Starts the tuning of the timing of the current sampling of Motor 1
+ *
+ * If the Motor Control Firmware is in the #IDLE state, the current offsets are measured if they
+ * are not known yet, then the noise of the currents is measured at standstill for each sampling
+ * time and trigger delay, in the #ADC_CALIBRATING state, and true is returned. Otherwise, nothing
+ * is done and false is returned.
+ *
+ * The shortest timing that does not add noise replaces the one of the configuration, see
+ * mc_adccalib.h. The tuning has not completed when this function returns: the application
+ * can use the MC_ADCCalib_GetPhase() function to query its state.
+ */
+bool MC_StartAdcCalibrationMotor1( void )
+{
+	return( MCI_StartAdcCalibration( pMCI[M1] ) );
+}
+#endif
+
+#ifdef MC_PROFILE_MODE
+/**
+ * @brief Applies a profile of parameters stored in flash to Motor 1
+ *
+ * If the Motor Control Firmware is in the #IDLE state and the profile is stored, the profile
+ * is applied by the next medium frequency task, kept for the next boots, and true is returned.
+ * Otherwise, nothing is done and false is returned. See mc_profile.h.
+ */
+bool MC_SelectProfileMotor1( uint8_t bProfile )
+{
+	return( MC_Profile_IsStored( bProfile ) && MCI_SelectProfile( pMCI[M1], bProfile ) );
+}
+#endif
+
+#ifdef MC_PWMFREQ_MODE
+/**
+ * @brief Changes the PWM frequency of Motor 1, in Hz
+ *
+ * If the Motor Control Firmware is in the #IDLE state and the frequency is accepted, the
+ * frequency is applied by the next medium frequency task, with the constants derived from
+ * it, and true is returned. Otherwise, nothing is done and false is returned. See
+ * mc_pwmfreq.h.
+ */
+bool MC_SetPwmFrequencyMotor1( uint32_t wFrequency )
+{
+	return( MC_PwmFreq_Check( wFrequency ) && MCI_SetPwmFrequency( pMCI[M1], wFrequency ) );
+}
+
+/**
+ * @brief Returns the PWM frequency of Motor 1, in Hz
+ */
+uint32_t MC_GetPwmFrequencyMotor1( void )
+{
+	return( MC_PwmFreq_Get() );
+}
+#endif
+
 /**
  * @brief This method is used to get the average measured motor power
  *        expressed in watt for Motor 1. Average is done over the last
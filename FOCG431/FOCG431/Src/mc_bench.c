@@ -0,0 +1,472 @@
+/**
+  ******************************************************************************
+  * @file    mc_bench.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Execution time benchmark of the motor control math kernels
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "mc_math.h"
+#include "mc_config.h"
+#include "parameters_conversion.h"
+#include "mc_plant.h"
+#include "mc_bench.h"
+
+#ifdef MC_BENCH_MODE
+
+/* Times one call of a kernel with the interrupts masked, in CPU cycles. In the cold run
+   the instruction and data caches of the flash are reset first, as when the main loop has
+   evicted the high frequency task from them. */
+#define MC_BENCH_MEASURE(kernel, statement)               \
+  do {                                                    \
+    uint32_t StartMeasure;                                \
+    uint32_t DeltaTimeInCycle;                            \
+    __disable_irq();                                      \
+    if (true == BenchCold)                                \
+    {                                                     \
+      MC_Bench_ResetCaches();                             \
+    }                                                     \
+    StartMeasure = DWT->CYCCNT;                           \
+    statement;                                            \
+    DeltaTimeInCycle = DWT->CYCCNT - StartMeasure;        \
+    __enable_irq();                                       \
+    MC_Bench_Record((kernel), DeltaTimeInCycle);          \
+  } while (0)
+
+MC_Bench_Result_t MC_BenchResults[MC_BENCH_NB_KERNELS];
+MC_Bench_Ripple_t MC_BenchRipple[MC_BENCH_NB_INPUTS];
+MC_Bench_Scenario_t MC_BenchScenarios[MC_BENCH_NB_CONTROLLERS][MC_BENCH_NB_SCENARIOS];
+
+/* Working copies, so that the benchmark does not alter the state of the drive */
+static PID_Handle_t BenchPID;
+static PID_Handle_t BenchPIDd;
+static STO_PLL_Handle_t BenchSTO;
+static STO_CR_Handle_t BenchSTOCR;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+static PCC_Handle_t BenchPCC;
+#endif
+
+/* Cost of the measurement itself, removed from every result */
+static uint32_t BenchOverhead;
+
+/* First run of the kernels, recorded in the cold field of their results */
+static bool BenchCold;
+
+/* Outputs of the kernels, kept so that the calls are not optimised out */
+static volatile int32_t BenchSink;
+static Trig_Components BenchTrig[MC_BENCH_NB_INPUTS];
+
+/* Fixed input vectors: phase currents, electrical angles and voltages in s16 digits */
+static const ab_t BenchIab[MC_BENCH_NB_INPUTS] =
+{
+  {0, 0}, {3000, -1500}, {-12000, 6000}, {20000, 12000},
+  {-32768, 16384}, {32767, 32767}, {-25000, -25000}, {1234, -4321}
+};
+
+static const int16_t BenchAngle[MC_BENCH_NB_INPUTS] =
+{
+  0, 5461, 10923, 16384, -32768, -21845, -10923, 30000
+};
+
+static const qd_t BenchVqd[MC_BENCH_NB_INPUTS] =
+{
+  {0, 0}, {8000, -2000}, {-16000, 4000}, {25000, 20000},
+  {-32767, 0}, {32767, 32767}, {3000, -30000}, {-12000, -12000}
+};
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+static const int16_t BenchSpeedDpp[MC_BENCH_NB_INPUTS] =
+{
+  0, 20, 45, 80, 120, -30, -90, 150
+};
+
+/* References of the closed loop runs, q and d currents in s16A digits */
+static const qd_t BenchIqdref[MC_BENCH_NB_INPUTS] =
+{
+  {0, 0}, {2000, 0}, {4000, -1000}, {8000, -4000},
+  {-2000, 0}, {-6000, -2000}, {12000, -8000}, {1000, 1000}
+};
+#endif
+
+/* Operating points of the scenarios, before and after their step */
+typedef struct {
+    int16_t  hIqrefBefore;          /* Percent of NOMINAL_CURRENT, the d reference is zero */
+    int16_t  hIqrefAfter;
+    int16_t  hSpeedBefore;          /* dpp */
+    int16_t  hSpeedAfter;
+    float_t  fBusAfter;             /* Bus voltage after the step, per unit of the nominal one */
+    float_t  fRsScale;              /* Plant parameters, per unit of the ones of the drive */
+    float_t  fLsScale;
+} MC_Bench_Step_t;
+
+static const MC_Bench_Step_t BenchSteps[MC_BENCH_NB_SCENARIOS] =
+{
+  {40, 40, 20, 80, 1.0f, 1.0f, 1.0f},
+  {10, 60, 45, 45, 1.0f, 1.0f, 1.0f},
+  {40, 40, 45, 45, 0.7f, 1.0f, 1.0f},
+  {10, 60, 45, 45, 1.0f, 1.5f, 0.7f}
+};
+
+/* The references stay below the current barrier of the predictive controller, NOMINAL_CURRENT */
+#define MC_BENCH_IQREF(pc)  ((int16_t)(((int32_t)(pc) * (int32_t)NOMINAL_CURRENT) / 100))
+
+/* Resets the instruction and data caches of the flash accelerator: the reset only acts on
+   a disabled cache, the enable bits are then restored */
+static void MC_Bench_ResetCaches(void)
+{
+  uint32_t wAcr = FLASH->ACR;
+
+  __HAL_FLASH_INSTRUCTION_CACHE_DISABLE();
+  __HAL_FLASH_DATA_CACHE_DISABLE();
+  __HAL_FLASH_INSTRUCTION_CACHE_RESET();
+  __HAL_FLASH_DATA_CACHE_RESET();
+  FLASH->ACR = wAcr;
+}
+
+static void MC_Bench_Record(uint8_t bKernel, uint32_t wCycles)
+{
+  MC_Bench_Result_t *pResult = &MC_BenchResults[bKernel];
+  uint32_t wNet = (wCycles > BenchOverhead) ? (wCycles - BenchOverhead) : 0U;
+
+  if (true == BenchCold)
+  {
+    if (pResult->cold < wNet) { pResult->cold = wNet; }
+  }
+  else
+  {
+    if (pResult->max < wNet) { pResult->max = wNet; }
+    if (pResult->min > wNet) { pResult->min = wNet; }
+  }
+}
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+/* Runs BenchPCC in closed loop on its own model and stores the squared tracking error
+   in MC_BenchRipple. The measured current of each period is the current predicted by the
+   previous call, so that the result only depends on the cost and the search. */
+static void MC_Bench_Ripple(void)
+{
+  uint8_t i;
+  uint16_t hPeriod;
+
+  for (i = 0; i < MC_BENCH_NB_INPUTS; i++)
+  {
+    qd_t Iqd = {0, 0};
+    qd_t Vqd = {0, 0};
+    int16_t hAngle = BenchAngle[i];
+    uint64_t lSum = 0U;
+    uint32_t wMax = 0U;
+
+    BenchPCC = PCC_M1;
+    PCC_Clear(&BenchPCC);
+    for (hPeriod = 0U; hPeriod < (MC_BENCH_RIPPLE_WARMUP + MC_BENCH_RIPPLE_PERIODS); hPeriod++)
+    {
+      int32_t wErrQ = (int32_t)BenchIqdref[i].q - Iqd.q;
+      int32_t wErrD = (int32_t)BenchIqdref[i].d - Iqd.d;
+      uint32_t wSqError = (uint32_t)(wErrQ * wErrQ) + (uint32_t)(wErrD * wErrD);
+
+      if (hPeriod >= MC_BENCH_RIPPLE_WARMUP)
+      {
+        lSum += wSqError;
+        wMax = (wSqError > wMax) ? wSqError : wMax;
+      }
+      Vqd = PCC_CalcVoltage(&BenchPCC, Iqd, BenchIqdref[i], Vqd, MCM_Trig_Functions(hAngle), BenchSpeedDpp[i]);
+      Iqd = BenchPCC.IqdNext;
+      hAngle = (int16_t)(hAngle + BenchSpeedDpp[i]);
+    }
+    MC_BenchRipple[i].mean = (uint32_t)(lSum / MC_BENCH_RIPPLE_PERIODS);
+    MC_BenchRipple[i].max = wMax;
+  }
+}
+#endif
+
+/* One period of the controller under test, from the currents sampled at its start
+   and the voltage applied during it, as in FOC_CurrControllerM1 */
+static qd_t MC_Bench_Control(uint8_t bController, qd_t Iqd, qd_t Iqdref, qd_t Vqd, int16_t hAngle,
+                             int16_t hSpeedDpp)
+{
+  qd_t VqdNext = Vqd;
+
+  if ((uint8_t)BENCH_CTRL_PI == bController)
+  {
+    VqdNext.q = PI_Controller(&BenchPID, (int32_t)Iqdref.q - Iqd.q);
+    VqdNext.d = PI_Controller(&BenchPIDd, (int32_t)Iqdref.d - Iqd.d);
+    VqdNext = Circle_Limitation(&CircleLimitationM1, VqdNext);
+  }
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  else
+  {
+    VqdNext = PCC_CalcVoltage(&BenchPCC, Iqd, Iqdref, Vqd, MCM_Trig_Functions(hAngle), hSpeedDpp);
+#if (PCC_OUTPUT_MODE != PCC_FINITE_SET) && !defined (PCC_FULL_HEXAGON)
+    VqdNext = Circle_Limitation(&CircleLimitationM1, VqdNext);
+#endif
+  }
+#else
+  else
+  {
+    /* Only the PI controllers are built */
+    (void)hAngle;
+    (void)hSpeedDpp;
+  }
+#endif
+  return (VqdNext);
+}
+
+/* Runs one controller through one scenario on the plant model of mc_plant.c, the one of
+   the software in the loop build, and stores its results in MC_BenchScenarios. The plant
+   steps with the voltage chosen at the previous period, so that the delay of one period
+   seen on the drive is kept. */
+static void MC_Bench_Scenario(uint8_t bController, uint8_t bScenario)
+{
+  const MC_Bench_Step_t *pStep = &BenchSteps[bScenario];
+  MC_Bench_Scenario_t *pResult = &MC_BenchScenarios[bController][bScenario];
+  MC_Plant_t Plant;
+  qd_t Vqd = {0, 0};
+  qd_t Iqdref = {MC_BENCH_IQREF(pStep->hIqrefBefore), 0};
+  int32_t wBand = 0;
+  uint16_t hLastOut = 0U;
+  uint16_t hPeriod;
+  int64_t lSumQ = 0;
+  int64_t lSumD = 0;
+  int64_t lSumSq = 0;
+  uint64_t lCycles = 0U;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  uint32_t wTransitions = 0U;
+  uint8_t bState;
+#endif
+
+  MC_Plant_Init(&Plant, pStep->fRsScale, pStep->fLsScale);
+  MC_Plant_SetSpeed(&Plant, pStep->hSpeedBefore);
+  BenchPID = PIDIqHandle_M1;
+  BenchPIDd = PIDIdHandle_M1;
+  PID_SetIntegralTerm(&BenchPID, 0);
+  PID_SetIntegralTerm(&BenchPIDd, 0);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  BenchPCC = PCC_M1;
+  PCC_Clear(&BenchPCC);
+  PCC_SetBusVoltage(&BenchPCC, PCC_NOMINAL_BUS_D);
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  bState = PCC_GetSwitchingState(&BenchPCC);
+#endif
+#endif
+
+  for (hPeriod = 0U; hPeriod < (MC_BENCH_SCENARIO_WARMUP + MC_BENCH_SCENARIO_SETTLE + MC_BENCH_RIPPLE_PERIODS);
+       hPeriod++)
+  {
+    uint32_t StartMeasure;
+    uint32_t DeltaTimeInCycle;
+    qd_t Iqd;
+    qd_t VqdNext;
+
+    if (MC_BENCH_SCENARIO_WARMUP == hPeriod)
+    {
+      Iqdref.q = MC_BENCH_IQREF(pStep->hIqrefAfter);
+      MC_Plant_SetSpeed(&Plant, pStep->hSpeedAfter);
+      MC_Plant_SetBusScale(&Plant, pStep->fBusAfter);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+      PCC_SetBusVoltage(&BenchPCC, (uint16_t)((float_t)PCC_NOMINAL_BUS_D * pStep->fBusAfter));
+#endif
+      wBand = ((Iqdref.q < 0) ? -(int32_t)Iqdref.q : (int32_t)Iqdref.q) >> MC_BENCH_SETTLE_BAND_POW2;
+      wBand = (wBand < MC_BENCH_SETTLE_BAND_MIN) ? MC_BENCH_SETTLE_BAND_MIN : wBand;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    Iqd = MC_Plant_GetIqd(&Plant);
+    __disable_irq();
+    StartMeasure = DWT->CYCCNT;
+    VqdNext = MC_Bench_Control(bController, Iqd, Iqdref, Vqd, Plant.hElAngle, Plant.hElSpeedDpp);
+    DeltaTimeInCycle = DWT->CYCCNT - StartMeasure;
+    __enable_irq();
+
+    /* Currents at the end of the period, with the voltage applied during it */
+    MC_Plant_Step(&Plant, Vqd);
+    Vqd = VqdNext;
+
+    if (hPeriod < MC_BENCH_SCENARIO_WARMUP)
+    {
+      /* Nothing to do */
+    }
+    else if (hPeriod < (MC_BENCH_SCENARIO_WARMUP + MC_BENCH_SCENARIO_SETTLE))
+    {
+      int32_t wErrQ = (int32_t)Iqdref.q - Iqd.q;
+
+      if ((wErrQ > wBand) || (wErrQ < -wBand))
+      {
+        hLastOut = (hPeriod - MC_BENCH_SCENARIO_WARMUP) + 1U;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      lSumQ += Iqd.q;
+      lSumD += Iqd.d;
+      lSumSq += ((int64_t)Iqd.q * Iqd.q) + ((int64_t)Iqd.d * Iqd.d);
+      lCycles += (DeltaTimeInCycle > BenchOverhead) ? (DeltaTimeInCycle - BenchOverhead) : 0U;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+      if ((uint8_t)BENCH_CTRL_PCC == bController)
+      {
+        uint8_t bChanged = bState ^ PCC_GetSwitchingState(&BenchPCC);
+
+        wTransitions += (uint32_t)(bChanged & 1U) + ((bChanged >> 1) & 1U) + ((bChanged >> 2) & 1U);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+#endif
+    }
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    bState = PCC_GetSwitchingState(&BenchPCC);
+#endif
+  }
+
+  {
+    int32_t wMeanQ = (int32_t)(lSumQ / (int64_t)MC_BENCH_RIPPLE_PERIODS);
+    int32_t wMeanD = (int32_t)(lSumD / (int64_t)MC_BENCH_RIPPLE_PERIODS);
+    int64_t lVar = (lSumSq / (int64_t)MC_BENCH_RIPPLE_PERIODS) - (((int64_t)wMeanQ * wMeanQ) + ((int64_t)wMeanD * wMeanD));
+    int32_t wMean = MCM_Sqrt((wMeanQ * wMeanQ) + (wMeanD * wMeanD));
+    int32_t wRms = MCM_Sqrt((lVar > 0) ? (int32_t)lVar : 0);
+    uint32_t wThd = (wMean > 0) ? (((uint32_t)wRms * 1000U) / (uint32_t)wMean) : UINT16_MAX;
+    uint32_t wSettling = ((uint32_t)hLastOut * 1000000U) / TF_REGULATION_RATE;
+    /* A modulated voltage switches every leg once per PWM period, a finite set vector
+       is held for the whole period */
+    uint32_t wSwitching = (uint32_t)PWM_FREQUENCY;
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    if ((uint8_t)BENCH_CTRL_PCC == bController)
+    {
+      wSwitching = (wTransitions * TF_REGULATION_RATE) / (2U * 3U * MC_BENCH_RIPPLE_PERIODS);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif
+
+    pResult->hRippleRms = (uint16_t)wRms;
+    pResult->hThd = (uint16_t)((wThd > UINT16_MAX) ? UINT16_MAX : wThd);
+    pResult->hSettlingTime = (hLastOut >= MC_BENCH_SCENARIO_SETTLE) ? UINT16_MAX
+                           : (uint16_t)((wSettling > UINT16_MAX) ? UINT16_MAX : wSettling);
+    pResult->hSwitchingFreq = (uint16_t)wSwitching;
+    pResult->wCycles = (uint32_t)(lCycles / MC_BENCH_RIPPLE_PERIODS);
+  }
+}
+
+/**
+ * @brief  Runs every kernel of MC_BENCH_KERNELS_LIST_t on the fixed input vectors
+ *         and stores the minimum and maximum execution times in MC_BenchResults,
+ *         with the longest one of a first run on reset caches,
+ *         then the current ripple of the PCC backend in MC_BenchRipple and the
+ *         closed loop results of the current controllers in MC_BenchScenarios.
+ *         The handles of the drive are copied first, the drive itself is not run.
+ */
+void MC_Bench_Run(void)
+{
+  uint8_t i;
+  uint8_t bRun;
+  uint8_t bKernel;
+  uint8_t bScenario;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // Enable the DWT also without debugger
+  DWT->CYCCNT  = 0;
+  DWT->CTRL   |= DWT_CTRL_CYCCNTENA_Msk;      // Enable Cycle Counter
+
+  for (bKernel = 0; bKernel < (uint8_t)MC_BENCH_NB_KERNELS; bKernel++)
+  {
+    MC_BenchResults[bKernel].min = UINT32_MAX;
+    MC_BenchResults[bKernel].max = 0;
+    MC_BenchResults[bKernel].cold = 0;
+  }
+
+  /* The overhead is the shortest empty measure, with the caches filled */
+  BenchOverhead = 0;
+  BenchCold = false;
+  for (bRun = 0; bRun < MC_BENCH_NB_RUNS; bRun++)
+  {
+    MC_BENCH_MEASURE((uint8_t)BENCH_MCM_Clarke, BenchSink = 0);
+  }
+  BenchOverhead = MC_BenchResults[BENCH_MCM_Clarke].min;
+  MC_BenchResults[BENCH_MCM_Clarke].min = UINT32_MAX;
+  MC_BenchResults[BENCH_MCM_Clarke].max = 0;
+
+  BenchPID = PIDIqHandle_M1;
+  BenchSTO = STO_PLL_M1;
+  BenchSTOCR = STO_CR_M1;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  BenchPCC = PCC_M1;
+#endif
+
+  for (bRun = 0; bRun <= MC_BENCH_NB_RUNS; bRun++)
+  {
+    BenchCold = (0U == bRun);
+    for (i = 0; i < MC_BENCH_NB_INPUTS; i++)
+    {
+      alphabeta_t Ialphabeta;
+      alphabeta_t Valphabeta;
+      qd_t Iqd;
+      qd_t Vqd;
+      Trig_Components Trig;
+      Observer_Inputs_t STO_Inputs;
+
+      MC_BENCH_MEASURE((uint8_t)BENCH_MCM_Clarke, Ialphabeta = MCM_Clarke(BenchIab[i]));
+      MC_BENCH_MEASURE((uint8_t)BENCH_MCM_Park, Iqd = MCM_Park(Ialphabeta, BenchAngle[i]));
+      MC_BENCH_MEASURE((uint8_t)BENCH_MCM_Rev_Park, Valphabeta = MCM_Rev_Park(BenchVqd[i], BenchAngle[i]));
+      MC_BENCH_MEASURE((uint8_t)BENCH_MCM_ClarkePark, Iqd = MCM_ClarkePark(BenchIab[i], BenchAngle[i], &Ialphabeta, &Trig));
+      MC_BENCH_MEASURE((uint8_t)BENCH_MCM_Trig_Functions, Trig = MCM_Trig_Functions(BenchAngle[i]));
+      MC_BENCH_MEASURE((uint8_t)BENCH_MCM_Trig_Functions_Batch,
+                       MCM_Trig_Functions_Batch(BenchAngle, BenchTrig, (uint8_t)MC_BENCH_NB_INPUTS));
+      MC_BENCH_MEASURE((uint8_t)BENCH_MCM_Sqrt,
+                       BenchSink = MCM_Sqrt(((int32_t)BenchIab[i].a * BenchIab[i].a) >> 1));
+      MC_BENCH_MEASURE((uint8_t)BENCH_Circle_Limitation, Vqd = Circle_Limitation(&CircleLimitationM1, BenchVqd[i]));
+      MC_BENCH_MEASURE((uint8_t)BENCH_PI_Controller,
+                       BenchSink = PI_Controller(&BenchPID, (int32_t)BenchIab[i].b - Iqd.q));
+
+      STO_Inputs.Ialfa_beta = Ialphabeta;
+      STO_Inputs.Valfa_beta = Valphabeta;
+      STO_Inputs.Vbus = (uint16_t)(((uint32_t)i * 4096U) + 16384U);
+      MC_BENCH_MEASURE((uint8_t)BENCH_STO_PLL_CalcElAngle, BenchSink = STO_PLL_CalcElAngle(&BenchSTO, &STO_Inputs));
+      MC_BENCH_MEASURE((uint8_t)BENCH_STO_CR_CalcElAngle, BenchSink = STO_CR_CalcElAngle(&BenchSTOCR, &STO_Inputs));
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+      MC_BENCH_MEASURE((uint8_t)BENCH_PCC_CalcVoltage,
+                       Vqd = PCC_CalcVoltage(&BenchPCC, Iqd, BenchVqd[(i + 1U) % MC_BENCH_NB_INPUTS], Vqd,
+                                             Trig, BenchSpeedDpp[i]));
+#endif
+
+      BenchSink = (int32_t)Vqd.q + Vqd.d + Trig.hCos + Trig.hSin;
+    }
+  }
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  MC_Bench_Ripple();
+#endif
+
+  for (bScenario = 0; bScenario < (uint8_t)MC_BENCH_NB_SCENARIOS; bScenario++)
+  {
+    MC_Bench_Scenario((uint8_t)BENCH_CTRL_PI, bScenario);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+    MC_Bench_Scenario((uint8_t)BENCH_CTRL_PCC, bScenario);
+#endif
+  }
+}
+
+#endif /* MC_BENCH_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * @file    mc_cbc_limit.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Cycle-by-cycle current limit by a comparator on the current sensing
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "stm32g4xx_ll_exti.h"
+#include "mc_cbc_limit.h"
+
+#ifdef MC_CBC_LIMIT_MODE
+
+/* Periods cut by the limit since the boot, saturated */
+static uint16_t hEvents;
+
+/**
+  * @brief  Busy wait of the startup of the DAC and of the comparator, as
+  *         R3_2_SetAOReferenceVoltage
+  */
+static void MC_CbcLimit_Wait(uint32_t wDelay_us)
+{
+  volatile uint32_t wait_loop_index = wDelay_us * (SystemCoreClock / (1000000UL * 2UL));
+
+  while (wait_loop_index != 0UL)
+  {
+    wait_loop_index--;
+  }
+}
+
+/**
+  * @brief  Starts DAC3 at a null threshold, so that the limit does not trip, and the
+  *         comparator, and routes it to the OCREF_CLR input of the PWM channels of
+  *         TIM1. To be called once TIM1 is initialized.
+  */
+void MC_CbcLimit_Init(void)
+{
+  LL_AHB2_GRP1_EnableClock(LL_AHB2_GRP1_PERIPH_DAC3);
+  LL_DAC_SetHighFrequencyMode(DAC3, LL_DAC_HIGH_FREQ_MODE_ABOVE_160MHZ);
+  LL_DAC_SetOutputBuffer(DAC3, MC_CBC_LIMIT_DAC_CHANNEL, LL_DAC_OUTPUT_BUFFER_DISABLE);
+  LL_DAC_SetOutputConnection(DAC3, MC_CBC_LIMIT_DAC_CHANNEL, LL_DAC_OUTPUT_CONNECT_INTERNAL);
+  LL_DAC_ConvertData12RightAligned(DAC3, MC_CBC_LIMIT_DAC_CHANNEL, 0U);
+  LL_DAC_Enable(DAC3, MC_CBC_LIMIT_DAC_CHANNEL);
+  MC_CbcLimit_Wait(LL_DAC_DELAY_STARTUP_VOLTAGE_SETTLING_US);
+
+  /* High while the amplifier output is below the threshold */
+  LL_COMP_SetInputPlus(MC_CBC_LIMIT_COMP, MC_CBC_LIMIT_INPUT_PLUS);
+  LL_COMP_SetInputMinus(MC_CBC_LIMIT_COMP, MC_CBC_LIMIT_INPUT_MINUS);
+  LL_COMP_SetInputHysteresis(MC_CBC_LIMIT_COMP, MC_CBC_LIMIT_HYSTERESIS);
+  LL_COMP_SetOutputPolarity(MC_CBC_LIMIT_COMP, LL_COMP_OUTPUTPOL_INVERTED);
+  LL_COMP_SetOutputBlankingSource(MC_CBC_LIMIT_COMP, LL_COMP_BLANKINGSRC_NONE);
+  LL_COMP_Enable(MC_CBC_LIMIT_COMP);
+  MC_CbcLimit_Wait(LL_COMP_DELAY_STARTUP_US);
+
+  /* Pending flag only, the interrupt of the comparators is not enabled in the NVIC */
+  LL_EXTI_EnableRisingTrig_0_31(MC_CBC_LIMIT_EXTI_LINE);
+  LL_EXTI_EnableIT_0_31(MC_CBC_LIMIT_EXTI_LINE);
+  LL_EXTI_ClearFlag_0_31(MC_CBC_LIMIT_EXTI_LINE);
+
+  LL_TIM_SetOCRefClearInputSource(TIM1, MC_CBC_LIMIT_OCREF_CLR);
+  LL_TIM_OC_EnableClear(TIM1, LL_TIM_CHANNEL_CH1);
+  LL_TIM_OC_EnableClear(TIM1, LL_TIM_CHANNEL_CH2);
+  LL_TIM_OC_EnableClear(TIM1, LL_TIM_CHANNEL_CH3);
+}
+
+/**
+  * @brief  Writes the threshold of MC_CBC_LIMIT_CURRENT below the offset of phase U
+  *         and clears the crossings of the previous run. To be called with the PWM
+  *         off, before it is switched on.
+  */
+void MC_CbcLimit_Arm(PWMC_Handle_t *pPWMC)
+{
+  PolarizationOffsets_t Offsets;
+  int32_t wThreshold;
+
+  PWMC_GetOffsetCalib(pPWMC, &Offsets);
+  /* From the left aligned 16-bit reading of the ADC to the 12-bit code of the DAC */
+  wThreshold = (Offsets.phaseAOffset - (int32_t)MC_CBC_LIMIT_CURRENT) / 16;
+  wThreshold = (wThreshold < 0) ? 0 : wThreshold;
+  LL_DAC_ConvertData12RightAligned(DAC3, MC_CBC_LIMIT_DAC_CHANNEL, (uint32_t)wThreshold);
+  LL_EXTI_ClearFlag_0_31(MC_CBC_LIMIT_EXTI_LINE);
+}
+
+/**
+  * @brief  It must be called by FOC_CurrControllerM1 once per period.
+  * @retval bool True if the limit cut the PWM since the last call
+  */
+bool MC_CbcLimit_Exec(void)
+{
+  bool Cut = (1U == LL_EXTI_IsActiveFlag_0_31(MC_CBC_LIMIT_EXTI_LINE));
+
+  if (true == Cut)
+  {
+    LL_EXTI_ClearFlag_0_31(MC_CBC_LIMIT_EXTI_LINE);
+    hEvents += (hEvents < UINT16_MAX) ? 1U : 0U;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (Cut);
+}
+
+/**
+  * @brief  Number of periods cut by the limit since the boot, saturated to UINT16_MAX
+  */
+uint16_t MC_CbcLimit_GetEvents(void)
+{
+  return (hEvents);
+}
+
+#endif /* MC_CBC_LIMIT_MODE */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
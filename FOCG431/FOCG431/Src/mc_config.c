@@ -41,7 +41,8 @@
 
 PQD_MotorPowMeas_Handle_t PQD_MotorPowMeasM1 =
 {
-  .wConvFact = PQD_CONVERSION_FACTOR
+  .wConvFact = PQD_CONVERSION_FACTOR,
+  .wCopperLossFact = PQD_COPPER_LOSS_FACTOR
 };
 
 /**
@@ -62,11 +63,21 @@ PID_Handle_t PIDSpeedHandle_M1 =
   .hDefKdGain           = 0x0000U,
   .hKdDivisor           = 0x0000U,
   .hKdDivisorPOW2       = 0x0000U,
+#ifdef PID_FMAC
+  .FMACEnable           = true,
+#endif
 };
 
 /**
   * @brief  PI / PID Iq loop parameters Motor 1
   */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
 PID_Handle_t PIDIqHandle_M1 =
 {
   .hDefKpGain          = (int16_t)PID_TORQUE_KP_DEFAULT,
@@ -82,11 +93,21 @@ PID_Handle_t PIDIqHandle_M1 =
   .hDefKdGain           = 0x0000U,
   .hKdDivisor           = 0x0000U,
   .hKdDivisorPOW2       = 0x0000U,
+#ifdef PID_FMAC
+  .FMACEnable           = true,
+#endif
 };
 
 /**
   * @brief  PI / PID Id loop parameters Motor 1
   */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
 PID_Handle_t PIDIdHandle_M1 =
 {
   .hDefKpGain          = (int16_t)PID_FLUX_KP_DEFAULT,
@@ -102,6 +123,9 @@ PID_Handle_t PIDIdHandle_M1 =
   .hDefKdGain           = 0x0000U,
   .hKdDivisor           = 0x0000U,
   .hKdDivisorPOW2       = 0x0000U,
+#ifdef PID_FMAC
+  .FMACEnable           = true,
+#endif
 };
 
 /**
@@ -120,6 +144,7 @@ SpeednTorqCtrl_Handle_t SpeednTorqCtrlM1 =
   .MecSpeedRefUnitDefault =          (int16_t)(DEFAULT_TARGET_SPEED_UNIT),
   .TorqueRefDefault =                (int16_t)DEFAULT_TORQUE_COMPONENT,
   .IdrefDefault =                    (int16_t)DEFAULT_FLUX_COMPONENT,
+  .AccFFGain =                        SPEED_ACC_FF_GAIN,
 };
 RevUpCtrl_Handle_t RevUpControlM1 =
 {
@@ -140,19 +165,168 @@ RevUpCtrl_Handle_t RevUpControlM1 =
                              {(uint16_t)PHASE5_DURATION,(int16_t)(PHASE5_FINAL_SPEED_UNIT),(int16_t)PHASE5_FINAL_CURRENT,(void*)MC_NULL},
                             },
 };
+
+#if defined (SINGLE_SHUNT)
+/**
+  * @brief  Current sensor parameters Motor 1 - single shunt - G4
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
+PWMC_R1_Handle_t PWM_Handle_M1 =
+{
+  {
+    .pFctIrqHandler                    = MC_NULL,
+    .pFctSetADCSampPointSectX          = &PWMC_SET_SAMP_POINT_SECTX_M1,
+    .pFctSetADCSampPointState          = &PWMC_SET_SAMP_POINT_STATE_M1,
+    .pFctGetPhaseCurrents              = &PWMC_GET_PHASE_CURRENTS_M1,
+    .pFctSetOffsetCalib                = &R1_SetOffsetCalib,
+    .pFctGetOffsetCalib                = &R1_GetOffsetCalib,
+    .pFctSwitchOffPwm                  = &PWMC_SWITCH_OFF_PWM_M1,
+    .pFctSwitchOnPwm                   = &PWMC_SWITCH_ON_PWM_M1,
+    .pFctCurrReadingCalib              = &R1_CurrentReadingPolarization,
+    .pFctTurnOnLowSides                = &PWMC_TURN_ON_LOW_SIDES_M1,
+    .pFctIsOverCurrentOccurred         = &PWMC_IS_OVER_CURRENT_M1,
+    .pFctOCPSetReferenceVoltage        = MC_NULL,
+    .pFctRLDetectionModeEnable         = MC_NULL,
+    .pFctRLDetectionModeDisable        = MC_NULL,
+    .pFctRLDetectionModeSetDuty        = MC_NULL,
+    .hT_Sqrt3 = (PWM_PERIOD_CYCLES*SQRT3FACTOR)/16384u,
+    .CntPhA = 0,
+    .CntPhB = 0,
+    .CntPhC = 0,
+    .SWerror = 0,
+    .Sector = 0,
+    .lowDuty = ( uint16_t )0,
+    .midDuty = ( uint16_t )0,
+    .highDuty= ( uint16_t )0,
+    .TurnOnLowSidesAction = false,
+    .OffCalibrWaitTimeCounter = 0,
+    .Motor = M1,
+    .RLDetectionMode = false,
+    .Ia = 0,
+    .Ib = 0,
+    .Ic = 0,
+    .LPFIqd_const = LPF_FILT_CONST,
+    .DTTest = 0,
+    .PWMperiod          = PWM_PERIOD_CYCLES,
+    .OffCalibrWaitTicks = (uint16_t)((SYS_TICK_FREQUENCY * OFFCALIBRWAIT_MS)/ 1000),
+    .DTCompCnt          = DTCOMPCNT,
+    .StateHighCnt       = STATE_HIGH_CNT,
+    .BootRefreshPeriods = BOOT_REFRESH_PERIODS,
+    .BootRefreshCnt     = BOOT_REFRESH_CNT,
+    .Ton                 = TON,
+    .Toff                = TOFF
+  },
+  .PhaseOffset = 0,
+  .Half_PWMPeriod = PWM_PERIOD_CYCLES/2u,
+  .PolarizationCounter = ( uint8_t )0,
+  .Sample = { R1_SAMPLE_NONE, R1_SAMPLE_NONE },
+  .OverCurrentFlag = false,
+  .OverVoltageFlag = false,
+  .BrakeActionLock = false,
+  .pParams_str = &R1_ParamsM1,
+  .ADCRegularLocked = false
+};
+#elif defined (ICS_SENSORS)
+/**
+  * @brief  Current sensor parameters Motor 1 - ICS - G4
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
+PWMC_ICS_Handle_t PWM_Handle_M1 =
+{
+  {
+    .pFctIrqHandler                    = MC_NULL,
+    .pFctSetADCSampPointSectX          = &PWMC_SET_SAMP_POINT_SECTX_M1,
+    .pFctSetADCSampPointState          = &PWMC_SET_SAMP_POINT_STATE_M1,
+    .pFctGetPhaseCurrents              = &PWMC_GET_PHASE_CURRENTS_M1,
+    .pFctSetOffsetCalib                = &ICS_SetOffsetCalib,
+    .pFctGetOffsetCalib                = &ICS_GetOffsetCalib,
+    .pFctSwitchOffPwm                  = &PWMC_SWITCH_OFF_PWM_M1,
+    .pFctSwitchOnPwm                   = &PWMC_SWITCH_ON_PWM_M1,
+    .pFctCurrReadingCalib              = &ICS_CurrentReadingPolarization,
+    .pFctTurnOnLowSides                = &PWMC_TURN_ON_LOW_SIDES_M1,
+    .pFctIsOverCurrentOccurred         = &PWMC_IS_OVER_CURRENT_M1,
+    .pFctOCPSetReferenceVoltage        = MC_NULL,
+    .pFctRLDetectionModeEnable         = MC_NULL,
+    .pFctRLDetectionModeDisable        = MC_NULL,
+    .pFctRLDetectionModeSetDuty        = MC_NULL,
+    .hT_Sqrt3 = (PWM_PERIOD_CYCLES*SQRT3FACTOR)/16384u,
+    .CntPhA = 0,
+    .CntPhB = 0,
+    .CntPhC = 0,
+    .SWerror = 0,
+    .Sector = 0,
+    .lowDuty = ( uint16_t )0,
+    .midDuty = ( uint16_t )0,
+    .highDuty= ( uint16_t )0,
+    .TurnOnLowSidesAction = false,
+    .OffCalibrWaitTimeCounter = 0,
+    .Motor = M1,
+    .RLDetectionMode = false,
+    .Ia = 0,
+    .Ib = 0,
+    .Ic = 0,
+    .LPFIqd_const = LPF_FILT_CONST,
+    .DTTest = 0,
+    .PWMperiod          = PWM_PERIOD_CYCLES,
+    .OffCalibrWaitTicks = (uint16_t)((SYS_TICK_FREQUENCY * OFFCALIBRWAIT_MS)/ 1000),
+    .DTCompCnt          = DTCOMPCNT,
+    .StateHighCnt       = STATE_HIGH_CNT,
+    .BootRefreshPeriods = BOOT_REFRESH_PERIODS,
+    .BootRefreshCnt     = BOOT_REFRESH_CNT,
+    .Ton                 = TON,
+    .Toff                = TOFF
+  },
+  .PhaseAOffset = 0,
+  .PhaseBOffset = 0,
+  .Half_PWMPeriod = PWM_PERIOD_CYCLES/2u,
+  .SamplingPoint = ICS_SAMPLING_POINT,
+  .SamplingPointState = ICS_SAMPLING_POINT_STATE,
+  .ADC_ExternalPolarityInjected = ( uint16_t )0,
+  .PolarizationCounter = ( uint8_t )0,
+  .OverCurrentFlag = false,
+  .OverVoltageFlag = false,
+  .BrakeActionLock = false,
+  .ADCRegularLocked = false,
+  .pParams_str = &ICS_ParamsM1
+};
+#else
+/**
+  * @brief  Current sensor parameters Motor 1 - three shunt - G4
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
 PWMC_R3_2_Handle_t PWM_Handle_M1 =
 {
   {
      .pFctIrqHandler                    = MC_NULL,
-    .pFctSetADCSampPointSectX          = &R3_2_SetADCSampPointSectX,
-    .pFctGetPhaseCurrents              = &R3_2_GetPhaseCurrents,
+    .pFctSetADCSampPointSectX          = &PWMC_SET_SAMP_POINT_SECTX_M1,
+    .pFctSetADCSampPointState          = &PWMC_SET_SAMP_POINT_STATE_M1,
+    .pFctGetPhaseCurrents              = &PWMC_GET_PHASE_CURRENTS_M1,
     .pFctSetOffsetCalib                = &R3_2_SetOffsetCalib,
     .pFctGetOffsetCalib                = &R3_2_GetOffsetCalib,
-    .pFctSwitchOffPwm                  = &R3_2_SwitchOffPWM,
-    .pFctSwitchOnPwm                   = &R3_2_SwitchOnPWM,
+    .pFctSetSamplingTiming             = &R3_2_SetSamplingTiming,
+    .pFctSwitchOffPwm                  = &PWMC_SWITCH_OFF_PWM_M1,
+    .pFctSwitchOnPwm                   = &PWMC_SWITCH_ON_PWM_M1,
     .pFctCurrReadingCalib              = &R3_2_CurrentReadingPolarization,
-    .pFctTurnOnLowSides                = &R3_2_TurnOnLowSides,
-    .pFctIsOverCurrentOccurred         = &R3_2_IsOverCurrentOccurred,
+    .pFctTurnOnLowSides                = &PWMC_TURN_ON_LOW_SIDES_M1,
+    .pFctIsOverCurrentOccurred         = &PWMC_IS_OVER_CURRENT_M1,
     .pFctOCPSetReferenceVoltage        = MC_NULL,
     .pFctRLDetectionModeEnable         = &R3_2_RLDetectionModeEnable,
     .pFctRLDetectionModeDisable        = &R3_2_RLDetectionModeDisable,
@@ -178,6 +352,9 @@ PWMC_R3_2_Handle_t PWM_Handle_M1 =
     .PWMperiod          = PWM_PERIOD_CYCLES,
     .OffCalibrWaitTicks = (uint16_t)((SYS_TICK_FREQUENCY * OFFCALIBRWAIT_MS)/ 1000),
     .DTCompCnt          = DTCOMPCNT,
+    .StateHighCnt       = STATE_HIGH_CNT,
+    .BootRefreshPeriods = BOOT_REFRESH_PERIODS,
+    .BootRefreshCnt     = BOOT_REFRESH_CNT,
     .Ton                 = TON,
     .Toff                = TOFF
   },
@@ -194,6 +371,7 @@ PWMC_R3_2_Handle_t PWM_Handle_M1 =
   .pParams_str = &R3_2_ParamsM1,
   .ADCRegularLocked = false
 };
+#endif /* SINGLE_SHUNT */
 
 /**
   * @brief  SpeedNPosition sensor parameters Motor 1 - Base Class
@@ -207,17 +385,137 @@ VirtualSpeedSensor_Handle_t VirtualSpeedSensorM1 =
     .hMinReliableMecSpeedUnit          =	(uint16_t)(MIN_APPLICATION_SPEED_UNIT),
     .bMaximumSpeedErrorsNumber         =	MEAS_ERRORS_BEFORE_FAULTS,
     .hMaxReliableMecAccelUnitP         =	65535,
-    .hMeasurementFrequency             =	TF_REGULATION_RATE_SCALED,
+    .hMeasurementFrequency             =	OBS_REGULATION_RATE_SCALED,
     .DPPConvFactor                     =  DPP_CONV_FACTOR,
     },
   .hSpeedSamplingFreqHz =	MEDIUM_FREQUENCY_TASK_RATE,
-  .hTransitionSteps     =	(int16_t)(TF_REGULATION_RATE * TRANSITION_DURATION/ 1000.0),
+  .hTransitionSteps     =	(int16_t)(OBS_REGULATION_RATE * TRANSITION_DURATION/ 1000.0),
 
 };
 
+#ifdef M1_ENCODER_SENSOR
+/**
+  * @brief  SpeedNPosition sensor parameters Motor 1 - Encoder, measured at the
+  *         rate of the observer. Its speed is reliable down to standstill.
+  */
+ENCODER_Handle_t ENCODER_M1 =
+{
+  ._Super = {
+    .bElToMecRatio                     =	POLE_PAIR_NUM,
+    .hMaxReliableMecSpeedUnit          =	(uint16_t)(1.15*MAX_APPLICATION_SPEED_UNIT),
+    .hMinReliableMecSpeedUnit          =	0U,
+    .bMaximumSpeedErrorsNumber         =	MEAS_ERRORS_BEFORE_FAULTS,
+    .hMaxReliableMecAccelUnitP         =	65535,
+    .hMeasurementFrequency             =	OBS_REGULATION_RATE_SCALED,
+    .DPPConvFactor                     =  DPP_CONV_FACTOR,
+  },
+  .PulseNumber           =	M1_PULSE_NBR + 1,
+  .RevertSignal          =	(FunctionalState)ENC_INVERT_SPEED,
+  .SpeedSamplingFreqHz   =	MEDIUM_FREQUENCY_TASK_RATE,
+  .SpeedBufferSize       =	ENC_AVERAGING_FIFO_DEPTH,
+  .TIMx                  =	TIM2,
+  .ICx_Filter            =	ENC_ICX_FILTER,
+};
+
+/**
+  * @brief  Encoder Alignment Controller parameters Motor 1
+  */
+EncAlign_Handle_t EncAlignCtrlM1 =
+{
+  .hEACFrequencyHz = MEDIUM_FREQUENCY_TASK_RATE,
+  .hFinalTorque    = FINAL_I_ALIGNMENT,
+  .hElAngle        = ALIGNMENT_ANGLE_S16,
+  .hDurationms     = ALIGNMENT_DURATION,
+  .bElToMecRatio   = POLE_PAIR_NUM,
+};
+#endif
+
+#ifdef M1_HFI_SENSOR
+/**
+  * @brief  SpeedNPosition sensor parameters Motor 1 - High Frequency Injection,
+  *         run at the rate of the observer. Its speed is reliable down to
+  *         standstill.
+  */
+HFI_Handle_t HFI_M1 =
+{
+  ._Super = {
+    .bElToMecRatio                     =	POLE_PAIR_NUM,
+    .SpeedUnit                         = SPEED_UNIT,
+    .hMaxReliableMecSpeedUnit          =	(uint16_t)(1.15*MAX_APPLICATION_SPEED_UNIT),
+    .hMinReliableMecSpeedUnit          =	0U,
+    .bMaximumSpeedErrorsNumber         =	MEAS_ERRORS_BEFORE_FAULTS,
+    .hMaxReliableMecAccelUnitP         =	65535,
+    .hMeasurementFrequency             =	OBS_REGULATION_RATE_SCALED,
+    .DPPConvFactor                     =  DPP_CONV_FACTOR,
+  },
+  .PIRegulator = {
+    .hDefKpGain          = HFI_PLL_KP_GAIN,
+    .hDefKiGain          = HFI_PLL_KI_GAIN,
+    .hDefKdGain          = 0x0000U,
+    .hKpDivisor          = HFI_PLL_KPDIV,
+    .hKiDivisor          = HFI_PLL_KIDIV,
+    .hKdDivisor          = 0x0000U,
+    .wUpperIntegralLimit = INT32_MAX,
+    .wLowerIntegralLimit = -INT32_MAX,
+    .hUpperOutputLimit   = INT16_MAX,
+    .hLowerOutputLimit   = -INT16_MAX,
+    .hKpDivisorPOW2      = HFI_PLL_KPDIV_LOG,
+    .hKiDivisorPOW2      = HFI_PLL_KIDIV_LOG,
+    .hKdDivisorPOW2      = 0x0000U,
+  },
+  .hInjVoltage      = HFI_INJ_VOLTAGE,
+  .bHalfPeriod      = HFI_HALF_PERIOD,
+  .hErrorGain       = HFI_ERROR_GAIN,
+  .hMinDResponse    = HFI_MIN_D_RESPONSE,
+  .hPolarityCurrent = HFI_POLARITY_CURRENT,
+  .hLockTicks       = HFI_LOCK_TICKS,
+  .hPulseTicks      = HFI_PULSE_TICKS,
+};
+#endif
+
+#ifdef M1_POSITION_CTRL
+/**
+  * @brief  PID position loop parameters Motor 1, from the mechanical angle error
+  *         to the torque reference
+  */
+PID_Handle_t PID_PosParamsM1 =
+{
+  .hDefKpGain          = (int16_t)PID_POSITION_KP_GAIN,
+  .hDefKiGain          = (int16_t)PID_POSITION_KI_GAIN,
+  .hDefKdGain          = (int16_t)PID_POSITION_KD_GAIN,
+  .wUpperIntegralLimit = (int32_t)NOMINAL_CURRENT * (int32_t)POS_KIDIV,
+  .wLowerIntegralLimit = -(int32_t)NOMINAL_CURRENT * (int32_t)POS_KIDIV,
+  .hUpperOutputLimit   = (int16_t)NOMINAL_CURRENT,
+  .hLowerOutputLimit   = -(int16_t)NOMINAL_CURRENT,
+  .hKpDivisor          = (uint16_t)POS_KPDIV,
+  .hKiDivisor          = (uint16_t)POS_KIDIV,
+  .hKdDivisor          = (uint16_t)POS_KDDIV,
+  .hKpDivisorPOW2      = (uint16_t)POS_KPDIV_LOG,
+  .hKiDivisorPOW2      = (uint16_t)POS_KIDIV_LOG,
+  .hKdDivisorPOW2      = (uint16_t)POS_KDDIV_LOG,
+};
+
+/**
+  * @brief  Position Control parameters Motor 1, run at POSITION_LOOP_FREQUENCY_HZ
+  */
+PosCtrl_Handle_t PosCtrlM1 =
+{
+  .SamplingTime  = POSITION_SAMPLING_TIME,
+  .SysTickPeriod = POSITION_SAMPLING_TIME,
+  .AlignmentCfg  = TC_ABSOLUTE_ALIGNMENT_NOT_SUPPORTED,
+};
+#endif
+
 /**
   * @brief  SpeedNPosition sensor parameters Motor 1 - State Observer + PLL
   */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
 STO_PLL_Handle_t STO_PLL_M1 =
 {
   ._Super = {
@@ -227,7 +525,7 @@ STO_PLL_Handle_t STO_PLL_M1 =
     .hMinReliableMecSpeedUnit          =	(uint16_t)(MIN_APPLICATION_SPEED_UNIT),
     .bMaximumSpeedErrorsNumber         =	MEAS_ERRORS_BEFORE_FAULTS,
     .hMaxReliableMecAccelUnitP         =	65535,
-    .hMeasurementFrequency             =	TF_REGULATION_RATE_SCALED,
+    .hMeasurementFrequency             =	OBS_REGULATION_RATE_SCALED,
     .DPPConvFactor                     =  DPP_CONV_FACTOR,
   },
  .hC1                         =	C1,
@@ -266,9 +564,52 @@ STO_PLL_Handle_t STO_PLL_M1 =
  .F1LOG                              =	F1_LOG,
  .F2LOG                              =	F2_LOG,
  .SpeedBufferSizeDppLOG              =	STO_FIFO_DEPTH_DPP_LOG,
+ .GainScheduleSpeedUnit              =	PLL_GAIN_SCHEDULE_SPEED_UNIT,
+ .GainScheduleMax                    =	PLL_GAIN_SCHEDULE_MAX,
+ .FastConvergence                    =	(OBS_FAST_CONVERGENCE_ENABLING == ENABLE),
  .hForcedDirection                   =  0x0000U
 };
 
+/**
+  * @brief  SpeedNPosition sensor parameters Motor 1 - State Observer + CORDIC,
+  *         alternative to STO_PLL_M1 selected with TSK_SetObserverM1()
+  */
+STO_CR_Handle_t STO_CR_M1 =
+{
+  ._Super = {
+    .bElToMecRatio                     =	POLE_PAIR_NUM,
+    .SpeedUnit                         = SPEED_UNIT,
+    .hMaxReliableMecSpeedUnit          =	(uint16_t)(1.15*MAX_APPLICATION_SPEED_UNIT),
+    .hMinReliableMecSpeedUnit          =	(uint16_t)(MIN_APPLICATION_SPEED_UNIT),
+    .bMaximumSpeedErrorsNumber         =	MEAS_ERRORS_BEFORE_FAULTS,
+    .hMaxReliableMecAccelUnitP         =	65535,
+    .hMeasurementFrequency             =	OBS_REGULATION_RATE_SCALED,
+    .DPPConvFactor                     =  DPP_CONV_FACTOR,
+  },
+ .hC1                                =	C1,
+ .hC2                                =	C2,
+ .hC3                                =	C3,
+ .hC4                                =	C4,
+ .hC5                                =	C5,
+ .hF1                                =	F1,
+ .hF2                                =	F2,
+ .SpeedBufferSizeUnit                =	STO_FIFO_DEPTH_UNIT,
+ .SpeedBufferSizedpp                 =	STO_FIFO_DEPTH_DPP,
+ .VariancePercentage                 =	PERCENTAGE_FACTOR,
+ .SpeedValidationBand_H              =	SPEED_BAND_UPPER_LIMIT,
+ .SpeedValidationBand_L              =	SPEED_BAND_LOWER_LIMIT,
+ .MinStartUpValidSpeed               =	OBS_MINIMUM_SPEED_UNIT,
+ .StartUpConsistThreshold            =	NB_CONSECUTIVE_TESTS,
+ .Reliability_hysteresys             =	OBS_MEAS_ERRORS_BEFORE_FAULTS,
+ .MaxInstantElAcceleration           =	CORD_MAX_ACCEL_DPPP,
+ .BemfConsistencyCheck               =	BEMF_CONSISTENCY_TOL,
+ .BemfConsistencyGain                =	BEMF_CONSISTENCY_GAIN,
+ .MaxAppPositiveMecSpeedUnit         =	(uint16_t)(MAX_APPLICATION_SPEED_UNIT*1.15),
+ .F1LOG                              =	F1_LOG,
+ .F2LOG                              =	F2_LOG,
+ .SpeedBufferSizedppLOG              =	STO_FIFO_DEPTH_DPP_LOG
+};
+
 STO_Handle_t STO_M1 =
 {
   ._Super                        = (SpeednPosFdbk_Handle_t*)&STO_PLL_M1, //cstat !MISRAC2012-Rule-11.3
@@ -324,6 +665,33 @@ RDivider_Handle_t BusVoltageSensor_M1 =
   .aBuffer = RealBusVoltageSensorFilterBufferM1,
 };
 
+#ifdef M1_ICL_ENABLED
+/**
+  * Inrush current limiter Motor 1, clocked by the medium frequency task
+  */
+ICL_Handle_t ICL_M1 =
+{
+  .ICLstate         = ICL_INACTIVE,
+  .hICLTicksCounter = 0U,
+  .hICLTotalTicks   = 0U,
+  .hICLFrequencyHz  = SPEED_LOOP_FREQUENCY_HZ,
+  .hICLDurationms   = INRUSH_CURRLIMIT_CHANGE_AFTER_MS,
+  .hICLWindowms     = INRUSH_CURRLIMIT_WINDOW_MS,
+  .hSettleVoltage_d = INRUSH_CURRLIMIT_SETTLE_d,
+};
+
+/**
+  * Bypass relay of the inrush current limiter Motor 1, active when the resistor limits
+  */
+DOUT_handle_t ICLDOUTParamsM1 =
+{
+  .OutputState      = INACTIVE,
+  .hDOutputPort     = M1_ICL_SHUT_OUT_GPIO_Port,
+  .hDOutputPin      = M1_ICL_SHUT_OUT_Pin,
+  .bDOutputPolarity = DOutputActiveHigh,
+};
+#endif
+
 /** RAMP for Motor1.
   *
   */
@@ -332,21 +700,398 @@ RampExtMngr_Handle_t RampExtMngrHFParamsM1 =
   .FrequencyHz = TF_REGULATION_RATE
 };
 
+/**
+  * @brief  PI Flux Weakening control parameters Motor 1
+  */
+PID_Handle_t PIDFluxWeakeningHandle_M1 =
+{
+  .hDefKpGain          = (int16_t)FW_KP_GAIN,
+  .hDefKiGain          = (int16_t)FW_KI_GAIN,
+  .wUpperIntegralLimit = 0,
+  .wLowerIntegralLimit = (int32_t)(-NOMINAL_CURRENT) * (int32_t)FW_KIDIV,
+  .hUpperOutputLimit       = 0,
+  .hLowerOutputLimit       = -INT16_MAX,
+  .hKpDivisor          = (uint16_t)FW_KPDIV,
+  .hKiDivisor          = (uint16_t)FW_KIDIV,
+  .hKpDivisorPOW2      = (uint16_t)FW_KPDIV_LOG,
+  .hKiDivisorPOW2      = (uint16_t)FW_KIDIV_LOG,
+  .hDefKdGain           = 0x0000U,
+  .hKdDivisor           = 0x0000U,
+  .hKdDivisorPOW2       = 0x0000U,
+};
+
+/**
+  * @brief  FluxWeakeningCtrl component parameters Motor 1
+  */
+FW_Handle_t FW_M1 =
+{
+  .hMaxModule             = MAX_MODULE,
+  .hDefaultFW_V_Ref       = (int16_t)FW_VOLTAGE_REF,
+  .hDemagCurrent          = ID_DEMAG,
+  .wNominalSqCurr         = ((int32_t)NOMINAL_CURRENT*(int32_t)NOMINAL_CURRENT),
+  .hVqdLowPassFilterBW    = M1_VQD_SW_FILTER_BW_FACTOR,
+  .hVqdLowPassFilterBWLOG = M1_VQD_SW_FILTER_BW_FACTOR_LOG
+};
+
+/**
+  * @brief  FeedForwardCtrl parameters Motor 1
+  */
+FF_Handle_t FF_M1 =
+{
+  .hVqdLowPassFilterBW    = M1_VQD_SW_FILTER_BW_FACTOR,
+  .wDefConstant_1D        = (int32_t)CONSTANT1_D,
+  .wDefConstant_1Q        = (int32_t)CONSTANT1_Q,
+  .wDefConstant_2         = (int32_t)CONSTANT2_QD,
+  .hVqdLowPassFilterBWLOG = M1_VQD_SW_FILTER_BW_FACTOR_LOG
+};
+
+/**
+  * @brief  MTPA component parameters Motor 1
+  */
+MTPA_Handle_t MTPARegM1 =
+{
+  .SegDiv   = (int16_t)SEGDIV,
+  .AngCoeff = ANGC,
+  .Offset   = OFST,
+};
+
 /**
   * @brief  CircleLimitation Component parameters Motor 1 - Base Component
   */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
 CircleLimitation_Handle_t CircleLimitationM1 =
 {
   .MaxModule          = MAX_MODULE,
   .MaxVd          	  = (uint16_t)(MAX_MODULE * 950 / 1000),
 };
 
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+/**
+  * @brief  Predictive Current Control cost weights Motor 1
+  */
+static const PCC_Weights_t PCC_WeightTableM1[PCC_NB_WEIGHTS] = PCC_WEIGHT_TABLE;
+#ifdef PCC_ADAPTIVE_PERIOD
+/**
+  * @brief  Predictive Current Control models of the decision periods Motor 1
+  */
+static const PCC_PeriodModel_t PCC_PeriodTableM1[PCC_PERIOD_STEPS] = PCC_PERIOD_TABLE;
+#endif
+#endif
+
+/**
+  * @brief  Predictive Current Control parameters Motor 1
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
+PCC_Handle_t PCC_M1 =
+{
+  .wKDecay      = PCC_KDECAY,
+  .wKVolt       = PCC_KVOLT,
+  .wKBemf       = PCC_KBEMF,
+  .hCoefDivisorPOW2 = (uint16_t)PCC_COEF_DIV_LOG,
+  .hBemfDivisorPOW2 = (uint16_t)PCC_BEMF_DIV_LOG,
+  .hSwitchingWeight = (uint16_t)PCC_SWITCHING_WEIGHT,
+  .hNodeBudget  = (uint16_t)PCC_NODE_BUDGET,
+  .hFallbackOverruns = (uint16_t)PCC_FALLBACK_OVERRUNS,
+  .hFallbackPeriods = PCC_FALLBACK_PERIODS,
+  .hResidualLimit = PCC_RESIDUAL_LIMIT,
+  .bResidualShift = (uint8_t)PCC_RESIDUAL_SHIFT,
+  .hDistGain    = PCC_DIST_GAIN,
+#ifdef PCC_STATE_FILTER
+  .hStateGain   = PCC_STATE_GAIN,
+#endif
+  .hEngageSpeed = (int16_t)PCC_ENGAGE_SPEED_UNIT,
+  .hDisengageSpeed = (int16_t)PCC_DISENGAGE_SPEED_UNIT,
+  .hNominalBusVoltage = PCC_NOMINAL_BUS_D,
+  .hStatsPeriod = PCC_STATS_PERIOD,
+#if (PCC_OUTPUT_MODE != PCC_FINITE_SET) && !defined (PCC_FULL_HEXAGON)
+  .hMaxModule   = MAX_MODULE,
+#endif
+#ifdef PCC_VBUS_LIMIT
+  .hVbusStart_d = PCC_VBUS_START_D,
+  .hVbusLimit_d = OVERVOLTAGE_THRESHOLD_d,
+  .hRegenWeight = (uint16_t)PCC_REGEN_WEIGHT,
+  .hBrakeIdMax  = PCC_BRAKE_ID,
+#endif
+#ifdef PCC_INDUCTANCE_TABLE
+  .hLSatKnee    = PCC_LSAT_KNEE,
+  .hLSatDrop    = PCC_LSAT_DROP,
+  .hLSatStep    = PCC_LSAT_STEP,
+#endif
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  .hSwitchDrop  = PCC_SWITCH_DROP,
+  .hDiodeDrop   = PCC_DIODE_DROP,
+  .hDeadTimeDrop = PCC_DEADTIME_DROP,
+  .pWeightTable = PCC_WeightTableM1,
+  .hWeightSpeedBand = {(int16_t)PCC_WEIGHT_SPEED_BAND1_UNIT, (int16_t)PCC_WEIGHT_SPEED_BAND2_UNIT},
+  .hWeightIqBand = {PCC_WEIGHT_IQ_BAND1, PCC_WEIGHT_IQ_BAND2},
+  .hLimitCurr = (int16_t)PCC_BARRIER_CURRENT,
+  .hMaxCurr = (int16_t)PCC_MAX_CURR,
+  .hTripCurr = (int16_t)PCC_TRIP_CURR,
+#if (PCC_COST_NORM == PCC_COST_L2_SAT) || (PCC_COST_NORM == PCC_COST_L2_PACKED)
+  .hCostSatError = (int16_t)PCC_COST_SAT_ERROR,
+#endif
+  .hTieBand = (uint16_t)PCC_TIE_BAND,
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+  .wFluxCurr = PCC_FLUX_CURR,
+  .hInductanceRatio = PCC_INDUCTANCE_RATIO,
+#endif
+#ifdef PCC_ADAPTIVE_PERIOD
+  .pPeriodTable = PCC_PeriodTableM1,
+  .hPeriodSpeedBand = {(int16_t)PCC_PERIOD_SPEED_BAND1_UNIT, (int16_t)PCC_PERIOD_SPEED_BAND2_UNIT},
+  .hPeriodHyst = (int16_t)PCC_PERIOD_HYST_UNIT,
+#endif
+#endif
+};
+
+#ifdef PCC_MODEL_ESTIMATION
+/**
+  * @brief  PCC model estimator Motor 1
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
+PCC_EST_Handle_t PCC_EST_M1 =
+{
+  .fForgetting     = (float_t)PCC_EST_FORGETTING_FACTOR,
+  .fPriorWeight    = (float_t)PCC_EST_PRIOR_WEIGHT,
+  .fInitCovariance = (float_t)PCC_EST_INIT_COVARIANCE,
+  .hMinSpeedDpp    = PCC_EST_MIN_SPEED_DPP,
+  .hMinCurrent     = PCC_EST_MIN_CURRENT,
+  .hRefTemp_C      = (int16_t)PCC_EST_REF_TEMP_C,
+  .hUpdatePeriod   = PCC_EST_UPDATE_PERIOD,
+};
+#endif
+#endif
+
+#ifdef THERMAL_DERATING
+/**
+  * @brief  Thermal derating Motor 1
+  */
+TDR_Handle_t TDR_M1 =
+{
+  .Node =
+  {
+    [TDR_STAGE] =
+    {
+      .fRise_C = (float_t)TDR_STAGE_RISE_C,
+      .fCoeff  = (float_t)TDR_STAGE_COEFF,
+      .hMax_C  = (int16_t)TDR_STAGE_MAX_C,
+    },
+    [TDR_WINDING] =
+    {
+      .fRise_C = (float_t)TDR_WINDING_RISE_C,
+      .fCoeff  = (float_t)TDR_WINDING_COEFF,
+      .hMax_C  = (int16_t)TDR_WINDING_MAX_C,
+    },
+  },
+  .wNominalSqCurr = ((int32_t)NOMINAL_CURRENT*(int32_t)NOMINAL_CURRENT),
+  .hBand_C        = (int16_t)TDR_BAND_C,
+};
+#endif
+
+#ifdef LOSS_MINIMIZATION
+/**
+  * @brief  Loss minimization Motor 1
+  */
+LMN_Handle_t LMN_M1 =
+{
+  .hIdStep        = LMN_ID_STEP,
+  .hIdMax         = LMN_ID_MAX,
+  .hLightLoadIq   = LMN_LIGHT_LOAD_IQ,
+  .hLoadBand      = LMN_LOAD_BAND,
+  .hMinSpeedUnit  = (int16_t)LMN_MIN_SPEED_UNIT,
+  .hSettlePeriods = LMN_SETTLE_PERIODS,
+  .hAvgPeriods    = LMN_AVG_PERIODS,
+};
+#endif
+
+#ifdef HARMONIC_COMPENSATION
+/**
+  * @brief  Harmonic compensation Motor 1, its table read by the high frequency task
+  */
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
+HCM_Handle_t HCM_M1 =
+{
+  .hLearnSpeedDpp = HCM_LEARN_SPEED_DPP,
+  .hMinSpeedDpp   = HCM_MIN_SPEED_DPP,
+  .bLearnShift    = (uint8_t)HCM_LEARN_SHIFT,
+  .bMeanShift     = (uint8_t)HCM_MEAN_SHIFT,
+};
+#endif
+
+#ifdef SIX_STEP_MODE
+/**
+  * @brief  Six-step mode Motor 1
+  */
+SSM_Handle_t SSM_M1 =
+{
+  .hMinSpeedDpp  = SSM_MIN_SPEED_DPP,
+  .hExitSpeedDpp = SSM_EXIT_SPEED_DPP,
+  .hEnterRatio   = SSM_ENTER_RATIO,
+  .hExitRatio    = SSM_EXIT_RATIO,
+  .hEnterPeriods = SSM_ENTER_PERIODS,
+  .bFilterShift  = (uint8_t)SIX_STEP_FILTER_SHIFT,
+  .bHystShift    = (uint8_t)SIX_STEP_HYST_SHIFT,
+};
+#endif
+
+#ifdef LOAD_TORQUE_OBSERVER
+/**
+  * @brief  Load torque observer Motor 1
+  */
+LTO_Handle_t LTO_M1 =
+{
+  .wSpeedPerIq = LTO_SPEED_PER_IQ,
+  .hSpeedGain  = LTO_SPEED_GAIN,
+  .wLoadGain   = LTO_LOAD_GAIN,
+  .hFFGain     = LTO_FF_GAIN,
+  .hMaxLoad    = LTO_MAX_LOAD,
+};
+#endif
+
+#ifdef SPEED_FILTER_BANK
+/**
+  * @brief  Filter bank of the speed loop Motor 1
+  */
+SFB_Handle_t SFB_M1 =
+{
+  .hSampleFreqHz = (uint16_t)MEDIUM_FREQUENCY_TASK_RATE,
+  .hNotchFreqHz  = (uint16_t)SPEED_FILTER_NOTCH_HZ,
+  .hNotchWidthHz = (uint16_t)SPEED_FILTER_NOTCH_WIDTH_HZ,
+  .hLowPassHz    = (uint16_t)SPEED_FILTER_LOW_PASS_HZ,
+};
+#endif
+
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+/**
+  * @brief  Speed predictive control Motor 1
+  */
+SMPC_Handle_t SMPC_M1 =
+{
+  .bHorizon        = (uint8_t)SPEED_MPC_HORIZON,
+  .fMoveWeight     = (float_t)SPEED_MPC_MOVE_WEIGHT,
+  .fForgetting     = (float_t)SPEED_MPC_FORGETTING_FACTOR,
+  .fInitCovariance = (float_t)SPEED_MPC_INIT_COVARIANCE,
+  .fTorqueTermNom  = (float_t)SPEED_MPC_TORQUE_TERM,
+  .hNominalCurrent = (int16_t)NOMINAL_CURRENT,
+  .hSpeedScale     = (int16_t)MAX_APPLICATION_SPEED_UNIT,
+  .hMinSpeedUnit   = (int16_t)SPEED_MPC_EST_MIN_SPEED_UNIT,
+};
+#endif
+
+#ifdef MC_GAP_MODE
+#if !defined (GAP_NCS_Pin) || !defined (GAP_NSD_Pin)
+#error "MC_GAP_MODE requires the GAP_NCS and GAP_NSD pins in main.h"
+#endif
+/**
+  * @brief  STGAP gate drivers Motor 1, the devices beyond MC_GAP_NB_DEVICES are not used
+  */
+GAP_Handle_t STGAP_M1 =
+{
+  .DeviceNum    = (uint8_t)MC_GAP_NB_DEVICES,
+  .DeviceParams =
+  {
+    MC_GAP_DEVICE_PARAMS, MC_GAP_DEVICE_PARAMS, MC_GAP_DEVICE_PARAMS, MC_GAP_DEVICE_PARAMS,
+    MC_GAP_DEVICE_PARAMS, MC_GAP_DEVICE_PARAMS, MC_GAP_DEVICE_PARAMS,
+  },
+  .SPIx         = MC_GAP_SPI,
+  .NCSPort      = GAP_NCS_GPIO_Port,
+  .NCSPin       = GAP_NCS_Pin,
+  .NSDPort      = GAP_NSD_GPIO_Port,
+  .NSDPin       = GAP_NSD_Pin,
+};
+#endif
+
+/**
+  * @brief  Current regulation of Motor 1, run by FOC_CurrControllerM1
+  */
+CRG_Handle_t CurrRegM1 =
+{
+  .pPIDIq = &PIDIqHandle_M1,
+  .pPIDId = &PIDIdHandle_M1,
+  .pFF    = &FF_M1,
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  .pPCC   = &PCC_M1,
+#ifdef PCC_MODEL_ESTIMATION
+  .pPCCEst = &PCC_EST_M1,
+#endif
+#ifdef PCC_BLENDED_HANDOVER
+  .wBlendPeriods = PCC_BLEND_PERIODS,
+#endif
+#endif
+#ifdef HARMONIC_COMPENSATION
+  .pHCM   = &HCM_M1,
+#endif
+#ifdef SIX_STEP_MODE
+  .pSSM   = &SSM_M1,
+#endif
+};
+
 MCI_Handle_t Mci[NBR_OF_MOTORS];
+#ifdef DBG_MCU_LOAD_MEASURE
+MC_Perf_Handle_t PerfTraces;
+#endif
+#ifndef MC_STATIC_BINDING_MODE
 SpeednTorqCtrl_Handle_t *pSTC[NBR_OF_MOTORS] = { &SpeednTorqCtrlM1 };
 PID_Handle_t *pPIDIq[NBR_OF_MOTORS] = {&PIDIqHandle_M1};
 PID_Handle_t *pPIDId[NBR_OF_MOTORS] = {&PIDIdHandle_M1};
+FW_Handle_t *pFW[NBR_OF_MOTORS] = {&FW_M1};
+FF_Handle_t *pFF[NBR_OF_MOTORS] = {&FF_M1};
+MTPA_Handle_t *pMaxTorquePerAmpere[NBR_OF_MOTORS] = {&MTPARegM1};
+CRG_Handle_t *pCRG[NBR_OF_MOTORS] = {&CurrRegM1};
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+PCC_Handle_t *pPCC[NBR_OF_MOTORS] = {&PCC_M1};
+#ifdef PCC_MODEL_ESTIMATION
+PCC_EST_Handle_t *pPCCEst[NBR_OF_MOTORS] = {&PCC_EST_M1};
+#endif
+#endif
 NTC_Handle_t *pTemperatureSensor[NBR_OF_MOTORS] = {&TempSensor_M1};
+#ifdef THERMAL_DERATING
+TDR_Handle_t *pTDR[NBR_OF_MOTORS] = {&TDR_M1};
+#endif
+#ifdef LOSS_MINIMIZATION
+LMN_Handle_t *pLMN[NBR_OF_MOTORS] = {&LMN_M1};
+#endif
+#ifdef HARMONIC_COMPENSATION
+HCM_Handle_t *pHCM[NBR_OF_MOTORS] = {&HCM_M1};
+#endif
+#ifdef SIX_STEP_MODE
+SSM_Handle_t *pSSM[NBR_OF_MOTORS] = {&SSM_M1};
+#endif
+#ifdef LOAD_TORQUE_OBSERVER
+LTO_Handle_t *pLTO[NBR_OF_MOTORS] = {&LTO_M1};
+#endif
+#ifdef SPEED_FILTER_BANK
+SFB_Handle_t *pSFB[NBR_OF_MOTORS] = {&SFB_M1};
+#endif
+#if (SPEED_CONTROLLER == SPD_CTRL_MPC)
+SMPC_Handle_t *pSMPC[NBR_OF_MOTORS] = {&SMPC_M1};
+#endif
 PQD_MotorPowMeas_Handle_t *pMPM[NBR_OF_MOTORS] = {&PQD_MotorPowMeasM1};
+#endif
 
 /* USER CODE BEGIN Additional configuration */
 
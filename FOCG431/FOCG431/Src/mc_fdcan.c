@@ -0,0 +1,786 @@
+/**
+  ******************************************************************************
+  * @file    mc_fdcan.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Cyclic process data of the drive over FDCAN
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "main.h"
+#include "mc_config.h"
+#include "mc_interface.h"
+#include "mc_fdcan.h"
+#ifdef MC_PWM_SYNC_MODE
+#include "mc_pwm_sync.h"
+#endif
+#ifdef MC_FDCAN_SHARED_LINK
+#include "mcp.h"
+#include "register_interface.h"
+#endif
+
+#ifdef MC_FDCAN_MODE
+
+#if (MC_FDCAN_NODE >= MC_FDCAN_MAX_NODES)
+#error "MC_FDCAN_NODE must be lower than MC_FDCAN_MAX_NODES"
+#endif
+
+#if defined(MC_FDCAN_GATEWAY) && defined(MC_FDCAN_PEER)
+#error "A drive is either the gateway or a peer"
+#elif defined(MC_FDCAN_GATEWAY) && (MC_FDCAN_NODE != 0U)
+#error "The gateway must be the node 0"
+#elif defined(MC_FDCAN_PEER) && (MC_FDCAN_NODE == 0U)
+#error "The node 0 is the gateway, a peer must have another index"
+#endif
+
+#if (MC_FDCAN_TELEMETRY_DECIMATION < 1U) || (MC_FDCAN_TELEMETRY_DECIMATION > 255U)
+#error "MC_FDCAN_TELEMETRY_DECIMATION must be from 1 to 255"
+#endif
+
+/* Bytes of the command frame up to the end of the slot of the drive */
+#define MC_FDCAN_SLOT_END  ((MC_FDCAN_NODE + 1U) * MC_FDCAN_SLOT_SIZE)
+
+#if defined(MC_PWM_SYNC_MODE) && (MC_PWM_SYNC_SOURCE == MC_PWM_SYNC_FDCAN)
+#define MC_FDCAN_SYNC
+/* TIM1 counts per unit of the timestamp counter, one nominal bit time of 1 us */
+#define MC_FDCAN_TIMESTAMP_TICKS  ((uint32_t)ADV_TIM_CLK_MHz)
+#endif
+
+extern FDCAN_HandleTypeDef hfdcan1;
+
+/* Data field sizes of the FD data length codes */
+static const uint8_t FdcanDlcBytes[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+static FDCAN_TxHeaderTypeDef FeedbackHeader;
+static uint8_t bPrevControl;      /* Control bits of the previous command frame */
+static uint16_t hSequence;        /* Sequence number of the last command frame */
+static uint32_t wLostFeedbacks;   /* Feedback frames not queued, Tx FIFO full */
+
+#ifdef MC_FDCAN_SHARED_LINK
+#define MC_FDCAN_FRAME_SIZE     64U
+#define MC_FDCAN_RING_SIZE      4U
+#define MC_FDCAN_NEXT(index)    ((uint8_t)(((index) + 1U) % MC_FDCAN_RING_SIZE))
+
+/* Forwarded MCP request, from the point of view of the node that owns it */
+typedef enum
+{
+  MC_FDCAN_REQ_NONE,
+  MC_FDCAN_REQ_QUEUED,          /* Request to send by the gateway, to execute by the peer */
+  MC_FDCAN_REQ_SENT,            /* Request waiting for the answer of the peer */
+  MC_FDCAN_REQ_ANSWERED         /* Answer to return to the host, or to send by the peer */
+} MC_FDCAN_Request_t;
+#endif
+
+#ifdef MC_FDCAN_PEER
+static FDCAN_TxHeaderTypeDef TelemetryHeader;
+static FDCAN_TxHeaderTypeDef AnswerHeader;
+/* Sequence number of the last command frame in the high half word, FOC periods elapsed
+   since this frame in the low one */
+static volatile uint32_t wCycle;
+/* Frames from the read index to the write one are complete, the one at the write index
+   is being filled */
+static uint8_t TelemetryFrames[MC_FDCAN_RING_SIZE][MC_FDCAN_TELEMETRY_SIZE];
+static volatile uint8_t bTelemetryWrite;
+static volatile uint8_t bTelemetryRead;
+static uint8_t bTelemetrySamples;   /* Samples of the frame being filled */
+static uint8_t bTelemetryCount;     /* FOC periods before the next sample */
+static uint8_t RequestFrame[MC_FDCAN_FRAME_SIZE];
+static uint8_t AnswerFrame[MC_FDCAN_FRAME_SIZE];
+static volatile MC_FDCAN_Request_t RequestState = MC_FDCAN_REQ_NONE;
+/* Only the size of the answers is used by MCP_ReceivedPacket */
+static MCTL_Handle_t PeerTransport = {.txSyncMaxPayload = MC_FDCAN_MCP_MAX_BYTES};
+#endif
+
+#ifdef MC_FDCAN_GATEWAY
+/* Timestamp, then node, samples, decimation and state, samples, mark and async ID */
+#define MC_FDCAN_PACKET_SIZE    (MC_FDCAN_TELEMETRY_SIZE + 2U)
+
+typedef struct
+{
+  uint32_t wTimestamp;          /* GLOBAL_TIMESTAMP at the reception of the command frame */
+  uint16_t hSequence;
+  bool Valid;
+} MC_FDCAN_SeqStamp_t;
+
+static FDCAN_TxHeaderTypeDef RequestHeader;
+static MC_FDCAN_SeqStamp_t SeqHistory[MC_FDCAN_SEQ_HISTORY];
+/* Packets from the read index to the write one wait for the deferred high frequency task */
+static uint8_t TelemetryPackets[MC_FDCAN_RING_SIZE][MC_FDCAN_PACKET_SIZE];
+static uint16_t hPacketLength[MC_FDCAN_RING_SIZE];
+static volatile uint8_t bPacketWrite;
+static volatile uint8_t bPacketRead;
+static uint8_t ForwardFrame[MC_FDCAN_FRAME_SIZE];
+static uint8_t ForwardAnswer[MC_FDCAN_FRAME_SIZE];
+static uint8_t bForwardNode;
+static uint8_t bForwardNumber;
+static uint32_t wForwardTick;
+static volatile MC_FDCAN_Request_t ForwardState = MC_FDCAN_REQ_NONE;
+#endif
+
+static int16_t MC_FDCAN_GetInt16(const uint8_t *pData)
+{
+  return ((int16_t)((uint16_t)pData[0] | ((uint16_t)pData[1] << 8U)));
+}
+
+static void MC_FDCAN_PutInt16(uint8_t *pData, int16_t hValue)
+{
+  pData[0] = (uint8_t)((uint16_t)hValue);
+  pData[1] = (uint8_t)((uint16_t)hValue >> 8U);
+}
+
+static void MC_FDCAN_InitTxHeader(FDCAN_TxHeaderTypeDef *pHeader, uint32_t wIdentifier, uint32_t wDataLength)
+{
+  pHeader->Identifier = wIdentifier;
+  pHeader->IdType = FDCAN_STANDARD_ID;
+  pHeader->TxFrameType = FDCAN_DATA_FRAME;
+  pHeader->DataLength = wDataLength;
+  pHeader->ErrorStateIndicator = FDCAN_ESI_ACTIVE;
+  pHeader->BitRateSwitch = FDCAN_BRS_ON;
+  pHeader->FDFormat = FDCAN_FD_CAN;
+  pHeader->TxEventFifoControl = FDCAN_NO_TX_EVENTS;
+  pHeader->MessageMarker = 0U;
+}
+
+static void MC_FDCAN_ExecSlot(const uint8_t *pSlot)
+{
+  MCI_Handle_t *pMCI = &Mci[M1];
+  uint8_t bRising = pSlot[1] & (uint8_t)~bPrevControl;
+  qd_t Iqdref;
+
+  switch (pSlot[0])
+  {
+    case MC_FDCAN_CMD_TORQUE:
+    {
+      Iqdref.q = MC_FDCAN_GetInt16(&pSlot[2]);
+      Iqdref.d = MC_FDCAN_GetInt16(&pSlot[4]);
+      MCI_SetCurrentReferences(pMCI, Iqdref);
+      break;
+    }
+
+    case MC_FDCAN_CMD_SPEED:
+    {
+      MCI_ExecSpeedRamp(pMCI, MC_FDCAN_GetInt16(&pSlot[2]), 0U);
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  /* After the references, so that a start of the same frame is done with them */
+  if ((bRising & MC_FDCAN_CTRL_ACK) != 0U)
+  {
+    (void)MCI_FaultAcknowledged(pMCI);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  if ((bRising & MC_FDCAN_CTRL_STOP) != 0U)
+  {
+    (void)MCI_StopMotor(pMCI);
+  }
+  else if ((bRising & MC_FDCAN_CTRL_START) != 0U)
+  {
+    (void)MCI_StartMotor(pMCI);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  bPrevControl = pSlot[1];
+  hSequence = (uint16_t)MC_FDCAN_GetInt16(&pSlot[6]);
+}
+
+static void MC_FDCAN_SendFeedback(void)
+{
+  MCI_Handle_t *pMCI = &Mci[M1];
+  uint8_t bData[MC_FDCAN_FEEDBACK_SIZE];
+  qd_t Iqd = MCI_GetIqd(pMCI);
+
+  MC_FDCAN_PutInt16(&bData[0], Iqd.q);
+  MC_FDCAN_PutInt16(&bData[2], Iqd.d);
+  MC_FDCAN_PutInt16(&bData[4], MCI_GetAvrgMecSpeedUnit(pMCI));
+  bData[6] = (uint8_t)MCI_GetSTMState(pMCI);
+  bData[7] = 0U;
+  MC_FDCAN_PutInt16(&bData[8], (int16_t)MCI_GetCurrentFaults(pMCI));
+  MC_FDCAN_PutInt16(&bData[10], (int16_t)hSequence);
+
+  if (HAL_FDCAN_AddMessageToTxFifoQ(&hfdcan1, &FeedbackHeader, bData) != HAL_OK)
+  {
+    wLostFeedbacks++;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+  * @brief  Configures the filter and the notifications of FDCAN1, initialized by
+  *         MX_FDCAN1_Init(), and starts it. To be called once the motor control
+  *         is initialized, since the commands are executed from the first frame.
+  */
+void MC_FDCAN_Start(void)
+{
+  FDCAN_FilterTypeDef sFilterConfig = {0};
+
+  /* The command frame is received in FIFO 0, alone */
+  sFilterConfig.IdType = FDCAN_STANDARD_ID;
+  sFilterConfig.FilterIndex = 0U;
+  sFilterConfig.FilterType = FDCAN_FILTER_DUAL;
+  sFilterConfig.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
+  sFilterConfig.FilterID1 = MC_FDCAN_COMMAND_ID;
+  sFilterConfig.FilterID2 = MC_FDCAN_COMMAND_ID;
+  if (HAL_FDCAN_ConfigFilter(&hfdcan1, &sFilterConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#ifdef MC_FDCAN_PEER
+  /* Requests forwarded by the gateway to the drive, in FIFO 1 */
+  sFilterConfig.FilterIndex = 1U;
+  sFilterConfig.FilterConfig = FDCAN_FILTER_TO_RXFIFO1;
+  sFilterConfig.FilterID1 = MC_FDCAN_REQUEST_ID + MC_FDCAN_NODE;
+  sFilterConfig.FilterID2 = MC_FDCAN_REQUEST_ID + MC_FDCAN_NODE;
+  if (HAL_FDCAN_ConfigFilter(&hfdcan1, &sFilterConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#endif
+#ifdef MC_FDCAN_GATEWAY
+  /* Telemetry and answers of all the peers, in FIFO 1 */
+  sFilterConfig.FilterIndex = 1U;
+  sFilterConfig.FilterType = FDCAN_FILTER_RANGE;
+  sFilterConfig.FilterConfig = FDCAN_FILTER_TO_RXFIFO1;
+  sFilterConfig.FilterID1 = MC_FDCAN_TELEMETRY_ID + 1U;
+  sFilterConfig.FilterID2 = MC_FDCAN_TELEMETRY_ID + MC_FDCAN_MAX_NODES - 1U;
+  if (HAL_FDCAN_ConfigFilter(&hfdcan1, &sFilterConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  sFilterConfig.FilterIndex = 2U;
+  sFilterConfig.FilterID1 = MC_FDCAN_ANSWER_ID + 1U;
+  sFilterConfig.FilterID2 = MC_FDCAN_ANSWER_ID + MC_FDCAN_MAX_NODES - 1U;
+  if (HAL_FDCAN_ConfigFilter(&hfdcan1, &sFilterConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#endif
+  if (HAL_FDCAN_ConfigGlobalFilter(&hfdcan1, FDCAN_REJECT, FDCAN_REJECT, FDCAN_REJECT_REMOTE,
+                                   FDCAN_REJECT_REMOTE) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* A late command is replaced by the newer one instead of being dropped */
+  if (HAL_FDCAN_ConfigRxFifoOverwrite(&hfdcan1, FDCAN_RX_FIFO0, FDCAN_RX_FIFO_OVERWRITE) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* Transceiver loop delay, measured at the sample point of the data phase */
+  if (HAL_FDCAN_ConfigTxDelayCompensation(&hfdcan1,
+                                          hfdcan1.Init.DataPrescaler * hfdcan1.Init.DataTimeSeg1, 0U) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  if (HAL_FDCAN_EnableTxDelayCompensation(&hfdcan1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  if (HAL_FDCAN_ActivateNotification(&hfdcan1, FDCAN_IT_RX_FIFO0_NEW_MESSAGE, 0U) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#ifdef MC_FDCAN_SHARED_LINK
+  /* Unlike FIFO 0, FIFO 1 keeps the oldest frames when it is full */
+  if (HAL_FDCAN_ActivateNotification(&hfdcan1, FDCAN_IT_RX_FIFO1_NEW_MESSAGE, 0U) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#endif
+#ifdef MC_FDCAN_SYNC
+  /* Start of frame of the command frame, the sync event of the carrier */
+  if (HAL_FDCAN_ConfigTimestampCounter(&hfdcan1, FDCAN_TIMESTAMP_PRESC_1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  if (HAL_FDCAN_EnableTimestampCounter(&hfdcan1, FDCAN_TIMESTAMP_INTERNAL) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#endif
+
+  MC_FDCAN_InitTxHeader(&FeedbackHeader, MC_FDCAN_FEEDBACK_ID + MC_FDCAN_NODE, FDCAN_DLC_BYTES_12);
+#ifdef MC_FDCAN_PEER
+  MC_FDCAN_InitTxHeader(&TelemetryHeader, MC_FDCAN_TELEMETRY_ID + MC_FDCAN_NODE, FDCAN_DLC_BYTES_64);
+  MC_FDCAN_InitTxHeader(&AnswerHeader, MC_FDCAN_ANSWER_ID + MC_FDCAN_NODE, FDCAN_DLC_BYTES_64);
+#endif
+#ifdef MC_FDCAN_GATEWAY
+  /* The identifier is the one of the peer of each request */
+  MC_FDCAN_InitTxHeader(&RequestHeader, MC_FDCAN_REQUEST_ID, FDCAN_DLC_BYTES_64);
+#endif
+  bPrevControl = 0U;
+
+  if (HAL_FDCAN_Start(&hfdcan1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+/**
+  * @brief  Sequence number of the last command frame
+  */
+uint16_t MC_FDCAN_GetSequence(void)
+{
+  return (hSequence);
+}
+
+/**
+  * @brief  Number of feedback frames lost since the start, the Tx FIFO being full
+  */
+uint32_t MC_FDCAN_GetLostFeedbacks(void)
+{
+  return (wLostFeedbacks);
+}
+
+/**
+  * @brief  Executes the slot of the drive in the last command frame and answers
+  *         with the feedback frame. Called by HAL_FDCAN_IRQHandler().
+  */
+void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs)
+{
+  FDCAN_RxHeaderTypeDef RxHeader;
+  uint8_t bData[64];
+  bool bReceived = false;
+#ifdef MC_FDCAN_SYNC
+  uint16_t hElapsed;
+#endif
+
+  if ((RxFifo0ITs & FDCAN_IT_RX_FIFO0_NEW_MESSAGE) != 0U)
+  {
+    /* Only the newest command is executed if several are pending */
+    while (HAL_FDCAN_GetRxFifoFillLevel(hfdcan, FDCAN_RX_FIFO0) > 0U)
+    {
+      if (HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO0, &RxHeader, bData) == HAL_OK)
+      {
+        bReceived = (FdcanDlcBytes[RxHeader.DataLength >> 16U] >= MC_FDCAN_SLOT_END);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+
+    if (bReceived)
+    {
+#ifdef MC_FDCAN_SYNC
+      __disable_irq();
+      hElapsed = (uint16_t)(HAL_FDCAN_GetTimestampCounter(hfdcan) - (uint16_t)RxHeader.RxTimestamp);
+      MC_PwmSync_Event((uint32_t)hElapsed * MC_FDCAN_TIMESTAMP_TICKS);
+      __enable_irq();
+#endif
+      MC_FDCAN_ExecSlot(&bData[MC_FDCAN_NODE * MC_FDCAN_SLOT_SIZE]);
+      MC_FDCAN_SendFeedback();
+#ifdef MC_FDCAN_PEER
+      /* Written at once: the deferred high frequency task, above, counts the periods */
+      wCycle = (uint32_t)hSequence << 16U;
+#endif
+#ifdef MC_FDCAN_GATEWAY
+      SeqHistory[hSequence % MC_FDCAN_SEQ_HISTORY].wTimestamp = GLOBAL_TIMESTAMP;
+      SeqHistory[hSequence % MC_FDCAN_SEQ_HISTORY].hSequence = hSequence;
+      SeqHistory[hSequence % MC_FDCAN_SEQ_HISTORY].Valid = true;
+#endif
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+#ifdef MC_FDCAN_PEER
+/**
+  * @brief  Samples the currents and the voltages every MC_FDCAN_TELEMETRY_DECIMATION
+  *         FOC periods in the frame at the write index of the ring, and moves to the
+  *         next frame once this one is full. Called by the deferred high frequency task,
+  *         once per FOC period: the FDCAN interrupt, below, does not split it.
+  */
+void MC_FDCAN_Sample(void)
+{
+  uint32_t wNow = wCycle;
+
+  /* The periods stop at 0xFFFF without command frame, the gateway then drops the frames */
+  if ((wNow & 0xFFFFU) != 0xFFFFU)
+  {
+    wNow++;
+    wCycle = wNow;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  if (bTelemetryCount > 0U)
+  {
+    bTelemetryCount--;
+  }
+  else
+  {
+    MCI_Handle_t *pMCI = &Mci[M1];
+    uint8_t *pFrame = TelemetryFrames[bTelemetryWrite];
+    uint8_t *pSample = &pFrame[8U + (8U * (uint32_t)bTelemetrySamples)];
+    qd_t Iqd = MCI_GetIqd(pMCI);
+    qd_t Vqd = MCI_GetVqd(pMCI);
+
+    bTelemetryCount = (uint8_t)(MC_FDCAN_TELEMETRY_DECIMATION - 1U);
+    if (0U == bTelemetrySamples)
+    {
+      MC_FDCAN_PutInt16(&pFrame[0], (int16_t)(uint16_t)(wNow >> 16U));
+      MC_FDCAN_PutInt16(&pFrame[2], (int16_t)(uint16_t)wNow);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    MC_FDCAN_PutInt16(&pSample[0], Iqd.q);
+    MC_FDCAN_PutInt16(&pSample[2], Iqd.d);
+    MC_FDCAN_PutInt16(&pSample[4], Vqd.q);
+    MC_FDCAN_PutInt16(&pSample[6], Vqd.d);
+    bTelemetrySamples++;
+
+    if (MC_FDCAN_TELEMETRY_SAMPLES == bTelemetrySamples)
+    {
+      uint8_t bNext = MC_FDCAN_NEXT(bTelemetryWrite);
+
+      pFrame[4] = MC_FDCAN_TELEMETRY_SAMPLES;
+      pFrame[5] = (uint8_t)MC_FDCAN_TELEMETRY_DECIMATION;
+      pFrame[6] = (uint8_t)MCI_GetSTMState(pMCI);
+      pFrame[7] = 0U;
+      bTelemetrySamples = 0U;
+      if (bNext != bTelemetryRead)
+      {
+        bTelemetryWrite = bNext;
+      }
+      else
+      {
+        /* Nothing to do, the ring is full: the frame is filled again, and the host sees
+           the gap in the timestamps */
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+}
+
+/**
+  * @brief  Executes the request forwarded by the gateway, if any, and builds its answer,
+  *         sent by the next medium frequency task. Called by the main loop, as the
+  *         requests of the host.
+  */
+void MC_FDCAN_ExecRequest(void)
+{
+  MCP_Handle_t PeerMCP;
+
+  if (MC_FDCAN_REQ_QUEUED == RequestState)
+  {
+    PeerMCP.pTransportLayer = &PeerTransport;
+    PeerMCP.rxBuffer = &RequestFrame[2];
+    PeerMCP.rxLength = RequestFrame[1];
+    PeerMCP.txBuffer = &AnswerFrame[2];
+    if ((PeerMCP.rxLength < MCP_HEADER_SIZE) || (PeerMCP.rxLength > MC_FDCAN_MCP_MAX_BYTES))
+    {
+      PeerMCP.txBuffer[0] = MCP_CMD_NOK;
+      PeerMCP.txLength = 1U;
+    }
+    else
+    {
+      MCP_ReceivedPacket(&PeerMCP);
+    }
+    AnswerFrame[0] = RequestFrame[0];
+    AnswerFrame[1] = (uint8_t)PeerMCP.txLength;
+    /* Raised last: the answer is complete when the medium frequency task reads it */
+    RequestState = MC_FDCAN_REQ_ANSWERED;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+#endif
+
+#ifdef MC_FDCAN_GATEWAY
+/**
+  * @brief  Dates the samples of a telemetry frame on GLOBAL_TIMESTAMP and queues them as
+  *         an async packet for the deferred high frequency task
+  */
+static void MC_FDCAN_ReceiveTelemetry(uint8_t bNode, const uint8_t *pData)
+{
+  uint16_t hSeq = (uint16_t)MC_FDCAN_GetInt16(&pData[0]);
+  uint16_t hPeriods = (uint16_t)MC_FDCAN_GetInt16(&pData[2]);
+  const MC_FDCAN_SeqStamp_t *pStamp = &SeqHistory[hSeq % MC_FDCAN_SEQ_HISTORY];
+  uint8_t bNext = MC_FDCAN_NEXT(bPacketWrite);
+  uint8_t bSamples = pData[4];
+
+  if ((false == pStamp->Valid) || (pStamp->hSequence != hSeq) || (0xFFFFU == hPeriods)
+      || (bSamples > MC_FDCAN_TELEMETRY_SAMPLES) || (bNext == bPacketRead))
+  {
+    /* Nothing to do, the frame cannot be dated or the ring is full */
+  }
+  else
+  {
+    uint8_t *pPacket = TelemetryPackets[bPacketWrite];
+    uint32_t wTimestamp = pStamp->wTimestamp + (uint32_t)hPeriods;
+    uint16_t hLength = 8U + (8U * (uint16_t)bSamples);
+
+    (void)memcpy(pPacket, &wTimestamp, sizeof(wTimestamp));
+    pPacket[4] = bNode;
+    pPacket[5] = bSamples;
+    pPacket[6] = pData[5];
+    pPacket[7] = pData[6];
+    (void)memcpy(&pPacket[8], &pData[8], 8U * (uint32_t)bSamples);
+    /* Null mark and async ID, as the end of a datalog buffer */
+    pPacket[hLength] = 0U;
+    pPacket[hLength + 1U] = MC_FDCAN_ASYNC_ID;
+    hPacketLength[bPacketWrite] = hLength + 2U;
+    /* Raised last: the packet is complete when the deferred task reads it */
+    bPacketWrite = bNext;
+  }
+}
+
+/**
+  * @brief  Hands the oldest telemetry packet to the transport. It is called by the
+  *         deferred high frequency task after the datalog, between two of its buffers,
+  *         as MC_Report_Send.
+  */
+void MC_FDCAN_SendTelemetry(MCPA_Handle_t *pMCPA)
+{
+  uint8_t bRead = bPacketRead;
+  uint8_t *pBuffer;
+
+  if ((bRead == bPacketWrite) || (pMCPA->bufferIndex != 0U))
+  {
+    /* Nothing to do */
+  }
+  else if (0U == pMCPA->pTransportLayer->fGetBuffer(pMCPA->pTransportLayer,
+                                                    (void **)&pBuffer, //cstat !MISRAC2012-Rule-11.3
+                                                    MCTL_ASYNC))
+  {
+    /* Nothing to do, tried again at the next period */
+  }
+  else
+  {
+    (void)memcpy(pBuffer, TelemetryPackets[bRead], hPacketLength[bRead]);
+    (void)pMCPA->pTransportLayer->fSendPacket(pMCPA->pTransportLayer, pBuffer, hPacketLength[bRead], MCTL_ASYNC);
+    bPacketRead = MC_FDCAN_NEXT(bRead);
+  }
+}
+
+/**
+  * @brief  Queues the request of the host for the peer addressed by its MCP header, sent
+  *         by the next medium frequency task. Called by the main loop, with the
+  *         synchronous buffer of the answer held until MC_FDCAN_GetForwardAnswer returns
+  *         true.
+  * @retval bool False if the request is for the gateway itself
+  */
+bool MC_FDCAN_Forward(const MCP_Handle_t *pMCP)
+{
+  uint16_t hHeader = (uint16_t)pMCP->rxBuffer[0] | ((uint16_t)pMCP->rxBuffer[1] << 8U);
+  uint8_t bNode = (uint8_t)((hHeader - 1U) & MOTOR_MASK);
+  bool bForwarded = (bNode != 0U);
+
+  if (false == bForwarded)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    bForwardNode = bNode;
+    bForwardNumber++;
+    wForwardTick = HAL_GetTick();
+    if (pMCP->rxLength > MC_FDCAN_MCP_MAX_BYTES)
+    {
+      ForwardAnswer[1] = 1U;
+      ForwardAnswer[2] = MCP_CMD_NOK;
+      ForwardState = MC_FDCAN_REQ_ANSWERED;
+    }
+    else
+    {
+      ForwardFrame[0] = bForwardNumber;
+      ForwardFrame[1] = (uint8_t)pMCP->rxLength;
+      (void)memcpy(&ForwardFrame[2], pMCP->rxBuffer, pMCP->rxLength);
+      /* Motor 1 of the peer */
+      ForwardFrame[2] = (uint8_t)((hHeader & (uint16_t)~MOTOR_MASK) | 1U);
+      RequestHeader.Identifier = MC_FDCAN_REQUEST_ID + (uint32_t)bNode;
+      /* Raised last: the request is complete when the medium frequency task reads it */
+      ForwardState = MC_FDCAN_REQ_QUEUED;
+    }
+  }
+  return (bForwarded);
+}
+
+bool MC_FDCAN_IsForwarding(void)
+{
+  return (ForwardState != MC_FDCAN_REQ_NONE);
+}
+
+/**
+  * @brief  Copies the answer of the peer to the synchronous buffer of the host once it
+  *         is received, or MCP_CMD_NOK after MC_FDCAN_MCP_TIMEOUT_MS
+  * @retval bool True once the answer is in the buffer, to be sent
+  */
+bool MC_FDCAN_GetForwardAnswer(MCP_Handle_t *pMCP)
+{
+  bool bDone = true;
+
+  if ((MC_FDCAN_REQ_ANSWERED == ForwardState)
+      && ((uint16_t)ForwardAnswer[1] <= pMCP->pTransportLayer->txSyncMaxPayload))
+  {
+    (void)memcpy(pMCP->txBuffer, &ForwardAnswer[2], ForwardAnswer[1]);
+    pMCP->txLength = ForwardAnswer[1];
+  }
+  else if (MC_FDCAN_REQ_ANSWERED == ForwardState)
+  {
+    pMCP->txBuffer[0] = MCP_ERROR_NO_TXSYNC_SPACE;
+    pMCP->txLength = 1U;
+  }
+  else if ((HAL_GetTick() - wForwardTick) >= MC_FDCAN_MCP_TIMEOUT_MS)
+  {
+    pMCP->txBuffer[0] = MCP_CMD_NOK;
+    pMCP->txLength = 1U;
+  }
+  else
+  {
+    bDone = false;
+  }
+
+  if (true == bDone)
+  {
+    ForwardState = MC_FDCAN_REQ_NONE;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bDone);
+}
+#endif
+
+#ifdef MC_FDCAN_SHARED_LINK
+/**
+  * @brief  Sends the frames queued by the deferred high frequency task and the main loop.
+  *         Called by the medium frequency task, that the FDCAN interrupt does not
+  *         preempt: the Tx FIFO is only written at this priority. A frame that does not
+  *         fit in the Tx FIFO is sent by the next task.
+  */
+void MC_FDCAN_Exec(void)
+{
+#ifdef MC_FDCAN_PEER
+  bool bQueued = true;
+
+  while ((bTelemetryRead != bTelemetryWrite) && (true == bQueued))
+  {
+    bQueued = (HAL_FDCAN_AddMessageToTxFifoQ(&hfdcan1, &TelemetryHeader, TelemetryFrames[bTelemetryRead]) == HAL_OK);
+    if (true == bQueued)
+    {
+      bTelemetryRead = MC_FDCAN_NEXT(bTelemetryRead);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  if ((MC_FDCAN_REQ_ANSWERED == RequestState)
+      && (HAL_FDCAN_AddMessageToTxFifoQ(&hfdcan1, &AnswerHeader, AnswerFrame) == HAL_OK))
+  {
+    RequestState = MC_FDCAN_REQ_NONE;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+#ifdef MC_FDCAN_GATEWAY
+  if ((MC_FDCAN_REQ_QUEUED == ForwardState)
+      && (HAL_FDCAN_AddMessageToTxFifoQ(&hfdcan1, &RequestHeader, ForwardFrame) == HAL_OK))
+  {
+    ForwardState = MC_FDCAN_REQ_SENT;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+}
+
+/**
+  * @brief  Receives the frames of the gateway or of its peers. Called by
+  *         HAL_FDCAN_IRQHandler().
+  */
+void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo1ITs)
+{
+  FDCAN_RxHeaderTypeDef RxHeader;
+  uint8_t bData[MC_FDCAN_FRAME_SIZE];
+
+  if ((RxFifo1ITs & FDCAN_IT_RX_FIFO1_NEW_MESSAGE) != 0U)
+  {
+    /* Unlike the commands, every frame is processed */
+    while (HAL_FDCAN_GetRxFifoFillLevel(hfdcan, FDCAN_RX_FIFO1) > 0U)
+    {
+      if ((HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO1, &RxHeader, bData) != HAL_OK)
+          || (FdcanDlcBytes[RxHeader.DataLength >> 16U] < MC_FDCAN_FRAME_SIZE))
+      {
+        /* Nothing to do */
+      }
+#ifdef MC_FDCAN_PEER
+      else if (MC_FDCAN_REQ_NONE == RequestState)
+      {
+        (void)memcpy(RequestFrame, bData, MC_FDCAN_FRAME_SIZE);
+        RequestState = MC_FDCAN_REQ_QUEUED;
+      }
+#endif
+#ifdef MC_FDCAN_GATEWAY
+      else if (RxHeader.Identifier < MC_FDCAN_ANSWER_ID)
+      {
+        MC_FDCAN_ReceiveTelemetry((uint8_t)(RxHeader.Identifier - MC_FDCAN_TELEMETRY_ID), bData);
+      }
+      else if ((MC_FDCAN_REQ_SENT == ForwardState) && (bData[0] == bForwardNumber)
+               && ((RxHeader.Identifier - MC_FDCAN_ANSWER_ID) == (uint32_t)bForwardNode)
+               && (bData[1] >= 1U) && (bData[1] <= MC_FDCAN_MCP_MAX_BYTES))
+      {
+        (void)memcpy(ForwardAnswer, bData, MC_FDCAN_FRAME_SIZE);
+        ForwardState = MC_FDCAN_REQ_ANSWERED;
+      }
+#endif
+      else
+      {
+        /* Nothing to do, the previous request of the gateway is not answered, or a
+           late answer */
+      }
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+#endif
+
+#endif /* MC_FDCAN_MODE */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -36,7 +36,46 @@
 
 /* Private macro -------------------------------------------------------------*/
 
-#define divSQRT_3 (int32_t)0x49E6    /* 1/sqrt(3) in q1.15 format=0.5773315*/
+#ifndef MC_BOARD_CORDIC
+/* Quarter wave sine table of the boards without CORDIC */
+#define SIN_COS_TABLE {\
+    0x0000,0x00C9,0x0192,0x025B,0x0324,0x03ED,0x04B6,0x057F,\
+    0x0648,0x0711,0x07D9,0x08A2,0x096A,0x0A33,0x0AFB,0x0BC4,\
+    0x0C8C,0x0D54,0x0E1C,0x0EE3,0x0FAB,0x1072,0x113A,0x1201,\
+    0x12C8,0x138F,0x1455,0x151C,0x15E2,0x16A8,0x176E,0x1833,\
+    0x18F9,0x19BE,0x1A82,0x1B47,0x1C0B,0x1CCF,0x1D93,0x1E57,\
+    0x1F1A,0x1FDD,0x209F,0x2161,0x2223,0x22E5,0x23A6,0x2467,\
+    0x2528,0x25E8,0x26A8,0x2767,0x2826,0x28E5,0x29A3,0x2A61,\
+    0x2B1F,0x2BDC,0x2C99,0x2D55,0x2E11,0x2ECC,0x2F87,0x3041,\
+    0x30FB,0x31B5,0x326E,0x3326,0x33DF,0x3496,0x354D,0x3604,\
+    0x36BA,0x376F,0x3824,0x38D9,0x398C,0x3A40,0x3AF2,0x3BA5,\
+    0x3C56,0x3D07,0x3DB8,0x3E68,0x3F17,0x3FC5,0x4073,0x4121,\
+    0x41CE,0x427A,0x4325,0x43D0,0x447A,0x4524,0x45CD,0x4675,\
+    0x471C,0x47C3,0x4869,0x490F,0x49B4,0x4A58,0x4AFB,0x4B9D,\
+    0x4C3F,0x4CE0,0x4D81,0x4E20,0x4EBF,0x4F5D,0x4FFB,0x5097,\
+    0x5133,0x51CE,0x5268,0x5302,0x539B,0x5432,0x54C9,0x5560,\
+    0x55F5,0x568A,0x571D,0x57B0,0x5842,0x58D3,0x5964,0x59F3,\
+    0x5A82,0x5B0F,0x5B9C,0x5C28,0x5CB3,0x5D3E,0x5DC7,0x5E4F,\
+    0x5ED7,0x5F5D,0x5FE3,0x6068,0x60EB,0x616E,0x61F0,0x6271,\
+    0x62F1,0x6370,0x63EE,0x646C,0x64E8,0x6563,0x65DD,0x6656,\
+    0x66CF,0x6746,0x67BC,0x6832,0x68A6,0x6919,0x698B,0x69FD,\
+    0x6A6D,0x6ADC,0x6B4A,0x6BB7,0x6C23,0x6C8E,0x6CF8,0x6D61,\
+    0x6DC9,0x6E30,0x6E96,0x6EFB,0x6F5E,0x6FC1,0x7022,0x7083,\
+    0x70E2,0x7140,0x719D,0x71F9,0x7254,0x72AE,0x7307,0x735E,\
+    0x73B5,0x740A,0x745F,0x74B2,0x7504,0x7555,0x75A5,0x75F3,\
+    0x7641,0x768D,0x76D8,0x7722,0x776B,0x77B3,0x77FA,0x783F,\
+    0x7884,0x78C7,0x7909,0x794A,0x7989,0x79C8,0x7A05,0x7A41,\
+    0x7A7C,0x7AB6,0x7AEE,0x7B26,0x7B5C,0x7B91,0x7BC5,0x7BF8,\
+    0x7C29,0x7C59,0x7C88,0x7CB6,0x7CE3,0x7D0E,0x7D39,0x7D62,\
+    0x7D89,0x7DB0,0x7DD5,0x7DFA,0x7E1D,0x7E3E,0x7E5F,0x7E7E,\
+    0x7E9C,0x7EB9,0x7ED5,0x7EEF,0x7F09,0x7F21,0x7F37,0x7F4D,\
+    0x7F61,0x7F74,0x7F86,0x7F97,0x7FA6,0x7FB4,0x7FC1,0x7FCD,\
+    0x7FD8,0x7FE1,0x7FE9,0x7FF0,0x7FF5,0x7FF9,0x7FFD,0x7FFE,\
+    0x7FFF}
+
+/* Private variables ---------------------------------------------------------*/
+const int16_t hSin_Cos_Table[SIN_TABLE_SIZE] = SIN_COS_TABLE;
+#endif /* MC_BOARD_CORDIC */
 
 #if defined (CCMRAM)
 #if defined (__ICCARM__)
@@ -44,6 +83,8 @@
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function transforms stator values a and b (which are
@@ -56,53 +97,7 @@ __attribute__( ( section ( ".ccmram" ) ) )
   */
 __weak alphabeta_t MCM_Clarke(ab_t Input)
 {
-  alphabeta_t Output;
-
-  int32_t a_divSQRT3_tmp;
-  int32_t b_divSQRT3_tmp;
-  int32_t wbeta_tmp;
-  int16_t hbeta_tmp;
-
-  /* qIalpha = qIas*/
-  Output.alpha = Input.a;
-
-  a_divSQRT3_tmp = divSQRT_3 * ((int32_t)Input.a);
-
-  b_divSQRT3_tmp = divSQRT_3 * ((int32_t)Input.b);
-
-  /*qIbeta = -(2*qIbs+qIas)/sqrt(3)*/
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-    the compiler to perform the shift (instead of LSR logical shift right) */
-  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-  wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) >> 15;
-#else
-  wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) / 32768;
-#endif
-
-  /* Check saturation of Ibeta */
-  if (wbeta_tmp > INT16_MAX)
-  {
-    hbeta_tmp = INT16_MAX;
-  }
-  else if (wbeta_tmp < (-32768))
-  {
-    hbeta_tmp =  ((int16_t)-32768);
-  }
-  else
-  {
-    hbeta_tmp = ((int16_t)wbeta_tmp);
-  }
-
-  Output.beta = hbeta_tmp;
-
-  if (((int16_t )-32768) == Output.beta)
-  {
-    Output.beta = -32767;
-  }
-
-  return (Output);
+  return (MCM_Clarke_Inline(Input));
 }
 
 #if defined (CCMRAM)
@@ -111,6 +106,8 @@ __weak alphabeta_t MCM_Clarke(ab_t Input)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function transforms stator values alpha and beta, which
@@ -124,92 +121,7 @@ __attribute__( ( section ( ".ccmram" ) ) )
   */
 __weak qd_t MCM_Park(alphabeta_t Input, int16_t Theta)
 {
-  qd_t Output;
-  int32_t d_tmp_1;
-  int32_t d_tmp_2;
-  int32_t q_tmp_1;
-  int32_t q_tmp_2;
-  int32_t wqd_tmp;
-  int16_t hqd_tmp;
-  Trig_Components Local_Vector_Components;
-
-  Local_Vector_Components = MCM_Trig_Functions(Theta);
-
-  /*No overflow guaranteed*/
-  q_tmp_1 = Input.alpha * ((int32_t )Local_Vector_Components.hCos);
-
-  /*No overflow guaranteed*/
-  q_tmp_2 = Input.beta * ((int32_t)Local_Vector_Components.hSin);
-
-  /*Iq component in Q1.15 Format */
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-    the compiler to perform the shift (instead of LSR logical shift right) */
-  wqd_tmp = (q_tmp_1 - q_tmp_2) >> 15; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-#else
-  wqd_tmp = (q_tmp_1 - q_tmp_2) / 32768;
-#endif
-
-  /* Check saturation of Iq */
-  if (wqd_tmp > INT16_MAX)
-  {
-    hqd_tmp = INT16_MAX;
-  }
-  else if (wqd_tmp < (-32768))
-  {
-    hqd_tmp = ((int16_t)-32768);
-  }
-  else
-  {
-    hqd_tmp = ((int16_t)wqd_tmp);
-  }
-
-  Output.q = hqd_tmp;
-
-  if (((int16_t )-32768) == Output.q)
-  {
-    Output.q = -32767;
-  }
-
-  /*No overflow guaranteed*/
-  d_tmp_1 = Input.alpha * ((int32_t )Local_Vector_Components.hSin);
-
-  /*No overflow guaranteed*/
-  d_tmp_2 = Input.beta * ((int32_t )Local_Vector_Components.hCos);
-
-  /*Id component in Q1.15 Format */
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-    the compiler to perform the shift (instead of LSR logical shift right) */
-  wqd_tmp = (d_tmp_1 + d_tmp_2) >> 15; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-#else
-  wqd_tmp = (d_tmp_1 + d_tmp_2) / 32768;
-#endif
-
-  /* Check saturation of Id */
-  if (wqd_tmp > INT16_MAX)
-  {
-    hqd_tmp = INT16_MAX;
-  }
-  else if (wqd_tmp < (-32768))
-  {
-    hqd_tmp = ((int16_t)-32768);
-  }
-  else
-  {
-    hqd_tmp = ((int16_t)wqd_tmp);
-  }
-
-  Output.d = hqd_tmp;
-
-  if (((int16_t)-32768) == Output.d)
-  {
-    Output.d = -32767;
-  }
-
-  return (Output);
+  return (MCM_Park_Trig_Inline(Input, MCM_Trig_Functions(Theta)));
 }
 
 #if defined (CCMRAM)
@@ -218,6 +130,8 @@ __weak qd_t MCM_Park(alphabeta_t Input, int16_t Theta)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function transforms stator voltage qVq and qVd, that belong to
@@ -231,43 +145,84 @@ __attribute__( ( section ( ".ccmram" ) ) )
   */
 __weak alphabeta_t MCM_Rev_Park(qd_t Input, int16_t Theta)
 {
-  int32_t alpha_tmp1;
-  int32_t alpha_tmp2;
-  int32_t beta_tmp1;
-  int32_t beta_tmp2;
-  Trig_Components Local_Vector_Components;
-  alphabeta_t Output;
-
-  Local_Vector_Components = MCM_Trig_Functions(Theta);
-
-  /*No overflow guaranteed*/
-  alpha_tmp1 = Input.q * ((int32_t)Local_Vector_Components.hCos);
-  alpha_tmp2 = Input.d * ((int32_t)Local_Vector_Components.hSin);
+  return (MCM_Rev_Park_Trig_Inline(Input, MCM_Trig_Functions(Theta)));
+}
 
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-    the compiler to perform the shift (instead of LSR logical shift right) */
-  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-  Output.alpha = (int16_t)(((alpha_tmp1) + (alpha_tmp2)) >> 15);
-#else
-  Output.alpha = (int16_t)(((alpha_tmp1) + (alpha_tmp2)) / 32768);
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  This function carries out MCM_Clarke() and MCM_Park() in one pass and
+  *         also returns the sine and cosine of Theta, so that they can be reused
+  *         by the other transformations at the same angle.
+  *                               alpha = a
+  *                       beta = -(2*b+a)/sqrt(3)
+  *                   q= alpha *cos(Theta)- beta *sin(Theta)
+  *                   d= alpha *sin(theta)+ beta *cos(Theta)
+  *         The outputs are saturated as by MCM_Clarke() and MCM_Park().
+  * @param  Input: stator values a and b in ab_t format
+  * @param  Theta: rotating frame angular position in q1.15 format
+  * @param  pAlphabeta: stator values alpha and beta in alphabeta_t format
+  * @param  pTrig: Cos(Theta) and Sin(Theta) in Trig_Components format
+  * @retval Stator values q and d in qd_t format
+  */
+__weak qd_t MCM_ClarkePark(ab_t Input, int16_t Theta, alphabeta_t *pAlphabeta, Trig_Components *pTrig)
+{
+  *pTrig = MCM_Trig_Functions(Theta);
+  return (MCM_ClarkePark_Trig(Input, *pTrig, pAlphabeta));
+}
 
-  beta_tmp1 = Input.q * ((int32_t)Local_Vector_Components.hSin);
-  beta_tmp2 = Input.d * ((int32_t)Local_Vector_Components.hCos);
-
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-  /* WARNING: the below instruction is not MISRA compliant, user should verify
-  that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
-  the compiler to perform the shift (instead of LSR logical shift right) */
-  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-  Output.beta = (int16_t)((beta_tmp2 - beta_tmp1) >> 15);
-#else
-  Output.beta = (int16_t)((beta_tmp2 - beta_tmp1) / 32768);
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
+/**
+  * @brief  This function carries out MCM_ClarkePark() with the sine and cosine
+  *         of the angle already computed, e.g. requested with MCM_Trig_Request()
+  *         before the phase currents are read and obtained with
+  *         MCM_Trig_Collect().
+  * @param  Input: stator values a and b in ab_t format
+  * @param  Trig: Cos(Theta) and Sin(Theta) in Trig_Components format
+  * @param  pAlphabeta: stator values alpha and beta in alphabeta_t format
+  * @retval Stator values q and d in qd_t format
+  */
+__weak qd_t MCM_ClarkePark_Trig(ab_t Input, Trig_Components Trig, alphabeta_t *pAlphabeta)
+{
+  return (MCM_ClarkePark_Trig_Inline(Input, Trig, pAlphabeta));
+}
 
-  return (Output);
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  This function carries out MCM_Rev_Park() with the sine and cosine of
+  *         the angle already computed, e.g. by MCM_ClarkePark():
+  *                  Valfa= Vq*Cos(theta)+ Vd*Sin(theta)
+  *                  Vbeta=-Vq*Sin(theta)+ Vd*Cos(theta)
+  * @param  Input: stator voltage Vq and Vd in qd_t format
+  * @param  Trig: Cos(theta) and Sin(theta) in Trig_Components format
+  * @retval Stator voltage Valpha and Vbeta in qd_t format
+  */
+__weak alphabeta_t MCM_Rev_Park_Trig(qd_t Input, Trig_Components Trig)
+{
+  return (MCM_Rev_Park_Trig_Inline(Input, Trig));
 }
 
 #if defined (CCMRAM)
@@ -276,44 +231,42 @@ __weak alphabeta_t MCM_Rev_Park(qd_t Input, int16_t Theta)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function returns cosine and sine functions of the angle fed in
-  *         input
+  *         input. On the boards without CORDIC, both come from a quarter wave
+  *         table indexed by the bits of hAngle, with a linear interpolation: no
+  *         division is needed.
   * @param  hAngle: angle in q1.15 format
   * @retval Sin(angle) and Cos(angle) in Trig_Components format
   */
 
 __weak Trig_Components MCM_Trig_Functions(int16_t hAngle)
 {
-  /* MISRAC2012-violation Rule 19.2. The union keyword should not be used.
-   * If this rule is not followed, the kinds of behavior that need to be determined
-   * are:
-   * Padding  how much padding is inserted at the end of the union;
-   * Alignment  how are members of any structures within the union aligned;
-   * Endianness  is the most significant byte of a word stored at the lowest or
-   *              highest memory address;
-   * Bit-order  how are bits numbered within bytes and how are bits allocated to
-   *             bit fields.
-   * Low. Use of union (u32toi16x2). */
-  //cstat -MISRAC2012-Rule-19.2
-  union u32toi16x2 {
-    uint32_t CordicRdata;
-    Trig_Components Components;
-  } CosSin;
-  //cstat +MISRAC2012-Rule-19.2
-  /* Configure CORDIC */
-  /* Misra  violation Rule11.4 AConversionshouldnotbeperformedbetweena
-   * pointertoobject and an integer type */
-  WRITE_REG(CORDIC->CSR, CORDIC_CONFIG_COSINE);
-  /* Misra  violation Rule11.4 AConversionshouldnotbeperformedbetweena
-   * pointertoobject and an integer type */
-  LL_CORDIC_WriteData(CORDIC, ((uint32_t)0x7FFF0000) + ((uint32_t)hAngle));
-  /* Read angle */
-  /* Misra  violation Rule11.4 AConversionshouldnotbeperformedbetweena
-   * pointertoobject and an integer type */
-  CosSin.CordicRdata = LL_CORDIC_ReadData(CORDIC);
-  return (CosSin.Components); //cstat !UNION-type-punning
+  return (MCM_Trig_Functions_Inline(hAngle));
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  This function returns the cosine and sine of several angles in one
+  *         call
+  * @param  pAngles: angles in q1.15 format
+  * @param  pTrig: Cos(angle) and Sin(angle) of each angle, in the same order
+  * @param  bCount: number of angles
+  */
+__weak void MCM_Trig_Functions_Batch(const int16_t *pAngles, Trig_Components *pTrig, uint8_t bCount)
+{
+  MCM_Trig_Functions_Batch_Inline(pAngles, pTrig, bCount);
 }
 
 #if defined (CCMRAM)
@@ -322,6 +275,8 @@ __weak Trig_Components MCM_Trig_Functions(int16_t hAngle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It calculates the square root of a non-negative int32_t. It returns 0
@@ -331,32 +286,8 @@ __attribute__( ( section ( ".ccmram" ) ) )
   */
 __weak int32_t MCM_Sqrt(int32_t wInput)
 {
-  int32_t wtemprootnew;
-
-  if (wInput > 0)
-  {
-    uint32_t retVal;
-    /* disable Irq as sqrt is used in MF and HF task */
-    __disable_irq();
-    /* Configure CORDIC */
-    WRITE_REG(CORDIC->CSR, CORDIC_CONFIG_SQRT);
-    LL_CORDIC_WriteData(CORDIC, ((uint32_t)wInput));
-    /* Read sqrt and return */
-#ifndef FULL_MISRA_C_COMPLIANCY_MC_MATH
-    retVal = (LL_CORDIC_ReadData(CORDIC)) >> 15; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
-#else
-    retVal = (LL_CORDIC_ReadData(CORDIC)) / 32768U;
-#endif
-    wtemprootnew = (int32_t)retVal;
-    __enable_irq();
-
-  }
-  else
-  {
-    wtemprootnew = (int32_t)0;
-  }
-
-  return (wtemprootnew);
+  /* With the CORDIC, the interrupts are masked around it, sqrt is used in MF and HF task */
+  return (MCM_Sqrt_Inline(wInput));
 }
 
 /**
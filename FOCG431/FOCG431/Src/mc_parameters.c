@@ -27,7 +27,13 @@
 #include "parameters_conversion.h"
 #include "mc_parameters.h"
 
+#if defined (SINGLE_SHUNT)
+#include "r1_g4xx_pwm_curr_fdbk.h"
+#elif defined (ICS_SENSORS)
+#include "ics_g4xx_pwm_curr_fdbk.h"
+#else
 #include "r3_2_g4xx_pwm_curr_fdbk.h"
+#endif
 
 /* USER CODE BEGIN Additional include */
 
@@ -36,6 +42,138 @@
 #define FREQ_RATIO 1                /* Dummy value for single drive */
 #define FREQ_RELATION HIGHEST_FREQ  /* Dummy value for single drive */
 
+#if defined (SINGLE_SHUNT)
+/**
+  * @brief  Current sensor parameters Motor 1 - single shunt - G4
+  */
+R1_Params_t R1_ParamsM1 =
+{
+/* Current reading A/D Conversions initialization -----------------------------*/
+  .ADCx            = ADC1,
+  //cstat -MISRAC2012-Rule-12.1 -MISRAC2012-Rule-10.1_R6
+  /* Cost reduced board config: bus current on the shunt channel, converted twice */
+  .ADCConfig = MC_ADC_CHANNEL_1<<ADC_JSQR_JSQ1_Pos | MC_ADC_CHANNEL_1<<ADC_JSQR_JSQ2_Pos
+             | 1U<<ADC_JSQR_JL_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO2 & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT),
+  //cstat +MISRAC2012-Rule-12.1 +MISRAC2012-Rule-10.1_R6
+
+  /* PWM generation parameters --------------------------------------------------*/
+  .RepetitionCounter = REP_COUNTER,
+  .Tbefore           = TW_BEFORE,
+  .TMin              = TW_MIN,
+  .TIMx              = TIM1,
+
+/* PWM Driving signals initialization ----------------------------------------*/
+  .LowSideOutputs = (LowSideOutputsFunction_t)LOW_SIDE_SIGNALS_ENABLING,
+ .pwm_en_u_port      = M1_PWM_EN_U_GPIO_Port,
+ .pwm_en_u_pin       = M1_PWM_EN_U_Pin,
+ .pwm_en_v_port      = M1_PWM_EN_V_GPIO_Port,
+ .pwm_en_v_pin       = M1_PWM_EN_V_Pin,
+ .pwm_en_w_port      = M1_PWM_EN_W_GPIO_Port,
+ .pwm_en_w_pin       = M1_PWM_EN_W_Pin,
+
+/* Emergency input (BKIN2) signal initialization -----------------------------*/
+  .BKIN2Mode     = EXT_MODE,
+
+/* Internal OPAMP settings ---------------------------------------------------*/
+  .OPAMPx          = MC_NULL,
+/* Internal COMP settings ----------------------------------------------------*/
+  .CompOCPSelection     = MC_NULL,
+  .CompOCPInvInput_MODE = NONE,
+  .DAC_OCP_Selection    = MC_NULL,
+  .DAC_Channel_OCP      = (uint32_t) 0,
+
+  .CompOVPSelection      = MC_NULL,
+  .CompOVPInvInput_MODE  = NONE,
+  .DAC_OVP_Selection     = MC_NULL,
+  .DAC_Channel_OVP       = (uint32_t) 0,
+
+/* DAC settings --------------------------------------------------------------*/
+  .DAC_OCP_Threshold =  23830,
+  .DAC_OVP_Threshold =  23830,
+
+};
+#elif defined (ICS_SENSORS)
+/**
+  * @brief  Current sensor parameters Motor 1 - ICS - G4
+  */
+ICS_Params_t ICS_ParamsM1 =
+{
+/* Dual MC parameters --------------------------------------------------------*/
+  .FreqRatio       = FREQ_RATIO,
+  .IsHigherFreqTim = FREQ_RELATION,
+
+/* Current reading A/D Conversions initialization -----------------------------*/
+  .ADCx_1           = ADC1,
+  .ADCx_2           = ADC2,
+  //cstat -MISRAC2012-Rule-12.1 -MISRAC2012-Rule-10.1_R6
+  /* Ia on ADC1 and Ib on ADC2, triggered by the same TIMx TRGO edge */
+  .ADCConfig1 = MC_ADC_CHANNEL_1<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT),
+  .ADCConfig2 = MC_ADC_CHANNEL_7<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT),
+  //cstat +MISRAC2012-Rule-12.1 +MISRAC2012-Rule-10.1_R6
+
+  /* Current sampling parameters -----------------------------------------------*/
+  .SamplingPoint      = ICS_SAMPLING_POINT,
+  .SamplingPointState = ICS_SAMPLING_POINT_STATE,
+
+  /* PWM generation parameters --------------------------------------------------*/
+  .RepetitionCounter = REP_COUNTER,
+  .TIMx              = TIM1,
+
+/* PWM Driving signals initialization ----------------------------------------*/
+  .LowSideOutputs = (LowSideOutputsFunction_t)LOW_SIDE_SIGNALS_ENABLING,
+ .pwm_en_u_port      = M1_PWM_EN_U_GPIO_Port,
+ .pwm_en_u_pin       = M1_PWM_EN_U_Pin,
+ .pwm_en_v_port      = M1_PWM_EN_V_GPIO_Port,
+ .pwm_en_v_pin       = M1_PWM_EN_V_Pin,
+ .pwm_en_w_port      = M1_PWM_EN_W_GPIO_Port,
+ .pwm_en_w_pin       = M1_PWM_EN_W_Pin,
+
+/* Emergency input (BKIN2) signal initialization -----------------------------*/
+  .BKIN2Mode     = EXT_MODE,
+};
+#else
+#if defined (THREE_SHUNT_INTERNAL_OPAMPS)
+/**
+  * @brief  Internal OPAMP parameters Motor 1 - three shunt - G4xx - Shared Resources
+  * hard coded to the ESC G4 board, as the STSPING4 one
+  */
+R3_3_OPAMPParams_t R3_3_OPAMPParamsM1 =
+{
+  .OPAMPx_1 = OPAMP1,
+  .OPAMPx_2 = OPAMP2,
+  .OPAMPx_3 = MC_NULL,
+  /* OPAMPSelect_x is used to specify which OPAMP amplifies the current converted by the ADC */
+  .OPAMPSelect_1 = { OPAMP1
+                   , OPAMP1
+                   , OPAMP1
+                   , OPAMP1
+                   , OPAMP1
+                   , OPAMP1
+                   },
+  .OPAMPSelect_2 = { OPAMP2
+                   , OPAMP2
+                   , OPAMP2
+                   , OPAMP2
+                   , OPAMP2
+                   , OPAMP2
+                   },
+  .OPAMPConfig1 = { OPAMP1_NonInvertingInput_PA7
+                  , OPAMP1_NonInvertingInput_PA1
+                  , OPAMP1_NonInvertingInput_PA1
+                  , OPAMP1_NonInvertingInput_PA1
+                  , OPAMP1_NonInvertingInput_PA1
+                  , OPAMP1_NonInvertingInput_PA7
+                  },
+  .OPAMPConfig2 = { OPAMP2_NonInvertingInput_PB0
+                  , OPAMP2_NonInvertingInput_PB0
+                  , OPAMP2_NonInvertingInput_PB0
+                  , OPAMP2_NonInvertingInput_PA7
+                  , OPAMP2_NonInvertingInput_PA7
+                  , OPAMP2_NonInvertingInput_PB0
+                  },
+};
+#endif /* THREE_SHUNT_INTERNAL_OPAMPS */
+
 /**
   * @brief  Current sensor parameters Motor 1 - three shunt - G4
   */
@@ -55,6 +193,23 @@ R3_2_Params_t R3_2_ParamsM1 =
  * expressions should be made explicit.
  *  Medium. The operand `(MC_ADC_CHANNEL_xx<. */
   //cstat -MISRAC2012-Rule-12.1 -MISRAC2012-Rule-10.1_R6
+#if defined (THREE_SHUNT_INTERNAL_OPAMPS)
+  /* Outputs of OPAMP1 and OPAMP2 */
+  .ADCConfig1 = { MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                },
+  .ADCConfig2 = { MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                , MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
+                },
+#else
   /* Motor Control Kit config */
   .ADCConfig1 = { MC_ADC_CHANNEL_7<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
                 , MC_ADC_CHANNEL_1<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
@@ -70,6 +225,8 @@ R3_2_Params_t R3_2_ParamsM1 =
                 ,MC_ADC_CHANNEL_7<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
                 ,MC_ADC_CHANNEL_6<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
                 },
+#endif /* THREE_SHUNT_INTERNAL_OPAMPS */
+  .ADCOversampling = ADC_INJ_OVERSAMPLING,
   .ADCDataReg1 = { &ADC1->JDR1
                  , &ADC1->JDR1
                  , &ADC1->JDR1
@@ -91,6 +248,9 @@ R3_2_Params_t R3_2_ParamsM1 =
   .Tsampling         = (uint16_t)SAMPLING_TIME,
   .Tcase2            = (uint16_t)SAMPLING_TIME + (uint16_t)TDEAD + (uint16_t)TRISE,
   .Tcase3            = ((uint16_t)TDEAD + (uint16_t)TNOISE + (uint16_t)SAMPLING_TIME)/2u,
+#ifdef PWM_DOUBLE_UPDATE
+  .Tvalley           = PWM_VALLEY_CNT,
+#endif
   .TIMx               = TIM1,
 
 /* PWM Driving signals initialization ----------------------------------------*/
@@ -106,7 +266,11 @@ R3_2_Params_t R3_2_ParamsM1 =
   .BKIN2Mode     = EXT_MODE,
 
 /* Internal OPAMP common settings --------------------------------------------*/
+#if defined (THREE_SHUNT_INTERNAL_OPAMPS)
+  .OPAMPParams     = &R3_3_OPAMPParamsM1,
+#else
   .OPAMPParams     = MC_NULL,
+#endif
 /* Internal COMP settings ----------------------------------------------------*/
   .CompOCPASelection     = MC_NULL,
   .CompOCPAInvInput_MODE = NONE,
@@ -131,6 +295,7 @@ R3_2_Params_t R3_2_ParamsM1 =
   .DAC_OVP_Threshold =  23830,
 
 };
+#endif /* SINGLE_SHUNT */
 
 /* USER CODE BEGIN Additional parameters */
 
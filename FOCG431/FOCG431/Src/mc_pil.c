@@ -0,0 +1,205 @@
+/**
+  ******************************************************************************
+  * @file    mc_pil.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Processor in the loop run of the current controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "mc_pil.h"
+
+#ifdef MC_PIL_MODE
+
+static volatile MC_Pil_State_t PilState = MC_PIL_OFF;
+static volatile bool PilPending;            /* PilNext written by the host, not yet stepped */
+static MC_Pil_Input_t PilNext;
+static MC_Pil_Input_t PilStep;              /* Inputs of the running step */
+static MC_Pil_Output_t PilOutput;
+static uint16_t hPilStepRate = MC_PIL_STEP_RATE;
+static uint16_t hPilCountdown;              /* FOC periods before the next step */
+static volatile uint16_t hPilBusVoltage_d;
+static uint32_t wPilStart;
+
+/**
+ * @brief  Executes a MC_PIL_CMD_xxx command. It must be called in the IDLE state only.
+ * @retval bool False if the command is unknown
+ */
+bool MC_Pil_Command(uint8_t bCmd)
+{
+  bool bDone = true;
+
+  switch (bCmd)
+  {
+    case MC_PIL_CMD_OFF:
+    {
+      PilState = MC_PIL_OFF;
+      break;
+    }
+
+    case MC_PIL_CMD_ON:
+    {
+      CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // Enable the DWT also without debugger
+      DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;            // Enable Cycle Counter
+      PilPending = false;
+      hPilCountdown = 1U;
+      hPilBusVoltage_d = 0U;
+      PilOutput.hSeq = 0U;
+      PilOutput.hLatePeriods = 0U;
+      PilState = MC_PIL_ON;
+      break;
+    }
+
+    default:
+    {
+      bDone = false;
+      break;
+    }
+  }
+  return (bDone);
+}
+
+MC_Pil_State_t MC_Pil_GetState(void)
+{
+  return (PilState);
+}
+
+/**
+ * @brief  Sets the number of FOC periods per step, from 1
+ */
+void MC_Pil_SetStepRate(uint16_t hStepRate)
+{
+  hPilStepRate = (hStepRate > 0U) ? hStepRate : 1U;
+}
+
+uint16_t MC_Pil_GetStepRate(void)
+{
+  return (hPilStepRate);
+}
+
+/**
+ * @brief  Queues the inputs of the next step.
+ * @retval bool False if the mode is off, or if the previous inputs are not stepped yet
+ */
+bool MC_Pil_Push(const MC_Pil_Input_t *pInput)
+{
+  bool bDone = false;
+
+  if ((MC_PIL_ON == PilState) && (false == PilPending))
+  {
+    /* The high frequency task only reads PilNext once it is pending */
+    PilNext = *pInput;
+    hPilBusVoltage_d = pInput->hBusVoltage_d;
+    PilPending = true;
+    bDone = true;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bDone);
+}
+
+/**
+ * @brief  Copies the outputs of the last step, that the high frequency task may be
+ *         writing.
+ */
+void MC_Pil_GetOutput(MC_Pil_Output_t *pOutput)
+{
+  __disable_irq();
+  *pOutput = PilOutput;
+  __enable_irq();
+}
+
+/**
+ * @brief  Bus voltage of the last frame, in u16Volts, 0 if the mode is off or until
+ *         the first frame
+ */
+uint16_t MC_Pil_GetBusVoltage(void)
+{
+  return ((MC_PIL_ON == PilState) ? hPilBusVoltage_d : 0U);
+}
+
+/**
+ * @brief  Counts the FOC periods between the steps. It must be called by the high
+ *         frequency task once per FOC period.
+ * @retval bool True if FOC_CurrControllerM1 must be skipped in this period
+ */
+bool MC_Pil_IsHolding(void)
+{
+  bool bHolding = true;
+
+  if (MC_PIL_OFF == PilState)
+  {
+    bHolding = false;
+  }
+  else if (hPilCountdown > 1U)
+  {
+    hPilCountdown--;
+  }
+  else if (false == PilPending)
+  {
+    /* The step waits for its frame */
+    PilOutput.hLatePeriods = (PilOutput.hLatePeriods < UINT16_MAX) ? (PilOutput.hLatePeriods + 1U) : UINT16_MAX;
+  }
+  else
+  {
+    PilStep = PilNext;
+    PilPending = false;
+    hPilCountdown = hPilStepRate;
+    bHolding = false;
+  }
+  return (bHolding);
+}
+
+/**
+ * @brief  Starts the timing of a step. It must be called first by FOC_CurrControllerM1.
+ * @retval const MC_Pil_Input_t * Inputs of the step, MC_NULL if the mode is off
+ */
+const MC_Pil_Input_t *MC_Pil_StartStep(void)
+{
+  const MC_Pil_Input_t *pInput = MC_NULL;
+
+  if (MC_PIL_ON == PilState)
+  {
+    wPilStart = DWT->CYCCNT;
+    pInput = &PilStep;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (pInput);
+}
+
+/**
+ * @brief  Ends a step started by MC_Pil_StartStep with the voltage written in the PWM.
+ */
+void MC_Pil_EndStep(qd_t Vqd, alphabeta_t Valphabeta, uint8_t bVector, uint8_t bFlags)
+{
+  uint32_t wCycles = DWT->CYCCNT - wPilStart;
+
+  PilOutput.hVq = Vqd.q;
+  PilOutput.hVd = Vqd.d;
+  PilOutput.hValpha = Valphabeta.alpha;
+  PilOutput.hVbeta = Valphabeta.beta;
+  PilOutput.bVector = bVector;
+  PilOutput.bFlags = bFlags;
+  PilOutput.hCycles = (wCycles > UINT16_MAX) ? UINT16_MAX : (uint16_t)wCycles;
+  PilOutput.hSeq = PilStep.hSeq;
+}
+
+#endif /* MC_PIL_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,119 @@
+/**
+  ******************************************************************************
+  * @file    mc_plant.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Plant model of the motor for the closed loop runs of the controllers
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "mc_math.h"
+#include "parameters_conversion.h"
+#include "mc_plant.h"
+
+#if defined (MC_BENCH_MODE) || defined (MC_SIL)
+
+#define MC_PLANT_RAD_PER_DPP  ((float_t)(3.14159265358979 / 32768.0))
+#define MC_PLANT_SQRT3_2      ((float_t)0.866025403784439)
+
+static int16_t MC_Plant_Sat16(float_t fValue)
+{
+  return ((fValue > 32767.0f) ? INT16_MAX : ((fValue < -32767.0f) ? -INT16_MAX : (int16_t)fValue));
+}
+
+/**
+ * @brief  Sets the plant at rest, at the angle 0, with the bus voltage at its nominal value.
+ * @param  fRsScale: resistance of the plant, per unit of RS
+ * @param  fLsScale: inductance of the plant, per unit of LS
+ */
+void MC_Plant_Init(MC_Plant_t *pPlant, float_t fRsScale, float_t fLsScale)
+{
+  float_t fLs = (float_t)LS * fLsScale;
+
+  pPlant->fKDecay = 1.0f - (((float_t)RS * fRsScale) / (fLs * (float_t)TF_REGULATION_RATE));
+  pPlant->fKVolt = (float_t)PCC_KVOLT_UNIT / fLsScale;
+  pPlant->fKBemf = (float_t)PCC_KBEMF_UNIT / fLsScale;
+  pPlant->fBusScale = 1.0f;
+  pPlant->fIq = 0.0f;
+  pPlant->fId = 0.0f;
+  pPlant->hElAngle = 0;
+  pPlant->hElSpeedDpp = 0;
+}
+
+/**
+ * @brief  Sets the bus voltage, per unit of the nominal one
+ */
+void MC_Plant_SetBusScale(MC_Plant_t *pPlant, float_t fBusScale)
+{
+  pPlant->fBusScale = fBusScale;
+}
+
+/**
+ * @brief  Sets the electrical speed of the next periods, in dpp
+ */
+void MC_Plant_SetSpeed(MC_Plant_t *pPlant, int16_t hElSpeedDpp)
+{
+  pPlant->hElSpeedDpp = hElSpeedDpp;
+}
+
+/**
+ * @brief  Currents of the plant in the q/d frame, sampled at the start of the period
+ */
+qd_t MC_Plant_GetIqd(const MC_Plant_t *pPlant)
+{
+  qd_t Iqd;
+
+  Iqd.q = MC_Plant_Sat16(pPlant->fIq);
+  Iqd.d = MC_Plant_Sat16(pPlant->fId);
+  return (Iqd);
+}
+
+/**
+ * @brief  Phase currents a and b of the plant, sampled at the start of the period, in
+ *         the convention of MCM_Clarke and MCM_Park
+ */
+ab_t MC_Plant_GetIab(const MC_Plant_t *pPlant)
+{
+  Trig_Components Trig = MCM_Trig_Functions(pPlant->hElAngle);
+  float_t fCos = (float_t)Trig.hCos / 32768.0f;
+  float_t fSin = (float_t)Trig.hSin / 32768.0f;
+  float_t fAlpha = (pPlant->fIq * fCos) + (pPlant->fId * fSin);
+  float_t fBeta = (pPlant->fId * fCos) - (pPlant->fIq * fSin);
+  ab_t Iab;
+
+  Iab.a = MC_Plant_Sat16(fAlpha);
+  Iab.b = MC_Plant_Sat16((-0.5f * fAlpha) - (MC_PLANT_SQRT3_2 * fBeta));
+  return (Iab);
+}
+
+/**
+ * @brief  Integrates the currents over one FOC period with the voltage applied during it,
+ *         then moves the angle to the start of the next period.
+ * @param  Vqd: voltage of the period, in the frame of the angle at its start
+ */
+void MC_Plant_Step(MC_Plant_t *pPlant, qd_t Vqd)
+{
+  float_t fDelta = (float_t)pPlant->hElSpeedDpp * MC_PLANT_RAD_PER_DPP;
+  float_t fIqNext = (pPlant->fKDecay * pPlant->fIq) - (fDelta * pPlant->fId)
+                  + (pPlant->fKVolt * pPlant->fBusScale * (float_t)Vqd.q)
+                  - (pPlant->fKBemf * (float_t)pPlant->hElSpeedDpp);
+
+  pPlant->fId = (pPlant->fKDecay * pPlant->fId) + (fDelta * pPlant->fIq)
+              + (pPlant->fKVolt * pPlant->fBusScale * (float_t)Vqd.d);
+  pPlant->fIq = fIqNext;
+  pPlant->hElAngle = (int16_t)(pPlant->hElAngle + pPlant->hElSpeedDpp);
+}
+
+#endif /* MC_BENCH_MODE || MC_SIL */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
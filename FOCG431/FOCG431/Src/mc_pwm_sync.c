@@ -0,0 +1,140 @@
+/**
+  ******************************************************************************
+  * @file    mc_pwm_sync.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Lock of the PWM carrier of the drive on an external sync event
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "mc_config.h"
+#include "mc_pwm_sync.h"
+
+#ifdef MC_PWM_SYNC_MODE
+
+#if (MC_PWM_SYNC_SOURCE == MC_PWM_SYNC_FDCAN) && !defined(MC_FDCAN_MODE)
+#error "MC_PWM_SYNC_FDCAN requires MC_FDCAN_MODE"
+#endif
+
+#define MC_PWM_SYNC_HALF_PERIOD ((int32_t)PWM_PERIOD_CYCLES / 2)
+
+/* Gains of the PI regulator, with MC_PWM_SYNC_GAIN_LOG fractional bits: the proportional
+   term corrects half of the phase error by the next event, the integral term absorbs the
+   offset between the clocks of the drives */
+#define MC_PWM_SYNC_GAIN_LOG    4U
+#define MC_PWM_SYNC_KP          8
+
+/* Phase change over the period of the events, in timer counts, for one count of trim.
+   Each PWM period lasts two auto reloads */
+#define MC_PWM_SYNC_TRIM_STEP   (2 * (int32_t)MC_PWM_SYNC_RATIO)
+
+static int32_t wTarget;           /* MC_PWM_SYNC_PHASE in timer counts */
+static int32_t wIntegral;
+static int32_t wTrim;             /* Trim of the auto reload loaded at the last event */
+static int32_t wPhaseError;       /* Phase error of the last event, in timer counts */
+static uint16_t hLockCount;       /* Successive events within MC_PWM_SYNC_LOCK_WINDOW */
+
+/**
+  * @brief  Clears the regulator and enables the preload of the auto reload of TIM1,
+  *         that is then written at any time. To be called once the timers are started.
+  */
+void MC_PwmSync_Init(void)
+{
+  wTarget = (int32_t)(((uint32_t)MC_PWM_SYNC_PHASE * (uint32_t)PWM_PERIOD_CYCLES) >> 16U);
+  wIntegral = 0;
+  wTrim = 0;
+  wPhaseError = 0;
+  hLockCount = 0U;
+  LL_TIM_EnableARRPreload(TIM1);
+}
+
+/**
+  * @brief  Measures the phase of the carrier at the sync event and trims the auto reload
+  *         of TIM1. To be called with the interrupts disabled, so that the counter is read
+  *         at a known time after the event.
+  * @param  wElapsed Time elapsed since the event, in timer counts
+  */
+void MC_PwmSync_Event(uint32_t wElapsed)
+{
+  int32_t wPeriod = 2 * (MC_PWM_SYNC_HALF_PERIOD + wTrim);
+  int32_t wCounter = (int32_t)LL_TIM_GetCounter(TIM1);
+  int32_t wPhase;
+  int32_t wError;
+  int32_t wNewTrim;
+
+  /* Time since the last underflow. Near the turnarounds both directions give the same
+     phase, modulo the period */
+  wPhase = (LL_TIM_COUNTERDIRECTION_DOWN == LL_TIM_GetDirection(TIM1)) ? (wPeriod - wCounter) : wCounter;
+
+  /* Back to the event, and then to the error modulo the period, in [-wPeriod/2, wPeriod/2[ */
+  wError = ((wPhase - (int32_t)(wElapsed % (uint32_t)wPeriod)) - wTarget) + (2 * wPeriod);
+  wError %= wPeriod;
+  if (wError >= (wPeriod / 2))
+  {
+    wError -= wPeriod;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  /* A positive error is a carrier ahead of the event, slowed down by a longer period */
+  wNewTrim = ((wError * MC_PWM_SYNC_KP) + wIntegral) / (MC_PWM_SYNC_TRIM_STEP << MC_PWM_SYNC_GAIN_LOG);
+  if (wNewTrim > MC_PWM_SYNC_MAX_TRIM)
+  {
+    wNewTrim = MC_PWM_SYNC_MAX_TRIM;
+  }
+  else if (wNewTrim < -MC_PWM_SYNC_MAX_TRIM)
+  {
+    wNewTrim = -MC_PWM_SYNC_MAX_TRIM;
+  }
+  else
+  {
+    /* No integration while the trim saturates */
+    wIntegral += wError;
+  }
+
+  if ((wError < MC_PWM_SYNC_LOCK_WINDOW) && (wError > -MC_PWM_SYNC_LOCK_WINDOW))
+  {
+    hLockCount = (hLockCount < MC_PWM_SYNC_LOCK_EVENTS) ? (uint16_t)(hLockCount + 1U) : hLockCount;
+  }
+  else
+  {
+    hLockCount = 0U;
+  }
+
+  wTrim = wNewTrim;
+  wPhaseError = wError;
+  LL_TIM_SetAutoReload(TIM1, (uint32_t)(MC_PWM_SYNC_HALF_PERIOD + wTrim));
+}
+
+/**
+  * @brief  True once MC_PWM_SYNC_LOCK_EVENTS successive events are within
+  *         MC_PWM_SYNC_LOCK_WINDOW of MC_PWM_SYNC_PHASE
+  */
+bool MC_PwmSync_IsLocked(void)
+{
+  return (hLockCount >= MC_PWM_SYNC_LOCK_EVENTS);
+}
+
+/**
+  * @brief  Phase error of the last sync event, in timer counts
+  */
+int32_t MC_PwmSync_GetPhaseError(void)
+{
+  return (wPhaseError);
+}
+
+#endif /* MC_PWM_SYNC_MODE */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
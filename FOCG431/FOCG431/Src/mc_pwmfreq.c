@@ -0,0 +1,265 @@
+/**
+  ******************************************************************************
+  * @file    mc_pwmfreq.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Change of the PWM frequency at run time
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "mc_config.h"
+#include "parameters_conversion.h"
+#include "mc_pwmfreq.h"
+
+#ifdef MC_PWMFREQ_MODE
+
+#if defined (MC_PWM_SYNC_MODE) || defined (MC_PWM_DITHER_MODE)
+#error "MC_PWMFREQ_MODE, MC_PWM_SYNC_MODE and MC_PWM_DITHER_MODE all write the auto reload of TIM1"
+#endif
+#ifdef MC_TIMEBASE_MODE
+#error "MC_PWMFREQ_MODE does not fit MC_TIMEBASE_MODE, that counts the FOC period of the build"
+#endif
+#ifdef M1_HFI_SENSOR
+#error "MC_PWMFREQ_MODE does not scale the injection of the HFI sensor"
+#endif
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_ADAPTIVE_PERIOD)
+#error "MC_PWMFREQ_MODE does not scale the models of the decision periods of PCC_ADAPTIVE_PERIOD"
+#endif
+
+_Static_assert((MC_PWMFREQ_MIN_HZ > 0U) && (MC_PWMFREQ_MIN_HZ <= MC_PWMFREQ_MAX_HZ),
+               "MC_PWMFREQ_MIN_HZ must be above 0 and up to MC_PWMFREQ_MAX_HZ");
+_Static_assert((((uint32_t)(ADV_TIM_CLK_MHz) * 1000000UL) / MC_PWMFREQ_MIN_HZ) <= 0xFFFEUL,
+               "PWM period of MC_PWMFREQ_MIN_HZ above the range of TIM1");
+
+/* Values of a frequency, computed from the ones in use before any of them is written */
+typedef struct
+{
+  uint16_t hPeriod;                 /* PWM period, in timer counts */
+  int16_t  hIqKi;
+  int16_t  hIdKi;
+  int16_t  hPllC[5];                /* hC1 to hC5 of the PLL state observer */
+  int16_t  hPllKp;
+  int16_t  hPllKi;
+  int16_t  hCordicC[5];             /* hC1 to hC5 of the CORDIC state observer */
+  int16_t  hCordicMaxAccel;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  PCC_Tuning_t PCC;
+#endif
+} MC_PwmFreq_Set_t;
+
+/* Frequency in use, in Hz */
+static uint32_t PwmFreqHz = (uint32_t)PWM_FREQUENCY;
+
+/* hValue * wNum / wDen, rounded to the nearest, so that a return to a frequency restores
+   the gains. False if the result leaves the range of an int16_t. */
+static bool MC_PwmFreq_Scale(int16_t hValue, uint64_t wNum, uint64_t wDen, int16_t *pResult)
+{
+  int64_t lValue = (int64_t)hValue * (int64_t)wNum;
+  int64_t lHalf = (int64_t)(wDen / 2U);
+  bool bFits;
+
+  lValue = ((lValue >= 0) ? (lValue + lHalf) : (lValue - lHalf)) / (int64_t)wDen;
+  bFits = (lValue >= (int64_t)INT16_MIN) && (lValue <= (int64_t)INT16_MAX);
+  *pResult = (true == bFits) ? (int16_t)lValue : hValue;
+  return (bFits);
+}
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+/* As MC_PwmFreq_Scale, for the int32_t coefficients of the predictive controller */
+static bool MC_PwmFreq_Scale32(int32_t wValue, uint64_t wNum, uint64_t wDen, int32_t *pResult)
+{
+  int64_t lValue = (int64_t)wValue * (int64_t)wNum;
+  int64_t lHalf = (int64_t)(wDen / 2U);
+  bool bFits;
+
+  lValue = ((lValue >= 0) ? (lValue + lHalf) : (lValue - lHalf)) / (int64_t)wDen;
+  bFits = (lValue >= (int64_t)INT32_MIN) && (lValue <= (int64_t)INT32_MAX);
+  *pResult = (true == bFits) ? (int32_t)lValue : wValue;
+  return (bFits);
+}
+#endif
+
+/**
+ * @brief  Computes the values of a frequency from the ones in use. The gains follow the
+ *         period, PwmFreqHz / wFrequency, or its square.
+ * @retval bool False if the frequency is out of range, does not leave the sampling
+ *         window in the period, or scales a gain out of its range
+ */
+static bool MC_PwmFreq_Compute(uint32_t wFrequency, MC_PwmFreq_Set_t *pSet)
+{
+  uint64_t wOld = (uint64_t)PwmFreqHz;
+  uint64_t wNew = (uint64_t)wFrequency;
+  bool bFits = (wFrequency >= MC_PWMFREQ_MIN_HZ) && (wFrequency <= MC_PWMFREQ_MAX_HZ);
+
+  if (true == bFits)
+  {
+    const PWMC_SampTiming_t *pTiming = PWMC_GetSamplingTiming(&PWM_Handle_M1._Super);
+    uint16_t hHalf;
+
+    pSet->hPeriod = PWM_PERIOD_CYCLES_AT(wFrequency);
+    hHalf = pSet->hPeriod / 2U;
+    /* The timing in use, possibly calibrated, still fits in half of the period */
+    bFits = (pTiming->hTafter < hHalf) && (pTiming->hTbefore < hHalf);
+#if !defined (ICS_SENSORS)
+    bFits = bFits && (hHalf > (uint16_t)(((TW_AFTER > TW_BEFORE) ? TW_AFTER : TW_BEFORE) + 1U));
+#endif
+
+    bFits = MC_PwmFreq_Scale(PID_GetKI(&PIDIqHandle_M1), wOld, wNew, &pSet->hIqKi) && bFits;
+    bFits = MC_PwmFreq_Scale(PID_GetKI(&PIDIdHandle_M1), wOld, wNew, &pSet->hIdKi) && bFits;
+
+    bFits = MC_PwmFreq_Scale(STO_PLL_M1.hC1, wOld, wNew, &pSet->hPllC[0]) && bFits;
+    bFits = MC_PwmFreq_Scale(STO_PLL_M1.hC2, wOld, wNew, &pSet->hPllC[1]) && bFits;
+    bFits = MC_PwmFreq_Scale(STO_PLL_M1.hC3, wOld, wNew, &pSet->hPllC[2]) && bFits;
+    bFits = MC_PwmFreq_Scale(STO_PLL_M1.hC4, wOld, wNew, &pSet->hPllC[3]) && bFits;
+    bFits = MC_PwmFreq_Scale(STO_PLL_M1.hC5, wOld, wNew, &pSet->hPllC[4]) && bFits;
+    STO_GetPLLGains(&STO_PLL_M1, &pSet->hPllKp, &pSet->hPllKi);
+    bFits = MC_PwmFreq_Scale(pSet->hPllKp, wOld, wNew, &pSet->hPllKp) && bFits;
+    bFits = MC_PwmFreq_Scale(pSet->hPllKi, wOld * wOld, wNew * wNew, &pSet->hPllKi) && bFits;
+
+    bFits = MC_PwmFreq_Scale(STO_CR_M1.hC1, wOld, wNew, &pSet->hCordicC[0]) && bFits;
+    bFits = MC_PwmFreq_Scale(STO_CR_M1.hC2, wOld, wNew, &pSet->hCordicC[1]) && bFits;
+    bFits = MC_PwmFreq_Scale(STO_CR_M1.hC3, wOld, wNew, &pSet->hCordicC[2]) && bFits;
+    bFits = MC_PwmFreq_Scale(STO_CR_M1.hC4, wOld, wNew, &pSet->hCordicC[3]) && bFits;
+    bFits = MC_PwmFreq_Scale(STO_CR_M1.hC5, wOld, wNew, &pSet->hCordicC[4]) && bFits;
+    bFits = MC_PwmFreq_Scale(STO_CR_M1.MaxInstantElAcceleration, wOld * wOld, wNew * wNew,
+                             &pSet->hCordicMaxAccel) && bFits;
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+    {
+      /* wKDecay is 1 - Rs Ts / Ls, wKVolt and wKBemf follow Ts. In PCC_FINITE_SET wKVolt also
+         follows PCC_STATE_VOLT_GAIN_AT() of the period, StateHighCnt being shortened in the
+         short periods */
+      int32_t wDiv = (int32_t)1 << PCC_M1.hCoefDivisorPOW2;
+      int32_t wLoss;
+
+      PCC_GetTuning(&PCC_M1, &pSet->PCC);
+      bFits = MC_PwmFreq_Scale32(wDiv - pSet->PCC.wKDecay, wOld, wNew, &wLoss) && bFits;
+      bFits = bFits && (wLoss > 0) && (wLoss < wDiv);
+      pSet->PCC.wKDecay = wDiv - wLoss;
+      bFits = MC_PwmFreq_Scale32(pSet->PCC.wKVolt, wOld, wNew, &pSet->PCC.wKVolt) && bFits;
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+      {
+        const PWMC_Handle_t *pPWMC = &PWM_Handle_M1._Super;
+        uint64_t wGainNum = (uint64_t)STATE_HIGH_CNT_AT(pSet->hPeriod) * STATE_HIGH_CNT_SQRT3_AT(pPWMC->PWMperiod);
+        uint64_t wGainDen = (uint64_t)pPWMC->StateHighCnt * STATE_HIGH_CNT_SQRT3_AT(pSet->hPeriod);
+
+        bFits = MC_PwmFreq_Scale32(pSet->PCC.wKVolt, wGainNum, wGainDen, &pSet->PCC.wKVolt) && bFits;
+      }
+#endif
+      bFits = MC_PwmFreq_Scale32(pSet->PCC.wKBemf, wOld, wNew, &pSet->PCC.wKBemf) && bFits;
+    }
+#endif
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bFits);
+}
+
+uint32_t MC_PwmFreq_Get(void)
+{
+  return (PwmFreqHz);
+}
+
+/**
+ * @brief  Returns true if MC_PwmFreq_Apply() would accept the frequency with the gains
+ *         in use. It does not change anything.
+ */
+bool MC_PwmFreq_Check(uint32_t wFrequency)
+{
+  MC_PwmFreq_Set_t Set;
+
+  return (MC_PwmFreq_Compute(wFrequency, &Set));
+}
+
+/**
+ * @brief  Applies a PWM frequency, see mc_pwmfreq.h. It must be called by the medium
+ *         frequency task in the IDLE state, with the PWM switched off: the next start
+ *         runs at the new frequency.
+ * @param  wFrequency: PWM frequency, in Hz
+ * @retval bool False if the frequency is refused, nothing being then changed
+ */
+bool MC_PwmFreq_Apply(uint32_t wFrequency)
+{
+  MC_PwmFreq_Set_t Set;
+  bool bApplied = MC_PwmFreq_Compute(wFrequency, &Set);
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  /* The predictive controller validates its model itself, first so that a refused one
+     leaves the frequency unchanged */
+  bApplied = bApplied && PCC_SetTuning(&PCC_M1, &Set.PCC);
+#endif
+  if (true == bApplied)
+  {
+    PWMC_Handle_t *pPWMC = &PWM_Handle_M1._Super;
+    uint16_t hRegRate = (uint16_t)((wFrequency * PWM_UPDATES_PER_PERIOD) / (uint32_t)REGULATION_EXECUTION_RATE);
+    uint16_t hMeasRate = SPD_MEAS_RATE_SCALED_AT(wFrequency);
+
+    /* PWM, the timer counts up and down */
+    LL_TIM_SetAutoReload(PWM_Handle_M1.pParams_str->TIMx, (uint32_t)Set.hPeriod / 2U);
+    PWM_Handle_M1.Half_PWMPeriod = Set.hPeriod / 2U;
+    pPWMC->PWMperiod = Set.hPeriod;
+    pPWMC->hT_Sqrt3 = (uint16_t)(((uint32_t)Set.hPeriod * SQRT3FACTOR) / 16384U);
+    pPWMC->StateHighCnt = STATE_HIGH_CNT_AT(Set.hPeriod);
+    pPWMC->BootRefreshPeriods = BOOT_REFRESH_PERIODS_AT(hRegRate);
+#if defined (ICS_SENSORS)
+    PWM_Handle_M1.SamplingPoint = ICS_SAMPLING_POINT_AT(Set.hPeriod);
+#endif
+
+    PID_SetKI(&PIDIqHandle_M1, Set.hIqKi);
+    PID_SetKI(&PIDIdHandle_M1, Set.hIdKi);
+
+    /* Speed and position sensors */
+    VirtualSpeedSensorM1._Super.hMeasurementFrequency = hMeasRate;
+    VirtualSpeedSensorM1.hTransitionSteps = (int16_t)((SPD_MEAS_RATE_AT(wFrequency) * (uint32_t)TRANSITION_DURATION) / 1000U);
+#ifdef M1_ENCODER_SENSOR
+    ENCODER_M1._Super.hMeasurementFrequency = hMeasRate;
+#endif
+    STO_PLL_M1._Super.hMeasurementFrequency = hMeasRate;
+    STO_PLL_M1.hC1 = Set.hPllC[0];
+    STO_PLL_M1.hC2 = Set.hPllC[1];
+    STO_PLL_M1.hC3 = Set.hPllC[2];
+    STO_PLL_M1.hC4 = Set.hPllC[3];
+    STO_PLL_M1.hC5 = Set.hPllC[4];
+    STO_SetPLLGains(&STO_PLL_M1, Set.hPllKp, Set.hPllKi);
+    STO_CR_M1._Super.hMeasurementFrequency = hMeasRate;
+    STO_CR_M1.hC1 = Set.hCordicC[0];
+    STO_CR_M1.hC2 = Set.hCordicC[1];
+    STO_CR_M1.hC3 = Set.hCordicC[2];
+    STO_CR_M1.hC4 = Set.hCordicC[3];
+    STO_CR_M1.hC5 = Set.hCordicC[4];
+    STO_CR_M1.MaxInstantElAcceleration = Set.hCordicMaxAccel;
+
+    RampExtMngrHFParamsM1.FrequencyHz = hRegRate;
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+    PCC_ApplyTuning(&PCC_M1);
+#ifdef PCC_MODEL_ESTIMATION
+    /* The model of the new period becomes the nominal model of the estimator */
+    PCC_EST_Init(&PCC_EST_M1, &PCC_M1);
+#endif
+#endif
+    PwmFreqHz = wFrequency;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bApplied);
+}
+
+#endif /* MC_PWMFREQ_MODE */
+
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
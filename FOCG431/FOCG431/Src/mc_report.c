@@ -0,0 +1,214 @@
+/**
+  ******************************************************************************
+  * @file    mc_report.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Registers pushed to the host when they change
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "main.h"
+#include "mcp.h"
+#include "register_interface.h"
+#include "mc_report.h"
+
+#ifdef MC_REPORT_MODE
+
+static MC_Report_Config_t ReportConfig;
+static uint8_t bReportSize[MC_REPORT_NB_SUBS];   /* Bytes of each register */
+static uint32_t wReportValue[MC_REPORT_NB_SUBS]; /* Value last reported */
+static bool ReportAll;              /* The next report holds all the registers */
+static uint32_t wReportReadTick;
+static uint32_t wReportSentTick;
+static uint8_t ReportBuffer[MC_REPORT_MAX_BYTES];
+/* Bytes of the packet waiting for the deferred high frequency task, 0 if none */
+static volatile uint16_t hReportLength = 0U;
+
+/**
+ * @brief  Returns true if a register moved by more than its deadband since it was last
+ *         reported
+ */
+static bool MC_Report_Changed(uint8_t bSub, uint32_t wValue)
+{
+  uint8_t bShift = (uint8_t)(32U - (8U * bReportSize[bSub]));
+  /* The change is taken as a signed value of the size of the register */
+  int32_t wDelta = ((int32_t)((wValue - wReportValue[bSub]) << bShift)) >> bShift; //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  uint32_t wAbsDelta = (wDelta < 0) ? (0U - (uint32_t)wDelta) : (uint32_t)wDelta;
+
+  return (wAbsDelta > (uint32_t)ReportConfig.Subs[bSub].hDeadband);
+}
+
+/**
+ * @brief  Applies a configuration written in MC_REG_REPORT_CONFIG. Every register is read
+ *         once here, so that an unknown one is rejected now rather than at each report.
+ * @param  hAsyncMaxPayload Largest async payload of the transport, that the report of
+ *         all the registers must fit in
+ * @retval uint8_t MCP_CMD_OK, or the error of the configuration
+ */
+uint8_t MC_Report_Configure(const MC_Report_Config_t *pConfig, uint16_t hAsyncMaxPayload)
+{
+  uint8_t retVal = MCP_CMD_OK;
+  uint8_t bSize[MC_REPORT_NB_SUBS];
+  uint16_t hMaxBytes = 4U + 2U;
+  uint32_t wValue;
+  uint8_t i;
+
+  if (pConfig->bNbSubs > MC_REPORT_NB_SUBS)
+  {
+    retVal = MCP_ERROR_BAD_RAW_FORMAT;
+  }
+  else
+  {
+    for (i = 0U; (i < pConfig->bNbSubs) && (MCP_CMD_OK == retVal); i++)
+    {
+      bSize[i] = RI_GetIDSize(pConfig->Subs[i].hDataID);
+      if (0U == bSize[i])
+      {
+        retVal = MCP_ERROR_BAD_DATA_TYPE;
+      }
+      else
+      {
+        retVal = RI_ReadReg(pConfig->Subs[i].hDataID, &wValue);
+        hMaxBytes += 2U + (uint16_t)bSize[i];
+      }
+    }
+    if ((MCP_CMD_OK == retVal) && (hMaxBytes > hAsyncMaxPayload))
+    {
+      retVal = MCP_ERROR_NO_TXASYNC_SPACE;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+
+  if (MCP_CMD_OK == retVal)
+  {
+    ReportConfig = *pConfig;
+    if (0U == ReportConfig.hIntervalMs)
+    {
+      ReportConfig.bNbSubs = 0U;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    (void)memcpy(bReportSize, bSize, pConfig->bNbSubs);
+    ReportAll = true;
+    wReportReadTick = HAL_GetTick() - ReportConfig.hIntervalMs;
+  }
+  else
+  {
+    /* Nothing to do, the configuration in use is kept */
+  }
+  return (retVal);
+}
+
+const MC_Report_Config_t *MC_Report_GetConfig(void)
+{
+  return (&ReportConfig);
+}
+
+/**
+ * @brief  Reads the registers of the configuration every hIntervalMs and builds the
+ *         packet of the ones that changed. It is called by the main loop, as the host
+ *         requests, and does nothing while the previous packet waits for the deferred
+ *         high frequency task.
+ */
+void MC_Report_Exec(void)
+{
+  uint32_t wTick = HAL_GetTick();
+
+  if ((0U == ReportConfig.bNbSubs) || (hReportLength != 0U)
+      || ((wTick - wReportReadTick) < (uint32_t)ReportConfig.hIntervalMs))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    bool All = (true == ReportAll)
+            || ((ReportConfig.hHeartbeatMs > 0U) && ((wTick - wReportSentTick) >= (uint32_t)ReportConfig.hHeartbeatMs));
+    uint32_t wTimestamp = GLOBAL_TIMESTAMP;
+    uint16_t hLength = 4U;
+    uint32_t wValue;
+    uint8_t i;
+
+    wReportReadTick = wTick;
+    (void)memcpy(ReportBuffer, &wTimestamp, sizeof(wTimestamp));
+    for (i = 0U; i < ReportConfig.bNbSubs; i++)
+    {
+      if ((MCP_CMD_OK == RI_ReadReg(ReportConfig.Subs[i].hDataID, &wValue))
+          && ((true == All) || (true == MC_Report_Changed(i, wValue))))
+      {
+        (void)memcpy(&ReportBuffer[hLength], &ReportConfig.Subs[i].hDataID, sizeof(uint16_t));
+        hLength += (uint16_t)sizeof(uint16_t);
+        (void)memcpy(&ReportBuffer[hLength], &wValue, bReportSize[i]);
+        hLength += (uint16_t)bReportSize[i];
+        wReportValue[i] = wValue;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+
+    if (hLength > 4U)
+    {
+      /* Null mark and async ID, as the end of a datalog buffer */
+      ReportBuffer[hLength] = 0U;
+      ReportBuffer[hLength + 1U] = MC_REPORT_ASYNC_ID;
+      ReportAll = false;
+      wReportSentTick = wTick;
+      /* Raised last: the packet is complete when the deferred task reads it */
+      hReportLength = hLength + 2U;
+    }
+    else
+    {
+      /* Nothing to do, no change */
+    }
+  }
+}
+
+/**
+ * @brief  Hands the packet built by MC_Report_Exec to the transport. It is called by the
+ *         deferred high frequency task after the datalog, the only producer of the async
+ *         buffers: the packet waits while the datalog fills a buffer, since the ring only
+ *         gives the one at its write index, or while the ring is full.
+ */
+void MC_Report_Send(MCPA_Handle_t *pMCPA)
+{
+  uint16_t hLength = hReportLength;
+  uint8_t *pBuffer;
+
+  if ((0U == hLength) || (pMCPA->bufferIndex != 0U))
+  {
+    /* Nothing to do */
+  }
+  else if (0U == pMCPA->pTransportLayer->fGetBuffer(pMCPA->pTransportLayer,
+                                                    (void **)&pBuffer, //cstat !MISRAC2012-Rule-11.3
+                                                    MCTL_ASYNC))
+  {
+    /* Nothing to do, tried again at the next period */
+  }
+  else
+  {
+    (void)memcpy(pBuffer, ReportBuffer, hLength);
+    (void)pMCPA->pTransportLayer->fSendPacket(pMCPA->pTransportLayer, pBuffer, hLength, MCTL_ASYNC);
+    hReportLength = 0U;
+  }
+}
+
+#endif /* MC_REPORT_MODE */
+
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
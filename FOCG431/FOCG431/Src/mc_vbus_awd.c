@@ -0,0 +1,136 @@
+/**
+  ******************************************************************************
+  * @file    mc_vbus_awd.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Overvoltage protection by the analog watchdog of the bus voltage ADC
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "mc_vbus_awd.h"
+
+#ifdef MC_VBUS_AWD_MODE
+
+static ADC_TypeDef *pAwdADC;
+static uint16_t hThreshold;         /* OverVoltageThreshold of the sensor, in the 16-bit unit */
+static volatile bool Tripped;       /* The interrupt is disabled until the supervisor rearms it */
+static uint16_t hTrips;
+
+/**
+  * @brief  Sets the analog watchdog 1 of the ADC of the bus voltage on its regular
+  *         conversion. The configuration is only written with no conversion ongoing:
+  *         the injected conversions are stopped meanwhile and the regular scan, whose
+  *         DMA would lose its rank if stopped, is waited for. To be called by MCboot
+  *         once the sensor is initialized.
+  */
+void MC_VbusAwd_Init(const RDivider_Handle_t *pHandle)
+{
+  uint32_t bInjected;
+
+  pAwdADC = pHandle->VbusRegConv.regADC;
+  hThreshold = pHandle->OverVoltageThreshold;
+
+  bInjected = LL_ADC_INJ_IsConversionOngoing(pAwdADC);
+  if (1U == bInjected)
+  {
+    LL_ADC_INJ_StopConversion(pAwdADC);
+    while (1U == LL_ADC_INJ_IsStopConversionOngoing(pAwdADC))
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  while (1U == LL_ADC_REG_IsConversionOngoing(pAwdADC))
+  {
+    /* Nothing to do */
+  }
+
+  LL_ADC_SetAnalogWDMonitChannels(pAwdADC, LL_ADC_AWD1,
+                                  __LL_ADC_ANALOGWD_CHANNEL_GROUP(
+                                    __LL_ADC_DECIMAL_NB_TO_CHANNEL(pHandle->VbusRegConv.channel),
+                                    LL_ADC_GROUP_REGULAR));
+  /* The watchdog compares the 12-bit conversion, before its left alignment */
+  LL_ADC_ConfigAnalogWDThresholds(pAwdADC, LL_ADC_AWD1, (uint32_t)hThreshold >> 4U, 0U);
+  LL_ADC_ClearFlag_AWD1(pAwdADC);
+  LL_ADC_EnableIT_AWD1(pAwdADC);
+  Tripped = false;
+
+  if (1U == bInjected)
+  {
+    LL_ADC_INJ_StartConversion(pAwdADC);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section (".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Switches off the PWM on a conversion above the threshold, through the
+  *         break of TIM1. To be called by the interrupt handler of the ADC.
+  */
+void MC_VbusAwd_IRQHandler(void)
+{
+  if ((1U == LL_ADC_IsEnabledIT_AWD1(pAwdADC)) && (1U == LL_ADC_IsActiveFlag_AWD1(pAwdADC)))
+  {
+    LL_TIM_GenerateEvent_BRK(TIM1);
+    LL_ADC_DisableIT_AWD1(pAwdADC);
+    LL_ADC_ClearFlag_AWD1(pAwdADC);
+    hTrips += (hTrips < UINT16_MAX) ? 1U : 0U;
+    Tripped = true;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+  * @brief  Rearms the watchdog once the averaged bus voltage is back below the
+  *         threshold. To be called by the safety task after RVBS_CalcAvVbus.
+  */
+void MC_VbusAwd_Supervise(uint16_t hAvBusVoltage_d)
+{
+  if ((true == Tripped) && (hAvBusVoltage_d < hThreshold))
+  {
+    Tripped = false;
+    LL_ADC_ClearFlag_AWD1(pAwdADC);
+    LL_ADC_EnableIT_AWD1(pAwdADC);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+  * @brief  Breaks generated by the watchdog since the boot, saturated to UINT16_MAX
+  */
+uint16_t MC_VbusAwd_GetTrips(void)
+{
+  return (hTrips);
+}
+
+#endif /* MC_VBUS_AWD_MODE */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
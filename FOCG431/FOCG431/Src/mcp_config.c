@@ -21,25 +21,36 @@
 
 #include "parameters_conversion.h"
 #include "usart_aspep_driver.h"
+#ifdef MC_USB_CDC_MODE
+#include "usb_cdc_aspep_driver.h"
+#endif
 #include "aspep.h"
 #include "mcp.h"
 #include "mcpa.h"
 #include "mcp_config.h"
 
-static uint8_t MCPSyncTxBuff[MCP_TX_SYNCBUFFER_SIZE];
-static uint8_t MCPSyncRXBuff[MCP_RX_SYNCBUFFER_SIZE];
+/* Answer and request buffers of the requests outstanding at once */
+static uint8_t MCPSyncTxBuff[ASPEP_SYNC_NB_BUFFERS][MCP_TX_SYNCBUFFER_SIZE];
+static uint8_t MCPSyncRXBuff[ASPEP_SYNC_NB_BUFFERS][MCP_RX_SYNCBUFFER_SIZE];
 
-/* Asynchronous buffer dedicated to UART_A*/
-static uint8_t MCPAsyncBuffUARTA_A[MCP_TX_ASYNCBUFFER_SIZE_A];
-static uint8_t MCPAsyncBuffUARTA_B[MCP_TX_ASYNCBUFFER_SIZE_A];
+/* Ring of asynchronous buffers dedicated to UART_A*/
+static uint8_t MCPAsyncBuffUARTA[ASPEP_ASYNC_NB_BUFFERS][MCP_TX_ASYNCBUFFER_SIZE_A];
 /* Buffer dedicated to store pointer of data to be streamed over UART_A*/
 void * dataPtrTableA[MCPA_OVER_UARTA_STREAM];
 void * dataPtrTableBuffA[MCPA_OVER_UARTA_STREAM];
 uint8_t dataSizeTableA[MCPA_OVER_UARTA_STREAM];
 uint8_t dataSizeTableBuffA[MCPA_OVER_UARTA_STREAM]; /* buffered version of dataSizeTableA */
+int16_t HFLastTableA[MCPA_OVER_UARTA_STREAM];
 
 MCP_user_cb_t MCP_UserCallBack[MCP_USER_CALLBACK_MAX];
 
+#ifdef MC_USB_CDC_MODE
+/* The link of aspepOverUartA is the USB device, see usb_cdc_aspep_driver.h */
+CDCASPEP_Handle_t CDCASPEP_A =
+{
+  .pASPEP = &aspepOverUartA,
+};
+#else
 static UASPEP_Handle_t UASPEP_A =
 {
  .USARTx = USARTA,
@@ -48,6 +59,7 @@ static UASPEP_Handle_t UASPEP_A =
  .rxChannel = DMACH_RX_A,
  .txChannel = DMACH_TX_A,
 };
+#endif
 
 ASPEP_Handle_t aspepOverUartA =
 {
@@ -57,28 +69,67 @@ ASPEP_Handle_t aspepOverUartA =
     .fSendPacket = &ASPEP_sendPacket,
     .fRXPacketProcess = &ASPEP_RXframeProcess,
     },
+#ifdef MC_USB_CDC_MODE
+  .HWIp = &CDCASPEP_A,
+#else
   .HWIp = &UASPEP_A,
+#endif
   .Capabilities = {
+#ifdef ASPEP_DATA_CRC
+    .DATA_CRC = 1U, /* Used only if the master also supports it */
+#else
     .DATA_CRC = 0U,
+#endif
     .RX_maxSize =  (MCP_RX_SYNC_PAYLOAD_MAX>>5U)-1U,
     .TXS_maxSize = (MCP_TX_SYNC_PAYLOAD_MAX>>5U)-1U,
     .TXA_maxSize =  MCP_TX_ASYNC_PAYLOAD_MAX_A>>6U,
     .version = 0x0U,
   },
   .syncBuffer = {
-   .buffer = MCPSyncTxBuff,
+    { .buffer = MCPSyncTxBuff[0], },
+#if (ASPEP_SYNC_NB_BUFFERS > 1U)
+    { .buffer = MCPSyncTxBuff[1], },
+#endif
+#if (ASPEP_SYNC_NB_BUFFERS > 2U)
+    { .buffer = MCPSyncTxBuff[2], },
+#endif
+#if (ASPEP_SYNC_NB_BUFFERS > 3U)
+    { .buffer = MCPSyncTxBuff[3], },
+#endif
   },
-  .asyncBufferA = {
-    .buffer = MCPAsyncBuffUARTA_A,
+  .asyncBuffer = {
+    { .buffer = MCPAsyncBuffUARTA[0], },
+    { .buffer = MCPAsyncBuffUARTA[1], },
+#if (ASPEP_ASYNC_NB_BUFFERS > 2U)
+    { .buffer = MCPAsyncBuffUARTA[2], },
+#endif
+#if (ASPEP_ASYNC_NB_BUFFERS > 3U)
+    { .buffer = MCPAsyncBuffUARTA[3], },
+#endif
   },
-  .asyncBufferB = {
-    .buffer = MCPAsyncBuffUARTA_B,
+  .rxSlot = {
+    { .buffer = MCPSyncRXBuff[0], },
+#if (ASPEP_SYNC_NB_BUFFERS > 1U)
+    { .buffer = MCPSyncRXBuff[1], },
+#endif
+#if (ASPEP_SYNC_NB_BUFFERS > 2U)
+    { .buffer = MCPSyncRXBuff[2], },
+#endif
+#if (ASPEP_SYNC_NB_BUFFERS > 3U)
+    { .buffer = MCPSyncRXBuff[3], },
+#endif
   },
-  .rxBuffer = MCPSyncRXBuff,
+#ifdef MC_USB_CDC_MODE
+  .fASPEP_HWInit = &CDCASPEP_INIT,
+  .fASPEP_HWSync = &CDCASPEP_IDLE_ENABLE,
+  .fASPEP_receive = &CDCASPEP_RECEIVE_BUFFER,
+  .fASPEP_send = &CDCASPEP_SEND_PACKET,
+#else
   .fASPEP_HWInit = &UASPEP_INIT,
   .fASPEP_HWSync = &UASPEP_IDLE_ENABLE,
   .fASPEP_receive = &UASPEP_RECEIVE_BUFFER,
   .fASPEP_send = &UASPEP_SEND_PACKET,
+#endif
   .liid = 0,
 };
 
@@ -94,6 +145,7 @@ MCPA_Handle_t MCPA_UART_A =
   .dataPtrTableBuff = dataPtrTableBuffA,
   .dataSizeTable = dataSizeTableA,
   .dataSizeTableBuff = dataSizeTableBuffA,
+  .HFLastTable = HFLastTableA,
   .nbrOfDataLog = MCPA_OVER_UARTA_STREAM,
 };
 
@@ -27,6 +27,27 @@
 #include "pwm_curr_fdbk.h"
 #include "mc_math.h"
 #include "mc_type.h"
+#if defined (MC_PWMC_DIRECT_MODE) || defined (MC_STATIC_BINDING_MODE)
+#include "mc_config.h"
+#endif
+
+#ifdef MC_PWMC_DIRECT_MODE
+/* Single motor: the handle is PWM_Handle_M1, the functions of its driver are called
+   directly. The function pointers of the handle are still set, for the other users */
+#define PWMC_GET_PHASE_CURRENTS(pHandle, Iab)  PWMC_GET_PHASE_CURRENTS_M1((pHandle), (Iab))
+#define PWMC_SET_SAMP_POINT_SECTX(pHandle)     PWMC_SET_SAMP_POINT_SECTX_M1(pHandle)
+#define PWMC_SWITCH_OFF_PWM(pHandle)           PWMC_SWITCH_OFF_PWM_M1(pHandle)
+#define PWMC_SWITCH_ON_PWM(pHandle)            PWMC_SWITCH_ON_PWM_M1(pHandle)
+#define PWMC_TURN_ON_LOW_SIDES(pHandle)        PWMC_TURN_ON_LOW_SIDES_M1(pHandle)
+#define PWMC_IS_OVER_CURRENT(pHandle)          PWMC_IS_OVER_CURRENT_M1(pHandle)
+#else
+#define PWMC_GET_PHASE_CURRENTS(pHandle, Iab)  (pHandle)->pFctGetPhaseCurrents((pHandle), (Iab))
+#define PWMC_SET_SAMP_POINT_SECTX(pHandle)     (pHandle)->pFctSetADCSampPointSectX(pHandle)
+#define PWMC_SWITCH_OFF_PWM(pHandle)           (pHandle)->pFctSwitchOffPwm(pHandle)
+#define PWMC_SWITCH_ON_PWM(pHandle)            (pHandle)->pFctSwitchOnPwm(pHandle)
+#define PWMC_TURN_ON_LOW_SIDES(pHandle)        (pHandle)->pFctTurnOnLowSides(pHandle)
+#define PWMC_IS_OVER_CURRENT(pHandle)          (pHandle)->pFctIsOverCurrentOccurred(pHandle)
+#endif
 
 /** @addtogroup MCSDK
   * @{
@@ -135,6 +156,8 @@ __weak void PWMC_GetOffsetCalib(PWMC_Handle_t *pHandle, PolarizationOffsets_t *o
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief Returns the phase current of the motor as read by the ADC (in s16A unit)
@@ -161,18 +184,50 @@ __weak void PWMC_GetPhaseCurrents(PWMC_Handle_t *pHandle, ab_t *Iab)
   else
   {
 #endif
-    pHandle->pFctGetPhaseCurrents(pHandle, Iab);
+    PWMC_GET_PHASE_CURRENTS(pHandle, Iab);
 #ifdef NULL_PTR_PWR_CUR_FDB
   }
 #endif
 }
 
+/**
+  * @brief  Interpolates the dead time compensation table of a phase at its current
+  * @param  pHandle handler on the target PWMC component, with a table.
+  * @param  bPhase 0, 1 or 2 for phase A, B or C
+  * @param  hCurrent current of the phase
+  * @retval uint16_t Compensation in timer clock cycles unit
+  */
+static inline uint16_t PWMC_GetDeadTimeComp(const PWMC_Handle_t *pHandle, uint8_t bPhase, int16_t hCurrent)
+{
+  const uint16_t *pLut = &pHandle->pDTCompLut[(uint32_t)bPhase * PWMC_DTCOMP_LUT_POINTS];
+  uint8_t bShift = pHandle->DTCompLutShift;
+  uint32_t wAbs = (hCurrent < 0) ? (uint32_t)(-(int32_t)hCurrent) : (uint32_t)hCurrent;
+  uint32_t wIndex = wAbs >> bShift;
+  uint16_t hComp;
+
+  if (wIndex >= (PWMC_DTCOMP_LUT_POINTS - 1U))
+  {
+    hComp = pLut[PWMC_DTCOMP_LUT_POINTS - 1U];
+  }
+  else
+  {
+    int32_t wFrac = (int32_t)(wAbs & (((uint32_t)1 << bShift) - 1U));
+    int32_t wDelta = (int32_t)pLut[wIndex + 1U] - (int32_t)pLut[wIndex];
+
+    //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+    hComp = (uint16_t)((int32_t)pLut[wIndex] + ((wDelta * wFrac) >> bShift));
+  }
+  return (hComp);
+}
+
 #if defined (CCMRAM)
 #if defined (__ICCARM__)
 #pragma location = ".ccmram"
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
  * @brief Sets the PWM duty cycles
@@ -201,6 +256,7 @@ __attribute__( ( section ( ".ccmram" ) ) )
   */
 __weak uint16_t PWMC_SetPhaseVoltage(PWMC_Handle_t *pHandle, alphabeta_t Valfa_beta)
 {
+  uint16_t returnValue;
 #ifdef NULL_PTR_PWR_CUR_FDB
   if (MC_NULL == pHandle)
   {
@@ -307,35 +363,300 @@ __weak uint16_t PWMC_SetPhaseVoltage(PWMC_Handle_t *pHandle, alphabeta_t Valfa_b
 
     if (1U == pHandle->DTTest)
     {
+      uint16_t hCompA = pHandle->DTCompCnt;
+      uint16_t hCompB = pHandle->DTCompCnt;
+      uint16_t hCompC = pHandle->DTCompCnt;
+
+      if (pHandle->pDTCompLut != MC_NULL)
+      {
+        /* Compensation of each phase at its current, down to zero at zero current */
+        hCompA = PWMC_GetDeadTimeComp(pHandle, 0U, pHandle->Ia);
+        hCompB = PWMC_GetDeadTimeComp(pHandle, 1U, pHandle->Ib);
+        hCompC = PWMC_GetDeadTimeComp(pHandle, 2U, pHandle->Ic);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
       /* Dead time compensation */
       if (pHandle->Ia > 0)
       {
-        pHandle->CntPhA += pHandle->DTCompCnt;
+        pHandle->CntPhA += hCompA;
       }
       else
       {
-        pHandle->CntPhA -= pHandle->DTCompCnt;
+        pHandle->CntPhA -= hCompA;
       }
 
       if (pHandle->Ib > 0)
       {
-        pHandle->CntPhB += pHandle->DTCompCnt;
+        pHandle->CntPhB += hCompB;
       }
       else
       {
-        pHandle->CntPhB -= pHandle->DTCompCnt;
+        pHandle->CntPhB -= hCompB;
       }
 
       if (pHandle->Ic > 0)
       {
-        pHandle->CntPhC += pHandle->DTCompCnt;
+        pHandle->CntPhC += hCompC;
       }
       else
       {
-        pHandle->CntPhC -= pHandle->DTCompCnt;
+        pHandle->CntPhC -= hCompC;
       }
     }
-    returnValue = pHandle->pFctSetADCSampPointSectX(pHandle);
+    returnValue = PWMC_SET_SAMP_POINT_SECTX(pHandle);
+#ifdef NULL_PTR_PWR_CUR_FDB
+  }
+#endif
+  return (returnValue);
+}
+
+/* Pair of shunts sampled for each switching state, as a sector of the space vector modulation.
+   The sampling point is in the middle of the period, where all the low sides are on; the pair
+   leaves out a phase with its high side on before the sampling window, A first, then B, then C */
+static const uint8_t PWMC_StateSector[8] =
+{
+  SECTOR_5, SECTOR_1, SECTOR_3, SECTOR_1, SECTOR_5, SECTOR_1, SECTOR_3, SECTOR_5
+};
+
+#ifdef PWMC_BOOT_REFRESH
+/**
+  * @brief  Counts the periods of each high side on over the whole period. Once one of
+  *         them reaches BootRefreshPeriods, the three compare values are lowered by
+  *         BootRefreshCnt for this period: its low side is turned on long enough to
+  *         recharge the bootstrap capacitor, while the phase to phase voltages are kept
+  *         as far as the lowest phase allows.
+  * @param  pHandle handler on the target PWMC component, with its compare values set.
+  */
+static inline void PWMC_BootRefresh(PWMC_Handle_t *pHandle)
+{
+  uint16_t hFullCnt = pHandle->PWMperiod / 2U;
+  uint16_t hCnt[3];
+  bool Refresh = false;
+  uint8_t i;
+
+  hCnt[0] = pHandle->CntPhA;
+  hCnt[1] = pHandle->CntPhB;
+  hCnt[2] = pHandle->CntPhC;
+  for (i = 0U; i < 3U; i++)
+  {
+    if (hCnt[i] >= hFullCnt)
+    {
+      pHandle->BootHighPeriods[i]++;
+      Refresh = (pHandle->BootHighPeriods[i] >= pHandle->BootRefreshPeriods) ? true : Refresh;
+    }
+    else
+    {
+      pHandle->BootHighPeriods[i] = 0U;
+    }
+  }
+  if (true == Refresh)
+  {
+    for (i = 0U; i < 3U; i++)
+    {
+      hCnt[i] = (hCnt[i] > pHandle->BootRefreshCnt) ? (hCnt[i] - pHandle->BootRefreshCnt) : 0U;
+      pHandle->BootHighPeriods[i] = 0U;
+    }
+    pHandle->CntPhA = hCnt[0];
+    pHandle->CntPhB = hCnt[1];
+    pHandle->CntPhC = hCnt[2];
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+#endif
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Applies one inverter switching state during the PWM period, without any
+  *         space vector modulation.
+  * @param  pHandle handler on the target PWMC component.
+  * @param  bState Switching state: bit 0, 1 and 2 set turn the high side of phase A, B and C
+  *         on, cleared the low side.
+  *
+  * The phases with their high side on are switched on during StateHighCnt, sqrt(3)/2 of the
+  * period, so that an active state has the voltage of a vector of magnitude 32767 given to
+  * PWMC_SetPhaseVoltage(). StateHighCnt is shortened when the PWM period is too short for
+  * the sampling window. The rest of the period, centred on the middle of the PWM period,
+  * all the low sides are on and the currents can be sampled by the shunts whatever the state.
+  * The phases with their low side on do not commute. The zero state with all the high sides
+  * on is applied with all the low sides on, that do not commute either.
+  *
+  * The shunts and the sampling point of the next PWM cycle are taken from the switching state
+  * by the pFctSetADCSampPointState function of the component instance, without the duty
+  * cycle comparisons of PWMC_SetPhaseVoltage(). There is no dead time compensation.
+  *
+  * @retval Returns #MC_NO_ERROR if no error occurred or #MC_FOC_DURATION if the compare
+  *         registers were set too late for being taken into account in the next PWM cycle.
+  */
+__weak uint16_t PWMC_SetSwitchingState(PWMC_Handle_t *pHandle, uint8_t bState)
+{
+  uint16_t returnValue;
+#ifdef NULL_PTR_PWR_CUR_FDB
+  if (MC_NULL == pHandle)
+  {
+    returnValue = 0U;
+  }
+  else
+  {
+#endif
+    uint16_t hHighCnt = pHandle->StateHighCnt;
+    uint8_t bActive = (7U == (bState & 7U)) ? 0U : (bState & 7U);
+    uint8_t bNbHigh = (bActive & 1U) + ((bActive >> 1) & 1U) + ((bActive >> 2) & 1U);
+
+    pHandle->CntPhA = ((bActive & 1U) != 0U) ? hHighCnt : 0U;
+    pHandle->CntPhB = ((bActive & 2U) != 0U) ? hHighCnt : 0U;
+    pHandle->CntPhC = ((bActive & 4U) != 0U) ? hHighCnt : 0U;
+
+    /* Largest, middle and smallest compare values, as sorted by PWMC_SetPhaseVoltage() */
+    pHandle->lowDuty = (bNbHigh > 0U) ? hHighCnt : 0U;
+    pHandle->midDuty = (bNbHigh > 1U) ? hHighCnt : 0U;
+    pHandle->highDuty = 0U;
+    pHandle->Sector = PWMC_StateSector[bActive];
+
+#ifdef MC_PWMC_DIRECT_MODE
+    returnValue = PWMC_SET_SAMP_POINT_STATE_M1(pHandle);
+#else
+    if (MC_NULL == pHandle->pFctSetADCSampPointState)
+    {
+      returnValue = pHandle->pFctSetADCSampPointSectX(pHandle);
+    }
+    else
+    {
+      returnValue = pHandle->pFctSetADCSampPointState(pHandle);
+    }
+#endif
+#ifdef NULL_PTR_PWR_CUR_FDB
+  }
+#endif
+  return (returnValue);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Applies two adjacent active switching states during their dwell times and the zero
+  *         states during the rest of the PWM period, centred as by the space vector modulation.
+  * @param  pHandle handler on the target PWMC component.
+  * @param  bStateA Switching state of the first active vector, coded as for
+  *         PWMC_SetSwitchingState().
+  * @param  bStateB Switching state of the second active vector, adjacent to @p bStateA.
+  * @param  hDwellA Dwell time of @p bStateA, in Q15 fraction of the PWM period.
+  * @param  hDwellB Dwell time of @p bStateB. @p hDwellA plus @p hDwellB must not exceed 32768.
+  *
+  * The duty cycles are computed as by PWMC_SetPhaseVoltage_OVM(), from the dwell times instead
+  * of the voltage: an active state applied during the whole period is a vertex of the hexagon,
+  * 2/sqrt(3) of the full scale of PWMC_SetPhaseVoltage(). As the zero states shorten down to
+  * nothing, the low side of the leading phases may no longer be on long enough for the sampling:
+  * the pFctSetADCSampPointSectX and pFctGetPhaseCurrents functions of the component instance
+  * must then be the _OVM ones, that fall back to the currents of PWMC_CalcPhaseCurrentsEst().
+  *
+  * @retval Returns #MC_NO_ERROR if no error occurred or #MC_FOC_DURATION if the compare
+  *         registers were set too late for being taken into account in the next PWM cycle.
+  */
+__weak uint16_t PWMC_SetDwellTimes(PWMC_Handle_t *pHandle, uint8_t bStateA, uint8_t bStateB,
+                                   uint16_t hDwellA, uint16_t hDwellB)
+{
+  uint16_t returnValue;
+#ifdef NULL_PTR_PWR_CUR_FDB
+  if (MC_NULL == pHandle)
+  {
+    returnValue = 0U;
+  }
+  else
+  {
+#endif
+    uint32_t wZero = (32768U - (uint32_t)hDwellA - (uint32_t)hDwellB) / 2U;
+    uint32_t wPeriod = (uint32_t)pHandle->PWMperiod;
+    uint32_t wDutyA;
+    uint32_t wDutyB;
+    uint32_t wDutyC;
+
+    /* High side on time of each phase: half of the zero states, plus the active states
+       that turn it on */
+    wDutyA = wZero + (((bStateA & 1U) != 0U) ? hDwellA : 0U) + (((bStateB & 1U) != 0U) ? hDwellB : 0U);
+    wDutyB = wZero + (((bStateA & 2U) != 0U) ? hDwellA : 0U) + (((bStateB & 2U) != 0U) ? hDwellB : 0U);
+    wDutyC = wZero + (((bStateA & 4U) != 0U) ? hDwellA : 0U) + (((bStateB & 4U) != 0U) ? hDwellB : 0U);
+    pHandle->CntPhA = (uint16_t)((wPeriod * wDutyA) >> 16);
+    pHandle->CntPhB = (uint16_t)((wPeriod * wDutyB) >> 16);
+    pHandle->CntPhC = (uint16_t)((wPeriod * wDutyC) >> 16);
+#ifdef PWMC_BOOT_REFRESH
+    /* A vertex over the whole period leaves the high sides of its phases on */
+    PWMC_BootRefresh(pHandle);
+#endif
+
+    /* Sector and largest, middle and smallest compare values, as sorted by
+       PWMC_SetPhaseVoltage() */
+    if (pHandle->CntPhA >= pHandle->CntPhB)
+    {
+      if (pHandle->CntPhB >= pHandle->CntPhC)
+      {
+        pHandle->Sector = SECTOR_1;
+        pHandle->lowDuty = pHandle->CntPhA;
+        pHandle->midDuty = pHandle->CntPhB;
+        pHandle->highDuty = pHandle->CntPhC;
+      }
+      else if (pHandle->CntPhA >= pHandle->CntPhC)
+      {
+        pHandle->Sector = SECTOR_6;
+        pHandle->lowDuty = pHandle->CntPhA;
+        pHandle->midDuty = pHandle->CntPhC;
+        pHandle->highDuty = pHandle->CntPhB;
+      }
+      else
+      {
+        pHandle->Sector = SECTOR_5;
+        pHandle->lowDuty = pHandle->CntPhC;
+        pHandle->midDuty = pHandle->CntPhA;
+        pHandle->highDuty = pHandle->CntPhB;
+      }
+    }
+    else
+    {
+      if (pHandle->CntPhA >= pHandle->CntPhC)
+      {
+        pHandle->Sector = SECTOR_2;
+        pHandle->lowDuty = pHandle->CntPhB;
+        pHandle->midDuty = pHandle->CntPhA;
+        pHandle->highDuty = pHandle->CntPhC;
+      }
+      else if (pHandle->CntPhB >= pHandle->CntPhC)
+      {
+        pHandle->Sector = SECTOR_3;
+        pHandle->lowDuty = pHandle->CntPhB;
+        pHandle->midDuty = pHandle->CntPhC;
+        pHandle->highDuty = pHandle->CntPhA;
+      }
+      else
+      {
+        pHandle->Sector = SECTOR_4;
+        pHandle->lowDuty = pHandle->CntPhC;
+        pHandle->midDuty = pHandle->CntPhB;
+        pHandle->highDuty = pHandle->CntPhA;
+      }
+    }
+
+    returnValue = PWMC_SET_SAMP_POINT_SECTX(pHandle);
 #ifdef NULL_PTR_PWR_CUR_FDB
   }
 #endif
@@ -357,7 +678,7 @@ __weak void PWMC_SwitchOffPWM(PWMC_Handle_t *pHandle)
   else
   {
 #endif
-    pHandle->pFctSwitchOffPwm(pHandle);
+    PWMC_SWITCH_OFF_PWM(pHandle);
 #ifdef NULL_PTR_PWR_CUR_FDB
   }
 #endif
@@ -378,7 +699,7 @@ __weak void PWMC_SwitchOnPWM(PWMC_Handle_t *pHandle)
   else
   {
 #endif
-    pHandle->pFctSwitchOnPwm(pHandle);
+    PWMC_SWITCH_ON_PWM(pHandle);
 #ifdef NULL_PTR_PWR_CUR_FDB
   }
 #endif
@@ -449,6 +770,8 @@ __weak bool PWMC_CurrentReadingCalibr(PWMC_Handle_t *pHandle, CRCAction_t action
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 static inline int32_t PWMC_LowPassFilter(int32_t in, int32_t *out_buf, int32_t t)
 {
@@ -482,6 +805,8 @@ static inline int32_t PWMC_LowPassFilter(int32_t in, int32_t *out_buf, int32_t t
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__( ( section ( ".ccmram" ) ) )
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It converts input currents components Iqd into estimated
@@ -501,13 +826,46 @@ void PWMC_CalcPhaseCurrentsEst(PWMC_Handle_t *pHandle, qd_t Iqd, int16_t hElAngl
   {
 #endif
     qd_t idq_ave;
-    alphabeta_t ialpha_beta;
-    int32_t temp1, temp2;
 
     idq_ave.q = (int16_t)PWMC_LowPassFilter(Iqd.q, &(pHandle->LPFIqBuf), pHandle->LPFIqd_const);
     idq_ave.d = (int16_t)PWMC_LowPassFilter(Iqd.d, &(pHandle->LPFIdBuf), pHandle->LPFIqd_const);
 
-    ialpha_beta = MCM_Rev_Park(idq_ave, hElAngledpp);
+    PWMC_SetPhaseCurrentsEst(pHandle, idq_ave, hElAngledpp);
+#ifdef NULL_PTR_PWR_CUR_FDB
+  }
+#endif
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__( ( section ( ".ccmram" ) ) )
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It converts the currents predicted for the next sampling Iqd into the
+  *         estimated currents Ia, Ib and Ic, without low pass filter
+  * @param  Iqd: Iq and Id currents
+  * @param  hElAngledpp: electrical angle of the next sampling
+  * @retval none
+  */
+void PWMC_SetPhaseCurrentsEst(PWMC_Handle_t *pHandle, qd_t Iqd, int16_t hElAngledpp)
+{
+#ifdef NULL_PTR_PWR_CUR_FDB
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    alphabeta_t ialpha_beta;
+    int32_t temp1, temp2;
+
+    ialpha_beta = MCM_Rev_Park(Iqd, hElAngledpp);
 
     /* reverse Clarke */
 
@@ -552,7 +910,7 @@ __weak void PWMC_TurnOnLowSides(PWMC_Handle_t *pHandle)
   else
   {
 #endif
-    pHandle->pFctTurnOnLowSides(pHandle);
+    PWMC_TURN_ON_LOW_SIDES(pHandle);
 #ifdef NULL_PTR_PWR_CUR_FDB
   }
 #endif
@@ -565,9 +923,9 @@ __weak void PWMC_TurnOnLowSides(PWMC_Handle_t *pHandle)
 __weak uint16_t PWMC_CheckOverCurrent(PWMC_Handle_t *pHandle) //cstat !MISRAC2012-Rule-8.13
 {
 #ifdef NULL_PTR_PWR_CUR_FDB
-  return ((MC_NULL == pHandle) ? MC_NO_FAULTS : (uint16_t)pHandle->pFctIsOverCurrentOccurred(pHandle));
+  return ((MC_NULL == pHandle) ? MC_NO_FAULTS : (uint16_t)PWMC_IS_OVER_CURRENT(pHandle));
 #else
-  return ((uint16_t)pHandle->pFctIsOverCurrentOccurred(pHandle));
+  return ((uint16_t)PWMC_IS_OVER_CURRENT(pHandle));
 #endif
 }
 
@@ -746,6 +1104,95 @@ void PWMC_SetAlignFlag(PWMC_Handle_t *pHandle, uint8_t flag)
 #endif
 }
 
+/**
+  * @brief  Sets the table of the dead time compensation applied by PWMC_SetPhaseVoltage() instead
+  *         of DTCompCnt, and enables the compensation. The table is kept by the caller. It must be
+  *         called with the PWM switched off.
+  * @param  pHandle handler on the target PWMC component.
+  * @param  pLut #PWMC_DTCOMP_LUT_POINTS points of phase A, then of phase B and C, in timer clock
+  *         cycles unit at 0 to #PWMC_DTCOMP_LUT_POINTS - 1 current steps, the last one applied above.
+  *         MC_NULL gives DTCompCnt back, and leaves the compensation enabled or not.
+  * @param  bShift current step, 2^bShift digits
+  * @retval none
+  */
+__weak void PWMC_SetDeadTimeLut(PWMC_Handle_t *pHandle, const uint16_t *pLut, uint8_t bShift)
+{
+#ifdef NULL_PTR_PWR_CUR_FDB
+  if (MC_NULL ==  pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->DTCompLutShift = bShift;
+    pHandle->pDTCompLut = pLut;
+    if (pLut != MC_NULL)
+    {
+      pHandle->DTTest = 1U;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_PWR_CUR_FDB
+  }
+#endif
+}
+
+/**
+  * @brief  Sets the timing of the current sampling in place of the one of the parameters
+  *         of the component. The sampling time of the ADC is changed at once: to be called
+  *         with the PWM switched off, or by the high frequency task once the currents are
+  *         read.
+  * @param  pHandle handle on the target PWMC component
+  * @param  pTiming timing of the sampling
+  * @retval bool False if the component does not support it or refuses the timing, that
+  *         is then not changed
+  */
+__weak bool PWMC_SetSamplingTiming(PWMC_Handle_t *pHandle, const PWMC_SampTiming_t *pTiming)
+{
+  bool retVal = false;
+#ifdef NULL_PTR_PWR_CUR_FDB
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+#endif
+  if (pHandle->pFctSetSamplingTiming != MC_NULL)
+  {
+    retVal = pHandle->pFctSetSamplingTiming(pHandle, pTiming);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (retVal);
+}
+
+/**
+  * @brief  Returns the timing of the current sampling in use
+  * @param  pHandle handle on the target PWMC component
+  */
+__weak const PWMC_SampTiming_t *PWMC_GetSamplingTiming(const PWMC_Handle_t *pHandle)
+{
+  return (&pHandle->SampTiming);
+}
+
+/**
+  * @brief  Forces the current sampling hTafter after the edge of the phase with the largest
+  *         compare value, even when the middle of the period is possible. Reserved to the
+  *         calibration of the timing, with the components that support
+  *         PWMC_SetSamplingTiming().
+  * @param  pHandle handle on the target PWMC component
+  * @param  Enable true to force the sampling after the edge
+  */
+__weak void PWMC_SetEdgeSampling(PWMC_Handle_t *pHandle, bool Enable)
+{
+  pHandle->EdgeSampling = Enable;
+}
+
 /**
  * @brief Sets the Callback that the PWMC component shall invoke to get phases current.
  * @param pCallBack pointer on the callback
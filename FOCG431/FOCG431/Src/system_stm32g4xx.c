@@ -178,6 +178,15 @@
 
 void SystemInit(void)
 {
+#if defined (CCMRAM) && defined (__GNUC__)
+  /* Symbols of the linker script, see the .ccmram section */
+  extern uint32_t _siccmram;
+  extern uint32_t _sccmram;
+  extern uint32_t _eccmram;
+  const uint32_t *pSrc = &_siccmram;
+  uint32_t *pDst = &_sccmram;
+#endif
+
   /* FPU settings ------------------------------------------------------------*/
   #if (__FPU_PRESENT == 1) && (__FPU_USED == 1)
     SCB->CPACR |= ((3UL << (10*2))|(3UL << (11*2)));  /* set CP10 and CP11 Full Access */
@@ -187,6 +196,16 @@ void SystemInit(void)
 #if defined(USER_VECT_TAB_ADDRESS)
   SCB->VTOR = VECT_TAB_BASE_ADDRESS | VECT_TAB_OFFSET; /* Vector Table Relocation in Internal SRAM */
 #endif /* USER_VECT_TAB_ADDRESS */
+
+#if defined (CCMRAM) && defined (__GNUC__)
+  /* Copy of the motor control code and data placed in the CCM SRAM --------*/
+  while (pDst < &_eccmram)
+  {
+    *pDst = *pSrc;
+    pDst++;
+    pSrc++;
+  }
+#endif
 }
 
 /**
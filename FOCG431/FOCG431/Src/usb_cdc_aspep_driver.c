@@ -0,0 +1,746 @@
+/**
+  ******************************************************************************
+  * @file    usb_cdc_aspep_driver.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   ASPEP physical layer over the USB device, as a CDC virtual COM port
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "main.h"
+#include "usb_cdc_aspep_driver.h"
+
+#ifdef MC_USB_CDC_MODE
+
+/* Endpoints: the data IN and OUT endpoints have their own numbers, so that each
+   endpoint register is only written for one direction */
+#define CDCASPEP_EP0_OUT        0x00U
+#define CDCASPEP_EP0_IN         0x80U
+#define CDCASPEP_EP_DATA_IN     0x81U
+#define CDCASPEP_EP_DATA_OUT    0x02U
+#define CDCASPEP_EP_NOTIF_IN    0x83U
+#define CDCASPEP_NOTIF_SIZE     8U
+
+/* Packet memory: the buffer table of the four endpoints, then their buffers */
+#define CDCASPEP_PMA_EP0_OUT    0x020U
+#define CDCASPEP_PMA_EP0_IN     0x060U
+#define CDCASPEP_PMA_DATA_IN0   0x0A0U
+#define CDCASPEP_PMA_DATA_IN1   0x0E0U
+#define CDCASPEP_PMA_DATA_OUT   0x120U
+#define CDCASPEP_PMA_NOTIF_IN   0x160U
+
+/* Standard requests */
+#define CDCASPEP_REQ_TYPE_MASK        0x60U
+#define CDCASPEP_REQ_TYPE_STANDARD    0x00U
+#define CDCASPEP_REQ_TYPE_CLASS       0x20U
+#define CDCASPEP_REQ_RECIPIENT_MASK   0x1FU
+#define CDCASPEP_REQ_RECIPIENT_EP     0x02U
+#define CDCASPEP_REQ_GET_STATUS       0x00U
+#define CDCASPEP_REQ_CLEAR_FEATURE    0x01U
+#define CDCASPEP_REQ_SET_FEATURE      0x03U
+#define CDCASPEP_REQ_SET_ADDRESS      0x05U
+#define CDCASPEP_REQ_GET_DESCRIPTOR   0x06U
+#define CDCASPEP_REQ_GET_CONFIGURATION 0x08U
+#define CDCASPEP_REQ_SET_CONFIGURATION 0x09U
+#define CDCASPEP_REQ_GET_INTERFACE    0x0AU
+#define CDCASPEP_REQ_SET_INTERFACE    0x0BU
+
+/* Class requests of the ACM subclass */
+#define CDCASPEP_REQ_SET_LINE_CODING  0x20U
+#define CDCASPEP_REQ_GET_LINE_CODING  0x21U
+#define CDCASPEP_REQ_SET_CONTROL_LINE_STATE 0x22U
+#define CDCASPEP_REQ_SEND_BREAK       0x23U
+
+#define CDCASPEP_DESC_DEVICE          0x01U
+#define CDCASPEP_DESC_CONFIGURATION   0x02U
+#define CDCASPEP_DESC_STRING          0x03U
+
+#define CDCASPEP_FEATURE_EP_HALT      0x00U
+
+#define CDCASPEP_LOBYTE(x)            ((uint8_t)((x) & 0xFFU))
+#define CDCASPEP_HIBYTE(x)            ((uint8_t)(((x) >> 8) & 0xFFU))
+
+/* Longest string, in characters */
+#define CDCASPEP_STRING_MAX           32U
+
+#define CDCASPEP_CONFIG_DESC_SIZE     67U
+
+static const uint8_t CDCASPEP_DeviceDesc[18] =
+{
+  18U, CDCASPEP_DESC_DEVICE,
+  0x00U, 0x02U,                   /* USB 2.0 */
+  0x02U, 0x00U, 0x00U,            /* Communications device */
+  CDCASPEP_PACKET_SIZE,           /* Max packet size of the control endpoint */
+  CDCASPEP_LOBYTE(CDCASPEP_VID), CDCASPEP_HIBYTE(CDCASPEP_VID),
+  CDCASPEP_LOBYTE(CDCASPEP_PID), CDCASPEP_HIBYTE(CDCASPEP_PID),
+  0x00U, 0x02U,                   /* Device release 2.00 */
+  1U, 2U, 3U,                     /* Manufacturer, product and serial number strings */
+  1U                              /* Configurations */
+};
+
+static const uint8_t CDCASPEP_ConfigDesc[CDCASPEP_CONFIG_DESC_SIZE] =
+{
+  /* Configuration */
+  9U, CDCASPEP_DESC_CONFIGURATION,
+  CDCASPEP_LOBYTE(CDCASPEP_CONFIG_DESC_SIZE), CDCASPEP_HIBYTE(CDCASPEP_CONFIG_DESC_SIZE),
+  2U, 1U, 0U,                     /* Interfaces, value of the configuration, no string */
+  0xC0U, 50U,                     /* Self powered, 100 mA */
+  /* Communication interface, abstract control model */
+  9U, 0x04U, 0U, 0U, 1U, 0x02U, 0x02U, 0x01U, 0U,
+  5U, 0x24U, 0x00U, 0x10U, 0x01U, /* Header, CDC 1.10 */
+  5U, 0x24U, 0x01U, 0x00U, 1U,    /* Call management, data interface 1 */
+  4U, 0x24U, 0x02U, 0x02U,        /* ACM, line coding and serial state */
+  5U, 0x24U, 0x06U, 0U, 1U,       /* Union of the interfaces 0 and 1 */
+  7U, 0x05U, CDCASPEP_EP_NOTIF_IN, 0x03U, CDCASPEP_NOTIF_SIZE, 0x00U, 16U,
+  /* Data interface */
+  9U, 0x04U, 1U, 0U, 2U, 0x0AU, 0x00U, 0x00U, 0U,
+  7U, 0x05U, CDCASPEP_EP_DATA_OUT, 0x02U, CDCASPEP_PACKET_SIZE, 0x00U, 0U,
+  7U, 0x05U, CDCASPEP_EP_DATA_IN, 0x02U, CDCASPEP_PACKET_SIZE, 0x00U, 0U
+};
+
+static const uint8_t CDCASPEP_LangIdDesc[4] = {4U, CDCASPEP_DESC_STRING, 0x09U, 0x04U};
+static const char CDCASPEP_Manufacturer[] = "STMicroelectronics";
+static const char CDCASPEP_Product[] = "Motor Control MCP";
+
+/* String descriptor of the last request */
+static uint8_t CDCASPEP_StringDesc[2U + (2U * CDCASPEP_STRING_MAX)];
+/* Unique device ID in hexadecimal */
+static char CDCASPEP_Serial[25];
+
+static void CDCASPEP_Process(CDCASPEP_Handle_t *pHandle);
+
+static void CDCASPEP_BuildSerial(void)
+{
+  const uint32_t *pUid = (const uint32_t *)UID_BASE; //cstat !MISRAC2012-Rule-11.4
+  static const char Hex[] = "0123456789ABCDEF";
+  uint8_t i;
+  uint8_t j;
+
+  for (i = 0U; i < 3U; i++)
+  {
+    uint32_t wWord = pUid[i];
+
+    for (j = 0U; j < 8U; j++)
+    {
+      CDCASPEP_Serial[(i * 8U) + j] = Hex[(wWord >> (28U - (4U * j))) & 0xFU];
+    }
+  }
+  CDCASPEP_Serial[24] = '\0';
+}
+
+static uint16_t CDCASPEP_BuildString(const char *pString)
+{
+  uint16_t hLength = 0U;
+
+  while ((pString[hLength] != '\0') && (hLength < CDCASPEP_STRING_MAX))
+  {
+    CDCASPEP_StringDesc[2U + (2U * hLength)] = (uint8_t)pString[hLength];
+    CDCASPEP_StringDesc[3U + (2U * hLength)] = 0U;
+    hLength++;
+  }
+  CDCASPEP_StringDesc[0] = (uint8_t)(2U + (2U * hLength));
+  CDCASPEP_StringDesc[1] = CDCASPEP_DESC_STRING;
+  return ((uint16_t)CDCASPEP_StringDesc[0]);
+}
+
+/* Returns the descriptor of wValue, NULL if the device has none */
+static const uint8_t *CDCASPEP_GetDescriptor(uint16_t wValue, uint16_t *pSize)
+{
+  const uint8_t *pDesc = NULL;
+  uint8_t bIndex = CDCASPEP_LOBYTE(wValue);
+
+  switch (CDCASPEP_HIBYTE(wValue))
+  {
+    case CDCASPEP_DESC_DEVICE:
+    {
+      pDesc = CDCASPEP_DeviceDesc;
+      *pSize = (uint16_t)sizeof(CDCASPEP_DeviceDesc);
+      break;
+    }
+
+    case CDCASPEP_DESC_CONFIGURATION:
+    {
+      pDesc = CDCASPEP_ConfigDesc;
+      *pSize = (uint16_t)sizeof(CDCASPEP_ConfigDesc);
+      break;
+    }
+
+    case CDCASPEP_DESC_STRING:
+    {
+      if (0U == bIndex)
+      {
+        pDesc = CDCASPEP_LangIdDesc;
+        *pSize = (uint16_t)sizeof(CDCASPEP_LangIdDesc);
+      }
+      else if (bIndex <= 3U)
+      {
+        const char *pString = (1U == bIndex) ? CDCASPEP_Manufacturer
+                            : ((2U == bIndex) ? CDCASPEP_Product : CDCASPEP_Serial);
+        *pSize = CDCASPEP_BuildString(pString);
+        pDesc = CDCASPEP_StringDesc;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      break;
+    }
+
+    default:
+    {
+      /* No device qualifier: the device is full speed only */
+      break;
+    }
+  }
+  return (pDesc);
+}
+
+static void CDCASPEP_Ep0SendNext(CDCASPEP_Handle_t *pHandle)
+{
+  uint16_t hChunk = (pHandle->hEp0Remaining < CDCASPEP_PACKET_SIZE) ? pHandle->hEp0Remaining
+                                                                    : (uint16_t)CDCASPEP_PACKET_SIZE;
+
+  (void)HAL_PCD_EP_Transmit(&pHandle->PCD, CDCASPEP_EP0_IN, (uint8_t *)pHandle->pEp0Data, hChunk);
+  pHandle->pEp0Data = &pHandle->pEp0Data[hChunk];
+  pHandle->hEp0Remaining -= hChunk;
+}
+
+/* Data IN stage of a request: hSize bytes, at most the wLength asked by the host */
+static void CDCASPEP_Ep0Send(CDCASPEP_Handle_t *pHandle, const uint8_t *pData, uint16_t hSize, uint16_t wLength)
+{
+  uint16_t hLength = (hSize < wLength) ? hSize : wLength;
+
+  pHandle->pEp0Data = pData;
+  pHandle->hEp0Remaining = hLength;
+  pHandle->Ep0Zlp = (hLength < wLength) && (0U == (hLength % CDCASPEP_PACKET_SIZE));
+  pHandle->Ep0Stage = CDCASPEP_EP0_DATA_IN;
+  CDCASPEP_Ep0SendNext(pHandle);
+}
+
+static void CDCASPEP_Ep0Status(CDCASPEP_Handle_t *pHandle)
+{
+  pHandle->Ep0Stage = CDCASPEP_EP0_STATUS_IN;
+  (void)HAL_PCD_EP_Transmit(&pHandle->PCD, CDCASPEP_EP0_IN, NULL, 0U);
+}
+
+static void CDCASPEP_Ep0Stall(CDCASPEP_Handle_t *pHandle)
+{
+  pHandle->Ep0Stage = CDCASPEP_EP0_IDLE;
+  (void)HAL_PCD_EP_SetStall(&pHandle->PCD, CDCASPEP_EP0_IN);
+  (void)HAL_PCD_EP_SetStall(&pHandle->PCD, CDCASPEP_EP0_OUT);
+}
+
+/* Drops the transfers of the configuration: the send in progress is completed for
+   ASPEP, that goes on with its next buffer */
+static void CDCASPEP_Unconfigure(CDCASPEP_Handle_t *pHandle)
+{
+  pHandle->bConfiguration = 0U;
+  pHandle->RxArmed = false;
+  pHandle->hRxPacketLength = 0U;
+  pHandle->hRxPacketRead = 0U;
+  if (true == pHandle->TxBusy)
+  {
+    pHandle->TxBusy = false;
+    pHandle->TxZlp = false;
+    ASPEP_HWDataTransmittedIT(pHandle->pASPEP);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+static void CDCASPEP_SetConfiguration(CDCASPEP_Handle_t *pHandle, uint8_t bConfiguration)
+{
+  PCD_HandleTypeDef *pPCD = &pHandle->PCD;
+
+  if ((1U == bConfiguration) && (0U == pHandle->bConfiguration))
+  {
+    (void)HAL_PCD_EP_Open(pPCD, CDCASPEP_EP_DATA_IN, CDCASPEP_PACKET_SIZE, EP_TYPE_BULK);
+    (void)HAL_PCD_EP_Open(pPCD, CDCASPEP_EP_DATA_OUT, CDCASPEP_PACKET_SIZE, EP_TYPE_BULK);
+    (void)HAL_PCD_EP_Open(pPCD, CDCASPEP_EP_NOTIF_IN, CDCASPEP_NOTIF_SIZE, EP_TYPE_INTR);
+    pHandle->bConfiguration = 1U;
+  }
+  else if ((0U == bConfiguration) && (pHandle->bConfiguration != 0U))
+  {
+    (void)HAL_PCD_EP_Close(pPCD, CDCASPEP_EP_DATA_IN);
+    (void)HAL_PCD_EP_Close(pPCD, CDCASPEP_EP_DATA_OUT);
+    (void)HAL_PCD_EP_Close(pPCD, CDCASPEP_EP_NOTIF_IN);
+    CDCASPEP_Unconfigure(pHandle);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+static void CDCASPEP_StandardRequest(CDCASPEP_Handle_t *pHandle, const uint8_t *pSetup)
+{
+  uint16_t wValue = (uint16_t)pSetup[2] | ((uint16_t)pSetup[3] << 8);
+  uint16_t wIndex = (uint16_t)pSetup[4] | ((uint16_t)pSetup[5] << 8);
+  uint16_t wLength = (uint16_t)pSetup[6] | ((uint16_t)pSetup[7] << 8);
+
+  switch (pSetup[1])
+  {
+    case CDCASPEP_REQ_GET_DESCRIPTOR:
+    {
+      uint16_t hSize = 0U;
+      const uint8_t *pDesc = CDCASPEP_GetDescriptor(wValue, &hSize);
+
+      if (NULL == pDesc)
+      {
+        CDCASPEP_Ep0Stall(pHandle);
+      }
+      else
+      {
+        CDCASPEP_Ep0Send(pHandle, pDesc, hSize, wLength);
+      }
+      break;
+    }
+
+    case CDCASPEP_REQ_SET_ADDRESS:
+    {
+      /* Applied by the PCD driver once the status stage is sent */
+      (void)HAL_PCD_SetAddress(&pHandle->PCD, (uint8_t)(wValue & 0x7FU));
+      CDCASPEP_Ep0Status(pHandle);
+      break;
+    }
+
+    case CDCASPEP_REQ_SET_CONFIGURATION:
+    {
+      if (wValue <= 1U)
+      {
+        CDCASPEP_SetConfiguration(pHandle, (uint8_t)wValue);
+        CDCASPEP_Ep0Status(pHandle);
+      }
+      else
+      {
+        CDCASPEP_Ep0Stall(pHandle);
+      }
+      break;
+    }
+
+    case CDCASPEP_REQ_GET_CONFIGURATION:
+    {
+      pHandle->Ep0Buffer[0] = pHandle->bConfiguration;
+      CDCASPEP_Ep0Send(pHandle, pHandle->Ep0Buffer, 1U, wLength);
+      break;
+    }
+
+    case CDCASPEP_REQ_GET_STATUS:
+    {
+      /* Self powered device, no halted endpoint */
+      pHandle->Ep0Buffer[0] = (0U == (pSetup[0] & CDCASPEP_REQ_RECIPIENT_MASK)) ? 1U : 0U;
+      pHandle->Ep0Buffer[1] = 0U;
+      CDCASPEP_Ep0Send(pHandle, pHandle->Ep0Buffer, 2U, wLength);
+      break;
+    }
+
+    case CDCASPEP_REQ_CLEAR_FEATURE:
+    case CDCASPEP_REQ_SET_FEATURE:
+    {
+      if ((CDCASPEP_REQ_RECIPIENT_EP == (pSetup[0] & CDCASPEP_REQ_RECIPIENT_MASK))
+          && (CDCASPEP_FEATURE_EP_HALT == wValue) && ((wIndex & 0x7FU) != 0U))
+      {
+        if (CDCASPEP_REQ_SET_FEATURE == pSetup[1])
+        {
+          (void)HAL_PCD_EP_SetStall(&pHandle->PCD, (uint8_t)wIndex);
+        }
+        else
+        {
+          (void)HAL_PCD_EP_ClrStall(&pHandle->PCD, (uint8_t)wIndex);
+        }
+      }
+      else
+      {
+        /* Remote wake up is not supported, the request is acknowledged */
+      }
+      CDCASPEP_Ep0Status(pHandle);
+      break;
+    }
+
+    case CDCASPEP_REQ_GET_INTERFACE:
+    {
+      pHandle->Ep0Buffer[0] = 0U;
+      CDCASPEP_Ep0Send(pHandle, pHandle->Ep0Buffer, 1U, wLength);
+      break;
+    }
+
+    case CDCASPEP_REQ_SET_INTERFACE:
+    {
+      /* The interfaces have a single alternate setting */
+      if (0U == wValue)
+      {
+        CDCASPEP_Ep0Status(pHandle);
+      }
+      else
+      {
+        CDCASPEP_Ep0Stall(pHandle);
+      }
+      break;
+    }
+
+    default:
+    {
+      CDCASPEP_Ep0Stall(pHandle);
+      break;
+    }
+  }
+}
+
+static void CDCASPEP_ClassRequest(CDCASPEP_Handle_t *pHandle, const uint8_t *pSetup)
+{
+  uint16_t wLength = (uint16_t)pSetup[6] | ((uint16_t)pSetup[7] << 8);
+
+  switch (pSetup[1])
+  {
+    case CDCASPEP_REQ_SET_LINE_CODING:
+    {
+      if (CDCASPEP_LINE_CODING_SIZE == wLength)
+      {
+        pHandle->bEp0Request = pSetup[1];
+        pHandle->Ep0Stage = CDCASPEP_EP0_DATA_OUT;
+        (void)HAL_PCD_EP_Receive(&pHandle->PCD, CDCASPEP_EP0_OUT, pHandle->Ep0Buffer, wLength);
+      }
+      else
+      {
+        CDCASPEP_Ep0Stall(pHandle);
+      }
+      break;
+    }
+
+    case CDCASPEP_REQ_GET_LINE_CODING:
+    {
+      CDCASPEP_Ep0Send(pHandle, pHandle->LineCoding, CDCASPEP_LINE_CODING_SIZE, wLength);
+      break;
+    }
+
+    case CDCASPEP_REQ_SET_CONTROL_LINE_STATE:
+    case CDCASPEP_REQ_SEND_BREAK:
+    {
+      /* The link does not depend on the control lines of the host */
+      CDCASPEP_Ep0Status(pHandle);
+      break;
+    }
+
+    default:
+    {
+      CDCASPEP_Ep0Stall(pHandle);
+      break;
+    }
+  }
+}
+
+/**
+ * @brief  Starts the USB device. The host enumerates it once the pull-up of its data
+ *         line is enabled, in the USB interrupt.
+ */
+void CDCASPEP_INIT(void *pHWHandle)
+{
+  CDCASPEP_Handle_t *pHandle = (CDCASPEP_Handle_t *)pHWHandle; //cstat !MISRAC2012-Rule-11.5
+  PCD_HandleTypeDef *pPCD = &pHandle->PCD;
+  static const uint8_t DefaultLineCoding[CDCASPEP_LINE_CODING_SIZE] =
+  {
+    0x00U, 0xC2U, 0x01U, 0x00U,   /* 115200 bit/s */
+    0U, 0U, 8U                    /* 1 stop bit, no parity, 8 data bits */
+  };
+
+  (void)memcpy(pHandle->LineCoding, DefaultLineCoding, CDCASPEP_LINE_CODING_SIZE);
+  CDCASPEP_BuildSerial();
+  pHandle->bConfiguration = 0U;
+  pHandle->TxBusy = false;
+  pHandle->TxRequest = false;
+  pHandle->pRxTarget = NULL;
+  pHandle->ResyncRequest = false;
+  pHandle->RxArmed = false;
+  pHandle->hRxPacketLength = 0U;
+  pHandle->hRxPacketRead = 0U;
+  pHandle->Ep0Stage = CDCASPEP_EP0_IDLE;
+
+  pPCD->pData = pHandle;
+  pPCD->Instance = USB;
+  pPCD->Init.dev_endpoints = 8U;
+  pPCD->Init.speed = PCD_SPEED_FULL;
+  pPCD->Init.phy_itface = PCD_PHY_EMBEDDED;
+  pPCD->Init.Sof_enable = DISABLE;
+  pPCD->Init.low_power_enable = DISABLE;
+  pPCD->Init.lpm_enable = DISABLE;
+  pPCD->Init.battery_charging_enable = DISABLE;
+  if (HAL_PCD_Init(pPCD) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  (void)HAL_PCDEx_PMAConfig(pPCD, CDCASPEP_EP0_OUT, PCD_SNG_BUF, CDCASPEP_PMA_EP0_OUT);
+  (void)HAL_PCDEx_PMAConfig(pPCD, CDCASPEP_EP0_IN, PCD_SNG_BUF, CDCASPEP_PMA_EP0_IN);
+  (void)HAL_PCDEx_PMAConfig(pPCD, CDCASPEP_EP_DATA_IN, PCD_DBL_BUF,
+                            CDCASPEP_PMA_DATA_IN0 | (CDCASPEP_PMA_DATA_IN1 << 16));
+  (void)HAL_PCDEx_PMAConfig(pPCD, CDCASPEP_EP_DATA_OUT, PCD_SNG_BUF, CDCASPEP_PMA_DATA_OUT);
+  (void)HAL_PCDEx_PMAConfig(pPCD, CDCASPEP_EP_NOTIF_IN, PCD_SNG_BUF, CDCASPEP_PMA_NOTIF_IN);
+  (void)HAL_PCD_Start(pPCD);
+}
+
+/**
+ * @brief  Requests the send of a buffer, started by the USB interrupt. ASPEP only
+ *         requests it once the previous one is transmitted.
+ */
+bool CDCASPEP_SEND_PACKET(void *pHWHandle, void *data, uint16_t length)
+{
+  CDCASPEP_Handle_t *pHandle = (CDCASPEP_Handle_t *)pHWHandle; //cstat !MISRAC2012-Rule-11.5
+
+  pHandle->pTxData = (uint8_t *)data; //cstat !MISRAC2012-Rule-11.5
+  pHandle->hTxLength = length;
+  pHandle->TxRequest = true;
+  NVIC_SetPendingIRQ(USB_LP_IRQn);
+  return (true);
+}
+
+/**
+ * @brief  Requests the next length bytes received, ASPEP_HWDataReceivedIT is called
+ *         by the USB interrupt once they are in the buffer.
+ */
+void CDCASPEP_RECEIVE_BUFFER(void *pHWHandle, void *buffer, uint16_t length)
+{
+  CDCASPEP_Handle_t *pHandle = (CDCASPEP_Handle_t *)pHWHandle; //cstat !MISRAC2012-Rule-11.5
+
+  pHandle->hRxGot = 0U;
+  pHandle->hRxWanted = length;
+  pHandle->pRxTarget = (uint8_t *)buffer; //cstat !MISRAC2012-Rule-11.5
+  NVIC_SetPendingIRQ(USB_LP_IRQn);
+}
+
+/**
+ * @brief  Resynchronizes ASPEP after a bad header: the rest of the last packet is
+ *         dropped, then ASPEP_HWDMAReset waits for the next header.
+ */
+void CDCASPEP_IDLE_ENABLE(void *pHWHandle)
+{
+  CDCASPEP_Handle_t *pHandle = (CDCASPEP_Handle_t *)pHWHandle; //cstat !MISRAC2012-Rule-11.5
+
+  pHandle->ResyncRequest = true;
+  NVIC_SetPendingIRQ(USB_LP_IRQn);
+}
+
+void CDCASPEP_IRQHandler(CDCASPEP_Handle_t *pHandle)
+{
+  HAL_PCD_IRQHandler(&pHandle->PCD);
+  CDCASPEP_Process(pHandle);
+}
+
+/* Moves the transfers requested by ASPEP, until none can progress */
+static void CDCASPEP_Process(CDCASPEP_Handle_t *pHandle)
+{
+  bool Progress;
+
+  do
+  {
+    Progress = false;
+
+    if ((true == pHandle->TxRequest) && (false == pHandle->TxBusy))
+    {
+      pHandle->TxRequest = false;
+      if (0U == pHandle->bConfiguration)
+      {
+        /* No host: the packet is dropped */
+        ASPEP_HWDataTransmittedIT(pHandle->pASPEP);
+      }
+      else
+      {
+        pHandle->TxBusy = true;
+        pHandle->TxZlp = (0U == (pHandle->hTxLength % CDCASPEP_PACKET_SIZE));
+        (void)HAL_PCD_EP_Transmit(&pHandle->PCD, CDCASPEP_EP_DATA_IN, pHandle->pTxData, pHandle->hTxLength);
+      }
+      Progress = true;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    if (true == pHandle->ResyncRequest)
+    {
+      pHandle->ResyncRequest = false;
+      pHandle->hRxPacketRead = pHandle->hRxPacketLength;
+      ASPEP_HWDMAReset(pHandle->pASPEP);
+      Progress = true;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    if ((pHandle->pRxTarget != NULL) && (pHandle->hRxPacketRead < pHandle->hRxPacketLength))
+    {
+      uint16_t hWanted = pHandle->hRxWanted - pHandle->hRxGot;
+      uint16_t hAvailable = pHandle->hRxPacketLength - pHandle->hRxPacketRead;
+      uint16_t hCopy = (hWanted < hAvailable) ? hWanted : hAvailable;
+
+      (void)memcpy(&pHandle->pRxTarget[pHandle->hRxGot], &pHandle->RxPacket[pHandle->hRxPacketRead], hCopy);
+      pHandle->hRxGot += hCopy;
+      pHandle->hRxPacketRead += hCopy;
+      if (pHandle->hRxGot >= pHandle->hRxWanted)
+      {
+        /* ASPEP may request the next bytes at once */
+        pHandle->pRxTarget = NULL;
+        ASPEP_HWDataReceivedIT(pHandle->pASPEP);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      Progress = true;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  } while (true == Progress);
+
+  /* The host is held by NAKs until the last packet is taken */
+  if ((pHandle->bConfiguration != 0U) && (false == pHandle->RxArmed)
+      && (pHandle->hRxPacketRead >= pHandle->hRxPacketLength))
+  {
+    pHandle->RxArmed = true;
+    (void)HAL_PCD_EP_Receive(&pHandle->PCD, CDCASPEP_EP_DATA_OUT, pHandle->RxPacket, CDCASPEP_PACKET_SIZE);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/* Callbacks of the HAL PCD driver, in the USB interrupt ----------------------*/
+
+void HAL_PCD_ResetCallback(PCD_HandleTypeDef *hpcd)
+{
+  CDCASPEP_Handle_t *pHandle = (CDCASPEP_Handle_t *)hpcd->pData; //cstat !MISRAC2012-Rule-11.5
+
+  (void)HAL_PCD_EP_Open(hpcd, CDCASPEP_EP0_OUT, CDCASPEP_PACKET_SIZE, EP_TYPE_CTRL);
+  (void)HAL_PCD_EP_Open(hpcd, CDCASPEP_EP0_IN, CDCASPEP_PACKET_SIZE, EP_TYPE_CTRL);
+  pHandle->Ep0Stage = CDCASPEP_EP0_IDLE;
+  CDCASPEP_Unconfigure(pHandle);
+}
+
+void HAL_PCD_SetupStageCallback(PCD_HandleTypeDef *hpcd)
+{
+  CDCASPEP_Handle_t *pHandle = (CDCASPEP_Handle_t *)hpcd->pData; //cstat !MISRAC2012-Rule-11.5
+  const uint8_t *pSetup = (const uint8_t *)hpcd->Setup;
+
+  switch (pSetup[0] & CDCASPEP_REQ_TYPE_MASK)
+  {
+    case CDCASPEP_REQ_TYPE_STANDARD:
+    {
+      CDCASPEP_StandardRequest(pHandle, pSetup);
+      break;
+    }
+
+    case CDCASPEP_REQ_TYPE_CLASS:
+    {
+      CDCASPEP_ClassRequest(pHandle, pSetup);
+      break;
+    }
+
+    default:
+    {
+      CDCASPEP_Ep0Stall(pHandle);
+      break;
+    }
+  }
+}
+
+void HAL_PCD_DataInStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
+{
+  CDCASPEP_Handle_t *pHandle = (CDCASPEP_Handle_t *)hpcd->pData; //cstat !MISRAC2012-Rule-11.5
+
+  if (0U == epnum)
+  {
+    if (CDCASPEP_EP0_DATA_IN == pHandle->Ep0Stage)
+    {
+      if (pHandle->hEp0Remaining > 0U)
+      {
+        CDCASPEP_Ep0SendNext(pHandle);
+      }
+      else if (true == pHandle->Ep0Zlp)
+      {
+        pHandle->Ep0Zlp = false;
+        CDCASPEP_Ep0SendNext(pHandle);
+      }
+      else
+      {
+        pHandle->Ep0Stage = CDCASPEP_EP0_STATUS_OUT;
+        (void)HAL_PCD_EP_Receive(hpcd, CDCASPEP_EP0_OUT, NULL, 0U);
+      }
+    }
+    else
+    {
+      /* End of the status stage */
+      pHandle->Ep0Stage = CDCASPEP_EP0_IDLE;
+    }
+  }
+  else if ((CDCASPEP_EP_DATA_IN & 0x7FU) == epnum)
+  {
+    if (true == pHandle->TxZlp)
+    {
+      /* The host only ends its read on a short packet */
+      pHandle->TxZlp = false;
+      (void)HAL_PCD_EP_Transmit(hpcd, CDCASPEP_EP_DATA_IN, NULL, 0U);
+    }
+    else
+    {
+      pHandle->TxBusy = false;
+      ASPEP_HWDataTransmittedIT(pHandle->pASPEP);
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+void HAL_PCD_DataOutStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
+{
+  CDCASPEP_Handle_t *pHandle = (CDCASPEP_Handle_t *)hpcd->pData; //cstat !MISRAC2012-Rule-11.5
+
+  if (0U == epnum)
+  {
+    if ((CDCASPEP_EP0_DATA_OUT == pHandle->Ep0Stage)
+        && (CDCASPEP_REQ_SET_LINE_CODING == pHandle->bEp0Request)
+        && (HAL_PCD_EP_GetRxCount(hpcd, CDCASPEP_EP0_OUT) >= CDCASPEP_LINE_CODING_SIZE))
+    {
+      (void)memcpy(pHandle->LineCoding, pHandle->Ep0Buffer, CDCASPEP_LINE_CODING_SIZE);
+      CDCASPEP_Ep0Status(pHandle);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else if (CDCASPEP_EP_DATA_OUT == epnum)
+  {
+    pHandle->hRxPacketLength = (uint16_t)HAL_PCD_EP_GetRxCount(hpcd, CDCASPEP_EP_DATA_OUT);
+    pHandle->hRxPacketRead = 0U;
+    pHandle->RxArmed = false;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+#endif /* MC_USB_CDC_MODE */
+
+/************************ (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,29 @@
+/**
+  ******************************************************************************
+  * @file    main.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Host replacement of the main.h of the ports for the software in the
+  *          loop build of the controllers
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MAIN_H
+#define MAIN_H
+
+/* The modules of the port built on the host only take the CMSIS core functions and the
+   DWT from main.h, without the HAL */
+#include "mc_stm_types.h"
+
+#endif /* MAIN_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
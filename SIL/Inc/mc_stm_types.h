@@ -0,0 +1,70 @@
+/**
+  ******************************************************************************
+  * @file    mc_stm_types.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Host replacement of the mc_stm_types.h of the ports for the software
+  *          in the loop build of the controllers
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+#ifndef MC_STM_TYPES_H
+#define MC_STM_TYPES_H
+
+/* mc_type.h includes <mc_stm_types.h>, found here before the Inc directory of the port:
+   the LL drivers and mc_board.h of the port are not included, so that mc_math.c runs its
+   table based variant, without the CORDIC. The options of the predictive current
+   controller are left to the defaults of pcc.h and are set with the -D options of the
+   build, e.g. -DPCC_HORIZON=2U, as they are set in mc_stm_types.h on the target. The
+   FMAC of the G4 ports, used by the regulators with PID_FMAC, is the model of sil_fmac.h. */
+
+#include <stddef.h>
+#include "sil_cmsis.h"
+#include "sil_fmac.h"
+
+/* From the device header, used by the parameters of the drive */
+typedef enum
+{
+  DISABLE = 0,
+  ENABLE = !DISABLE
+} FunctionalState;
+
+/* From the device header, for the handle of the bus voltage sensor read by the feed forward */
+typedef struct
+{
+  volatile uint32_t DR;
+} ADC_TypeDef;
+
+#define U_RPM 60
+#define U_01HZ 10
+
+#define CURR_CTRL_PI 0
+#define CURR_CTRL_PCC 1
+
+#define SPD_CTRL_PI 0
+#define SPD_CTRL_MPC 1
+
+#define SPEED_UNIT U_01HZ
+
+#ifndef CURRENT_CONTROLLER
+#define CURRENT_CONTROLLER CURR_CTRL_PCC
+#endif
+
+#define SPEED_CONTROLLER SPD_CTRL_PI
+
+#define MC_MATH_INLINE
+
+#define RPM_2_SPEED_UNIT(rpm)   ((int16_t)(((rpm)*SPEED_UNIT)/U_RPM)) /*!< Convenient macro to convert user friendly RPM into SpeedUnit used by MC API */
+#define SPEED_UNIT_2_RPM(speed)   ((int16_t)(((speed)*U_RPM)/SPEED_UNIT)) /*!< Convenient macro to convert SpeedUnit used by MC API into user friendly RPM */
+
+#endif /* MC_STM_TYPES_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
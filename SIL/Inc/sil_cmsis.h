@@ -0,0 +1,131 @@
+/**
+  ******************************************************************************
+  * @file    sil_cmsis.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Host stubs of the CMSIS core functions used by the motor control library
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef SIL_CMSIS_H
+#define SIL_CMSIS_H
+
+#include <stdint.h>
+
+/* The Cortex-M4 SIMD and saturating instructions are given in C with the results of the
+   instructions, Q flag aside and with the 32 bit wrap around of the dual products, so
+   that the library computes on the host the same values as on the target. The interrupt
+   masking is a no operation: the host build is single threaded. The cycle counter of the
+   DWT is a variable, that the host sets from its clock around the code it times. */
+
+#define __weak              __attribute__((weak))
+#define __STATIC_INLINE     static inline
+
+typedef struct
+{
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} SIL_DWT_t;
+
+typedef struct
+{
+  volatile uint32_t DEMCR;
+} SIL_CoreDebug_t;
+
+extern SIL_DWT_t SilDWT;
+extern SIL_CoreDebug_t SilCoreDebug;
+
+#define DWT                             (&SilDWT)
+#define CoreDebug                       (&SilCoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk          (1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << 24)
+
+static inline void __DMB(void)
+{
+  __sync_synchronize();
+}
+
+static inline void __disable_irq(void)
+{
+}
+
+static inline void __enable_irq(void)
+{
+}
+
+static inline uint32_t __get_PRIMASK(void)
+{
+  return (0U);
+}
+
+static inline void __set_PRIMASK(uint32_t priMask)
+{
+  (void)priMask;
+}
+
+static inline int32_t __SSAT(int32_t val, uint32_t sat)
+{
+  int32_t result = val;
+
+  if ((sat >= 1U) && (sat <= 32U))
+  {
+    const int32_t max = (int32_t)((1U << (sat - 1U)) - 1U);
+    const int32_t min = -1 - max;
+
+    result = (val > max) ? max : ((val < min) ? min : val);
+  }
+  return (result);
+}
+
+static inline int32_t __QADD(int32_t op1, int32_t op2)
+{
+  int64_t sum = (int64_t)op1 + (int64_t)op2;
+
+  return ((sum > INT32_MAX) ? INT32_MAX : ((sum < INT32_MIN) ? INT32_MIN : (int32_t)sum));
+}
+
+static inline int64_t SIL_Lo16(uint32_t op)
+{
+  return ((int64_t)(int16_t)(uint16_t)op);
+}
+
+static inline int64_t SIL_Hi16(uint32_t op)
+{
+  return ((int64_t)(int16_t)(uint16_t)(op >> 16));
+}
+
+static inline uint32_t __SMUAD(uint32_t op1, uint32_t op2)
+{
+  return ((uint32_t)((SIL_Lo16(op1) * SIL_Lo16(op2)) + (SIL_Hi16(op1) * SIL_Hi16(op2))));
+}
+
+static inline uint32_t __SMUADX(uint32_t op1, uint32_t op2)
+{
+  return ((uint32_t)((SIL_Lo16(op1) * SIL_Hi16(op2)) + (SIL_Hi16(op1) * SIL_Lo16(op2))));
+}
+
+static inline uint32_t __SMUSD(uint32_t op1, uint32_t op2)
+{
+  return ((uint32_t)((SIL_Lo16(op1) * SIL_Lo16(op2)) - (SIL_Hi16(op1) * SIL_Hi16(op2))));
+}
+
+static inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3)
+{
+  return (op3 + __SMUAD(op1, op2));
+}
+
+#define __PKHBT(ARG1, ARG2, ARG3) ((((uint32_t)(ARG1)) & 0x0000FFFFUL) | \
+                                   ((((uint32_t)(ARG2)) << (ARG3)) & 0xFFFF0000UL))
+
+#endif /* SIL_CMSIS_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
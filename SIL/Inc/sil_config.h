@@ -0,0 +1,42 @@
+/**
+  ******************************************************************************
+  * @file    sil_config.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Handles of the controllers run by the software in the loop build
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef SIL_CONFIG_H
+#define SIL_CONFIG_H
+
+#include "pid_regulator.h"
+#include "circle_limitation.h"
+#include "sto_pll_speed_pos_fdbk.h"
+#include "pcc.h"
+#include "feed_forward_ctrl.h"
+#include "r_divider_bus_voltage_sensor.h"
+#include "mc_curr_regulation.h"
+
+extern PID_Handle_t PIDIqHandle_M1;
+extern PID_Handle_t PIDIdHandle_M1;
+extern STO_PLL_Handle_t STO_PLL_M1;
+extern CircleLimitation_Handle_t CircleLimitationM1;
+extern FF_Handle_t FF_M1;
+extern RDivider_Handle_t BusVoltageSensor_M1;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+extern PCC_Handle_t PCC_M1;
+#endif
+
+#endif /* SIL_CONFIG_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
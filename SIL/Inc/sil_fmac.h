@@ -0,0 +1,267 @@
+/**
+  ******************************************************************************
+  * @file    sil_fmac.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Host model of the G4 FMAC, with the LL functions used by the motor
+  *          control library
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef SIL_FMAC_H
+#define SIL_FMAC_H
+
+#include <stdint.h>
+
+/* The FMAC is modelled at the level of the LL functions, which replace the ones of
+   stm32g4xx_ll_fmac.h: the buffers are areas of the 256 words of the local memory, the load
+   functions write them from their base, the oldest value first, and the FIR and IIR
+   filters compute an output each time an input is written, once the X1 buffer holds their
+   P taps. An output is the sum of the products, of the inputs by the feed forward
+   coefficients and of the previous outputs by the feedback ones, shifted left by R from
+   q2.30 and truncated to q1.15, then clipped or wrapped. Only the buffer contents and the
+   START bit are modelled: no watermarks, flags other than YEMPTY, interrupts or DMA. */
+
+#define SIL_FMAC_MEM_SIZE  256U
+
+typedef struct
+{
+  int16_t Mem[SIL_FMAC_MEM_SIZE];
+  uint8_t X1Base;
+  uint8_t X1Size;
+  uint8_t X2Base;
+  uint8_t X2Size;
+  uint8_t YBase;
+  uint8_t YSize;
+  uint32_t Function;
+  uint8_t P;
+  uint8_t Q;
+  uint8_t R;
+  uint8_t Start;
+  uint8_t Clip;
+  uint8_t Reset;
+  uint16_t Loaded;                  /* Values written by the current load */
+  uint8_t X1Count;                  /* Inputs in the X1 buffer, the last at X1Next - 1 */
+  uint8_t X1Next;
+  uint8_t YCount;                   /* Outputs in the Y buffer, the last at YNext - 1 */
+  uint8_t YNext;
+  uint8_t YUnread;
+} SIL_FMAC_t;
+
+typedef SIL_FMAC_t FMAC_TypeDef;
+
+extern SIL_FMAC_t SilFMAC;
+
+#define FMAC                              (&SilFMAC)
+
+#define LL_AHB1_GRP1_PERIPH_FMAC          (1UL << 4)
+#define LL_FMAC_WM_0_THRESHOLD_1          0x00000000U
+#define LL_FMAC_PROCESSING_STOP           0x00U
+#define LL_FMAC_PROCESSING_START          0x01U
+#define LL_FMAC_FUNC_LOAD_X1              0x01000000U
+#define LL_FMAC_FUNC_LOAD_X2              0x02000000U
+#define LL_FMAC_FUNC_LOAD_Y               0x03000000U
+#define LL_FMAC_FUNC_CONVO_FIR            0x08000000U
+#define LL_FMAC_FUNC_IIR_DIRECT_FORM_1    0x09000000U
+
+static inline void LL_AHB1_GRP1_EnableClock(uint32_t Periphs)
+{
+  (void)Periphs;
+}
+
+static inline void LL_FMAC_EnableReset(FMAC_TypeDef *FMACx)
+{
+  FMACx->Start = 0U;
+  FMACx->X1Count = 0U;
+  FMACx->YCount = 0U;
+  FMACx->YUnread = 0U;
+  FMACx->Reset = 0U;
+}
+
+static inline uint32_t LL_FMAC_IsEnabledReset(FMAC_TypeDef *FMACx)
+{
+  return ((uint32_t)FMACx->Reset);
+}
+
+static inline void LL_FMAC_EnableClipping(FMAC_TypeDef *FMACx)
+{
+  FMACx->Clip = 1U;
+}
+
+static inline void LL_FMAC_DisableClipping(FMAC_TypeDef *FMACx)
+{
+  FMACx->Clip = 0U;
+}
+
+static inline void LL_FMAC_ConfigX1(FMAC_TypeDef *FMACx, uint32_t Watermark, uint8_t Base, uint8_t BufferSize)
+{
+  (void)Watermark;
+  FMACx->X1Base = Base;
+  FMACx->X1Size = BufferSize;
+}
+
+static inline void LL_FMAC_ConfigX2(FMAC_TypeDef *FMACx, uint8_t Base, uint8_t BufferSize)
+{
+  FMACx->X2Base = Base;
+  FMACx->X2Size = BufferSize;
+}
+
+static inline void LL_FMAC_ConfigY(FMAC_TypeDef *FMACx, uint32_t Watermark, uint8_t Base, uint8_t BufferSize)
+{
+  (void)Watermark;
+  FMACx->YBase = Base;
+  FMACx->YSize = BufferSize;
+}
+
+/* Starting a filter keeps the preloaded values of the buffers, starting a load restarts it */
+static inline void LL_FMAC_ConfigFunc(FMAC_TypeDef *FMACx, uint8_t Start, uint32_t Function, uint8_t ParamP,
+                                      uint8_t ParamQ, uint8_t ParamR)
+{
+  FMACx->Function = Function;
+  FMACx->P = ParamP;
+  FMACx->Q = ParamQ;
+  FMACx->R = ParamR;
+  FMACx->Start = Start;
+  FMACx->Loaded = 0U;
+  if ((LL_FMAC_PROCESSING_START == Start) && (LL_FMAC_FUNC_LOAD_X1 == Function))
+  {
+    FMACx->X1Count = 0U;
+    FMACx->X1Next = 0U;
+  }
+  else if ((LL_FMAC_PROCESSING_START == Start) && (LL_FMAC_FUNC_LOAD_Y == Function))
+  {
+    FMACx->YCount = 0U;
+    FMACx->YNext = 0U;
+    FMACx->YUnread = 0U;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+static inline void LL_FMAC_DisableStart(FMAC_TypeDef *FMACx)
+{
+  FMACx->Start = 0U;
+}
+
+static inline uint32_t LL_FMAC_IsEnabledStart(FMAC_TypeDef *FMACx)
+{
+  return ((uint32_t)FMACx->Start);
+}
+
+static inline uint32_t LL_FMAC_IsActiveFlag_YEMPTY(FMAC_TypeDef *FMACx)
+{
+  return ((0U == FMACx->YUnread) ? 1U : 0U);
+}
+
+/* Value of a circular buffer, bAge values before the last one written */
+static inline int16_t SIL_FMAC_Past(const FMAC_TypeDef *FMACx, uint8_t bBase, uint8_t bSize, uint8_t bNext,
+                                    uint8_t bAge)
+{
+  uint8_t bIndex = (uint8_t)(((uint32_t)bNext + (2U * (uint32_t)bSize) - 1U - (uint32_t)bAge) % bSize);
+
+  return (FMACx->Mem[(uint8_t)(bBase + bIndex)]);
+}
+
+static inline void SIL_FMAC_Filter(FMAC_TypeDef *FMACx)
+{
+  const int16_t *pCoeff = &FMACx->Mem[FMACx->X2Base];
+  uint8_t bFeedback = (LL_FMAC_FUNC_IIR_DIRECT_FORM_1 == FMACx->Function) ? FMACx->Q : 0U;
+  int64_t lAcc = 0;
+  int32_t wOutput;
+  uint8_t k;
+
+  for (k = 0U; k < FMACx->P; k++)
+  {
+    lAcc += (int64_t)pCoeff[k] * SIL_FMAC_Past(FMACx, FMACx->X1Base, FMACx->X1Size, FMACx->X1Next, k);
+  }
+  for (k = 0U; (k < bFeedback) && (k < FMACx->YCount); k++)
+  {
+    lAcc += (int64_t)pCoeff[FMACx->P + k] * SIL_FMAC_Past(FMACx, FMACx->YBase, FMACx->YSize, FMACx->YNext, k);
+  }
+  lAcc = lAcc / ((int64_t)1 << (15U - FMACx->R)) - (((lAcc % ((int64_t)1 << (15U - FMACx->R))) < 0) ? 1 : 0);
+  if (1U == FMACx->Clip)
+  {
+    wOutput = (lAcc > INT16_MAX) ? INT16_MAX : ((lAcc < INT16_MIN) ? INT16_MIN : (int32_t)lAcc);
+  }
+  else
+  {
+    wOutput = (int32_t)(int16_t)(uint16_t)(uint64_t)lAcc;
+  }
+  FMACx->Mem[(uint8_t)(FMACx->YBase + FMACx->YNext)] = (int16_t)wOutput;
+  FMACx->YNext = (uint8_t)((FMACx->YNext + 1U) % FMACx->YSize);
+  FMACx->YCount = (FMACx->YCount < FMACx->YSize) ? (uint8_t)(FMACx->YCount + 1U) : FMACx->YCount;
+  FMACx->YUnread++;
+}
+
+static inline void LL_FMAC_WriteData(FMAC_TypeDef *FMACx, uint16_t InData)
+{
+  if (0U == FMACx->Start)
+  {
+    /* Ignored, as on the target */
+  }
+  else if (LL_FMAC_FUNC_LOAD_X2 == FMACx->Function)
+  {
+    FMACx->Mem[(uint8_t)(FMACx->X2Base + FMACx->Loaded)] = (int16_t)InData;
+    FMACx->Loaded++;
+    FMACx->Start = (FMACx->Loaded < ((uint16_t)FMACx->P + FMACx->Q)) ? 1U : 0U;
+  }
+  else if ((LL_FMAC_FUNC_LOAD_Y == FMACx->Function) || (LL_FMAC_FUNC_LOAD_X1 == FMACx->Function))
+  {
+    uint8_t bY = (LL_FMAC_FUNC_LOAD_Y == FMACx->Function) ? 1U : 0U;
+
+    FMACx->Mem[(uint8_t)(((1U == bY) ? FMACx->YBase : FMACx->X1Base) + FMACx->Loaded)] = (int16_t)InData;
+    FMACx->Loaded++;
+    if (1U == bY)
+    {
+      FMACx->YCount = (uint8_t)FMACx->Loaded;
+      FMACx->YNext = (uint8_t)(FMACx->Loaded % FMACx->YSize);
+    }
+    else
+    {
+      FMACx->X1Count = (uint8_t)FMACx->Loaded;
+      FMACx->X1Next = (uint8_t)(FMACx->Loaded % FMACx->X1Size);
+    }
+    FMACx->Start = (FMACx->Loaded < FMACx->P) ? 1U : 0U;
+  }
+  else
+  {
+    FMACx->Mem[(uint8_t)(FMACx->X1Base + FMACx->X1Next)] = (int16_t)InData;
+    FMACx->X1Next = (uint8_t)((FMACx->X1Next + 1U) % FMACx->X1Size);
+    FMACx->X1Count = (FMACx->X1Count < FMACx->X1Size) ? (uint8_t)(FMACx->X1Count + 1U) : FMACx->X1Count;
+    if (FMACx->X1Count >= FMACx->P)
+    {
+      SIL_FMAC_Filter(FMACx);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+}
+
+static inline uint16_t LL_FMAC_ReadData(FMAC_TypeDef *FMACx)
+{
+  uint16_t hData = 0U;
+
+  if (FMACx->YUnread > 0U)
+  {
+    hData = (uint16_t)SIL_FMAC_Past(FMACx, FMACx->YBase, FMACx->YSize, FMACx->YNext, (uint8_t)(FMACx->YUnread - 1U));
+    FMACx->YUnread--;
+  }
+  return (hData);
+}
+
+#endif /* SIL_FMAC_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
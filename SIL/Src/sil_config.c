@@ -0,0 +1,247 @@
+/**
+  ******************************************************************************
+  * @file    sil_config.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Handles of the controllers run by the software in the loop build
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "parameters_conversion.h"
+#include "sil_config.h"
+
+/* Same initialisation as in the mc_config.c of the port, from the same parameters, without
+   the placement of the handles in CCM SRAM */
+
+/* Cycle counter of the host, see sil_cmsis.h */
+SIL_DWT_t SilDWT;
+SIL_CoreDebug_t SilCoreDebug;
+
+/* FMAC of the host, see sil_fmac.h */
+SIL_FMAC_t SilFMAC;
+
+/* The ports that decimate the observer give it its own rate */
+#ifdef OBS_REGULATION_RATE_SCALED
+#define SIL_OBS_RATE_SCALED  OBS_REGULATION_RATE_SCALED
+#else
+#define SIL_OBS_RATE_SCALED  TF_REGULATION_RATE_SCALED
+#endif
+
+/**
+  * @brief  PI / PID Iq loop parameters Motor 1
+  */
+PID_Handle_t PIDIqHandle_M1 =
+{
+#ifdef PID_FMAC
+  .FMACEnable          = true,
+#endif
+  .hDefKpGain          = (int16_t)PID_TORQUE_KP_DEFAULT,
+  .hDefKiGain          = (int16_t)PID_TORQUE_KI_DEFAULT,
+  .wUpperIntegralLimit = (int32_t)INT16_MAX * TF_KIDIV,
+  .wLowerIntegralLimit = (int32_t)-INT16_MAX * TF_KIDIV,
+  .hUpperOutputLimit       = INT16_MAX,
+  .hLowerOutputLimit       = -INT16_MAX,
+  .hKpDivisor          = (uint16_t)TF_KPDIV,
+  .hKiDivisor          = (uint16_t)TF_KIDIV,
+  .hKpDivisorPOW2      = (uint16_t)TF_KPDIV_LOG,
+  .hKiDivisorPOW2      = (uint16_t)TF_KIDIV_LOG,
+  .hDefKdGain           = 0x0000U,
+  .hKdDivisor           = 0x0000U,
+  .hKdDivisorPOW2       = 0x0000U,
+};
+
+/**
+  * @brief  PI / PID Id loop parameters Motor 1
+  */
+PID_Handle_t PIDIdHandle_M1 =
+{
+#ifdef PID_FMAC
+  .FMACEnable          = true,
+#endif
+  .hDefKpGain          = (int16_t)PID_FLUX_KP_DEFAULT,
+  .hDefKiGain          = (int16_t)PID_FLUX_KI_DEFAULT,
+  .wUpperIntegralLimit = (int32_t)INT16_MAX * TF_KIDIV,
+  .wLowerIntegralLimit = (int32_t)-INT16_MAX * TF_KIDIV,
+  .hUpperOutputLimit       = INT16_MAX,
+  .hLowerOutputLimit       = -INT16_MAX,
+  .hKpDivisor          = (uint16_t)TF_KPDIV,
+  .hKiDivisor          = (uint16_t)TF_KIDIV,
+  .hKpDivisorPOW2      = (uint16_t)TF_KPDIV_LOG,
+  .hKiDivisorPOW2      = (uint16_t)TF_KIDIV_LOG,
+  .hDefKdGain           = 0x0000U,
+  .hKdDivisor           = 0x0000U,
+  .hKdDivisorPOW2       = 0x0000U,
+};
+
+/**
+  * @brief  SpeedNPosition sensor parameters Motor 1 - State Observer + PLL
+  */
+STO_PLL_Handle_t STO_PLL_M1 =
+{
+  ._Super = {
+	.bElToMecRatio                     =	POLE_PAIR_NUM,
+    .SpeedUnit                         = SPEED_UNIT,
+    .hMaxReliableMecSpeedUnit          =	(uint16_t)(1.15*MAX_APPLICATION_SPEED_UNIT),
+    .hMinReliableMecSpeedUnit          =	(uint16_t)(MIN_APPLICATION_SPEED_UNIT),
+    .bMaximumSpeedErrorsNumber         =	MEAS_ERRORS_BEFORE_FAULTS,
+    .hMaxReliableMecAccelUnitP         =	65535,
+    .hMeasurementFrequency             =	SIL_OBS_RATE_SCALED,
+    .DPPConvFactor                     =  DPP_CONV_FACTOR,
+  },
+ .hC1                         =	C1,
+ .hC2                         =	C2,
+ .hC3                         =	C3,
+ .hC4                         =	C4,
+ .hC5                         =	C5,
+ .hF1                         =	F1,
+ .hF2                         =	F2,
+ .PIRegulator = {
+     .hDefKpGain = PLL_KP_GAIN,
+     .hDefKiGain = PLL_KI_GAIN,
+	 .hDefKdGain = 0x0000U,
+     .hKpDivisor = PLL_KPDIV,
+     .hKiDivisor = PLL_KIDIV,
+	 .hKdDivisor = 0x0000U,
+     .wUpperIntegralLimit = INT32_MAX,
+     .wLowerIntegralLimit = -INT32_MAX,
+     .hUpperOutputLimit = INT16_MAX,
+     .hLowerOutputLimit = -INT16_MAX,
+     .hKpDivisorPOW2 = PLL_KPDIV_LOG,
+     .hKiDivisorPOW2 = PLL_KIDIV_LOG,
+     .hKdDivisorPOW2       = 0x0000U,
+   },
+ .SpeedBufferSizeUnit                =	STO_FIFO_DEPTH_UNIT,
+ .SpeedBufferSizeDpp                 =	STO_FIFO_DEPTH_DPP,
+ .VariancePercentage                 =	PERCENTAGE_FACTOR,
+ .SpeedValidationBand_H              =	SPEED_BAND_UPPER_LIMIT,
+ .SpeedValidationBand_L              =	SPEED_BAND_LOWER_LIMIT,
+ .MinStartUpValidSpeed               =	OBS_MINIMUM_SPEED_UNIT,
+ .StartUpConsistThreshold            =	NB_CONSECUTIVE_TESTS,
+ .Reliability_hysteresys             =	OBS_MEAS_ERRORS_BEFORE_FAULTS,
+ .BemfConsistencyCheck               =	BEMF_CONSISTENCY_TOL,
+ .BemfConsistencyGain                =	BEMF_CONSISTENCY_GAIN,
+ .MaxAppPositiveMecSpeedUnit         =	(uint16_t)(MAX_APPLICATION_SPEED_UNIT*1.15),
+ .F1LOG                              =	F1_LOG,
+ .F2LOG                              =	F2_LOG,
+ .SpeedBufferSizeDppLOG              =	STO_FIFO_DEPTH_DPP_LOG,
+ .GainScheduleSpeedUnit              =	PLL_GAIN_SCHEDULE_SPEED_UNIT,
+ .GainScheduleMax                    =	PLL_GAIN_SCHEDULE_MAX,
+ .FastConvergence                    =	(OBS_FAST_CONVERGENCE_ENABLING == ENABLE),
+ .hForcedDirection                   =  0x0000U
+};
+
+/**
+  * @brief  FeedForwardCtrl parameters Motor 1
+  */
+FF_Handle_t FF_M1 =
+{
+  .hVqdLowPassFilterBW    = M1_VQD_SW_FILTER_BW_FACTOR,
+  .wDefConstant_1D        = (int32_t)CONSTANT1_D,
+  .wDefConstant_1Q        = (int32_t)CONSTANT1_Q,
+  .wDefConstant_2         = (int32_t)CONSTANT2_QD,
+  .hVqdLowPassFilterBWLOG = M1_VQD_SW_FILTER_BW_FACTOR_LOG
+};
+
+/* Bus voltage read by the feed forward: only its average is used, written by each period
+   of sil_main.c with the bus voltage of the plant */
+RDivider_Handle_t BusVoltageSensor_M1;
+
+/**
+  * @brief  CircleLimitation Component parameters Motor 1 - Base Component
+  */
+CircleLimitation_Handle_t CircleLimitationM1 =
+{
+  .MaxModule          = MAX_MODULE,
+  .MaxVd          	  = (uint16_t)(MAX_MODULE * 950 / 1000),
+};
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+/**
+  * @brief  Predictive Current Control cost weights Motor 1
+  */
+static const PCC_Weights_t PCC_WeightTableM1[PCC_NB_WEIGHTS] = PCC_WEIGHT_TABLE;
+#ifdef PCC_ADAPTIVE_PERIOD
+/**
+  * @brief  Predictive Current Control models of the decision periods Motor 1
+  */
+static const PCC_PeriodModel_t PCC_PeriodTableM1[PCC_PERIOD_STEPS] = PCC_PERIOD_TABLE;
+#endif
+#endif
+
+/**
+  * @brief  Predictive Current Control parameters Motor 1
+  */
+PCC_Handle_t PCC_M1 =
+{
+  .wKDecay      = PCC_KDECAY,
+  .wKVolt       = PCC_KVOLT,
+  .wKBemf       = PCC_KBEMF,
+  .hCoefDivisorPOW2 = (uint16_t)PCC_COEF_DIV_LOG,
+  .hBemfDivisorPOW2 = (uint16_t)PCC_BEMF_DIV_LOG,
+  .hSwitchingWeight = (uint16_t)PCC_SWITCHING_WEIGHT,
+  .hNodeBudget  = (uint16_t)PCC_NODE_BUDGET,
+  .hFallbackOverruns = (uint16_t)PCC_FALLBACK_OVERRUNS,
+  .hFallbackPeriods = PCC_FALLBACK_PERIODS,
+  .hResidualLimit = PCC_RESIDUAL_LIMIT,
+  .bResidualShift = (uint8_t)PCC_RESIDUAL_SHIFT,
+  .hDistGain    = PCC_DIST_GAIN,
+#ifdef PCC_STATE_FILTER
+  .hStateGain   = PCC_STATE_GAIN,
+#endif
+  .hEngageSpeed = (int16_t)PCC_ENGAGE_SPEED_UNIT,
+  .hDisengageSpeed = (int16_t)PCC_DISENGAGE_SPEED_UNIT,
+  .hNominalBusVoltage = PCC_NOMINAL_BUS_D,
+  .hStatsPeriod = PCC_STATS_PERIOD,
+#if (PCC_OUTPUT_MODE != PCC_FINITE_SET) && !defined (PCC_FULL_HEXAGON)
+  .hMaxModule   = MAX_MODULE,
+#endif
+#ifdef PCC_VBUS_LIMIT
+  .hVbusStart_d = PCC_VBUS_START_D,
+  .hVbusLimit_d = OVERVOLTAGE_THRESHOLD_d,
+  .hRegenWeight = (uint16_t)PCC_REGEN_WEIGHT,
+  .hBrakeIdMax  = PCC_BRAKE_ID,
+#endif
+#ifdef PCC_INDUCTANCE_TABLE
+  .hLSatKnee    = PCC_LSAT_KNEE,
+  .hLSatDrop    = PCC_LSAT_DROP,
+  .hLSatStep    = PCC_LSAT_STEP,
+#endif
+#if (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  .hSwitchDrop  = PCC_SWITCH_DROP,
+  .hDiodeDrop   = PCC_DIODE_DROP,
+  .hDeadTimeDrop = PCC_DEADTIME_DROP,
+  .pWeightTable = PCC_WeightTableM1,
+  .hWeightSpeedBand = {(int16_t)PCC_WEIGHT_SPEED_BAND1_UNIT, (int16_t)PCC_WEIGHT_SPEED_BAND2_UNIT},
+  .hWeightIqBand = {PCC_WEIGHT_IQ_BAND1, PCC_WEIGHT_IQ_BAND2},
+  .hLimitCurr = (int16_t)PCC_BARRIER_CURRENT,
+  .hMaxCurr = (int16_t)PCC_MAX_CURR,
+  .hTripCurr = (int16_t)PCC_TRIP_CURR,
+#if (PCC_COST_NORM == PCC_COST_L2_SAT) || (PCC_COST_NORM == PCC_COST_L2_PACKED)
+  .hCostSatError = (int16_t)PCC_COST_SAT_ERROR,
+#endif
+  .hTieBand = (uint16_t)PCC_TIE_BAND,
+#if (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+  .wFluxCurr = PCC_FLUX_CURR,
+  .hInductanceRatio = PCC_INDUCTANCE_RATIO,
+#endif
+#ifdef PCC_ADAPTIVE_PERIOD
+  .pPeriodTable = PCC_PeriodTableM1,
+  .hPeriodSpeedBand = {(int16_t)PCC_PERIOD_SPEED_BAND1_UNIT, (int16_t)PCC_PERIOD_SPEED_BAND2_UNIT},
+  .hPeriodHyst = (int16_t)PCC_PERIOD_HYST_UNIT,
+#endif
+#endif
+};
+#endif
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,868 @@
+/**
+  ******************************************************************************
+  * @file    sil_main.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Software in the loop benchmark of the current controllers on the host
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mc_math.h"
+#include "parameters_conversion.h"
+#include "sil_config.h"
+#include "mc_plant.h"
+#include "mc_record.h"
+#include "mc_pil.h"
+#ifdef PID_FMAC
+#include "pid_fmac_g4xx.h"
+#endif
+
+/* Each FOC period runs the chain of FOC_CurrControllerM1 on the phase currents of the plant
+   model: Clarke and Park transformations, CRG_Regulate() and CRG_RegulationDone() of the
+   mc_curr_regulation.h of the port, circle limitation, reverse Park transformation, then the
+   STO_PLL observer on the voltage and currents of the period. The feed forward of the PI
+   controllers is computed at the rate of the medium frequency task and, with
+   PCC_SPLIT_PHASE, PCC_PrepareVoltage() runs before each period as the update interrupt
+   runs it. The Park angle is the one of the plant, the observer runs alongside and its
+   angle error is reported. The plant applies the voltage during the next period, as on the
+   drive. The predictive controller hands the regulation over to the PI controllers for the
+   periods of a fallback, and the number of fallbacks is reported.
+
+   mc_sil [periods] runs the scenarios of the benchmark, then the given number of periods,
+   1000000 by default, for the throughput. It exits with 1 if a controller does not settle
+   after the step of a scenario, or if its mean error, ripple or observer error exceeds the
+   SIL_Limits_t of the scenario. The regenerative scenario also fails unless the mean power
+   drawn from the bus is negative, the braking energy that rises the bus.
+
+   mc_sil --replay <file> feeds the controllers with the frames of a record downloaded
+   from MC_REG_RECORD_DATA, a raw little endian array of MC_Record_Frame_t, from the
+   cleared state of the controllers as on the target, and compares the voltage and the
+   controller of each period with the recorded ones. The build must use the port and
+   the options of the target, and runs the table based math: a target built with the
+   CORDIC rounds the angles differently. mc_sil --record <file> writes the frames of the
+   load step scenario in the same format, so that the replay is checked on the host.
+   Both exit with 1 on an error or on the first frame that differs.
+
+   mc_sil --pil [steps] runs the host side of the processor in the loop mode on the same
+   plant: each step builds the MC_Pil_Input_t of the plant, pushes it to the mc_pil.c of
+   the port, runs the period from the inputs of the step as the high frequency task does,
+   and reads the MC_Pil_Output_t back to step the plant. The voltages must be the ones of
+   the same load step run without the frames, bit for bit. The cycles of the outputs are
+   host nanoseconds here.
+
+   mc_sil --observer <file> runs the scenarios of the benchmark, without the throughput, and
+   writes the state of the observer after each period, a raw array of SIL_Observer_Frame_t.
+   The test compares the file of the build with the dual MACs of STO_PLL_CalcElAngle() with
+   the one of the build with the separate products, bit for bit. */
+
+#define SIL_WARMUP            256U
+#define SIL_SETTLE            256U
+#define SIL_STEADY            4096U
+#define SIL_DEFAULT_PERIODS   1000000UL
+#define SIL_MAX_FRAMES        65535U
+/* FOC periods of the medium frequency task, that computes the feed forward */
+#define SIL_MEDIUM_PERIODS    (TF_REGULATION_RATE / MEDIUM_FREQUENCY_TASK_RATE)
+
+/* The q current is settled within 1/16 of its reference, and at least this band. A finite
+   set vector moves the current by up to SIL_FCS_STEP digits in one period, and its ripple
+   exceeds the band: the current of the finite set controller is averaged over about
+   2^SIL_SETTLE_AVERAGE_POW2 periods first. */
+#define SIL_SETTLE_BAND_POW2  4U
+#define SIL_SETTLE_BAND_MIN   256
+#define SIL_SETTLE_AVERAGE_POW2  4U
+#define SIL_FCS_STEP          ((int32_t)(PCC_KVOLT_UNIT * PCC_STATE_VOLT_GAIN * 32767.0))
+/* Power of the product of a q/d voltage digit and a q/d current digit, at the nominal bus */
+#define SIL_WATT_PER_DIGIT2   ((1.5 * PCC_VECTOR_VOLTAGE_V) / (32768.0 * CURRENT_CONV_FACTOR))
+
+typedef enum
+{
+  SIL_CTRL_PI,
+  SIL_CTRL_PCC
+} SIL_Controller_t;
+
+/* Limits of the results of a scenario, beyond which the test fails */
+typedef struct
+{
+  float_t fMeanError;               /* Absolute mean q current error, percent of the reference */
+  float_t fRipple;                  /* Ripple rms, per mille of the mean current, or of
+                                       SIL_FCS_STEP at the bus after the step for the finite set */
+  float_t fAngleError;              /* Mean absolute angle error of the observer, degrees */
+} SIL_Limits_t;
+
+typedef struct
+{
+  const char *pName;
+  int16_t hIqrefBefore;             /* Percent of NOMINAL_CURRENT, the d reference is zero */
+  int16_t hIqrefAfter;
+  int16_t hSpeedBefore;             /* dpp */
+  int16_t hSpeedAfter;
+  float_t fBusAfter;                /* Bus voltage after the step, per unit of the nominal one */
+  float_t fRsScale;                 /* Plant parameters, per unit of the ones of the drive */
+  float_t fLsScale;
+  bool bRegenerative;               /* The braking returns energy to the bus: the mean power
+                                       drawn from the bus must be negative */
+  SIL_Limits_t Modulated;           /* PI, and the modulated and deadbeat predictive controllers */
+  SIL_Limits_t FiniteSet;
+} SIL_Scenario_t;
+
+/* State of the observer after a period, for the --observer mode */
+typedef struct
+{
+  int16_t hElAngle;
+  int16_t hElSpeedDpp;
+  int32_t wIalfa_est;
+  int32_t wIbeta_est;
+  int32_t wBemf_alfa_est;
+  int32_t wBemf_beta_est;
+} SIL_Observer_Frame_t;
+
+typedef struct
+{
+  double dMeanError;                /* Mean q current error, percent of the reference */
+  double dRippleRms;                /* s16A digits */
+  double dThd;                      /* Per mille of the mean current */
+  double dSwitchingFreq;            /* Mean switching frequency of one leg, Hz */
+  double dSettlingTime;             /* us after the step, negative if not settled */
+  double dAngleError;               /* Mean absolute angle error of the observer, degrees */
+  double dBusPower;                 /* Mean power drawn from the bus, W, negative when it rises */
+  double dPeriodTime;               /* Host time of one period, ns */
+  uint16_t hFallbacks;              /* Fallbacks of the predictive controller to the PI */
+} SIL_Result_t;
+
+static const SIL_Scenario_t SilScenarios[] =
+{
+  {"speed step", 40, 40, 20, 80, 1.0f, 1.0f, 1.0f, false, {1.0f, 4.0f, 2.5f}, {4.0f, 450.0f, 12.0f}},
+  {"load step",  10, 60, 45, 45, 1.0f, 1.0f, 1.0f, false, {1.0f, 3.0f, 2.5f}, {4.0f, 450.0f, 12.0f}},
+  {"bus sag",    40, 40, 45, 45, 0.7f, 1.0f, 1.0f, false, {1.0f, 4.0f, 2.5f}, {3.0f, 450.0f, 5.0f}},
+  {"mismatch",   10, 60, 45, 45, 1.0f, 1.5f, 0.7f, false, {1.0f, 4.0f, 3.0f}, {4.0f, 700.0f, 16.0f}},
+  {"reverse",   -40, -40, -20, -80, 1.0f, 1.0f, 1.0f, false, {1.0f, 4.0f, 2.5f}, {4.0f, 450.0f, 12.0f}},
+  {"regen",      10, -60, 80, 80, 1.2f, 1.0f, 1.0f, true, {1.0f, 4.0f, 3.5f}, {4.0f, 450.0f, 12.0f}},
+};
+
+/* The references stay below the current barrier of the predictive controller, NOMINAL_CURRENT */
+#define SIL_IQREF(pc)  ((int16_t)(((int32_t)(pc) * (int32_t)NOMINAL_CURRENT) / 100))
+
+#define SIL_NB_SCENARIOS  (sizeof(SilScenarios) / sizeof(SilScenarios[0]))
+
+static PID_Handle_t SilPIDq;
+static PID_Handle_t SilPIDd;
+static STO_PLL_Handle_t SilSTO;
+static FF_Handle_t SilFF;
+static SpeednTorqCtrl_Handle_t SilSTC;
+static uint32_t wSilMediumCount;
+static FILE *pSilObserverFile;
+static bool bSilStateWritten;   /* The voltage written by the last period is a switching state */
+static bool bSilStateApplied;   /* The one the plant applies during the current period is */
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+static PCC_Handle_t SilPCC;
+#endif
+
+/* Current regulation of FOC_CurrControllerM1, on the copies of the handles of the port */
+static CRG_Handle_t SilCRG =
+{
+  .pPIDIq = &SilPIDq,
+  .pPIDId = &SilPIDd,
+  .pFF    = &SilFF,
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  .pPCC   = &SilPCC,
+#ifdef PCC_BLENDED_HANDOVER
+  .wBlendPeriods = PCC_BLEND_PERIODS,
+#endif
+#endif
+};
+
+/* Controller run by the last period */
+static inline bool SIL_IsPCCEngaged(void)
+{
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  return (SilCRG.PCCEngaged);
+#else
+  return (false);
+#endif
+}
+
+static double SIL_Now(void)
+{
+  struct timespec Now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &Now);
+  return (((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec);
+}
+
+/* Clears the controllers and the observer, as FOC_Clear() does at the start of the drive */
+static void SIL_Clear(void)
+{
+#ifdef PID_FMAC
+  PID_FMAC_Init();
+#endif
+  SilPIDq = PIDIqHandle_M1;
+  SilPIDd = PIDIdHandle_M1;
+  PID_HandleInit(&SilPIDq);
+  PID_HandleInit(&SilPIDd);
+  SilSTO = STO_PLL_M1;
+  STO_PLL_Init(&SilSTO);
+  SilSTC.SPD = &SilSTO._Super;
+  BusVoltageSensor_M1._Super.AvBusVoltage_d = PCC_NOMINAL_BUS_D;
+  SilFF = FF_M1;
+  FF_Init(&SilFF, &BusVoltageSensor_M1._Super, &SilPIDd, &SilPIDq);
+  FF_Clear(&SilFF);
+  FF_InitFOCAdditionalMethods(&SilFF);
+  wSilMediumCount = 0U;
+  bSilStateWritten = false;
+  bSilStateApplied = false;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  SilPCC = PCC_M1;
+  PCC_Init(&SilPCC);
+  PCC_SetBusVoltage(&SilPCC, PCC_NOMINAL_BUS_D);
+#endif
+  CRG_Clear(&SilCRG);
+}
+
+/* One period of FOC_CurrControllerM1 on the phase currents of the period. Returns the
+   voltage written, that the plant applies during the next period, and the angle of the
+   observer. The predictive controller regulates when it is requested and not in a
+   fallback, the PI controllers otherwise, as in CRG_Regulate(). */
+static qd_t SIL_Period(bool PCCRequested, ab_t Iab, int16_t hElAngle, int16_t hElSpeedDpp, qd_t Iqdref,
+                       qd_t Vqd, uint16_t hBusVoltage_d, qd_t *pIqd, int16_t *pObsAngle)
+{
+  Observer_Inputs_t ObsInputs;
+  Trig_Components Trig = MCM_Trig_Functions(hElAngle);
+  alphabeta_t Ialphabeta = MCM_Clarke(Iab);
+  qd_t Iqd = MCM_Park(Ialphabeta, hElAngle);
+  qd_t VqdNext;
+
+  /* Medium frequency task: feed forward of the PI controllers, from the speed of the
+     observer and the bus voltage of the period */
+  BusVoltageSensor_M1._Super.AvBusVoltage_d = hBusVoltage_d;
+  if (0U == wSilMediumCount)
+  {
+    FF_VqdffComputation(&SilFF, Iqdref, &SilSTC);
+    wSilMediumCount = SIL_MEDIUM_PERIODS;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  wSilMediumCount--;
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+  SilCRG.PCCSelected = PCCRequested;
+#ifdef PCC_SPLIT_PHASE
+  /* FOC_CurrPrepareM1() of the update interrupt, before the currents are read */
+  if (true == SilCRG.PCCEngaged)
+  {
+    PCC_PrepareVoltage(&SilPCC, Vqd, Trig, hElSpeedDpp);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+#endif
+#else
+  /* Only the PI controllers are built */
+  (void)PCCRequested;
+#endif
+  VqdNext = CRG_Regulate(&SilCRG, Iqd, Iqdref, Vqd, Trig, hElSpeedDpp);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && ((PCC_OUTPUT_MODE == PCC_FINITE_SET) || defined (PCC_FULL_HEXAGON))
+  /* The vector or the dwell times of the predictive controller are written as they are */
+  if (false == SilCRG.PCCEngaged)
+#endif
+  {
+    VqdNext = Circle_Limitation(&CircleLimitationM1, VqdNext);
+  }
+  (void)CRG_RegulationDone(&SilCRG, Iqd, VqdNext);
+  bSilStateApplied = bSilStateWritten;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  bSilStateWritten = SilCRG.PCCEngaged;
+#endif
+
+  ObsInputs.Ialfa_beta = Ialphabeta;
+  ObsInputs.Valfa_beta = MCM_Rev_Park(VqdNext, hElAngle);
+  ObsInputs.Vbus = hBusVoltage_d;
+  *pObsAngle = STO_PLL_CalcElAngle(&SilSTO, &ObsInputs);
+  if (NULL != pSilObserverFile)
+  {
+    SIL_Observer_Frame_t Frame;
+
+    Frame.hElAngle = SilSTO._Super.hElAngle;
+    Frame.hElSpeedDpp = SilSTO._Super.hElSpeedDpp;
+    Frame.wIalfa_est = SilSTO.Ialfa_est;
+    Frame.wIbeta_est = SilSTO.Ibeta_est;
+    Frame.wBemf_alfa_est = SilSTO.wBemf_alfa_est;
+    Frame.wBemf_beta_est = SilSTO.wBemf_beta_est;
+    (void)fwrite(&Frame, sizeof(Frame), 1U, pSilObserverFile);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  *pIqd = Iqd;
+  return (VqdNext);
+}
+
+/* One period of the controller on the plant */
+static qd_t SIL_PlantPeriod(SIL_Controller_t Controller, const MC_Plant_t *pPlant, qd_t Iqdref, qd_t Vqd,
+                            uint16_t hBusVoltage_d, qd_t *pIqd, int16_t *pObsAngle)
+{
+  return (SIL_Period(SIL_CTRL_PCC == Controller, MC_Plant_GetIab(pPlant), pPlant->hElAngle, pPlant->hElSpeedDpp,
+                     Iqdref, Vqd, hBusVoltage_d, pIqd, pObsAngle));
+}
+
+/* Applies the voltage written by the previous period to the plant, and returns it. The
+   inverter applies the active switching states for StateHighCnt, PCC_STATE_VOLT_GAIN of their
+   vector. */
+static qd_t SIL_PlantStep(MC_Plant_t *pPlant, qd_t Vqd)
+{
+  qd_t VqdApplied = Vqd;
+
+  if (true == bSilStateApplied)
+  {
+    VqdApplied.q = (int16_t)((double)Vqd.q * PCC_STATE_VOLT_GAIN);
+    VqdApplied.d = (int16_t)((double)Vqd.d * PCC_STATE_VOLT_GAIN);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  MC_Plant_Step(pPlant, VqdApplied);
+  return (VqdApplied);
+}
+
+/* Runs a scenario, true if the controller settles within the limits of the scenario */
+static bool SIL_Scenario(SIL_Controller_t Controller, const SIL_Scenario_t *pScenario, SIL_Result_t *pResult)
+{
+  MC_Plant_t Plant;
+  qd_t Iqdref = {SIL_IQREF(pScenario->hIqrefBefore), 0};
+  qd_t Vqd = {0, 0};
+  float_t fBusScale = 1.0f;
+  int32_t wBand = 0;
+  uint32_t wLastOut = 0U;
+  uint32_t wPeriod;
+  int32_t wSettleQ;
+  double dSumQ = 0.0;
+  double dSumD = 0.0;
+  double dSumSq = 0.0;
+  double dAngleSum = 0.0;
+  double dPowerSum = 0.0;
+  double dPower;
+  double dStart = 0.0;
+  double dRipple;
+  const SIL_Limits_t *pLimits = &pScenario->Modulated;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  int32_t wAverageQ = 0;
+  uint32_t wTransitions = 0U;
+  uint8_t bState;
+#endif
+
+  SIL_Clear();
+  /* As at the start of the drive, the observer takes the direction of the rotation */
+  STO_SetDirection(&SilSTO, (pScenario->hSpeedBefore < 0) ? -1 : 1);
+  MC_Plant_Init(&Plant, pScenario->fRsScale, pScenario->fLsScale);
+  MC_Plant_SetSpeed(&Plant, pScenario->hSpeedBefore);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+  bState = PCC_GetSwitchingState(&SilPCC);
+#endif
+
+  for (wPeriod = 0U; wPeriod < (SIL_WARMUP + SIL_SETTLE + SIL_STEADY); wPeriod++)
+  {
+    qd_t Iqd;
+    qd_t VqdNext;
+    qd_t VqdApplied;
+    int16_t hObsAngle;
+    uint16_t hBusVoltage_d;
+
+    if (SIL_WARMUP == wPeriod)
+    {
+      Iqdref.q = SIL_IQREF(pScenario->hIqrefAfter);
+      fBusScale = pScenario->fBusAfter;
+      MC_Plant_SetSpeed(&Plant, pScenario->hSpeedAfter);
+      MC_Plant_SetBusScale(&Plant, fBusScale);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+      PCC_SetBusVoltage(&SilPCC, (uint16_t)((float_t)PCC_NOMINAL_BUS_D * fBusScale));
+#endif
+      wBand = ((Iqdref.q < 0) ? -(int32_t)Iqdref.q : (int32_t)Iqdref.q) >> SIL_SETTLE_BAND_POW2;
+      wBand = (wBand < SIL_SETTLE_BAND_MIN) ? SIL_SETTLE_BAND_MIN : wBand;
+    }
+    else if ((SIL_WARMUP + SIL_SETTLE) == wPeriod)
+    {
+      dStart = SIL_Now();
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    hBusVoltage_d = (uint16_t)((float_t)PCC_NOMINAL_BUS_D * fBusScale);
+    VqdNext = SIL_PlantPeriod(Controller, &Plant, Iqdref, Vqd, hBusVoltage_d, &Iqd, &hObsAngle);
+    VqdApplied = SIL_PlantStep(&Plant, Vqd);
+    /* Power of the period, on the mean of the currents at its start and at its end */
+    dPower = (((double)VqdApplied.q * ((double)Iqd.q + (double)Plant.fIq))
+              + ((double)VqdApplied.d * ((double)Iqd.d + (double)Plant.fId))) * (0.5 * (double)fBusScale);
+    Vqd = VqdNext;
+    wSettleQ = Iqd.q;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    if (SIL_CTRL_PCC == Controller)
+    {
+      wAverageQ += (int32_t)Iqd.q - (wAverageQ >> SIL_SETTLE_AVERAGE_POW2);
+      wSettleQ = wAverageQ >> SIL_SETTLE_AVERAGE_POW2;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif
+
+    if (wPeriod < SIL_WARMUP)
+    {
+      /* Nothing to do */
+    }
+    else if (wPeriod < (SIL_WARMUP + SIL_SETTLE))
+    {
+      int32_t wErrQ = (int32_t)Iqdref.q - wSettleQ;
+
+      if ((wErrQ > wBand) || (wErrQ < -wBand))
+      {
+        wLastOut = (wPeriod - SIL_WARMUP) + 1U;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      int16_t hAngleError = (int16_t)(hObsAngle - (int16_t)(Plant.hElAngle - Plant.hElSpeedDpp));
+
+      dSumQ += (double)Iqd.q;
+      dSumD += (double)Iqd.d;
+      dSumSq += ((double)Iqd.q * (double)Iqd.q) + ((double)Iqd.d * (double)Iqd.d);
+      dAngleSum += (hAngleError < 0) ? -(double)hAngleError : (double)hAngleError;
+      dPowerSum += dPower;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+      if (SIL_CTRL_PCC == Controller)
+      {
+        uint8_t bChanged = bState ^ PCC_GetSwitchingState(&SilPCC);
+
+        wTransitions += (uint32_t)(bChanged & 1U) + ((bChanged >> 1) & 1U) + ((bChanged >> 2) & 1U);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+#endif
+    }
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    bState = PCC_GetSwitchingState(&SilPCC);
+#endif
+  }
+
+  {
+    double dPeriodTime = (SIL_Now() - dStart) / (double)SIL_STEADY;
+    double dMeanQ = dSumQ / (double)SIL_STEADY;
+    double dMeanD = dSumD / (double)SIL_STEADY;
+    double dMean2 = (dMeanQ * dMeanQ) + (dMeanD * dMeanD);
+    double dVar = (dSumSq / (double)SIL_STEADY) - dMean2;
+    double dRms = (dVar > 0.0) ? sqrt(dVar) : 0.0;
+    double dMean = sqrt(dMean2);
+
+    pResult->dMeanError = ((dMeanQ - (double)Iqdref.q) * 100.0) / (double)Iqdref.q;
+    pResult->dRippleRms = dRms;
+    pResult->dThd = (dMean > 0.0) ? ((dRms * 1000.0) / dMean) : 0.0;
+    dRipple = pResult->dThd;
+    /* A modulated voltage switches every leg once per PWM period, a finite set vector is
+       held for the whole period */
+    pResult->dSwitchingFreq = (double)PWM_FREQUENCY;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+    if (SIL_CTRL_PCC == Controller)
+    {
+      pResult->dSwitchingFreq = ((double)wTransitions * (double)TF_REGULATION_RATE) / (2.0 * 3.0 * (double)SIL_STEADY);
+      dRipple = (dRms * 1000.0) / ((double)SIL_FCS_STEP * (double)fBusScale);
+      pLimits = &pScenario->FiniteSet;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif
+    pResult->dSettlingTime = (wLastOut >= SIL_SETTLE) ? -1.0
+                           : (((double)wLastOut * 1e6) / (double)TF_REGULATION_RATE);
+    pResult->dAngleError = ((dAngleSum / (double)SIL_STEADY) * 180.0) / 32768.0;
+    pResult->dBusPower = (dPowerSum * SIL_WATT_PER_DIGIT2) / (double)SIL_STEADY;
+    pResult->dPeriodTime = dPeriodTime;
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+    pResult->hFallbacks = (SIL_CTRL_PCC == Controller) ? PCC_GetFallbackEvents(&SilPCC) : 0U;
+#else
+    pResult->hFallbacks = 0U;
+#endif
+  }
+  return ((pResult->dSettlingTime >= 0.0)
+          && (fabs(pResult->dMeanError) <= (double)pLimits->fMeanError)
+          && (dRipple <= (double)pLimits->fRipple)
+          && (pResult->dAngleError <= (double)pLimits->fAngleError)
+          && ((false == pScenario->bRegenerative) || (pResult->dBusPower < 0.0)));
+}
+
+/* Closed loop periods of the controller on the plant at the load step operating point */
+static double SIL_Throughput(SIL_Controller_t Controller, unsigned long lPeriods)
+{
+  MC_Plant_t Plant;
+  qd_t Iqdref = {SIL_IQREF(60), 0};
+  qd_t Vqd = {0, 0};
+  unsigned long lPeriod;
+  double dStart;
+
+  SIL_Clear();
+  MC_Plant_Init(&Plant, 1.0f, 1.0f);
+  MC_Plant_SetSpeed(&Plant, 45);
+  dStart = SIL_Now();
+  for (lPeriod = 0UL; lPeriod < lPeriods; lPeriod++)
+  {
+    qd_t Iqd;
+    qd_t VqdNext;
+    int16_t hObsAngle;
+
+    VqdNext = SIL_PlantPeriod(Controller, &Plant, Iqdref, Vqd, PCC_NOMINAL_BUS_D, &Iqd, &hObsAngle);
+    (void)SIL_PlantStep(&Plant, Vqd);
+    Vqd = VqdNext;
+  }
+  return (((double)lPeriods * 1e9) / (SIL_Now() - dStart));
+}
+
+/* Runs the load step scenario and writes the frame of each period as FOC_CurrControllerM1
+   writes it in the record, from the cleared state of the controllers */
+static bool SIL_Record(const char *pFileName)
+{
+  const SIL_Scenario_t *pScenario = &SilScenarios[1];
+  SIL_Controller_t Controller = (CURRENT_CONTROLLER == CURR_CTRL_PCC) ? SIL_CTRL_PCC : SIL_CTRL_PI;
+  MC_Plant_t Plant;
+  qd_t Iqdref = {SIL_IQREF(pScenario->hIqrefBefore), 0};
+  qd_t Vqd = {0, 0};
+  uint32_t wPeriod;
+  bool bDone;
+  FILE *pFile = fopen(pFileName, "wb");
+
+  bDone = (NULL != pFile);
+  SIL_Clear();
+  MC_Plant_Init(&Plant, pScenario->fRsScale, pScenario->fLsScale);
+  MC_Plant_SetSpeed(&Plant, pScenario->hSpeedBefore);
+  for (wPeriod = 0U; (true == bDone) && (wPeriod < (SIL_WARMUP + SIL_SETTLE)); wPeriod++)
+  {
+    MC_Record_Frame_t Frame;
+    ab_t Iab = MC_Plant_GetIab(&Plant);
+    qd_t Iqd;
+    qd_t VqdNext;
+    int16_t hObsAngle;
+
+    if (SIL_WARMUP == wPeriod)
+    {
+      Iqdref.q = SIL_IQREF(pScenario->hIqrefAfter);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    Frame.hIa = Iab.a;
+    Frame.hIb = Iab.b;
+    Frame.hElAngle = Plant.hElAngle;
+    Frame.hElSpeedDpp = Plant.hElSpeedDpp;
+    Frame.hIqref = Iqdref.q;
+    Frame.hIdref = Iqdref.d;
+    Frame.hBusVoltage_d = PCC_NOMINAL_BUS_D;
+    VqdNext = SIL_PlantPeriod(Controller, &Plant, Iqdref, Vqd, PCC_NOMINAL_BUS_D, &Iqd, &hObsAngle);
+    Frame.hFlags = (true == SIL_IsPCCEngaged()) ? MC_RECORD_FLAG_PCC : 0U;
+    Frame.hVq = VqdNext.q;
+    Frame.hVd = VqdNext.d;
+    bDone = (1U == fwrite(&Frame, sizeof(Frame), 1U, pFile));
+    (void)SIL_PlantStep(&Plant, Vqd);
+    Vqd = VqdNext;
+  }
+  if (NULL != pFile)
+  {
+    bDone = (0 == fclose(pFile)) && bDone;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  (void)printf("record: %s %u frames to %s\n", (true == bDone) ? "wrote" : "failed to write",
+               (unsigned)wPeriod, pFileName);
+  return (bDone);
+}
+
+/* Feeds the controllers with the frames of a record, from their cleared state. The voltage
+   written by the previous frame is the one applied during the period, FOCVars.Vqd on the
+   target. */
+static bool SIL_Replay(const char *pFileName)
+{
+  static MC_Record_Frame_t Frames[SIL_MAX_FRAMES];
+  qd_t Vqd = {0, 0};
+  uint32_t wNbFrames = 0U;
+  uint32_t wFrame;
+  uint32_t wMismatch = SIL_MAX_FRAMES;
+  FILE *pFile = fopen(pFileName, "rb");
+
+  if (NULL != pFile)
+  {
+    wNbFrames = (uint32_t)fread(Frames, sizeof(MC_Record_Frame_t), SIL_MAX_FRAMES, pFile);
+    (void)fclose(pFile);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  SIL_Clear();
+  for (wFrame = 0U; (wFrame < wNbFrames) && (SIL_MAX_FRAMES == wMismatch); wFrame++)
+  {
+    const MC_Record_Frame_t *pFrame = &Frames[wFrame];
+    ab_t Iab = {pFrame->hIa, pFrame->hIb};
+    qd_t Iqdref = {pFrame->hIqref, pFrame->hIdref};
+    qd_t Iqd;
+    int16_t hObsAngle;
+
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+    PCC_SetBusVoltage(&SilPCC, pFrame->hBusVoltage_d);
+#endif
+    Vqd = SIL_Period(0U != (pFrame->hFlags & MC_RECORD_FLAG_PCC), Iab, pFrame->hElAngle, pFrame->hElSpeedDpp,
+                     Iqdref, Vqd, pFrame->hBusVoltage_d, &Iqd, &hObsAngle);
+    if ((Vqd.q != pFrame->hVq) || (Vqd.d != pFrame->hVd)
+        || (((true == SIL_IsPCCEngaged()) ? MC_RECORD_FLAG_PCC : 0U) != (pFrame->hFlags & MC_RECORD_FLAG_PCC)))
+    {
+      wMismatch = wFrame;
+      (void)printf("replay: frame %u differs, Vqd %d %d flags 0x%04x, recorded %d %d flags 0x%04x\n",
+                   (unsigned)wFrame, Vqd.q, Vqd.d, (true == SIL_IsPCCEngaged()) ? MC_RECORD_FLAG_PCC : 0U,
+                   pFrame->hVq, pFrame->hVd, pFrame->hFlags);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  if (SIL_MAX_FRAMES == wMismatch)
+  {
+    (void)printf("replay: %u frames of %s bit exact\n", (unsigned)wNbFrames, pFileName);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return ((wNbFrames > 0U) && (SIL_MAX_FRAMES == wMismatch));
+}
+
+/* Runs the load step scenario through the frames of the processor in the loop mode, with
+   a step per FOC period, and alongside it without the frames */
+static bool SIL_Pil(unsigned long lSteps)
+{
+  const SIL_Scenario_t *pScenario = &SilScenarios[1];
+  bool PCCRequested = (CURRENT_CONTROLLER == CURR_CTRL_PCC);
+  MC_Plant_t Plant;
+  qd_t Iqdref = {SIL_IQREF(pScenario->hIqrefAfter), 0};
+  qd_t Vqd = {0, 0};
+  qd_t VqdRef[SIL_WARMUP + SIL_SETTLE];
+  unsigned long lStep;
+  unsigned long lMismatch = lSteps;
+  uint32_t wCycles = 0U;
+  uint32_t wMaxCycles = 0U;
+  MC_Pil_Output_t Output = {0};
+
+  if (lSteps > (SIL_WARMUP + SIL_SETTLE))
+  {
+    lSteps = SIL_WARMUP + SIL_SETTLE;
+    lMismatch = lSteps;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  /* Reference run, without the frames */
+  SIL_Clear();
+  MC_Plant_Init(&Plant, pScenario->fRsScale, pScenario->fLsScale);
+  MC_Plant_SetSpeed(&Plant, pScenario->hSpeedAfter);
+  for (lStep = 0UL; lStep < lSteps; lStep++)
+  {
+    qd_t Iqd;
+    int16_t hObsAngle;
+
+    VqdRef[lStep] = SIL_Period(PCCRequested, MC_Plant_GetIab(&Plant), Plant.hElAngle, Plant.hElSpeedDpp,
+                               Iqdref, Vqd, PCC_NOMINAL_BUS_D, &Iqd, &hObsAngle);
+    (void)SIL_PlantStep(&Plant, Vqd);
+    Vqd = VqdRef[lStep];
+  }
+
+  /* Same run through the frames */
+  SIL_Clear();
+  MC_Plant_Init(&Plant, pScenario->fRsScale, pScenario->fLsScale);
+  MC_Plant_SetSpeed(&Plant, pScenario->hSpeedAfter);
+  Vqd.q = 0;
+  Vqd.d = 0;
+  (void)MC_Pil_Command(MC_PIL_CMD_ON);
+  MC_Pil_SetStepRate(1U);
+  for (lStep = 0UL; (lStep < lSteps) && (lMismatch == lSteps); lStep++)
+  {
+    ab_t Iab = MC_Plant_GetIab(&Plant);
+    MC_Pil_Input_t Input;
+
+    /* Host: frame of the plant */
+    Input.hSeq = (uint16_t)lStep;
+    Input.hIa = Iab.a;
+    Input.hIb = Iab.b;
+    Input.hElAngle = Plant.hElAngle;
+    Input.hElSpeedDpp = Plant.hElSpeedDpp;
+    Input.hBusVoltage_d = PCC_NOMINAL_BUS_D;
+    (void)MC_Pil_Push(&Input);
+
+    /* Target: high frequency task */
+    if (false == MC_Pil_IsHolding())
+    {
+      const MC_Pil_Input_t *pStep;
+      ab_t IabStep;
+      qd_t Iqd;
+      qd_t VqdNext;
+      int16_t hObsAngle;
+      uint8_t bVector = MC_PIL_NO_VECTOR;
+
+      SilDWT.CYCCNT = (uint32_t)SIL_Now();
+      pStep = MC_Pil_StartStep();
+      IabStep.a = pStep->hIa;
+      IabStep.b = pStep->hIb;
+      VqdNext = SIL_Period(PCCRequested, IabStep, pStep->hElAngle, pStep->hElSpeedDpp,
+                           Iqdref, Vqd, MC_Pil_GetBusVoltage(), &Iqd, &hObsAngle);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && (PCC_OUTPUT_MODE == PCC_FINITE_SET)
+      bVector = (true == SilCRG.PCCEngaged) ? PCC_GetSwitchingState(&SilPCC) : MC_PIL_NO_VECTOR;
+#endif
+      SilDWT.CYCCNT = (uint32_t)SIL_Now();
+      MC_Pil_EndStep(VqdNext, MCM_Rev_Park(VqdNext, pStep->hElAngle), bVector,
+                     (true == SIL_IsPCCEngaged()) ? MC_PIL_FLAG_PCC : 0U);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    /* Host: outputs of the step, applied during the next one */
+    MC_Pil_GetOutput(&Output);
+    if ((Output.hSeq != (uint16_t)lStep) || (Output.hVq != VqdRef[lStep].q) || (Output.hVd != VqdRef[lStep].d))
+    {
+      lMismatch = lStep;
+      (void)printf("pil: step %lu differs, seq %u Vqd %d %d, expected %lu %d %d\n", lStep, (unsigned)Output.hSeq,
+                   Output.hVq, Output.hVd, lStep, VqdRef[lStep].q, VqdRef[lStep].d);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    wCycles += Output.hCycles;
+    wMaxCycles = (Output.hCycles > wMaxCycles) ? Output.hCycles : wMaxCycles;
+    (void)SIL_PlantStep(&Plant, Vqd);
+    Vqd.q = Output.hVq;
+    Vqd.d = Output.hVd;
+  }
+  (void)MC_Pil_Command(MC_PIL_CMD_OFF);
+
+  if (lMismatch == lSteps)
+  {
+    (void)printf("pil: %lu steps bit exact, %u late periods, step %.1f ns mean %u ns max\n", lSteps,
+                 (unsigned)Output.hLatePeriods, (double)wCycles / (double)lSteps, (unsigned)wMaxCycles);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return ((lSteps > 0UL) && (lMismatch == lSteps));
+}
+
+int main(int argc, char *argv[])
+{
+  static const char * const ControllerNames[] = {"PI", "PCC"};
+  unsigned long lPeriods = (argc > 1) ? strtoul(argv[1], NULL, 0) : SIL_DEFAULT_PERIODS;
+  uint8_t bNbControllers = (CURRENT_CONTROLLER == CURR_CTRL_PCC) ? 2U : 1U;
+  bool bPassed = true;
+  uint8_t bController;
+  uint8_t bScenario;
+
+  if ((argc > 2) && (0 == strcmp(argv[1], "--record")))
+  {
+    return ((true == SIL_Record(argv[2])) ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  else if ((argc > 2) && (0 == strcmp(argv[1], "--replay")))
+  {
+    return ((true == SIL_Replay(argv[2])) ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  else if ((argc > 1) && (0 == strcmp(argv[1], "--pil")))
+  {
+    return ((true == SIL_Pil((argc > 2) ? strtoul(argv[2], NULL, 0) : (SIL_WARMUP + SIL_SETTLE)))
+            ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  else if ((argc > 2) && (0 == strcmp(argv[1], "--observer")))
+  {
+    pSilObserverFile = fopen(argv[2], "wb");
+    if (NULL == pSilObserverFile)
+    {
+      (void)printf("observer: failed to open %s\n", argv[2]);
+      return (EXIT_FAILURE);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  (void)printf("%-4s %-11s %9s %10s %8s %10s %10s %11s %8s %9s %8s\n", "ctrl", "scenario", "iq_err_pc", "ripple_rms",
+               "thd_pm", "switch_hz", "settle_us", "obs_err_deg", "bus_w", "fallbacks", "ns");
+  for (bController = 0U; bController < bNbControllers; bController++)
+  {
+    for (bScenario = 0U; bScenario < SIL_NB_SCENARIOS; bScenario++)
+    {
+      SIL_Result_t Result;
+
+      bool bInLimits = SIL_Scenario((SIL_Controller_t)bController, &SilScenarios[bScenario], &Result);
+
+      (void)printf("%-4s %-11s %9.1f %10.1f %8.1f %10.0f %10.1f %11.2f %8.2f %9u %8.1f%s\n", ControllerNames[bController],
+                   SilScenarios[bScenario].pName, Result.dMeanError, Result.dRippleRms, Result.dThd, Result.dSwitchingFreq,
+                   Result.dSettlingTime, Result.dAngleError, Result.dBusPower, (unsigned)Result.hFallbacks,
+                   Result.dPeriodTime,
+                   bInLimits ? "" : "  out of limits");
+      bPassed = bInLimits && bPassed;
+    }
+  }
+
+  if (NULL != pSilObserverFile)
+  {
+    bPassed = (0 == ferror(pSilObserverFile)) && bPassed;
+    bPassed = (0 == fclose(pSilObserverFile)) && bPassed;
+    bNbControllers = 0U;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  for (bController = 0U; bController < bNbControllers; bController++)
+  {
+    (void)printf("%s: %.2f million periods per second over %lu periods\n", ControllerNames[bController],
+                 SIL_Throughput((SIL_Controller_t)bController, lPeriods) / 1e6, lPeriods);
+  }
+  return (bPassed ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
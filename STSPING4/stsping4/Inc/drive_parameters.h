@@ -73,6 +73,16 @@
                                                             amplitude-speed consistency */
 #define BEMF_CONSISTENCY_GAIN            64   /* Parameter for B-emf
                                                            amplitude-speed consistency */
+#define PLL_GAIN_SCHEDULE_SPEED_RPM      1000 /*!< Speed below which the PLL
+                                                           gains are raised in inverse
+                                                           proportion to the speed,
+                                                           0 to disable */
+#define PLL_GAIN_SCHEDULE_MAX            4    /*!< Largest factor applied to the
+                                                           PLL gains at low speed */
+/****** State Observer + CORDIC, same observer constants ****/
+#define CORD_MAX_ACCEL_DPPP              64  /*!< Maximum electrical
+                                                            acceleration (dpp per
+                                                            observer period) */
 
 /* USER CODE BEGIN angle reconstruction M1 */
 #define PARK_ANGLE_COMPENSATION_FACTOR 0
@@ -110,9 +120,266 @@
 #define TF_KDDIV_LOG                  LOG2((8192))
 #define TFDIFFERENTIAL_TERM_ENABLING  DISABLE
 
+/* Flying start: a start command first regulates zero currents, so that the observer
+   locks onto the back-EMF of a coasting rotor and the loop is closed without rev-up */
+#define FLYING_START_ENABLING         ENABLE
+#define FLYING_START_CATCH_MS         20   /*!< Duration of the zero current
+                                                regulation, ms */
+#define FLYING_START_MIN_SPEED_RPM    1000 /*!< Mechanical speed below which the
+                                                rotor is considered at rest and
+                                                the rev-up is run */
+
+/* Zero torque coasting of the sensorless builds: in RUN, a null torque reference of the
+   torque mode held COAST_ENTRY_MS above FLYING_START_MIN_SPEED_RPM switches the PWM off,
+   and the high frequency task with it. The angle is propagated at the speed of the
+   observer when the PWM went off, and a torque reference that leaves zero re-engages
+   through the flying start, the observer starting from the propagated angle */
+#define COAST_ENABLING                DISABLE
+#define COAST_ENTRY_MS                50   /*!< Duration of the null reference before
+                                                the PWM is switched off, ms */
+#define COAST_CATCH_MS                10   /*!< Duration of the zero current
+                                                regulation of the re-engagement, ms */
+#define COAST_MAX_SPEED_RPM           MAX_APPLICATION_SPEED_RPM /*!< Mechanical speed
+                                                above which the back-EMF may charge
+                                                the bus through the diodes: no coasting */
+
+/* Quadrature encoder of the M1_ENCODER_SENSOR builds, with the M1_ENCODER_PPR
+   of pmsm_motor_parameters.h */
+#define ENC_ICX_FILTER                12   /*!< Input capture filter of the
+                                                encoder timer */
+#define ENC_INVERT_SPEED              DISABLE /*!< ENABLE if the encoder counts
+                                                down in the positive direction */
+#define ENC_AVERAGING_FIFO_DEPTH      16   /*!< Medium frequency periods averaged
+                                                by the speed, up to 16 */
+#define ALIGNMENT_DURATION            700  /*!< Duration of the alignment of the
+                                                rotor on the encoder, ms */
+#define ALIGNMENT_ANGLE_DEG           90   /*!< Electrical angle of the alignment */
+#define FINAL_I_ALIGNMENT             642  /*!< d current of the alignment, s16A */
+#define ENC_PCC_ENGAGE_SPEED_RPM      0    /*!< Engage and disengage speeds of the
+                                                predictive controller, replacing
+                                                PCC_ENGAGE_SPEED_RPM and
+                                                PCC_DISENGAGE_SPEED_RPM */
+#define ENC_PCC_DISENGAGE_SPEED_RPM   0
+
+/* Low speed sensor of the M1_ENCODER_SENSOR and M1_HFI_SENSOR builds */
+#define SENSORLESS_SWITCH_SPEED_RPM   1500 /*!< Mechanical speed above which the
+                                                observer replaces the low speed
+                                                sensor, once it tracks its speed.
+                                                0 keeps the encoder at all speeds,
+                                                not allowed with HFI */
+#define SENSORLESS_SWITCH_BACK_RPM    1300 /*!< Mechanical speed below which the
+                                                low speed sensor takes over again */
+
+/* High frequency injection of the M1_HFI_SENSOR builds */
+#define HFI_INJECTION_VOLTAGE_V       3.0  /*!< Amplitude of the square wave
+                                                carrier on the d voltage, V */
+#define HFI_HALF_PERIOD               2    /*!< FOC periods of each sign of the
+                                                carrier, from 2 to 4 */
+#define HFI_PLL_BANDWIDTH_HZ          100  /*!< Bandwidth of the angle PLL */
+#define HFI_LOCK_MS                   50   /*!< Lock of the PLL at zero current
+                                                before the polarity detection, ms */
+#define HFI_POLARITY_MS               20   /*!< Duration of each d current pulse
+                                                of the polarity detection, ms */
+#define HFI_POLARITY_CURRENT          642  /*!< d current of the pulses, s16A */
+
+/* Position control of the M1_POSITION_CTRL builds */
+#define POSITION_LOOP_FREQUENCY_HZ    4000 /*!< Execution rate of the trajectory
+                                                and of the position PID, a
+                                                multiple of 1000 Hz and of the
+                                                speed loop frequency. Above
+                                                2000 Hz the SysTick runs at
+                                                this rate */
+#define PID_POSITION_KP_GAIN          2000 /*!< Gains of the position PID, from
+                                                the mechanical angle error in
+                                                s16 degrees to the q current in
+                                                s16A: starting values, to be
+                                                tuned with the inertia of the
+                                                load */
+#define PID_POSITION_KI_GAIN          100
+#define PID_POSITION_KD_GAIN          400
+#define POS_KPDIV                     1024
+#define POS_KIDIV                     32768
+#define POS_KDDIV                     16
+#define POS_KPDIV_LOG                 LOG2((1024))
+#define POS_KIDIV_LOG                 LOG2((32768))
+#define POS_KDDIV_LOG                 LOG2((16))
+
+/* Predictive current control */
+#define PCC_ENGAGE_SPEED_RPM          1900 /*!< Absolute mechanical speed above
+                                                which the predictive controller
+                                                replaces the torque and flux PI
+                                                loops, in both directions */
+#define PCC_DISENGAGE_SPEED_RPM       1700 /*!< Absolute mechanical speed below
+                                                which the torque and flux PI loops
+                                                take over again */
+#define PCC_SWITCHING_WEIGHT          0    /*!< Cost of one inverter leg commutation,
+                                                in units of 256 squared current
+                                                digits. 0 disables the penalty */
+#define PCC_TIE_BAND                  0    /*!< Cost difference, in the units of
+                                                PCC_SWITCHING_WEIGHT, within which
+                                                one of the candidates is drawn at
+                                                random. 0 disables the tie break */
+#define PCC_NODE_BUDGET               64   /*!< Maximum number of nodes evaluated
+                                                by the horizon search in one FOC
+                                                period */
+#define PCC_FALLBACK_OVERRUNS         4    /*!< Consecutive node budget overruns
+                                                that hand the regulation over to
+                                                the PI controllers. 0 disables
+                                                the fallback */
+#define PCC_FALLBACK_MS               20   /*!< Duration of the fallback to the
+                                                PI controllers */
+#define PCC_RESIDUAL_LIMIT_PC         20   /*!< Mean error of the predicted
+                                                currents, in % of the nominal
+                                                current, that falls back to the
+                                                PI controllers. 0 disables it */
+#define PCC_RESIDUAL_SHIFT            6    /*!< The error is averaged over
+                                                2^PCC_RESIDUAL_SHIFT FOC periods */
+#define PCC_DIST_OBSERVER_GAIN        0.1  /*!< Share of the prediction error of
+                                                one period added to the estimated
+                                                disturbance, below 1. 0 disables
+                                                the disturbance observer */
+#define PCC_STATE_FILTER_GAIN         0.5  /*!< With PCC_STATE_FILTER, share of the
+                                                prediction error of one period
+                                                added to the predicted currents,
+                                                below 1. Steady state Kalman gain
+                                                K = P / (P + R), with
+                                                P = (Q + sqrt(Q^2 + 4 Q R)) / 2,
+                                                R the variance of the noise of
+                                                the measured currents and Q the
+                                                one of the model error over one
+                                                period */
+/* Predictive current control inverter model, dead time from DEADTIME_NS */
+#define PCC_SWITCH_DROP_V             0.1  /*!< Voltage across a conducting power
+                                                switch at the rated current */
+#define PCC_DIODE_DROP_V              0.1  /*!< Voltage across a conducting
+                                                freewheeling device, the same as
+                                                PCC_SWITCH_DROP_V with MOSFETs in
+                                                synchronous rectification */
+/* Predictive current control model estimation */
+#define PCC_EST_FORGETTING_FACTOR     0.999 /*!< Forgetting factor of the least
+                                                squares, per medium frequency
+                                                period */
+#define PCC_EST_PRIOR_WEIGHT          0.1  /*!< Weight of the temperature prior of
+                                                the resistance, relative to one
+                                                equation of the model */
+#define PCC_EST_INIT_COVARIANCE       1.0  /*!< Initial covariance of the estimates */
+#define PCC_EST_MIN_SPEED_RPM         300  /*!< Mechanical speed below which the
+                                                model is not estimated */
+#define PCC_EST_MIN_CURRENT_A         0.5  /*!< q current below which the model is
+                                                not estimated */
+#define PCC_EST_REF_TEMP_C            25   /*!< Temperature of the nominal stator
+                                                resistance */
+#define PCC_EST_UPDATE_PERIOD_MS      100  /*!< Period of the update of the
+                                                predictor coefficients */
+/* Predictive current control statistics */
+#define PCC_STATS_WINDOW_MS           1000 /*!< Length of the window of the
+                                                decision statistics */
+/* Predictive current control braking close to the overvoltage, with PCC_VBUS_LIMIT */
+#define PCC_VBUS_START_V              68   /*!< Bus voltage from which the
+                                                braking is limited, up to
+                                                OV_VOLTAGE_THRESHOLD_V */
+#define PCC_REGEN_WEIGHT              256  /*!< Cost of a current digit returned
+                                                to the bus at the threshold, in
+                                                squared current error digits */
+#define PCC_BRAKE_ID_PC               30   /*!< d current injected at the
+                                                threshold, in percent of the
+                                                nominal current */
+/* Predictive current control inductance saturation, with PCC_INDUCTANCE_TABLE */
+#define PCC_LSAT_RANGE_PC             100  /*!< q current of the last point of
+                                                the table, in percent of the
+                                                measurement range */
+#define PCC_LSAT_KNEE_PC              50   /*!< q current from which the
+                                                default table saturates, in
+                                                percent of the range */
+#define PCC_LSAT_DROP_PC              0    /*!< Inductance lost at the last
+                                                point of the default table, in
+                                                percent */
+/* Predictive current control cost weights, by operating point */
+#define PCC_WEIGHT_SPEED_BAND1_RPM    2500 /*!< Mechanical speeds at which the */
+#define PCC_WEIGHT_SPEED_BAND2_RPM    3500 /*!< first two speed bands end */
+#define PCC_WEIGHT_IQ_BAND1_PC        30   /*!< q currents, in percent of the */
+#define PCC_WEIGHT_IQ_BAND2_PC        70   /*!< nominal current, at which the
+                                                first two q current bands end */
+#define PCC_BARRIER_CURRENT_PC        100  /*!< Current magnitude, in percent of
+                                                the nominal current, above which
+                                                the barrier weight applies */
+#define PCC_MAX_CURRENT_PC            90   /*!< Current magnitude, in percent of
+                                                the measurement range, above which
+                                                a vector is only applied if no
+                                                other one stays below it. 0
+                                                disables the constraint */
+#define PCC_TRIP_CURRENT_PC           85   /*!< Phase current, in percent of the
+                                                measurement range, above which a
+                                                vector is only applied if no other
+                                                one stays below it: to be set
+                                                below the trip of the overcurrent
+                                                protection. 0 disables the
+                                                constraint */
+/* Predictive current control decision period, with PCC_ADAPTIVE_PERIOD */
+#define PCC_PERIOD_SPEED_BAND1_RPM    3000 /*!< Mechanical speeds below which the
+                                                vector is decided every 2 */
+#define PCC_PERIOD_SPEED_BAND2_RPM    2200 /*!< and every 4 FOC periods */
+#define PCC_PERIOD_HYST_RPM           100  /*!< Speed below a band before the
+                                                decision period is made longer */
+/* Weights of the q error, of the d error, of the switching penalty and of the
+   current barrier, 256 for 1. One line per speed band, from the lowest, with
+   one entry per q current band, from the lowest */
+#define PCC_WEIGHT_TABLE              { {256, 256, 256, 1024}, {256, 256, 256, 1024}, {256, 256, 256, 1024},\
+                                        {256, 256, 256, 1024}, {256, 256, 256, 1024}, {256, 256, 256, 1024},\
+                                        {256, 256, 256, 1024}, {256, 256, 256, 1024}, {256, 256, 256, 1024} }
+
+/* Flux weakening */
+#define FW_VOLTAGE_REF                985  /*!< Vs reference, tenth of a percent
+                                                of the maximum module */
+#define FW_KP_GAIN                    3000 /*!< Default Kp gain */
+#define FW_KI_GAIN                    5000 /*!< Default Ki gain */
+#define FW_KPDIV                      32768
+#define FW_KIDIV                      32768
+#define FW_KPDIV_LOG                  LOG2((32768))
+#define FW_KIDIV_LOG                  LOG2((32768))
+
 /* Speed control loop */
 #define SPEED_LOOP_FREQUENCY_HZ       ( uint16_t )2000 /*!<Execution rate of speed
-                                                      regulation loop (Hz) */
+                                                      regulation loop (Hz). Above
+                                                      2000 Hz the SysTick runs at
+                                                      this rate, a multiple of
+                                                      1000 Hz */
+#define SPEED_ACC_FF_INERTIA_KGM2     0.0  /*!< Inertia of the rotor and of its
+                                                load, kg.m2. The torque of the
+                                                speed ramps is fed forward to
+                                                the speed PI output. 0 disables
+                                                the acceleration feed-forward */
+/* Speed predictive control */
+#define SPEED_MPC_HORIZON             20   /*!< Prediction horizon, in speed loop
+                                                periods, up to 32 */
+#define SPEED_MPC_MOVE_WEIGHT         1.0  /*!< Weight of the change of the q
+                                                current reference, relative to
+                                                the speed tracking error */
+#define SPEED_MPC_INERTIA_KGM2        0.0002 /*!< Nominal inertia of the rotor and
+                                                of its load, kg.m2, from which the
+                                                model is estimated */
+#define SPEED_MPC_FORGETTING_FACTOR   0.9995 /*!< Forgetting factor of the least
+                                                squares, per speed loop period */
+#define SPEED_MPC_INIT_COVARIANCE     1.0  /*!< Initial covariance of the estimates */
+#define SPEED_MPC_EST_MIN_SPEED_RPM   150  /*!< Mechanical speed below which the
+                                                model is not estimated */
+/* Load torque observer, LOAD_TORQUE_OBSERVER */
+#define LOAD_OBS_INERTIA_KGM2         0.0002 /*!< Inertia of the rotor and of its
+                                                load, kg.m2 */
+#define LOAD_OBS_BANDWIDTH_HZ         20   /*!< Bandwidth of the observer, below
+                                                the speed loop frequency / 13 */
+#define LOAD_OBS_FF_PC                100  /*!< Share of the estimated load fed
+                                                forward to the q current */
+#define LOAD_OBS_MAX_PC               100  /*!< Bound of the estimated load, in %
+                                                of the nominal current */
+/* Filter bank of the speed loop, SPEED_FILTER_BANK */
+#define SPEED_FILTER_NOTCH_HZ         0    /*!< Center of the notch on the torque
+                                                reference, the frequency of the
+                                                mechanical resonance. 0 for none */
+#define SPEED_FILTER_NOTCH_WIDTH_HZ   40   /*!< Width of the notch at -3 dB */
+#define SPEED_FILTER_LOW_PASS_HZ      0    /*!< Cut-off of the second order
+                                                low-pass on the torque reference.
+                                                0 for none */
 
 #define PID_SPEED_KP_DEFAULT          1000/(SPEED_UNIT/10) /* Workbench compute the gain for 01Hz unit*/
 #define PID_SPEED_KI_DEFAULT          700/(SPEED_UNIT/10) /* Workbench compute the gain for 01Hz unit*/
@@ -132,6 +399,14 @@
 #define SPD_DIFFERENTIAL_TERM_ENABLING DISABLE
 #define IQMAX                          2571
 
+/* MTPA parameters, the segments of the Id(Iq) curve over 0 to IQMAX computed
+   from LS, LD_LQ_RATIO and MOTOR_VOLTAGE_CONSTANT:
+   Id = Psi/(2*(Lq-Ld)) - sqrt((Psi/(2*(Lq-Ld)))^2 + Iq^2). With LD_LQ_RATIO 1
+   the motor has no reluctance torque and the curve is Id = 0 */
+#define SEGDIV                         (int16_t)322
+#define ANGC                           {0, 0, 0, 0, 0, 0, 0, 0}
+#define OFST                           {0, 0, 0, 0, 0, 0, 0, 0}
+
 /* Default settings */
 #define DEFAULT_CONTROL_MODE           STC_SPEED_MODE /*!< STC_TORQUE_MODE or
                                                         STC_SPEED_MODE */
@@ -154,6 +429,78 @@
 #define OV_TEMPERATURE_THRESHOLD_C      90 /*!< Celsius degrees */
 #define OV_TEMPERATURE_HYSTERESIS_C     10 /*!< Celsius degrees */
 
+/* Thermal derating, the rises are the ones at steady state at NOMINAL_CURRENT */
+#define TDR_STAGE_MAX_C                 100 /*!< Largest temperature of the power
+                                                 switches, Celsius degrees */
+#define TDR_STAGE_RISE_C                20  /*!< Rise of the power switches above
+                                                 the heat sink, Celsius degrees */
+#define TDR_STAGE_TAU_S                 2.0 /*!< Thermal time constant of the
+                                                 power switches, seconds */
+#define TDR_WINDING_MAX_C               120 /*!< Largest temperature of the
+                                                 windings, Celsius degrees */
+#define TDR_WINDING_RISE_C              60  /*!< Rise of the windings above the
+                                                 heat sink, Celsius degrees */
+#define TDR_WINDING_TAU_S               120.0 /*!< Thermal time constant of the
+                                                 windings, seconds */
+#define TDR_BAND_C                      10  /*!< Headroom below which the current
+                                                 is derated, Celsius degrees */
+
+/* Loss minimization, LOSS_MINIMIZATION, currents in percent of NOMINAL_CURRENT */
+#define LMN_LIGHT_LOAD_PC               30  /*!< q current up to which the d
+                                                 current of least loss is
+                                                 searched */
+#define LMN_LOAD_BAND_PC                5   /*!< Change of the q current that
+                                                 discards a power measurement */
+#define LMN_MIN_SPEED_RPM               1000 /*!< Mechanical speed from which
+                                                 the d current is searched */
+#define LMN_ID_STEP_PC                  2   /*!< Step of the d current */
+#define LMN_ID_MAX_PC                   20  /*!< Largest d current offset */
+#define LMN_SETTLE_MS                   200 /*!< Wait after a step, for the
+                                                 speed loop to settle */
+#define LMN_AVG_MS                      200 /*!< Averaging time of the power
+                                                 after a step */
+
+/* Harmonic compensation, HARMONIC_COMPENSATION */
+#define HCM_LEARN_SPEED_RPM             1000 /*!< Mechanical speed at which the
+                                                 voltages of the table are
+                                                 given */
+#define HCM_MIN_SPEED_RPM               100 /*!< Mechanical speed from which
+                                                 the table is learned */
+#define HCM_STEADY_BAND_RPM             30  /*!< Speed error up to which the
+                                                 speed is steady */
+#define HCM_LEARN_SHIFT                 6   /*!< An entry learns 2^-n of its
+                                                 error each time */
+#define HCM_MEAN_SHIFT                  12  /*!< The means are taken over 2^n
+                                                 FOC periods, several electrical
+                                                 revolutions at the lowest
+                                                 speed */
+
+/* Six-step mode, SIX_STEP_MODE */
+#define SIX_STEP_MIN_SPEED_RPM          1800 /*!< Mechanical speed from which
+                                                 the mode is entered */
+#define SIX_STEP_EXIT_SPEED_RPM         1600 /*!< Mechanical speed below which
+                                                 the mode is left */
+#define SIX_STEP_ENTER_PC               97  /*!< Part of the voltage limit from
+                                                 which the request is saturated,
+                                                 below FW_VOLTAGE_REF */
+#define SIX_STEP_EXIT_PC                90  /*!< Part of the voltage limit below
+                                                 which the mode is left */
+#define SIX_STEP_ENTER_MS               20  /*!< Saturated request before the
+                                                 mode is entered */
+#define SIX_STEP_FILTER_SHIFT           4   /*!< The request is averaged over
+                                                 2^n FOC periods */
+#define SIX_STEP_HYST_SHIFT             4   /*!< A vertex is left once the next
+                                                 one is nearer by 2^-n of the
+                                                 request */
+
+/* Inrush current limiter, M1_ICL_ENABLED */
+#define INRUSH_CURRLIMIT_CHANGE_AFTER_MS 20 /*!< Switching time of the bypass
+                                                 relay, ms */
+#define INRUSH_CURRLIMIT_WINDOW_MS      10  /*!< Interval between the samples of
+                                                 the bus voltage rise, ms */
+#define INRUSH_CURRLIMIT_SETTLE_V       0.5 /*!< Rise of the bus voltage still
+                                                 expected at the bypass, Volts */
+
 #define HW_OV_CURRENT_PROT_BYPASS       DISABLE /*!< In case ON_OVER_VOLTAGE
                                                           is set to TURN_ON_LOW_SIDES
                                                           this feature may be used to
@@ -199,6 +546,10 @@
                                                          former NB_CONSECUTIVE_TESTS/
                                                          (TF_REGULATION_RATE/
                                                          MEDIUM_FREQUENCY_TASK_RATE) */
+#define OBS_FAST_CONVERGENCE_ENABLING  ENABLE /*!< A test inside the inner
+                                                         half of the speed band counts
+                                                         twice, a failed test halves
+                                                         the count instead of clearing it */
 #define SPEED_BAND_UPPER_LIMIT         17 /*!< It expresses how much
                                                             estimated speed can exceed
                                                             forced stator electrical
@@ -217,6 +568,9 @@
 #define  M1_TEMP_SAMPLING_TIME  LL_ADC_SAMPLING_CYCLE(47)
 /******************************   Current sensing Motor 1   **********************/
 #define ADC_SAMPLING_CYCLES (6 + SAMPLING_CYCLE_CORRECTION)
+/* Injected conversions averaged by the ADC oversampler for each current sample:
+   1 (oversampling disabled), 2 or 4 */
+#define ADC_INJ_OVERSAMPLING 1
 
 /******************************   ADDITIONAL FEATURES   **********************/
 
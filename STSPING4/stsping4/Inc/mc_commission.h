@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file    mc_commission.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Identification of the model of the predictive current controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_COMMISSION_H
+#define MC_COMMISSION_H
+
+#include "mc_type.h"
+#include "pcc.h"
+#include "pcc_est.h"
+
+/* The self-commissioning is built when MC_COMMISSION_MODE is added to the preprocessor
+   symbols of the build configuration, with the PCC current controller and
+   PCC_MODEL_ESTIMATION. MC_CommissionMotor1() identifies the a, b and c terms of the
+   model of PCC_EST, in the units of the predictor, instead of taking them from the
+   motor parameters:
+
+   - the rotor is aligned by a d current of MC_COMMISSION_CURRENT, regulated by the PI
+     controllers at the angle of the Virtual Speed Sensor at rest;
+   - a is the slope of the d voltage between half and the whole MC_COMMISSION_CURRENT:
+     the drop of the dead time, the same at both currents, cancels out;
+   - bd and bq are the inverses of the current change per voltage digit and per period,
+     measured with pulses of two periods of each sign added on the d, then on the q
+     voltage that holds the current;
+   - c is the back-EMF at MC_COMMISSION_SPEED_UNIT, reached in open loop by the Virtual
+     Speed Sensor with the same d current, once the resistive and inductive drops are
+     removed from the averaged voltage.
+
+   - with PCC_INDUCTANCE_TABLE, the d pulses are repeated while the d current is held at
+     each point of the saturation table above MC_COMMISSION_CURRENT and up to
+     MC_COMMISSION_LSAT_CURRENT. The rotor is not allowed to turn: the saturation by the
+     d current stands for the one by the q current the table is indexed by. The points
+     up to MC_COMMISSION_CURRENT keep the inductance of the model, the ones above
+     MC_COMMISSION_LSAT_CURRENT the inductance of the last point measured.
+
+   The predictor has a single inductance and is given the mean of bd and bq. The model
+   becomes the nominal model of PCC_EST and is written in the flash page before the one
+   of mc_offset_store, that must be removed from the FLASH region of the linker script
+   as well: the next boots reload it. */
+
+/* Currents of the standstill phases, in digits, and speed of the flux phase */
+#ifndef MC_COMMISSION_CURRENT
+#define MC_COMMISSION_CURRENT       ((int16_t)(NOMINAL_CURRENT / 2))
+#endif
+#ifndef MC_COMMISSION_SPEED_UNIT
+#define MC_COMMISSION_SPEED_UNIT    ((int16_t)(MAX_APPLICATION_SPEED_UNIT / 4))
+#endif
+/* Largest d current of the inductance saturation points, in digits */
+#ifndef MC_COMMISSION_LSAT_CURRENT
+#define MC_COMMISSION_LSAT_CURRENT  ((int16_t)NOMINAL_CURRENT)
+#endif
+/* Duration of the acceleration to MC_COMMISSION_SPEED_UNIT */
+#define MC_COMMISSION_RAMP_MS       1000U
+
+/* FOC periods of the alignment, the d current settles for a quarter of them at each
+   change of level */
+#define MC_COMMISSION_SETTLE_LOG    13U
+/* FOC periods averaged at each current level */
+#define MC_COMMISSION_AVG_LOG       12U
+/* Pulse cycles of 8 FOC periods on each axis */
+#define MC_COMMISSION_CYCLES_LOG    8U
+/* Medium frequency periods averaged at MC_COMMISSION_SPEED_UNIT */
+#define MC_COMMISSION_FLUX_LOG      9U
+/* Largest pulse, in voltage digits */
+#define MC_COMMISSION_MAX_PULSE     8192
+
+/* Estimates of MC_Commission_GetEstimate(): the a, b and c terms, in the order of the
+   parameters of PCC_EST, then bd and bq */
+#define MC_COMMISSION_NB_ESTIMATES  5U
+#define MC_COMMISSION_RS            0U
+#define MC_COMMISSION_LS            1U
+#define MC_COMMISSION_FLUX          2U
+#define MC_COMMISSION_LD            3U
+#define MC_COMMISSION_LQ            4U
+
+typedef enum
+{
+  MC_COMM_IDLE = 0,   /*!< Not started or stopped */
+  MC_COMM_ALIGN,      /*!< Rotor aligned by the d current */
+  MC_COMM_RS_LOW,     /*!< d current at half MC_COMMISSION_CURRENT */
+  MC_COMM_RS_HIGH,    /*!< d current at MC_COMMISSION_CURRENT */
+  MC_COMM_LD,         /*!< Voltage pulses on the d axis */
+  MC_COMM_LQ,         /*!< Voltage pulses on the q axis */
+  MC_COMM_LSAT_HOLD,  /*!< d current held at a point of the saturation table,
+                           with PCC_INDUCTANCE_TABLE */
+  MC_COMM_LSAT,       /*!< Voltage pulses on the d axis at that current */
+  MC_COMM_SPIN,       /*!< Standstill phases done, the voltage is held until the
+                           medium frequency task starts the acceleration */
+  MC_COMM_RAMP,       /*!< Acceleration to MC_COMMISSION_SPEED_UNIT */
+  MC_COMM_FLUX,       /*!< Voltages and currents averaged at MC_COMMISSION_SPEED_UNIT */
+  MC_COMM_DONE,       /*!< Model identified */
+  MC_COMM_FAILED      /*!< Implausible measurement, the model is not changed */
+} MC_Commission_Phase_t;
+
+/* The standstill phases, up to MC_COMM_SPIN, are run by the high frequency task */
+void MC_Commission_Start(const PCC_Handle_t *pPCC, int16_t hCurrent);
+void MC_Commission_Stop(void);
+MC_Commission_Phase_t MC_Commission_GetPhase(void);
+bool MC_Commission_IsStandstill(void);
+bool MC_Commission_IsRegulating(void);
+qd_t MC_Commission_GetCurrentRef(void);
+qd_t MC_Commission_Exec(qd_t Iqd, qd_t Vqd);
+
+/* Medium frequency task, from MC_COMM_SPIN */
+bool MC_Commission_Spin(void);
+void MC_Commission_StartFlux(void);
+void MC_Commission_AccumulateFlux(qd_t Iqd, qd_t Vqd, int16_t hElSpeedDpp);
+
+float_t MC_Commission_GetEstimate(uint8_t bParam);
+void MC_Commission_Apply(PCC_EST_Handle_t *pEst, PCC_Handle_t *pPCC);
+bool MC_Commission_Load(void);
+void MC_Commission_Save(void);
+
+#endif /* MC_COMMISSION_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -59,6 +59,7 @@ typedef struct
 #define EHALL      4
 #define EHSO       5
 #define EZEST      6
+#define EHFI       7
 
 #define SDK_VERSION_MAIN   (0x5) /*!< [31:24] main version */
 #define SDK_VERSION_SUB1   (0x5a) /*!< [23:16] sub1 version */
@@ -89,6 +90,9 @@ typedef struct
 /* configurationFlag2 definition */
 #define OVERMODULATION_FLAG (1U)
 #define DISCONTINUOUS_PWM_FLAG (1U << 1U)
+#define PREDICTIVE_CURRENT_CTRL_FLAG (1U << 2U)
+#define PCC_FLOAT_COST_FLAG (1U << 3U)
+#define PCC_TORQUE_COST_FLAG (1U << 4U)
 #define DBG_MCU_LOAD_MEASURE_FLAG (1U << 14U)
 #define DBG_OPEN_LOOP_FLAG (1U << 15U)
 
@@ -97,14 +101,37 @@ typedef struct
 #define MCP_OVER_UARTA   (1U<< 1U)
 #define MCP_OVER_UARTB   0U
 
-#define configurationFlag1_M1 (VBUS_SENSING_FLAG|TEMP_SENSING_FLAG|DAC_CH1_FLAG|DAC_CH2_FLAG)
-#define configurationFlag2_M1 (0U)
+#ifdef M1_POSITION_CTRL
+#define configurationFlag1_M1 (POSITION_CTRL_FLAG|FLUX_WEAKENING_FLAG|FEED_FORWARD_FLAG|MTPA_FLAG|VBUS_SENSING_FLAG|TEMP_SENSING_FLAG|DAC_CH1_FLAG|DAC_CH2_FLAG)
+#else
+#define configurationFlag1_M1 (FLUX_WEAKENING_FLAG|FEED_FORWARD_FLAG|MTPA_FLAG|VBUS_SENSING_FLAG|TEMP_SENSING_FLAG|DAC_CH1_FLAG|DAC_CH2_FLAG)
+#endif
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC)
+#include "pcc.h"
+#if (PCC_COST_NORM == PCC_COST_L2_FLOAT)
+#define configurationFlag2_M1 (PREDICTIVE_CURRENT_CTRL_FLAG|PCC_FLOAT_COST_FLAG)
+#elif (PCC_COST_OBJECTIVE == PCC_OBJECTIVE_TORQUE)
+#define configurationFlag2_M1 (PREDICTIVE_CURRENT_CTRL_FLAG|PCC_TORQUE_COST_FLAG)
+#else
+#define configurationFlag2_M1 (PREDICTIVE_CURRENT_CTRL_FLAG)
+#endif
+#else
+#define configurationFlag2_M1 0U
+#endif
 
 #define MAX_OF_MOTORS 2U
 #define NBR_OF_MOTORS  1
 #define DRIVE_TYPE_M1  0
+#ifdef M1_ENCODER_SENSOR
+#define PRIM_SENSOR_M1  EENCODER
+#define AUX_SENSOR_M1  EPLL
+#elif defined(M1_HFI_SENSOR)
+#define PRIM_SENSOR_M1  EHFI
+#define AUX_SENSOR_M1  EPLL
+#else
 #define PRIM_SENSOR_M1  EPLL
 #define AUX_SENSOR_M1  ENO_SENSOR
+#endif
 #define TOPOLOGY_M1 0
 #define FOC_RATE_M1 1
 #define PWM_FREQ_M1 20000
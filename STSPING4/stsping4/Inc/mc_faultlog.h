@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************
+  * @file    mc_faultlog.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Log of the faults and of the periods before them, stored in flash
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_FAULTLOG_H
+#define MC_FAULTLOG_H
+
+#include "mc_type.h"
+#include "mc_ram_budget.h"
+
+/* The fault log is built when MC_FAULTLOG_MODE is added to the preprocessor symbols of
+   the build configuration. The current controller keeps the snapshots of its last
+   MC_FAULTLOG_DEPTH periods in RAM. When the drive enters a fault:
+
+   - the safety task freezes them, with the faults, the timestamp and the controller
+     in use, once per fault: the log is armed again by the acknowledgement;
+   - the medium frequency task writes the entry in the two flash pages before the one
+     of mc_profile, that must be removed from the FLASH region of the linker script as
+     well, once the PWM is off. The pages are written in turn: when the current one is
+     full the other one is erased, so that the erases are spread on both and the last
+     page of entries is always kept;
+   - MC_REG_FAULTLOG_COUNT returns the number of entries stored, MC_REG_FAULTLOG_INDEX
+     selects the entry returned by MC_REG_FAULTLOG_DATA, 0 for the newest.
+
+   The timestamp is GLOBAL_TIMESTAMP, in FOC periods since the boot: the sequence
+   number of the entries orders them across the resets. With MC_TIMEBASE_MODE, the
+   timestamp is the low word of the ticks of mc_timebase and wCycles places the freeze
+   between two ticks, MC_FAULTLOG_NO_CYCLES otherwise and in the entries written
+   before wCycles took the spare word of their record. */
+
+/* Snapshots of an entry: MC_FAULTLOG_DEPTH, see mc_ram_budget.h */
+
+/* Values of MC_FaultLog_Entry_t::bController */
+#define MC_FAULTLOG_CTRL_PI         0U    /* PI current regulators */
+#define MC_FAULTLOG_CTRL_PCC        1U    /* Predictive current controller */
+
+/* Value of MC_FaultLog_Entry_t::wCycles without time base */
+#define MC_FAULTLOG_NO_CYCLES       0xFFFFFFFFU
+
+/* Period of the current controller */
+typedef struct
+{
+  int16_t  hIa;                     /* Phase currents read */
+  int16_t  hIb;
+  int16_t  hIq;                     /* Currents regulated */
+  int16_t  hId;
+  int16_t  hIqref;                  /* Current references */
+  int16_t  hIdref;
+  int16_t  hVq;                     /* Voltage written, limited by the circle limitation */
+  int16_t  hVd;
+  int16_t  hElAngle;                /* Angle of the Park transformation */
+  uint16_t hDecision;               /* PCC_Handle_t::hLogDecision, 0 with the PI regulators */
+} MC_FaultLog_Snapshot_t;
+
+/* Entry of the log, also the layout of MC_REG_FAULTLOG_DATA */
+typedef struct
+{
+  uint32_t wSequence;               /* Entries written before this one, across the resets */
+  uint32_t wTimestamp;              /* GLOBAL_TIMESTAMP of the freeze */
+  uint16_t hFaults;                 /* Faults occurred since the acknowledgement, MC_xxx codes */
+  uint8_t  bController;             /* MC_FAULTLOG_CTRL_xxx */
+  uint8_t  bNbSnapshots;            /* Valid snapshots, at the end of Snapshots */
+  MC_FaultLog_Snapshot_t Snapshots[MC_FAULTLOG_DEPTH]; /* Oldest first */
+  uint32_t wCycles;                 /* CPU cycles from the tick of wTimestamp to the freeze */
+} MC_FaultLog_Entry_t;
+
+void MC_FaultLog_Init(void);
+void MC_FaultLog_Write(const MC_FaultLog_Snapshot_t *pSnapshot);
+void MC_FaultLog_Freeze(uint16_t hFaults, uint8_t bController);
+void MC_FaultLog_Rearm(void);
+void MC_FaultLog_Store(void);
+uint16_t MC_FaultLog_GetCount(void);
+void MC_FaultLog_SetReadIndex(uint16_t hIndex);
+uint16_t MC_FaultLog_GetReadIndex(void);
+bool MC_FaultLog_Read(MC_FaultLog_Entry_t *pEntry);
+
+#endif /* MC_FAULTLOG_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
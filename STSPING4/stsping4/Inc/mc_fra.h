@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    mc_fra.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Frequency response analysis of the current and speed loops
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_FRA_H
+#define MC_FRA_H
+
+#include "mc_type.h"
+
+/* The analysis is built when MC_FRA_MODE is added to the preprocessor symbols of the
+   build configuration. The MC_REG_FRA_CONFIG register gives the injection point, the
+   amplitude, the two 16 bits registers measured and the list of frequencies; writing
+   MC_FRA_CMD_START in MC_REG_FRA_STATE then sweeps them in RUN.
+
+   At each frequency, a sine of hAmplitude is added to the current reference or to the
+   voltage of the current controller. Once hSettleCycles periods of the sine have let
+   the loops settle, the two channels are correlated with the sine and the cosine of
+   the injection over hCycles periods: a single bin of the DFT per channel, with a
+   fixed cost of one table sine and four multiply-accumulates per FOC period. The
+   number of FOC periods of the correlation is a whole number of periods of the sine,
+   the frequency is adjusted to it, so that there is no leakage from the other
+   frequencies. A drive that leaves RUN stops the sweep, the frequencies done are kept.
+
+   The points are read at the link pace with the MC_REG_FRA_INDEX and MC_REG_FRA_DATA
+   registers. For a channel answering B.sin(wt + phi) to the injection A.sin(wt), the
+   point gives B.cos(phi) and B.sin(phi) in Q15 of the channel digits: the gain and the
+   phase between two channels, or between a channel and the injection, are the ones of
+   their complex ratio. With the injection on Iq and the channels Iq reference and
+   speed, it measures the speed loop; on Vq with the channels Iq and Vq, the plant of
+   the current loop; on Iq with the measured Iq, the closed current loop. */
+
+/* Number of 16 bits registers measured */
+#define MC_FRA_NB_CHANNELS      2U
+/* Largest number of frequencies of a sweep */
+#ifndef MC_FRA_MAX_POINTS
+#define MC_FRA_MAX_POINTS       24U
+#endif
+
+/* Commands written in MC_REG_FRA_STATE */
+#define MC_FRA_CMD_STOP         0U
+#define MC_FRA_CMD_START        1U
+
+typedef enum
+{
+  MC_FRA_INJ_IQ_REF,        /* Added to the q current reference, in s16A */
+  MC_FRA_INJ_ID_REF,        /* Added to the d current reference, in s16A */
+  MC_FRA_INJ_VQ,            /* Added to the q voltage of the controller, in s16V */
+  MC_FRA_INJ_VD             /* Added to the d voltage of the controller, in s16V */
+} MC_Fra_Injection_t;
+
+typedef enum
+{
+  MC_FRA_IDLE,
+  MC_FRA_SETTLING,          /* Injecting, before the correlation of the point */
+  MC_FRA_MEASURING,         /* Injecting and correlating */
+  MC_FRA_DONE               /* All the points measured */
+} MC_Fra_State_t;
+
+typedef struct
+{
+  uint16_t hRegID[MC_FRA_NB_CHANNELS]; /* TYPE_DATA_16BIT register of each channel */
+  uint8_t  bInjection;                 /* MC_Fra_Injection_t */
+  uint8_t  bNbPoints;                  /* Frequencies of the sweep */
+  int16_t  hAmplitude;                 /* Amplitude of the injected sine */
+  uint16_t hSettleCycles;              /* Periods of the sine before the correlation */
+  uint16_t hCycles;                    /* Periods of the sine correlated */
+  uint32_t wFreq_mHz[MC_FRA_MAX_POINTS];
+} MC_Fra_Config_t;
+
+/* Bytes of the configuration before the frequencies, also in MC_REG_FRA_CONFIG */
+#define MC_FRA_CONFIG_HEADER    12U
+
+/* One frequency, also the layout of the points of MC_REG_FRA_DATA */
+typedef struct
+{
+  uint32_t wFreq_mHz;                        /* Frequency injected, after the adjustment */
+  int32_t  wInPhase[MC_FRA_NB_CHANNELS];     /* B.cos(phi) of each channel */
+  int32_t  wQuadrature[MC_FRA_NB_CHANNELS];  /* B.sin(phi) of each channel */
+} MC_Fra_Point_t;
+
+bool MC_Fra_Configure(const MC_Fra_Config_t *pConfig);
+bool MC_Fra_Command(uint8_t bCmd);
+const MC_Fra_Config_t *MC_Fra_GetConfig(void);
+MC_Fra_State_t MC_Fra_GetState(void);
+qd_t MC_Fra_InjectCurrent(qd_t Iqdref);
+qd_t MC_Fra_InjectVoltage(qd_t Vqd);
+void MC_Fra_Measure(bool Running);
+void MC_Fra_SetReadIndex(uint16_t hIndex);
+uint16_t MC_Fra_GetReadIndex(void);
+uint16_t MC_Fra_Read(MC_Fra_Point_t *pPoints, uint16_t hMaxPoints);
+
+#endif /* MC_FRA_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -32,6 +32,9 @@ extern "C" {
 #include "mc_type.h"
 #include "pwm_curr_fdbk.h"
 #include "speed_torq_ctrl.h"
+#ifdef M1_POSITION_CTRL
+#include "trajectory_ctrl.h"
+#endif
 /** @addtogroup MCSDK
   * @{
   */
@@ -59,6 +62,9 @@ typedef enum
   MCI_CMD_EXECTORQUERAMP,       /*!< ExecTorqueRamp command coming from the user.*/
   MCI_CMD_SETCURRENTREFERENCES, /*!< SetCurrentReferences command coming from the
                                  user.*/
+  MCI_CMD_EXECPOSITIONCMD,      /*!< ExecPositionCommand command coming from the
+                                 user.*/
+  MCI_CMD_STARTSTREAM,          /*!< StartStream command coming from the user.*/
 } MCI_UserCommands_t;
 
 /**
@@ -108,10 +114,48 @@ typedef enum
                           state is normally STOP_IDLE, state machine is moved as
                           soon as the user has acknowledged the fault condition.
                       */
-  WAIT_STOP_MOTOR = 20
+  WAIT_STOP_MOTOR = 20,
+  COMMISSIONING = 21,   /*!< Persistent state where the model of the predictive
+                           current controller is identified, see mc_commission.h.
+                           Following state is STOP, at the end of the
+                           identification or if a stop motor command has been
+                           given */
+  DT_CALIBRATING = 22,  /*!< Persistent state where the dead time compensation is
+                           calibrated at standstill, see mc_dtcalib.h. Following
+                           state is STOP, at the end of the calibration or if a
+                           stop motor command has been given */
+  ADC_CALIBRATING = 23  /*!< Persistent state where the timing of the current
+                           sampling is tuned at standstill, see mc_adccalib.h.
+                           Following state is STOP, at the end of the tuning or if
+                           a stop motor command has been given */
 
 } MCI_State_t;
 
+#ifdef MCI_SETPOINT_STREAM
+#define MCI_STREAM_DEPTH 16U /*!< Entries of the setpoint FIFO, a power of 2 lower than 256.*/
+
+typedef struct
+{
+  uint16_t hTime;  /*!< Time at which the setpoint is reached, in FOC periods of
+                        MCI_GetStreamClock().*/
+  qd_t Iqdref;     /*!< Current references of the setpoint.*/
+} MCI_Setpoint_t;
+
+typedef struct
+{
+  volatile MCI_Setpoint_t Fifo[MCI_STREAM_DEPTH]; /*!< Setpoints not yet reached.*/
+  volatile uint8_t bHead;    /*!< Free running index of the next entry written, only
+                                  by MCI_PushSetpoint.*/
+  volatile uint8_t bTail;    /*!< Free running index of the next entry read, only by
+                                  MCI_ExecStream.*/
+  volatile MCI_Setpoint_t Prev; /*!< Last setpoint reached, start of the interpolation.*/
+  volatile uint16_t hClock;  /*!< FOC periods counted by MCI_ExecStream.*/
+  volatile bool Active;      /*!< True while the stream drives the current references.*/
+  uint32_t wOverruns;        /*!< Setpoints rejected, the FIFO being full.*/
+  uint32_t wStarved;         /*!< FOC periods of the stream without a next setpoint.*/
+} MCI_Stream_t;
+#endif
+
 typedef enum
 {
   MCI_NO_COMMAND = 0,    /**< No Command --- Set when going to IDLE */
@@ -120,7 +164,12 @@ typedef enum
   MCI_MEASURE_OFFSETS,  /**< Start the ADCs Offset measurements procedure */
   /* Shouldn't we remove this command ? */
   MCI_ALIGN_ENCODER,    /**< Start the Encoder alignment procedure */
-  MCI_STOP              /**< Stop the Motor and the control */
+  MCI_STOP,             /**< Stop the Motor and the control */
+  MCI_COMMISSION,       /**< Identify the model of the predictive current controller */
+  MCI_SELECT_PROFILE,   /**< Apply a stored profile of parameters, see mc_profile.h */
+  MCI_DT_CALIBRATE,     /**< Calibrate the dead time compensation, see mc_dtcalib.h */
+  MCI_ADC_CALIBRATE,    /**< Tune the timing of the current sampling, see mc_adccalib.h */
+  MCI_SET_PWM_FREQ      /**< Change the PWM frequency, see mc_pwmfreq.h */
 } MCI_DirectCommands_t;
 
 typedef struct
@@ -134,8 +183,14 @@ typedef struct
                                    command.*/
   qd_t Iqdref;     /*!< Current component of last
                                    SetCurrentReferences command.*/
-  uint16_t hDurationms;       /*!< Duration in ms of last ExecSpeedRamp or
-                                   ExecTorqueRamp command.*/
+  uint16_t hDurationms;       /*!< Duration in ms of last ExecSpeedRamp,
+                                   ExecTorqueRamp or ExecPositionCommand
+                                   command.*/
+#ifdef M1_POSITION_CTRL
+  PosCtrl_Handle_t *pPosCtrl; /*!< Position controller object used by MCI.*/
+  float FinalPosition;        /*!< Final mechanical angle of last
+                                   ExecPositionCommand command, in rad.*/
+#endif
  MCI_DirectCommands_t DirectCommand;
  MCI_State_t State;
  uint16_t CurrentFaults;
@@ -143,6 +198,15 @@ typedef struct
  MCI_CommandState_t CommandState; /*!< The status of the buffered command.*/
  STC_Modality_t LastModalitySetByUser; /*!< The last STC_Modality_t set by the
                                              user. */
+#ifdef MCI_SETPOINT_STREAM
+ MCI_Stream_t Stream;                  /*!< Setpoint stream of the current references.*/
+#endif
+#ifdef MC_PROFILE_MODE
+ uint8_t bProfile;                     /*!< Profile of the last SelectProfile command.*/
+#endif
+#ifdef MC_PWMFREQ_MODE
+ uint32_t wPwmFrequency;               /*!< Frequency of the last SetPwmFrequency command, in Hz.*/
+#endif
 } MCI_Handle_t;
 
 /* Exported functions ------------------------------------------------------- */
@@ -157,10 +221,38 @@ void MCI_ExecTorqueRamp_F( MCI_Handle_t * pHandle, const float FinalTorque, uint
 void MCI_SetCurrentReferences( MCI_Handle_t * pHandle, qd_t Iqdref );
 void MCI_SetCurrentReferences_F( MCI_Handle_t * pHandle, qd_f_t Iqdref );
 
+#ifdef M1_POSITION_CTRL
+void MCI_ExecPositionCommand( MCI_Handle_t * pHandle, float FinalPosition, uint16_t hDurationms );
+float MCI_GetCurrentPosition( MCI_Handle_t * pHandle );
+PosCtrlStatus_t MCI_GetPositionCtrlStatus( MCI_Handle_t * pHandle );
+#endif
+
+#ifdef MCI_SETPOINT_STREAM
+void MCI_StartStream( MCI_Handle_t * pHandle );
+bool MCI_PushSetpoint( MCI_Handle_t * pHandle, uint16_t hTime, qd_t Iqdref );
+uint16_t MCI_GetStreamClock( MCI_Handle_t * pHandle );
+void MCI_ExecStream( MCI_Handle_t * pHandle );
+#endif
+
 void MCI_SetIdref( MCI_Handle_t * pHandle, int16_t hNewIdref );
 void MCI_SetIdref_F( MCI_Handle_t * pHandle, float NewIdRef );
 bool MCI_StartMotor( MCI_Handle_t * pHandle );
 bool MCI_StartOffsetMeasurments(MCI_Handle_t *pHandle);
+#ifdef MC_COMMISSION_MODE
+bool MCI_StartCommissioning(MCI_Handle_t *pHandle);
+#endif
+#ifdef MC_PROFILE_MODE
+bool MCI_SelectProfile(MCI_Handle_t *pHandle, uint8_t bProfile);
+#endif
+#ifdef MC_DTCALIB_MODE
+bool MCI_StartDeadTimeCalibration(MCI_Handle_t *pHandle);
+#endif
+#ifdef MC_ADCCALIB_MODE
+bool MCI_StartAdcCalibration(MCI_Handle_t *pHandle);
+#endif
+#ifdef MC_PWMFREQ_MODE
+bool MCI_SetPwmFrequency(MCI_Handle_t *pHandle, uint32_t wFrequency);
+#endif
 bool MCI_GetCalibratedOffsetsMotor(MCI_Handle_t* pHandle, PolarizationOffsets_t * PolarizationOffsets);
 bool MCI_SetCalibratedOffsetsMotor( MCI_Handle_t* pHandle, PolarizationOffsets_t * PolarizationOffsets);
 bool MCI_StopMotor( MCI_Handle_t * pHandle );
@@ -1,13 +1,81 @@
-/* mc_perf.h */
+/**
+  ******************************************************************************
+  * @file    mc_perf.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Execution time measurement
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_PERF_H
+#define MC_PERF_H
+
+#include "mc_type.h"
 
 typedef enum {
   MEASURE_TSK_HighFrequencyTask,
-  MEASURE_TSK_MediumFrequencyTaskM1
+  MEASURE_TSK_MediumFrequencyTaskM1,
+  MEASURE_FOC_ReadCurrents,     /* Phase currents reading */
+  MEASURE_FOC_Park,             /* Clarke and Park transforms */
+  MEASURE_FOC_Predict,          /* Current regulation: PI controllers or predictive search */
+  MEASURE_FOC_Write             /* Reverse Park transform and duty cycles update */
 //  Others functions to measure to be added here.
 }MC_PERF_FUNCTIONS_LIST_t;
 
 /* Define max number of traces according to the list defined in MC_PERF_FUNCTIONS_LIST_t */
-#define  MC_PERF_NB_TRACES  2
+#define  MC_PERF_NB_TRACES  6
+
+typedef enum {
+  JITTER_TSK_MediumFrequencyTaskM1,
+  JITTER_TSK_SafetyTask,
+  JITTER_TSK_HighFrequencyTask    /* Also counts an overrun at each restart of the PWM */
+//  Others scheduled tasks to measure to be added here, with their period in mc_perf.c.
+}MC_PERF_TASKS_LIST_t;
+
+/* Define max number of jitter traces according to the list defined in MC_PERF_TASKS_LIST_t */
+#define  MC_PERF_NB_JITTERS  3
+
+typedef enum {
+  LOAD_TSK_HighFrequencyTask,
+  LOAD_TSK_HighFrequencyDeferredTask,
+  LOAD_TSK_MediumFrequencyTaskM1,
+  LOAD_TSK_SafetyTask,
+  LOAD_MCP                        /* MCP requests processed by the main loop */
+//  Others tasks to measure to be added here. The idle time is what they leave, the
+//  interrupts not measured included.
+}MC_PERF_LOADS_LIST_t;
+
+/* Define max number of load traces according to the list defined in MC_PERF_LOADS_LIST_t */
+#define  MC_PERF_NB_LOADS  5
+
+/* Interrupt entries measured by MC_Perf_MeasureIrqEntry() */
+typedef enum {
+  IRQ_ENTRY_NO_FPU,               /* Preempting integer code */
+  IRQ_ENTRY_FPU_LAZY,             /* Preempting floating point code, lazy stacking */
+  IRQ_ENTRY_FPU_STACKED           /* Preempting floating point code, FPU registers stacked */
+}MC_PERF_IRQ_ENTRIES_LIST_t;
+
+#define  MC_PERF_NB_IRQ_ENTRIES  3
+
+/* CPU load of a whole CPU, the loads being in 0.01 % */
+#define  MC_PERF_LOAD_FULL  10000U
+
+/* Number of measures averaged by the mean, expressed as power of 2 */
+#define  MC_PERF_MEAN_WINDOW_LOG  8U
+
+/* Number of bins of the histograms. Each bin is 1/MC_PERF_HISTO_NB_BINS of the FOC
+   period wide, the last bin also counts the measures longer than the FOC period */
+#define  MC_PERF_HISTO_NB_BINS  16U
 
 /* DWT (Data Watchpoint and Trace) registers, only exists on ARM Cortex with a DWT unit */
 /* The DWT is usually implemented in Cortex-M3 or higher, but not on Cortex-M0(+) (ie not present on G0) */
@@ -17,12 +85,55 @@ typedef struct {
     uint32_t  DeltaTimeInCycle;
     uint32_t  min;
     uint32_t  max;
+    uint32_t  mean;                               /* Mean of the last complete window */
+    uint32_t  AccCycles;                          /* Sum of the measures of the current window */
+    uint16_t  NbMeasures;                         /* Number of measures in the current window */
+    uint16_t  Histogram[MC_PERF_HISTO_NB_BINS];   /* Saturated counts, foreground sections only */
 } Perf_Handle_t;
 
+typedef struct {
+    uint32_t  LastStart;                          /* Cycle counter at the last start of the task */
+    int32_t   min;                                /* Start to start time minus the task period, in CPU cycles */
+    int32_t   max;
+    uint16_t  NbOverruns;                         /* Starts later than two periods, saturated */
+    bool      Started;                            /* LastStart holds a start of the task */
+} Perf_Jitter_t;
+
+/* CPU load of a task: its own execution time, without the time of the tasks that
+   preempt it, over windows of MC_PERF_LOAD_WINDOW_MS */
+typedef struct {
+    uint32_t  StartMeasure;
+    uint32_t  NestedMark;                         /* LoadNestedCycles at the start of the task */
+    uint32_t  AccCycles;                          /* Execution time in the current window */
+    uint16_t  load;                               /* Load of the last complete window, in 0.01 % */
+    uint16_t  max;                                /* Highest load of the windows */
+} Perf_Load_t;
+
+/* Spread of the phase currents read at each FOC period, to compare the noise of the
+   current sensing configurations: at standstill with null references, the variance
+   is the noise power of the sensing network and of the ADC, in s16A digits squared */
+typedef struct {
+    int32_t   AccSample[2];                       /* Sums of Ia and Ib in the current window */
+    uint64_t  AccSquare[2];                       /* Sums of their squares */
+    int16_t   mean[2];                            /* Means of Ia and Ib of the last complete window */
+    uint32_t  variance[2];                        /* Variances of Ia and Ib of the last complete window */
+    uint16_t  NbSamples;                          /* Number of samples in the current window */
+} Perf_Noise_t;
+
 typedef struct {
     bool   BG_Task_OnGoing;
     uint32_t  AccHighFreqTasksCnt;
     Perf_Handle_t MC_Perf_TraceLog[MC_PERF_NB_TRACES];
+    Perf_Jitter_t MC_Perf_JitterLog[MC_PERF_NB_JITTERS];
+    uint16_t  NbFpuTasks;                         /* High frequency tasks that executed FPU instructions, saturated */
+    uint16_t  IrqEntryCycles[MC_PERF_NB_IRQ_ENTRIES]; /* From the pending of an interrupt to its handler */
+    volatile uint32_t  IrqEntryStamp;             /* Cycle counter read by FPU_IRQHandler() */
+    Perf_Noise_t  CurrentNoise;
+    Perf_Load_t   MC_Perf_LoadLog[MC_PERF_NB_LOADS];
+    uint32_t  LoadNestedCycles;                   /* Execution time of every task measured, wraps */
+    uint32_t  LoadWindowStart;
+    uint16_t  IdleLoad;                           /* CPU left by the tasks in the last window, in 0.01 % */
+    uint16_t  MinIdleLoad;
 } MC_Perf_Handle_t;
 
 void MC_Perf_Measure_Init  (MC_Perf_Handle_t * pHandle);
@@ -31,7 +142,17 @@ void MC_Perf_Measure_Start (MC_Perf_Handle_t * pHandle, uint8_t i);
 void MC_BG_Perf_Measure_Start (MC_Perf_Handle_t * pHandle, uint8_t i);
 void MC_Perf_Measure_Stop  (MC_Perf_Handle_t * pHandle, uint8_t i);
 void MC_BG_Perf_Measure_Stop  (MC_Perf_Handle_t * pHandle, uint8_t i);
+void MC_Perf_Task_Start (MC_Perf_Handle_t * pHandle, uint8_t i);
+void MC_Perf_CheckFpu (MC_Perf_Handle_t * pHandle);
+void MC_Perf_MeasureIrqEntry (MC_Perf_Handle_t * pHandle);
+void MC_Perf_CurrentNoise (MC_Perf_Handle_t * pHandle, ab_t Iab);
+void MC_Perf_Load_Start (MC_Perf_Handle_t * pHandle, uint8_t i);
+void MC_Perf_Load_Stop (MC_Perf_Handle_t * pHandle, uint8_t i);
+void MC_Perf_Load_Update (MC_Perf_Handle_t * pHandle);
 
 float MC_Perf_GetCPU_Load( MC_Perf_Handle_t * pHandle );
 float MC_Perf_GetMaxCPU_Load( MC_Perf_Handle_t * pHandle );
 float MC_Perf_GetMinCPU_Load( MC_Perf_Handle_t * pHandle );
+
+#endif /* MC_PERF_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
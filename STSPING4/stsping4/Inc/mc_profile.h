@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file    mc_profile.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Motor and controller parameter sets stored in flash
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_PROFILE_H
+#define MC_PROFILE_H
+
+#include "mc_type.h"
+#include "pcc.h"
+
+/* The profile store is built when MC_PROFILE_MODE is added to the preprocessor symbols
+   of the build configuration. Up to MC_PROFILE_NB_PROFILES sets of the run time
+   parameters of the drive are written in the flash page before the one of
+   mc_commission, that must be removed from the FLASH region of the linker script as
+   well, and one of them is selected:
+
+   - MC_REG_PROFILE_DATA returns the parameters in use, and stores a profile when it is
+     written with its index followed by the parameters;
+   - MC_REG_PROFILE_SEL returns the selected profile, and selects a stored one when it
+     is written. The selection is applied by the medium frequency task in the IDLE
+     state, with the PWM off, and kept for the next boots.
+
+   The parameters derived from the motor parameters at build time, such as the pole
+   pairs and the scaling of the measurements, remain the ones of the firmware. Without
+   any stored profile the drive runs with the parameters of the build. */
+
+#ifndef MC_PROFILE_NB_PROFILES
+#define MC_PROFILE_NB_PROFILES      8U
+#endif
+/* MC_Profile_GetSelected() before the first selection */
+#define MC_PROFILE_NONE             0xFFU
+
+/* Parameters of a profile, also the layout of MC_REG_PROFILE_DATA, in the units of the
+   components. The members of the components absent from the build are ignored. */
+typedef struct
+{
+  int16_t  hSpeedKp;                /* Speed PI */
+  int16_t  hSpeedKi;
+  int16_t  hIqKp;                   /* q current PI */
+  int16_t  hIqKi;
+  int16_t  hIdKp;                   /* d current PI */
+  int16_t  hIdKi;
+  uint16_t hSpeedKpDivPOW2;
+  uint16_t hSpeedKiDivPOW2;
+  uint16_t hIqKpDivPOW2;
+  uint16_t hIqKiDivPOW2;
+  uint16_t hIdKpDivPOW2;
+  uint16_t hIdKiDivPOW2;
+  int16_t  hPllC1;                  /* Gains of the PLL state observer */
+  int16_t  hPllC2;
+  int16_t  hPllKp;
+  int16_t  hPllKi;
+  int16_t  hCordicC1;               /* Gains of the CORDIC state observer */
+  int16_t  hCordicC2;
+  uint16_t hMaxSpeedUnit;           /* Speed limits of the application, in #SPEED_UNIT */
+  int16_t  hMinSpeedUnit;
+  uint16_t hMaxTorque;              /* q current limits, in digits */
+  int16_t  hMinTorque;
+  PCC_Tuning_t PCC;                 /* Model and tuning of the predictive current control */
+  float_t  fMpcMoveWeight;          /* Speed predictive control */
+  float_t  fMpcTorqueTerm;
+  uint8_t  bMpcHorizon;
+  uint8_t  bObserver;               /* EPLL or ECORDIC */
+  uint16_t hSpare;
+} MC_Profile_t;
+
+void MC_Profile_Init(void);
+void MC_Profile_Capture(MC_Profile_t *pProfile);
+bool MC_Profile_IsStored(uint8_t bIndex);
+bool MC_Profile_Store(uint8_t bIndex, const MC_Profile_t *pProfile);
+void MC_Profile_Select(uint8_t bIndex);
+uint8_t MC_Profile_GetSelected(void);
+
+#endif /* MC_PROFILE_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
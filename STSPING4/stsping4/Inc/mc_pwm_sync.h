@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    mc_pwm_sync.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Lock of the PWM carrier of the drive on an external sync event
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_PWM_SYNC_H
+#define MC_PWM_SYNC_H
+
+#include "mc_type.h"
+
+/* The carrier lock is built when MC_PWM_SYNC_MODE is added to the preprocessor symbols
+   of the build configuration. The sync event, common to all the drives of the machine,
+   is either the rising edge of the PWM_SYNC pin or the start of frame of the FDCAN
+   command frame, timestamped by the FDCAN. At each event, the phase of the carrier of
+   TIM1, the time elapsed since its last underflow, is compared to MC_PWM_SYNC_PHASE and
+   a PI regulator trims the auto reload of TIM1 by at most MC_PWM_SYNC_MAX_TRIM counts,
+   loaded at the next update event. The counter is never reset: the PWM, the ADC
+   triggers and the high frequency task of the drive follow the carrier without glitch.
+
+   Drives given phases evenly spread over the PWM period interleave their current
+   ripple on a shared DC bus. The period of the sync events must be MC_PWM_SYNC_RATIO
+   PWM periods, and with the FDCAN source the command frame must be the first frame of
+   the cycle, so that its start of frame is not delayed by the arbitration. */
+
+#define MC_PWM_SYNC_EXTI        0U    /* Rising edge of the PWM_SYNC pin */
+#define MC_PWM_SYNC_FDCAN       1U    /* Start of frame of the command frame of mc_fdcan */
+
+#ifndef MC_PWM_SYNC_SOURCE
+#define MC_PWM_SYNC_SOURCE      MC_PWM_SYNC_EXTI
+#endif
+
+/* Phase of the carrier at the sync event, in 1/65536 of the PWM period after the
+   underflow of TIM1 */
+#ifndef MC_PWM_SYNC_PHASE
+#define MC_PWM_SYNC_PHASE       0U
+#endif
+
+/* PWM periods between two sync events */
+#ifndef MC_PWM_SYNC_RATIO
+#define MC_PWM_SYNC_RATIO       20U
+#endif
+
+/* Largest change of the auto reload of TIM1, in timer counts */
+#define MC_PWM_SYNC_MAX_TRIM    8
+/* Phase error, in timer counts, and number of successive events within it for the lock */
+#define MC_PWM_SYNC_LOCK_WINDOW ((int32_t)PWM_PERIOD_CYCLES / 32)
+#define MC_PWM_SYNC_LOCK_EVENTS 16U
+
+void MC_PwmSync_Init(void);
+void MC_PwmSync_Event(uint32_t wElapsed);
+bool MC_PwmSync_IsLocked(void);
+int32_t MC_PwmSync_GetPhaseError(void);
+
+#endif /* MC_PWM_SYNC_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
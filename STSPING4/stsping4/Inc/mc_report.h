@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file    mc_report.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Registers pushed to the host when they change
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_REPORT_H
+#define MC_REPORT_H
+
+#include "mc_type.h"
+#include "mcpa.h"
+
+/* The report by exception is built when MC_REPORT_MODE is added to the preprocessor
+   symbols of the build configuration. Instead of polling registers that seldom change,
+   the host writes MC_REG_REPORT_CONFIG with up to MC_REPORT_NB_SUBS registers of 8, 16
+   or 32 bits, each with a deadband, and the interval of their reads:
+
+   - every hIntervalMs the main loop reads them, as GET_DATA_ELEMENT does. The registers
+     that moved by more than their deadband since they were last reported are sent in
+     one asynchronous packet: GLOBAL_TIMESTAMP on 32 bits, then the data ID on 16 bits
+     and the value of each one, then a null mark and the async ID MC_REPORT_ASYNC_ID,
+     where the MCPA datalog has 0. The deadband is in the units of the register, and
+     the change is taken as a signed value of its size;
+   - the first report after the configuration holds all the registers, and so does the
+     one that follows hHeartbeatMs without any report, unless it is 0;
+   - the packet is handed to the transport by the deferred high frequency task, the one
+     that fills the async buffers of the datalog, between two buffers of the datalog.
+     The registers are not read again while it is waiting.
+
+   A configuration with a null interval or no register stops the reports. */
+
+#define MC_REPORT_NB_SUBS           16U
+#define MC_REPORT_ASYNC_ID          1U
+
+/* Timestamp, data IDs and 32 bits values of all the registers, mark and async ID */
+#define MC_REPORT_MAX_BYTES         (4U + (MC_REPORT_NB_SUBS * 6U) + 2U)
+
+typedef struct
+{
+  uint16_t hDataID;
+  uint16_t hDeadband;               /* Largest change not reported, 0 for any change */
+} MC_Report_Sub_t;
+
+/* Layout of MC_REG_REPORT_CONFIG */
+typedef struct
+{
+  uint16_t hIntervalMs;             /* Period of the reads of the registers, 0 stops the
+                                       reports */
+  uint16_t hHeartbeatMs;            /* All registers reported after this time without
+                                       report, 0 for none */
+  uint8_t  bNbSubs;
+  uint8_t  bReserved[3];
+  MC_Report_Sub_t Subs[MC_REPORT_NB_SUBS];
+} MC_Report_Config_t;
+
+uint8_t MC_Report_Configure(const MC_Report_Config_t *pConfig, uint16_t hAsyncMaxPayload);
+const MC_Report_Config_t *MC_Report_GetConfig(void);
+
+/* Main loop, after the host requests */
+void MC_Report_Exec(void);
+
+/* Deferred high frequency task, after the datalog */
+void MC_Report_Send(MCPA_Handle_t *pMCPA);
+
+#endif /* MC_REPORT_H */
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
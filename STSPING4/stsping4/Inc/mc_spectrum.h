@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file    mc_spectrum.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Spectrum of the phase current, distortion and ripple monitoring
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_SPECTRUM_H
+#define MC_SPECTRUM_H
+
+#include "mc_type.h"
+#include "mc_ram_budget.h"
+
+/* The spectrum is built when MC_SPECTRUM_MODE is added to the preprocessor symbols of
+   the build configuration. The high frequency task keeps one phase a current out of
+   MC_SPECTRUM_DECIMATION in a buffer of MC_SPECTRUM_SIZE samples, then leaves it to the
+   main loop. There, MC_Spectrum_Process() removes the mean, applies a Hann window and
+   computes the spectrum with a fixed point FFT, then gives the buffer back to the high
+   frequency task. The high frequency task only pays for a copy per kept sample.
+
+   The fundamental is the largest bin above the mean. The distortion is the ratio of
+   the RMS of all the other bins to the one of the fundamental, so that the aperiodic
+   ripple of a finite control set controller counts as well as the harmonics: the
+   current above the Nyquist frequency of the decimated samples folds into the band
+   and is counted too. The MC_SPECTRUM_NB_PEAKS largest bins out of the fundamental
+   give the dominant ripple frequencies.
+
+   The distortion is read in MC_REG_SPECTRUM_THD, the whole result in
+   MC_REG_SPECTRUM_DATA. Both are the ones of the last buffer processed in RUN. */
+
+/* Samples of a spectrum, a power of two set by MC_SPECTRUM_SIZE_LOG, see mc_ram_budget.h */
+#define MC_SPECTRUM_SIZE        (1U << MC_SPECTRUM_SIZE_LOG)
+/* FOC periods per sample */
+#ifndef MC_SPECTRUM_DECIMATION
+#define MC_SPECTRUM_DECIMATION  2U
+#endif
+/* Bins on each side of the fundamental that are part of it, with the Hann window */
+#define MC_SPECTRUM_FUND_BINS   2U
+/* Ripple frequencies reported */
+#define MC_SPECTRUM_NB_PEAKS    3U
+
+typedef struct
+{
+  uint16_t hFreq_Hz;        /* Center frequency of the bin */
+  uint16_t hAmplitude;      /* Amplitude of the bin, in s16A */
+} MC_Spectrum_Peak_t;
+
+/* Layout of MC_REG_SPECTRUM_DATA */
+typedef struct
+{
+  MC_Spectrum_Peak_t Fundamental;
+  uint16_t hThd;            /* Distortion, in per mille of the fundamental */
+  uint16_t hCount;          /* Spectra processed since the power on, wraps around */
+  MC_Spectrum_Peak_t Peaks[MC_SPECTRUM_NB_PEAKS]; /* Largest first */
+} MC_Spectrum_Result_t;
+
+void MC_Spectrum_Sample(int16_t hIa, bool Running);
+void MC_Spectrum_Process(void);
+uint16_t MC_Spectrum_GetThd(void);
+void MC_Spectrum_GetResult(MC_Spectrum_Result_t *pResult);
+
+#endif /* MC_SPECTRUM_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
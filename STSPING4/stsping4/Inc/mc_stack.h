@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file    mc_stack.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   High-water mark of the main stack, by painting
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_STACK_H
+#define MC_STACK_H
+
+#include "mc_type.h"
+
+/* The stack monitor is built when MC_STACK_MODE is added to the preprocessor symbols
+   of the build configuration. The application has a single stack, the main stack, on
+   which the main loop and every interrupt run:
+
+   - at boot, before the first interrupt, the stack reserved by the linker script below
+     the stack pointer of main() is painted with MC_STACK_PAINT;
+   - the main loop scans it from its bottom up to the first word written since, and
+     keeps the deepest use, that only grows;
+   - the high frequency task keeps its deepest stack pointer at entry: the stack under
+     the ADC interrupt in the worst nesting of the lower priorities;
+   - MC_REG_STACK returns MC_Stack_Info_t. A high-water mark equal to the reserved size
+     is an overflow of the reservation, into the heap or the variables below it.
+
+   The reservation is _Min_Stack_Size below _estack in the linker script of
+   STM32CubeIDE, the CSTACK block with IAR. */
+
+/* Word of the painted stack */
+#define MC_STACK_PAINT          0xA5A5A5A5U
+
+/* Words kept under the stack pointer of the paint, for its own calls */
+#define MC_STACK_PAINT_MARGIN   16U
+
+/* Layout of MC_REG_STACK, in bytes */
+typedef struct
+{
+  uint32_t wReserved;               /* Stack reserved by the linker script */
+  uint32_t wHighWater;              /* Deepest use since the boot */
+  uint32_t wHFEntry;                /* Deepest use at the entry of the high frequency task */
+} MC_Stack_Info_t;
+
+/* Stack pointer at the deepest entry of the high frequency task */
+extern uint32_t wMCStackHFEntry;
+
+void MC_Stack_Paint(void);
+void MC_Stack_Scan(void);
+void MC_Stack_GetInfo(MC_Stack_Info_t *pInfo);
+
+/* To be called at the entry of the high frequency task */
+static inline void MC_Stack_MarkHF(void)
+{
+  uint32_t wSP = __get_MSP();
+
+  if (wSP < wMCStackHFEntry)
+  {
+    wMCStackHFEntry = wSP;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+#endif /* MC_STACK_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -29,11 +29,13 @@
 #define FULL_MISRA_C_COMPLIANCY_PID_REGULATOR
 #define FULL_MISRA_C_COMPLIANCY_PW_CURR_FDB_OVM
 #define FULL_MISRA_C_COMPLIANCY_SPD_TORQ_CTRL
+#define FULL_MISRA_C_COMPLIANCY_SPD_POS_FBK
 #define FULL_MISRA_C_COMPLIANCY_STO_PLL
 #define FULL_MISRA_C_COMPLIANCY_VIRT_SPD_SENS
 #define FULL_MISRA_C_COMPLIANCY_MC_MATH
 #define FULL_MISRA_C_COMPLIANCY_PFC
 #define FULL_MISRA_C_COMPLIANCY_PWM_CURR
+#define FULL_MISRA_C_COMPLIANCY_PCC
 #endif
 
 #ifdef NULL_PTR_CHECK
@@ -52,6 +54,15 @@
 #define NULL_PTR_CHECK_NTC_TEMP_SENS
 #define NULL_PTR_CHECK_OPEN_LOOP
 #define NULL_PTR_CHECK_PID_REG
+#define NULL_PTR_CHECK_PCC
+#define NULL_PTR_CHECK_PCC_EST
+#define NULL_PTR_CHECK_SPD_MPC
+#define NULL_PTR_CHECK_THERMAL_DERATING
+#define NULL_PTR_CHECK_LOSS_MINIMIZATION
+#define NULL_PTR_CHECK_HARMONIC_COMPENSATION
+#define NULL_PTR_CHECK_SIX_STEP_MODE
+#define NULL_PTR_CHECK_LOAD_TORQUE_OBS
+#define NULL_PTR_CHECK_SPEED_FILTER
 #define NULL_PTR_MOT_POW_MEAS
 #define NULL_PTR_POW_COM
 #define NULL_PTR_PWM_CUR_FDB_OVM
@@ -96,6 +107,8 @@
   #include "stm32g4xx_ll_comp.h"
   #include "stm32g4xx_ll_opamp.h"
   #include "stm32g4xx_ll_cordic.h"
+  #include "stm32g4xx_ll_fmac.h"
+  #include "mc_board.h"
 
 __STATIC_INLINE void LL_DMA_ClearFlag_TC(DMA_TypeDef *DMAx, uint32_t Channel)
 {
@@ -153,6 +166,37 @@ __STATIC_INLINE uint32_t LL_DMA_IsActiveFlag_HT(DMA_TypeDef *DMAx, uint32_t Chan
 /* #define _001HZ 100 */
 /** @} */
 
+/**
+ * @name Current controller backends
+ *
+ * Each of the following symbols defines a current controller backend of the FOC. They are
+ * used to set the #CURRENT_CONTROLLER macro.
+ *
+ * @anchor CurrentController
+ */
+/** @{ */
+/** Torque and flux PI controllers only. The predictive current controller is not built */
+#define CURR_CTRL_PI 0
+/** Predictive current controller above its engage speed, PI controllers below its
+    disengage speed */
+#define CURR_CTRL_PCC 1
+/** @} */
+
+/**
+ * @name Speed controller backends
+ *
+ * Each of the following symbols defines a speed controller backend. They are used to set
+ * the #SPEED_CONTROLLER macro.
+ *
+ * @anchor SpeedController
+ */
+/** @{ */
+/** Speed PI controller of the speed and torque controller */
+#define SPD_CTRL_PI 0
+/** Speed predictive controller on an estimated mechanical model, the speed PI follows it */
+#define SPD_CTRL_MPC 1
+/** @} */
+
 /* USER CODE BEGIN DEFINITIONS */
 /* Definitions placed here will not be erased by code generation */
 /**
@@ -170,6 +214,419 @@ __STATIC_INLINE uint32_t LL_DMA_IsActiveFlag_HT(DMA_TypeDef *DMAx, uint32_t Chan
  */
 #define SPEED_UNIT U_01HZ
 
+/**
+ * @brief Current controller backend of the FOC
+ *
+ * Either #CURR_CTRL_PI, the torque and flux PI controllers only, or #CURR_CTRL_PCC, the
+ * predictive current controller above #PCC_ENGAGE_SPEED_RPM and the PI controllers below
+ * #PCC_DISENGAGE_SPEED_RPM. The backend is selected at build time: the high frequency task
+ * calls it without any dispatch and the code of the other backend is not built.
+ *
+ * @note This symbol should be set to one of the symbols predefined for that purpose. See
+ *       @ref CurrentController for more details.
+ */
+#define CURRENT_CONTROLLER CURR_CTRL_PCC
+
+/**
+ * @brief Speed controller backend of the speed mode
+ *
+ * Either #SPD_CTRL_PI, the speed PI controller, or #SPD_CTRL_MPC, the predictive controller
+ * that holds the q current reference minimizing the tracking error of the speed ramp over
+ * #SPEED_MPC_HORIZON medium frequency periods, on a model whose inertia, friction and load
+ * are estimated online. The integral term of the speed PI follows the predictive controller,
+ * so that the PI does not wind up while its output is not applied.
+ *
+ * @note This symbol should be set to one of the symbols predefined for that purpose. See
+ *       @ref SpeedController for more details.
+ */
+#define SPEED_CONTROLLER SPD_CTRL_PI
+
+/**
+ * @brief Candidate search of the predictive current controller
+ *
+ * Either #PCC_SECTOR_SEARCH, that evaluates only the vectors adjacent to the deadbeat voltage,
+ * or #PCC_FULL_SEARCH, the reference search over every inverter vector.
+ */
+#define PCC_SEARCH_MODE PCC_SECTOR_SEARCH
+
+/**
+ * @brief Prediction horizon of the predictive current controller, in FOC periods
+ *
+ * 1, 2 or 3. A horizon of 2 or 3 is opt-in: it lowers the current ripple of low inductance
+ * motors at the same switching frequency, at the cost of a longer FOC; the number of nodes
+ * evaluated per period is then capped by #PCC_NODE_BUDGET.
+ */
+#define PCC_HORIZON 1U
+
+/**
+ * @brief Output of the predictive current controller
+ *
+ * Either #PCC_FINITE_SET, one inverter vector per FOC period, #PCC_MODULATED, two active
+ * vectors and the zero vector with dwell times, applied by the space vector modulation, or
+ * #PCC_DEADBEAT, the voltage solved in closed form from the model, applied by the space
+ * vector modulation without any search. #PCC_MODULATED and #PCC_DEADBEAT require a
+ * #PCC_HORIZON of 1.
+ */
+#define PCC_OUTPUT_MODE PCC_DEADBEAT
+
+/**
+ * @brief Norm of the cost of the candidates of #PCC_FINITE_SET
+ *
+ * Either #PCC_COST_L2_WIDE, the weighted squared errors with 64 bit products, #PCC_COST_L2_SAT,
+ * the same cost with 32 bit products on errors saturated to #PCC_COST_SAT_ERROR,
+ * #PCC_COST_L2_PACKED, the saturated cost with the q and d components in the halves of one
+ * register and the dual 16-bit multiplies of the Cortex-M4, #PCC_COST_L2_FLOAT, the cost of
+ * #PCC_COST_L2_WIDE in single precision on the FPU, or #PCC_COST_L1, the weighted
+ * absolute errors. With #PCC_COST_L1 the switching and the
+ * barrier costs are in current digits instead of squared digits.
+ */
+#define PCC_COST_NORM PCC_COST_L2_WIDE
+
+/**
+ * @brief Quantities tracked by the cost of the candidates
+ *
+ * Either #PCC_OBJECTIVE_CURRENT, the q and d current errors, or #PCC_OBJECTIVE_TORQUE, the
+ * errors of the torque and of the squared stator flux predicted from the currents, the
+ * predictive torque control. #PCC_OBJECTIVE_TORQUE requires #PCC_FINITE_SET, #PCC_FULL_SEARCH
+ * and #PCC_COST_L2_WIDE; with #PCC_SHARED_MODEL the magnet flux follows the observer.
+ */
+#define PCC_COST_OBJECTIVE PCC_OBJECTIVE_CURRENT
+
+/**
+ * @brief Applies the dwell times of #PCC_MODULATED up to the vertices of the hexagon
+ *
+ * The predictor then reaches 2/sqrt(3) of the full scale of PWMC_SetPhaseVoltage() in the
+ * direction of the vectors, as the overmodulation, instead of the circle limitation. The
+ * PWM_Handle_M1 of mc_config.c samples the currents with the _OVM functions.
+ */
+/* #define PCC_FULL_HEXAGON */
+
+/**
+ * @brief Zero order hold model of the predictive current controller
+ *
+ * The decay, input and back-EMF coefficients are the exact discretisation of the motor over
+ * one FOC period, and the rotation of the frame follows the angle covered in the period,
+ * instead of the forward Euler model. To be enabled where the angle covered in one FOC
+ * period is large, at low PWM frequencies or high electrical speeds.
+ */
+/* #define PCC_EXACT_DISCRETISATION */
+
+/**
+ * @brief Adaptive decision period of the predictive current controller in #PCC_FINITE_SET
+ *
+ * Below #PCC_PERIOD_SPEED_BAND1_RPM and #PCC_PERIOD_SPEED_BAND2_RPM the vector is decided every
+ * 2 and 4 FOC periods and held in between, with the model of the longer period. The FOC period
+ * and the PWM frequency do not change. Requires #PCC_MODEL_ESTIMATION to be disabled.
+ */
+/* #define PCC_ADAPTIVE_PERIOD */
+
+/**
+ * @brief Blended handover between the PI controllers and the predictive current controller
+ *
+ * After a handover both controllers run for #TRANSITION_DURATION and the voltage moves
+ * linearly from the one of the controller left to the one of the controller engaged. The
+ * controller is also selected in SWITCH_OVER: above #PCC_ENGAGE_SPEED_RPM the predictor is
+ * blended in over the same ramp as the observer angle and the q current reference. Requires
+ * #PCC_MODULATED without #PCC_FULL_HEXAGON, or #PCC_DEADBEAT.
+ */
+/* #define PCC_BLENDED_HANDOVER */
+
+/**
+ * @brief Open loop predictive start-up
+ *
+ * In START the predictive current controller regulates the currents of the rev-up on the angle
+ * of the virtual speed sensor instead of the PI controllers, within the current constraint of
+ * #PCC_MAX_CURRENT_PC: the torque ramps of the rev-up phases can then be shortened without the
+ * overcurrent trips of the PI controllers lagging the forced angle. The predictor keeps the
+ * regulation through SWITCH_OVER, RUN then selects the controller from the speed as usual.
+ */
+/* #define PCC_OPEN_LOOP_START */
+
+/**
+ * @brief Table of the q/d voltages of the vectors of the predictive current controller
+ *
+ * The q/d voltage of the optimal vector is read from a flash table of #PCC_DQ_TABLE_SIZE
+ * electrical angles instead of being rotated at every period: 6 KB of flash for the
+ * multiplies of the rotation, meant for the boards without CORDIC. Requires #PCC_FINITE_SET.
+ */
+/* #define PCC_DQ_VECTOR_TABLE */
+
+/**
+ * @brief Back-EMF of the predictive current controller from the STO_PLL observer model
+ *
+ * The predictor takes the back-EMF current step of the state observer, the hC3 term of its
+ * model, instead of evaluating its own from wKBemf and the speed, so that both models stay
+ * consistent when the observer gains change. The wKBemf term is kept while the CORDIC
+ * observer runs.
+ */
+/* #define PCC_SHARED_MODEL */
+
+/**
+ * @brief Cycle-by-cycle current limit events in the predictive current controller
+ *
+ * The periods where the comparator current limit of MC_CBC_LIMIT_MODE, on the boards having
+ * it, cut the PWM are given to the predictor: they do not update its disturbance observer and
+ * the next decision weights the current barrier 2^#PCC_LIMIT_EVENT_SHIFT times more. They
+ * are counted in the statistics of #MC_REG_PCC_STATS.
+ */
+/* #define PCC_LIMIT_EVENTS */
+
+/**
+ * @brief Split-phase prediction of the predictive current controller
+ *
+ * The update interrupt of TIM1, FOC_CurrPrepareM1(), computes the terms of the next
+ * prediction that do not depend on the measured currents while they are converted: the
+ * rotation of the period, the back-EMF and the applied voltage steps and, with
+ * #PCC_FINITE_SET, the polarity of the predicted currents that sets the voltage errors of
+ * the vectors. The high frequency task then only applies the measurement and the search.
+ */
+/* #define PCC_SPLIT_PHASE */
+
+/**
+ * @brief Filtered current state of the predictive current controller
+ *
+ * The prediction starts from a fixed gain Kalman estimate of the currents, the prediction of
+ * the previous period corrected by #PCC_STATE_FILTER_GAIN of its error, instead of the
+ * measured currents, so that the noise of one sample does not flip the optimal vector.
+ */
+/* #define PCC_STATE_FILTER */
+
+/**
+ * @brief Overvoltage aware braking of the predictive current controller
+ *
+ * From #PCC_VBUS_START_V to the overvoltage threshold, a braking reference gets a d current
+ * rising up to #PCC_BRAKE_ID_PC, to dissipate the power, and the regenerative power
+ * predicted for each candidate vector is weighted by #PCC_REGEN_WEIGHT in the cost, so that
+ * the search limits the braking before MC_OVER_VOLT trips.
+ */
+/* #define PCC_VBUS_LIMIT */
+
+/**
+ * @brief Inductance saturation table of the predictive current controller
+ *
+ * The current steps of the predictor are scaled, each control period, by the ratio of the
+ * inductance of the model to the one at the measured q current, interpolated in a table of
+ * PCC_LSAT_POINTS points. The default table lowers the inductance by #PCC_LSAT_DROP_PC from
+ * #PCC_LSAT_KNEE_PC; MC_COMMISSION_MODE measures it.
+ */
+/* #define PCC_INDUCTANCE_TABLE */
+
+/**
+ * @brief Enables the online estimation of the predictive current controller model
+ *
+ * The resistance, inductance and flux terms are estimated by the medium frequency task in
+ * RUN state, with the motor temperature as prior of the resistance, and the wKDecay, wKVolt
+ * and wKBemf coefficients are updated every #PCC_EST_UPDATE_PERIOD_MS. While enabled, the
+ * estimator overwrites the coefficients written with #MC_REG_PCC_TUNING.
+ */
+#define PCC_MODEL_ESTIMATION
+
+/**
+ * @brief Sensored position feedback of Motor 1 with a quadrature encoder
+ *
+ * The encoder angle is valid from standstill, once the rotor has been aligned on it by the
+ * first start: the loop is closed without rev-up and the predictive current controller runs
+ * from zero speed. The observer runs alongside it and replaces it above
+ * #SENSORLESS_SWITCH_SPEED_RPM, once it tracks the encoder speed. The encoder inputs are the
+ * channels 1 and 2 of TIM4, on PB6 and PB7.
+ */
+/* #define M1_ENCODER_SENSOR */
+
+/**
+ * @brief Position control of Motor 1 on the encoder of #M1_ENCODER_SENSOR
+ *
+ * MC_ProgramPositionCommandMotor1() moves the rotor to a mechanical angle along a jerk
+ * limited trajectory. The trajectory and the position PID run at
+ * #POSITION_LOOP_FREQUENCY_HZ, a task of the scheduler of their own, and drive the q
+ * current reference in torque mode. Speed and torque commands still work and stop the
+ * position regulation.
+ */
+/* #define M1_POSITION_CTRL */
+
+/**
+ * @brief Sensorless low speed position feedback of Motor 1 with high frequency injection
+ *
+ * A square wave carrier on the d voltage makes the angle of a salient motor, Ld smaller than
+ * Lq, visible down to standstill. The polarity of the magnet is detected at start with two
+ * d current pulses, then the loop is closed without rev-up. The observer replaces the
+ * injection above #SENSORLESS_SWITCH_SPEED_RPM, where the predictive current controller may
+ * engage: the carrier only rides on the PI controllers. Not with #M1_ENCODER_SENSOR, and not
+ * with the motor of pmsm_motor_parameters.h, whose LD_LQ_RATIO is 1.
+ */
+/* #define M1_HFI_SENSOR */
+
+/**
+ * @brief Enables the thermal derating of the current limit
+ *
+ * The temperatures of the power switches and of the windings are estimated by the medium
+ * frequency task from the NTC heat sink temperature and the mean squared current. Within
+ * #TDR_BAND_C of their largest values the current limit of the flux weakening component goes
+ * down to the current that holds them there, and the over temperature fault is only the
+ * last protection.
+ */
+#define THERMAL_DERATING
+
+/**
+ * @brief Enables the online search of the d current of least loss at light load
+ *
+ * Below #LMN_LIGHT_LOAD_PC of the nominal current and from #LMN_MIN_SPEED_RPM, the medium
+ * frequency task moves the d current reference by steps of #LMN_ID_STEP_PC and keeps the
+ * direction that lowers the electrical power measured by the PQD windows.
+ */
+/* #define LOSS_MINIMIZATION */
+
+/**
+ * @brief Enables the compensation of the back-EMF harmonics and of the cogging torque
+ *
+ * A table of 256 entries, by electrical angle, gives the voltage of the back-EMF harmonics
+ * at #HCM_LEARN_SPEED_RPM, scaled by the speed, and the current of the cogging torque. The
+ * high frequency task adds them to the PI controllers and to the predictor, at the cost of
+ * one entry per period. The table is learned at steady speed on #MC_REG_HCM_STATE.
+ */
+/* #define HARMONIC_COMPENSATION */
+
+/**
+ * @brief Enables the six-step operation at the top of the speed range
+ *
+ * Once the voltage requested by the current controller stays on its limit above
+ * #SIX_STEP_MIN_SPEED_RPM, the inverter holds the vertex of the hexagon nearest to the request
+ * over whole PWM periods: the legs only commute six times per electrical revolution, and the
+ * predictor leaves the regulation to the PI controllers. The PWM_Handle_M1 of mc_config.c
+ * samples the currents with the _OVM functions. The entries are read in
+ * #MC_REG_SIX_STEP_ENTRIES.
+ */
+/* #define SIX_STEP_MODE */
+
+/**
+ * @brief Enables the load torque observer of the speed loop
+ *
+ * Once per speed loop period, the load torque is estimated from the q current executed and
+ * the measured speed, with the inertia #LOAD_OBS_INERTIA_KGM2, and fed forward to the output
+ * of the speed PI in speed mode: the current controller applies it within one PWM period and
+ * the speed dips less on a load step. It requires #SPD_CTRL_PI. The estimate is read in
+ * #MC_REG_LOAD_TORQUE.
+ */
+/* #define LOAD_TORQUE_OBSERVER */
+
+/**
+ * @brief Enables the filter bank of the speed loop
+ *
+ * In speed mode, the torque reference goes through a cascade of biquads once per speed loop
+ * period: a notch at #SPEED_FILTER_NOTCH_HZ and a low-pass at #SPEED_FILTER_LOW_PASS_HZ, so
+ * that the gains of the speed loop are not limited by the resonances of the mechanics. Any
+ * cascade of up to four biquads, in Q14, is read and written in #MC_REG_SPEED_FILTER.
+ */
+/* #define SPEED_FILTER_BANK */
+
+/**
+ * @brief Refresh of the bootstrap capacitors of the high side drivers
+ *
+ * A phase whose high side stays on over whole periods, at the vertices of the dwell times of
+ * #PCC_FULL_HEXAGON or in #SIX_STEP_MODE, discharges its bootstrap capacitor. After
+ * #BOOT_REFRESH_MAX_HIGH_US of them, PWMC_SetDwellTimes() lowers the three phases for one
+ * period so that its low side is on for #BOOT_REFRESH_LOW_NS: the phase to phase voltages are
+ * kept as far as the lowest phase allows, and no speed or torque derating is needed. The
+ * switching states of #PCC_FINITE_SET leave a low side window every period and need no refresh.
+ */
+#define PWMC_BOOT_REFRESH
+
+/**
+ * @brief Updates the PWM and samples the currents at both the underflow and the overflow
+ *
+ * The repetition counter of TIM1 is cleared so that the compare values are loaded every half
+ * period, and the update event triggers the injected conversions: the high frequency task, and
+ * the finite-set controller of #PCC_FINITE_SET with it, runs twice per carrier period.
+ * TF_REGULATION_RATE is doubled and the switching frequency is unchanged. The combined 3-phase
+ * PWM of TIM1 CH5 turns the low sides on for #PWM_VALLEY_CNT around the underflow, the second
+ * sampling window; the compare values are shifted by it and clamped so that the window in the
+ * middle of the period is kept, which costs the modulation twice the window. G4 three shunt
+ * reading only, R3_2 driver.
+ */
+/* #define PWM_DOUBLE_UPDATE */
+
+/**
+ * @brief Computes the current and speed PI regulators with the FMAC
+ *
+ * PI_Controller() calls PI_FMAC_Controller() for the Iq, Id and speed regulators of
+ * mc_config.c, whose FMACEnable is set: the incremental form of the regulator is an IIR
+ * filter of the FMAC, in the PI path of FOC_CurrControllerM1() and in
+ * STC_CalcTorqueReference(). The integral term has the 16 bit resolution of the output, see
+ * pid_fmac_g4xx.c. The other regulators stay in software. G4 only.
+ */
+/* #define PID_FMAC */
+
+/**
+ * @brief Enables the inrush current limiter of the bus capacitors
+ *
+ * At power up the bus capacitors charge through the limiting resistor, the state machine
+ * waits in ICLWAIT and the under voltage fault is not raised. The medium frequency task
+ * predicts, from the decay of the rise of the bus voltage, the rise still expected, and
+ * bypasses the resistor with the M1_ICL_SHUT_OUT output as soon as it is below
+ * #INRUSH_CURRLIMIT_SETTLE_V. The commands are taken once the bypass relay has switched,
+ * after #INRUSH_CURRLIMIT_CHANGE_AFTER_MS.
+ */
+/* #define M1_ICL_ENABLED */
+
+/**
+ * @brief Measures the current offsets at the end of the boot
+ *
+ * The offset calibration is otherwise run by the first start, before the charge of the
+ * bootstrap capacitors. A start requested while it runs continues with the charge once
+ * it is done. Not used with #MC_OFFSETS_IN_FLASH, whose stored offsets are loaded by the
+ * first start.
+ */
+#define MC_BOOT_OFFSET_CALIB
+
+/**
+ * @brief Streaming of timestamped current references to Motor 1
+ *
+ * MC_PushSetpointMotor1() queues q and d current references, each with the time at which it
+ * is to be reached, in a FIFO of #MCI_STREAM_DEPTH entries that needs no lock. Once
+ * MC_StartSetpointStreamMotor1() is executed, the high frequency task interpolates the
+ * current references between the setpoints every FOC period, in RUN state, so that a
+ * trajectory generator streams them at several kHz without going through the buffered
+ * command of the medium frequency task. Any other command ends the stream.
+ */
+/* #define MCI_SETPOINT_STREAM */
+
+/**
+ * @brief Enables the measurement of the execution time of the high frequency task
+ *
+ * The DWT cycle counter times the whole task and the reading, Park, regulation and writing
+ * sections of the FOC. The results are read with #MC_REG_PERF_TRACE and #MC_REG_PERF_STATS.
+ * The measurement adds a few tens of cycles per section to the task. It is a debug switch, to
+ * be defined while profiling and left undefined in a production build.
+ */
+/* #define DBG_MCU_LOAD_MEASURE */
+
+/**
+ * @brief Calls the static inline variants of the mc_math transformations in the current loop
+ *
+ * FOC_CurrControllerM1() and PCC_CalcVoltage() then call MCM_xxx_Inline() instead of the
+ * __weak MCM_xxx() functions, and the compiler can fuse them into the loop. An override of
+ * the __weak functions is not seen by these callers. See #MCM_CALL.
+ *
+ * Off in the Debug configuration, to keep the transformations steppable in the debugger;
+ * the Release configuration (STM32CubeIDE/Release/makefile) defines it.
+ */
+/* #define MC_MATH_INLINE */
+
+/**
+ * @brief Selects the output of the debug trace points of the high frequency task
+ *
+ * MC_TRACE_OFF compiles them out, MC_TRACE_GPIO drives each of them on its pin with a single
+ * BSRR store and MC_TRACE_ITM writes it, and the start and stop of the code sections timed by
+ * #DBG_MCU_LOAD_MEASURE, on the ITM stimulus ports read over SWO. MC_TRACE_ITM also writes
+ * the entry and exit of the motor control interrupts, the output chosen by the current
+ * controller with its switching state, and the faults. See mc_trace.h.
+ */
+#define MC_TRACE_OUTPUT MC_TRACE_OFF
+
+/**
+ * @brief Enables the update of the debug DAC outputs after every FOC period
+ */
+/* #define DBG_DAC_OUTPUT */
+
 /* USER CODE END DEFINITIONS */
 
 #define RPM_2_SPEED_UNIT(rpm)   ((int16_t)(((rpm)*SPEED_UNIT)/U_RPM)) /*!< Convenient macro to convert user friendly RPM into SpeedUnit used by MC API */
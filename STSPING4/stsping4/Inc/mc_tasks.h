@@ -42,20 +42,48 @@ void MC_RunMotorControlTasks(void);
 
 /* Executes the Medium Frequency Task functions for each drive instance */
 void MC_Scheduler(void);
+/* Processes the MCP requests of the host, from the main loop */
+void MC_ProcessHostRequests(void);
 
 /* Executes safety checks (e.g. bus voltage and temperature) for all drive instances */
 void TSK_SafetyTask(void);
 /* Executes the Motor Control duties that require a high frequency rate and a precise timing */
 uint8_t TSK_HighFrequencyTask(void);
+/* Executes the high frequency duties that do not require a precise timing */
+void TSK_HighFrequencyDeferredTask(void);
 void UI_HandleStartStopButton_cb (void);
 /* Reserves FOC execution on ADC ISR half a PWM period in advance */
 void TSK_DualDriveFIFOUpdate(uint8_t Motor);
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_SPLIT_PHASE)
+/* Prepares the next prediction of the predictive current controller, from the update
+   interrupt of the PWM timer */
+void FOC_CurrPrepareM1(void);
+#endif
 
 /* Puts the Motor Control subsystem in in safety conditions on a Hard Fault */
 void TSK_HardwareFaultTask(void);
 
  /* Locks GPIO pins used for Motor Control to prevent accidental reconfiguration */
 void mc_lock_pins (void);
+
+/* Returns the time from the power on at which Motor 1 was first ready to start, in ms */
+uint16_t TSK_GetReadyTimeM1(void);
+
+/* Returns the time from the last start command of Motor 1 to the RUN state, in ms */
+uint16_t TSK_GetStartUpTimeM1(void);
+
+#ifdef MC_LOW_POWER_IDLE
+/* Returns true while Motor 1 is stopped in IDLE with no command pending. Built when
+   MC_LOW_POWER_IDLE is added to the preprocessor symbols of the build configuration:
+   the main loop then sleeps with WFI until the next interrupt, the SysTick of the
+   medium frequency task or the reception of a host or FDCAN frame */
+bool TSK_IsLowPowerIdle(void);
+#endif
+
+/* Selects the state observer, EPLL or ECORDIC, used from the next start of Motor 1 */
+bool TSK_SetObserverM1(uint8_t bObserver);
+/* Returns the state observer selected for Motor 1 */
+uint8_t TSK_GetObserverM1(void);
 /**
   * @}
   */
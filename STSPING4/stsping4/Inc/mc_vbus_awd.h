@@ -0,0 +1,49 @@
+/**
+  ******************************************************************************
+  * @file    mc_vbus_awd.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Overvoltage protection by the analog watchdog of the bus voltage ADC
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MC_VBUS_AWD_H
+#define MC_VBUS_AWD_H
+
+#include "mc_type.h"
+#include "r_divider_bus_voltage_sensor.h"
+
+/* The watchdog of the bus voltage is built when MC_VBUS_AWD_MODE is added to the
+   preprocessor symbols of the build configuration. The analog watchdog 1 of the ADC of the
+   bus voltage monitors its regular conversion, against OverVoltageThreshold of the sensor:
+
+   - while the PWM is on the regular scan is started by the high frequency task at every
+     period, right after the currents are read, instead of once per SysTick: the bus
+     voltage is converted at the PWM rate;
+   - the watchdog interrupt, shared with the current sensing, generates a break of TIM1 by
+     software on the first conversion above the threshold. The outputs go to their idle
+     state at once, those of ON_OVER_VOLTAGE, and the break handler raises MC_OVER_VOLT
+     for the safety task as the hardware protection does;
+   - the interrupt is then disabled. MC_VbusAwd_Supervise(), called by the safety task with
+     the averaged bus voltage, enables it again once that voltage is back below the
+     threshold. The software check of RVBS_CalcAvVbus is kept, as the slow supervisor.
+
+   While the PWM is off the regular scan stays at the SysTick rate. */
+
+void MC_VbusAwd_Init(const RDivider_Handle_t *pHandle);
+void MC_VbusAwd_IRQHandler(void);
+void MC_VbusAwd_Supervise(uint16_t hAvBusVoltage_d);
+uint16_t MC_VbusAwd_GetTrips(void);
+
+#endif /* MC_VBUS_AWD_H */
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
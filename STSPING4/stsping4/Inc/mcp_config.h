@@ -36,8 +36,6 @@
 #define MCP_RX_IRQHandler_A DMA1_Channel2_IRQHandler
 #define MCP_USER_CALLBACK_MAX 2
 
-#define MCPA_OVER_UARTA_STREAM 10
-
 extern ASPEP_Handle_t aspepOverUartA;
 extern MCP_Handle_t MCP_Over_UartA;
 extern MCPA_Handle_t MCPA_UART_A;
@@ -34,6 +34,15 @@
                                                          by HW if low side signals
                                                          are not used */
 
+/*********** Bootstrap refresh, PWMC_BOOT_REFRESH *********/
+#define BOOT_REFRESH_MAX_HIGH_US      1000 /*!< Longest time a high side
+                                                         stays on without its low
+                                                         side */
+#define BOOT_REFRESH_LOW_NS           500 /*!< Low side on time that
+                                                         recharges a bootstrap
+                                                         capacitor, past the dead
+                                                         time */
+
 /*********** Bus voltage sensing section ****************/
 #define VBUS_PARTITIONING_FACTOR      0.0398 /*!< It expresses how
                                                        much the Vbus is attenuated
@@ -42,6 +51,11 @@
 #define NOMINAL_BUS_VOLTAGE_V         24
 /******** Current reading parameters section ******/
 /*** Topology ***/
+/* SINGLE_SHUNT instead, for a board with the only shunt in the DC link: the
+   R1_G4XX_pwm_curr_fdbk component reads the currents.
+   ICS_SENSORS instead, for isolated current sensors on phases A and B: the
+   ICS_G4XX_pwm_curr_fdbk component samples them simultaneously with ADC1 and
+   ADC2, RSHUNT is then 1 and AMPLIFICATION_GAIN the gain of the sensors in V/A */
 #define THREE_SHUNT_INDEPENDENT_RESOURCES
 
 #define RSHUNT                        0.01000
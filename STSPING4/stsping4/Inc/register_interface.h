@@ -74,6 +74,18 @@
 #define  MC_REG_SC_COMPLETED           ((20 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT )
 #define  MC_REG_POSITION_CTRL_STATE    ((21 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT )
 #define  MC_REG_POSITION_ALIGN_STATE   ((22 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT )
+#define  MC_REG_PERF_TRACE             ((23 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Code section read by MC_REG_PERF_STATS */
+#define  MC_REG_OBSERVER_SEL           ((24 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* EPLL or ECORDIC, applied at the next start */
+#define  MC_REG_CAPTURE_STATE          ((25 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Capture state, or MC_CAPTURE_CMD_xxx when written */
+#define  MC_REG_PROFILE_SEL            ((26 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Selected profile, or profile to apply in IDLE when written */
+#define  MC_REG_RECORD_STATE           ((27 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Record state, or MC_RECORD_CMD_xxx when written */
+#define  MC_REG_PIL_STATE              ((28 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Processor in the loop state, or MC_PIL_CMD_xxx in IDLE when written */
+#define  MC_REG_FAULTLOG_COUNT         ((29 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Entries of the fault log stored in flash, saturated to 255 */
+#define  MC_REG_HCM_STATE              ((30 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Harmonic compensation state, or HCM_CMD_xxx when written */
+#define  MC_REG_FRA_STATE              ((31 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Frequency response analysis state, or MC_FRA_CMD_xxx when written */
+#define  MC_REG_ABTEST_STATE           ((32 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* A/B experiment state, or MC_ABTEST_CMD_xxx when written */
+#define  MC_REG_WARMBOOT               ((33 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Kind of the last boot, MC_WarmBoot_Kind_t */
+#define  MC_REG_ASPEP_SYNC_DEPTH       ((34 << ELT_IDENTIFIER_POS) | TYPE_DATA_8BIT ) /* Requests the host may send before the first answer, ASPEP_SYNC_NB_BUFFERS */
 
 /* TYPE_DATA_16BIT registers definition */
 #define  MC_REG_SPEED_KP               ((2U   << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
@@ -174,6 +186,29 @@
 #define  MC_REG_FLUXWK_KI_DIV          ((102 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
 #define  MC_REG_STARTUP_CURRENT_REF    ((105 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
 #define  MC_REG_PULSE_VALUE            ((106 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
+#define  MC_REG_PCC_SW_WEIGHT          ((107 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
+#define  MC_REG_PCC_DECISION           ((108 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
+#define  MC_REG_PCC_COST               ((109 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
+#define  MC_REG_PCC_I_Q_PRED           ((110 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
+#define  MC_REG_PCC_I_D_PRED           ((111 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
+#define  MC_REG_PCC_FALLBACKS          ((112 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT )
+#define  MC_REG_CAPTURE_INDEX          ((113 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Next sample read by MC_REG_CAPTURE_DATA */
+#define  MC_REG_MOTOR_COPPER_LOSS      ((114 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* W */
+#define  MC_REG_MOTOR_EFFICIENCY       ((115 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Per mille */
+#define  MC_REG_THERMAL_HEADROOM       ((116 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Celsius */
+#define  MC_REG_THERMAL_CURR_LIMIT     ((117 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* s16A */
+#define  MC_REG_WINDING_TEMP           ((118 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Celsius */
+#define  MC_REG_READY_TIME             ((119 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* ms from power on, 0 while not ready */
+#define  MC_REG_STARTUP_TIME           ((120 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* ms from the start command to RUN, last start */
+#define  MC_REG_RECORD_INDEX           ((121 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Next frame read by MC_REG_RECORD_DATA */
+#define  MC_REG_PIL_STEP_RATE          ((122 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* FOC periods per processor in the loop step */
+#define  MC_REG_FAULTLOG_INDEX         ((123 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Entry read by MC_REG_FAULTLOG_DATA, 0 for the newest */
+#define  MC_REG_LMN_ID_OFFSET          ((124 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* s16A, d current offset of LOSS_MINIMIZATION */
+#define  MC_REG_FRA_INDEX              ((125 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Next point read by MC_REG_FRA_DATA */
+#define  MC_REG_SPECTRUM_THD           ((126 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Per mille, distortion of the phase current */
+#define  MC_REG_SIX_STEP_ENTRIES       ((127 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Entries of SIX_STEP_MODE, wraps around */
+#define  MC_REG_PCC_RESIDUAL_EVENTS    ((128 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* Fallbacks to the PI started by the residual of the predictions */
+#define  MC_REG_LOAD_TORQUE            ((129 << ELT_IDENTIFIER_POS) | TYPE_DATA_16BIT ) /* s16A, q current of the load estimated by LOAD_TORQUE_OBSERVER */
 
 /* TYPE_DATA_32BIT registers definition */
 #define  MC_REG_FAULTS_FLAGS           ((0  << ELT_IDENTIFIER_POS) | TYPE_DATA_32BIT )
@@ -203,6 +238,8 @@
 #define  MC_REG_SC_MAX_CURRENT         ((103 << ELT_IDENTIFIER_POS) | TYPE_DATA_32BIT )
 #define  MC_REG_SC_STARTUP_SPEED       ((104 << ELT_IDENTIFIER_POS) | TYPE_DATA_32BIT )
 #define  MC_REG_SC_STARTUP_ACC         ((105 << ELT_IDENTIFIER_POS) | TYPE_DATA_32BIT )
+#define  MC_REG_PWM_FREQUENCY          ((106 << ELT_IDENTIFIER_POS) | TYPE_DATA_32BIT ) /* PWM frequency in Hz, applied in IDLE when written */
+#define  MC_REG_GAP_ERRORS             ((107 << ELT_IDENTIFIER_POS) | TYPE_DATA_32BIT ) /* GAP_ERROR_CODE_xxx of the STGAP gate drivers, MC_GAP_MODE */
 #define  MC_REG_FW_NAME               ((0U << ELT_IDENTIFIER_POS) | TYPE_DATA_STRING )
 #define  MC_REG_CTRL_STAGE_NAME       ((1U << ELT_IDENTIFIER_POS) | TYPE_DATA_STRING )
 #define  MC_REG_PWR_STAGE_NAME        ((2U << ELT_IDENTIFIER_POS) | TYPE_DATA_STRING )
@@ -217,14 +254,52 @@
 #define  MC_REG_REVUP_DATA            ((8U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Configure all steps*/
 #define  MC_REG_CURRENT_REF           ((13U  << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW )
 #define  MC_REG_POSITION_RAMP         ((14  << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW )
+#define  MC_REG_PERF_STATS            ((15  << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Min, max, mean and histogram in CPU cycles */
+#define  MC_REG_BENCH_RESULTS         ((16  << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Min, max and cold cache time of each kernel in CPU cycles */
+#define  MC_REG_PCC_TUNING            ((17  << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Model, weight, budget, engage and disengage speeds in rpm */
+#define  MC_REG_PCC_STATS             ((18  << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Decision statistics of the last window, then the periods constrained by and predicted above the trip current, the periods after a cut of the current limit and the mean and max residual of the predictions in s16A */
+#define  MC_REG_PERF_JITTER           ((19  << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Min and max jitter in CPU cycles and overruns of each scheduled task */
 #define  MC_REG_ASYNC_UARTA           ((20U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW )
 #define  MC_REG_ASYNC_UARTB           ((21U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW )
 #define  MC_REG_ASYNC_STLNK           ((22U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW )
+#define  MC_REG_CAPTURE_CONFIG        ((23U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Channels, trigger and pre-trigger, arms the capture */
+#define  MC_REG_CAPTURE_DATA          ((24U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* First index and samples of the frozen capture */
+#define  MC_REG_BENCH_RIPPLE          ((25U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Mean and max squared PCC tracking error of each input */
+#define  MC_REG_PROFILE_DATA          ((26U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_Profile_t in use, or index and MC_Profile_t to store when written */
+#define  MC_REG_RECORD_DATA           ((27U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* First index and MC_Record_Frame_t of the frozen record */
+#define  MC_REG_BENCH_SCENARIOS       ((28U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Closed loop results of each controller and scenario */
+#define  MC_REG_PIL_FRAME             ((29U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_Pil_Output_t of the last step, or MC_Pil_Input_t of the next one when written */
+#define  MC_REG_PERF_NOISE            ((30U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Means and variances of Ia and Ib in s16A digits of the last window */
+#define  MC_REG_FAULTLOG_DATA         ((31U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_FaultLog_Entry_t of the entry selected by MC_REG_FAULTLOG_INDEX */
+#define  MC_REG_STATE_STATS         ((32U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_StateStats_t, a write resets the statistics */
+#define  MC_REG_FRA_CONFIG           ((33U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Injection, amplitude, channels, cycles and frequencies in mHz of the sweep */
+#define  MC_REG_FRA_DATA             ((34U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* First index and MC_Fra_Point_t of the points measured */
+#define  MC_REG_SPECTRUM_DATA        ((35U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_Spectrum_Result_t of the last spectrum */
+#define  MC_REG_SPEED_FILTER         ((36U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* SFB_Bank_t in use, or SFB_Bank_t to apply when written */
+#define  MC_REG_TIME                 ((37U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_Time_Info_t: time in CPU cycles since the boot, trigger of the capture and rates */
+#define  MC_REG_PERF_LOAD            ((38U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* Load and max load of each task of MC_PERF_LOADS_LIST_t, then idle and min idle, in 0.01 % */
+#define  MC_REG_STACK                ((39U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_Stack_Info_t: stack reserved, high-water mark and depth at the entry of the high frequency task, in bytes */
+#define  MC_REG_RAM_FOOTPRINT        ((40U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_RAM_Report_t: RAM budget and bytes of the buffers of each feature */
+#define  MC_REG_ABTEST_CONFIG        ((41U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_ABTest_Config_t: length of the blocks and controller of each arm */
+#define  MC_REG_ABTEST_STATS         ((42U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_ABTest_Stats_t: sums of the tracking error, commutations, power and cycles of each arm */
+#define  MC_REG_AUTOSELECT           ((43U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_AutoSel_Report_t: current controller selected at boot and cycles of each candidate */
+#define  MC_REG_BOOTLOG_CONFIG       ((44U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_BootLog_Config_t: capture armed at boot, stored for the next boots when written in IDLE */
+#define  MC_REG_ADCCALIB             ((45U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_ADCCalib_Report_t: timing of the current sampling and noise of each timing tuned, read only */
+#define  MC_REG_REPORT_CONFIG        ((46U << ELT_IDENTIFIER_POS) | TYPE_DATA_RAW ) /* MC_Report_Config_t: registers pushed to the host when they change, their deadbands and the interval of their reads */
+
+/* Register groups: sets of 8, 16 or 32 bits registers defined once by the host with
+   DEFINE_REG_GROUP, then read with a GET_REG_GROUP command that only carries the index
+   of the group. The values are returned in the order of their definition. */
+#define RI_REG_GROUP_NBR      4U  /* Number of groups */
+#define RI_REG_GROUP_MAX_ELT  16U /* Registers of a group */
 
 uint8_t RI_SetRegCommandParser (MCP_Handle_t * pHandle, uint16_t txSyncFreeSpace);
 uint8_t RI_GetRegCommandParser (MCP_Handle_t * pHandle, uint16_t txSyncFreeSpace);
+uint8_t RI_DefineRegGroupCommandParser (MCP_Handle_t * pHandle);
+uint8_t RI_GetRegGroupCommandParser (MCP_Handle_t * pHandle, uint16_t txSyncFreeSpace);
 uint8_t RI_GetPtrReg(uint16_t dataID, void **dataPtr);
 uint8_t RI_GetIDSize(uint16_t dataID);
+uint8_t RI_ReadReg(uint16_t dataID, uint32_t *value);
 
 #endif /* REGISTER_INTERFACE_H */
 
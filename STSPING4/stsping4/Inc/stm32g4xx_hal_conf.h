@@ -42,7 +42,9 @@
 /*#define HAL_CRC_MODULE_ENABLED   */
 /*#define HAL_CRYP_MODULE_ENABLED   */
 #define HAL_DAC_MODULE_ENABLED
-/*#define HAL_FDCAN_MODULE_ENABLED   */
+#ifdef MC_FDCAN_MODE
+#define HAL_FDCAN_MODULE_ENABLED
+#endif
 /*#define HAL_FMAC_MODULE_ENABLED   */
 /*#define HAL_HRTIM_MODULE_ENABLED   */
 /*#define HAL_IRDA_MODULE_ENABLED   */
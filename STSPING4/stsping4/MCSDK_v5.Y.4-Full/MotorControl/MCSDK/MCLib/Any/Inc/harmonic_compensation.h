@@ -0,0 +1,156 @@
+/**
+  ******************************************************************************
+  * @file    harmonic_compensation.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          Harmonic Compensation component of the Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup HarmonicCompensation
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HARMONIC_COMPENSATION_H
+#define HARMONIC_COMPENSATION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup HarmonicCompensation
+  * @{
+  */
+
+/* Entries of the table, over one electrical revolution */
+#define HCM_TABLE_SIZE      256U
+/* Shift of the electrical angle that gives the entry */
+#define HCM_ANGLE_SHIFT     8U
+
+/**
+  * @brief Learning state of a Harmonic Compensation component
+  */
+typedef enum
+{
+  HCM_IDLE = 0,       /*!< The table is applied, not learned */
+  HCM_WAITING,        /*!< Learning requested, waiting for a steady speed */
+  HCM_LEARNING        /*!< The table is learned */
+} HCM_State_t;
+
+/**
+  * @brief Commands of HCM_Command()
+  */
+#define HCM_CMD_STOP        0U    /*!< Stops the learning, the table is kept */
+#define HCM_CMD_LEARN       1U    /*!< Learns at the next steady speeds */
+#define HCM_CMD_CLEAR       2U    /*!< Clears the table */
+
+/**
+  * @brief Entry of the table, for one electrical angle
+  */
+typedef struct
+{
+  int16_t hVq;                /*!< q voltage of the harmonics of the back-EMF
+                                   at hLearnSpeedDpp, in digits */
+  int16_t hVd;                /*!< d voltage of the harmonics of the back-EMF
+                                   at hLearnSpeedDpp, in digits */
+  int16_t hIq;                /*!< q current of the cogging torque, in s16A */
+} HCM_Entry_t;
+
+/**
+  * @brief Handle of a Harmonic Compensation component
+  *
+  * @detail Table of the voltage of the back-EMF harmonics and of the current of
+  * the cogging torque, by electrical angle. The cogging torque repeats a whole
+  * number of times per electrical revolution, as the back-EMF harmonics do.
+  */
+typedef struct
+{
+  HCM_Entry_t Table[HCM_TABLE_SIZE]; /*!< Compensation, by electrical angle */
+  int16_t  hLearnSpeedDpp;    /*!< Electrical speed at which the voltages of
+                                   the table are given, in dpp */
+  int16_t  hMinSpeedDpp;      /*!< Electrical speed magnitude from which the
+                                   table is learned, in dpp */
+  uint8_t  bLearnShift;       /*!< An entry moves by 2^-bLearnShift of its
+                                   error each time it is learned */
+  uint8_t  bMeanShift;        /*!< The mean voltage and current are averaged
+                                   over 2^bMeanShift periods */
+
+  int32_t  wLearnSpeedInv;    /*!< 2^30 divided by hLearnSpeedDpp. Computed by
+                                   HCM_Init() */
+  int32_t  wLearnScale;       /*!< hLearnSpeedDpp divided by the speed of the
+                                   learning, Q15 */
+  int32_t  wVqSum;            /*!< Sums of the running means of the q and d */
+  int32_t  wVdSum;            /*!< voltages and of the q current reference, */
+  int32_t  wIqSum;            /*!< times 2^bMeanShift */
+  uint16_t hWarmup;           /*!< Periods left before the means are valid */
+  qd_t     Voltage;           /*!< Voltage of the entry of the period */
+  int16_t  hIqref;            /*!< q current reference of the period, with the
+                                   cogging current */
+  uint8_t  bIndex;            /*!< Entry of the period */
+  bool     LearnRequested;    /*!< True from HCM_CMD_LEARN to HCM_CMD_STOP */
+  bool     Learning;          /*!< True while the table is learned */
+} HCM_Handle_t;
+
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------- */
+
+/* Initializes the component, the table is kept */
+void HCM_Init(HCM_Handle_t *pHandle);
+
+/* Stops the learning until the next steady speed, before a restart */
+void HCM_Clear(HCM_Handle_t *pHandle);
+
+/* Loads the entry of the period, from the high frequency task */
+void HCM_Update(HCM_Handle_t *pHandle, int16_t hElAngle, int16_t hElSpeedDpp);
+
+/* Adds the cogging current of the period to the current references */
+qd_t HCM_AddCurrent(HCM_Handle_t *pHandle, qd_t Iqdref);
+
+/* Returns the voltage of the back-EMF harmonics of the period */
+qd_t HCM_GetVoltage(const HCM_Handle_t *pHandle);
+
+/* Adds the voltage of the back-EMF harmonics of the period to a voltage */
+qd_t HCM_AddVoltage(const HCM_Handle_t *pHandle, qd_t Vqd);
+
+/* Learns the entry of the period from the applied voltage */
+void HCM_Learn(HCM_Handle_t *pHandle, qd_t Vqd);
+
+/* Selects the learning, from the medium frequency task */
+void HCM_SelectLearning(HCM_Handle_t *pHandle, bool SteadyState, int16_t hElSpeedDpp);
+
+/* Executes one of the HCM_CMD_xxx commands */
+bool HCM_Command(HCM_Handle_t *pHandle, uint8_t bCommand);
+
+/* Returns the learning state */
+HCM_State_t HCM_GetState(const HCM_Handle_t *pHandle);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* HARMONIC_COMPENSATION_H */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
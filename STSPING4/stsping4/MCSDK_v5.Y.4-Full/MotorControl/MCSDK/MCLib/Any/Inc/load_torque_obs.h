@@ -0,0 +1,105 @@
+/**
+  ******************************************************************************
+  * @file    load_torque_obs.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          Load Torque Observer component of the Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup LoadTorqueObserver
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LOAD_TORQUE_OBS_H
+#define LOAD_TORQUE_OBS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup LoadTorqueObserver
+  * @{
+  */
+
+/**
+  * @brief Handle of a Load Torque Observer component
+  *
+  * @detail The mechanical model over one speed loop period is:
+  *
+  * @f[
+  * \omega_{k} = \omega_{k-1} + b (i_{q,k-1} - i_{L})
+  * @f]
+  *
+  * where @f$ \omega @f$ is the mechanical speed in #SPEED_UNIT, b the speed
+  * gained per q current digit from the inertia and @f$ i_{L} @f$ the load
+  * torque expressed as the q current that balances it. The observer corrects
+  * the predicted speed by hSpeedGain of its error and the load by wLoadGain
+  * of it: both poles of the error are at the bandwidth of the observer.
+  */
+typedef struct
+{
+  int32_t  wSpeedPerIq;       /*!< Speed gained in one period per q current
+                                   digit, b, in #SPEED_UNIT times 65536 */
+  uint16_t hSpeedGain;        /*!< Share of the speed error added to the
+                                   estimated speed, Q15 */
+  int32_t  wLoadGain;         /*!< Load current removed per #SPEED_UNIT of
+                                   speed error, in digits times 65536 */
+  uint16_t hFFGain;           /*!< Share of the estimated load fed forward to
+                                   the q current reference, Q15 */
+  int16_t  hMaxLoad;          /*!< Bound of the magnitude of the estimated
+                                   load, in digits */
+
+  int32_t  wSpeedEst;         /*!< Estimated speed, in #SPEED_UNIT times 65536 */
+  int32_t  wLoad;             /*!< Estimated load, in digits times 65536 */
+  bool     Valid;             /*!< False until a first call after a clear */
+} LTO_Handle_t;
+
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------- */
+
+/* Initializes the component */
+void LTO_Init(LTO_Handle_t *pHandle);
+
+/* Clears the estimates, before the speed loop is closed */
+void LTO_Clear(LTO_Handle_t *pHandle);
+
+/* Runs one step of the observer and returns the estimated load */
+int16_t LTO_Update(LTO_Handle_t *pHandle, int16_t hIqApplied, int16_t hSpeedUnit);
+
+/* Adds the feed-forward of the estimated load to a q current reference */
+int16_t LTO_AddFeedForward(const LTO_Handle_t *pHandle, int16_t hIqref);
+
+/* Returns the estimated load */
+int16_t LTO_GetLoad(const LTO_Handle_t *pHandle);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* LOAD_TORQUE_OBS_H */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -229,6 +229,20 @@ typedef enum
   INTERNAL, EXTERNAL
 } CurrRefSource_t ;
 
+/**
+  * @brief  Measured and applied quantities of one FOC period, published as a
+  *         whole by the high frequency task, see FOC_PublishSnapshot()
+  */
+typedef struct
+{
+  ab_t Iab;                /**< @brief Stator current on stator reference frame abc */
+  alphabeta_t Ialphabeta;  /**< @brief Stator current on stator reference frame alfa-beta */
+  qd_t Iqd;                /**< @brief Stator current on rotor reference frame qd */
+  qd_t Vqd;                /**< @brief Phase voltage on rotor reference frame qd */
+  alphabeta_t Valphabeta;  /**< @brief Phase voltage on stator reference frame alpha-beta */
+  int16_t hElAngle;        /**< @brief Electrical angle used for reference frame transformation */
+} FOCSnapshot_t;
+
 /**
   * @brief  FOC variables structure
   */
@@ -247,8 +261,57 @@ typedef struct
   uint16_t hCodeError;         /**< @brief error message */
   CurrRefSource_t bDriveInput; /**< @brief It specifies whether the current reference source must be
                                  *         #INTERNAL or #EXTERNAL*/
+  FOCSnapshot_t Snapshot[2];   /**< @brief Last two periods published by FOC_PublishSnapshot() */
+  volatile uint32_t wSnapshotSeq; /**< @brief Number of published periods, the last one is in
+                                 *         Snapshot[wSnapshotSeq & 1] */
 } FOCVars_t, *pFOCVars_t;
 
+/**
+  * @brief  It publishes the quantities of the FOC period, already written in
+  *         @p pFOCVars, for the readers of lower priority. It must be called by
+  *         the high frequency task only, once the FOC period is complete.
+  *
+  *         The period is written in the buffer not being read, then made visible
+  *         by a single increment of the sequence counter, so that the readers
+  *         never need to disable the interrupts.
+  * @param  pFOCVars FOC variables of the motor
+  */
+static inline void FOC_PublishSnapshot(FOCVars_t *pFOCVars)
+{
+  FOCSnapshot_t *pSnapshot = &pFOCVars->Snapshot[(pFOCVars->wSnapshotSeq + 1U) & 1U];
+
+  pSnapshot->Iab = pFOCVars->Iab;
+  pSnapshot->Ialphabeta = pFOCVars->Ialphabeta;
+  pSnapshot->Iqd = pFOCVars->Iqd;
+  pSnapshot->Vqd = pFOCVars->Vqd;
+  pSnapshot->Valphabeta = pFOCVars->Valphabeta;
+  pSnapshot->hElAngle = pFOCVars->hElAngle;
+  __DMB(); /* The buffer is complete before it is published */
+  pFOCVars->wSnapshotSeq++;
+}
+
+/**
+  * @brief  It returns a consistent copy of the last FOC period published by
+  *         FOC_PublishSnapshot(). The copy is only made again if the high
+  *         frequency task has published two periods while it was in progress.
+  * @param  pFOCVars FOC variables of the motor
+  * @retval FOCSnapshot_t Quantities of the last published FOC period
+  */
+static inline FOCSnapshot_t FOC_GetSnapshot(const FOCVars_t *pFOCVars)
+{
+  FOCSnapshot_t Snapshot;
+  uint32_t wSeq;
+
+  do
+  {
+    wSeq = pFOCVars->wSnapshotSeq;
+    __DMB();
+    Snapshot = pFOCVars->Snapshot[wSeq & 1U];
+    __DMB();
+  } while ((pFOCVars->wSnapshotSeq - wSeq) > 1U);
+  return (Snapshot);
+}
+
 /**
   * @brief  Low side or enabling signal definition
   */
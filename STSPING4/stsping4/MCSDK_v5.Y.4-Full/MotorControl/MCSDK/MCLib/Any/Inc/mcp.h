@@ -43,6 +43,8 @@
 #define PFC_ENABLE       0x50
 #define PFC_DISABLE      0x58
 #define PFC_FAULT_ACK    0x60
+#define DEFINE_REG_GROUP 0x68
+#define GET_REG_GROUP    0x70
 #define SW_RESET         0x78
 #define MCP_USER_CMD     0x100
 
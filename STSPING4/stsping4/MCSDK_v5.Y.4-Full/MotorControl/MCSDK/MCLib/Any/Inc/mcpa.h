@@ -26,6 +26,12 @@
 #include "mcptl.h"
 extern uint32_t GLOBAL_TIMESTAMP;
 
+/* Set in the HF data number of the log configuration by a host that decodes the HF values
+   as deltas: each one is the 8 bits difference to the previous value of its channel in the
+   buffer, or MCPA_DELTA_ESCAPE followed by the raw 16 bits value when it does not fit */
+#define MCPA_CFG_HF_DELTA   0x80U
+#define MCPA_DELTA_ESCAPE   0x80U
+
 
 
 typedef struct
@@ -35,6 +41,7 @@ typedef struct
   void ** dataPtrTableBuff;
   uint8_t *dataSizeTable;
   uint8_t *dataSizeTableBuff;  
+  int16_t *HFLastTable;       /* Last HF values of the buffer, for the delta encoding */
   uint8_t *currentBuffer;
   uint16_t bufferIndex;
   uint16_t bufferTxTrigger;
@@ -55,6 +62,8 @@ typedef struct
   uint8_t MFNumBuff;
   uint8_t Mark;
   uint8_t MarkBuff;
+  uint8_t HFDelta;
+  uint8_t HFDeltaBuff;
 } MCPA_Handle_t; /* MCP Async handle type*/
 
 
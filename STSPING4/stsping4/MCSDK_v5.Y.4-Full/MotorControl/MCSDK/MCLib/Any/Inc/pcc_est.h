@@ -0,0 +1,156 @@
+/**
+  ******************************************************************************
+  * @file    pcc_est.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          Predictive Current Control model estimator component of the Motor
+  *          Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup PCC_EST
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PCC_EST_H
+#define PCC_EST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mc_type.h"
+#include "pcc.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup PCC_EST
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/**
+  * @brief Number of estimated parameters: resistance, inductance and flux terms
+  */
+#define PCC_EST_NB_PARAMS   3U
+
+/**
+  * @brief Sums of the q/d currents and voltages over one medium frequency period
+  */
+typedef struct
+{
+  int32_t   wIqSum;
+  int32_t   wIdSum;
+  int32_t   wVqSum;
+  int32_t   wVdSum;
+  uint16_t  hNbSamples;
+} PCC_EST_Acc_t;
+
+/**
+  * @brief Handle of a PCC model estimator component
+  *
+  * @detail The estimator identifies, with a recursive least squares algorithm,
+  * the steady state model of the motor in the units of the predictor:
+  *
+  * @f[
+  * v_{d} = a i_{d} - b \delta i_{q}
+  * @f]
+  * @f[
+  * v_{q} = a i_{q} + b \delta i_{d} + c n
+  * @f]
+  *
+  * where n is the electrical speed in dpp and @f$ \delta @f$ the same speed in
+  * rad per control period. a, b and c are the resistance, inductance and flux
+  * terms, from which the wKDecay, wKVolt and wKBemf coefficients of the
+  * predictor are computed.
+  */
+typedef struct
+{
+  float_t   fForgetting;          /**< Forgetting factor of the least squares,
+                                       between 0 and 1 */
+  float_t   fPriorWeight;         /**< Weight of the temperature prior of the
+                                       resistance term, relative to one equation
+                                       of the model, between 0 and 1. 0 disables
+                                       the prior */
+  float_t   fInitCovariance;      /**< Diagonal of the covariance matrix at
+                                       initialization */
+  int16_t   hMinSpeedDpp;         /**< Absolute electrical speed, in dpp, below
+                                       which the samples are discarded */
+  int16_t   hMinCurrent;          /**< Absolute q current, in digits, below
+                                       which the samples are discarded */
+  int16_t   hRefTemp_C;           /**< Temperature, in Celsius, of the nominal
+                                       resistance of the motor */
+  uint16_t  hUpdatePeriod;        /**< Number of calls of PCC_EST_Update()
+                                       between two updates of the predictor */
+  PCC_EST_Acc_t Acc[2];           /**< Sums written by the high frequency task
+                                       and read by the medium frequency task */
+  volatile uint8_t bAccIndex;     /**< Index of the sums written by the high
+                                       frequency task */
+  float_t   fTheta[PCC_EST_NB_PARAMS]; /**< Estimated a, b and c terms */
+  float_t   fThetaNom[PCC_EST_NB_PARAMS]; /**< a, b and c terms of the nominal
+                                       model, computed by PCC_EST_Init() */
+  float_t   fP[PCC_EST_NB_PARAMS][PCC_EST_NB_PARAMS]; /**< Covariance matrix */
+  uint16_t  hUpdateCounter;       /**< Calls of PCC_EST_Update() since the last
+                                       update of the predictor */
+} PCC_EST_Handle_t;
+
+/* Exported functions ------------------------------------------------------- */
+
+/*
+ * Initializes the handle from the nominal model of the predictor
+ */
+void PCC_EST_Init(PCC_EST_Handle_t *pHandle, const PCC_Handle_t *pPCC);
+
+/*
+ * Resets the sums and the estimates to the nominal model
+ */
+void PCC_EST_Clear(PCC_EST_Handle_t *pHandle);
+
+/*
+ * Adds the currents and voltages of one control period to the sums
+ */
+void PCC_EST_Accumulate(PCC_EST_Handle_t *pHandle, qd_t Iqd, qd_t Vqd);
+
+/*
+ * Runs one step of the estimation and updates the predictor model
+ */
+void PCC_EST_Update(PCC_EST_Handle_t *pHandle, PCC_Handle_t *pPCC, int16_t hElSpeedDpp, int16_t hTemp_C);
+
+/*
+ * Replaces the nominal model and updates the predictor model
+ */
+void PCC_EST_SetModel(PCC_EST_Handle_t *pHandle, PCC_Handle_t *pPCC, const float_t fTheta[PCC_EST_NB_PARAMS]);
+
+/*
+ * Returns one of the estimated a, b and c terms
+ */
+float_t PCC_EST_GetEstimate(const PCC_EST_Handle_t *pHandle, uint8_t bParam);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* PCC_EST_H */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -94,6 +94,21 @@ typedef struct
                                        must be 9 as 2^9 = 512 */
   int32_t   wPrevProcessVarError; /*!< previous process variable used by the
                                        derivative part of the PID component */
+#ifdef PID_FMAC
+  bool      FMACEnable;           /*!< PI_Controller() of the regulator runs on the
+                                       FMAC, see PI_FMAC_Controller() */
+  bool      FMACCoeffValid;       /*!< The coefficients below match the gains and
+                                       divisors, cleared by their setters */
+  uint8_t   bFMACShift;           /*!< Gain R of the FMAC, the coefficients being
+                                       scaled by 2^-R */
+  int16_t   hFMACCoeff[4];        /*!< b0, b1, b2 and a1 of the FMAC, in q1.15 */
+  int16_t   hFMACPrevError;       /*!< Process variable error of the previous call,
+                                       saturated to 16 bits */
+  int16_t   hFMACPrevOutput;      /*!< Output of the previous call, within the
+                                       output limits */
+  uint16_t  hFMACFraction;        /*!< Fraction of a digit truncated by the previous
+                                       call, in 2^(R-15) digits */
+#endif
 } PID_Handle_t;
 
 /*
@@ -44,6 +44,19 @@ extern "C" {
   * @{
   */
 
+/**
+  * @brief Sums of one measurement window, accumulated at every FOC period by
+  *        PQD_AccumulateElPower() and closed by PQD_CalcElMotorPower().
+  */
+typedef struct
+{
+  int32_t  wPowerSum;       /*!< Sum of the power of the FOC periods, in
+                                 digits of voltage times current / 65536 */
+  uint32_t wCurrentSqSum;   /*!< Sum of the squared current magnitudes, in
+                                 squared current digits / 65536 */
+  uint16_t hNbPeriods;      /*!< Number of FOC periods of the sums */
+} PQD_Window_t;
+
 typedef struct
 {
   MotorPowMeas_Handle_t _super;
@@ -54,8 +67,27 @@ typedef struct
                          power in watts. It must be equal to
                          (1000 * 3 * Vddï¿½)/(sqrt(3) * Rshunt * Aop) */
 
+  int32_t wCopperLossFact; /* Copper losses, in mW, of a squared current
+                              magnitude of 65536 squared digits. It must be
+                              equal to 1500 * Rs * (Vdd / (Rshunt * Aop))^2 */
+
   pFOCVars_t pFOCVars;    /*!< Pointer to FOC vars used by MPM.*/
   BusVoltageSensor_Handle_t *pVBS;               /*!< Bus voltage sensor object used by MPM.*/
+
+  PQD_Window_t Window[2];  /*!< Window accumulated by the high frequency task
+                                and window being closed */
+  volatile uint8_t bWindow; /*!< Index of the window accumulated by the high
+                                frequency task */
+  alphabeta_t Ialphabeta;  /*!< Currents sampled at the start of the FOC
+                                period being applied */
+  alphabeta_t Valphabeta;  /*!< Voltage applied during that FOC period */
+  uint32_t wCurrentSq;     /*!< Mean squared current magnitude of the last
+                                window, in squared current digits / 65536 */
+  int32_t wElPower_mW;     /*!< Electrical power of the last window, in mW */
+  int32_t wCopperLoss_mW;  /*!< Copper losses of the last window, in mW */
+  int16_t hEfficiency;     /*!< Share of the electrical power of the last
+                                window that is not lost in the copper, in
+                                per mille */
 } PQD_MotorPowMeas_Handle_t;
 
 
@@ -66,6 +98,43 @@ typedef struct
   */
 void PQD_CalcElMotorPower(PQD_MotorPowMeas_Handle_t *pHandle);
 
+/**
+  * @brief Clears the measurement windows and the power buffer.
+  * @param pHandle related component instance.
+  */
+void PQD_Clear(PQD_MotorPowMeas_Handle_t *pHandle);
+
+/**
+  * @brief Accumulates the power of the FOC period that ends with the sampling
+  *        of @p Ialphabeta.
+  * @param pHandle related component instance.
+  * @param Ialphabeta currents sampled in the current FOC period.
+  * @param Valphabeta voltage written in the current FOC period.
+  */
+void PQD_AccumulateElPower(PQD_MotorPowMeas_Handle_t *pHandle, alphabeta_t Ialphabeta, alphabeta_t Valphabeta);
+
+/**
+  * @brief Returns the mean squared current magnitude of the last window, in
+  *        squared current digits / 65536.
+  */
+uint32_t PQD_GetMeanSqCurrent(const PQD_MotorPowMeas_Handle_t *pHandle);
+
+/**
+  * @brief Returns the electrical power of the last window, in mW.
+  */
+int32_t PQD_GetElPower_mW(const PQD_MotorPowMeas_Handle_t *pHandle);
+
+/**
+  * @brief Returns the copper losses of the last window, in watt.
+  */
+int16_t PQD_GetCopperLossW(const PQD_MotorPowMeas_Handle_t *pHandle);
+
+/**
+  * @brief Returns the share of the electrical power of the last window that is
+  *        not lost in the copper, in per mille.
+  */
+int16_t PQD_GetEfficiency(const PQD_MotorPowMeas_Handle_t *pHandle);
+
 
 /**
   * @}
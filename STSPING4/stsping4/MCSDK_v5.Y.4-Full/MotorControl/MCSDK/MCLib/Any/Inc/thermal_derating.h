@@ -0,0 +1,129 @@
+/**
+  ******************************************************************************
+  * @file    thermal_derating.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          Thermal Derating component of the Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup ThermalDerating
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef THERMAL_DERATING_H
+#define THERMAL_DERATING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup ThermalDerating
+  * @{
+  */
+
+/**
+  * @brief Number of nodes of the thermal model: power switches and windings
+  */
+#define TDR_NB_NODES   2U
+
+/**
+  * @brief Index of the power switches node
+  */
+#define TDR_STAGE      0U
+
+/**
+  * @brief Index of the windings node
+  */
+#define TDR_WINDING    1U
+
+/**
+  * @brief Parameters and state of one node of the thermal model
+  */
+typedef struct
+{
+  float_t fRise_C;     /*!< Rise of the node above the heat sink at steady state
+                            at the nominal current */
+  float_t fCoeff;      /*!< Medium frequency period divided by the thermal time
+                            constant of the node */
+  int16_t hMax_C;      /*!< Largest temperature of the node */
+  float_t fLoad;       /*!< Squared current relative to the squared nominal
+                            current, filtered with the thermal time constant */
+  int16_t hTemp_C;     /*!< Estimated temperature of the node */
+} TDR_Node_t;
+
+/**
+  * @brief Handle of a Thermal Derating component
+  *
+  * @detail Each node is a first order thermal model above the heat sink
+  * temperature measured by the NTC, heated by the copper losses:
+  *
+  * @f[
+  * T = T_{sink} + R \frac{I^2}{I_{nom}^2}
+  * @f]
+  *
+  * at steady state, where R is the rise of the node at the nominal current. The
+  * heat sink is the warmest point the model can see: the ambient temperature of
+  * the motor is not measured and is taken equal to it.
+  */
+typedef struct
+{
+  TDR_Node_t Node[TDR_NB_NODES];
+  int32_t wNominalSqCurr;   /*!< Squared nominal current, in s16A squared */
+  int16_t hBand_C;          /*!< Headroom below which the current is derated */
+  int16_t hHeadroom_C;      /*!< Smallest distance of the estimated temperatures
+                                 to their largest value */
+  int32_t wSqCurrLimit;     /*!< Squared current limit, in s16A squared */
+} TDR_Handle_t;
+
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------- */
+
+/* Initializes the thermal model at the heat sink temperature */
+void TDR_Init(TDR_Handle_t *pHandle);
+
+/* Updates the thermal model and the current limit, once per medium frequency period */
+void TDR_Update(TDR_Handle_t *pHandle, uint32_t wCurrentSq, int16_t hSinkTemp_C);
+
+/* Returns the squared current limit, in s16A squared */
+int32_t TDR_GetSqCurrLimit(const TDR_Handle_t *pHandle);
+
+/* Returns the current limit, in s16A */
+int16_t TDR_GetCurrLimit(const TDR_Handle_t *pHandle);
+
+/* Returns the smallest distance of the estimated temperatures to their largest value, in Celsius */
+int16_t TDR_GetHeadroom_C(const TDR_Handle_t *pHandle);
+
+/* Returns the estimated temperature of a node, in Celsius */
+int16_t TDR_GetTemp_C(const TDR_Handle_t *pHandle, uint8_t bNode);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /* THERMAL_DERATING_H */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
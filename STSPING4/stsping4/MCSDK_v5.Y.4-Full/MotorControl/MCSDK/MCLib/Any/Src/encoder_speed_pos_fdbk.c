@@ -132,6 +132,7 @@ __weak void ENC_Clear(ENCODER_Handle_t *pHandle)
       pHandle->DeltaCapturesBuffer[index] = 0;
     }
     pHandle->SensorIsReliable = true;
+    pHandle->_Super.InstantaneousElSpeedDpp = 0;
 #ifdef NULL_PTR_CHECK_ENC_SPD_POS_FDB
   }
 #endif
@@ -319,6 +320,9 @@ __weak bool ENC_CalcAvrgMecSpeedUnit(ENCODER_Handle_t *pHandle, int16_t *pMecSpe
     wtemp1 /= ((int32_t)pHandle->_Super.hMeasurementFrequency);
 
     pHandle->_Super.hElSpeedDpp = (int16_t)wtemp1;
+    /* SPD_GetElAngleAt() extrapolates the angle of ENC_CalcAngle() with the speed
+       of the last medium frequency period */
+    pHandle->_Super.InstantaneousElSpeedDpp = (int16_t)wtemp1;
 
     /*last captured value update*/
     pHandle->PreviousCapture = (CntCapture >= (uint32_t)65535) ? 65535U : (uint16_t)CntCapture;
@@ -214,6 +214,8 @@ __weak void FF_VqdffComputation(FF_Handle_t *pHandle, qd_t Iqdref, SpeednTorqCtr
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It return the Vqd componets fed in input plus the feed forward
@@ -261,6 +263,8 @@ __weak qd_t FF_VqdConditioning(FF_Handle_t *pHandle, qd_t Vqd)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It low-pass filters the Vqd voltage coming from the speed PI. Filter
@@ -222,6 +222,8 @@ __weak qd_t FW_CalcCurrRef(FW_Handle_t *pHandle, qd_t Iqdref)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It low-pass filters both the Vqd voltage components. Filter
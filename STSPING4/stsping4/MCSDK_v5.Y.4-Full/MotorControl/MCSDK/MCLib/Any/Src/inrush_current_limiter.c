@@ -44,7 +44,64 @@
 /* Private macros ------------------------------------------------------------*/
 /* Global variables ----------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static bool ICL_IsBusCharged(ICL_Handle_t *pHandle);
+
 /* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  It samples the rise of the bus voltage once per interval and predicts
+  *         the rise still expected. The bus capacitors charge through the ICL
+  *         resistor: the rise of each interval is the one of the previous
+  *         interval times a constant ratio r, and the rise still expected after
+  *         an interval of rise dV is dV.r/(1-r), with r the ratio of the last two
+  *         rises.
+  * @param  pHandle: handler of the current instance of the ICL component
+  * @retval bool true once the bus voltage is above the under voltage threshold
+  *         and the rise still expected is below hSettleVoltage_d
+  */
+static bool ICL_IsBusCharged(ICL_Handle_t *pHandle)
+{
+  bool bCharged = false;
+  uint16_t hVbus_d;
+  int32_t wRise;
+
+  if (0U == pHandle->hSettleVoltage_d)
+  {
+    bCharged = (VBS_CheckVbus(pHandle->pVBS) != MC_UNDER_VOLT);
+  }
+  else if (pHandle->hWindowCounter > 1U)
+  {
+    pHandle->hWindowCounter--;
+  }
+  else
+  {
+    hVbus_d = VBS_GetAvBusVoltage_d(pHandle->pVBS);
+    wRise = (int32_t)hVbus_d - (int32_t)pHandle->hWindowVbus_d;
+    if (VBS_CheckVbus(pHandle->pVBS) == MC_UNDER_VOLT)
+    {
+      /* Nothing to do */
+    }
+    else if (wRise <= 0)
+    {
+      /* Settled, within the noise of the measurement */
+      bCharged = true;
+    }
+    else if (pHandle->wLastRise_d > wRise)
+    {
+      /* dV^2 <= Settle.(dVlast - dV), both sides below 2^32 */
+      bCharged = ((uint32_t)wRise * (uint32_t)wRise)
+              <= ((uint32_t)pHandle->hSettleVoltage_d * (uint32_t)(pHandle->wLastRise_d - wRise));
+    }
+    else
+    {
+      /* Nothing to do, the rise is not decaying yet */
+    }
+    pHandle->wLastRise_d = wRise;
+    pHandle->hWindowVbus_d = hVbus_d;
+    pHandle->hWindowCounter = pHandle->hWindowTicks;
+  }
+  return (bCharged);
+}
+
 /**
   * @brief  It initializes all the needed ICL component variables.
   *         It shall be called only once, right after the ICL instance creation.
@@ -77,6 +134,20 @@ __weak void ICL_Init(ICL_Handle_t *pHandle, BusVoltageSensor_Handle_t *pVBS, DOU
     wAux = 1;
   }
   pHandle->hICLTotalTicks = (uint16_t)(wAux);
+
+  wAux = ((uint32_t)pHandle->hICLWindowms * (uint32_t)pHandle->hICLFrequencyHz) / 1000U;
+  if (wAux > UINT16_MAX)
+  {
+    wAux = UINT16_MAX;
+  }
+  if (wAux < 1U)
+  {
+    wAux = 1U;
+  }
+  pHandle->hWindowTicks = (uint16_t)(wAux);
+  pHandle->hWindowCounter = pHandle->hWindowTicks;
+  pHandle->hWindowVbus_d = VBS_GetAvBusVoltage_d(pVBS);
+  pHandle->wLastRise_d = -1;
 }
 
 /**
@@ -120,8 +191,8 @@ __weak ICL_State_t ICL_Exec(ICL_Handle_t *pHandle)
 
     case ICL_ACTIVE:
     {
-      /* ICL is active: if bus is present deactivate the ICL */
-      if (VBS_CheckVbus(pHandle->pVBS) != MC_UNDER_VOLT)
+      /* ICL is active: once the bus capacitors are charged deactivate the ICL */
+      if (true == ICL_IsBusCharged(pHandle))
       {
         DOUT_SetOutputState(pHandle->pDOUT, INACTIVE);
         pHandle->ICLstate = ICL_DEACTIVATION;
@@ -138,6 +209,10 @@ __weak ICL_State_t ICL_Exec(ICL_Handle_t *pHandle)
         DOUT_SetOutputState(pHandle->pDOUT, ACTIVE);
         pHandle->ICLstate = ICL_ACTIVATION;
         pHandle->hICLTicksCounter = pHandle->hICLTotalTicks;
+        /* The bus charges again from the present voltage */
+        pHandle->hWindowCounter = pHandle->hWindowTicks;
+        pHandle->hWindowVbus_d = VBS_GetAvBusVoltage_d(pHandle->pVBS);
+        pHandle->wLastRise_d = -1;
       }
     }
     break;
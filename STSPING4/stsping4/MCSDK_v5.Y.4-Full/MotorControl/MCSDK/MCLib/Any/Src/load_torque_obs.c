@@ -0,0 +1,221 @@
+/**
+  ******************************************************************************
+  * @file    load_torque_obs.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the Load Torque Observer component of the Motor Control SDK:
+  *
+  *           * estimation of the load torque from the q current and the speed
+  *           * feed-forward of the estimated load to the q current reference
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "load_torque_obs.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/**
+  * @defgroup LoadTorqueObserver Load Torque Observer
+  * @brief Estimation and feed-forward of the load torque
+  *
+  * The speed PI only reacts to the speed error: a load step costs a dip of the
+  * speed until its integral term has caught up. The observer predicts the speed
+  * from the q current executed over the last speed loop period and the inertia,
+  * and moves its estimate of the load torque from the error of that
+  * prediction. The estimate, expressed as the q current that balances the
+  * load, is added to the output of the speed PI: the current controller then
+  * applies it within one PWM period, and the PI only corrects the error of the
+  * observer.
+  *
+  * The observer runs once per speed loop period in integer arithmetic. Both
+  * poles of its error are placed at the bandwidth set in the drive parameters,
+  * low enough for the noise of the averaged speed.
+  *
+  * @{
+  */
+
+/**
+  * @brief  Initializes the component.
+  * @param  pHandle handler of the current instance of the Load Torque Observer component
+  */
+__weak void LTO_Init(LTO_Handle_t *pHandle)
+{
+  LTO_Clear(pHandle);
+}
+
+/**
+  * @brief  Clears the estimates. The next call of LTO_Update() starts the
+  *         observer from the measured speed and no load.
+  * @param  pHandle handler of the current instance of the Load Torque Observer component
+  */
+__weak void LTO_Clear(LTO_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_LOAD_TORQUE_OBS
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->wSpeedEst = 0;
+    pHandle->wLoad = 0;
+    pHandle->Valid = false;
+#ifdef NULL_PTR_CHECK_LOAD_TORQUE_OBS
+  }
+#endif
+}
+
+/**
+  * @brief  Predicts the speed from the q current executed over the last period,
+  *         then corrects the speed and the load from the error of the
+  *         prediction. It must be called once per speed loop period.
+  * @param  pHandle handler of the current instance of the Load Torque Observer component
+  * @param  hIqApplied q current reference executed over the last period, in digits
+  * @param  hSpeedUnit measured mechanical speed, in #SPEED_UNIT
+  * @retval int16_t Estimated load, as the q current that balances it, in digits
+  */
+__weak int16_t LTO_Update(LTO_Handle_t *pHandle, int16_t hIqApplied, int16_t hSpeedUnit)
+{
+  int16_t hLoad = 0;
+#ifdef NULL_PTR_CHECK_LOAD_TORQUE_OBS
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int32_t wSpeed = (int32_t)hSpeedUnit * 65536;
+
+    if (false == pHandle->Valid)
+    {
+      pHandle->wSpeedEst = wSpeed;
+      pHandle->Valid = true;
+    }
+    else
+    {
+      int32_t wMaxLoad = (int32_t)pHandle->hMaxLoad * 65536;
+      int64_t dSpeedEst;
+      int64_t dError;
+      int64_t dLoad;
+
+      /* Prediction over the last period, kept in the range of the speed */
+      dSpeedEst = (int64_t)pHandle->wSpeedEst
+                + (((int64_t)hIqApplied - (pHandle->wLoad / 65536)) * pHandle->wSpeedPerIq);
+      if (dSpeedEst > ((int64_t)INT16_MAX * 65536))
+      {
+        dSpeedEst = (int64_t)INT16_MAX * 65536;
+      }
+      else if (dSpeedEst < (-(int64_t)INT16_MAX * 65536))
+      {
+        dSpeedEst = -(int64_t)INT16_MAX * 65536;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      dError = (int64_t)wSpeed - dSpeedEst;
+
+      /* Correction: a speed below the prediction is a larger load */
+      pHandle->wSpeedEst = (int32_t)(dSpeedEst + ((dError * pHandle->hSpeedGain) / 32768));
+      dLoad = (int64_t)pHandle->wLoad - ((dError * pHandle->wLoadGain) / 65536);
+      if (dLoad > wMaxLoad)
+      {
+        dLoad = wMaxLoad;
+      }
+      else if (dLoad < -wMaxLoad)
+      {
+        dLoad = -wMaxLoad;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      pHandle->wLoad = (int32_t)dLoad;
+    }
+    hLoad = (int16_t)(pHandle->wLoad / 65536);
+#ifdef NULL_PTR_CHECK_LOAD_TORQUE_OBS
+  }
+#endif
+  return (hLoad);
+}
+
+/**
+  * @brief  Adds hFFGain of the estimated load to a q current reference.
+  * @param  pHandle handler of the current instance of the Load Torque Observer component
+  * @param  hIqref q current reference, output of the speed controller, in digits
+  * @retval int16_t q current reference with the feed-forward, saturated to 16 bits.
+  *         The flux weakening saturates it on the current limit downstream
+  */
+__weak int16_t LTO_AddFeedForward(const LTO_Handle_t *pHandle, int16_t hIqref)
+{
+  int16_t hIqrefFF = hIqref;
+#ifdef NULL_PTR_CHECK_LOAD_TORQUE_OBS
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int32_t wIqref = (int32_t)hIqref + (((pHandle->wLoad / 65536) * (int32_t)pHandle->hFFGain) / 32768);
+
+    if (wIqref > INT16_MAX)
+    {
+      wIqref = INT16_MAX;
+    }
+    else if (wIqref < -INT16_MAX)
+    {
+      wIqref = -INT16_MAX;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    hIqrefFF = (int16_t)wIqref;
+#ifdef NULL_PTR_CHECK_LOAD_TORQUE_OBS
+  }
+#endif
+  return (hIqrefFF);
+}
+
+/**
+  * @brief  Returns the estimated load.
+  * @param  pHandle handler of the current instance of the Load Torque Observer component
+  * @retval int16_t Estimated load, as the q current that balances it, in digits
+  */
+__weak int16_t LTO_GetLoad(const LTO_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_LOAD_TORQUE_OBS
+  return ((MC_NULL == pHandle) ? 0 : (int16_t)(pHandle->wLoad / 65536));
+#else
+  return ((int16_t)(pHandle->wLoad / 65536));
+#endif
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,250 @@
+/**
+  ******************************************************************************
+  * @file    loss_minimization.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the Loss Minimization component of the Motor Control SDK:
+  *
+  *           * perturb and observe search of the d current of least power
+  *             at light load
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "loss_minimization.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/**
+  * @defgroup LossMinimization Loss Minimization
+  * @brief Online search of the d current of least power at part load
+  *
+  * The medium frequency task feeds the component with the electrical power of
+  * its period, measured by the PQD windows, and with the operating point. While
+  * the magnitude of the q current reference is below hLightLoadIq and the
+  * speed magnitude above hMinSpeedUnit, the d current offset is moved by
+  * hIdStep, then the power is averaged over hAvgPeriods once hSettlePeriods have
+  * let the speed loop settle. When the average is higher than the one of the
+  * previous step, the direction of the next step is reversed. The offset ends
+  * up oscillating by one step around the point of least power.
+  *
+  * The search rate is bounded by one step per hSettlePeriods + hAvgPeriods
+  * and the offset by hIdMax. A change of the q current reference by more than
+  * hLoadBand during a measurement discards it. Out of the search range, the
+  * offset goes back to zero by one step per period.
+  *
+  * The offset is added to the MTPA d current, before the flux weakening loop
+  * that may lower it further.
+  *
+  * @{
+  */
+
+/**
+  * @brief  Initializes the search with no d current offset.
+  * @param  pHandle handler of the current instance of the Loss Minimization component
+  */
+__weak void LMN_Init(LMN_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_LOSS_MINIMIZATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->hDirection = -1;
+    LMN_Clear(pHandle);
+#ifdef NULL_PTR_CHECK_LOSS_MINIMIZATION
+  }
+#endif
+}
+
+/**
+  * @brief  Returns the d current offset to zero at once and restarts the
+  *         measurement. The direction of the last step is kept, it is the
+  *         likely one at the next start.
+  * @param  pHandle handler of the current instance of the Loss Minimization component
+  */
+__weak void LMN_Clear(LMN_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_LOSS_MINIMIZATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->hIdOffset = 0;
+    pHandle->hCount = 0U;
+    pHandle->wPowerSum = 0;
+    pHandle->LastPowerValid = false;
+    pHandle->Searching = false;
+#ifdef NULL_PTR_CHECK_LOSS_MINIMIZATION
+  }
+#endif
+}
+
+/**
+  * @brief  Updates the search of the d current offset. It must be called once
+  *         per medium frequency period in RUN, after the power of the period
+  *         has been measured.
+  * @param  pHandle handler of the current instance of the Loss Minimization component
+  * @param  wPower_mW electrical power of the period, in mW
+  * @param  hIqref q current reference, in s16A
+  * @param  hAvrgMecSpeedUnit average mechanical speed, in SPEED_UNIT
+  */
+__weak void LMN_Update(LMN_Handle_t *pHandle, int32_t wPower_mW, int16_t hIqref, int16_t hAvrgMecSpeedUnit)
+{
+#ifdef NULL_PTR_CHECK_LOSS_MINIMIZATION
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int32_t wIq = (hIqref < 0) ? -(int32_t)hIqref : (int32_t)hIqref;
+    int32_t wSpeed = (hAvrgMecSpeedUnit < 0) ? -(int32_t)hAvrgMecSpeedUnit : (int32_t)hAvrgMecSpeedUnit;
+    int32_t wOffset = (int32_t)pHandle->hIdOffset;
+    int32_t wStep = (int32_t)pHandle->hIdStep;
+
+    if ((wIq > (int32_t)pHandle->hLightLoadIq) || (wSpeed < (int32_t)pHandle->hMinSpeedUnit))
+    {
+      /* Out of the search range: back to the MTPA d current, at a bounded rate */
+      if (wOffset > wStep)
+      {
+        wOffset -= wStep;
+      }
+      else if (wOffset < -wStep)
+      {
+        wOffset += wStep;
+      }
+      else
+      {
+        wOffset = 0;
+      }
+      pHandle->hCount = 0U;
+      pHandle->wPowerSum = 0;
+      pHandle->LastPowerValid = false;
+      pHandle->Searching = false;
+    }
+    else if ((false == pHandle->Searching)
+             || (((int32_t)hIqref - (int32_t)pHandle->hIqWindow) > (int32_t)pHandle->hLoadBand)
+             || (((int32_t)pHandle->hIqWindow - (int32_t)hIqref) > (int32_t)pHandle->hLoadBand))
+    {
+      /* New operating point: the previous measurement does not compare */
+      pHandle->hIqWindow = hIqref;
+      pHandle->hCount = 0U;
+      pHandle->wPowerSum = 0;
+      pHandle->LastPowerValid = false;
+      pHandle->Searching = true;
+    }
+    else
+    {
+      pHandle->hCount++;
+      if (pHandle->hCount > pHandle->hSettlePeriods)
+      {
+        pHandle->wPowerSum += wPower_mW;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
+      if (pHandle->hCount >= (pHandle->hSettlePeriods + pHandle->hAvgPeriods))
+      {
+        int32_t wPower = pHandle->wPowerSum / (int32_t)pHandle->hAvgPeriods;
+
+        if ((true == pHandle->LastPowerValid) && (wPower > pHandle->wLastPower_mW))
+        {
+          /* The last step raised the losses */
+          pHandle->hDirection = -pHandle->hDirection;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        pHandle->wLastPower_mW = wPower;
+        pHandle->LastPowerValid = true;
+
+        wOffset += (int32_t)pHandle->hDirection * wStep;
+        if ((wOffset > (int32_t)pHandle->hIdMax) || (wOffset < -(int32_t)pHandle->hIdMax))
+        {
+          /* At the bound the search turns back */
+          pHandle->hDirection = -pHandle->hDirection;
+          wOffset += 2 * (int32_t)pHandle->hDirection * wStep;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        pHandle->hIqWindow = hIqref;
+        pHandle->hCount = 0U;
+        pHandle->wPowerSum = 0;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    pHandle->hIdOffset = (int16_t)wOffset;
+#ifdef NULL_PTR_CHECK_LOSS_MINIMIZATION
+  }
+#endif
+}
+
+/**
+  * @brief  Returns the d current offset of the last LMN_Update().
+  * @param  pHandle handler of the current instance of the Loss Minimization component
+  * @retval int16_t d current offset, in s16A
+  */
+__weak int16_t LMN_GetIdOffset(const LMN_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_LOSS_MINIMIZATION
+  return ((MC_NULL == pHandle) ? 0 : pHandle->hIdOffset);
+#else
+  return (pHandle->hIdOffset);
+#endif
+}
+
+/**
+  * @brief  Returns true while the operating point of the last LMN_Update() is
+  *         in the search range.
+  * @param  pHandle handler of the current instance of the Loss Minimization component
+  * @retval bool Searching
+  */
+__weak bool LMN_IsSearching(const LMN_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_LOSS_MINIMIZATION
+  return ((MC_NULL == pHandle) ? false : pHandle->Searching);
+#else
+  return (pHandle->Searching);
+#endif
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
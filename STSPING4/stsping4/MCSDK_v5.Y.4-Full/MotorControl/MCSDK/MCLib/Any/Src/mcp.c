@@ -81,6 +81,18 @@ void MCP_ReceivedPacket(MCP_Handle_t *pHandle)
         break;
       }
 
+      case DEFINE_REG_GROUP:
+      {
+        MCPResponse = RI_DefineRegGroupCommandParser(pHandle);
+        break;
+      }
+
+      case GET_REG_GROUP:
+      {
+        MCPResponse = RI_GetRegGroupCommandParser(pHandle, txSyncFreeSpace);
+        break;
+      }
+
       case START_MOTOR:
       {
         MCPResponse = (MCI_StartMotor(pMCI)) ? MCP_CMD_OK : MCP_CMD_NOK;
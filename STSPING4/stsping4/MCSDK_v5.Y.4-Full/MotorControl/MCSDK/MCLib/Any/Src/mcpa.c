@@ -77,21 +77,55 @@ void MCPA_dataLog(MCPA_Handle_t *pHandle)
             pHandle->HFRateBuff = pHandle->HFRate;
             pHandle->MFRateBuff = pHandle->MFRate;
             pHandle->bufferTxTriggerBuff = pHandle->bufferTxTrigger;
+            pHandle->HFDeltaBuff = pHandle->HFDelta;
             /* We store pointer here, so 4 bytes */
           memcpy(pHandle->dataPtrTableBuff, pHandle->dataPtrTable, (pHandle->HFNum+pHandle->MFNum) * 4U); /* We store pointer here, so 4 bytes */
           memcpy(pHandle->dataSizeTableBuff, pHandle->dataSizeTable, pHandle->HFNum+pHandle->MFNum); /* 1 size byte per ID*/
           }
+          /* Each buffer is decoded on its own: the first deltas are taken from 0 */
+          if (pHandle->HFDeltaBuff != 0U)
+          {
+            memset(pHandle->HFLastTable, 0, pHandle->HFNumBuff * sizeof(int16_t));
+          }
         }
       }
       /* */
       if ((pHandle->bufferIndex > 0U)  && (pHandle->bufferIndex <= pHandle->bufferTxTriggerBuff))
       {
-        logValue16 = (uint16_t *) &pHandle->currentBuffer[pHandle->bufferIndex]; //cstat !MISRAC2012-Rule-11.3
-        for (i = 0U; i < pHandle->HFNumBuff; i++)
+        if (0U == pHandle->HFDeltaBuff)
+        {
+          logValue16 = (uint16_t *) &pHandle->currentBuffer[pHandle->bufferIndex]; //cstat !MISRAC2012-Rule-11.3
+          for (i = 0U; i < pHandle->HFNumBuff; i++)
+          {
+            *logValue16 = *((uint16_t *) pHandle->dataPtrTableBuff[i]); //cstat !MISRAC2012-Rule-11.5
+            logValue16++;
+            pHandle->bufferIndex = pHandle->bufferIndex + 2U;
+          }
+        }
+        else
         {
-          *logValue16 = *((uint16_t *) pHandle->dataPtrTableBuff[i]); //cstat !MISRAC2012-Rule-11.5
-          logValue16++;
-          pHandle->bufferIndex = pHandle->bufferIndex + 2U;
+          uint8_t *logValue8 = &pHandle->currentBuffer[pHandle->bufferIndex];
+
+          for (i = 0U; i < pHandle->HFNumBuff; i++)
+          {
+            int16_t value = *((int16_t *) pHandle->dataPtrTableBuff[i]); //cstat !MISRAC2012-Rule-11.5
+            int32_t delta = (int32_t)value - pHandle->HFLastTable[i];
+
+            if ((delta > -128) && (delta < 128))
+            {
+              *logValue8 = (uint8_t)delta;
+              logValue8++;
+            }
+            else
+            {
+              logValue8[0] = MCPA_DELTA_ESCAPE;
+              logValue8[1] = (uint8_t)value;
+              logValue8[2] = (uint8_t)((uint16_t)value >> 8);
+              logValue8 = &logValue8[3];
+            }
+            pHandle->HFLastTable[i] = value;
+          }
+          pHandle->bufferIndex = (uint16_t)(logValue8 - pHandle->currentBuffer);
         }
         /* MFRateBuff=254 means we dump MF data once per buffer */
         /* MFRateBuff=255 means we do not dump MF data */
@@ -230,7 +264,8 @@ uint8_t MCPA_cfgLog(MCPA_Handle_t *pHandle, uint8_t *cfgdata)
     else
     {
       pHandle->HFRate = *((uint8_t *)&pCfgData[2]);
-      pHandle->HFNum  = *((uint8_t *)&pCfgData[3]);
+      pHandle->HFNum  = *((uint8_t *)&pCfgData[3]) & (uint8_t)~MCPA_CFG_HF_DELTA;
+      pHandle->HFDelta = *((uint8_t *)&pCfgData[3]) & MCPA_CFG_HF_DELTA;
       pHandle->MFRate = *((uint8_t *)&pCfgData[4]);
       pHandle->MFNum =  *((uint8_t *)&pCfgData[5]);
       pCfgData = &pCfgData[6]; /* Start of the HF IDs*/
@@ -241,8 +276,9 @@ uint8_t MCPA_cfgLog(MCPA_Handle_t *pHandle, uint8_t *cfgdata)
       {
          newID = *((uint16_t *) pCfgData); //cstat !MISRAC2012-Rule-11.3
          (void)RI_GetPtrReg (newID, &pHandle->dataPtrTable[i]);
-         /* HF Data are fixed to 2 bytes*/
-         pHandle->dataSizeTable[i] = (i < pHandle->HFNum )? 2:  RI_GetIDSize(newID);
+         /* HF Data are fixed to 2 bytes, 3 for an escaped delta */
+         pHandle->dataSizeTable[i] = (i < pHandle->HFNum ) ? ((pHandle->HFDelta != 0U) ? 3U : 2U)
+                                                           : RI_GetIDSize(newID);
         pCfgData++;/* Point to the next UID */
         pCfgData++;
          logSize = logSize+pHandle->dataSizeTable[i];
@@ -25,6 +25,9 @@
 /* Includes ------------------------------------------------------------------*/
 #include "pid_regulator.h"
 #include "mc_type.h"
+#ifdef PID_FMAC
+#include "pid_fmac_g4xx.h"
+#endif
 
 /** @addtogroup MCSDK
   * @{
@@ -79,6 +82,11 @@ __weak void PID_HandleInit(PID_Handle_t *pHandle)
     pHandle->hKdGain =  pHandle->hDefKdGain;
     pHandle->wIntegralTerm = 0;
     pHandle->wPrevProcessVarError = 0;
+#ifdef PID_FMAC
+    pHandle->FMACCoeffValid = false;
+    pHandle->hFMACPrevError = 0;
+    pHandle->hFMACPrevOutput = 0;
+#endif
 #ifdef NULL_PTR_CHECK_PID_REG
   }
 #endif
@@ -101,6 +109,9 @@ __weak void PID_SetKP(PID_Handle_t *pHandle, int16_t hKpGain)
   {
 #endif
     pHandle->hKpGain = hKpGain;
+#ifdef PID_FMAC
+    pHandle->FMACCoeffValid = false;
+#endif
 #ifdef NULL_PTR_CHECK_PID_REG
   }
 #endif
@@ -123,6 +134,9 @@ __weak void PID_SetKI(PID_Handle_t *pHandle, int16_t hKiGain)
   {
 #endif
     pHandle->hKiGain = hKiGain;
+#ifdef PID_FMAC
+    pHandle->FMACCoeffValid = false;
+#endif
 #ifdef NULL_PTR_CHECK_PID_REG
   }
 #endif
@@ -190,6 +204,8 @@ __weak int16_t PID_GetDefaultKI(PID_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It set a new value into the PI integral term
@@ -208,6 +224,12 @@ __weak void PID_SetIntegralTerm(PID_Handle_t *pHandle, int32_t wIntegralTermValu
   {
 #endif
     pHandle->wIntegralTerm = wIntegralTermValue;
+#ifdef PID_FMAC
+    /* The FMAC regulator keeps its output, that is the integral term for a null error */
+    pHandle->hFMACPrevError = 0;
+    //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+    pHandle->hFMACPrevOutput = (int16_t)__SSAT(wIntegralTermValue >> pHandle->hKiDivisorPOW2, 16);
+#endif
 #ifdef NULL_PTR_CHECK_PID_REG
   }
 #endif
@@ -260,6 +282,9 @@ __weak void PID_SetKPDivisorPOW2(PID_Handle_t *pHandle, uint16_t hKpDivisorPOW2)
 #endif
     pHandle->hKpDivisorPOW2 = hKpDivisorPOW2;
     pHandle->hKpDivisor = (((uint16_t)1) << hKpDivisorPOW2);
+#ifdef PID_FMAC
+    pHandle->FMACCoeffValid = false;
+#endif
 #ifdef NULL_PTR_CHECK_PID_REG
   }
 #endif
@@ -312,6 +337,9 @@ __weak void PID_SetKIDivisorPOW2(PID_Handle_t *pHandle, uint16_t hKiDivisorPOW2)
     uint32_t wKiDiv = (((uint32_t)1) << hKiDivisorPOW2);
     pHandle->hKiDivisorPOW2 = hKiDivisorPOW2;
     pHandle->hKiDivisor = (uint16_t)wKiDiv;
+#ifdef PID_FMAC
+    pHandle->FMACCoeffValid = false;
+#endif
     PID_SetUpperIntegralTermLimit(pHandle, (int32_t)INT16_MAX * (int32_t)wKiDiv);
     PID_SetLowerIntegralTermLimit(pHandle, (int32_t)(-INT16_MAX) * (int32_t)wKiDiv);
 #ifdef NULL_PTR_CHECK_PID_REG
@@ -524,6 +552,8 @@ __weak void PID_SetKDDivisorPOW2(PID_Handle_t *pHandle, uint16_t hKdDivisorPOW2)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function compute the output of a PI regulator sum of its
@@ -541,6 +571,19 @@ __weak int16_t PI_Controller(PID_Handle_t *pHandle, int32_t wProcessVarError)
   {
     returnValue = 0;
   }
+#ifdef PID_FMAC
+  else if (true == pHandle->FMACEnable)
+  {
+    returnValue = PI_FMAC_Controller(pHandle, wProcessVarError);
+  }
+#endif
+  else
+  {
+#elif defined (PID_FMAC)
+  if (true == pHandle->FMACEnable)
+  {
+    returnValue = PI_FMAC_Controller(pHandle, wProcessVarError);
+  }
   else
   {
 #endif
@@ -645,7 +688,7 @@ __weak int16_t PI_Controller(PID_Handle_t *pHandle, int32_t wProcessVarError)
 
     pHandle->wIntegralTerm += wDischarge;
     returnValue = (int16_t)wOutput_32;
-#ifdef NULL_PTR_CHECK_PID_REG
+#if defined (NULL_PTR_CHECK_PID_REG) || defined (PID_FMAC)
   }
 #endif
   return (returnValue);
@@ -657,6 +700,8 @@ __weak int16_t PI_Controller(PID_Handle_t *pHandle, int32_t wProcessVarError)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  This function compute the output of a PID regulator sum of its
@@ -0,0 +1,360 @@
+/**
+  ******************************************************************************
+  * @file    six_step_mode.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement the following features
+  *          of the Six-Step Mode component of the Motor Control SDK:
+  *
+  *           * entry and exit of the six-step operation from the saturation of
+  *             the voltage requested by the current controller
+  *           * selection of the vertex of the hexagon applied over the period
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "six_step_mode.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/**
+  * @defgroup SixStepMode Six-Step Mode
+  * @brief Square wave operation at the top of the speed range
+  *
+  * The current controller keeps running each period, the predictive one or the
+  * PI controllers, and its voltage request is averaged over 2^bFilterShift
+  * periods: the average of the vectors of a finite set controller as well as
+  * the output of the PI controllers. Once that mean stays on the voltage limit
+  * in use, hEnterRatio of it, for hEnterPeriods periods above hMinSpeedDpp, the
+  * mode is entered. The mean request is then rotated to the stator frame each
+  * period and the vertex of the hexagon nearest to it is held over the whole
+  * PWM period. The angle of the request keeps the current regulated: the
+  * controller moves it as it would move a modulated voltage, while its
+  * magnitude is the one of the hexagon. The mode is left as soon as the mean
+  * request falls below hExitRatio of the limit or the speed below
+  * hExitSpeedDpp.
+  *
+  * The vertices are the active vectors of the predictive current controller,
+  * with the same normalisation: the observer and the power measurement receive
+  * the same voltages in both modes, and keep their estimates across the
+  * transitions.
+  *
+  * @{
+  */
+
+/* Private variables ---------------------------------------------------------*/
+/**
+  * @brief Vertices of the hexagon in the alpha/beta frame, normalised to
+  *        INT16_MAX as the active vectors of the predictive current controller.
+  */
+static const alphabeta_t SSM_Vertices[SSM_NB_VERTICES] =
+{
+  {  32767,      0 },   /* 100:   0 deg */
+  {  16384,  28377 },   /* 101:  60 deg */
+  { -16384,  28377 },   /* 001: 120 deg */
+  { -32767,      0 },   /* 011: 180 deg */
+  { -16384, -28377 },   /* 010: 240 deg */
+  {  16384, -28377 },   /* 110: 300 deg */
+};
+
+/**
+  * @brief Switching state of each vertex: bit 0, 1 and 2 for the high side of
+  *        phase A, B and C, as PWMC_SetDwellTimes() takes them.
+  */
+static const uint8_t SSM_SwitchingStates[SSM_NB_VERTICES] = {1U, 5U, 4U, 6U, 2U, 3U};
+
+/**
+  * @brief  Initializes the component, out of the mode.
+  * @param  pHandle handler of the current instance of the Six-Step Mode component
+  */
+__weak void SSM_Init(SSM_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->hEntries = 0U;
+    SSM_Clear(pHandle);
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  }
+#endif
+}
+
+/**
+  * @brief  Leaves the mode and clears the mean request. The number of entries
+  *         is kept.
+  * @param  pHandle handler of the current instance of the Six-Step Mode component
+  */
+__weak void SSM_Clear(SSM_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    pHandle->wVqSum = 0;
+    pHandle->wVdSum = 0;
+    pHandle->hSatCount = 0U;
+    pHandle->bVertex = SSM_NB_VERTICES;
+    pHandle->Active = false;
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  }
+#endif
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Averages the voltage requested by the current controller, then
+  *         enters or leaves the mode. It must be called by the high frequency
+  *         task once the current controller has run.
+  * @param  pHandle handler of the current instance of the Six-Step Mode component
+  * @param  Vqd voltage requested by the current controller, before the circle
+  *         limitation
+  * @param  hMaxModule voltage limit of the current controller in use
+  * @param  hElSpeedDpp electrical speed, in dpp
+  * @retval bool True if the vertices are to be applied in this period
+  */
+__weak bool SSM_Update(SSM_Handle_t *pHandle, qd_t Vqd, uint16_t hMaxModule, int16_t hElSpeedDpp)
+{
+  bool Active = false;
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    qd_t Request;
+    uint32_t wModSq;
+    uint32_t wLimit;
+    int32_t wSpeed = (hElSpeedDpp < 0) ? -(int32_t)hElSpeedDpp : (int32_t)hElSpeedDpp;
+
+    pHandle->wVqSum += (int32_t)Vqd.q - (pHandle->wVqSum >> pHandle->bFilterShift);
+    pHandle->wVdSum += (int32_t)Vqd.d - (pHandle->wVdSum >> pHandle->bFilterShift);
+    Request = SSM_GetRequest(pHandle);
+    wModSq = (uint32_t)((int32_t)Request.q * Request.q) + (uint32_t)((int32_t)Request.d * Request.d);
+
+    if (true == pHandle->Active)
+    {
+      wLimit = ((uint32_t)hMaxModule * pHandle->hExitRatio) >> 15;
+      if ((wSpeed < (int32_t)pHandle->hExitSpeedDpp) || (wModSq < (wLimit * wLimit)))
+      {
+        /* Back to the modulated voltage of the current controller */
+        pHandle->Active = false;
+        pHandle->bVertex = SSM_NB_VERTICES;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      wLimit = ((uint32_t)hMaxModule * pHandle->hEnterRatio) >> 15;
+      if ((wSpeed >= (int32_t)pHandle->hMinSpeedDpp) && (wModSq >= (wLimit * wLimit)))
+      {
+        pHandle->hSatCount++;
+        if (pHandle->hSatCount >= pHandle->hEnterPeriods)
+        {
+          pHandle->hSatCount = 0U;
+          pHandle->bVertex = SSM_NB_VERTICES;
+          pHandle->hEntries++;
+          pHandle->Active = true;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+      }
+      else
+      {
+        pHandle->hSatCount = 0U;
+      }
+    }
+    Active = pHandle->Active;
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  }
+#endif
+  return (Active);
+}
+
+/**
+  * @brief  Returns the mean voltage requested by the current controller.
+  * @param  pHandle handler of the current instance of the Six-Step Mode component
+  * @retval qd_t Mean requested voltage
+  */
+__weak qd_t SSM_GetRequest(const SSM_Handle_t *pHandle)
+{
+  qd_t Request = {0, 0};
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    Request.q = (int16_t)(pHandle->wVqSum >> pHandle->bFilterShift);
+    Request.d = (int16_t)(pHandle->wVdSum >> pHandle->bFilterShift);
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  }
+#endif
+  return (Request);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Selects the vertex whose projection of the requested voltage is the
+  *         largest. The vertex applied is kept until the next one is nearer by
+  *         2^-bHystShift of its projection, so that the noise of the request
+  *         around the boundary of two sectors does not toggle the legs.
+  * @param  pHandle handler of the current instance of the Six-Step Mode component
+  * @param  Vab mean requested voltage, in the alpha/beta frame of the period
+  * @retval uint8_t Switching state of the vertex
+  */
+__weak uint8_t SSM_SelectVertex(SSM_Handle_t *pHandle, alphabeta_t Vab)
+{
+  uint8_t bState = 0U;
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    int32_t wProj[SSM_NB_VERTICES];
+    uint8_t bBest = 0U;
+    uint8_t i;
+
+    for (i = 0U; i < SSM_NB_VERTICES; i++)
+    {
+      wProj[i] = (((int32_t)Vab.alpha * SSM_Vertices[i].alpha) + ((int32_t)Vab.beta * SSM_Vertices[i].beta)) >> 15;
+      bBest = (wProj[i] > wProj[bBest]) ? i : bBest;
+    }
+    if (pHandle->bVertex >= SSM_NB_VERTICES)
+    {
+      /* First period of the mode */
+      pHandle->bVertex = bBest;
+    }
+    else if ((wProj[bBest] - wProj[pHandle->bVertex]) > (wProj[bBest] >> pHandle->bHystShift))
+    {
+      pHandle->bVertex = bBest;
+    }
+    else
+    {
+      /* Nothing to do, the vertex is kept */
+    }
+    bState = SSM_SwitchingStates[pHandle->bVertex];
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  }
+#endif
+  return (bState);
+}
+
+/**
+  * @brief  Returns the voltage of the vertex applied, zero out of the mode.
+  * @param  pHandle handler of the current instance of the Six-Step Mode component
+  * @retval alphabeta_t Voltage, in the normalisation of the predictive controller
+  */
+__weak alphabeta_t SSM_GetVoltage(const SSM_Handle_t *pHandle)
+{
+  alphabeta_t Voltage = {0, 0};
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+#endif
+    if (pHandle->bVertex < SSM_NB_VERTICES)
+    {
+      Voltage = SSM_Vertices[pHandle->bVertex];
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  }
+#endif
+  return (Voltage);
+}
+
+/**
+  * @brief  Returns true while the vertices are applied.
+  * @param  pHandle handler of the current instance of the Six-Step Mode component
+  * @retval bool Mode state
+  */
+__weak bool SSM_IsActive(const SSM_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  return ((MC_NULL == pHandle) ? false : pHandle->Active);
+#else
+  return (pHandle->Active);
+#endif
+}
+
+/**
+  * @brief  Returns the number of times the mode was entered since the start
+  *         up. It wraps around.
+  * @param  pHandle handler of the current instance of the Six-Step Mode component
+  * @retval uint16_t Entries
+  */
+__weak uint16_t SSM_GetEntries(const SSM_Handle_t *pHandle)
+{
+#ifdef NULL_PTR_CHECK_SIX_STEP_MODE
+  return ((MC_NULL == pHandle) ? 0U : pHandle->hEntries);
+#else
+  return (pHandle->hEntries);
+#endif
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2019 STMicroelectronics *****END OF FILE****/
@@ -52,6 +52,8 @@
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It returns the last computed rotor electrical angle, expressed in
@@ -124,6 +126,8 @@ __weak int16_t SPD_GetElSpeedDpp(const SpeednPosFdbk_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  It returns the last instantaneous computed electrical speed, expressed in Dpp.
@@ -142,6 +146,53 @@ __weak int16_t SPD_GetInstElSpeedDpp(const SpeednPosFdbk_Handle_t *pHandle)
 #endif
 }
 
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  It returns the rotor electrical angle, expressed in s16degrees,
+  *         extrapolated with the instantaneous electrical speed to an instant
+  *         that follows the last angle computation by @p hFraction.
+  *
+  * The sampling instant of the currents and the application instant of the
+  * voltage are each reached with their own @p hFraction, one multiply each.
+  * @param  pHandle: handler of the current instance of the SpeednPosFdbk component
+  * @param  hFraction: time elapsed since the last angle computation, in
+  *         1/#SPD_PERIOD_FRACTION of control period. It may exceed one period
+  * @retval int16_t rotor electrical angle (s16degrees)
+  */
+__weak int16_t SPD_GetElAngleAt(const SpeednPosFdbk_Handle_t *pHandle, int16_t hFraction)
+{
+  int16_t hElAngle;
+#ifdef NULL_PTR_SPD_POS_FBK
+  if (MC_NULL == pHandle)
+  {
+    hElAngle = 0;
+  }
+  else
+  {
+#endif
+    int32_t wDelta = (int32_t)pHandle->InstantaneousElSpeedDpp * hFraction;
+#ifndef FULL_MISRA_C_COMPLIANCY_SPD_POS_FBK
+    //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+    wDelta = wDelta >> SPD_PERIOD_FRACTION_POW2;
+#else
+    wDelta = wDelta / SPD_PERIOD_FRACTION;
+#endif
+    /* The angle wraps around on the s16degree circle */
+    hElAngle = (int16_t)((uint16_t)pHandle->hElAngle + (uint16_t)wDelta);
+#ifdef NULL_PTR_SPD_POS_FBK
+  }
+#endif
+  return (hElAngle);
+}
+
 /**
   * @brief  It returns the result of the last reliability check performed.
   *         Reliability is measured with reference to parameters
@@ -172,6 +223,8 @@ __weak bool SPD_Check(const SpeednPosFdbk_Handle_t *pHandle)
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 
 /**
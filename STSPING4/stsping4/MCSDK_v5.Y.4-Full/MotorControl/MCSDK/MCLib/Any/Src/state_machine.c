@@ -361,6 +361,8 @@ __weak State_t STM_FaultProcessing(STM_Handle_t *pHandle, uint16_t hSetErrors, u
 #elif defined (__CC_ARM) || defined(__GNUC__)
 __attribute__((section(".ccmram")))
 #endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
 #endif
 /**
   * @brief  Returns the current state machine state
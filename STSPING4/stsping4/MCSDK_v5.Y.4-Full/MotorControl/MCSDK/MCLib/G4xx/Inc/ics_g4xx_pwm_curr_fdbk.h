@@ -62,13 +62,26 @@ typedef const struct
   GPIO_TypeDef *pwm_en_v_port;     /*!< Channel 2N (low side) GPIO output*/
   GPIO_TypeDef *pwm_en_w_port;     /*!< Channel 3N (low side)  GPIO output */
 
-  uint32_t ADCConfig1; /*!< values of JSQR for first ADC for 6 sectors */
-  uint32_t ADCConfig2; /*!< values of JSQR for Second ADC for 6 sectors */
+  uint32_t ADCConfig1; /*!< value of JSQR for first ADC, without the trigger edge */
+  uint32_t ADCConfig2; /*!< value of JSQR for Second ADC, without the trigger edge */
 
   uint16_t pwm_en_u_pin;                    /*!< Channel 1N (low side) GPIO output pin */
   uint16_t pwm_en_v_pin;                    /*!< Channel 2N (low side) GPIO output pin */
   uint16_t pwm_en_w_pin;                    /*!< Channel 3N (low side)  GPIO output pin */
 
+  /* Current sampling parameters -----------------------------------------------*/
+  uint16_t SamplingPoint;             /*!< Instant of the simultaneous sampling of
+                                            the two sensors in the PWM period,
+                                            express in number of TIM clocks from
+                                            the update event, from 0 to the PWM
+                                            period. Half PWM period minus one is
+                                            the middle of the zero vector.*/
+  uint16_t SamplingPointState;        /*!< Instant of the sampling, in the same
+                                            unit, of an active switching state
+                                            applied by PWMC_SetSwitchingState().
+                                            The zero states are sampled at
+                                            SamplingPoint.*/
+
   /* PWM Driving signals initialization ----------------------------------------*/
   LowSideOutputsFunction_t LowSideOutputs; /*!< Low side or enabling signals
                                                 generation method are defined
@@ -115,6 +128,11 @@ typedef struct
   uint32_t PhaseAOffset;   /*!< Offset of Phase A current sensing network  */
   uint32_t PhaseBOffset;   /*!< Offset of Phase B current sensing network  */
   uint16_t Half_PWMPeriod;  /*!< Half PWM Period in timer clock counts */
+  uint16_t SamplingPoint;       /*!< Instant of the sampling of the modulated periods,
+                                     see ICS_Params_t::SamplingPoint */
+  uint16_t SamplingPointState;  /*!< Instant of the sampling of the active switching
+                                     states, see ICS_Params_t::SamplingPointState */
+  uint16_t ADC_ExternalPolarityInjected; /*!< Trigger edge of the next sampling */
   volatile uint8_t PolarizationCounter;
 
   bool OverCurrentFlag;     /*!< This flag is set when an overcurrent occurs.*/
@@ -174,6 +192,19 @@ void ICS_SwitchOffPWM(PWMC_Handle_t *pHdl);
   */
 uint16_t ICS_WriteTIMRegisters(PWMC_Handle_t *pHdl);
 
+/**
+  * Configure the ADC for the current sampling of a switching state
+  * applied by PWMC_SetSwitchingState(), at the instant of its kind
+  * of state, and write the TIMx registers.
+  */
+uint16_t ICS_SetADCSampPointState(PWMC_Handle_t *pHdl);
+
+/**
+  * It sets the sampling instants of the modulated periods and of the
+  * active switching states, taken into account from the next period.
+  */
+void ICS_SetSamplingPoints(PWMC_ICS_Handle_t *pHandle, uint16_t hSamplingPoint, uint16_t hSamplingPointState);
+
 
 /**
   *  It contains the TIMx Update event interrupt
@@ -0,0 +1,270 @@
+/**
+  ******************************************************************************
+  * @file    r1_g4xx_pwm_curr_fdbk.h
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file contains all definitions and functions prototypes for the
+  *          R1_G4XX_pwm_curr_fdbk component of the Motor Control SDK.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  * @ingroup R1_G4XX_pwm_curr_fdbk
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef R1_G4XX_PWMNCURRFDBK_H
+#define R1_G4XX_PWMNCURRFDBK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "pwm_curr_fdbk.h"
+
+/* Exported defines --------------------------------------------------------*/
+#define NONE    ((uint8_t)(0x00))
+#define EXT_MODE  ((uint8_t)(0x01))
+#define INT_MODE  ((uint8_t)(0x02))
+
+/* Content of a conversion of the shunt, PWMC_R1_Handle_t::Sample */
+#define R1_SAMPLE_NONE  ((uint8_t)0x00) /* Conversion that only completes the sequence */
+#define R1_SAMPLE_IA    ((uint8_t)0x01) /* Current of phase A */
+#define R1_SAMPLE_IB    ((uint8_t)0x02) /* Current of phase B */
+#define R1_SAMPLE_IC    ((uint8_t)0x03) /* Current of phase C */
+#define R1_SAMPLE_NEG   ((uint8_t)0x04) /* Flag: opposite of the current of the phase */
+#define R1_SAMPLE_PHASE ((uint8_t)0x03) /* Mask of the phase */
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup pwm_curr_fdbk
+  * @{
+  */
+
+/** @addtogroup R1_G4XX_pwm_curr_fdbk
+  * @{
+  */
+
+/* Exported types ------------------------------------------------------- */
+
+/**
+  * @brief  R1_G4XX_pwm_curr_fdbk component parameters definition
+  */
+typedef const struct
+{
+  /* HW IP involved -----------------------------*/
+  ADC_TypeDef *ADCx;               /*!< ADC peripheral converting the shunt.*/
+  TIM_TypeDef *TIMx;               /*!< timer used for PWM generation.*/
+  OPAMP_TypeDef *OPAMPx;           /*!< Internal OPAMP amplifying the shunt.
+                                       It must be MC_NULL if an external amplifier is used.*/
+  COMP_TypeDef *CompOCPSelection;  /*!< Internal comparator used for over current protection.*/
+  COMP_TypeDef *CompOVPSelection;  /*!< Internal comparator used for Over Voltage protection.*/
+  GPIO_TypeDef *pwm_en_u_port;     /*!< Channel 1N (low side) GPIO output */
+  GPIO_TypeDef *pwm_en_v_port;     /*!< Channel 2N (low side) GPIO output*/
+  GPIO_TypeDef *pwm_en_w_port;     /*!< Channel 3N (low side)  GPIO output */
+  DAC_TypeDef   *DAC_OCP_Selection; /*!< DAC used for over current protection.*/
+  DAC_TypeDef   *DAC_OVP_Selection; /*!< DAC used for Over Voltage protection.*/
+  uint32_t DAC_Channel_OCP;       /*!< DAC channel used for over current protection.*/
+  uint32_t DAC_Channel_OVP;       /*!< DAC channel used for Over Voltage protection.*/
+  uint32_t ADCConfig;             /*!< value of JSQR: two conversions of the shunt
+                                       channel triggered by TIMx TRGO2, without the
+                                       trigger edge */
+
+  uint16_t pwm_en_u_pin;                    /*!< Channel 1N (low side) GPIO output pin */
+  uint16_t pwm_en_v_pin;                    /*!< Channel 2N (low side) GPIO output pin */
+  uint16_t pwm_en_w_pin;                    /*!< Channel 3N (low side)  GPIO output pin */
+
+  /* PWM generation parameters --------------------------------------------------*/
+
+  uint16_t Tbefore;                   /*!< Time between the trigger and the end of
+                                            the sampling, express in number of TIM
+                                            clocks.*/
+  uint16_t TMin;                      /*!< Shortest window in which the bus current
+                                            can be sampled: dead time plus max value
+                                            between rise time and noise time, plus
+                                            Tbefore. It is also the shortest distance
+                                            between the two triggers, and must be
+                                            longer than Tbefore and than a conversion.
+                                            Express in number of TIM clocks.*/
+
+  /* DAC settings --------------------------------------------------------------*/
+  uint16_t DAC_OCP_Threshold;        /*!< Value of analog reference expressed
+                                           as 16bit unsigned integer.
+                                           Ex. 0 = 0V 65536 = VDD_DAC.*/
+  uint16_t DAC_OVP_Threshold;        /*!< Value of analog reference expressed
+                                           as 16bit unsigned integer.
+                                           Ex. 0 = 0V 65536 = VDD_DAC.*/
+  /* PWM Driving signals initialization ----------------------------------------*/
+  LowSideOutputsFunction_t LowSideOutputs; /*!< Low side or enabling signals
+                                                generation method are defined
+                                                here.*/
+
+  uint8_t  RepetitionCounter;         /*!< It expresses the number of PWM
+                                            periods to be elapsed before compare
+                                            registers are updated again. In
+                                            particular:
+                                            RepetitionCounter= (2* #PWM periods)-1*/
+  /* Emergency input (BKIN2) signal initialization -----------------------------*/
+  uint8_t BKIN2Mode;                 /*!< It defines the modality of emergency
+                                           input 2. It must be any of the
+                                           the following:
+                                           NONE - feature disabled.
+                                           INT_MODE - Internal comparator used
+                                           as source of emergency event.
+                                           EXT_MODE - External comparator used
+                                           as source of emergency event.*/
+
+  /* Internal COMP settings ----------------------------------------------------*/
+  uint8_t       CompOCPInvInput_MODE;     /*!< COMPx inverting input mode. It must be either
+                                                equal to EXT_MODE or INT_MODE. */
+  uint8_t       CompOVPInvInput_MODE;     /*!< COMPx inverting input mode. It must be either
+                                                equal to EXT_MODE or INT_MODE. */
+
+} R1_Params_t, *pR1_Params_t;
+
+/**
+  * @brief  This structure is used to handle an instance of the
+  *         r1_g4xx_pwm_curr_fdbk component.
+  */
+typedef struct
+{
+  PWMC_Handle_t _Super;     /*!<   */
+  uint32_t PhaseOffset;     /*!< Offset of the bus current sensing network  */
+  uint16_t Half_PWMPeriod;  /*!< Half PWM Period in timer clock counts */
+  volatile uint8_t PolarizationCounter;
+  uint8_t Sample[2];        /*!< R1_SAMPLE_xxx content of the two conversions of
+                                 the PWM period */
+  bool OverCurrentFlag;     /*!< This flag is set when an overcurrent occurs.*/
+  bool OverVoltageFlag;     /*!< This flag is set when an overvoltage occurs.*/
+  bool BrakeActionLock;     /*!< This flag is set to avoid that brake action is
+                                 interrupted.*/
+  pR1_Params_t pParams_str;
+  bool ADCRegularLocked; /* Cut 2.2 patch*/
+} PWMC_R1_Handle_t;
+
+
+/* Exported functions ------------------------------------------------------- */
+
+/**
+  * It initializes TIMx, ADC, OPAMP and comparators for current reading
+  * in single shunt topology using STM32G4
+  */
+void R1_Init(PWMC_R1_Handle_t *pHandle);
+
+/**
+  * It starts the initialization: OPAMP, comparators and the calibration of the ADC,
+  * that runs while the caller goes on
+  */
+void R1_StartInit(PWMC_R1_Handle_t *pHandle);
+
+/**
+  * It completes the initialization started by R1_StartInit: enables the ADC
+  * once calibrated and initializes TIMx
+  */
+void R1_CompleteInit(PWMC_R1_Handle_t *pHandle);
+
+/**
+  * It stores into the handle the voltage present on the bus current
+  * feedback analog channel when no current is flowin into the motor
+  */
+void R1_CurrentReadingPolarization(PWMC_Handle_t *pHdl);
+
+/**
+  * It computes and return latest converted motor phase currents motor
+  *
+  */
+void R1_GetPhaseCurrents(PWMC_Handle_t *pHdl, ab_t *Iab);
+
+/**
+  * It turns on low sides switches. This function is intended to be
+  * used for charging boot capacitors of driving section. It has to be
+  * called each motor start-up when using high voltage drivers
+  */
+void R1_TurnOnLowSides(PWMC_Handle_t *pHdl);
+
+/**
+  * It enables PWM generation on the proper Timer peripheral acting on MOE
+  * bit
+  */
+void R1_SwitchOnPWM(PWMC_Handle_t *pHdl);
+
+/**
+  * It disables PWM generation on the proper Timer peripheral acting on
+  * MOE bit
+  */
+void R1_SwitchOffPWM(PWMC_Handle_t *pHdl);
+
+/**
+  * Configure the ADC for the current sampling
+  * It means set the two sampling points via TIMx_Ch5 and TIMx_Ch6 values
+  * and the phase currents they convert.
+  * And call the WriteTIMRegisters method.
+  */
+uint16_t R1_SetADCSampPointSectX(PWMC_Handle_t *pHdl);
+
+/**
+  * Configure the ADC for the current sampling of a switching state
+  * applied by PWMC_SetSwitchingState(), in its active window.
+  * And call the WriteTIMRegisters method.
+  */
+uint16_t R1_SetADCSampPointState(PWMC_Handle_t *pHdl);
+
+/**
+  *  It contains the TIMx Update event interrupt
+  */
+void *R1_TIMx_UP_IRQHandler(PWMC_R1_Handle_t *pHandle);
+
+/**
+  *  It contains the TIMx Break2 event interrupt
+  */
+void *R1_BRK2_IRQHandler(PWMC_R1_Handle_t *pHandle);
+
+/**
+  *  It contains the TIMx Break1 event interrupt
+  */
+void *R1_BRK_IRQHandler(PWMC_R1_Handle_t *pHandle);
+
+/**
+  * It is used to check if an overcurrent occurred since last call.
+  */
+uint16_t R1_IsOverCurrentOccurred(PWMC_Handle_t *pHdl);
+
+/**
+  * It sets the calibrated offset.
+  */
+void R1_SetOffsetCalib(PWMC_Handle_t *pHdl, PolarizationOffsets_t *offsets);
+
+/**
+  * It reads the calibrated offsets.
+  */
+void R1_GetOffsetCalib(PWMC_Handle_t *pHdl, PolarizationOffsets_t *offsets);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif /* __cpluplus */
+
+#endif /*R1_G4XX_PWMNCURRFDBK_H*/
+
+/************************ (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -114,6 +114,21 @@ else
 @}
   */
 
+/**
+@defgroup stspin32g4_Queue Transaction Queue
+@brief Function and definitions to access I2C registers of STSPIN32G4 without blocking
+@details The transactions are queued and run one after the other by the I2C interrupts,
+so that the caller never waits for the bus. A batch of updates of protected registers
+is run as unlock, read-modify-write-verify of each register and lock: when one of its
+transactions fails the next ones are skipped, with the exception of the lock.
+\n Each register access is a sequential transfer of the HAL, without any wait on the bus.
+The I2C3 event and error interrupts must be enabled, and the HAL I2C master callbacks forward
+the end of the transfers with STSPIN32G4_txCplt(), STSPIN32G4_rxCplt() and STSPIN32G4_transferError().
+\n The blocking functions return HAL_BUSY while the queue is running.
+@{
+@}
+  */
+
 /**
 @}
   */
@@ -269,6 +284,51 @@ typedef struct
   uint8_t lock:1;       /**< If 1 the protected registers are locked and cannot be modified. */
 } STSPIN32G4_statusTypeDef;
 
+/**
+@ingroup stspin32g4_Queue
+@{
+  */
+
+#define STSPIN32G4_QUEUE_SIZE  (16U)  /**< Number of transactions of the queue, a power of two */
+
+/**
+@brief Transactions of the queue
+  */
+typedef enum
+{
+  STSPIN32G4_TXN_STATUS = 0,  /**< Read of the status register into the polled status */
+  STSPIN32G4_TXN_WRITE,       /**< Write of a register */
+  STSPIN32G4_TXN_UPDATE,      /**< Read of a register, write of its masked bits and verification of the read back value */
+  STSPIN32G4_TXN_UNLOCK,      /**< Unlock of the protected registers */
+  STSPIN32G4_TXN_LOCK         /**< Lock of the protected registers, run even when the batch failed */
+} STSPIN32G4_txnType;
+
+/**
+@brief Transaction of the queue
+  */
+typedef struct
+{
+  uint8_t type;       /**< STSPIN32G4_txnType */
+  uint8_t regAddr;    /**< Address of the register written or updated */
+  uint8_t mask;       /**< Bits of the register replaced by an update */
+  uint8_t value;      /**< Value written, or bits written by an update */
+  bool last;          /**< Last transaction of its batch */
+} STSPIN32G4_txnTypeDef;
+
+/**
+@brief Update of a register to be used with function STSPIN32G4_queueUpdates()
+  */
+typedef struct
+{
+  uint8_t regAddr;    /**< Address of the register */
+  uint8_t mask;       /**< Bits of the register replaced */
+  uint8_t value;      /**< Value of the replaced bits */
+} STSPIN32G4_regUpdateTypeDef;
+
+/**
+@}
+  */
+
 /**
 @brief Handler of STSPIN32G4 driver to be used with all driver functions
 @see STSPIN32G4_init() for example code
@@ -277,6 +337,21 @@ typedef struct
 typedef struct
 {
   I2C_HandleTypeDef *i2cHdl;    /**< Handler to i2c3 */
+
+  STSPIN32G4_txnTypeDef queue[STSPIN32G4_QUEUE_SIZE]; /**< Transactions waiting for the I2C */
+  volatile uint8_t head;        /**< Slot of the next queued transaction */
+  volatile uint8_t tail;        /**< Slot of the running transaction */
+  volatile bool running;        /**< True while an I2C transfer of the queue is on going */
+  uint8_t phase;                /**< Register access of the running transaction */
+  bool reading;                 /**< The register address of a read has been sent, its value is to be received */
+  uint8_t buffer[2];            /**< Register address and value of the running write */
+  uint8_t data;                 /**< Value of the last register read */
+  uint8_t written;              /**< Value written by the running update */
+  bool batchFailed;             /**< A transaction of the running batch failed */
+  volatile uint16_t batchErrors; /**< Number of failed batches */
+  volatile bool statusPending;  /**< A status read is queued */
+  volatile bool statusValid;    /**< The polled status has been read at least once */
+  STSPIN32G4_statusTypeDef polledStatus; /**< Status register of the last status read */
 } STSPIN32G4_HandleTypeDef;
 
 
@@ -545,6 +620,83 @@ HAL_StatusTypeDef STSPIN32G4_writeReg(STSPIN32G4_HandleTypeDef *hdl, uint8_t reg
   */
 HAL_StatusTypeDef STSPIN32G4_writeVerifyReg(STSPIN32G4_HandleTypeDef *hdl, uint8_t regAddr, uint8_t value);
 
+/**
+@brief Queue a batch of register updates
+@details Each update reads the register, replaces the bits of @p mask and verifies the read back value.
+@param [in] hdl Driver handler.
+@param [in] updates Updates of the batch.
+@param [in] nbUpdates Number of updates of the batch.
+@param [in] protectedRegs If true the batch is run between an unlock and a lock of the protected registers.
+@return HAL_BUSY if the queue has no room for the whole batch, nothing is then queued, otherwise HAL_OK.
+@ingroup stspin32g4_Queue
+  */
+HAL_StatusTypeDef STSPIN32G4_queueUpdates(STSPIN32G4_HandleTypeDef *hdl, const STSPIN32G4_regUpdateTypeDef *updates,
+                                          uint8_t nbUpdates, bool protectedRegs);
+
+/**
+@brief Queue a batch of one register write
+@param [in] hdl Driver handler.
+@param [in] regAddr Address of the register to write.
+@param [in] value Content to write in the register.
+@param [in] protectedReg If true the write is run between an unlock and a lock of the protected registers.
+@return HAL_BUSY if the queue has no room for the batch otherwise HAL_OK.
+@ingroup stspin32g4_Queue
+  */
+HAL_StatusTypeDef STSPIN32G4_queueWrite(STSPIN32G4_HandleTypeDef *hdl, uint8_t regAddr, uint8_t value, bool protectedReg);
+
+/**
+@brief Queue a read of the status register, unless one is already queued
+@details To be called periodically. The result is returned by STSPIN32G4_getPolledStatus().
+@param [in] hdl Driver handler.
+@return HAL_BUSY if the queue has no room otherwise HAL_OK.
+@ingroup stspin32g4_Queue
+  */
+HAL_StatusTypeDef STSPIN32G4_pollStatus(STSPIN32G4_HandleTypeDef *hdl);
+
+/**
+@brief Get the status register of the last read queued by STSPIN32G4_pollStatus()
+@param [in] hdl Driver handler
+@param [out] status Value of the status register
+@return HAL_ERROR if the status has not been read yet otherwise HAL_OK.
+@ingroup stspin32g4_Queue
+  */
+HAL_StatusTypeDef STSPIN32G4_getPolledStatus(STSPIN32G4_HandleTypeDef *hdl, STSPIN32G4_statusTypeDef *status);
+
+/**
+@brief Get the number of batches of the queue that failed
+@param [in] hdl Driver handler
+@return Number of failed batches since STSPIN32G4_init().
+@ingroup stspin32g4_Queue
+  */
+uint16_t STSPIN32G4_getBatchErrors(STSPIN32G4_HandleTypeDef *hdl);
+
+/**
+@brief Returns true while transactions are queued
+@param [in] hdl Driver handler
+@ingroup stspin32g4_Queue
+  */
+bool STSPIN32G4_isQueueBusy(STSPIN32G4_HandleTypeDef *hdl);
+
+/**
+@brief End of an I2C transmit of the queue, to be called by the I2C master transmit complete callback
+@param [in] hdl Driver handler
+@ingroup stspin32g4_Queue
+  */
+void STSPIN32G4_txCplt(STSPIN32G4_HandleTypeDef *hdl);
+
+/**
+@brief End of an I2C receive of the queue, to be called by the I2C master receive complete callback
+@param [in] hdl Driver handler
+@ingroup stspin32g4_Queue
+  */
+void STSPIN32G4_rxCplt(STSPIN32G4_HandleTypeDef *hdl);
+
+/**
+@brief Failure of an I2C transfer of the queue, to be called by the I2C error callback
+@param [in] hdl Driver handler
+@ingroup stspin32g4_Queue
+  */
+void STSPIN32G4_transferError(STSPIN32G4_HandleTypeDef *hdl);
 
 #endif //#define STSPIN32G4
 
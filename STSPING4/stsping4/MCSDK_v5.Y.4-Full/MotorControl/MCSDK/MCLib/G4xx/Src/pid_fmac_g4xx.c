@@ -0,0 +1,284 @@
+/**
+  ******************************************************************************
+  * @file    pid_fmac_g4xx.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides the PI regulator computed by the FMAC of the
+  *          STM32G4, selected with PID_FMAC:
+  *           + FMAC initialization
+  *           + PI regulator in IIR direct form 1
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "pid_fmac_g4xx.h"
+#include "mc_type.h"
+
+#ifdef PID_FMAC
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup PIDRegulator
+  * @{
+  */
+
+/**
+  * @defgroup PID_FMAC_G4XX PI Regulator on the G4 FMAC
+  *
+  * @brief PI regulator of the PID component computed by the FMAC of the STM32G4
+  *
+  * PI_Controller() calls PI_FMAC_Controller() for the handles whose FMACEnable is set, the
+  * current and speed regulators of mc_config.c. The regulator is written in its incremental
+  * form, an IIR filter of the error:
+  *
+  * @f[
+  * y(k) = y(k-1) + (K_p + K_i) e(k) - K_p e(k-1) + r(k-1)
+  * @f]
+  *
+  * with @f$K_p = K_{pg} / K_{pd}@f$ and @f$K_i = K_{ig} / K_{id}@f$. The FMAC truncates its
+  * output to whole digits. @f$r(k-1)@f$, the last feed forward tap, is the fraction of a
+  * digit truncated by the previous call, a fractional accumulator: the errors whose
+  * @f$K_i e@f$ is below one digit are integrated over the calls, as the 32 bit integral term
+  * of the software regulator does. It is the low bits of the sum of the FMAC, computed again
+  * in 32 bits after the call, and starts at half a digit, so that the output is rounded.
+  * The state of the regulator, @f$e(k-1)@f$, @f$r(k-1)@f$ and @f$y(k-1)@f$, is kept in the
+  * handle and preloaded in the X1 and Y buffers at each call, with the coefficients, so that the
+  * current and speed regulators, and the other users of the FMAC, share it: each user
+  * configures its buffers and stops the FMAC when done. @f$y(k-1)@f$ is the output after the
+  * output limits, which makes the anti wind-up: the output limits are also the ones of the
+  * integral term, the integral limits of the handle are not used.
+  *
+  * Gains of @f$2^{PID\_FMAC\_MAX\_SHIFT}@f$ and more do not fit in the coefficients: the
+  * regulator then goes back to PI_Controller() in software, from its last output.
+  *
+  * @{
+  */
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Gain of a regulator in q15, 2^15 being 1 */
+static int32_t PID_FMAC_GainQ15(int16_t hGain, uint16_t hDivisorPOW2)
+{
+  int32_t wGain;
+
+  if (hDivisorPOW2 <= 15U)
+  {
+    wGain = (int32_t)hGain * (int32_t)(1UL << (15U - hDivisorPOW2));
+  }
+  else
+  {
+    //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+    wGain = ((int32_t)hGain + (int32_t)(1UL << (hDivisorPOW2 - 16U))) >> (hDivisorPOW2 - 15U);
+  }
+  return (wGain);
+}
+
+/* Coefficients of the FMAC from the gains: the smallest gain R of the FMAC that fits them
+   in q1.15, for their resolution. bFMACShift is left to zero if none does. */
+static void PID_FMAC_SetCoefficients(PID_Handle_t *pHandle)
+{
+  int32_t wKp = PID_FMAC_GainQ15(pHandle->hKpGain, pHandle->hKpDivisorPOW2);
+  int32_t wKi = PID_FMAC_GainQ15(pHandle->hKiGain, pHandle->hKiDivisorPOW2);
+  int32_t wB0 = wKp + wKi;
+  int32_t wB1 = -wKp;
+  uint8_t bShift = 1U;
+
+  pHandle->bFMACShift = 0U;
+  while ((0U == pHandle->bFMACShift) && (bShift <= PID_FMAC_MAX_SHIFT))
+  {
+    int32_t wRound = (int32_t)(1UL << (bShift - 1U));
+    //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+    int32_t wB0R = (wB0 + wRound) >> bShift;
+    //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+    int32_t wB1R = (wB1 + wRound) >> bShift;
+
+    if ((wB0R <= INT16_MAX) && (wB0R >= INT16_MIN) && (wB1R <= INT16_MAX) && (wB1R >= INT16_MIN))
+    {
+      pHandle->hFMACCoeff[0] = (int16_t)wB0R;
+      pHandle->hFMACCoeff[1] = (int16_t)wB1R;
+      /* Times the fraction, in 2^(R-15) digits of the output, from half a digit */
+      pHandle->hFMACCoeff[2] = 1;
+      pHandle->hFMACCoeff[3] = (int16_t)(1UL << (15U - bShift));
+      pHandle->hFMACFraction = (uint16_t)(1UL << (14U - bShift));
+      pHandle->bFMACShift = bShift;
+    }
+    else
+    {
+      bShift++;
+    }
+  }
+  pHandle->FMACCoeffValid = true;
+}
+
+/* Waits for the end of a load of the FMAC buffers */
+static inline void PID_FMAC_WaitLoad(void)
+{
+  while (0U != LL_FMAC_IsEnabledStart(FMAC))
+  {
+    /* Nothing to do */
+  }
+}
+
+/* Exported functions ------------------------------------------------------- */
+
+/**
+  * @brief  Enables the clock of the FMAC, resets it and enables the clipping of its
+  *         outputs to the q1.15 range. Called once by MCboot(), before the first
+  *         call of PI_Controller().
+  */
+void PID_FMAC_Init(void)
+{
+  LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_FMAC);
+  LL_FMAC_EnableReset(FMAC);
+  while (0U != LL_FMAC_IsEnabledReset(FMAC))
+  {
+    /* Nothing to do */
+  }
+  LL_FMAC_EnableClipping(FMAC);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#elif defined (RAMFUNC)
+__RAM_FUNC
+#endif
+/**
+  * @brief  Computes the output of a PI regulator with the FMAC, the sum of its
+  *         proportional and integral terms as PI_Controller()
+  * @param  pHandle: handler of the current instance of the PID component
+  * @param  wProcessVarError: current process variable error, intended as the reference
+  *         value minus the present process variable value, saturated to 16 bits
+  * @retval computed PI output
+  *
+  * The interrupts are masked while the FMAC is used, so that the regulators of the
+  * medium frequency task share it with the ones of the high frequency task.
+  */
+int16_t PI_FMAC_Controller(PID_Handle_t *pHandle, int32_t wProcessVarError)
+{
+  int16_t returnValue;
+
+  if (false == pHandle->FMACCoeffValid)
+  {
+    PID_FMAC_SetCoefficients(pHandle);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  if (0U == pHandle->bFMACShift)
+  {
+    /* The software regulator goes on from the last output */
+    int32_t wProportional = (int32_t)pHandle->hKpGain * (int32_t)pHandle->hFMACPrevError;
+
+    pHandle->FMACEnable = false;
+    //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+    PID_SetIntegralTerm(pHandle, ((int32_t)pHandle->hFMACPrevOutput - (wProportional >> pHandle->hKpDivisorPOW2))
+                                 * (int32_t)pHandle->hKiDivisor);
+    returnValue = PI_Controller(pHandle, wProcessVarError);
+  }
+  else
+  {
+    int16_t hError = (int16_t)__SSAT(wProcessVarError, 16);
+    int32_t wOutput;
+    uint32_t wSum;
+    uint32_t wPriMask = __get_PRIMASK();
+    uint8_t i;
+
+    __disable_irq();
+    LL_FMAC_ConfigX1(FMAC, LL_FMAC_WM_0_THRESHOLD_1, (uint8_t)PID_FMAC_X1_BASE, (uint8_t)PID_FMAC_X1_SIZE);
+    LL_FMAC_ConfigX2(FMAC, (uint8_t)PID_FMAC_X2_BASE, (uint8_t)PID_FMAC_X2_SIZE);
+    LL_FMAC_ConfigY(FMAC, LL_FMAC_WM_0_THRESHOLD_1, (uint8_t)PID_FMAC_Y_BASE, (uint8_t)PID_FMAC_Y_SIZE);
+
+    /* Coefficients, feed forward then feedback */
+    LL_FMAC_ConfigFunc(FMAC, LL_FMAC_PROCESSING_START, LL_FMAC_FUNC_LOAD_X2, (uint8_t)PID_FMAC_TAPS_B,
+                       (uint8_t)PID_FMAC_TAPS_A, 0U);
+    for (i = 0U; i < PID_FMAC_X2_SIZE; i++)
+    {
+      LL_FMAC_WriteData(FMAC, (uint16_t)pHandle->hFMACCoeff[i]);
+    }
+    PID_FMAC_WaitLoad();
+
+    /* Past inputs, the oldest first: the fraction, then e(k-1) */
+    LL_FMAC_ConfigFunc(FMAC, LL_FMAC_PROCESSING_START, LL_FMAC_FUNC_LOAD_X1, (uint8_t)(PID_FMAC_TAPS_B - 1U),
+                       0U, 0U);
+    LL_FMAC_WriteData(FMAC, pHandle->hFMACFraction);
+    LL_FMAC_WriteData(FMAC, (uint16_t)pHandle->hFMACPrevError);
+    PID_FMAC_WaitLoad();
+
+    /* Past output y(k-1) */
+    LL_FMAC_ConfigFunc(FMAC, LL_FMAC_PROCESSING_START, LL_FMAC_FUNC_LOAD_Y, (uint8_t)PID_FMAC_TAPS_A, 0U, 0U);
+    LL_FMAC_WriteData(FMAC, (uint16_t)pHandle->hFMACPrevOutput);
+    PID_FMAC_WaitLoad();
+
+    /* One output of the filter for e(k) */
+    LL_FMAC_ConfigFunc(FMAC, LL_FMAC_PROCESSING_START, LL_FMAC_FUNC_IIR_DIRECT_FORM_1, (uint8_t)PID_FMAC_TAPS_B,
+                       (uint8_t)PID_FMAC_TAPS_A, pHandle->bFMACShift);
+    LL_FMAC_WriteData(FMAC, (uint16_t)hError);
+    while (0U != LL_FMAC_IsActiveFlag_YEMPTY(FMAC))
+    {
+      /* Nothing to do */
+    }
+    wOutput = (int32_t)(int16_t)LL_FMAC_ReadData(FMAC);
+    LL_FMAC_DisableStart(FMAC);
+    __set_PRIMASK(wPriMask);
+
+    /* Fraction truncated by the FMAC: the low 15-R bits of its sum, which the products
+       wrapped to 32 bits keep exact */
+    wSum = ((uint32_t)((int32_t)pHandle->hFMACCoeff[0] * (int32_t)hError)
+            + (uint32_t)((int32_t)pHandle->hFMACCoeff[1] * (int32_t)pHandle->hFMACPrevError))
+           + (uint32_t)pHandle->hFMACFraction;
+    pHandle->hFMACFraction = (uint16_t)(wSum & ((1UL << (15U - pHandle->bFMACShift)) - 1U));
+
+    if (wOutput > pHandle->hUpperOutputLimit)
+    {
+      wOutput = pHandle->hUpperOutputLimit;
+    }
+    else if (wOutput < pHandle->hLowerOutputLimit)
+    {
+      wOutput = pHandle->hLowerOutputLimit;
+    }
+    else
+    {
+      /* Nothing to do here */
+    }
+
+    pHandle->hFMACPrevError = hError;
+    pHandle->hFMACPrevOutput = (int16_t)wOutput;
+    returnValue = (int16_t)wOutput;
+  }
+  return (returnValue);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* PID_FMAC */
+
+/************************ (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,1193 @@
+/**
+  ******************************************************************************
+  * @file    r1_g4xx_pwm_curr_fdbk.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   This file provides firmware functions that implement current sensor
+  *          class to be stantiated when the single shunt current sensing
+  *          topology is used. It is specifically designed for STM32G4
+  *          microcontrollers and implements the sampling of the bus current
+  *          twice per PWM period with one ADC.
+  *           + MCU peripheral and handle initialization function
+  *           + single shunt current sensing
+  *           + space vector modulation function
+  *           + ADC sampling function
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "r1_g4xx_pwm_curr_fdbk.h"
+#include "pwm_common.h"
+#include "mc_type.h"
+
+/** @addtogroup MCSDK
+  * @{
+  */
+
+/** @addtogroup pwm_curr_fdbk
+  * @{
+  */
+
+/**
+  * @defgroup R1_G4XX_pwm_curr_fdbk R1 G4 PWM & Current Feedback
+  *
+  * @brief STM32G4, 1-Shunt PWM & Current Feedback implementation
+  *
+  * This component is used in applications based on an STM32G4 MCU, using a single
+  * shunt resistor in the DC link to sense the currents and one ADC peripheral to
+  * acquire the values.
+  *
+  * In the rising count of the PWM period, the phase with the smallest compare value
+  * goes low first: until the middle phase goes low too, the bus current is the
+  * opposite of its current. Then only the phase with the largest compare value stays
+  * high, and the bus current is its current. TIMx_Ch5 and TIMx_Ch6, in PWM mode 2,
+  * trigger the two injected conversions of the shunt through TRGO2 at the end of
+  * these windows, when they are at least TMin long. When a window is shorter, or in
+  * the zero states of PWMC_SetSwitchingState(), the phase currents that are not
+  * measured are taken from the estimates of the PWMC component, IaEst, IbEst and
+  * IcEst, corrected so that the three currents sum up to zero. The estimates must be
+  * set each period, from the currents predicted for the next sampling.
+  *
+  * There is no phase shift of the PWM: at low modulation index, the windows are too
+  * short and the currents are the estimates only.
+  *
+  * @{
+  */
+
+/* Private defines -----------------------------------------------------------*/
+#define TIMxCCER_MASK_CH123        ((uint16_t)(LL_TIM_CHANNEL_CH1|LL_TIM_CHANNEL_CH1N|\
+                                               LL_TIM_CHANNEL_CH2|LL_TIM_CHANNEL_CH2N|\
+                                               LL_TIM_CHANNEL_CH3|LL_TIM_CHANNEL_CH3N))
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static void R1_TIMxInit(TIM_TypeDef *TIMx, PWMC_Handle_t *pHdl);
+static void R1_ADCxInit(ADC_TypeDef *ADCx);
+__STATIC_INLINE uint16_t R1_WriteTIMRegisters(PWMC_Handle_t *pHdl, uint16_t hTrigger1, uint16_t hTrigger2);
+static uint16_t R1_SetSamplingWindows(PWMC_Handle_t *pHdl);
+static void R1_HFCurrentsPolarization(PWMC_Handle_t *pHdl, ab_t *Iab);
+static void R1_SetAOReferenceVoltage(uint32_t DAC_Channel, DAC_TypeDef *DACx, uint16_t hDACVref);
+uint16_t R1_SetADCSampPointPolarization(PWMC_Handle_t *pHdl) ;
+
+/**
+  * @brief  It initializes TIMx, ADC, OPAMP and comparators for current reading
+  *         in single shunt topology using STM32G4
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void R1_Init(PWMC_R1_Handle_t *pHandle)
+{
+  R1_StartInit(pHandle);
+  R1_CompleteInit(pHandle);
+}
+
+/**
+  * @brief  It starts the initialization of the component: OPAMP, comparators, and the
+  *         voltage regulator and calibration of the ADC. The calibration runs in the
+  *         background until R1_CompleteInit is called, so that the caller can initialize
+  *         the other components meanwhile.
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void R1_StartInit(PWMC_R1_Handle_t *pHandle)
+{
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    COMP_TypeDef *COMP_OCPx = pHandle->pParams_str->CompOCPSelection;
+    COMP_TypeDef *COMP_OVPx = pHandle->pParams_str->CompOVPSelection;
+    DAC_TypeDef *DAC_OCPx = pHandle->pParams_str->DAC_OCP_Selection;
+    DAC_TypeDef *DAC_OVPx = pHandle->pParams_str->DAC_OVP_Selection;
+    TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+    ADC_TypeDef *ADCx = pHandle->pParams_str->ADCx;
+
+    /*Check that _Super is the first member of the structure PWMC_R1_Handle_t */
+    if ((uint32_t)pHandle == (uint32_t)&pHandle->_Super) //cstat !MISRAC2012-Rule-11.4
+    {
+      /* disable IT and flags in case of LL driver usage
+       * workaround for unwanted interrupt enabling done by LL driver */
+      LL_ADC_DisableIT_EOC(ADCx);
+      LL_ADC_ClearFlag_EOC(ADCx);
+      LL_ADC_DisableIT_JEOC(ADCx);
+      LL_ADC_ClearFlag_JEOC(ADCx);
+
+      if (TIM1 ==  TIMx)
+      {
+        /* TIM1 Counter Clock stopped when the core is halted */
+        LL_DBGMCU_APB2_GRP1_FreezePeriph(LL_DBGMCU_APB2_GRP1_TIM1_STOP);
+      }
+      else
+      {
+        /* TIM8 Counter Clock stopped when the core is halted */
+        LL_DBGMCU_APB2_GRP1_FreezePeriph(LL_DBGMCU_APB2_GRP1_TIM8_STOP);
+      }
+
+      if (pHandle->pParams_str->OPAMPx != NULL)
+      {
+        LL_OPAMP_Enable(pHandle->pParams_str->OPAMPx);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
+      /* Over current protection */
+      if (COMP_OCPx != NULL)
+      {
+        /* Inverting input*/
+        if ((pHandle->pParams_str->CompOCPInvInput_MODE != EXT_MODE) && (DAC_OCPx != MC_NULL))
+        {
+          R1_SetAOReferenceVoltage(pHandle->pParams_str->DAC_Channel_OCP, DAC_OCPx,
+                                   (uint16_t)(pHandle->pParams_str->DAC_OCP_Threshold));
+        }
+        /* Output */
+        LL_COMP_Enable(COMP_OCPx);
+        LL_COMP_Lock(COMP_OCPx);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
+      /* Over voltage protection */
+      if (COMP_OVPx != NULL)
+      {
+        /* Inverting input*/
+        if ((pHandle->pParams_str->CompOVPInvInput_MODE != EXT_MODE) && (DAC_OVPx != MC_NULL))
+        {
+          R1_SetAOReferenceVoltage(pHandle->pParams_str->DAC_Channel_OVP, DAC_OVPx,
+                                   (uint16_t)(pHandle->pParams_str->DAC_OVP_Threshold));
+        }
+        /* Output */
+        LL_COMP_Enable(COMP_OVPx);
+        LL_COMP_Lock(COMP_OVPx);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
+      if (0U == LL_ADC_IsEnabled(ADCx))
+      {
+        /* - Exit from deep-power-down mode */
+        LL_ADC_DisableDeepPowerDown(ADCx);
+
+        if (0U == LL_ADC_IsInternalRegulatorEnabled(ADCx))
+        {
+          /* Enable ADC internal voltage regulator */
+          LL_ADC_EnableInternalRegulator(ADCx);
+
+          /* Wait for Regulator Startup time */
+          /* Note: Variable divided by 2 to compensate partially              */
+          /*       CPU processing cycles, scaling in us split to not          */
+          /*       exceed 32 bits register capacity and handle low frequency. */
+          volatile uint32_t wait_loop_index = ((LL_ADC_DELAY_INTERNAL_REGUL_STAB_US / 10UL)
+                                               * (SystemCoreClock / (100000UL * 2UL)));
+          while (wait_loop_index != 0UL)
+          {
+            wait_loop_index--;
+          }
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+
+        LL_ADC_StartCalibration(ADCx, LL_ADC_SINGLE_ENDED);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+}
+
+/**
+  * @brief  It completes the initialization started by R1_StartInit: it waits for the
+  *         end of the calibration of the ADC, enables it and initializes TIMx.
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void R1_CompleteInit(PWMC_R1_Handle_t *pHandle)
+{
+  if (MC_NULL == pHandle)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+    ADC_TypeDef *ADCx = pHandle->pParams_str->ADCx;
+
+    if ((uint32_t)pHandle == (uint32_t)&pHandle->_Super) //cstat !MISRAC2012-Rule-11.4
+    {
+      if (0U == LL_ADC_IsEnabled(ADCx))
+      {
+        R1_ADCxInit(ADCx);
+        /* The interrupt comes at the end of the second conversion of the period */
+        LL_ADC_ClearFlag_JEOS(ADCx);
+        LL_ADC_EnableIT_JEOS(ADCx);
+      }
+      else
+      {
+        /* Nothing to do ADCx already configured */
+      }
+      R1_TIMxInit(TIMx, &pHandle->_Super);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+}
+
+/**
+  * @brief  Enables the ADC at the end of the calibration started by R1_StartInit.
+  *         Each trigger then converts one rank of the injected sequence.
+  * @param  ADCx ADC to be enabled
+  */
+static void R1_ADCxInit(ADC_TypeDef *ADCx)
+{
+  while (1U == LL_ADC_IsCalibrationOnGoing(ADCx))
+  {
+    /* Nothing to do */
+  }
+  /* ADC Enable (must be done after calibration) */
+  /* ADC5-140924: Enabling the ADC by setting ADEN bit soon after polling ADCAL=0
+  * following a calibration phase, could have no effect on ADC
+  * within certain AHB/ADC clock ratio.
+  */
+  while (0U == LL_ADC_IsActiveFlag_ADRDY(ADCx))
+  {
+    LL_ADC_Enable(ADCx);
+  }
+  /* Clear JSQR from CubeMX setting to avoid not wanting conversion*/
+  LL_ADC_INJ_StartConversion(ADCx);
+  LL_ADC_INJ_StopConversion(ADCx);
+  LL_ADC_INJ_SetQueueMode(ADCx, LL_ADC_INJ_QUEUE_2CONTEXTS_END_EMPTY);
+  LL_ADC_INJ_SetSequencerDiscont(ADCx, LL_ADC_INJ_SEQ_DISCONT_1RANK);
+
+  /* dummy conversion (ES0431 doc chap. 2.5.4) */
+  LL_ADC_REG_StartConversion(ADCx);
+}
+
+/**
+  * @brief  It initializes TIMx peripheral for PWM generation, and TIMx_Ch5 and
+  *         TIMx_Ch6 for the triggers of the ADC
+  * @param TIMx: Timer to be initialized
+  * @param pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+static void R1_TIMxInit(TIM_TypeDef *TIMx, PWMC_Handle_t *pHdl)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+  volatile uint32_t Brk2Timeout = 1000;
+
+  /* disable main TIM counter to ensure
+   * a synchronous start by TIM2 trigger */
+  LL_TIM_DisableCounter(TIMx);
+
+  LL_TIM_SetTriggerOutput(TIMx, LL_TIM_TRGO_RESET);
+  LL_TIM_SetTriggerOutput2(TIMx, LL_TIM_TRGO2_RESET);
+
+  /* Enables the TIMx Preload on CC1 Register */
+  LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH1);
+  /* Enables the TIMx Preload on CC2 Register */
+  LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH2);
+  /* Enables the TIMx Preload on CC3 Register */
+  LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH3);
+  /* OC5REF and OC6REF rise in the rising count only */
+  LL_TIM_OC_SetMode(TIMx, LL_TIM_CHANNEL_CH5, LL_TIM_OCMODE_PWM2);
+  LL_TIM_OC_SetMode(TIMx, LL_TIM_CHANNEL_CH6, LL_TIM_OCMODE_PWM2);
+  LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH5);
+  LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH6);
+  /* Prepare timer for synchronization */
+  LL_TIM_GenerateEvent_UPDATE(TIMx);
+  if (1U == pHandle->pParams_str->RepetitionCounter)
+  {
+    LL_TIM_SetCounter(TIMx, (uint32_t)(pHandle->Half_PWMPeriod) - 1U);
+  }
+  else if (3U == pHandle->pParams_str->RepetitionCounter)
+  {
+    /* Set TIMx repetition counter to 1 */
+    LL_TIM_SetRepetitionCounter(TIMx, 1);
+    LL_TIM_GenerateEvent_UPDATE(TIMx);
+    /* Repetition counter will be set to 3 at next Update */
+    LL_TIM_SetRepetitionCounter(TIMx, 3);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  LL_TIM_ClearFlag_BRK(TIMx);
+
+  if ((pHandle->pParams_str->BKIN2Mode) != NONE)
+  {
+    uint32_t result;
+    result = LL_TIM_IsActiveFlag_BRK2(TIMx);
+    while ((Brk2Timeout != 0u) && (1U == result))
+    {
+      LL_TIM_ClearFlag_BRK2(TIMx);
+      Brk2Timeout--;
+      result = LL_TIM_IsActiveFlag_BRK2(TIMx);
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  LL_TIM_EnableIT_BRK(TIMx);
+
+  /* Enable PWM channel */
+  LL_TIM_CC_EnableChannel(TIMx, TIMxCCER_MASK_CH123);
+}
+
+/**
+  * @brief  It sets the calibrated offset, taken from the one of phase A
+  * @param pHdl: handler of the current instance of the PWM component
+  * @param offsets: pointer to the structure that contains the offsets
+  * @retval none
+  */
+__weak void R1_SetOffsetCalib(PWMC_Handle_t *pHdl, PolarizationOffsets_t *offsets)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+
+  pHandle->PhaseOffset = offsets->phaseAOffset;
+  pHdl->offsetCalibStatus = true;
+}
+
+/**
+  * @brief  It reads the calibrated offset, given for the three phases
+  * @param pHdl: handler of the current instance of the PWM component
+  * @param offsets: pointer to the structure that will contain the offsets
+  * @retval none
+  */
+__weak void R1_GetOffsetCalib(PWMC_Handle_t *pHdl, PolarizationOffsets_t *offsets)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+
+  offsets->phaseAOffset = pHandle->PhaseOffset;
+  offsets->phaseBOffset = pHandle->PhaseOffset;
+  offsets->phaseCOffset = pHandle->PhaseOffset;
+}
+
+/**
+  * @brief  It stores into the component the voltage present on the bus current
+  *         feedback analog channel when no current is flowin into the motor
+  * @param  pHdl: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void R1_CurrentReadingPolarization(PWMC_Handle_t *pHdl)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+  TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+  ADC_TypeDef *ADCx = pHandle->pParams_str->ADCx;
+  volatile PWMC_GetPhaseCurr_Cb_t GetPhaseCurrCbSave;
+  volatile PWMC_SetSampPointSectX_Cb_t SetSampPointSectXCbSave;
+
+  if (true == pHandle->_Super.offsetCalibStatus)
+  {
+    LL_ADC_INJ_StartConversion(ADCx);
+  }
+  else
+  {
+    /* Save callback routines */
+    GetPhaseCurrCbSave = pHandle->_Super.pFctGetPhaseCurrents;
+    SetSampPointSectXCbSave = pHandle->_Super.pFctSetADCSampPointSectX;
+
+    pHandle->PhaseOffset = 0U;
+    pHandle->PolarizationCounter = 0U;
+
+    /* It forces inactive level on TIMx CHy and CHyN */
+    LL_TIM_CC_DisableChannel(TIMx, TIMxCCER_MASK_CH123);
+
+    /* Change function to be executed in ADCx_ISR */
+    pHandle->_Super.pFctGetPhaseCurrents = &R1_HFCurrentsPolarization;
+    pHandle->_Super.pFctSetADCSampPointSectX = &R1_SetADCSampPointPolarization;
+
+    R1_SwitchOnPWM(&pHandle->_Super);
+
+    /* IF TRGO2 is enabled, it means that JSQR is now configured to sample polarization current*/
+    while (((TIMx->CR2) & TIM_CR2_MMS2_Msk) != LL_TIM_TRGO2_OC5_RISING_OC6_RISING)
+    {
+      /* Nothing to do */
+    }
+    /* It is the right time to start the ADC without unwanted conversion */
+    /* Start ADC to wait for external trigger. This is series dependant*/
+    LL_ADC_INJ_StartConversion(ADCx);
+
+    /* Wait for NB_CONVERSIONS to be executed */
+    waitForPolarizationEnd(TIMx,
+                           &pHandle->_Super.SWerror,
+                           pHandle->pParams_str->RepetitionCounter,
+                           &pHandle->PolarizationCounter);
+
+    R1_SwitchOffPWM(&pHandle->_Super);
+    /* Two conversions per period */
+    pHandle->PhaseOffset /= (2U * NB_CONVERSIONS);
+    pHandle->_Super.offsetCalibStatus = true;
+
+    /* Change back function to be executed in ADCx_ISR */
+    pHandle->_Super.pFctGetPhaseCurrents = GetPhaseCurrCbSave;
+    pHandle->_Super.pFctSetADCSampPointSectX = SetSampPointSectXCbSave;
+
+    /* It over write TIMx CCRy wrongly written by FOC during calibration so as to
+     force 50% duty cycle on the three inverer legs */
+    /* Disable TIMx preload */
+    LL_TIM_OC_DisablePreload(TIMx, LL_TIM_CHANNEL_CH1);
+    LL_TIM_OC_DisablePreload(TIMx, LL_TIM_CHANNEL_CH2);
+    LL_TIM_OC_DisablePreload(TIMx, LL_TIM_CHANNEL_CH3);
+    LL_TIM_OC_SetCompareCH1(TIMx, pHandle->Half_PWMPeriod);
+    LL_TIM_OC_SetCompareCH2(TIMx, pHandle->Half_PWMPeriod);
+    LL_TIM_OC_SetCompareCH3(TIMx, pHandle->Half_PWMPeriod);
+    /* Enable TIMx preload */
+    LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH1);
+    LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH2);
+    LL_TIM_OC_EnablePreload(TIMx, LL_TIM_CHANNEL_CH3);
+
+    /* It re-enable drive of TIMx CHy and CHyN by TIMx CHyRef*/
+    LL_TIM_CC_EnableChannel(TIMx, TIMxCCER_MASK_CH123);
+  }
+  /* At the end of calibration, all phases are at 50%: no window */
+  pHandle->Sample[0] = R1_SAMPLE_NONE;
+  pHandle->Sample[1] = R1_SAMPLE_NONE;
+
+  pHandle->BrakeActionLock = false;
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  It computes and return latest converted motor phase currents motor.
+  *         The currents that the two conversions of the period did not measure are
+  *         the estimates IaEst, IbEst and IcEst, less the share of each of the error
+  *         of their sum with the measured ones.
+  * @param  pHdl: handler of the current instance of the PWM component
+  * @retval Ia and Ib current in Curr_Components format
+  */
+__weak void R1_GetPhaseCurrents(PWMC_Handle_t *pHdl, ab_t *Iab)
+{
+  if (MC_NULL == Iab)
+  {
+    /* nothing to do */
+  }
+  else
+  {
+    PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl;  //cstat !MISRAC2012-Rule-11.3
+    TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+    ADC_TypeDef *ADCx = pHandle->pParams_str->ADCx;
+    uint32_t ADCDataReg[2];
+    int32_t Curr[3];
+    int32_t Aux;
+    bool Measured[3] = {false, false, false};
+    uint8_t NbEstimated = 3U;
+    uint8_t i;
+
+    /* disable ADC trigger source */
+    LL_TIM_SetTriggerOutput2(TIMx, LL_TIM_TRGO2_RESET);
+
+    ADCDataReg[0] = ADCx->JDR1;
+    ADCDataReg[1] = ADCx->JDR2;
+
+    Curr[0] = (int32_t)pHandle->_Super.IaEst;
+    Curr[1] = (int32_t)pHandle->_Super.IbEst;
+    Curr[2] = (int32_t)pHandle->_Super.IcEst;
+
+    for (i = 0U; i < 2U; i++)
+    {
+      if (R1_SAMPLE_NONE == pHandle->Sample[i])
+      {
+        /* Nothing to do */
+      }
+      else
+      {
+        uint8_t Phase = (pHandle->Sample[i] & R1_SAMPLE_PHASE) - 1U;
+
+        /* Bus current = ADC converted value - PhaseOffset */
+        Aux = (int32_t)(ADCDataReg[i]) - (int32_t)(pHandle->PhaseOffset);
+        Curr[Phase] = ((pHandle->Sample[i] & R1_SAMPLE_NEG) != 0U) ? -Aux : Aux;
+        Measured[Phase] = true;
+        NbEstimated--;
+      }
+    }
+
+    if ((NbEstimated > 0U) && (NbEstimated < 3U))
+    {
+      /* The estimated currents take the error of the sum: exact with two measured ones */
+      Aux = (Curr[0] + Curr[1] + Curr[2]) / (int32_t)NbEstimated;
+      for (i = 0U; i < 3U; i++)
+      {
+        Curr[i] -= (true == Measured[i]) ? 0 : Aux;
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    Iab->a = PWMC_SatCurrent(Curr[0]);
+    Iab->b = PWMC_SatCurrent(Curr[1]);
+
+    pHandle->_Super.Ia = Iab->a;
+    pHandle->_Super.Ib = Iab->b;
+    pHandle->_Super.Ic = -Iab->a - Iab->b;
+  }
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Configure the ADC for the current sampling during calibration.
+  *         The two triggers are at the end of the rising count, where no current
+  *         flows.
+  *         And call the WriteTIMRegisters method.
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+uint16_t R1_SetADCSampPointPolarization(PWMC_Handle_t *pHdl)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+
+  pHandle->Sample[0] = R1_SAMPLE_NONE;
+  pHandle->Sample[1] = R1_SAMPLE_NONE;
+  return R1_WriteTIMRegisters(&pHandle->_Super,
+                              pHandle->Half_PWMPeriod - pHandle->pParams_str->TMin - (uint16_t)1,
+                              pHandle->Half_PWMPeriod - (uint16_t)1);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Places the two triggers of the PWM period and sets the currents they
+  *         convert, from the compare values of the three phases.
+  *
+  * A window is used when it is at least TMin long, and its trigger is Tbefore before
+  * its end. As the end of sequence interrupt runs the FOC, both triggers must occur
+  * TMin apart: a conversion that measures no window is placed at the end of the rising
+  * count when it is far enough from the other one, before it otherwise.
+  * @param  pHandle Pointer on the target component instance
+  * @retval none
+  */
+static uint16_t R1_SetSamplingWindows(PWMC_Handle_t *pHdl)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl;  //cstat !MISRAC2012-Rule-11.3
+  uint16_t TMin = pHandle->pParams_str->TMin;
+  uint16_t Tbefore = pHandle->pParams_str->Tbefore;
+  uint16_t LastCnt = pHandle->Half_PWMPeriod - (uint16_t)1;
+  uint16_t Cnt[3];
+  uint16_t Trigger[2];
+  uint8_t Max = 0U;
+  uint8_t Min = 0U;
+  uint8_t NbWindows = 0U;
+  uint8_t i;
+
+  Cnt[0] = pHdl->CntPhA;
+  Cnt[1] = pHdl->CntPhB;
+  Cnt[2] = pHdl->CntPhC;
+  for (i = 1U; i < 3U; i++)
+  {
+    Max = (Cnt[i] > Cnt[Max]) ? i : Max;
+    Min = (Cnt[i] < Cnt[Min]) ? i : Min;
+  }
+
+  if (Max != Min)
+  {
+    uint8_t Mid = 3U - Max - Min;
+
+    /* Only the phase with the smallest compare value is low */
+    if ((uint16_t)(Cnt[Mid] - Cnt[Min]) >= TMin)
+    {
+      Trigger[NbWindows] = Cnt[Mid] - Tbefore;
+      pHandle->Sample[NbWindows] = (Min + 1U) | R1_SAMPLE_NEG;
+      NbWindows++;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    /* Only the phase with the largest compare value is high */
+    if ((uint16_t)(Cnt[Max] - Cnt[Mid]) >= TMin)
+    {
+      Trigger[NbWindows] = Cnt[Max] - Tbefore;
+      pHandle->Sample[NbWindows] = Max + 1U;
+      NbWindows++;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* Zero state: no window */
+  }
+
+  if (1U == NbWindows)
+  {
+    if (((uint32_t)Trigger[0] + TMin) <= LastCnt)
+    {
+      Trigger[1] = LastCnt;
+      pHandle->Sample[1] = R1_SAMPLE_NONE;
+    }
+    else if (Trigger[0] >= TMin)
+    {
+      Trigger[1] = Trigger[0];
+      pHandle->Sample[1] = pHandle->Sample[0];
+      Trigger[0] = Trigger[1] - TMin;
+      pHandle->Sample[0] = R1_SAMPLE_NONE;
+    }
+    else
+    {
+      /* PWM period too short for the window and another conversion */
+      NbWindows = 0U;
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  if (0U == NbWindows)
+  {
+    Trigger[0] = LastCnt - TMin;
+    Trigger[1] = LastCnt;
+    pHandle->Sample[0] = R1_SAMPLE_NONE;
+    pHandle->Sample[1] = R1_SAMPLE_NONE;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  return R1_WriteTIMRegisters(&pHandle->_Super, Trigger[0], Trigger[1]);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Configure the ADC for the current sampling of the duty cycles applied
+  *         by PWMC_SetPhaseVoltage() or PWMC_SetDwellTimes().
+  *         It means set the two sampling points via TIMx_Ch5 and TIMx_Ch6 values
+  *         and the phase currents they convert.
+  *         And call the WriteTIMRegisters method.
+  * @param  pHandle Pointer on the target component instance
+  * @retval none
+  */
+uint16_t R1_SetADCSampPointSectX(PWMC_Handle_t *pHdl)
+{
+  uint16_t returnValue;
+
+  if (MC_NULL == pHdl)
+  {
+    returnValue = 0U;
+  }
+  else
+  {
+    returnValue = R1_SetSamplingWindows(pHdl);
+  }
+  return (returnValue);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Configure the ADC for the current sampling of a switching state applied by
+  *         PWMC_SetSwitchingState().
+  *         An active state has a single window of StateHighCnt, from the start of the
+  *         PWM period: the current of its only high phase, or the opposite of the
+  *         current of its only low phase, is measured. A zero state has no window.
+  *         And call the WriteTIMRegisters method.
+  * @param  pHandle Pointer on the target component instance
+  * @retval none
+  */
+uint16_t R1_SetADCSampPointState(PWMC_Handle_t *pHdl)
+{
+  uint16_t returnValue;
+
+  if (MC_NULL == pHdl)
+  {
+    returnValue = 0U;
+  }
+  else
+  {
+    returnValue = R1_SetSamplingWindows(pHdl);
+  }
+  return (returnValue);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  Writes the compare values of the phases and of the two triggers
+  * @param  pHandle handler of the current instance of the PWM component
+  * @param  hTrigger1 Compare value of TIMx_Ch5, first conversion
+  * @param  hTrigger2 Compare value of TIMx_Ch6, second conversion
+  * @retval none
+  */
+__STATIC_INLINE uint16_t R1_WriteTIMRegisters(PWMC_Handle_t *pHdl, uint16_t hTrigger1, uint16_t hTrigger2)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+  TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+  uint16_t Aux;
+
+  LL_TIM_OC_SetCompareCH1(TIMx, (uint32_t) pHandle->_Super.CntPhA);
+  LL_TIM_OC_SetCompareCH2(TIMx, (uint32_t) pHandle->_Super.CntPhB);
+  LL_TIM_OC_SetCompareCH3(TIMx, (uint32_t) pHandle->_Super.CntPhC);
+  LL_TIM_OC_SetCompareCH5(TIMx, (uint32_t) hTrigger1);
+  LL_TIM_OC_SetCompareCH6(TIMx, (uint32_t) hTrigger2);
+
+  /* Limit for update event */
+  if (((TIMx->CR2) & TIM_CR2_MMS2_Msk) != LL_TIM_TRGO2_RESET)
+  {
+    Aux = MC_FOC_DURATION;
+  }
+  else
+  {
+    Aux = MC_NO_ERROR;
+  }
+  return Aux;
+}
+
+/**
+  * @brief  Implementaion of PWMC_GetPhaseCurrents to be performed during
+  *         calibration. It sum up injected conversion data into PhaseOffset
+  *         to compute the offset introduced in the current feedback
+  *         network. It is requied to proper configure ADC inputs before to enable
+  *         the offset computation.
+  * @param  pHdl Pointer on the target component instance
+  * @retval It always returns {0,0} in Curr_Components format
+  */
+static void R1_HFCurrentsPolarization(PWMC_Handle_t *pHdl, ab_t *Iab)
+{
+  if (MC_NULL == Iab)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+    TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+    ADC_TypeDef *ADCx = pHandle->pParams_str->ADCx;
+
+    /* disable ADC trigger source */
+    LL_TIM_SetTriggerOutput2(TIMx, LL_TIM_TRGO2_RESET);
+
+    if (pHandle->PolarizationCounter < NB_CONVERSIONS)
+    {
+      pHandle->PhaseOffset += ADCx->JDR1 + ADCx->JDR2;
+      pHandle->PolarizationCounter++;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    /* during offset calibration no current is flowing in the phases */
+    Iab->a = 0;
+    Iab->b = 0;
+  }
+}
+
+/**
+  * @brief  It turns on low sides switches. This function is intended to be
+  *         used for charging boot capacitors of driving section. It has to be
+  *         called each motor start-up when using high voltage drivers
+  * @param  pHdl: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void R1_TurnOnLowSides(PWMC_Handle_t *pHdl)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+  TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+
+  pHandle->_Super.TurnOnLowSidesAction = true;
+
+  /* Clear Update Flag */
+  LL_TIM_ClearFlag_UPDATE(pHandle->pParams_str->TIMx);
+
+  /*Turn on the three low side switches */
+  LL_TIM_OC_SetCompareCH1(TIMx, 0u);
+  LL_TIM_OC_SetCompareCH2(TIMx, 0u);
+  LL_TIM_OC_SetCompareCH3(TIMx, 0u);
+
+  /* Wait until next update */
+  while (0U == LL_TIM_IsActiveFlag_UPDATE(TIMx))
+  {
+    /* Nothing to do */
+  }
+
+  /* Main PWM Output Enable */
+  LL_TIM_EnableAllOutputs(TIMx);
+
+  if ((ES_GPIO == pHandle->pParams_str->LowSideOutputs))
+  {
+    LL_GPIO_SetOutputPin(pHandle->pParams_str->pwm_en_u_port, pHandle->pParams_str->pwm_en_u_pin);
+    LL_GPIO_SetOutputPin(pHandle->pParams_str->pwm_en_v_port, pHandle->pParams_str->pwm_en_v_pin);
+    LL_GPIO_SetOutputPin(pHandle->pParams_str->pwm_en_w_port, pHandle->pParams_str->pwm_en_w_pin);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return;
+}
+
+
+/**
+  * @brief  It enables PWM generation on the proper Timer peripheral acting on MOE
+  *         bit
+  * @param  pHdl: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void R1_SwitchOnPWM(PWMC_Handle_t *pHdl)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+  TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+  /* We forbid ADC usage for regular conversion on Systick*/
+  pHandle->ADCRegularLocked = true;
+
+  pHandle->_Super.TurnOnLowSidesAction = false;
+
+  /* Set all duty to 50%: no window */
+  pHandle->Sample[0] = R1_SAMPLE_NONE;
+  pHandle->Sample[1] = R1_SAMPLE_NONE;
+  LL_TIM_OC_SetCompareCH1(TIMx, ((uint32_t)pHandle->Half_PWMPeriod / (uint32_t)2));
+  LL_TIM_OC_SetCompareCH2(TIMx, ((uint32_t)pHandle->Half_PWMPeriod / (uint32_t)2));
+  LL_TIM_OC_SetCompareCH3(TIMx, ((uint32_t)pHandle->Half_PWMPeriod / (uint32_t)2));
+  LL_TIM_OC_SetCompareCH5(TIMx, ((uint32_t)pHandle->Half_PWMPeriod - (uint32_t)pHandle->pParams_str->TMin
+                                 - (uint32_t)5));
+  LL_TIM_OC_SetCompareCH6(TIMx, ((uint32_t)pHandle->Half_PWMPeriod - (uint32_t)5));
+
+  /* wait for a new PWM period */
+  LL_TIM_ClearFlag_UPDATE(TIMx);
+  while (0U == LL_TIM_IsActiveFlag_UPDATE(TIMx))
+  {
+    /* Nothing to do */
+  }
+  LL_TIM_ClearFlag_UPDATE(TIMx);
+
+  /* Main PWM Output Enable */
+  TIMx->BDTR |= LL_TIM_OSSI_ENABLE;
+  LL_TIM_EnableAllOutputs(TIMx);
+
+  if ((ES_GPIO == pHandle->pParams_str->LowSideOutputs))
+  {
+    if ((TIMx->CCER & TIMxCCER_MASK_CH123) != 0U)
+    {
+      LL_GPIO_SetOutputPin(pHandle->pParams_str->pwm_en_u_port, pHandle->pParams_str->pwm_en_u_pin);
+      LL_GPIO_SetOutputPin(pHandle->pParams_str->pwm_en_v_port, pHandle->pParams_str->pwm_en_v_pin);
+      LL_GPIO_SetOutputPin(pHandle->pParams_str->pwm_en_w_port, pHandle->pParams_str->pwm_en_w_pin);
+    }
+    else
+    {
+      /* It is executed during calibration phase the EN signal shall stay off */
+      LL_GPIO_ResetOutputPin(pHandle->pParams_str->pwm_en_u_port, pHandle->pParams_str->pwm_en_u_pin);
+      LL_GPIO_ResetOutputPin(pHandle->pParams_str->pwm_en_v_port, pHandle->pParams_str->pwm_en_v_pin);
+      LL_GPIO_ResetOutputPin(pHandle->pParams_str->pwm_en_w_port, pHandle->pParams_str->pwm_en_w_pin);
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  /* Clear Update Flag */
+  LL_TIM_ClearFlag_UPDATE(TIMx);
+  /* Enable Update IRQ */
+  LL_TIM_EnableIT_UPDATE(TIMx);
+}
+
+
+/**
+  * @brief  It disables PWM generation on the proper Timer peripheral acting on
+  *         MOE bit
+  * @param  pHdl: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void R1_SwitchOffPWM(PWMC_Handle_t *pHdl)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+  TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+
+  /* Disable UPDATE ISR */
+  LL_TIM_DisableIT_UPDATE(TIMx);
+
+  pHandle->_Super.TurnOnLowSidesAction = false;
+
+  /* Main PWM Output Disable */
+  LL_TIM_DisableAllOutputs(TIMx);
+  if (true == pHandle->BrakeActionLock)
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    if (ES_GPIO == pHandle->pParams_str->LowSideOutputs)
+    {
+      LL_GPIO_ResetOutputPin(pHandle->pParams_str->pwm_en_u_port, pHandle->pParams_str->pwm_en_u_pin);
+      LL_GPIO_ResetOutputPin(pHandle->pParams_str->pwm_en_v_port, pHandle->pParams_str->pwm_en_v_pin);
+      LL_GPIO_ResetOutputPin(pHandle->pParams_str->pwm_en_w_port, pHandle->pParams_str->pwm_en_w_pin);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+
+  /* wait for a new PWM period to flush last HF task */
+  LL_TIM_ClearFlag_UPDATE(TIMx);
+  while (0U == LL_TIM_IsActiveFlag_UPDATE(TIMx))
+  {
+    /* Nothing to do */
+  }
+  LL_TIM_ClearFlag_UPDATE(TIMx);
+
+  /* We allow ADC usage for regular conversion on Systick*/
+  pHandle->ADCRegularLocked = false;
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  It contains the TIMx Update event interrupt
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void *R1_TIMx_UP_IRQHandler(PWMC_R1_Handle_t *pHandle)
+{
+  void *tempPointer;
+  if (MC_NULL == pHandle)
+  {
+    tempPointer = MC_NULL;
+  }
+  else
+  {
+    TIM_TypeDef *TIMx = pHandle->pParams_str->TIMx;
+    ADC_TypeDef *ADCx = pHandle->pParams_str->ADCx;
+
+    /* Same JSQR each period: the triggers give the instants of the conversions */
+    ADCx->JSQR = pHandle->pParams_str->ADCConfig | (uint32_t)LL_ADC_INJ_TRIG_EXT_RISING;
+
+    /* enable ADC trigger source */
+    LL_TIM_SetTriggerOutput2(TIMx, LL_TIM_TRGO2_OC5_RISING_OC6_RISING);
+
+    tempPointer = &(pHandle->_Super.Motor);
+  }
+  return (tempPointer);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  It contains the TIMx Break2 event interrupt
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void *R1_BRK2_IRQHandler(PWMC_R1_Handle_t *pHandle)
+{
+  void *tempPointer;
+  if (MC_NULL == pHandle)
+  {
+    tempPointer = MC_NULL;
+  }
+  else
+  {
+    if (false == pHandle->BrakeActionLock)
+    {
+      if (ES_GPIO == pHandle->pParams_str->LowSideOutputs)
+      {
+        LL_GPIO_ResetOutputPin(pHandle->pParams_str->pwm_en_u_port, pHandle->pParams_str->pwm_en_u_pin);
+        LL_GPIO_ResetOutputPin(pHandle->pParams_str->pwm_en_v_port, pHandle->pParams_str->pwm_en_v_pin);
+        LL_GPIO_ResetOutputPin(pHandle->pParams_str->pwm_en_w_port, pHandle->pParams_str->pwm_en_w_pin);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    pHandle->OverCurrentFlag = true;
+    tempPointer = &(pHandle->_Super.Motor);
+  }
+  return (tempPointer);
+}
+
+#if defined (CCMRAM)
+#if defined (__ICCARM__)
+#pragma location = ".ccmram"
+#elif defined (__CC_ARM) || defined(__GNUC__)
+__attribute__((section(".ccmram")))
+#endif
+#endif
+/**
+  * @brief  It contains the TIMx Break1 event interrupt
+  * @param  pHandle: handler of the current instance of the PWM component
+  * @retval none
+  */
+__weak void *R1_BRK_IRQHandler(PWMC_R1_Handle_t *pHandle)
+{
+  void *tempPointer;
+  if (MC_NULL == pHandle)
+  {
+    tempPointer = MC_NULL;
+  }
+  else
+  {
+    pHandle->pParams_str->TIMx->BDTR |= LL_TIM_OSSI_ENABLE;
+    pHandle->OverVoltageFlag = true;
+    pHandle->BrakeActionLock = true;
+    tempPointer = &(pHandle->_Super.Motor);
+  }
+  return (tempPointer);
+}
+
+/**
+  * @brief  It is used to check if an overcurrent occurred since last call.
+  * @param  pHdl Pointer on the target component instance
+  * @retval uint16_t It returns MC_BREAK_IN whether an overcurrent has been
+  *                  detected since last method call, MC_NO_FAULTS otherwise.
+  */
+__weak uint16_t R1_IsOverCurrentOccurred(PWMC_Handle_t *pHdl)
+{
+  PWMC_R1_Handle_t *pHandle = (PWMC_R1_Handle_t *)pHdl; //cstat !MISRAC2012-Rule-11.3
+  uint16_t retVal = MC_NO_FAULTS;
+
+  if (true == pHandle->OverVoltageFlag)
+  {
+    retVal = MC_OVER_VOLT;
+    pHandle->OverVoltageFlag = false;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  if (true == pHandle->OverCurrentFlag)
+  {
+    retVal |= MC_BREAK_IN;
+    pHandle->OverCurrentFlag = false;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  return retVal;
+}
+
+/**
+  * @brief  It is used to configure the analog output used for protection
+  *         thresholds.
+  * @param  DAC_Channel: the selected DAC channel.
+  *          This parameter can be:
+  *            @arg DAC_Channel_1: DAC Channel1 selected
+  *            @arg DAC_Channel_2: DAC Channel2 selected
+  * @param  hDACVref Value of DAC reference expressed as 16bit unsigned integer.
+  *         Ex. 0 = 0V 65536 = VDD_DAC.
+  * @retval none
+  */
+static void R1_SetAOReferenceVoltage(uint32_t DAC_Channel, DAC_TypeDef *DACx, uint16_t hDACVref)
+{
+  LL_DAC_ConvertData12LeftAligned(DACx, DAC_Channel, hDACVref);
+
+  /* Enable DAC Channel */
+  LL_DAC_TrigSWConversion(DACx, DAC_Channel);
+
+  if (1U == LL_DAC_IsEnabled(DACx, DAC_Channel))
+  {
+    /* If DAC is already enable, we wait LL_DAC_DELAY_VOLTAGE_SETTLING_US*/
+    volatile uint32_t wait_loop_index = ((LL_DAC_DELAY_VOLTAGE_SETTLING_US) * (SystemCoreClock / (1000000UL * 2UL)));
+    while (wait_loop_index != 0UL)
+    {
+      wait_loop_index--;
+    }
+  }
+  else
+  {
+    /* If DAC is not enabled, we must wait LL_DAC_DELAY_STARTUP_VOLTAGE_SETTLING_US*/
+    LL_DAC_Enable(DACx, DAC_Channel);
+    volatile uint32_t wait_loop_index = ((LL_DAC_DELAY_STARTUP_VOLTAGE_SETTLING_US)
+                                         * (SystemCoreClock / (1000000UL * 2UL)));
+    while (wait_loop_index != 0UL)
+    {
+      wait_loop_index--;
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -28,6 +28,11 @@
 
 #define STSPIN32G4_I2C_TIMEOUT      (100)
 #define STSPIN32G4_I2C_LOCKCODE     (0xD)
+#define STSPIN32G4_I2C_LOCKVALUE    (((STSPIN32G4_I2C_LOCKCODE << 4) & 0xf0) | (STSPIN32G4_I2C_LOCKCODE & 0x0f))
+#define STSPIN32G4_I2C_UNLOCKVALUE  ((((~STSPIN32G4_I2C_LOCKCODE) << 4) & 0xf0) | (STSPIN32G4_I2C_LOCKCODE & 0x0f))
+#define STSPIN32G4_I2C_STATUS_LOCK  (1<<7)  /* Bit lock of register STATUS */
+
+#define STSPIN32G4_QUEUE_MASK       (STSPIN32G4_QUEUE_SIZE - 1U)
 
 #define GD_READY_GPIO_Port GPIOE
 #define GD_READY_Pin GPIO_PIN_14
@@ -52,6 +57,15 @@ HAL_StatusTypeDef STSPIN32G4_init(STSPIN32G4_HandleTypeDef *hdl)
   }
 
   hdl->i2cHdl = &hi2c3;
+  hdl->head = 0;
+  hdl->tail = 0;
+  hdl->running = false;
+  hdl->phase = 0;
+  hdl->reading = false;
+  hdl->batchFailed = false;
+  hdl->batchErrors = 0;
+  hdl->statusPending = false;
+  hdl->statusValid = false;
 
   __HAL_RCC_GPIOE_CLK_ENABLE();
 
@@ -107,7 +121,7 @@ HAL_StatusTypeDef STSPIN32G4_lockReg(STSPIN32G4_HandleTypeDef *hdl)
     return HAL_ERROR;
   }
 
-  i2cReg = ((STSPIN32G4_I2C_LOCKCODE << 4) & 0xf0) | (STSPIN32G4_I2C_LOCKCODE & 0x0f);
+  i2cReg = STSPIN32G4_I2C_LOCKVALUE;
   status = STSPIN32G4_writeReg(hdl, STSPIN32G4_I2C_LOCK, i2cReg);
 
 #ifdef STSPIN32G4_I2C_LOCKUSEPARANOID
@@ -137,7 +151,7 @@ HAL_StatusTypeDef STSPIN32G4_unlockReg(STSPIN32G4_HandleTypeDef *hdl)
     return HAL_ERROR;
   }
 
-  i2cReg = (((~STSPIN32G4_I2C_LOCKCODE) << 4) & 0xf0) | (STSPIN32G4_I2C_LOCKCODE & 0x0f);
+  i2cReg = STSPIN32G4_I2C_UNLOCKVALUE;
   status = STSPIN32G4_writeReg(hdl, STSPIN32G4_I2C_LOCK, i2cReg);
 
 #ifdef STSPIN32G4_I2C_LOCKUSEPARANOID
@@ -170,6 +184,12 @@ HAL_StatusTypeDef STSPIN32G4_readReg(STSPIN32G4_HandleTypeDef *hdl, uint8_t regA
     return HAL_ERROR;
   }
 
+  /* The bus belongs to the transaction queue until it is empty */
+  if (hdl->running)
+  {
+    return HAL_BUSY;
+  }
+
   status = HAL_I2C_Mem_Read(hdl->i2cHdl, STSPIN32G4_I2C_ADDR, (uint16_t) regAddr, 1, value, 1, STSPIN32G4_I2C_TIMEOUT);
   return status;
 }
@@ -183,6 +203,11 @@ HAL_StatusTypeDef STSPIN32G4_writeReg(STSPIN32G4_HandleTypeDef *hdl, uint8_t reg
     return HAL_ERROR;
   }
 
+  if (hdl->running)
+  {
+    return HAL_BUSY;
+  }
+
   status = HAL_I2C_Mem_Write(hdl->i2cHdl, STSPIN32G4_I2C_ADDR, (uint16_t) regAddr, 1, &value, 1, STSPIN32G4_I2C_TIMEOUT);
   return status;
 }
@@ -979,3 +1004,372 @@ HAL_StatusTypeDef STSPIN32G4_getStatus(STSPIN32G4_HandleTypeDef *hdl, STSPIN32G4
   return STSPIN32G4_readReg(hdl, STSPIN32G4_I2C_STATUS, (uint8_t *)status);
 }
 
+
+/* Starts the transfer of one register access: the write of its address and
+   value, or the transmit of its address for a read */
+static HAL_StatusTypeDef STSPIN32G4_startAccess(STSPIN32G4_HandleTypeDef *hdl, bool read, uint8_t regAddr,
+                                                uint8_t value)
+{
+  HAL_StatusTypeDef status;
+
+  hdl->buffer[0] = regAddr;
+  hdl->buffer[1] = value;
+  hdl->reading = read;
+
+  if (read)
+  {
+    /* The receive of the value follows with a repeated start */
+    status = HAL_I2C_Master_Seq_Transmit_IT(hdl->i2cHdl, STSPIN32G4_I2C_ADDR, hdl->buffer, 1, I2C_FIRST_FRAME);
+  }
+  else
+  {
+    status = HAL_I2C_Master_Seq_Transmit_IT(hdl->i2cHdl, STSPIN32G4_I2C_ADDR, hdl->buffer, 2,
+                                            I2C_FIRST_AND_LAST_FRAME);
+  }
+
+  return status;
+}
+
+static HAL_StatusTypeDef STSPIN32G4_startPhase(STSPIN32G4_HandleTypeDef *hdl, const STSPIN32G4_txnTypeDef *txn)
+{
+  HAL_StatusTypeDef status;
+
+  switch (txn->type)
+  {
+    case STSPIN32G4_TXN_STATUS:
+      status = STSPIN32G4_startAccess(hdl, true, STSPIN32G4_I2C_STATUS, 0);
+      break;
+
+    case STSPIN32G4_TXN_WRITE:
+      status = STSPIN32G4_startAccess(hdl, false, txn->regAddr, txn->value);
+      break;
+
+    case STSPIN32G4_TXN_UPDATE:
+      if (hdl->phase == 1)
+      {
+        status = STSPIN32G4_startAccess(hdl, false, txn->regAddr, hdl->written);
+      }
+      else
+      {
+        /* Read of the register, then read back of the written value */
+        status = STSPIN32G4_startAccess(hdl, true, txn->regAddr, 0);
+      }
+      break;
+
+    case STSPIN32G4_TXN_UNLOCK:
+    case STSPIN32G4_TXN_LOCK:
+      if (hdl->phase == 0)
+      {
+        status = STSPIN32G4_startAccess(hdl, false, STSPIN32G4_I2C_LOCK,
+                                        (txn->type == STSPIN32G4_TXN_LOCK) ? STSPIN32G4_I2C_LOCKVALUE
+                                                                           : STSPIN32G4_I2C_UNLOCKVALUE);
+      }
+      else
+      {
+        status = STSPIN32G4_startAccess(hdl, true, STSPIN32G4_I2C_STATUS, 0);
+      }
+      break;
+
+    default:
+      status = HAL_ERROR;
+      break;
+  }
+
+  return status;
+}
+
+static void STSPIN32G4_nextTxn(STSPIN32G4_HandleTypeDef *hdl)
+{
+  if (hdl->queue[hdl->tail].last)
+  {
+    hdl->batchFailed = false;
+  }
+
+  hdl->tail = (hdl->tail + 1U) & STSPIN32G4_QUEUE_MASK;
+  hdl->phase = 0;
+}
+
+static void STSPIN32G4_failTxn(STSPIN32G4_HandleTypeDef *hdl)
+{
+  if (!hdl->batchFailed)
+  {
+    hdl->batchErrors++;
+    hdl->batchFailed = true;
+  }
+
+  if (hdl->queue[hdl->tail].type == STSPIN32G4_TXN_STATUS)
+  {
+    hdl->statusPending = false;
+  }
+
+  STSPIN32G4_nextTxn(hdl);
+}
+
+/* Starts the next access of the queue, skipping the transactions of a failed
+   batch up to its lock */
+static void STSPIN32G4_runQueue(STSPIN32G4_HandleTypeDef *hdl)
+{
+  const STSPIN32G4_txnTypeDef *txn;
+  bool started = false;
+
+  while ((!started) && (hdl->tail != hdl->head))
+  {
+    txn = &hdl->queue[hdl->tail];
+
+    if (hdl->batchFailed && (txn->type != STSPIN32G4_TXN_LOCK))
+    {
+      STSPIN32G4_nextTxn(hdl);
+    }
+    else if (STSPIN32G4_startPhase(hdl, txn) == HAL_OK)
+    {
+      started = true;
+    }
+    else
+    {
+      STSPIN32G4_failTxn(hdl);
+    }
+  }
+
+  hdl->running = started;
+}
+
+/* End of an access of the running transaction */
+static void STSPIN32G4_accessDone(STSPIN32G4_HandleTypeDef *hdl)
+{
+  const STSPIN32G4_txnTypeDef *txn = &hdl->queue[hdl->tail];
+  bool done = true;
+  bool ok = true;
+
+  switch (txn->type)
+  {
+    case STSPIN32G4_TXN_STATUS:
+      *(uint8_t *)&hdl->polledStatus = hdl->data;
+      hdl->statusValid = true;
+      hdl->statusPending = false;
+      break;
+
+    case STSPIN32G4_TXN_UPDATE:
+      if (hdl->phase == 0)
+      {
+        hdl->written = (hdl->data & ~txn->mask) | (txn->value & txn->mask);
+        done = false;
+      }
+      else if (hdl->phase == 1)
+      {
+        done = false;
+      }
+      else
+      {
+        ok = (hdl->data == hdl->written);
+      }
+      break;
+
+    case STSPIN32G4_TXN_UNLOCK:
+    case STSPIN32G4_TXN_LOCK:
+#ifdef STSPIN32G4_I2C_LOCKUSEPARANOID
+      if (hdl->phase == 0)
+      {
+        done = false;
+      }
+      else
+      {
+        ok = ((hdl->data & STSPIN32G4_I2C_STATUS_LOCK) != 0) == (txn->type == STSPIN32G4_TXN_LOCK);
+      }
+#endif
+      break;
+
+    default:
+      break;
+  }
+
+  if (!ok)
+  {
+    STSPIN32G4_failTxn(hdl);
+  }
+  else if (done)
+  {
+    STSPIN32G4_nextTxn(hdl);
+  }
+  else
+  {
+    hdl->phase++;
+  }
+
+  STSPIN32G4_runQueue(hdl);
+}
+
+/* Adds a batch to the queue and starts it if the I2C is idle */
+static HAL_StatusTypeDef STSPIN32G4_enqueue(STSPIN32G4_HandleTypeDef *hdl, const STSPIN32G4_txnTypeDef *txns,
+                                            uint8_t nbTxns)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t primask = __get_PRIMASK();
+  uint8_t freeSlots;
+  uint8_t i;
+
+  /* The I2C interrupts and the other callers must not see a partial batch */
+  __disable_irq();
+
+  freeSlots = (STSPIN32G4_QUEUE_SIZE - 1U) - ((hdl->head - hdl->tail) & STSPIN32G4_QUEUE_MASK);
+  if ((nbTxns == 0) || (nbTxns > freeSlots))
+  {
+    status = HAL_BUSY;
+  }
+  else
+  {
+    for (i = 0; i < nbTxns; i++)
+    {
+      hdl->queue[(hdl->head + i) & STSPIN32G4_QUEUE_MASK] = txns[i];
+    }
+    hdl->queue[(hdl->head + nbTxns - 1U) & STSPIN32G4_QUEUE_MASK].last = true;
+    hdl->head = (hdl->head + nbTxns) & STSPIN32G4_QUEUE_MASK;
+
+    if (!hdl->running)
+    {
+      STSPIN32G4_runQueue(hdl);
+    }
+  }
+
+  __set_PRIMASK(primask);
+
+  return status;
+}
+
+HAL_StatusTypeDef STSPIN32G4_queueUpdates(STSPIN32G4_HandleTypeDef *hdl, const STSPIN32G4_regUpdateTypeDef *updates,
+                                          uint8_t nbUpdates, bool protectedRegs)
+{
+  STSPIN32G4_txnTypeDef txns[STSPIN32G4_QUEUE_SIZE];
+  uint8_t nbTxns = 0;
+  uint8_t i;
+
+  if ((hdl == NULL) || (updates == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  if ((nbUpdates + 2U) > STSPIN32G4_QUEUE_SIZE)
+  {
+    return HAL_BUSY;
+  }
+
+  if (protectedRegs)
+  {
+    txns[nbTxns++] = (STSPIN32G4_txnTypeDef){.type = STSPIN32G4_TXN_UNLOCK};
+  }
+
+  for (i = 0; i < nbUpdates; i++)
+  {
+    txns[nbTxns++] = (STSPIN32G4_txnTypeDef){.type = STSPIN32G4_TXN_UPDATE, .regAddr = updates[i].regAddr,
+                                             .mask = updates[i].mask, .value = updates[i].value};
+  }
+
+  if (protectedRegs)
+  {
+    txns[nbTxns++] = (STSPIN32G4_txnTypeDef){.type = STSPIN32G4_TXN_LOCK};
+  }
+
+  return STSPIN32G4_enqueue(hdl, txns, nbTxns);
+}
+
+HAL_StatusTypeDef STSPIN32G4_queueWrite(STSPIN32G4_HandleTypeDef *hdl, uint8_t regAddr, uint8_t value, bool protectedReg)
+{
+  STSPIN32G4_txnTypeDef txns[3];
+  uint8_t nbTxns = 0;
+
+  if (hdl == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  if (protectedReg)
+  {
+    txns[nbTxns++] = (STSPIN32G4_txnTypeDef){.type = STSPIN32G4_TXN_UNLOCK};
+  }
+
+  txns[nbTxns++] = (STSPIN32G4_txnTypeDef){.type = STSPIN32G4_TXN_WRITE, .regAddr = regAddr, .value = value};
+
+  if (protectedReg)
+  {
+    txns[nbTxns++] = (STSPIN32G4_txnTypeDef){.type = STSPIN32G4_TXN_LOCK};
+  }
+
+  return STSPIN32G4_enqueue(hdl, txns, nbTxns);
+}
+
+HAL_StatusTypeDef STSPIN32G4_pollStatus(STSPIN32G4_HandleTypeDef *hdl)
+{
+  const STSPIN32G4_txnTypeDef txn = {.type = STSPIN32G4_TXN_STATUS};
+  HAL_StatusTypeDef status = HAL_OK;
+
+  if (hdl == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  if (!hdl->statusPending)
+  {
+    hdl->statusPending = true;
+    status = STSPIN32G4_enqueue(hdl, &txn, 1);
+    if (status != HAL_OK)
+    {
+      hdl->statusPending = false;
+    }
+  }
+
+  return status;
+}
+
+HAL_StatusTypeDef STSPIN32G4_getPolledStatus(STSPIN32G4_HandleTypeDef *hdl, STSPIN32G4_statusTypeDef *status)
+{
+  if ((hdl == NULL) || (status == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  if (!hdl->statusValid)
+  {
+    return HAL_ERROR;
+  }
+
+  *status = hdl->polledStatus;
+  return HAL_OK;
+}
+
+uint16_t STSPIN32G4_getBatchErrors(STSPIN32G4_HandleTypeDef *hdl)
+{
+  return (hdl == NULL) ? 0 : hdl->batchErrors;
+}
+
+bool STSPIN32G4_isQueueBusy(STSPIN32G4_HandleTypeDef *hdl)
+{
+  return (hdl == NULL) ? false : (hdl->head != hdl->tail);
+}
+
+void STSPIN32G4_txCplt(STSPIN32G4_HandleTypeDef *hdl)
+{
+  if (hdl->reading)
+  {
+    hdl->reading = false;
+    if (HAL_I2C_Master_Seq_Receive_IT(hdl->i2cHdl, STSPIN32G4_I2C_ADDR, &hdl->data, 1, I2C_LAST_FRAME) != HAL_OK)
+    {
+      STSPIN32G4_failTxn(hdl);
+      STSPIN32G4_runQueue(hdl);
+    }
+  }
+  else
+  {
+    STSPIN32G4_accessDone(hdl);
+  }
+}
+
+void STSPIN32G4_rxCplt(STSPIN32G4_HandleTypeDef *hdl)
+{
+  STSPIN32G4_accessDone(hdl);
+}
+
+void STSPIN32G4_transferError(STSPIN32G4_HandleTypeDef *hdl)
+{
+  hdl->reading = false;
+  STSPIN32G4_failTxn(hdl);
+  STSPIN32G4_runQueue(hdl);
+}
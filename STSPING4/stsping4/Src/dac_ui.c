@@ -104,13 +104,14 @@ __weak void DAC_Exec(DAC_Handle_t *pHandle)
   {
 #endif
     uint32_t temp1;
-    temp1 = DACOFF + (uint32_t)*((uint16_t*) pHandle->ptrDataCh[DAC_CH1]); //cstat !MISRAC2012-Rule-11.3
-    LL_DAC_ConvertData12LeftAligned(DAC1, LL_DAC_CHANNEL_1, temp1);
-    LL_DAC_TrigSWConversion(DAC1, LL_DAC_CHANNEL_1);
     uint32_t temp2;
-    temp2 = DACOFF + (uint32_t)*((uint16_t*) pHandle->ptrDataCh[DAC_CH2]); //cstat !MISRAC2012-Rule-11.3
-    LL_DAC_ConvertData12LeftAligned(DAC1, LL_DAC_CHANNEL_2, temp2);
-    LL_DAC_TrigSWConversion(DAC1, LL_DAC_CHANNEL_2);
+    temp1 = (DACOFF + (uint32_t)*pHandle->ptrDataCh[DAC_CH1]) & 0xFFFFU;
+    temp2 = (DACOFF + (uint32_t)*pHandle->ptrDataCh[DAC_CH2]) << 16U;
+    /* Both channels are loaded by one write of the dual holding register and
+       converted by one software trigger. The plain writes avoid the read back of the
+       registers, slow on the peripheral bus, done by the LL functions. */
+    WRITE_REG(DAC1->DHR12LD, (temp1 | temp2) & (DAC_DHR12LD_DACC1DHR | DAC_DHR12LD_DACC2DHR));
+    WRITE_REG(DAC1->SWTRIGR, DAC_SWTRIGR_SWTRIG1 | DAC_SWTRIGR_SWTRIG2);
 #ifdef NULL_PTR_DAC_UI
   }
 #endif
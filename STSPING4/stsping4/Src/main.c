@@ -21,6 +21,22 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "mc_tasks.h"
+#ifdef MC_PWM_SYNC_MODE
+#include "mc_pwm_sync.h"
+#endif
+#ifdef MC_PWM_DITHER_MODE
+#include "mc_pwm_dither.h"
+#endif
+#ifdef MC_SPECTRUM_MODE
+#include "mc_spectrum.h"
+#endif
+#ifdef MC_STACK_MODE
+#include "mc_stack.h"
+#endif
+#ifdef MC_FDCAN_MODE
+#include "mc_fdcan.h"
+#endif
 
 /* USER CODE END Includes */
 
@@ -63,6 +79,12 @@ DMA_HandleTypeDef hdma_usart1_rx;
 DMA_HandleTypeDef hdma_usart1_tx;
 
 /* USER CODE BEGIN PV */
+#ifdef M1_ENCODER_SENSOR
+TIM_HandleTypeDef htim4;
+#endif
+#ifdef MC_FDCAN_MODE
+FDCAN_HandleTypeDef hfdcan1;
+#endif
 
 /* USER CODE END PV */
 
@@ -84,6 +106,18 @@ static void MX_TIM1_Init(void);
 static void MX_USART1_UART_Init(void);
 static void MX_NVIC_Init(void);
 /* USER CODE BEGIN PFP */
+#ifdef M1_ENCODER_SENSOR
+static void MX_TIM4_Init(void);
+#endif
+#ifdef MC_FDCAN_MODE
+static void MX_FDCAN1_Init(void);
+#endif
+#if defined(MC_PWM_SYNC_MODE) && (MC_PWM_SYNC_SOURCE == MC_PWM_SYNC_EXTI)
+static void MX_PWM_SYNC_Init(void);
+#endif
+#ifdef M1_ICL_ENABLED
+static void MX_ICL_Init(void);
+#endif
 
 /* USER CODE END PFP */
 
@@ -99,6 +133,10 @@ static void MX_NVIC_Init(void);
 int main(void)
 {
   /* USER CODE BEGIN 1 */
+#ifdef MC_STACK_MODE
+  /* Before the first interrupt */
+  MC_Stack_Paint();
+#endif
 
   /* USER CODE END 1 */
 
@@ -115,6 +153,10 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+#ifdef M1_ENCODER_SENSOR
+  /* Counting before MCboot, that initializes the encoder component */
+  MX_TIM4_Init();
+#endif
 
   /* USER CODE END SysInit */
 
@@ -138,6 +180,24 @@ int main(void)
   /* Initialize interrupts */
   MX_NVIC_Init();
   /* USER CODE BEGIN 2 */
+#ifdef MC_PWM_DITHER_MODE
+  MC_PwmDither_Init();
+#endif
+#ifdef MC_PWM_SYNC_MODE
+  MC_PwmSync_Init();
+#if (MC_PWM_SYNC_SOURCE == MC_PWM_SYNC_EXTI)
+  MX_PWM_SYNC_Init();
+#endif
+#endif
+#ifdef M1_ICL_ENABLED
+  /* The output keeps the state written by ICL_Init in MCboot */
+  MX_ICL_Init();
+#endif
+#ifdef MC_FDCAN_MODE
+  /* After the motor control, the commands being executed from the first frame */
+  MX_FDCAN1_Init();
+  MC_FDCAN_Start();
+#endif
 
 
 	initModelPredictiveControl();
@@ -151,6 +211,24 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+    MC_ProcessHostRequests();
+#ifdef MC_STACK_MODE
+    MC_Stack_Scan();
+#endif
+#ifdef MC_SPECTRUM_MODE
+    MC_Spectrum_Process();
+#endif
+#ifdef MC_LOW_POWER_IDLE
+    if (true == TSK_IsLowPowerIdle())
+    {
+      /* A frame received before the sleep waits for the next SysTick at most */
+      __WFI();
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif
   }
   /* USER CODE END 3 */
 }
@@ -211,22 +289,24 @@ void SystemClock_Config(void)
 static void MX_NVIC_Init(void)
 {
   /* USART1_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(USART1_IRQn, 3, 1);
+  HAL_NVIC_SetPriority(USART1_IRQn, MC_IRQ_PRIO_COMM, 1);
   HAL_NVIC_EnableIRQ(USART1_IRQn);
   /* DMA1_Channel2_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, 3, 0);
+  HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, MC_IRQ_PRIO_COMM, 0);
   HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
   /* TIM1_BRK_TIM15_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(TIM1_BRK_TIM15_IRQn, 4, 1);
+  HAL_NVIC_SetPriority(TIM1_BRK_TIM15_IRQn, TICK_INT_PRIORITY, 1);
   HAL_NVIC_EnableIRQ(TIM1_BRK_TIM15_IRQn);
   /* TIM1_UP_TIM16_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(TIM1_UP_TIM16_IRQn, 0, 0);
+  HAL_NVIC_SetPriority(TIM1_UP_TIM16_IRQn, MC_IRQ_PRIO_TIM_UP, 0);
   HAL_NVIC_EnableIRQ(TIM1_UP_TIM16_IRQn);
   /* ADC1_2_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(ADC1_2_IRQn, 2, 0);
+  HAL_NVIC_SetPriority(ADC1_2_IRQn, MC_IRQ_PRIO_HF, 0);
   HAL_NVIC_EnableIRQ(ADC1_2_IRQn);
+  /* PendSV_IRQn interrupt configuration: deferred duties of the high frequency task */
+  HAL_NVIC_SetPriority(PendSV_IRQn, MC_IRQ_PRIO_COMM, 0);
   /* EXTI15_10_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(EXTI15_10_IRQn, 3, 0);
+  HAL_NVIC_SetPriority(EXTI15_10_IRQn, MC_IRQ_PRIO_COMM, 0);
   HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
 }
 
@@ -824,13 +904,13 @@ static void MX_USART1_UART_Init(void)
 
   /* USER CODE END USART1_Init 1 */
   huart1.Instance = USART1;
-  huart1.Init.BaudRate = 1843200;
+  huart1.Init.BaudRate = MCP_UART_BAUDRATE_A;
   huart1.Init.WordLength = UART_WORDLENGTH_8B;
   huart1.Init.StopBits = UART_STOPBITS_1;
   huart1.Init.Parity = UART_PARITY_NONE;
   huart1.Init.Mode = UART_MODE_TX_RX;
   huart1.Init.HwFlowCtl = UART_HWCONTROL_NONE;
-  huart1.Init.OverSampling = UART_OVERSAMPLING_16;
+  huart1.Init.OverSampling = MCP_UART_OVERSAMPLING_A;
   huart1.Init.OneBitSampling = UART_ONE_BIT_SAMPLE_DISABLE;
   huart1.Init.ClockPrescaler = UART_PRESCALER_DIV1;
   huart1.AdvancedInit.AdvFeatureInit = UART_ADVFEATURE_NO_INIT;
@@ -919,6 +999,122 @@ static void MX_GPIO_Init(void)
 }
 
 /* USER CODE BEGIN 4 */
+#ifdef M1_ENCODER_SENSOR
+/**
+  * @brief TIM4 Initialization Function, quadrature encoder of Motor 1
+  * @param None
+  * @retval None
+  */
+static void MX_TIM4_Init(void)
+{
+  TIM_Encoder_InitTypeDef sConfig = {0};
+
+  htim4.Instance = TIM4;
+  htim4.Init.Prescaler = 0;
+  htim4.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim4.Init.Period = M1_PULSE_NBR;
+  htim4.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim4.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  sConfig.EncoderMode = TIM_ENCODERMODE_TI12;
+  sConfig.IC1Polarity = (ENC_INVERT_SPEED == ENABLE) ? TIM_ICPOLARITY_FALLING : TIM_ICPOLARITY_RISING;
+  sConfig.IC1Selection = TIM_ICSELECTION_DIRECTTI;
+  sConfig.IC1Prescaler = TIM_ICPSC_DIV1;
+  sConfig.IC1Filter = ENC_ICX_FILTER;
+  sConfig.IC2Polarity = TIM_ICPOLARITY_RISING;
+  sConfig.IC2Selection = TIM_ICSELECTION_DIRECTTI;
+  sConfig.IC2Prescaler = TIM_ICPSC_DIV1;
+  sConfig.IC2Filter = ENC_ICX_FILTER;
+  if (HAL_TIM_Encoder_Init(&htim4, &sConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  /* TIM4_IRQn interrupt configuration: overflows of the encoder counter */
+  HAL_NVIC_SetPriority(TIM4_IRQn, MC_IRQ_PRIO_COMM, 0);
+  HAL_NVIC_EnableIRQ(TIM4_IRQn);
+}
+#endif
+#ifdef MC_FDCAN_MODE
+/**
+  * @brief FDCAN1 Initialization Function, FD frames with bit rate switching
+  * @param None
+  * @retval None
+  */
+static void MX_FDCAN1_Init(void)
+{
+  /* 170 MHz PCLK1 kernel clock. Nominal phase: 17 MHz time quantum, 17 quanta per bit,
+     1 Mbit/s sampled at 82%. Data phase: 85 MHz time quantum, 17 quanta per bit,
+     5 Mbit/s sampled at 76% */
+  hfdcan1.Instance = FDCAN1;
+  hfdcan1.Init.ClockDivider = FDCAN_CLOCK_DIV1;
+  hfdcan1.Init.FrameFormat = FDCAN_FRAME_FD_BRS;
+  hfdcan1.Init.Mode = FDCAN_MODE_NORMAL;
+  /* A frame lost in a cycle is superseded by the next one */
+  hfdcan1.Init.AutoRetransmission = DISABLE;
+  hfdcan1.Init.TransmitPause = DISABLE;
+  hfdcan1.Init.ProtocolException = DISABLE;
+  hfdcan1.Init.NominalPrescaler = 10;
+  hfdcan1.Init.NominalSyncJumpWidth = 3;
+  hfdcan1.Init.NominalTimeSeg1 = 13;
+  hfdcan1.Init.NominalTimeSeg2 = 3;
+  hfdcan1.Init.DataPrescaler = 2;
+  hfdcan1.Init.DataSyncJumpWidth = 4;
+  hfdcan1.Init.DataTimeSeg1 = 12;
+  hfdcan1.Init.DataTimeSeg2 = 4;
+  hfdcan1.Init.StdFiltersNbr = MC_FDCAN_STD_FILTERS;
+  hfdcan1.Init.ExtFiltersNbr = 0;
+  hfdcan1.Init.TxFifoQueueMode = FDCAN_TX_FIFO_OPERATION;
+  if (HAL_FDCAN_Init(&hfdcan1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  /* FDCAN1_IT0_IRQn interrupt configuration: same preemption priority as the medium
+     frequency task, that executes the buffered commands written by the callback */
+  HAL_NVIC_SetPriority(FDCAN1_IT0_IRQn, TICK_INT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(FDCAN1_IT0_IRQn);
+}
+#endif
+#if defined(MC_PWM_SYNC_MODE) && (MC_PWM_SYNC_SOURCE == MC_PWM_SYNC_EXTI)
+/**
+  * @brief PWM_SYNC pin Initialization Function, rising edges of the sync event
+  * @param None
+  * @retval None
+  */
+static void MX_PWM_SYNC_Init(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  GPIO_InitStruct.Pin = PWM_SYNC_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+  GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+  HAL_GPIO_Init(PWM_SYNC_GPIO_Port, &GPIO_InitStruct);
+
+  /* PWM_SYNC_EXTI_IRQn interrupt configuration: above the high frequency task, that
+     would otherwise delay the reading of the carrier phase by its duration */
+  HAL_NVIC_SetPriority(PWM_SYNC_EXTI_IRQn, MC_IRQ_PRIO_PWM_SYNC, 0);
+  HAL_NVIC_EnableIRQ(PWM_SYNC_EXTI_IRQn);
+}
+#endif
+#ifdef M1_ICL_ENABLED
+/**
+  * @brief Bypass relay output of the inrush current limiter Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_ICL_Init(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_GPIOC_CLK_ENABLE();
+  GPIO_InitStruct.Pin = M1_ICL_SHUT_OUT_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+  HAL_GPIO_Init(M1_ICL_SHUT_OUT_GPIO_Port, &GPIO_InitStruct);
+}
+#endif
 
 /* USER CODE END 4 */
 
@@ -0,0 +1,378 @@
+/**
+  ******************************************************************************
+  * @file    mc_capture.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Triggered capture of 16 bits registers at the FOC rate
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "main.h"
+#include "register_interface.h"
+#include "mc_capture.h"
+#ifdef MC_TIMEBASE_MODE
+#include "mc_timebase.h"
+#endif
+
+#ifdef MC_CAPTURE_MODE
+
+#define MC_CAPTURE_MASK  (MC_CAPTURE_DEPTH - 1U)
+
+static MC_Capture_Config_t CaptureConfig;
+static const int16_t *pCaptureChannel[MC_CAPTURE_NB_CHANNELS];
+static int16_t CaptureRing[MC_CAPTURE_DEPTH][MC_CAPTURE_NB_CHANNELS];
+
+/* Written by the MCP requests, read by the high frequency task */
+static volatile MC_Capture_State_t CaptureState = MC_CAPTURE_IDLE;
+static volatile bool CaptureForce = false;
+
+static uint16_t hCaptureWrite;    /* Ring slot of the next sample */
+static uint16_t hCaptureFilled;   /* Samples recorded since armed, up to MC_CAPTURE_DEPTH */
+static uint16_t hCapturePost;     /* Post-trigger samples still to record */
+static uint16_t hCaptureBurst;    /* Changes of the trigger channel in the burst window */
+static uint16_t hCaptureStart;    /* Ring slot of the oldest sample of the frozen capture */
+static uint16_t hCaptureRead;     /* Next sample read by MC_Capture_Read */
+#ifdef MC_TIMEBASE_MODE
+/* Written by the high frequency task before the triggered state is published */
+static uint64_t dCaptureTrigger;
+#endif
+
+static void MC_Capture_Arm(void)
+{
+  /* The high frequency task does not touch the ring until the state is armed */
+  CaptureState = MC_CAPTURE_IDLE;
+  (void)memset(CaptureRing, 0, sizeof(CaptureRing));
+  hCaptureWrite = 0U;
+  hCaptureFilled = 0U;
+  hCaptureBurst = 0U;
+  hCaptureRead = 0U;
+  CaptureForce = false;
+  CaptureState = MC_CAPTURE_ARMED;
+}
+
+static bool MC_Capture_IsTriggered(uint16_t hFaults, const int16_t *pSample, const int16_t *pPrevious)
+{
+  int16_t hValue = pSample[CaptureConfig.bTrigChannel];
+  int16_t hPrevious = pPrevious[CaptureConfig.bTrigChannel];
+  bool bTriggered;
+
+  switch (CaptureConfig.bTrigger)
+  {
+    case (uint8_t)MC_CAPTURE_TRIG_FAULT:
+    {
+      bTriggered = (hFaults != 0U);
+      break;
+    }
+
+    case (uint8_t)MC_CAPTURE_TRIG_RISING:
+    {
+      bTriggered = (hPrevious < CaptureConfig.hTrigLevel) && (hValue >= CaptureConfig.hTrigLevel);
+      break;
+    }
+
+    case (uint8_t)MC_CAPTURE_TRIG_FALLING:
+    {
+      bTriggered = (hPrevious > CaptureConfig.hTrigLevel) && (hValue <= CaptureConfig.hTrigLevel);
+      break;
+    }
+
+    case (uint8_t)MC_CAPTURE_TRIG_BURST:
+    {
+      bTriggered = ((int32_t)hCaptureBurst >= (int32_t)CaptureConfig.hTrigLevel);
+      break;
+    }
+
+    default:
+    {
+      bTriggered = false;
+      break;
+    }
+  }
+  return (bTriggered);
+}
+
+/* Fills pChannel with the registers of the channels, and returns false if the
+   configuration is refused */
+static bool MC_Capture_Resolve(const MC_Capture_Config_t *pConfig, const int16_t *pChannel[])
+{
+  void *pData;
+  uint8_t i;
+  bool bValid = (pConfig->hPreTrigger < MC_CAPTURE_DEPTH)
+             && (pConfig->bTrigChannel < MC_CAPTURE_NB_CHANNELS)
+             && (pConfig->bTrigger <= (uint8_t)MC_CAPTURE_TRIG_BURST);
+
+  for (i = 0U; i < MC_CAPTURE_NB_CHANNELS; i++)
+  {
+    if (RI_GetPtrReg(pConfig->hRegID[i], &pData) != MCP_CMD_OK)
+    {
+      bValid = false;
+    }
+    else
+    {
+      pChannel[i] = (const int16_t *)pData; //cstat !MISRAC2012-Rule-11.5
+    }
+  }
+  return (bValid);
+}
+
+/**
+ * @brief  Checks a capture configuration without applying it.
+ * @retval bool False if MC_Capture_Configure would refuse it
+ */
+bool MC_Capture_Check(const MC_Capture_Config_t *pConfig)
+{
+  const int16_t *pChannel[MC_CAPTURE_NB_CHANNELS];
+
+  return (MC_Capture_Resolve(pConfig, pChannel));
+}
+
+/**
+ * @brief  Configures the channels and the trigger of the capture and arms it.
+ * @param  pConfig: capture configuration
+ * @retval bool False if a channel is not a 16 bits register known by RI_GetPtrReg
+ *         or the trigger is out of range. The capture is then left unchanged.
+ */
+bool MC_Capture_Configure(const MC_Capture_Config_t *pConfig)
+{
+  const int16_t *pChannel[MC_CAPTURE_NB_CHANNELS];
+  bool bValid = MC_Capture_Resolve(pConfig, pChannel);
+
+  if (true == bValid)
+  {
+    CaptureState = MC_CAPTURE_IDLE;
+    CaptureConfig = *pConfig;
+    (void)memcpy(pCaptureChannel, pChannel, sizeof(pCaptureChannel));
+    MC_Capture_Arm();
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bValid);
+}
+
+/**
+ * @brief  Executes a MC_CAPTURE_CMD_xxx command.
+ * @retval bool False if the command is unknown, if the capture is armed again before
+ *         any configuration or triggered while it is not armed
+ */
+bool MC_Capture_Command(uint8_t bCmd)
+{
+  bool bDone = true;
+
+  switch (bCmd)
+  {
+    case MC_CAPTURE_CMD_STOP:
+    {
+      CaptureState = MC_CAPTURE_IDLE;
+      break;
+    }
+
+    case MC_CAPTURE_CMD_ARM:
+    {
+      if (MC_NULL == pCaptureChannel[0])
+      {
+        bDone = false;
+      }
+      else
+      {
+        MC_Capture_Arm();
+      }
+      break;
+    }
+
+    case MC_CAPTURE_CMD_TRIGGER:
+    {
+      if (MC_CAPTURE_ARMED == CaptureState)
+      {
+        CaptureForce = true;
+      }
+      else
+      {
+        bDone = false;
+      }
+      break;
+    }
+
+    default:
+    {
+      bDone = false;
+      break;
+    }
+  }
+  return (bDone);
+}
+
+/**
+ * @brief  Records one sample of every channel while the capture is armed or
+ *         triggered. It must be called once per FOC period by the high frequency
+ *         task, after the current controller and the observer.
+ * @param  hFaults: current faults of the drive, tested by MC_CAPTURE_TRIG_FAULT
+ */
+void MC_Capture_Record(uint16_t hFaults)
+{
+  MC_Capture_State_t State = CaptureState;
+
+  if ((MC_CAPTURE_ARMED == State) || (MC_CAPTURE_TRIGGERED == State))
+  {
+    int16_t *pSample = CaptureRing[hCaptureWrite];
+    const int16_t *pPrevious = CaptureRing[(hCaptureWrite - 1U) & MC_CAPTURE_MASK];
+    const int16_t *pOldest = CaptureRing[(hCaptureWrite - MC_CAPTURE_BURST_WINDOW) & MC_CAPTURE_MASK];
+    const int16_t *pBeforeOldest = CaptureRing[(hCaptureWrite - MC_CAPTURE_BURST_WINDOW - 1U) & MC_CAPTURE_MASK];
+    uint8_t bCh = CaptureConfig.bTrigChannel;
+    uint8_t i;
+
+    for (i = 0U; i < MC_CAPTURE_NB_CHANNELS; i++)
+    {
+      pSample[i] = *pCaptureChannel[i];
+    }
+
+    /* Sliding count of the changes: the one of the new sample enters the window and
+       the one of its oldest sample leaves it. Both are still in the ring. */
+    if (pSample[bCh] != pPrevious[bCh])
+    {
+      hCaptureBurst++;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    if (pOldest[bCh] != pBeforeOldest[bCh])
+    {
+      hCaptureBurst--;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    hCaptureWrite = (hCaptureWrite + 1U) & MC_CAPTURE_MASK;
+
+    if (MC_CAPTURE_ARMED == State)
+    {
+      if (hCaptureFilled < MC_CAPTURE_DEPTH)
+      {
+        hCaptureFilled++;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      /* The trigger is only accepted once the pre-trigger part of the ring is filled */
+      if ((hCaptureFilled > CaptureConfig.hPreTrigger)
+          && ((true == CaptureForce) || (true == MC_Capture_IsTriggered(hFaults, pSample, pPrevious))))
+      {
+        hCapturePost = (MC_CAPTURE_DEPTH - 1U) - CaptureConfig.hPreTrigger;
+#ifdef MC_TIMEBASE_MODE
+        dCaptureTrigger = MC_Time_Get();
+#endif
+        State = MC_CAPTURE_TRIGGERED;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      hCapturePost--;
+    }
+
+    if ((MC_CAPTURE_TRIGGERED == State) && (0U == hCapturePost))
+    {
+      hCaptureStart = hCaptureWrite;
+      State = MC_CAPTURE_DONE;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    CaptureState = State;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+const MC_Capture_Config_t *MC_Capture_GetConfig(void)
+{
+  return (&CaptureConfig);
+}
+
+MC_Capture_State_t MC_Capture_GetState(void)
+{
+  return (CaptureState);
+}
+
+#ifdef MC_TIMEBASE_MODE
+/**
+ * @brief  Returns the time of the trigger sample, MC_TIME_NONE until the capture
+ *         armed last is triggered.
+ */
+uint64_t MC_Capture_GetTriggerTime(void)
+{
+  MC_Capture_State_t State = CaptureState;
+
+  return (((MC_CAPTURE_TRIGGERED == State) || (MC_CAPTURE_DONE == State)) ? dCaptureTrigger : MC_TIME_NONE);
+}
+#endif
+
+/**
+ * @brief  Sets the first sample read by the next MC_Capture_Read. The samples are
+ *         indexed in chronological order: the trigger one is at hPreTrigger.
+ */
+void MC_Capture_SetReadIndex(uint16_t hIndex)
+{
+  hCaptureRead = (hIndex < MC_CAPTURE_DEPTH) ? hIndex : MC_CAPTURE_DEPTH;
+}
+
+uint16_t MC_Capture_GetReadIndex(void)
+{
+  return (hCaptureRead);
+}
+
+/**
+ * @brief  Copies the samples of the frozen capture from the read index on, and
+ *         moves the read index after them.
+ * @param  pSamples: receives MC_CAPTURE_NB_CHANNELS values per sample
+ * @param  hMaxSamples: largest number of samples copied
+ * @retval uint16_t Number of samples copied, 0 if the capture is not done
+ */
+uint16_t MC_Capture_Read(int16_t *pSamples, uint16_t hMaxSamples)
+{
+  uint16_t hNbSamples = 0U;
+  uint16_t i;
+
+  if (MC_CAPTURE_DONE == CaptureState)
+  {
+    hNbSamples = MC_CAPTURE_DEPTH - hCaptureRead;
+    hNbSamples = (hNbSamples < hMaxSamples) ? hNbSamples : hMaxSamples;
+    for (i = 0U; i < hNbSamples; i++)
+    {
+      (void)memcpy(&pSamples[i * MC_CAPTURE_NB_CHANNELS],
+                   CaptureRing[(hCaptureStart + hCaptureRead + i) & MC_CAPTURE_MASK],
+                   sizeof(CaptureRing[0]));
+    }
+    hCaptureRead += hNbSamples;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (hNbSamples);
+}
+
+#endif /* MC_CAPTURE_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
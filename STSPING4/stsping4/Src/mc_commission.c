@@ -0,0 +1,713 @@
+/**
+  ******************************************************************************
+  * @file    mc_commission.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Identification of the model of the predictive current controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "main.h"
+#include "mc_math.h"
+#include "mc_commission.h"
+
+#ifdef MC_COMMISSION_MODE
+
+#if (CURRENT_CONTROLLER != CURR_CTRL_PCC) || !defined(PCC_MODEL_ESTIMATION)
+#error "MC_COMMISSION_MODE requires the PCC current controller and PCC_MODEL_ESTIMATION"
+#endif
+
+/* Page before the one of mc_offset_store, in the 128 KB flash of the STM32G431xB */
+#define MC_COMMISSION_FLASH_PAGE    62U
+#define MC_COMMISSION_FLASH_ADDR    (FLASH_BASE + (MC_COMMISSION_FLASH_PAGE * FLASH_PAGE_SIZE))
+
+#ifdef PCC_INDUCTANCE_TABLE
+#define MC_COMMISSION_MAGIC         0x4D4F4453U   /* "MODS", with the saturation table */
+/* Points of the table in the record, rounded up to a multiple of the programming unit */
+#define MC_COMMISSION_LSAT_WORDS    ((PCC_LSAT_POINTS + 3U) & ~3U)
+#else
+#define MC_COMMISSION_MAGIC         0x4D4F444CU   /* "MODL" */
+#endif
+#define MC_COMMISSION_ERASED        0xFFFFFFFFU
+
+#define MC_COMMISSION_SETTLE        ((uint16_t)1 << (MC_COMMISSION_SETTLE_LOG - 2U))
+#define MC_COMMISSION_AVG_END       (MC_COMMISSION_SETTLE + ((uint16_t)1 << MC_COMMISSION_AVG_LOG))
+/* One more cycle than averaged: the first one only fills the previous samples */
+#define MC_COMMISSION_PULSES_END    (8U * (((uint16_t)1 << MC_COMMISSION_CYCLES_LOG) + 1U))
+/* Smallest pulse left by the voltage that holds the current */
+#define MC_COMMISSION_MIN_PULSE     256
+#define MC_COMMISSION_RAD_PER_DPP   ((float_t)(3.14159265358979 / 32768.0)) /* rad per control period of 1 dpp */
+
+/* One record per commissioning, appended to the page as the offsets of mc_offset_store.
+   The size is a multiple of the 64-bit programming unit. */
+typedef struct
+{
+  uint32_t wMagic;
+  float_t  fModel[MC_COMMISSION_NB_ESTIMATES];
+#ifdef PCC_INDUCTANCE_TABLE
+  uint16_t hLSatGain[MC_COMMISSION_LSAT_WORDS];
+#endif
+  uint32_t wSpare;
+  uint32_t wCrc;                    /* CRC-32 of the fields above */
+} MC_CommissionRecord_t;
+
+#define MC_COMMISSION_NB_SLOTS      (FLASH_PAGE_SIZE / sizeof(MC_CommissionRecord_t))
+
+/* Signs of the pulse of a cycle: two periods of each sign, then four periods for the
+   current to settle back. The change of the current between two samples is then the
+   same whether the voltage acts one period, or half a period, after its computation */
+static const int8_t PulseSigns[8] = {1, 1, -1, -1, 0, 0, 0, 0};
+
+static volatile MC_Commission_Phase_t Phase = MC_COMM_IDLE;
+static qd_t Iqdref;
+static qd_t Vhold;                /* Voltage that holds the current, averaged */
+static int16_t hCurrent;
+static int16_t hPulse;
+static uint16_t hCounter;         /* FOC periods since the start of the phase */
+static int32_t wIdSum;
+static int32_t wVdSum;
+static int32_t wVqSum;
+static int32_t wIdLowSum;         /* Sums at half the current */
+static int32_t wVdLowSum;
+static int16_t hPrevI;            /* Current of the pulsed axis at the previous period */
+static int16_t hPrevPulse[2];     /* Pulses of the last two periods */
+static int64_t lDiSum[3];         /* Sums of the current changes times the pulses, d, q
+                                     and d at a saturation point */
+static int64_t lPulseSum[3];      /* Sums of the squared pulses, d, q and saturation */
+static int32_t wFluxSums[4];      /* Iq, Id, Vq and Vd sums of the flux phase */
+static int32_t wSpeedSum;
+static uint16_t hFluxCount;
+static float_t fBusScale;
+static float_t fModel[MC_COMMISSION_NB_ESTIMATES];
+#ifdef PCC_INDUCTANCE_TABLE
+static uint8_t bLSatPoint;        /* Saturation point being measured */
+static uint8_t bLSatLast;         /* Last saturation point measured */
+static float_t fLSatK[PCC_LSAT_POINTS]; /* Current changes per voltage digit of the points */
+static int16_t hLSatStep;
+static qd_t VholdModel;           /* Voltage that holds MC_COMMISSION_CURRENT */
+static uint16_t hLSatGain[PCC_LSAT_POINTS];
+#endif
+
+static uint32_t MC_Commission_Crc(const MC_CommissionRecord_t *pRecord)
+{
+  const uint8_t *pData = (const uint8_t *)pRecord;
+  uint32_t wCrc = 0xFFFFFFFFU;
+  uint32_t i;
+  uint8_t bBit;
+
+  for (i = 0U; i < offsetof(MC_CommissionRecord_t, wCrc); i++)
+  {
+    wCrc ^= pData[i];
+    for (bBit = 0U; bBit < 8U; bBit++)
+    {
+      wCrc = ((wCrc & 1U) != 0U) ? ((wCrc >> 1) ^ 0xEDB88320U) : (wCrc >> 1);
+    }
+  }
+  return (~wCrc);
+}
+
+static bool MC_Commission_IsPlausible(const float_t *pModel)
+{
+  bool bPlausible = true;
+  uint8_t i;
+
+  for (i = 0U; i < MC_COMMISSION_NB_ESTIMATES; i++)
+  {
+    /* Also false for a NaN */
+    if (!(pModel[i] > 0.0f))
+    {
+      bPlausible = false;
+    }
+  }
+  return (bPlausible);
+}
+
+/* Returns the last valid record of the page, or NULL, and the first free slot */
+static const MC_CommissionRecord_t *MC_Commission_Scan(uint32_t *pFreeSlot)
+{
+  const MC_CommissionRecord_t *pRecords = (const MC_CommissionRecord_t *)MC_COMMISSION_FLASH_ADDR;
+  const MC_CommissionRecord_t *pLast = NULL;
+  uint32_t i = 0U;
+
+  while ((i < MC_COMMISSION_NB_SLOTS) && (pRecords[i].wMagic != MC_COMMISSION_ERASED))
+  {
+    /* A record interrupted by a reset fails its CRC and is skipped */
+    if ((MC_COMMISSION_MAGIC == pRecords[i].wMagic) && (MC_Commission_Crc(&pRecords[i]) == pRecords[i].wCrc))
+    {
+      pLast = &pRecords[i];
+    }
+    i++;
+  }
+  *pFreeSlot = i;
+  return (pLast);
+}
+
+static void MC_Commission_ClearSums(void)
+{
+  hCounter = 0U;
+  wIdSum = 0;
+  wVdSum = 0;
+  wVqSum = 0;
+}
+
+/* Current change per voltage digit and per period, from the sums of a pulse phase */
+static float_t MC_Commission_PulseGain(uint8_t bSlot)
+{
+  /* The pulses of the regressor are summed over two periods */
+  return ((lPulseSum[bSlot] > 0)
+          ? ((2.0f * (float_t)lDiSum[bSlot]) / ((float_t)lPulseSum[bSlot] * fBusScale)) : 0.0f);
+}
+
+/* Freezes the PI controllers on the averaged voltage that holds the current and bounds
+   the pulses by the voltage left. Returns the next phase */
+static MC_Commission_Phase_t MC_Commission_Hold(MC_Commission_Phase_t NextPhase)
+{
+  int16_t hAbsVq;
+
+  Vhold.d = (int16_t)(wVdSum >> MC_COMMISSION_AVG_LOG);
+  Vhold.q = (int16_t)(wVqSum >> MC_COMMISSION_AVG_LOG);
+  hAbsVq = (Vhold.q < 0) ? -Vhold.q : Vhold.q;
+  hAbsVq = (Vhold.d < -hAbsVq) ? -Vhold.d : ((Vhold.d > hAbsVq) ? Vhold.d : hAbsVq);
+  if (hPulse > ((2 * MC_COMMISSION_MAX_PULSE) - hAbsVq))
+  {
+    hPulse = (int16_t)((2 * MC_COMMISSION_MAX_PULSE) - hAbsVq);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  hCounter = 0U;
+  return ((hPulse < MC_COMMISSION_MIN_PULSE) ? MC_COMM_FAILED : NextPhase);
+}
+
+#ifdef PCC_INDUCTANCE_TABLE
+/* Holds the d current at the next saturation point to measure, or ends the standstill
+   phases after the last one */
+static void MC_Commission_NextLSatPoint(void)
+{
+  int32_t wLevel;
+
+  bLSatPoint++;
+  wLevel = (int32_t)hLSatStep * (int32_t)bLSatPoint;
+  if ((bLSatPoint < PCC_LSAT_POINTS) && (wLevel <= (int32_t)MC_COMMISSION_LSAT_CURRENT))
+  {
+    Iqdref.d = (int16_t)wLevel;
+    lDiSum[2] = 0;
+    lPulseSum[2] = 0;
+    hPrevPulse[0] = 0;
+    hPrevPulse[1] = 0;
+    MC_Commission_ClearSums();
+    Phase = MC_COMM_LSAT_HOLD;
+  }
+  else
+  {
+    /* Back to the current of the model for the acceleration */
+    Vhold = VholdModel;
+    Iqdref.d = hCurrent;
+    Phase = MC_COMM_SPIN;
+  }
+}
+#endif
+
+/**
+ * @brief  Starts the commissioning, run by the high frequency task up to MC_COMM_SPIN.
+ *         To be called by the medium frequency task before the PWM is switched on,
+ *         with the PI controllers cleared.
+ * @param  pPCC: predictor, whose nominal model gives the amplitude of the pulses
+ * @param  hCurrentRef: d current of the standstill phases, in digits
+ */
+void MC_Commission_Start(const PCC_Handle_t *pPCC, int16_t hCurrentRef)
+{
+  PCC_Tuning_t Tuning;
+  float_t fPulse;
+  uint8_t i;
+
+  PCC_GetTuning(pPCC, &Tuning);
+  fBusScale = ((float_t)pPCC->hBusScale) / ((float_t)PCC_BUS_SCALE_ONE);
+#ifdef PCC_INDUCTANCE_TABLE
+  hLSatStep = pPCC->hLSatStep;
+#endif
+  /* With the nominal model, a pulse moves the current by a quarter of hCurrentRef */
+  fPulse = (Tuning.wKVolt > 0)
+         ? ((((float_t)hCurrentRef) * (float_t)((int32_t)1 << Tuning.hCoefDivisorPOW2)) / (8.0f * (float_t)Tuning.wKVolt))
+         : (float_t)MC_COMMISSION_MAX_PULSE;
+  hPulse = (fPulse < (float_t)MC_COMMISSION_MAX_PULSE) ? (int16_t)fPulse : (int16_t)MC_COMMISSION_MAX_PULSE;
+
+  hCurrent = hCurrentRef;
+  Iqdref.q = 0;
+  Iqdref.d = 0;
+  Vhold.q = 0;
+  Vhold.d = 0;
+  hPrevPulse[0] = 0;
+  hPrevPulse[1] = 0;
+  for (i = 0U; i < 3U; i++)
+  {
+    lDiSum[i] = 0;
+    lPulseSum[i] = 0;
+  }
+  MC_Commission_ClearSums();
+  Phase = MC_COMM_ALIGN;
+}
+
+/**
+ * @brief  Ends the commissioning, whatever its phase. The model is not changed.
+ */
+void MC_Commission_Stop(void)
+{
+  Phase = MC_COMM_IDLE;
+}
+
+/**
+ * @brief  Phase of the last commissioning
+ */
+MC_Commission_Phase_t MC_Commission_GetPhase(void)
+{
+  return (Phase);
+}
+
+/**
+ * @brief  True while the voltage is given by MC_Commission_Exec() instead of the FOC
+ */
+bool MC_Commission_IsStandstill(void)
+{
+  return ((Phase >= MC_COMM_ALIGN) && (Phase <= MC_COMM_SPIN));
+}
+
+/**
+ * @brief  True while the PI controllers regulate MC_Commission_GetCurrentRef()
+ */
+bool MC_Commission_IsRegulating(void)
+{
+  return (((Phase >= MC_COMM_ALIGN) && (Phase <= MC_COMM_RS_HIGH)) || (MC_COMM_LSAT_HOLD == Phase));
+}
+
+/**
+ * @brief  Current references of the standstill phases
+ */
+qd_t MC_Commission_GetCurrentRef(void)
+{
+  return (Iqdref);
+}
+
+/**
+ * @brief  Runs one control period of the standstill phases. To be called by the high
+ *         frequency task while MC_Commission_IsStandstill(), at a fixed angle.
+ * @param  Iqd: measured currents in the q/d frame
+ * @param  Vqd: output of the PI controllers while MC_Commission_IsRegulating(),
+ *         ignored otherwise
+ * @retval qd_t Voltage to apply
+ */
+qd_t MC_Commission_Exec(qd_t Iqd, qd_t Vqd)
+{
+  qd_t Vout = Vqd;
+
+  hCounter++;
+  switch (Phase)
+  {
+    case MC_COMM_ALIGN:
+    {
+      /* The d current ramps up over the first half of the alignment */
+      if (hCounter < ((uint16_t)1 << (MC_COMMISSION_SETTLE_LOG - 1U)))
+      {
+        Iqdref.d = (int16_t)(((int32_t)hCurrent * (int32_t)hCounter) >> (MC_COMMISSION_SETTLE_LOG - 1U));
+      }
+      else if (hCounter < ((uint16_t)1 << MC_COMMISSION_SETTLE_LOG))
+      {
+        Iqdref.d = hCurrent;
+      }
+      else
+      {
+        Iqdref.d = hCurrent / 2;
+        MC_Commission_ClearSums();
+        Phase = MC_COMM_RS_LOW;
+      }
+      break;
+    }
+
+    case MC_COMM_RS_LOW:
+    case MC_COMM_RS_HIGH:
+    {
+      if (hCounter > MC_COMMISSION_SETTLE)
+      {
+        wIdSum += Iqd.d;
+        wVdSum += Vqd.d;
+        wVqSum += Vqd.q;
+      }
+      else
+      {
+        /* The current settles at its new level */
+      }
+
+      if (hCounter < MC_COMMISSION_AVG_END)
+      {
+        /* Nothing to do */
+      }
+      else if (MC_COMM_RS_LOW == Phase)
+      {
+        wIdLowSum = wIdSum;
+        wVdLowSum = wVdSum;
+        Iqdref.d = hCurrent;
+        MC_Commission_ClearSums();
+        Phase = MC_COMM_RS_HIGH;
+      }
+      else
+      {
+        /* From now on the PI controllers are frozen and the voltage that holds the
+           current is applied as is, with the pulses */
+        Phase = MC_Commission_Hold(MC_COMM_LD);
+        Vout = Vhold;
+      }
+      break;
+    }
+
+#ifdef PCC_INDUCTANCE_TABLE
+    case MC_COMM_LSAT_HOLD:
+    {
+      if (hCounter > MC_COMMISSION_SETTLE)
+      {
+        wVdSum += Vqd.d;
+        wVqSum += Vqd.q;
+      }
+      else
+      {
+        /* The current settles at the level of the point */
+      }
+
+      if (hCounter >= MC_COMMISSION_AVG_END)
+      {
+        Phase = MC_Commission_Hold(MC_COMM_LSAT);
+        Vout = Vhold;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      break;
+    }
+#endif
+
+    case MC_COMM_LD:
+    case MC_COMM_LQ:
+    case MC_COMM_LSAT:
+    {
+      uint8_t bSlot = (MC_COMM_LD == Phase) ? 0U : ((MC_COMM_LQ == Phase) ? 1U : 2U);
+      uint8_t bAxis = (1U == bSlot) ? 1U : 0U;
+      int16_t hI = (0U == bAxis) ? Iqd.d : Iqd.q;
+      int16_t hW = (int16_t)(PulseSigns[(hCounter - 1U) & 7U] * hPulse);
+      int32_t wS = (int32_t)hPrevPulse[0] + hPrevPulse[1];
+
+      if (hCounter > 8U)
+      {
+        lDiSum[bSlot] += (int64_t)((int32_t)hI - hPrevI) * wS;
+        lPulseSum[bSlot] += (int64_t)wS * wS;
+      }
+      else
+      {
+        /* First cycle, the previous samples may belong to the previous phase */
+      }
+      hPrevPulse[1] = hPrevPulse[0];
+      hPrevPulse[0] = hW;
+      hPrevI = hI;
+
+      Vout = Vhold;
+      if (0U == bAxis)
+      {
+        Vout.d += hW;
+      }
+      else
+      {
+        Vout.q += hW;
+      }
+
+      if (hCounter < MC_COMMISSION_PULSES_END)
+      {
+        /* Nothing to do */
+      }
+      else if (MC_COMM_LD == Phase)
+      {
+        hCounter = 0U;
+        Phase = MC_COMM_LQ;
+      }
+#ifdef PCC_INDUCTANCE_TABLE
+      else if (MC_COMM_LQ == Phase)
+      {
+        /* The points up to the current of the model keep its inductance */
+        bLSatPoint = (hLSatStep > 0) ? (uint8_t)(hCurrent / hLSatStep) : PCC_LSAT_POINTS;
+        bLSatLast = bLSatPoint;
+        VholdModel = Vhold;
+        MC_Commission_NextLSatPoint();
+      }
+      else
+      {
+        fLSatK[bLSatPoint] = MC_Commission_PulseGain(2U);
+        bLSatLast = bLSatPoint;
+        MC_Commission_NextLSatPoint();
+        Vout = Vhold;
+      }
+#else
+      else
+      {
+        hCounter = 0U;
+        Phase = MC_COMM_SPIN;
+      }
+#endif
+      break;
+    }
+
+    case MC_COMM_SPIN:
+    {
+      Vout = Vhold;
+      break;
+    }
+
+    default:
+      break;
+  }
+  return (Vout);
+}
+
+/**
+ * @brief  Computes the resistance and inductance terms of the standstill phases. To be
+ *         called by the medium frequency task in MC_COMM_SPIN, before the acceleration.
+ * @retval bool True if they are plausible and MC_COMM_RAMP is entered, false if
+ *         MC_COMM_FAILED is
+ */
+bool MC_Commission_Spin(void)
+{
+  float_t fDeltaI = (float_t)(wIdSum - wIdLowSum);
+  float_t fK[2];
+  uint8_t i;
+  bool bValid = (fDeltaI > 0.0f);
+
+  for (i = 0U; i < 2U; i++)
+  {
+    fK[i] = MC_Commission_PulseGain(i);
+    bValid = bValid && (fK[i] > 0.0f);
+  }
+#ifdef PCC_INDUCTANCE_TABLE
+  for (i = 0U; i < PCC_LSAT_POINTS; i++)
+  {
+    float_t fGain = 1.0f;
+
+    if ((true == bValid) && (hLSatStep > 0) && (i > (uint8_t)(hCurrent / hLSatStep)))
+    {
+      /* Ratio of the d inductance of the model to the one of the point */
+      uint8_t bPoint = (i < bLSatLast) ? i : bLSatLast;
+
+      fGain = (bPoint > (uint8_t)(hCurrent / hLSatStep)) ? (fLSatK[bPoint] / fK[0]) : 1.0f;
+      bValid = (fGain > 0.5f) && (fGain < 2.0f);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    hLSatGain[i] = (uint16_t)(fGain * (float_t)PCC_LSAT_ONE);
+  }
+#endif
+
+  if (true == bValid)
+  {
+    /* Voltages brought back to the nominal bus voltage of the predictor model */
+    fModel[MC_COMMISSION_RS] = (((float_t)(wVdSum - wVdLowSum)) * fBusScale) / fDeltaI;
+    fModel[MC_COMMISSION_LD] = 1.0f / fK[0];
+    fModel[MC_COMMISSION_LQ] = 1.0f / fK[1];
+    fModel[MC_COMMISSION_LS] = 0.5f * (fModel[MC_COMMISSION_LD] + fModel[MC_COMMISSION_LQ]);
+    bValid = (fModel[MC_COMMISSION_RS] > 0.0f);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  Phase = (true == bValid) ? MC_COMM_RAMP : MC_COMM_FAILED;
+  return (bValid);
+}
+
+/**
+ * @brief  Starts the averaging of the flux phase, once the speed is reached
+ */
+void MC_Commission_StartFlux(void)
+{
+  uint8_t i;
+
+  for (i = 0U; i < 4U; i++)
+  {
+    wFluxSums[i] = 0;
+  }
+  wSpeedSum = 0;
+  hFluxCount = 0U;
+  Phase = MC_COMM_FLUX;
+}
+
+/**
+ * @brief  Adds the currents and voltages of the FOC to the flux phase and, once
+ *         2^MC_COMMISSION_FLUX_LOG are added, computes the flux term. To be called
+ *         by the medium frequency task in MC_COMM_FLUX.
+ * @param  Iqd: currents of the last FOC period
+ * @param  Vqd: voltage of the last FOC period
+ * @param  hElSpeedDpp: electrical speed, in dpp per FOC period
+ */
+void MC_Commission_AccumulateFlux(qd_t Iqd, qd_t Vqd, int16_t hElSpeedDpp)
+{
+  wFluxSums[0] += Iqd.q;
+  wFluxSums[1] += Iqd.d;
+  wFluxSums[2] += Vqd.q;
+  wFluxSums[3] += Vqd.d;
+  wSpeedSum += hElSpeedDpp;
+  hFluxCount++;
+
+  if (hFluxCount >= ((uint16_t)1 << MC_COMMISSION_FLUX_LOG))
+  {
+    float_t fNbSamples = (float_t)hFluxCount;
+    float_t fIq = ((float_t)wFluxSums[0]) / fNbSamples;
+    float_t fId = ((float_t)wFluxSums[1]) / fNbSamples;
+    float_t fVq = (((float_t)wFluxSums[2]) / fNbSamples) * fBusScale;
+    float_t fVd = (((float_t)wFluxSums[3]) / fNbSamples) * fBusScale;
+    float_t fSpeed = ((float_t)wSpeedSum) / fNbSamples;
+    float_t fA = fModel[MC_COMMISSION_RS];
+    float_t fB = fModel[MC_COMMISSION_LS];
+    float_t fDelta = fSpeed * MC_COMMISSION_RAD_PER_DPP;
+    /* Back-EMF, in the frame of the Virtual Speed Sensor that leads the rotor by the
+       load angle: only its magnitude is used */
+    float_t fEd = (fVd - (fA * fId)) + (fDelta * fB * fIq);
+    float_t fEq = (fVq - (fA * fIq)) - (fDelta * fB * fId);
+    float_t fSq = (fEd * fEd) + (fEq * fEq);
+
+    fSpeed = (fSpeed < 0.0f) ? -fSpeed : fSpeed;
+    fSq = (fSq < 2147483520.0f) ? fSq : 2147483520.0f;
+    if (fSpeed > 0.0f)
+    {
+      fModel[MC_COMMISSION_FLUX] = ((float_t)MCM_Sqrt((int32_t)fSq)) / fSpeed;
+      Phase = (true == MC_Commission_IsPlausible(fModel)) ? MC_COMM_DONE : MC_COMM_FAILED;
+    }
+    else
+    {
+      Phase = MC_COMM_FAILED;
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+ * @brief  One of the estimates of the last commissioning, or of the stored one
+ * @param  bParam: 0 to 2 for the a, b and c terms, MC_COMMISSION_LD or MC_COMMISSION_LQ
+ * @retval float_t Estimate, in the units of the predictor, 0 if bParam is out of range
+ */
+float_t MC_Commission_GetEstimate(uint8_t bParam)
+{
+  return ((bParam < MC_COMMISSION_NB_ESTIMATES) ? fModel[bParam] : 0.0f);
+}
+
+/**
+ * @brief  Makes the identified model the nominal model of the estimator and stages its
+ *         coefficients in the predictor
+ * @param  pEst: model estimator
+ * @param  pPCC: predictor that uses the model
+ */
+void MC_Commission_Apply(PCC_EST_Handle_t *pEst, PCC_Handle_t *pPCC)
+{
+  PCC_EST_SetModel(pEst, pPCC, fModel);
+#ifdef PCC_INDUCTANCE_TABLE
+  PCC_SetInductanceTable(pPCC, hLSatGain);
+#endif
+}
+
+/**
+ * @brief  Reads the model of the last commissioning stored in flash.
+ * @retval bool True if the stored model passes its CRC and is plausible
+ */
+bool MC_Commission_Load(void)
+{
+  const MC_CommissionRecord_t *pRecord;
+  uint32_t wFreeSlot;
+  bool bValid = false;
+
+  pRecord = MC_Commission_Scan(&wFreeSlot);
+  if ((pRecord != NULL) && (true == MC_Commission_IsPlausible(pRecord->fModel)))
+  {
+    (void)memcpy(fModel, pRecord->fModel, sizeof(fModel));
+#ifdef PCC_INDUCTANCE_TABLE
+    (void)memcpy(hLSatGain, pRecord->hLSatGain, sizeof(hLSatGain));
+#endif
+    bValid = true;
+  }
+  return (bValid);
+}
+
+/**
+ * @brief  Appends the model of a completed commissioning to the flash page, unless it
+ *         is equal to the last stored one. The flash is not readable while it is
+ *         written: it must be called with the PWM switched off.
+ */
+void MC_Commission_Save(void)
+{
+  const MC_CommissionRecord_t *pLast;
+  MC_CommissionRecord_t Record;
+  uint32_t wFreeSlot;
+  uint32_t wAddress;
+  uint64_t Words[sizeof(MC_CommissionRecord_t) / sizeof(uint64_t)];
+  uint32_t i;
+  bool bWrite = (MC_COMM_DONE == Phase);
+
+  pLast = MC_Commission_Scan(&wFreeSlot);
+  if ((true == bWrite) && (pLast != NULL) && (0 == memcmp(pLast->fModel, fModel, sizeof(fModel)))
+#ifdef PCC_INDUCTANCE_TABLE
+      && (0 == memcmp(pLast->hLSatGain, hLSatGain, sizeof(hLSatGain)))
+#endif
+     )
+  {
+    bWrite = false;
+  }
+
+  if (true == bWrite)
+  {
+    Record.wMagic = MC_COMMISSION_MAGIC;
+    (void)memcpy(Record.fModel, fModel, sizeof(fModel));
+#ifdef PCC_INDUCTANCE_TABLE
+    (void)memset(Record.hLSatGain, 0xFF, sizeof(Record.hLSatGain));
+    (void)memcpy(Record.hLSatGain, hLSatGain, sizeof(hLSatGain));
+#endif
+    Record.wSpare = MC_COMMISSION_ERASED;
+    Record.wCrc = MC_Commission_Crc(&Record);
+    (void)memcpy(Words, &Record, sizeof(Record));
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    if (wFreeSlot >= MC_COMMISSION_NB_SLOTS)
+    {
+      FLASH_EraseInitTypeDef Erase;
+      uint32_t wPageError;
+
+      Erase.TypeErase = FLASH_TYPEERASE_PAGES;
+      Erase.Banks = FLASH_BANK_1;
+      Erase.Page = MC_COMMISSION_FLASH_PAGE;
+      Erase.NbPages = 1U;
+      (void)HAL_FLASHEx_Erase(&Erase, &wPageError);
+      wFreeSlot = 0U;
+    }
+    wAddress = MC_COMMISSION_FLASH_ADDR + (wFreeSlot * sizeof(MC_CommissionRecord_t));
+    for (i = 0U; i < (sizeof(MC_CommissionRecord_t) / sizeof(uint64_t)); i++)
+    {
+      (void)HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, wAddress + (i * sizeof(uint64_t)), Words[i]);
+    }
+    HAL_FLASH_Lock();
+  }
+}
+
+#endif /* MC_COMMISSION_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,428 @@
+/**
+  ******************************************************************************
+  * @file    mc_fra.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Frequency response analysis of the current and speed loops
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "main.h"
+#include "mc_math.h"
+#include "parameters_conversion.h"
+#include "register_interface.h"
+#include "mc_fra.h"
+
+#ifdef MC_FRA_MODE
+
+static MC_Fra_Config_t FraConfig;
+static const int16_t *pFraChannel[MC_FRA_NB_CHANNELS];
+static uint32_t wFraStep[MC_FRA_MAX_POINTS];   /* Phase step per FOC period, 2^32 per period of the sine */
+static uint32_t wFraTicks[MC_FRA_MAX_POINTS];  /* FOC periods of the correlation */
+/* Sums of the products of each channel with the sine, then with the cosine */
+static int64_t FraSums[MC_FRA_MAX_POINTS][MC_FRA_NB_CHANNELS][2];
+
+/* Written by the MCP requests, read by the high frequency task */
+static volatile MC_Fra_State_t FraState = MC_FRA_IDLE;
+/* Written by the high frequency task, read by the MCP requests */
+static volatile uint8_t bFraDone;  /* Points measured since the start */
+
+static uint8_t bFraPoint;         /* Point of the injection */
+static uint32_t wFraCount;        /* Periods of the sine settled, then FOC periods correlated */
+static uint32_t wFraPhase;        /* Phase of the sine, 2^32 per period */
+static int16_t hFraSin;           /* Sine and cosine of the phase of the period */
+static int16_t hFraCos;
+static int16_t hFraExcitation;    /* Injected value of the period */
+static uint16_t hFraRead;         /* Next point read by MC_Fra_Read */
+
+static int16_t MC_Fra_Add(int16_t hValue, int16_t hDelta)
+{
+  int32_t wSum = (int32_t)hValue + hDelta;
+
+  if (wSum > INT16_MAX)
+  {
+    wSum = INT16_MAX;
+  }
+  else if (wSum < -INT16_MAX)
+  {
+    wSum = -INT16_MAX;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return ((int16_t)wSum);
+}
+
+static bool MC_Fra_IsInjecting(void)
+{
+  MC_Fra_State_t State = FraState;
+
+  return ((MC_FRA_SETTLING == State) || (MC_FRA_MEASURING == State));
+}
+
+static MC_Fra_State_t MC_Fra_FirstState(void)
+{
+  return ((0U == FraConfig.hSettleCycles) ? MC_FRA_MEASURING : MC_FRA_SETTLING);
+}
+
+/**
+ * @brief  Configures the injection, the channels and the frequencies of the sweep.
+ *         A sweep in progress is stopped.
+ * @param  pConfig: analysis configuration
+ * @retval bool False if a channel is not a 16 bits register known by RI_GetPtrReg,
+ *         the injection or the number of points is out of range or a frequency has
+ *         less than 4 FOC periods per period. The configuration is then left unchanged.
+ */
+bool MC_Fra_Configure(const MC_Fra_Config_t *pConfig)
+{
+  const int16_t *pChannel[MC_FRA_NB_CHANNELS];
+  uint32_t wStep[MC_FRA_MAX_POINTS];
+  uint32_t wTicks[MC_FRA_MAX_POINTS];
+  void *pData;
+  uint8_t i;
+  bool bValid = (pConfig->bInjection <= (uint8_t)MC_FRA_INJ_VD)
+             && (pConfig->bNbPoints > 0U) && (pConfig->bNbPoints <= MC_FRA_MAX_POINTS)
+             && (pConfig->hAmplitude > 0) && (pConfig->hCycles > 0U);
+
+  for (i = 0U; i < MC_FRA_NB_CHANNELS; i++)
+  {
+    if (RI_GetPtrReg(pConfig->hRegID[i], &pData) != MCP_CMD_OK)
+    {
+      bValid = false;
+    }
+    else
+    {
+      pChannel[i] = (const int16_t *)pData; //cstat !MISRAC2012-Rule-11.5
+    }
+  }
+
+  for (i = 0U; (i < pConfig->bNbPoints) && (true == bValid); i++)
+  {
+    uint32_t wFreq_mHz = pConfig->wFreq_mHz[i];
+
+    if ((0U == wFreq_mHz) || (((uint64_t)wFreq_mHz * 4U) > ((uint64_t)TF_REGULATION_RATE * 1000U)))
+    {
+      bValid = false;
+    }
+    else
+    {
+      /* The whole periods of the sine fill a whole number of FOC periods */
+      uint64_t dTicks = ((((uint64_t)pConfig->hCycles * TF_REGULATION_RATE * 1000U) + (wFreq_mHz / 2U))
+                         / wFreq_mHz);
+      if (dTicks > UINT32_MAX)
+      {
+        bValid = false;
+      }
+      else
+      {
+        wTicks[i] = (uint32_t)dTicks;
+        wStep[i] = (uint32_t)(((uint64_t)pConfig->hCycles << 32) / dTicks);
+      }
+    }
+  }
+
+  if (true == bValid)
+  {
+    FraState = MC_FRA_IDLE;
+    FraConfig = *pConfig;
+    (void)memcpy(pFraChannel, pChannel, sizeof(pFraChannel));
+    (void)memcpy(wFraStep, wStep, pConfig->bNbPoints * sizeof(wStep[0]));
+    (void)memcpy(wFraTicks, wTicks, pConfig->bNbPoints * sizeof(wTicks[0]));
+    bFraDone = 0U;
+    hFraRead = 0U;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (bValid);
+}
+
+/**
+ * @brief  Executes a MC_FRA_CMD_xxx command.
+ * @retval bool False if the command is unknown or the sweep is started before any
+ *         configuration
+ */
+bool MC_Fra_Command(uint8_t bCmd)
+{
+  bool bDone = true;
+
+  switch (bCmd)
+  {
+    case MC_FRA_CMD_STOP:
+    {
+      FraState = MC_FRA_IDLE;
+      break;
+    }
+
+    case MC_FRA_CMD_START:
+    {
+      if (0U == FraConfig.bNbPoints)
+      {
+        bDone = false;
+      }
+      else
+      {
+        /* The high frequency task does not touch the sweep until it is started */
+        FraState = MC_FRA_IDLE;
+        (void)memset(FraSums, 0, sizeof(FraSums));
+        bFraDone = 0U;
+        bFraPoint = 0U;
+        wFraCount = 0U;
+        wFraPhase = 0U;
+        hFraSin = 0;
+        hFraCos = INT16_MAX;
+        hFraExcitation = 0;
+        hFraRead = 0U;
+        FraState = MC_Fra_FirstState();
+      }
+      break;
+    }
+
+    default:
+    {
+      bDone = false;
+      break;
+    }
+  }
+  return (bDone);
+}
+
+const MC_Fra_Config_t *MC_Fra_GetConfig(void)
+{
+  return (&FraConfig);
+}
+
+MC_Fra_State_t MC_Fra_GetState(void)
+{
+  return (FraState);
+}
+
+/**
+ * @brief  Adds the sine of the period to the current reference selected by the
+ *         configuration, while a sweep is in progress.
+ * @param  Iqdref: current references of the period
+ * @retval qd_t Current references to regulate
+ */
+qd_t MC_Fra_InjectCurrent(qd_t Iqdref)
+{
+  qd_t Result = Iqdref;
+
+  if (true == MC_Fra_IsInjecting())
+  {
+    if ((uint8_t)MC_FRA_INJ_IQ_REF == FraConfig.bInjection)
+    {
+      Result.q = MC_Fra_Add(Iqdref.q, hFraExcitation);
+    }
+    else if ((uint8_t)MC_FRA_INJ_ID_REF == FraConfig.bInjection)
+    {
+      Result.d = MC_Fra_Add(Iqdref.d, hFraExcitation);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (Result);
+}
+
+/**
+ * @brief  Adds the sine of the period to the controller voltage selected by the
+ *         configuration, while a sweep is in progress.
+ * @param  Vqd: voltage of the current controller, before the circle limitation
+ * @retval qd_t Voltage to apply
+ */
+qd_t MC_Fra_InjectVoltage(qd_t Vqd)
+{
+  qd_t Result = Vqd;
+
+  if (true == MC_Fra_IsInjecting())
+  {
+    if ((uint8_t)MC_FRA_INJ_VQ == FraConfig.bInjection)
+    {
+      Result.q = MC_Fra_Add(Vqd.q, hFraExcitation);
+    }
+    else if ((uint8_t)MC_FRA_INJ_VD == FraConfig.bInjection)
+    {
+      Result.d = MC_Fra_Add(Vqd.d, hFraExcitation);
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  return (Result);
+}
+
+/**
+ * @brief  Correlates the channels with the sine of the period, then moves the sine to
+ *         the next period. It must be called once per FOC period by the high frequency
+ *         task, after the current controller. Its cost does not depend on the point.
+ * @param  Running: true while the drive is in RUN, a sweep is stopped otherwise
+ */
+void MC_Fra_Measure(bool Running)
+{
+  MC_Fra_State_t State = FraState;
+
+  if ((MC_FRA_SETTLING == State) || (MC_FRA_MEASURING == State))
+  {
+    if (false == Running)
+    {
+      State = MC_FRA_IDLE;
+    }
+    else
+    {
+      uint32_t wPrevPhase = wFraPhase;
+      Trig_Components Trig;
+
+      if (MC_FRA_MEASURING == State)
+      {
+        int64_t (*pSums)[2] = FraSums[bFraPoint];
+        uint8_t i;
+
+        for (i = 0U; i < MC_FRA_NB_CHANNELS; i++)
+        {
+          int32_t wValue = (int32_t)*pFraChannel[i];
+          pSums[i][0] += (int64_t)(wValue * hFraSin);
+          pSums[i][1] += (int64_t)(wValue * hFraCos);
+        }
+
+        wFraCount++;
+        if (wFraCount >= wFraTicks[bFraPoint])
+        {
+          /* Next frequency, from the phase reached */
+          bFraPoint++;
+          bFraDone = bFraPoint;
+          wFraCount = 0U;
+          State = (bFraPoint >= FraConfig.bNbPoints) ? MC_FRA_DONE : MC_Fra_FirstState();
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+
+      if (MC_FRA_DONE == State)
+      {
+        hFraExcitation = 0;
+      }
+      else
+      {
+        wFraPhase += wFraStep[bFraPoint];
+        if ((MC_FRA_SETTLING == State) && (wFraPhase < wPrevPhase))
+        {
+          /* One more period of the sine settled */
+          wFraCount++;
+          if (wFraCount >= FraConfig.hSettleCycles)
+          {
+            wFraCount = 0U;
+            State = MC_FRA_MEASURING;
+          }
+          else
+          {
+            /* Nothing to do */
+          }
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        Trig = MCM_Trig_Functions((int16_t)(wFraPhase >> 16));
+        hFraSin = Trig.hSin;
+        hFraCos = Trig.hCos;
+        hFraExcitation = (int16_t)(((int32_t)FraConfig.hAmplitude * Trig.hSin) >> 15);
+      }
+    }
+    /* A command of the link may have stopped the sweep meanwhile */
+    if (true == MC_Fra_IsInjecting())
+    {
+      FraState = State;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+ * @brief  Sets the first point read by the next MC_Fra_Read, 0 for the first
+ *         frequency of the configuration.
+ */
+void MC_Fra_SetReadIndex(uint16_t hIndex)
+{
+  hFraRead = (hIndex < MC_FRA_MAX_POINTS) ? hIndex : MC_FRA_MAX_POINTS;
+}
+
+uint16_t MC_Fra_GetReadIndex(void)
+{
+  return (hFraRead);
+}
+
+/**
+ * @brief  Copies the points measured from the read index on, and moves the read index
+ *         after them. The points already measured can be read while the sweep goes on.
+ * @param  pPoints: receives the points
+ * @param  hMaxPoints: largest number of points copied
+ * @retval uint16_t Number of points copied
+ */
+uint16_t MC_Fra_Read(MC_Fra_Point_t *pPoints, uint16_t hMaxPoints)
+{
+  uint16_t hDone = bFraDone;
+  uint16_t hNbPoints = (hDone > hFraRead) ? (uint16_t)(hDone - hFraRead) : 0U;
+  uint16_t i;
+  uint8_t j;
+
+  hNbPoints = (hNbPoints < hMaxPoints) ? hNbPoints : hMaxPoints;
+  for (i = 0U; i < hNbPoints; i++)
+  {
+    uint16_t hPoint = hFraRead + i;
+    int64_t dTicks = (int64_t)wFraTicks[hPoint];
+    MC_Fra_Point_t Point;
+
+    Point.wFreq_mHz = (uint32_t)((((uint64_t)FraConfig.hCycles * TF_REGULATION_RATE * 1000U)
+                                  + ((uint64_t)dTicks / 2U)) / (uint64_t)dTicks);
+    for (j = 0U; j < MC_FRA_NB_CHANNELS; j++)
+    {
+      /* Twice the mean of the products over whole periods: the amplitude of the part
+         of the channel in phase with the sine, then with the cosine */
+      Point.wInPhase[j] = (int32_t)((2 * FraSums[hPoint][j][0]) / dTicks);
+      Point.wQuadrature[j] = (int32_t)((2 * FraSums[hPoint][j][1]) / dTicks);
+    }
+    (void)memcpy(&pPoints[i], &Point, sizeof(MC_Fra_Point_t));
+  }
+  hFraRead += hNbPoints;
+  return (hNbPoints);
+}
+
+#endif /* MC_FRA_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,192 @@
+/**
+  ******************************************************************************
+  * @file    mc_offset_store.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   Storage of the current sensing offsets in flash
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "main.h"
+#include "mc_offset_store.h"
+
+#ifdef MC_OFFSETS_IN_FLASH
+
+/* Last page of the 128 KB flash of the STM32G431xB */
+#define MC_OFFSETS_FLASH_PAGE   63U
+#define MC_OFFSETS_FLASH_ADDR   (FLASH_BASE + (MC_OFFSETS_FLASH_PAGE * FLASH_PAGE_SIZE))
+
+#define MC_OFFSETS_MAGIC        0x4F464653U   /* "OFFS" */
+#define MC_OFFSETS_ERASED       0xFFFFFFFFU
+
+/* One record per calibration, appended to the page: the page is only erased when
+   it is full. The size is a multiple of the 64-bit programming unit. */
+typedef struct
+{
+  uint32_t wMagic;
+  PolarizationOffsets_t Offsets;
+  int32_t  wTemp_C;                 /* Heat sink temperature of the calibration */
+  uint32_t wCrc;                    /* CRC-32 of the fields above */
+} MC_OffsetRecord_t;
+
+#define MC_OFFSETS_NB_SLOTS     (FLASH_PAGE_SIZE / sizeof(MC_OffsetRecord_t))
+
+static uint32_t MC_OffsetStore_Crc(const MC_OffsetRecord_t *pRecord)
+{
+  const uint8_t *pData = (const uint8_t *)pRecord;
+  uint32_t wCrc = 0xFFFFFFFFU;
+  uint32_t i;
+  uint8_t bBit;
+
+  for (i = 0U; i < offsetof(MC_OffsetRecord_t, wCrc); i++)
+  {
+    wCrc ^= pData[i];
+    for (bBit = 0U; bBit < 8U; bBit++)
+    {
+      wCrc = ((wCrc & 1U) != 0U) ? ((wCrc >> 1) ^ 0xEDB88320U) : (wCrc >> 1);
+    }
+  }
+  return (~wCrc);
+}
+
+static bool MC_OffsetStore_IsPlausible(const PolarizationOffsets_t *pOffsets)
+{
+  int32_t Offsets[3];
+  bool bPlausible = true;
+  uint8_t i;
+
+  Offsets[0] = pOffsets->phaseAOffset;
+  Offsets[1] = pOffsets->phaseBOffset;
+  Offsets[2] = pOffsets->phaseCOffset;
+  for (i = 0U; i < 3U; i++)
+  {
+    if ((Offsets[i] < (MC_OFFSET_NOMINAL - MC_OFFSET_TOLERANCE))
+        || (Offsets[i] > (MC_OFFSET_NOMINAL + MC_OFFSET_TOLERANCE)))
+    {
+      bPlausible = false;
+    }
+  }
+  return (bPlausible);
+}
+
+/* Returns the last valid record of the page, or NULL, and the first free slot */
+static const MC_OffsetRecord_t *MC_OffsetStore_Scan(uint32_t *pFreeSlot)
+{
+  const MC_OffsetRecord_t *pRecords = (const MC_OffsetRecord_t *)MC_OFFSETS_FLASH_ADDR;
+  const MC_OffsetRecord_t *pLast = NULL;
+  uint32_t i = 0U;
+
+  while ((i < MC_OFFSETS_NB_SLOTS) && (pRecords[i].wMagic != MC_OFFSETS_ERASED))
+  {
+    /* A record interrupted by a reset fails its CRC and is skipped */
+    if ((MC_OFFSETS_MAGIC == pRecords[i].wMagic) && (MC_OffsetStore_Crc(&pRecords[i]) == pRecords[i].wCrc))
+    {
+      pLast = &pRecords[i];
+    }
+    i++;
+  }
+  *pFreeSlot = i;
+  return (pLast);
+}
+
+/**
+ * @brief  Reads the offsets of the last calibration stored in flash.
+ * @param  pOffsets: filled with the stored offsets
+ * @param  hTemp_C: heat sink temperature, in Celsius
+ * @retval bool True if the stored offsets pass their CRC, lie around the mid scale
+ *         and were measured within MC_OFFSET_MAX_TEMP_DELTA_C of hTemp_C
+ */
+bool MC_OffsetStore_Load(PolarizationOffsets_t *pOffsets, int16_t hTemp_C)
+{
+  const MC_OffsetRecord_t *pRecord;
+  uint32_t wFreeSlot;
+  int32_t wTempDelta;
+  bool bValid = false;
+
+  pRecord = MC_OffsetStore_Scan(&wFreeSlot);
+  if (pRecord != NULL)
+  {
+    wTempDelta = (int32_t)hTemp_C - pRecord->wTemp_C;
+    wTempDelta = (wTempDelta < 0) ? -wTempDelta : wTempDelta;
+    if ((wTempDelta <= MC_OFFSET_MAX_TEMP_DELTA_C) && (true == MC_OffsetStore_IsPlausible(&pRecord->Offsets)))
+    {
+      *pOffsets = pRecord->Offsets;
+      bValid = true;
+    }
+  }
+  return (bValid);
+}
+
+/**
+ * @brief  Appends the offsets of a calibration to the flash page, unless they are
+ *         implausible or equal to the last stored ones. The flash is not readable
+ *         while it is written: it must be called with the PWM switched off.
+ * @param  pOffsets: measured offsets
+ * @param  hTemp_C: heat sink temperature, in Celsius
+ */
+void MC_OffsetStore_Save(const PolarizationOffsets_t *pOffsets, int16_t hTemp_C)
+{
+  const MC_OffsetRecord_t *pLast;
+  MC_OffsetRecord_t Record;
+  uint32_t wFreeSlot;
+  uint32_t wAddress;
+  uint64_t Words[sizeof(MC_OffsetRecord_t) / sizeof(uint64_t)];
+  uint32_t i;
+  bool bWrite = MC_OffsetStore_IsPlausible(pOffsets);
+
+  pLast = MC_OffsetStore_Scan(&wFreeSlot);
+  if ((true == bWrite) && (pLast != NULL)
+      && (pLast->Offsets.phaseAOffset == pOffsets->phaseAOffset)
+      && (pLast->Offsets.phaseBOffset == pOffsets->phaseBOffset)
+      && (pLast->Offsets.phaseCOffset == pOffsets->phaseCOffset)
+      && (pLast->wTemp_C == (int32_t)hTemp_C))
+  {
+    bWrite = false;
+  }
+
+  if (true == bWrite)
+  {
+    Record.wMagic = MC_OFFSETS_MAGIC;
+    Record.Offsets = *pOffsets;
+    Record.wTemp_C = (int32_t)hTemp_C;
+    Record.wCrc = MC_OffsetStore_Crc(&Record);
+    (void)memcpy(Words, &Record, sizeof(Record));
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    if (wFreeSlot >= MC_OFFSETS_NB_SLOTS)
+    {
+      FLASH_EraseInitTypeDef Erase;
+      uint32_t wPageError;
+
+      Erase.TypeErase = FLASH_TYPEERASE_PAGES;
+      Erase.Banks = FLASH_BANK_1;
+      Erase.Page = MC_OFFSETS_FLASH_PAGE;
+      Erase.NbPages = 1U;
+      (void)HAL_FLASHEx_Erase(&Erase, &wPageError);
+      wFreeSlot = 0U;
+    }
+    wAddress = MC_OFFSETS_FLASH_ADDR + (wFreeSlot * sizeof(MC_OffsetRecord_t));
+    for (i = 0U; i < (sizeof(MC_OffsetRecord_t) / sizeof(uint64_t)); i++)
+    {
+      (void)HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, wAddress + (i * sizeof(uint64_t)), Words[i]);
+    }
+    HAL_FLASH_Lock();
+  }
+}
+
+#endif /* MC_OFFSETS_IN_FLASH */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -27,7 +27,13 @@
 #include "parameters_conversion.h"
 #include "mc_parameters.h"
 
+#if defined (SINGLE_SHUNT)
+#include "r1_g4xx_pwm_curr_fdbk.h"
+#elif defined (ICS_SENSORS)
+#include "ics_g4xx_pwm_curr_fdbk.h"
+#else
 #include "r3_2_g4xx_pwm_curr_fdbk.h"
+#endif
 
 /* USER CODE BEGIN Additional include */
 
@@ -36,6 +42,97 @@
 #define FREQ_RATIO 1                /* Dummy value for single drive */
 #define FREQ_RELATION HIGHEST_FREQ  /* Dummy value for single drive */
 
+#if defined (SINGLE_SHUNT)
+/**
+  * @brief  Current sensor parameters Motor 1 - single shunt - G4
+  */
+R1_Params_t R1_ParamsM1 =
+{
+/* Current reading A/D Conversions initialization -----------------------------*/
+  .ADCx            = ADC1,
+  //cstat -MISRAC2012-Rule-12.1 -MISRAC2012-Rule-10.1_R6
+  /* Cost reduced board config: bus current on the shunt channel, converted twice */
+  .ADCConfig = MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ2_Pos
+             | 1U<<ADC_JSQR_JL_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO2 & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT),
+  //cstat +MISRAC2012-Rule-12.1 +MISRAC2012-Rule-10.1_R6
+
+  /* PWM generation parameters --------------------------------------------------*/
+  .RepetitionCounter = REP_COUNTER,
+  .Tbefore           = TW_BEFORE,
+  .TMin              = TW_MIN,
+  .TIMx              = TIM1,
+
+/* PWM Driving signals initialization ----------------------------------------*/
+  .LowSideOutputs = (LowSideOutputsFunction_t)LOW_SIDE_SIGNALS_ENABLING,
+ .pwm_en_u_port      = MC_NULL,
+ .pwm_en_u_pin       = (uint16_t) 0,
+ .pwm_en_v_port      = MC_NULL,
+ .pwm_en_v_pin       = (uint16_t) 0,
+ .pwm_en_w_port      = MC_NULL,
+ .pwm_en_w_pin       = (uint16_t) 0,
+
+/* Emergency input (BKIN2) signal initialization -----------------------------*/
+  .BKIN2Mode     = INT_MODE,
+
+/* Internal OPAMP settings ---------------------------------------------------*/
+  .OPAMPx          = OPAMP1,
+/* Internal COMP settings ----------------------------------------------------*/
+  .CompOCPSelection     = COMP1,
+  .CompOCPInvInput_MODE = INT_MODE,
+  .DAC_OCP_Selection    = MC_NULL,
+  .DAC_Channel_OCP      = (uint32_t) 0,
+
+  .CompOVPSelection      = MC_NULL,
+  .CompOVPInvInput_MODE  = NONE,
+  .DAC_OVP_Selection     = MC_NULL,
+  .DAC_Channel_OVP       = (uint32_t) 0,
+
+/* DAC settings --------------------------------------------------------------*/
+  .DAC_OCP_Threshold =  5957,
+  .DAC_OVP_Threshold =  23830,
+
+};
+#elif defined (ICS_SENSORS)
+/**
+  * @brief  Current sensor parameters Motor 1 - ICS - G4
+  */
+ICS_Params_t ICS_ParamsM1 =
+{
+/* Dual MC parameters --------------------------------------------------------*/
+  .FreqRatio       = FREQ_RATIO,
+  .IsHigherFreqTim = FREQ_RELATION,
+
+/* Current reading A/D Conversions initialization -----------------------------*/
+  .ADCx_1           = ADC1,
+  .ADCx_2           = ADC2,
+  //cstat -MISRAC2012-Rule-12.1 -MISRAC2012-Rule-10.1_R6
+  /* Ia on ADC1 and Ib on ADC2, triggered by the same TIMx TRGO edge, through OPAMP1
+     and OPAMP2 with their non inverting inputs on phase A and B */
+  .ADCConfig1 = MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT),
+  .ADCConfig2 = MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT),
+  //cstat +MISRAC2012-Rule-12.1 +MISRAC2012-Rule-10.1_R6
+
+  /* Current sampling parameters -----------------------------------------------*/
+  .SamplingPoint      = ICS_SAMPLING_POINT,
+  .SamplingPointState = ICS_SAMPLING_POINT_STATE,
+
+  /* PWM generation parameters --------------------------------------------------*/
+  .RepetitionCounter = REP_COUNTER,
+  .TIMx              = TIM1,
+
+/* PWM Driving signals initialization ----------------------------------------*/
+  .LowSideOutputs = (LowSideOutputsFunction_t)LOW_SIDE_SIGNALS_ENABLING,
+ .pwm_en_u_port      = MC_NULL,
+ .pwm_en_u_pin       = (uint16_t) 0,
+ .pwm_en_v_port      = MC_NULL,
+ .pwm_en_v_pin       = (uint16_t) 0,
+ .pwm_en_w_port      = MC_NULL,
+ .pwm_en_w_pin       = (uint16_t) 0,
+
+/* Emergency input (BKIN2) signal initialization -----------------------------*/
+  .BKIN2Mode     = INT_MODE,
+};
+#else
 /**
   * @brief  Internal OPAMP parameters Motor 1 - three shunt - G4xx - Shared Resources
   * temporary hard coded to ESC G4 board
@@ -109,6 +206,7 @@ R3_2_Params_t R3_2_ParamsM1 =
                 ,MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
                 ,MC_ADC_CHANNEL_3<<ADC_JSQR_JSQ1_Pos | (LL_ADC_INJ_TRIG_EXT_TIM1_TRGO & ~ADC_INJ_TRIG_EXT_EDGE_DEFAULT)
                 },
+  .ADCOversampling = ADC_INJ_OVERSAMPLING,
   .ADCDataReg1 = { &ADC1->JDR1
                  , &ADC1->JDR1
                  , &ADC1->JDR1
@@ -130,6 +228,9 @@ R3_2_Params_t R3_2_ParamsM1 =
   .Tsampling         = (uint16_t)SAMPLING_TIME,
   .Tcase2            = (uint16_t)SAMPLING_TIME + (uint16_t)TDEAD + (uint16_t)TRISE,
   .Tcase3            = ((uint16_t)TDEAD + (uint16_t)TNOISE + (uint16_t)SAMPLING_TIME)/2u,
+#ifdef PWM_DOUBLE_UPDATE
+  .Tvalley           = PWM_VALLEY_CNT,
+#endif
   .TIMx               = TIM1,
 
 /* PWM Driving signals initialization ----------------------------------------*/
@@ -170,6 +271,7 @@ R3_2_Params_t R3_2_ParamsM1 =
   .DAC_OVP_Threshold =  23830,
 
 };
+#endif /* SINGLE_SHUNT */
 
 /* USER CODE BEGIN Additional parameters */
 
@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file    mc_stack.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   High-water mark of the main stack, by painting
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "mc_stack.h"
+
+#ifdef MC_STACK_MODE
+
+#if defined (__ICCARM__)
+#pragma section = "CSTACK"
+#define MC_STACK_BOTTOM   ((uint32_t)__section_begin("CSTACK"))
+#define MC_STACK_TOP      ((uint32_t)__section_end("CSTACK"))
+#elif defined (__GNUC__)
+/* Symbols of the linker script */
+extern uint8_t _estack;
+extern uint8_t _Min_Stack_Size;
+#define MC_STACK_TOP      ((uint32_t)&_estack)
+#define MC_STACK_BOTTOM   (MC_STACK_TOP - (uint32_t)&_Min_Stack_Size)
+#else
+#error "MC_STACK_MODE: the bounds of the stack are only known with IAR and GCC"
+#endif
+
+uint32_t wMCStackHFEntry;
+
+/* Lowest word written since the paint */
+static const uint32_t *pStackLowest;
+
+/**
+ * @brief  Paints the stack reserved below the stack pointer of the caller. To be
+ *         called at the start of main(), before the interrupts run.
+ */
+void MC_Stack_Paint(void)
+{
+  uint32_t *pWord = (uint32_t *)((MC_STACK_BOTTOM + 3U) & ~3U); //cstat !MISRAC2012-Rule-11.4
+  const uint32_t *pEnd = (const uint32_t *)(__get_MSP() - (4U * MC_STACK_PAINT_MARGIN)); //cstat !MISRAC2012-Rule-11.4
+
+  while (pWord < pEnd)
+  {
+    *pWord = MC_STACK_PAINT;
+    pWord++;
+  }
+  pStackLowest = pEnd;
+  wMCStackHFEntry = MC_STACK_TOP;
+}
+
+/**
+ * @brief  Moves the high-water mark down to the lowest word written. The words of
+ *         the paint below the mark are read at each call: to be called from the main
+ *         loop, where it is preempted by every task.
+ */
+void MC_Stack_Scan(void)
+{
+  const uint32_t *pWord = (const uint32_t *)((MC_STACK_BOTTOM + 3U) & ~3U); //cstat !MISRAC2012-Rule-11.4
+
+  while ((pWord < pStackLowest) && (MC_STACK_PAINT == *pWord))
+  {
+    pWord++;
+  }
+  pStackLowest = pWord;
+}
+
+void MC_Stack_GetInfo(MC_Stack_Info_t *pInfo)
+{
+  pInfo->wReserved = MC_STACK_TOP - MC_STACK_BOTTOM;
+  pInfo->wHighWater = MC_STACK_TOP - (uint32_t)pStackLowest; //cstat !MISRAC2012-Rule-11.4
+  pInfo->wHFEntry = MC_STACK_TOP - wMCStackHFEntry;
+}
+
+#endif /* MC_STACK_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
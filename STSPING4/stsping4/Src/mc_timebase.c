@@ -0,0 +1,123 @@
+/**
+  ******************************************************************************
+  * @file    mc_timebase.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   64-bit time base of the telemetry, in CPU cycles since the boot
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "parameters_conversion.h"
+#include "mc_timebase.h"
+#ifdef MC_CAPTURE_MODE
+#include "mc_capture.h"
+#endif
+
+#ifdef MC_TIMEBASE_MODE
+
+_Static_assert(MC_TIME_CYCLES_PER_TICK > 0U, "FOC period shorter than a CPU cycle");
+
+/* Written by the high frequency task only */
+static volatile uint32_t wTimeTickLow;
+static volatile uint32_t wTimeTickHigh;
+static volatile uint32_t wTimeTickCycles;   /* Cycle counter at the last tick */
+
+/**
+ * @brief  Enables the cycle counter of the DWT, without clearing it for the
+ *         measures of mc_perf, and starts the time base. To be called once at boot,
+ *         before the high frequency task runs.
+ */
+void MC_Time_Init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // Enable the DWT also without debugger
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;          // Enable Cycle Counter
+  wTimeTickLow = 0U;
+  wTimeTickHigh = 0U;
+  wTimeTickCycles = DWT->CYCCNT;
+}
+
+/**
+ * @brief  Counts a tick. It must be called by the high frequency task at each FOC
+ *         period, with GLOBAL_TIMESTAMP.
+ */
+void MC_Time_Tick(void)
+{
+  uint32_t wTickLow = wTimeTickLow + 1U;
+
+  wTimeTickCycles = DWT->CYCCNT;
+  if (0U == wTickLow)
+  {
+    wTimeTickHigh++;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  /* Written last: a reader preempted by the tick sees it changed and reads again */
+  wTimeTickLow = wTickLow;
+}
+
+/**
+ * @brief  Reads the ticks and the cycles since the last one, consistent with each
+ *         other at any priority below the one of the high frequency task.
+ */
+void MC_Time_GetStamp(MC_Time_Stamp_t *pStamp)
+{
+  uint32_t wTickLow;
+  uint32_t wCycles;
+
+  do
+  {
+    wTickLow = wTimeTickLow;
+    pStamp->wTickHigh = wTimeTickHigh;
+    wCycles = DWT->CYCCNT - wTimeTickCycles;
+  } while (wTickLow != wTimeTickLow);
+
+  pStamp->wTickLow = wTickLow;
+  pStamp->wCycles = (wCycles < MC_TIME_CYCLES_PER_TICK) ? wCycles : (MC_TIME_CYCLES_PER_TICK - 1U);
+}
+
+uint64_t MC_Time_FromStamp(const MC_Time_Stamp_t *pStamp)
+{
+  uint64_t dTicks = ((uint64_t)pStamp->wTickHigh << 32) | pStamp->wTickLow;
+
+  return ((dTicks * MC_TIME_CYCLES_PER_TICK) + pStamp->wCycles);
+}
+
+/**
+ * @brief  Returns the time in CPU cycles since the boot.
+ */
+uint64_t MC_Time_Get(void)
+{
+  MC_Time_Stamp_t Stamp;
+
+  MC_Time_GetStamp(&Stamp);
+  return (MC_Time_FromStamp(&Stamp));
+}
+
+void MC_Time_GetInfo(MC_Time_Info_t *pInfo)
+{
+  pInfo->dNow = MC_Time_Get();
+#ifdef MC_CAPTURE_MODE
+  pInfo->dCaptureTrigger = MC_Capture_GetTriggerTime();
+#else
+  pInfo->dCaptureTrigger = MC_TIME_NONE;
+#endif
+  pInfo->wCyclesPerSecond = MC_TIME_CYCLES_PER_SECOND;
+  pInfo->wCyclesPerTick = MC_TIME_CYCLES_PER_TICK;
+}
+
+#endif /* MC_TIMEBASE_MODE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,243 @@
+/**
+  ******************************************************************************
+  * @file    mc_warmboot.c
+  * @author  Motor Control SDK Team, ST Microelectronics
+  * @brief   State of the drive kept across a warm reset
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "main.h"
+#include "stm32g4xx_ll_pwr.h"
+#include "stm32g4xx_ll_rtc.h"
+#include "parameters_conversion.h"
+#include "mc_tasks.h"
+#include "mc_warmboot.h"
+
+#ifdef MC_WARMBOOT_MODE
+
+/* The loop of a coasting rotor is only closed by the flying start of the sensorless
+   builds, an encoder is not aligned after the reset */
+#if (FLYING_START_ENABLING == ENABLE) && !defined (M1_ENCODER_SENSOR) && !defined (M1_HFI_SENSOR)
+#define MC_WARMBOOT_RESUME
+#endif
+
+#define MC_WARMBOOT_MAGIC           0x57424F54U   /* "WBOT" */
+
+/* Backup registers of the TAMP of the STM32G4 */
+#define MC_WARMBOOT_NB_BKP          32U
+
+/* Resets that keep the record */
+#ifdef MC_WARMBOOT_NO_BOR
+#define MC_WARMBOOT_RESETS          (RCC_CSR_IWDGRSTF | RCC_CSR_WWDGRSTF | RCC_CSR_SFTRSTF)
+#else
+#define MC_WARMBOOT_RESETS          (RCC_CSR_IWDGRSTF | RCC_CSR_WWDGRSTF | RCC_CSR_SFTRSTF | RCC_CSR_BORRSTF)
+#endif
+
+#define MC_WARMBOOT_STABLE_TICKS    ((uint16_t)((MC_WARMBOOT_STABLE_MS * (uint32_t)MEDIUM_FREQUENCY_TASK_RATE) / 1000U))
+
+typedef struct
+{
+  uint32_t wMagic;
+  PolarizationOffsets_t Offsets;
+  int16_t  hFinalSpeed;             /* Last speed ramp, in #SPEED_UNIT */
+  int16_t  hFinalTorque;            /* Last torque ramp, in digits */
+  uint8_t  bRunning;                /* 1 in RUN without fault */
+  uint8_t  bModality;               /* STC_Modality_t */
+  uint8_t  bObserver;               /* EPLL or ECORDIC */
+  uint8_t  bResumes;                /* Warm boots in a row that started the drive */
+  uint32_t wCrc;                    /* CRC-32 of the fields above */
+} MC_WarmBootRecord_t;
+
+_Static_assert((sizeof(MC_WarmBootRecord_t) % sizeof(uint32_t)) == 0U,
+               "MC_WarmBootRecord_t must be a multiple of a backup register");
+_Static_assert((MC_WARMBOOT_BKP_FIRST + (sizeof(MC_WarmBootRecord_t) / sizeof(uint32_t))) <= MC_WARMBOOT_NB_BKP,
+               "MC_WarmBootRecord_t does not fit in the backup registers from MC_WARMBOOT_BKP_FIRST");
+
+/* Copy of the record in the backup registers */
+static MC_WarmBootRecord_t WarmBootRecord;
+static MC_WarmBoot_Kind_t WarmBootKind = MC_WARMBOOT_COLD;
+/* Medium frequency periods left before the resumes count is cleared */
+static uint16_t hWarmBootStableTicks = 0U;
+
+static uint32_t MC_WarmBoot_Crc(const MC_WarmBootRecord_t *pRecord)
+{
+  const uint8_t *pData = (const uint8_t *)pRecord;
+  uint32_t wCrc = 0xFFFFFFFFU;
+  uint32_t i;
+  uint8_t bBit;
+
+  for (i = 0U; i < offsetof(MC_WarmBootRecord_t, wCrc); i++)
+  {
+    wCrc ^= pData[i];
+    for (bBit = 0U; bBit < 8U; bBit++)
+    {
+      wCrc = ((wCrc & 1U) != 0U) ? ((wCrc >> 1) ^ 0xEDB88320U) : (wCrc >> 1);
+    }
+  }
+  return (~wCrc);
+}
+
+static void MC_WarmBoot_Write(void)
+{
+  uint32_t Words[sizeof(MC_WarmBootRecord_t) / sizeof(uint32_t)];
+  uint32_t i;
+
+  WarmBootRecord.wCrc = MC_WarmBoot_Crc(&WarmBootRecord);
+  (void)memcpy(Words, &WarmBootRecord, sizeof(WarmBootRecord));
+  for (i = 0U; i < (sizeof(MC_WarmBootRecord_t) / sizeof(uint32_t)); i++)
+  {
+    LL_RTC_BKP_SetRegister(RTC, MC_WARMBOOT_BKP_FIRST + i, Words[i]);
+  }
+}
+
+/**
+ * @brief  Reads the record of the previous boot and, after a warm reset, restores the
+ *         offsets and starts the drive again if it was running. It must be called by
+ *         MCboot, once the components are initialised, in the IDLE state.
+ * @retval bool True if the offsets are restored, the offset measurement of the boot is
+ *         then not needed
+ */
+bool MC_WarmBoot_Restore(MCI_Handle_t *pMCI, PWMC_Handle_t *pPWMC)
+{
+  uint32_t Words[sizeof(MC_WarmBootRecord_t) / sizeof(uint32_t)];
+  uint32_t wResets = RCC->CSR;
+  uint32_t i;
+  bool bValid;
+
+  /* The backup domain is written from now on */
+  LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_PWR | LL_APB1_GRP1_PERIPH_RTCAPB);
+  LL_PWR_EnableBkUpAccess();
+  /* So that the next boot sees its own reset only */
+  SET_BIT(RCC->CSR, RCC_CSR_RMVF);
+
+  for (i = 0U; i < (sizeof(MC_WarmBootRecord_t) / sizeof(uint32_t)); i++)
+  {
+    Words[i] = LL_RTC_BKP_GetRegister(RTC, MC_WARMBOOT_BKP_FIRST + i);
+  }
+  (void)memcpy(&WarmBootRecord, Words, sizeof(WarmBootRecord));
+  bValid = ((wResets & MC_WARMBOOT_RESETS) != 0U) && (MC_WARMBOOT_MAGIC == WarmBootRecord.wMagic)
+        && (MC_WarmBoot_Crc(&WarmBootRecord) == WarmBootRecord.wCrc);
+
+  if (true == bValid)
+  {
+    PWMC_SetOffsetCalib(pPWMC, &WarmBootRecord.Offsets);
+    WarmBootKind = MC_WARMBOOT_OFFSETS;
+    if (1U == WarmBootRecord.bRunning)
+    {
+      WarmBootKind = MC_WARMBOOT_HELD;
+#ifdef MC_WARMBOOT_RESUME
+      if (WarmBootRecord.bResumes < MC_WARMBOOT_MAX_RESUMES)
+      {
+        (void)TSK_SetObserverM1(WarmBootRecord.bObserver);
+        if ((uint8_t)STC_TORQUE_MODE == WarmBootRecord.bModality)
+        {
+          MCI_ExecTorqueRamp(pMCI, WarmBootRecord.hFinalTorque, 0U);
+        }
+        else
+        {
+          MCI_ExecSpeedRamp(pMCI, WarmBootRecord.hFinalSpeed, 0U);
+        }
+        if (true == MCI_StartMotor(pMCI))
+        {
+          WarmBootKind = MC_WARMBOOT_RESUMED;
+          WarmBootRecord.bResumes++;
+          hWarmBootStableTicks = MC_WARMBOOT_STABLE_TICKS;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+#endif
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  else
+  {
+    (void)memset(&WarmBootRecord, 0, sizeof(WarmBootRecord));
+    WarmBootRecord.wMagic = MC_WARMBOOT_MAGIC;
+  }
+  /* Until the first medium frequency task, the drive is not running */
+  WarmBootRecord.bRunning = 0U;
+  MC_WarmBoot_Write();
+  return (bValid);
+}
+
+MC_WarmBoot_Kind_t MC_WarmBoot_GetKind(void)
+{
+  return (WarmBootKind);
+}
+
+/**
+ * @brief  Updates the record with the state of the drive. The backup registers are only
+ *         written when the record changes.
+ */
+void MC_WarmBoot_Save(MCI_Handle_t *pMCI, PWMC_Handle_t *pPWMC)
+{
+  MC_WarmBootRecord_t Record = WarmBootRecord;
+  bool bRunning = (RUN == MCI_GetSTMState(pMCI)) && (MC_NO_FAULTS == MCI_GetOccurredFaults(pMCI));
+
+  if (true == pPWMC->offsetCalibStatus)
+  {
+    PWMC_GetOffsetCalib(pPWMC, &Record.Offsets);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+  Record.bRunning = (true == bRunning) ? 1U : 0U;
+  if (true == bRunning)
+  {
+    Record.bModality = (uint8_t)MCI_GetControlMode(pMCI);
+    Record.hFinalSpeed = MCI_GetLastRampFinalSpeed(pMCI);
+    Record.hFinalTorque = MCI_GetLastRampFinalTorque(pMCI);
+    Record.bObserver = TSK_GetObserverM1();
+    /* A drive that runs long enough after a resume may be resumed again */
+    if (hWarmBootStableTicks > 0U)
+    {
+      hWarmBootStableTicks--;
+    }
+    else
+    {
+      Record.bResumes = 0U;
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  if (0 != memcmp(&Record, &WarmBootRecord, offsetof(MC_WarmBootRecord_t, wCrc)))
+  {
+    WarmBootRecord = Record;
+    MC_WarmBoot_Write();
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+#endif /* MC_WARMBOOT_MODE */
+
+/******************* (C) COPYRIGHT 2021 STMicroelectronics *****END OF FILE****/
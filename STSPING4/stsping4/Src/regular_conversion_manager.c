@@ -6,7 +6,8 @@
   * @brief   This file provides firmware functions that implement the following features
   *          of the regular_conversion_manager component of the Motor Control SDK:
   *           Register conversion with or without callback
-  *           Execute regular conv directly from Temperature and VBus sensors
+  *           Scan the registered conversions of each ADC with the DMA
+  *           Read the scanned conversions from Temperature and VBus sensors
   *           Execute user regular conversion scheduled by medium frequency task
   *           Manage user conversion state machine
   *           +
@@ -52,6 +53,14 @@
   * RCM_RegisterRegConv_WithCB() or RCM_RegisterRegConv() APIs. Multiple conversions can be registered,
   * but only one can be scheduled at a time .
   *
+  * The registered conversions of each ADC are converted in a single scan of its regular
+  * sequence, moved by a circular DMA channel into a buffer. The scan is started once per
+  * SysTick by the safety task, after the conversions of the previous scan have been read.
+  * While the PWM is on, the ADC is locked by the current sensing and the scan is started by
+  * the high frequency task right after the current reading instead. A conversion is therefore
+  * never waited for: RCM_ExecRegularConv() returns the value of the last scan, at most one
+  * SysTick period old.
+  *
   * A requested user regular conversion will be executed by the medium frequency task after the
   * MC-SDK regular safety conversions: Bus voltage and Temperature.
   *
@@ -75,33 +84,6 @@
   * @{
   */
 
-/* Private typedef -----------------------------------------------------------*/
-/**
-  * @brief Document as stated in template.h
-  *
-  * ...
-  */
-typedef enum {
-  notvalid,
-  ongoing,
-  valid
-}  RCM_status_t;
-
-typedef struct
-{
-  bool enable;
-  RCM_status_t status;
-  uint16_t value;
-  uint8_t prev;
-  uint8_t next;
-} RCM_NoInj_t;
-
-typedef struct
-{
-  RCM_exec_cb_t cb;
-  void *data;
-} RCM_callback_t;
-
 /* Private defines -----------------------------------------------------------*/
 /**
   * @brief Number of regular conversion allowed By default.
@@ -118,18 +100,68 @@ typedef struct
   */
 #define RCM_MAX_CONV  4U
 
+/**
+  * @brief Number of ADCs that can be scanned, one DMA channel each
+  */
+#define RCM_MAX_SCAN  2U
+
+/* Private typedef -----------------------------------------------------------*/
+/**
+  * @brief DMA scan of the regular conversions registered on one ADC
+  */
+typedef struct
+{
+  ADC_TypeDef *regADC;            /* Scanned ADC, MC_NULL until a conversion is registered on it */
+  uint32_t dmaChannel;            /* DMA channel that moves the conversions to buffer */
+  uint8_t length;                 /* Number of conversions of the scan */
+  uint16_t buffer[RCM_MAX_CONV];  /* Written by the DMA, in the order of the ranks */
+} RCM_Scan_t;
+
+/**
+  * @brief Position of a registered conversion in the scans
+  */
+typedef struct
+{
+  uint8_t scan;                   /* Index of the scan of the ADC of the conversion */
+  uint8_t rank;                   /* Rank of the conversion in the scan, index of its value in buffer */
+} RCM_ScanPos_t;
+
+typedef struct
+{
+  RCM_exec_cb_t cb;
+  void *data;
+} RCM_callback_t;
+
 /* Global variables ----------------------------------------------------------*/
 
 static RegConv_t *RCM_handle_array[RCM_MAX_CONV];
 static RCM_callback_t RCM_CB_array[RCM_MAX_CONV];
 
-static RCM_NoInj_t RCM_NoInj_array[RCM_MAX_CONV];
-static uint8_t RCM_currentHandle;
+static RCM_Scan_t RCM_Scan_array[RCM_MAX_SCAN] =
+{
+  {MC_NULL, RCM_DMA_CHANNEL_SCAN1, 0U, {0U}},
+  {MC_NULL, RCM_DMA_CHANNEL_SCAN2, 0U, {0U}},
+};
+static RCM_ScanPos_t RCM_ScanPos_array[RCM_MAX_CONV];
+static volatile bool RCM_ScanRequested = false;
 static uint16_t RCM_UserConvValue;
 static RCM_UserConvState_t RCM_UserConvState;
 static uint8_t RCM_UserConvHandle;
 
+static const uint32_t RCM_RegRanks[RCM_MAX_CONV] =
+{
+  LL_ADC_REG_RANK_1, LL_ADC_REG_RANK_2, LL_ADC_REG_RANK_3, LL_ADC_REG_RANK_4
+};
+
+static const uint32_t RCM_SeqLengths[RCM_MAX_CONV] =
+{
+  LL_ADC_REG_SEQ_SCAN_DISABLE, LL_ADC_REG_SEQ_SCAN_ENABLE_2RANKS,
+  LL_ADC_REG_SEQ_SCAN_ENABLE_3RANKS, LL_ADC_REG_SEQ_SCAN_ENABLE_4RANKS
+};
+
 /* Private function prototypes -----------------------------------------------*/
+static bool RCM_AddToScan(uint8_t handle, RegConv_t *regConv);
+static void RCM_ConfigScan(RCM_Scan_t *pScan);
 
 /* Private functions ---------------------------------------------------------*/
 
@@ -247,6 +279,22 @@ uint8_t RCM_RegisterRegConv(RegConv_t *regConv)
       }
       i++;
     }
+    if ((handle < RCM_MAX_CONV) && (0 == RCM_handle_array [handle]))
+    {
+      /* New conversion, it must find a place in the scan of its ADC */
+      if (false == RCM_AddToScan(handle, regConv))
+      {
+        handle = 255U;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      /* Nothing to do */
+    }
     if (handle < RCM_MAX_CONV)
     {
       RCM_handle_array [handle] = regConv;
@@ -277,15 +325,11 @@ uint8_t RCM_RegisterRegConv(RegConv_t *regConv)
       {
         /* Nothing to do */
       }
-      /* conversion handler is created, will be enabled by the first call to RCM_ExecRegularConv*/
-      RCM_NoInj_array[handle].enable = false;
-      RCM_NoInj_array[handle].next = handle;
-      RCM_NoInj_array[handle].prev = handle;
-      /* reset regular conversion sequencer length set by cubeMX */
-      LL_ADC_REG_SetSequencerLength(regConv->regADC, LL_ADC_REG_SEQ_SCAN_DISABLE);
       /* configure the sampling time (should already be configured by for non user conversions)*/
       LL_ADC_SetChannelSamplingTime(regConv->regADC, __LL_ADC_DECIMAL_NB_TO_CHANNEL(regConv->channel),
                                     regConv->samplingTime);
+      /* The regular sequence set by cubeMX is replaced by the registered conversions */
+      RCM_ConfigScan(&RCM_Scan_array[RCM_ScanPos_array[handle].scan]);
     }
     else
     {
@@ -299,118 +343,16 @@ uint8_t RCM_RegisterRegConv(RegConv_t *regConv)
 
 /*
  * This function is used to read the result of a regular conversion.
- * Depending of the MC state machine, this function can poll on the ADC end of conversion or not.
- * If the ADC is already in use for currents sensing, the regular conversion can not
- * be executed instantaneously but have to be scheduled in order to be executed after currents sensing
- * inside HF task.
- * This function takes care of inserting the handle into the scheduler.
- * If it is possible to execute the conversion instantaneously, it will be executed, and result returned.
- * Otherwise, the latest stored conversion result will be returned.
+ * It does not wait for an ADC conversion: the value returned is the one of the last
+ * DMA scan of the ADC of the conversion, started by RCM_StartRegularScan.
  *
  * NOTE: This function is not part of the public API and users should not call it.
  */
 uint16_t RCM_ExecRegularConv (uint8_t handle)
 {
-  uint16_t retVal;
-  uint8_t formerNext;
-  uint8_t i=0;
-  uint8_t LastEnable = RCM_MAX_CONV;
-
-  if (false == RCM_NoInj_array [handle].enable)
-  {
-    /* find position in the list */
-    while (i < RCM_MAX_CONV)
-    {
-      if (true == RCM_NoInj_array [i].enable)
-      {
-        if (RCM_NoInj_array[i].next > handle)
-        /* We found a previous reg conv to link with */
-        {
-          formerNext = RCM_NoInj_array [i].next;
-          RCM_NoInj_array[handle].next = formerNext;
-          RCM_NoInj_array[handle].prev = i;
-          RCM_NoInj_array[i].next = handle;
-          RCM_NoInj_array[formerNext].prev = handle;
-          i = RCM_MAX_CONV; /* stop the loop, handler inserted*/
-        }
-        else
-        { /* We found an enabled regular conv,
-           * but do not know yet if it is the one we have to be linked to. */
-          LastEnable = i;
-        }
-      }
-      else
-      {
-        /* nothing to do */
-      }
-      i++;
-      if (RCM_MAX_CONV == i)
-      /* We reach end of the array without handler inserted*/
-      {
-       if (LastEnable != RCM_MAX_CONV )
-       /* we find a regular conversion with smaller position to be linked with */
-       {
-         formerNext = RCM_NoInj_array[LastEnable].next;
-         RCM_NoInj_array[handle].next = formerNext;
-         RCM_NoInj_array[handle].prev = LastEnable;
-         RCM_NoInj_array[LastEnable].next = handle;
-         RCM_NoInj_array[formerNext].prev = handle;
-       }
-       else
-       { /* the current handle is the only one in the list */
-         /* previous and next are already pointing to itself (done at registerRegConv) */
-         RCM_currentHandle = handle;
-       }
-      }
-      else
-      {
-        /* Nothing to do we are parsing the array, nothing inserted yet*/
-      }
-    }
-    /* The handle is now linked with others, we can set the enable flag */
-    RCM_NoInj_array[handle].enable = true;
-    RCM_NoInj_array[handle].status = notvalid;
-    if (RCM_NoInj_array[RCM_currentHandle].status != ongoing)
-    {/* select the new conversion to be the next scheduled only if a conversion is not ongoing*/
-      RCM_currentHandle = handle;
-    }
-    else
-    {
-      /* Nothing to do */
-    }
-  }
-  else
-  {
-    /* Nothing to do the current handle is already scheduled */
-  }
-  if (false == PWM_Handle_M1.ADCRegularLocked)
-  /* The ADC is free to be used asynchronously*/
-  {
-    LL_ADC_REG_SetSequencerRanks(RCM_handle_array[handle]->regADC,
-                                 LL_ADC_REG_RANK_1,
-                                 __LL_ADC_DECIMAL_NB_TO_CHANNEL(RCM_handle_array[handle]->channel));
-
-    (void)LL_ADC_REG_ReadConversionData12(RCM_handle_array[handle]->regADC);
-    /* Start ADC conversion */
-    LL_ADC_REG_StartConversion(RCM_handle_array[handle]->regADC);
-
-    /* Wait EOC */
-    while ( 0U == LL_ADC_IsActiveFlag_EOC(RCM_handle_array[handle]->regADC))
-    {
-      /* Nothing to do */
-    }
+  const RCM_ScanPos_t *pPos = &RCM_ScanPos_array[handle];
 
-    /* Read the "Regular" conversion (Not related to current sampling) */
-    RCM_NoInj_array[handle].value = LL_ADC_REG_ReadConversionData12(RCM_handle_array[handle]->regADC);
-    RCM_currentHandle = RCM_NoInj_array[handle].next;
-    RCM_NoInj_array[handle].status = valid;
-  }
-  else
-  {
-    /* Nothing to do */
-  }
-  retVal = RCM_NoInj_array[handle].value;
-  return retVal;
+  return (RCM_Scan_array[pPos->scan].buffer[pPos->rank]);
 }
 
 /**
@@ -477,18 +419,9 @@ void RCM_ExecUserConv()
 {
   if (RCM_USERCONV_REQUESTED == RCM_UserConvState)
   {
+    /* The conversion was scanned at registration, the scan buffer always holds a value */
     RCM_UserConvValue = RCM_ExecRegularConv(RCM_UserConvHandle);
-    /* Regular conversion is read from RCM_NoInj_array but we must take care that first conversion is done*/
-    /* status could also be ongoing, but decision is taken to provide previous conversion */
-    /* instead of waiting for RCM_NoInj_array [RCM_UserConvHandle].status == valid */
-    if (RCM_NoInj_array [RCM_UserConvHandle].status != notvalid)
-    {
-      RCM_UserConvState = RCM_USERCONV_EOC;
-    }
-    else
-    {
-      /* Nothing to do */
-    }
+    RCM_UserConvState = RCM_USERCONV_EOC;
     if (RCM_CB_array[RCM_UserConvHandle].cb != NULL)
     {
       RCM_UserConvState = RCM_USERCONV_IDLE;
@@ -518,51 +451,48 @@ RCM_UserConvState_t RCM_GetUserConvState(void)
   return (RCM_UserConvState);
 }
 
-/**
- * @brief  Un-schedules a regular conversion
- *
- * This function does not poll ADC read and is meant to be used when
- * ADCs do not support injected channels.
- *
- * In such configurations, once a regular conversion has been executed once,
- * It is continuously scheduled in HF task after current reading.
- *
- * This function remove the handle from the scheduling.
- *
- * @note Note that even though, in such configurations, regular conversions are
- *       continuously scheduled after having been requested once, the results of
- *       subsequent conversions are not made available unless the users invoke
- *       RCM_RequestUserConv() again.
- *
+/*
+ * Starts the DMA scans of the regular conversions of all the ADCs
  */
-bool RCM_PauseRegularConv(uint8_t handle)
+static inline void RCM_StartScans(void)
 {
-  bool retVal;
-  uint8_t Prev;
-  uint8_t Next;
+  uint8_t i;
 
-  if (handle < RCM_MAX_CONV)
+  for (i = 0U; i < RCM_MAX_SCAN; i++)
   {
-    retVal = true;
-    if (true == RCM_NoInj_array [handle].enable)
+    ADC_TypeDef *regADC = RCM_Scan_array[i].regADC;
+
+    if ((regADC != MC_NULL) && (0U == LL_ADC_REG_IsConversionOngoing(regADC)))
     {
-      RCM_NoInj_array [handle].enable = false;
-      RCM_NoInj_array [handle].status = notvalid;
-      Prev = RCM_NoInj_array [handle].prev;
-      Next = RCM_NoInj_array [handle].next;
-      RCM_NoInj_array [Prev].next = RCM_NoInj_array [handle].next;
-      RCM_NoInj_array [Next].prev = RCM_NoInj_array [handle].prev;
+      LL_ADC_REG_StartConversion(regADC);
     }
     else
     {
-      /* Nothing to do */
+      /* Nothing to do, no conversion registered or the previous scan is not over */
     }
   }
+}
+
+/*
+ * Starts the scan of the registered regular conversions
+ *
+ * This function does not poll on ADC read: the DMA stores the conversions, read back
+ * by the next calls to RCM_ExecRegularConv. It must be called by MC_TASK once per
+ * SysTick, after the conversions of the previous scan have been read. While the ADC
+ * is locked by the current sensing, the scan is left to RCM_ExecNextConv.
+ *
+ * NOTE: This function is not part of the public API and users should not call it.
+ */
+void RCM_StartRegularScan(void)
+{
+  if (false == PWM_Handle_M1.ADCRegularLocked)
+  {
+    RCM_StartScans();
+  }
   else
   {
-    retVal = false;
+    RCM_ScanRequested = true;
   }
-  return (retVal);
 }
 
 #if defined (CCMRAM)
@@ -573,78 +503,139 @@ __attribute__((section (".ccmram")))
 #endif
 #endif
 /*
- * Starts the next scheduled regular conversion
+ * Starts the scan requested while the ADC was locked by the current sensing
  *
  * This function does not poll on ADC read and is foreseen to be used inside
- * high frequency task where ADC are shared between currents reading
- * and user conversion.
+ * high frequency task, right after the currents reading: the injected conversions
+ * of the period are then over and the scan completes before the next ones. With
+ * MC_VBUS_AWD_MODE the scan is started at every call.
  *
  * NOTE: This function is not part of the public API and users should not call it.
  */
 void RCM_ExecNextConv(void)
 {
-  if (true == RCM_NoInj_array [RCM_currentHandle].enable)
+#ifdef MC_VBUS_AWD_MODE
+  /* Every period, for the analog watchdog of the bus voltage */
+  RCM_ScanRequested = false;
+  RCM_StartScans();
+#else
+  if (true == RCM_ScanRequested)
   {
-    /* When this function is called, the ADC conversions triggered by External
-       event for current reading has been completed.
-       ADC is therefore ready to be started because already stopped.*/
-
-    /* Clear EOC */
-    LL_ADC_ClearFlag_EOC(RCM_handle_array[RCM_currentHandle]->regADC);
-    LL_ADC_REG_SetSequencerRanks(RCM_handle_array[RCM_currentHandle]->regADC,
-                                 LL_ADC_REG_RANK_1,
-                                 __LL_ADC_DECIMAL_NB_TO_CHANNEL(RCM_handle_array[RCM_currentHandle]->channel));
-
-    (void)LL_ADC_REG_ReadConversionData12(RCM_handle_array[RCM_currentHandle]->regADC);
-
-    /* Start ADC for regular conversion */
-    LL_ADC_REG_StartConversion(RCM_handle_array[RCM_currentHandle]->regADC);
-    RCM_NoInj_array[RCM_currentHandle].status = ongoing;
+    RCM_ScanRequested = false;
+    RCM_StartScans();
   }
   else
   {
-    /* nothing to do, conversion not enabled have already notvalid status */
+    /* Nothing to do */
   }
+#endif
 }
 
-#if defined (CCMRAM)
-#if defined (__ICCARM__)
-#pragma location = ".ccmram"
-#elif defined (__CC_ARM) || defined(__GNUC__)
-__attribute__((section (".ccmram")))
-#endif
-#endif
 /*
- * Reads the result of the ongoing regular conversion
- *
- * This function is foreseen to be used inside
- * high frequency task where ADC are shared between current reading
- * and user conversion.
- *
- * NOTE: This function is not part of the public API and users should not call it.
+ * Gives a registered conversion a rank in the scan of its ADC. A free scan is
+ * allocated to the ADC of its first conversion.
+ */
+static bool RCM_AddToScan(uint8_t handle, RegConv_t *regConv)
+{
+  bool retVal = false;
+  uint8_t i = 0U;
+
+  while (i < RCM_MAX_SCAN)
+  {
+    RCM_Scan_t *pScan = &RCM_Scan_array[i];
+
+    if (MC_NULL == pScan->regADC)
+    {
+      pScan->regADC = regConv->regADC;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    if ((pScan->regADC == regConv->regADC) && (pScan->length < RCM_MAX_CONV))
+    {
+      RCM_ScanPos_array[handle].scan = i;
+      RCM_ScanPos_array[handle].rank = pScan->length;
+      pScan->length++;
+      retVal = true;
+      i = RCM_MAX_SCAN; /* we can skip the rest of the loop*/
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    i++;
+  }
+  return (retVal);
+}
+
+/*
+ * Programs the regular sequence of a scanned ADC with its registered conversions and
+ * its DMA channel in circular mode, then runs a first scan so that the buffer holds
+ * valid values. That first scan is skipped while the ADC is locked by the current
+ * sensing: the values of a conversion registered then read 0 until the next scan.
  */
-void RCM_ReadOngoingConv(void)
+static void RCM_ConfigScan(RCM_Scan_t *pScan)
 {
-  uint32_t result;
-  RCM_status_t status;
+  ADC_TypeDef *regADC = pScan->regADC;
+  uint8_t i;
 
-  status = RCM_NoInj_array[RCM_currentHandle].status;
-  result = LL_ADC_IsActiveFlag_EOC(RCM_handle_array[RCM_currentHandle]->regADC);
-  if (( valid == status ) || ( notvalid == status ) || ( 0U == result ))
+  if (1U == LL_ADC_REG_IsConversionOngoing(regADC))
   {
-    /* Nothing to do */
+    LL_ADC_REG_StopConversion(regADC);
+    while (1U == LL_ADC_REG_IsStopConversionOngoing(regADC))
+    {
+      /* Nothing to do */
+    }
   }
   else
   {
-    /* Reading of ADC Converted Value */
-    RCM_NoInj_array[RCM_currentHandle].value
-                  = LL_ADC_REG_ReadConversionData12(RCM_handle_array[RCM_currentHandle]->regADC);
-    RCM_NoInj_array[RCM_currentHandle].status = valid;
-    /* Restore back DMA configuration. */
+    /* Nothing to do */
   }
 
-  /* Prepare next conversion */
-  RCM_currentHandle = RCM_NoInj_array [RCM_currentHandle].next;
+  for (i = 0U; i < RCM_MAX_CONV; i++)
+  {
+    if ((RCM_handle_array[i] != 0) && (RCM_handle_array[i]->regADC == regADC))
+    {
+      LL_ADC_REG_SetSequencerRanks(regADC, RCM_RegRanks[RCM_ScanPos_array[i].rank],
+                                   __LL_ADC_DECIMAL_NB_TO_CHANNEL(RCM_handle_array[i]->channel));
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+  }
+  LL_ADC_REG_SetSequencerLength(regADC, RCM_SeqLengths[pScan->length - 1U]);
+
+  LL_AHB1_GRP1_EnableClock(RCM_DMA_CLOCK);
+  LL_DMA_DisableChannel(RCM_DMA, pScan->dmaChannel);
+  LL_DMA_SetPeriphRequest(RCM_DMA, pScan->dmaChannel,
+                          (ADC1 == regADC) ? LL_DMAMUX_REQ_ADC1 : LL_DMAMUX_REQ_ADC2);
+  LL_DMA_ConfigTransfer(RCM_DMA, pScan->dmaChannel,
+                        LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_CIRCULAR | LL_DMA_PERIPH_NOINCREMENT
+                        | LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_HALFWORD | LL_DMA_MDATAALIGN_HALFWORD
+                        | LL_DMA_PRIORITY_LOW);
+  LL_DMA_ConfigAddresses(RCM_DMA, pScan->dmaChannel,
+                         LL_ADC_DMA_GetRegAddr(regADC, LL_ADC_DMA_REG_REGULAR_DATA),
+                         (uint32_t)pScan->buffer, LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+  LL_DMA_SetDataLength(RCM_DMA, pScan->dmaChannel, pScan->length);
+  LL_DMA_ClearFlag_TC(RCM_DMA, pScan->dmaChannel);
+  LL_DMA_EnableChannel(RCM_DMA, pScan->dmaChannel);
+  LL_ADC_REG_SetDMATransfer(regADC, LL_ADC_REG_DMA_TRANSFER_UNLIMITED);
+
+  if (false == PWM_Handle_M1.ADCRegularLocked)
+  {
+    LL_ADC_REG_StartConversion(regADC);
+    while (0U == LL_DMA_IsActiveFlag_TC(RCM_DMA, pScan->dmaChannel))
+    {
+      /* Nothing to do */
+    }
+    LL_DMA_ClearFlag_TC(RCM_DMA, pScan->dmaChannel);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
 }
 
 /**
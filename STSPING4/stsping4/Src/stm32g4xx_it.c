@@ -22,6 +22,9 @@
 #include "stm32g4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#ifdef MC_PWM_SYNC_MODE
+#include "mc_pwm_sync.h"
+#endif
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -57,6 +60,9 @@
 /* External variables --------------------------------------------------------*/
 extern DMA_HandleTypeDef hdma_usart1_rx;
 /* USER CODE BEGIN EV */
+#ifdef MC_FDCAN_MODE
+extern FDCAN_HandleTypeDef hfdcan1;
+#endif
 
 /* USER CODE END EV */
 
@@ -72,5 +78,33 @@ extern DMA_HandleTypeDef hdma_usart1_rx;
 /******************************************************************************/
 
 /* USER CODE BEGIN 1 */
+#if defined(MC_PWM_SYNC_MODE) && (MC_PWM_SYNC_SOURCE == MC_PWM_SYNC_EXTI)
+/**
+  * @brief This function handles the EXTI line of the PWM_SYNC pin.
+  */
+void EXTI9_5_IRQHandler(void)
+{
+  if (__HAL_GPIO_EXTI_GET_IT(PWM_SYNC_Pin) != 0U)
+  {
+    __disable_irq();
+    MC_PwmSync_Event(0U);
+    __enable_irq();
+    __HAL_GPIO_EXTI_CLEAR_IT(PWM_SYNC_Pin);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+#endif
+#ifdef MC_FDCAN_MODE
+/**
+  * @brief This function handles FDCAN1 interrupt 0.
+  */
+void FDCAN1_IT0_IRQHandler(void)
+{
+  HAL_FDCAN_IRQHandler(&hfdcan1);
+}
+#endif
 
 /* USER CODE END 1 */
@@ -31,6 +31,10 @@
 #include "stm32g4xx_hal.h"
 #include "stm32g4xx.h"
 #include "mcp_config.h"
+#include "mc_trace.h"
+#ifdef MC_VBUS_AWD_MODE
+#include "mc_vbus_awd.h"
+#endif
 
 /* USER CODE BEGIN Includes */
 
@@ -62,11 +66,20 @@
 void ADC1_2_IRQHandler(void);
 void TIMx_UP_M1_IRQHandler(void);
 void TIMx_BRK_M1_IRQHandler(void);
+#ifdef M1_ENCODER_SENSOR
+void SPD_TIM_M1_IRQHandler(void);
+#endif
 
 void USART_IRQHandler(void);
 void HardFault_Handler(void);
 void SysTick_Handler(void);
+void PendSV_Handler(void);
+#ifdef DBG_MCU_LOAD_MEASURE
+void FPU_IRQHandler(void);
+#endif
 void EXTI15_10_IRQHandler (void);
+void I2C3_EV_IRQHandler(void);
+void I2C3_ER_IRQHandler(void);
 
 #if defined (CCMRAM)
 #if defined (__ICCARM__)
@@ -85,16 +98,30 @@ void ADC1_2_IRQHandler(void)
   /* USER CODE BEGIN ADC1_2_IRQn 0 */
 
   /* USER CODE END ADC1_2_IRQn 0 */
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_HF);
 
-  // Clear Flags M1
-  LL_ADC_ClearFlag_JEOS( ADC1 );
+#ifdef MC_VBUS_AWD_MODE
+  /* The analog watchdog of the bus voltage shares the interrupt */
+  MC_VbusAwd_IRQHandler();
+  if (0U == LL_ADC_IsActiveFlag_JEOS(ADC1))
+  {
+    /* Nothing to do, watchdog only */
+  }
+  else
+#endif
+  {
+    // Clear Flags M1
+    LL_ADC_ClearFlag_JEOS( ADC1 );
 
-  (void)TSK_HighFrequencyTask();
+    (void)TSK_HighFrequencyTask();
+  }
 
  /* USER CODE BEGIN HighFreq */
 
  /* USER CODE END HighFreq  */
 
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_HF);
+
  /* USER CODE BEGIN ADC1_2_IRQn 1 */
 
  /* USER CODE END ADC1_2_IRQn 1 */
@@ -117,9 +144,22 @@ void TIMx_UP_M1_IRQHandler(void)
  /* USER CODE BEGIN TIMx_UP_M1_IRQn 0 */
 
  /* USER CODE END  TIMx_UP_M1_IRQn 0 */
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_TIM_UP);
 
     LL_TIM_ClearFlag_UPDATE(TIM1);
+#if defined (SINGLE_SHUNT)
+    ( void )R1_TIMx_UP_IRQHandler(&PWM_Handle_M1);
+#elif defined (ICS_SENSORS)
+    ( void )ICS_TIMx_UP_IRQHandler(&PWM_Handle_M1);
+#else
     ( void )R3_2_TIMx_UP_IRQHandler(&PWM_Handle_M1);
+#endif
+#if (CURRENT_CONTROLLER == CURR_CTRL_PCC) && defined (PCC_SPLIT_PHASE)
+    /* The ADC is rearmed first: the first stage of the prediction runs during the conversions */
+    FOC_CurrPrepareM1();
+#endif
+
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_TIM_UP);
 
  /* USER CODE BEGIN TIMx_UP_M1_IRQn 1 */
 
@@ -131,6 +171,7 @@ void TIMx_BRK_M1_IRQHandler(void)
   /* USER CODE BEGIN TIMx_BRK_M1_IRQn 0 */
 
   /* USER CODE END TIMx_BRK_M1_IRQn 0 */
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_BRK);
   if ( 0U == LL_TIM_IsActiveFlag_BRK(TIM1))
   {
     /* Nothing to do */
@@ -138,7 +179,13 @@ void TIMx_BRK_M1_IRQHandler(void)
   else
   {
     LL_TIM_ClearFlag_BRK(TIM1);
+#if defined (SINGLE_SHUNT)
+    ( void )R1_BRK_IRQHandler(&PWM_Handle_M1);
+#elif defined (ICS_SENSORS)
+    ( void )ICS_BRK_IRQHandler(&PWM_Handle_M1);
+#else
     ( void )R3_2_BRK_IRQHandler(&PWM_Handle_M1);
+#endif
   }
   if ( 0U == LL_TIM_IsActiveFlag_BRK2(TIM1))
   {
@@ -147,16 +194,52 @@ void TIMx_BRK_M1_IRQHandler(void)
   else
   {
     LL_TIM_ClearFlag_BRK2(TIM1);
+#if defined (SINGLE_SHUNT)
+    ( void )R1_BRK2_IRQHandler(&PWM_Handle_M1);
+#elif defined (ICS_SENSORS)
+    ( void )ICS_BRK2_IRQHandler(&PWM_Handle_M1);
+#else
     ( void )R3_2_BRK2_IRQHandler(&PWM_Handle_M1);
+#endif
   }
   /* Systick is not executed due low priority so is necessary to call MC_Scheduler here.*/
   MC_Scheduler();
 
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_BRK);
+
   /* USER CODE BEGIN TIMx_BRK_M1_IRQn 1 */
 
   /* USER CODE END TIMx_BRK_M1_IRQn 1 */
 }
 
+#ifdef M1_ENCODER_SENSOR
+/**
+  * @brief  This function handles the overflows of the encoder timer of Motor 1.
+  * @param  None
+  * @retval None
+  */
+void SPD_TIM_M1_IRQHandler(void)
+{
+  /* USER CODE BEGIN SPD_TIM_M1_IRQn 0 */
+
+  /* USER CODE END SPD_TIM_M1_IRQn 0 */
+
+  if ((LL_TIM_IsActiveFlag_UPDATE(ENCODER_M1.TIMx) != 0U) && (LL_TIM_IsEnabledIT_UPDATE(ENCODER_M1.TIMx) != 0U))
+  {
+    LL_TIM_ClearFlag_UPDATE(ENCODER_M1.TIMx);
+    (void)ENC_IRQHandler(&ENCODER_M1);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  /* USER CODE BEGIN SPD_TIM_M1_IRQn 1 */
+
+  /* USER CODE END SPD_TIM_M1_IRQn 1 */
+}
+#endif
+
 /**
   * @brief This function handles DMA_RX_A channel DMACH_RX_A global interrupt.
   */
@@ -282,6 +365,7 @@ void HardFault_Handler(void)
 
 void SysTick_Handler(void)
 {
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_SYSTICK);
 
 #ifdef MC_HAL_IS_USED
 static uint8_t SystickDividerCounter = SYSTICK_DIVIDER;
@@ -303,8 +387,42 @@ static uint8_t SystickDividerCounter = SYSTICK_DIVIDER;
 
   /* USER CODE BEGIN SysTick_IRQn 2 */
   /* USER CODE END SysTick_IRQn 2 */
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_SYSTICK);
 }
 
+/**
+  * @brief  This function handles the PendSV exception, requested by the high
+  *         frequency task to run its deferred duties.
+  * @param  None
+  * @retval None
+  */
+void PendSV_Handler(void)
+{
+  /* USER CODE BEGIN PendSV_IRQn 0 */
+
+  /* USER CODE END PendSV_IRQn 0 */
+  MC_TRACE_ISR_ENTRY(MC_TRACE_ISR_PENDSV);
+
+  TSK_HighFrequencyDeferredTask();
+
+  MC_TRACE_ISR_EXIT(MC_TRACE_ISR_PENDSV);
+
+  /* USER CODE BEGIN PendSV_IRQn 1 */
+
+  /* USER CODE END PendSV_IRQn 1 */
+}
+
+#ifdef DBG_MCU_LOAD_MEASURE
+/**
+  * @brief  This function handles the FPU interrupt, only pended by
+  *         MC_Perf_MeasureIrqEntry(): the cycle counter at the entry.
+  */
+void FPU_IRQHandler(void)
+{
+  PerfTraces.IrqEntryStamp = DWT->CYCCNT;
+}
+#endif
+
 /**
   * @brief  This function handles Button IRQ on PIN PB10.
   */
@@ -323,6 +441,46 @@ void EXTI15_10_IRQHandler (void)
 
 }
 
+/**
+  * @brief  This function handles the I2C3 event interrupt of the STSPIN32G4 driver queue.
+  */
+void I2C3_EV_IRQHandler(void)
+{
+  HAL_I2C_EV_IRQHandler(HdlSTSPING4.i2cHdl);
+}
+
+/**
+  * @brief  This function handles the I2C3 error interrupt of the STSPIN32G4 driver queue.
+  */
+void I2C3_ER_IRQHandler(void)
+{
+  HAL_I2C_ER_IRQHandler(HdlSTSPING4.i2cHdl);
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == HdlSTSPING4.i2cHdl)
+  {
+    STSPIN32G4_txCplt(&HdlSTSPING4);
+  }
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == HdlSTSPING4.i2cHdl)
+  {
+    STSPIN32G4_rxCplt(&HdlSTSPING4);
+  }
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == HdlSTSPING4.i2cHdl)
+  {
+    STSPIN32G4_transferError(&HdlSTSPING4);
+  }
+}
+
 /* USER CODE BEGIN 1 */
 
 /* USER CODE END 1 */